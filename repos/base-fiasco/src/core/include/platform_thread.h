@@ -159,6 +159,16 @@ namespace Genode {
 			 */
 			unsigned long long execution_time() const { return 0; }
 
+			/**
+			 * Return number of migrations of the thread between CPUs
+			 */
+			unsigned long migrations() const { return 0; }
+
+			/**
+			 * Return number of wake-ups of the thread from a blocking state
+			 */
+			unsigned long wakeups() const { return 0; }
+
 
 			/*******************************
 			 ** Fiasco-specific Accessors **
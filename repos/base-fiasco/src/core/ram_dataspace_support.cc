@@ -25,3 +25,11 @@ void Ram_dataspace_factory::_clear_ds(Dataspace_component *ds)
 {
 	memset((void *)ds->phys_addr(), 0, ds->size());
 }
+
+
+bool Ram_dataspace_factory::_clear_ahead(addr_t phys, size_t size)
+{
+	/* physical memory is identity-mapped in core */
+	memset((void *)phys, 0, size);
+	return true;
+}
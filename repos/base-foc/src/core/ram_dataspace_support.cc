@@ -33,3 +33,14 @@ void Ram_dataspace_factory::_clear_ds(Dataspace_component *ds)
 			Fiasco::l4_cache_dma_coherent(ds->phys_addr(), ds->phys_addr() + ds->size());
 }
 
+bool Ram_dataspace_factory::_clear_ahead(addr_t phys, size_t size)
+{
+	if (!size)
+		return true;
+
+	memset((void *)phys, 0, size);
+
+	/* the memory may end up in an uncached dataspace */
+	Fiasco::l4_cache_dma_coherent(phys, phys + size);
+	return true;
+}
@@ -0,0 +1,35 @@
+/*
+ * \brief  Client-side HW specific CPU session interface
+ * \author Genode Labs
+ * \date   2026-10-14
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__HW_NATIVE_CPU__CLIENT_H_
+#define _INCLUDE__HW_NATIVE_CPU__CLIENT_H_
+
+#include <hw_native_cpu/hw_native_cpu.h>
+#include <base/rpc_client.h>
+
+namespace Genode { struct Hw_native_cpu_client; }
+
+
+struct Genode::Hw_native_cpu_client : Rpc_client<Hw_native_cpu>
+{
+	explicit Hw_native_cpu_client(Capability<Native_cpu> cap)
+	: Rpc_client<Hw_native_cpu>(static_cap_cast<Hw_native_cpu>(cap)) { }
+
+	void perf_events(Thread_capability thread, Perf_events events) override {
+		call<Rpc_perf_events>(thread, events); }
+
+	Perf_counts perf_counts(Thread_capability thread) override {
+		return call<Rpc_perf_counts>(thread); }
+};
+
+#endif /* _INCLUDE__HW_NATIVE_CPU__CLIENT_H_ */
@@ -0,0 +1,63 @@
+/*
+ * \brief  HW-specific part of the CPU session interface
+ * \author Genode Labs
+ * \date   2026-10-14
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__HW_NATIVE_CPU__HW_NATIVE_CPU_H_
+#define _INCLUDE__HW_NATIVE_CPU__HW_NATIVE_CPU_H_
+
+#include <base/rpc.h>
+#include <cpu_session/cpu_session.h>
+
+namespace Genode { struct Hw_native_cpu; }
+
+
+struct Genode::Hw_native_cpu : Cpu_session::Native_cpu
+{
+	enum { MAX_PERF_EVENTS = 4 };
+
+	/**
+	 * Events of the performance-monitoring unit
+	 *
+	 * Events that the unit of the CPU does not know are never counted.
+	 */
+	enum Perf_event {
+		NONE, INSTRUCTIONS, CACHE_MISSES, BRANCH_MISSES, TLB_MISSES };
+
+	struct Perf_events { Perf_event event[MAX_PERF_EVENTS]; };
+	struct Perf_counts { uint64_t   count[MAX_PERF_EVENTS]; };
+
+	/**
+	 * Select the events counted while the thread executes
+	 *
+	 * The counts of the thread start from zero.
+	 */
+	virtual void perf_events(Thread_capability, Perf_events) = 0;
+
+	/**
+	 * Return the event counts of the thread
+	 *
+	 * The counts of a thread that executes at another CPU than the caller
+	 * are as of the thread's last preemption.
+	 */
+	virtual Perf_counts perf_counts(Thread_capability) = 0;
+
+
+	/*********************
+	 ** RPC declaration **
+	 *********************/
+
+	GENODE_RPC(Rpc_perf_events, void, perf_events, Thread_capability, Perf_events);
+	GENODE_RPC(Rpc_perf_counts, Perf_counts, perf_counts, Thread_capability);
+	GENODE_RPC_INTERFACE(Rpc_perf_events, Rpc_perf_counts);
+};
+
+#endif /* _INCLUDE__HW_NATIVE_CPU__HW_NATIVE_CPU_H_ */
@@ -25,6 +25,7 @@ SRC_CC += spec/x86_64/muen/platform_services.cc
 SRC_CC += spec/x86_64/muen/sinfo_instance.cc
 SRC_CC += spec/x86_64/muen/timer.cc
 SRC_CC += kernel/vm_thread_on.cc
+SRC_CC += kernel/perf_counter_off.cc
 
 SRC_CC += kernel/kernel.cc
 SRC_CC += spec/x86/io_port_session_component.cc
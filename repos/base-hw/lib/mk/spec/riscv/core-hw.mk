@@ -5,6 +5,7 @@ CC_OPT += -fno-delete-null-pointer-checks
 # add C++ sources
 SRC_CC += platform_services.cc
 SRC_CC += kernel/vm_thread_off.cc kernel/kernel.cc
+SRC_CC += kernel/perf_counter_off.cc
 SRC_CC += spec/riscv/cpu.cc
 SRC_CC += spec/riscv/kernel/thread.cc
 SRC_CC += spec/riscv/kernel/cpu.cc
@@ -14,6 +14,7 @@ SRC_S += spec/x86_64/exception_vector.s
 
 # add C++ sources
 SRC_CC += kernel/vm_thread_off.cc
+SRC_CC += kernel/perf_counter_off.cc
 SRC_CC += spec/x86_64/pic.cc
 SRC_CC += spec/x86_64/timer.cc
 SRC_CC += spec/x86_64/kernel/thread_exception.cc
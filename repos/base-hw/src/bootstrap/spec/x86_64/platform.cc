@@ -109,6 +109,11 @@ Bootstrap::Platform::Board::Board()
 
 unsigned Bootstrap::Platform::enable_mmu()
 {
+	/* provide the write-combining memory type used by the page tables */
+	Cpu::Ia32_pat::access_t pat = Cpu::Ia32_pat::read();
+	Cpu::Ia32_pat::Pa1::set(pat, Cpu::Ia32_pat::WRITE_COMBINING);
+	Cpu::Ia32_pat::write(pat);
+
 	Cpu::Cr3::write(Cpu::Cr3::Pdb::masked((addr_t)core_pd->table_base));
 	return 0;
 }
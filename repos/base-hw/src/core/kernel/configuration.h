@@ -31,6 +31,12 @@ namespace Kernel
 
 	/* time slice for the round-robin mode and the idle in CPU scheduling */
 	constexpr time_t cpu_fill_us = 10000;
+
+	/* migrate waiting threads without strict affinity to idle CPUs */
+	constexpr bool cpu_balancing = true;
+
+	/* do not interrupt an idle CPU before the end of the super period */
+	constexpr bool tickless_idle = true;
 }
 
 #endif /* _CORE__KERNEL__CONFIGURATION_H_ */
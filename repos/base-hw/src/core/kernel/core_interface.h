@@ -20,6 +20,9 @@
 /* base-hw includes */
 #include <kernel/interface.h>
 
+/* core includes */
+#include <kernel/perf_counter.h>
+
 namespace Genode { class Native_utcb; }
 
 namespace Kernel
@@ -60,6 +63,8 @@ namespace Kernel
 	constexpr Call_arg call_id_delete_obj()             { return 122; }
 	constexpr Call_arg call_id_cancel_thread_blocking() { return 123; }
 	constexpr Call_arg call_id_new_core_thread()        { return 124; }
+	constexpr Call_arg call_id_thread_perf_events()     { return 125; }
+	constexpr Call_arg call_id_thread_perf_counts()     { return 126; }
 
 	/**
 	 * Update locally effective domain configuration to in-memory state
@@ -88,6 +93,35 @@ namespace Kernel
 	}
 
 
+	/**
+	 * Select the events that the performance counter counts for a thread
+	 *
+	 * \param thread  kernel object of the targeted thread
+	 * \param events  'Perf_counter::MAX_EVENTS' events, 'NONE' for unused
+	 *                counters
+	 *
+	 * The counts of the thread get reset.
+	 */
+	inline void thread_perf_events(Thread * const thread,
+	                               Perf_counter::Event const * const events)
+	{
+		call(call_id_thread_perf_events(), (Call_arg)thread, (Call_arg)events);
+	}
+
+
+	/**
+	 * Read the event counts of a thread
+	 *
+	 * \param thread  kernel object of the targeted thread
+	 * \param counts  destination of 'Perf_counter::MAX_EVENTS' counts
+	 */
+	inline void thread_perf_counts(Thread * const thread,
+	                               Genode::uint64_t * const counts)
+	{
+		call(call_id_thread_perf_counts(), (Call_arg)thread, (Call_arg)counts);
+	}
+
+
 	/**
 	 * Pause execution of a thread until 'resume_thread' is called on it
 	 *
@@ -124,21 +158,37 @@ namespace Kernel
 	}
 
 
+	/**
+	 * Encode a set of 'num' CPUs starting with CPU 'first'
+	 */
+	constexpr Call_arg cpu_set(unsigned const first, unsigned const num) {
+		return (Call_arg)first | ((Call_arg)num << 16); }
+
+	constexpr unsigned cpu_set_first(Call_arg const set) { return set & 0xffff; }
+
+	constexpr unsigned cpu_set_size(Call_arg const set) {
+		return (set >> 16) ? (set >> 16) & 0xffff : 1; }
+
+
 	/**
 	 * Start execution of a thread
 	 *
 	 * \param thread  pointer to thread kernel object
-	 * \param cpu_id  kernel name of the targeted CPU
+	 * \param cpus    set of CPUs the thread may execute on, encoded via
+	 *                'cpu_set', the thread starts at the first CPU
 	 * \param pd      pointer to pd kernel object
 	 * \param utcb    core local pointer to userland thread-context
 	 *
 	 * \retval   0  suceeded
 	 * \retval !=0  failed
+	 *
+	 * If the set comprises more than one CPU, the kernel may migrate the
+	 * thread within the set to balance the load.
 	 */
-	inline int start_thread(Thread * const thread, unsigned const cpu_id,
+	inline int start_thread(Thread * const thread, Call_arg const cpus,
 	                        Pd * const pd, Native_utcb * const utcb)
 	{
-		return call(call_id_start_thread(), (Call_arg)thread, cpu_id,
+		return call(call_id_start_thread(), (Call_arg)thread, cpus,
 		            (Call_arg)pd, (Call_arg)utcb);
 	}
 
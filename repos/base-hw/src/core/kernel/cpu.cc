@@ -108,6 +108,28 @@ void Cpu_job::quota(unsigned const q)
 }
 
 
+bool Cpu_job::migratable_to(Cpu const &cpu)
+{
+	return cpu.id() >= _first_cpu && cpu.id() < _first_cpu + _num_cpus
+	    && &cpu != _cpu && _migratable();
+}
+
+
+void Cpu_job::migrate(Cpu &cpu)
+{
+	assert(_cpu->id() == Cpu::executing_id());
+
+	_cpu->scheduler()->unready(this);
+	_cpu->scheduler()->remove(this);
+	_leave_cpu();
+
+	_cpu = &cpu;
+	_cpu->scheduler()->insert(this);
+	_cpu->schedule(this);
+	_migrations++;
+}
+
+
 Cpu_job::Cpu_job(Cpu_priority const p, unsigned const q)
 :
 	Cpu_share(p, q), _cpu(0) { }
@@ -147,6 +169,54 @@ time_t Cpu::timeout_age_us(Timeout const * const timeout) const {
 time_t Cpu::timeout_max_us() const { return _timer.timeout_max_us(); }
 
 
+void Cpu::_balance()
+{
+	if (!cpu_balancing || NR_OF_CPUS == 1) { return; }
+
+	bool done = false;
+	cpu_pool()->for_each_cpu([&] (Cpu &cpu) {
+
+		if (done || &cpu == this || !cpu._scheduler.idle()) { return; }
+
+		Cpu_share * const share = _scheduler.waiting_fill([&] (Cpu_share &s) {
+			return static_cast<Job &>(s).migratable_to(cpu); });
+
+		if (!share) { return; }
+
+		static_cast<Job *>(share)->migrate(cpu);
+		done = true;
+	});
+}
+
+
+void Cpu::_switch_perf_context(Perf_counter::Context * const context)
+{
+	if (context == _perf_context)
+		return;
+
+	if (_perf_context) { perf_counter()->save(*_perf_context); }
+	if (context)       { perf_counter()->load(*context); }
+	_perf_context = context;
+}
+
+
+void Cpu::flush_perf_context(Perf_counter::Context &context)
+{
+	if (&context != _perf_context)
+		return;
+
+	perf_counter()->save(context);
+	perf_counter()->load(context);
+}
+
+
+void Cpu::perf_context_gone(Perf_counter::Context &context)
+{
+	if (&context == _perf_context)
+		_perf_context = nullptr;
+}
+
+
 void Cpu::schedule(Job * const job)
 {
 	if (_id == executing_id()) { _scheduler.ready(job); }
@@ -168,18 +238,40 @@ Cpu_job & Cpu::schedule()
 	/* update scheduler */
 	time_t quota = _timer.update_time();
 	Job & old_job = scheduled_job();
+
+	/*
+	 * Account the time slices of the idle job that passed without a kernel
+	 * pass. Doing so before handling the exception keeps the time, during
+	 * which the CPU idled, from being charged to a job that became ready.
+	 */
+	if (tickless_idle && &old_job == &_idle)
+		for (; quota > _fill() && _scheduler.head() == &_idle; quota -= _fill())
+			_scheduler.update(_fill());
+
 	old_job.exception(*this);
 	_timer.process_timeouts();
 	_scheduler.update(quota);
+	_balance();
 
 	/* get new job */
 	Job & new_job = scheduled_job();
 	quota = _scheduler.head_quota();
 
+	/*
+	 * An idle CPU has nothing to decide before the end of the super period,
+	 * at which the claims get refreshed. Jobs that become ready and user
+	 * timeouts cause a kernel pass anyway, the latter because the timer
+	 * gets programmed for the nearest of all timeouts.
+	 */
+	if (tickless_idle && &new_job == &_idle)
+		quota = _scheduler.residual();
+
 	_timer.set_timeout(this, quota);
 
 	_timer.schedule_timeout();
 
+	_switch_perf_context(new_job.perf_context());
+
 	/* return new job */
 	return new_job;
 }
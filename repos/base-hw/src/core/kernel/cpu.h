@@ -90,9 +90,22 @@ class Kernel::Cpu : public Genode::Cpu, public Irq::Pool, private Timeout
 		Ipi            _ipi_irq;
 		Irq            _timer_irq; /* timer IRQ implemented as empty event */
 
+		/* event counters that are loaded into the performance counter */
+		Perf_counter::Context * _perf_context = nullptr;
+
 		unsigned _quota() const { return _timer.us_to_ticks(cpu_quota_us); }
 		unsigned _fill() const  { return _timer.us_to_ticks(cpu_fill_us); }
 
+		/**
+		 * Hand over a job that waits for this CPU to an idle CPU
+		 */
+		void _balance();
+
+		/**
+		 * Make the performance counter count for 'context'
+		 */
+		void _switch_perf_context(Perf_counter::Context * const context);
+
 	public:
 
 		enum { KERNEL_STACK_SIZE = 16 * 1024 * sizeof(Genode::addr_t) };
@@ -140,6 +153,16 @@ class Kernel::Cpu : public Genode::Cpu, public Irq::Pool, private Timeout
 
 		time_t timeout_max_us() const;
 
+		/**
+		 * Save the event counters of 'context' if they are loaded at the CPU
+		 */
+		void flush_perf_context(Perf_counter::Context &context);
+
+		/**
+		 * Forget the event counters of 'context' as they will vanish
+		 */
+		void perf_context_gone(Perf_counter::Context &context);
+
 		time_t time() const { return _timer.time(); }
 
 		addr_t stack_start();
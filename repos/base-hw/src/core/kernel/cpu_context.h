@@ -18,6 +18,7 @@
 /* core includes */
 #include <kernel/cpu_scheduler.h>
 #include <kernel/timer.h>
+#include <kernel/perf_counter.h>
 
 namespace Kernel
 {
@@ -70,6 +71,14 @@ class Kernel::Cpu_domain_update : public Double_list_item
 
 class Kernel::Cpu_job : public Cpu_share
 {
+	private:
+
+		/* range of CPUs the job may be migrated to */
+		unsigned _first_cpu = 0;
+		unsigned _num_cpus  = 1;
+
+		unsigned long _migrations = 0;
+
 	protected:
 
 		Cpu * _cpu;
@@ -99,6 +108,16 @@ class Kernel::Cpu_job : public Cpu_share
 		 */
 		bool _helping_possible(Cpu_job * const j) { return j->_cpu == _cpu; }
 
+		/**
+		 * Return wether the job may leave its CPU in its current state
+		 */
+		virtual bool _migratable() { return false; }
+
+		/**
+		 * Withdraw the state of the job that the executing CPU holds
+		 */
+		virtual void _leave_cpu() { }
+
 	public:
 
 		/**
@@ -116,6 +135,11 @@ class Kernel::Cpu_job : public Cpu_share
 		 */
 		virtual Cpu_job * helping_sink() = 0;
 
+		/**
+		 * Return the event counters of the job or nullptr if it counts none
+		 */
+		virtual Perf_counter::Context * perf_context() { return nullptr; }
+
 		/**
 		 * Construct a job with scheduling priority 'p' and time quota 'q'
 		 */
@@ -131,6 +155,30 @@ class Kernel::Cpu_job : public Cpu_share
 		 */
 		void affinity(Cpu * const cpu);
 
+		/**
+		 * Permit migration of the job to 'num' CPUs starting with CPU 'first'
+		 */
+		void cpus(unsigned const first, unsigned const num)
+		{
+			_first_cpu = first;
+			_num_cpus  = num;
+		}
+
+		/**
+		 * Return wether the job may be migrated to CPU 'cpu'
+		 */
+		bool migratable_to(Cpu const &cpu);
+
+		/**
+		 * Move the ready job from the executing CPU to CPU 'cpu'
+		 */
+		void migrate(Cpu &cpu);
+
+		/**
+		 * Return how often the job was migrated
+		 */
+		unsigned long migrations() const { return _migrations; }
+
 		/**
 		 * Set CPU quota of the job to 'q'
 		 */
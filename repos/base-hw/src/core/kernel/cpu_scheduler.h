@@ -223,6 +223,29 @@ class Kernel::Cpu_scheduler
 		 * Accessors
 		 */
 
+		/**
+		 * Return wether no share is ready
+		 */
+		bool idle() const { return !_fills.head(); }
+
+		/**
+		 * Return a ready share that waits for the CPU and satisfies 'f'
+		 *
+		 * Only shares without quota are considered because the quota of
+		 * a claim is a reservation at this scheduler.
+		 *
+		 * \param f  functor of type 'bool (Share &)'
+		 */
+		template <typename F>
+		Share * waiting_fill(F const &f)
+		{
+			for (Fill * i = _fills.head(); i; i = Fill_list::next(i)) {
+				Share * const s = _share(i);
+				if (s != _head && !s->_quota && f(*s)) { return s; }
+			}
+			return nullptr;
+		}
+
 		Share * head() const { return _head; }
 		unsigned head_quota() const {
 			return Genode::min(_head_quota, _residual); }
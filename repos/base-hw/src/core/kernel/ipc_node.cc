@@ -34,6 +34,18 @@ static inline void free_obj_id_ref(Pd *pd, void *ptr)
 }
 
 
+void Ipc_node::_alloc_obj_id_refs(unsigned const num)
+{
+	if (_obj_id_ref_cnt >= num)
+		return;
+
+	Genode::Allocator &slab = pd()->platform_pd()->capability_slab();
+	for (; _obj_id_ref_cnt < num; _obj_id_ref_cnt++)
+		_obj_id_ref_ptr[_obj_id_ref_cnt] =
+			slab.alloc(sizeof(Object_identity_reference));
+}
+
+
 void Ipc_node::copy_msg(Ipc_node * const sender)
 {
 	using namespace Genode;
@@ -43,25 +55,21 @@ void Ipc_node::copy_msg(Ipc_node * const sender)
 	*_utcb = *sender->_utcb;
 	_utcb->destination(sender->_capid);
 
-	/* translate capabilities */
-	for (unsigned i = 0; i < _rcv_caps; i++) {
+	/*
+	 * Translate capabilities, the pre-allocations of unused capability
+	 * slots are kept for the next message
+	 */
+	unsigned const num_caps = min(_rcv_caps, sender->_utcb->cap_cnt());
+	for (unsigned i = 0; i < num_caps; i++) {
 
 		capid_t id = sender->_utcb->cap_get(i);
 
-		/* if there is no capability to send, just free the pre-allocation */
-		if (i >= sender->_utcb->cap_cnt()) {
-			free_obj_id_ref(pd(), _obj_id_ref_ptr[i]);
-			continue;
-		}
-
 		/* lookup the capability id within the caller's cap space */
 		Reference *oir = (id == cap_id_invalid())
 			? nullptr : sender->pd()->cap_tree().find(id);
 
-		/* if the caller's capability is invalid, free the pre-allocation */
 		if (!oir) {
 			_utcb->cap_add(cap_id_invalid());
-			free_obj_id_ref(pd(), _obj_id_ref_ptr[i]);
 			continue;
 		}
 
@@ -69,12 +77,11 @@ void Ipc_node::copy_msg(Ipc_node * const sender)
 		Reference *dst_oir = oir->find(pd());
 
 		/* if it is not found, and the target is not core, create a reference */
-		if (!dst_oir && (pd() != core_pd())) {
-			dst_oir = oir->factory(_obj_id_ref_ptr[i], *pd());
-			if (!dst_oir)
-				free_obj_id_ref(pd(), _obj_id_ref_ptr[i]);
-		} else /* otherwise free the pre-allocation */
-			free_obj_id_ref(pd(), _obj_id_ref_ptr[i]);
+		if (!dst_oir && (pd() != core_pd()) && _obj_id_ref_cnt) {
+			dst_oir = oir->factory(_obj_id_ref_ptr[_obj_id_ref_cnt - 1], *pd());
+			if (dst_oir)
+				_obj_id_ref_cnt--;
+		}
 
 		if (dst_oir) dst_oir->add_to_utcb();
 
@@ -164,9 +171,7 @@ void Ipc_node::_init(Genode::Native_utcb * utcb, Ipc_node * starter)
 {
 	_utcb = utcb;
 	_rcv_caps = starter->_utcb->cap_cnt();
-	Genode::Allocator &slab = pd()->platform_pd()->capability_slab();
-	for (unsigned i = 0; i < _rcv_caps; i++)
-		_obj_id_ref_ptr[i] = slab.alloc(sizeof(Object_identity_reference));
+	_alloc_obj_id_refs(_rcv_caps);
 	copy_msg(starter);
 }
 
@@ -178,9 +183,7 @@ void Ipc_node::send_request(Ipc_node * const callee, capid_t capid, bool help,
 		Genode::error("IPC send request: bad state");
 		return;
 	}
-	Genode::Allocator &slab = pd()->platform_pd()->capability_slab();
-	for (unsigned i = 0; i < rcv_caps; i++)
-		_obj_id_ref_ptr[i] = slab.alloc(sizeof(Object_identity_reference));
+	_alloc_obj_id_refs(rcv_caps);
 
 	_state    = AWAIT_REPLY;
 	_callee   = callee;
@@ -205,9 +208,7 @@ bool Ipc_node::await_request(unsigned rcv_caps)
 		Genode::error("IPC await request: bad state");
 		return true;
 	}
-	Genode::Allocator &slab = pd()->platform_pd()->capability_slab();
-	for (unsigned i = 0; i < rcv_caps; i++)
-		_obj_id_ref_ptr[i] = slab.alloc(sizeof(Object_identity_reference));
+	_alloc_obj_id_refs(rcv_caps);
 
 	_rcv_caps = rcv_caps;
 
@@ -256,5 +257,8 @@ Ipc_node::~Ipc_node()
 	_cancel_request_queue();
 	_cancel_inbuf_request();
 	_cancel_outbuf_request();
+
+	while (_obj_id_ref_cnt)
+		free_obj_id_ref(pd(), _obj_id_ref_ptr[--_obj_id_ref_cnt]);
 }
 
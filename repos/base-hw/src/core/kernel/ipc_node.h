@@ -65,8 +65,19 @@ class Kernel::Ipc_node : public Ipc_node_queue::Element
 		Genode::Native_utcb * _utcb     = nullptr;
 		Ipc_node_queue        _request_queue;
 
-		/* pre-allocation array for obkject identity references */
-		void * _obj_id_ref_ptr[Genode::Msgbuf_base::MAX_CAPS_PER_MSG];
+		/*
+		 * Pre-allocation array for object identity references
+		 *
+		 * The first '_obj_id_ref_cnt' entries are allocated. Entries that
+		 * were not consumed by a message are kept for the next message.
+		 */
+		void *   _obj_id_ref_ptr[Genode::Msgbuf_base::MAX_CAPS_PER_MSG];
+		unsigned _obj_id_ref_cnt = 0;
+
+		/**
+		 * Make sure that 'num' object identity references are pre-allocated
+		 */
+		void _alloc_obj_id_refs(unsigned const num);
 
 		inline void copy_msg(Ipc_node * const sender);
 
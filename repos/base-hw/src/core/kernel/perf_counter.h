@@ -14,6 +14,9 @@
 #ifndef _CORE__KERNEL__PERF_COUNTER_H_
 #define _CORE__KERNEL__PERF_COUNTER_H_
 
+/* Genode includes */
+#include <base/stdint.h>
+
 namespace Kernel
 {
 	/**
@@ -23,10 +26,43 @@ namespace Kernel
 	{
 		public:
 
+			enum { MAX_EVENTS = 4 };
+
+			/**
+			 * Events that can be counted per thread
+			 *
+			 * The events are translated to the events of the actual
+			 * performance-monitoring unit. Events unknown to the unit are
+			 * not counted.
+			 */
+			enum Event {
+				NONE, INSTRUCTIONS, CACHE_MISSES, BRANCH_MISSES, TLB_MISSES };
+
+			/**
+			 * Event counters of a thread
+			 */
+			struct Context
+			{
+				Event            event[MAX_EVENTS];
+				Genode::uint64_t count[MAX_EVENTS];
+			};
+
 			/**
 			 * Enable counting
 			 */
 			void enable();
+
+			/**
+			 * Program the counters for the events of 'context'
+			 *
+			 * The counters start from zero.
+			 */
+			void load(Context const &context);
+
+			/**
+			 * Add the counted events to 'context'
+			 */
+			void save(Context &context);
 	};
 
 
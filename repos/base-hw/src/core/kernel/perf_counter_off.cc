@@ -0,0 +1,26 @@
+/*
+ * \brief  Performance counter when having no supported counters
+ * \author Genode Labs
+ * \date   2026-10-14
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* core includes */
+#include <kernel/perf_counter.h>
+
+void Kernel::Perf_counter::enable()               { }
+void Kernel::Perf_counter::load(Context const &) { }
+void Kernel::Perf_counter::save(Context &)       { }
+
+
+Kernel::Perf_counter* Kernel::perf_counter()
+{
+	static Kernel::Perf_counter inst;
+	return &inst;
+}
@@ -140,6 +140,7 @@ void Thread::_activate_used_shares()
 
 void Thread::_become_active()
 {
+	if (_state != ACTIVE && _state != AWAITS_START) { _wakeups++; }
 	if (_state != ACTIVE && !_paused) { _activate_used_shares(); }
 	_state = ACTIVE;
 }
@@ -159,6 +160,24 @@ Cpu_job * Thread::helping_sink() {
 	return static_cast<Thread *>(Ipc_node::helping_sink()); }
 
 
+bool Thread::_migratable()
+{
+	/*
+	 * A timeout is bound to the timer of the CPU it was set at. Helping is
+	 * restricted to jobs of the same CPU.
+	 */
+	if (_state != ACTIVE || _paused || _cpu_timeout) { return false; }
+	if (Ipc_node::helping_sink() != static_cast<Ipc_node *>(this)) { return false; }
+
+	bool helped = false;
+	Ipc_node::for_each_helper([&] (Ipc_node * const) { helped = true; });
+	return !helped;
+}
+
+
+void Thread::_leave_cpu() { _cpu->release_fpu(*regs); }
+
+
 size_t Thread::_core_to_kernel_quota(size_t const quota) const
 {
 	using Genode::Cpu_session;
@@ -197,20 +216,57 @@ void Thread::_call_thread_quota()
 }
 
 
+void Thread::_call_thread_perf_events()
+{
+	Thread &thread = *(Thread *)user_arg_1();
+	Perf_counter::Event const * const events =
+		(Perf_counter::Event const *)user_arg_2();
+
+	/* the new events take effect when the thread gets scheduled next */
+	thread._perf_counting = false;
+	for (unsigned i = 0; i < Perf_counter::MAX_EVENTS; i++) {
+		thread._perf_context.event[i] = events[i];
+		thread._perf_context.count[i] = 0;
+		if (events[i] != Perf_counter::NONE)
+			thread._perf_counting = true;
+	}
+}
+
+
+void Thread::_call_thread_perf_counts()
+{
+	Thread &thread = *(Thread *)user_arg_1();
+	Genode::uint64_t * const counts = (Genode::uint64_t *)user_arg_2();
+
+	/*
+	 * The counters of a thread that executes at another CPU at the moment
+	 * are as of the last time it was descheduled there.
+	 */
+	if (thread._cpu)
+		thread._cpu->flush_perf_context(thread._perf_context);
+
+	for (unsigned i = 0; i < Perf_counter::MAX_EVENTS; i++)
+		counts[i] = thread._perf_context.count[i];
+}
+
+
 void Thread::_call_start_thread()
 {
 	/* lookup CPU */
-	Cpu * const cpu = cpu_pool()->cpu(user_arg_2());
-	if (!cpu) {
+	unsigned const first_cpu = cpu_set_first(user_arg_2());
+	unsigned const num_cpus  = cpu_set_size(user_arg_2());
+	if (first_cpu >= NR_OF_CPUS) {
 		Genode::warning("failed to lookup CPU");
 		user_arg_0(-2);
 		return;
 	}
+	Cpu * const cpu = cpu_pool()->cpu(first_cpu);
 	user_arg_0(0);
 	Thread * const thread = (Thread*) user_arg_1();
 
 	assert(thread->_state == AWAITS_START)
 
+	thread->cpus(first_cpu, Genode::min(num_cpus, NR_OF_CPUS - first_cpu));
 	thread->affinity(cpu);
 
 	/* join protection domain */
@@ -326,6 +382,7 @@ void Thread::_call_await_request_msg()
 void Thread::_call_timeout()
 {
 	_timeout_sigid = user_arg_2();
+	_cpu_timeout   = true;
 	Cpu_job::timeout(this, user_arg_1());
 }
 
@@ -597,6 +654,8 @@ void Thread::_call()
 	case call_id_new_thread():             _call_new_thread(); return;
 	case call_id_new_core_thread():        _call_new_core_thread(); return;
 	case call_id_thread_quota():           _call_thread_quota(); return;
+	case call_id_thread_perf_events():     _call_thread_perf_events(); return;
+	case call_id_thread_perf_counts():     _call_thread_perf_counts(); return;
 	case call_id_delete_thread():          _call_delete<Thread>(); return;
 	case call_id_start_thread():           _call_start_thread(); return;
 	case call_id_resume_thread():          _call_resume_thread(); return;
@@ -659,6 +718,12 @@ Thread::Thread(unsigned const priority, unsigned const quota,
 	_signal_receiver(0), _label(label), _core(core), regs(core) { }
 
 
+Thread::~Thread()
+{
+	if (_cpu) { _cpu->perf_context_gone(_perf_context); }
+}
+
+
 void Thread::print(Genode::Output &out) const
 {
 	Genode::print(out, (_pd) ? _pd->platform_pd()->label() : "?");
@@ -75,6 +75,12 @@ class Kernel::Thread
 		bool               _paused = false;
 		bool               _cancel_next_await_signal = false;
 		bool const         _core = false;
+		bool               _cpu_timeout = false;
+		unsigned long      _wakeups = 0;
+
+		/* events counted for the thread, if '_perf_counting' */
+		Perf_counter::Context _perf_context { };
+		bool                  _perf_counting = false;
 
 		/**
 		 * Notice that another thread yielded the CPU to this thread
@@ -145,6 +151,8 @@ class Kernel::Thread
 		void _call_new_thread();
 		void _call_new_core_thread();
 		void _call_thread_quota();
+		void _call_thread_perf_events();
+		void _call_thread_perf_counts();
 		void _call_start_thread();
 		void _call_stop_thread();
 		void _call_pause_thread();
@@ -245,6 +253,8 @@ class Kernel::Thread
 		Thread(unsigned const priority, unsigned const quota,
 		       char const * const label, bool core = false);
 
+		~Thread();
+
 		/**
 		 * Constructor for core/kernel thread
 		 *
@@ -321,6 +331,16 @@ class Kernel::Thread
 		void proceed(Cpu & cpu);
 		Cpu_job * helping_sink();
 
+		Perf_counter::Context * perf_context() override {
+			return _perf_counting ? &_perf_context : nullptr; }
+
+	protected:
+
+		bool _migratable() override;
+		void _leave_cpu() override;
+
+	public:
+
 
 		/*************
 		 ** Timeout **
@@ -335,6 +355,11 @@ class Kernel::Thread
 
 		char const * label() const { return _label; }
 		Thread_fault fault() const { return _fault; }
+
+		/**
+		 * Return how often the thread was woken up from a blocking state
+		 */
+		unsigned long wakeups() const { return _wakeups; }
 };
 
 
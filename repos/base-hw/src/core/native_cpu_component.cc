@@ -0,0 +1,77 @@
+/*
+ * \brief  Kernel-specific part of the CPU-session interface
+ * \author Genode Labs
+ * \date   2026-10-14
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* core includes */
+#include <native_cpu_component.h>
+#include <cpu_session_component.h>
+
+using namespace Genode;
+
+
+static Kernel::Perf_counter::Event kernel_perf_event(Hw_native_cpu::Perf_event e)
+{
+	using Kernel::Perf_counter;
+
+	switch (e) {
+	case Hw_native_cpu::INSTRUCTIONS:  return Perf_counter::INSTRUCTIONS;
+	case Hw_native_cpu::CACHE_MISSES:  return Perf_counter::CACHE_MISSES;
+	case Hw_native_cpu::BRANCH_MISSES: return Perf_counter::BRANCH_MISSES;
+	case Hw_native_cpu::TLB_MISSES:    return Perf_counter::TLB_MISSES;
+	case Hw_native_cpu::NONE:          break;
+	}
+	return Perf_counter::NONE;
+}
+
+
+void Native_cpu_component::perf_events(Thread_capability thread_cap,
+                                       Perf_events events)
+{
+	static_assert((unsigned)MAX_PERF_EVENTS == Kernel::Perf_counter::MAX_EVENTS,
+	              "mismatching number of performance counters");
+
+	Kernel::Perf_counter::Event kernel_events[MAX_PERF_EVENTS];
+	for (unsigned i = 0; i < MAX_PERF_EVENTS; i++)
+		kernel_events[i] = kernel_perf_event(events.event[i]);
+
+	_thread_ep.apply(thread_cap, [&] (Cpu_thread_component *thread) {
+		if (thread)
+			thread->platform_thread().perf_events(kernel_events); });
+}
+
+
+Hw_native_cpu::Perf_counts
+Native_cpu_component::perf_counts(Thread_capability thread_cap)
+{
+	Perf_counts counts { };
+
+	_thread_ep.apply(thread_cap, [&] (Cpu_thread_component *thread) {
+		if (thread)
+			thread->platform_thread().perf_counts(counts.count); });
+
+	return counts;
+}
+
+
+Native_cpu_component::Native_cpu_component(Cpu_session_component &cpu_session,
+                                           char const *)
+:
+	_cpu_session(cpu_session), _thread_ep(*_cpu_session._thread_ep)
+{
+	_thread_ep.manage(this);
+}
+
+
+Native_cpu_component::~Native_cpu_component()
+{
+	_thread_ep.dissolve(this);
+}
@@ -0,0 +1,45 @@
+/*
+ * \brief  Kernel-specific part of the CPU-session interface
+ * \author Genode Labs
+ * \date   2026-10-14
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _CORE__INCLUDE__NATIVE_CPU_COMPONENT_H_
+#define _CORE__INCLUDE__NATIVE_CPU_COMPONENT_H_
+
+/* Genode includes */
+#include <base/rpc_server.h>
+#include <hw_native_cpu/hw_native_cpu.h>
+
+namespace Genode {
+
+	class Cpu_session_component;
+	class Native_cpu_component;
+}
+
+
+class Genode::Native_cpu_component : public Rpc_object<Hw_native_cpu,
+                                                       Native_cpu_component>
+{
+	private:
+
+		Cpu_session_component &_cpu_session;
+		Rpc_entrypoint        &_thread_ep;
+
+	public:
+
+		Native_cpu_component(Cpu_session_component &, char const *);
+		~Native_cpu_component();
+
+		void perf_events(Thread_capability, Perf_events) override;
+		Perf_counts perf_counts(Thread_capability) override;
+};
+
+#endif /* _CORE__INCLUDE__NATIVE_CPU_COMPONENT_H_ */
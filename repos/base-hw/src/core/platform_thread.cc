@@ -164,8 +164,10 @@ int Platform_thread::start(void * const ip, void * const sp)
 		return -1;
 	}
 
-	unsigned const cpu =
-		_location.valid() ? _location.xpos() : Cpu::primary_id();
+	/* threads without strict affinity may be migrated within their location */
+	Kernel::Call_arg const cpus = _location.valid()
+		? Kernel::cpu_set(_location.xpos(), _location.width())
+		: Kernel::cpu_set(Cpu::primary_id(), 1);
 
 	Native_utcb * utcb = Thread::myself()->utcb();
 
@@ -176,7 +178,7 @@ int Platform_thread::start(void * const ip, void * const sp)
 		utcb->cap_add(Capability_space::capid(_pd->parent()));
 		utcb->cap_add(Capability_space::capid(_utcb));
 	}
-	Kernel::start_thread(kernel_object(), cpu, &_pd->kernel_pd(),
+	Kernel::start_thread(kernel_object(), cpus, &_pd->kernel_pd(),
 	                     _utcb_core_addr);
 	return 0;
 }
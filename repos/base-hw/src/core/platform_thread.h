@@ -152,6 +152,23 @@ namespace Genode {
 			void cancel_blocking() {
 				Kernel::cancel_thread_blocking(kernel_object()); }
 
+			/**
+			 * Select the events that the performance counter counts for us
+			 *
+			 * \param events  'Kernel::Perf_counter::MAX_EVENTS' events
+			 */
+			void perf_events(Kernel::Perf_counter::Event const *events) {
+				Kernel::thread_perf_events(kernel_object(), events); }
+
+			/**
+			 * Read the event counts of the thread
+			 *
+			 * \param counts  destination of 'Kernel::Perf_counter::MAX_EVENTS'
+			 *                counts
+			 */
+			void perf_counts(uint64_t *counts) {
+				Kernel::thread_perf_counts(kernel_object(), counts); }
+
 			/**
 			 * Set CPU quota of the thread to 'quota'
 			 */
@@ -194,6 +211,18 @@ namespace Genode {
 			 */
 			unsigned long long execution_time() const { return 0; }
 
+			/**
+			 * Return number of migrations of the thread between CPUs
+			 */
+			unsigned long migrations() const {
+				return kernel_object()->migrations(); }
+
+			/**
+			 * Return number of wake-ups of the thread from a blocking state
+			 */
+			unsigned long wakeups() const {
+				return kernel_object()->wakeups(); }
+
 
 			/***************
 			 ** Accessors **
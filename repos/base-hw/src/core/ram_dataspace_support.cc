@@ -65,3 +65,36 @@ void Ram_dataspace_factory::_clear_ds (Dataspace_component * ds)
 	platform()->region_alloc()->free(virt_addr, page_rounded_size);
 }
 
+
+bool Ram_dataspace_factory::_clear_ahead(addr_t phys, size_t size)
+{
+	if (!size)
+		return true;
+
+	size_t page_rounded_size = (size + get_page_size() - 1) & get_page_mask();
+
+	void *virt_addr;
+	if (!platform()->region_alloc()->alloc(page_rounded_size, &virt_addr))
+		return false;
+
+	size_t num_pages = page_rounded_size >> get_page_size_log2();
+	if (!map_local(phys, (addr_t)virt_addr, num_pages)) {
+		platform()->region_alloc()->free(virt_addr, page_rounded_size);
+		return false;
+	}
+
+	memset(virt_addr, 0, page_rounded_size);
+
+	/*
+	 * The memory may end up in an uncached dataspace, so the zeroes must
+	 * reach physical memory regardless of the current use.
+	 */
+	Kernel::update_data_region((addr_t)virt_addr, page_rounded_size);
+	Kernel::update_instr_region((addr_t)virt_addr, page_rounded_size);
+
+	if (!unmap_local((addr_t)virt_addr, num_pages))
+		error("could not unmap core-local address range at ", virt_addr);
+
+	platform()->region_alloc()->free(virt_addr, page_rounded_size);
+	return true;
+}
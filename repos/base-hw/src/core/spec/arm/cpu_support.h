@@ -150,6 +150,8 @@ struct Genode::Arm_cpu : public Hw::Arm_cpu
 
 	bool retry_undefined_instr(Context&) { return false; }
 
+	void release_fpu(Context&) { }
+
 	/**
 	 * Return kernel name of the executing CPU
 	 */
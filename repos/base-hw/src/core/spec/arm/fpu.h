@@ -221,6 +221,20 @@ class Genode::Fpu
 		 */
 		void unset(Context &context) {
 			if (_context == &context) _context = nullptr; }
+
+		/**
+		 * Save and unset FPU context, e.g., before its thread changes the CPU
+		 */
+		void release(Context &context)
+		{
+			if (_context != &context) return;
+
+			_enable();
+			_save();
+			_context->_fpu = nullptr;
+			_context = nullptr;
+			_disable();
+		}
 };
 
 /*
@@ -106,6 +106,13 @@ void Kernel::Perf_counter::enable()
 }
 
 
+/*
+ * The event counters of the ARM11 are not virtualized per thread
+ */
+void Kernel::Perf_counter::load(Context const &) { }
+void Kernel::Perf_counter::save(Context &)       { }
+
+
 Kernel::Perf_counter* Kernel::perf_counter()
 {
 	static Kernel::Perf_counter inst;
@@ -167,6 +167,98 @@ struct Pmuseren : Register<32>
 };
 
 
+/**
+ * Performance Counter Selection Register
+ */
+struct Pmselr : Register<32>
+{
+	struct Sel : Bitfield<0,5> { }; /* counter accessed via 'Pmxev*' */
+
+	static void write(access_t const v) {
+		asm volatile("mcr p15, 0, %[v], c9, c12, 5" :: [v]"r"(v) : ); }
+};
+
+
+/**
+ * Event Type Select Register of the selected counter
+ */
+struct Pmxevtyper : Register<32>
+{
+	struct Evt_count : Bitfield<0,8> { };
+
+	enum {
+		L1D_CACHE_REFILL = 0x03,
+		L1D_TLB_REFILL   = 0x05,
+		INSTR_EXECUTED   = 0x08,
+		BR_MIS_PRED      = 0x10,
+	};
+
+	static void write(access_t const v) {
+		asm volatile("mcr p15, 0, %[v], c9, c13, 1" :: [v]"r"(v) : ); }
+};
+
+
+/**
+ * Event Count Register of the selected counter
+ */
+struct Pmxevcntr : Register<32>
+{
+	static access_t read()
+	{
+		access_t v;
+		asm volatile("mrc p15, 0, %[v], c9, c13, 2" : [v]"=r"(v) :: );
+		return v;
+	}
+
+	static void write(access_t const v) {
+		asm volatile("mcr p15, 0, %[v], c9, c13, 2" :: [v]"r"(v) : ); }
+};
+
+
+/**
+ * Return event number of the architecture for 'event', or 0 if unsupported
+ */
+static Pmxevtyper::access_t evt_count(Kernel::Perf_counter::Event const event)
+{
+	using Kernel::Perf_counter;
+
+	switch (event) {
+	case Perf_counter::INSTRUCTIONS:  return Pmxevtyper::INSTR_EXECUTED;
+	case Perf_counter::CACHE_MISSES:  return Pmxevtyper::L1D_CACHE_REFILL;
+	case Perf_counter::BRANCH_MISSES: return Pmxevtyper::BR_MIS_PRED;
+	case Perf_counter::TLB_MISSES:    return Pmxevtyper::L1D_TLB_REFILL;
+	case Perf_counter::NONE:          break;
+	}
+	return 0;
+}
+
+
+void Kernel::Perf_counter::load(Context const &context)
+{
+	for (unsigned i = 0; i < MAX_EVENTS; i++) {
+		Pmxevtyper::access_t const evt = evt_count(context.event[i]);
+		if (!evt)
+			continue;
+
+		Pmselr::write(Pmselr::Sel::bits(i));
+		Pmxevtyper::write(Pmxevtyper::Evt_count::bits(evt));
+		Pmxevcntr::write(0);
+	}
+}
+
+
+void Kernel::Perf_counter::save(Context &context)
+{
+	for (unsigned i = 0; i < MAX_EVENTS; i++) {
+		if (!evt_count(context.event[i]))
+			continue;
+
+		Pmselr::write(Pmselr::Sel::bits(i));
+		context.count[i] += Pmxevcntr::read();
+	}
+}
+
+
 void Kernel::Perf_counter::enable()
 {
 	/* program PMU and enable all counters */
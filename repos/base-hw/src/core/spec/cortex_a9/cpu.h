@@ -55,6 +55,11 @@ class Genode::Cpu : public Arm_v7_cpu
 		bool retry_undefined_instr(Context & context) {
 			return _fpu.fault(context); }
 
+		/**
+		 * Write back the FPU state of 'context' if held by this CPU
+		 */
+		void release_fpu(Context & context) { _fpu.release(context); }
+
 		/**
 		 * Write back dirty cache lines and invalidate whole data cache
 		 */
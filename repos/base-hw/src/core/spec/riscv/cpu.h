@@ -78,6 +78,11 @@ class Genode::Cpu : public Hw::Riscv_cpu
 		static void invalidate_tlb_by_pid(unsigned const pid) { sfence(); }
 
 		void switch_to(Mmu_context & context);
+
+		/**
+		 * Withdraw the FPU state of 'context', not applicable
+		 */
+		void release_fpu(Context&) { }
 		static void mmu_fault(Context & c, Kernel::Thread_fault & f);
 
 		static unsigned executing_id() { return 0; }
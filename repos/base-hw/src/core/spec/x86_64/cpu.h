@@ -113,6 +113,11 @@ class Genode::Cpu : public Hw::X86_64_cpu
 
 		Fpu & fpu() { return _fpu; }
 
+		/**
+		 * Write back the FPU state of 'context' if held by this CPU
+		 */
+		void release_fpu(Context & context) { _fpu.release(context); }
+
 		/**
 		 * Return wether to retry an undefined user instruction after this call
 		 */
@@ -140,6 +140,20 @@ class Genode::Fpu
 		 */
 		void unset(Context &context) {
 			if (_context == &context) _context = nullptr; }
+
+		/**
+		 * Save and unset FPU context, e.g., before its thread changes the CPU
+		 */
+		void release(Context &context)
+		{
+			if (_context != &context) return;
+
+			enable();
+			_save();
+			_context->_fpu = nullptr;
+			_context = nullptr;
+			disable();
+		}
 };
 
 #endif /* _CORE__SPEC__X86_64__FPU_H_ */
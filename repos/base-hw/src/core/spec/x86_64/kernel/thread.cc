@@ -19,7 +19,23 @@
 #include <kernel/pd.h>
 
 
-void Kernel::Thread::_call_update_data_region() { }
+void Kernel::Thread::_call_update_data_region()
+{
+	/*
+	 * The region is flushed from the data cache, so that mappings of other
+	 * memory types observe its content. The call is used by core only,
+	 * whose address space is active while the kernel handles the call.
+	 */
+	enum { CACHE_LINE_SIZE = 64 };
+
+	addr_t const base = (addr_t)user_arg_1() & ~(addr_t)(CACHE_LINE_SIZE - 1);
+	addr_t const end  = (addr_t)user_arg_1() + (size_t)user_arg_2();
+
+	for (addr_t line = base; line < end; line += CACHE_LINE_SIZE)
+		asm volatile ("clflush (%0)" :: "r" (line) : "memory");
+
+	asm volatile ("mfence" ::: "memory");
+}
 
 
 void Kernel::Thread::_call_update_instr_region() { }
@@ -40,9 +40,16 @@ namespace Genode
 	 * argument. If a kernel only supports a certain set of map sizes such
 	 * as 4K and 4M, this function should select one of those smaller or
 	 * equal to the argument.
+	 *
+	 * The translation tables of base-hw split a mapping into the largest
+	 * blocks supported by the MMU, e.g., 1M sections on ARM or 2M and 1G
+	 * pages on x86_64. Hence, a fault within a large and suitably aligned
+	 * RAM or I/O-memory region is answered by mapping up to 1G at once,
+	 * which resolves the region with a few faults instead of one per
+	 * megabyte.
 	 */
 	constexpr size_t constrain_map_size_log2(size_t size_log2) {
-		return (size_log2 < 20) ? 12 : 20; }
+		return (size_log2 < 20) ? 12 : ((size_log2 < 30) ? size_log2 : 30); }
 }
 
 #endif /* _CORE__UTIL_H_ */
@@ -78,6 +78,17 @@ struct Hw::X86_64_cpu
 		struct Smep       : Bitfield<20, 1> { }; /* SMEP Enable */
 		struct Smap       : Bitfield<21, 1> { }; /* SMAP Enable */
 	);
+
+	/**
+	 * Page attribute table
+	 *
+	 * See Intel SDM Vol. 3A, section 11.12.
+	 */
+	X86_64_MSR_REGISTER(Ia32_pat, 0x277,
+		enum { WRITE_COMBINING = 1 };
+
+		struct Pa1 : Bitfield<8, 3> { };
+	);
 };
 
 #endif /* _SRC__LIB__HW__SPEC__X86_64__CPU_H_ */
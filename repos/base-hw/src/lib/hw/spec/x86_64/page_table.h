@@ -90,6 +90,24 @@ namespace Hw
 				| Xd::bits(!flags.executable);
 		}
 
+		/**
+		 * Return memory-type bits of a page-frame mapping
+		 *
+		 * The bits select one of the first four entries of the page
+		 * attribute table, with entry 1 programmed to write-combining by
+		 * bootstrap. Where the table is left untouched, write-combined
+		 * mappings fall back to write-through.
+		 */
+		static access_t memory_type(Page_flags const &flags)
+		{
+			switch (flags.cacheable) {
+			case Genode::WRITE_COMBINED: return Pwt::bits(1);
+			case Genode::UNCACHED:       return Pwt::bits(1) | Pcd::bits(1);
+			case Genode::CACHED:         break;
+			}
+			return 0;
+		}
+
 		/**
 		 * Return descriptor value with cleared accessed and dirty flags. These
 		 * flags can be set by the MMU.
@@ -128,8 +146,8 @@ class Hw::Level_4_translation_table
 
 			static access_t create(Page_flags const &flags, addr_t const pa)
 			{
-				/* XXX: Set memory type depending on active PAT */
 				return Common::create(flags)
+					| Common::memory_type(flags)
 					| G::bits(flags.global)
 					| Pa::masked(pa);
 			}
@@ -307,8 +325,8 @@ class Hw::Page_directory
 			static typename Base::access_t create(Page_flags const &flags,
 			                                      addr_t const pa)
 			{
-				/* XXX: Set memory type depending on active PAT */
 				return Base::create(flags)
+					| Base::memory_type(flags)
 					| Base::Ps::bits(1)
 					| G::bits(flags.global)
 					| Pa::masked(pa);
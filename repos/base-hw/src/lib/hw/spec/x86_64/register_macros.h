@@ -32,4 +32,21 @@
 		__VA_ARGS__; \
 	};
 
+#define X86_64_MSR_REGISTER(name, msr, ...) \
+	struct name : Genode::Register<64> \
+	{ \
+		static access_t read() \
+		{ \
+			Genode::uint32_t low, high; \
+			asm volatile ("rdmsr" : "=a" (low), "=d" (high) : "c" (msr)); \
+			return (access_t)high << 32 | low; \
+		} \
+ \
+		static void write(access_t const v) { \
+			asm volatile ("wrmsr" :: "a" ((Genode::uint32_t)v), \
+			              "d" ((Genode::uint32_t)(v >> 32)), "c" (msr)); } \
+ \
+		__VA_ARGS__; \
+	};
+
 #endif /* _SRC__LIB__HW__SPEC__X86_64__REGISTER_MACROS_H_ */
@@ -65,3 +65,8 @@ void Ram_dataspace_factory::_revoke_ram_ds(Dataspace_component *ds)
 
 
 void Ram_dataspace_factory::_clear_ds(Dataspace_component *ds) { }
+
+
+
+/* dataspaces are backed by new files, which are always empty */
+bool Ram_dataspace_factory::_clear_ahead(addr_t, size_t) { return false; }
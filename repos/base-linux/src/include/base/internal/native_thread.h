@@ -48,6 +48,18 @@ struct Genode::Native_thread
 
 	Socket_pair socket_pair;
 
+	/**
+	 * Datagram socket pair for receiving RPC replies
+	 *
+	 * The pair is created by the first RPC call of the thread and reused
+	 * by subsequent calls.
+	 */
+	struct Reply_socket_pair
+	{
+		int local_sd  = -1;
+		int remote_sd = -1;
+	} reply_socket_pair;
+
 	Native_thread() { }
 };
 
@@ -360,34 +360,55 @@ Rpc_exception_code Genode::ipc_call(Native_capability dst,
 	                sizeof(Protocol_header) + snd_msgbuf.data_size());
 
 	/*
-	 * Create reply channel
+	 * Obtain reply channel
 	 *
-	 * The reply channel will be closed when leaving the scope of 'lx_call'.
+	 * Threads keep their reply channel across calls, which spares the
+	 * creation and destruction of a socket pair per call. The main thread
+	 * has no 'Native_thread' and uses a new socket pair for each call,
+	 * which is closed when leaving the scope of 'ipc_call'.
 	 */
 	struct Reply_channel
 	{
-		enum { LOCAL_SOCKET = 0, REMOTE_SOCKET = 1 };
-		int sd[2];
+		typedef Native_thread::Reply_socket_pair Socket_pair;
 
-		Reply_channel()
+		Socket_pair  _own { };
+		Socket_pair &_sp;
+
+		static Socket_pair &_socket_pair(Socket_pair &own)
 		{
-			sd[LOCAL_SOCKET] = -1; sd[REMOTE_SOCKET] = -1;
+			Thread * const myself = Thread::myself();
+			return myself ? myself->native_thread().reply_socket_pair : own;
+		}
 
+		Reply_channel() : _sp(_socket_pair(_own))
+		{
+			if (_sp.local_sd != -1)
+				return;
+
+			int sd[2] = { -1, -1 };
 			int ret = lx_socketpair(AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC, 0, sd);
 			if (ret < 0) {
 				PRAW("[%d] lx_socketpair failed with %d", lx_getpid(), ret);
 				throw Genode::Ipc_error();
 			}
+			_sp.local_sd  = sd[0];
+			_sp.remote_sd = sd[1];
 		}
 
-		~Reply_channel()
+		~Reply_channel() { if (&_sp == &_own) close(); }
+
+		/**
+		 * Close socket pair, e.g., if a late reply might still arrive
+		 */
+		void close()
 		{
-			if (sd[LOCAL_SOCKET]  != -1) lx_close(sd[LOCAL_SOCKET]);
-			if (sd[REMOTE_SOCKET] != -1) lx_close(sd[REMOTE_SOCKET]);
+			if (_sp.local_sd  != -1) lx_close(_sp.local_sd);
+			if (_sp.remote_sd != -1) lx_close(_sp.remote_sd);
+			_sp = Socket_pair();
 		}
 
-		int local_socket()  const { return sd[LOCAL_SOCKET];  }
-		int remote_socket() const { return sd[REMOTE_SOCKET]; }
+		int local_socket()  const { return _sp.local_sd;  }
+		int remote_socket() const { return _sp.remote_sd; }
 
 	} reply_channel;
 
@@ -420,12 +441,20 @@ Rpc_exception_code Genode::ipc_call(Native_capability dst,
 	rcv_msgbuf.reset();
 	int const recv_ret = lx_recvmsg(reply_channel.local_socket(), rcv_msg.msg(), 0);
 
-	/* system call got interrupted by a signal */
-	if (recv_ret == -LX_EINTR)
+	/*
+	 * System call got interrupted by a signal
+	 *
+	 * The server may still reply to the canceled call. Hence, the reply
+	 * channel must not be used for subsequent calls.
+	 */
+	if (recv_ret == -LX_EINTR) {
+		reply_channel.close();
 		throw Genode::Blocking_canceled();
+	}
 
 	if (recv_ret < 0) {
 		PRAW("[%d] lx_recvmsg failed with %d in lx_call()", lx_getpid(), recv_ret);
+		reply_channel.close();
 		throw Genode::Ipc_error();
 	}
 
@@ -129,6 +129,11 @@ void Thread::_deinit_platform_thread()
 		lx_nanosleep(&ts, 0);
 	}
 
+	/* close reply channel used by the thread's RPC calls */
+	Native_thread::Reply_socket_pair &reply_sp = native_thread().reply_socket_pair;
+	if (reply_sp.local_sd  != -1) lx_close(reply_sp.local_sd);
+	if (reply_sp.remote_sd != -1) lx_close(reply_sp.remote_sd);
+
 	/* inform core about the killed thread */
 	_cpu_session->kill_thread(_thread_cap);
 }
@@ -543,6 +543,11 @@ Thread::~Thread()
 			        "with ", ret, " (errno=", errno, ")");
 	}
 
+	/* close reply channel used by the thread's RPC calls */
+	Native_thread::Reply_socket_pair &reply_sp = native_thread().reply_socket_pair;
+	if (reply_sp.local_sd  != -1) lx_close(reply_sp.local_sd);
+	if (reply_sp.remote_sd != -1) lx_close(reply_sp.remote_sd);
+
 	Thread_meta_data_created *meta_data =
 		dynamic_cast<Thread_meta_data_created *>(native_thread().meta_data);
 
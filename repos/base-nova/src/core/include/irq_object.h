@@ -25,6 +25,7 @@ class Genode::Irq_object
 		Genode::addr_t            _msi_addr;
 		Genode::addr_t            _msi_data;
 		Genode::addr_t            _device_phys; /* PCI config extended address */
+		Genode::addr_t            _cpu;         /* kernel CPU receiving the IRQ */
 
 		enum { KERNEL_CAP_COUNT_LOG2 = 0 };
 
@@ -41,7 +42,7 @@ class Genode::Irq_object
 		void sigh(Signal_context_capability cap);
 		void ack_irq();
 
-		void start(unsigned irq, Genode::addr_t);
+		void start(unsigned irq, Genode::addr_t, Genode::addr_t cpu);
 };
 
 #endif /* _CORE__INCLUDE__IRQ_OBJECT_H_ */
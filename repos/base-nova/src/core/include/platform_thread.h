@@ -199,6 +199,16 @@ namespace Genode {
 			 * Return execution time consumed by the thread
 			 */
 			unsigned long long execution_time() const;
+
+			/**
+			 * Return number of migrations of the thread between CPUs
+			 */
+			unsigned long migrations() const { return 0; }
+
+			/**
+			 * Return number of wake-ups of the thread from a blocking state
+			 */
+			unsigned long wakeups() const { return 0; }
 	};
 }
 
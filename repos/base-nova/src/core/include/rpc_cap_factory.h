@@ -15,7 +15,7 @@
 #define _CORE__INCLUDE__RPC_CAP_FACTORY_H_
 
 /* Genode includes */
-#include <util/list.h>
+#include <util/avl_tree.h>
 #include <base/lock.h>
 #include <base/capability.h>
 #include <base/tslab.h>
@@ -28,20 +28,50 @@ class Genode::Rpc_cap_factory
 {
 	private:
 
-		struct Cap_object : List<Cap_object>::Element
+		/*
+		 * The cap objects are organized by their selectors, which makes
+		 * the lookup on 'free' cheap and allows for revoking consecutive
+		 * selectors at once.
+		 */
+		struct Cap_object : Avl_node<Cap_object>
 		{
 			Genode::addr_t _cap_sel;
 
 			Cap_object(addr_t cap_sel) : _cap_sel(cap_sel) {}
+
+			bool higher(Cap_object *other) const {
+				return other->_cap_sel > _cap_sel; }
+
+			Cap_object *find_by_sel(addr_t sel)
+			{
+				if (sel == _cap_sel) return this;
+
+				Cap_object *obj = this->child(sel > _cap_sel);
+				return obj ? obj->find_by_sel(sel) : nullptr;
+			}
 		};
 
 		enum { SBS = 960*sizeof(long) };
 		uint8_t _initial_sb[SBS];
 
 		Tslab<Cap_object, SBS> _slab;
-		List<Cap_object>       _list;
+		Avl_tree<Cap_object>   _tree;
 		Lock                   _lock;
 
+		Cap_object *_find(addr_t sel) {
+			return _tree.first() ? _tree.first()->find_by_sel(sel) : nullptr; }
+
+		void _destroy(Cap_object *obj)
+		{
+			_tree.remove(obj);
+			destroy(&_slab, obj);
+		}
+
+		/**
+		 * Revoke selector range with as few syscalls as possible
+		 */
+		static void _revoke(addr_t sel, addr_t count);
+
 	public:
 
 		Rpc_cap_factory(Allocator &md_alloc);
@@ -27,12 +27,12 @@
 using namespace Genode;
 
 
-static bool irq_ctrl(Genode::addr_t irq_sel,
+static bool irq_ctrl(Genode::addr_t irq_sel, Genode::addr_t cpu,
                      Genode::addr_t &msi_addr, Genode::addr_t &msi_data,
                      Genode::addr_t sig_sel, Genode::addr_t virt_addr = 0)
 {
 	/* assign IRQ to CPU && request msi data to be used by driver */
-	uint8_t res = Nova::assign_gsi(irq_sel, virt_addr, boot_cpu(),
+	uint8_t res = Nova::assign_gsi(irq_sel, virt_addr, cpu,
 	                               msi_addr, msi_data, sig_sel);
 
 	if (res != Nova::NOVA_OK)
@@ -46,26 +46,26 @@ static bool irq_ctrl(Genode::addr_t irq_sel,
 }
 
 
-static bool associate(Genode::addr_t irq_sel,
+static bool associate(Genode::addr_t irq_sel, Genode::addr_t cpu,
                       Genode::addr_t &msi_addr, Genode::addr_t &msi_data,
                       Genode::Signal_context_capability sig_cap,
                       Genode::addr_t virt_addr = 0)
 {
-	return irq_ctrl(irq_sel, msi_addr, msi_data, sig_cap.local_name(),
+	return irq_ctrl(irq_sel, cpu, msi_addr, msi_data, sig_cap.local_name(),
 	                virt_addr);
 }
 
 
-static void deassociate(Genode::addr_t irq_sel)
+static void deassociate(Genode::addr_t irq_sel, Genode::addr_t cpu)
 {
 	addr_t dummy1 = 0, dummy2 = 0;
 
-	if (!irq_ctrl(irq_sel, dummy1, dummy2, irq_sel))
+	if (!irq_ctrl(irq_sel, cpu, dummy1, dummy2, irq_sel))
 		warning("Irq could not be de-associated");
 }
 
 
-static bool msi(Genode::addr_t irq_sel, Genode::addr_t phys_mem,
+static bool msi(Genode::addr_t irq_sel, Genode::addr_t cpu, Genode::addr_t phys_mem,
                 Genode::addr_t &msi_addr, Genode::addr_t &msi_data,
                 Genode::Signal_context_capability sig_cap)
 {
@@ -90,7 +90,7 @@ static bool msi(Genode::addr_t irq_sel, Genode::addr_t phys_mem,
 	}
 
 	/* try to assign MSI to device */
-	bool res = associate(irq_sel, msi_addr, msi_data, sig_cap, virt_addr);
+	bool res = associate(irq_sel, cpu, msi_addr, msi_data, sig_cap, virt_addr);
 
 	unmap_local(Nova::Mem_crd(virt_addr >> 12, 0, Rights(true, true, true)));
 	platform()->region_alloc()->free(virt, 4096);
@@ -105,19 +105,19 @@ void Irq_object::sigh(Signal_context_capability cap)
 		return;
 
 	if ((_sigh_cap.valid() && !cap.valid())) {
-		deassociate(irq_sel());
+		deassociate(irq_sel(), _cpu);
 		_sigh_cap = Signal_context_capability();
 		return;
 	}
 
 	bool ok = false;
 	if (_device_phys)
-		ok = msi(irq_sel(), _device_phys, _msi_addr, _msi_data, cap);
+		ok = msi(irq_sel(), _cpu, _device_phys, _msi_addr, _msi_data, cap);
 	else
-	    ok = associate(irq_sel(), _msi_addr, _msi_data, cap);
+	    ok = associate(irq_sel(), _cpu, _msi_addr, _msi_data, cap);
 
 	if (!ok) {
-		deassociate(irq_sel());
+		deassociate(irq_sel(), _cpu);
 		_sigh_cap = Signal_context_capability();
 		return;
 	}
@@ -133,8 +133,11 @@ void Irq_object::ack_irq()
 }
 
 
-void Irq_object::start(unsigned irq, Genode::addr_t const device_phys)
+void Irq_object::start(unsigned irq, Genode::addr_t const device_phys,
+                       Genode::addr_t const cpu)
 {
+	_cpu = cpu;
+
 	/* map IRQ SM cap from kernel to core at irq_sel selector */
 	using Nova::Obj_crd;
 
@@ -152,9 +155,9 @@ void Irq_object::start(unsigned irq, Genode::addr_t const device_phys)
 	/* associate GSI or MSI to device belonging to device_phys */
 	bool ok = false;
 	if (device_phys)
-		ok = msi(irq_sel(), device_phys, _msi_addr, _msi_data, _sigh_cap);
+		ok = msi(irq_sel(), _cpu, device_phys, _msi_addr, _msi_data, _sigh_cap);
 	else
-		ok = associate(irq_sel(), _msi_addr, _msi_data, _sigh_cap);
+		ok = associate(irq_sel(), _cpu, _msi_addr, _msi_data, _sigh_cap);
 
 	if (!ok)
 		throw Service_denied();
@@ -166,14 +169,14 @@ void Irq_object::start(unsigned irq, Genode::addr_t const device_phys)
 Irq_object::Irq_object()
 :
 	_kernel_caps(cap_map()->insert(KERNEL_CAP_COUNT_LOG2)),
-	_msi_addr(0UL), _msi_data(0UL)
+	_msi_addr(0UL), _msi_data(0UL), _device_phys(0UL), _cpu(boot_cpu())
 { }
 
 
 Irq_object::~Irq_object()
 {
 	if (_sigh_cap.valid())
-		deassociate(irq_sel());
+		deassociate(irq_sel(), _cpu);
 
 	/* revoke IRQ SM */
 	Nova::revoke(Nova::Obj_crd(_kernel_caps, KERNEL_CAP_COUNT_LOG2));
@@ -223,7 +226,22 @@ Irq_session_component::Irq_session_component(Range_allocator *irq_alloc,
 
 	_irq_number = irq_number;
 
-	_irq_object.start(_irq_number, device_phys);
+	/*
+	 * MSIs may be steered to any CPU, e.g., the CPU serving the device
+	 * queue that belongs to the MSI-X vector. GSIs stay at the boot CPU.
+	 */
+	addr_t cpu = boot_cpu();
+	long const genode_cpu = Arg_string::find_arg(args, "irq_cpu").long_value(-1);
+	if (device_phys && genode_cpu >= 0) {
+		Affinity::Space const space = platform()->affinity_space();
+		if ((unsigned long)genode_cpu < space.total())
+			cpu = platform_specific()->kernel_cpu_id(genode_cpu);
+		else
+			warning("IRQ ", irq_number, ": invalid CPU ", genode_cpu,
+			        " requested, using boot CPU");
+	}
+
+	_irq_object.start(_irq_number, device_phys, cpu);
 }
 
 
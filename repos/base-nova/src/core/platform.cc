@@ -701,7 +701,7 @@ Platform::Platform() :
 	/* core log as ROM module */
 	{
 		void * phys_ptr = nullptr;
-		unsigned const pages  = 1;
+		unsigned const pages  = 1 + CORE_BINARY_LOG_PAGES;
 		size_t const log_size = pages << get_page_size_log2();
 
 		ram_alloc()->alloc_aligned(log_size, &phys_ptr, get_page_size_log2());
@@ -710,10 +710,18 @@ Platform::Platform() :
 		addr_t const core_local_addr = _map_pages(phys_addr, pages, true);
 		memset(reinterpret_cast<void *>(core_local_addr), 0, log_size);
 
-		_rom_fs.insert(new (core_mem_alloc()) Rom_module(phys_addr, log_size,
+		/* the first page holds the text log, the others the binary log */
+		size_t const text_size = get_page_size();
+
+		_rom_fs.insert(new (core_mem_alloc()) Rom_module(phys_addr, text_size,
 		                                                 "core_log"));
+		_rom_fs.insert(new (core_mem_alloc())
+		               Rom_module(phys_addr + text_size, log_size - text_size,
+		                          "core_binary_log"));
 
-		init_core_log( Core_log_range { core_local_addr, log_size } );
+		init_core_log(Core_log_range { core_local_addr, text_size } );
+		init_core_binary_log(Core_log_range { core_local_addr + text_size,
+		                                      log_size - text_size });
 	}
 
 	/* I/O port allocator (only meaningful for x86) */
@@ -96,3 +96,10 @@ void Ram_dataspace_factory::_export_ram_ds(Dataspace_component *ds) {
 	/* assign virtual address to the dataspace to be used by clear_ds */
 	ds->assign_core_local_addr(virt_ptr);
 }
+
+
+/*
+ * Dataspaces are cleared via the core-local mapping established by
+ * '_export_ram_ds', which makes clearing ahead of time pointless.
+ */
+bool Ram_dataspace_factory::_clear_ahead(addr_t, size_t) { return false; }
@@ -36,7 +36,7 @@ Native_capability Rpc_cap_factory::alloc(Native_capability ep, addr_t entry, add
 	if (!pt_cap)
 		return Native_capability();
 
-	_list.insert(pt_cap);
+	_tree.insert(pt_cap);
 
 	/* create portal */
 	uint8_t const res = create_pt(pt_sel, pd_sel, ec_sel, Mtd(mtd), entry);
@@ -50,8 +50,7 @@ Native_capability Rpc_cap_factory::alloc(Native_capability ep, addr_t entry, add
 	      "xpt=",   Hex(pt_sel), " "
 	      "res=",   res);
 
-	_list.remove(pt_cap);
-	destroy(&_slab, pt_cap);
+	_destroy(pt_cap);
 
 	/* cleanup unused selectors */
 	cap_map()->remove(pt_sel, 0, false);
@@ -60,23 +59,37 @@ Native_capability Rpc_cap_factory::alloc(Native_capability ep, addr_t entry, add
 }
 
 
+void Rpc_cap_factory::_revoke(addr_t sel, addr_t count)
+{
+	/* split range into naturally aligned power-of-two blocks */
+	while (count) {
+		uint8_t order = 0;
+		while ((addr_t)2 << order <= count && !(sel & ((2UL << order) - 1)))
+			order++;
+
+		Nova::revoke(Nova::Obj_crd(sel, order));
+		cap_map()->remove(sel, order, false);
+
+		sel   += 1UL << order;
+		count -= 1UL << order;
+	}
+}
+
+
 void Rpc_cap_factory::free(Native_capability cap)
 {
 	if (!cap.valid()) return;
 
 	Lock::Guard guard(_lock);
 
-	for (Cap_object *obj = _list.first(); obj ; obj = obj->next()) {
-		if (cap.local_name() == (long)obj->_cap_sel) {
-			Nova::revoke(Nova::Obj_crd(obj->_cap_sel, 0));
-			cap_map()->remove(obj->_cap_sel, 0, false);
-
-			_list.remove(obj);
-			destroy(&_slab, obj);
-			return;
-		}
+	Cap_object *obj = _find(cap.local_name());
+	if (!obj) {
+		warning("attempt to free invalid cap object");
+		return;
 	}
-	warning("attempt to free invalid cap object");
+
+	_revoke(obj->_cap_sel, 1);
+	_destroy(obj);
 }
 
 
@@ -88,11 +101,24 @@ Rpc_cap_factory::~Rpc_cap_factory()
 {
 	Lock::Guard guard(_lock);
 
-	for (Cap_object *obj; (obj = _list.first()); ) {
-		Nova::revoke(Nova::Obj_crd(obj->_cap_sel, 0));
-		cap_map()->remove(obj->_cap_sel, 0, false);
+	/*
+	 * Revoke the selectors in runs of consecutive selectors, starting
+	 * with the lowest remaining one. Selectors allocated in a row, e.g.,
+	 * by a session storm, are thereby revoked by a single syscall.
+	 */
+	for (Cap_object *obj; (obj = _tree.first()); ) {
+
+		while (Cap_object *lower = obj->child(Cap_object::LEFT))
+			obj = lower;
+
+		addr_t const first = obj->_cap_sel;
+		addr_t       count = 0;
+
+		for (; obj; obj = _find(first + count)) {
+			_destroy(obj);
+			count++;
+		}
 
-		_list.remove(obj);
-		destroy(&_slab, obj);
+		_revoke(first, count);
 	}
 }
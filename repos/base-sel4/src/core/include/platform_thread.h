@@ -133,6 +133,16 @@ class Genode::Platform_thread : public List<Platform_thread>::Element
 		 */
 		unsigned long long execution_time() const;
 
+		/**
+		 * Return number of migrations of the thread between CPUs
+		 */
+		unsigned long migrations() const { return 0; }
+
+		/**
+		 * Return number of wake-ups of the thread from a blocking state
+		 */
+		unsigned long wakeups() const { return 0; }
+
 
 		/************************
 		 ** Accessor functions **
@@ -73,3 +73,10 @@ void Ram_dataspace_factory::_clear_ds (Dataspace_component *ds)
 	/* free core's virtual address space */
 	platform()->region_alloc()->free(virt_addr_ptr, get_page_size());
 }
+
+
+/*
+ * Memory can be mapped only after its conversion to page frames, which
+ * happens for exported dataspaces only.
+ */
+bool Ram_dataspace_factory::_clear_ahead(addr_t, size_t) { return false; }
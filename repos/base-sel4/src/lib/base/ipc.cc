@@ -31,15 +31,25 @@ using namespace Genode;
 
 /**
  * Message-register definitions
+ *
+ * The number of capability arguments is conveyed as message label. Only
+ * the RPC object keys of the present capabilities are transferred, followed
+ * by the data payload. This way, messages without capability arguments
+ * remain small enough to take the kernel's IPC fastpath, which is limited
+ * to messages that fit into the fast message registers.
  */
 enum {
 	MR_IDX_EXC_CODE = 0,
-	MR_IDX_NUM_CAPS = 1,
-	MR_IDX_CAPS     = 2,
-	MR_IDX_DATA     = MR_IDX_CAPS + Msgbuf_base::MAX_CAPS_PER_MSG,
+	MR_IDX_CAPS     = 1,
 };
 
 
+/**
+ * Return index of the first data word of a message with 'num_caps' caps
+ */
+static constexpr size_t mr_idx_data(size_t num_caps) { return MR_IDX_CAPS + num_caps; }
+
+
 /**
  * Return reference to receive selector of the calling thread
  */
@@ -86,7 +96,6 @@ static seL4_MessageInfo_t new_seL4_message(Msgbuf_base const &msg)
 	/*
 	 * Supply capabilities to kernel IPC message
 	 */
-	seL4_SetMR(MR_IDX_NUM_CAPS, msg.used_caps());
 	size_t sel4_sel_cnt = 0;
 	for (size_t i = 0; i < msg.used_caps(); i++) {
 
@@ -103,26 +112,24 @@ static seL4_MessageInfo_t new_seL4_message(Msgbuf_base const &msg)
 		}
 	}
 
-	/*
-	 * Pad unused capability slots with invalid capabilities to avoid
-	 * leakage of any information that happens to be in the IPC buffer.
-	 */
-	for (size_t i = msg.used_caps(); i < Msgbuf_base::MAX_CAPS_PER_MSG; i++)
-		seL4_SetMR(MR_IDX_CAPS + i, Rpc_obj_key::INVALID);
-
 	/*
 	 * Supply data payload
+	 *
+	 * The payload directly follows the used capability slots. Unused slots
+	 * are not part of the message, so no stale IPC-buffer content leaks.
 	 */
 	size_t const num_data_mwords =
 		align_natural(msg.data_size()) / sizeof(umword_t);
 
+	size_t const mr_idx_data_start = mr_idx_data(msg.used_caps());
+
 	umword_t const *src = (umword_t const *)msg.data();
 	for (size_t i = 0; i < num_data_mwords; i++)
-		seL4_SetMR(MR_IDX_DATA + i, *src++);
+		seL4_SetMR(mr_idx_data_start + i, *src++);
 
 	seL4_MessageInfo_t const msg_info =
-		seL4_MessageInfo_new(0, 0, sel4_sel_cnt,
-		                     MR_IDX_DATA + num_data_mwords);
+		seL4_MessageInfo_new(msg.used_caps(), 0, sel4_sel_cnt,
+		                     mr_idx_data_start + num_data_mwords);
 	return msg_info;
 }
 
@@ -139,7 +146,8 @@ static void decode_seL4_message(seL4_MessageInfo_t const &msg_info,
 	 * You must not use any Genode primitives which may corrupt the IPCBuffer
 	 * during this step, e.g. Lock or RPC for output !!!
 	 */
-	size_t const num_caps = min(seL4_GetMR(MR_IDX_NUM_CAPS), Msgbuf_base::MAX_CAPS_PER_MSG);
+	size_t const num_caps = min((size_t)seL4_MessageInfo_get_label(msg_info),
+	                            (size_t)Msgbuf_base::MAX_CAPS_PER_MSG);
 	uint32_t const caps_extra = seL4_MessageInfo_get_extraCaps(msg_info);
 	uint32_t const caps_unwrapped = seL4_MessageInfo_get_capsUnwrapped(msg_info);
 	uint32_t const num_msg_words = seL4_MessageInfo_get_length(msg_info);
@@ -164,16 +172,18 @@ static void decode_seL4_message(seL4_MessageInfo_t const &msg_info,
 	 * Extract message data payload
 	 */
 
+	size_t const mr_idx_data_start = mr_idx_data(num_caps);
+
 	/* detect malformed message with too small header */
-	if (num_msg_words >= MR_IDX_DATA) {
+	if (num_msg_words >= mr_idx_data_start) {
 
 		/* copy data payload */
 		size_t const max_words      = dst_msg.capacity()/sizeof(umword_t);
-		size_t const num_data_words = min(num_msg_words - MR_IDX_DATA, max_words);
+		size_t const num_data_words = min(num_msg_words - mr_idx_data_start, max_words);
 
 		umword_t *dst = (umword_t *)dst_msg.data();
 		for (size_t i = 0; i < num_data_words; i++)
-			*dst++ = seL4_GetMR(MR_IDX_DATA + i);
+			*dst++ = seL4_GetMR(mr_idx_data_start + i);
 
 		dst_msg.data_size(num_data_words*sizeof(umword_t));
 	}
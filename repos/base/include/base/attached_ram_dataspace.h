@@ -75,12 +75,8 @@ class Genode::Attached_ram_dataspace
 			 * work-around for this issues, we eagerly map the whole
 			 * dataspace before writing actual content to it.
 			 */
-			if (_cached != CACHED) {
-				enum { PAGE_SIZE = 4096 };
-				unsigned char volatile *base = (unsigned char volatile *)_local_addr;
-				for (size_t i = 0; i < _size; i += PAGE_SIZE)
-					touch_read_write(base + i);
-			}
+			if (_cached != CACHED)
+				prefault();
 		}
 
 	public:
@@ -141,6 +137,22 @@ class Genode::Attached_ram_dataspace
 		 */
 		size_t size() const { return _size; }
 
+		/**
+		 * Populate the mappings of the whole dataspace
+		 *
+		 * This method is a hint for large buffers that are accessed right
+		 * after the allocation. Core answers each fault with the largest
+		 * mapping supported by the kernel, so that the pages covered by a
+		 * previous fault are merely touched.
+		 */
+		void prefault()
+		{
+			enum { PAGE_SIZE = 4096 };
+			unsigned char volatile *base = (unsigned char volatile *)_local_addr;
+			for (size_t i = 0; i < _size; i += PAGE_SIZE)
+				touch_read_write(base + i);
+		}
+
 		void swap(Attached_ram_dataspace &other)
 		{
 			_swap(_size,        other._size);
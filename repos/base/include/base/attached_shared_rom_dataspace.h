@@ -0,0 +1,245 @@
+/*
+ * \brief  ROM dataspace whose updates are obtained without RPC
+ * \author Genode Labs
+ * \date   2026-10-14
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__BASE__ATTACHED_SHARED_ROM_DATASPACE_H_
+#define _INCLUDE__BASE__ATTACHED_SHARED_ROM_DATASPACE_H_
+
+#include <util/reconstructible.h>
+#include <util/xml_node.h>
+#include <base/attached_dataspace.h>
+#include <base/attached_ram_dataspace.h>
+#include <base/log.h>
+#include <rom_session/connection.h>
+#include <cpu/memory_barrier.h>
+
+namespace Genode { class Attached_shared_rom_dataspace; }
+
+
+/**
+ * Variant of 'Attached_rom_dataspace' that takes advantage of servers that
+ * update the ROM content in a shared dataspace
+ *
+ * On 'update', the content is copied from the shared dataspace to a
+ * private buffer. In contrast to 'Attached_rom_dataspace', no RPC is
+ * involved unless the content grew beyond the capacity of the shared
+ * dataspace. With servers that lack support for shared dataspaces, the
+ * regular ROM-session protocol is used.
+ */
+class Genode::Attached_shared_rom_dataspace : Noncopyable
+{
+	private:
+
+		typedef Rom_session::Shared_header Header;
+
+		enum { MAX_COPY_ATTEMPTS = 4 };
+
+		Env           &_env;
+		Rom_connection _rom;
+
+		/* dataspace updated by the server, invalid if unsupported */
+		Constructible<Attached_dataspace> _shared;
+
+		/* private copy of the shared content */
+		Constructible<Attached_ram_dataspace> _copy;
+
+		size_t _size = 0;
+
+		/* dataspace used with servers that lack the shared mode */
+		Constructible<Attached_dataspace> _ds;
+
+		bool _shared_mode = false;
+
+		Header const &_header() const {
+			return *_shared->local_addr<Header const>(); }
+
+		void _attach_shared()
+		{
+			/* the server may replace the dataspace, see 'dataspace()' */
+			_shared.destruct();
+			try {
+				Rom_dataspace_capability const ds = _rom.shared_dataspace();
+				if (ds.valid())
+					_shared.construct(_env.rm(), ds);
+			}
+			catch (Attached_dataspace::Invalid_dataspace) { }
+		}
+
+		void _try_attach()
+		{
+			_ds.destruct();
+			try { _ds.construct(_env.rm(), _rom.dataspace()); }
+			catch (Attached_dataspace::Invalid_dataspace) { }
+		}
+
+		/**
+		 * Copy content from the shared dataspace unless it is modified
+		 * concurrently
+		 */
+		bool _try_copy()
+		{
+			Header const &header = _header();
+
+			unsigned long const generation = header.generation;
+			if (generation & 1)
+				return false;
+
+			memory_barrier();
+
+			size_t const capacity = _shared->size() - Rom_session::SHARED_CONTENT_OFFSET;
+			size_t const size     = min((size_t)header.size, capacity);
+
+			/* reserve space for a terminating zero */
+			if (!_copy.constructed() || _copy->size() < size + 1)
+				_copy.construct(_env.ram(), _env.rm(),
+				                max(size + 1, _copy.constructed() ? 2*_copy->size()
+				                                                  : (size_t)0));
+
+			memcpy(_copy->local_addr<char>(),
+			       _shared->local_addr<char const>() + Rom_session::SHARED_CONTENT_OFFSET,
+			       size);
+			_copy->local_addr<char>()[size] = 0;
+
+			memory_barrier();
+
+			if (header.generation != generation)
+				return false;
+
+			_size = size;
+			return true;
+		}
+
+		/**
+		 * Obtain the content via 'dataspace' from now on
+		 */
+		void _fall_back_to_copying()
+		{
+			_shared_mode = false;
+			_copy.destruct();
+			_size = 0;
+			_try_attach();
+		}
+
+		void _update_shared()
+		{
+			if (_header().retired) {
+				_attach_shared();
+
+				/* the server stopped offering a shared dataspace */
+				if (!_shared.constructed()) {
+					_fall_back_to_copying();
+					return;
+				}
+			}
+
+			for (unsigned i = 0; i < MAX_COPY_ATTEMPTS; i++) {
+
+				if (_try_copy())
+					return;
+
+				/*
+				 * The server is modifying the content. It completes the
+				 * modification before responding to an RPC.
+				 */
+				_rom.update();
+			}
+
+			warning("shared ROM content remained inconsistent");
+		}
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \throw Rom_connection::Rom_connection_failed
+		 * \throw Region_map::Region_conflict
+		 * \throw Out_of_ram
+		 * \throw Out_of_caps
+		 */
+		Attached_shared_rom_dataspace(Env &env, char const *name)
+		:
+			_env(env), _rom(env, name)
+		{
+			_attach_shared();
+			_shared_mode = _shared.constructed();
+
+			if (_shared_mode)
+				_update_shared();
+			else
+				_try_attach();
+		}
+
+		/**
+		 * Register signal handler for ROM module changes
+		 */
+		void sigh(Signal_context_capability sigh) { _rom.sigh(sigh); }
+
+		/**
+		 * Update ROM module content
+		 */
+		void update()
+		{
+			if (_shared_mode) {
+				_update_shared();
+				return;
+			}
+
+			if (_ds.constructed() && _rom.update() == true)
+				return;
+
+			_try_attach();
+		}
+
+		/**
+		 * Return true of content is present
+		 */
+		bool valid() const
+		{
+			return _shared_mode ? (_copy.constructed() && _size > 0)
+			                    : _ds.constructed();
+		}
+
+		template <typename T> T const *local_addr() const
+		{
+			if (_shared_mode)
+				return _copy.constructed() ? _copy->local_addr<T const>() : nullptr;
+
+			return _ds.constructed() ? _ds->local_addr<T const>() : nullptr;
+		}
+
+		size_t size() const
+		{
+			if (_shared_mode)
+				return _size;
+
+			return _ds.constructed() ? _ds->size() : 0;
+		}
+
+		/**
+		 * Return dataspace content as XML node
+		 *
+		 * If the dataspace is invalid or does not contain properly
+		 * formatted XML, the returned XML node has the form "<empty/>".
+		 */
+		Xml_node xml() const
+		{
+			try {
+				if (valid() && local_addr<char>())
+					return Xml_node(local_addr<char>(), size());
+			} catch (Xml_node::Invalid_syntax) { }
+
+			return Xml_node("<empty/>");
+		}
+};
+
+#endif /* _INCLUDE__BASE__ATTACHED_SHARED_ROM_DATASPACE_H_ */
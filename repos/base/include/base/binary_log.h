@@ -0,0 +1,256 @@
+/*
+ * \brief  Binary log ring shared between a producer and a consumer
+ * \author Genode Labs
+ * \date   2026-10-14
+ *
+ * Instead of formatting messages as text, a producer stores the ID of a
+ * format string, a timestamp, and a few numeric arguments per record. The
+ * format strings are registered once in a string table that is part of the
+ * shared buffer. Formatting is left to the consumer, which may run at a
+ * much lower rate than the producer.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__BASE__BINARY_LOG_H_
+#define _INCLUDE__BASE__BINARY_LOG_H_
+
+#include <base/stdint.h>
+#include <base/snprintf.h>
+#include <util/string.h>
+#include <cpu/atomic.h>
+#include <cpu/memory_barrier.h>
+
+namespace Genode { class Binary_log; }
+
+
+/**
+ * Lock-free ring of fixed-size log records
+ *
+ * Any number of producers may log concurrently. Each record slot carries a
+ * sequence number, which is cleared while the slot is written and set to
+ * the number of the record plus one once the record is complete. So, the
+ * consumer detects records that are still in progress as well as records
+ * that got overwritten because the consumer could not keep up.
+ */
+class Genode::Binary_log
+{
+	public:
+
+		enum { MAGIC = 0x42696e4c, MAX_ARGS = 5 };
+
+		/**
+		 * Format string of a call site
+		 *
+		 * The object is meant to be a static aggregate at the call site,
+		 * which caches the ID of the string after its first use, e.g.,
+		 *
+		 * ! static Binary_log::Format fmt { "fault at %lx", 0 };
+		 *
+		 * Arguments are stored as 'unsigned long'. Hence, the format
+		 * string must use the 'l' length modifier for all conversions.
+		 */
+		struct Format
+		{
+			char const   *string;
+			int volatile  id;     /* offset in string table plus one */
+		};
+
+		struct Record
+		{
+			int volatile  seq;
+			int           id;
+			uint64_t      timestamp;
+			unsigned long args[MAX_ARGS];
+		};
+
+	private:
+
+		unsigned     _magic;
+		unsigned     _num_records;
+		unsigned     _strings_size;
+		int volatile _next_record;
+		int volatile _strings_used;
+
+		/*
+		 * The string table is followed by the records. No other member
+		 * variables must follow.
+		 */
+		char _strings[0];
+
+		Record *_records() const {
+			return (Record *)((addr_t)_strings + _strings_size); }
+
+		static bool _terminated(char const *s, size_t n)
+		{
+			for (; n; s++, n--)
+				if (!*s)
+					return true;
+
+			return false;
+		}
+
+		static int _fetch_add(int volatile &value, int inc)
+		{
+			for (;;) {
+				int const old = value;
+				if (cmpxchg(&value, old, old + inc))
+					return old;
+			}
+		}
+
+		int _register(Format &fmt)
+		{
+			int const len = strlen(fmt.string) + 1;
+
+			for (;;) {
+				int const used = _strings_used;
+				if (used + len > (int)_strings_size)
+					return 0;
+
+				if (!cmpxchg(&_strings_used, used, used + len))
+					continue;
+
+				memcpy(_strings + used, fmt.string, len);
+
+				/*
+				 * Concurrent registrations of the same format merely
+				 * waste space in the string table.
+				 */
+				fmt.id = used + 1;
+				return fmt.id;
+			}
+		}
+
+		void _record(int id, uint64_t timestamp, unsigned long const *args,
+		             unsigned num_args)
+		{
+			int const n = _fetch_add(_next_record, 1);
+
+			Record &r = _records()[(unsigned)n % _num_records];
+
+			/* mark slot as being written */
+			r.seq = 0;
+			memory_barrier();
+
+			r.id        = id;
+			r.timestamp = timestamp;
+			for (unsigned i = 0; i < MAX_ARGS; i++)
+				r.args[i] = i < num_args ? args[i] : 0;
+
+			/* publish record */
+			memory_barrier();
+			r.seq = n + 1;
+		}
+
+	public:
+
+		/*********************************
+		 ** Functions used by producers **
+		 *********************************/
+
+		/**
+		 * Initialize buffer of 'size' bytes at the address of the object
+		 *
+		 * \param strings_size  bytes reserved for the string table
+		 */
+		void init(size_t size, size_t strings_size)
+		{
+			size_t const header_size = (addr_t)&_strings - (addr_t)this;
+
+			_strings_size = strings_size;
+			_num_records  = (size - header_size - strings_size) / sizeof(Record);
+			_next_record  = 0;
+			_strings_used = 0;
+			_magic        = MAGIC;
+		}
+
+		template <typename... ARGS>
+		void log(Format &fmt, uint64_t timestamp, ARGS... args)
+		{
+			static_assert(sizeof...(ARGS) <= MAX_ARGS, "too many arguments");
+
+			int id = fmt.id;
+			if (!id)
+				id = _register(fmt);
+
+			/* string table exhausted */
+			if (!id)
+				return;
+
+			unsigned long const values[] = { 0UL, (unsigned long)args... };
+			_record(id, timestamp, values + 1, sizeof...(ARGS));
+		}
+
+
+		/************************************
+		 ** Functions used by the consumer **
+		 ************************************/
+
+		bool valid() const { return _magic == MAGIC && _num_records; }
+
+		unsigned num_records() const { return _num_records; }
+
+		/**
+		 * Return number of the next record to be written
+		 */
+		unsigned next_record() const { return _next_record; }
+
+		/**
+		 * Fetch copy of record number 'n'
+		 *
+		 * \return  0 if the record is complete, a negative value if the
+		 *          record is not yet written, or a positive value if the
+		 *          record was already overwritten
+		 */
+		int fetch(unsigned n, Record &dst) const
+		{
+			Record const &r = _records()[n % _num_records];
+
+			int const seq = r.seq;
+			if (seq != (int)(n + 1))
+				return seq == 0 || (int)(seq - (n + 1)) < 0 ? -1 : 1;
+
+			memory_barrier();
+			dst.seq       = seq;
+			dst.id        = r.id;
+			dst.timestamp = r.timestamp;
+			for (unsigned i = 0; i < MAX_ARGS; i++)
+				dst.args[i] = r.args[i];
+			memory_barrier();
+
+			/* the record may have been overwritten while copying */
+			return r.seq == seq ? 0 : 1;
+		}
+
+		/**
+		 * Format record as text into 'dst'
+		 */
+		void format(Record const &r, char *dst, size_t dst_len) const
+		{
+			/* a string is complete before any record refers to it */
+			int const used = _strings_used;
+
+			bool valid = r.id > 0 && r.id <= used && used <= (int)_strings_size;
+
+			/* the string must be terminated within the table */
+			char const *fmt = _strings + r.id - 1;
+			if (valid)
+				valid = _terminated(fmt, used - (r.id - 1));
+
+			if (!valid) {
+				snprintf(dst, dst_len, "<invalid format %d>", r.id);
+				return;
+			}
+
+			snprintf(dst, dst_len, fmt, r.args[0], r.args[1], r.args[2],
+			         r.args[3], r.args[4]);
+		}
+};
+
+#endif /* _INCLUDE__BASE__BINARY_LOG_H_ */
@@ -206,6 +206,17 @@ struct Genode::Child_policy
 	 */
 	virtual bool initiate_env_sessions() const { return true; }
 
+	/**
+	 * Return true to defer the loading of the child's executable
+	 *
+	 * By default, the child's ELF segments are set up as soon as the
+	 * environment sessions are complete. By returning 'true', the parent
+	 * takes the responsibility to call 'Child::construct_process()' once
+	 * 'Child::process_pending()' returns true. This way, the processes of
+	 * multiple children can be set up concurrently by different threads.
+	 */
+	virtual bool defer_process_construction() const { return false; }
+
 	/**
 	 * Return region map for the child's address space
 	 *
@@ -307,6 +318,10 @@ class Genode::Child : protected Rpc_object<Parent>,
 		Signal_context_capability _resource_avail_sigh;
 		Signal_context_capability _yield_sigh;
 		Signal_context_capability _session_sigh;
+		Signal_context_capability _heartbeat_sigh;
+
+		/* number of heartbeat signals not yet responded to by the child */
+		unsigned _outstanding_heartbeats = 0;
 
 		/* arguments fetched by the child in response to a yield signal */
 		Lock          _yield_request_lock;
@@ -337,6 +352,11 @@ class Genode::Child : protected Rpc_object<Parent>,
 
 		void _try_construct_env_dependent_members();
 
+		void _construct_process();
+
+		/* set if the process construction is deferred by the policy */
+		bool _process_pending = false;
+
 		Constructible<Initial_thread> _initial_thread;
 
 		struct Process
@@ -654,6 +674,24 @@ class Genode::Child : protected Rpc_object<Parent>,
 		 */
 		bool active() const { return _process.constructed(); }
 
+		/**
+		 * Return true if the environment is complete but the construction
+		 * of the process was deferred
+		 *
+		 * See the description of 'Child_policy::defer_process_construction'.
+		 */
+		bool process_pending() const { return _process_pending; }
+
+		/**
+		 * Load the executable and start the child's initial thread
+		 *
+		 * This method has an effect only if 'process_pending' returns true.
+		 * It does not interact with the parent interface of the child. Hence,
+		 * it can be called by a thread other than the child's entrypoint as
+		 * long as no other operation is performed on the child concurrently.
+		 */
+		void construct_process();
+
 		/**
 		 * Initialize the child's RAM session
 		 */
@@ -735,6 +773,25 @@ class Genode::Child : protected Rpc_object<Parent>,
 		 */
 		void notify_resource_avail() const;
 
+		/**
+		 * Send heartbeat signal to the child
+		 *
+		 * This method is a no-op if the child has not registered a
+		 * heartbeat signal handler.
+		 */
+		void heartbeat();
+
+		/**
+		 * Return number of heartbeats that the child missed to respond to
+		 *
+		 * The heartbeat sent most recently is not counted as the child
+		 * may still be about to respond.
+		 */
+		unsigned skipped_heartbeats() const
+		{
+			return _outstanding_heartbeats ? _outstanding_heartbeats - 1 : 0;
+		}
+
 
 		/**********************
 		 ** Parent interface **
@@ -756,6 +813,8 @@ class Genode::Child : protected Rpc_object<Parent>,
 		void yield_sigh(Signal_context_capability) override;
 		Resource_args yield_request() override;
 		void yield_response() override;
+		void heartbeat_sigh(Signal_context_capability) override;
+		void heartbeat_response() override;
 };
 
 #endif /* _INCLUDE__BASE__CHILD_H_ */
@@ -0,0 +1,308 @@
+/*
+ * \brief  Slab allocator for concurrent use by multiple threads
+ * \author Genode Labs
+ * \date   2026-10-14
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__BASE__CONCURRENT_SLAB_H_
+#define _INCLUDE__BASE__CONCURRENT_SLAB_H_
+
+#include <base/slab.h>
+#include <base/lock.h>
+#include <base/thread.h>
+#include <cpu/atomic.h>
+#include <util/construct_at.h>
+#include <util/misc_math.h>
+
+namespace Genode { class Concurrent_slab; }
+
+
+/**
+ * Thread-safe slab allocator with magazine caches
+ *
+ * Slab entries are cached in magazines, which are arrays of free entries.
+ * Each thread uses one of 'NUM_CACHES' caches, selected by the stack slot
+ * of the thread, and allocates from and frees to the magazines of its
+ * cache. Only when both magazines of a cache are exhausted or full, the
+ * cache exchanges a magazine with the depot, which holds full and empty
+ * magazines in two lock-free stacks. The underlying 'Slab' is accessed
+ * under a lock only if the depot cannot satisfy the request, and then in
+ * batches of half a magazine.
+ *
+ * As each cache is protected by its own lock, threads sharing a cache
+ * remain correct, yet contend on the cache lock. Entries held in
+ * magazines are not returned to the backing store before 'reclaim' is
+ * called or the allocator is destructed.
+ */
+class Genode::Concurrent_slab : public Allocator
+{
+	public:
+
+		enum { MAGAZINE_SIZE = 32, NUM_CACHES = 16, NUM_DEPOT_MAGAZINES = 32 };
+
+	private:
+
+		enum { NUM_MAGAZINES = 2*NUM_CACHES + NUM_DEPOT_MAGAZINES };
+
+		struct Magazine
+		{
+			int      next  = 0;  /* index + 1 of next magazine in depot stack */
+			unsigned count = 0;
+			void    *entries[MAGAZINE_SIZE];
+
+			bool full()  const { return count == MAGAZINE_SIZE; }
+			bool empty() const { return count == 0; }
+		};
+
+		/**
+		 * Lock-free stack of magazines
+		 *
+		 * The head contains the index of the top-most magazine in the
+		 * lower and a modification count in the upper bits. The count
+		 * prevents a stale head from being installed by 'cmpxchg' when
+		 * the stack was modified in between.
+		 */
+		struct Depot_stack
+		{
+			enum { INDEX_MASK = 0xffff, TAG_SHIFT = 16, TAG_MASK = 0x7fff };
+
+			volatile int head = 0;
+
+			static int _head(int old, int index) {
+				return ((((old >> TAG_SHIFT) + 1) & TAG_MASK) << TAG_SHIFT) | index; }
+
+			void push(Magazine *magazines, Magazine &magazine)
+			{
+				int const index = &magazine - magazines + 1;
+				for (;;) {
+					int const old = head;
+					magazine.next = old & INDEX_MASK;
+					if (cmpxchg(&head, old, _head(old, index)))
+						return;
+				}
+			}
+
+			Magazine *pop(Magazine *magazines)
+			{
+				for (;;) {
+					int const old   = head;
+					int const index = old & INDEX_MASK;
+					if (!index)
+						return nullptr;
+
+					int const next = magazines[index - 1].next;
+					if (cmpxchg(&head, old, _head(old, next)))
+						return &magazines[index - 1];
+				}
+			}
+		};
+
+		struct Cache
+		{
+			Lock      lock;
+			Magazine *loaded   = nullptr;
+			Magazine *previous = nullptr;
+		};
+
+		size_t     const _slab_size;
+		Allocator       &_backing_store;
+
+		Lock _slab_lock;
+		Slab _slab;
+
+		Magazine * const _magazines;
+
+		Depot_stack _full_magazines;
+		Depot_stack _empty_magazines;
+
+		Cache _caches[NUM_CACHES];
+
+		static_assert((unsigned)NUM_MAGAZINES
+		              < (unsigned)Depot_stack::INDEX_MASK,
+		              "too many magazines for depot stack");
+
+		Magazine *_alloc_magazines()
+		{
+			size_t const size = NUM_MAGAZINES*sizeof(Magazine);
+
+			void *ptr = nullptr;
+			if (!_backing_store.alloc(size, &ptr))
+				throw Out_of_memory();
+
+			Magazine *magazines = (Magazine *)ptr;
+			for (unsigned i = 0; i < NUM_MAGAZINES; i++)
+				construct_at<Magazine>(&magazines[i]);
+
+			return magazines;
+		}
+
+		Cache &_cache()
+		{
+			/*
+			 * The stack of each thread resides in a distinct slot of the
+			 * stack area, so the address of a local variable identifies the
+			 * calling thread.
+			 */
+			int    const local = 0;
+			addr_t const slot  = (addr_t)&local
+			                     >> log2(Thread::stack_virtual_size());
+			return _caches[slot % NUM_CACHES];
+		}
+
+		/**
+		 * Fill magazine with entries of the underlying slab
+		 */
+		void _refill(Magazine &magazine)
+		{
+			Lock::Guard guard(_slab_lock);
+
+			while (magazine.count < MAGAZINE_SIZE/2) {
+				void *entry = nullptr;
+				if (!_slab.alloc(_slab_size, &entry))
+					return;
+				magazine.entries[magazine.count++] = entry;
+			}
+		}
+
+		/**
+		 * Return 'count' entries of magazine to the underlying slab
+		 */
+		void _drain(Magazine &magazine, unsigned count)
+		{
+			Lock::Guard guard(_slab_lock);
+
+			for (; count && magazine.count; count--)
+				_slab.free(magazine.entries[--magazine.count], _slab_size);
+		}
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param slab_size      size of one slab entry
+		 * \param block_size     size of the slab blocks obtained from the
+		 *                       backing store
+		 * \param backing_store  allocator for slab blocks and magazines
+		 *
+		 * \throw Out_of_memory
+		 */
+		Concurrent_slab(size_t slab_size, size_t block_size,
+		                Allocator &backing_store)
+		:
+			_slab_size(slab_size), _backing_store(backing_store),
+			_slab(slab_size, block_size, nullptr, &backing_store),
+			_magazines(_alloc_magazines())
+		{
+			for (unsigned i = 0; i < NUM_CACHES; i++) {
+				_caches[i].loaded   = &_magazines[2*i];
+				_caches[i].previous = &_magazines[2*i + 1];
+			}
+
+			for (unsigned i = 2*NUM_CACHES; i < NUM_MAGAZINES; i++)
+				_empty_magazines.push(_magazines, _magazines[i]);
+		}
+
+		~Concurrent_slab()
+		{
+			reclaim();
+
+			for (unsigned i = 0; i < NUM_MAGAZINES; i++)
+				_drain(_magazines[i], MAGAZINE_SIZE);
+
+			_backing_store.free(_magazines, NUM_MAGAZINES*sizeof(Magazine));
+		}
+
+		/**
+		 * Return the entries of all full magazines of the depot to the
+		 * underlying slab
+		 */
+		void reclaim()
+		{
+			while (Magazine *magazine = _full_magazines.pop(_magazines)) {
+				_drain(*magazine, MAGAZINE_SIZE);
+				_empty_magazines.push(_magazines, *magazine);
+			}
+		}
+
+
+		/*************************
+		 ** Allocator interface **
+		 *************************/
+
+		bool alloc(size_t size, void **out_addr) override
+		{
+			if (size > _slab_size) {
+				error("requested size ", size, " is larger then slab size ",
+				      _slab_size);
+				return false;
+			}
+
+			Cache &cache = _cache();
+			Lock::Guard guard(cache.lock);
+
+			if (cache.loaded->empty()) {
+
+				if (!cache.previous->empty()) {
+					Magazine *m = cache.loaded;
+					cache.loaded   = cache.previous;
+					cache.previous = m;
+
+				} else if (Magazine *full = _full_magazines.pop(_magazines)) {
+					_empty_magazines.push(_magazines, *cache.previous);
+					cache.previous = cache.loaded;
+					cache.loaded   = full;
+
+				} else {
+					_refill(*cache.loaded);
+					if (cache.loaded->empty())
+						return false;
+				}
+			}
+
+			Magazine &m = *cache.loaded;
+			*out_addr = m.entries[--m.count];
+			return true;
+		}
+
+		void free(void *addr, size_t) override
+		{
+			Cache &cache = _cache();
+			Lock::Guard guard(cache.lock);
+
+			if (cache.loaded->full()) {
+
+				if (!cache.previous->full()) {
+					Magazine *m = cache.loaded;
+					cache.loaded   = cache.previous;
+					cache.previous = m;
+
+				} else if (Magazine *empty = _empty_magazines.pop(_magazines)) {
+					_full_magazines.push(_magazines, *cache.previous);
+					cache.previous = cache.loaded;
+					cache.loaded   = empty;
+
+				} else {
+					_drain(*cache.loaded, MAGAZINE_SIZE/2);
+				}
+			}
+
+			Magazine &m = *cache.loaded;
+			m.entries[m.count++] = addr;
+		}
+
+		size_t consumed() const override { return _slab.consumed(); }
+
+		size_t overhead(size_t size) const override { return _slab.overhead(size); }
+
+		bool need_size_for_free() const override { return false; }
+};
+
+#endif /* _INCLUDE__BASE__CONCURRENT_SLAB_H_ */
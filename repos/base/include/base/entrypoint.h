@@ -58,11 +58,8 @@ class Genode::Entrypoint : Genode::Noncopyable
 		{
 			enum { STACK_SIZE = 2*1024*sizeof(long) };
 			Entrypoint &ep;
-			Signal_proxy_thread(Env &env, Entrypoint &ep)
-			:
-				Thread(env, "signal_proxy", STACK_SIZE),
-				ep(ep)
-			{ start(); }
+			Signal_proxy_thread(Env &env, Entrypoint &ep,
+			                    Affinity::Location location);
 
 			void entry() override { ep._process_incoming_signals(); }
 		};
@@ -114,10 +111,27 @@ class Genode::Entrypoint : Genode::Noncopyable
 		void _handle_suspend() { _suspended = true; }
 		Constructible<Genode::Signal_handler<Entrypoint>> _suspend_dispatcher;
 
+		/*
+		 * Heartbeat signals of the parent are answered by the initial
+		 * entrypoint. Hence, a component that is stuck in its entrypoint
+		 * stops responding.
+		 */
+		void _handle_heartbeat();
+		Constructible<Genode::Signal_handler<Entrypoint>> _heartbeat_handler;
+
+		void _init_heartbeat();
+
+		/*
+		 * Maximum number of signals dispatched at once, which bounds the
+		 * time the entrypoint does not respond to RPCs
+		 */
+		enum { MAX_SIGNAL_BATCH = 32 };
+
 		void _dispatch_signal(Signal &sig);
 		void _defer_signal(Signal &sig);
 		void _process_deferred_signals();
 		void _process_incoming_signals();
+		void _dispatch_pending_io_signals();
 		bool _wait_and_dispatch_one_io_signal(bool dont_block);
 
 		Constructible<Signal_proxy_thread> _signal_proxy_thread;
@@ -134,6 +148,15 @@ class Genode::Entrypoint : Genode::Noncopyable
 
 		Entrypoint(Env &env, size_t stack_size, char const *name);
 
+		/**
+		 * Constructor
+		 *
+		 * \param location  CPU affinity of the entrypoint and its signal
+		 *                  proxy thread
+		 */
+		Entrypoint(Env &env, size_t stack_size, char const *name,
+		           Affinity::Location location);
+
 		~Entrypoint()
 		{
 			_rpc_ep->dissolve(&_signal_proxy);
@@ -169,7 +192,8 @@ class Genode::Entrypoint : Genode::Noncopyable
 		void dissolve(Signal_dispatcher_base &);
 
 		/**
-		 * Block and dispatch a single I/O-level signal, return afterwards
+		 * Block for an I/O-level signal, dispatch it together with all
+		 * further pending I/O-level signals, and return afterwards
 		 *
 		 * \noapi
 		 *
@@ -187,7 +211,7 @@ class Genode::Entrypoint : Genode::Noncopyable
 		}
 
 		/**
-		 * Dispatch single pending I/O-level signal (non-blocking)
+		 * Dispatch pending I/O-level signals (non-blocking)
 		 *
 		 * \return true if a pending signal was dispatched, false if no signal
 		 *         was pending
@@ -0,0 +1,171 @@
+/*
+ * \brief  Pool of RPC entrypoints distributed over the available CPUs
+ * \author Genode Labs
+ * \date   2026-10-14
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__BASE__ENTRYPOINT_POOL_H_
+#define _INCLUDE__BASE__ENTRYPOINT_POOL_H_
+
+#include <util/noncopyable.h>
+#include <base/entrypoint.h>
+#include <base/rpc_server.h>
+#include <base/allocator.h>
+#include <base/env.h>
+
+namespace Genode { class Entrypoint_pool; }
+
+
+/**
+ * Set of RPC entrypoints serving the objects of one component
+ *
+ * The pool consists of the component's initial entrypoint and one
+ * additional RPC entrypoint for each further CPU of the component's
+ * affinity space. Each RPC object is managed by exactly one entrypoint of
+ * the pool, which serializes the RPCs of the object. By default, objects
+ * are managed by the initial entrypoint and are thereby serialized with
+ * each other and with the signal handling of the component. Objects that
+ * inherit 'Entrypoint_pool::Concurrent' declare that they can be served
+ * concurrently to all other objects. Those objects are distributed over
+ * all entrypoints of the pool in a round-robin fashion.
+ */
+class Genode::Entrypoint_pool : Noncopyable
+{
+	public:
+
+		/**
+		 * Marker for RPC objects that are safe to serve concurrently
+		 */
+		struct Concurrent { };
+
+	private:
+
+		Allocator &_alloc;
+
+		Rpc_entrypoint &_primary;
+
+		unsigned const _num_eps;
+
+		/* entrypoints beside the primary one */
+		Rpc_entrypoint **_eps;
+
+		Lock     _lock { };
+		unsigned _next = 0;
+
+		static bool _concurrent(Concurrent const *) { return true;  }
+		static bool _concurrent(void const *)       { return false; }
+
+		static unsigned _num_cpus(Env &env, unsigned max_eps)
+		{
+			unsigned const total = env.cpu().affinity_space().total();
+			return max(1U, min(total, max_eps));
+		}
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param stack_size  stack size of each additional entrypoint
+		 * \param name        name of the additional entrypoint threads
+		 * \param max_eps     maximum number of entrypoints including the
+		 *                    initial entrypoint of the component
+		 *
+		 * \throw Out_of_ram
+		 * \throw Out_of_caps
+		 */
+		Entrypoint_pool(Env &env, Allocator &alloc, size_t stack_size,
+		                char const *name, unsigned max_eps = ~0U)
+		:
+			_alloc(alloc), _primary(env.ep().rpc_ep()),
+			_num_eps(_num_cpus(env, max_eps)),
+			_eps(new (alloc) Rpc_entrypoint*[_num_eps])
+		{
+			Affinity::Space cpus = env.cpu().affinity_space();
+
+			_eps[0] = &_primary;
+			for (unsigned i = 1; i < _num_eps; i++)
+				_eps[i] = new (alloc)
+					Rpc_entrypoint(&env.pd(), stack_size, name, true,
+					               cpus.location_of_index(i));
+		}
+
+		/**
+		 * Destructor
+		 *
+		 * All RPC objects must have been dissolved before.
+		 */
+		~Entrypoint_pool()
+		{
+			for (unsigned i = 1; i < _num_eps; i++)
+				destroy(_alloc, _eps[i]);
+
+			destroy(_alloc, _eps);
+		}
+
+		/**
+		 * Return number of entrypoints including the initial one
+		 */
+		unsigned size() const { return _num_eps; }
+
+		/**
+		 * Return entrypoint with index 'i', index 0 refers to the initial
+		 * entrypoint of the component
+		 */
+		Rpc_entrypoint &ep(unsigned i) { return *_eps[i % _num_eps]; }
+
+		/**
+		 * Return the initial entrypoint of the component
+		 */
+		Rpc_entrypoint &primary() { return _primary; }
+
+		/**
+		 * Associate RPC object with an entrypoint of the pool
+		 *
+		 * \return entrypoint that manages the object
+		 */
+		template <typename OBJ>
+		Rpc_entrypoint &manage(OBJ &obj)
+		{
+			Rpc_entrypoint *ep = &_primary;
+
+			if (_concurrent(&obj)) {
+				Lock::Guard guard(_lock);
+				ep = _eps[_next++ % _num_eps];
+			}
+
+			ep->manage(&obj);
+			return *ep;
+		}
+
+		/**
+		 * Return entrypoint that manages the RPC object of 'cap'
+		 *
+		 * If no entrypoint of the pool manages the object, the initial
+		 * entrypoint is returned.
+		 */
+		Rpc_entrypoint &ep_of(Untyped_capability cap)
+		{
+			for (unsigned i = 1; i < _num_eps; i++)
+				if (_eps[i]->apply(cap, [&] (Rpc_object_base *obj) {
+					return obj != nullptr; }))
+					return *_eps[i];
+
+			return _primary;
+		}
+
+		/**
+		 * Dissolve RPC object from the entrypoint that manages it
+		 */
+		template <typename OBJ>
+		void dissolve(OBJ &obj) { ep_of(obj.cap()).dissolve(&obj); }
+};
+
+#endif /* _INCLUDE__BASE__ENTRYPOINT_POOL_H_ */
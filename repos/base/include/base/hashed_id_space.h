@@ -0,0 +1,302 @@
+/*
+ * \brief  ID name space with constant-time lookup
+ * \author Genode Labs
+ * \date   2026-10-14
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__BASE__HASHED_ID_SPACE_H_
+#define _INCLUDE__BASE__HASHED_ID_SPACE_H_
+
+#include <util/noncopyable.h>
+#include <util/meta.h>
+#include <base/allocator.h>
+#include <base/lock.h>
+#include <base/log.h>
+
+namespace Genode { template <typename T> class Hashed_id_space; }
+
+
+/**
+ * ID space with the interface of 'Id_space', backed by a hash table
+ *
+ * The ID value modulo the table size serves as hash. Because IDs are
+ * allocated consecutively, the table degenerates to a flat array indexed
+ * by ID for the common case of dense IDs. The table is doubled whenever
+ * the number of elements exceeds the number of buckets, which keeps
+ * lookups at constant time for thousands of IDs. Growing the table is
+ * best effort. If the allocator is depleted, the ID space continues to
+ * operate with longer bucket chains.
+ */
+template <typename T>
+class Genode::Hashed_id_space : public Noncopyable
+{
+	public:
+
+		struct Id
+		{
+			unsigned long value;
+
+			bool operator == (Id const &other) const { return value == other.value; }
+
+			void print(Output &out) const { Genode::print(out, value); }
+		};
+
+		class Out_of_ids     : Exception { };
+		class Conflicting_id : Exception { };
+
+		class Element : Noncopyable
+		{
+			private:
+
+				T               &_obj;
+				Hashed_id_space &_id_space;
+				Id               _id { 0 };
+				Element         *_next = nullptr;   /* next in bucket */
+
+				friend class Hashed_id_space;
+
+			public:
+
+				/**
+				 * Constructor
+				 *
+				 * \throw Out_of_ids  ID space is exhausted
+				 */
+				Element(T &obj, Hashed_id_space &id_space)
+				:
+					_obj(obj), _id_space(id_space)
+				{
+					Lock::Guard guard(_id_space._lock);
+					_id = id_space._unused_id();
+					_id_space._insert(*this);
+				}
+
+				/**
+				 * Constructor
+				 *
+				 * \throw Conflicting_id  'id' is already present in ID space
+				 */
+				Element(T &obj, Hashed_id_space &id_space, Id id)
+				:
+					_obj(obj), _id_space(id_space), _id(id)
+				{
+					Lock::Guard guard(_id_space._lock);
+					if (_id_space._lookup(id))
+						throw Conflicting_id();
+					_id_space._insert(*this);
+				}
+
+				~Element()
+				{
+					Lock::Guard guard(_id_space._lock);
+					_id_space._remove(*this);
+				}
+
+				Id id() const { return _id; }
+
+				void print(Output &out) const { Genode::print(out, _id); }
+		};
+
+	private:
+
+		enum { INITIAL_BUCKETS = 32 };
+
+		Allocator &_alloc;
+
+		Lock mutable   _lock;  /* protect buckets, '_count', and '_cnt' */
+		Element       *_initial_buckets[INITIAL_BUCKETS] { };
+		Element      **_buckets     = _initial_buckets;
+		unsigned long  _num_buckets = INITIAL_BUCKETS;
+		unsigned long  _count       = 0;
+		unsigned long  _cnt         = 0;
+
+		/* lowest bucket that may be non-empty, used by 'apply_any' */
+		unsigned long _first_used = 0;
+
+		Element *&_bucket(Id id) { return _buckets[id.value & (_num_buckets - 1)]; }
+
+		Element *_lookup(Id id) const
+		{
+			Element *e = _buckets[id.value & (_num_buckets - 1)];
+			for (; e && !(e->_id == id); e = e->_next);
+			return e;
+		}
+
+		void _grow()
+		{
+			unsigned long const num_buckets = 2*_num_buckets;
+			size_t        const size        = num_buckets*sizeof(Element *);
+
+			void *ptr = nullptr;
+			try { if (!_alloc.alloc(size, &ptr)) return; }
+			catch (Out_of_ram)  { return; }
+			catch (Out_of_caps) { return; }
+
+			Element **buckets = (Element **)ptr;
+			for (unsigned long i = 0; i < num_buckets; i++)
+				buckets[i] = nullptr;
+
+			for (unsigned long i = 0; i < _num_buckets; i++)
+				while (Element *e = _buckets[i]) {
+					_buckets[i] = e->_next;
+					Element *&bucket = buckets[e->_id.value & (num_buckets - 1)];
+					e->_next = bucket;
+					bucket   = e;
+				}
+
+			if (_buckets != _initial_buckets)
+				_alloc.free(_buckets, _num_buckets*sizeof(Element *));
+
+			_buckets     = buckets;
+			_num_buckets = num_buckets;
+			_first_used  = 0;
+		}
+
+		void _insert(Element &e)
+		{
+			if (_count >= _num_buckets)
+				_grow();
+
+			Element *&bucket = _bucket(e._id);
+			e._next = bucket;
+			bucket  = &e;
+			_count++;
+
+			unsigned long const index = e._id.value & (_num_buckets - 1);
+			if (index < _first_used)
+				_first_used = index;
+		}
+
+		void _remove(Element &e)
+		{
+			for (Element **p = &_bucket(e._id); *p; p = &(*p)->_next)
+				if (*p == &e) {
+					*p = e._next;
+					_count--;
+					return;
+				}
+		}
+
+		/**
+		 * Return ID that does not exist within the ID space
+		 *
+		 * \return ID assigned to the element within the ID space
+		 * \throw  Out_of_ids
+		 */
+		Id _unused_id()
+		{
+			unsigned long _attempts = 0;
+			for (; _attempts < ~0UL; _attempts++, _cnt++) {
+
+				Id const id { _cnt };
+
+				/* another attempt if is already in use */
+				if (_lookup(id))
+					continue;
+
+				return id;
+			}
+			throw Out_of_ids();
+		}
+
+	public:
+
+		class Unknown_id : Exception { };
+
+		/**
+		 * Constructor
+		 *
+		 * \param alloc  allocator used for growing the hash table
+		 */
+		Hashed_id_space(Allocator &alloc) : _alloc(alloc) { }
+
+		/**
+		 * Apply functor 'fn' to each ID present in the ID space
+		 *
+		 * \param ARG  argument type passed to 'fn', must be convertible
+		 *             from 'T' via a 'static_cast'
+		 *
+		 * In contrast to 'Id_space', the elements are not visited in the
+		 * order of their IDs.
+		 *
+		 * This function is called with the ID space locked. Hence, it is not
+		 * possible to modify the ID space from within 'fn'.
+		 */
+		template <typename ARG, typename FUNC>
+		void for_each(FUNC const &fn) const
+		{
+			Lock::Guard guard(_lock);
+
+			for (unsigned long i = 0; i < _num_buckets; i++)
+				for (Element *e = _buckets[i]; e; e = e->_next)
+					fn(static_cast<ARG &>(e->_obj));
+		}
+
+		/**
+		 * Apply functor 'fn' to object with given ID
+		 *
+		 * See 'for_each' for a description of the 'ARG' argument.
+		 *
+		 * \throw Unknown_id
+		 */
+		template <typename ARG, typename FUNC>
+		auto apply(Id id, FUNC const &fn)
+		-> typename Trait::Functor<decltype(&FUNC::operator())>::Return_type
+		{
+			T *obj = nullptr;
+			{
+				Lock::Guard guard(_lock);
+
+				if (Element *e = _lookup(id))
+					obj = &e->_obj;
+			}
+			if (obj)
+				return fn(static_cast<ARG &>(*obj));
+			else
+				throw Unknown_id();
+		}
+
+		/**
+		 * Apply functor 'fn' to an arbitrary ID present in the ID space
+		 *
+		 * See 'Id_space::apply_any' for a description.
+		 *
+		 * \return  true if 'fn' was applied, or
+		 *          false if the ID space is empty.
+		 */
+		template <typename ARG, typename FUNC>
+		bool apply_any(FUNC const &fn)
+		{
+			T *obj = nullptr;
+			{
+				Lock::Guard guard(_lock);
+
+				if (!_count)
+					return false;
+
+				for (; !_buckets[_first_used]; _first_used++);
+
+				obj = &_buckets[_first_used]->_obj;
+			}
+			fn(static_cast<ARG &>(*obj));
+			return true;
+		}
+
+		~Hashed_id_space()
+		{
+			if (_count)
+				error("ID space not empty at destruction time");
+
+			if (_buckets != _initial_buckets)
+				_alloc.free(_buckets, _num_buckets*sizeof(Element *));
+		}
+};
+
+#endif /* _INCLUDE__BASE__HASHED_ID_SPACE_H_ */
@@ -71,6 +71,30 @@ class Genode::Heap : public Allocator
 				ram_alloc = ram, region_map = rm; }
 		};
 
+		/*
+		 * Blocks of up to 'MAX_SMALL_SIZE' bytes are served by size
+		 * classes, each of which carves elements of one size out of
+		 * page-sized superblocks obtained from the local allocator. The
+		 * header of a superblock identifies its elements by address, so
+		 * that 'alloc' and 'free' of small blocks neither take the heap
+		 * lock nor walk the AVL tree in the common case.
+		 */
+		enum { NUM_SIZE_CLASSES = 8, MAX_SMALL_SIZE = 256 };
+
+		struct Superblock;
+
+		struct Size_class
+		{
+			Lock         lock;
+			size_t       elem_size = 0;
+
+			/* superblocks with free elements precede the full ones */
+			Superblock  *first = nullptr;
+			Superblock  *last  = nullptr;
+		};
+
+		Size_class _size_classes[NUM_SIZE_CLASSES];
+
 		Lock                           _lock;
 		Reconstructible<Allocator_avl> _alloc;        /* local allocator    */
 		Dataspace_pool                 _ds_pool;      /* list of dataspaces */
@@ -98,12 +122,30 @@ class Genode::Heap : public Allocator
 		 * This method is a utility used by '_unsynchronized_alloc' to
 		 * avoid code duplication.
 		 */
-		bool _try_local_alloc(size_t size, void **out_addr);
+		bool _try_local_alloc(size_t size, void **out_addr, int align);
 
 		/**
 		 * Unsynchronized implementation of 'alloc'
+		 *
+		 * \param align  log2 of the alignment of the block
+		 */
+		bool _unsynchronized_alloc(size_t size, void **out_addr, int align = 4);
+
+		Size_class &_size_class(size_t size);
+
+		/**
+		 * Return superblock containing 'addr' or nullptr if 'addr' is
+		 * not an element of a size class
+		 */
+		Superblock *_superblock(void *addr) const;
+
+		bool _small_alloc(Size_class &, void **out_addr);
+		void _small_free(Superblock &, void *addr);
+
+		/**
+		 * Hand back superblock to the local allocator
 		 */
-		bool _unsynchronized_alloc(size_t size, void **out_addr);
+		void _release(Superblock &);
 
 	public:
 
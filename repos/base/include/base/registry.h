@@ -15,6 +15,7 @@
 #define _INCLUDE__BASE__REGISTRY_H_
 
 #include <util/list.h>
+#include <util/double_list.h>
 #include <base/lock.h>
 
 namespace Genode {
@@ -39,7 +40,7 @@ class Genode::Registry_base
 
 	protected:
 
-		class Element : public List<Element>::Element
+		class Element : public Double_list<Element>::Element
 		{
 			private:
 
@@ -70,8 +71,8 @@ class Genode::Registry_base
 
 	protected:
 
-		Lock mutable  _lock; /* protect '_elements' */
-		List<Element> _elements;
+		Lock mutable         _lock; /* protect '_elements' */
+		Double_list<Element> _elements;
 
 	private:
 
@@ -83,7 +84,7 @@ class Genode::Registry_base
 		void _insert(Element &);
 		void _remove(Element &);
 
-		Element *_processed(Notify &, List<Element> &, Element &, Element *);
+		Element *_processed(Notify &, Double_list<Element> &, Element &, Element *);
 
 	protected:
 
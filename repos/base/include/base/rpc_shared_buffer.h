@@ -0,0 +1,247 @@
+/*
+ * \brief  Shared buffer for passing large RPC arguments
+ * \author Genode Labs
+ * \date   2026-10-14
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__BASE__RPC_SHARED_BUFFER_H_
+#define _INCLUDE__BASE__RPC_SHARED_BUFFER_H_
+
+#include <util/string.h>
+#include <util/misc_math.h>
+#include <base/attached_dataspace.h>
+#include <base/attached_ram_dataspace.h>
+
+namespace Genode {
+
+	struct Rpc_bulk_arg;
+	class  Rpc_shared_buffer;
+	class  Rpc_shared_buffer_client;
+}
+
+
+/**
+ * RPC argument referring to a range within a shared buffer
+ *
+ * Session interfaces use this type as argument or return value of RPC
+ * functions whose payload exceeds the size of the message buffer. The
+ * payload itself resides in a dataspace that is set up once per session
+ * and shared between client and server. Hence, the argument is not
+ * copied by the kernel and no session-specific copy protocol is needed.
+ */
+struct Genode::Rpc_bulk_arg
+{
+	size_t offset;
+	size_t length;
+
+	/**
+	 * Return true if the range lies within a buffer of 'size' bytes
+	 */
+	bool valid(size_t size) const {
+		return offset <= size && length <= size - offset; }
+
+	/**
+	 * Return word-aligned offset following the range
+	 *
+	 * This offset can be used to place a further argument of the same
+	 * RPC into the buffer.
+	 */
+	size_t next_offset() const {
+		return align_addr(offset + length, log2(sizeof(long))); }
+};
+
+
+/**
+ * Server-side part of the shared buffer
+ *
+ * The buffer is allocated at session-creation time from the session's
+ * RAM quota and handed out to the client via a session RPC function that
+ * returns 'cap()'. The buffer is reused by all RPCs of the session. The
+ * server must only access ranges that are referred to by the arguments of
+ * the RPC currently being served. The accessors check the ranges against
+ * the buffer bounds and do not throw, so that an invalid argument by the
+ * client cannot cause an undeclared exception within the server.
+ */
+class Genode::Rpc_shared_buffer : Noncopyable
+{
+	private:
+
+		Attached_ram_dataspace _ds;
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param size  buffer size in bytes
+		 *
+		 * \throw Out_of_ram
+		 * \throw Out_of_caps
+		 */
+		Rpc_shared_buffer(Ram_allocator &ram, Region_map &rm, size_t size)
+		: _ds(ram, rm, size) { }
+
+		Dataspace_capability cap() const { return _ds.cap(); }
+
+		size_t size() const { return _ds.size(); }
+
+		/**
+		 * Apply functor to the content referred to by 'arg'
+		 *
+		 * \param fn  functor called with the start address and the length
+		 *            of the content as arguments
+		 *
+		 * \return  false if 'arg' exceeds the buffer, in which case 'fn' is
+		 *          not called
+		 */
+		template <typename FN>
+		bool with_arg(Rpc_bulk_arg const &arg, FN const &fn) const
+		{
+			if (!arg.valid(size()))
+				return false;
+
+			fn(_ds.local_addr<char const>() + arg.offset, arg.length);
+			return true;
+		}
+
+		/**
+		 * Apply functor to the null-terminated string referred to by 'arg'
+		 *
+		 * The functor is called with a local copy of the string. Hence, the
+		 * client cannot modify the string while the functor evaluates it.
+		 *
+		 * \param MAX_LEN  maximum length of the string including the
+		 *                 terminating null character
+		 *
+		 * \return  false if 'arg' exceeds the buffer or 'MAX_LEN', or if the
+		 *          string lacks the terminating null character within the
+		 *          range
+		 */
+		template <size_t MAX_LEN, typename FN>
+		bool with_string(Rpc_bulk_arg const &arg, FN const &fn) const
+		{
+			bool result = false;
+			with_arg(arg, [&] (char const *start, size_t length) {
+				if (!length || length > MAX_LEN)
+					return;
+
+				char string[MAX_LEN];
+				memcpy(string, start, length);
+
+				if (string[length - 1] != 0)
+					return;
+
+				fn((char const *)string);
+				result = true;
+			});
+			return result;
+		}
+
+		/**
+		 * Produce a result within the buffer
+		 *
+		 * \param offset  start of the result within the buffer
+		 * \param fn      functor called with the destination address and
+		 *                the space available, returning the number of
+		 *                bytes written
+		 *
+		 * \return  range of the result, to be returned to the client
+		 */
+		template <typename FN>
+		Rpc_bulk_arg write(size_t offset, FN const &fn)
+		{
+			if (offset > size())
+				return Rpc_bulk_arg { 0, 0 };
+
+			size_t const max     = size() - offset;
+			size_t const written = fn(_ds.local_addr<char>() + offset, max);
+
+			return Rpc_bulk_arg { offset, min(max, written) };
+		}
+};
+
+
+/**
+ * Client-side part of the shared buffer
+ *
+ * The client must not modify an argument within the buffer while the RPC
+ * that refers to it is in progress. Because the buffer is shared by all
+ * RPCs of a session, the client has to serialize those RPCs.
+ */
+class Genode::Rpc_shared_buffer_client : Noncopyable
+{
+	private:
+
+		Attached_dataspace _ds;
+
+	public:
+
+		class Arg_too_large : Exception { };
+
+		/**
+		 * Constructor
+		 *
+		 * \param ds  dataspace of the session's shared buffer
+		 *
+		 * \throw Region_map::Invalid_dataspace
+		 * \throw Region_map::Region_conflict
+		 * \throw Out_of_ram
+		 * \throw Out_of_caps
+		 */
+		Rpc_shared_buffer_client(Region_map &rm, Dataspace_capability ds)
+		: _ds(rm, ds) { }
+
+		size_t size() const { return _ds.size(); }
+
+		/**
+		 * Place argument into the buffer
+		 *
+		 * \param offset  start of the argument within the buffer, use
+		 *                'Rpc_bulk_arg::next_offset' of a preceding
+		 *                argument to pass multiple arguments at once
+		 *
+		 * \throw Arg_too_large
+		 */
+		Rpc_bulk_arg write(void const *src, size_t length, size_t offset = 0)
+		{
+			Rpc_bulk_arg const arg { offset, length };
+			if (!arg.valid(size()))
+				throw Arg_too_large();
+
+			memcpy(_ds.local_addr<char>() + offset, src, length);
+			return arg;
+		}
+
+		/**
+		 * Place null-terminated string into the buffer
+		 *
+		 * \throw Arg_too_large
+		 */
+		Rpc_bulk_arg write_string(char const *string, size_t offset = 0) {
+			return write(string, strlen(string) + 1, offset); }
+
+		/**
+		 * Apply functor to a result returned by the server
+		 *
+		 * \return  false if 'result' exceeds the buffer, in which case 'fn'
+		 *          is not called
+		 */
+		template <typename FN>
+		bool with_result(Rpc_bulk_arg const &result, FN const &fn) const
+		{
+			if (!result.valid(size()))
+				return false;
+
+			fn(_ds.local_addr<char const>() + result.offset, result.length);
+			return true;
+		}
+};
+
+#endif /* _INCLUDE__BASE__RPC_SHARED_BUFFER_H_ */
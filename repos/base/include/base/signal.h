@@ -428,6 +428,32 @@ class Genode::Signal_receiver : Noncopyable
 		 */
 		Signal pending_signal();
 
+		/**
+		 * Apply functor 'fn' to each pending signal
+		 *
+		 * \param max  maximum number of signals to process
+		 * \return     number of signals passed to 'fn'
+		 *
+		 * The signals are picked up in the order of the context ring, each
+		 * lookup continuing after the context of the previous signal. Hence,
+		 * the batch takes a single pass over the associated contexts. The
+		 * functor is called with the signal as argument and without holding
+		 * any lock of the receiver.
+		 */
+		template <typename FUNC>
+		unsigned for_each_pending_signal(FUNC const &fn, unsigned max = ~0U)
+		{
+			unsigned n = 0;
+			for (; n < max; n++) {
+				try {
+					Signal signal = pending_signal();
+					fn(signal);
+				}
+				catch (Signal_not_pending) { break; }
+			}
+			return n;
+		}
+
 		/**
 		 * Locally submit signal to the receiver
 		 *
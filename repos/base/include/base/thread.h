@@ -405,6 +405,11 @@ class Genode::Thread
 			_logger()->log(data, len);
 		}
 
+		/**
+		 * Log binary trace record
+		 */
+		static void trace(Trace::Record const &record) { _logger()->log(record); }
+
 		/**
 		 * Log trace event as defined in base/trace.h
 		 */
@@ -25,6 +25,7 @@ namespace Genode { namespace Trace {
 	struct Rpc_reply;
 	struct Signal_submit;
 	struct Signal_received;
+	struct Checkpoint;
 } }
 
 
@@ -121,4 +122,23 @@ struct Genode::Trace::Signal_received
 };
 
 
+/**
+ * Named value recorded by a component, e.g., a measured duration
+ */
+struct Genode::Trace::Checkpoint
+{
+	char const   *name;
+	unsigned long data;
+
+	Checkpoint(char const *name, unsigned long data)
+	: name(name), data(data)
+	{
+		Thread::trace(this);
+	}
+
+	size_t generate(Policy_module &policy, char *dst) const {
+		return policy.checkpoint(dst, name, data); }
+};
+
+
 #endif /* _INCLUDE__BASE__TRACE__EVENTS_H_ */
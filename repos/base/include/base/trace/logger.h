@@ -15,6 +15,7 @@
 #define _INCLUDE__BASE__TRACE__LOGGER_H_
 
 #include <base/trace/buffer.h>
+#include <base/trace/record.h>
 #include <cpu_session/cpu_session.h>
 
 namespace Genode { namespace Trace {
@@ -62,6 +63,22 @@ struct Genode::Trace::Logger
 		 */
 		void log(char const *, size_t);
 
+		/**
+		 * Log record to trace buffer
+		 *
+		 * In contrast to events, records are stored as is, without calling
+		 * the trace policy.
+		 */
+		__attribute__((optimize("-fno-delete-null-pointer-checks")))
+		void log(Record const &record)
+		{
+			if (!this || !_evaluate_control()) return;
+
+			char * const dst = buffer->reserve(sizeof(record));
+			__builtin_memcpy(dst, &record, sizeof(record));
+			buffer->commit(sizeof(record));
+		}
+
 		/**
 		 * Log event to trace buffer
 		 */
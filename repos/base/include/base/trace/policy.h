@@ -38,6 +38,7 @@ struct Genode::Trace::Policy_module
 	size_t (*rpc_reply)       (char *, char const *);
 	size_t (*signal_submit)   (char *, unsigned const);
 	size_t (*signal_received) (char *, Signal_context const &, unsigned const);
+	size_t (*checkpoint)      (char *, char const *, unsigned long);
 };
 
 #endif /* _INCLUDE__BASE__TRACE__POLICY_H_ */
@@ -0,0 +1,40 @@
+/*
+ * \brief  Fixed-size binary trace record
+ * \author Genode Labs
+ * \date   2026-10-14
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__BASE__TRACE__RECORD_H_
+#define _INCLUDE__BASE__TRACE__RECORD_H_
+
+#include <base/fixed_stdint.h>
+
+namespace Genode { namespace Trace { struct Record; } }
+
+
+/**
+ * Trace event logged without the detour through the trace policy
+ *
+ * A record is stored as a trace-buffer entry of 'sizeof(Record)' bytes.
+ * The 'magic' value distinguishes records from the events generated by
+ * the trace policy, which are usually text.
+ */
+struct Genode::Trace::Record
+{
+	enum { MAGIC = 0x74726563 /* "trec" */ };
+
+	uint64_t timestamp;
+	uint32_t magic;
+	uint32_t id;
+	uint64_t arg;
+
+} __attribute__((packed));
+
+#endif /* _INCLUDE__BASE__TRACE__RECORD_H_ */
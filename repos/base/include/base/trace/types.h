@@ -114,20 +114,25 @@ class Genode::Trace::Subject_info
 		Policy_id          _policy_id;
 		Execution_time     _execution_time;
 		Affinity::Location _affinity;
+		unsigned long      _migrations;
+		unsigned long      _wakeups;
 
 	public:
 
-		Subject_info() : _state(INVALID) { }
+		Subject_info() : _state(INVALID), _migrations(0), _wakeups(0) { }
 
 		Subject_info(Session_label const &session_label,
 		             Thread_name   const &thread_name,
 		             State state, Policy_id policy_id,
 		             Execution_time execution_time,
-		             Affinity::Location affinity)
+		             Affinity::Location affinity,
+		             unsigned long migrations = 0,
+		             unsigned long wakeups    = 0)
 		:
 			_session_label(session_label), _thread_name(thread_name),
 			_state(state), _policy_id(policy_id),
-			_execution_time(execution_time), _affinity(affinity)
+			_execution_time(execution_time), _affinity(affinity),
+			_migrations(migrations), _wakeups(wakeups)
 		{ }
 
 		Session_label const &session_label()  const { return _session_label; }
@@ -136,6 +141,16 @@ class Genode::Trace::Subject_info
 		Policy_id            policy_id()      const { return _policy_id; }
 		Execution_time       execution_time() const { return _execution_time; }
 		Affinity::Location   affinity()       const { return _affinity; }
+
+		/**
+		 * Return number of migrations of the thread between CPUs
+		 */
+		unsigned long        migrations()     const { return _migrations; }
+
+		/**
+		 * Return number of wake-ups of the thread from a blocking state
+		 */
+		unsigned long        wakeups()        const { return _wakeups; }
 };
 
 #endif /* _INCLUDE__BASE__TRACE__TYPES_H_ */
@@ -87,6 +87,7 @@ class Genode::Exynos_uart: Mmio
 			struct Fifo_en         : Bitfield<0, 1> { };
 			struct Rx_fifo_rst     : Bitfield<1, 1> { };
 			struct Tx_fifo_rst     : Bitfield<2, 1> { };
+			struct Rx_fifo_trigger : Bitfield<4, 3> { };
 		};
 
 		/**
@@ -111,6 +112,14 @@ class Genode::Exynos_uart: Mmio
 			}
 		};
 
+		/**
+		 * Error status, cleared on read
+		 */
+		struct Uerstat : Register<0x14, 32>
+		{
+			struct Overrun : Bitfield<0, 1> { };
+		};
+
 		/**
 		 * FIFO status
 		 */
@@ -168,9 +177,16 @@ class Genode::Exynos_uart: Mmio
 		using Uintp = Uintx<0x30>;
 		using Uintm = Uintx<0x38>;
 
-		void _rx_enable()
+		/**
+		 * Enable receive interrupt
+		 *
+		 * \param rx_trigger  rx FIFO trigger level, whose meaning depends
+		 *                    on the FIFO size of the UART
+		 */
+		void _rx_enable(unsigned rx_trigger = 0)
 		{
 			write<Ufcon::Fifo_en>(1);
+			write<Ufcon::Rx_fifo_trigger>(rx_trigger);
 
 			/* mask all IRQs except receive IRQ */
 			write<Uintm>(Uintm::Error::bits(1) |
@@ -188,6 +204,11 @@ class Genode::Exynos_uart: Mmio
 			return (read<Ufstat>() & (Ufstat::Rx_fifo_count::bits(0xff)
 			        | Ufstat::Rx_fifo_full::bits(1))); }
 
+		/**
+		 * Return true if an overrun occurred since the last call
+		 */
+		bool _rx_overrun() { return read<Uerstat::Overrun>(); }
+
 		/**
 		 * Return character received via UART
 		 */
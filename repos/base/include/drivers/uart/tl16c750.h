@@ -90,6 +90,10 @@ class Genode::Tl16c750_uart : public Mmio
 		struct Uart_fcr : Register<0x8, 32>
 		{
 			struct Fifo_enable   : Bitfield<0, 1> { };
+			struct Rx_fifo_trig  : Bitfield<6, 2>
+			{
+				enum { _8_CHAR = 0, _16_CHAR = 1, _56_CHAR = 2, _60_CHAR = 3 };
+			};
 		};
 
 		/**
@@ -128,6 +132,7 @@ class Genode::Tl16c750_uart : public Mmio
 		struct Uart_lsr : Register<0x14, 32>
 		{
 			struct Rx_fifo_empty : Bitfield<0, 1> { };
+			struct Rx_oe         : Bitfield<1, 1> { };
 			struct Tx_fifo_empty : Bitfield<5, 1> { };
 		};
 
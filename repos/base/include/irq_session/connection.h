@@ -30,11 +30,12 @@ struct Genode::Irq_connection : Connection<Irq_session>, Irq_session_client
 	                                 unsigned              irq,
 	                                 Irq_session::Trigger  trigger,
 	                                 Irq_session::Polarity polarity,
-	                                 Genode::addr_t        device_config_phys)
+	                                 Genode::addr_t        device_config_phys,
+	                                 int                   cpu = -1)
 	{
 		return session("ram_quota=6K, cap_quota=4, irq_number=%u, irq_trigger=%u, "
-		               " irq_polarity=%u, device_config_phys=0x%lx",
-		               irq, trigger, polarity, device_config_phys);
+		               " irq_polarity=%u, device_config_phys=0x%lx, irq_cpu=%d",
+		               irq, trigger, polarity, device_config_phys, cpu);
 	}
 
 	/**
@@ -43,15 +44,18 @@ struct Genode::Irq_connection : Connection<Irq_session>, Irq_session_client
 	 * \param irq      physical interrupt number
 	 * \param trigger  interrupt trigger (e.g., level/edge)
 	 * \param polarity interrupt trigger polarity (e.g., low/high)
+	 * \param cpu      CPU that receives the message-signaled interrupt,
+	 *                 -1 selects the CPU chosen by core
 	 */
 	Irq_connection(Env                  &env,
 	               unsigned              irq,
 	               Irq_session::Trigger  trigger  = Irq_session::TRIGGER_UNCHANGED,
 	               Irq_session::Polarity polarity = Irq_session::POLARITY_UNCHANGED,
-	               Genode::addr_t        device_config_phys = 0)
+	               Genode::addr_t        device_config_phys = 0,
+	               int                   cpu = -1)
 	:
 		Connection<Irq_session>(env, _session(env.parent(), irq, trigger,
-		                                      polarity, device_config_phys)),
+		                                      polarity, device_config_phys, cpu)),
 		Irq_session_client(cap())
 	{ }
 
@@ -280,6 +280,20 @@ class Genode::Parent
 		 */
 		virtual void yield_response() = 0;
 
+		/**
+		 * Register signal handler for heartbeat notifications
+		 *
+		 * The parent may periodically submit a heartbeat signal to check
+		 * the responsiveness of the component. The component confirms each
+		 * heartbeat by calling 'heartbeat_response()'.
+		 */
+		virtual void heartbeat_sigh(Signal_context_capability sigh) = 0;
+
+		/**
+		 * Deliver response to a heartbeat signal
+		 */
+		virtual void heartbeat_response() = 0;
+
 
 		/*********************
 		 ** RPC declaration **
@@ -315,13 +329,16 @@ class Genode::Parent
 		GENODE_RPC(Rpc_yield_sigh, void, yield_sigh, Signal_context_capability);
 		GENODE_RPC(Rpc_yield_request, Resource_args, yield_request);
 		GENODE_RPC(Rpc_yield_response, void, yield_response);
+		GENODE_RPC(Rpc_heartbeat_sigh, void, heartbeat_sigh, Signal_context_capability);
+		GENODE_RPC(Rpc_heartbeat_response, void, heartbeat_response);
 
 		GENODE_RPC_INTERFACE(Rpc_exit, Rpc_announce, Rpc_session_sigh,
 		                     Rpc_session, Rpc_session_cap, Rpc_upgrade,
 		                     Rpc_close, Rpc_session_response, Rpc_main_thread,
 		                     Rpc_deliver_session_cap, Rpc_resource_avail_sigh,
 		                     Rpc_resource_request, Rpc_yield_sigh,
-		                     Rpc_yield_request, Rpc_yield_response);
+		                     Rpc_yield_request, Rpc_yield_response,
+		                     Rpc_heartbeat_sigh, Rpc_heartbeat_response);
 };
 
 
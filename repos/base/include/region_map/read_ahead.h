@@ -0,0 +1,105 @@
+/*
+ * \brief  Read-ahead window for resolving faults of managed dataspaces
+ * \author Genode Labs
+ * \date   2026-10-14
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__REGION_MAP__READ_AHEAD_H_
+#define _INCLUDE__REGION_MAP__READ_AHEAD_H_
+
+#include <base/stdint.h>
+#include <util/misc_math.h>
+
+namespace Genode { class Read_ahead_window; }
+
+
+/**
+ * Policy of a region-map fault handler for populating ranges of pages
+ *
+ * Each fault of a managed dataspace implies a signal round trip to the
+ * fault handler. A handler that attaches a single page per fault therefore
+ * handles sequential accesses at a high cost. A single attachment, however,
+ * resumes all threads faulting within the attached range. By attaching one
+ * dataspace for a whole range, the handler resolves many pages at once.
+ *
+ * The window determines the range to populate for a given fault. As long
+ * as faults occur right behind the previously populated range, the window
+ * doubles in size up to the declared read-ahead size. A fault elsewhere
+ * shrinks the window to its minimum size.
+ */
+class Genode::Read_ahead_window
+{
+	public:
+
+		struct Range { addr_t base; size_t size; };
+
+	private:
+
+		enum { PAGE_SIZE_LOG2 = 12, PAGE_SIZE = 1UL << PAGE_SIZE_LOG2 };
+
+		size_t const _min_size;
+		size_t const _max_size;
+
+		size_t _size = _min_size;
+
+		/* expected address of the next fault of a sequential access */
+		addr_t _next = ~0UL;
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param min_size  size populated at a random fault
+		 * \param max_size  read-ahead size of a sequential access
+		 *
+		 * Both sizes are rounded up to the page size.
+		 */
+		Read_ahead_window(size_t min_size, size_t max_size)
+		:
+			_min_size(align_addr(max(min_size, (size_t)PAGE_SIZE), PAGE_SIZE_LOG2)),
+			_max_size(align_addr(max(max_size, _min_size), PAGE_SIZE_LOG2))
+		{ }
+
+		/**
+		 * Return range to populate for resolving a fault
+		 *
+		 * \param fault_addr  fault address as reported by 'Region_map::state'
+		 * \param limit       end of the unpopulated part of the region map
+		 *                    behind 'fault_addr', i.e., the size of the
+		 *                    region map or the start of the next attachment
+		 *
+		 * The returned range starts at the page of the fault and never
+		 * exceeds 'limit'.
+		 */
+		Range range(addr_t fault_addr, addr_t limit)
+		{
+			addr_t const base = fault_addr & ~(PAGE_SIZE - 1);
+
+			_size = (base == _next) ? min(2*_size, _max_size) : _min_size;
+
+			size_t const size = (limit > base) ? min(_size, (size_t)(limit - base))
+			                                   : (size_t)PAGE_SIZE;
+			_next = base + size;
+
+			return Range { base, size };
+		}
+
+		/**
+		 * Forget the access pattern, e.g., after the region map got flushed
+		 */
+		void reset()
+		{
+			_size = _min_size;
+			_next = ~0UL;
+		}
+};
+
+#endif /* _INCLUDE__REGION_MAP__READ_AHEAD_H_ */
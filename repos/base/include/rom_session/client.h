@@ -33,6 +33,9 @@ struct Genode::Rom_session_client : Rpc_client<Rom_session>
 
 	void sigh(Signal_context_capability cap) override {
 		call<Rpc_sigh>(cap); }
+
+	Rom_dataspace_capability shared_dataspace() override {
+		return call<Rpc_shared_dataspace>(); }
 };
 
 #endif /* _INCLUDE__ROM_SESSION__CLIENT_H_ */
@@ -106,6 +106,40 @@ struct Genode::Rom_session : Session
 	 */
 	virtual void sigh(Signal_context_capability sigh) = 0;
 
+	/**
+	 * Layout of the dataspace returned by 'shared_dataspace'
+	 *
+	 * The content follows the header at 'SHARED_CONTENT_OFFSET'. The
+	 * server increments 'generation' before and after each modification
+	 * of the content. Hence, the generation is odd while a modification
+	 * is in progress. Once the content no longer fits in the dataspace,
+	 * the server sets 'retired'. The client must then detach the
+	 * dataspace and request a new one.
+	 */
+	struct Shared_header
+	{
+		unsigned long volatile generation;
+		size_t        volatile size;
+		bool          volatile retired;
+	};
+
+	enum { SHARED_CONTENT_OFFSET = 64 };
+
+	/**
+	 * Request dataspace that is updated by the server in place
+	 *
+	 * This method is an optimization for ROM modules that change at a
+	 * high rate. Whenever the content changes, the server writes the new
+	 * content to the shared dataspace before notifying the client. The
+	 * client obtains the content by copying it from the dataspace, which
+	 * does not involve any RPC, see 'Attached_shared_rom_dataspace'.
+	 *
+	 * \return  capability to the shared dataspace, or an invalid
+	 *          capability if the server does not support shared content
+	 */
+	virtual Rom_dataspace_capability shared_dataspace() {
+		return Rom_dataspace_capability(); }
+
 
 	/*********************
 	 ** RPC declaration **
@@ -114,8 +148,10 @@ struct Genode::Rom_session : Session
 	GENODE_RPC(Rpc_dataspace, Rom_dataspace_capability, dataspace);
 	GENODE_RPC(Rpc_sigh, void, sigh, Signal_context_capability);
 	GENODE_RPC(Rpc_update, bool, update);
+	GENODE_RPC(Rpc_shared_dataspace, Rom_dataspace_capability, shared_dataspace);
 
-	GENODE_RPC_INTERFACE(Rpc_dataspace, Rpc_update, Rpc_sigh);
+	GENODE_RPC_INTERFACE(Rpc_dataspace, Rpc_update, Rpc_sigh,
+	                     Rpc_shared_dataspace);
 };
 
 #endif /* _INCLUDE__ROM_SESSION__ROM_SESSION_H_ */
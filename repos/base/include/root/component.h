@@ -21,6 +21,7 @@
 #include <base/allocator.h>
 #include <base/rpc_server.h>
 #include <base/entrypoint.h>
+#include <base/entrypoint_pool.h>
 #include <base/service.h>
 #include <util/arg_string.h>
 #include <base/log.h>
@@ -107,6 +108,11 @@ class Genode::Root_component : public Rpc_object<Typed_root<SESSION_TYPE> >,
 		 */
 		Rpc_entrypoint *_ep;
 
+		/*
+		 * Optional pool of entrypoints that serve the session objects
+		 */
+		Entrypoint_pool *_ep_pool = nullptr;
+
 		/*
 		 * Allocator for allocating session objects.
 		 * This allocator must be used by the derived
@@ -196,8 +202,10 @@ class Genode::Root_component : public Rpc_object<Typed_root<SESSION_TYPE> >,
 			 * Consider that the session-object constructor may already have
 			 * called 'manage'.
 			 */
-			if (!s->cap().valid())
-				_ep->manage(s);
+			if (!s->cap().valid()) {
+				if (_ep_pool) _ep_pool->manage(*s);
+				else          _ep->manage(s);
+			}
 
 			aquire_guard.ack = true;
 			return *s;
@@ -272,6 +280,12 @@ class Genode::Root_component : public Rpc_object<Typed_root<SESSION_TYPE> >,
 		 */
 		Rpc_entrypoint *ep() { return _ep; }
 
+		/**
+		 * Return entrypoint that manages the given session
+		 */
+		Rpc_entrypoint &_session_ep(Session_capability session) {
+			return _ep_pool ? _ep_pool->ep_of(session) : *_ep; }
+
 	public:
 
 		/**
@@ -287,6 +301,21 @@ class Genode::Root_component : public Rpc_object<Typed_root<SESSION_TYPE> >,
 			_ep(&ep.rpc_ep()), _md_alloc(&md_alloc)
 		{ }
 
+		/**
+		 * Constructor
+		 *
+		 * \param ep_pool   entrypoints that manage the sessions of this
+		 *                  root interface, sessions that inherit
+		 *                  'Entrypoint_pool::Concurrent' are distributed
+		 *                  over all entrypoints of the pool
+		 * \param md_alloc  meta-data allocator providing the backing store
+		 *                  for session objects
+		 */
+		Root_component(Entrypoint_pool &ep_pool, Allocator &md_alloc)
+		:
+			_ep(&ep_pool.primary()), _ep_pool(&ep_pool), _md_alloc(&md_alloc)
+		{ }
+
 		/**
 		 * Constructor
 		 *
@@ -340,7 +369,7 @@ class Genode::Root_component : public Rpc_object<Typed_root<SESSION_TYPE> >,
 		{
 			if (!args.valid_string()) throw Service_denied();
 
-			_ep->apply(session, [&] (SESSION_TYPE *s) {
+			_session_ep(session).apply(session, [&] (SESSION_TYPE *s) {
 				if (!s) return;
 
 				_upgrade_session(s, args.string());
@@ -351,11 +380,13 @@ class Genode::Root_component : public Rpc_object<Typed_root<SESSION_TYPE> >,
 		{
 			SESSION_TYPE * session;
 
-			_ep->apply(session_cap, [&] (SESSION_TYPE *s) {
+			Rpc_entrypoint &ep = _session_ep(session_cap);
+
+			ep.apply(session_cap, [&] (SESSION_TYPE *s) {
 				session = s;
 
 				/* let the entry point forget the session object */
-				if (session) _ep->dissolve(session);
+				if (session) ep.dissolve(session);
 			});
 
 			if (!session) return;
@@ -17,25 +17,179 @@
 
 #include <util/bit_array.h>
 
-namespace Genode { template<unsigned> class Bit_allocator; } 
+namespace Genode {
 
+	class Bit_allocator_base;
+	template<unsigned> class Bit_allocator;
+}
 
-template<unsigned BITS>
-class Genode::Bit_allocator
+
+/**
+ * Bitmap allocator operating on caller-provided storage
+ *
+ * In addition to the bitmap, the allocator maintains a hierarchy of
+ * summary bitmaps, in which each bit denotes whether the corresponding
+ * word of the level below is completely allocated. Finding a free bit
+ * thereby takes one word lookup per level instead of a scan over the
+ * whole bitmap. Aligned allocations of multiple bits skip completely
+ * allocated words via the summary.
+ */
+class Genode::Bit_allocator_base
 {
 	protected:
 
 		enum {
 			BITS_PER_BYTE = 8UL,
 			BITS_PER_WORD = sizeof(addr_t) * BITS_PER_BYTE,
-			BITS_ALIGNED  = (BITS + BITS_PER_WORD - 1UL)
-			                & ~(BITS_PER_WORD - 1UL),
+			MAX_LEVELS    = 8, /* sufficient for any 'unsigned' count of bits */
 		};
 
-		using Array = Bit_array<BITS_ALIGNED>;
+		enum : addr_t { INVALID = ~0UL };
+
+		static constexpr unsigned _words(unsigned bits) {
+			return (bits + BITS_PER_WORD - 1) / BITS_PER_WORD; }
+
+		/**
+		 * Return number of summary words needed for 'words' bitmap words
+		 */
+		static constexpr unsigned _summary_words(unsigned words) {
+			return words <= 1 ? 0 : _words(words) + _summary_words(_words(words)); }
+
+	public:
+
+		/**
+		 * Return number of words needed as storage for 'bits' bits
+		 *
+		 * The value of 'bits' must be a multiple of the word size.
+		 */
+		static constexpr unsigned storage_words(unsigned bits) {
+			return _words(bits) + _summary_words(_words(bits)); }
+
+	private:
+
+		Bit_array_base _array;
+
+		/*
+		 * Level 0 refers to the words of the bitmap, the top-most level
+		 * consists of a single word.
+		 */
+		addr_t   *_level[MAX_LEVELS];
+		unsigned  _level_words[MAX_LEVELS];
+		unsigned  _num_levels = 0;
+
+		static addr_t _first_set(addr_t word) { return __builtin_ctzl(word); }
+
+		/**
+		 * Update summary bits for bitmap word 'word'
+		 */
+		void _propagate(addr_t word)
+		{
+			for (unsigned l = 0; l + 1 < _num_levels; l++) {
+
+				addr_t &parent   = _level[l + 1][word / BITS_PER_WORD];
+				addr_t  const bit = 1UL << (word % BITS_PER_WORD);
+				bool    const was_full = (parent == ~0UL);
+
+				if (_level[l][word] == ~0UL) parent |=  bit;
+				else                         parent &= ~bit;
+
+				/* levels above are unaffected if fill state keeps the same */
+				if ((parent == ~0UL) == was_full)
+					return;
+
+				word /= BITS_PER_WORD;
+			}
+		}
+
+		void _update(addr_t const index, addr_t const width)
+		{
+			addr_t const last = (index + width - 1) / BITS_PER_WORD;
+			for (addr_t word = index / BITS_PER_WORD; word <= last; word++)
+				_propagate(word);
+		}
+
+		/**
+		 * Return index of first free bit at or after 'index'
+		 */
+		addr_t _first_free(addr_t index) const
+		{
+			unsigned l = 0;
+
+			/* ascend until a word with a free bit at or after 'index' is found */
+			for (;;) {
+				addr_t const word = index / BITS_PER_WORD;
+				if (word >= _level_words[l])
+					return INVALID;
+
+				addr_t const used = _level[l][word]
+				                  | ((1UL << (index % BITS_PER_WORD)) - 1);
+				if (used != ~0UL) {
+					index = word*BITS_PER_WORD + _first_set(~used);
+					break;
+				}
+
+				if (l + 1 == _num_levels)
+					return INVALID;
+
+				/* continue with the next word of this level */
+				index = word + 1;
+				l++;
+			}
 
-		addr_t _next;
-		Array  _array;
+			/* descend along not completely allocated words */
+			while (l-- > 0)
+				index = index*BITS_PER_WORD + _first_set(~_level[l][index]);
+
+			return index;
+		}
+
+		/**
+		 * Return index of first free and aligned block of 'step' bits at or
+		 * after 'index', which must be aligned to 'step'
+		 */
+		addr_t _first_free(addr_t index, addr_t const step) const
+		{
+			if (step == 1)
+				return _first_free(index);
+
+			addr_t * const words = _level[0];
+
+			if (step >= BITS_PER_WORD) {
+				addr_t const num = step / BITS_PER_WORD;
+				for (addr_t w = index / BITS_PER_WORD; w + num <= _level_words[0]; w += num) {
+					addr_t i = 0;
+					for (; i < num && !words[w + i]; i++);
+					if (i == num)
+						return w*BITS_PER_WORD;
+				}
+				return INVALID;
+			}
+
+			/* bit pattern with one bit set at each multiple of 'step' */
+			addr_t const aligned = ~0UL / ((1UL << step) - 1);
+
+			while ((index = _first_free(index)) != INVALID) {
+
+				addr_t const word  = index / BITS_PER_WORD;
+				addr_t const below = (1UL << (index % BITS_PER_WORD)) - 1;
+
+				/* bits at which a free block of 'step' bits starts */
+				addr_t free = ~(words[word] | below);
+				for (addr_t shift = 1; shift < step; shift <<= 1)
+					free &= free >> shift;
+				free &= aligned;
+
+				if (free)
+					return word*BITS_PER_WORD + _first_set(free);
+
+				index = (word + 1)*BITS_PER_WORD;
+			}
+			return INVALID;
+		}
+
+	protected:
+
+		addr_t _next = 0;
 
 		/**
 		 * Reserve consecutive number of bits
@@ -47,47 +201,99 @@ class Genode::Bit_allocator
 			if (!num) return;
 
 			_array.set(bit_start, num);
+			_update(bit_start, num);
 		}
 
 	public:
 
 		class Out_of_indices : Exception {};
 
-		Bit_allocator() : _next(0) {
-			_reserve(BITS, BITS_ALIGNED - BITS); }
-		Bit_allocator(const Bit_allocator & o) : _next(0), _array(o._array) { }
-
-		addr_t alloc(size_t const num_log2 = 0)
+		/**
+		 * Constructor
+		 *
+		 * \param bits   number of bits, must be a multiple of the word size
+		 * \param words  storage of 'storage_words(bits)' words
+		 * \param clear  initialize storage, if false, the storage must
+		 *               contain the state of an allocator of equal size
+		 */
+		Bit_allocator_base(unsigned bits, addr_t *words, bool clear = true)
+		:
+			_array(bits, words, clear)
 		{
-			addr_t const step = 1UL << num_log2;
-			addr_t max = ~0UL;
+			unsigned num = _words(bits);
+			for (addr_t *level = words; ; level += num, num = _words(num)) {
 
-			do {
-				try {
-					/* throws exception if array is accessed outside bounds */
-					for (addr_t i = _next & ~(step - 1); i < max; i += step) {
-						if (_array.get(i, step))
-							continue;
+				_level[_num_levels]       = level;
+				_level_words[_num_levels] = num;
+				_num_levels++;
 
-						_array.set(i, step);
-						_next = i + step;
-						return i;
-					}
-				} catch (typename Array::Invalid_index_access) { }
+				if (num <= 1)
+					break;
+			}
 
-				max = _next;
-				_next = 0;
+			if (!clear)
+				return;
 
-			} while (max != 0);
+			/* mark bits beyond the last word of the level below as used */
+			for (unsigned l = 1; l < _num_levels; l++) {
+				memset(_level[l], 0, _level_words[l]*sizeof(addr_t));
 
-			throw Out_of_indices();
+				unsigned const children = _level_words[l - 1];
+				if (children % BITS_PER_WORD)
+					_level[l][_level_words[l] - 1] = ~0UL << (children % BITS_PER_WORD);
+			}
+		}
+
+		addr_t alloc(size_t const num_log2 = 0)
+		{
+			addr_t const step = 1UL << num_log2;
+
+			addr_t i = _first_free(_next & ~(step - 1), step);
+			if (i == INVALID)
+				i = _first_free(0, step);
+			if (i == INVALID)
+				throw Out_of_indices();
+
+			_array.set(i, step);
+			_update(i, step);
+			_next = i + step;
+			return i;
 		}
 
 		void free(addr_t const bit_start, size_t const num_log2 = 0)
 		{
 			_array.clear(bit_start, 1UL << num_log2);
+			_update(bit_start, 1UL << num_log2);
 			_next = bit_start;
 		}
 };
 
+
+template<unsigned BITS>
+class Genode::Bit_allocator : public Bit_allocator_base
+{
+	protected:
+
+		enum {
+			BITS_ALIGNED = (BITS + BITS_PER_WORD - 1UL)
+			               & ~(BITS_PER_WORD - 1UL),
+		};
+
+	private:
+
+		addr_t _storage[storage_words(BITS_ALIGNED)];
+
+	public:
+
+		Bit_allocator() : Bit_allocator_base(BITS_ALIGNED, _storage) {
+			_reserve(BITS, BITS_ALIGNED - BITS); }
+
+		Bit_allocator(const Bit_allocator & o)
+		:
+			Bit_allocator_base(BITS_ALIGNED,
+			                   (addr_t *)memcpy(_storage, o._storage, sizeof(_storage)),
+			                   false)
+		{ }
+};
+
 #endif /* _INCLUDE__UTIL__BIT_ALLOCATOR_H_ */
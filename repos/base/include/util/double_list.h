@@ -0,0 +1,143 @@
+/*
+ * \brief  Double connected list
+ * \author Genode Labs
+ * \date   2026-10-14
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__UTIL__DOUBLE_LIST_H_
+#define _INCLUDE__UTIL__DOUBLE_LIST_H_
+
+namespace Genode {
+
+	template <typename> class Double_list;
+	template <typename> class Double_list_element;
+}
+
+
+/**
+ * Double-connected list
+ *
+ * \param LT  list element type
+ *
+ * The interface corresponds to the one of 'List'. In contrast to 'List',
+ * the removal of an element takes constant time, which pays off for lists
+ * with many elements that are removed individually. Each element carries
+ * an additional back pointer.
+ */
+template <typename LT>
+class Genode::Double_list
+{
+	private:
+
+		LT *_first;
+
+	public:
+
+		class Element
+		{
+			protected:
+
+				friend class Double_list;
+
+				LT mutable *_next;
+				LT mutable *_prev;
+
+			public:
+
+				Element(): _next(0), _prev(0) { }
+
+				/**
+				 * Return next element in list
+				 */
+				LT *next() const { return _next; }
+		};
+
+	public:
+
+		/**
+		 * Constructor
+		 */
+		Double_list() : _first(0) { }
+
+		/**
+		 * Return first list element
+		 */
+		LT       *first()       { return _first; }
+		LT const *first() const { return _first; }
+
+		/**
+		 * Insert element after specified element into list
+		 *
+		 * \param  le  list element to insert
+		 * \param  at  target position (preceding list element)
+		 */
+		void insert(LT const *le, LT const *at = 0)
+		{
+			LT *next = at ? at->Element::_next : _first;
+
+			le->Element::_prev = const_cast<LT *>(at);
+			le->Element::_next = next;
+
+			if (next)
+				next->Element::_prev = const_cast<LT *>(le);
+
+			if (at)
+				at->Element::_next = const_cast<LT *>(le);
+			else
+				_first = const_cast<LT *>(le);
+		}
+
+		/**
+		 * Remove element from list
+		 *
+		 * The removal of an element that is not a member of any list is
+		 * ignored.
+		 */
+		void remove(LT const *le)
+		{
+			LT *prev = le->Element::_prev;
+			LT *next = le->Element::_next;
+
+			if (prev)
+				prev->Element::_next = next;
+			else if (le == _first)
+				_first = next;
+			else
+				return;  /* element is not member of the list */
+
+			if (next)
+				next->Element::_prev = prev;
+
+			le->Element::_next = 0;
+			le->Element::_prev = 0;
+		}
+};
+
+
+/**
+ * Helper for using member variables as list elements
+ *
+ * \param T  type of compound object to be organized in a list
+ *
+ * See 'List_element' for the rationale.
+ */
+template <typename T>
+class Genode::Double_list_element : public Double_list<Double_list_element<T> >::Element
+{
+	T *_object;
+
+	public:
+
+		Double_list_element(T *object) : _object(object) { }
+
+		T *object() const { return _object; }
+};
+
+#endif /* _INCLUDE__UTIL__DOUBLE_LIST_H_ */
@@ -30,29 +30,86 @@ class Genode::Xml_generator
 		 */
 		class Buffer_exceeded { };
 
+		/**
+		 * Buffer that can be enlarged while XML data is generated into it
+		 *
+		 * When the generated XML data exceeds the buffer, the generator
+		 * asks the buffer to expand instead of throwing 'Buffer_exceeded'.
+		 * Hence, the XML data is produced in one pass, regardless of its
+		 * size.
+		 */
+		struct Expanding_buffer
+		{
+			char  *base = nullptr;
+			size_t size = 0;
+
+			/**
+			 * Enlarge buffer, preserving its content
+			 *
+			 * \param min_size  minimum size of the enlarged buffer
+			 *
+			 * \return  false if the buffer cannot be enlarged
+			 *
+			 * The implementation must update 'base' and 'size'.
+			 */
+			virtual bool expand(size_t min_size) = 0;
+
+			virtual ~Expanding_buffer() { }
+		};
+
 	private:
 
+		/**
+		 * Buffer of fixed size as supplied to the regular constructor
+		 */
+		struct Fixed_buffer : Expanding_buffer
+		{
+			Fixed_buffer(char *dst, size_t dst_len) { base = dst; size = dst_len; }
+
+			bool expand(size_t) override { return false; }
+		};
+
 		/**
 		 * Buffer descriptor where the XML output goes to
 		 *
+		 * The descriptor refers to a range of the underlying buffer by its
+		 * offset. So it stays valid when the buffer is expanded and thereby
+		 * relocated.
+		 *
 		 * All 'append' methods may throw a 'Buffer_exceeded' exception.
 		 */
 		class Out_buffer
 		{
 			private:
 
-				char  *_dst;
-				size_t _capacity;
-				size_t _used = 0;
+				Expanding_buffer *_buffer;
+				size_t            _offset;
+				size_t            _capacity;
+				size_t            _used = 0;
+
+				char *_dst() const { return _buffer->base + _offset; }
 
-				void _check_advance(size_t const len) const {
+				void _check_advance(size_t const len) const
+				{
 					if (_used + len > _capacity)
-						throw Buffer_exceeded(); }
+						throw Buffer_exceeded();
+
+					size_t const min_size = _offset + _used + len;
+					if (min_size > _buffer->size && !_buffer->expand(min_size))
+						throw Buffer_exceeded();
+				}
 
 			public:
 
-				Out_buffer(char *dst, size_t capacity)
-				: _dst(dst), _capacity(capacity) { }
+				/**
+				 * Constructor
+				 *
+				 * \param capacity  maximum number of bytes, limited by the
+				 *                  size of the underlying buffer
+				 */
+				Out_buffer(Expanding_buffer &buffer, size_t offset = 0,
+				           size_t capacity = ~0UL)
+				: _buffer(&buffer), _offset(offset), _capacity(capacity) { }
 
 				void advance(size_t const len)
 				{
@@ -66,7 +123,7 @@ class Genode::Xml_generator
 				void append(char const c)
 				{
 					_check_advance(1);
-					_dst[_used] = c;
+					_dst()[_used] = c;
 					advance(1);
 				}
 
@@ -115,7 +172,7 @@ class Genode::Xml_generator
 				 * Return unused part of the buffer
 				 */
 				Out_buffer remainder() const {
-					return Out_buffer(_dst + _used, _capacity - _used); }
+					return Out_buffer(*_buffer, _offset + _used, _capacity - _used); }
 
 				/**
 				 * Insert gap into already populated part of the buffer
@@ -126,18 +183,18 @@ class Genode::Xml_generator
 				{
 					/* don't allow the insertion into non-populated part */
 					if (at > _used)
-						return Out_buffer(_dst + at, 0);
+						return Out_buffer(*_buffer, _offset + at, 0);
 
 					_check_advance(len);
-					memmove(_dst + at + len, _dst + at, _used - at);
+					memmove(_dst() + at + len, _dst() + at, _used - at);
 					advance(len);
 
-					return Out_buffer(_dst + at, len);
+					return Out_buffer(*_buffer, _offset + at, len);
 				}
 
 				bool has_trailing_newline() const
 				{
-					return (_used > 1) && (_dst[_used - 1] == '\n');
+					return (_used > 1) && (_dst()[_used - 1] == '\n');
 				}
 
 				/**
@@ -147,7 +204,7 @@ class Genode::Xml_generator
 
 				void discard_trailing_whitespace()
 				{
-					for (; _used > 0 && is_whitespace(_dst[_used - 1]); _used--);
+					for (; _used > 0 && is_whitespace(_dst()[_used - 1]); _used--);
 				}
 		};
 
@@ -281,9 +338,10 @@ class Genode::Xml_generator
 				}
 		};
 
-		Out_buffer _out_buffer;
-		Node      *_curr_node   = 0;
-		unsigned   _curr_indent = 0;
+		Fixed_buffer _fixed_buffer;
+		Out_buffer   _out_buffer;
+		Node        *_curr_node   = 0;
+		unsigned     _curr_indent = 0;
 
 	public:
 
@@ -291,7 +349,7 @@ class Genode::Xml_generator
 		Xml_generator(char *dst, size_t dst_len,
 		              char const *name, FUNC const &func)
 		:
-			_out_buffer(dst, dst_len)
+			_fixed_buffer(dst, dst_len), _out_buffer(_fixed_buffer)
 		{
 			if (dst) {
 				node(name, func);
@@ -299,6 +357,23 @@ class Genode::Xml_generator
 			}
 		}
 
+		/**
+		 * Constructor for generating XML data into an expanding buffer
+		 *
+		 * \throw Buffer_exceeded  buffer could not be expanded
+		 */
+		template <typename FUNC>
+		Xml_generator(Expanding_buffer &buffer,
+		              char const *name, FUNC const &func)
+		:
+			_fixed_buffer(nullptr, 0), _out_buffer(buffer)
+		{
+			if (buffer.base) {
+				node(name, func);
+				_out_buffer.append('\n');
+			}
+		}
+
 		template <typename FUNC>
 		void node(char const *name, FUNC const &func = [] () { } )
 		{
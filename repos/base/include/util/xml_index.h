@@ -0,0 +1,208 @@
+/*
+ * \brief  Index of the nodes of XML data
+ * \author Genode Labs
+ * \date   2026-10-14
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__UTIL__XML_INDEX_H_
+#define _INCLUDE__UTIL__XML_INDEX_H_
+
+#include <util/xml_node.h>
+#include <util/noncopyable.h>
+#include <base/allocator.h>
+
+namespace Genode { class Xml_index; }
+
+
+/**
+ * Pre-parsed representation of XML data
+ *
+ * An 'Xml_node' scans the XML data of the node whenever it is constructed,
+ * which happens for each sub node visited via 'sub_node', 'next', or
+ * 'for_each_sub_node'. For large XML data that is traversed repeatedly,
+ * e.g., the config of init with many '<start>' nodes, the index records
+ * the location of all nodes in a single pass. The nodes obtained via
+ * 'xml()' provide the regular 'Xml_node' interface but navigate between
+ * nodes via the index without scanning the XML data again.
+ *
+ * The index refers to the XML data, which must stay unmodified while the
+ * index exists. Nodes obtained from the index must not be used after the
+ * index is destructed.
+ */
+class Genode::Xml_index : Noncopyable
+{
+	private:
+
+		typedef Xml_node::Tag         Tag;
+		typedef Xml_node::Comment     Comment;
+		typedef Xml_node::Token       Token;
+		typedef Xml_node::Index_entry Entry;
+
+		/**
+		 * Call 'fn' for each tag of the node, including its own tags
+		 */
+		template <typename FN>
+		static void _for_each_tag(Xml_node const &node, FN const &fn)
+		{
+			Token t     = node._start_tag.token();
+			int   depth = 0;
+
+			do {
+				Comment comment(t);
+				if (comment.valid()) {
+					t = comment.next_token();
+					continue;
+				}
+
+				Tag tag(t);
+				if (tag.type() == Tag::INVALID) {
+					t = t.next();
+					continue;
+				}
+
+				fn(tag);
+
+				depth += (tag.type() == Tag::START);
+				depth -= (tag.type() == Tag::END);
+
+				t = tag.next_token();
+
+			} while (depth > 0 && t.type() != Token::END);
+		}
+
+		static unsigned _count_nodes(Xml_node const &node)
+		{
+			unsigned count = 0;
+			_for_each_tag(node, [&] (Tag const &tag) {
+				if (tag.node()) count++; });
+			return count;
+		}
+
+		/* state of a node whose end tag is not yet reached while indexing */
+		struct Open
+		{
+			unsigned    entry;
+			unsigned    last_sub_node;
+			char const *start_tag;
+			char const *content;
+		};
+
+		Allocator &_alloc;
+
+		unsigned const _count;
+
+		Entry * const _entries;
+
+		void _build(Xml_node const &node)
+		{
+			size_t const open_size = _count*sizeof(Open);
+
+			Open *open = nullptr;
+			try { open = (Open *)_alloc.alloc(open_size); }
+			catch (...) {
+				_alloc.free(_entries, _count*sizeof(Entry));
+				throw;
+			}
+
+			bool        valid = true;
+			unsigned    n     = 0;
+			unsigned    depth = 0;
+			char const *addr  = node.addr();
+
+			_for_each_tag(node, [&] (Tag const &tag) {
+
+				char const * const tag_start = tag.token().start();
+
+				if (tag.type() == Tag::END) {
+
+					Open &o = open[--depth];
+					_entries[o.entry].end = tag_start;
+
+					/* check that the end tag matches the start tag */
+					size_t const max_len = node._max_len - (o.start_tag - addr);
+					Token  const start_name =
+						Tag(Token(o.start_tag, max_len)).name();
+
+					if (start_name.len() != tag.name().len()
+					 || strcmp(start_name.start(), tag.name().start(),
+					           start_name.len()))
+						valid = false;
+					return;
+				}
+
+				/*
+				 * Like 'Xml_node::sub_node', let the first sub node start
+				 * right at the content of its parent
+				 */
+				char const *start = tag_start;
+
+				unsigned const index = n++;
+
+				if (depth) {
+					Open &parent = open[depth - 1];
+					_entries[parent.entry].num_sub_nodes++;
+					if (parent.last_sub_node)
+						_entries[parent.last_sub_node].next = index;
+					else
+						start = parent.content;
+					parent.last_sub_node = index;
+				}
+
+				_entries[index] = Entry { start, nullptr,
+				                          node._max_len - (start - addr), 0, 0 };
+
+				if (tag.type() == Tag::START)
+					open[depth++] = Open { index, 0, tag_start,
+					                       tag.next_token().start() };
+			});
+
+			_alloc.free(open, open_size);
+
+			if (!valid) {
+				_alloc.free(_entries, _count*sizeof(Entry));
+				throw Xml_node::Invalid_syntax();
+			}
+		}
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param alloc  allocator used for the index
+		 * \param node   top-level node of the XML data to index
+		 *
+		 * \throw Xml_node::Invalid_syntax  start and end tags of a sub node
+		 *                                  do not match
+		 * \throw Out_of_ram
+		 * \throw Out_of_caps
+		 */
+		Xml_index(Allocator &alloc, Xml_node const &node)
+		:
+			_alloc(alloc), _count(_count_nodes(node)),
+			_entries((Entry *)alloc.alloc(_count*sizeof(Entry)))
+		{
+			_build(node);
+		}
+
+		~Xml_index() { _alloc.free(_entries, _count*sizeof(Entry)); }
+
+		/**
+		 * Return top-level node of the indexed XML data
+		 */
+		Xml_node xml() const { return Xml_node(_entries, 0); }
+
+		/**
+		 * Return number of nodes contained in the XML data
+		 */
+		unsigned num_nodes() const { return _count; }
+};
+
+#endif /* _INCLUDE__UTIL__XML_INDEX_H_ */
@@ -20,6 +20,7 @@
 namespace Genode {
 	class Xml_attribute;
 	class Xml_node;
+	class Xml_index;
 }
 
 
@@ -443,12 +444,33 @@ class Genode::Xml_node
 			}
 		};
 
+		friend class Xml_index;
+
+		/**
+		 * Location of a node within the XML data, as recorded by 'Xml_index'
+		 *
+		 * The entries of an index are stored in document order. Hence, the
+		 * first sub node of a node follows the node's entry immediately.
+		 */
+		struct Index_entry
+		{
+			char const *start;          /* start tag                       */
+			char const *end;            /* end tag, or 0 for empty element */
+			size_t      max_len;        /* length of remaining XML data    */
+			int         num_sub_nodes;
+			unsigned    next;           /* next sibling, or 0 if last      */
+		};
+
 		const char *_addr;          /* first character of XML data      */
 		size_t      _max_len;       /* length of XML data in characters */
 		int         _num_sub_nodes; /* number of immediate sub nodes    */
 		Tag         _start_tag;
 		Tag         _end_tag;
 
+		/* index of the XML data, or 0 if the node is not indexed */
+		Index_entry const *_index = nullptr;
+		unsigned           _entry = 0;
+
 		/**
 		 * Search for end tag of XML node and initialize '_num_sub_nodes'
 		 *
@@ -565,6 +587,38 @@ class Genode::Xml_node
 			return Xml_node(at, _max_len - (at - addr()));
 		}
 
+		/**
+		 * Return first sub node, the node must have at least one sub node
+		 *
+		 * \throw Nonexistent_sub_node
+		 * \throw Invalid_syntax
+		 */
+		Xml_node _first_sub_node() const
+		{
+			if (_index)
+				return Xml_node(_index, _entry + 1);
+
+			return _sub_node(content_addr());
+		}
+
+		/**
+		 * Constructor used for nodes of an 'Xml_index'
+		 *
+		 * The end tag is taken from the index. So the XML data of the node
+		 * does not need to be scanned again.
+		 */
+		Xml_node(Index_entry const *index, unsigned entry)
+		:
+			_addr(index[entry].start),
+			_max_len(index[entry].max_len),
+			_num_sub_nodes(index[entry].num_sub_nodes),
+			_start_tag(skip_non_tag_characters(Token(_addr, _max_len))),
+			_end_tag(index[entry].end ? Tag(Token(index[entry].end,
+			                                      _max_len - (index[entry].end - _addr)))
+			                          : _start_tag),
+			_index(index), _entry(entry)
+		{ }
+
 	public:
 
 		/**
@@ -720,6 +774,13 @@ class Genode::Xml_node
 		 */
 		Xml_node next() const
 		{
+			/* the siblings of an indexed node are known, except for the root */
+			if (_index && _index[_entry].next)
+				return Xml_node(_index, _index[_entry].next);
+
+			if (_index && _entry)
+				throw Nonexistent_sub_node();
+
 			Token after_node = _end_tag.next_token();
 			after_node = skip_non_tag_characters(after_node);
 			try { return _sub_node(after_node.start()); }
@@ -769,7 +830,7 @@ class Genode::Xml_node
 
 				/* look up node at specified index */
 				try {
-					Xml_node curr_node = _sub_node(content_addr());
+					Xml_node curr_node = _first_sub_node();
 					for (; idx > 0; idx--)
 						curr_node = curr_node.next();
 					return curr_node;
@@ -790,7 +851,7 @@ class Genode::Xml_node
 
 				/* search for sub node of specified type */
 				try {
-					Xml_node curr_node = _sub_node(content_addr());
+					Xml_node curr_node = _first_sub_node();
 					for ( ; true; curr_node = curr_node.next())
 						if (curr_node.has_type(type))
 							return curr_node;
@@ -116,6 +116,12 @@ else
 #
 LD_OPT += --dynamic-list=$(BASE_DIR)/src/ld/genode_dyn.dl
 
+#
+# Provide the GNU symbol hash table in addition to the SysV table, the former
+# is preferred by the dynamic linker for symbol lookups
+#
+LD_OPT += --hash-style=both
+
 LD_SCRIPTS := $(LD_SCRIPT_DYN)
 LD_CMD     += -Wl,--dynamic-linker=$(DYNAMIC_LINKER).lib.so \
               -Wl,--eh-frame-hdr -Wl,-rpath-link=.
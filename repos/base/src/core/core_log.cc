@@ -17,6 +17,8 @@
 static Genode::Core_log_range range { 0, 0 };
 static unsigned range_pos   { 0 };
 
+static Genode::Binary_log *binary_log_ptr { nullptr };
+
 static void out_mem(char const c)
 {
 	struct Log_memory
@@ -43,6 +45,18 @@ static void out_mem(char const c)
 void Genode::init_core_log(Core_log_range const &r) { range = r; }
 
 
+void Genode::init_core_binary_log(Core_log_range const &r)
+{
+	Binary_log *log = reinterpret_cast<Binary_log *>(r.start);
+
+	log->init(r.size, CORE_BINARY_LOG_STRINGS);
+	binary_log_ptr = log;
+}
+
+
+Genode::Binary_log *Genode::core_binary_log() { return binary_log_ptr; }
+
+
 void Genode::Core_log::output(char const * str)
 {
 	for (unsigned i = 0; i < Genode::strlen(str); i++) {
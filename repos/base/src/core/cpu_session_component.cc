@@ -80,16 +80,24 @@ Thread_capability Cpu_session_component::create_thread(Capability<Pd_session> pd
 
 Affinity::Location Cpu_session_component::_thread_affinity(Affinity::Location location) const
 {
+	/* a thread without affinity may use all CPUs of the session */
+	if (!location.valid())
+		return _location;
+
 	/* convert session-local location to physical location */
 	int const x1 = location.xpos() + _location.xpos(),
 	          y1 = location.ypos() + _location.ypos(),
-	          x2 = location.xpos() +  location.width(),
-	          y2 = location.ypos() +  location.height();
+	          x2 = x1 + (int)location.width()  - 1,
+	          y2 = y1 + (int)location.height() - 1;
+
+	/* clip location to the bounds of the session */
+	int const last_x = _location.xpos() + (int)_location.width()  - 1,
+	          last_y = _location.ypos() + (int)_location.height() - 1;
 
-	int const clipped_x1 = max(_location.xpos(), x1),
-	          clipped_y1 = max(_location.ypos(), y1),
-	          clipped_x2 = max(_location.xpos() + (int)_location.width()  - 1, x2),
-	          clipped_y2 = max(_location.ypos() + (int)_location.height() - 1, y2);
+	int const clipped_x1 = min(max(_location.xpos(), x1), last_x),
+	          clipped_y1 = min(max(_location.ypos(), y1), last_y),
+	          clipped_x2 = max(min(last_x, x2), clipped_x1),
+	          clipped_y2 = max(min(last_y, y2), clipped_y1);
 
 	return Affinity::Location(clipped_x1, clipped_y1,
 	                          clipped_x2 - clipped_x1 + 1,
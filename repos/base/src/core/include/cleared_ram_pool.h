@@ -0,0 +1,309 @@
+/*
+ * \brief  Pool of physical memory that is cleared ahead of its allocation
+ * \author Genode Labs
+ * \date   2026-10-14
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _CORE__INCLUDE__CLEARED_RAM_POOL_H_
+#define _CORE__INCLUDE__CLEARED_RAM_POOL_H_
+
+/* Genode includes */
+#include <base/allocator_avl.h>
+#include <base/semaphore.h>
+#include <base/thread.h>
+#include <util/fifo.h>
+#include <util/misc_math.h>
+#include <util/reconstructible.h>
+
+namespace Genode { class Cleared_ram_pool; }
+
+
+/**
+ * Physical memory withheld from the RAM allocator and cleared by a thread
+ *
+ * The pool consists of a few chunks of physical memory. Dataspaces that fit
+ * into a chunk are allocated from the pool without clearing them in the
+ * context of the allocating client. Memory of freed pool dataspaces is
+ * cleared by the pool thread before it becomes available again. Whenever
+ * the amount of cleared memory drops below the target level, the thread
+ * adds another chunk.
+ */
+class Genode::Cleared_ram_pool : Thread_deprecated<2*4096>
+{
+	public:
+
+		/**
+		 * Function for clearing physical memory
+		 *
+		 * The function leaves the memory coherent with all caches.
+		 *
+		 * \return  false if the platform cannot clear memory this way
+		 */
+		typedef bool (*Clear_fn)(addr_t phys, size_t size);
+
+		enum {
+			CHUNK_SIZE_LOG2 = 22,
+			CHUNK_SIZE      = 1UL << CHUNK_SIZE_LOG2,
+			MAX_CHUNKS      = 8,
+			TARGET_CLEARED  = 2*CHUNK_SIZE,
+
+			/* leave free memory to the RAM allocator when running low */
+			PHYS_HEADROOM = 4*CHUNK_SIZE,
+		};
+
+	private:
+
+		struct Chunk
+		{
+			addr_t const  base;
+			Allocator_avl alloc;
+
+			/* bytes handed out or waiting to be cleared */
+			size_t used = 0;
+
+			Chunk(Allocator &md_alloc, addr_t base)
+			: base(base), alloc(&md_alloc) { alloc.add_range(base, CHUNK_SIZE); }
+
+			bool contains(addr_t addr) const {
+				return addr >= base && addr - base < CHUNK_SIZE; }
+		};
+
+		struct Dirty : Fifo<Dirty>::Element
+		{
+			Chunk &chunk;
+			addr_t const addr;
+			size_t const size;
+
+			Dirty(Chunk &chunk, addr_t addr, size_t size)
+			: chunk(chunk), addr(addr), size(size) { }
+		};
+
+		Range_allocator &_phys_alloc;
+		Allocator       &_md_alloc;
+		Clear_fn  const  _clear;
+
+		Lock _lock { };
+
+		Constructible<Chunk> _chunks[MAX_CHUNKS];
+
+		Fifo<Dirty> _dirty { };
+
+		size_t _cleared = 0;
+
+		bool      _refill_pending = false;
+		Semaphore _refill { };
+
+		addr_t const _high_start = (sizeof(void *) == 4 ? 3UL : 4UL) << 30;
+
+		void _wakeup()
+		{
+			if (_refill_pending)
+				return;
+
+			_refill_pending = true;
+			_refill.up();
+		}
+
+		/**
+		 * Add cleared chunk, return false if no memory could be obtained
+		 */
+		bool _grow()
+		{
+			if (_phys_alloc.avail() < PHYS_HEADROOM + CHUNK_SIZE)
+				return false;
+
+			Constructible<Chunk> *slot = nullptr;
+			{
+				Lock::Guard guard(_lock);
+				for (unsigned i = 0; i < MAX_CHUNKS && !slot; i++)
+					if (!_chunks[i].constructed())
+						slot = &_chunks[i];
+			}
+
+			/* slots are only populated by the pool thread */
+			if (!slot)
+				return false;
+
+			void *phys = nullptr;
+			if (!_phys_alloc.alloc_aligned(CHUNK_SIZE, &phys, CHUNK_SIZE_LOG2,
+			                               _high_start, ~0UL).ok()
+			 && !_phys_alloc.alloc_aligned(CHUNK_SIZE, &phys, CHUNK_SIZE_LOG2).ok())
+				return false;
+
+			if (!_clear((addr_t)phys, CHUNK_SIZE)) {
+				_phys_alloc.free(phys);
+				return false;
+			}
+
+			Lock::Guard guard(_lock);
+
+			slot->construct(_md_alloc, (addr_t)phys);
+			_cleared += CHUNK_SIZE;
+			return true;
+		}
+
+		bool _below_target()
+		{
+			Lock::Guard guard(_lock);
+			return _cleared < TARGET_CLEARED;
+		}
+
+		void entry() override
+		{
+			for (;;) {
+				_refill.down();
+
+				/* clear memory of freed dataspaces */
+				for (;;) {
+					Dirty *dirty = nullptr;
+					{
+						Lock::Guard guard(_lock);
+						dirty = _dirty.dequeue();
+					}
+					if (!dirty) break;
+
+					_clear(dirty->addr, dirty->size);
+
+					Lock::Guard guard(_lock);
+					dirty->chunk.alloc.free((void *)dirty->addr);
+					dirty->chunk.used -= dirty->size;
+					_cleared          += dirty->size;
+					destroy(_md_alloc, dirty);
+				}
+
+				while (_below_target() && _grow());
+
+				Lock::Guard guard(_lock);
+				_refill_pending = false;
+				if (!_dirty.empty())
+					_wakeup();
+			}
+		}
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param md_alloc  allocator for meta data, must be thread safe
+		 */
+		Cleared_ram_pool(Range_allocator &phys_alloc, Allocator &md_alloc,
+		                 Clear_fn clear)
+		:
+			Thread_deprecated("clear_ram"),
+			_phys_alloc(phys_alloc), _md_alloc(md_alloc), _clear(clear)
+		{
+			start();
+
+			Lock::Guard guard(_lock);
+			_wakeup();
+		}
+
+		/**
+		 * Allocate cleared memory
+		 *
+		 * \return  true on success, the memory must be released via 'free'
+		 */
+		bool alloc(size_t size, addr_t &phys)
+		{
+			if (size > CHUNK_SIZE)
+				return false;
+
+			Lock::Guard guard(_lock);
+
+			bool ok = false;
+
+			for (unsigned i = 0; i < MAX_CHUNKS && !ok; i++) {
+				if (!_chunks[i].constructed() || _chunks[i]->alloc.avail() < size)
+					continue;
+
+				Chunk &chunk = *_chunks[i];
+
+				/* prefer natural alignment as done for regular allocations */
+				for (size_t align_log2 = log2(size); align_log2 >= 12; align_log2--) {
+					void *addr = nullptr;
+					if (chunk.alloc.alloc_aligned(size, &addr, align_log2).ok()) {
+						phys        = (addr_t)addr;
+						chunk.used += size;
+						_cleared   -= size;
+						ok          = true;
+						break;
+					}
+				}
+			}
+
+			if (_cleared < TARGET_CLEARED)
+				_wakeup();
+
+			return ok;
+		}
+
+		/**
+		 * Return true if 'phys' was allocated from the pool
+		 */
+		bool owns(addr_t phys)
+		{
+			Lock::Guard guard(_lock);
+
+			for (unsigned i = 0; i < MAX_CHUNKS; i++)
+				if (_chunks[i].constructed() && _chunks[i]->contains(phys))
+					return true;
+
+			return false;
+		}
+
+		/**
+		 * Hand back a pool allocation for clearing by the pool thread
+		 */
+		void free(addr_t phys, size_t size)
+		{
+			Lock::Guard guard(_lock);
+
+			for (unsigned i = 0; i < MAX_CHUNKS; i++) {
+				if (!_chunks[i].constructed() || !_chunks[i]->contains(phys))
+					continue;
+
+				_dirty.enqueue(new (_md_alloc) Dirty(*_chunks[i], phys, size));
+				_wakeup();
+				return;
+			}
+		}
+
+		/**
+		 * Return unused chunks to the RAM allocator
+		 *
+		 * This is used as fallback when the RAM allocator runs out of
+		 * memory.
+		 *
+		 * \return  true if any memory was released
+		 */
+		bool release_unused()
+		{
+			Lock::Guard guard(_lock);
+
+			bool released = false;
+
+			for (unsigned i = 0; i < MAX_CHUNKS; i++) {
+				if (!_chunks[i].constructed() || _chunks[i]->used)
+					continue;
+
+				addr_t const base = _chunks[i]->base;
+
+				_chunks[i].destruct();
+				_cleared -= CHUNK_SIZE;
+				_phys_alloc.free((void *)base);
+				released = true;
+			}
+
+			return released;
+		}
+};
+
+#endif /* _CORE__INCLUDE__CLEARED_RAM_POOL_H_ */
@@ -16,6 +16,8 @@
 #define _CORE_LOG_H_
 
 #include <util/string.h>
+#include <base/binary_log.h>
+#include <trace/timestamp.h>
 
 namespace Genode {
 	struct Core_log;
@@ -25,7 +27,29 @@ namespace Genode {
 		addr_t size;
 	};
 
+	/* pages of the binary log following the page of the text log */
+	enum { CORE_BINARY_LOG_PAGES = 4, CORE_BINARY_LOG_STRINGS = 1024 };
+
 	void init_core_log(Core_log_range const &);
+
+	void init_core_binary_log(Core_log_range const &);
+
+	/**
+	 * Return binary log of core, or nullptr if not available
+	 */
+	Binary_log *core_binary_log();
+
+	/**
+	 * Record message in the binary log, formatted by its consumer
+	 *
+	 * In contrast to the text log, the message costs a few stores only.
+	 */
+	template <typename... ARGS>
+	void binary_log(Binary_log::Format &fmt, ARGS... args)
+	{
+		if (Binary_log *log = core_binary_log())
+			log->log(fmt, Trace::timestamp(), args...);
+	}
 }
 
 
@@ -23,6 +23,7 @@
 
 /* core includes */
 #include <dataspace_component.h>
+#include <cleared_ram_pool.h>
 
 namespace Genode { class Ram_dataspace_factory; }
 
@@ -81,6 +82,23 @@ class Genode::Ram_dataspace_factory : public Ram_allocator,
 		 */
 		void _clear_ds(Dataspace_component *ds);
 
+		/**
+		 * Zero-out physical memory ahead of its use for a dataspace
+		 *
+		 * Unlike '_clear_ds', the function leaves the memory coherent with
+		 * all caches so that it can back dataspaces of any cacheability.
+		 * A 'size' of zero queries whether the platform supports clearing
+		 * memory this way.
+		 *
+		 * \return  false if clearing memory ahead of time is not supported
+		 */
+		static bool _clear_ahead(addr_t phys, size_t size);
+
+		/**
+		 * Return pool of cleared memory, or nullptr if not supported
+		 */
+		Cleared_ram_pool *_cleared_ram_pool();
+
 	public:
 
 		Ram_dataspace_factory(Rpc_entrypoint  &ep,
@@ -239,6 +239,8 @@ class Genode::Trace::Subject
 		{
 			Execution_time execution_time;
 			Affinity::Location affinity;
+			unsigned long migrations = 0;
+			unsigned long wakeups    = 0;
 
 			{
 				Locked_ptr<Source> source(_source);
@@ -247,11 +249,14 @@ class Genode::Trace::Subject
 					Trace::Source::Info const info = source->info();
 					execution_time = info.execution_time;
 					affinity       = info.affinity;
+					migrations     = info.migrations;
+					wakeups        = info.wakeups;
 				}
 			}
 
 			return Subject_info(_label, _name, _state(), _policy_id,
-			                    execution_time, affinity);
+			                    execution_time, affinity, migrations,
+			                    wakeups);
 		}
 
 		Dataspace_capability buffer() const { return _buffer.dataspace(); }
@@ -16,10 +16,23 @@
 
 /* core includes */
 #include <ram_dataspace_factory.h>
+#include <platform.h>
 
 using namespace Genode;
 
 
+Cleared_ram_pool *Ram_dataspace_factory::_cleared_ram_pool()
+{
+	static Cleared_ram_pool *pool = _clear_ahead(0, 0)
+		? new (platform()->core_mem_alloc())
+			Cleared_ram_pool(_phys_alloc, *platform()->core_mem_alloc(),
+			                 _clear_ahead)
+		: nullptr;
+
+	return pool;
+}
+
+
 Ram_dataspace_capability
 Ram_dataspace_factory::alloc(size_t ds_size, Cache_attribute cached)
 {
@@ -40,33 +53,58 @@ Ram_dataspace_factory::alloc(size_t ds_size, Cache_attribute cached)
 	void *ds_addr = 0;
 	bool alloc_succeeded = false;
 
+	bool const any_phys_range = (_phys_range.start == 0 && _phys_range.end == ~0UL);
+
 	/*
-	 * If no physical constraint exists, try to allocate physical memory at
-	 * high locations (3G for 32-bit / 4G for 64-bit platforms) in order to
-	 * preserve lower physical regions for device drivers, which may have DMA
-	 * constraints.
+	 * Dataspaces without physical constraint are preferably backed by memory
+	 * that was cleared ahead of time, which spares the clearing below.
 	 */
-	if (_phys_range.start == 0 && _phys_range.end == ~0UL) {
-		addr_t const high_start = (sizeof(void *) == 4 ? 3UL : 4UL) << 30;
-		for (size_t align_log2 = log2(ds_size); align_log2 >= 12; align_log2--) {
-			if (_phys_alloc.alloc_aligned(ds_size, &ds_addr, align_log2,
-			                              high_start, _phys_range.end).ok()) {
-				alloc_succeeded = true;
-				break;
+	Cleared_ram_pool * const pool = any_phys_range ? _cleared_ram_pool() : nullptr;
+
+	addr_t cleared_addr = 0;
+	bool const precleared = pool && pool->alloc(ds_size, cleared_addr);
+	if (precleared) {
+		ds_addr         = (void *)cleared_addr;
+		alloc_succeeded = true;
+	}
+
+	auto alloc_phys = [&] ()
+	{
+		/*
+		 * If no physical constraint exists, try to allocate physical memory at
+		 * high locations (3G for 32-bit / 4G for 64-bit platforms) in order to
+		 * preserve lower physical regions for device drivers, which may have DMA
+		 * constraints.
+		 */
+		if (any_phys_range) {
+			addr_t const high_start = (sizeof(void *) == 4 ? 3UL : 4UL) << 30;
+			for (size_t align_log2 = log2(ds_size); align_log2 >= 12; align_log2--) {
+				if (_phys_alloc.alloc_aligned(ds_size, &ds_addr, align_log2,
+				                              high_start, _phys_range.end).ok()) {
+					alloc_succeeded = true;
+					break;
+				}
 			}
 		}
-	}
 
-	/* apply constraints or re-try because higher memory allocation failed */
-	if (!alloc_succeeded) {
-		for (size_t align_log2 = log2(ds_size); align_log2 >= 12; align_log2--) {
-			if (_phys_alloc.alloc_aligned(ds_size, &ds_addr, align_log2,
-			                              _phys_range.start, _phys_range.end).ok()) {
-				alloc_succeeded = true;
-				break;
+		/* apply constraints or re-try because higher memory allocation failed */
+		if (!alloc_succeeded) {
+			for (size_t align_log2 = log2(ds_size); align_log2 >= 12; align_log2--) {
+				if (_phys_alloc.alloc_aligned(ds_size, &ds_addr, align_log2,
+				                              _phys_range.start, _phys_range.end).ok()) {
+					alloc_succeeded = true;
+					break;
+				}
 			}
 		}
-	}
+	};
+
+	if (!alloc_succeeded)
+		alloc_phys();
+
+	/* memory withheld by the pool may be needed to satisfy the request */
+	if (!alloc_succeeded && pool && pool->release_unused())
+		alloc_phys();
 
 	/*
 	 * Helper to release the allocated physical memory whenever we leave the
@@ -74,16 +112,25 @@ Ram_dataspace_factory::alloc(size_t ds_size, Cache_attribute cached)
 	 */
 	struct Phys_alloc_guard
 	{
-		Range_allocator &phys_alloc;
-		void * const ds_addr;
+		Range_allocator  &phys_alloc;
+		Cleared_ram_pool *pool;
+		void * const      ds_addr;
+		size_t const      ds_size;
 		bool ack = false;
 
-		Phys_alloc_guard(Range_allocator &phys_alloc, void *ds_addr)
-		: phys_alloc(phys_alloc), ds_addr(ds_addr) { }
+		Phys_alloc_guard(Range_allocator &phys_alloc, Cleared_ram_pool *pool,
+		                 void *ds_addr, size_t ds_size)
+		: phys_alloc(phys_alloc), pool(pool), ds_addr(ds_addr), ds_size(ds_size) { }
 
-		~Phys_alloc_guard() { if (!ack) phys_alloc.free(ds_addr); }
+		~Phys_alloc_guard()
+		{
+			if (ack) return;
+
+			if (pool) pool->free((addr_t)ds_addr, ds_size);
+			else      phys_alloc.free(ds_addr);
+		}
 
-	} phys_alloc_guard(_phys_alloc, ds_addr);
+	} phys_alloc_guard(_phys_alloc, precleared ? pool : nullptr, ds_addr, ds_size);
 
 	/*
 	 * Normally, init's quota equals the size of physical memory and this quota
@@ -123,7 +170,8 @@ Ram_dataspace_factory::alloc(size_t ds_size, Cache_attribute cached)
 	 * function must also make sure to flush all cache lines related to the
 	 * address range used by the dataspace.
 	 */
-	_clear_ds(ds);
+	if (!precleared)
+		_clear_ds(ds);
 
 	Dataspace_capability result = _ep.manage(ds);
 
@@ -155,7 +203,11 @@ void Ram_dataspace_factory::free(Ram_dataspace_capability ds_cap)
 		_revoke_ram_ds(ds);
 
 		/* free physical memory that was backing the dataspace */
-		_phys_alloc.free((void *)ds->phys_addr(), ds_size);
+		Cleared_ram_pool * const pool = _cleared_ram_pool();
+		if (pool && pool->owns(ds->phys_addr()))
+			pool->free(ds->phys_addr(), ds_size);
+		else
+			_phys_alloc.free((void *)ds->phys_addr(), ds_size);
 	});
 
 	/* call dataspace destructor and free memory */
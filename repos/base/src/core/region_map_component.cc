@@ -24,6 +24,7 @@
 #include <cpu_session_component.h>
 #include <region_map_component.h>
 #include <dataspace_component.h>
+#include <core_log.h>
 
 static const bool verbose             = false;
 static const bool verbose_page_faults = false;
@@ -162,6 +163,25 @@ static void print_page_fault(char const *msg,
 }
 
 
+/**
+ * Record page fault in the binary log
+ *
+ * In contrast to 'print_page_fault', this is cheap enough to be done for
+ * each page fault.
+ */
+static void record_page_fault(addr_t pf_addr, addr_t pf_ip,
+                              Region_map::State::Fault_type pf_type)
+{
+	static Binary_log::Format read  { "page fault (READ pf_addr=%lx pf_ip=%lx)",  0 };
+	static Binary_log::Format write { "page fault (WRITE pf_addr=%lx pf_ip=%lx)", 0 };
+	static Binary_log::Format exec  { "page fault (EXEC pf_addr=%lx pf_ip=%lx)",  0 };
+
+	binary_log(pf_type == Region_map::State::WRITE_FAULT ? write :
+	           pf_type == Region_map::State::READ_FAULT  ? read  : exec,
+	           pf_addr, pf_ip);
+}
+
+
 /***********************
  ** Region-map client **
  ***********************/
@@ -180,6 +200,8 @@ int Rm_client::pager(Ipc_pager &pager)
 	addr_t pf_addr = pager.fault_addr();
 	addr_t pf_ip   = pager.fault_ip();
 
+	record_page_fault(pf_addr, pf_ip, pf_type);
+
 	if (verbose_page_faults)
 		print_page_fault("page fault", pf_addr, pf_ip, pf_type, *this);
 
@@ -18,21 +18,35 @@
 #include <util/retry.h>
 #include <pd_session/client.h>
 
+/* base-internal includes */
+#include <base/internal/upgrade_policy.h>
+
 namespace Genode { class Expanding_pd_session_client; }
 
 
 struct Genode::Expanding_pd_session_client : Pd_session_client
 {
+	/*
+	 * The parent may have to ask its own parent for the requested
+	 * resources. The limits are therefore modest.
+	 */
+	enum { RAM_REQUEST_LIMIT = 256*1024, CAP_REQUEST_LIMIT = 32 };
+
+	Upgrade_policy _ram_requests { RAM_REQUEST_LIMIT };
+	Upgrade_policy _cap_requests { CAP_REQUEST_LIMIT };
+
 	void _request_ram_from_parent(size_t amount)
 	{
 		Parent &parent = *env_deprecated()->parent();
-		parent.resource_request(String<128>("ram_quota=", amount).string());
+		parent.resource_request(String<128>("ram_quota=",
+		                                    _ram_requests.amount(amount)).string());
 	}
 
 	void _request_caps_from_parent(size_t amount)
 	{
 		Parent &parent = *env_deprecated()->parent();
-		parent.resource_request(String<128>("cap_quota=", amount).string());
+		parent.resource_request(String<128>("cap_quota=",
+		                                    _cap_requests.amount(amount)).string());
 	}
 
 	Expanding_pd_session_client(Pd_session_capability cap) : Pd_session_client(cap) { }
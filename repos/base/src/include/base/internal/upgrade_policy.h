@@ -0,0 +1,85 @@
+/*
+ * \brief  Policy for the amount of quota upgrades
+ * \author Genode Labs
+ * \date   2026-10-14
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__BASE__INTERNAL__UPGRADE_POLICY_H_
+#define _INCLUDE__BASE__INTERNAL__UPGRADE_POLICY_H_
+
+/* Genode includes */
+#include <util/misc_math.h>
+
+namespace Genode { class Upgrade_policy; }
+
+
+/**
+ * Exponential batching of quota upgrades
+ *
+ * Each upgrade of a session quota or resource request to the parent costs
+ * RPCs and the retry of the failed operation. A client that grows steadily
+ * would pay those costs for each small step. Hence, each upgrade is twice
+ * as large as the previous one, bounded by a limit. The first upgrade
+ * covers the amount needed only.
+ */
+class Genode::Upgrade_policy
+{
+	private:
+
+		size_t _limit;
+
+		size_t _batch = 0;
+
+		unsigned long _upgrades = 0;
+		size_t        _total    = 0;
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param limit  maximum amount of a single upgrade, an upgrade
+		 *               covers the needed amount regardless of the limit
+		 */
+		Upgrade_policy(size_t limit) : _limit(limit) { }
+
+		/**
+		 * Return amount of the next upgrade
+		 *
+		 * \param needed  amount needed to resolve the current shortage
+		 */
+		size_t amount(size_t needed)
+		{
+			size_t const amount = max(needed, _batch);
+
+			_batch     = min(2*amount, max(_limit, needed));
+			_upgrades += 1;
+			_total    += amount;
+
+			return amount;
+		}
+
+		/**
+		 * Define maximum amount of a single upgrade
+		 */
+		void limit(size_t limit) { _limit = limit; }
+
+		/**
+		 * Return number of upgrades issued so far
+		 */
+		unsigned long upgrades() const { return _upgrades; }
+
+		/**
+		 * Return sum of all upgrades issued so far
+		 */
+		size_t total() const { return _total; }
+};
+
+#endif /* _INCLUDE__BASE__INTERNAL__UPGRADE_POLICY_H_ */
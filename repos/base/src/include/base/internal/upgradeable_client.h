@@ -17,30 +17,61 @@
 #include <base/env.h>
 #include <base/log.h>
 
+/* base-internal includes */
+#include <base/internal/upgrade_policy.h>
+
 namespace Genode { template <typename> struct Upgradeable_client; }
 
 
 /**
  * Client object for a session that may get its session quota upgraded
+ *
+ * The upgrades are batched according to the 'Upgrade_policy'. The
+ * policies also keep the statistics about the upgrades of the session.
  */
 template <typename CLIENT>
 struct Genode::Upgradeable_client : CLIENT
 {
 	typedef Genode::Capability<typename CLIENT::Rpc_interface> Capability;
 
+	enum { RAM_UPGRADE_LIMIT = 64*1024, CAP_UPGRADE_LIMIT = 16 };
+
 	Parent::Client::Id _id;
 
+	Upgrade_policy _ram_upgrades { RAM_UPGRADE_LIMIT };
+	Upgrade_policy _cap_upgrades { CAP_UPGRADE_LIMIT };
+
 	Upgradeable_client(Capability cap, Parent::Client::Id id)
 	: CLIENT(cap), _id(id) { }
 
+	/**
+	 * Upgrade session by at least 'quota' bytes
+	 */
 	void upgrade_ram(size_t quota)
 	{
-		env_deprecated()->parent()->upgrade(_id, String<64>("ram_quota=", quota).string());
+		size_t const amount = _ram_upgrades.amount(quota);
+		env_deprecated()->parent()->upgrade(_id, String<64>("ram_quota=", amount).string());
 	}
 
+	/**
+	 * Upgrade session by at least 'quota' capabilities
+	 */
 	void upgrade_caps(size_t quota)
 	{
-		env_deprecated()->parent()->upgrade(_id, String<64>("cap_quota=", quota).string());
+		size_t const amount = _cap_upgrades.amount(quota);
+		env_deprecated()->parent()->upgrade(_id, String<64>("cap_quota=", amount).string());
+	}
+
+	Upgrade_policy const &ram_upgrades() const { return _ram_upgrades; }
+	Upgrade_policy const &cap_upgrades() const { return _cap_upgrades; }
+
+	/**
+	 * Define the maximum amounts of single upgrades
+	 */
+	void upgrade_limits(size_t ram, size_t caps)
+	{
+		_ram_upgrades.limit(ram);
+		_cap_upgrades.limit(caps);
 	}
 };
 
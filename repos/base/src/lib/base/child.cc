@@ -49,6 +49,16 @@ void Child::notify_resource_avail() const
 }
 
 
+void Child::heartbeat()
+{
+	if (!_heartbeat_sigh.valid())
+		return;
+
+	Signal_transmitter(_heartbeat_sigh).submit();
+	_outstanding_heartbeats++;
+}
+
+
 void Child::announce(Parent::Service_name const &name)
 {
 	if (!name.valid_string()) return;
@@ -648,6 +658,16 @@ Parent::Resource_args Child::yield_request()
 void Child::yield_response() { _policy.yield_response(); }
 
 
+void Child::heartbeat_sigh(Signal_context_capability sigh)
+{
+	_heartbeat_sigh         = sigh;
+	_outstanding_heartbeats = 0;
+}
+
+
+void Child::heartbeat_response() { _outstanding_heartbeats = 0; }
+
+
 namespace {
 
 	/**
@@ -688,6 +708,9 @@ void Child::_try_construct_env_dependent_members()
 	if (_linker.constructed() && !_linker->cap().valid())
 		return;
 
+	if (_process_pending)
+		return;
+
 	/*
 	 * Mark all environment sessions as handed out to prevent the triggering
 	 * of signals by 'Child::session_sigh' for these sessions.
@@ -698,6 +721,27 @@ void Child::_try_construct_env_dependent_members()
 
 	_policy.init(_cpu.session(), _cpu.cap());
 
+	if (_policy.defer_process_construction()) {
+		_process_pending = true;
+		return;
+	}
+
+	_construct_process();
+}
+
+
+void Child::construct_process()
+{
+	if (!_process_pending)
+		return;
+
+	_process_pending = false;
+	_construct_process();
+}
+
+
+void Child::_construct_process()
+{
 	try {
 		_initial_thread.construct(_cpu.session(), _pd.cap(), _policy.name());
 		_process.construct(_binary.session().dataspace(), _linker_dataspace(),
@@ -48,11 +48,9 @@ static char const *initial_ep_name() { return "ep"; }
 
 void Entrypoint::Signal_proxy_component::signal()
 {
-	/* XXX introduce while-pending loop */
-	try {
-		Signal sig = ep._sig_rec->pending_signal();
-		ep._dispatch_signal(sig);
-	} catch (Signal_receiver::Signal_not_pending) { }
+	/* dispatch all signals pending at this point with one proxy call */
+	ep._sig_rec->for_each_pending_signal([&] (Signal &sig) {
+		ep._dispatch_signal(sig); }, MAX_SIGNAL_BATCH);
 
 	ep._execute_post_signal_hook();
 	ep._process_deferred_signals();
@@ -107,6 +105,14 @@ void Entrypoint::_process_incoming_signals()
 		do {
 			_sig_rec->block_for_signal();
 
+			/*
+			 * Signals may have been picked up already as part of a batch
+			 * dispatched on behalf of an earlier wakeup. Don't bother the
+			 * entrypoint in this case.
+			 */
+			if (!_sig_rec->pending())
+				continue;
+
 			int success;
 			{
 				Lock::Guard guard(_signal_pending_lock);
@@ -144,6 +150,8 @@ void Entrypoint::_process_incoming_signals()
 
 		_deferred_signal_handler.destruct();
 		_suspend_dispatcher.destruct();
+		bool const heartbeat = _heartbeat_handler.constructed();
+		_heartbeat_handler.destruct();
 		_sig_rec.destruct();
 		dissolve(_signal_proxy);
 		_signal_proxy_cap = Capability<Signal_proxy>();
@@ -159,6 +167,9 @@ void Entrypoint::_process_incoming_signals()
 		_signal_proxy_cap = manage(_signal_proxy);
 		_sig_rec.construct();
 
+		if (heartbeat)
+			_init_heartbeat();
+
 		/*
 		 * Before calling the resumed callback, we reset the callback pointer
 		 * as these may be set again in the resumed code to initiate the next
@@ -174,6 +185,36 @@ void Entrypoint::_process_incoming_signals()
 }
 
 
+void Entrypoint::_dispatch_pending_io_signals()
+{
+	for (unsigned i = 0; i < MAX_SIGNAL_BATCH; i++) {
+
+		_signal_pending_lock.lock();
+		cmpxchg(&_signal_recipient, NONE, ENTRYPOINT);
+
+		try {
+			Signal sig = _sig_rec->pending_signal();
+			cmpxchg(&_signal_recipient, ENTRYPOINT, NONE);
+
+			_signal_pending_lock.unlock();
+
+			_signal_pending_ack_lock.unlock();
+
+			/* defer application-level signals */
+			if (sig.context()->level() == Signal_context::Level::App)
+				_defer_signal(sig);
+			else
+				_dispatch_signal(sig);
+
+		} catch (Signal_receiver::Signal_not_pending) {
+			cmpxchg(&_signal_recipient, ENTRYPOINT, NONE);
+			_signal_pending_lock.unlock();
+			return;
+		}
+	}
+}
+
+
 bool Entrypoint::_wait_and_dispatch_one_io_signal(bool const dont_block)
 {
 	for (;;) {
@@ -209,6 +250,9 @@ bool Entrypoint::_wait_and_dispatch_one_io_signal(bool const dont_block)
 		}
 	}
 
+	/* handle signals that are pending already as one batch */
+	_dispatch_pending_io_signals();
+
 	_execute_post_signal_hook();
 
 	/* initiate potential deferred-signal handling in entrypoint */
@@ -240,6 +284,16 @@ void Entrypoint::schedule_suspend(void (*suspended)(), void (*resumed)())
 }
 
 
+void Entrypoint::_handle_heartbeat() { _env.parent().heartbeat_response(); }
+
+
+void Entrypoint::_init_heartbeat()
+{
+	_heartbeat_handler.construct(*this, *this, &Entrypoint::_handle_heartbeat);
+	_env.parent().heartbeat_sigh(*_heartbeat_handler);
+}
+
+
 Signal_context_capability Entrypoint::manage(Signal_dispatcher_base &dispatcher)
 {
 	/* _sig_rec is invalid for a small window in _process_incoming_signals */
@@ -295,6 +349,16 @@ namespace {
 }
 
 
+Entrypoint::Signal_proxy_thread::Signal_proxy_thread(Env &env, Entrypoint &ep,
+                                                     Affinity::Location location)
+:
+	Thread(env, "signal_proxy", STACK_SIZE, location, Weight(), env.cpu()),
+	ep(ep)
+{
+	start();
+}
+
+
 Entrypoint::Entrypoint(Env &env)
 :
 	_env(env),
@@ -306,6 +370,9 @@ Entrypoint::Entrypoint(Env &env)
 	/* initialize emulation of the original synchronous root interface */
 	init_root_proxy(_env);
 
+	/* respond to heartbeat signals of the parent */
+	_init_heartbeat();
+
 	/*
 	 * Invoke Component::construct function in the context of the entrypoint.
 	 */
@@ -335,6 +402,17 @@ Entrypoint::Entrypoint(Env &env, size_t stack_size, char const *name)
 	_env(env),
 	_rpc_ep(&env.pd(), stack_size, name), _signalling_initialized(true)
 {
-	_signal_proxy_thread.construct(env, *this);
+	_signal_proxy_thread.construct(env, *this, Affinity::Location());
+}
+
+
+Entrypoint::Entrypoint(Env &env, size_t stack_size, char const *name,
+                       Affinity::Location location)
+:
+	_env(env),
+	_rpc_ep(&env.pd(), stack_size, name, true, location),
+	_signalling_initialized(true)
+{
+	_signal_proxy_thread.construct(env, *this, location);
 }
 
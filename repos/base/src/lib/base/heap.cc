@@ -31,11 +31,103 @@ namespace {
 		 * to smaller allocations, this memory is released to
 		 * the RAM session when 'free()' is called.
 		 */
-		BIG_ALLOCATION_THRESHOLD = 64*1024 /* in bytes */
+		BIG_ALLOCATION_THRESHOLD = 64*1024, /* in bytes */
+
+		SUPERBLOCK_SIZE_LOG2 = 12,
+		SUPERBLOCK_SIZE      = 1 << SUPERBLOCK_SIZE_LOG2,
+		SUPERBLOCK_MAGIC     = 0x68656170
 	};
+
+	/* element sizes of the size classes in bytes */
+	constexpr size_t size_class_elem_size[] = { 16, 32, 48, 64, 96, 128, 192, 256 };
+
+	/**
+	 * Return value that marks a superblock of 'heap' located at 'sb'
+	 */
+	addr_t superblock_tag(void const *heap, void const *sb)
+	{
+		return (addr_t)heap ^ (addr_t)sb ^ SUPERBLOCK_MAGIC;
+	}
 }
 
 
+/**
+ * Page-sized block holding the elements of one size class
+ *
+ * The header is located at the start of the page and the elements follow
+ * it. Because no element starts at a page boundary, any address passed to
+ * 'free' can be checked for being an element by looking at the header of
+ * its page.
+ */
+struct Genode::Heap::Superblock
+{
+	addr_t      tag;
+	Size_class &size_class;
+	Superblock *prev = nullptr;
+	Superblock *next = nullptr;
+
+	void   *free_list = nullptr;  /* elements released via 'free' */
+	addr_t  unused;               /* start of the never-used elements */
+	size_t  num_used  = 0;
+
+	static constexpr size_t header_size() {
+		return align_addr(sizeof(Superblock), 4); }
+
+	Superblock(addr_t tag, Size_class &size_class)
+	:
+		tag(tag), size_class(size_class),
+		unused((addr_t)this + header_size())
+	{ }
+
+	bool full() const
+	{
+		return !free_list
+		    && unused + size_class.elem_size > (addr_t)this + SUPERBLOCK_SIZE;
+	}
+
+	void *alloc()
+	{
+		void *elem = free_list;
+		if (elem) {
+			free_list = *(void **)elem;
+		} else {
+			elem    = (void *)unused;
+			unused += size_class.elem_size;
+		}
+		num_used++;
+		return elem;
+	}
+
+	void free(void *elem)
+	{
+		*(void **)elem = free_list;
+		free_list = elem;
+		num_used--;
+	}
+
+	void unlink()
+	{
+		(prev ? prev->next : size_class.first) = next;
+		(next ? next->prev : size_class.last)  = prev;
+		prev = next = nullptr;
+	}
+
+	void link_first()
+	{
+		next = size_class.first;
+		(next ? next->prev : size_class.last) = this;
+		size_class.first = this;
+	}
+
+	void link_last()
+	{
+		prev = size_class.last;
+		(prev ? prev->next : size_class.first) = this;
+		size_class.last = this;
+	}
+};
+
+
 void Heap::Dataspace_pool::remove_and_free(Dataspace &ds)
 {
 	/*
@@ -133,9 +225,9 @@ Heap::Dataspace *Heap::_allocate_dataspace(size_t size, bool enforce_separate_me
 }
 
 
-bool Heap::_try_local_alloc(size_t size, void **out_addr)
+bool Heap::_try_local_alloc(size_t size, void **out_addr, int align)
 {
-	if (_alloc->alloc_aligned(size, out_addr, log2(16)).error())
+	if (_alloc->alloc_aligned(size, out_addr, align).error())
 		return false;
 
 	_quota_used += size;
@@ -143,7 +235,7 @@ bool Heap::_try_local_alloc(size_t size, void **out_addr)
 }
 
 
-bool Heap::_unsynchronized_alloc(size_t size, void **out_addr)
+bool Heap::_unsynchronized_alloc(size_t size, void **out_addr, int align)
 {
 	size_t dataspace_size;
 
@@ -174,7 +266,7 @@ bool Heap::_unsynchronized_alloc(size_t size, void **out_addr)
 	}
 
 	/* try allocation at our local allocator */
-	if (_try_local_alloc(size, out_addr))
+	if (_try_local_alloc(size, out_addr, align))
 		return true;
 
 	/*
@@ -185,6 +277,10 @@ bool Heap::_unsynchronized_alloc(size_t size, void **out_addr)
 	 */
 	dataspace_size = size + Allocator_avl::slab_block_size() + sizeof(Heap::Dataspace);
 
+	/* leave room for aligning the block beyond the default alignment */
+	if (align > log2(16))
+		dataspace_size += 1UL << align;
+
 	/*
 	 * '_chunk_size' is a multiple of 4K, so 'dataspace_size' becomes
 	 * 4K-aligned, too.
@@ -209,12 +305,113 @@ bool Heap::_unsynchronized_alloc(size_t size, void **out_addr)
 	}
 
 	/* allocate originally requested block */
-	return _try_local_alloc(size, out_addr);
+	return _try_local_alloc(size, out_addr, align);
+}
+
+
+Heap::Size_class &Heap::_size_class(size_t size)
+{
+	unsigned i = 0;
+	while (_size_classes[i].elem_size < size)
+		i++;
+
+	return _size_classes[i];
+}
+
+
+Heap::Superblock *Heap::_superblock(void *addr) const
+{
+	addr_t const sb_addr = (addr_t)addr & ~((addr_t)SUPERBLOCK_SIZE - 1);
+
+	if (sb_addr == (addr_t)addr)
+		return nullptr;
+
+	/*
+	 * The page containing 'addr' is mapped, so reading the potential
+	 * header at its start is safe.
+	 */
+	Superblock *sb = (Superblock *)sb_addr;
+	return sb->tag == superblock_tag(this, sb) ? sb : nullptr;
+}
+
+
+bool Heap::_small_alloc(Size_class &size_class, void **out_addr)
+{
+	Lock::Guard size_class_guard(size_class.lock);
+
+	Superblock *sb = size_class.first;
+
+	if (!sb || sb->full()) {
+
+		void *sb_addr = nullptr;
+		{
+			Lock::Guard lock_guard(_lock);
+
+			if (SUPERBLOCK_SIZE + _quota_used > _quota_limit)
+				return false;
+
+			if (!_unsynchronized_alloc(SUPERBLOCK_SIZE, &sb_addr,
+			                           SUPERBLOCK_SIZE_LOG2))
+				return false;
+		}
+
+		sb = construct_at<Superblock>(sb_addr, superblock_tag(this, sb_addr),
+		                              size_class);
+		sb->link_first();
+	}
+
+	*out_addr = sb->alloc();
+
+	/* keep superblocks with free elements in front */
+	if (sb->full()) {
+		sb->unlink();
+		sb->link_last();
+	}
+	return true;
+}
+
+
+void Heap::_release(Superblock &sb)
+{
+	sb.unlink();
+	sb.tag = 0;
+	sb.~Superblock();
+
+	Lock::Guard lock_guard(_lock);
+
+	_alloc->free(&sb, SUPERBLOCK_SIZE);
+	_quota_used -= SUPERBLOCK_SIZE;
+}
+
+
+void Heap::_small_free(Superblock &sb, void *addr)
+{
+	Size_class &size_class = sb.size_class;
+
+	Lock::Guard size_class_guard(size_class.lock);
+
+	bool const was_full = sb.full();
+
+	sb.free(addr);
+
+	/* release empty superblock unless it is the only one of its class */
+	if (sb.num_used == 0 && (size_class.first != &sb || sb.next)) {
+		_release(sb);
+		return;
+	}
+
+	if (was_full) {
+		sb.unlink();
+		sb.link_first();
+	}
 }
 
 
 bool Heap::alloc(size_t size, void **out_addr)
 {
+	if (size <= MAX_SMALL_SIZE)
+		return _small_alloc(_size_class(size), out_addr);
+
 	/* serialize access of heap functions */
 	Lock::Guard lock_guard(_lock);
 
@@ -228,6 +425,11 @@ bool Heap::alloc(size_t size, void **out_addr)
 
 void Heap::free(void *addr, size_t)
 {
+	if (Superblock *sb = _superblock(addr)) {
+		_small_free(*sb, addr);
+		return;
+	}
+
 	/* serialize access of heap functions */
 	Lock::Guard lock_guard(_lock);
 
@@ -276,6 +478,13 @@ Heap::Heap(Ram_allocator *ram_alloc,
 	_quota_limit(quota_limit), _quota_used(0),
 	_chunk_size(MIN_CHUNK_SIZE)
 {
+	static_assert(sizeof(size_class_elem_size)/sizeof(size_t) == NUM_SIZE_CLASSES
+	           && size_class_elem_size[NUM_SIZE_CLASSES - 1] == MAX_SMALL_SIZE,
+	              "inconsistent size classes");
+
+	for (unsigned i = 0; i < NUM_SIZE_CLASSES; i++)
+		_size_classes[i].elem_size = size_class_elem_size[i];
+
 	if (static_addr)
 		_alloc->add_range((addr_t)static_addr, static_size);
 }
@@ -283,6 +492,10 @@ Heap::Heap(Ram_allocator *ram_alloc,
 
 Heap::~Heap()
 {
+	for (unsigned i = 0; i < NUM_SIZE_CLASSES; i++)
+		while (Superblock *sb = _size_classes[i].first)
+			_release(*sb);
+
 	/*
 	 * Revert allocations of heap-internal 'Dataspace' objects. Otherwise, the
 	 * subsequent destruction of the 'Allocator_avl' would detect those blocks
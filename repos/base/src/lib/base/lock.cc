@@ -60,10 +60,29 @@ void Cancelable_lock::Applicant::wake_up()
  ** Cancelable lock **
  *********************/
 
+/*
+ * Most critical sections protected by locks are short, e.g., within the
+ * heap or the signal bookkeeping. On SMP, the lock holder is thereby likely
+ * to leave the critical section before a block/wake-up pair could be
+ * completed. Hence, an applicant polls the lock for a bounded number of
+ * iterations before enqueuing itself. Polling stops as soon as other
+ * applicants are queued because the lock is handed over to those in order.
+ */
+enum { LOCK_SPIN_ITERATIONS = 256 };
+
+
 void Cancelable_lock::lock()
 {
 	Applicant myself(Thread::myself());
 
+	for (unsigned i = 0; i < LOCK_SPIN_ITERATIONS; i++) {
+
+		if (_state == UNLOCKED || _last_applicant != &_owner)
+			break;
+
+		memory_barrier();
+	}
+
 	spinlock_lock(&_spinlock_state);
 
 	if (cmpxchg(&_state, UNLOCKED, LOCKED)) {
@@ -72,7 +72,7 @@ void Registry_base::_remove(Element &element)
 
 
 Registry_base::Element *Registry_base::_processed(Notify &notify,
-                                                  List<Element> &processed,
+                                                  Double_list<Element> &processed,
                                                   Element &e, Element *at)
 {
 	_curr = nullptr;
@@ -111,7 +111,7 @@ void Registry_base::_for_each(Untyped_functor &functor)
 	/* insert position in list of processed elements */
 	Element *at = nullptr;
 
-	List<Element> processed;
+	Double_list<Element> processed;
 
 	while (Element *e = _elements.first()) {
 
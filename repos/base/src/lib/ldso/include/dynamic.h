@@ -20,6 +20,8 @@
 
 namespace Linker {
 	struct Hash_table;
+	struct Gnu_hash_table;
+	struct Symbol_hash;
 	struct Dynamic;
 }
 
@@ -53,6 +55,99 @@ struct Linker::Hash_table
 };
 
 
+/**
+ * GNU hash table and hash function
+ *
+ * In contrast to the SysV hash table, the table features a bloom filter
+ * that rejects most lookups of symbols not defined by the object without
+ * touching the hash chains. The chains are sorted by bucket and store the
+ * hash values of the symbols, so that string comparisons are performed
+ * only for matching hash values.
+ */
+struct Linker::Gnu_hash_table
+{
+	uint32_t nbuckets;
+	uint32_t symoffset;
+	uint32_t bloom_size;
+	uint32_t bloom_shift;
+
+	Elf::Addr const *bloom() const SELF_RELOC {
+		return (Elf::Addr const *)(this + 1); }
+
+	uint32_t const *buckets() const SELF_RELOC {
+		return (uint32_t const *)(bloom() + bloom_size); }
+
+	/**
+	 * Return chain of hash values, starting at symbol index 'symoffset'
+	 */
+	uint32_t const *chains() const SELF_RELOC { return buckets() + nbuckets; }
+
+	/**
+	 * Return false if the bloom filter rules out a symbol with the hash
+	 */
+	bool may_contain(uint32_t hash) const
+	{
+		enum { BITS = 8*sizeof(Elf::Addr) };
+
+		Elf::Addr const word = bloom()[(hash / BITS) % bloom_size];
+		Elf::Addr const mask = ((Elf::Addr)1 << (hash % BITS))
+		                     | ((Elf::Addr)1 << ((hash >> bloom_shift) % BITS));
+
+		return (word & mask) == mask;
+	}
+
+	/**
+	 * Return number of symbols covered by the table
+	 *
+	 * The table does not store the number of symbols. It is determined by
+	 * the end of the chain that starts at the highest bucket. The function
+	 * is called during the linker's self relocation.
+	 */
+	unsigned long num_symbols() const SELF_RELOC
+	{
+		uint32_t max_index = 0;
+		for (uint32_t i = 0; i < nbuckets; i++)
+			if (buckets()[i] > max_index)
+				max_index = buckets()[i];
+
+		if (max_index < symoffset)
+			return symoffset;
+
+		while ((chains()[max_index - symoffset] & 1) == 0)
+			max_index++;
+
+		return max_index + 1;
+	}
+
+	/**
+	 * Hash function of the GNU toolchain (DJB hash)
+	 */
+	static uint32_t hash(char const *name)
+	{
+		uint32_t h = 5381;
+		for (unsigned char const *p = (unsigned char const *)name; *p; p++)
+			h = h*33 + *p;
+
+		return h;
+	}
+};
+
+
+/**
+ * Hash values of a symbol name for both kinds of hash tables
+ *
+ * The values are computed once per lookup and used for all objects.
+ */
+struct Linker::Symbol_hash
+{
+	unsigned long const sysv;
+	uint32_t      const gnu;
+
+	Symbol_hash(char const *name)
+	: sysv(Hash_table::hash(name)), gnu(Gnu_hash_table::hash(name)) { }
+};
+
+
 /**
  * .dynamic section entries
  */
@@ -88,6 +183,10 @@ class Linker::Dynamic
 		Allocator           *_md_alloc      = nullptr;
 
 		Hash_table          *_hash_table    = nullptr;
+		Gnu_hash_table      *_gnu_hash      = nullptr;
+
+		/* number of entries of the symbol table */
+		unsigned long        _num_symbols   = 0;
 
 		Elf::Rela           *_reloca        = nullptr;
 		unsigned long        _reloca_size   = 0;
@@ -152,6 +251,7 @@ class Linker::Dynamic
 				case DT_PLTRELSZ: _pltrel_size = d->un.val;                             break;
 				case DT_PLTGOT  : _section<typeof(_pltgot)>(&_pltgot, d);               break;
 				case DT_HASH    : _section<typeof(_hash_table)>(&_hash_table, d);       break;
+				case DT_GNU_HASH: _section<typeof(_gnu_hash)>(&_gnu_hash, d);           break;
 				case DT_RELA    : _section<typeof(_reloca)>(&_reloca, d);               break;
 				case DT_RELASZ  : _reloca_size = d->un.val;                             break;
 				case DT_SYMTAB  : _section<typeof(_symtab)>(&_symtab, d);               break;
@@ -167,6 +267,80 @@ class Linker::Dynamic
 					break;
 				}
 			}
+
+			if (_hash_table)
+				_num_symbols = _hash_table->nchains();
+			else if (_gnu_hash)
+				_num_symbols = _gnu_hash->num_symbols();
+		}
+
+		Elf::Sym const *_lookup_symbol_sysv(char const *name, unsigned long hash) const
+		{
+			Hash_table *h = _hash_table;
+
+			if (!h->buckets())
+				return nullptr;
+
+			unsigned long sym_index = h->buckets()[hash % h->nbuckets()];
+
+			/* traverse hash chain */
+			for (; sym_index != STN_UNDEF; sym_index = h->chains()[sym_index])
+			{
+				/* bad object */
+				if (sym_index > h->nchains())
+					return nullptr;
+
+				Elf::Sym const *sym = symbol(sym_index);
+
+				if (_symbol_matches(*sym, name))
+					return sym;
+			}
+
+			return nullptr;
+		}
+
+		Elf::Sym const *_lookup_symbol_gnu(char const *name, uint32_t hash) const
+		{
+			Gnu_hash_table const &h = *_gnu_hash;
+
+			if (!h.nbuckets || !h.bloom_size || !h.may_contain(hash))
+				return nullptr;
+
+			unsigned long sym_index = h.buckets()[hash % h.nbuckets];
+			if (sym_index < h.symoffset)
+				return nullptr;
+
+			/* traverse chain of the bucket, the lowest bit marks its end */
+			for (; sym_index < _num_symbols; sym_index++) {
+
+				uint32_t const chain_hash = h.chains()[sym_index - h.symoffset];
+
+				if ((chain_hash | 1) == (hash | 1)) {
+					Elf::Sym const *sym = symbol(sym_index);
+					if (_symbol_matches(*sym, name))
+						return sym;
+				}
+
+				if (chain_hash & 1)
+					break;
+			}
+
+			return nullptr;
+		}
+
+		bool _symbol_matches(Elf::Sym const &sym, char const *name) const
+		{
+			/* this omitts everything but 'NOTYPE', 'OBJECT', and 'FUNC' */
+			if (sym.type() > STT_FUNC)
+				return false;
+
+			if (sym.st_value == 0)
+				return false;
+
+			char const *sym_name = symbol_name(sym);
+
+			/* check for symbol name */
+			return name[0] == sym_name[0] && !strcmp(name, sym_name);
 		}
 
 	public:
@@ -210,7 +384,7 @@ class Linker::Dynamic
 
 		Elf::Sym const *symbol(unsigned sym_index) const
 		{
-			if (sym_index > _hash_table->nchains())
+			if (sym_index > _num_symbols)
 				return nullptr;
 
 			return _symtab + sym_index;
@@ -231,43 +405,24 @@ class Linker::Dynamic
 		 * Use DT_HASH table address for linker, assuming that it will always be at
 		 * the beginning of the file
 		 */
-		Elf::Addr link_map_addr() const { return trunc_page((Elf::Addr)_hash_table); }
+		Elf::Addr link_map_addr() const
+		{
+			return trunc_page(_hash_table ? (Elf::Addr)_hash_table
+			                              : (Elf::Addr)_gnu_hash);
+		}
 
 		/**
 		 * Lookup symbol name in this ELF
+		 *
+		 * The GNU hash table is used if present, the SysV hash table otherwise.
 		 */
-		Elf::Sym const *lookup_symbol(char const *name, unsigned long hash) const
+		Elf::Sym const *lookup_symbol(char const *name, Symbol_hash const &hash) const
 		{
-			Hash_table *h = _hash_table;
+			if (_gnu_hash)
+				return _lookup_symbol_gnu(name, hash.gnu);
 
-			if (!h->buckets())
-				return nullptr;
-
-			unsigned long sym_index = h->buckets()[hash % h->nbuckets()];
-
-			/* traverse hash chain */
-			for (; sym_index != STN_UNDEF; sym_index = h->chains()[sym_index])
-			{
-				/* bad object */
-				if (sym_index > h->nchains())
-					return nullptr;
-
-				Elf::Sym const *sym      = symbol(sym_index);
-				char const     *sym_name = symbol_name(*sym);
-
-				/* this omitts everything but 'NOTYPE', 'OBJECT', and 'FUNC' */
-				if (sym->type() > STT_FUNC)
-					continue;
-
-				if (sym->st_value == 0)
-					continue;
-
-				/* check for symbol name */
-				if (name[0] != sym_name[0] || strcmp(name, sym_name))
-					continue;
-
-				return sym;
-			}
+			if (_hash_table)
+				return _lookup_symbol_sysv(name, hash.sysv);
 
 			return nullptr;
 		}
@@ -279,7 +434,7 @@ class Linker::Dynamic
 		{
 			addr_t const reloc_base = _obj.reloc_base();
 
-			for (unsigned long i = 0; i < _hash_table->nchains(); i++)
+			for (unsigned long i = 0; i < _num_symbols; i++)
 			{
 				Elf::Sym const *sym = symbol(i);
 				if (!sym)
@@ -28,6 +28,19 @@ namespace Linker {
 	struct Phdr;
 	struct File;
 	struct Elf_file;
+
+	/**
+	 * Return true if the relocation type merely adds the load address
+	 *
+	 * Defined by the architecture-specific relocation code.
+	 */
+	bool relative_relocation(unsigned type);
+
+	/*
+	 * Dynamic tag of objects whose relocations were applied at build time
+	 * for their link address, e.g., by the 'prelink' tool
+	 */
+	enum { DT_GNU_PRELINKED = 0x6ffffdf5 };
 }
 
 
@@ -56,6 +69,13 @@ struct Linker::File
 	Elf::Addr  start      = 0;
 	Elf::Size  size       = 0;
 
+	/*
+	 * Set if the object is prelinked and loaded at its link address. In
+	 * this case, the file content already reflects all relative
+	 * relocations.
+	 */
+	bool       prelinked  = false;
+
 	virtual ~File() { }
 
 	Elf::Phdr const *elf_phdr(unsigned index) const
@@ -81,6 +101,28 @@ struct Linker::Elf_file : File
 	Ram_dataspace_capability      ram_cap[Phdr::MAX_PHDR];
 	bool                    const loaded;
 
+	/**
+	 * Part of the read-write segment attached read-only from the ROM
+	 *
+	 * For a prelinked object loaded at its link address, the pages of the
+	 * RELRO region that are not written by any relocation are identical
+	 * for all processes. Instead of copying them, they are attached from
+	 * the ROM dataspace, which is shared by all processes.
+	 */
+	struct Shared_relro
+	{
+		addr_t start = 0, end = 0;   /* page-aligned link addresses */
+
+		bool                     head = false; /* private pages below 'start' */
+		Ram_dataspace_capability tail_cap;     /* private pages above 'end'   */
+
+		bool valid() const { return end > start; }
+
+	} shared_relro;
+
+	/* set if the dynamic section contains the 'DT_GNU_PRELINKED' tag */
+	bool gnu_prelinked = false;
+
 	typedef String<64> Name;
 
 	Rom_dataspace_capability _rom_dataspace(Name const &name)
@@ -167,6 +209,8 @@ struct Linker::Elf_file : File
 			addr_t header = (addr_t)&ehdr + ehdr.e_phoff;
 			for (unsigned i = 0; i < phdr.count; i++, header += ehdr.e_phentsize)
 				memcpy(&phdr.phdr[i], (void *)header, ehdr.e_phentsize);
+
+			inspect_prelink((addr_t)&ehdr);
 		}
 
 		Phdr p;
@@ -198,6 +242,120 @@ struct Linker::Elf_file : File
 		}
 	}
 
+	/**
+	 * Return pointer to the file content at link address 'vaddr'
+	 *
+	 * \param elf_addr  local address of the attached ROM
+	 */
+	void const *file_content(addr_t elf_addr, Elf::Addr vaddr) const
+	{
+		for (unsigned i = 0; i < phdr.count; i++) {
+			Elf::Phdr const &ph = phdr.phdr[i];
+
+			if (ph.p_type == PT_LOAD && vaddr >= ph.p_vaddr
+			 && vaddr <  ph.p_vaddr + ph.p_filesz)
+				return (void const *)(elf_addr + ph.p_offset + (vaddr - ph.p_vaddr));
+		}
+		return nullptr;
+	}
+
+	/**
+	 * Determine whether the object is prelinked and which RELRO pages
+	 * remain untouched by the relocations
+	 *
+	 * Only the link-time information of the ROM is evaluated. Whether the
+	 * object can be loaded at its link address is decided later by
+	 * 'load_segments'.
+	 */
+	void inspect_prelink(addr_t elf_addr)
+	{
+		Elf::Phdr const *relro = nullptr, *dynamic = nullptr;
+
+		for (unsigned i = 0; i < phdr.count; i++) {
+			if (phdr.phdr[i].p_type == PT_GNU_RELRO) relro   = &phdr.phdr[i];
+			if (phdr.phdr[i].p_type == PT_DYNAMIC)   dynamic = &phdr.phdr[i];
+		}
+
+		if (!dynamic)
+			return;
+
+		Elf::Dyn const *dyn = (Elf::Dyn const *)file_content(elf_addr, dynamic->p_vaddr);
+		if (!dyn)
+			return;
+
+		Elf::Addr rel    = 0, rel_size    = 0;
+		Elf::Addr rela   = 0, rela_size   = 0;
+		Elf::Addr jmprel = 0, jmprel_size = 0, pltrel_type = DT_NULL;
+		Elf::Addr pltgot = 0;
+
+		for (; dyn->tag != DT_NULL; dyn++) {
+			switch (dyn->tag) {
+			case DT_REL:           rel         = dyn->un.ptr; break;
+			case DT_RELSZ:         rel_size    = dyn->un.val; break;
+			case DT_RELA:          rela        = dyn->un.ptr; break;
+			case DT_RELASZ:        rela_size   = dyn->un.val; break;
+			case DT_JMPREL:        jmprel      = dyn->un.ptr; break;
+			case DT_PLTRELSZ:      jmprel_size = dyn->un.val; break;
+			case DT_PLTREL:        pltrel_type = dyn->un.val; break;
+			case DT_PLTGOT:        pltgot      = dyn->un.ptr; break;
+			case DT_GNU_PRELINKED: gnu_prelinked = true;      break;
+			default: break;
+			}
+		}
+
+		if (!gnu_prelinked || !relro)
+			return;
+
+		addr_t const start = round_page((addr_t)relro->p_vaddr);
+		addr_t       end   = trunc_page((addr_t)(relro->p_vaddr + relro->p_memsz));
+
+		/* limit the shared range to the pages below the given address */
+		auto exclude = [&] (Elf::Addr vaddr) {
+			if (vaddr >= start && vaddr < end)
+				end = trunc_page((addr_t)vaddr); };
+
+		/* the linker writes to the GOT and the '.dynamic' section */
+		if (pltgot) exclude(pltgot);
+		exclude(dynamic->p_vaddr);
+
+		/*
+		 * Both 'Elf::Rel' and 'Elf::Rela' start with the relocated address
+		 * followed by the info word, which holds the type in its low bits.
+		 */
+		auto exclude_targets = [&] (Elf::Addr table, Elf::Addr size,
+		                            size_t entry_size, bool skip_relative) {
+
+			Elf::Addr const *entry = (Elf::Addr const *)file_content(elf_addr, table);
+			if (!entry)
+				return;
+
+			for (Elf::Addr i = 0; i < size/entry_size; i++) {
+
+				Elf::Addr const *e = (Elf::Addr const *)((addr_t)entry + i*entry_size);
+
+				unsigned const type = (sizeof(Elf::Addr) == 8)
+				                    ? (unsigned)(e[1] & 0xffffffff)
+				                    : (unsigned)(e[1] & 0xff);
+
+				if (skip_relative && relative_relocation(type))
+					continue;
+
+				exclude(e[0]);
+			}
+		};
+
+		exclude_targets(rel,  rel_size,  sizeof(Elf::Rel),  true);
+		exclude_targets(rela, rela_size, sizeof(Elf::Rela), true);
+		exclude_targets(jmprel, jmprel_size,
+		                pltrel_type == DT_RELA ? sizeof(Elf::Rela) : sizeof(Elf::Rel),
+		                false);
+
+		if (end > start) {
+			shared_relro.start = start;
+			shared_relro.end   = end;
+		}
+	}
+
 	bool is_rx(Elf::Phdr const &ph) {
 		return ((ph.p_flags & PF_MASK) == (PF_R | PF_X)); }
 
@@ -218,6 +376,11 @@ struct Linker::Elf_file : File
 		reloc_base = Region_map::r()->alloc_region(size, start);
 		reloc_base = (start == reloc_base) ?  0 : reloc_base;
 
+		/* prelinked content is valid only at the link address */
+		prelinked = gnu_prelinked && reloc_base == 0;
+		if (!prelinked)
+			shared_relro = Shared_relro();
+
 		if (verbose_loading)
 			log("LD: reloc_base: ", Hex(reloc_base),
 			    " start: ",         Hex(start),
@@ -258,6 +421,12 @@ struct Linker::Elf_file : File
 		void  *src = env.rm().attach(rom_cap, 0, p.p_offset);
 		addr_t dst = p.p_vaddr + reloc_base;
 
+		if (shares_relro(p)) {
+			load_segment_rw_shared(p, nr, (addr_t)src);
+			env.rm().detach(src);
+			return;
+		}
+
 		ram_cap[nr] = env.ram().alloc(p.p_memsz);
 		Region_map::r()->attach_at(ram_cap[nr], dst);
 
@@ -270,6 +439,59 @@ struct Linker::Elf_file : File
 		env.rm().detach(src);
 	}
 
+	/**
+	 * Return true if the shared RELRO pages lie within the segment's file content
+	 */
+	bool shares_relro(Elf::Phdr const &p) const
+	{
+		return shared_relro.valid()
+		    && shared_relro.start >= p.p_vaddr
+		    && shared_relro.end   <= trunc_page((addr_t)(p.p_vaddr + p.p_filesz));
+	}
+
+	/**
+	 * Set up read-write segment with shared RELRO pages
+	 *
+	 * The segment is composed of up to three parts: the private pages
+	 * below the shared range, the shared pages attached from the ROM, and
+	 * the private pages above the shared range. The object is loaded at its
+	 * link address.
+	 */
+	void load_segment_rw_shared(Elf::Phdr const &p, int nr, addr_t src)
+	{
+		addr_t const seg_start  = p.p_vaddr;
+		addr_t const file_end   = p.p_vaddr + p.p_filesz;
+		addr_t const seg_end    = p.p_vaddr + p.p_memsz;
+		addr_t const head_size  = shared_relro.start - seg_start;
+		addr_t const tail_start = shared_relro.end;
+
+		if (head_size) {
+			ram_cap[nr] = env.ram().alloc(head_size);
+			Region_map::r()->attach_at(ram_cap[nr], seg_start);
+			memcpy((void *)seg_start, (void *)src, head_size);
+			shared_relro.head = true;
+		}
+
+		Region_map::r()->attach_at(rom_cap, shared_relro.start,
+		                           shared_relro.end - shared_relro.start,
+		                           p.p_offset + head_size);
+
+		if (seg_end > tail_start) {
+			shared_relro.tail_cap = env.ram().alloc(seg_end - tail_start);
+			Region_map::r()->attach_at(shared_relro.tail_cap, tail_start);
+
+			memcpy((void *)tail_start, (void *)(src + (tail_start - seg_start)),
+			       file_end - tail_start);
+
+			if (seg_end > file_end)
+				memset((void *)file_end, 0, seg_end - file_end);
+		}
+
+		if (verbose_loading)
+			log("LD: shared RELRO ", Hex(shared_relro.start),
+			    "-", Hex(shared_relro.end));
+	}
+
 	/**
 	 * Unmap segements, RM regions, and free allocated dataspaces
 	 */
@@ -282,6 +504,17 @@ struct Linker::Elf_file : File
 		for (unsigned i = 0; i < p.count; i++)
 			Region_map::r()->detach(trunc_page(p.phdr[i].p_vaddr) + reloc_base);
 
+		/* detach the remaining parts of a segment with shared RELRO pages */
+		if (shared_relro.valid()) {
+			if (shared_relro.head)
+				Region_map::r()->detach(shared_relro.start);
+
+			if (shared_relro.tail_cap.valid()) {
+				Region_map::r()->detach(shared_relro.end);
+				env.ram().free(shared_relro.tail_cap);
+			}
+		}
+
 		/* free region from RM area */
 		Region_map::r()->free_region(trunc_page(p.phdr[0].p_vaddr) + reloc_base);
 
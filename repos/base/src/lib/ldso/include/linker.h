@@ -151,6 +151,11 @@ class Linker::Object : public Fifo<Object>::Element,
 		File      const *file()       const { return _file; }
 		Elf::Size const  size()       const { return _file ? _file->size : 0; }
 
+		/**
+		 * Return true if relative relocations are already applied
+		 */
+		bool prelinked() const { return _file && _file->prelinked; }
+
 		virtual bool is_linker() const = 0;
 		virtual bool is_binary() const = 0;
 
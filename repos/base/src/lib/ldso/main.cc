@@ -172,7 +172,7 @@ class Linker::Elf_object : public Object, public Fifo<Elf_object>::Element
 			return _dyn.symbol_name(sym);
 		}
 
-		Elf::Sym const *lookup_symbol(char const *name, unsigned long hash) const
+		Elf::Sym const *lookup_symbol(char const *name, Symbol_hash const &hash) const
 		{
 			return _dyn.lookup_symbol(name, hash);
 		}
@@ -503,6 +503,9 @@ Object *Linker::obj_list_head()
 }
 
 
+bool Linker::relative_relocation(unsigned type) { return type == R_RELATIVE; }
+
+
 Elf::Sym const *Linker::lookup_symbol(unsigned sym_index, Dependency const &dep,
                                       Elf::Addr *base, bool undef, bool other)
 {
@@ -527,7 +530,7 @@ Elf::Sym const *Linker::lookup_symbol(char const *name, Dependency const &dep,
                                       Elf::Addr *base, bool undef, bool other)
 {
 	Dependency const *curr        = &dep.first();
-	unsigned long     hash        = Hash_table::hash(name);
+	Symbol_hash const hash(name);
 	Elf::Sym   const *weak_symbol = 0;
 	Elf::Addr        weak_base    = 0;
 	Elf::Sym   const *symbol      = 0;
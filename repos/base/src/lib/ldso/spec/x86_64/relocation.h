@@ -45,6 +45,10 @@ class Linker::Reloc_non_plt : public Reloc_non_plt_generic
 		 */
 		void _relative(Elf::Rela const *rel, Elf::Addr *addr)
 		{
+			/* the file content of a prelinked object is already relocated */
+			if (_dep.obj().prelinked())
+				return;
+
 			*addr = _dep.obj().reloc_base() + rel->addend;
 		}
 
@@ -0,0 +1,134 @@
+/*
+ * \brief  Benchmark of the round-trip time of synchronous IPC
+ * \author Genode Labs
+ * \date   2026-10-14
+ *
+ * The client and the server run on the same CPU. Each RPC is measured with
+ * an empty message, with a payload of a few hundred words, and with a
+ * capability argument.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/component.h>
+#include <base/log.h>
+#include <base/rpc_server.h>
+#include <base/rpc_client.h>
+#include <base/rpc_args.h>
+#include <trace/timestamp.h>
+
+namespace Test {
+
+	using namespace Genode;
+
+	struct Session;
+	struct Client;
+	struct Component;
+	struct Main;
+
+	typedef Rpc_in_buffer<2048> Payload;
+}
+
+
+/**
+ * Test session interface definition
+ */
+struct Test::Session : Genode::Session
+{
+	static const char *service_name() { return "IPC_RTT_TEST"; }
+
+	enum { CAP_QUOTA = 2 };
+
+	GENODE_RPC(Rpc_null, void, null);
+	GENODE_RPC(Rpc_payload, void, payload, Payload const &);
+	GENODE_RPC(Rpc_cap, void, cap, Native_capability);
+	GENODE_RPC_INTERFACE(Rpc_null, Rpc_payload, Rpc_cap);
+};
+
+
+struct Test::Client : Rpc_client<Session>
+{
+	Client(Capability<Session> cap) : Rpc_client<Session>(cap) { }
+
+	void null() { call<Rpc_null>(); }
+
+	void payload(Payload const &payload) { call<Rpc_payload>(payload); }
+
+	void cap(Native_capability cap) { call<Rpc_cap>(cap); }
+};
+
+
+struct Test::Component : Rpc_object<Session, Component>
+{
+	void null() { }
+
+	void payload(Payload const &) { }
+
+	void cap(Native_capability) { }
+};
+
+
+struct Test::Main
+{
+	enum { STACK_SIZE = 2*1024*sizeof(long), ROUND_TRIPS = 100000 };
+
+	Env &_env;
+
+	Rpc_entrypoint _ep { &_env.pd(), STACK_SIZE, "ipc_rtt_ep" };
+
+	Component _component;
+	Component _cap_component;
+
+	Client _client { _ep.manage(&_component) };
+
+	template <typename FN>
+	void _measure(char const *name, FN const &fn)
+	{
+		/* warm up caches and TLBs */
+		for (unsigned i = 0; i < ROUND_TRIPS/10; i++)
+			fn();
+
+		Trace::Timestamp const start = Trace::timestamp();
+
+		for (unsigned i = 0; i < ROUND_TRIPS; i++)
+			fn();
+
+		Trace::Timestamp const duration = Trace::timestamp() - start;
+
+		log(name, ": ", (unsigned)ROUND_TRIPS, " round trips took ",
+		    duration / ROUND_TRIPS, " cycles each");
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		log("--- IPC round-trip benchmark ---");
+
+		_measure("empty message", [&] () { _client.null(); });
+
+		char buf[Payload::MAX_SIZE];
+		memset(buf, 'x', sizeof(buf));
+		Payload const payload(buf, sizeof(buf));
+
+		_measure("payload of 2 KiB", [&] () { _client.payload(payload); });
+
+		/* the transferred capability refers to another RPC object */
+		Native_capability const cap = _ep.manage(&_cap_component);
+
+		_measure("capability argument", [&] () { _client.cap(cap); });
+
+		log("--- IPC round-trip benchmark finished ---");
+
+		_ep.dissolve(&_cap_component);
+		_ep.dissolve(&_component);
+		_env.parent().exit(0);
+	}
+};
+
+
+void Component::construct(Genode::Env &env) { static Test::Main main(env); }
@@ -0,0 +1,3 @@
+TARGET = test-ipc_rtt
+SRC_CC = main.cc
+LIBS   = base
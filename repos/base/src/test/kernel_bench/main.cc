@@ -0,0 +1,324 @@
+/*
+ * \brief  Micro benchmarks of kernel primitives
+ * \author Genode Labs
+ * \date   2026-10-14
+ *
+ * Each benchmark records the duration of individual operations in cycles.
+ * The result of each benchmark is printed as a single '<result>' node that
+ * states the percentiles of the samples, e.g.,
+ *
+ * ! <result kernel="nova" name="rpc_same_cpu" unit="cycles" samples="10000"
+ * !         min="812" p50="840" p90="868" p99="1204" max="9120"/>
+ *
+ * The kernel name is taken from the config and merely passed through to
+ * ease the comparison of the results of different kernels.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/component.h>
+#include <base/attached_ram_dataspace.h>
+#include <base/attached_rom_dataspace.h>
+#include <base/heap.h>
+#include <base/log.h>
+#include <base/rpc_server.h>
+#include <base/rpc_client.h>
+#include <base/signal.h>
+#include <base/thread.h>
+#include <trace/timestamp.h>
+
+namespace Test {
+
+	using namespace Genode;
+	using Trace::Timestamp;
+
+	struct Session;
+	struct Client;
+	struct Component;
+	class  Samples;
+	struct Signal_echo;
+	struct Empty_thread;
+	struct Main;
+
+	typedef String<32> Kernel_name;
+}
+
+
+struct Test::Session : Genode::Session
+{
+	static const char *service_name() { return "KERNEL_BENCH"; }
+
+	enum { CAP_QUOTA = 2 };
+
+	GENODE_RPC(Rpc_null, void, null);
+	GENODE_RPC(Rpc_cap, void, cap, Native_capability);
+	GENODE_RPC_INTERFACE(Rpc_null, Rpc_cap);
+};
+
+
+struct Test::Client : Rpc_client<Session>
+{
+	Client(Capability<Session> cap) : Rpc_client<Session>(cap) { }
+
+	void null() { call<Rpc_null>(); }
+
+	void cap(Native_capability cap) { call<Rpc_cap>(cap); }
+};
+
+
+struct Test::Component : Rpc_object<Session, Component>
+{
+	void null() { }
+
+	void cap(Native_capability) { }
+};
+
+
+/**
+ * Buffer of measured durations
+ */
+class Test::Samples
+{
+	public:
+
+		enum { MAX = 10000 };
+
+	private:
+
+		Timestamp _values[MAX];
+		unsigned  _count = 0;
+
+		/**
+		 * Sort samples in ascending order using shell sort
+		 */
+		void _sort()
+		{
+			for (unsigned gap = _count/2; gap > 0; gap /= 2)
+				for (unsigned i = gap; i < _count; i++) {
+					Timestamp const v = _values[i];
+					unsigned j = i;
+					for (; j >= gap && _values[j - gap] > v; j -= gap)
+						_values[j] = _values[j - gap];
+					_values[j] = v;
+				}
+		}
+
+		Timestamp _percentile(unsigned p) const {
+			return _values[min(_count - 1, (_count*p)/100)]; }
+
+	public:
+
+		void reset() { _count = 0; }
+
+		void add(Timestamp value)
+		{
+			if (_count < MAX)
+				_values[_count++] = value;
+		}
+
+		void report(Kernel_name const &kernel, char const *name)
+		{
+			if (!_count) {
+				log("<result kernel=\"", kernel, "\" name=\"", name, "\" samples=\"0\"/>");
+				return;
+			}
+
+			_sort();
+
+			log("<result kernel=\"", kernel, "\" name=\"", name, "\""
+			    " unit=\"cycles\" samples=\"", _count, "\""
+			    " min=\"", _values[0], "\""
+			    " p50=\"", _percentile(50), "\""
+			    " p90=\"", _percentile(90), "\""
+			    " p99=\"", _percentile(99), "\""
+			    " max=\"", _values[_count - 1], "\"/>");
+		}
+};
+
+
+/**
+ * Thread that answers each signal with a signal
+ */
+struct Test::Signal_echo : Thread
+{
+	Signal_receiver _receiver { };
+	Signal_context  _context  { };
+
+	Signal_context_capability const cap = _receiver.manage(&_context);
+
+	Signal_transmitter _reply;
+
+	Signal_echo(Env &env, Signal_context_capability reply, Affinity::Location location)
+	:
+		Thread(env, "signal_echo", 8*1024, location, Weight(), env.cpu()),
+		_reply(reply)
+	{ }
+
+	~Signal_echo() { _receiver.dissolve(&_context); }
+
+	void entry() override
+	{
+		for (;;) {
+			Signal const signal = _receiver.wait_for_signal();
+			for (unsigned i = 0; i < signal.num(); i++)
+				_reply.submit();
+		}
+	}
+};
+
+
+struct Test::Empty_thread : Thread
+{
+	Empty_thread(Env &env) : Thread(env, "empty", 8*1024) { }
+
+	void entry() override { }
+};
+
+
+struct Test::Main
+{
+	enum { STACK_SIZE = 2*1024*sizeof(long), WARMUP = 1000 };
+
+	Env &_env;
+
+	Attached_rom_dataspace _config { _env, "config" };
+
+	Kernel_name const _kernel =
+		_config.xml().attribute_value("kernel", Kernel_name("unknown"));
+
+	unsigned const _rounds =
+		min((unsigned)Samples::MAX, _config.xml().attribute_value("rounds", 10000U));
+
+	Affinity::Space _space = _env.cpu().affinity_space();
+
+	Samples _samples { };
+
+	Component _component     { };
+	Component _cap_component { };
+
+	/*
+	 * Measure 'fn' with each call individually timed
+	 */
+	template <typename FN>
+	void _measure(char const *name, unsigned rounds, FN const &fn)
+	{
+		for (unsigned i = 0; i < min(rounds, (unsigned)WARMUP); i++)
+			fn();
+
+		_samples.reset();
+		for (unsigned i = 0; i < rounds; i++) {
+			Timestamp const start = Trace::timestamp();
+			fn();
+			_samples.add(Trace::timestamp() - start);
+		}
+		_samples.report(_kernel, name);
+	}
+
+	void _bench_timestamp()
+	{
+		_measure("timestamp", _rounds, [&] () { });
+	}
+
+	void _bench_rpc(char const *name, char const *cap_name,
+	                Affinity::Location location)
+	{
+		Rpc_entrypoint ep(&_env.pd(), STACK_SIZE, "kernel_bench_ep", true, location);
+
+		Client client(ep.manage(&_component));
+		_measure(name, _rounds, [&] () { client.null(); });
+
+		/* the transferred capability refers to another RPC object */
+		Native_capability const cap = ep.manage(&_cap_component);
+		_measure(cap_name, _rounds, [&] () { client.cap(cap); });
+
+		ep.dissolve(&_cap_component);
+		ep.dissolve(&_component);
+	}
+
+	void _bench_signal(char const *name, Affinity::Location location)
+	{
+		Signal_receiver receiver;
+		Signal_context  context;
+
+		Signal_echo echo(_env, receiver.manage(&context), location);
+		echo.start();
+
+		Signal_transmitter transmitter(echo.cap);
+
+		_measure(name, _rounds, [&] () {
+			transmitter.submit();
+			receiver.wait_for_signal();
+		});
+
+		receiver.dissolve(&context);
+	}
+
+	void _bench_page_fault()
+	{
+		enum { PAGES = 1024 };
+
+		_samples.reset();
+
+		for (unsigned round = 0; round*PAGES < _rounds; round++) {
+
+			Attached_ram_dataspace ds(_env.ram(), _env.rm(), PAGES*4096);
+
+			char * const base = ds.local_addr<char>();
+
+			for (unsigned i = 0; i < PAGES; i++) {
+				Timestamp const start = Trace::timestamp();
+				*(char volatile *)(base + i*4096) = 1;
+				_samples.add(Trace::timestamp() - start);
+			}
+		}
+		_samples.report(_kernel, "page_fault");
+	}
+
+	void _bench_thread_creation()
+	{
+		Heap heap(_env.ram(), _env.rm());
+
+		_measure("thread_create_join", min(_rounds, 500U), [&] () {
+			Empty_thread *thread = new (heap) Empty_thread(_env);
+			thread->start();
+			thread->join();
+			destroy(heap, thread);
+		});
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		log("--- kernel benchmarks ---");
+
+		Affinity::Location const same_cpu  = _space.location_of_index(0);
+		Affinity::Location const other_cpu = _space.location_of_index(1);
+
+		bool const smp = _space.total() > 1;
+
+		_bench_timestamp();
+
+		_bench_rpc("rpc_same_cpu", "rpc_cap_same_cpu", same_cpu);
+		if (smp)
+			_bench_rpc("rpc_cross_cpu", "rpc_cap_cross_cpu", other_cpu);
+
+		_bench_signal("signal_round_trip_same_cpu", same_cpu);
+		if (smp)
+			_bench_signal("signal_round_trip_cross_cpu", other_cpu);
+
+		_bench_page_fault();
+		_bench_thread_creation();
+
+		log("--- kernel benchmarks finished ---");
+
+		_env.parent().exit(0);
+	}
+};
+
+
+void Component::construct(Genode::Env &env) { static Test::Main main(env); }
@@ -18,6 +18,8 @@
 #include <base/log.h>
 #include <base/rpc_server.h>
 #include <base/rpc_client.h>
+#include <base/entrypoint_pool.h>
+#include <trace/timestamp.h>
 
 namespace Test {
 
@@ -34,7 +36,9 @@ namespace Test {
 		GENODE_RPC(Rpc_test_cap, void, test_cap, Genode::Native_capability);
 		GENODE_RPC(Rpc_test_cap_reply, Genode::Native_capability,
 		           test_cap_reply, Genode::Native_capability);
-		GENODE_RPC_INTERFACE(Rpc_test_untyped, Rpc_test_cap, Rpc_test_cap_reply);
+		GENODE_RPC(Rpc_test_null, void, test_null);
+		GENODE_RPC_INTERFACE(Rpc_test_untyped, Rpc_test_cap, Rpc_test_cap_reply,
+		                     Rpc_test_null);
 	};
 
 	struct Client : Genode::Rpc_client<Session>
@@ -45,6 +49,7 @@ namespace Test {
 		void test_cap(Genode::Native_capability cap) { call<Rpc_test_cap>(cap); }
 		Genode::Native_capability test_cap_reply(Genode::Native_capability cap) {
 			return call<Rpc_test_cap_reply>(cap); }
+		void test_null() { call<Rpc_test_null>(); }
 	};
 
 	struct Component : Genode::Rpc_object<Session, Component>
@@ -55,8 +60,15 @@ namespace Test {
 		void test_cap(Genode::Native_capability);
 		/* Test to transfer a object capability during send+reply */
 		Genode::Native_capability test_cap_reply(Genode::Native_capability);
+		/* Call without any payload, used for benchmarking */
+		void test_null() { }
 	};
 
+	/**
+	 * Session that may be served concurrently to other sessions
+	 */
+	struct Concurrent_component : Component, Genode::Entrypoint_pool::Concurrent { };
+
 	typedef Genode::Capability<Session> Capability;
 
 	/**
@@ -78,6 +90,112 @@ namespace Test {
 	}
 }
 
+namespace Test {
+
+	struct Benchmark_client;
+	struct Benchmark;
+}
+
+
+/**
+ * Thread on one CPU that calls its session repeatedly
+ */
+struct Test::Benchmark_client : Genode::Thread
+{
+	enum { STACK_SIZE = 2*1024*sizeof(long), CALLS = 20000 };
+
+	Client _client;
+
+	void entry() override
+	{
+		for (unsigned i = 0; i < CALLS; i++)
+			_client.test_null();
+	}
+
+	Benchmark_client(Genode::Env &env, Location location, Capability cap)
+	:
+		Genode::Thread(env, Name("bench_client"), STACK_SIZE, location,
+		               Weight(), env.cpu()),
+		_client(cap)
+	{ }
+};
+
+
+/**
+ * Compare serving one session per CPU by a single entrypoint with
+ * serving them by an entrypoint pool
+ *
+ * The benchmark runs in a thread of its own because the RPCs to the
+ * initial entrypoint can only be served after 'Component::construct'
+ * returned.
+ */
+struct Test::Benchmark : Genode::Thread
+{
+	enum { STACK_SIZE = 4*1024*sizeof(long) };
+
+	Genode::Env       &_env;
+	Genode::Allocator &_alloc;
+
+	Genode::Trace::Timestamp _run(unsigned max_eps)
+	{
+		using namespace Genode;
+
+		Affinity::Space       cpus = _env.cpu().affinity_space();
+		unsigned        const num  = cpus.total();
+
+		Entrypoint_pool pool(_env, _alloc, STACK_SIZE, "rpc_pool", max_eps);
+
+		Concurrent_component *components = new (_alloc) Concurrent_component[num];
+		Benchmark_client    **clients    = new (_alloc) Benchmark_client*[num];
+
+		for (unsigned i = 0; i < num; i++) {
+			pool.manage(components[i]);
+			clients[i] = new (_alloc)
+				Benchmark_client(_env, cpus.location_of_index(i),
+				                 reinterpret_cap_cast<Session>(components[i].cap()));
+		}
+
+		Trace::Timestamp const start = Trace::timestamp();
+
+		for (unsigned i = 0; i < num; i++)
+			clients[i]->start();
+
+		for (unsigned i = 0; i < num; i++)
+			clients[i]->join();
+
+		Trace::Timestamp const duration = Trace::timestamp() - start;
+
+		for (unsigned i = 0; i < num; i++) {
+			destroy(_alloc, clients[i]);
+			pool.dissolve(components[i]);
+		}
+
+		destroy(_alloc, clients);
+		destroy(_alloc, components);
+
+		log("benchmark with ", pool.size(), " entrypoint", pool.size() > 1 ? "s" : "",
+		    ": ", num*Benchmark_client::CALLS, " calls "
+		    "took ", duration, " cycles");
+
+		return duration;
+	}
+
+	void entry() override
+	{
+		_run(1);
+		_run(~0U);
+
+		Genode::log("done");
+	}
+
+	Benchmark(Genode::Env &env, Genode::Allocator &alloc)
+	:
+		Genode::Thread(env, Name("benchmark"), STACK_SIZE),
+		_env(env), _alloc(alloc)
+	{ }
+};
+
+
 /**
  * Set up a server running on every CPU one Rpc_entrypoint
  */
@@ -85,7 +203,7 @@ void Component::construct(Genode::Env & env)
 {
 	using namespace Genode;
 
-	Heap heap(env.ram(), env.rm());
+	static Heap heap(env.ram(), env.rm());
 
 	log("--- test-mp_server started ---");
 
@@ -132,5 +250,7 @@ void Component::construct(Genode::Env & env)
 		log("got from server on CPU ", i, " - received cap ", rcap.local_name());
 	}
 
-	log("done");
+	/* Test: Serve one session per CPU by an entrypoint pool */
+	static Test::Benchmark benchmark(env, heap);
+	benchmark.start();
 }
@@ -21,6 +21,7 @@
 #include <base/component.h>
 #include <rm_session/connection.h>
 #include <region_map/client.h>
+#include <region_map/read_ahead.h>
 #include <dataspace/client.h>
 
 using namespace Genode;
@@ -29,11 +30,15 @@ using namespace Genode;
 enum {
 	MANAGED_SIZE = 0x00010000,
 	PAGE_SIZE    = 4096,
+	READ_AHEAD   = 8*PAGE_SIZE,
 };
 
 
 /**
  * Region-manager fault handler resolves faults by attaching new dataspaces
+ *
+ * The sequential access of the test is resolved by growing ranges of pages,
+ * each backed by one dataspace.
  */
 class Local_fault_handler : public Entrypoint
 {
@@ -42,6 +47,7 @@ class Local_fault_handler : public Entrypoint
 		Env &                               _env;
 		Region_map &                        _region_map;
 		Signal_handler<Local_fault_handler> _handler;
+		Read_ahead_window                   _window { PAGE_SIZE, READ_AHEAD };
 
 		void _handle_fault()
 		{
@@ -53,9 +59,14 @@ class Local_fault_handler : public Entrypoint
 			       state.type == Region_map::State::EXEC_FAULT  ? "EXEC_FAULT"  : "READY",
 			       ", pf_addr=", Hex(state.addr, Hex::PREFIX));
 
-			log("allocate dataspace and attach it to sub region map");
-			Dataspace_capability ds = _env.ram().alloc(PAGE_SIZE);
-			_region_map.attach_at(ds, state.addr & ~(PAGE_SIZE - 1));
+			/* the test populates the region map in ascending order */
+			Read_ahead_window::Range const range =
+				_window.range(state.addr, MANAGED_SIZE);
+
+			log("allocate dataspace of ", Hex(range.size, Hex::PREFIX),
+			    " and attach it to sub region map");
+			Dataspace_capability ds = _env.ram().alloc(range.size);
+			_region_map.attach_at(ds, range.base);
 
 			log("returning from handle_fault");
 		}
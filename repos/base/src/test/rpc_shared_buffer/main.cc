@@ -0,0 +1,233 @@
+/*
+ * \brief  Test for passing large RPC arguments via a shared buffer
+ * \author Genode Labs
+ * \date   2026-10-14
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/component.h>
+#include <base/log.h>
+#include <base/rpc_server.h>
+#include <base/rpc_client.h>
+#include <base/rpc_shared_buffer.h>
+
+namespace Test {
+
+	using namespace Genode;
+
+	struct Session;
+	struct Client;
+	struct Component;
+	struct Main;
+
+	enum { BUFFER_SIZE = 128*1024, ARG_SIZE = 64*1024, MAX_STRING_LEN = 256 };
+}
+
+
+/**
+ * Test session interface definition
+ */
+struct Test::Session : Genode::Session
+{
+	static const char *service_name() { return "RPC_SHARED_BUFFER_TEST"; }
+
+	enum { CAP_QUOTA = 2 };
+
+	GENODE_RPC(Rpc_buffer, Dataspace_capability, shared_buffer);
+	GENODE_RPC(Rpc_checksum, unsigned long, checksum, Rpc_bulk_arg);
+	GENODE_RPC(Rpc_reverse, Rpc_bulk_arg, reverse, Rpc_bulk_arg);
+	GENODE_RPC(Rpc_string_length, long, string_length, Rpc_bulk_arg);
+	GENODE_RPC_INTERFACE(Rpc_buffer, Rpc_checksum, Rpc_reverse,
+	                     Rpc_string_length);
+};
+
+
+struct Test::Client : Rpc_client<Session>
+{
+	Client(Capability<Session> cap) : Rpc_client<Session>(cap) { }
+
+	Dataspace_capability shared_buffer() { return call<Rpc_buffer>(); }
+
+	unsigned long checksum(Rpc_bulk_arg arg) { return call<Rpc_checksum>(arg); }
+
+	Rpc_bulk_arg reverse(Rpc_bulk_arg arg) { return call<Rpc_reverse>(arg); }
+
+	long string_length(Rpc_bulk_arg arg) { return call<Rpc_string_length>(arg); }
+};
+
+
+struct Test::Component : Rpc_object<Session, Component>
+{
+	Genode::Rpc_shared_buffer _buffer;
+
+	Component(Env &env) : _buffer(env.ram(), env.rm(), BUFFER_SIZE) { }
+
+	Dataspace_capability shared_buffer() { return _buffer.cap(); }
+
+	/**
+	 * Return checksum of argument, or 0 if the argument is invalid
+	 */
+	unsigned long checksum(Rpc_bulk_arg arg)
+	{
+		unsigned long sum = 0;
+		_buffer.with_arg(arg, [&] (char const *start, size_t length) {
+			for (size_t i = 0; i < length; i++)
+				sum = sum*31 + (unsigned char)start[i]; });
+		return sum;
+	}
+
+	/**
+	 * Return reversed copy of argument, placed behind the argument
+	 */
+	Rpc_bulk_arg reverse(Rpc_bulk_arg arg)
+	{
+		Rpc_bulk_arg result { 0, 0 };
+		_buffer.with_arg(arg, [&] (char const *src, size_t length) {
+			result = _buffer.write(arg.next_offset(), [&] (char *dst, size_t max) {
+				size_t const n = min(length, max);
+				for (size_t i = 0; i < n; i++)
+					dst[i] = src[length - 1 - i];
+				return n;
+			});
+		});
+		return result;
+	}
+
+	/**
+	 * Return length of string argument, or -1 if the argument is invalid
+	 */
+	long string_length(Rpc_bulk_arg arg)
+	{
+		long result = -1;
+		_buffer.with_string<MAX_STRING_LEN>(arg, [&] (char const *string) {
+			result = strlen(string); });
+		return result;
+	}
+};
+
+
+struct Test::Main
+{
+	Env &_env;
+
+	enum { STACK_SIZE = 8*1024 };
+
+	Rpc_entrypoint _ep { &_env.pd(), STACK_SIZE, "rpc_buffer_ep" };
+
+	Component _component { _env };
+
+	Capability<Session> _cap = _ep.manage(&_component);
+
+	Client _client { _cap };
+
+	Rpc_shared_buffer_client _buffer { _env.rm(), _client.shared_buffer() };
+
+	static unsigned long _checksum(char const *data, size_t length)
+	{
+		unsigned long sum = 0;
+		for (size_t i = 0; i < length; i++)
+			sum = sum*31 + (unsigned char)data[i];
+		return sum;
+	}
+
+	bool _test_large_argument()
+	{
+		static char data[ARG_SIZE];
+		for (size_t i = 0; i < sizeof(data); i++)
+			data[i] = (char)(i*7 + (i >> 8));
+
+		Rpc_bulk_arg const arg = _buffer.write(data, sizeof(data));
+
+		if (_client.checksum(arg) != _checksum(data, sizeof(data))) {
+			error("checksum of large argument differs");
+			return false;
+		}
+
+		Rpc_bulk_arg const result = _client.reverse(arg);
+		if (result.length != sizeof(data) || result.offset < arg.next_offset()) {
+			error("unexpected result range ", result.offset, "+", result.length);
+			return false;
+		}
+
+		bool ok = false;
+		_buffer.with_result(result, [&] (char const *start, size_t length) {
+			ok = true;
+			for (size_t i = 0; ok && i < length; i++)
+				ok = (start[i] == data[length - 1 - i]);
+		});
+		if (!ok) {
+			error("reversed argument differs");
+			return false;
+		}
+
+		log("large argument of ", (unsigned)ARG_SIZE, " bytes passed");
+		return true;
+	}
+
+	bool _test_string_argument()
+	{
+		Rpc_bulk_arg const arg = _buffer.write_string("shared buffer");
+
+		if (_client.string_length(arg) != 13) {
+			error("unexpected string length");
+			return false;
+		}
+
+		/* string without terminating null character must be rejected */
+		if (_client.string_length(Rpc_bulk_arg { arg.offset, 5 }) != -1) {
+			error("unterminated string accepted");
+			return false;
+		}
+
+		log("string argument passed");
+		return true;
+	}
+
+	bool _test_invalid_argument()
+	{
+		Rpc_bulk_arg const beyond   { BUFFER_SIZE - 16, 32 };
+		Rpc_bulk_arg const overflow { 16, ~(size_t)0 };
+
+		if (_client.checksum(beyond) || _client.checksum(overflow)
+		 || _client.reverse(beyond).length) {
+			error("invalid argument accepted");
+			return false;
+		}
+
+		try {
+			_buffer.write("", 1, BUFFER_SIZE);
+			error("client-side range check failed");
+			return false;
+		}
+		catch (Rpc_shared_buffer_client::Arg_too_large) { }
+
+		log("invalid arguments rejected");
+		return true;
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		log("--- RPC shared-buffer test ---");
+
+		if (!_test_large_argument() || !_test_string_argument()
+		 || !_test_invalid_argument()) {
+			_env.parent().exit(-1);
+			return;
+		}
+
+		_ep.dissolve(&_component);
+
+		log("--- RPC shared-buffer test finished ---");
+		_env.parent().exit(0);
+	}
+};
+
+
+void Component::construct(Genode::Env &env) { static Test::Main main(env); }
@@ -0,0 +1,3 @@
+TARGET = test-rpc_shared_buffer
+SRC_CC = main.cc
+LIBS   = base
@@ -1,5 +1,5 @@
 /*
- * \brief  Slab allocator test
+ * \brief  Slab allocator test and heap benchmark
  * \author Norman Feske
  * \date   2015-03-31
  */
@@ -14,6 +14,9 @@
 #include <base/component.h>
 #include <base/heap.h>
 #include <base/slab.h>
+#include <base/concurrent_slab.h>
+#include <base/synced_allocator.h>
+#include <base/thread.h>
 #include <base/log.h>
 #include <base/allocator_guard.h>
 #include <timer_session/connection.h>
@@ -62,6 +65,190 @@ struct Array_of_slab_elements
 };
 
 
+/**
+ * Measure the time of allocating and freeing blocks of one size at the heap
+ */
+static void heap_benchmark(Genode::Env &env, Timer::Connection &timer,
+                           Genode::Allocator &alloc)
+{
+	enum { NUM_ELEM = 200000, MAX_BYTES = 16*1024*1024, ROUNDS = 3 };
+
+	size_t const sizes[] = { 16, 24, 64, 100, 256, 1024, 4096 };
+
+	void **elem = (void **)alloc.alloc(NUM_ELEM*sizeof(void *));
+
+	Genode::Heap heap(env.ram(), env.rm());
+
+	for (size_t size : sizes) {
+
+		size_t const num_elem = Genode::min((size_t)NUM_ELEM, MAX_BYTES/size);
+
+		size_t consumed_after_first_round = 0;
+
+		unsigned long const start_ms = timer.elapsed_ms();
+
+		for (unsigned round = 0; round < ROUNDS; round++) {
+
+			/* allocate all elements, then free them in reverse order */
+			for (size_t i = 0; i < num_elem; i++)
+				if (!heap.alloc(size, &elem[i])) {
+					error("heap allocation of ", size, " bytes failed");
+					throw Array_of_slab_elements::Alloc_failed();
+				}
+
+			for (size_t i = num_elem; i-- > 0; )
+				heap.free(elem[i], size);
+
+			/* interleave allocations and frees of a small working set */
+			for (size_t i = 0; i < NUM_ELEM; i++) {
+				size_t const j = i % 64;
+				if (i >= 64) heap.free(elem[j], size);
+				heap.alloc(size, &elem[j]);
+			}
+
+			for (size_t j = 0; j < 64; j++)
+				heap.free(elem[j], size);
+
+			if (round == 0)
+				consumed_after_first_round = heap.consumed();
+		}
+
+		log(" heap ", size, " bytes: ", ROUNDS*(2*num_elem + 2*NUM_ELEM), " operations "
+		    "took ", timer.elapsed_ms() - start_ms, " ms "
+		    "(used quota: ", heap.consumed(), ")");
+
+		if (heap.consumed() > consumed_after_first_round) {
+			error("heap leaked memory for blocks of ", size, " bytes");
+			throw Array_of_slab_elements::Alloc_failed();
+		}
+	}
+
+	alloc.free(elem, NUM_ELEM*sizeof(void *));
+}
+
+
+/**
+ * Thread that allocates and frees bursts of slab entries
+ */
+struct Slab_worker : Genode::Thread
+{
+	enum { STACK_SIZE = 4*1024*sizeof(long), BURST = 100, ROUNDS = 2000 };
+
+	Genode::Allocator &_alloc;
+	size_t      const  _slab_size;
+
+	bool failed = false;
+
+	void entry() override
+	{
+		void *elem[BURST];
+
+		for (unsigned round = 0; round < ROUNDS; round++) {
+
+			for (unsigned i = 0; i < BURST; i++)
+				if (!_alloc.alloc(_slab_size, &elem[i])) {
+					failed = true;
+					return;
+				}
+
+			for (unsigned i = 0; i < BURST; i++)
+				_alloc.free(elem[i], _slab_size);
+		}
+	}
+
+	Slab_worker(Genode::Env &env, Location location,
+	            Genode::Allocator &alloc, size_t slab_size)
+	:
+		Genode::Thread(env, Name("slab_worker"), STACK_SIZE, location,
+		               Weight(), env.cpu()),
+		_alloc(alloc), _slab_size(slab_size)
+	{ }
+};
+
+
+/**
+ * Run one worker per CPU on a shared allocator
+ *
+ * \return  duration in milliseconds
+ */
+static unsigned long run_slab_workers(Genode::Env &env, Timer::Connection &timer,
+                                      Genode::Allocator &heap,
+                                      Genode::Allocator &alloc, size_t slab_size,
+                                      unsigned num_threads)
+{
+	Genode::Affinity::Space cpus = env.cpu().affinity_space();
+
+	Slab_worker **workers = new (heap) Slab_worker*[num_threads];
+
+	for (unsigned i = 0; i < num_threads; i++)
+		workers[i] = new (heap) Slab_worker(env, cpus.location_of_index(i),
+		                                    alloc, slab_size);
+
+	unsigned long const start_ms = timer.elapsed_ms();
+
+	for (unsigned i = 0; i < num_threads; i++)
+		workers[i]->start();
+
+	bool failed = false;
+	for (unsigned i = 0; i < num_threads; i++) {
+		workers[i]->join();
+		failed |= workers[i]->failed;
+	}
+
+	unsigned long const duration_ms = timer.elapsed_ms() - start_ms;
+
+	for (unsigned i = 0; i < num_threads; i++)
+		Genode::destroy(heap, workers[i]);
+
+	Genode::destroy(heap, workers);
+
+	if (failed) {
+		error("slab allocation by worker thread failed");
+		throw Array_of_slab_elements::Alloc_failed();
+	}
+	return duration_ms;
+}
+
+
+/**
+ * Compare the lock-guarded slab with the concurrent slab for 1..N threads
+ */
+static void slab_scaling_test(Genode::Env &env, Timer::Connection &timer,
+                              Genode::Allocator &heap)
+{
+	using namespace Genode;
+
+	enum { SLAB_SIZE = 64, BLOCK_SIZE = 4096 };
+
+	unsigned const num_cpus = env.cpu().affinity_space().total();
+	log(" detected ", num_cpus, " CPU", num_cpus > 1 ? "s" : "");
+
+	Allocator_guard guard(&heap, ~0UL);
+
+	for (unsigned threads = 1; threads <= num_cpus; threads++) {
+
+		unsigned long synced_ms = 0, concurrent_ms = 0;
+		{
+			Synced_allocator<Slab> slab(SLAB_SIZE, BLOCK_SIZE, nullptr, &guard);
+			synced_ms = run_slab_workers(env, timer, heap, slab, SLAB_SIZE, threads);
+		}
+		{
+			Concurrent_slab slab(SLAB_SIZE, BLOCK_SIZE, guard);
+			concurrent_ms = run_slab_workers(env, timer, heap, slab, SLAB_SIZE, threads);
+		}
+
+		log(" ", threads, " thread", threads > 1 ? "s" : "", ": "
+		    "locked slab ", synced_ms, " ms, "
+		    "concurrent slab ", concurrent_ms, " ms");
+
+		if (guard.consumed() > 0) {
+			error("concurrent slab failed to release all backing store");
+			throw Array_of_slab_elements::Alloc_failed();
+		}
+	}
+}
+
+
 void Component::construct(Genode::Env & env)
 {
 	static Genode::Heap heap(env.ram(), env.rm());
@@ -123,5 +310,15 @@ void Component::construct(Genode::Env & env)
 		}
 	}
 
+	log("--- heap benchmark ---");
+
+	try { heap_benchmark(env, timer, heap); }
+	catch (Array_of_slab_elements::Alloc_failed) { return; }
+
+	log("--- slab scaling test ---");
+
+	try { slab_scaling_test(env, timer, heap); }
+	catch (Array_of_slab_elements::Alloc_failed) { return; }
+
 	log("Test done");
 }
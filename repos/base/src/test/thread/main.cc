@@ -22,6 +22,7 @@
 #include <cpu_session/connection.h>
 #include <cpu_thread/client.h>
 #include <cpu/memory_barrier.h>
+#include <timer_session/connection.h>
 
 using namespace Genode;
 
@@ -431,6 +432,76 @@ static void test_locks(Genode::Env &env)
 }
 
 
+/*************************************
+ ** Contention of short-term locks **
+ *************************************/
+
+struct Contention_helper : Thread
+{
+	enum { STACK_SIZE = 0x2000, ROUNDS = 100000 };
+
+	Lock          &lock;
+	unsigned long &counter;
+
+	Contention_helper(Env &env, Location location, Lock &lock,
+	                  unsigned long &counter)
+	:
+		Thread(env, "contention", STACK_SIZE, location, Weight(), env.cpu()),
+		lock(lock), counter(counter)
+	{ }
+
+	void entry()
+	{
+		for (unsigned i = 0; i < ROUNDS; i++) {
+			Lock::Guard guard(lock);
+			counter++;
+		}
+	}
+};
+
+
+/**
+ * Measure lock throughput with one thread per CPU and a tiny critical section
+ */
+static void test_lock_contention(Env &env)
+{
+	log("running '", __func__, "'");
+
+	enum { MAX_THREADS = 16 };
+
+	Timer::Connection timer(env);
+
+	Affinity::Space cpus = env.cpu().affinity_space();
+
+	unsigned const num_threads = min(cpus.total(), (unsigned)MAX_THREADS);
+
+	for (unsigned n = 1; n <= num_threads; n++) {
+
+		Lock          lock;
+		unsigned long counter = 0;
+
+		Constructible<Contention_helper> helper[MAX_THREADS];
+		for (unsigned i = 0; i < n; i++)
+			helper[i].construct(env, cpus.location_of_index(i), lock, counter);
+
+		unsigned long const start_ms = timer.elapsed_ms();
+
+		for (unsigned i = 0; i < n; i++) helper[i]->start();
+		for (unsigned i = 0; i < n; i++) helper[i]->join();
+
+		unsigned long const duration_ms = timer.elapsed_ms() - start_ms;
+
+		if (counter != n*(unsigned long)Contention_helper::ROUNDS) {
+			error("lock contention: counter ", counter, " mismatch");
+			throw -23;
+		}
+
+		log(" ", n, " thread(s): ", counter, " lock/unlock pairs in ",
+		    duration_ms, " ms");
+	}
+}
+
+
 /**********************************
  ** Using cxa guards concurrently *
  **********************************/
@@ -655,6 +726,7 @@ void Component::construct(Env &env)
 		test_stack_alignment(env);
 		test_main_thread();
 		test_cpu_session(env);
+		test_lock_contention(env);
 		if (config.xml().attribute_value("prio", false)) {
 			test_locks(env);
 			test_cxa_guards(env);
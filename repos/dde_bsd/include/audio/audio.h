@@ -54,6 +54,19 @@ namespace Audio {
 	int play(short *data, Genode::size_t size);
 
 	int record(short *data, Genode::size_t size);
+
+	/**
+	 * Return number of frames per hardware block
+	 *
+	 * The block size divides 'Audio_out::PERIOD' and 'Audio_in::PERIOD'.
+	 * The driver is notified each time a block was played or recorded.
+	 */
+	unsigned hw_period();
+
+	/**
+	 * Return number of frames handed to the device but not played yet
+	 */
+	unsigned play_delay();
 }
 
 #endif /* _AUDIO__AUDIO_H_ */
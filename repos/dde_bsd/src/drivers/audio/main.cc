@@ -73,6 +73,14 @@ class Audio_out::Out
 		Genode::Signal_handler<Audio_out::Out>  _data_avail_dispatcher;
 		Genode::Signal_handler<Audio_out::Out>  _notify_dispatcher;
 
+		/*
+		 * The device plays blocks of 'Audio::hw_period()' frames, which may
+		 * be shorter than a packet. '_offset' is the number of frames of
+		 * the current packets that were handed to the device already.
+		 */
+		unsigned _offset = 0;
+		bool     _silent = true; /* current packets are played as silence */
+
 		bool _active() {
 			return  channel_acquired[LEFT] && channel_acquired[RIGHT] &&
 			        channel_acquired[LEFT]->active() && channel_acquired[RIGHT]->active();
@@ -106,51 +114,73 @@ class Audio_out::Out
 		{
 			static short silence[Audio_out::PERIOD * Audio_out::MAX_CHANNELS] = { 0 };
 
-			int err = Audio::play(silence, sizeof(silence));
+			size_t const size = Audio::hw_period() * Audio_out::MAX_CHANNELS * sizeof(short);
+
+			int err = Audio::play(silence, size);
 			if (err && err != 35) {
 				Genode::warning("Error ", err, " during silence playback");
 			}
 		}
 
-		void _play_packet()
+		void _play_block()
 		{
+			unsigned const frames = Audio::hw_period();
+
 			unsigned lpos = left()->pos();
 			unsigned rpos = right()->pos();
 
 			Packet *p_left  = left()->get(lpos);
 			Packet *p_right = right()->get(rpos);
 
-			if (p_left->valid() && p_right->valid()) {
+			/* packets that are not valid when they are due are skipped */
+			if (_offset == 0)
+				_silent = !p_left->valid() || !p_right->valid();
+
+			if (!_silent) {
 				/* convert float to S16LE */
 				static short data[Audio_out::PERIOD * Audio_out::MAX_CHANNELS];
 
-				for (int i = 0; i < Audio_out::PERIOD * Audio_out::MAX_CHANNELS; i += 2) {
-					data[i] = p_left->content()[i / 2] * 32767;
-					data[i + 1] = p_right->content()[i / 2] * 32767;
+				float const *l = p_left->content()  + _offset;
+				float const *r = p_right->content() + _offset;
+
+				for (unsigned i = 0; i < frames; i++) {
+					data[2*i]     = l[i] * 32767;
+					data[2*i + 1] = r[i] * 32767;
 				}
 
 				/* send to driver */
-				if (int err = Audio::play(data, sizeof(data))) {
+				size_t const size = frames * Audio_out::MAX_CHANNELS * sizeof(short);
+				if (int err = Audio::play(data, size)) {
 					Genode::warning("Error ", err, " during playback");
 				}
-
-				p_left->invalidate();
-				p_right->invalidate();
-
-				p_left->mark_as_played();
-				p_right->mark_as_played();
-
 			} else {
 				_play_silence();
 			}
 
-			_advance_position(p_left, p_right);
+			_offset += frames;
 
-			/* always report when a period has passed */
-			Session_component *channel_left  = channel_acquired[LEFT];
-			Session_component *channel_right = channel_acquired[RIGHT];
-			channel_left->progress_submit();
-			channel_right->progress_submit();
+			if (_offset == Audio_out::PERIOD) {
+				_offset = 0;
+
+				if (!_silent) {
+					p_left->invalidate();
+					p_right->invalidate();
+
+					p_left->mark_as_played();
+					p_right->mark_as_played();
+				}
+
+				_advance_position(p_left, p_right);
+
+				/* always report when a period has passed */
+				Session_component *channel_left  = channel_acquired[LEFT];
+				Session_component *channel_right = channel_acquired[RIGHT];
+				channel_left->progress_submit();
+				channel_right->progress_submit();
+			}
+
+			left()->delay(Audio::play_delay());
+			right()->delay(Audio::play_delay());
 		}
 
 		/*
@@ -168,7 +198,12 @@ class Audio_out::Out
 		void _handle_notify()
 		{
 			if (_active())
-				_play_packet();
+				_play_block();
+			else {
+				/* start the next session at a packet boundary */
+				_offset = 0;
+				_play_silence();
+			}
 		}
 
 	public:
@@ -179,7 +214,8 @@ class Audio_out::Out
 			_data_avail_dispatcher(env.ep(), *this, &Audio_out::Out::_handle_data_avail),
 			_notify_dispatcher(env.ep(), *this, &Audio_out::Out::_handle_notify)
 		{
-			/* play a silence packet to get the driver running */
+			/* play two silence blocks to get the double-buffered driver running */
+			_play_silence();
 			_play_silence();
 		}
 
@@ -331,20 +367,45 @@ class Audio_in::In
 		Genode::Env                          &_env;
 		Genode::Signal_handler<Audio_in::In>  _notify_dispatcher;
 
+		/*
+		 * The device records blocks of 'Audio::hw_period()' frames, which
+		 * are collected until a packet is complete.
+		 */
+		float    _frames[Audio_in::PERIOD];
+		unsigned _offset = 0;
+
 		bool _active() { return channel_acquired && channel_acquired->active(); }
 
 		Stream *stream() { return channel_acquired->stream(); }
 
-		void _record_packet()
+		void _record_block()
 		{
+			unsigned const frames = Audio::hw_period();
+
 			static short data[2 * Audio_in::PERIOD];
-			if (int err = Audio::record(data, sizeof(data))) {
+			if (int err = Audio::record(data, 2 * frames * sizeof(short))) {
 					if (err && err != 35) {
 						Genode::warning("Error ", err, " during recording");
 					}
 					return;
 			}
 
+			float const scale = 32768.0f * 2;
+
+			for (unsigned i = 0; i < frames; i++) {
+				float sample = data[2*i] + data[2*i + 1];
+				_frames[_offset + i] = sample / scale;
+			}
+
+			_offset += frames;
+			if (_offset < Audio_in::PERIOD)
+				return;
+
+			_offset = 0;
+
+			if (!_active())
+				return;
+
 			/*
 			 * Check for an overrun first and notify the client later.
 			 */
@@ -352,13 +413,7 @@ class Audio_in::In
 
 			Packet *p = stream()->alloc();
 
-			float const scale = 32768.0f * 2;
-
-			float * const content = p->content();
-			for (int i = 0; i < 2*Audio_in::PERIOD; i += 2) {
-				float sample = data[i] + data[i+1];
-				content[i/2] = sample / scale;
-			}
+			Genode::memcpy(p->content(), _frames, sizeof(_frames));
 
 			stream()->submit(p);
 
@@ -367,11 +422,11 @@ class Audio_in::In
 			if (overrun) channel_acquired->overrun_submit();
 		}
 
-		void _handle_notify()
-		{
-			if (_active())
-				_record_packet();
-		}
+		/*
+		 * The device keeps recording without a session, so the blocks
+		 * are consumed in any case.
+		 */
+		void _handle_notify() { _record_block(); }
 
 	public:
 
@@ -379,7 +434,7 @@ class Audio_in::In
 		:
 			_env(env),
 			_notify_dispatcher(env.ep(), *this, &Audio_in::In::_handle_notify)
-		{ _record_packet(); }
+		{ _record_block(); }
 
 		Signal_context_capability sigh() { return _notify_dispatcher; }
 
@@ -37,6 +37,13 @@ static dev_t const mdev = 0x10; /* mixer0 (minor nr  16) */
 
 static bool adev_usuable = false;
 
+/* frames per hardware block */
+static unsigned hw_period = Audio_out::PERIOD;
+
+/* frames handed to the device and frames played by the device */
+static unsigned long play_written;
+static unsigned long play_played;
+
 
 static bool drv_loaded()
 {
@@ -372,7 +379,34 @@ static void configure_mixer(Genode::Env &env, Mixer &mixer, Genode::Xml_node con
 }
 
 
-static bool configure_audio_device(Genode::Env &env, dev_t dev, Genode::Xml_node config)
+/**
+ * Return hardware block size configured via the 'period' attribute
+ *
+ * The block size must be a power of two that divides the period of the
+ * Audio_out and Audio_in sessions.
+ */
+static unsigned configured_hw_period(Genode::Xml_node config)
+{
+	unsigned const period = config.attribute_value("period", (unsigned)Audio_out::PERIOD);
+
+	bool const valid = period >= 64 && period <= Audio_out::PERIOD
+	                && !(period & (period - 1));
+	if (!valid) {
+		Genode::warning("invalid period ", period, ", using ",
+		                (unsigned)Audio_out::PERIOD);
+		return Audio_out::PERIOD;
+	}
+
+	return period;
+}
+
+
+/**
+ * Configure play and record parameters
+ *
+ * \param exact  set to true if the device uses the requested block size
+ */
+static bool set_audio_info(unsigned period, bool &exact)
 {
 	struct audio_info ai;
 
@@ -386,7 +420,7 @@ static bool configure_audio_device(Genode::Env &env, dev_t dev, Genode::Xml_node
 	ai.play.sample_rate = Audio_out::SAMPLE_RATE;
 	ai.play.channels    = Audio_out::MAX_CHANNELS;
 	ai.play.encoding    = AUDIO_ENCODING_SLINEAR_LE;
-	ai.play.block_size  = Audio_out::MAX_CHANNELS * sizeof(short) * Audio_out::PERIOD;
+	ai.play.block_size  = Audio_out::MAX_CHANNELS * sizeof(short) * period;
 
 	/* Configure the device according to our Audio_in session settings
 	 *
@@ -396,14 +430,51 @@ static bool configure_audio_device(Genode::Env &env, dev_t dev, Genode::Xml_node
 	ai.record.sample_rate = Audio_in::SAMPLE_RATE;
 	ai.record.channels    = Audio_out::MAX_CHANNELS;
 	ai.record.encoding    = AUDIO_ENCODING_SLINEAR_LE;
-	ai.record.block_size  = Audio_out::MAX_CHANNELS * sizeof(short) * Audio_in::PERIOD;
+	ai.record.block_size  = Audio_out::MAX_CHANNELS * sizeof(short) * period;
+
+	/*
+	 * Keep at most two blocks in the play buffer, i.e., the device plays
+	 * one block while the next one is pending. This bounds the output
+	 * latency to two blocks.
+	 */
+	ai.hiwat = 2;
+	ai.lowat = 1;
 
 	err = audioioctl(adev, AUDIO_SETINFO, (char*)&ai, 0, 0);
 	if (err)
 		return false;
 
+	/* the device may have rounded the block size */
+	err = audioioctl(adev, AUDIO_GETINFO, (char*)&ai, 0, 0);
+	if (err)
+		return false;
+
+	exact = ai.play.block_size   == Audio_out::MAX_CHANNELS * sizeof(short) * period
+	     && ai.record.block_size == Audio_out::MAX_CHANNELS * sizeof(short) * period;
+	return true;
+}
+
+
+static bool configure_audio_device(Genode::Env &env, dev_t dev, Genode::Xml_node config)
+{
+	unsigned period = configured_hw_period(config);
+	bool     exact  = false;
+
+	if (!set_audio_info(period, exact))
+		return false;
+
+	if (!exact && period != Audio_out::PERIOD) {
+		Genode::warning("period ", period, " not supported by the device");
+
+		period = Audio_out::PERIOD;
+		if (!set_audio_info(period, exact))
+			return false;
+	}
+
+	hw_period = period;
+
 	int fullduplex = 1;
-	err = audioioctl(adev, AUDIO_SETFD, (char*)&fullduplex, 0, 0);
+	int err = audioioctl(adev, AUDIO_SETFD, (char*)&fullduplex, 0, 0);
 	if (err)
 		return false;
 
@@ -415,6 +486,8 @@ static bool configure_audio_device(Genode::Env &env, dev_t dev, Genode::Xml_node
 
 	bool const verbose = config.attribute_value<bool>("verbose", false);
 
+	if (verbose) Genode::log("period: ", hw_period, " frames");
+
 	if (verbose) dump_pinfo();
 	if (verbose) dump_rinfo();
 	if (verbose) dump_mixer(mixer);
@@ -478,6 +551,8 @@ static Genode::Signal_context_capability _record_sigh;
 
 extern "C" void notify_play()
 {
+	play_played += hw_period;
+
 	if (_play_sigh.valid())
 		Genode::Signal_transmitter(_play_sigh).submit();
 }
@@ -532,7 +607,10 @@ void Audio::record_sigh(Genode::Signal_context_capability sigh) {
 int Audio::play(short *data, Genode::size_t size)
 {
 	struct uio uio = { 0, size, UIO_READ, data, size };
-	return audiowrite(adev, &uio, IO_NDELAY);
+	int const err = audiowrite(adev, &uio, IO_NDELAY);
+
+	play_written += (size - uio.uio_resid) / (Audio_out::MAX_CHANNELS * sizeof(short));
+	return err;
 }
 
 
@@ -541,3 +619,16 @@ int Audio::record(short *data, Genode::size_t size)
 	struct uio uio = { 0, size, UIO_WRITE, data, size };
 	return audioread(adev, &uio, IO_NDELAY);
 }
+
+
+unsigned Audio::hw_period() { return hw_period; }
+
+
+unsigned Audio::play_delay()
+{
+	/* the device plays silence on underruns */
+	if (play_played > play_written)
+		play_played = play_written;
+
+	return play_written - play_played;
+}
@@ -32,17 +32,33 @@ typedef void (*dde_ipxe_nic_link_cb)(void);
  */
 typedef void (*dde_ipxe_nic_rx_cb)(unsigned if_index, const char *packet, unsigned packet_len);
 
+/**
+ * End-of-batch callback
+ *
+ * \param   more  1 if the poll budget was exhausted, 0 otherwise
+ *
+ * The callback is called after each poll pass, which passes at most
+ * DDE_IPXE_NIC_RX_BUDGET packets to the rx callback. If 'more' is set, the
+ * device interrupt stays disabled until 'dde_ipxe_nic_poll' ran out of
+ * packets.
+ */
+typedef void (*dde_ipxe_nic_rx_done_cb)(int more);
+
+enum { DDE_IPXE_NIC_RX_BUDGET = 64 };
+
 /**
  * Register packet reception callback
  *
- * \param   rx_cb    packet-reception callback function
- * \param   link_cb  link-state change callback function
+ * \param   rx_cb       packet-reception callback function
+ * \param   link_cb     link-state change callback function
+ * \param   rx_done_cb  end-of-batch callback function
  *
  * This registers a function pointer as rx callback. Incoming ethernet packets
  * are passed to this function.
  */
 extern void dde_ipxe_nic_register_callbacks(dde_ipxe_nic_rx_cb rx_cb,
-                                            dde_ipxe_nic_link_cb link_cb);
+                                            dde_ipxe_nic_link_cb link_cb,
+                                            dde_ipxe_nic_rx_done_cb rx_done_cb);
 
 /**
  * Clear callbacks
@@ -58,9 +74,24 @@ extern void dde_ipxe_nic_unregister_callbacks();
  * \param   packet_len  packet length
  *
  * \return  0 on success, -1 otherwise
+ *
+ * Completed transmissions are reaped only if the transmit ring is full.
+ * After sending a batch of packets, 'dde_ipxe_nic_poll' should be called.
  */
 extern int dde_ipxe_nic_tx(unsigned if_index, const char *packet, unsigned packet_len);
 
+/**
+ * Poll device for completed transmissions and received packets
+ *
+ * \param   if_index  index of the network interface
+ *
+ * \return  1 if the poll budget was exhausted, 0 otherwise
+ *
+ * Received packets are passed to the rx callback followed by a call of the
+ * end-of-batch callback.
+ */
+extern int dde_ipxe_nic_poll(unsigned if_index);
+
 /**
  * Get MAC address of device
  *
@@ -17,6 +17,7 @@
 #include <base/env.h>
 #include <base/heap.h>
 #include <base/log.h>
+#include <base/signal.h>
 #include <nic/component.h>
 #include <nic/root.h>
 
@@ -33,8 +34,19 @@ class Ipxe_session_component  : public Nic::Session_component
 
 	private:
 
+		enum {
+			RX_BATCH = DDE_IPXE_NIC_RX_BUDGET,
+			TX_BATCH = 64,
+		};
+
 		Nic::Mac_address _mac_addr;
 
+		/* received packets submitted at the end of each poll pass */
+		Nic::Packet_descriptor _rx_batch[RX_BATCH];
+		unsigned               _rx_batch_count = 0;
+
+		Genode::Signal_handler<Ipxe_session_component> _repoll_handler;
+
 		static void _rx_callback(unsigned    if_index,
 		                         const char *packet,
 		                         unsigned    packet_len)
@@ -43,57 +55,121 @@ class Ipxe_session_component  : public Nic::Session_component
 				instance->_receive(packet, packet_len);
 		}
 
+		static void _rx_done_callback(int more)
+		{
+			if (instance)
+				instance->_rx_done(more);
+		}
+
 		static void _link_callback()
 		{
 			if (instance)
 				instance->_link_state_changed();
 		}
 
+		void _release_acked_rx()
+		{
+			Nic::Packet_descriptor acked[RX_BATCH];
+
+			while (unsigned const n = _rx.source()->get_acked_packets(acked, RX_BATCH))
+				for (unsigned i = 0; i < n; i++)
+					_rx.source()->release_packet(acked[i]);
+		}
+
+		void _flush_rx()
+		{
+			if (!_rx_batch_count)
+				return;
+
+			unsigned const submitted =
+				_rx.source()->submit_packets(_rx_batch, _rx_batch_count);
+
+			/* '_receive' reserves the queue slots, so this is just a precaution */
+			for (unsigned i = submitted; i < _rx_batch_count; i++)
+				_rx.source()->release_packet(_rx_batch[i]);
+
+			_rx_batch_count = 0;
+		}
+
+		/**
+		 * Transmit pending packets in batches
+		 *
+		 * \return true if any packet was sent
+		 */
 		bool _send()
 		{
 			using namespace Genode;
 
-			if (!_tx.sink()->ready_to_ack())
-				return false;
+			Nic::Packet_descriptor batch[TX_BATCH];
 
-			if (!_tx.sink()->packet_avail())
-				return false;
+			bool sent = false;
 
-			Packet_descriptor packet = _tx.sink()->get_packet();
-			if (!packet.size()) {
-				Genode::warning("Invalid tx packet");
-				return true;
-			}
+			for (;;) {
+				unsigned const max = min((unsigned)TX_BATCH,
+				                         _tx.sink()->ack_slots_free());
+				unsigned const n = max ? _tx.sink()->get_packets(batch, max) : 0;
+				if (!n)
+					break;
+
+				for (unsigned i = 0; i < n; i++) {
+					char const *content = _tx.sink()->packet_content(batch[i]);
+					if (!batch[i].size() || !content) {
+						Genode::warning("Invalid tx packet");
+						continue;
+					}
 
-			if (dde_ipxe_nic_tx(1, _tx.sink()->packet_content(packet), packet.size()))
-				Genode::warning("Sending packet failed!");
+					if (dde_ipxe_nic_tx(1, content, batch[i].size()))
+						Genode::warning("Sending packet failed!");
+				}
 
-			_tx.sink()->acknowledge_packet(packet);
-			return true;
+				_tx.sink()->acknowledge_packets(batch, n);
+				sent = true;
+			}
+
+			return sent;
 		}
 
 		void _receive(const char *packet, unsigned packet_len)
 		{
-			_handle_packet_stream();
+			if (!_rx_batch_count)
+				_release_acked_rx();
 
-			if (!_rx.source()->ready_to_submit())
+			if (_rx.source()->submit_slots_free() <= _rx_batch_count)
 				return;
 
 			try {
 				Nic::Packet_descriptor p = _rx.source()->alloc_packet(packet_len);
 				Genode::memcpy(_rx.source()->packet_content(p), packet, packet_len);
-				_rx.source()->submit_packet(p);
+				_rx_batch[_rx_batch_count++] = p;
 			} catch (...) {
 				Genode::warning(__func__, ": failed to process received packet");
 			}
 		}
 
+		/**
+		 * Submit the batch of a poll pass, continue polling if needed
+		 *
+		 * While the poll budget gets exhausted, the device interrupt is
+		 * disabled and the device is polled via a local signal. So the
+		 * entrypoint serves the Nic client between two poll passes.
+		 */
+		void _rx_done(int more)
+		{
+			_flush_rx();
+
+			if (more)
+				Genode::Signal_transmitter(_repoll_handler).submit();
+		}
+
+		void _handle_repoll() { dde_ipxe_nic_poll(1); }
+
 		void _handle_packet_stream() override
 		{
-			while (_rx.source()->ack_avail())
-				_rx.source()->release_packet(_rx.source()->get_acked_packet());
+			_release_acked_rx();
 
-			while (_send()) ;
+			/* reap completions and receive packets once per batch */
+			if (_send())
+				dde_ipxe_nic_poll(1);
 		}
 
 	public:
@@ -102,11 +178,14 @@ class Ipxe_session_component  : public Nic::Session_component
 		                       Genode::size_t const rx_buf_size,
 		                       Genode::Allocator   &rx_block_md_alloc,
 		                       Genode::Env         &env)
-		: Session_component(tx_buf_size, rx_buf_size, rx_block_md_alloc, env)
+		:
+			Session_component(tx_buf_size, rx_buf_size, rx_block_md_alloc, env),
+			_repoll_handler(env.ep(), *this, &Ipxe_session_component::_handle_repoll)
 		{
 			instance = this;
 
-			dde_ipxe_nic_register_callbacks(_rx_callback, _link_callback);
+			dde_ipxe_nic_register_callbacks(_rx_callback, _link_callback,
+			                                _rx_done_callback);
 
 			dde_ipxe_nic_get_mac_addr(1, _mac_addr.addr);
 
@@ -31,8 +31,14 @@ static struct net_device *net_dev;
 /**
  * Callback function pointers
  */
-static dde_ipxe_nic_link_cb link_callback;
-static dde_ipxe_nic_rx_cb   rx_callback;
+static dde_ipxe_nic_link_cb    link_callback;
+static dde_ipxe_nic_rx_cb      rx_callback;
+static dde_ipxe_nic_rx_done_cb rx_done_callback;
+
+/**
+ * State of the device interrupt
+ */
+static int irq_enabled = 1;
 
 /**
  * Known iPXE driver structures (located in the driver binaries)
@@ -176,33 +182,93 @@ static unsigned scan_pci(void)
 
 
 /**
- * IRQ handler registered at DDE
+ * Enable or disable the device interrupt
  */
-static void irq_handler(void *p)
+static void set_irq(int enable)
+{
+	if (irq_enabled == enable)
+		return;
+
+	netdev_irq(net_dev, enable);
+	irq_enabled = enable;
+}
+
+
+/**
+ * Poll the device and pass received packets to the rx callback
+ *
+ * The device is polled until it has no more received packets or
+ * DDE_IPXE_NIC_RX_BUDGET packets were passed to the callback. Each poll
+ * reaps all completed transmissions and received frames of the rings.
+ * Similar to NAPI in Linux, the device interrupt stays disabled while the
+ * budget gets exhausted.
+ *
+ * Must be called with the DDE lock held.
+ *
+ * \return 1 if the budget is exhausted
+ */
+static int poll_pass(void)
+{
+	unsigned budget = DDE_IPXE_NIC_RX_BUDGET;
+
+	while (budget) {
+		netdev_poll(net_dev);
+
+		struct io_buffer *iobuf = netdev_rx_dequeue(net_dev);
+		if (!iobuf)
+			break;
+
+		for (; iobuf; iobuf = budget ? netdev_rx_dequeue(net_dev) : 0) {
+			dde_lock_leave();
+			if (rx_callback)
+				rx_callback(1, iobuf->data, iob_len(iobuf));
+			dde_lock_enter();
+			free_iob(iobuf);
+			budget--;
+		}
+	}
+
+	int const more = !budget;
+
+	set_irq(!more);
+
+	return more;
+}
+
+
+/**
+ * Poll device and report the end of the batch and link-state changes
+ */
+static int poll_device(void)
 {
 	dde_lock_enter();
 
-	/* check for the link-state to change on each interrupt */
+	/* check for the link-state to change on each poll */
 	int link_ok = netdev_link_ok(net_dev);
 
 	/* poll the device for packets and also link-state changes */
-	netdev_poll(net_dev);
-
-	struct io_buffer *iobuf;
-	while ((iobuf = netdev_rx_dequeue(net_dev))) {
-		dde_lock_leave();
-		if (rx_callback)
-			rx_callback(1, iobuf->data, iob_len(iobuf));
-		dde_lock_enter();
-		free_iob(iobuf);
-	}
+	int const more = poll_pass();
 
 	dde_lock_leave();
 
+	if (rx_done_callback)
+		rx_done_callback(more);
+
 	if (link_ok != netdev_link_ok(net_dev))
 		/* report link-state changes */
 		if (link_callback)
 			link_callback();
+
+	return more;
+}
+
+
+/**
+ * IRQ handler registered at DDE
+ */
+static void irq_handler(void *p)
+{
+	poll_device();
 }
 
 
@@ -211,12 +277,18 @@ static void irq_handler(void *p)
  ************************/
 
 void dde_ipxe_nic_register_callbacks(dde_ipxe_nic_rx_cb rx_cb,
-                                     dde_ipxe_nic_link_cb link_cb)
+                                     dde_ipxe_nic_link_cb link_cb,
+                                     dde_ipxe_nic_rx_done_cb rx_done_cb)
 {
 	dde_lock_enter();
 
-	rx_callback   = rx_cb;
-	link_callback = link_cb;
+	rx_callback      = rx_cb;
+	link_callback    = link_cb;
+	rx_done_callback = rx_done_cb;
+
+	/* a previous client may have left us in polling mode */
+	if (net_dev)
+		set_irq(1);
 
 	dde_lock_leave();
 }
@@ -226,8 +298,9 @@ void dde_ipxe_nic_unregister_callbacks(void)
 {
 	dde_lock_enter();
 
-	rx_callback   = (dde_ipxe_nic_rx_cb)0;
-	link_callback = (dde_ipxe_nic_link_cb)0;
+	rx_callback      = (dde_ipxe_nic_rx_cb)0;
+	link_callback    = (dde_ipxe_nic_link_cb)0;
+	rx_done_callback = (dde_ipxe_nic_rx_done_cb)0;
 
 	dde_lock_leave();
 }
@@ -247,28 +320,55 @@ int dde_ipxe_nic_link_state(unsigned if_index)
 }
 
 
-int dde_ipxe_nic_tx(unsigned if_index, const char *packet, unsigned packet_len)
+/**
+ * Copy packet into I/O buffer and hand it to the device
+ *
+ * Must be called with the DDE lock held.
+ */
+static int transmit(const char *packet, unsigned packet_len)
 {
-	if (if_index != 1)
+	struct io_buffer *iobuf = alloc_iob(packet_len);
+
+	if (!iobuf)
 		return -1;
 
+	dde_lock_leave();
+
+	memcpy(iob_put(iobuf, packet_len), packet, packet_len);
+
 	dde_lock_enter();
 
-	struct io_buffer *iobuf = alloc_iob(packet_len);
+	/* the buffer is released by the network stack in any case */
+	return netdev_tx(net_dev, iob_disown(iobuf)) ? -1 : 0;
+}
 
-	dde_lock_leave();
 
-	if (!iobuf)
+int dde_ipxe_nic_tx(unsigned if_index, const char *packet, unsigned packet_len)
+{
+	if (if_index != 1)
 		return -1;
 
-	memcpy(iob_put(iobuf, packet_len), packet, packet_len);
 	dde_lock_enter();
 
-	netdev_poll(net_dev);
-	netdev_tx(net_dev, iob_disown(iobuf));
+	int rc = transmit(packet, packet_len);
+
+	/* on a full transmit ring, reap completed transmissions and retry */
+	if (rc) {
+		netdev_poll(net_dev);
+		rc = transmit(packet, packet_len);
+	}
 
 	dde_lock_leave();
-	return 0;
+	return rc;
+}
+
+
+int dde_ipxe_nic_poll(unsigned if_index)
+{
+	if (if_index != 1)
+		return 0;
+
+	return poll_device();
 }
 
 
@@ -91,15 +91,65 @@ class Framebuffer::Session_component : public Genode::Rpc_object<Session>
 		Genode::Attached_ram_dataspace       _ds;
 		bool                                 _in_mode_change = true;
 
+		enum { MAX_BUFFERS = 3, NONE = ~0U };
+
+		/*
+		 * Page flipping copies the flip area of the new front buffer to
+		 * the physical frame buffer at the periodic sync tick, which
+		 * thereby serves as vertical blank.
+		 */
+		Genode::Signal_context_capability    _sync_sigh;
+		Genode::Signal_context_capability    _flip_sigh;
+		unsigned                             _buffers = 1;
+		unsigned                             _front   = 0;
+		unsigned                             _pending = NONE;
+		struct { int x, y, w, h; }           _flip_area { 0, 0, 0, 0 };
+		bool                                 _ticking = false;
+
+		Genode::Signal_handler<Session_component> _tick_handler;
+
 		unsigned long _polling_from_config() {
 			return _config.xml().attribute_value<unsigned long>("poll", 0); }
 
+		unsigned _buffers_from_config()
+		{
+			unsigned const buffers = _config.xml().attribute_value("buffers", 1U);
+			return Genode::max(1U, Genode::min((unsigned)MAX_BUFFERS, buffers));
+		}
+
+		void _start_ticking()
+		{
+			if (_ticking) return;
+
+			_timer.sigh(_tick_handler);
+			_timer.trigger_periodic(10*1000);
+			_ticking = true;
+		}
+
+		void _handle_tick()
+		{
+			if (_pending != NONE) {
+				_front   = _pending;
+				_pending = NONE;
+
+				refresh(_flip_area.x, _flip_area.y, _flip_area.w, _flip_area.h);
+
+				if (_flip_sigh.valid())
+					Genode::Signal_transmitter(_flip_sigh).submit();
+			}
+
+			if (_sync_sigh.valid())
+				Genode::Signal_transmitter(_sync_sigh).submit();
+		}
+
 	public:
 
 		Session_component(Genode::Env &env,
 		                  Genode::Attached_rom_dataspace &config)
 		: _driver(env, *this), _config(config), _timer(env),
-		  _ram(env.ram()), _ds(env.ram(), env.rm(), 0) {}
+		  _ram(env.ram()), _ds(env.ram(), env.rm(), 0),
+		  _buffers(_buffers_from_config()),
+		  _tick_handler(env.ep(), *this, &Session_component::_handle_tick) {}
 
 		Driver & driver() { return _driver; }
 
@@ -137,7 +187,11 @@ class Framebuffer::Session_component : public Genode::Rpc_object<Session>
 
 		Genode::Dataspace_capability dataspace() override
 		{
-			_ds.realloc(&_ram, _driver.width()*_driver.height()*_driver.bpp());
+			_buffers = _buffers_from_config();
+			_front   = 0;
+			_pending = NONE;
+
+			_ds.realloc(&_ram, _buffers*_driver.width()*_driver.height()*_driver.bpp());
 			_in_mode_change = false;
 			return _ds.cap();
 		}
@@ -150,8 +204,8 @@ class Framebuffer::Session_component : public Genode::Rpc_object<Session>
 
 		void sync_sigh(Genode::Signal_context_capability sigh) override
 		{
-			_timer.sigh(sigh);
-			_timer.trigger_periodic(10*1000);
+			_sync_sigh = sigh;
+			_start_ticking();
 		}
 
 		void refresh(int x, int y, int w, int h) override
@@ -174,13 +228,28 @@ class Framebuffer::Session_component : public Genode::Rpc_object<Session>
 			    y1 = max(y, 0);
 			if (x1 > x2 || y1 > y2) return;
 
-			/* copy pixels from back buffer to physical frame buffer */
-			char *src = _ds.local_addr<char>()  + bpp*(width*y1 + x1),
+			/* copy pixels from front buffer to physical frame buffer */
+			char *src = _ds.local_addr<char>()  + bpp*width*height*_front
+			                                    + bpp*(width*y1 + x1),
 			     *dst = (char*)_driver.fb_addr() + pitch*y1 + bpp*x1;
 
 			blit(src, bpp*width, dst, pitch,
 			     bpp*(x2 - x1 + 1), y2 - y1 + 1);
 		}
+
+		unsigned buffers() const override { return _buffers; }
+
+		void flip(unsigned buffer, int x, int y, int w, int h) override
+		{
+			if (buffer >= _buffers) return;
+
+			_pending   = buffer;
+			_flip_area = { x, y, w, h };
+			_start_ticking();
+		}
+
+		void flip_sigh(Genode::Signal_context_capability sigh) override {
+			_flip_sigh = sigh; }
 };
 
 
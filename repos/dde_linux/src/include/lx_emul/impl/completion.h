@@ -13,7 +13,7 @@
 
 /* Linux kint includes */
 #include <lx_kit/env.h>
-#include <lx_kit/internal/task.h>
+#include <lx_kit/scheduler.h>
 
 typedef Lx::Task::List_element Wait_le;
 typedef Lx::Task::List         Wait_list;
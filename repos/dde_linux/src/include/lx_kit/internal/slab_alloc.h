@@ -32,10 +32,32 @@ class Lx::Slab_alloc : public Genode::Slab
 
 		typedef Genode::size_t size_t;
 
+		struct Stats
+		{
+			unsigned long allocs = 0;
+			unsigned long frees  = 0;
+			unsigned long fast   = 0; /* allocations served by the free list */
+			unsigned long in_use = 0;
+			unsigned long peak   = 0;
+		};
+
 	private:
 
+		/*
+		 * Recently freed objects are kept in a LIFO free list, which serves
+		 * allocations without touching the slab blocks and hands out objects
+		 * that are likely still cached.
+		 */
+		enum { FREE_LIST_MAX = 32 };
+
+		struct Free_object { Free_object *next; };
+
 		size_t const _object_size;
 
+		Free_object *_free_list  = nullptr;
+		unsigned     _free_count = 0;
+		Stats        _stats;
+
 		/*
 		 * Each slab block in the slab contains about 8 objects (slab entries)
 		 * as proposed in the paper by Bonwick and block sizes are multiples of
@@ -47,24 +69,65 @@ class Lx::Slab_alloc : public Genode::Slab
 			return Genode::align_addr(block_size, 12);
 		}
 
+		Genode::addr_t _account_alloc(Genode::addr_t addr)
+		{
+			if (++_stats.in_use > _stats.peak)
+				_stats.peak = _stats.in_use;
+
+			return addr;
+		}
+
 	public:
 
 		Slab_alloc(size_t object_size, Slab_backend_alloc &allocator)
 		:
-			Slab(object_size, _calculate_block_size(object_size), 0, &allocator),
-			_object_size(object_size)
+			Slab(Genode::max(object_size, sizeof(Free_object)),
+			     _calculate_block_size(object_size), 0, &allocator),
+			_object_size(Genode::max(object_size, sizeof(Free_object)))
 		{ }
 
+		~Slab_alloc()
+		{
+			while (Free_object *o = _free_list) {
+				_free_list = o->next;
+				Slab::free(o, _object_size);
+			}
+		}
+
 		Genode::addr_t alloc()
 		{
+			_stats.allocs++;
+
+			if (Free_object *o = _free_list) {
+				_free_list = o->next;
+				_free_count--;
+				_stats.fast++;
+				return _account_alloc((Genode::addr_t)o);
+			}
+
 			Genode::addr_t result;
-			return (Slab::alloc(_object_size, (void **)&result) ? result : 0);
+			return (Slab::alloc(_object_size, (void **)&result) ? _account_alloc(result) : 0);
 		}
 
 		void free(void *ptr)
 		{
+			_stats.frees++;
+			_stats.in_use--;
+
+			if (_free_count < FREE_LIST_MAX) {
+				Free_object *o = (Free_object *)ptr;
+				o->next    = _free_list;
+				_free_list = o;
+				_free_count++;
+				return;
+			}
+
 			Slab::free(ptr, _object_size);
 		}
+
+		size_t object_size() const { return _object_size; }
+
+		Stats const &stats() const { return _stats; }
 };
 
 #endif /* _LX_KIT__INTERAL__SLAB_ALLOC_H_ */
@@ -107,6 +107,20 @@ class Lx::Task : public Lx_kit::List<Lx::Task>::Element
 
 	public:
 
+		/**
+		 * Run-queue membership and accounting, managed by the scheduler
+		 *
+		 * \noapi
+		 */
+		struct Sched
+		{
+			Task              *prev    = nullptr;
+			Task              *next    = nullptr;
+			bool               queued  = false;
+			unsigned           index   = 0;
+			unsigned long long runtime = 0; /* in time-stamp counter ticks */
+		} sched;
+
 		Task(void (*func)(void*), void *arg, char const *name,
 		     Priority priority, Scheduler &scheduler);
 
@@ -150,10 +164,16 @@ class Lx::Task : public Lx_kit::List<Lx::Task>::Element
 		 ** Runtime state transitions **
 		 *******************************/
 
+		/*
+		 * The scheduler keeps runnable tasks in a run queue. A wake-up of a
+		 * task that is already runnable does not touch the queue.
+		 */
+
 		void block()
 		{
 			if (_state == STATE_RUNNING) {
 				_state = STATE_BLOCKED;
+				_scheduler.blocked(this);
 			}
 		}
 
@@ -161,6 +181,7 @@ class Lx::Task : public Lx_kit::List<Lx::Task>::Element
 		{
 			if (_state == STATE_BLOCKED) {
 				_state = STATE_RUNNING;
+				_scheduler.runnable(this);
 			}
 		}
 
@@ -169,6 +190,7 @@ class Lx::Task : public Lx_kit::List<Lx::Task>::Element
 			if (_state == STATE_RUNNING) {
 				_state = STATE_MUTEX_BLOCKED;
 				list->append(&_mutex_le);
+				_scheduler.blocked(this);
 			}
 		}
 
@@ -177,6 +199,7 @@ class Lx::Task : public Lx_kit::List<Lx::Task>::Element
 			if (_state == STATE_MUTEX_BLOCKED) {
 				_state = STATE_RUNNING;
 				list->remove(&_mutex_le);
+				_scheduler.runnable(this);
 			}
 		}
 
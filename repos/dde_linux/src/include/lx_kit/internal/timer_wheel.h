@@ -0,0 +1,359 @@
+/*
+ * \brief  Hashed timer wheel for Linux timers
+ * \author Genode Labs
+ * \date   2026-10-14
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is distributed under the terms of the GNU General Public License
+ * version 2.
+ */
+
+#ifndef _LX_KIT__INTERNAL__TIMER_WHEEL_H_
+#define _LX_KIT__INTERNAL__TIMER_WHEEL_H_
+
+/* Genode includes */
+#include <util/noncopyable.h>
+
+
+namespace Lx_kit { class Timer_wheel; }
+
+
+/**
+ * Cascading timer wheel as used by Linux up to version 4.7
+ *
+ * Timers expiring within the next 256 jiffies live in per-jiffy slots of
+ * the first level. Timers further in the future live in one of four upper
+ * levels of 64 slots each, whose granularity grows by a factor of 64 per
+ * level. Whenever the first level wraps around, the current slot of the
+ * next level gets redistributed to the lower levels. Hence, adding,
+ * modifying, and deleting a timer takes constant time and timers of the
+ * same jiffy fire in the order they were scheduled.
+ *
+ * Timers are registered by the address of their Linux timer object, which
+ * is looked up via a hash table.
+ */
+class Lx_kit::Timer_wheel : Genode::Noncopyable
+{
+	private:
+
+		struct Slot;
+
+	public:
+
+		class Entry : Genode::Noncopyable
+		{
+			private:
+
+				friend class Timer_wheel;
+
+				void const *_key;
+
+				Entry   *_hash_next = nullptr;
+				Entry   *_prev      = nullptr;
+				Entry   *_next      = nullptr;
+				Slot    *_slot      = nullptr;
+				unsigned _level     = 0;
+
+			public:
+
+				enum { INVALID_TIMEOUT = ~0UL };
+
+				unsigned long timeout { INVALID_TIMEOUT }; /* absolute in jiffies */
+
+				Entry(void const *key) : _key(key) { }
+
+				void const *key() const { return _key; }
+
+				/**
+				 * Return true if the timer is scheduled but has not fired yet
+				 */
+				bool pending() const { return _slot != nullptr; }
+		};
+
+	private:
+
+		enum {
+			TV1_BITS  = 8,
+			TVN_BITS  = 6,
+			TV1_SIZE  = 1 << TV1_BITS,
+			TVN_SIZE  = 1 << TVN_BITS,
+			TV1_MASK  = TV1_SIZE - 1,
+			TVN_MASK  = TVN_SIZE - 1,
+			LEVELS    = 5,
+			EXPIRED   = LEVELS, /* pseudo level of the timers about to fire */
+			HASH_BITS = 10,
+			HASH_SIZE = 1 << HASH_BITS,
+		};
+
+		/* timers are never scheduled further than 2^32 jiffies ahead */
+		static unsigned long max_delta() { return 0xffffffffUL; }
+
+		struct Slot
+		{
+			Entry *first = nullptr;
+			Entry *last  = nullptr;
+		};
+
+		Slot     _tv1[TV1_SIZE];
+		Slot     _tvn[LEVELS - 1][TVN_SIZE];
+		Slot     _expired;
+		unsigned _count[LEVELS + 1] { };
+		Entry   *_hash[HASH_SIZE] { };
+
+		unsigned long _base = 0; /* next jiffy to process */
+
+		static unsigned _hash_index(void const *key)
+		{
+			unsigned long const v = (unsigned long)key;
+			return (v >> 4 ^ v >> (4 + HASH_BITS)) & (HASH_SIZE - 1);
+		}
+
+		/**
+		 * Return bit position of the slot index of upper 'level'
+		 */
+		static unsigned _shift(unsigned level) {
+			return TV1_BITS + (level - 1)*TVN_BITS; }
+
+		bool _empty() const
+		{
+			for (unsigned level = 0; level < LEVELS; level++)
+				if (_count[level])
+					return false;
+
+			return true;
+		}
+
+		void _link(Slot &slot, unsigned level, Entry &e)
+		{
+			e._next = nullptr;
+			e._prev = slot.last;
+
+			if (slot.last)
+				slot.last->_next = &e;
+			else
+				slot.first = &e;
+
+			slot.last = &e;
+			e._slot   = &slot;
+			e._level  = level;
+			_count[level]++;
+		}
+
+		void _unlink(Entry &e)
+		{
+			Slot &slot = *e._slot;
+
+			if (e._prev) e._prev->_next = e._next;
+			else         slot.first     = e._next;
+
+			if (e._next) e._next->_prev = e._prev;
+			else         slot.last      = e._prev;
+
+			_count[e._level]--;
+			e._slot = nullptr;
+			e._prev = e._next = nullptr;
+		}
+
+		void _enqueue(Entry &e)
+		{
+			unsigned long       expires = e.timeout;
+			unsigned long const delta   = expires - _base;
+
+			/* already expired timers fire with the next processed jiffy */
+			if ((long)delta < 0) {
+				_link(_tv1[_base & TV1_MASK], 0, e);
+				return;
+			}
+
+			if (delta < TV1_SIZE) {
+				_link(_tv1[expires & TV1_MASK], 0, e);
+				return;
+			}
+
+			if (delta > max_delta())
+				expires = _base + max_delta();
+
+			for (unsigned level = 1; level < LEVELS; level++) {
+				unsigned const shift = _shift(level);
+
+				if (level == LEVELS - 1 || expires - _base < 1UL << (shift + TVN_BITS)) {
+					_link(_tvn[level - 1][(expires >> shift) & TVN_MASK], level, e);
+					return;
+				}
+			}
+		}
+
+		/**
+		 * Redistribute the current slot of upper 'level' to lower levels
+		 *
+		 * \return index of the redistributed slot
+		 */
+		unsigned _cascade(unsigned level)
+		{
+			unsigned const index = (_base >> _shift(level)) & TVN_MASK;
+
+			Slot &slot = _tvn[level - 1][index];
+			while (Entry *e = slot.first) {
+				_unlink(*e);
+				_enqueue(*e);
+			}
+			return index;
+		}
+
+	public:
+
+		/**
+		 * Register timer for lookup
+		 */
+		void insert(Entry &e)
+		{
+			unsigned const i = _hash_index(e._key);
+
+			e._hash_next = _hash[i];
+			_hash[i]     = &e;
+		}
+
+		/**
+		 * Deactivate and unregister timer
+		 */
+		void remove(Entry &e)
+		{
+			deactivate(e);
+
+			for (Entry **p = &_hash[_hash_index(e._key)]; *p; p = &(*p)->_hash_next)
+				if (*p == &e) {
+					*p = e._hash_next;
+					break;
+				}
+
+			e._hash_next = nullptr;
+		}
+
+		Entry *lookup(void const *key) const
+		{
+			for (Entry *e = _hash[_hash_index(key)]; e; e = e->_hash_next)
+				if (e->_key == key)
+					return e;
+
+			return nullptr;
+		}
+
+		/**
+		 * Schedule or reschedule timer to fire at jiffy 'expires'
+		 *
+		 * \param now  current jiffies, used to resynchronize the wheel
+		 *             after it ran idle
+		 */
+		void schedule(Entry &e, unsigned long expires, unsigned long now)
+		{
+			deactivate(e);
+
+			if (_empty())
+				_base = now;
+
+			e.timeout = expires;
+			_enqueue(e);
+		}
+
+		void deactivate(Entry &e)
+		{
+			if (e.pending())
+				_unlink(e);
+		}
+
+		/**
+		 * Fire all timers expired at jiffy 'now'
+		 *
+		 * The functor is called with each expired timer, which is no longer
+		 * pending at this point. It may schedule or remove any timer.
+		 */
+		template <typename FN>
+		void expire(unsigned long now, FN const &fn)
+		{
+			while ((long)(now - _base) >= 0) {
+
+				if (_empty()) {
+					_base = now + 1;
+					return;
+				}
+
+				unsigned const index = _base & TV1_MASK;
+
+				/* the first level wrapped around */
+				if (!index)
+					for (unsigned level = 1; level < LEVELS; level++)
+						if (_cascade(level))
+							break;
+
+				Slot &slot = _tv1[index];
+				while (Entry *e = slot.first) {
+					_unlink(*e);
+					_link(_expired, EXPIRED, *e);
+				}
+
+				_base++;
+
+				while (Entry *e = _expired.first) {
+					_unlink(*e);
+					fn(*e);
+				}
+
+				/* skip empty slots up to the next wrap around */
+				if (!_count[0]) {
+					unsigned long const wrap = (_base + TV1_MASK) & ~(unsigned long)TV1_MASK;
+					_base = (long)(now + 1 - wrap) < 0 ? now + 1 : wrap;
+				}
+			}
+		}
+
+		/**
+		 * Determine jiffy at which 'expire' must be called next
+		 *
+		 * The result is exact if the earliest timer is on the first level.
+		 * Otherwise, it is the jiffy at which the earliest occupied slot of
+		 * the upper levels gets redistributed.
+		 *
+		 * \return false if no timer is pending
+		 */
+		bool next_event(unsigned long &jiffy) const
+		{
+			bool found = false;
+
+			if (_count[0])
+				for (unsigned i = 0; i < TV1_SIZE; i++)
+					if (_tv1[(_base + i) & TV1_MASK].first) {
+						jiffy = _base + i;
+						found = true;
+						break;
+					}
+
+			for (unsigned level = 1; level < LEVELS; level++) {
+
+				if (!_count[level])
+					continue;
+
+				unsigned const      shift = _shift(level);
+				unsigned long const step  = 1UL << shift;
+
+				/* jiffies of the upcoming redistributions of this level */
+				unsigned long at = (_base + step - 1) & ~(step - 1);
+				for (unsigned i = 0; i < TVN_SIZE; i++, at += step) {
+
+					if (!_tvn[level - 1][(at >> shift) & TVN_MASK].first)
+						continue;
+
+					if (!found || (long)(at - jiffy) < 0)
+						jiffy = at;
+
+					found = true;
+					break;
+				}
+			}
+			return found;
+		}
+};
+
+#endif /* _LX_KIT__INTERNAL__TIMER_WHEEL_H_ */
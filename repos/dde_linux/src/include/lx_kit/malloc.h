@@ -60,6 +60,14 @@ class Lx::Malloc : public Genode::Allocator
 		 */
 		virtual bool inside(addr_t const addr) const = 0;
 
+		/**
+		 * Log usage of the size classes and of the backing store
+		 *
+		 * The peak number of objects and the backend size help to
+		 * dimension the RAM quota of a driver.
+		 */
+		virtual void log_stats() const = 0;
+
 		/**
 		 * Genode alllocator interface
 		 */
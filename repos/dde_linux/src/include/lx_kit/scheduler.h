@@ -57,6 +57,16 @@ class Lx::Scheduler
 		 */
 		virtual void remove(Task *task) = 0;
 
+		/**
+		 * Enqueue task that became runnable
+		 */
+		virtual void runnable(Task *task) = 0;
+
+		/**
+		 * Dequeue task that got blocked
+		 */
+		virtual void blocked(Task *task) = 0;
+
 		/**
 		 * Schedule all present tasks
 		 *
@@ -64,6 +74,11 @@ class Lx::Scheduler
 		 */
 		virtual void schedule() = 0;
 
+		/**
+		 * Return number of task switches since the start of the scheduler
+		 */
+		virtual unsigned long task_switches() const = 0;
+
 		/**
 		 * Log current state of tasks in present list (debug)
 		 *
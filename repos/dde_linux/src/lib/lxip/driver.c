@@ -15,6 +15,8 @@
 /* Linux includes */
 #include <linux/netdevice.h>
 #include <linux/etherdevice.h>
+#include <linux/ip.h>
+#include <linux/tcp.h>
 
 /* local includes */
 #include <lx_emul.h>
@@ -23,6 +25,9 @@
 
 static struct net_device *_dev;
 
+/* context of generic receive offload, received packets are not polled */
+static struct napi_struct _napi;
+
 
 static int driver_net_open(struct net_device *dev)
 {
@@ -35,10 +40,9 @@ static int driver_net_xmit(struct sk_buff *skb, struct net_device *dev)
 {
 	struct net_device_stats *stats = (struct net_device_stats*) netdev_priv(dev);
 	int len                        = skb->len;
-	void* addr                     = skb->data;
 
-	/* transmit to nic-session */
-	if (net_tx(addr, len)) {
+	/* transmit to nic-session, the data is gathered by 'net_tx_copy' */
+	if (net_tx(skb, len)) {
 		/* tx queue is  full, could not enqueue packet */
 		pr_debug("TX packet dropped\n");
 		return NETDEV_TX_BUSY;
@@ -56,6 +60,21 @@ static int driver_net_xmit(struct sk_buff *skb, struct net_device *dev)
 }
 
 
+/**
+ * Called by Nic_client to copy the data of an skb to a packet
+ */
+void net_tx_copy(void *skb, void *dst, unsigned long len)
+{
+	skb_copy_bits((struct sk_buff *)skb, 0, dst, len);
+}
+
+
+static int driver_napi_poll(struct napi_struct *napi, int budget)
+{
+	return 0;
+}
+
+
 static int driver_change_mtu(struct net_device *dev, int new_mtu)
 {
 	/* possible point to reflect successful MTU setting */
@@ -83,6 +102,16 @@ static int driver_init(void)
 
 	dev->netdev_ops = &driver_net_ops;
 
+	/*
+	 * The data of scattered skbs is gathered when copied to the packet,
+	 * which lets TCP build large segments that are split in software (GSO)
+	 * right before they are passed as MTU-sized packets to the NIC session.
+	 */
+	dev->hw_features |= NETIF_F_SG;
+	dev->features    |= NETIF_F_SG | NETIF_F_GSO | NETIF_F_GRO;
+
+	netif_napi_add(dev, &_napi, driver_napi_poll, NAPI_POLL_WEIGHT);
+
 	/* set MAC */
 	net_mac(dev->dev_addr, ETH_ALEN);
 
@@ -103,38 +132,116 @@ out:
 module_init(driver_init);
 
 
+/**
+ * Return length of the protocol headers of a received packet
+ *
+ * The payload of TCP segments is kept apart from the headers, which lets
+ * GRO merge segments by chaining their payload fragments.
+ */
+static unsigned long rx_header_len(void *addr, unsigned long size,
+                                   unsigned long max_len)
+{
+	struct ethhdr const *eth = addr;
+	struct iphdr  const *ip  = (struct iphdr const *)(eth + 1);
+	struct tcphdr const *tcp;
+	unsigned long len = sizeof(*eth) + sizeof(*ip);
+
+	if (size < len || eth->h_proto != htons(ETH_P_IP))
+		return min(size, max_len);
+
+	len = sizeof(*eth) + ip->ihl*4;
+	if (ip->protocol != IPPROTO_TCP || size < len + sizeof(*tcp))
+		return min(size, max_len);
+
+	tcp = (struct tcphdr const *)((char const *)ip + ip->ihl*4);
+	len += tcp->doff*4;
+
+	return min(size, min(len, max_len));
+}
+
+
 /**
  * Called by Nic_client when a packet was received
+ *
+ * If 'packet' is not NULL, only the protocol headers are copied to the skb.
+ * The payload is referenced as page fragment that points into the packet
+ * buffer of the NIC session. Once the last reference to the fragment is
+ * dropped, i.e., when the data was copied to the application, the packet
+ * is handed back via 'net_rx_packet_release'.
+ *
+ * \return 1 if the payload is referenced by the skb, 0 if the packet can be
+ *         acknowledged right away
  */
-void net_driver_rx(void *addr, unsigned long size)
+int net_driver_rx(void *addr, unsigned long size, void *packet)
 {
 	struct net_device_stats *stats;
+	struct sk_buff *skb;
+	unsigned long linear = size;
+	int referenced = 0;
 
 	if (!_dev)
-		return;
+		return 0;
 
 	stats = (struct net_device_stats*) netdev_priv(_dev);
 
-	/* allocate skb */
 	enum {
 		ADDITIONAL_HEADROOM = 4, /* smallest value found by trial & error */
+
+		/* covers the ethernet, IP, and TCP headers without options */
+		RX_COPYBREAK = 128,
 	};
-	struct sk_buff *skb = dev_alloc_skb(size + ADDITIONAL_HEADROOM);
+
+	if (packet && size > RX_COPYBREAK)
+		linear = rx_header_len(addr, size, RX_COPYBREAK);
+
+	/* allocate skb */
+	skb = dev_alloc_skb(linear + ADDITIONAL_HEADROOM);
 	if (!skb) {
 		printk(KERN_NOTICE "genode_net_rx: low on mem - packet dropped!\n");
 		stats->rx_dropped++;
-		return;
+		return 0;
 	}
 
-	/* copy packet */
-	memcpy(skb_put(skb, size), addr, size);
+	/* copy headers, or the whole packet if it is small */
+	memcpy(skb_put(skb, linear), addr, linear);
+
+	if (linear < size) {
+		struct page *page = kzalloc(sizeof(struct page), GFP_ATOMIC);
+		if (!page) {
+			printk(KERN_NOTICE "genode_net_rx: low on mem - packet dropped!\n");
+			kfree_skb(skb);
+			stats->rx_dropped++;
+			return 0;
+		}
+
+		page->addr      = addr;
+		page->rx_packet = packet;
+		atomic_set(&page->_count, 1);
+
+		skb_add_rx_frag(skb, 0, page, linear, size - linear, size - linear);
+		referenced = 1;
+	}
 
 	skb->dev       = _dev;
 	skb->protocol  = eth_type_trans(skb, _dev);
 	skb->ip_summed = CHECKSUM_NONE;
 
-	netif_receive_skb(skb);
+	napi_gro_receive(&_napi, skb);
 
 	stats->rx_packets++;
 	stats->rx_bytes += size;
+
+	return referenced;
+}
+
+
+/**
+ * Called by Nic_client after a batch of received packets
+ *
+ * Passes the segments merged by GRO to the protocol layers.
+ */
+void net_driver_rx_complete(void)
+{
+	if (_dev)
+		napi_gro_flush(&_napi, false);
 }
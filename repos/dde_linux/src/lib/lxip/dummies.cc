@@ -257,7 +257,6 @@ DUMMY(-1, get_net_ns_by_pid)
 DUMMY(-1, getnstimeofday)
 DUMMY(-1, get_nulls_value)
 DUMMY(-1, get_options)
-DUMMY(-1, get_page)
 DUMMY(-1, gfp_pfmemalloc_allowed)
 DUMMY(-1, gid_lte)
 DUMMY(-1, hash32_ptr)
@@ -632,7 +631,6 @@ DUMMY(0, tcp_fastopen_init_key_once)
 DUMMY(0, tcp_rack_advance)
 DUMMY(0, tcp_rack_mark_lost)
 DUMMY(0, tcp_try_fastopen)
-DUMMY(0, tcpv4_offload_init)
 DUMMY(0, this_cpu_ksoftirqd)
 DUMMY_SKIP(0, trace_fib_table_lookup)
 DUMMY_SKIP(0, trace_fib_table_lookup_nh)
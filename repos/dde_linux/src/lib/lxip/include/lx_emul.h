@@ -585,6 +585,7 @@ struct page
 	atomic_t _count;
 	void     *addr;
 	unsigned long private;
+	void     *rx_packet; /* NIC packet backing the page, see 'net_driver_rx' */
 } __attribute((packed));
 
 
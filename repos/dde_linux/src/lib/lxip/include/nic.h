@@ -19,8 +19,11 @@ extern "C" {
 #endif
 
 void net_mac(void* mac, unsigned long size);
-int  net_tx(void* addr, unsigned long len);
-void net_driver_rx(void *addr, unsigned long size);
+int  net_tx(void *skb, unsigned long len);
+void net_tx_copy(void *skb, void *dst, unsigned long len);
+int  net_driver_rx(void *addr, unsigned long size, void *packet);
+void net_driver_rx_complete(void);
+void net_rx_packet_release(void *packet);
 
 #ifdef __cplusplus
 }
@@ -480,6 +480,7 @@ void core_sock_init(void);
 void core_netlink_proto_init(void);
 void subsys_net_dev_init(void);
 void fs_inet_init(void);
+void fs_ipv4_offload_init(void);
 void module_driver_init(void);
 void module_cubictcp_register(void);
 void late_ip_auto_config(void);
@@ -501,6 +502,9 @@ void lxip_init()
 	subsys_net_dev_init();
 	fs_inet_init();
 
+	/* segmentation and receive offload of TCP */
+	fs_ipv4_offload_init();
+
 	/* enable local accepts */
 	IPV4_DEVCONF_ALL(&init_net, ACCEPT_LOCAL) = 0x1;
 
@@ -26,6 +26,7 @@
 /* local includes */
 #include <lx_emul.h>
 #include <lx.h>
+#include <nic.h>
 
 
 /* Lx_kit */
@@ -489,12 +490,26 @@ struct page *virt_to_head_page(const void *x)
 }
 
 
+void get_page(struct page *page)
+{
+	atomic_inc(&page->_count);
+}
+
+
 void put_page(struct page *page)
 {
 	if (!atomic_dec_and_test(&page->_count))
 		return;
 
 	lx_log(DEBUG_SLAB, "put_page: %p", page);
+
+	/* page refers to the content of a received packet, see 'driver.c' */
+	if (page->rx_packet) {
+		net_rx_packet_release(page->rx_packet);
+		kfree(page);
+		return;
+	}
+
 	Avl_page *p = tree.first()->find_by_address((Genode::addr_t)page->addr);
 
 	tree.remove(p);
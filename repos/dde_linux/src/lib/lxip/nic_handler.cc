@@ -15,6 +15,7 @@
 
 /* Genode includes */
 #include <base/log.h>
+#include <util/list.h>
 #include <nic/packet_allocator.h>
 #include <nic_session/connection.h>
 
@@ -32,8 +33,30 @@ class Nic_client
 		enum {
 			PACKET_SIZE = Nic::Packet_allocator::DEFAULT_PACKET_SIZE,
 			BUF_SIZE    = Nic::Session::QUEUE_SIZE * PACKET_SIZE,
+
+			/*
+			 * Maximum number of received packets referenced by the IP stack,
+			 * further packets are copied to keep the NIC server able to
+			 * deliver packets if the application does not read its data
+			 */
+			MAX_HELD_PACKETS = Nic::Session::QUEUE_SIZE / 2,
+		};
+
+		/**
+		 * Received packet whose payload is referenced by an skb
+		 *
+		 * The packet is acknowledged when the IP stack released the payload,
+		 * which happens once the data was copied to the application.
+		 */
+		struct Rx_packet : Genode::List<Rx_packet>::Element
+		{
+			Nic::Packet_descriptor packet { };
 		};
 
+		Rx_packet               _rx_packets[MAX_HELD_PACKETS];
+		Genode::List<Rx_packet> _free_rx_packets     { };
+		Genode::List<Rx_packet> _released_rx_packets { };
+
 		Nic::Packet_allocator _tx_block_alloc;
 		Nic::Connection       _nic;
 
@@ -58,6 +81,19 @@ class Nic_client
 			lxip_configure_dhcp();
 		}
 
+		void _ack_released_rx_packets()
+		{
+			while (Rx_packet *rx = _released_rx_packets.first()) {
+
+				if (!_nic.rx()->ready_to_ack())
+					return;
+
+				_released_rx_packets.remove(rx);
+				_nic.rx()->acknowledge_packet(rx->packet);
+				_free_rx_packets.insert(rx);
+			}
+		}
+
 		/**
 		 * submit queue not empty anymore
 		 */
@@ -65,6 +101,8 @@ class Nic_client
 		{
 			Lx::timer_update_jiffies();
 
+			_ack_released_rx_packets();
+
 			/* process a batch of only MAX_PACKETS in one run */
 			enum { MAX_PACKETS = 20 };
 
@@ -74,11 +112,24 @@ class Nic_client
 			       count++ < MAX_PACKETS)
 			{
 				Nic::Packet_descriptor p = _nic.rx()->get_packet();
-				net_driver_rx(_nic.rx()->packet_content(p), p.size());
+
+				Rx_packet *rx = _free_rx_packets.first();
+				if (rx) {
+					_free_rx_packets.remove(rx);
+					rx->packet = p;
+				}
+
+				if (net_driver_rx(_nic.rx()->packet_content(p), p.size(), rx))
+					continue;
+
+				if (rx)
+					_free_rx_packets.insert(rx);
 
 				_nic.rx()->acknowledge_packet(p);
 			}
 
+			net_driver_rx_complete();
+
 			/* schedule next batch if there are still packets available */
 			if (_nic.rx()->packet_avail())
 				Genode::Signal_transmitter(_sink_submit).submit();
@@ -129,6 +180,18 @@ class Nic_client
 			_nic.tx_channel()->sigh_ack_avail(_source_ack);
 			_nic.link_state_sigh(_link_state_change);
 			/* ready_to_submit not handled */
+
+			for (unsigned i = 0; i < MAX_HELD_PACKETS; i++)
+				_free_rx_packets.insert(&_rx_packets[i]);
+		}
+
+		/**
+		 * Acknowledge packet as the IP stack released its payload
+		 */
+		void release(void *packet)
+		{
+			_released_rx_packets.insert((Rx_packet *)packet);
+			_ack_released_rx_packets();
 		}
 
 		Nic::Connection *nic() { return &_nic; }
@@ -173,16 +236,25 @@ void net_mac(void* mac, unsigned long size)
 }
 
 
+/**
+ * Call by back-end driver when the payload of a received packet is released
+ */
+void net_rx_packet_release(void *packet)
+{
+	_nic_client->release(packet);
+}
+
+
 /**
  * Call by back-end driver when a packet should be sent
  */
-int net_tx(void* addr, unsigned long len)
+int net_tx(void *skb, unsigned long len)
 {
 	try {
 		Nic::Packet_descriptor packet = _nic_client->nic()->tx()->alloc_packet(len);
 		void* content                 = _nic_client->nic()->tx()->packet_content(packet);
 
-		Genode::memcpy((char *)content, addr, len);
+		net_tx_copy(skb, content, len);
 		_nic_client->nic()->tx()->submit_packet(packet);
 
 		return 0;
@@ -21,7 +21,7 @@
 #include <util/reconstructible.h>
 
 /* Linux kit includes */
-#include <lx_kit/internal/list.h>
+#include <lx_kit/internal/timer_wheel.h>
 
 /* local includes */
 #include <lx_emul.h>
@@ -48,17 +48,14 @@ class Lx::Timer
 		/**
 		 * Context encapsulates a regular linux timer_list
 		 */
-		struct Context : public Lx_kit::List<Context>::Element
+		struct Context : public Lx_kit::Timer_wheel::Entry
 		{
-			enum { INVALID_TIMEOUT = ~0UL };
 			enum Type { LIST };
 
-			Type               type;
-			void              *timer;
-			bool               pending { false };
-			unsigned long      timeout { INVALID_TIMEOUT }; /* absolute in jiffies */
+			Type   type;
+			void  *timer;
 
-			Context(struct timer_list *timer) : type(LIST), timer(timer) { }
+			Context(struct timer_list *timer) : Entry(timer), type(LIST), timer(timer) { }
 
 			void expires(unsigned long e)
 			{
@@ -84,12 +81,19 @@ class Lx::Timer
 	private:
 
 		::Timer::Connection                          _timer_conn;
-		Lx_kit::List<Context>                        _list;
+		Lx_kit::Timer_wheel                          _wheel;
 		Genode::Io_signal_handler<Lx::Timer>         _handler;
 		Genode::Tslab<Context, 32 * sizeof(Context)> _timer_alloc;
 
 		void (*_tick)();
 
+		/* context whose function is currently executed */
+		Context *_running = nullptr;
+
+		/* jiffy the timer session is programmed for */
+		bool          _armed      = false;
+		unsigned long _programmed = 0;
+
 	public:
 
 		bool                                          ready  { true };
@@ -99,57 +103,38 @@ class Lx::Timer
 		/**
 		 * Lookup local timer
 		 */
-		Context *_find_context(void const *timer)
-		{
-			for (Context *c = _list.first(); c; c = c->next())
-				if (c->timer == timer)
-					return c;
-
-			return 0;
-		}
+		Context *_find_context(void const *timer) {
+			return static_cast<Context *>(_wheel.lookup(timer)); }
 
 		/**
-		 * Program the first timer in the list
+		 * Program the timer session unless it triggers earlier anyway
+		 *
+		 * TCP reschedules its retransmission and delayed-ACK timers with
+		 * almost every segment. Most of the changes postpone a timer, which
+		 * merely causes a spurious trigger instead of an RPC per change.
 		 */
-		void _program_first_timer()
+		void _program(unsigned long jiffy)
 		{
-			Context *ctx = _list.first();
-			if (!ctx)
+			if (_armed && (long)(jiffy - _programmed) >= 0)
 				return;
 
+			_armed      = true;
+			_programmed = jiffy;
+
 			/* calculate relative microseconds for trigger */
-			unsigned long us = ctx->timeout > jiffies ?
-			                   jiffies_to_msecs(ctx->timeout - jiffies) * 1000 : 0;
+			unsigned long us = jiffy > jiffies ?
+			                   jiffies_to_msecs(jiffy - jiffies) * 1000 : 0;
 			_timer_conn.trigger_once(us);
 		}
 
 		/**
-		 * Schedule timer
-		 *
-		 * Add the context to the scheduling list depending on its timeout
-		 * and reprogram the first timer.
+		 * Program the next event of the timer wheel
 		 */
-		void _schedule_timer(Context *ctx, unsigned long expires)
+		void _program_next_event()
 		{
-			_list.remove(ctx);
-
-			ctx->timeout    = expires;
-			ctx->pending    = true;
-
-			/*
-			 * Also write the timeout value to the expires field in
-			 * struct timer_list because some code the checks
-			 * it directly.
-			 */
-			ctx->expires(expires);
-
-			Context *c;
-			for (c = _list.first(); c; c = c->next())
-				if (ctx->timeout <= c->timeout)
-					break;
-			_list.insert_before(ctx, c);
-
-			_program_first_timer();
+			unsigned long jiffy = 0;
+			if (_wheel.next_event(jiffy))
+				_program(jiffy);
 		}
 
 		/**
@@ -159,16 +144,23 @@ class Lx::Timer
 		{
 			update_jiffies();
 
-			while (Lx::Timer::Context *ctx = _list.first()) {
-				if (ctx->timeout > jiffies)
-					break;
+			_armed = false;
 
-				ctx->pending = false;
-				ctx->function();
+			_wheel.expire(jiffies, [&] (Lx_kit::Timer_wheel::Entry &e) {
 
-				if (!ctx->pending)
-					del(ctx->timer);
-			}
+				Context &ctx = static_cast<Context &>(e);
+
+				_running = &ctx;
+				ctx.function();
+				_running = nullptr;
+
+				if (!ctx.pending()) {
+					_wheel.remove(ctx);
+					destroy(&_timer_alloc, &ctx);
+				}
+			});
+
+			_program_next_event();
 
 			/* tick the higher layer of the component */
 			_tick();
@@ -198,7 +190,7 @@ class Lx::Timer
 		void add(TIMER *timer)
 		{
 			Context *t = new (&_timer_alloc) Context(timer);
-			_list.append(t);
+			_wheel.insert(*t);
 		}
 
 		/**
@@ -215,9 +207,15 @@ class Lx::Timer
 			if (!ctx)
 				return 0;
 
-			int rv = ctx->pending ? 1 : 0;
+			int rv = ctx->pending() ? 1 : 0;
+
+			/* a running timer is cleaned up after its function returned */
+			if (ctx == _running) {
+				_wheel.deactivate(*ctx);
+				return rv;
+			}
 
-			_list.remove(ctx);
+			_wheel.remove(*ctx);
 			destroy(&_timer_alloc, ctx);
 
 			return rv;
@@ -238,17 +236,29 @@ class Lx::Timer
 			 * If timer was already active return 1, otherwise 0. The return
 			 * value is needed by mod_timer().
 			 */
-			int rv = ctx->pending ? 1 : 0;
+			int rv = ctx->pending() ? 1 : 0;
+
+			_wheel.schedule(*ctx, expires, jiffies);
+
+			/*
+			 * Also write the timeout value to the expires field in
+			 * struct timer_list because some code the checks
+			 * it directly.
+			 */
+			ctx->expires(expires);
 
-			_schedule_timer(ctx, expires);
+			_program(expires);
 
 			return rv;
 		}
 
 		/**
 		 * Schedule next linux timer
+		 *
+		 * The timer session is programmed whenever a timer gets scheduled,
+		 * so deleting a timer never requires reprogramming.
 		 */
-		void schedule_next() { _program_first_timer(); }
+		void schedule_next() { if (!_armed) _program_next_event(); }
 
 		/**
 		 * Check if the timer is currently pending
@@ -260,7 +270,7 @@ class Lx::Timer
 				return false;
 			}
 
-			return ctx->pending;
+			return ctx->pending();
 		}
 
 		Context *find(struct timer_list const *timer) {
@@ -273,11 +283,6 @@ class Lx::Timer
 		{
 			jiffies = msecs_to_jiffies(_timer_conn.elapsed_ms());
 		}
-
-		/**
-		 * Get first timer context
-		 */
-		Context* first() { return _list.first(); }
 };
 
 
@@ -49,6 +49,7 @@ struct Services
 
 	/* report generation */
 	bool raw_report_device_list = false;
+	bool raw_report_latency     = false;
 
 	Services(Genode::Env &env) : env(env)
 	{
@@ -96,6 +97,7 @@ struct Services
 			try {
 				Genode::Xml_node node_report = node_raw.sub_node("report");
 				raw_report_device_list = node_report.attribute_value("devices", false);
+				raw_report_latency     = node_report.attribute_value("latency", false);
 			} catch (...) { }
 		} catch (Xml_node::Nonexistent_sub_node) {
 			log("No <raw> config node found - not starting external USB service");
@@ -55,7 +55,7 @@ namespace Nic
 
 namespace Raw
 {
-	void init(Genode::Env &env, bool report_device_list);
+	void init(Genode::Env &env, bool report_device_list, bool report_latency);
 }
 
 
@@ -124,7 +124,8 @@ void start_usb_driver(Genode::Env &env)
 	Nic::init(env);
 
 	if (services.raw)
-		Raw::init(env, services.raw_report_device_list);
+		Raw::init(env, services.raw_report_device_list,
+		          services.raw_report_latency);
 
 	Lx::Scheduler &sched = Lx::scheduler(&env);
 	Lx::Timer &timer = Lx::timer(&env, &env.ep(), &Lx_kit::env().heap(), &jiffies);
@@ -15,6 +15,7 @@
 #include <os/reporter.h>
 #include <os/session_policy.h>
 #include <root/component.h>
+#include <timer_session/connection.h>
 #include <usb_session/rpc_object.h>
 #include <util/list.h>
 
@@ -34,6 +35,19 @@ extern "C" int usb_set_configuration(struct usb_device *dev, int configuration);
 
 constexpr bool verbose_raw = false;
 
+/* number of completed URBs between two updates of the latency report */
+enum { LATENCY_REPORT_INTERVAL = 1000 };
+
+/**
+ * Return current time in microseconds, used to measure the URB latency
+ */
+static unsigned long time_us();
+
+/**
+ * Update the latency report of all sessions
+ */
+static void report_latency();
+
 
 namespace Usb {
 	class  Session_component;
@@ -127,10 +141,54 @@ class Usb::Worker : public Genode::Weak_object<Usb::Worker>
 		unsigned                  _p_in_flight = 0;
 		bool                      _device_ready = false;
 
+		/*
+		 * Acknowledgements are collected and handed to the client in
+		 * batches, i.e., all URBs completed during one interrupt are
+		 * signalled to the client at once.
+		 */
+		Packet_descriptor _acks[Session::TX_QUEUE_SIZE];
+		unsigned          _ack_count = 0;
+
 		void _ack_packet(Packet_descriptor &p)
 		{
-			_sink->acknowledge_packet(p);
-			_p_in_flight--;
+			_acks[_ack_count++] = p;
+		}
+
+		void _flush_acks()
+		{
+			unsigned done = 0;
+			while (done < _ack_count)
+				done += _sink->acknowledge_packets(_acks + done, _ack_count - done);
+
+			_p_in_flight -= _ack_count;
+			_ack_count    = 0;
+		}
+
+	public:
+
+		struct Latency
+		{
+			unsigned long urbs   = 0;
+			unsigned long sum_us = 0;
+			unsigned long max_us = 0;
+		};
+
+	private:
+
+		Latency _latency;
+
+		void _account_latency(Packet_descriptor &p, unsigned long submitted)
+		{
+			unsigned long const latency = time_us() - submitted;
+
+			p.transfer.latency_us = latency;
+
+			_latency.urbs++;
+			_latency.sum_us += latency;
+			_latency.max_us  = max(_latency.max_us, latency);
+
+			if (_latency.urbs % LATENCY_REPORT_INTERVAL == 0)
+				report_latency();
 		}
 
 		/**
@@ -207,9 +265,10 @@ class Usb::Worker : public Genode::Weak_object<Usb::Worker>
 		{
 			Weak_ptr<Worker>   worker;
 			Packet_descriptor  packet;
+			unsigned long      submitted;
 
 			Complete_data(Weak_ptr<Worker> &w, Packet_descriptor &p)
-			: worker(w), packet(p) { }
+			: worker(w), packet(p), submitted(time_us()) { }
 		};
 
 		Complete_data * alloc_complete_data(Packet_descriptor &p)
@@ -232,7 +291,9 @@ class Usb::Worker : public Genode::Weak_object<Usb::Worker>
 				p.transfer.actual_size = urb->actual_length;
 				p.succeded             = true;
 
-				if (read)
+				if (p.type == Packet_descriptor::ISOC)
+					_isoc_finish(p, urb, read);
+				else if (read)
 					Genode::memcpy(_sink->packet_content(p), urb->transfer_buffer, 
 					               urb->actual_length);
 			}
@@ -251,9 +312,14 @@ class Usb::Worker : public Genode::Weak_object<Usb::Worker>
 			{
 				Locked_ptr<Worker> worker(data->worker);
 
-				if (worker.valid())
+				if (worker.valid()) {
+					worker->_account_latency(data->packet, data->submitted);
 					worker->_async_finish(data->packet, urb,
 					                      !!(data->packet.transfer.ep & USB_DIR_IN));
+
+					/* let the worker hand the acknowledgements to the client */
+					worker->packet_avail();
+				}
 			}
 
 			free_complete_data(data);
@@ -328,16 +394,7 @@ class Usb::Worker : public Genode::Weak_object<Usb::Worker>
 
 			Complete_data *data = alloc_complete_data(p);
 
-			int polling_interval;
-
-			if (p.transfer.polling_interval == Usb::Packet_descriptor::DEFAULT_POLLING_INTERVAL) {
-
-				usb_host_endpoint *ep = read ? _device->udev->ep_in[p.transfer.ep & 0x0f]
-				                             : _device->udev->ep_out[p.transfer.ep & 0x0f];
-				polling_interval = ep->desc.bInterval;
-
-			} else
-				polling_interval = p.transfer.polling_interval;
+			int const polling_interval = _polling_interval(p, read);
 
 			usb_fill_int_urb(irq_urb, _device->udev, pipe, buf, p.size(),
 			                 _async_complete, data, polling_interval);
@@ -356,6 +413,112 @@ class Usb::Worker : public Genode::Weak_object<Usb::Worker>
 			return true;
 		}
 
+		/**
+		 * Return polling interval of interrupt or isochronous endpoint
+		 */
+		int _polling_interval(Packet_descriptor &p, bool read)
+		{
+			if (p.transfer.polling_interval != Usb::Packet_descriptor::DEFAULT_POLLING_INTERVAL)
+				return p.transfer.polling_interval;
+
+			usb_host_endpoint *ep = read ? _device->udev->ep_in[p.transfer.ep & 0x0f]
+			                             : _device->udev->ep_out[p.transfer.ep & 0x0f];
+
+			/* the interval of isochronous endpoints is encoded as exponent */
+			if (p.type == Packet_descriptor::ISOC)
+				return 1 << (min(16, max(1, (int)ep->desc.bInterval)) - 1);
+
+			return ep->desc.bInterval;
+		}
+
+		/**
+		 * Isochronous transfer
+		 *
+		 * All frames of the packet are transferred by one URB.
+		 */
+		bool _isoc(Packet_descriptor &p, bool read)
+		{
+			Isoc_transfer &isoc = *(Isoc_transfer *)_sink->packet_content(p);
+
+			unsigned       const frames = isoc.number_of_packets;
+			Genode::size_t const size = isoc.frame_offset(frames);
+
+			if (!frames || frames > Isoc_transfer::MAX_PACKETS
+			 || Isoc_transfer::size(size) > p.size()) {
+				error("Invalid isochronous transfer of ", frames, " frames");
+				p.error = Usb::Packet_descriptor::SUBMIT_ERROR;
+				return false;
+			}
+
+			void *buf = dma_malloc(size);
+
+			unsigned pipe;
+			if (read)
+				pipe = usb_rcvisocpipe(_device->udev, p.transfer.ep);
+			else {
+				pipe = usb_sndisocpipe(_device->udev, p.transfer.ep);
+				Genode::memcpy(buf, isoc.data(), size);
+			}
+
+			urb *isoc_urb = usb_alloc_urb(frames, GFP_KERNEL);
+			if (!isoc_urb) {
+				error("Failed to allocate isochronous URB");
+				dma_free(buf);
+				p.error = Usb::Packet_descriptor::SUBMIT_ERROR;
+				return false;
+			}
+
+			Complete_data *data = alloc_complete_data(p);
+
+			isoc_urb->dev                    = _device->udev;
+			isoc_urb->pipe                   = pipe;
+			isoc_urb->transfer_flags         = URB_ISO_ASAP;
+			isoc_urb->transfer_buffer        = buf;
+			isoc_urb->transfer_buffer_length = size;
+			isoc_urb->number_of_packets      = frames;
+			isoc_urb->interval               = _polling_interval(p, read);
+			isoc_urb->complete               = _async_complete;
+			isoc_urb->context                = data;
+
+			for (unsigned i = 0, offset = 0; i < frames; i++) {
+				isoc_urb->iso_frame_desc[i].offset = offset;
+				isoc_urb->iso_frame_desc[i].length = isoc.packet_size[i];
+				offset += isoc.packet_size[i];
+			}
+
+			int ret = usb_submit_urb(isoc_urb, GFP_KERNEL);
+			if (ret != 0) {
+				error("Failed to submit URB, error: ", ret);
+				p.error = Usb::Packet_descriptor::SUBMIT_ERROR;
+
+				free_complete_data(data);
+				usb_free_urb(isoc_urb);
+				dma_free(buf);
+				return false;
+			}
+
+			return true;
+		}
+
+		/**
+		 * Copy per-frame results of completed isochronous URB to the packet
+		 */
+		void _isoc_finish(Packet_descriptor &p, urb *urb, bool read)
+		{
+			Isoc_transfer &isoc = *(Isoc_transfer *)_sink->packet_content(p);
+
+			for (int i = 0; i < urb->number_of_packets; i++) {
+				usb_iso_packet_descriptor &frame = urb->iso_frame_desc[i];
+
+				isoc.actual_packet_size[i] = frame.status ? 0 : frame.actual_length;
+
+				if (read && !frame.status)
+					Genode::memcpy(isoc.data() + frame.offset,
+					               (char *)urb->transfer_buffer + frame.offset,
+					               frame.actual_length);
+			}
+		}
+
 		/**
 		 * Change alternate settings for device
 		 */
@@ -450,6 +613,11 @@ class Usb::Worker : public Genode::Weak_object<Usb::Worker>
 							continue;
 						break;
 
+					case Packet_descriptor::ISOC:
+						if (_isoc(p, !!(p.transfer.ep & USB_DIR_IN)))
+							continue;
+						break;
+
 					case Packet_descriptor::ALT_SETTING:
 						_alt_setting(p);
 						break;
@@ -490,7 +658,9 @@ class Usb::Worker : public Genode::Weak_object<Usb::Worker>
 
 			while (true) {
 				wait_for_completion(&_packet_avail);
+				_flush_acks();
 				_dispatch();
+				_flush_acks();
 			}
 		}
 
@@ -525,6 +695,8 @@ class Usb::Worker : public Genode::Weak_object<Usb::Worker>
 
 		void stop()
 		{
+			_flush_acks();
+
 			if (_task) {
 				Lx::scheduler().remove(_task);
 				destroy(Lx::Malloc::mem(), _task);
@@ -541,6 +713,8 @@ class Usb::Worker : public Genode::Weak_object<Usb::Worker>
 		}
 
 		bool device_ready() { return _device_ready; }
+
+		Latency latency() const { return _latency; }
 };
 
 
@@ -599,6 +773,7 @@ class Usb::Session_component : public Session_rpc_object,
 	private:
 
 		Genode::Entrypoint                &_ep;
+		Session_label const                _label;
 		unsigned long                      _vendor;
 		unsigned long                      _product;
 		long                               _bus = 0;
@@ -634,10 +809,11 @@ class Usb::Session_component : public Session_rpc_object,
 		Session_component(Genode::Ram_dataspace_capability tx_ds,
 		                  Genode::Entrypoint &ep,
 		                  Genode::Region_map &rm,
+		                  Session_label const &label,
 		                  unsigned long vendor, unsigned long product,
 		                  long bus, long dev, Usb::Cleaner &cleaner)
 		: Session_rpc_object(tx_ds, ep.rpc_ep(), rm),
-		  _ep(ep), _vendor(vendor), _product(product), _bus(bus), _dev(dev),
+		  _ep(ep), _label(label), _vendor(vendor), _product(product), _bus(bus), _dev(dev),
 		  _packet_avail(ep, *this, &Session_component::_receive),
 		  _ready_ack(ep, *this, &Session_component::_receive),
 		  _worker(sink()), _tx_ds(tx_ds), _cleaner(cleaner)
@@ -811,6 +987,10 @@ class Usb::Session_component : public Session_rpc_object,
 		}
 
 		Ram_dataspace_capability tx_ds() { return _tx_ds; }
+
+		Session_label const &label() const { return _label; }
+
+		Worker::Latency latency() const { return _worker.latency(); }
 };
 
 
@@ -845,6 +1025,10 @@ class Usb::Root : public Genode::Root_component<Session_component>
 		Genode::Reporter _device_list_reporter {
 			_env, "devices", "devices", 512*1024 };
 
+		Genode::Reporter _latency_reporter { _env, "latency" };
+
+		::Timer::Connection _timer { _env };
+
 		Usb::Cleaner     _cleaner;
 
 		void _handle_config()
@@ -905,7 +1089,8 @@ class Usb::Root : public Genode::Root_component<Session_component>
 
 				Ram_dataspace_capability tx_ds = _env.ram().alloc(tx_buf_size);
 				Session_component *session = new (md_alloc())
-					Session_component(tx_ds, _env.ep(), _env.rm(), vendor, product, bus, dev, _cleaner);
+					Session_component(tx_ds, _env.ep(), _env.rm(), label, vendor,
+					                  product, bus, dev, _cleaner);
 				::Session::list()->insert(session);
 				return session;
 			}
@@ -930,31 +1115,65 @@ class Usb::Root : public Genode::Root_component<Session_component>
 
 		Root(Genode::Env &env,
 		     Genode::Allocator &md_alloc,
-		     bool report_device_list)
+		     bool report_device_list, bool report_latency)
 		: Genode::Root_component<Session_component>(env.ep(), md_alloc),
 			_env(env)
 		{
 			Lx_kit::env().config_rom().sigh(_config_handler);
 			_device_list_reporter.enabled(report_device_list);
+			_latency_reporter.enabled(report_latency);
 		}
 
 		Genode::Reporter &device_list_reporter()
 		{
 			return _device_list_reporter;
 		}
+
+		Genode::Reporter &latency_reporter()
+		{
+			return _latency_reporter;
+		}
+
+		unsigned long time_us() {
+			return _timer.curr_time().trunc_to_plain_us().value; }
 };
 
 
 static Genode::Constructible<Usb::Root> root;
 
 
-void Raw::init(Genode::Env &env, bool report_device_list)
+void Raw::init(Genode::Env &env, bool report_device_list, bool report_latency)
 {
-	root.construct(env, Lx::Malloc::mem(), report_device_list);
+	root.construct(env, Lx::Malloc::mem(), report_device_list, report_latency);
 	env.parent().announce(env.ep().manage(*root));
 }
 
 
+static unsigned long time_us() { return root->time_us(); }
+
+
+static void report_latency()
+{
+	if (!root->latency_reporter().enabled())
+		return;
+
+	Genode::Reporter::Xml_generator xml(root->latency_reporter(), [&] ()
+	{
+		for (Usb::Session_component *s = ::Session::list()->first(); s; s = s->next()) {
+			xml.node("session", [&] ()
+			{
+				Usb::Worker::Latency const latency = s->latency();
+
+				xml.attribute("label",  s->label().string());
+				xml.attribute("urbs",   latency.urbs);
+				xml.attribute("avg_us", latency.urbs ? latency.sum_us / latency.urbs : 0);
+				xml.attribute("max_us", latency.max_us);
+			});
+		}
+	});
+}
+
+
 void Device::report_device_list()
 {
 	if (!root->device_list_reporter().enabled())
@@ -92,6 +92,19 @@ unsigned get_addr(char const *p)
 	return (to[0]<<0)|(to[1]<<8)|(to[2]<<16)|(to[3]<<24);
 }
 
+
+/**
+ * Print address in the format "a.b.c.d:port\n"
+ */
+int print_addr(char *dst, Genode::size_t len, Linux::sockaddr_in const &addr)
+{
+	unsigned char const *a = (unsigned char const *)&addr.sin_addr.s_addr;
+	unsigned char const *p = (unsigned char const *)&addr.sin_port;
+	return Genode::snprintf(dst, len,
+	                        "%d.%d.%d.%d:%u\n",
+	                        a[0], a[1], a[2], a[3], (p[0]<<8)|(p[1]<<0));
+}
+
 }
 
 
@@ -614,12 +627,7 @@ class Vfs::Lxip_local_file : public Vfs::Lxip_file
 			int const res = _sock.ops->getname(&_sock, (sockaddr *)addr, &out_len, 0);
 			if (res < 0) return -1;
 
-			in_addr const i_addr   = addr->sin_addr;
-			unsigned char const *a = (unsigned char *)&i_addr.s_addr;
-			unsigned char const *p = (unsigned char *)&addr->sin_port;
-			return Genode::snprintf(dst, len,
-			                        "%d.%d.%d.%d:%u\n",
-			                        a[0], a[1], a[2], a[3], (p[0]<<8)|(p[1]<<0));
+			return print_addr(dst, len, *addr);
 		}
 };
 
@@ -694,12 +702,7 @@ class Vfs::Lxip_remote_file : public Vfs::Lxip_file
 				break;
 			}
 
-			in_addr const i_addr   = addr->sin_addr;
-			unsigned char const *a = (unsigned char *)&i_addr.s_addr;
-			unsigned char const *p = (unsigned char *)&addr->sin_port;
-			return Genode::snprintf(dst, len,
-			                        "%d.%d.%d.%d:%u\n",
-			                        a[0], a[1], a[2], a[3], (p[0]<<8)|(p[1]<<0));
+			return print_addr(dst, len, *addr);
 		}
 
 		Lxip::ssize_t write(char const *src, Genode::size_t len,
@@ -778,9 +781,27 @@ class Vfs::Lxip_accept_file : public Vfs::Lxip_file
 			new_sock->type = _sock.type;
 			new_sock->ops  = _sock.ops;
 
+			/*
+			 * Report the remote address along with the new socket, which
+			 * spares the client the round trips to the "remote" file.
+			 */
+			sockaddr_storage addr_storage;
+			sockaddr_in *addr = (sockaddr_in *)&addr_storage;
+
+			int out_len = sizeof(addr_storage);
+			bool const has_addr =
+				new_sock->ops->getname(new_sock, (sockaddr *)addr, &out_len, 1) >= 0;
+
 			try {
 				unsigned const id = _parent.accept(*new_sock);
-				return Genode::snprintf(dst, len, "%s/%u\n", _parent.top_dir(), id);
+
+				int const n = Genode::snprintf(dst, len, "%s/%u%s",
+				                               _parent.top_dir(), id,
+				                               has_addr ? " " : "\n");
+				if (!has_addr || n >= (int)len)
+					return n;
+
+				return n + print_addr(dst + n, len - n, *addr);
 			} catch (...) {
 				Genode::error("lxip: could not adopt new client socket");
 			}
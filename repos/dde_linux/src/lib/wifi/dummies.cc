@@ -567,7 +567,6 @@ DUMMY(0, flow_keys_dissector)
 DUMMY(0, get_net_ns_by_id)
 DUMMY(0, gfpflags_allow_blocking)
 DUMMY(0, init_dummy_netdev)
-DUMMY(0, napi_gro_flush)
 DUMMY(0, netdev_start_xmit)
 DUMMY_RET(0, netdev_uses_dsa)
 DUMMY_RET(0, page_is_pfmemalloc)
@@ -586,8 +585,6 @@ DUMMY(0, sock_diag_has_destroy_listeners)
 DUMMY(0, switchdev_port_attr_get)
 
 DUMMY_RET(0, netif_dormant)
-DUMMY(0, netif_napi_add)
-DUMMY(0, netif_napi_del)
 DUMMY_STOP(0, netif_rx)
 DUMMY(0, netif_skb_features)
 DUMMY(0, netif_supports_nofcs)
@@ -2805,10 +2805,16 @@ int __hw_addr_sync(struct netdev_hw_addr_list *to_list, struct netdev_hw_addr_li
 void __hw_addr_unsync(struct netdev_hw_addr_list *to_list, struct netdev_hw_addr_list *from_list, int addr_len);
 void __hw_addr_init(struct netdev_hw_addr_list *list);
 
+enum { NAPI_POLL_WEIGHT = 64 };
+
+enum { NAPI_STATE_SCHED = 0 };
+
 struct napi_struct
 {
 	int (*poll)(struct napi_struct *, int);
 	struct net_device *dev;
+	int           weight;
+	unsigned long state;
 };
 
 enum { MAX_PHYS_ITEM_ID_LEN = 32 };
@@ -2839,6 +2845,8 @@ struct packet_offload
 void netif_napi_add(struct net_device *dev, struct napi_struct *napi,
                     int (*poll)(struct napi_struct *, int), int weight);
 void netif_napi_del(struct napi_struct *napi);
+void napi_schedule(struct napi_struct *napi);
+void napi_complete(struct napi_struct *napi);
 
 typedef int gro_result_t;
 
@@ -20,8 +20,14 @@
 #include <nic/xml_node.h>
 #include <nic/component.h>
 #include <root/component.h>
+#include <timer_session/connection.h>
 #include <util/xml_node.h>
 
+/* Linux emulation environment includes */
+#include <lx_kit/env.h>
+#include <lx_kit/malloc.h>
+#include <lx_kit/scheduler.h>
+
 /* local includes */
 #include <lx.h>
 #include <lx_emul.h>
@@ -35,9 +41,13 @@
 
 enum {
 	HEAD_ROOM = 128, /* XXX guessed value but works */
+	RX_BUDGET = NAPI_POLL_WEIGHT,
 };
 
 
+static void schedule_rx_poll();
+
+
 /**
  * Nic::Session implementation
  */
@@ -71,6 +81,13 @@ class Wifi_session_component : public Nic::Session_component
 		Lx::Task _tx_task { _run_tx_task, &_tx_data, "tx_task",
 		                    Lx::Task::PRIORITY_1, Lx::scheduler() };
 
+		/*
+		 * Received frames are copied to the packet stream right away but
+		 * submitted in batches, which spares the client a signal per frame.
+		 */
+		Nic::Packet_descriptor _rx_batch[RX_BUDGET];
+		unsigned               _rx_batch_count = 0;
+
 	protected:
 
 		bool _send()
@@ -155,11 +172,39 @@ class Wifi_session_component : public Nic::Session_component
 			_link_state_changed();
 		}
 
+		struct Rx_stats
+		{
+			unsigned long frames  = 0;
+			unsigned long batches = 0;
+		} rx_stats;
+
+		/**
+		 * Submit batch of received frames to the client
+		 */
+		void flush_rx()
+		{
+			if (!_rx_batch_count)
+				return;
+
+			unsigned const submitted =
+				_rx.source()->submit_packets(_rx_batch, _rx_batch_count);
+
+			/* 'receive' reserves the queue slots, so this is just a precaution */
+			for (unsigned i = submitted; i < _rx_batch_count; i++)
+				_rx.source()->release_packet(_rx_batch[i]);
+
+			_rx_batch_count = 0;
+			rx_stats.batches++;
+		}
+
 		void receive(struct sk_buff *skb)
 		{
 			_handle_rx();
 
-			if (!_rx.source()->ready_to_submit()) {
+			if (_rx_batch_count == RX_BUDGET)
+				flush_rx();
+
+			if (_rx.source()->submit_slots_free() <= _rx_batch_count) {
 				Genode::warning("not ready to receive packet");
 				return;
 			}
@@ -174,7 +219,12 @@ class Wifi_session_component : public Nic::Session_component
 				if (s.frag_size)
 					memcpy((char *)buffer + s.packet_size, s.frag, s.frag_size);
 
-				_rx.source()->submit_packet(p);
+				/* the frame gets submitted by the receive poll task */
+				if (!_rx_batch_count)
+					schedule_rx_poll();
+
+				_rx_batch[_rx_batch_count++] = p;
+				rx_stats.frames++;
 			} catch (...) {
 				Genode::warning("failed to process received packet");
 			}
@@ -241,6 +291,8 @@ class Root : public Genode::Root_component<Wifi_session_component,
 
 		void _destroy_session(Wifi_session_component *session)
 		{
+			session->flush_rx();
+
 			/* stop rx */
 			Root::instance->session = nullptr;
 			Genode::Root_component<Wifi_session_component, Genode::Single_client>::_destroy_session(session);
@@ -268,6 +320,135 @@ static Genode::Env       *_env;
 static Genode::Allocator *_alloc;
 
 
+/**
+ * NAPI-style polling of received frames
+ *
+ * Frames delivered by the mac80211 stack are collected by the session and
+ * handed to the client once the poll task runs. The task has the lowest
+ * priority, i.e., it runs after the tasks delivering frames became idle or
+ * when the session reached its budget of frames. NAPI instances scheduled
+ * by the driver are polled by the task with their weight as budget.
+ */
+class Rx_poll
+{
+	private:
+
+		enum { MAX_NAPI = 4 };
+
+		napi_struct *_napi[MAX_NAPI] { };
+
+		Lx::Task _task { _run, this, "rx_poll", Lx::Task::PRIORITY_0,
+		                 Lx::scheduler() };
+
+		bool _poll()
+		{
+			bool budget_exhausted = false;
+
+			for (napi_struct *napi : _napi) {
+				if (!napi || !(napi->state & (1UL << NAPI_STATE_SCHED)))
+					continue;
+
+				int const budget = napi->weight ? napi->weight : NAPI_POLL_WEIGHT;
+				if (napi->poll(napi, budget) >= budget)
+					budget_exhausted = true;
+			}
+
+			if (Root::instance->session)
+				Root::instance->session->flush_rx();
+
+			return budget_exhausted;
+		}
+
+		static void _run(void *arg)
+		{
+			Rx_poll &poll = *static_cast<Rx_poll *>(arg);
+
+			while (true) {
+				Lx::scheduler().current()->block_and_schedule();
+
+				/* let other tasks run before polling again */
+				while (poll._poll())
+					Lx::scheduler().current()->schedule();
+			}
+		}
+
+	public:
+
+		void add(napi_struct *napi)
+		{
+			for (napi_struct *&n : _napi)
+				if (!n) { n = napi; return; }
+
+			Genode::error("too many NAPI instances");
+		}
+
+		void remove(napi_struct *napi)
+		{
+			for (napi_struct *&n : _napi)
+				if (n == napi) n = nullptr;
+		}
+
+		void schedule() { _task.unblock(); }
+};
+
+
+static Rx_poll &rx_poll()
+{
+	static Rx_poll inst;
+	return inst;
+}
+
+
+static void schedule_rx_poll() { rx_poll().schedule(); }
+
+
+/**
+ * Periodic log of the receive and task-switch rates
+ */
+struct Rx_stats_logger
+{
+	::Timer::Connection timer;
+	unsigned long       last_frames   = 0;
+	unsigned long       last_batches  = 0;
+	unsigned long       last_switches = 0;
+	unsigned            seconds       = 0;
+
+	Genode::Signal_handler<Rx_stats_logger> handler;
+
+	void handle_timeout()
+	{
+		unsigned long frames = 0, batches = 0;
+		if (Wifi_session_component *session = Root::instance->session) {
+			frames  = session->rx_stats.frames;
+			batches = session->rx_stats.batches;
+		}
+		unsigned long const switches = Lx::scheduler().task_switches();
+
+		Genode::log("rx frames/s: ",      frames   - last_frames,
+		            " rx batches/s: ",    batches  - last_batches,
+		            " task switches/s: ", switches - last_switches);
+
+		last_frames   = frames;
+		last_batches  = batches;
+		last_switches = switches;
+
+		/* memory usage changes slowly, log it less frequently */
+		if (++seconds % 10 == 0) {
+			Lx::Malloc::mem().log_stats();
+			Lx::Malloc::dma().log_stats();
+		}
+	}
+
+	Rx_stats_logger(Genode::Env &env)
+	:
+		timer(env), handler(env.ep(), *this, &Rx_stats_logger::handle_timeout)
+	{
+		timer.sigh(handler);
+		timer.trigger_periodic(1000*1000);
+	}
+};
+
+
 void Lx::nic_init(Genode::Env &env, Genode::Allocator &alloc)
 {
 	static Root root(env, alloc);
@@ -275,6 +456,13 @@ void Lx::nic_init(Genode::Env &env, Genode::Allocator &alloc)
 
 	_env = &env;
 	_alloc = &alloc;
+
+	/* create poll task before the driver starts receiving */
+	rx_poll();
+
+	if (Lx_kit::env().config_rom().xml().attribute_value("verbose_stats", false)) {
+		static Rx_stats_logger logger(env);
+	}
 }
 
 
@@ -650,6 +838,44 @@ gro_result_t napi_gro_receive(struct napi_struct *napi, struct sk_buff *skb)
 }
 
 
+extern "C" void napi_gro_flush(struct napi_struct *napi, bool flush_old)
+{
+	if (Root::instance->session)
+		Root::instance->session->flush_rx();
+}
+
+
+extern "C" void netif_napi_add(struct net_device *dev, struct napi_struct *napi,
+                               int (*poll)(struct napi_struct *, int), int weight)
+{
+	napi->dev    = dev;
+	napi->poll   = poll;
+	napi->weight = weight;
+	napi->state  = 0;
+
+	rx_poll().add(napi);
+}
+
+
+extern "C" void netif_napi_del(struct napi_struct *napi)
+{
+	rx_poll().remove(napi);
+}
+
+
+extern "C" void napi_schedule(struct napi_struct *napi)
+{
+	napi->state |= 1UL << NAPI_STATE_SCHED;
+	rx_poll().schedule();
+}
+
+
+extern "C" void napi_complete(struct napi_struct *napi)
+{
+	napi->state &= ~(1UL << NAPI_STATE_SCHED);
+}
+
+
 extern "C" void netif_start_subqueue(struct net_device *dev, u16 queue_index)
 {
 	dev->_tx[queue_index].state = NETDEV_QUEUE_START;
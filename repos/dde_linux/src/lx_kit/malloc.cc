@@ -118,6 +118,7 @@ class Lx_kit::Slab_backend_alloc : public Lx::Slab_backend_alloc,
 		void   free(void *addr, size_t size) override { _range.free(addr, size); }
 		size_t overhead(size_t size) const override { return  0; }
 		bool need_size_for_free() const override { return false; }
+		size_t consumed() const override { return _index * P_BLOCK_SIZE; }
 
 		addr_t phys_addr(addr_t addr)
 		{
@@ -158,10 +159,15 @@ class Lx_kit::Malloc : public Lx::Malloc
 {
 	private:
 
+		/*
+		 * Like kmalloc, the size classes between 64 B and 64 KiB are powers
+		 * of two interleaved with 1.5 times the powers of two, i.e., 64, 96,
+		 * 128, 192, and so on.
+		 */
 		enum {
 			SLAB_START_LOG2 = 3,  /* 8 B */
 			SLAB_STOP_LOG2  = MAX_SIZE_LOG2,
-			NUM_SLABS = (SLAB_STOP_LOG2 - SLAB_START_LOG2) + 1,
+			NUM_SLABS = 3 + 2*(SLAB_STOP_LOG2 - 6) + 1,
 		};
 
 		typedef Genode::addr_t         addr_t;
@@ -174,6 +180,38 @@ class Lx_kit::Malloc : public Lx::Malloc
 		addr_t                             _start;  /* VM region of this allocator */
 		addr_t                             _end;
 
+		/**
+		 * Return index of the smallest size class fitting 'size'
+		 */
+		static unsigned _size_class(size_t size)
+		{
+			if (size <= 8)  return 0;
+			if (size <= 16) return 1;
+			if (size <= 32) return 2;
+
+			unsigned const msb = Genode::log2(size);
+
+			if (size == 1UL << msb)
+				return 3 + 2*(msb - 6);
+
+			if (msb >= 6 && size <= 3UL << (msb - 1))
+				return 4 + 2*(msb - 6);
+
+			return 3 + 2*(msb + 1 - 6);
+		}
+
+		/**
+		 * Return object size of size class 'index'
+		 */
+		static size_t _class_size(unsigned index)
+		{
+			if (index < 3)
+				return 8UL << index;
+
+			unsigned const i = index - 3, msb = 6 + i/2;
+			return (i & 1) ? 3UL << (msb - 1) : 1UL << msb;
+		}
+
 		/**
 		 * Set 'value' at 'addr'
 		 */
@@ -223,8 +261,8 @@ class Lx_kit::Malloc : public Lx::Malloc
 			_end(alloc.end())
 		{
 			/* init slab allocators */
-			for (unsigned i = SLAB_START_LOG2; i <= SLAB_STOP_LOG2; i++)
-				_allocator[i - SLAB_START_LOG2].construct(1U << i, alloc);
+			for (unsigned i = 0; i < NUM_SLABS; i++)
+				_allocator[i].construct(_class_size(i), alloc);
 		}
 
 
@@ -243,30 +281,24 @@ class Lx_kit::Malloc : public Lx::Malloc
 			/* += slab index + aligment size */
 			size += sizeof(addr_t) + (align > 2 ? (1 << align) : 0);
 
-			int msb = Genode::log2(size);
-
-			if (size > (1U << msb))
-				msb++;
-
-			if (size < (1U << SLAB_START_LOG2))
-				msb = SLAB_STOP_LOG2;
-
-			if (msb > SLAB_STOP_LOG2) {
-				Genode::error("slab too large ",
-				              1UL << msb, "reqested ", size, " cached ", (int)_cached);
+			if (size > (1UL << SLAB_STOP_LOG2)) {
+				Genode::error("slab too large, "
+				              "requested ", size, " cached ", (int)_cached);
 				return 0;
 			}
 
-			addr_t addr =  _allocator[msb - SLAB_START_LOG2]->alloc();
+			unsigned const index = _size_class(size);
+
+			addr_t addr =  _allocator[index]->alloc();
 			if (!addr) {
-				Genode::error("failed to get slab for ", 1 << msb);
+				Genode::error("failed to get slab for ", _class_size(index));
 				return 0;
 			}
 
 			_set_at(addr, orig_size);
 			addr += sizeof(addr_t);
 
-			_set_at(addr, msb - SLAB_START_LOG2);
+			_set_at(addr, index);
 			addr += sizeof(addr_t);
 
 			if (align > 2) {
@@ -328,6 +360,27 @@ class Lx_kit::Malloc : public Lx::Malloc
 			return _back_allocator.virt_addr(phys); }
 
 		bool inside(addr_t const addr) const { return (addr > _start) && (addr <= _end); }
+
+		void log_stats() const
+		{
+			char const *pool = _cached == Genode::CACHED ? "mem" : "dma";
+
+			for (unsigned i = 0; i < NUM_SLABS; i++) {
+				Slab_alloc const &slab = *_allocator[i];
+				Slab_alloc::Stats const &stats = slab.stats();
+
+				if (!stats.allocs)
+					continue;
+
+				Genode::log(pool, " ", slab.object_size(), " B:"
+				            " in use ", stats.in_use, " peak ", stats.peak,
+				            " allocs ", stats.allocs, " fast ", stats.fast,
+				            " slabs ", slab.consumed() / 1024, " KiB");
+			}
+
+			Genode::log(pool, " backend: ", _back_allocator.consumed() / 1024,
+			            " KiB");
+		}
 };
 
 
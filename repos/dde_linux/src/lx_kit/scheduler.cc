@@ -19,7 +19,9 @@
 #include <base/log.h>
 #include <base/sleep.h>
 #include <base/thread.h>
+#include <base/snprintf.h>
 #include <timer_session/connection.h>
+#include <trace/record.h>
 
 /* Linux emulation environment includes */
 #include <lx_kit/scheduler.h>
@@ -43,7 +45,96 @@ class Lx_kit::Scheduler : public Lx::Scheduler
 
 		Lx::Task *_current = nullptr; /* currently scheduled task */
 
-		bool _run_task(Lx::Task *);
+		unsigned long _task_switches = 0;
+		unsigned      _task_count    = 0;
+
+		/*
+		 * Run queue of runnable tasks
+		 *
+		 * There is one FIFO per priority. Bit 'n' of '_ready' is set if the
+		 * FIFO of priority 'n' is non-empty, which makes the selection of the
+		 * next task independent of the number of tasks.
+		 */
+		enum { NUM_PRIORITIES = Lx::Task::PRIORITY_3 + 1 };
+
+		struct Fifo
+		{
+			Lx::Task *head = nullptr;
+			Lx::Task *tail = nullptr;
+		};
+
+		Fifo     _fifo[NUM_PRIORITIES];
+		unsigned _ready = 0;
+
+		void _enqueue(Lx::Task *t)
+		{
+			if (t->sched.queued)
+				return;
+
+			Fifo &fifo = _fifo[t->priority()];
+
+			t->sched.prev   = fifo.tail;
+			t->sched.next   = nullptr;
+			t->sched.queued = true;
+
+			if (fifo.tail) fifo.tail->sched.next = t;
+			else           fifo.head = t;
+
+			fifo.tail = t;
+			_ready   |= 1U << t->priority();
+		}
+
+		void _dequeue(Lx::Task *t)
+		{
+			if (!t->sched.queued)
+				return;
+
+			Fifo &fifo = _fifo[t->priority()];
+
+			if (t->sched.prev) t->sched.prev->sched.next = t->sched.next;
+			else               fifo.head = t->sched.next;
+
+			if (t->sched.next) t->sched.next->sched.prev = t->sched.prev;
+			else               fifo.tail = t->sched.prev;
+
+			t->sched.prev   = t->sched.next = nullptr;
+			t->sched.queued = false;
+
+			if (!fifo.head)
+				_ready &= ~(1U << t->priority());
+		}
+
+		/**
+		 * Dequeue runnable task of the highest priority
+		 */
+		Lx::Task *_next()
+		{
+			if (!_ready)
+				return nullptr;
+
+			unsigned const prio = 31 - __builtin_clz(_ready);
+
+			Lx::Task *t = _fifo[prio].head;
+			_dequeue(t);
+			return t;
+		}
+
+		/*
+		 * Trace record of a task run, the argument carries the task index in
+		 * the upper 16 bits and the runtime in time-stamp counter ticks in
+		 * the lower 48 bits. The index gets associated with the task name by
+		 * a textual trace event when the task is added.
+		 */
+		enum { TRACE_TASK_RUN = 0x6c787472 /* "lxtr" */ };
+
+		void _trace_run(Lx::Task const *t, Genode::Trace::Timestamp ticks)
+		{
+			enum { TICKS_MASK = (1ULL << 48) - 1 };
+
+			Genode::Trace::record(TRACE_TASK_RUN,
+			                      ((Genode::uint64_t)t->sched.index << 48)
+			                      | (ticks & TICKS_MASK));
+		}
 
 		/*
 		 * Support for logging
@@ -130,42 +221,65 @@ class Lx_kit::Scheduler : public Lx::Scheduler
 			}
 			if (!p)
 				_present_list.append(task);
+
+			task->sched.index = _task_count++;
+
+			char buf[64];
+			Genode::snprintf(buf, sizeof(buf), "lx_task %u %s",
+			                 task->sched.index, task->name());
+			Genode::Thread::trace(buf);
+
+			/* new tasks are runnable */
+			_enqueue(task);
 		}
 
 		void remove(Lx::Task *task) override
 		{
+			_dequeue(task);
 			_present_list.remove(task);
 		}
 
+		void runnable(Lx::Task *task) override
+		{
+			/* the current task is enqueued again when it returns */
+			if (task != _current)
+				_enqueue(task);
+		}
+
+		void blocked(Lx::Task *task) override { _dequeue(task); }
+
 		void schedule() override
 		{
 			bool at_least_one = false;
 
 			/*
-			 * Iterate over all tasks and run first runnable.
-			 *
-			 * (1) If one runnable tasks was run start over from beginning of
-			 *     list.
-			 *
-			 * (2) If no task is runnable quit scheduling (break endless
-			 *     loop).
+			 * Run the first task of the highest-priority run queue until no
+			 * task is runnable anymore. A task that is still runnable when
+			 * reaching its preemption point is enqueued at the tail, which
+			 * lets tasks of the same priority take turns.
 			 */
-			while (true) {
+			while (Lx::Task *t = _next()) {
 				/* update jiffies before running task */
 				Lx::timer_update_jiffies();
 
-				bool was_run = false;
-				for (Lx::Task *t = _present_list.first(); t; t = t->next()) {
-					/* update current before running task */
-					_current = t;
+				/* update current before running task */
+				_current = t;
 
-					if ((was_run = t->run())) {
-						at_least_one = true;
-						break;
-					}
-				}
-				if (!was_run)
-					break;
+				Genode::Trace::Timestamp const start = Genode::Trace::timestamp();
+
+				if (!t->run())
+					continue;
+
+				Genode::Trace::Timestamp const ticks = Genode::Trace::timestamp() - start;
+
+				t->sched.runtime += ticks;
+				_trace_run(t, ticks);
+
+				at_least_one = true;
+				_task_switches++;
+
+				if (t->state() == Lx::Task::STATE_RUNNING)
+					_enqueue(t);
 			}
 
 			if (!at_least_one) {
@@ -177,6 +291,9 @@ class Lx_kit::Scheduler : public Lx::Scheduler
 			_current = nullptr;
 		}
 
+		unsigned long task_switches() const override {
+			return _task_switches; }
+
 		void log_state(char const *prefix) override
 		{
 			unsigned  i;
@@ -186,6 +303,7 @@ class Lx_kit::Scheduler : public Lx::Scheduler
 				            "prio: ", (int)t->priority(), " "
 				            "state: ", _state_color(t->state()), (int)t->state(),
 				                       _ansi_esc_reset(), " ",
+				            "runtime: ", t->sched.runtime, " ",
 				            t->name());
 			}
 		}
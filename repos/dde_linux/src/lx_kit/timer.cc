@@ -18,7 +18,7 @@
 #include <timer_session/connection.h>
 
 /* Linux kit includes */
-#include <lx_kit/internal/list.h>
+#include <lx_kit/internal/timer_wheel.h>
 #include <lx_kit/scheduler.h>
 
 /* Linux emulation environment includes */
@@ -36,17 +36,13 @@ class Lx_kit::Timer : public Lx::Timer
 		/**
 		 * Context encapsulates a regular linux timer_list
 		 */
-		struct Context : public Lx_kit::List<Context>::Element
+		struct Context : public Lx_kit::Timer_wheel::Entry
 		{
-			enum { INVALID_TIMEOUT = ~0UL };
+			Type   type;
+			void  *timer;
 
-			Type               type;
-			void              *timer;
-			bool               pending { false };
-			unsigned long      timeout { INVALID_TIMEOUT }; /* absolute in jiffies */
-
-			Context(struct timer_list *timer) : type(LIST), timer(timer) { }
-			Context(struct hrtimer    *timer) : type(HR),   timer(timer) { }
+			Context(struct timer_list *timer) : Entry(timer), type(LIST), timer(timer) { }
+			Context(struct hrtimer    *timer) : Entry(timer), type(HR),   timer(timer) { }
 
 			void expires(unsigned long e)
 			{
@@ -81,65 +77,76 @@ class Lx_kit::Timer : public Lx::Timer
 		unsigned long                               &_jiffies;
 		::Timer::Connection                          _timer_conn;
 		::Timer::Connection                          _timer_conn_modern;
-		Lx_kit::List<Context>                        _list;
+		Lx_kit::Timer_wheel                          _wheel;
 		Lx::Task                                     _timer_task;
 		Genode::Signal_handler<Lx_kit::Timer>        _dispatcher;
 		Genode::Tslab<Context, 32 * sizeof(Context)> _timer_alloc;
 
+		/* context whose function is currently executed */
+		Context *_running = nullptr;
+
+		/* jiffy the timer session is programmed for */
+		bool          _armed      = false;
+		unsigned long _programmed = 0;
+
 		/**
 		 * Lookup local timer
 		 */
-		Context *_find_context(void const *timer)
-		{
-			for (Context *c = _list.first(); c; c = c->next())
-				if (c->timer == timer)
-					return c;
-
-			return 0;
-		}
+		Context *_find_context(void const *timer) {
+			return static_cast<Context *>(_wheel.lookup(timer)); }
 
 		/**
-		 * Program the first timer in the list
+		 * Program the timer session unless it triggers earlier anyway
+		 *
+		 * Spurious triggers caused by deleted or postponed timers are
+		 * cheaper than reprogramming the timer session on each change.
 		 */
-		void _program_first_timer()
+		void _program(unsigned long jiffy)
 		{
-			Context *ctx = _list.first();
-			if (!ctx)
+			if (_armed && (long)(jiffy - _programmed) >= 0)
 				return;
 
+			_armed      = true;
+			_programmed = jiffy;
+
 			/* calculate relative microseconds for trigger */
-			unsigned long us = ctx->timeout > _jiffies ?
-			                   jiffies_to_msecs(ctx->timeout - _jiffies) * 1000 : 0;
+			unsigned long us = jiffy > _jiffies ?
+			                   jiffies_to_msecs(jiffy - _jiffies) * 1000 : 0;
 			_timer_conn.trigger_once(us);
 		}
 
 		/**
-		 * Schedule timer
-		 *
-		 * Add the context to the scheduling list depending on its timeout
-		 * and reprogram the first timer.
+		 * Program the next event of the timer wheel
 		 */
-		void _schedule_timer(Context *ctx, unsigned long expires)
+		void _program_next_event()
 		{
-			_list.remove(ctx);
+			unsigned long jiffy = 0;
+			if (_wheel.next_event(jiffy))
+				_program(jiffy);
+		}
 
-			ctx->timeout    = expires;
-			ctx->pending    = true;
+		/**
+		 * Execute expired timers
+		 */
+		void _expire()
+		{
+			_armed = false;
 
-			/*
-			 * Also write the timeout value to the expires field in
-			 * struct timer_list because some code the checks
-			 * it directly.
-			 */
-			ctx->expires(expires);
+			_wheel.expire(_jiffies, [&] (Lx_kit::Timer_wheel::Entry &e) {
 
-			Context *c;
-			for (c = _list.first(); c; c = c->next())
-				if (ctx->timeout <= c->timeout)
-					break;
-			_list.insert_before(ctx, c);
+				Context &ctx = static_cast<Context &>(e);
+
+				_running = &ctx;
+				ctx.function();
+				_running = nullptr;
+
+				if (!ctx.pending()) {
+					_wheel.remove(ctx);
+					destroy(&_timer_alloc, &ctx);
+				}
+			});
 
-			_program_first_timer();
+			_program_next_event();
 		}
 
 		/**
@@ -171,10 +178,6 @@ class Lx_kit::Timer : public Lx::Timer
 			_timer_conn.sigh(_dispatcher);
 		}
 
-		Context* first() { return _list.first(); }
-
-		unsigned long jiffies() const { return _jiffies; }
-
 		static void run_timer(void *p)
 		{
 			Timer &t = *reinterpret_cast<Timer*>(p);
@@ -182,20 +185,7 @@ class Lx_kit::Timer : public Lx::Timer
 			while (1) {
 				Lx::scheduler().current()->block_and_schedule();
 
-				while (Lx_kit::Timer::Context *ctx = t.first()) {
-					if (ctx->timeout > t.jiffies()) {
-						break;
-					}
-
-					ctx->pending = false;
-					ctx->function();
-
-					if (!ctx->pending) {
-						t.del(ctx->timer);
-					}
-				}
-
-				t.schedule_next();
+				t._expire();
 			}
 		}
 
@@ -212,7 +202,7 @@ class Lx_kit::Timer : public Lx::Timer
 			else
 				t = new (&_timer_alloc) Context(static_cast<timer_list *>(timer));
 
-			_list.append(t);
+			_wheel.insert(*t);
 		}
 
 		int del(void *timer)
@@ -226,9 +216,15 @@ class Lx_kit::Timer : public Lx::Timer
 			if (!ctx)
 				return 0;
 
-			int rv = ctx->pending ? 1 : 0;
+			int rv = ctx->pending() ? 1 : 0;
 
-			_list.remove(ctx);
+			/* a running timer is cleaned up after its function returned */
+			if (ctx == _running) {
+				_wheel.deactivate(*ctx);
+				return rv;
+			}
+
+			_wheel.remove(*ctx);
 			destroy(&_timer_alloc, ctx);
 
 			return rv;
@@ -246,14 +242,27 @@ class Lx_kit::Timer : public Lx::Timer
 			 * If timer was already active return 1, otherwise 0. The return
 			 * value is needed by mod_timer().
 			 */
-			int rv = ctx->pending ? 1 : 0;
+			int rv = ctx->pending() ? 1 : 0;
 
-			_schedule_timer(ctx, expires);
+			_wheel.schedule(*ctx, expires, _jiffies);
+
+			/*
+			 * Also write the timeout value to the expires field in
+			 * struct timer_list because some code the checks
+			 * it directly.
+			 */
+			ctx->expires(expires);
+
+			_program(expires);
 
 			return rv;
 		}
 
-		void schedule_next() { _program_first_timer(); }
+		/*
+		 * The timer session is programmed whenever a timer gets scheduled,
+		 * so deleting a timer never requires reprogramming.
+		 */
+		void schedule_next() { if (!_armed) _program_next_event(); }
 
 		/**
 		 * Check if the timer is currently pending
@@ -265,17 +274,11 @@ class Lx_kit::Timer : public Lx::Timer
 				return false;
 			}
 
-			return ctx->pending;
+			return ctx->pending();
 		}
 
-		bool find(void const *timer) const
-		{
-			for (Context const *c = _list.first(); c; c = c->next())
-				if (c->timer == timer)
-					return true;
-
-			return false;
-		}
+		bool find(void const *timer) const {
+			return _wheel.lookup(timer) != nullptr; }
 
 		void update_jiffies() {
 			_jiffies = usecs_to_jiffies(_timer_conn_modern.curr_time().trunc_to_plain_us().value); }
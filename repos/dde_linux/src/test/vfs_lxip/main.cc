@@ -19,6 +19,7 @@
 #include <unistd.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <dirent.h>
 
 
@@ -182,14 +183,15 @@ static int test_bind_accept(char const *sock_root, char const *sock_fd)
 			break;
 		}
 
-		char client_fd[8] = { 0 };
-		res = read(fda, client_fd, sizeof(client_fd));
+		/* the socket is followed by the remote address */
+		char client_fd[64] = { 0 };
+		res = read(fda, client_fd, sizeof(client_fd) - 1);
 		close(fda);
 
 		if      (res  < 0) break;
 		else if (res == 0) continue;
 
-		client_fd[res-1] = '\0';
+		client_fd[strcspn(client_fd, " \n")] = '\0';
 
 		printf("accept socket: %s\n", client_fd);
 
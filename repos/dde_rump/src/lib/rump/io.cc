@@ -14,6 +14,8 @@
 #include "sched.h"
 #include <base/allocator_avl.h>
 #include <base/printf.h>
+#include <base/semaphore.h>
+#include <util/reconstructible.h>
 #include <block_session/connection.h>
 #include <rump/env.h>
 #include <rump_fs/fs.h>
@@ -25,23 +27,230 @@ enum  { GENODE_FD = 64 };
 
 /**
  * Block session connection
+ *
+ * Block requests are submitted asynchronously. The acknowledgements are
+ * processed by a dedicated completion thread, which calls the 'biodone'
+ * function of the request within the rump kernel. Hence, up to
+ * 'MAX_REQUESTS' block requests of the rump kernel are outstanding at the
+ * block server at a time.
  */
 class Backend
 {
 	private:
 
+		enum { TX_BUF_SIZE = 1024*1024, MAX_REQUESTS = 32 };
+
+		/**
+		 * Block request in flight
+		 */
+		struct Request
+		{
+			Block::Packet_descriptor  packet;
+			int                       op;
+			void                     *data;
+			size_t                    length;
+			rump_biodone_fn           biodone;
+			void                     *donearg;
+			Genode::Semaphore        *waiter;    /* synchronous caller */
+			bool                      succeeded;
+			bool                      used;
+		};
+
 		Genode::Allocator_avl              _alloc { &Rump::env().heap() };
-		Block::Connection                  _session { Rump::env().env(), &_alloc };
+		Block::Connection                  _session { Rump::env().env(), &_alloc, TX_BUF_SIZE };
 		Genode::size_t                     _blk_size; /* block size of the device   */
 		Block::sector_t                    _blk_cnt;  /* number of blocks of device */
 		Block::Session::Operations         _blk_ops;
 		Genode::Lock                       _session_lock;
 
+		Request                            _requests[MAX_REQUESTS];
+		unsigned                           _free_waiters = 0;
+		Genode::Semaphore                  _free_sem;
+
+		Genode::Constructible<Hard_context_thread> _completion;
+
+		/**
+		 * Return free request slot, caller must hold the session lock
+		 */
+		Request *_alloc_request()
+		{
+			for (unsigned i = 0; i < MAX_REQUESTS; i++)
+				if (!_requests[i].used) {
+					_requests[i].used = true;
+					return &_requests[i];
+				}
+			return nullptr;
+		}
+
+		/**
+		 * Release request slot, caller must hold the session lock
+		 */
+		void _free_request(Request &r)
+		{
+			r.used = false;
+
+			/* wake up all submitters waiting for a slot or packet space */
+			for (; _free_waiters; _free_waiters--)
+				_free_sem.up();
+		}
+
+		Request *_lookup(Block::Packet_descriptor const &packet)
+		{
+			for (unsigned i = 0; i < MAX_REQUESTS; i++)
+				if (_requests[i].used
+				 && _requests[i].packet.operation() == packet.operation()
+				 && _requests[i].packet.offset()    == packet.offset()
+				 && _requests[i].packet.size()      == packet.size())
+					return &_requests[i];
+			return nullptr;
+		}
+
+		/**
+		 * Submit request, block while no request slot or packet space is free
+		 */
+		void _submit(Block::Packet_descriptor::Opcode opcode, int op,
+		             int64_t offset, size_t length, void *data,
+		             rump_biodone_fn biodone, void *donearg,
+		             Genode::Semaphore *waiter)
+		{
+			using namespace Block;
+
+			for (;;) {
+				{
+					Genode::Lock::Guard guard(_session_lock);
+
+					if (!_completion.constructed())
+						_completion.construct("rump_bio", _completion_entry, this, 0);
+
+					Request *r = _alloc_request();
+					if (r) {
+						try {
+							Packet_descriptor packet(_session.dma_alloc_packet(length),
+							                         opcode, offset / _blk_size,
+							                         length / _blk_size);
+
+							/* out packet -> copy data */
+							if (opcode == Packet_descriptor::WRITE)
+								Genode::memcpy(_session.tx()->packet_content(packet), data, length);
+
+							*r = Request { packet, op, data, length, biodone,
+							               donearg, waiter, false, true };
+
+							_session.tx()->submit_packet(packet);
+							return;
+
+						} catch(Block::Session::Tx::Source::Packet_alloc_failed) {
+							r->used = false;
+
+							if (length > TX_BUF_SIZE) {
+								Genode::error("I/O back end: request exceeds packet buffer");
+								throw;
+							}
+						}
+					}
+					_free_waiters++;
+				}
+				_free_sem.down();
+			}
+		}
+
+		/**
+		 * Turn acknowledged packet into the completion of its request
+		 *
+		 * \return true if the request is finished
+		 */
+		bool _complete(Request &r, Block::Packet_descriptor const &packet)
+		{
+			using namespace Block;
+
+			Genode::Lock::Guard guard(_session_lock);
+
+			if (packet.operation() == Packet_descriptor::READ)
+				Genode::memcpy(r.data, _session.tx()->packet_content(packet),
+				               packet.block_count() * _blk_size);
+
+			if (packet.operation() != Packet_descriptor::FLUSH)
+				r.succeeded = packet.succeeded();
+			else if (!packet.succeeded())
+				Genode::error("I/O back end: flush failed");
+
+			_session.tx()->release_packet(packet);
+
+			/* sync request, write back caches before completing the request */
+			if ((r.op & RUMPUSER_BIO_SYNC) && r.succeeded) {
+				r.op &= ~RUMPUSER_BIO_SYNC;
+
+				if (_blk_ops.supported(Packet_descriptor::FLUSH)) {
+					try {
+						r.packet = Packet_descriptor(_session.dma_alloc_packet(0),
+						                             Packet_descriptor::FLUSH, 0, 0);
+						_session.tx()->submit_packet(r.packet);
+						return false;
+					} catch(Block::Session::Tx::Source::Packet_alloc_failed) { }
+				}
+				_session.sync();
+			}
+			return true;
+		}
+
+		void _completion_loop()
+		{
+			/* create rump LWP for the calls of 'biodone' */
+			_rump_upcalls.hyp_schedule();
+			_rump_upcalls.hyp_lwproc_newlwp(0);
+			_rump_upcalls.hyp_unschedule();
+
+			for (;;) {
+				Block::Packet_descriptor const packet = _session.tx()->get_acked_packet();
+
+				Request *r = nullptr;
+				{
+					Genode::Lock::Guard guard(_session_lock);
+					r = _lookup(packet);
+				}
+
+				if (!r) {
+					Genode::error("I/O back end: acknowledgement of unknown packet");
+					Genode::Lock::Guard guard(_session_lock);
+					_session.tx()->release_packet(packet);
+					continue;
+				}
+
+				if (!_complete(*r, packet))
+					continue;
+
+				Request const done = *r;
+				{
+					Genode::Lock::Guard guard(_session_lock);
+					_free_request(*r);
+				}
+
+				if (done.waiter) {
+					done.waiter->up();
+					continue;
+				}
+
+				_rump_upcalls.hyp_schedule();
+				done.biodone(done.donearg, done.succeeded ? done.length : 0,
+				             done.succeeded ? 0 : EIO);
+				_rump_upcalls.hyp_unschedule();
+			}
+		}
+
+		static void *_completion_entry(void *backend)
+		{
+			static_cast<Backend *>(backend)->_completion_loop();
+			return nullptr;
+		}
+
 	public:
 
 		Backend()
 		{
 			_session.info(&_blk_cnt, &_blk_size, &_blk_ops);
+
+			for (unsigned i = 0; i < MAX_REQUESTS; i++)
+				_requests[i].used = false;
 		}
 
 		uint64_t block_count() const { return (uint64_t)_blk_cnt; }
@@ -52,53 +261,41 @@ class Backend
 			return _blk_ops.supported(Block::Packet_descriptor::WRITE);
 		}
 
+		/**
+		 * Make written data persistent
+		 *
+		 * Devices that support flush requests get a write barrier instead
+		 * of the synchronization of the whole session.
+		 */
 		void sync()
 		{
-			Genode::Lock::Guard guard(_session_lock);
-			_session.sync();
+			using namespace Block;
+
+			if (!_blk_ops.supported(Packet_descriptor::FLUSH)) {
+				Genode::Lock::Guard guard(_session_lock);
+				_session.sync();
+				return;
+			}
+
+			Genode::Semaphore done;
+			_submit(Packet_descriptor::FLUSH, 0, 0, 0, nullptr, nullptr,
+			        nullptr, &done);
+			done.down();
 		}
 
-		bool submit(int op, int64_t offset, size_t length, void *data)
+		/**
+		 * Submit block request, 'biodone' is called on completion
+		 */
+		void submit(int op, int64_t offset, size_t length, void *data,
+		            rump_biodone_fn biodone, void *donearg)
 		{
 			using namespace Block;
 
-			Genode::Lock::Guard guard(_session_lock);
-
 			Packet_descriptor::Opcode opcode;
 			opcode = op & RUMPUSER_BIO_WRITE ? Packet_descriptor::WRITE :
 			                                   Packet_descriptor::READ;
-			/* allocate packet */
-			try {
-				Packet_descriptor packet( _session.dma_alloc_packet(length),
-				                         opcode, offset / _blk_size,
-				                         length / _blk_size);
-
-				/* out packet -> copy data */
-				if (opcode == Packet_descriptor::WRITE)
-					Genode::memcpy(_session.tx()->packet_content(packet), data, length);
-
-				_session.tx()->submit_packet(packet);
-			} catch(Block::Session::Tx::Source::Packet_alloc_failed) {
-				Genode::error("I/O back end: Packet allocation failed!");
-				return false;
-			}
-
-			/* wait and process result */
-			Packet_descriptor packet = _session.tx()->get_acked_packet();
 
-			/* in packet */
-			if (opcode == Packet_descriptor::READ)
-				Genode::memcpy(data, _session.tx()->packet_content(packet), length);
-
-			bool succeeded = packet.succeeded();
-			_session.tx()->release_packet(packet);
-
-			/* sync request */
-			if (op & RUMPUSER_BIO_SYNC) {
-				_session.sync();
-			}
-
-			return succeeded;
+			_submit(opcode, op, offset, length, data, biodone, donearg, nullptr);
 		}
 };
 
@@ -154,12 +351,15 @@ void rumpuser_bio(int fd, int op, void *data, size_t dlen, int64_t off,
 		            "bio ",   donearg, " "
 		            "sync: ", !!(op & RUMPUSER_BIO_SYNC));
 
-	bool succeeded = backend().submit(op, off, dlen, data);
+	try {
+		backend().submit(op, off, dlen, data, biodone, donearg);
+	} catch (...) {
+		rumpkern_sched(nlocks, 0);
+		biodone(donearg, 0, EIO);
+		return;
+	}
 
 	rumpkern_sched(nlocks, 0);
-
-	if (biodone)
-		biodone(donearg, dlen, succeeded ? 0 : EIO);
 }
 
 
@@ -20,11 +20,13 @@
 #include <root/component.h>
 #include <base/component.h>
 #include <base/heap.h>
+#include <base/semaphore.h>
 
 #include "undef.h"
 
 #include <rump/env.h>
 #include <rump_fs/fs.h>
+#include <util/hard_context.h>
 #include <sys/resource.h>
 #include "file_system.h"
 #include "directory.h"
@@ -38,8 +40,89 @@ namespace Rump_fs {
 	struct Main;
 	struct Root;
 	struct Session_component;
+	class  Job_queue;
 }
 
+
+/**
+ * Packets handed over from the entrypoint to the worker threads
+ *
+ * The worker threads execute the file operations within the rump kernel.
+ * While a worker blocks for a block request, the entrypoint and the other
+ * workers continue to serve the remaining sessions.
+ */
+class Rump_fs::Job_queue
+{
+	public:
+
+		struct Job
+		{
+			Session_component *session;
+			Packet_descriptor  packet;
+		};
+
+	private:
+
+		enum { SIZE = 64 };
+
+		Genode::Lock      _lock;
+		Genode::Semaphore _avail;
+
+		Job      _jobs[SIZE];
+		unsigned _head  = 0;
+		unsigned _tail  = 0;
+		unsigned _count = 0;
+
+		static void *_worker_entry(void *);
+
+	public:
+
+		/**
+		 * Start worker threads
+		 */
+		void start_workers(Genode::Allocator &alloc, unsigned count)
+		{
+			for (unsigned i = 0; i < count; i++)
+				new (alloc) Hard_context_thread("rump_fs_worker", _worker_entry, this, 0);
+		}
+
+		/**
+		 * Enqueue job
+		 *
+		 * \return false if the queue is full
+		 */
+		bool put(Job const &job)
+		{
+			{
+				Genode::Lock::Guard guard(_lock);
+
+				if (_count == SIZE)
+					return false;
+
+				_jobs[_head] = job;
+				_head = (_head + 1) % SIZE;
+				_count++;
+			}
+			_avail.up();
+			return true;
+		}
+
+		/**
+		 * Dequeue job, block until a job is available
+		 */
+		Job get()
+		{
+			_avail.down();
+
+			Genode::Lock::Guard guard(_lock);
+
+			Job const job = _jobs[_tail];
+			_tail = (_tail + 1) % SIZE;
+			_count--;
+			return job;
+		}
+};
+
 class Rump_fs::Session_component : public Session_rpc_object
 {
 	private:
@@ -53,6 +136,17 @@ class Rump_fs::Session_component : public Session_rpc_object
 
 		Signal_handler<Session_component> _process_packet_handler;
 
+		Job_queue &_jobs;
+
+		/*
+		 * At most one packet of a session is processed by a worker at a
+		 * time, which keeps the order of the session's packets.
+		 */
+		Genode::Lock      _busy_lock;
+		bool              _busy    = false;
+		bool              _closing = false;
+		Genode::Semaphore _idle;
+
 
 		/******************************
 		 ** Packet-stream processing **
@@ -104,10 +198,8 @@ class Rump_fs::Session_component : public Session_rpc_object
 			tx_sink()->acknowledge_packet(packet);
 		}
 
-		void _process_packet()
+		void _process_packet(Packet_descriptor packet)
 		{
-			Packet_descriptor packet = tx_sink()->get_packet();
-
 			/* assume failure by default */
 			packet.succeeded(false);
 
@@ -131,6 +223,12 @@ class Rump_fs::Session_component : public Session_rpc_object
 		{
 			while (tx_sink()->packet_avail()) {
 
+				{
+					Genode::Lock::Guard guard(_busy_lock);
+					if (_busy)
+						return;
+				}
+
 				/*
 				 * Make sure that the '_process_packet' function does not
 				 * block.
@@ -146,7 +244,18 @@ class Rump_fs::Session_component : public Session_rpc_object
 				if (!tx_sink()->ready_to_ack())
 					return;
 
-				_process_packet();
+				Packet_descriptor const packet = tx_sink()->get_packet();
+
+				{
+					Genode::Lock::Guard guard(_busy_lock);
+
+					_busy = _jobs.put(Job_queue::Job { this, packet });
+					if (_busy)
+						return;
+				}
+
+				/* process packet in place if all workers are occupied */
+				_process_packet(packet);
 			}
 		}
 
@@ -168,13 +277,15 @@ class Rump_fs::Session_component : public Session_rpc_object
 		                  size_t              tx_buf_size,
 		                  char const         *root_dir,
 		                  bool                writeable,
-		                  Allocator          &md_alloc)
+		                  Allocator          &md_alloc,
+		                  Job_queue          &jobs)
 		:
 			Session_rpc_object(env.ram().alloc(tx_buf_size), env.rm(), env.ep().rpc_ep()),
 			_md_alloc(md_alloc),
 			_root(*new (&_md_alloc) Directory(_md_alloc, root_dir, false)),
 			_writable(writeable),
-			_process_packet_handler(env.ep(), *this, &Session_component::_process_packets)
+			_process_packet_handler(env.ep(), *this, &Session_component::_process_packets),
+			_jobs(jobs)
 		{
 			/*
 			 * Register '_process_packets' dispatch function as signal
@@ -189,11 +300,42 @@ class Rump_fs::Session_component : public Session_rpc_object
 		 */
 		~Session_component()
 		{
+			/* wait for the worker processing a packet of the session */
+			bool busy = false;
+			{
+				Genode::Lock::Guard guard(_busy_lock);
+				_closing = true;
+				busy     = _busy;
+			}
+			if (busy)
+				_idle.down();
+
 			Dataspace_capability ds = tx_sink()->dataspace();
 			Rump::env().env().ram().free(static_cap_cast<Ram_dataspace>(ds));
 			destroy(&_md_alloc, &_root);
 		}
 
+		/**
+		 * Process packet, called by a worker thread
+		 */
+		void process_job(Packet_descriptor const &packet)
+		{
+			_process_packet(packet);
+
+			bool closing = false;
+			{
+				Genode::Lock::Guard guard(_busy_lock);
+				_busy   = false;
+				closing = _closing;
+
+				/* continue with the packets queued in the meantime */
+				if (!closing)
+					Signal_transmitter(_process_packet_handler).submit();
+			}
+			if (closing)
+				_idle.up();
+		}
+
 		/***************************
 		 ** File_system interface **
 		 ***************************/
@@ -427,6 +569,8 @@ class Rump_fs::Root : public Root_component<Session_component>
 
 		Genode::Attached_rom_dataspace _config { _env, "config" };
 
+		Job_queue &_jobs;
+
 	protected:
 
 		Session_component *_create_session(const char *args)
@@ -504,7 +648,8 @@ class Rump_fs::Root : public Root_component<Session_component>
 
 			try {
 				return new (md_alloc())
-					Session_component(_env, tx_buf_size, root_dir, writeable, *md_alloc());
+					Session_component(_env, tx_buf_size, root_dir, writeable,
+					                  *md_alloc(), _jobs);
 
 			} catch (Lookup_failed) {
 				Genode::error("File system root directory \"", root_dir, "\" does not exist");
@@ -526,11 +671,17 @@ class Rump_fs::Root : public Root_component<Session_component>
 		/**
 		 * Constructor
 		 */
-		Root(Genode::Env &env, Allocator &md_alloc)
+		Root(Genode::Env &env, Allocator &md_alloc, Job_queue &jobs)
 		:
 			Root_component<Session_component>(env.ep(), md_alloc),
-			_env(env)
+			_env(env), _jobs(jobs)
 		{ }
+
+		/**
+		 * Return number of worker threads configured
+		 */
+		unsigned workers() {
+			return _config.xml().attribute_value("workers", 4U); }
 };
 
 
@@ -565,7 +716,9 @@ struct Rump_fs::Main
 	 */
 	Sliced_heap sliced_heap { env.ram(), env.rm() };
 
-	Root fs_root { env, sliced_heap };
+	Job_queue jobs { };
+
+	Root fs_root { env, sliced_heap, jobs };
 
 	Main(Genode::Env &env) : env(env)
 	{
@@ -583,6 +736,8 @@ struct Rump_fs::Main
 		if (rump_sys_setrlimit(RLIMIT_NOFILE, &rl) != 0)
 			Genode::error("rump_sys_setrlimit(RLIMIT_NOFILE, ...) failed, errno ", errno);
 
+		jobs.start_workers(heap, fs_root.workers());
+
 		env.parent().announce(env.ep().manage(fs_root));
 		env.parent().resource_avail_sigh(resource_handler);
 
@@ -592,6 +747,18 @@ struct Rump_fs::Main
 };
 
 
+void *Rump_fs::Job_queue::_worker_entry(void *queue)
+{
+	Job_queue &jobs = *static_cast<Job_queue *>(queue);
+
+	for (;;) {
+		Job const job = jobs.get();
+		job.session->process_job(job.packet);
+	}
+	return nullptr;
+}
+
+
 void Component::construct(Genode::Env &env)
 {
 	/* XXX execute constructors of global statics (uses shared objects) */
@@ -34,6 +34,24 @@ class Animator
 
 		inline void animate();
 
+		/**
+		 * Advance all animated items by 'num_frames'
+		 *
+		 * Items that finish their animation in between are not animated
+		 * further.
+		 */
+		void animate(unsigned num_frames)
+		{
+			for (unsigned i = 0; i < num_frames && active(); i++)
+				animate();
+		}
+
+		/**
+		 * Return true if any item is animated
+		 *
+		 * An animator that is not active does not need to be driven by a
+		 * periodic signal.
+		 */
 		bool active() const { return _items.first() != nullptr; }
 };
 
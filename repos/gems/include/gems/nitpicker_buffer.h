@@ -131,8 +131,23 @@ struct Nitpicker_buffer
 
 	void reset_surface()
 	{
-		Genode::size_t const num_pixels = pixel_surface().size().count();
-		Genode::memset(alpha_surface().addr(), 0, num_pixels);
+		reset_surface(Rect(Point(0, 0), size()));
+	}
+
+	/**
+	 * Reset area of the back buffer
+	 */
+	void reset_surface(Rect rect)
+	{
+		rect = Rect::intersect(rect, Rect(Point(0, 0), size()));
+		if (!rect.valid())
+			return;
+
+		unsigned const line = size().w();
+		unsigned const offset = rect.y1()*line + rect.x1();
+
+		Pixel_alpha8 *alpha  = alpha_surface().addr() + offset;
+		Pixel_rgb888 *pixels = pixel_surface().addr() + offset;
 
 		/*
 		 * Initialize color buffer with 50% gray
@@ -140,13 +155,16 @@ struct Nitpicker_buffer
 		 * We do not use black to limit the bleeding of black into antialiased
 		 * drawing operations applied onto an initially transparent background.
 		 */
-		Pixel_surface pixels = pixel_surface();
-		Pixel_rgb888 *dst    = pixels.addr();
-
 		Pixel_rgb888 const gray(127, 127, 127, 255);
 
-		for (unsigned n = pixels.size().count(); n; n--)
-			*dst++ = gray;
+		for (unsigned y = 0; y < rect.h(); y++, alpha += line, pixels += line) {
+
+			Genode::memset(alpha, 0, rect.w()*sizeof(Pixel_alpha8));
+
+			Pixel_rgb888 *dst = pixels;
+			for (unsigned n = rect.w(); n; n--)
+				*dst++ = gray;
+		}
 	}
 
 	template <typename DST_PT, typename SRC_PT>
@@ -161,18 +179,17 @@ struct Nitpicker_buffer
 		Dither_painter::paint(surface, texture, Point());
 	}
 
-	void _update_input_mask()
+	void _update_input_mask(Rect const rect)
 	{
 		unsigned const num_pixels = size().count();
+		unsigned const line       = size().w();
+		unsigned const offset     = rect.y1()*line + rect.x1();
 
 		unsigned char * const alpha_base = fb_ds.local_addr<unsigned char>()
 		                                 + mode.bytes_per_pixel()*num_pixels;
 
 		unsigned char * const input_base = alpha_base + num_pixels;
 
-		unsigned char const *src = alpha_base;
-		unsigned char       *dst = input_base;
-
 		/*
 		 * Set input mask for all pixels where the alpha value is above a
 		 * given threshold. The threshold is defines such that typical
@@ -180,21 +197,36 @@ struct Nitpicker_buffer
 		 */
 		unsigned char const threshold = 100;
 
-		for (unsigned i = 0; i < num_pixels; i++)
-			*dst++ = (*src++) > threshold;
+		for (unsigned y = 0; y < rect.h(); y++) {
+
+			unsigned char const *src = alpha_base + offset + y*line;
+			unsigned char       *dst = input_base + offset + y*line;
+
+			for (unsigned i = 0; i < rect.w(); i++)
+				*dst++ = (*src++) > threshold;
+		}
 	}
 
 	void flush_surface()
 	{
+		flush_surface(Rect(Point(0, 0), size()));
+	}
+
+	/**
+	 * Transfer area of the back buffer to the virtual framebuffer
+	 */
+	void flush_surface(Rect rect)
+	{
+		Rect const clip_rect = Rect::intersect(rect, Rect(Point(0, 0), size()));
+		if (!clip_rect.valid())
+			return;
+
 		/* represent back buffer as texture */
 		Genode::Texture<Pixel_rgb888>
 			texture(pixel_surface_ds.local_addr<Pixel_rgb888>(),
 			        alpha_surface_ds.local_addr<unsigned char>(),
 			        size());
 
-		// XXX track dirty rectangles
-		Rect const clip_rect(Genode::Surface_base::Point(0, 0), size());
-
 		Pixel_rgb565 *pixel_base = fb_ds.local_addr<Pixel_rgb565>();
 		Pixel_alpha8 *alpha_base = fb_ds.local_addr<Pixel_alpha8>()
 		                         + mode.bytes_per_pixel()*size().count();
@@ -202,7 +234,7 @@ struct Nitpicker_buffer
 		_convert_back_to_front(pixel_base, texture, clip_rect);
 		_convert_back_to_front(alpha_base, texture, clip_rect);
 
-		_update_input_mask();
+		_update_input_mask(clip_rect);
 	}
 };
 
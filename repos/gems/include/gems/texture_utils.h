@@ -15,10 +15,20 @@
 #define _INCLUDE__GEMS__TEXTURE_UTILS_H_
 
 #include <os/texture.h>
+#include <os/texture_rgb565.h>
+#include <os/pixel_rgb888.h>
+#include <util/dither_matrix.h>
+#include <blit/blit.h>
 
+/**
+ * Scale rows 'first_row' to 'first_row + num_rows - 1' of 'dst'
+ *
+ * Distinct row ranges of the same destination may be scaled concurrently.
+ */
 template <typename PT>
 static void scale(Genode::Texture<PT> const &src, Genode::Texture<PT> &dst,
-                  Genode::Allocator &alloc)
+                  Genode::Allocator &alloc, unsigned first_row,
+                  unsigned num_rows)
 {
 	/* sanity check to prevent division by zero */
 	if (dst.size().count() == 0)
@@ -30,7 +40,9 @@ static void scale(Genode::Texture<PT> const &src, Genode::Texture<PT> &dst,
 	unsigned const mx = (src.size().w() << 16) / dst.size().w();
 	unsigned const my = (src.size().h() << 16) / dst.size().h();
 
-	for (unsigned y = 0, src_y = 0; y < dst.size().h(); y++, src_y += my) {
+	unsigned const end_row = Genode::min(first_row + num_rows, dst.size().h());
+
+	for (unsigned y = first_row, src_y = first_row*my; y < end_row; y++, src_y += my) {
 
 		unsigned const src_line_offset = src.size().w()*(src_y >> 16);
 
@@ -58,6 +70,14 @@ static void scale(Genode::Texture<PT> const &src, Genode::Texture<PT> &dst,
 }
 
 
+template <typename PT>
+static void scale(Genode::Texture<PT> const &src, Genode::Texture<PT> &dst,
+                  Genode::Allocator &alloc)
+{
+	scale(src, dst, alloc, 0, dst.size().h());
+}
+
+
 /*
  * \deprecated
  */
@@ -70,11 +90,19 @@ static void scale(Genode::Texture<PT> const &src, Genode::Texture<PT> &dst)
 }
 
 
+/**
+ * Convert rows 'first_row' to 'first_row + num_rows - 1' of 'src'
+ *
+ * Distinct row ranges of the same destination may be converted
+ * concurrently.
+ */
 template <typename SRC_PT, typename DST_PT>
 static void convert_pixel_format(Genode::Texture<SRC_PT> const &src,
                                  Genode::Texture<DST_PT>       &dst,
                                  unsigned                       alpha,
-                                 Genode::Allocator             &alloc)
+                                 Genode::Allocator             &alloc,
+                                 unsigned                       first_row,
+                                 unsigned                       num_rows)
 {
 	/* sanity check */
 	if (src.size() != dst.size())
@@ -84,9 +112,10 @@ static void convert_pixel_format(Genode::Texture<SRC_PT> const &src,
 	unsigned char *row = (unsigned char *)alloc.alloc(row_num_bytes);
 
 	/* shortcuts */
-	unsigned const w = dst.size().w(), h = dst.size().h();
+	unsigned const w = dst.size().w();
+	unsigned const h = Genode::min(first_row + num_rows, dst.size().h());
 
-	for (unsigned y = 0, line_offset = 0; y < h; y++, line_offset += w) {
+	for (unsigned y = first_row, line_offset = first_row*w; y < h; y++, line_offset += w) {
 
 		SRC_PT        const *src_pixel = src.pixel() + line_offset;
 		unsigned char const *src_alpha = src.alpha() + line_offset;
@@ -109,6 +138,60 @@ static void convert_pixel_format(Genode::Texture<SRC_PT> const &src,
 }
 
 
+/**
+ * Convert rows of RGB888 texture to RGB565 via the blit library
+ *
+ * The pixels are converted by the vector kernels of the blit library, which
+ * apply the same ordered dithering as 'Dither_painter'.
+ */
+static inline void convert_pixel_format(Genode::Texture<Genode::Pixel_rgb888> const &src,
+                                        Genode::Texture<Genode::Pixel_rgb565>       &dst,
+                                        unsigned                                     alpha,
+                                        Genode::Allocator                           &,
+                                        unsigned                                     first_row,
+                                        unsigned                                     num_rows)
+{
+	/* sanity check */
+	if (src.size() != dst.size())
+		return;
+
+	unsigned const w = dst.size().w();
+	unsigned const h = Genode::min(first_row + num_rows, dst.size().h());
+
+	for (unsigned y = first_row; y < h; y++) {
+
+		Genode::size_t const line_offset = (Genode::size_t)y*w;
+
+		Genode::Dither_matrix::Row const dither_row = Genode::Dither_matrix::row(y);
+
+		unsigned char dither[16];
+		for (unsigned i = 0; i < sizeof(dither); i++)
+			dither[i] = dither_row.value(i) >> 4;
+
+		blit_convert_rgb888_to_rgb565(dst.pixel() + line_offset,
+		                              src.pixel() + line_offset, w, dither, 0);
+
+		if (!dst.alpha())
+			continue;
+
+		unsigned char const *s = src.alpha() + line_offset;
+		unsigned char       *d = dst.alpha() + line_offset;
+		for (unsigned x = 0; x < w; x++)
+			d[x] = (s[x] * alpha) >> 8;
+	}
+}
+
+
+template <typename SRC_PT, typename DST_PT>
+static void convert_pixel_format(Genode::Texture<SRC_PT> const &src,
+                                 Genode::Texture<DST_PT>       &dst,
+                                 unsigned                       alpha,
+                                 Genode::Allocator             &alloc)
+{
+	convert_pixel_format(src, dst, alpha, alloc, 0, dst.size().h());
+}
+
+
 /*
  * deprecated
  */
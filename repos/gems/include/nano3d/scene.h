@@ -293,6 +293,7 @@ class Nano3d::Scene
 		}
 
 		unsigned long elapsed_ms() const { return _timer.elapsed_ms(); }
+		unsigned long elapsed_us() const { return _timer.elapsed_us(); }
 
 		void input_handler(Input_handler *input_handler)
 		{
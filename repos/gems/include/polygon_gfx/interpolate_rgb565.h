@@ -31,6 +31,11 @@ namespace Polygon {
 
 /**
  * Specialization that employs dithering
+ *
+ * The span is processed in steps of four pixels, using the vector
+ * extensions of the compiler, which translates the vector operations into
+ * SSE2 or NEON instructions. The remaining pixels are processed one by one.
+ * Both paths yield the same pixel and alpha values.
  */
 template <>
 inline void Polygon::interpolate_rgba(Color start, Color end, Pixel_rgb565 *dst,
@@ -52,9 +57,66 @@ inline void Polygon::interpolate_rgba(Color start, Color end, Pixel_rgb565 *dst,
 	    b = start.b<<16,
 	    a = start.a<<16;
 
+	Genode::Dither_matrix::Row const dither_row = Genode::Dither_matrix::row(y);
+
+	typedef int Vec __attribute__((vector_size(16)));
+
+	enum { STEP = sizeof(Vec)/sizeof(int) };
+
+	/* same as 'Pixel_rgb565::blend' */
+	auto blend = [] (Vec pixel, Vec alpha) {
+		return ((((alpha >> 3) * (pixel & 0xf81f)) >> 5) & 0xf81f)
+		     | (((alpha * (pixel & 0x07c0)) >> 8) & 0x07c0); };
+
+	Vec const lane = { 0, 1, 2, 3 };
+
+	Vec vr = r + lane*r_ascent,
+	    vg = g + lane*g_ascent,
+	    vb = b + lane*b_ascent,
+	    va = a + lane*a_ascent;
+
+	for ( ; num_values >= STEP; num_values -= STEP, dst += STEP,
+	                            dst_alpha += STEP, x += STEP) {
+
+		Vec const dither_value = { dither_row.value(x)     << 12,
+		                           dither_row.value(x + 1) << 12,
+		                           dither_row.value(x + 2) << 12,
+		                           dither_row.value(x + 3) << 12 };
+
+		Vec const alpha = (va + dither_value) >> 16;
+
+		Vec const src = ((((vr + dither_value) >> 16) << 8) & 0xf800)
+		              | ((((vg + dither_value) >> 16) << 3) & 0x07e0)
+		              | ((((vb + dither_value) >> 16) >> 3) & 0x001f);
+
+		Vec const old_pixel = { dst[0].pixel, dst[1].pixel,
+		                        dst[2].pixel, dst[3].pixel };
+
+		Vec const old_alpha = { dst_alpha[0], dst_alpha[1],
+		                        dst_alpha[2], dst_alpha[3] };
+
+		Vec const pixel = blend(old_pixel, 264 - alpha) + blend(src, alpha);
+
+		Vec const new_alpha = old_alpha
+		                    + (((255 - old_alpha)*(va + dither_value)) >> (16 + 8));
+
+		for (unsigned i = 0; i < STEP; i++) {
+			dst[i].pixel = pixel[i];
+			dst_alpha[i] = new_alpha[i];
+		}
+
+		/* increment color-component values by ascent */
+		vr += r_ascent*STEP;
+		vg += g_ascent*STEP;
+		vb += b_ascent*STEP;
+		va += a_ascent*STEP;
+	}
+
+	r = vr[0]; g = vg[0]; b = vb[0]; a = va[0];
+
 	for ( ; num_values--; dst++, dst_alpha++, x++) {
 
-		int const dither_value = Genode::Dither_matrix::value(x, y) << 12;
+		int const dither_value = dither_row.value(x) << 12;
 
 		/* combine current color value with existing pixel via alpha blending */
 		*dst = Pixel_rgb565::mix(*dst,
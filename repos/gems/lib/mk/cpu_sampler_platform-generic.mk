@@ -1,6 +1,6 @@
 INC_DIR = $(REP_DIR)/src/server/cpu_sampler
 
-SRC_CC = native_cpu.cc
+SRC_CC = native_cpu.cc perf_counter.cc
 
 SHARED_LIB = yes
 
@@ -0,0 +1,10 @@
+REQUIRES = hw
+
+INC_DIR = $(REP_DIR)/src/server/cpu_sampler
+
+SRC_CC = native_cpu.cc perf_counter.cc
+
+SHARED_LIB = yes
+
+vpath native_cpu.cc   $(REP_DIR)/src/lib/cpu_sampler_platform-generic
+vpath perf_counter.cc $(REP_DIR)/src/lib/cpu_sampler_platform-hw
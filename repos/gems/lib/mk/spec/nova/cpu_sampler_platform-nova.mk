@@ -2,8 +2,9 @@ REQUIRES = nova
 
 INC_DIR = $(REP_DIR)/src/server/cpu_sampler
 
-SRC_CC = native_cpu.cc
+SRC_CC = native_cpu.cc perf_counter.cc
 
 SHARED_LIB = yes
 
 vpath %.cc $(REP_DIR)/src/lib/cpu_sampler_platform-nova
+vpath perf_counter.cc $(REP_DIR)/src/lib/cpu_sampler_platform-generic
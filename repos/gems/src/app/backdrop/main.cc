@@ -22,6 +22,7 @@
 #include <nitpicker_gfx/texture_painter.h>
 #include <base/attached_dataspace.h>
 #include <util/reconstructible.h>
+#include <util/list.h>
 #include <os/texture_rgb565.h>
 #include <os/texture_rgb888.h>
 
@@ -34,6 +35,9 @@
 /* libc includes */
 #include <libc/component.h>
 
+/* local includes */
+#include <workers.h>
+
 using namespace Genode;
 
 namespace Backdrop { struct Main; }
@@ -41,6 +45,8 @@ namespace Backdrop { struct Main; }
 
 struct Backdrop::Main
 {
+	typedef Surface_base::Area Area;
+
 	Genode::Env &env;
 
 	Genode::Heap heap { env.ram(), env.rm() };
@@ -117,6 +123,62 @@ struct Backdrop::Main
 
 	Constructible<Buffer> buffer;
 
+	/**
+	 * Image in the pixel format of the screen, ready to be painted
+	 *
+	 * Images are cached across configuration updates. An image is
+	 * identified by the PNG file contents and all parameters that affect
+	 * its pixels. Images that are not used by the most recent
+	 * configuration are discarded.
+	 */
+	struct Cached_image : List<Cached_image>::Element
+	{
+		typedef String<256> Path;
+		typedef String<8>   Scale;
+
+		Path          const path;
+		unsigned long const file_hash;
+		size_t        const file_size;
+		Scale         const scale;
+		Area          const mode_size;
+		unsigned      const alpha;
+
+		Chunky_texture<Pixel_rgb565> texture;
+
+		bool used = true;
+
+		Cached_image(Genode::Env &env, Path const &path,
+		             unsigned long file_hash, size_t file_size,
+		             Scale const &scale, Area mode_size, unsigned alpha,
+		             Area scaled_size)
+		:
+			path(path), file_hash(file_hash), file_size(file_size),
+			scale(scale), mode_size(mode_size), alpha(alpha),
+			texture(env.ram(), env.rm(), scaled_size)
+		{ }
+
+		Area size() const { return texture.Texture_base::size(); }
+
+		bool matches(Path const &p, unsigned long h, size_t s,
+		             Scale const &sc, Area m, unsigned a) const
+		{
+			return path == p && file_hash == h && file_size == s
+			    && scale == sc && mode_size == m && alpha == a;
+		}
+	};
+
+	List<Cached_image> image_cache;
+
+	/**
+	 * Threads used for scaling and pixel conversion
+	 */
+	Workers workers {
+		env, config.xml().attribute_value("threads", ~0U) };
+
+	Cached_image &obtain_image(Xml_node, Area);
+
+	void discard_unused_images();
+
 	Nitpicker::Session::View_handle view_handle = nitpicker.create_view();
 
 	void _update_view()
@@ -163,6 +225,19 @@ struct Backdrop::Main
 };
 
 
+/**
+ * Compute FNV-1a hash of file content
+ */
+static unsigned long file_hash(unsigned char const *data, size_t len)
+{
+	unsigned long hash = 2166136261UL;
+	for (size_t i = 0; i < len; i++)
+		hash = (hash ^ data[i]) * 16777619UL;
+
+	return hash;
+}
+
+
 /**
  * Calculate designated image size with proportional scaling applied
  */
@@ -229,29 +304,97 @@ void Backdrop::Main::paint_texture(Surface<PT> &surface, Texture<PT> const &text
 }
 
 
+Backdrop::Main::Cached_image &
+Backdrop::Main::obtain_image(Xml_node operation, Area mode_size)
+{
+	typedef Cached_image::Path  Path;
+	typedef Cached_image::Scale Scale;
+
+	Path const path = operation.attribute_value("png", Path());
+
+	File file(path.string(), heap);
+
+	unsigned long const hash  = file_hash(file.data<unsigned char>(), file.size());
+	Scale         const scale = operation.attribute_value("scale", Scale());
+	unsigned      const alpha = Decorator::attribute(operation, "alpha", 256U);
+
+	for (Cached_image *image = image_cache.first(); image; image = image->next())
+		if (image->matches(path, hash, file.size(), scale, mode_size, alpha)) {
+			image->used = true;
+			return *image;
+		}
+
+	Png_image png_image(env.ram(), env.rm(), heap, file.data<void>());
+
+	Area const scaled_size = calc_scaled_size(operation, png_image.size(),
+	                                          mode_size);
+
+	/* obtain texture containing the pixels of the PNG image */
+	Texture<Pixel_rgb888> *png_texture = png_image.texture<Pixel_rgb888>();
+
+	/* create texture with the scaled image */
+	Chunky_texture<Pixel_rgb888> scaled_texture(env.ram(), env.rm(), scaled_size);
+	try {
+		workers.apply(scaled_size.h(), [&] (unsigned first_row, unsigned num_rows) {
+			::scale(*png_texture, scaled_texture, heap, first_row, num_rows); });
+	} catch (...) {
+		png_image.release_texture(png_texture);
+		throw;
+	}
+
+	png_image.release_texture(png_texture);
+
+	/*
+	 * Code specific for the screen mode's pixel format
+	 */
+
+	/* create texture with down-sampled scaled image */
+	Cached_image &image = *new (heap)
+		Cached_image(env, path, hash, file.size(), scale, mode_size, alpha,
+		             scaled_size);
+	try {
+		workers.apply(scaled_size.h(), [&] (unsigned first_row, unsigned num_rows) {
+			convert_pixel_format(scaled_texture, image.texture, alpha, heap,
+			                     first_row, num_rows); });
+	} catch (...) {
+		destroy(heap, &image);
+		throw;
+	}
+
+	image_cache.insert(&image);
+	return image;
+}
+
+
+void Backdrop::Main::discard_unused_images()
+{
+	Cached_image *next = nullptr;
+	for (Cached_image *image = image_cache.first(); image; image = next) {
+		next = image->next();
+
+		if (!image->used) {
+			image_cache.remove(image);
+			destroy(heap, image);
+		}
+	}
+}
+
+
 void Backdrop::Main::apply_image(Xml_node operation)
 {
 	typedef Surface_base::Point Point;
-	typedef Surface_base::Area  Area;
 
 	if (!operation.has_attribute("png")) {
 		Genode::warning("missing 'png' attribute in <image> node");
 		return;
 	}
 
-	char png_file_name[256];
-	png_file_name[0] = 0;
-	operation.attribute("png").value(png_file_name, sizeof(png_file_name));
-
-	File file(png_file_name, heap);
-
 	Anchor anchor(operation);
 
-	Png_image png_image(env.ram(), env.rm(), heap, file.data<void>());
+	Cached_image &image = obtain_image(operation, Area(buffer->mode.width(),
+	                                                   buffer->mode.height()));
 
-	Area const scaled_size = calc_scaled_size(operation, png_image.size(),
-	                                          Area(buffer->mode.width(),
-	                                               buffer->mode.height()));
+	Area const scaled_size = image.size();
 	/*
 	 * Determine parameters of graphics operation
 	 */
@@ -274,29 +417,10 @@ void Backdrop::Main::apply_image(Xml_node operation)
 
 	bool const tiled = operation.attribute_value("tiled", false);
 
-	unsigned alpha = Decorator::attribute(operation, "alpha", 256U);
-
-	/* obtain texture containing the pixels of the PNG image */
-	Texture<Pixel_rgb888> *png_texture = png_image.texture<Pixel_rgb888>();
-
-	/* create texture with the scaled image */
-	Chunky_texture<Pixel_rgb888> scaled_texture(env.ram(), env.rm(), scaled_size);
-	scale(*png_texture, scaled_texture, heap);
-
-	png_image.release_texture(png_texture);
-
-	/*
-	 * Code specific for the screen mode's pixel format
-	 */
-
-	/* create texture with down-sampled scaled image */
-	typedef Pixel_rgb565 PT;
-	Chunky_texture<PT> texture(env.ram(), env.rm(), scaled_size);
-	convert_pixel_format(scaled_texture, texture, alpha, heap);
-
 	/* paint texture onto surface */
+	typedef Pixel_rgb565 PT;
 	Surface<PT> surface = buffer->surface<PT>();
-	paint_texture(surface, texture, pos, tiled);
+	paint_texture(surface, image.texture, pos, tiled);
 }
 
 
@@ -327,6 +451,9 @@ void Backdrop::Main::handle_config()
 	/* clear surface */
 	apply_fill(Xml_node("<fill color=\"#000000\"/>"));
 
+	for (Cached_image *image = image_cache.first(); image; image = image->next())
+		image->used = false;
+
 	/* apply graphics primitives defined in the config */
 	try {
 		for (unsigned i = 0; i < config.xml().num_sub_nodes(); i++) {
@@ -348,6 +475,8 @@ void Backdrop::Main::handle_config()
 		}
 	} catch (...) { /* ignore failure to obtain config */ }
 
+	discard_unused_images();
+
 	/* schedule buffer refresh */
 	nitpicker.framebuffer()->sync_sigh(sync_handler);
 }
@@ -0,0 +1,165 @@
+/*
+ * \brief  Pool of threads for processing image rows in parallel
+ * \author Genode Labs
+ * \date   2026-10-14
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _WORKERS_H_
+#define _WORKERS_H_
+
+/* Genode includes */
+#include <base/thread.h>
+#include <base/semaphore.h>
+#include <util/reconstructible.h>
+#include <util/noncopyable.h>
+#include <base/exception.h>
+
+namespace Backdrop { class Workers; }
+
+
+/**
+ * Threads that split the rows of an image operation into bands
+ *
+ * One worker thread is created per additional CPU. The calling thread
+ * processes the first band itself. The workers must not use the C runtime.
+ */
+class Backdrop::Workers : Genode::Noncopyable
+{
+	private:
+
+		enum { MAX_THREADS = 8, STACK_SIZE = 16*1024 };
+
+		struct Job
+		{
+			virtual void execute(unsigned first_row, unsigned num_rows) = 0;
+		};
+
+		class Worker : public Genode::Thread
+		{
+			private:
+
+				Workers           &_workers;
+				unsigned const     _band;
+				Genode::Semaphore  _start { };
+
+				void entry() override
+				{
+					for (;;) {
+						_start.down();
+						try { _workers._execute(_band); }
+						catch (...) { _workers._failed = true; }
+						_workers._done.up();
+					}
+				}
+
+			public:
+
+				Worker(Genode::Env &env, Workers &workers, unsigned band,
+				       Genode::Affinity::Location location)
+				:
+					Genode::Thread(env, "worker", STACK_SIZE, location,
+					               Weight(), env.cpu()),
+					_workers(workers), _band(band)
+				{
+					start();
+				}
+
+				void kick() { _start.up(); }
+		};
+
+		Genode::Constructible<Worker> _workers[MAX_THREADS - 1];
+
+		unsigned _num_bands = 1;
+
+		Genode::Semaphore _done { };
+
+		Job     *_job    = nullptr;
+		unsigned _rows   = 0;
+		bool     _failed = false;
+
+		void _execute(unsigned band)
+		{
+			unsigned const rows_per_band = (_rows + _num_bands - 1)/_num_bands;
+			unsigned const first_row     = band*rows_per_band;
+
+			if (first_row < _rows)
+				_job->execute(first_row, Genode::min(rows_per_band,
+				                                     _rows - first_row));
+		}
+
+	public:
+
+		struct Job_failed : Genode::Exception { };
+
+		/**
+		 * Constructor
+		 *
+		 * \param max_threads  upper bound for the number of threads
+		 *                     including the calling thread
+		 */
+		Workers(Genode::Env &env, unsigned max_threads)
+		{
+			Genode::Affinity::Space cpus = env.cpu().affinity_space();
+
+			unsigned const num_threads =
+				Genode::max(1U, Genode::min(Genode::min(cpus.total(), max_threads),
+				                            (unsigned)MAX_THREADS));
+
+			for (unsigned i = 1; i < num_threads; i++) {
+				_workers[i - 1].construct(env, *this, i, cpus.location_of_index(i));
+				_num_bands = i + 1;
+			}
+		}
+
+		unsigned num_threads() const { return _num_bands; }
+
+		/**
+		 * Call 'fn(first_row, num_rows)' for disjoint bands of 'rows' rows
+		 *
+		 * The method returns after all bands are processed.
+		 *
+		 * \throw Job_failed  'fn' threw an exception for any band
+		 */
+		template <typename FN>
+		void apply(unsigned rows, FN const &fn)
+		{
+			struct Fn_job : Job
+			{
+				FN const &fn;
+
+				Fn_job(FN const &fn) : fn(fn) { }
+
+				void execute(unsigned first_row, unsigned num_rows) override {
+					fn(first_row, num_rows); }
+
+			} job(fn);
+
+			_job  = &job;
+			_rows = rows;
+
+			for (unsigned i = 0; i < _num_bands - 1; i++)
+				_workers[i]->kick();
+
+			try { _execute(0); }
+			catch (...) { _failed = true; }
+
+			for (unsigned i = 0; i < _num_bands - 1; i++)
+				_done.down();
+
+			_job = nullptr;
+
+			if (_failed) {
+				_failed = false;
+				throw Job_failed();
+			}
+		}
+};
+
+#endif /* _WORKERS_H_ */
@@ -105,6 +105,24 @@ struct Decorator::Main : Window_factory_base
 	Signal_handler<Main> _nitpicker_sync_handler = {
 		_env.ep(), *this, &Main::_handle_nitpicker_sync };
 
+	bool _sync_enabled = false;
+
+	/**
+	 * Enable or disable the delivery of nitpicker sync signals
+	 *
+	 * Sync signals are needed only while a window-layout update is pending
+	 * or an animation is in progress.
+	 */
+	void _enable_sync(bool enabled)
+	{
+		if (enabled == _sync_enabled)
+			return;
+
+		_nitpicker.framebuffer()->sync_sigh(enabled ? _nitpicker_sync_handler
+		                                            : Signal_context_capability());
+		_sync_enabled = enabled;
+	}
+
 	Heap _heap { _env.ram(), _env.rm() };
 
 	Attached_rom_dataspace _config { _env, "config" };
@@ -127,7 +145,6 @@ struct Decorator::Main : Window_factory_base
 		_window_layout.sigh(_window_layout_handler);
 		_pointer.sigh(_pointer_handler);
 
-		_nitpicker.framebuffer()->sync_sigh(_nitpicker_sync_handler);
 
 		_hover_reporter.enabled(true);
 
@@ -252,6 +269,8 @@ void Decorator::Main::_handle_window_layout_update()
 	_window_layout.update();
 
 	_window_layout_update_needed = true;
+
+	_enable_sync(true);
 }
 
 
@@ -300,13 +319,17 @@ void Decorator::Main::_handle_nitpicker_sync()
 	 * 'frame_period', we update the animation as often as the nitpicker
 	 * sync signal occurs.
 	 */
-	for (unsigned i = 0; i < _frame_period; i++)
-		_animator.animate();
+	_animator.animate(_frame_period);
+
+	/* become idle until the next window-layout update */
+	if (!_animator.active()
+	 && !(_window_layout_update_needed && _window_layout.valid()))
+		_enable_sync(false);
 
 	if (!model_updated && !windows_animated)
 		return;
 
-	Dirty_rect dirty = _window_stack.draw(_canvas);
+	Dirty_region dirty = _window_stack.draw(_canvas);
 
 	_window_stack.update_nitpicker_views();
 
@@ -224,8 +224,11 @@ bool Decorator::Window::update(Genode::Xml_node window_node)
 		updated |= true;
 	}
 
-	_focused   = window_node.attribute_value(  "focused", false);
-	_has_alpha = window_node.attribute_value("has_alpha", false);
+	_focused = window_node.attribute_value("focused", false);
+
+	bool const has_alpha = window_node.attribute_value("has_alpha", false);
+	updated |= _has_alpha != has_alpha;
+	_has_alpha = has_alpha;
 
 	Window_title title = Decorator::string_attribute(window_node, "title",
 	                                                 Window_title("<untitled>"));
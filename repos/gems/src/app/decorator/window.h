@@ -434,6 +434,8 @@ class Decorator::Window : public Window_base
 			outer_geometry().cut(geometry(), top, left, right, bottom);
 		}
 
+		bool opaque() const override { return !_has_alpha; }
+
 		bool in_front_of(Window_base const &neighbor) const override
 		{
 			return _neighbor == neighbor.frontmost_view();
@@ -13,19 +13,124 @@
 
 /* Genode includes */
 #include <base/component.h>
+#include <base/heap.h>
 #include <base/attached_rom_dataspace.h>
 #include <os/reporter.h>
 
 namespace Depot_deploy {
 	using namespace Genode;
+	struct Digest;
+	struct Heap_buffer;
+	struct Start_node;
 	struct Main;
 }
 
 
+/**
+ * FNV-1a hash of generated or imported XML data
+ */
+struct Depot_deploy::Digest
+{
+	uint64_t value = 0xcbf29ce484222325ULL;
+
+	void add(char const *s, size_t n)
+	{
+		for (; n--; s++)
+			value = (value ^ (unsigned char)*s) * 0x100000001b3ULL;
+	}
+
+	void add(Xml_node node) { add(node.addr(), node.size()); }
+
+	bool operator != (Digest const &other) const { return value != other.value; }
+};
+
+
+/**
+ * Buffer for generating XML data of unknown size
+ */
+struct Depot_deploy::Heap_buffer : Xml_generator::Expanding_buffer, Noncopyable
+{
+	Allocator &_alloc;
+
+	Heap_buffer(Allocator &alloc, size_t initial_size) : _alloc(alloc)
+	{
+		base = (char *)_alloc.alloc(initial_size);
+		size = initial_size;
+	}
+
+	~Heap_buffer() { _alloc.free(base, size); }
+
+	bool expand(size_t min_size) override
+	{
+		size_t new_size = size;
+		while (new_size < min_size)
+			new_size *= 2;
+
+		char *new_base = nullptr;
+		if (!_alloc.alloc(new_size, &new_base))
+			return false;
+
+		memcpy(new_base, base, size);
+		_alloc.free(base, size);
+
+		base = new_base;
+		size = new_size;
+		return true;
+	}
+};
+
+
+/**
+ * Generated '<start>' node of a pkg
+ *
+ * The node is regenerated only if the pkg blueprint or the common routes
+ * changed.
+ */
+struct Depot_deploy::Start_node : List<Start_node>::Element, Noncopyable
+{
+	typedef String<128> Name;
+
+	Allocator &_alloc;
+
+	Name const name;
+
+	Digest _digest { };
+
+	char  *_text = nullptr;
+	size_t _len  = 0;
+
+	/* set if the pkg is present in the current blueprint */
+	bool present = false;
+
+	Start_node(Allocator &alloc, Name const &name) : _alloc(alloc), name(name) { }
+
+	~Start_node() { if (_text) _alloc.free(_text, _len); }
+
+	bool up_to_date(Digest const &digest) const {
+		return _text && !(digest != _digest); }
+
+	void update(Digest const &digest, char const *text, size_t len)
+	{
+		if (_text)
+			_alloc.free(_text, _len);
+
+		_text = (char *)_alloc.alloc(len);
+		_len  = len;
+		memcpy(_text, text, len);
+
+		_digest = digest;
+	}
+
+	void append_to(Xml_generator &xml) const { xml.append(_text, _len); }
+};
+
+
 struct Depot_deploy::Main
 {
 	Env &_env;
 
+	Heap _heap { _env.ram(), _env.rm() };
+
 	Attached_rom_dataspace _config    { _env, "config" };
 	Attached_rom_dataspace _blueprint { _env, "blueprint" };
 
@@ -34,8 +139,37 @@ struct Depot_deploy::Main
 	Signal_handler<Main> _config_handler {
 		_env.ep(), *this, &Main::_handle_config };
 
-	typedef String<128> Name;
-	typedef String<80>  Binary;
+	typedef Start_node::Name Name;
+	typedef String<80>       Binary;
+
+	List<Start_node> _start_nodes { };
+
+	/* digest of the most recently reported init configuration */
+	Digest _reported { };
+	bool   _reported_valid = false;
+
+	Start_node &_start_node(Name const &name)
+	{
+		for (Start_node *s = _start_nodes.first(); s; s = s->next())
+			if (s->name == name)
+				return *s;
+
+		Start_node &s = *new (_heap) Start_node(_heap, name);
+		_start_nodes.insert(&s);
+		return s;
+	}
+
+	void _destroy_absent_start_nodes()
+	{
+		for (Start_node *s = _start_nodes.first(); s; ) {
+			Start_node *next = s->next();
+			if (!s->present) {
+				_start_nodes.remove(s);
+				destroy(_heap, s);
+			}
+			s = next;
+		}
+	}
 
 	/**
 	 * Generate start node of init configuration
@@ -54,7 +188,18 @@ struct Depot_deploy::Main
 		Xml_node const config    = _config.xml();
 		Xml_node const blueprint = _blueprint.xml();
 
-		Reporter::Xml_generator xml(_init_config_reporter, [&] () {
+		Xml_node const common = config.sub_node("common_routes");
+
+		for (Start_node *s = _start_nodes.first(); s; s = s->next())
+			s->present = false;
+
+		Heap_buffer buffer(_heap, 16*1024);
+
+		/*
+		 * The start nodes are generated in the order of the blueprint, which
+		 * keeps the generated configuration stable across updates.
+		 */
+		Xml_generator xml(buffer, "config", [&] () {
 
 			Xml_node static_config = config.sub_node("static");
 			xml.append(static_config.content_base(), static_config.content_size());
@@ -78,16 +223,48 @@ struct Depot_deploy::Main
 					return;
 				}
 
-				xml.node("start", [&] () {
-					_gen_start_node(xml, pkg, config.sub_node("common_routes"));
-				});
+				Start_node &start = _start_node(name);
+
+				if (start.present) {
+					warning("skipping duplicate <pkg> node for '", name, "'");
+					return;
+				}
+				start.present = true;
+
+				Digest digest;
+				digest.add(pkg);
+				digest.add(common);
+
+				if (!start.up_to_date(digest)) {
+					Heap_buffer start_buffer(_heap, 4096);
+					Xml_generator start_xml(start_buffer, "start", [&] () {
+						_gen_start_node(start_xml, pkg, common); });
+
+					start.update(digest, start_buffer.base, start_xml.used());
+				}
+
+				start.append_to(xml);
 			});
 		});
+
+		_destroy_absent_start_nodes();
+
+		/* omit the report if the configuration did not change */
+		Digest digest;
+		digest.add(buffer.base, xml.used());
+
+		if (_reported_valid && !(digest != _reported))
+			return;
+
+		_init_config_reporter.report(buffer.base, xml.used());
+		_reported       = digest;
+		_reported_valid = true;
 	}
 
 	Main(Env &env) : _env(env)
 	{
 		_init_config_reporter.enabled(true);
+		_init_config_reporter.expanding(true);
 
 		_config   .sigh(_config_handler);
 		_blueprint.sigh(_config_handler);
@@ -15,12 +15,15 @@
 #include <base/component.h>
 #include <base/heap.h>
 #include <base/attached_rom_dataspace.h>
+#include <util/avl_string.h>
 #include <os/reporter.h>
 #include <gems/vfs.h>
 
 namespace Depot_query {
 	using namespace Genode;
 	struct Archive;
+	struct Pkg_archives;
+	struct Archive_cache;
 	struct Main;
 }
 
@@ -95,6 +98,118 @@ struct Depot_query::Archive
 };
 
 
+/**
+ * Content of the 'archives' file of a pkg archive
+ */
+struct Depot_query::Pkg_archives : Avl_string<Archive::Path::capacity()>
+{
+	struct Element : List<Element>::Element
+	{
+		Archive::Path const path;
+
+		Element(Archive::Path const &path) : path(path) { }
+	};
+
+	Allocator &_alloc;
+
+	List<Element> _archives;
+
+	void _destroy_elements()
+	{
+		while (Element *e = _archives.first()) {
+			_archives.remove(e);
+			destroy(_alloc, e);
+		}
+	}
+
+	/**
+	 * Constructor
+	 *
+	 * \throw Directory::Nonexistent_directory
+	 * \throw Directory::Nonexistent_file
+	 * \throw File::Truncated_during_read
+	 */
+	Pkg_archives(Allocator &alloc, Directory &depot_dir,
+	             Archive::Path const &pkg_path)
+	:
+		Avl_string(pkg_path.string()), _alloc(alloc)
+	{
+		Directory pkg_dir(depot_dir, Directory::Path(pkg_path));
+
+		File_content archives(_alloc, pkg_dir, "archives",
+		                      File_content::Limit{16*1024});
+
+		/* preserve the order of the archives */
+		Element *last = nullptr;
+		try {
+			archives.for_each_line<Archive::Path>([&] (Archive::Path const &path) {
+				if (!path.valid())
+					return;
+
+				Element *e = new (_alloc) Element(path);
+				_archives.insert(e, last);
+				last = e;
+			});
+		}
+		catch (...) { _destroy_elements(); throw; }
+	}
+
+	~Pkg_archives() { _destroy_elements(); }
+
+	template <typename FN>
+	void for_each(FN const &fn) const
+	{
+		for (Element const *e = _archives.first(); e; e = e->next())
+			fn(e->path);
+	}
+};
+
+
+/**
+ * Cache of the content of pkg archives
+ *
+ * A pkg archive of a given version is never modified. Hence, the content
+ * of its 'archives' file is read only once and kept across queries.
+ */
+struct Depot_query::Archive_cache : Noncopyable
+{
+	Allocator &_alloc;
+
+	Avl_tree<Avl_string_base> _pkgs { };
+
+	Archive_cache(Allocator &alloc) : _alloc(alloc) { }
+
+	~Archive_cache()
+	{
+		while (Avl_string_base *pkg = _pkgs.first()) {
+			_pkgs.remove(pkg);
+			destroy(_alloc, static_cast<Pkg_archives *>(pkg));
+		}
+	}
+
+	/**
+	 * Return content of the pkg archive, read from the depot if not cached
+	 *
+	 * \throw Directory::Nonexistent_directory
+	 * \throw Directory::Nonexistent_file
+	 * \throw File::Truncated_during_read
+	 */
+	Pkg_archives const &pkg_archives(Directory &depot_dir,
+	                                 Archive::Path const &pkg_path)
+	{
+		if (_pkgs.first()) {
+			Avl_string_base *pkg = _pkgs.first()->find_by_name(pkg_path.string());
+			if (pkg)
+				return *static_cast<Pkg_archives *>(pkg);
+		}
+
+		Pkg_archives &pkg = *new (_alloc) Pkg_archives(_alloc, depot_dir, pkg_path);
+		_pkgs.insert(&pkg);
+		return pkg;
+	}
+};
+
+
 struct Depot_query::Main
 {
 	Env &_env;
@@ -108,6 +223,8 @@ struct Depot_query::Main
 	Signal_handler<Main> _config_handler {
 		_env.ep(), *this, &Main::_handle_config };
 
+	Archive_cache _archive_cache { _heap };
+
 	Reporter _directory_reporter { _env, "directory" };
 	Reporter _blueprint_reporter { _env, "blueprint" };
 
@@ -116,7 +233,8 @@ struct Depot_query::Main
 
 	Architecture _architecture;
 
-	Archive::Path _find_rom_in_pkg(Directory::Path const &pkg_path,
+	Archive::Path _find_rom_in_pkg(Directory             &depot_dir,
+	                               Archive::Path   const &pkg_path,
 	                               Rom_label       const &rom_label,
 	                               unsigned        const  nesting_level);
 
@@ -180,7 +298,8 @@ void Depot_query::Main::_scan_depot_user_pkg(Archive::User const &user,
 
 
 Depot_query::Archive::Path
-Depot_query::Main::_find_rom_in_pkg(Directory::Path const &pkg_path,
+Depot_query::Main::_find_rom_in_pkg(Directory             &depot_dir,
+                                    Archive::Path   const &pkg_path,
                                     Rom_label       const &rom_label,
                                     unsigned        const  nesting_level)
 {
@@ -191,19 +310,15 @@ Depot_query::Main::_find_rom_in_pkg(Directory::Path const &pkg_path,
 
 	/*
 	 * \throw Directory::Nonexistent_directory
-	 */
-	Directory depot_dir(_root, Directory::Path("depot"));
-	Directory pkg_dir(depot_dir, pkg_path);
-
-	/*
 	 * \throw Directory::Nonexistent_file
 	 * \throw File::Truncated_during_read
 	 */
-	File_content archives(_heap, pkg_dir, "archives", File_content::Limit{16*1024});
+	Pkg_archives const &archives =
+		_archive_cache.pkg_archives(depot_dir, pkg_path);
 
 	Archive::Path result;
 
-	archives.for_each_line<Archive::Path>([&] (Archive::Path const &archive_path) {
+	archives.for_each([&] (Archive::Path const &archive_path) {
 
 		/*
 		 * \throw Archive::Unknown_archive_type
@@ -223,12 +338,21 @@ Depot_query::Main::_find_rom_in_pkg(Directory::Path const &pkg_path,
 			break;
 
 		case Archive::RAW:
-			log(" ", archive_path, " (raw-data archive)");
 			break;
 
 		case Archive::PKG:
-			// XXX call recursively, adjust 'nesting_level'
-			log(" ", archive_path, " (pkg archive)");
+			{
+				/* ROMs of the pkg itself take precedence */
+				if (result.valid())
+					break;
+
+				Archive::Path const rom_path =
+					_find_rom_in_pkg(depot_dir, archive_path, rom_label,
+					                 nesting_level - 1);
+
+				if (rom_path.valid())
+					result = rom_path;
+			}
 			break;
 		}
 	});
@@ -238,7 +362,8 @@ Depot_query::Main::_find_rom_in_pkg(Directory::Path const &pkg_path,
 
 void Depot_query::Main::_query_pkg(Directory::Path const &pkg_path, Xml_generator &xml)
 {
-	Directory pkg_dir(_root, Directory::Path("depot/", pkg_path));
+	Directory depot_dir(_root, Directory::Path("depot"));
+	Directory pkg_dir(depot_dir, pkg_path);
 
 	File_content runtime(_heap, pkg_dir, "runtime", File_content::Limit{16*1024});
 
@@ -276,7 +401,7 @@ void Depot_query::Main::_query_pkg(Directory::Path const &pkg_path, Xml_generato
 
 				unsigned const max_nesting_levels = 8;
 				Archive::Path const rom_path =
-					_find_rom_in_pkg(pkg_path, label, max_nesting_levels);
+					_find_rom_in_pkg(depot_dir, pkg_path, label, max_nesting_levels);
 
 				if (rom_path.valid()) {
 					xml.node("rom", [&] () {
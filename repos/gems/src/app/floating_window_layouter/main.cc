@@ -16,6 +16,7 @@
 #include <base/signal.h>
 #include <base/component.h>
 #include <base/attached_rom_dataspace.h>
+#include <base/attached_shared_rom_dataspace.h>
 #include <base/heap.h>
 #include <base/tslab.h>
 #include <os/reporter.h>
@@ -232,7 +233,8 @@ struct Floating_window_layouter::Main : Operations
 	Signal_handler<Main> hover_dispatcher = {
 		env.ep(), *this, &Main::handle_hover_update };
 
-	Attached_rom_dataspace hover { env, "hover" };
+	/* the hover model changes with each pointer motion */
+	Attached_shared_rom_dataspace hover { env, "hover" };
 
 
 	/**
@@ -156,6 +156,8 @@ struct Menu_view::Button_widget : Widget, Animator::Item
 		blend.animate();
 
 		animated(blend != blend.dst());
+
+		_mark_as_dirty();
 	}
 };
 
@@ -655,6 +655,9 @@ struct Menu_view::Depgraph_widget : Widget
 		_draw_children(pixel_surface, alpha_surface, at);
 	}
 
+	/* connections are drawn according to the child positions */
+	bool _draws_children_dependent() const override { return true; }
+
 	void _layout() override
 	{
 		for (Widget *w = _children.first(); w; w = w->next())
@@ -28,6 +28,8 @@ struct Menu_view::Label_widget : Widget
 	typedef String<200> Text;
 	Text text;
 
+	Area _min_size { }; /* value cached from update */
+
 	Label_widget(Widget_factory &factory, Xml_node node, Unique_id unique_id)
 	:
 		Widget(factory, node, unique_id)
@@ -37,15 +39,15 @@ struct Menu_view::Label_widget : Widget
 	{
 		font = _factory.styles.font(node, "font");
 		text = Decorator::string_attribute(node, "text", Text(""));
+
+		_min_size = font ? Area(font->str_w(text.string()),
+		                        font->str_h(text.string()))
+		                 : Area(0, 0);
 	}
 
 	Area min_size() const override
 	{
-		if (!font)
-			return Area(0, 0);
-
-		return Area(font->str_w(text.string()),
-		            font->str_h(text.string()));
+		return _min_size;
 	}
 
 	void draw(Surface<Pixel_rgb888> &pixel_surface,
@@ -25,6 +25,7 @@
 #include <input/event.h>
 #include <os/reporter.h>
 #include <timer_session/connection.h>
+#include <util/dirty_rect.h>
 
 /* gems includes */
 #include <gems/nitpicker_buffer.h>
@@ -98,7 +99,7 @@ struct Menu_view::Main
 		_env.ep(), *this, &Main::_handle_input};
 
 	/*
-	 * Timer used for animating widgets
+	 * Timer used for determining the number of animation frames passed
 	 */
 	struct Frame_timer : Timer::Connection
 	{
@@ -106,23 +107,46 @@ struct Menu_view::Main
 
 		unsigned curr_frame() const { return elapsed_ms() / PERIOD; }
 
-		void schedule() { trigger_once(Frame_timer::PERIOD*1000); }
-
 		Frame_timer(Env &env) : Timer::Connection(env) { }
 
 	} _timer { _env };
 
-	void _handle_frame_timer();
+	void _handle_frame();
+
+	/*
+	 * Frames are processed in the pace of the nitpicker sync signal
+	 */
+	Signal_handler<Main> _frame_handler = {
+		_env.ep(), *this, &Main::_handle_frame};
+
+	bool _frame_sync_enabled = false;
+
+	/**
+	 * Enable sync signals while an animation or redraw is pending
+	 */
+	void _enable_frame_sync(bool enabled)
+	{
+		if (enabled == _frame_sync_enabled)
+			return;
 
-	Signal_handler<Main> _frame_timer_handler = {
-		_env.ep(), *this, &Main::_handle_frame_timer};
+		_nitpicker.framebuffer()->sync_sigh(enabled ? _frame_handler
+		                                            : Signal_context_capability());
+		_frame_sync_enabled = enabled;
+	}
 
 	Genode::Reporter _hover_reporter = { _env, "hover" };
 
 	bool _schedule_redraw = false;
 
+	/*
+	 * Areas of the buffer that must be redrawn
+	 */
+	typedef Genode::Dirty_rect<Rect, 3> Dirty_rect;
+
+	Dirty_rect _dirty_rect { };
+
 	/**
-	 * Frame of last call of 'handle_frame_timer'
+	 * Frame of last call of '_handle_frame'
 	 */
 	unsigned _last_frame = 0;
 
@@ -145,8 +169,6 @@ struct Menu_view::Main
 
 		_nitpicker.input()->sigh(_input_handler);
 
-		_timer.sigh(_frame_timer_handler);
-
 		/* apply initial configuration */
 		_handle_config();
 	}
@@ -164,7 +186,7 @@ void Menu_view::Main::_handle_dialog_update()
 	try {
 		Xml_node dialog_xml(_dialog_rom.local_addr<char>());
 
-		_root_widget.update(dialog_xml);
+		_root_widget.apply(dialog_xml);
 		_root_widget.size(_root_widget.min_size());
 	} catch (...) {
 		Genode::error("failed to construct widget tree");
@@ -183,9 +205,9 @@ void Menu_view::Main::_handle_dialog_update()
 		if (curr_frame - _last_frame > 10)
 			_last_frame = curr_frame;
 
-		_handle_frame_timer();
+		_handle_frame();
 	} else {
-		_timer.schedule();
+		_enable_frame_sync(true);
 	}
 }
 
@@ -241,7 +263,7 @@ void Menu_view::Main::_handle_input()
 }
 
 
-void Menu_view::Main::_handle_frame_timer()
+void Menu_view::Main::_handle_frame()
 {
 	_frame_cnt++;
 
@@ -269,36 +291,54 @@ void Menu_view::Main::_handle_frame_timer()
 		Area const old_size = _buffer.constructed() ? _buffer->size() : Area();
 		Area const size     = _root_widget.min_size();
 
-		if (!_buffer.constructed() || size.w() > old_size.w() || size.h() > old_size.h())
+		bool const full_redraw = !_buffer.constructed()
+		                      || size.w() > old_size.w() || size.h() > old_size.h();
+		if (full_redraw)
 			_buffer.construct(_nitpicker, size, _env.ram(), _env.rm());
-		else
-			_buffer->reset_surface();
 
 		_root_widget.size(size);
 		_root_widget.position(Point(0, 0));
 
-		Surface<Pixel_rgb888> pixel_surface = _buffer->pixel_surface();
-		Surface<Pixel_alpha8> alpha_surface = _buffer->alpha_surface();
+		/*
+		 * Redraw only the areas of changed, moved, or removed widgets.
+		 * The damage is collected in any case to keep track of the drawn
+		 * widget positions.
+		 */
+		_root_widget.collect_damage([&] (Rect const &rect) {
+			_dirty_rect.mark_as_dirty(rect); });
+
+		if (full_redraw)
+			_dirty_rect.mark_as_dirty(Rect(Point(0, 0), _buffer->size()));
+
+		_dirty_rect.flush([&] (Rect const &rect) {
+
+			_buffer->reset_surface(rect);
+
+			Surface<Pixel_rgb888> pixel_surface = _buffer->pixel_surface();
+			Surface<Pixel_alpha8> alpha_surface = _buffer->alpha_surface();
+
+			pixel_surface.clip(rect);
+			alpha_surface.clip(rect);
+
+			_root_widget.draw(pixel_surface, alpha_surface, Point(0, 0));
 
-		// XXX restrict redraw to dirty regions
-		//     don't perform a full dialog update
-		_root_widget.draw(pixel_surface, alpha_surface, Point(0, 0));
+			_buffer->flush_surface(rect);
+			_nitpicker.framebuffer()->refresh(rect.x1(), rect.y1(),
+			                                  rect.w(), rect.h());
+		});
 
-		_buffer->flush_surface();
-		_nitpicker.framebuffer()->refresh(0, 0, _buffer->size().w(), _buffer->size().h());
 		_update_view();
 
 		_schedule_redraw = false;
 	}
 
 	/*
-	 * Deactivate timer periods when idle, activate timer when an animation is
-	 * in progress or a redraw is pending.
+	 * Stop processing frames when idle, keep processing frames while an
+	 * animation is in progress or a redraw is pending.
 	 */
 	bool const redraw_pending = _schedule_redraw && _frame_cnt != 0;
 
-	if (_animator.active() || redraw_pending)
-		_timer.schedule();
+	_enable_frame_sync(_animator.active() || redraw_pending);
 }
 
 
@@ -63,6 +63,23 @@ struct Menu_view::Root_widget : Widget
 		return Area(1, 1);
 	}
 
+	/**
+	 * Report areas that must be redrawn since the last call
+	 *
+	 * The root widget is located at the origin of the buffer.
+	 */
+	template <typename FN>
+	void collect_damage(FN const &fn)
+	{
+		for (Widget *w = _children.first(); w; w = w->next())
+			w->collect_damage(Point(0, 0), fn);
+
+		if (_vacated.valid()) {
+			fn(_vacated);
+			_vacated = Rect();
+		}
+	}
+
 	void draw(Surface<Pixel_rgb888> &pixel_surface,
 	          Surface<Pixel_alpha8> &alpha_surface,
 	          Point at) const
@@ -95,8 +95,47 @@ class Menu_view::Widget : public List<Widget>::Element
 
 		Unique_id const _unique_id;
 
+		/*
+		 * Digests of the XML node applied last, used to skip the update of
+		 * unchanged subtrees
+		 */
+		typedef uint64_t Digest;
+
+		Digest _tree_digest = 0;  /* node including all sub nodes */
+		Digest _own_digest  = 0;  /* start tag with the attributes */
+
+		static Digest _digest(char const *s, size_t len)
+		{
+			/* FNV-1a */
+			Digest d = 0xcbf29ce484222325ULL;
+			for (size_t i = 0; i < len; i++)
+				d = (d ^ (unsigned char)s[i]) * 0x100000001b3ULL;
+			return d;
+		}
+
 	protected:
 
+		/* layout must be recomputed even if the size remains unchanged */
+		bool _layout_needed = true;
+		Area _layout_size { };
+
+		bool _needs_redraw = true;
+
+		/* absolute position of the widget when it was drawn the last time */
+		Rect _drawn { };
+
+		/* area of removed child widgets */
+		Rect _vacated { };
+
+		void _vacate(Rect rect)
+		{
+			if (rect.valid())
+				_vacated = _vacated.valid() ? Rect::compound(_vacated, rect) : rect;
+		}
+
+		static bool _equal(Rect a, Rect b) { return a.p1() == b.p1() && a.p2() == b.p2(); }
+
+
 		Widget_factory &_factory;
 
 		List<Widget> _children;
@@ -104,10 +143,16 @@ class Menu_view::Widget : public List<Widget>::Element
 		struct Model_update_policy : List_model_update_policy<Widget>
 		{
 			Widget_factory &_factory;
+			Widget         &_owner;
 
-			Model_update_policy(Widget_factory &factory) : _factory(factory) { }
+			Model_update_policy(Widget_factory &factory, Widget &owner)
+			: _factory(factory), _owner(owner) { }
 
-			void destroy_element(Widget &w) { _factory.destroy(&w); }
+			void destroy_element(Widget &w)
+			{
+				_owner._vacate(w._drawn);
+				_factory.destroy(&w);
+			}
 
 			Widget &create_element(Xml_node elem_node)
 			{
@@ -117,7 +162,7 @@ class Menu_view::Widget : public List<Widget>::Element
 				throw Unknown_element_type();
 			}
 
-			void update_element(Widget &w, Xml_node node) { w.update(node); }
+			void update_element(Widget &w, Xml_node node) { w.apply(node); }
 
 			static bool element_matches_xml_node(Widget const &w, Xml_node node)
 			{
@@ -125,7 +170,7 @@ class Menu_view::Widget : public List<Widget>::Element
 				    && Widget::node_name(node) == w._name;
 			}
 
-		} _model_update_policy { _factory };
+		} _model_update_policy { _factory, *this };
 
 		inline void _update_children(Xml_node node)
 		{
@@ -136,12 +181,34 @@ class Menu_view::Widget : public List<Widget>::Element
 		                    Surface<Pixel_alpha8> &alpha_surface,
 		                    Point at) const
 		{
-			for (Widget const *w = _children.first(); w; w = w->next())
-				w->draw(pixel_surface, alpha_surface, at + w->_animated_geometry.p1());
+			for (Widget const *w = _children.first(); w; w = w->next()) {
+
+				Point const child_at = at + w->_animated_geometry.p1();
+
+				/* skip widgets outside the area to redraw */
+				Rect const r(child_at, w->_animated_geometry.area());
+				if (!Rect::intersect(r, pixel_surface.clip()).valid())
+					continue;
+
+				w->draw(pixel_surface, alpha_surface, child_at);
+			}
 		}
 
 		virtual void _layout() { }
 
+		/**
+		 * Request redraw of the whole widget area on the next frame
+		 */
+		void _mark_as_dirty() { _needs_redraw = true; }
+
+		/**
+		 * Return true if the widget's drawing depends on its children
+		 *
+		 * Such widgets are redrawn as a whole whenever one of their children
+		 * is changed.
+		 */
+		virtual bool _draws_children_dependent() const { return false; }
+
 		Rect _inner_geometry() const
 		{
 			return Rect(Point(margin.left, margin.top),
@@ -202,6 +269,72 @@ class Menu_view::Widget : public List<Widget>::Element
 
 		virtual void update(Xml_node node) = 0;
 
+		/**
+		 * Update widget from XML node unless the node is unchanged
+		 */
+		void apply(Xml_node node)
+		{
+			Digest const tree = _digest(node.addr(), node.size());
+			if (tree == _tree_digest)
+				return;
+
+			_tree_digest = tree;
+
+			size_t const start_tag_len =
+				min((size_t)(node.content_base() - node.addr()), node.size());
+
+			Digest const own = _digest(node.addr(), start_tag_len);
+			if (own != _own_digest) {
+				_own_digest   = own;
+				_needs_redraw = true;
+			}
+
+			update(node);
+
+			_layout_needed = true;
+		}
+
+		/**
+		 * Report areas that must be redrawn since the last call
+		 *
+		 * \param at  absolute position of the parent widget
+		 * \param fn  functor called with each dirty 'Rect'
+		 *
+		 * \return true if any area of the widget's subtree is dirty
+		 *
+		 * The caller is expected to redraw the reported areas.
+		 */
+		template <typename FN>
+		bool collect_damage(Point at, FN const &fn)
+		{
+			Rect const r = _animated_geometry;
+			Rect const abs(at + r.p1(), r.area());
+
+			bool damaged = false;
+			for (Widget *w = _children.first(); w; w = w->next())
+				damaged |= w->collect_damage(abs.p1(), fn);
+
+			if (_vacated.valid()) {
+				fn(_vacated);
+				_vacated = Rect();
+				damaged  = true;
+			}
+
+			if (damaged && _draws_children_dependent())
+				_needs_redraw = true;
+
+			if (_needs_redraw || !_equal(abs, _drawn)) {
+				if (_drawn.valid()) fn(_drawn);
+				if (abs.valid())    fn(abs);
+				damaged = true;
+			}
+
+			_drawn        = abs;
+			_needs_redraw = false;
+
+			return damaged;
+		}
+
 		virtual Area min_size() const = 0;
 
 		virtual void draw(Surface<Pixel_rgb888> &pixel_surface,
@@ -212,6 +345,13 @@ class Menu_view::Widget : public List<Widget>::Element
 		{
 			_geometry = Rect(_geometry.p1(), size);
 
+			/* the layout depends only on the size and the applied node */
+			if (!_layout_needed && size == _layout_size)
+				return;
+
+			_layout_needed = false;
+			_layout_size   = size;
+
 			_layout();
 		}
 
@@ -14,6 +14,7 @@
 /* Genode includes */
 #include <base/heap.h>
 #include <base/component.h>
+#include <base/log.h>
 #include <base/attached_rom_dataspace.h>
 #include <polygon_gfx/shaded_polygon_painter.h>
 #include <polygon_gfx/interpolate_rgb565.h>
@@ -80,12 +81,58 @@ class Scene : public Nano3d::Scene<PT>
 		Shape   _shape   = SHAPE_DODECAHEDRON;
 		Painter _painter = PAINTER_TEXTURED;
 
+		/**
+		 * Statistics of the benchmark mode
+		 *
+		 * The achieved frame rate is limited by the update rate of the scene.
+		 * The possible frame rate is derived from the time spent for
+		 * rendering.
+		 */
+		struct Benchmark
+		{
+			enum { PERIOD_US = 5*1000*1000 };
+
+			bool          enabled   = false;
+			unsigned long start_us  = 0;
+			unsigned long render_us = 0;
+			unsigned      frames    = 0;
+
+			void frame_rendered(unsigned long begin_us, unsigned long end_us)
+			{
+				if (!enabled)
+					return;
+
+				if (frames == 0)
+					start_us = begin_us;
+
+				render_us += end_us - begin_us;
+				frames++;
+
+				unsigned long const duration_us = end_us - start_us;
+				if (duration_us < PERIOD_US)
+					return;
+
+				Genode::log("frames/s: ", (frames*1000000ULL)/duration_us,
+				            " possible: ",
+				            (frames*1000000ULL)/Genode::max(render_us, 1UL),
+				            " (", render_us/frames, " us/frame)");
+
+				frames = 0;
+				render_us = 0;
+			}
+		};
+
+		Benchmark _benchmark { };
+
 		Genode::Attached_rom_dataspace _config { _env, "config" };
 
 		void _handle_config()
 		{
 			_config.update();
 
+			_benchmark = Benchmark();
+			_benchmark.enabled = _config.xml().attribute_value("benchmark", false);
+
 			try {
 				_shape = SHAPE_DODECAHEDRON;
 				if (_config.xml().attribute("shape").has_value("cube"))
@@ -209,7 +256,9 @@ class Scene : public Nano3d::Scene<PT>
 		void render(Genode::Surface<PT>                   &pixel,
 		            Genode::Surface<Genode::Pixel_alpha8> &alpha) override
 		{
-			unsigned const frame = (this->elapsed_ms()/10) % 1024;
+			unsigned long const begin_us = this->elapsed_us();
+
+			unsigned const frame = (begin_us/10000) % 1024;
 
 			if (_shape == SHAPE_DODECAHEDRON) {
 
@@ -221,6 +270,9 @@ class Scene : public Nano3d::Scene<PT>
 				_render_shape(pixel, alpha, _cube, frame, true);
 				_render_shape(pixel, alpha, _cube, frame, false);
 			}
+
+			if (_benchmark.enabled)
+				_benchmark.frame_rendered(begin_us, this->elapsed_us());
 		}
 };
 
@@ -99,6 +99,24 @@ struct Decorator::Main : Window_factory_base
 	Signal_handler<Main> _nitpicker_sync_handler = {
 		_env.ep(), *this, &Main::_handle_nitpicker_sync };
 
+	bool _sync_enabled = false;
+
+	/**
+	 * Enable or disable the delivery of nitpicker sync signals
+	 *
+	 * Sync signals are needed only while a window-layout update is pending
+	 * or an animation is in progress.
+	 */
+	void _enable_sync(bool enabled)
+	{
+		if (enabled == _sync_enabled)
+			return;
+
+		_nitpicker.framebuffer()->sync_sigh(enabled ? _nitpicker_sync_handler
+		                                            : Signal_context_capability());
+		_sync_enabled = enabled;
+	}
+
 	Attached_rom_dataspace _config { _env, "config" };
 
 	Config _decorator_config { _config.xml() };
@@ -136,7 +154,6 @@ struct Decorator::Main : Window_factory_base
 			Genode::log("pointer information unavailable");
 		}
 
-		_nitpicker.framebuffer()->sync_sigh(_nitpicker_sync_handler);
 
 		_hover_reporter.enabled(true);
 
@@ -246,6 +263,8 @@ void Decorator::Main::_handle_window_layout_update()
 	_window_layout.update();
 
 	_window_layout_update_needed = true;
+
+	_enable_sync(true);
 }
 
 
@@ -294,13 +313,20 @@ void Decorator::Main::_handle_nitpicker_sync()
 	 * 'frame_period', we update the animation as often as the nitpicker
 	 * sync signal occurs.
 	 */
-	for (unsigned i = 0; i < _frame_period; i++)
-		_animator.animate();
+	_animator.animate(_frame_period);
+
+	/* become idle until the next window-layout update */
+	if (!_animator.active()
+	 && !(_window_layout_update_needed && _window_layout.valid()))
+		_enable_sync(false);
 
 	if (!model_updated && !windows_animated)
 		return;
 
+	/* the views of all windows are updated with a single 'execute' */
 	_window_stack.update_nitpicker_views();
+
+	_nitpicker.execute();
 }
 
 
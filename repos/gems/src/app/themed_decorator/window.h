@@ -395,7 +395,6 @@ class Decorator::Window : public Window_base, public Animator::Item
 
 				_nitpicker_views_up_to_date = true;
 			}
-			_nitpicker.execute();
 		}
 
 		void draw(Canvas_base &, Rect, Draw_behind_fn const &) const override { }
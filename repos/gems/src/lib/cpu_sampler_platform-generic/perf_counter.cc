@@ -0,0 +1,29 @@
+/*
+ * \brief  Generic performance-counter access, no events can be counted
+ * \author Genode Labs
+ * \date   2026-10-14
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* local includes */
+#include "cpu_session_component.h"
+
+
+bool Cpu_sampler::Cpu_session_component::perf_select_event(Thread_capability,
+                                                           char const *)
+{
+	return false;
+}
+
+
+Genode::uint64_t
+Cpu_sampler::Cpu_session_component::perf_event_count(Thread_capability)
+{
+	return 0;
+}
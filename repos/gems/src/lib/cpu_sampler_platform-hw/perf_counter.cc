@@ -0,0 +1,63 @@
+/*
+ * \brief  Performance-counter access on base-hw
+ * \author Genode Labs
+ * \date   2026-10-14
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <hw_native_cpu/client.h>
+#include <util/string.h>
+
+/* local includes */
+#include "cpu_session_component.h"
+
+using namespace Genode;
+
+
+static Hw_native_cpu::Perf_event perf_event(char const *name)
+{
+	static struct {
+		char const               *name;
+		Hw_native_cpu::Perf_event event;
+	} const events[] = {
+		{ "instructions",  Hw_native_cpu::INSTRUCTIONS  },
+		{ "cache_misses",  Hw_native_cpu::CACHE_MISSES  },
+		{ "branch_misses", Hw_native_cpu::BRANCH_MISSES },
+		{ "tlb_misses",    Hw_native_cpu::TLB_MISSES    },
+	};
+
+	for (auto const &e : events)
+		if (!strcmp(e.name, name))
+			return e.event;
+
+	return Hw_native_cpu::NONE;
+}
+
+
+bool Cpu_sampler::Cpu_session_component::perf_select_event(Thread_capability thread,
+                                                           char const *name)
+{
+	Hw_native_cpu::Perf_events events { };
+	events.event[0] = perf_event(name);
+
+	if (events.event[0] == Hw_native_cpu::NONE)
+		return false;
+
+	Hw_native_cpu_client(parent_cpu_session().native_cpu()).perf_events(thread, events);
+	return true;
+}
+
+
+uint64_t
+Cpu_sampler::Cpu_session_component::perf_event_count(Thread_capability thread)
+{
+	return Hw_native_cpu_client(parent_cpu_session().native_cpu())
+	       .perf_counts(thread).count[0];
+}
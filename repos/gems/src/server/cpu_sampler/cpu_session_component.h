@@ -75,6 +75,24 @@ class Cpu_sampler::Cpu_session_component : public Rpc_object<Cpu_session>
 		Cpu_session_client &parent_cpu_session() { return _parent_cpu_session; }
 		Rpc_entrypoint &thread_ep() { return _thread_ep; }
 
+		/*
+		 * The following performance-counter functions are implemented by
+		 * the platform library.
+		 */
+
+		/**
+		 * Count event 'event' for the thread and reset its count
+		 *
+		 * \param thread  thread capability of the parent CPU session
+		 * \return        false if the kernel cannot count the event
+		 */
+		bool perf_select_event(Thread_capability thread, char const *event);
+
+		/**
+		 * Return number of events counted for the thread
+		 */
+		uint64_t perf_event_count(Thread_capability thread);
+
 		/**
 		 * Constructor
 		 */
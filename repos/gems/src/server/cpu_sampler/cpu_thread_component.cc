@@ -33,7 +33,7 @@ Cpu_sampler::Cpu_thread_component::Cpu_thread_component(
                                 char              const *thread_name,
                                 unsigned int             thread_id)
 : _cpu_session_component(cpu_session_component), _env(env),
-  _md_alloc(md_alloc),
+  _md_alloc(md_alloc), _pd(pd),
   _parent_cpu_thread(
       _cpu_session_component.parent_cpu_session().create_thread(pd,
                                                                 name,
@@ -49,10 +49,15 @@ Cpu_sampler::Cpu_thread_component::Cpu_thread_component(
 
 	_label = Session_label(label_buf);
 
-	snprintf(label_buf, sizeof(label_buf), "samples -> %s.%u",
-             _label.string(), thread_id);
+	snprintf(label_buf, sizeof(label_buf), "%s.%u",
+	         _label.string(), thread_id);
 
-    _log_session_label = Session_label(label_buf);
+	_sample_label = Session_label(label_buf);
+
+	snprintf(label_buf, sizeof(label_buf), "samples -> %s",
+	         _sample_label.string());
+
+	_log_session_label = Session_label(label_buf);
 
 	_cpu_session_component.thread_ep().manage(this);
 }
@@ -83,12 +88,30 @@ void Cpu_sampler::Cpu_thread_component::take_sample()
 
 		Thread_state thread_state = _parent_cpu_thread.state();
 
+		/* the stack is unwound while the thread is paused */
+		addr_t addrs[1 + MAX_FRAMES];
+		addrs[0] = thread_state.ip;
+
+		unsigned num_addrs = 1;
+		if (_stack_reader.constructed())
+			num_addrs += _stack_reader->unwind(thread_state, addrs + 1, _max_frames);
+
 		_parent_cpu_thread.resume();
 
-		_sample_buf[_sample_buf_index++] = thread_state.ip;
+		if (!_event_mode) {
+			_store_sample(addrs, num_addrs);
+			return;
+		}
+
+		/* attribute the events since the last sample to the current IP */
+		uint64_t const count =
+			_cpu_session_component.perf_event_count(_parent_cpu_thread);
+
+		_pending_events  += count - _last_event_count;
+		_last_event_count = count;
 
-		if (_sample_buf_index == SAMPLE_BUF_SIZE)
-			flush();
+		for (; _pending_events >= _event_period; _pending_events -= _event_period)
+			_store_sample(addrs, num_addrs);
 
 	} catch (Cpu_thread::State_access_failed) {
 
@@ -98,12 +121,85 @@ void Cpu_sampler::Cpu_thread_component::take_sample()
 }
 
 
+void Cpu_sampler::Cpu_thread_component::_store_sample(addr_t const *addrs,
+                                                      unsigned count)
+{
+	if (_file) {
+		_file->sample(_file_thread_id, addrs, count);
+		return;
+	}
+
+	if (_sample_buf_index + 1 + count > SAMPLE_BUF_SIZE)
+		flush();
+
+	_sample_buf[_sample_buf_index++] = count;
+	for (unsigned i = 0; i < count; i++)
+		_sample_buf[_sample_buf_index++] = addrs[i];
+}
+
+
 void Cpu_sampler::Cpu_thread_component::reset()
 {
 	_sample_buf_index = 0;
 }
 
 
+void Cpu_sampler::Cpu_thread_component::sample_events(char const *event,
+                                                      unsigned long period)
+{
+	_event_period     = max(period, 1UL);
+	_last_event_count = 0;
+	_pending_events   = 0;
+	_event_mode       = false;
+
+	if (!event[0])
+		return;
+
+	_event_mode = _cpu_session_component.perf_select_event(_parent_cpu_thread,
+	                                                       event);
+	if (!_event_mode)
+		Genode::warning("cannot count event \"", event, "\" for thread ",
+		                _label.string(), ", sampling periodically");
+}
+
+
+void Cpu_sampler::Cpu_thread_component::unwind_frames(unsigned frames)
+{
+	_max_frames = min(frames, (unsigned)MAX_FRAMES);
+
+	if (_max_frames && !Stack_reader::supported())
+		Genode::warning("stack unwinding not supported, sampling thread ",
+		                _label.string(), " without return addresses");
+
+	if (!_max_frames || !Stack_reader::supported()) {
+		_stack_reader.destruct();
+		return;
+	}
+
+	if (_stack_reader.constructed())
+		return;
+
+	try { _stack_reader.construct(_env.rm(), _pd); }
+	catch (Attached_dataspace::Invalid_dataspace) {
+		Genode::warning("cannot access stack of thread ", _label.string()); }
+	catch (Region_map::Region_conflict) {
+		Genode::warning("cannot attach stack of thread ", _label.string()); }
+}
+
+
+void Cpu_sampler::Cpu_thread_component::sample_file(Sample_file *file)
+{
+	if (file == _file)
+		return;
+
+	flush();
+
+	_file = file;
+	if (_file)
+		_file_thread_id = _file->announce_thread(_sample_label);
+}
+
+
 void Cpu_sampler::Cpu_thread_component::flush()
 {
 	if (_sample_buf_index == 0)
@@ -112,21 +208,31 @@ void Cpu_sampler::Cpu_thread_component::flush()
 	if (!_log.constructed())
 		_log.construct(_env, _log_session_label);
 
-	/* number of hex characters + newline + '\0' */
-	enum { SAMPLE_STRING_SIZE = 2 * sizeof(addr_t) + 1 + 1 };
+	/* number of hex characters per address + separator or newline + '\0' */
+	enum { SAMPLE_STRING_SIZE = (2 * sizeof(addr_t) + 1) * (1 + MAX_FRAMES) + 1 };
 
 	char sample_string[SAMPLE_STRING_SIZE];
 
 	char const *format_string;
 
 	if (sizeof(addr_t) == 8)
-		format_string = "%16lX\n";
+		format_string = "%16lX";
 	else
-		format_string = "%8X\n";
+		format_string = "%8X";
+
+	for (unsigned int i = 0; i < _sample_buf_index; ) {
+
+		unsigned const count = _sample_buf[i++];
+
+		/* return addresses are appended to the instruction pointer */
+		size_t len = 0;
+		for (unsigned j = 0; j < count; j++, i++) {
+			len += snprintf(sample_string + len, SAMPLE_STRING_SIZE - len,
+			                format_string, _sample_buf[i]);
+			sample_string[len++] = (j + 1 < count) ? ' ' : '\n';
+		}
+		sample_string[len] = 0;
 
-	for (unsigned int i = 0; i < _sample_buf_index; i++) {
-		snprintf(sample_string, SAMPLE_STRING_SIZE, format_string,
-		         _sample_buf[i]);
 		_log->write(sample_string);
 	}
 
@@ -21,6 +21,8 @@
 
 /* local includes */
 #include "cpu_session_component.h"
+#include "sample_file.h"
+#include "stack_reader.h"
 
 namespace Cpu_sampler {
 	using namespace Genode;
@@ -32,25 +34,52 @@ class Cpu_sampler::Cpu_thread_component : public Rpc_object<Cpu_thread>
 {
 	private:
 
-		enum { SAMPLE_BUF_SIZE = 1024 };
+		enum { SAMPLE_BUF_SIZE = 1024, MAX_FRAMES = 32 };
 
 		Cpu_session_component &_cpu_session_component;
 		Env                   &_env;
 
 		Allocator             &_md_alloc;
 
+		Pd_session_capability  _pd;
+
 		Cpu_thread_client      _parent_cpu_thread;
 
 		bool                   _started = false;
 
 		Session_label          _label;
+		Session_label          _sample_label;
 		Session_label          _log_session_label;
 
+		/*
+		 * Each sample is stored as the number of addresses followed by the
+		 * instruction pointer and the return addresses
+		 */
 		Genode::addr_t         _sample_buf[SAMPLE_BUF_SIZE];
 		unsigned int           _sample_buf_index = 0;
 
 		Constructible<Log_connection> _log;
 
+		/* binary output, samples are written to the log if not defined */
+		Sample_file           *_file = nullptr;
+		unsigned               _file_thread_id = 0;
+
+		/* number of return addresses recorded per sample */
+		unsigned               _max_frames = 0;
+
+		Constructible<Stack_reader> _stack_reader;
+
+		/*
+		 * In event-based mode, one sample is taken per '_event_period'
+		 * events counted by the performance counter for the thread.
+		 */
+		bool                   _event_mode       = false;
+		unsigned long          _event_period     = 1;
+		uint64_t               _last_event_count = 0;
+		uint64_t               _pending_events   = 0;
+
+		void _store_sample(addr_t const *addrs, unsigned count);
+
 	public:
 
 		Cpu_thread_component(Cpu_session_component   &cpu_session_component,
@@ -73,6 +102,32 @@ class Cpu_sampler::Cpu_thread_component : public Rpc_object<Cpu_thread>
 
 		void take_sample();
 		void reset();
+
+		/**
+		 * Take samples based on the count of event 'event'
+		 *
+		 * \param event   name of the event, or an empty string for
+		 *                periodic sampling
+		 * \param period  number of events per sample
+		 */
+		void sample_events(char const *event, unsigned long period);
+
+		/**
+		 * Record up to 'frames' return addresses per sample
+		 *
+		 * The return addresses are determined by following the frame
+		 * pointers, which requires the sampled code to be compiled with
+		 * frame pointers. Unwinding is supported on x86 only.
+		 */
+		void unwind_frames(unsigned frames);
+
+		/**
+		 * Write samples to 'file' instead of the log
+		 *
+		 * \param file  sample file, or nullptr for writing to the log
+		 */
+		void sample_file(Sample_file *file);
+
 		void flush();
 
 		/**************************
@@ -26,6 +26,7 @@
 #include "cpu_root.h"
 #include "cpu_session_component.h"
 #include "cpu_thread_component.h"
+#include "sample_file.h"
 #include "thread_list_change_handler.h"
 
 namespace Cpu_sampler { struct Main; }
@@ -52,6 +53,8 @@ struct Cpu_sampler::Main : Thread_list_change_handler
 	unsigned int            max_sample_index;
 	unsigned int            timeout_us;
 
+	Constructible<Sample_file> sample_file;
+
 
 	void handle_timeout()
 	{
@@ -67,6 +70,9 @@ struct Cpu_sampler::Main : Thread_list_change_handler
 
 		for_each_thread(selected_thread_list, lambda);
 
+		if (sample_file.constructed() && (sample_index == max_sample_index))
+			sample_file->flush();
+
 		if (verbose_sample_duration && (sample_index == max_sample_index))
 			Genode::log("sample period finished");
 
@@ -90,12 +96,20 @@ struct Cpu_sampler::Main : Thread_list_change_handler
 		unsigned int sample_interval_ms =
 			config.xml().attribute_value<unsigned int>("sample_interval_ms", 1000);
 
+		/* a sample interval in microseconds takes precedence */
+		unsigned int const sample_interval_us = max(1U,
+			config.xml().attribute_value<unsigned int>("sample_interval_us",
+			                                           sample_interval_ms * 1000));
+
 		unsigned int sample_duration_s =
 			config.xml().attribute_value<unsigned int>("sample_duration_s", 10);
 
-		max_sample_index = ((sample_duration_s * 1000) / sample_interval_ms) - 1;
+		max_sample_index = max(1UL, ((sample_duration_s * 1000UL * 1000UL)
+		                             / sample_interval_us)) - 1;
 
-		timeout_us = sample_interval_ms * 1000;
+		timeout_us = sample_interval_us;
+
+		apply_output_config();
 
 		thread_list_changed();
 
@@ -110,6 +124,28 @@ struct Cpu_sampler::Main : Thread_list_change_handler
 		{ env.ep(), *this, &Main::handle_config_update};
 
 
+	void apply_output_config()
+	{
+		/* detach all threads from the sample file before replacing it */
+		for_each_thread(thread_list, [&] (Thread_element *cpu_thread_element) {
+			cpu_thread_element->object()->sample_file(nullptr); });
+
+		sample_file.destruct();
+
+		typedef String<8> Output;
+		if (config.xml().attribute_value("output", Output("log")) != "file")
+			return;
+
+		try {
+			sample_file.construct(env, alloc,
+			                      config.xml().attribute_value("file",
+			                      Sample_file::Path("/samples.bin")));
+		}
+		catch (...) {
+			Genode::error("cannot open sample file, writing samples to the log"); }
+	}
+
+
 	void thread_list_changed() override
 	{
 		/* clear selected_thread_list */
@@ -141,6 +177,15 @@ struct Cpu_sampler::Main : Thread_list_change_handler
 
 				Session_policy policy(cpu_thread->label(), config.xml());
 				cpu_thread->reset();
+
+				typedef String<32> Event;
+				cpu_thread->sample_events(
+					policy.attribute_value("event", Event()).string(),
+					policy.attribute_value("event_period", 1000UL));
+				cpu_thread->unwind_frames(
+					policy.attribute_value("frames", 0U));
+				cpu_thread->sample_file(sample_file.constructed()
+				                        ? &*sample_file : nullptr);
 				selected_thread_list.insert(new (&alloc)
 				                            Thread_element(cpu_thread));
 
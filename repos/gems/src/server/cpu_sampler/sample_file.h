@@ -0,0 +1,171 @@
+/*
+ * \brief  Binary file of samples written via a file-system session
+ * \author Genode Labs
+ * \date   2026-10-14
+ *
+ * The file starts with a 'File_header', followed by a sequence of records.
+ * Each record starts with a 'Record_header'. A THREAD record is followed by
+ * 'length' characters of the thread label and assigns the label to the
+ * thread ID. A SAMPLE record is followed by 'length' addresses, the sampled
+ * instruction pointer first, followed by the return addresses found on the
+ * stack. All values are stored in the byte order of the sampled machine.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _SAMPLE_FILE_H_
+#define _SAMPLE_FILE_H_
+
+/* Genode includes */
+#include <base/allocator_avl.h>
+#include <base/log.h>
+#include <base/session_label.h>
+#include <file_system_session/connection.h>
+#include <file_system/util.h>
+#include <os/path.h>
+
+namespace Cpu_sampler {
+	using namespace Genode;
+	class Sample_file;
+}
+
+
+class Cpu_sampler::Sample_file : Noncopyable
+{
+	public:
+
+		using Path = String<File_system::MAX_PATH_LEN>;
+
+		struct File_header
+		{
+			uint32_t magic;      /* "GSMP" */
+			uint16_t version;
+			uint8_t  addr_size;  /* size of an address in bytes */
+			uint8_t  reserved;
+		};
+
+		struct Record_header
+		{
+			enum Type { THREAD = 1, SAMPLE = 2 };
+
+			uint16_t type;
+			uint16_t length;
+			uint32_t thread;
+		};
+
+	private:
+
+		enum { MAGIC = 0x504d5347, VERSION = 1, BUFFER_SIZE = 64*1024 };
+
+		Allocator_avl            _fs_block_alloc;
+		File_system::Connection  _fs;
+		File_system::File_handle _file;
+		File_system::seek_off_t  _seek = 0;
+
+		unsigned _next_thread_id = 0;
+
+		/* samples are buffered to write the file in large chunks */
+		char   _buffer[BUFFER_SIZE];
+		size_t _used = 0;
+
+		static File_system::File_handle _open(File_system::Session &fs,
+		                                      char const *path)
+		{
+			using namespace File_system;
+
+			Genode::Path<MAX_PATH_LEN> dir_path(path);
+			dir_path.strip_last_element();
+
+			Dir_handle dir = ensure_dir(fs, dir_path.base());
+			Handle_guard dir_guard(fs, dir);
+
+			File_system::Name const name(basename(path));
+
+			try { return fs.file(dir, name, WRITE_ONLY, true); }
+			catch (Node_already_exists) { }
+
+			File_handle file = fs.file(dir, name, WRITE_ONLY, false);
+			fs.truncate(file, 0);
+			return file;
+		}
+
+		void _append(void const *src, size_t len)
+		{
+			if (_used + len > sizeof(_buffer))
+				flush();
+
+			memcpy(_buffer + _used, src, len);
+			_used += len;
+		}
+
+		void _record(Record_header::Type type, unsigned thread,
+		             void const *payload, size_t length, size_t element_size)
+		{
+			Record_header const header { (uint16_t)type, (uint16_t)length,
+			                             (uint32_t)thread };
+			_append(&header, sizeof(header));
+			_append(payload, length*element_size);
+		}
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \throw File_system::Lookup_failed
+		 * \throw File_system::Permission_denied
+		 */
+		Sample_file(Env &env, Allocator &alloc, Path const &path)
+		:
+			_fs_block_alloc(&alloc),
+			_fs(env, _fs_block_alloc, "samples"),
+			_file(_open(_fs, path.string()))
+		{
+			File_header const header { MAGIC, VERSION, sizeof(addr_t), 0 };
+			_append(&header, sizeof(header));
+
+			log("write samples to file \"", path, "\"");
+		}
+
+		~Sample_file()
+		{
+			flush();
+			_fs.close(_file);
+		}
+
+		/**
+		 * Assign an ID to a thread
+		 */
+		unsigned announce_thread(Session_label const &label)
+		{
+			unsigned const id = _next_thread_id++;
+			_record(Record_header::THREAD, id, label.string(),
+			        strlen(label.string()), 1);
+			return id;
+		}
+
+		void sample(unsigned thread, addr_t const *addrs, unsigned count)
+		{
+			_record(Record_header::SAMPLE, thread, addrs, count, sizeof(addr_t));
+		}
+
+		void flush()
+		{
+			if (!_used)
+				return;
+
+			size_t const written = File_system::write(_fs, _file, _buffer, _used, _seek);
+			if (written < _used)
+				error("writing samples to file failed");
+
+			_seek += written;
+			_used  = 0;
+		}
+};
+
+#endif /* _SAMPLE_FILE_H_ */
@@ -0,0 +1,143 @@
+/*
+ * \brief  Frame-pointer based unwinding of the stack of a sampled thread
+ * \author Genode Labs
+ * \date   2026-10-14
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _STACK_READER_H_
+#define _STACK_READER_H_
+
+/* Genode includes */
+#include <base/attached_dataspace.h>
+#include <base/thread.h>
+#include <base/thread_state.h>
+#include <pd_session/client.h>
+#include <region_map/client.h>
+
+namespace Cpu_sampler {
+	using namespace Genode;
+	class Stack_reader;
+}
+
+
+/**
+ * Access to the stack area of the PD of a sampled thread
+ *
+ * The stack area of the PD is attached to the local address space. To
+ * prevent the sampler from faulting at unpopulated parts of the stack area,
+ * stack content is read only between the stack pointer and the top of the
+ * stack slot of the thread. The topmost page of the slot is skipped because
+ * it may host the UTCB, which is not part of the stack area on all kernels.
+ */
+class Cpu_sampler::Stack_reader : Noncopyable
+{
+	private:
+
+		enum { TOP_RESERVE = 4096 };
+
+		Attached_dataspace _stack_area;
+
+		static addr_t _slot_end(addr_t sp)
+		{
+			addr_t const slot_size = Thread::stack_virtual_size();
+			addr_t const offset    = sp - Thread::stack_area_virtual_base();
+
+			return Thread::stack_area_virtual_base()
+			     + (offset/slot_size + 1)*slot_size;
+		}
+
+		addr_t _read(addr_t addr) const
+		{
+			char const * const local = _stack_area.local_addr<char const>()
+			                         + (addr - Thread::stack_area_virtual_base());
+
+			return *(addr_t const *)local;
+		}
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \throw Attached_dataspace::Invalid_dataspace
+		 * \throw Region_map::Region_conflict
+		 */
+		Stack_reader(Region_map &rm, Pd_session_capability pd)
+		:
+			_stack_area(rm, Region_map_client(Pd_session_client(pd).stack_area()).dataspace())
+		{ }
+
+		/**
+		 * Return true if unwinding is supported for the CPU architecture
+		 */
+		static constexpr bool supported()
+		{
+#if defined(__x86_64__) || defined(__i386__)
+			return true;
+#else
+			return false;
+#endif
+		}
+
+		static addr_t frame_pointer(Thread_state const &state)
+		{
+#if defined(__x86_64__)
+			return state.rbp;
+#elif defined(__i386__)
+			return state.ebp;
+#else
+			(void)state;
+			return 0;
+#endif
+		}
+
+		/**
+		 * Follow the chain of frame pointers
+		 *
+		 * \param dst  destination buffer for the return addresses
+		 * \param max  capacity of 'dst'
+		 *
+		 * \return  number of return addresses written to 'dst'
+		 */
+		unsigned unwind(Thread_state const &state, addr_t *dst, unsigned max) const
+		{
+			addr_t const area_base = Thread::stack_area_virtual_base();
+			addr_t const sp        = state.sp;
+
+			if (sp < area_base || sp - area_base >= _stack_area.size())
+				return 0;
+
+			addr_t const limit = _slot_end(sp) - TOP_RESERVE;
+
+			unsigned count = 0;
+			for (addr_t fp = frame_pointer(state), lower = sp; count < max; ) {
+
+				/* the frame consists of the saved frame pointer and the return address */
+				if (fp < lower || fp > limit - 2*sizeof(addr_t)
+				 || (fp & (sizeof(addr_t) - 1)))
+					break;
+
+				addr_t const next_fp = _read(fp);
+				addr_t const ret     = _read(fp + sizeof(addr_t));
+
+				if (!ret)
+					break;
+
+				dst[count++] = ret;
+
+				/* frames are located at ascending addresses */
+				lower = fp + 2*sizeof(addr_t);
+				fp    = next_fp;
+			}
+			return count;
+		}
+};
+
+#endif /* _STACK_READER_H_ */
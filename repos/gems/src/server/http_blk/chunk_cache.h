@@ -0,0 +1,128 @@
+/*
+ * \brief  In-memory cache of fixed-size chunks of the remote file
+ * \author Genode Labs
+ * \date   2026-10-14
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _CHUNK_CACHE_H_
+#define _CHUNK_CACHE_H_
+
+/* Genode includes */
+#include <base/allocator.h>
+#include <util/noncopyable.h>
+
+class Chunk_cache : Genode::Noncopyable
+{
+	typedef Genode::size_t size_t;
+
+	public:
+
+		struct Slot
+		{
+			bool           valid     = false;
+			size_t         chunk     = 0;
+			unsigned long  last_used = 0;
+			char          *data      = nullptr;
+		};
+
+	private:
+
+		Genode::Allocator &_alloc;
+		size_t      const  _chunk_size;
+		unsigned    const  _count;
+		Slot              *_slots;
+		char              *_data;
+		unsigned long      _tick = 0;
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param chunk_size  size of one chunk in bytes
+		 * \param count       number of chunks kept in memory, at least one
+		 */
+		Chunk_cache(Genode::Allocator &alloc, size_t chunk_size, unsigned count)
+		:
+			_alloc(alloc), _chunk_size(chunk_size),
+			_count(Genode::max(count, 1U)),
+			_slots(new (alloc) Slot[_count]),
+			_data((char *)alloc.alloc(_chunk_size * _count))
+		{
+			for (unsigned i = 0; i < _count; i++)
+				_slots[i].data = _data + i * _chunk_size;
+		}
+
+		~Chunk_cache()
+		{
+			_alloc.free(_data, _chunk_size * _count);
+			Genode::destroy(_alloc, _slots);
+		}
+
+		size_t   chunk_size() const { return _chunk_size; }
+		unsigned slots()      const { return _count; }
+
+		/**
+		 * Return slot holding 'chunk' or nullptr if the chunk is not cached
+		 */
+		Slot *lookup(size_t chunk)
+		{
+			for (unsigned i = 0; i < _count; i++) {
+				Slot &slot = _slots[i];
+				if (slot.valid && slot.chunk == chunk) {
+					slot.last_used = ++_tick;
+					return &slot;
+				}
+			}
+			return nullptr;
+		}
+
+		/**
+		 * Return true if 'chunk' is cached, without touching its LRU state
+		 */
+		bool cached(size_t chunk) const
+		{
+			for (unsigned i = 0; i < _count; i++)
+				if (_slots[i].valid && _slots[i].chunk == chunk)
+					return true;
+			return false;
+		}
+
+		/**
+		 * Assign the least recently used slot to 'chunk'
+		 *
+		 * The slot stays invalid until the caller filled it and set its
+		 * 'valid' flag. Because the returned slot becomes the most recently
+		 * used one, up to 'slots()' consecutive calls return distinct slots.
+		 */
+		Slot &claim(size_t chunk)
+		{
+			Slot *victim = &_slots[0];
+			for (unsigned i = 1; i < _count; i++)
+				if (_slots[i].last_used < victim->last_used)
+					victim = &_slots[i];
+
+			victim->valid     = false;
+			victim->chunk     = chunk;
+			victim->last_used = ++_tick;
+			return *victim;
+		}
+
+		/**
+		 * Drop content of slot, making it the first one to be reused
+		 */
+		void discard(Slot &slot)
+		{
+			slot.valid     = false;
+			slot.last_used = 0;
+		}
+};
+
+#endif /* _CHUNK_CACHE_H_ */
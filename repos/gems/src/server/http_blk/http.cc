@@ -78,7 +78,7 @@ void Http::connect()
 }
 
 
-void Http::reconnect(){ close(_fd); connect(); }
+void Http::reconnect(){ close(_fd); connect(); _reconnects++; }
 
 
 void Http::resolve_uri()
@@ -131,14 +131,12 @@ Genode::size_t Http::read_header()
 }
 
 
-void Http::get_capacity()
+bool Http::header_value(size_t len, char const *key, size_t &value)
 {
-	cmd_head();
-	size_t  len = read_header();
 	char buf[32];
 	Http_token t(_http_buf, len);
 
-	bool key = false;
+	bool found = false;
 	while (t) {
 
 		if (t.type() != Http_token::IDENT) {
@@ -146,18 +144,27 @@ void Http::get_capacity()
 			continue;
 		}
 
-		if (key) {
-			ascii_to(t.start(), _size);
-			break;
+		if (found) {
+			ascii_to(t.start(), value);
+			return true;
 		}
 
 		t.string(buf, 32);
 
-		if (!Genode::strcmp(buf, "Content-Length", 32))
-			key = true;
+		if (!Genode::strcmp(buf, key, 32))
+			found = true;
 
 		t = t.next();
 	}
+	return false;
+}
+
+
+void Http::get_capacity()
+{
+	cmd_head();
+	size_t len = read_header();
+	header_value(len, "Content-Length", _size);
 }
 
 
@@ -167,9 +174,12 @@ void Http::do_read(void * buf, size_t size)
 
 	while (buf_fill < size) {
 
-		int part;
-		if ((part = read(_fd, (void *)((addr_t)buf + buf_fill),
-		                      size - buf_fill)) <= 0) {
+		int part = read(_fd, (void *)((addr_t)buf + buf_fill),
+		                size - buf_fill);
+		if (part == 0)
+			throw Http::Socket_closed();
+
+		if (part < 0) {
 			error("could not read data (", errno, ")");
 			throw Http::Socket_error();
 		}
@@ -180,7 +190,7 @@ void Http::do_read(void * buf, size_t size)
 
 
 Http::Http(Genode::Heap &heap, ::String &uri)
-: _heap(heap), _port((char *)"80")
+: _heap(heap), _port((char *)"80"), _requests(0), _reconnects(0)
 {
 	_heap.alloc(HTTP_BUF, (void**)&_http_buf);
 
@@ -239,40 +249,65 @@ void Http::parse_uri(::String & u)
 }
 
 
-void Http::cmd_get(size_t file_offset, size_t size, addr_t buffer)
+void Http::send_get(size_t file_offset, size_t size)
 {
-	while (true) {
+	const char *http_templ = "GET %s HTTP/1.1\r\n"
+	                         "Host: %s\r\n"
+	                         "Connection: keep-alive\r\n"
+	                         "Range: bytes=%lu-%lu\r\n"
+	                         "\r\n";
+
+	int length = snprintf(_http_buf, HTTP_BUF, http_templ, _path, _host,
+	                      file_offset, file_offset + size - 1);
 
-		const char *http_templ = "GET %s HTTP/1.1\r\n"
-		                         "Host: %s\r\n"
-		                         "Range: bytes=%lu-%lu\r\n"
-		                         "\r\n";
+	/* a failed write is handled like a connection closed by the server */
+	if (write(_fd, _http_buf, length) != length)
+		throw Http::Socket_closed();
+
+	_requests++;
+}
 
-		int length = snprintf(_http_buf, HTTP_BUF, http_templ, _path, _host,
-		                      file_offset, file_offset + size - 1);
 
-		if (write(_fd, _http_buf, length) < 0) {
+void Http::cmd_get(Range const *ranges, unsigned count)
+{
+	unsigned done = 0;
 
-			if (errno == ESHUTDOWN)
-				reconnect();
+	for (unsigned attempt = 0; done < count; attempt++) {
 
-			if (write(_fd, _http_buf, length) < 0)
-				throw Http::Socket_error();
+		if (attempt > MAX_RETRIES) {
+			error("cmd_get: giving up after ", attempt, " attempts");
+			throw Http::Socket_error();
 		}
 
 		try {
-			read_header();
+			/* put all outstanding requests on the wire at once */
+			for (unsigned i = done; i < count; i++)
+				send_get(ranges[i].offset, ranges[i].size);
+
+			/* responses arrive in request order */
+			for (; done < count; done++) {
+
+				Range const &range = ranges[done];
+
+				size_t len = read_header();
+
+				if (_http_ret != HTTP_SUCC_PARTIAL) {
+					error("cmd_get: server returned ", _http_ret);
+					throw Http::Server_error();
+				}
+
+				size_t content_length = 0;
+				if (!header_value(len, "Content-Length", content_length)
+				 || content_length != range.size) {
+					error("cmd_get: unexpected content length ", content_length,
+					      " for range of ", range.size, " bytes");
+					throw Http::Server_error();
+				}
+
+				do_read((void *)(range.buffer), range.size);
+			}
 		} catch (Http::Socket_closed) {
 			reconnect();
-			continue;
 		}
-
-		if (_http_ret != HTTP_SUCC_PARTIAL) {
-			error("cmd_get: server returned ", _http_ret);
-			throw Http::Server_error();
-		}
-
-		do_read((void *)(buffer), size);
-		return;
 	}
 }
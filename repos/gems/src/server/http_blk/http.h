@@ -37,6 +37,8 @@ class Http
 		struct addrinfo *_info;      /* Resolved address info for host */
 		int              _fd;        /* Socket file handle */
 		addr_t          _base_addr; /* Address of I/O dataspace */
+		unsigned         _requests;   /* number of issued GET requests */
+		unsigned         _reconnects; /* number of re-established connections */
 
 		/*
 		 * Send 'HEAD' command
@@ -68,11 +70,21 @@ class Http
 		 */
 		size_t read_header();
 
+		/*
+		 * Look up numeric value of header field 'key'
+		 */
+		bool header_value(size_t len, char const *key, size_t &value);
+
 		/*
 		 * Determine remote-file size
 		 */
 		void get_capacity();
 
+		/*
+		 * Send ranged 'GET' command without waiting for the response
+		 */
+		void send_get(size_t file_offset, size_t size);
+
 		/*
 		 * Read 'size' bytes into buffer
 		 */
@@ -95,7 +107,7 @@ class Http
 		 *
 		 * \return Remote file size in bytes
 		 */
-		size_t file_size() { return _size; }
+		size_t file_size() const { return _size; }
 
 		/**
 		 * Set base address of I/O dataspace
@@ -104,6 +116,31 @@ class Http
 		 */
 		void  base_addr(addr_t base_addr) { _base_addr = base_addr; }
 
+		/**
+		 * Byte range of the remote file and its local destination
+		 */
+		struct Range
+		{
+			size_t offset;  /* offset within remote file */
+			size_t size;    /* number of bytes */
+			addr_t buffer;  /* local destination */
+		};
+
+		enum { MAX_RETRIES = 3 };
+
+		/**
+		 * Fetch several ranges over the persistent connection
+		 *
+		 * \param ranges  array of ranges to fetch
+		 * \param count   number of ranges
+		 *
+		 * All requests are written to the connection before the first
+		 * response is read, so the ranges cost a single round trip. If the
+		 * server closes the connection in between, the connection is
+		 * re-established and the outstanding ranges are requested again.
+		 */
+		void cmd_get(Range const *ranges, unsigned count);
+
 		/**
 		 * Send 'GET' command
 		 *
@@ -111,7 +148,21 @@ class Http
 		 * \param size         Number of byts to transfer
 		 * \param buffer       address in I/O dataspace
 		 */
-		void cmd_get(size_t file_offset, size_t size, addr_t buffer);
+		void cmd_get(size_t file_offset, size_t size, addr_t buffer)
+		{
+			Range range { file_offset, size, buffer };
+			cmd_get(&range, 1);
+		}
+
+		/**
+		 * Number of GET requests sent so far
+		 */
+		unsigned requests() const { return _requests; }
+
+		/**
+		 * Number of times the connection had to be re-established
+		 */
+		unsigned reconnects() const { return _reconnects; }
 
 		/* Exceptions */
 		class Exception     : public ::Genode::Exception { };
@@ -17,25 +17,316 @@
 #include <base/log.h>
 #include <block/component.h>
 #include <libc/component.h>
+#include <os/reporter.h>
+#include <timer_session/connection.h>
+#include <util/reconstructible.h>
+
+/* libcrypto includes */
+#include <openssl/sha.h>
 
 /* local includes */
 #include "http.h"
+#include "chunk_cache.h"
 
 using namespace Genode;
 
+
+/**
+ * SHA-256 digests of all chunks of the remote file
+ *
+ * The digests are obtained from a ROM module that contains one digest per
+ * chunk as hexadecimal string, separated by whitespace.
+ */
+class Checksums
+{
+	public:
+
+		struct Invalid : Exception { };
+
+	private:
+
+		struct Digest { unsigned char value[SHA256_DIGEST_LENGTH]; };
+
+		Allocator    &_alloc;
+		size_t const  _count;
+		Digest       *_digests;
+
+		static int _hex_value(char c)
+		{
+			if (c >= '0' && c <= '9') return c - '0';
+			if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+			if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+			return -1;
+		}
+
+		static bool _space(char c) {
+			return c == ' ' || c == '\t' || c == '\r' || c == '\n'; }
+
+	public:
+
+		Checksums(Env &env, Allocator &alloc, char const *rom_name,
+		          size_t count)
+		:
+			_alloc(alloc), _count(count), _digests(new (alloc) Digest[count])
+		{
+			Attached_rom_dataspace rom(env, rom_name);
+
+			char const   *s   = rom.local_addr<char const>();
+			size_t const  len = rom.size();
+			size_t        pos = 0;
+
+			for (size_t i = 0; i < _count; i++) {
+
+				while (pos < len && _space(s[pos])) pos++;
+
+				for (unsigned j = 0; j < SHA256_DIGEST_LENGTH; j++, pos += 2) {
+
+					int const hi = pos + 1 < len ? _hex_value(s[pos])     : -1;
+					int const lo = pos + 1 < len ? _hex_value(s[pos + 1]) : -1;
+
+					if (hi < 0 || lo < 0) {
+						error("checksum of chunk ", i, " in ROM '", rom_name,
+						      "' is missing or malformed");
+						Genode::destroy(_alloc, _digests);
+						throw Invalid();
+					}
+					_digests[i].value[j] = (unsigned char)(hi << 4 | lo);
+				}
+			}
+		}
+
+		~Checksums() { Genode::destroy(_alloc, _digests); }
+
+		/**
+		 * Return true if 'data' matches the digest of 'chunk'
+		 */
+		bool verify(size_t chunk, void const *data, size_t size) const
+		{
+			if (chunk >= _count)
+				return false;
+
+			Digest digest;
+			SHA256((unsigned char const *)data, size, digest.value);
+			return !Genode::memcmp(digest.value, _digests[chunk].value,
+			                       sizeof(digest.value));
+		}
+};
+
+
+struct Stats
+{
+	unsigned long requests      = 0;
+	unsigned long bytes_read    = 0;
+	unsigned long bytes_fetched = 0;
+	unsigned long cache_hits    = 0;
+	unsigned long cache_misses  = 0;
+	unsigned long verify_errors = 0;
+};
+
+
 class Driver : public Block::Driver
 {
 	private:
 
-		size_t _block_size;
-		Http   _http;
+		enum {
+			MAX_PIPELINE       = 16,
+			DEFAULT_PIPELINE   = 4,
+			DEFAULT_READAHEAD  = 3,
+			DEFAULT_CHUNK_SIZE = 64 * 1024,
+			DEFAULT_CACHE_SIZE = 512 * 1024,
+		};
+
+		typedef Chunk_cache::Slot Slot;
+
+		Env           &_env;
+		size_t         _block_size;
+		Http           _http;
+		size_t   const _chunk_size;
+		Chunk_cache    _cache;
+		unsigned const _pipeline;
+		unsigned const _readahead;
+		Stats          _stats;
+
+		Constructible<Checksums> _checksums;
+
+		unsigned long _report_interval_ms = 1000;
+		unsigned long _reported_bytes     = 0;
+
+		Constructible<Timer::Connection>               _timer;
+		Reporter                                       _reporter { _env, "stats" };
+		Constructible<Timer::Periodic_timeout<Driver>> _report_timeout;
+
+		size_t _chunk_count() const {
+			return (_http.file_size() + _chunk_size - 1) / _chunk_size; }
+
+		size_t _chunk_bytes(size_t chunk) const {
+			return min(_chunk_size, _http.file_size() - chunk * _chunk_size); }
+
+		bool _valid(Slot const &slot) const
+		{
+			return !_checksums.constructed()
+			    || _checksums->verify(slot.chunk, slot.data,
+			                          _chunk_bytes(slot.chunk));
+		}
+
+		/**
+		 * Fetch the chunks assigned to 'slots' with one pipelined batch
+		 */
+		void _fetch(Slot **slots, unsigned count)
+		{
+			Http::Range ranges[MAX_PIPELINE];
+			size_t bytes = 0;
+
+			for (unsigned i = 0; i < count; i++) {
+				ranges[i] = { slots[i]->chunk * _chunk_size,
+				              _chunk_bytes(slots[i]->chunk),
+				              (addr_t)slots[i]->data };
+				bytes += ranges[i].size;
+			}
+
+			try { _http.cmd_get(ranges, count); }
+			catch (Http::Exception) {
+				for (unsigned i = 0; i < count; i++)
+					_cache.discard(*slots[i]);
+				throw Io_error();
+			}
+
+			_stats.cache_misses  += count;
+			_stats.bytes_fetched += bytes;
+		}
+
+		/**
+		 * Return slot holding the verified content of 'chunk'
+		 *
+		 * On a cache miss, the uncached chunks up to 'last_chunk' and
+		 * the configured number of read-ahead chunks are fetched along
+		 * with the requested one.
+		 */
+		Slot &_load(size_t chunk, size_t last_chunk)
+		{
+			if (Slot *slot = _cache.lookup(chunk)) {
+				_stats.cache_hits++;
+				return *slot;
+			}
+
+			unsigned const max_batch = min(_pipeline, _cache.slots());
+			size_t   const end       = min(last_chunk + _readahead + 1,
+			                               _chunk_count());
+
+			Slot    *batch[MAX_PIPELINE];
+			unsigned count = 0;
+
+			batch[count++] = &_cache.claim(chunk);
+			for (size_t c = chunk + 1; c < end && count < max_batch; c++)
+				if (!_cache.cached(c))
+					batch[count++] = &_cache.claim(c);
+
+			_fetch(batch, count);
+
+			auto discard_unverified = [&] () {
+				for (unsigned i = 0; i < count; i++)
+					if (!batch[i]->valid)
+						_cache.discard(*batch[i]);
+			};
+
+			for (unsigned i = 0; i < count; i++) {
+
+				Slot &slot = *batch[i];
+				if (_valid(slot)) {
+					slot.valid = true;
+					continue;
+				}
+
+				_stats.verify_errors++;
+				warning("checksum mismatch for chunk ", slot.chunk);
+
+				/* read-ahead chunks are fetched again on demand */
+				if (i > 0) {
+					_cache.discard(slot);
+					continue;
+				}
+
+				/* try requested chunk once more before giving up */
+				Slot *retry = &slot;
+				try { _fetch(&retry, 1); }
+				catch (Io_error) { discard_unverified(); throw; }
+
+				if (_valid(slot)) {
+					slot.valid = true;
+					continue;
+				}
+
+				_stats.verify_errors++;
+				error("chunk ", slot.chunk, " failed verification");
+				discard_unverified();
+				throw Io_error();
+			}
+			return *batch[0];
+		}
+
+		void _handle_report_timeout(Duration)
+		{
+			unsigned long const fetched = _stats.bytes_fetched - _reported_bytes;
+			_reported_bytes = _stats.bytes_fetched;
+
+			try {
+				Reporter::Xml_generator xml(_reporter, [&] () {
+					xml.attribute("requests",      _stats.requests);
+					xml.attribute("bytes_read",    _stats.bytes_read);
+					xml.attribute("bytes_fetched", _stats.bytes_fetched);
+					xml.attribute("cache_hits",    _stats.cache_hits);
+					xml.attribute("cache_misses",  _stats.cache_misses);
+					xml.attribute("verify_errors", _stats.verify_errors);
+					xml.attribute("http_requests", _http.requests());
+					xml.attribute("reconnects",    _http.reconnects());
+					xml.attribute("fetch_kib_per_s",
+					              fetched * 1000 / 1024 / _report_interval_ms);
+				});
+			} catch (...) { warning("could not report statistics"); }
+		}
 
 	public:
 
-		Driver(Heap &heap, Ram_session &ram,
-		       size_t block_size, ::String &uri)
-		: Block::Driver(ram),
-		  _block_size(block_size), _http(heap, uri) {}
+		Driver(Env &env, Heap &heap, size_t block_size, ::String &uri,
+		       Xml_node config)
+		:
+			Block::Driver(env.ram()), _env(env),
+			_block_size(block_size), _http(heap, uri),
+			_chunk_size(max((size_t)config.attribute_value("chunk_size",
+			                Number_of_bytes(DEFAULT_CHUNK_SIZE)), (size_t)1)),
+			_cache(heap, _chunk_size,
+			       (size_t)config.attribute_value("cache_size",
+			       Number_of_bytes(DEFAULT_CACHE_SIZE)) / _chunk_size),
+			_pipeline(max(1U, min((unsigned)MAX_PIPELINE,
+			          config.attribute_value("pipeline",
+			                                 (unsigned)DEFAULT_PIPELINE)))),
+			_readahead(config.attribute_value("readahead",
+			                                  (unsigned)DEFAULT_READAHEAD))
+		{
+			typedef Genode::String<64> Rom_name;
+			Rom_name const checksums = config.attribute_value("checksums",
+			                                                  Rom_name());
+			if (checksums.valid())
+				_checksums.construct(env, heap, checksums.string(),
+				                     _chunk_count());
+
+			try {
+				Xml_node report = config.sub_node("report");
+				if (report.attribute_value("stats", false)) {
+					_report_interval_ms = max(report.attribute_value(
+						"interval_ms", _report_interval_ms), 10UL);
+					_reporter.enabled(true);
+					_timer.construct(env);
+					_report_timeout.construct(*_timer, *this,
+					                          &Driver::_handle_report_timeout,
+					                          Microseconds(_report_interval_ms * 1000));
+				}
+			} catch (Xml_node::Nonexistent_sub_node) { }
+
+			log("chunk size ", Number_of_bytes(_chunk_size), ", ",
+			    _cache.slots(), " cached chunks, pipeline depth ", _pipeline,
+			    checksums.valid() ? ", verified" : "");
+		}
 
 
 		/*******************************
@@ -57,11 +348,33 @@ class Driver : public Block::Driver
 		          char                     *buffer,
 		          Block::Packet_descriptor &packet)
 		{
-			_http.cmd_get(block_nr * _block_size, block_count * _block_size,
-			              (addr_t)buffer);
+			size_t offset = block_nr * _block_size;
+			size_t size   = block_count * _block_size;
+
+			if (!size) {
+				ack_packet(packet);
+				return;
+			}
+
+			_stats.requests++;
+			_stats.bytes_read += size;
+
+			size_t const last_chunk = (offset + size - 1) / _chunk_size;
+
+			while (size) {
+				size_t const skip  = offset % _chunk_size;
+				size_t const bytes = min(size, _chunk_size - skip);
+
+				Slot &slot = _load(offset / _chunk_size, last_chunk);
+				Genode::memcpy(buffer, slot.data + skip, bytes);
+
+				buffer += bytes;
+				offset += bytes;
+				size   -= bytes;
+			}
 			ack_packet(packet);
 		}
-	};
+};
 
 
 class Factory : public Block::Driver_factory
@@ -90,7 +403,8 @@ class Factory : public Block::Driver_factory
 		}
 
 		Block::Driver *create() {
-			return new (&_heap) Driver(_heap, _env.ram(), _blk_sz, _uri); }
+			return new (&_heap) Driver(_env, _heap, _blk_sz, _uri,
+			                           _config.xml()); }
 
 	void destroy(Block::Driver *driver) {
 		Genode::destroy(&_heap, driver); }
@@ -1,4 +1,4 @@
 TARGET = http_blk
 SRC_CC = main.cc http.cc
-LIBS   = libc libc_lwip_nic_dhcp
+LIBS   = libc libc_lwip_nic_dhcp libcrypto
 
@@ -16,209 +16,82 @@
 #include <nitpicker_session/connection.h>
 #include <base/attached_rom_dataspace.h>
 #include <base/attached_ram_dataspace.h>
-#include <os/texture.h>
-#include <os/surface.h>
-#include <os/pixel_rgb565.h>
-#include <os/pixel_alpha8.h>
 #include <os/static_root.h>
-#include <util/reconstructible.h>
-#include <nitpicker_gfx/texture_painter.h>
 #include <util/lazy_value.h>
 #include <timer_session/connection.h>
 
-/* local includes */
-#include <alpha_dither_painter.h>
-
 namespace Nit_fader {
 
 	class Main;
-	class Src_buffer;
-	class Dst_buffer;
 	class Framebuffer_session_component;
 	class Nitpicker_session_component;
 
-	typedef Genode::Surface_base::Area  Area;
-	typedef Genode::Surface_base::Point Point;
-	typedef Genode::Surface_base::Rect  Rect;
-
 	using Genode::size_t;
-	using Genode::env;
 	using Genode::Xml_node;
 	using Genode::Dataspace_capability;
-	using Genode::Attached_ram_dataspace;
-	using Genode::Texture;
-	using Genode::Surface;
-	using Genode::Reconstructible;
-	using Genode::Constructible;
-
-	typedef Genode::Pixel_rgb565 Pixel_rgb565;
-	typedef Genode::Pixel_alpha8 Pixel_alpha8;
+	using Genode::Signal_context_capability;
 }
 
 
 /**
- * Buffer handed out to our client as virtual framebuffer
+ * Framebuffer session handed out to our client
+ *
+ * The client draws directly into the buffer of the nitpicker session. The
+ * session is interposed only to share the sync signal with the fader.
  */
-class Nit_fader::Src_buffer
-{
-	private:
-
-		typedef Pixel_rgb565 Pixel;
-
-		bool             const _use_alpha;
-		Attached_ram_dataspace _ds;
-		Texture<Pixel>         _texture;
-
-		static size_t _needed_bytes(Area size)
-		{
-			/* account for alpha channel, input mask, and pixels */
-			return size.count() * (1 + 1 + sizeof(Pixel));
-		}
-
-	public:
-
-		/**
-		 * Constructor
-		 */
-		Src_buffer(Genode::Env &env, Area size, bool use_alpha)
-		:
-			_use_alpha(use_alpha),
-			_ds(env.ram(), env.rm(), _needed_bytes(size)),
-			_texture(_ds.local_addr<Pixel>(),
-			         _ds.local_addr<unsigned char>() + size.count()*sizeof(Pixel),
-			         size)
-		{ }
-
-		Dataspace_capability dataspace() { return _ds.cap(); }
-
-		Texture<Pixel> const &texture() const { return _texture; }
-
-		bool use_alpha() const { return _use_alpha; }
-};
-
-
-class Nit_fader::Dst_buffer
-{
-	private:
-
-		Genode::Attached_dataspace _ds;
-		Area                       _size;
-
-		Surface<Pixel_rgb565> _pixel_surface { _ds.local_addr<Pixel_rgb565>(), _size };
-
-		Surface<Pixel_alpha8> _alpha_surface
-		{
-			_ds.local_addr<Pixel_alpha8>() + _size.count()*sizeof(Pixel_rgb565),
-			_size
-		};
-
-	public:
-
-		Dst_buffer(Genode::Env &env, Dataspace_capability ds_cap, Area size)
-		:
-			_ds(env.rm(), ds_cap), _size(size)
-		{
-			/* initialize input-mask buffer */
-			unsigned char *input_mask_buffer = _ds.local_addr<unsigned char>()
-			                                 + _size.count()*(1 + sizeof(Pixel_rgb565));
-
-			Genode::memset(input_mask_buffer, 0xff, _size.count());
-		}
-
-		Surface<Pixel_rgb565> &pixel_surface() { return _pixel_surface; }
-		Surface<Pixel_alpha8> &alpha_surface() { return _alpha_surface; }
-};
-
-
 class Nit_fader::Framebuffer_session_component
 :
 	public Genode::Rpc_object<Framebuffer::Session>
 {
 	private:
 
-		Genode::Env &_env;
-
 		Nitpicker::Connection &_nitpicker;
-		Src_buffer            &_src_buffer;
-
-		Constructible<Dst_buffer> _dst_buffer;
 
+		Signal_context_capability _client_sync_sigh;
+		Signal_context_capability _fader_sync_sigh;
 
-		Lazy_value<int> _fade;
+		/**
+		 * Install sync handler at the nitpicker session
+		 *
+		 * While no animation is in progress, the sync signals are delivered
+		 * to the client directly.
+		 */
+		void _install_sync_sigh()
+		{
+			_nitpicker.framebuffer()->sync_sigh(_fader_sync_sigh.valid()
+			                                    ? _fader_sync_sigh
+			                                    : _client_sync_sigh);
+		}
 
 	public:
 
 		/**
 		 * Constructor
 		 */
-		Framebuffer_session_component(Genode::Env &env,
-		                              Nitpicker::Connection &nitpicker,
-		                              Src_buffer            &src_buffer)
+		Framebuffer_session_component(Nitpicker::Connection &nitpicker)
 		:
-			_env(env), _nitpicker(nitpicker), _src_buffer(src_buffer)
+			_nitpicker(nitpicker)
 		{ }
 
-		void dst_buffer(Dataspace_capability ds_cap, Area size)
-		{
-			_dst_buffer.construct(_env, ds_cap, size);
-		}
-
-		void transfer_src_to_dst_pixel(Rect const rect)
-		{
-			if (!_dst_buffer.constructed())
-				return;
-
-			_dst_buffer->pixel_surface().clip(rect);
-
-			Texture_painter::paint(_dst_buffer->pixel_surface(),
-			                       _src_buffer.texture(),
-			                       Genode::Color(0, 0, 0),
-			                       Point(0, 0),
-			                       Texture_painter::SOLID,
-			                       false);
-		}
-
-		void transfer_src_to_dst_alpha(Rect const rect)
+		/**
+		 * Direct sync signals to the fader, or back to the client if 'sigh'
+		 * is invalid
+		 */
+		void fader_sync_sigh(Signal_context_capability sigh)
 		{
-			if (!_dst_buffer.constructed())
-				return;
-
-			_dst_buffer->alpha_surface().clip(rect);
-
-			if (_src_buffer.use_alpha()) {
-				Alpha_dither_painter::paint(_dst_buffer->alpha_surface(), rect, _fade,
-				                            _src_buffer.texture());
-			} else {
-				Alpha_dither_painter::paint(_dst_buffer->alpha_surface(), rect, _fade);
-			}
+			_fader_sync_sigh = sigh;
+			_install_sync_sigh();
 		}
 
-		Area size()
+		/**
+		 * Pass sync signal received by the fader to the client
+		 */
+		void forward_sync()
 		{
-			return _dst_buffer.constructed() ? _dst_buffer->pixel_surface().size()
-			                                 : Area();
+			if (_client_sync_sigh.valid())
+				Genode::Signal_transmitter(_client_sync_sigh).submit();
 		}
 
-		bool animate(unsigned num_frames)
-		{
-			for (unsigned i = 0; i < num_frames; i++)
-				_fade.animate();
-
-			Rect const rect(Point(0, 0), size());
-
-			transfer_src_to_dst_alpha(rect);
-
-			_nitpicker.framebuffer()->refresh(rect.x1(), rect.y1(), rect.w(), rect.h());
-
-			/* keep animating as long as the destination value is not reached */
-			return _fade != _fade.dst();
-		}
-
-		void fade(int fade_value, int steps) { _fade.dst(fade_value, steps); }
-
-		bool visible() const { return _fade != 0; }
-
-
 
 		/************************************
 		 ** Framebuffer::Session interface **
@@ -226,7 +99,7 @@ class Nit_fader::Framebuffer_session_component
 
 		Dataspace_capability dataspace() override
 		{
-			return _src_buffer.dataspace();
+			return _nitpicker.framebuffer()->dataspace();
 		}
 
 		Framebuffer::Mode mode() const override
@@ -234,26 +107,30 @@ class Nit_fader::Framebuffer_session_component
 			return _nitpicker.framebuffer()->mode();
 		}
 
-		void mode_sigh(Genode::Signal_context_capability sigh) override
+		void mode_sigh(Signal_context_capability sigh) override
 		{
 			_nitpicker.framebuffer()->mode_sigh(sigh);
 		}
 
 		void refresh(int x, int y, int w, int h) override
 		{
-			transfer_src_to_dst_pixel(Rect(Point(x, y), Area(w, h)));
-			transfer_src_to_dst_alpha(Rect(Point(x, y), Area(w, h)));
-
 			_nitpicker.framebuffer()->refresh(x, y, w, h);
 		}
 
-		void sync_sigh(Genode::Signal_context_capability sigh) override
+		void sync_sigh(Signal_context_capability sigh) override
 		{
-			_nitpicker.framebuffer()->sync_sigh(sigh);
+			_client_sync_sigh = sigh;
+			_install_sync_sigh();
 		}
 };
 
 
+/**
+ * Nitpicker session handed out to our client
+ *
+ * The fading is performed by nitpicker by the means of the opacity of the
+ * client's view.
+ */
 class Nit_fader::Nitpicker_session_component
 :
 	public Genode::Rpc_object<Nitpicker::Session>
@@ -262,11 +139,10 @@ class Nit_fader::Nitpicker_session_component
 
 		typedef Nitpicker::View_capability      View_capability;
 		typedef Nitpicker::Session::View_handle View_handle;
+		typedef Nitpicker::Session::Command     Command;
 
 		Genode::Env &_env;
 
-		Reconstructible<Src_buffer> _src_buffer { _env, Area(1, 1), false };
-
 		Nitpicker::Connection _nitpicker { _env };
 
 		Genode::Attached_ram_dataspace _command_ds {
@@ -275,29 +151,34 @@ class Nit_fader::Nitpicker_session_component
 		Nitpicker::Session::Command_buffer &_commands =
 			*_command_ds.local_addr<Nitpicker::Session::Command_buffer>();
 
-		Framebuffer_session_component _fb_session { _env, _nitpicker, *_src_buffer };
+		Framebuffer_session_component _fb_session { _nitpicker };
 
 		Framebuffer::Session_capability _fb_cap { _env.ep().manage(_fb_session) };
 
-		Nitpicker::Session::View_handle _view_handle;
-		bool _view_visible = false;
-		Rect _view_geometry;
+		Lazy_value<int> _fade;
+
+		View_handle _view_handle;
 
-		void _update_view_visibility()
+		/* opacity as last applied to the view */
+		unsigned _view_alpha = 255;
+
+		unsigned _alpha() const
 		{
-			if (!_view_handle.valid() || (_view_visible == _fb_session.visible()))
-				return;
+			int const alpha = (int)_fade >> 8;
+			return alpha < 0 ? 0 : alpha > 255 ? 255 : alpha;
+		}
 
-			typedef Nitpicker::Session::Command Command;
+		void _apply_alpha()
+		{
+			unsigned const alpha = _alpha();
 
-			if (_fb_session.visible())
-				_nitpicker.enqueue<Command::Geometry>(_view_handle, _view_geometry);
-			else
-				_nitpicker.enqueue<Command::Geometry>(_view_handle, Rect());
+			if (!_view_handle.valid() || alpha == _view_alpha)
+				return;
 
+			_nitpicker.enqueue<Command::Alpha>(_view_handle, (unsigned char)alpha);
 			_nitpicker.execute();
 
-			_view_visible = _fb_session.visible();
+			_view_alpha = alpha;
 		}
 
 	public:
@@ -316,19 +197,25 @@ class Nit_fader::Nitpicker_session_component
 			_env.ep().dissolve(_fb_session);
 		}
 
+		Framebuffer_session_component &fb_session() { return _fb_session; }
+
+		/**
+		 * Advance fading by 'num_frames'
+		 *
+		 * \return  true if the fading is still in progress
+		 */
 		bool animate(unsigned num_frames)
 		{
-			bool const keep_animating =  _fb_session.animate(num_frames);
+			for (unsigned i = 0; i < num_frames; i++)
+				_fade.animate();
 
-			_update_view_visibility();
+			_apply_alpha();
 
-			return keep_animating;
+			/* keep animating as long as the destination value is not reached */
+			return _fade != _fade.dst();
 		}
 
-		void fade(int fade_value, int steps)
-		{
-			_fb_session.fade(fade_value, steps);
-		}
+		void fade(int fade_value, int steps) { _fade.dst(fade_value, steps); }
 
 
 		/**********************************
@@ -348,6 +235,11 @@ class Nit_fader::Nitpicker_session_component
 		View_handle create_view(View_handle parent) override
 		{
 			_view_handle = _nitpicker.create_view(parent);
+
+			/* views are created opaque */
+			_view_alpha = 255;
+			_apply_alpha();
+
 			return _view_handle;
 		}
 
@@ -381,24 +273,15 @@ class Nit_fader::Nitpicker_session_component
 		{
 			for (unsigned i = 0; i < _commands.num(); i++) {
 
-				Nitpicker::Session::Command command = _commands.get(i);
-
-				bool forward_command = true;
-
-				if (command.opcode == Nitpicker::Session::Command::OP_GEOMETRY) {
-
-					/* remember view geometry as defined by the client */
-					_view_geometry = command.geometry.rect;
+				Command command = _commands.get(i);
 
-					if (!_view_visible)
-						forward_command = false;
-				}
+				/* the opacity of the client view is controlled by the fader */
+				if (command.opcode == Command::OP_ALPHA
+				 && command.alpha.view == _view_handle)
+					continue;
 
-				if (forward_command)
-					_nitpicker.enqueue(command);
+				_nitpicker.enqueue(command);
 			}
-			_fb_session.transfer_src_to_dst_pixel(Rect(Point(0, 0), _fb_session.size()));
-			_fb_session.transfer_src_to_dst_alpha(Rect(Point(0, 0), _fb_session.size()));
 			return _nitpicker.execute();
 		}
 
@@ -407,20 +290,14 @@ class Nit_fader::Nitpicker_session_component
 			return _nitpicker.mode();
 		}
 
-		void mode_sigh(Genode::Signal_context_capability sigh) override
+		void mode_sigh(Signal_context_capability sigh) override
 		{
 			_nitpicker.mode_sigh(sigh);
 		}
 
 		void buffer(Framebuffer::Mode mode, bool use_alpha) override
 		{
-			Area const size(mode.width(), mode.height());
-
-			_src_buffer.construct(_env, size, use_alpha);
-
-			_nitpicker.buffer(mode, true);
-
-			_fb_session.dst_buffer(_nitpicker.framebuffer()->dataspace(), size);
+			_nitpicker.buffer(mode, use_alpha);
 		}
 
 		void focus(Genode::Capability<Session> focused) override
@@ -460,26 +337,36 @@ struct Nit_fader::Main
 		env.ep().manage(nitpicker_session)
 	};
 
-	void handle_timer()
+	/**
+	 * Animate fading in the pace of the nitpicker sync signal
+	 *
+	 * The number of animation steps depends on the time passed such that
+	 * the speed of the fading is independent from the sync rate.
+	 */
+	void handle_sync()
 	{
-		unsigned long frame = curr_frame();
-		if (nitpicker_session.animate(frame - last_frame))
-			timer.trigger_once(PERIOD);
+		unsigned long const frame = curr_frame();
+
+		bool const animated = nitpicker_session.animate(frame - last_frame);
 
 		last_frame = frame;
+
+		nitpicker_session.fb_session().forward_sync();
+
+		/* stop receiving sync signals when idle */
+		if (!animated)
+			nitpicker_session.fb_session().fader_sync_sigh(Genode::Signal_context_capability());
 	}
 
-	Genode::Signal_handler<Main> timer_handler
+	Genode::Signal_handler<Main> sync_handler
 	{
-		env.ep(), *this, &Main::handle_timer
+		env.ep(), *this, &Main::handle_sync
 	};
 
 	Main(Genode::Env &env) : env(env)
 	{
 		config.sigh(config_handler);
 
-		timer.sigh(timer_handler);
-
 		/* apply initial config */
 		handle_config_update();
 
@@ -508,7 +395,7 @@ void Nit_fader::Main::handle_config_update()
 
 		/* schedule animation */
 		last_frame = curr_frame();
-		timer.trigger_once(PERIOD);
+		nitpicker_session.fb_session().fader_sync_sigh(sync_handler);
 	}
 }
 
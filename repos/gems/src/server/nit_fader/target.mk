@@ -1,4 +1,3 @@
 TARGET   = nit_fader
 SRC_CC   = main.cc
-LIBS     = base blit
-INC_DIR += $(PRG_DIR)
+LIBS     = base
@@ -24,9 +24,11 @@
 #include <os/session_policy.h>
 
 #include <libc/component.h>
-#include <pthread.h>
+#include <libc/select.h>
 
 /* socket API */
+#include <errno.h>
+#include <fcntl.h>
 #include <unistd.h>
 #include <sys/types.h>
 #include <sys/socket.h>
@@ -38,10 +40,105 @@
 static bool const verbose = true;
 
 
+/**
+ * Byte ring buffer
+ *
+ * Besides copying data in and out, the buffer exposes its contiguous free
+ * and occupied ranges, which are passed to the socket calls directly.
+ */
+class Io_ring
+{
+	private:
+
+		Genode::Attached_ram_dataspace _ds;
+
+		Genode::size_t const _capacity { _ds.size() };
+
+		char * const _data { _ds.local_addr<char>() };
+
+		Genode::size_t _head = 0; /* position of next write */
+		Genode::size_t _tail = 0; /* position of next read */
+		Genode::size_t _used = 0;
+
+	public:
+
+		Io_ring(Genode::Env &env, Genode::size_t capacity)
+		: _ds(env.ram(), env.rm(), capacity) { }
+
+		bool empty() const { return _used == 0; }
+		bool full()  const { return _used == _capacity; }
+
+		void clear() { _head = _tail = _used = 0; }
+
+		/**
+		 * Return contiguous free range at the write position
+		 */
+		char *write_range(Genode::size_t &len)
+		{
+			len = Genode::min(_capacity - _used, _capacity - _head);
+			return _data + _head;
+		}
+
+		void produced(Genode::size_t len)
+		{
+			_head  = (_head + len) % _capacity;
+			_used += len;
+		}
+
+		/**
+		 * Return contiguous occupied range at the read position
+		 */
+		char const *read_range(Genode::size_t &len) const
+		{
+			len = Genode::min(_used, _capacity - _tail);
+			return _data + _tail;
+		}
+
+		void consumed(Genode::size_t len)
+		{
+			_tail  = (_tail + len) % _capacity;
+			_used -= len;
+		}
+
+		Genode::size_t write(char const *src, Genode::size_t len)
+		{
+			Genode::size_t written = 0;
+			while (written < len && !full()) {
+				Genode::size_t n = 0;
+				char *dst = write_range(n);
+				n = Genode::min(n, len - written);
+				Genode::memcpy(dst, src + written, n);
+				produced(n);
+				written += n;
+			}
+			return written;
+		}
+
+		Genode::size_t read(char *dst, Genode::size_t len)
+		{
+			Genode::size_t num_read = 0;
+			while (num_read < len && !empty()) {
+				Genode::size_t n = 0;
+				char const *src = read_range(n);
+				n = Genode::min(n, len - num_read);
+				Genode::memcpy(dst + num_read, src, n);
+				consumed(n);
+				num_read += n;
+			}
+			return num_read;
+		}
+};
+
+
+class Open_socket_pool;
+
+
 class Open_socket : public Genode::List<Open_socket>::Element
 {
 	private:
 
+		Open_socket_pool &_pool;
+
 		/**
 		 * Socket descriptor for listening to a new TCP connection
 		 */
@@ -63,20 +160,22 @@ class Open_socket : public Genode::List<Open_socket>::Element
 		Genode::Signal_context_capability _read_avail_sigh;
 
 		/**
-		 * Buffer for incoming data
+		 * Buffers for incoming and outgoing data
 		 *
-		 * This buffer is used for synchronizing the reception of data in the
-		 * main thread ('watch_sockets_for_incoming_data') and the entrypoint
-		 * thread ('read'). The main thread fills the buffer if its not already
-		 * occupied and the entrypoint thread consumes the buffer. When the
-		 * buffer becomes occupied, the corresponding socket gets removed from
-		 * the 'rfds' set of 'select()' until a read request from the terminal
-		 * client comes in.
+		 * Both buffers are served by the I/O loop of the socket pool. The
+		 * socket is watched for reading as long as the receive buffer can
+		 * take data. Otherwise, the incoming data queues up in the TCP/IP
+		 * stack. The socket is watched for writing as long as the send
+		 * buffer holds data.
 		 */
-		enum { READ_BUF_SIZE = 4096 };
-		char           _read_buf[READ_BUF_SIZE];
-		Genode::size_t _read_buf_bytes_used;
-		Genode::size_t _read_buf_bytes_read;
+		Io_ring _rx_buf;
+		Io_ring _tx_buf;
+
+		static bool _would_block(int ret) {
+			return ret < 0 && (errno == EAGAIN || errno == EWOULDBLOCK); }
+
+		static void _set_nonblocking(int sd) {
+			fcntl(sd, F_SETFL, fcntl(sd, F_GETFL) | O_NONBLOCK); }
 
 		/**
 		 * Establish remote connection
@@ -98,38 +197,121 @@ class Open_socket : public Genode::List<Open_socket>::Element
 
 			if (bind(listen_sd, (struct sockaddr *)&sockaddr, sizeof(sockaddr))) {
 				Genode::error("bind to port ", tcp_port, " failed");
+				close(listen_sd);
 				return -1;
 			}
 
 			if (listen(listen_sd, 1)) {
 				Genode::error("listen failed");
+				close(listen_sd);
 				return -1;
 			}
 
+			_set_nonblocking(listen_sd);
+
 			Genode::log("listening on port ", tcp_port, "...");
 			return listen_sd;
 		}
 
-	public:
+		void _close_connection()
+		{
+			close(_sd);
+			_sd = -1;
 
-		Open_socket(int tcp_port);
+			/* drop data that cannot be delivered anymore */
+			_tx_buf.clear();
 
-		~Open_socket();
+			if (verbose)
+				Genode::log("connection closed");
+		}
+
+		void _accept_remote_connection()
+		{
+			struct sockaddr addr;
+			socklen_t len = sizeof(addr);
+			_sd = accept(_listen_sd, &addr, &len);
+
+			if (_sd == -1)
+				return;
+
+			_set_nonblocking(_sd);
+
+			Genode::log("connection established");
+
+			/*
+			 * Inform client about the finished initialization of the terminal
+			 * session
+			 */
+			if (_connected_sigh.valid())
+				Genode::Signal_transmitter(_connected_sigh).submit();
+		}
 
 		/**
-		 * Return socket descriptor for listening to new connections
+		 * Fetch data from socket into the receive buffer
 		 */
-		int listen_sd() const { return _listen_sd; }
+		void _fill_read_buffer_and_notify_client()
+		{
+			bool const was_empty = _rx_buf.empty();
+
+			while (connection_established() && !_rx_buf.full()) {
+
+				Genode::size_t len = 0;
+				char *dst = _rx_buf.write_range(len);
+
+				ssize_t const ret = ::read(_sd, dst, len);
+
+				if (_would_block(ret))
+					break;
+
+				if (ret <= 0) {
+					_close_connection();
+					break;
+				}
+
+				_rx_buf.produced(ret);
+			}
+
+			/* notify client about bytes available for reading */
+			if (was_empty && !_rx_buf.empty() && _read_avail_sigh.valid())
+				Genode::Signal_transmitter(_read_avail_sigh).submit();
+		}
 
 		/**
-		 * Return true if all steps of '_remote_listen' succeeded
+		 * Send data of the send buffer as far as the socket accepts it
 		 */
-		bool listen_sd_valid() const { return _listen_sd != -1; }
+		void _flush_write_buffer()
+		{
+			while (connection_established() && !_tx_buf.empty()) {
+
+				Genode::size_t len = 0;
+				char const *src = _tx_buf.read_range(len);
+
+				ssize_t const ret = ::write(_sd, src, len);
+
+				if (_would_block(ret))
+					break;
+
+				if (ret <= 0) {
+					Genode::error("write error, dropping data");
+					_close_connection();
+					break;
+				}
+
+				_tx_buf.consumed(ret);
+			}
+		}
+
+	public:
+
+		Open_socket(Genode::Env &env, Open_socket_pool &pool, int tcp_port,
+		            Genode::size_t rx_buf_size, Genode::size_t tx_buf_size);
+
+		~Open_socket();
 
 		/**
-		 * Return socket descriptor of the connection
+		 * Return true if all steps of '_remote_listen' succeeded
 		 */
-		int sd() const { return _sd; }
+		bool listen_sd_valid() const { return _listen_sd != -1; }
 
 		/**
 		 * Register signal handler to be notified once we accepted the TCP
@@ -150,29 +332,6 @@ class Open_socket : public Genode::List<Open_socket>::Element
 				Genode::Signal_transmitter(_read_avail_sigh).submit();
 		}
 
-		/**
-		 * Accept new connection, defining the connection's socket descriptor
-		 *
-		 * This function is called by the 'select()' thread when a new
-		 * connection is pending.
-		 */
-		void accept_remote_connection()
-		{
-			struct sockaddr addr;
-			socklen_t len = sizeof(addr);
-			_sd = accept(_listen_sd, &addr, &len);
-
-			if (_sd != -1)
-				Genode::log("connection established");
-
-			/*
-			 * Inform client about the finished initialization of the terminal
-			 * session
-			 */
-			if (_connected_sigh.valid())
-				Genode::Signal_transmitter(_connected_sigh).submit();
-		}
-
 		/**
 		 * Return true if TCP connection is established
 		 *
@@ -182,234 +341,204 @@ class Open_socket : public Genode::List<Open_socket>::Element
 		bool connection_established() const { return _sd != -1; }
 
 		/**
-		 * Fetch data from socket into internal read buffer
+		 * Add socket descriptors to the sets watched by the I/O loop
 		 */
-		void fill_read_buffer_and_notify_client()
+		void collect_fds(fd_set &rfds, fd_set &wfds, int &nfds) const
 		{
-			if (_read_buf_bytes_used) {
-				Genode::warning("read buffer already in use");
+			/*
+			 * If one of the steps of creating the listen socket failed,
+			 * skip the session.
+			 */
+			if (!listen_sd_valid())
 				return;
-			}
-
-			/* read from socket */
-			_read_buf_bytes_used = ::read(_sd, _read_buf, sizeof(_read_buf));
 
-			if (_read_buf_bytes_used == 0) {
-				close(_sd);
-				_sd = -1;
+			/*
+			 * If the connection is not already established, tell 'select'
+			 * to notify us about a new connection.
+			 */
+			if (!connection_established()) {
+				FD_SET(_listen_sd, &rfds);
+				nfds = Genode::max(nfds, _listen_sd);
 				return;
 			}
 
-			/* notify client about bytes available for reading */
-			if (_read_avail_sigh.valid())
-				Genode::Signal_transmitter(_read_avail_sigh).submit();
+			if (!_rx_buf.full())
+				FD_SET(_sd, &rfds);
+
+			if (!_tx_buf.empty())
+				FD_SET(_sd, &wfds);
+
+			nfds = Genode::max(nfds, _sd);
 		}
 
 		/**
-		 * Read out internal read buffer and copy into destination buffer.
+		 * Respond to socket descriptors reported ready by the I/O loop
 		 */
-		Genode::size_t read_buffer(char *dst, Genode::size_t dst_len)
+		void handle_io(fd_set const &rfds, fd_set const &wfds)
 		{
-			Genode::size_t num_bytes = Genode::min(dst_len, _read_buf_bytes_used -
-			                                       _read_buf_bytes_read);
-			Genode::memcpy(dst, _read_buf + _read_buf_bytes_read, num_bytes);
+			if (!listen_sd_valid())
+				return;
 
-			_read_buf_bytes_read += num_bytes;
-			if (_read_buf_bytes_read >= _read_buf_bytes_used)
-				_read_buf_bytes_used = _read_buf_bytes_read = 0;
+			if (!connection_established()) {
+				if (FD_ISSET(_listen_sd, &rfds))
+					_accept_remote_connection();
+				return;
+			}
 
-			/* notify client if there are still bytes available for reading */
-			if (_read_avail_sigh.valid() && !read_buffer_empty())
-				Genode::Signal_transmitter(_read_avail_sigh).submit();
+			if (FD_ISSET(_sd, &wfds))
+				_flush_write_buffer();
 
-			return num_bytes;
+			if (connection_established() && FD_ISSET(_sd, &rfds))
+				_fill_read_buffer_and_notify_client();
 		}
 
 		/**
-		 * Return true if the internal read buffer is ready to receive data
+		 * Read out receive buffer and copy into destination buffer
 		 */
-		bool read_buffer_empty() const { return _read_buf_bytes_used == 0; }
-};
-
-
-class Open_socket_pool
-{
-	private:
+		Genode::size_t read_buffer(char *dst, Genode::size_t dst_len);
 
 		/**
-		 * Protection for '_list'
+		 * Queue data for sending
+		 *
+		 * \return number of bytes taken, which is lower than 'len' if the
+		 *         send buffer is exhausted
 		 */
-		Genode::Lock _lock;
+		Genode::size_t write_buffer(char const *src, Genode::size_t len);
 
 		/**
-		 * List of open sockets
+		 * Return true if the receive buffer holds no data
 		 */
-		Genode::List<Open_socket> _list;
+		bool read_buffer_empty() const { return _rx_buf.empty(); }
+};
 
-		/**
-		 * Thread doing the select
-		 */
-		pthread_t _select;
 
-		/**
-		 * Number of currently open sockets
-		 */
-		int _count;
+/**
+ * I/O loop serving the sockets of all sessions
+ *
+ * The loop runs in the context of the entrypoint. Whenever the set of
+ * socket descriptors to watch changes, 'watch' re-arms the select handler
+ * of the libc, which calls back once one of the descriptors becomes ready.
+ */
+class Open_socket_pool
+{
+	private:
 
 		/**
-		 * Pipe used to synchronize 'select()' loop with the entrypoint thread
+		 * List of open sockets
 		 */
-		int sync_pipe_fds[2];
+		Genode::List<Open_socket> _list;
 
-		/**
-		 * Intercept the blocking state of the current 'select()' call
-		 */
-		void _wakeup_select()
+		void _handle_io(fd_set const &rfds, fd_set const &wfds)
 		{
-			char c = 0;
-			::write(sync_pipe_fds[1], &c, sizeof(c));
+			Libc::with_libc([&] () {
+				for (Open_socket *s = _list.first(); s; s = s->next())
+					s->handle_io(rfds, wfds);
+			});
 		}
 
-		static void * entry(void *arg) {
-			Open_socket_pool * pool = reinterpret_cast<Open_socket_pool *>(arg);
-
-			for (;;)
-				pool->watch_sockets_for_incoming_data();
-
-			return nullptr;
+		void _select_ready(int, fd_set const &rfds, fd_set const &wfds,
+		                   fd_set const &)
+		{
+			_handle_io(rfds, wfds);
+			watch();
 		}
 
-	public:
-
-		Open_socket_pool(Genode::Env &env)
-		: _count(0)
-		{
-			pipe(sync_pipe_fds);
+		Libc::Select_handler<Open_socket_pool> _select_handler {
+			*this, &Open_socket_pool::_select_ready };
 
-			if (pthread_create(&_select, nullptr, entry, this)) {
-				class Startup_select_thread_failed : Genode::Exception { };
-				throw Startup_select_thread_failed();
-			}
-		}
+	public:
 
 		void insert(Open_socket *s)
 		{
-			Genode::Lock::Guard guard(_lock);
 			_list.insert(s);
-			_count++;
-			_wakeup_select();
+			watch();
 		}
 
 		void remove(Open_socket *s)
 		{
-			Genode::Lock::Guard guard(_lock);
 			_list.remove(s);
-			_count--;
-			_wakeup_select();
+			watch();
 		}
 
-		void update_sockets_to_watch()
-		{
-			_wakeup_select();
-		}
-
-		void watch_sockets_for_incoming_data()
+		/**
+		 * Serve all ready sockets and wait for further events
+		 */
+		void watch()
 		{
-			/* prepare arguments for 'select()' */
-			fd_set rfds;
-			int    nfds = 0;
-			{
-				Genode::Lock::Guard guard(_lock);
-
-				/* collect file descriptors of all open sessions */
+			for (;;) {
+				fd_set rfds, wfds, efds;
 				FD_ZERO(&rfds);
-				for (Open_socket *s = _list.first(); s; s = s->next()) {
-
-					/*
-					 * If one of the steps of creating the listen socket
-					 * failed, skip the session.
-					 */
-					if (!s->listen_sd_valid())
-						continue;
-
-					/*
-					 * If the connection is not already established, tell
-					 * 'select' to notify us about a new connection.
-					 */
-					if (!s->connection_established()) {
-						nfds = Genode::max(nfds, s->listen_sd());
-						FD_SET(s->listen_sd(), &rfds);
-						continue;
-					}
-
-					/*
-					 * The connection is established. We watch the connection's
-					 * file descriptor for reading, but only if our buffer can
-					 * take new data. Otherwise, we let the incoming data queue
-					 * up in the TCP/IP stack.
-					 */
-					nfds = Genode::max(nfds, s->sd());
-					if (s->read_buffer_empty())
-						FD_SET(s->sd(), &rfds);
-				}
+				FD_ZERO(&wfds);
+				FD_ZERO(&efds);
 
-				/* add sync pipe to set of file descriptors to watch */
-				FD_SET(sync_pipe_fds[0], &rfds);
-				nfds = Genode::max(nfds, sync_pipe_fds[0]);
-			}
+				int nfds = 0;
+				for (Open_socket *s = _list.first(); s; s = s->next())
+					s->collect_fds(rfds, wfds, nfds);
 
-			/* block for incoming data or sync-pipe events */
-			select(nfds + 1, &rfds, NULL, NULL, NULL);
+				/* a return value of 0 schedules '_select_ready' */
+				if (!_select_handler.select(nfds + 1, rfds, wfds, efds))
+					return;
 
-			/* check if we were woken up via the sync pipe */
-			if (FD_ISSET(sync_pipe_fds[0], &rfds)) {
-				char c = 0;
-				::read(sync_pipe_fds[0], &c, 1);
-				return;
-			}
-
-			/* read pending data from sockets */
-			{
-				Genode::Lock::Guard guard(_lock);
-
-				for (Open_socket *s = _list.first(); s; s = s->next()) {
-
-					/* look for new connection */
-					if (!s->connection_established()) {
-						if (FD_ISSET(s->listen_sd(), &rfds))
-							s->accept_remote_connection();
-						continue;
-					}
-
-					/* connection is established, look for incoming data */
-					if (FD_ISSET(s->sd(), &rfds))
-						s->fill_read_buffer_and_notify_client();
-				}
+				_handle_io(rfds, wfds);
 			}
 		}
 };
 
 
-Open_socket_pool *open_socket_pool(Genode::Env * env = nullptr)
+Open_socket::Open_socket(Genode::Env &env, Open_socket_pool &pool, int tcp_port,
+                         Genode::size_t rx_buf_size, Genode::size_t tx_buf_size)
+:
+	_pool(pool), _listen_sd(_remote_listen(tcp_port)), _sd(-1),
+	_rx_buf(env, rx_buf_size), _tx_buf(env, tx_buf_size)
 {
-	static Open_socket_pool inst(*env);
-	return &inst;
+	_pool.insert(this);
 }
 
 
-Open_socket::Open_socket(int tcp_port)
-:
-	_listen_sd(_remote_listen(tcp_port)), _sd(-1),
-	_read_buf_bytes_used(0), _read_buf_bytes_read(0)
+Open_socket::~Open_socket()
 {
-	open_socket_pool()->insert(this);
+	if (_sd != -1) close(_sd);
+	if (_listen_sd != -1) close(_listen_sd);
+	_pool.remove(this);
 }
 
 
-Open_socket::~Open_socket()
+Genode::size_t Open_socket::read_buffer(char *dst, Genode::size_t dst_len)
 {
-	if (_sd != -1) close(_sd);
-	open_socket_pool()->remove(this);
+	bool const was_full = _rx_buf.full();
+
+	Genode::size_t const num_bytes = _rx_buf.read(dst, dst_len);
+
+	/* notify client if there are still bytes available for reading */
+	if (_read_avail_sigh.valid() && !read_buffer_empty())
+		Genode::Signal_transmitter(_read_avail_sigh).submit();
+
+	/* look if more data is buffered in the TCP/IP stack */
+	if (was_full && num_bytes)
+		_pool.watch();
+
+	return num_bytes;
+}
+
+
+Genode::size_t Open_socket::write_buffer(char const *src, Genode::size_t len)
+{
+	if (!connection_established()) {
+		Genode::error("no connection, dropping data");
+		return 0;
+	}
+
+	bool const was_empty = _tx_buf.empty();
+
+	Genode::size_t const num_bytes = _tx_buf.write(src, len);
+
+	/* send right away and leave the remainder to the I/O loop */
+	_flush_write_buffer();
+
+	if (was_empty && !_tx_buf.empty())
+		_pool.watch();
+
+	return num_bytes;
 }
 
 
@@ -427,9 +556,11 @@ class Terminal::Session_component : public Genode::Rpc_object<Session, Session_c
 
 	public:
 
-		Session_component(Genode::Env &env, Genode::size_t io_buffer_size, int tcp_port)
+		Session_component(Genode::Env &env, Open_socket_pool &pool,
+		                  Genode::size_t io_buffer_size, int tcp_port,
+		                  Genode::size_t rx_buf_size, Genode::size_t tx_buf_size)
 		:
-			Open_socket(tcp_port),
+			Open_socket(env, pool, tcp_port, rx_buf_size, tx_buf_size),
 			_io_buffer(env.ram(), env.rm(), io_buffer_size)
 		{ }
 
@@ -439,12 +570,7 @@ class Terminal::Session_component : public Genode::Rpc_object<Session, Session_c
 
 		Size size() { return Size(0, 0); }
 
-		bool avail()
-		{
-			bool ret = false;
-			Libc::with_libc([&] () { ret = !read_buffer_empty(); });
-			return ret;
-		}
+		bool avail() { return !read_buffer_empty(); }
 
 		Genode::size_t _read(Genode::size_t dst_len)
 		{
@@ -452,34 +578,17 @@ class Terminal::Session_component : public Genode::Rpc_object<Session, Session_c
 			Libc::with_libc([&] () {
 				num_bytes = read_buffer(_io_buffer.local_addr<char>(),
 				                        Genode::min(_io_buffer.size(), dst_len));
-
-				/*
-				 * If read buffer was in use, look if more data is buffered in
-				 * the TCP/IP stack.
-				 */
-				if (num_bytes)
-					open_socket_pool()->update_sockets_to_watch();
 			});
 			return num_bytes;
 		}
 
 		Genode::size_t _write(Genode::size_t num_bytes)
 		{
-			ssize_t written_bytes = 0;
+			Genode::size_t written_bytes = 0;
 
 			Libc::with_libc([&] () {
-				/* sanitize argument */
-				num_bytes = Genode::min(num_bytes, _io_buffer.size());
-
-				/* write data to socket, assuming that it won't block */
-				written_bytes = ::write(sd(),
-				                        _io_buffer.local_addr<char>(),
-				                        num_bytes);
-
-				if (written_bytes < 0) {
-					Genode::error("write error, dropping data");
-					written_bytes = 0;
-				}
+				written_bytes = write_buffer(_io_buffer.local_addr<char>(),
+				                             Genode::min(num_bytes, _io_buffer.size()));
 			});
 
 			return written_bytes;
@@ -509,8 +618,16 @@ class Terminal::Root_component : public Genode::Root_component<Session_component
 {
 	private:
 
-		Genode::Env &_env;
+		enum { DEFAULT_IO_BUFFER_SIZE = 4096,
+		       MAX_IO_BUFFER_SIZE     = 64*1024,
+		       DEFAULT_BUFFER_SIZE    = 16*1024 };
+
+		Genode::Env      &_env;
 		Genode::Xml_node  _config;
+		Open_socket_pool  _pool;
+
+		Genode::size_t _buffer_size(char const *attr) const {
+			return _config.attribute_value(attr, (Genode::size_t)DEFAULT_BUFFER_SIZE); }
 
 	protected:
 
@@ -518,10 +635,13 @@ class Terminal::Root_component : public Genode::Root_component<Session_component
 		{
 			using namespace Genode;
 
-			/*
-			 * XXX read I/O buffer size from args
-			 */
-			Genode::size_t io_buffer_size = 4096;
+			size_t io_buffer_size =
+				Arg_string::find_arg(args, "io_buffer_size").ulong_value(0);
+
+			if (!io_buffer_size)
+				io_buffer_size = DEFAULT_IO_BUFFER_SIZE;
+
+			io_buffer_size = min(io_buffer_size, (size_t)MAX_IO_BUFFER_SIZE);
 
 			try {
 				Session_label const label = label_from_args(args);
@@ -532,7 +652,9 @@ class Terminal::Root_component : public Genode::Root_component<Session_component
 				Session_component *session = nullptr;
 				Libc::with_libc([&] () {
 					session = new (md_alloc())
-						Session_component(_env, io_buffer_size, tcp_port);
+						Session_component(_env, _pool, io_buffer_size, tcp_port,
+						                  _buffer_size("rx_buffer"),
+						                  _buffer_size("tx_buffer"));
 				});
 				return session;
 			}
@@ -546,6 +668,12 @@ class Terminal::Root_component : public Genode::Root_component<Session_component
 			}
 		}
 
+		void _destroy_session(Session_component *session)
+		{
+			Libc::with_libc([&] () {
+				Genode::Root_component<Session_component>::_destroy_session(session); });
+		}
+
 	public:
 
 		/**
@@ -577,10 +705,6 @@ struct Main
 	Main(Genode::Env &env) : _env(env)
 	{
 		Genode::log("--- TCP terminal started ---");
-		Libc::with_libc([&] () {
-			/* start thread blocking in select */
-			open_socket_pool(&_env);
-		});
 
 		/* announce service at our parent */
 		_env.parent().announce(env.ep().manage(_root));
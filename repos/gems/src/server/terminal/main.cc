@@ -43,7 +43,10 @@ namespace Terminal {
 
 
 using Genode::Pixel_rgb565;
-typedef Text_painter::Font Font;
+typedef Text_painter::Font  Font;
+typedef Text_painter::Point Point;
+typedef Text_painter::Area  Area;
+typedef Text_painter::Rect  Rect;
 
 
 static bool const verbose = false;
@@ -131,6 +134,7 @@ inline void draw_glyph(Color                fg_color,
                        unsigned             glyph_width,
                        unsigned             glyph_img_width,
                        unsigned             glyph_img_height,
+                       Font::Box            glyph_box,
                        unsigned             cell_width,
                        PT                  *fb_base,
                        unsigned             fb_width)
@@ -164,9 +168,29 @@ inline void draw_glyph(Color                fg_color,
 	/* center glyph horizontally within its cell */
 	fb_base += left_gap;
 
+	/*
+	 * Only the pixels within the glyph's box need to be mixed, all others
+	 * are of the background color.
+	 */
+	unsigned const x1 = glyph_box.x1, x2 = Genode::min((unsigned)glyph_box.x2 + 1, glyph_width);
+
 	for (unsigned y = 0 ; y < glyph_img_height; y++) {
-		for (unsigned x = 0; x < glyph_width; x++)
-			fb_base[x] = mix(bg_pixel, fg_pixel, glyph_base[x]);
+
+		bool const visible = y >= glyph_box.y1 && y <= glyph_box.y2;
+
+		if (!visible || x1 >= x2) {
+			for (unsigned x = 0; x < glyph_width; x++)
+				fb_base[x] = bg_pixel;
+		} else {
+			for (unsigned x = 0; x < x1; x++)
+				fb_base[x] = bg_pixel;
+
+			for (unsigned x = x1; x < x2; x++)
+				fb_base[x] = mix(bg_pixel, fg_pixel, glyph_base[x]);
+
+			for (unsigned x = x2; x < glyph_width; x++)
+				fb_base[x] = bg_pixel;
+		}
 
 		fb_base    += fb_width;
 		glyph_base += glyph_img_width;
@@ -174,13 +198,20 @@ inline void draw_glyph(Color                fg_color,
 }
 
 
+/**
+ * Convert dirty character cells to pixels
+ *
+ * \return bounding box of the converted cells in pixels
+ */
 template <typename PT>
-static void convert_char_array_to_pixels(Cell_array<Char_cell> *cell_array,
+static Rect convert_char_array_to_pixels(Cell_array<Char_cell> *cell_array,
                                          PT                    *fb_base,
                                          unsigned               fb_width,
                                          unsigned               fb_height,
                                          Font_family const     &font_family)
 {
+	Rect dirty { };
+
 	Font const &regular_font = *font_family.font(Font_face::REGULAR);
 	unsigned glyph_height = regular_font.img_h,
 	         glyph_step_x = regular_font.wtab['m'];
@@ -194,7 +225,11 @@ static void convert_char_array_to_pixels(Cell_array<Char_cell> *cell_array,
 				Genode::log("convert line ", line);
 
 			unsigned x = 0;
-			for (unsigned column = 0; column < cell_array->num_cols(); column++) {
+			for (unsigned column = 0; column < cell_array->num_cols();
+			     column++, x += glyph_step_x) {
+
+				if (!cell_array->cell_dirty(column, line))
+					continue;
 
 				Char_cell      cell  = cell_array->get_cell(column, line);
 				Font const    *font  = font_family.font(cell.font_face());
@@ -220,9 +255,10 @@ static void convert_char_array_to_pixels(Cell_array<Char_cell> *cell_array,
 				draw_glyph<PT>(fg_color, bg_color,
 				               glyph_base, glyph_width,
 				               (unsigned)font->img_w, (unsigned)font->img_h,
-				               glyph_step_x, fb_base + x, fb_width);
+				               font->box(ascii), glyph_step_x, fb_base + x, fb_width);
 
-				x += glyph_step_x;
+				Rect const cell_rect(Point(x, y), Area(glyph_step_x, glyph_height));
+				dirty = dirty.valid() ? Rect::compound(dirty, cell_rect) : cell_rect;
 			}
 		}
 		y       += glyph_height;
@@ -230,6 +266,7 @@ static void convert_char_array_to_pixels(Cell_array<Char_cell> *cell_array,
 
 		if (y + glyph_height > fb_height) break;
 	}
+	return dirty;
 }
 
 
@@ -306,6 +343,43 @@ namespace Terminal {
 
 			Font_family const               &_font_family;
 
+			/**
+			 * Move pixels of a scrolled region
+			 *
+			 * \return pixel area affected by the scroll operation
+			 */
+			::Rect _scroll_pixels(Cell_array<Char_cell>::Scroll const &scroll)
+			{
+				int const region = scroll.end - scroll.start + 1;
+				int const lines  = Genode::min(region, scroll.lines < 0 ? -scroll.lines
+				                                                        : scroll.lines);
+
+				::Rect const rect(::Point(0, scroll.start*_char_height),
+				                  ::Area(_columns*_char_width, region*_char_height));
+
+				/* the exposed lines are marked as dirty and get redrawn */
+				int const moved = (region - lines)*_char_height;
+				if (moved <= 0)
+					return rect;
+
+				Pixel_rgb565  *fb     = (Pixel_rgb565 *)_fb_addr;
+				unsigned const stride = _fb_mode.width();
+				size_t   const bytes  = rect.w()*sizeof(Pixel_rgb565);
+				int      const dy     = lines*_char_height;
+
+				Pixel_rgb565 *top = fb + rect.y1()*stride;
+
+				/* the rows are at least one text line apart and thus disjoint */
+				if (scroll.lines > 0)
+					for (int y = 0; y < moved; y++)
+						Genode::memcpy(top + y*stride, top + (y + dy)*stride, bytes);
+				else
+					for (int y = moved - 1; y >= 0; y--)
+						Genode::memcpy(top + (y + dy)*stride, top + y*stride, bytes);
+
+				return rect;
+			}
+
 			/**
 			 * Initialize framebuffer-related attributes
 			 */
@@ -357,6 +431,9 @@ namespace Terminal {
 			{
 				using namespace Genode;
 
+				/* scroll by moving pixels instead of redrawing all lines */
+				_char_cell_array.track_scrolls(true);
+
 				log("new terminal session:");
 				log("  framebuffer has mode ", _fb_mode);
 				log("  character size is ", _char_width, "x", _char_height, " pixels");
@@ -376,30 +453,28 @@ namespace Terminal {
 			{
 				Genode::Lock::Guard guard(_lock);
 
-				convert_char_array_to_pixels<Pixel_rgb565>(&_char_cell_array,
-				                                           (Pixel_rgb565 *)_fb_addr,
-				                                           _fb_mode.width(),
-				                                           _fb_mode.height(),
-				                                           _font_family);
+				::Rect scrolled { };
+				_char_cell_array.flush_scrolls([&] (Cell_array<Char_cell>::Scroll const &scroll) {
+					::Rect const rect = _scroll_pixels(scroll);
+					scrolled = scrolled.valid() ? ::Rect::compound(scrolled, rect) : rect;
+				});
 
-				
-				int first_dirty_line =  10000,
-				    last_dirty_line  = -10000;
+				::Rect dirty =
+					convert_char_array_to_pixels<Pixel_rgb565>(&_char_cell_array,
+					                                           (Pixel_rgb565 *)_fb_addr,
+					                                           _fb_mode.width(),
+					                                           _fb_mode.height(),
+					                                           _font_family);
 
-				for (int line = 0; line < (int)_char_cell_array.num_lines(); line++) {
-					if (!_char_cell_array.line_dirty(line)) continue;
+				if (scrolled.valid())
+					dirty = dirty.valid() ? ::Rect::compound(dirty, scrolled) : scrolled;
 
-					first_dirty_line = Genode::min(line, first_dirty_line);
-					last_dirty_line  = Genode::max(line, last_dirty_line);
-
-					_char_cell_array.mark_line_as_clean(line);
-				}
+				for (int line = 0; line < (int)_char_cell_array.num_lines(); line++)
+					if (_char_cell_array.line_dirty(line))
+						_char_cell_array.mark_line_as_clean(line);
 
-				int num_dirty_lines = last_dirty_line - first_dirty_line + 1;
-				if (num_dirty_lines > 0)
-					_framebuffer.refresh(0, first_dirty_line*_char_height,
-					                     _fb_mode.width(),
-					                     num_dirty_lines*_char_height);
+				if (dirty.valid())
+					_framebuffer.refresh(dirty.x1(), dirty.y1(), dirty.w(), dirty.h());
 			}
 
 
@@ -565,14 +640,34 @@ struct Terminal::Main
 	 */
 	unsigned const _flush_delay = 5;
 
+	/*
+	 * In throughput mode, the pixels are updated at most once per period of
+	 * the display refresh rate. Rapidly changing content, e.g., a scrolling
+	 * log, is thereby rendered only as often as it can be displayed.
+	 */
+	unsigned long const _refresh_period_us;
+
+	unsigned long _last_flush_us = 0;
+
+	unsigned long _now_us() { return _timer.curr_time().trunc_to_plain_us().value; }
+
 	bool _flush_scheduled = false;
 
 	void _trigger_flush()
 	{
-		if (!_flush_scheduled) {
-			_flush_timeout.schedule(Microseconds{1000*_flush_delay});
-			_flush_scheduled = true;
+		if (_flush_scheduled)
+			return;
+
+		unsigned long delay_us = 1000*_flush_delay;
+
+		if (_refresh_period_us) {
+			unsigned long const since_us = _now_us() - _last_flush_us;
+			if (since_us < _refresh_period_us)
+				delay_us = max(delay_us, _refresh_period_us - since_us);
 		}
+
+		_flush_timeout.schedule(Microseconds{delay_us});
+		_flush_scheduled = true;
 	}
 
 	/*
@@ -589,6 +684,7 @@ struct Terminal::Main
 		_timer, *this, &Main::_handle_flush };
 
 	Main(Genode::Env &env,
+	     unsigned long refresh_period_us,
 	     Font_family &font_family,
 	     unsigned char const *keymap,
 	     unsigned char const *shift,
@@ -601,7 +697,8 @@ struct Terminal::Main
 		      _flush_callback_registry,
 		      _trigger_flush_callback,
 		      font_family),
-		_scancode_tracker(keymap, shift, altgr, Terminal::control)
+		_scancode_tracker(keymap, shift, altgr, Terminal::control),
+		_refresh_period_us(refresh_period_us)
 	{
 		_input.sigh(_input_handler);
 
@@ -663,6 +760,7 @@ void Terminal::Main::_handle_key_repeat(Duration)
 void Terminal::Main::_handle_flush(Duration)
 {
 	_flush_scheduled = false;
+	_last_flush_us   = _now_us();
 	_flush_callback_registry.flush();
 }
 
@@ -744,5 +842,15 @@ void Component::construct(Genode::Env &env)
 		}
 	} catch (...) { }
 
-	static Terminal::Main main(env, font_family, keymap, shift, altgr, Terminal::control);
+	/*
+	 * Coalesce updates to the display refresh rate in throughput mode
+	 */
+	unsigned long refresh_period_us = 0;
+	if (config.xml().attribute_value("throughput", false)) {
+		unsigned const rate = max(1U, config.xml().attribute_value("refresh_rate", 60U));
+		refresh_period_us = 1000*1000/rate;
+	}
+
+	static Terminal::Main main(env, refresh_period_us, font_family,
+	                           keymap, shift, altgr, Terminal::control);
 }
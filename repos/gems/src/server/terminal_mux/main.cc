@@ -18,6 +18,8 @@
 #include <libc/component.h>
 #include <libc/allocator.h>
 #include <util/arg_string.h>
+#include <util/string.h>
+#include <util/xml_node.h>
 #include <root/component.h>
 #include <timer_session/connection.h>
 
@@ -145,6 +147,74 @@ struct Registry
 };
 
 
+/**
+ * Output of a session straight to the terminal, bypassing ncurses
+ *
+ * While output is passed through, the scroll region of the terminal is
+ * confined to the session window below the status line. The screen content
+ * known by ncurses does not reflect the passed-through output.
+ */
+class Passthrough
+{
+	private:
+
+		Ncurses &_ncurses;
+
+		bool const _enabled;
+		bool       _active = false;
+
+		template <typename... ARGS>
+		void _write_sequence(ARGS &&... args)
+		{
+			Genode::String<32> const seq("\033[", args...);
+			_ncurses.write_raw(seq.string(), seq.length() - 1);
+		}
+
+	public:
+
+		Passthrough(Ncurses &ncurses, bool enabled)
+		: _ncurses(ncurses), _enabled(enabled) { }
+
+		bool enabled() const { return _enabled; }
+		bool active()  const { return _active; }
+
+		/**
+		 * Prepare terminal for the output into the session window
+		 *
+		 * \param lines   number of lines of the session window
+		 * \param cursor  cursor position within the session window
+		 */
+		void enter(unsigned lines, Terminal::Position cursor)
+		{
+			if (_active)
+				return;
+
+			/* setting the scroll region moves the cursor to the home position */
+			_write_sequence("2;", lines + 1, "r");
+			_write_sequence(cursor.y + 2, ";", cursor.x + 1, "H");
+			_active = true;
+		}
+
+		void write(char const *src, Genode::size_t len)
+		{
+			_ncurses.write_raw(src, len);
+		}
+
+		/**
+		 * Hand the terminal back to ncurses
+		 */
+		void leave()
+		{
+			if (!_active)
+				return;
+
+			_write_sequence("r");
+			_ncurses.clear_ok();
+			_active = false;
+		}
+};
+
+
 class Status_window;
 class Menu;
 
@@ -157,6 +227,9 @@ class Session_manager
 		Registry      &_registry;
 		Status_window &_status_window;
 		Menu          &_menu;
+		Passthrough   &_passthrough;
+
+		Registry::Entry const *_last_focused = nullptr;
 
 		/**
 		 * Update menu if it has the current focus
@@ -166,7 +239,8 @@ class Session_manager
 	public:
 
 		Session_manager(Ncurses &ncurses, Registry &registry,
-		                Status_window &status_window, Menu &menu);
+		                Status_window &status_window, Menu &menu,
+		                Passthrough &passthrough);
 
 		void activate_menu();
 		void submit_input(char c);
@@ -205,6 +279,113 @@ class Terminal::Session_component : public Genode::Rpc_object<Session, Session_c
 
 		Terminal::Position               _last_cursor_pos;
 
+		Passthrough &_passthrough;
+
+		/*
+		 * Output of the client is buffered and decoded not before the
+		 * session gets flushed. Hence, the costs of the decoding and the
+		 * rendering are independent from the number of write operations.
+		 */
+		enum { OUTPUT_BUFFER_SIZE = 16*1024 };
+
+		char           _output[OUTPUT_BUFFER_SIZE];
+		Genode::size_t _output_len = 0;
+
+		void _decode_output()
+		{
+			for (Genode::size_t i = 0; i < _output_len; i++)
+				_decoder.insert(_output[i]);
+
+			_output_len = 0;
+		}
+
+		bool _any_line_dirty()
+		{
+			for (unsigned line = 0; line < _char_cell_array.num_lines(); line++)
+				if (_char_cell_array.line_dirty(line))
+					return true;
+
+			return false;
+		}
+
+		/**
+		 * Return true if the buffered output can be passed through
+		 *
+		 * Only printable characters, carriage returns, and line feeds
+		 * qualify. Characters must not be printed into the last column
+		 * because the terminal wraps lines differently than the character
+		 * screen.
+		 */
+		bool _plain_output()
+		{
+			if (!_char_cell_array_character_screen.plain())
+				return false;
+
+			int       x     = _char_cell_array_character_screen.cursor_pos().x;
+			int const max_x = _char_cell_array.num_cols() - 1;
+
+			for (Genode::size_t i = 0; i < _output_len; i++) {
+
+				unsigned char const c = _output[i];
+
+				if (c == '\r' || c == '\n') {
+					x = 0;
+					continue;
+				}
+
+				if (c < 0x20 || c > 0x7e || x >= max_x)
+					return false;
+
+				x++;
+			}
+			return true;
+		}
+
+		/**
+		 * Pass buffered output straight to the terminal
+		 *
+		 * \return false if the session must be rendered via ncurses
+		 */
+		bool _pass_through()
+		{
+			if (!_passthrough.enabled())
+				return false;
+
+			if (_output_len == 0)
+				return _passthrough.active();
+
+			/* the terminal must show the current content of the session */
+			if (_any_line_dirty() || !_plain_output())
+				return false;
+
+			_passthrough.enter(_char_cell_array.num_lines(),
+			                   _char_cell_array_character_screen.cursor_pos());
+
+			/* the character screen starts a new line at each line feed */
+			char           buf[256];
+			Genode::size_t len = 0;
+			for (Genode::size_t i = 0; i < _output_len; i++) {
+
+				if (len + 2 > sizeof(buf)) {
+					_passthrough.write(buf, len);
+					len = 0;
+				}
+
+				if (_output[i] == '\n')
+					buf[len++] = '\r';
+
+				buf[len++] = _output[i];
+			}
+			_passthrough.write(buf, len);
+
+			_decode_output();
+
+			for (unsigned line = 0; line < _char_cell_array.num_lines(); line++)
+				_char_cell_array.mark_line_as_clean(line);
+
+			return true;
+		}
+
 	public:
 
 		Session_component(Genode::size_t               io_buffer_size,
@@ -212,7 +393,8 @@ class Terminal::Session_component : public Genode::Rpc_object<Session, Session_c
 		                  Session_manager             &session_manager,
 		                  Genode::Session_label const &label,
 		                  Genode::Env                 &env,
-		                  Genode::Allocator           &heap)
+		                  Genode::Allocator           &heap,
+		                  Passthrough                 &passthrough)
 		:
 			_env(env),
 			_ncurses(ncurses),
@@ -222,7 +404,8 @@ class Terminal::Session_component : public Genode::Rpc_object<Session, Session_c
 			_io_buffer(_env.ram(), _env.rm(), io_buffer_size),
 			_char_cell_array(ncurses.columns(), ncurses.lines() - 1, &heap),
 			_char_cell_array_character_screen(_char_cell_array),
-			_decoder(_char_cell_array_character_screen)
+			_decoder(_char_cell_array_character_screen),
+			_passthrough(passthrough)
 		{
 			_session_manager.add(this);
 		}
@@ -240,6 +423,18 @@ class Terminal::Session_component : public Genode::Rpc_object<Session, Session_c
 
 		void flush() override
 		{
+			if (_pass_through())
+				return;
+
+			_decode_output();
+
+			/* the ncurses window lacks the output passed through before */
+			if (_passthrough.active()) {
+				_passthrough.leave();
+				for (unsigned line = 0; line < _char_cell_array.num_lines(); line++)
+					_char_cell_array.mark_line_as_dirty(line);
+			}
+
 			convert_char_array_to_window(&_char_cell_array, _window);
 
 			int first_dirty_line =  10000,
@@ -299,13 +494,16 @@ class Terminal::Session_component : public Genode::Rpc_object<Session, Session_c
 
 		Genode::size_t _write(Genode::size_t num_bytes)
 		{
-			unsigned char *src = _io_buffer.local_addr<unsigned char>();
+			char const *src = _io_buffer.local_addr<char>();
 
-			for (unsigned i = 0; i < num_bytes; i++) {
+			num_bytes = Genode::min(num_bytes, _io_buffer.size());
 
-				/* submit character to sequence decoder */
-				_decoder.insert(src[i]);
-			}
+			/* make room by decoding the buffered output */
+			if (_output_len + num_bytes > sizeof(_output))
+				_decode_output();
+
+			Genode::memcpy(_output + _output_len, src, num_bytes);
+			_output_len += num_bytes;
 
 			return num_bytes;
 		}
@@ -342,6 +540,7 @@ class Terminal::Root_component : public Genode::Root_component<Session_component
 		Genode::Env     &_env;
 		Ncurses         &_ncurses;
 		Session_manager &_session_manager;
+		Passthrough     &_passthrough;
 
 		/*
 		 * FIXME The heap is shared between all clients. The allocator should
@@ -362,7 +561,8 @@ class Terminal::Root_component : public Genode::Root_component<Session_component
 
 			return new (md_alloc())
 				Session_component(io_buffer_size, _ncurses, _session_manager,
-				                  Genode::label_from_args(args), _env, _heap);
+				                  Genode::label_from_args(args), _env, _heap,
+				                  _passthrough);
 		}
 
 	public:
@@ -373,12 +573,14 @@ class Terminal::Root_component : public Genode::Root_component<Session_component
 		Root_component(Genode::Env       &env,
 		               Genode::Allocator &heap,
 		               Ncurses           &ncurses,
-		               Session_manager   &session_manager)
+		               Session_manager   &session_manager,
+		               Passthrough       &passthrough)
 		:
 			Genode::Root_component<Session_component>(env.ep(), heap),
 			_env(env),
 			_ncurses(ncurses),
 			_session_manager(session_manager),
+			_passthrough(passthrough),
 			_heap(heap)
 		{ }
 };
@@ -602,10 +804,11 @@ struct User_input
  ************************************/
 
 Session_manager::Session_manager(Ncurses &ncurses, Registry &registry,
-                                 Status_window &status_window, Menu &menu)
+                                 Status_window &status_window, Menu &menu,
+                                 Passthrough &passthrough)
 :
 	_ncurses(ncurses), _registry(registry), _status_window(status_window),
-	_menu(menu)
+	_menu(menu), _passthrough(passthrough)
 { }
 
 
@@ -637,6 +840,13 @@ void Session_manager::submit_input(char c)
 void Session_manager::update_ncurses_screen()
 {
 	Registry::Entry *focused = _registry.entry_at(0);
+
+	/* the output passed through belongs to the formerly focused entry */
+	if (focused != _last_focused) {
+		_passthrough.leave();
+		_last_focused = focused;
+	}
+
 	if (focused)
 		focused->flush();
 	_ncurses.do_update();
@@ -652,6 +862,11 @@ void Session_manager::add(Registry::Entry *entry)
 
 void Session_manager::remove(Registry::Entry *entry)
 {
+	if (entry == _last_focused) {
+		_passthrough.leave();
+		_last_focused = nullptr;
+	}
+
 	_registry.remove(entry);
 	_refresh_menu();
 }
@@ -663,7 +878,30 @@ void Session_manager::remove(Registry::Entry *entry)
 
 struct Main
 {
-	Genode::Env &env;
+	Libc::Env &env;
+
+	struct Config
+	{
+		enum { POLL_PERIOD_MS = 10 };
+
+		unsigned long frame_period_ms = 40;
+		bool          passthrough     = false;
+
+		Config(Libc::Env &env)
+		{
+			env.config([&] (Genode::Xml_node config) {
+
+				/* the screen is not updated more often than input is polled */
+				unsigned const rate = Genode::max(1U,
+					config.attribute_value("refresh_rate", 25U));
+
+				frame_period_ms = Genode::max(1000UL/rate,
+				                              (unsigned long)POLL_PERIOD_MS);
+
+				passthrough = config.attribute_value("passthrough", false);
+			});
+		}
+	} const config { env };
 
 	Libc::Allocator heap;
 
@@ -671,17 +909,22 @@ struct Main
 	Ncurses       ncurses       { heap };
 	Status_window status_window { ncurses };
 	Menu          menu          { ncurses, registry, status_window };
+	Passthrough   passthrough   { ncurses, config.passthrough };
 
 	User_input      user_input      { ncurses };
-	Session_manager session_manager { ncurses, registry, status_window, menu };
+	Session_manager session_manager { ncurses, registry, status_window, menu,
+	                                  passthrough };
 
-	Terminal::Root_component root { env, heap, ncurses, session_manager };
+	Terminal::Root_component root { env, heap, ncurses, session_manager,
+	                                passthrough };
 
 	Timer::Connection timer { env };
 
 	Genode::Signal_handler<Main> timer_handler { env.ep(), *this, &Main::handle_timer };
 
-	Main(Genode::Env &env) : env(env)
+	unsigned long last_frame_ms = 0;
+
+	Main(Libc::Env &env) : env(env)
 	{
 		Genode::log("--- terminal_mux service started ---");
 
@@ -691,7 +934,7 @@ struct Main
 		env.parent().announce(env.ep().manage(root));
 
 		timer.sigh(timer_handler);
-		timer.trigger_periodic(10*1000);
+		timer.trigger_periodic(Config::POLL_PERIOD_MS*1000);
 	}
 
 	void handle_timer()
@@ -719,6 +962,15 @@ struct Main
 			}
 		}
 
+		/*
+		 * Limit the frame rate. The output of the clients accumulates in
+		 * the meantime and is rendered at once.
+		 */
+		unsigned long const now_ms = timer.elapsed_ms();
+		if (now_ms - last_frame_ms < config.frame_period_ms)
+			return;
+
+		last_frame_ms = now_ms;
 		session_manager.update_ncurses_screen();
 	}
 };
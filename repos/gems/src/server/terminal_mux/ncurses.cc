@@ -13,7 +13,7 @@
 #include <stdlib.h>    /* for 'setenv()' */
 #include <sys/types.h> /* for 'open()' */
 #include <fcntl.h>
-#include <unistd.h>    /* for 'dup2()' */
+#include <unistd.h>    /* for 'dup2()' and 'write()' */
 
 /* local includes */
 #include <ncurses_cxx.h>
@@ -90,6 +90,23 @@ void Ncurses::do_update()
 }
 
 
+void Ncurses::write_raw(char const *src, unsigned long len)
+{
+	/* output pending ncurses data first */
+	fflush(stdout);
+
+	while (len) {
+		ssize_t const written = write(1, src, len);
+		if (written <= 0) {
+			Genode::error("could not write to terminal");
+			return;
+		}
+		src += written;
+		len -= written;
+	}
+}
+
+
 void Ncurses::cursor_visible(bool visible)
 {
 	if (!visible)
@@ -56,6 +56,15 @@ class Ncurses
 
 		void do_update();
 
+		/**
+		 * Write characters directly to the terminal, bypassing ncurses
+		 *
+		 * The screen content known by ncurses does not reflect the written
+		 * characters. Before updating the screen via ncurses again, the
+		 * caller must call 'clear_ok'.
+		 */
+		void write_raw(char const *src, unsigned long len);
+
 		Ncurses(Genode::Allocator &);
 
 		void cursor_visible(bool);
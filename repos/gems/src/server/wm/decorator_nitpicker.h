@@ -347,6 +347,7 @@ struct Wm::Decorator_nitpicker_session : Genode::Rpc_object<Nitpicker::Session>,
 
 		case Command::OP_TO_BACK:
 		case Command::OP_BACKGROUND:
+		case Command::OP_ALPHA:
 		case Command::OP_NOP:
 
 			_nitpicker_session.enqueue(cmd);
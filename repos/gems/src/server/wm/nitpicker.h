@@ -58,6 +58,7 @@ namespace Wm { namespace Nitpicker {
 	using namespace ::Nitpicker;
 
 	class Click_handler;
+	class Command_batch;
 	class View_handle_ctx;
 	class View;
 	class Top_level_view;
@@ -88,6 +89,85 @@ struct Wm::Nitpicker::Click_handler
 };
 
 
+/**
+ * Execution of the commands enqueued at the real nitpicker session
+ *
+ * A client's batch of commands usually results in several commands for the
+ * real nitpicker session. Instead of executing those commands one by one,
+ * they are merely enqueued while the client's batch is processed and
+ * executed by a single RPC at the end. Operations that depend on the
+ * execution of the enqueued commands, e.g., releasing a view handle that is
+ * referenced by an enqueued command, have to call 'flush' beforehand.
+ */
+class Wm::Nitpicker::Command_batch
+{
+	private:
+
+		Nitpicker::Session_client &_real_nitpicker;
+
+		unsigned _depth   = 0;
+		bool     _pending = false;
+
+		unsigned long _num_executions = 0;
+
+	public:
+
+		Command_batch(Nitpicker::Session_client &real_nitpicker)
+		: _real_nitpicker(real_nitpicker) { }
+
+		/**
+		 * Execute enqueued commands, deferred while a batch is in progress
+		 */
+		void execute()
+		{
+			_pending = true;
+
+			if (!_depth)
+				flush();
+		}
+
+		/**
+		 * Execute enqueued commands immediately
+		 */
+		void flush()
+		{
+			if (!_pending)
+				return;
+
+			_pending = false;
+			_num_executions++;
+			_real_nitpicker.execute();
+		}
+
+		/**
+		 * Call functor 'fn' with the execution of commands deferred
+		 */
+		template <typename FN>
+		void apply(FN const &fn)
+		{
+			struct Guard
+			{
+				Command_batch &batch;
+
+				Guard(Command_batch &batch) : batch(batch) { batch._depth++; }
+
+				~Guard()
+				{
+					if (--batch._depth == 0)
+						batch.flush();
+				}
+			} guard(*this);
+
+			fn();
+		}
+
+		/**
+		 * Return number of execute RPCs at the real nitpicker session
+		 */
+		unsigned long num_executions() const { return _num_executions; }
+};
+
+
 struct Nitpicker::View { GENODE_RPC_INTERFACE(); };
 
 
@@ -102,6 +182,7 @@ class Wm::Nitpicker::View : public Genode::Weak_object<View>,
 
 		Session_label              _session_label;
 		Nitpicker::Session_client &_real_nitpicker;
+		Command_batch             &_command_batch;
 		View_handle                _real_handle;
 		Title                      _title;
 		Rect                       _geometry;
@@ -109,13 +190,15 @@ class Wm::Nitpicker::View : public Genode::Weak_object<View>,
 		Weak_ptr<View>             _neighbor_ptr;
 		bool                       _neighbor_behind;
 		bool                       _has_alpha;
+		unsigned char              _alpha = 255;
 
 		View(Nitpicker::Session_client &real_nitpicker,
+		     Command_batch             &command_batch,
 		     Session_label       const &session_label,
 		     bool                       has_alpha)
 		:
 			_session_label(session_label), _real_nitpicker(real_nitpicker),
-			_has_alpha(has_alpha)
+			_command_batch(command_batch), _has_alpha(has_alpha)
 		{ }
 
 		/**
@@ -134,6 +217,7 @@ class Wm::Nitpicker::View : public Genode::Weak_object<View>,
 			_propagate_view_geometry();
 			_real_nitpicker.enqueue<Command::Offset>(_real_handle, _buffer_offset);
 			_real_nitpicker.enqueue<Command::Title> (_real_handle, _title.string());
+			_real_nitpicker.enqueue<Command::Alpha> (_real_handle, _alpha);
 
 			View_handle real_neighbor_handle;
 
@@ -145,10 +229,13 @@ class Wm::Nitpicker::View : public Genode::Weak_object<View>,
 			else
 				_real_nitpicker.enqueue<Command::To_back>(_real_handle, real_neighbor_handle);
 
-			_real_nitpicker.execute();
+			_command_batch.execute();
 
-			if (real_neighbor_handle.valid())
+			/* the stacking command must be executed before releasing the handle */
+			if (real_neighbor_handle.valid()) {
+				_command_batch.flush();
 				_real_nitpicker.release_view_handle(real_neighbor_handle);
+			}
 		}
 
 		void _apply_view_config()
@@ -161,8 +248,10 @@ class Wm::Nitpicker::View : public Genode::Weak_object<View>,
 
 		~View()
 		{
-			if (_real_handle.valid())
+			if (_real_handle.valid()) {
+				_command_batch.flush();
 				_real_nitpicker.destroy_view(_real_handle);
+			}
 		}
 
 		Point virtual_position() const { return _geometry.p1(); }
@@ -178,7 +267,7 @@ class Wm::Nitpicker::View : public Genode::Weak_object<View>,
 			 */
 			if (_real_handle.valid()) {
 				_propagate_view_geometry();
-				_real_nitpicker.execute();
+				_command_batch.execute();
 			}
 		}
 
@@ -188,7 +277,17 @@ class Wm::Nitpicker::View : public Genode::Weak_object<View>,
 
 			if (_real_handle.valid()) {
 				_real_nitpicker.enqueue<Command::Title>(_real_handle, title);
-				_real_nitpicker.execute();
+				_command_batch.execute();
+			}
+		}
+
+		void alpha(unsigned char alpha)
+		{
+			_alpha = alpha;
+
+			if (_real_handle.valid()) {
+				_real_nitpicker.enqueue<Command::Alpha>(_real_handle, _alpha);
+				_command_batch.execute();
 			}
 		}
 
@@ -209,7 +308,7 @@ class Wm::Nitpicker::View : public Genode::Weak_object<View>,
 
 			if (_real_handle.valid()) {
 				_real_nitpicker.enqueue<Command::Offset>(_real_handle, _buffer_offset);
-				_real_nitpicker.execute();
+				_command_batch.execute();
 			}
 		}
 
@@ -242,11 +341,12 @@ class Wm::Nitpicker::Top_level_view : public View,
 	public:
 
 		Top_level_view(Nitpicker::Session_client &real_nitpicker,
+		               Command_batch             &command_batch,
 		               Session_label       const &session_label,
 		               bool                       has_alpha,
 		               Window_registry           &window_registry)
 		:
-			View(real_nitpicker, session_label, has_alpha),
+			View(real_nitpicker, command_batch, session_label, has_alpha),
 			_window_registry(window_registry),
 			_session_label(session_label)
 		{ }
@@ -318,7 +418,8 @@ class Wm::Nitpicker::Top_level_view : public View,
 
 				_real_nitpicker.enqueue<Command::Offset>(_real_handle, _buffer_offset);
 				_real_nitpicker.enqueue<Command::Title> (_real_handle, _title.string());
-				_real_nitpicker.execute();
+				_real_nitpicker.enqueue<Command::Alpha> (_real_handle, _alpha);
+				_command_batch.execute();
 			}
 
 			return _real_nitpicker.view_capability(_real_handle);
@@ -346,11 +447,13 @@ class Wm::Nitpicker::Child_view : public View,
 	public:
 
 		Child_view(Nitpicker::Session_client &real_nitpicker,
+		           Command_batch             &command_batch,
 		           Session_label       const &session_label,
 		           bool                       has_alpha,
 		           Weak_ptr<View>             parent)
 		:
-			View(real_nitpicker, session_label, has_alpha), _parent(parent)
+			View(real_nitpicker, command_batch, session_label, has_alpha),
+			_parent(parent)
 		{
 			try_to_init_real_view();
 		}
@@ -438,6 +541,20 @@ class Wm::Nitpicker::Session_component : public Rpc_object<Nitpicker::Session>,
 		Genode::Ram_session   &_ram;
 		Nitpicker::Connection  _session { _env, _session_label.string() };
 
+		/*
+		 * Commands for the real nitpicker session are executed once per
+		 * batch of client commands
+		 */
+		Command_batch _command_batch { _session };
+
+		/*
+		 * Statistics about the execute RPCs at the real nitpicker session
+		 * per client batch, logged if 'verbose' is set
+		 */
+		enum { verbose = false };
+
+		unsigned long _num_client_batches = 0;
+
 		Window_registry             &_window_registry;
 		Session_control_fn          &_session_control_fn;
 		Tslab<Top_level_view, 4000>  _top_level_view_alloc;
@@ -587,7 +704,8 @@ class Wm::Nitpicker::Session_component : public Rpc_object<Nitpicker::Session>,
 				Weak_ptr<View> parent_ptr = _view_handle_registry.lookup(parent_handle);
 
 				Child_view *view = new (_child_view_alloc)
-					Child_view(_session, _session_label, _has_alpha, parent_ptr);
+					Child_view(_session, _command_batch, _session_label,
+					           _has_alpha, parent_ptr);
 
 				_child_views.insert(view);
 				return *view;
@@ -598,7 +716,8 @@ class Wm::Nitpicker::Session_component : public Rpc_object<Nitpicker::Session>,
 			 */
 			else {
 				Top_level_view *view = new (_top_level_view_alloc)
-					Top_level_view(_session, _session_label, _has_alpha, _window_registry);
+					Top_level_view(_session, _command_batch, _session_label,
+					               _has_alpha, _window_registry);
 
 				view->resizeable(_mode_sigh.valid());
 
@@ -697,6 +816,15 @@ class Wm::Nitpicker::Session_component : public Rpc_object<Nitpicker::Session>,
 					return;
 				}
 
+			case Command::OP_ALPHA:
+				{
+					Locked_ptr<View> view(_view_handle_registry.lookup(command.alpha.view));
+					if (view.valid())
+						view->alpha(command.alpha.alpha);
+
+					return;
+				}
+
 			case Command::OP_NOP:
 				return;
 			}
@@ -751,15 +879,17 @@ class Wm::Nitpicker::Session_component : public Rpc_object<Nitpicker::Session>,
 
 		void try_to_init_real_child_views()
 		{
-			for (Child_view *v = _child_views.first(); v; v = v->next())
-				v->try_to_init_real_view();
+			_command_batch.apply([&] () {
+				for (Child_view *v = _child_views.first(); v; v = v->next())
+					v->try_to_init_real_view(); });
 		}
 
 		void update_stacking_order_of_children(Window_registry::Id id)
 		{
-			for (Child_view *v = _child_views.first(); v; v = v->next())
-				if (v->belongs_to_win_id(id))
-					v->update_child_stacking();
+			_command_batch.apply([&] () {
+				for (Child_view *v = _child_views.first(); v; v = v->next())
+					if (v->belongs_to_win_id(id))
+						v->update_child_stacking(); });
 		}
 
 		void content_geometry(Window_registry::Id id, Rect rect)
@@ -898,12 +1028,24 @@ class Wm::Nitpicker::Session_component : public Rpc_object<Nitpicker::Session>,
 
 		void execute() override
 		{
-			for (unsigned i = 0; i < _command_buffer.num(); i++) {
-				try {
-					_execute_command(_command_buffer.get(i)); }
-				catch (View_handle_registry::Lookup_failed) {
-					Genode::warning("view lookup failed during command execution"); }
-			}
+			unsigned long const num_executions = _command_batch.num_executions();
+
+			_command_batch.apply([&] () {
+				for (unsigned i = 0; i < _command_buffer.num(); i++) {
+					try {
+						_execute_command(_command_buffer.get(i)); }
+					catch (View_handle_registry::Lookup_failed) {
+						Genode::warning("view lookup failed during command execution"); }
+				}
+			});
+
+			_num_client_batches++;
+
+			if (verbose)
+				Genode::log(_session_label, ": batch ", _num_client_batches, " of ",
+				            _command_buffer.num(), " commands took ",
+				            _command_batch.num_executions() - num_executions,
+				            " execute RPCs at nitpicker");
 
 			/* propagate window-list changes to the layouter */
 			_window_registry.flush();
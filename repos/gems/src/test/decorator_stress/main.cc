@@ -45,7 +45,15 @@ struct Param
 };
 
 
-void report_window_layout(Param param, Genode::Reporter &reporter)
+/**
+ * Report layout of 'num_windows' windows
+ *
+ * Only the first 'num_moving' windows follow 'param'. The other windows
+ * keep the geometry of the initial parameters.
+ */
+void report_window_layout(Param param, Param initial_param,
+                          unsigned num_windows, unsigned num_moving,
+                          Genode::Reporter &reporter)
 {
 
 	float w = 1024;
@@ -53,7 +61,10 @@ void report_window_layout(Param param, Genode::Reporter &reporter)
 
 	Genode::Reporter::Xml_generator xml(reporter, [&] ()
 	{
-		for (unsigned i = 1; i <= 10; i++) {
+		for (unsigned i = 1; i <= num_windows; i++) {
+
+			if (i == num_moving + 1)
+				param = initial_param;
 
 			xml.node("window", [&] ()
 			{
@@ -67,7 +78,8 @@ void report_window_layout(Param param, Genode::Reporter &reporter)
 					xml.attribute("focused", "yes");
 			});
 
-			param = param + Param(2.2, 3.3, 4.4, 5.5);
+			param         = param         + Param(2.2, 3.3, 4.4, 5.5);
+			initial_param = initial_param + Param(2.2, 3.3, 4.4, 5.5);
 		}
 	});
 }
@@ -75,9 +87,13 @@ void report_window_layout(Param param, Genode::Reporter &reporter)
 
 struct Main
 {
-	Genode::Env &_env;
+	Libc::Env &_env;
 
-	Param _param { 0, 1, 2, 3 };
+	Param const _initial_param { 0, 1, 2, 3 };
+	Param       _param = _initial_param;
+
+	unsigned _num_windows = 10;
+	unsigned _num_moving  = 10;
 
 	Genode::Reporter _window_layout_reporter { _env, "window_layout", "window_layout", 10*4096 };
 
@@ -85,7 +101,8 @@ struct Main
 
 	void _handle_timer()
 	{
-		report_window_layout(_param, _window_layout_reporter);
+		report_window_layout(_param, _initial_param, _num_windows, _num_moving,
+		                     _window_layout_reporter);
 
 		_param = _param + Param(0.0331/2, 0.042/2, 0.051/2, 0.04/2);
 	}
@@ -93,9 +110,20 @@ struct Main
 	Genode::Signal_handler<Main> _timer_handler {
 		_env.ep(), *this, &Main::_handle_timer };
 
-	Main(Genode::Env &env) : _env(env)
+	Main(Libc::Env &env) : _env(env)
 	{
+		/*
+		 * Stress the decorator with many windows of which only a few move,
+		 * e.g., '<config windows="50" moving="1"/>'.
+		 */
+		_env.config([&] (Genode::Xml_node config) {
+			_num_windows = config.attribute_value("windows", _num_windows);
+			_num_moving  = Genode::min(_num_windows,
+			               config.attribute_value("moving", _num_windows));
+		});
+
 		_window_layout_reporter.enabled(true);
+		_window_layout_reporter.expanding(true);
 		_timer.sigh(_timer_handler);
 		_timer.trigger_periodic(10*1000);
 	}
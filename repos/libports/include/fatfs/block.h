@@ -14,13 +14,22 @@
 #ifndef _INCLUDE__FATFS__BLOCK_H_
 #define _INCLUDE__FATFS__BLOCK_H_
 
+#include <base/stdint.h>
+
 namespace Genode {
 	struct Env;
 	struct Allocator;
 }
 
 namespace Fatfs {
-	void block_init(Genode::Env &, Genode::Allocator &heap);
+	/**
+	 * Initialize the block backend
+	 *
+	 * \param cache_size  size of the sector cache of each drive in bytes,
+	 *                    0 disables the cache
+	 */
+	void block_init(Genode::Env &, Genode::Allocator &heap,
+	                Genode::size_t cache_size = 0);
 }
 
 #endif /* _INCLUDE__FATFS__BLOCK_H_ */
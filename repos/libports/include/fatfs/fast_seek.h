@@ -0,0 +1,74 @@
+/*
+ * \brief  Fast-seek mode for open FatFs files
+ * \author Genode Labs
+ * \date   2026-10-14
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__FATFS__FAST_SEEK_H_
+#define _INCLUDE__FATFS__FAST_SEEK_H_
+
+/* fatfs includes */
+namespace Fatfs { extern "C" {
+#include <fatfs/ff.h>
+} }
+
+namespace Fatfs { class Fast_seek; }
+
+
+/**
+ * Cluster link map table (CLMT) of an open file
+ *
+ * With the table in place, FatFs translates file offsets to clusters
+ * without following the cluster chain through the FAT, which makes random
+ * and backward seeks within large files cheap. A file in fast-seek mode
+ * cannot grow. Hence, the table is dropped before each modification of
+ * the file and re-created on the next read.
+ */
+class Fatfs::Fast_seek
+{
+	private:
+
+		enum { MAX_FRAGMENTS = 32, MIN_FILE_SIZE = 64*1024 };
+
+		DWORD _table[1 + 2*MAX_FRAGMENTS];
+
+		/* table too small for the fragments of the file */
+		bool _too_fragmented = false;
+
+	public:
+
+		/**
+		 * Switch file to fast-seek mode if worthwhile
+		 */
+		void enable(FIL &fil)
+		{
+			if (fil.cltbl || _too_fragmented || f_size(&fil) < MIN_FILE_SIZE)
+				return;
+
+			_table[0]  = sizeof(_table)/sizeof(_table[0]);
+			fil.cltbl = _table;
+
+			if (f_lseek(&fil, CREATE_LINKMAP) != FR_OK) {
+				fil.cltbl       = nullptr;
+				_too_fragmented = true;
+			}
+		}
+
+		/**
+		 * Leave fast-seek mode before the file gets modified
+		 */
+		void disable(FIL &fil)
+		{
+			fil.cltbl       = nullptr;
+			_too_fragmented = false;
+		}
+};
+
+#endif /* _INCLUDE__FATFS__FAST_SEEK_H_ */
@@ -58,6 +58,10 @@ struct fuse_file_info {
 	uint64_t lock_owner;
 };
 
+/* capabilities of 'struct fuse_conn_info' */
+#define FUSE_CAP_ASYNC_READ (1 << 0)
+#define FUSE_CAP_BIG_WRITES (1 << 5)
+
 struct fuse_conn_info {
 	uint32_t proto_major;
 	uint32_t proto_minor;
@@ -62,6 +62,9 @@ struct fuse {
 
 	void *userdata;
 
+	/* limits and capabilities, used by the File_system server */
+	struct fuse_conn_info conn;
+
 	/* Block_session info */
 	uint32_t block_size;
 	uint64_t block_count;
@@ -25,6 +25,9 @@
 
 namespace Genode { class Env; }
 
+struct pollfd;
+struct iovec;
+
 namespace Libc {
 
 	using namespace Genode;
@@ -116,6 +119,20 @@ namespace Libc {
 			virtual File_descriptor *open(const char *pathname, int flags);
 			virtual int pipe(File_descriptor *pipefd[2]);
 			virtual ssize_t read(File_descriptor *, void *buf, ::size_t count);
+
+			/**
+			 * Vectored read and write at 'offset'
+			 *
+			 * If 'offset' is -1, the operation starts at the current file
+			 * offset and advances it. Otherwise, the file offset stays
+			 * unchanged. The default implementations loop over 'read'
+			 * and 'write'.
+			 */
+			virtual ssize_t preadv(File_descriptor *, struct iovec const *iov,
+			                       int iovcnt, ::off_t offset);
+			virtual ssize_t pwritev(File_descriptor *, struct iovec const *iov,
+			                        int iovcnt, ::off_t offset);
+
 			virtual ssize_t readlink(const char *path, char *buf, ::size_t bufsiz);
 			virtual ssize_t recv(File_descriptor *, void *buf, ::size_t len, int flags);
 			virtual ssize_t recvfrom(File_descriptor *, void *buf, ::size_t len, int flags,
@@ -125,6 +142,30 @@ namespace Libc {
 			virtual int rmdir(const char *pathname);
 			virtual int select(int nfds, fd_set *readfds, fd_set *writefds,
 			                   fd_set *exceptfds, struct timeval *timeout);
+
+			/**
+			 * Query the readiness of a single file descriptor
+			 *
+			 * The 'revents' of 'pfd' are set according to its 'events'.
+			 * The default implementation resorts to 'select'.
+			 *
+			 * \return false if the readiness could not be determined
+			 */
+			virtual bool poll(File_descriptor &, struct pollfd &pfd);
+
+			/**
+			 * Copy 'count' bytes at 'offset' of 'in' to 'out'
+			 *
+			 * The method is called at the plugin of 'out'. The file offset
+			 * of 'in' stays unchanged. The default implementation fails with
+			 * 'EOPNOTSUPP', which makes the caller copy the data via a
+			 * buffer.
+			 *
+			 * \return number of bytes copied, 0 at the end of 'in', or -1
+			 */
+			virtual ssize_t sendfile(File_descriptor *out, File_descriptor *in,
+			                         ::off_t offset, ::size_t count);
+
 			virtual ssize_t send(File_descriptor *, const void *buf, ::size_t len, int flags);
 			virtual ssize_t sendto(File_descriptor *, const void *buf,
 			                       ::size_t len, int flags,
@@ -6,6 +6,9 @@ SRC_C = getservent.c nsdispatch.c nsparser.c nslexer.c
 # needed for getaddrinfo()
 SRC_C += getaddrinfo.c
 
+# 'getaddrinfo' is provided by the libc back end, which caches the results
+CC_OPT_getaddrinfo = -Dgetaddrinfo=libc_getaddrinfo_uncached
+
 # needed for getnameinfo()
 SRC_C += getnameinfo.c name6.c
 
@@ -3,4 +3,23 @@ INC_DIR += $(REP_DIR)/src/lib/openssl/spec/arm
 
 CC_OPTS += -DL_ENDIAN
 
+#
+# Perlasm code paths as used by OpenSSL's 'linux-armv4' target. The NEON
+# variants are selected at runtime according to 'OPENSSL_armcap_P'.
+#
+CC_OPT += -DOPENSSL_CPUID_OBJ -DOPENSSL_BN_ASM_MONT -DOPENSSL_BN_ASM_GF2m \
+          -DSHA1_ASM -DSHA256_ASM -DSHA512_ASM -DAES_ASM -DGHASH_ASM
+
+SRC_ASM_CRYPTO = armv4cpuid.S armv4-mont.S armv4-gf2m.S aes-armv4.S \
+                 sha1-armv4-large.S sha256-armv4.S sha512-armv4.S \
+                 ghash-armv4.S
+
+SRC_C_GENERIC_ASM = mem_clr.c aes/aes_core.c
+
+SRC_C += armcap.c
+
+vpath armv4cpuid.S $(call select_from_ports,openssl)/src/lib/openssl/crypto
+vpath %.S          $(call select_from_ports,openssl)/src/lib/openssl/arm
+vpath armcap.c     $(REP_DIR)/src/lib/openssl/spec/arm
+
 include $(REP_DIR)/lib/mk/libcrypto.inc
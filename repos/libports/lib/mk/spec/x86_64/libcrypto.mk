@@ -6,6 +6,29 @@ CC_OPTS += -DL_ENDIAN
 SRC_S += modexp512.s
 SRC_S += rc4_md5.s
 
-vpath %.s $(call select_from_ports,openssl)/src/lib/openssl/x86_64
+#
+# Perlasm code paths as used by OpenSSL's 'linux-x86_64' target. The
+# implementation is selected at runtime according to 'OPENSSL_ia32cap_P',
+# which can be overridden via the 'OPENSSL_ia32cap' environment variable.
+#
+CC_OPT += -DOPENSSL_CPUID_OBJ -DOPENSSL_IA32_SSE2 -DOPENSSL_BN_ASM_MONT \
+          -DOPENSSL_BN_ASM_MONT5 -DOPENSSL_BN_ASM_GF2m -DSHA1_ASM -DSHA256_ASM \
+          -DSHA512_ASM -DMD5_ASM -DAES_ASM -DVPAES_ASM -DBSAES_ASM \
+          -DWHIRLPOOL_ASM -DGHASH_ASM
+
+SRC_ASM_CRYPTO = x86_64cpuid.s x86_64-mont.s x86_64-mont5.s x86_64-gf2m.s \
+                 aes-x86_64.s vpaes-x86_64.s bsaes-x86_64.s aesni-x86_64.s \
+                 aesni-sha1-x86_64.s md5-x86_64.s sha1-x86_64.s \
+                 sha256-x86_64.s sha512-x86_64.s rc4-x86_64.s ghash-x86_64.s \
+                 wp-x86_64.s cmll-x86_64.s
+
+SRC_C_GENERIC_ASM = mem_clr.c aes/aes_core.c aes/aes_cbc.c bn/bn_asm.c \
+                    camellia/camellia.c camellia/cmll_cbc.c rc4/rc4_enc.c \
+                    rc4/rc4_skey.c whrlpool/wp_block.c
+
+SRC_C += bn/asm/x86_64-gcc.c cpuid_setup.c
+
+vpath %.s          $(call select_from_ports,openssl)/src/lib/openssl/x86_64
+vpath cpuid_setup.c $(REP_DIR)/src/lib/openssl/spec/x86_64
 
 include $(REP_DIR)/lib/mk/libcrypto.inc
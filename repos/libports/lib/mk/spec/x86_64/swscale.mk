@@ -0,0 +1,12 @@
+include $(REP_DIR)/lib/mk/spec/x86_64/av.inc
+
+CC_C_OPT += -DARCH_X86=1
+
+include $(REP_DIR)/lib/mk/swscale.mk
+
+-include $(LIBSWSCALE_DIR)/x86/Makefile
+
+# the inline assembly of the scaler uses the stack below the stack pointer
+CC_OPT_x86/swscale = -mno-red-zone
+
+include $(REP_DIR)/lib/mk/spec/x86/av_yasm.inc
@@ -0,0 +1,7 @@
+SRC_CC = vfs.cc
+
+LIBS  += libc libarchive
+
+vpath %.cc $(REP_DIR)/src/lib/vfs/archive
+
+SHARED_LIB = yes
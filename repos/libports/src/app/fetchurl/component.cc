@@ -85,6 +85,17 @@ void Libc::Component::construct(Libc::Env &env)
 
 	bool verbose = config_node.attribute_value("verbose", false);
 
+	/*
+	 * All files are fetched with the same handle, which keeps connections
+	 * to a server alive in between transfers and caches resolved names.
+	 */
+	CURL *curl = curl_easy_init();
+	if (!curl) {
+		Genode::error("failed to initialize libcurl");
+		env.parent().exit(CURLE_FAILED_INIT);
+		return;
+	}
+
 	config_node.for_each_sub_node("fetch", [&] (Genode::Xml_node node) {
 
 		if (res != CURLE_OK) return;
@@ -111,12 +122,8 @@ void Libc::Component::construct(Libc::Env &env)
 			return;
 		}
 
-		CURL *curl = curl_easy_init();
-		if (!curl) {
-			Genode::error("failed to initialize libcurl");
-			res = CURLE_FAILED_INIT;
-			return;
-		}
+		/* reset the options of the former transfer, retains connections */
+		curl_easy_reset(curl);
 
 		Stats stats(timer, url.string());
 
@@ -149,11 +156,11 @@ void Libc::Component::construct(Libc::Env &env)
 
 			if (res != CURLE_OK)
 				Genode::error(curl_easy_strerror(res));
-
-			curl_easy_cleanup(curl);
 		});
 	});
 
+	Libc::with_libc([&]() { curl_easy_cleanup(curl); });
+
 	curl_global_cleanup();
 
 	Genode::warning("SSL certificates not verified");
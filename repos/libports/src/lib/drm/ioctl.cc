@@ -160,6 +160,15 @@ class Drm_call
 
 		Genode::Lock _completion_lock { Genode::Lock::LOCKED };
 
+		Genode::Attached_dataspace _completion_ds {
+			_env.rm(), _gpu_session.completion_dataspace() };
+
+		Gpu::Completion const &_completion {
+			*_completion_ds.local_addr<Gpu::Completion const>() };
+
+		/* sequence number of the last submitted batch buffer */
+		Gpu::Seqno _last_seqno { 0 };
+
 		size_t available_gtt_size { _gpu_info.aperture_size };
 
 		using Handle = uint32_t;
@@ -713,6 +722,7 @@ class Drm_call
 			}
 
 			_gpu_session.exec_buffer(bb_cap, batch_len);
+			_last_seqno = _completion.submitted;
 			return 0;
 		}
 
@@ -836,7 +846,16 @@ class Drm_call
 			              : _generic_ioctl(command_number(request), arg);
 		}
 
-		void wait_for_completion() { _completion_lock.lock(); }
+		/**
+		 * Wait until the last submitted batch buffer is executed
+		 *
+		 * A completion signal may refer to previous submissions only.
+		 */
+		void wait_for_completion()
+		{
+			while (!_completion.complete(_last_seqno))
+				_completion_lock.lock();
+		}
 };
 
 
@@ -38,13 +38,16 @@ extern "C" {
 		Genode::Allocator &alloc;
 		Genode::Allocator_avl tx_alloc { &alloc };
 
+		Genode::size_t const cache_size;
+
 		enum { MAX_DEV_NUM = 8 };
 
 		/* XXX: could make a tree... */
 		Drive* drives[MAX_DEV_NUM];
 
-		Platform(Genode::Env &env, Genode::Allocator &alloc)
-		: env(env), alloc(alloc)
+		Platform(Genode::Env &env, Genode::Allocator &alloc,
+		         Genode::size_t cache_size)
+		: env(env), alloc(alloc), cache_size(cache_size)
 		{
 			for (int i = 0; i < MAX_DEV_NUM; ++i)
 				drives[i] = nullptr;
@@ -53,27 +56,140 @@ extern "C" {
 
 	static Constructible<Platform> _platform;
 
-	void block_init(Genode::Env &env, Genode::Allocator &alloc) {
-		_platform.construct(env, alloc); }
+	void block_init(Genode::Env &env, Genode::Allocator &alloc,
+	                Genode::size_t cache_size) {
+		_platform.construct(env, alloc, cache_size); }
+
+	struct Sector_cache;
+	struct Drive;
+}
+
+
+/**
+ * Direct-mapped write-through cache of sectors
+ *
+ * FatFs accesses the FAT and directories through a window of one sector
+ * per volume and reads partial clusters of file data sector by sector.
+ * The cache keeps these sectors as well as small cluster reads in memory
+ * and thereby spares the round trip to the block server. Larger requests,
+ * i.e., bulk file data, bypass the cache but keep cached copies coherent.
+ */
+struct Fatfs::Sector_cache
+{
+	enum { MAX_CACHED_COUNT = 64 };
+
+	struct Entry
+	{
+		DWORD sector;
+		bool  valid;
+	};
+
+	Genode::Allocator    &alloc;
+	Genode::size_t const  sector_size;
+	unsigned       const  num_entries;
+
+	Entry * const entries = (Entry *)alloc.alloc(num_entries*sizeof(Entry));
+	BYTE  * const data    = (BYTE  *)alloc.alloc(num_entries*sector_size);
 
-	struct Drive : Block::Connection
+	Sector_cache(Genode::Allocator &alloc, Genode::size_t sector_size,
+	             unsigned num_entries)
+	: alloc(alloc), sector_size(sector_size), num_entries(num_entries)
 	{
-		Block::sector_t block_count;
-		Genode::size_t  block_size;
-		Block::Session::Operations ops;
+		for (unsigned i = 0; i < num_entries; i++)
+			entries[i] = Entry { 0, false };
+	}
 
-		Drive(Platform &platform, char const *label)
-		: Block::Connection(platform.env, &platform.tx_alloc, 128*1024, label)
-		{
-			info(&block_count, &block_size, &ops);
+	~Sector_cache()
+	{
+		alloc.free(data, num_entries*sector_size);
+		alloc.free(entries, num_entries*sizeof(Entry));
+	}
+
+	BYTE *_data(unsigned i) { return data + i*sector_size; }
+
+	unsigned _index(DWORD sector) const { return sector % num_entries; }
+
+	bool cached(UINT count) const { return count <= MAX_CACHED_COUNT; }
+
+	/**
+	 * Copy sectors to 'dst' if all of them are cached
+	 */
+	bool read(DWORD sector, UINT count, BYTE *dst)
+	{
+		for (UINT i = 0; i < count; i++) {
+			Entry const &e = entries[_index(sector + i)];
+			if (!e.valid || e.sector != sector + i)
+				return false;
 		}
-	};
-}
+		for (UINT i = 0; i < count; i++)
+			Genode::memcpy(dst + i*sector_size,
+			               _data(_index(sector + i)), sector_size);
+		return true;
+	}
+
+	/**
+	 * Store sectors read from or written to the device
+	 *
+	 * \param allocate  if false, only update sectors that are already cached
+	 */
+	void store(DWORD sector, UINT count, BYTE const *src, bool allocate)
+	{
+		for (UINT i = 0; i < count; i++) {
+			unsigned const idx = _index(sector + i);
+			Entry &e = entries[idx];
+
+			if (!allocate && (!e.valid || e.sector != sector + i))
+				continue;
+
+			Genode::memcpy(_data(idx), src + i*sector_size, sector_size);
+			e = Entry { sector + i, true };
+		}
+	}
+};
+
+
+struct Fatfs::Drive : Block::Connection
+{
+	Block::sector_t block_count;
+	Genode::size_t  block_size;
+	Block::Session::Operations ops;
+
+	Constructible<Sector_cache> cache;
+
+	Drive(Platform &platform, char const *label)
+	: Block::Connection(platform.env, &platform.tx_alloc, 128*1024, label)
+	{
+		info(&block_count, &block_size, &ops);
+
+		unsigned const num_entries = platform.cache_size / block_size;
+		if (num_entries)
+			cache.construct(platform.alloc, block_size, num_entries);
+	}
+};
 
 
 using namespace Fatfs;
 
 
+/**
+ * Submit request without payload and wait for its completion
+ */
+static DRESULT submit_control_request(Drive &drive,
+                                      Block::Packet_descriptor::Opcode op,
+                                      Block::sector_t sector,
+                                      Genode::size_t  count)
+{
+	Block::Packet_descriptor p(drive.tx()->alloc_packet(0), op, sector, count);
+	drive.tx()->submit_packet(p);
+	p = drive.tx()->get_acked_packet();
+
+	DRESULT const res = p.succeeded() ? RES_OK : RES_ERROR;
+
+	drive.tx()->release_packet(p);
+	return res;
+}
+
+
 extern "C" Fatfs::DSTATUS disk_initialize (BYTE drv)
 {
 	if (drv >= Platform::MAX_DEV_NUM) {
@@ -130,6 +246,11 @@ extern "C" DRESULT disk_read (BYTE pdrv, BYTE* buff, DWORD sector, UINT count)
 
 	Drive &drive = *_platform->drives[pdrv];
 
+	bool const cached = drive.cache.constructed() && drive.cache->cached(count);
+
+	if (cached && drive.cache->read(sector, count, buff))
+		return RES_OK;
+
 	Genode::size_t const op_len = drive.block_size*count;
 
 	/* allocate packet-descriptor for reading */
@@ -142,6 +263,9 @@ extern "C" DRESULT disk_read (BYTE pdrv, BYTE* buff, DWORD sector, UINT count)
 	if (p.succeeded() && p.size() >= op_len) {
 		Genode::memcpy(buff, drive.tx()->packet_content(p), op_len);
 		res = RES_OK;
+
+		if (cached)
+			drive.cache->store(sector, count, buff, true);
 	} else {
 		Genode::error(__func__, " failed at sector ", sector, ", count ", count);
 		res = RES_ERROR;
@@ -174,6 +298,10 @@ extern "C" DRESULT disk_write (BYTE pdrv, const BYTE* buff, DWORD sector, UINT c
 	DRESULT res;
 	if (p.succeeded()) {
 		res = RES_OK;
+
+		if (drive.cache.constructed())
+			drive.cache->store(sector, count, buff,
+			                   drive.cache->cached(count));
 	} else {
 		Genode::error(__func__, " failed at sector ", sector, ", count ", count);
 		res = RES_ERROR;
@@ -194,8 +322,23 @@ extern "C" DRESULT disk_ioctl (BYTE pdrv, BYTE cmd, void* buff)
 
 	switch (cmd) {
 	case CTRL_SYNC:
-		drive.sync();
-		return RES_OK;
+		if (!drive.ops.supported(Block::Packet_descriptor::FLUSH)) {
+			drive.sync();
+			return RES_OK;
+		}
+		return submit_control_request(drive, Block::Packet_descriptor::FLUSH, 0, 0);
+
+	case CTRL_TRIM:
+		{
+			/* buff holds the first and the last sector of the range */
+			DWORD const *range = (DWORD const *)buff;
+			if (!drive.ops.supported(Block::Packet_descriptor::DISCARD)
+			    || range[1] < range[0])
+				return RES_OK;
+
+			return submit_control_request(drive, Block::Packet_descriptor::DISCARD,
+			                              range[0], range[1] - range[0] + 1);
+		}
 
 	case GET_SECTOR_COUNT:
 		*((DWORD*)buff) = drive.block_count;
@@ -192,6 +192,21 @@ struct fuse* fuse_new(struct fuse_chan *chan, struct fuse_args *args,
 
 	_fuse->userdata = userdata;
 
+	/*
+	 * There is no kernel to negotiate the connection parameters with and
+	 * the file systems get initialized by 'Fuse::init_fs' instead of the
+	 * 'init' operation. Hence, we announce the parameters of the
+	 * File_system server, which may adjust them according to its config.
+	 */
+	Genode::memset(&_fuse->conn, 0, sizeof(_fuse->conn));
+	_fuse->conn.proto_major   = 7;
+	_fuse->conn.proto_minor   = 12;
+	_fuse->conn.async_read    = 1;
+	_fuse->conn.max_write     = 128*1024;
+	_fuse->conn.max_readahead = 128*1024;
+	_fuse->conn.capable       = FUSE_CAP_ASYNC_READ | FUSE_CAP_BIG_WRITES;
+	_fuse->conn.want          = _fuse->conn.capable;
+
 	_ctx.fuse         = _fuse;
 	_ctx.uid          = 0;
 	_ctx.gid          = 0;
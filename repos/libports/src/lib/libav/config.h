@@ -67,18 +67,47 @@
 #define HAVE_PPC4XX 0
 #define HAVE_AMD3DNOW 0
 #define HAVE_AMD3DNOWEXT 0
+
+#ifndef HAVE_AVX
 #define HAVE_AVX 0
+#endif
+
 #define HAVE_AVX2 0
 #define HAVE_FMA3 0
 #define HAVE_FMA4 0
+
+#ifndef HAVE_MMX
 #define HAVE_MMX 0
+#endif
+
+#ifndef HAVE_MMXEXT
 #define HAVE_MMXEXT 0
+#endif
+
+#ifndef HAVE_SSE
 #define HAVE_SSE 0
+#endif
+
+#ifndef HAVE_SSE2
 #define HAVE_SSE2 0
+#endif
+
+#ifndef HAVE_SSE3
 #define HAVE_SSE3 0
+#endif
+
+#ifndef HAVE_SSE4
 #define HAVE_SSE4 0
+#endif
+
+#ifndef HAVE_SSE42
 #define HAVE_SSE42 0
+#endif
+
+#ifndef HAVE_SSSE3
 #define HAVE_SSSE3 0
+#endif
+
 #define HAVE_XOP 0
 #define HAVE_CPUNOP 1
 #define HAVE_I686 1
@@ -103,18 +132,47 @@
 #define HAVE_PPC4XX_EXTERNAL 0
 #define HAVE_AMD3DNOW_EXTERNAL 0
 #define HAVE_AMD3DNOWEXT_EXTERNAL 0
+
+#ifndef HAVE_AVX_EXTERNAL
 #define HAVE_AVX_EXTERNAL 0
+#endif
+
 #define HAVE_AVX2_EXTERNAL 0
 #define HAVE_FMA3_EXTERNAL 0
 #define HAVE_FMA4_EXTERNAL 0
+
+#ifndef HAVE_MMX_EXTERNAL
 #define HAVE_MMX_EXTERNAL 0
+#endif
+
+#ifndef HAVE_MMXEXT_EXTERNAL
 #define HAVE_MMXEXT_EXTERNAL 0
+#endif
+
+#ifndef HAVE_SSE_EXTERNAL
 #define HAVE_SSE_EXTERNAL 0
+#endif
+
+#ifndef HAVE_SSE2_EXTERNAL
 #define HAVE_SSE2_EXTERNAL 0
+#endif
+
+#ifndef HAVE_SSE3_EXTERNAL
 #define HAVE_SSE3_EXTERNAL 0
+#endif
+
+#ifndef HAVE_SSE4_EXTERNAL
 #define HAVE_SSE4_EXTERNAL 0
+#endif
+
+#ifndef HAVE_SSE42_EXTERNAL
 #define HAVE_SSE42_EXTERNAL 0
+#endif
+
+#ifndef HAVE_SSSE3_EXTERNAL
 #define HAVE_SSSE3_EXTERNAL 0
+#endif
+
 #define HAVE_XOP_EXTERNAL 0
 #define HAVE_CPUNOP_EXTERNAL 0
 #define HAVE_I686_EXTERNAL 0
@@ -139,18 +197,47 @@
 #define HAVE_PPC4XX_INLINE 0
 #define HAVE_AMD3DNOW_INLINE 0
 #define HAVE_AMD3DNOWEXT_INLINE 0
+
+#ifndef HAVE_AVX_INLINE
 #define HAVE_AVX_INLINE 0
+#endif
+
 #define HAVE_AVX2_INLINE 0
 #define HAVE_FMA3_INLINE 0
 #define HAVE_FMA4_INLINE 0
+
+#ifndef HAVE_MMX_INLINE
 #define HAVE_MMX_INLINE 0
+#endif
+
+#ifndef HAVE_MMXEXT_INLINE
 #define HAVE_MMXEXT_INLINE 0
+#endif
+
+#ifndef HAVE_SSE_INLINE
 #define HAVE_SSE_INLINE 0
+#endif
+
+#ifndef HAVE_SSE2_INLINE
 #define HAVE_SSE2_INLINE 0
+#endif
+
+#ifndef HAVE_SSE3_INLINE
 #define HAVE_SSE3_INLINE 0
+#endif
+
+#ifndef HAVE_SSE4_INLINE
 #define HAVE_SSE4_INLINE 0
+#endif
+
+#ifndef HAVE_SSE42_INLINE
 #define HAVE_SSE42_INLINE 0
+#endif
+
+#ifndef HAVE_SSSE3_INLINE
 #define HAVE_SSSE3_INLINE 0
+#endif
+
 #define HAVE_XOP_INLINE 0
 #define HAVE_CPUNOP_INLINE 0
 #define HAVE_I686_INLINE 0
@@ -161,7 +248,11 @@
 #define HAVE_FAST_CMOV 1
 #define HAVE_LOCAL_ALIGNED_8 1
 #define HAVE_LOCAL_ALIGNED_16 1
+
+#ifndef HAVE_SIMD_ALIGN_16
 #define HAVE_SIMD_ALIGN_16 0
+#endif
+
 #define HAVE_ATOMICS_GCC 1
 #define HAVE_ATOMICS_SUNCC 0
 #define HAVE_ATOMICS_WIN32 0
@@ -173,7 +264,11 @@
 #define HAVE_SYNC_VAL_COMPARE_AND_SWAP 1
 #define HAVE_INLINE_ASM 1
 #define HAVE_SYMVER 1
+
+#ifndef HAVE_YASM
 #define HAVE_YASM 0
+#endif
+
 #define HAVE_BIGENDIAN 0
 #define HAVE_FAST_UNALIGNED 1
 #define HAVE_ALSA_ASOUNDLIB_H 1
@@ -293,7 +388,11 @@
 #define HAVE_SYMVER_GNU_ASM 1
 #define HAVE_VFP_ARGS 0
 #define HAVE_XFORM_ASM 0
+
+#ifndef HAVE_XMM_CLOBBERS
 #define HAVE_XMM_CLOBBERS 0
+#endif
+
 #define HAVE_SOCKLEN_T 1
 #define HAVE_STRUCT_ADDRINFO 1
 #define HAVE_STRUCT_GROUP_SOURCE_REQ 1
@@ -371,7 +470,11 @@
 #define CONFIG_ZLIB 1
 #define CONFIG_GRAY 0
 #define CONFIG_HARDCODED_TABLES 0
+
+#ifndef CONFIG_RUNTIME_CPUDETECT
 #define CONFIG_RUNTIME_CPUDETECT 0
+#endif
+
 #define CONFIG_SAFE_BITSTREAM_READER 1
 #define CONFIG_SHARED 0
 #define CONFIG_SMALL 0
@@ -406,7 +509,11 @@
 #define CONFIG_RDFT 1
 #define CONFIG_MEMALIGN_HACK 0
 #define CONFIG_NEON_CLOBBER_TEST 0
+
+#ifndef CONFIG_PIC
 #define CONFIG_PIC 0
+#endif
+
 #define CONFIG_POD2MAN 1
 #define CONFIG_TEXI2HTML 0
 #define CONFIG_THUMB 0
@@ -0,0 +1,223 @@
+/*
+ * \brief  Cache of name-resolution results of 'getaddrinfo'
+ * \author Genode Labs
+ * \date   2026-10-14
+ *
+ * Each lookup of a host name issues DNS queries via the socket file system.
+ * Components that open many connections to the same hosts, e.g., package
+ * fetchers, benefit from remembering the results for a short time. The
+ * cache is enabled via '<libc dns_cache="32" dns_cache_ttl="60"/>', which
+ * denotes the number of entries and their lifetime in seconds.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/allocator.h>
+#include <base/lock.h>
+#include <base/log.h>
+#include <util/construct_at.h>
+#include <util/string.h>
+
+/* libc includes */
+#include <netdb.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* libc-internal includes */
+#include "libc_init.h"
+#include "task.h"
+
+/* FreeBSD implementation, renamed at compile time of 'getaddrinfo.c' */
+extern "C" int libc_getaddrinfo_uncached(char const *, char const *,
+                                         addrinfo const *, addrinfo **);
+
+namespace Libc { class Addrinfo_cache; }
+
+
+class Libc::Addrinfo_cache : Genode::Noncopyable
+{
+	private:
+
+		typedef Genode::String<256> Host;
+		typedef Genode::String<32>  Service;
+
+		struct Entry
+		{
+			Host           host    { };
+			Service        service { };
+			int            flags = 0, family = 0, socktype = 0, protocol = 0;
+			unsigned long  expires = 0;
+			addrinfo      *info    = nullptr;
+
+			bool matches(char const *h, char const *s, addrinfo const &hints) const
+			{
+				return info && host == h && service == (s ? s : "")
+				    && flags    == hints.ai_flags
+				    && family   == hints.ai_family
+				    && socktype == hints.ai_socktype
+				    && protocol == hints.ai_protocol;
+			}
+		};
+
+		Genode::Allocator &_alloc;
+
+		unsigned const      _num_entries;
+		unsigned long const _ttl_ms;
+
+		Entry * const _entries;
+
+		Genode::Lock _lock { };
+
+		static Entry *_alloc_entries(Genode::Allocator &alloc, unsigned num)
+		{
+			Entry *entries = (Entry *)alloc.alloc(num*sizeof(Entry));
+			for (unsigned i = 0; i < num; i++)
+				Genode::construct_at<Entry>(&entries[i]);
+			return entries;
+		}
+
+		Entry &_slot(char const *host, char const *service)
+		{
+			/* FNV-1a hash of host and service name */
+			unsigned h = 2166136261u;
+			for (char const *s = host; *s; s++)
+				h = (h ^ (unsigned char)*s)*16777619u;
+			for (char const *s = service; s && *s; s++)
+				h = (h ^ (unsigned char)*s)*16777619u;
+
+			return _entries[h % _num_entries];
+		}
+
+		/**
+		 * Duplicate result list in the layout expected by 'freeaddrinfo'
+		 *
+		 * Each element is allocated along with its socket address. Only
+		 * the canonical name is allocated separately.
+		 */
+		static addrinfo *_copy(addrinfo const *src)
+		{
+			addrinfo *head = nullptr, **tail = &head;
+
+			for (; src; src = src->ai_next) {
+
+				addrinfo *ai = (addrinfo *)malloc(sizeof(addrinfo) + src->ai_addrlen);
+				if (!ai) {
+					if (head) freeaddrinfo(head);
+					return nullptr;
+				}
+
+				*ai = *src;
+				ai->ai_next      = nullptr;
+				ai->ai_addr      = (sockaddr *)(ai + 1);
+				ai->ai_canonname = src->ai_canonname ? strdup(src->ai_canonname)
+				                                     : nullptr;
+				memcpy(ai->ai_addr, src->ai_addr, src->ai_addrlen);
+
+				*tail = ai;
+				tail  = &ai->ai_next;
+			}
+			return head;
+		}
+
+	public:
+
+		Addrinfo_cache(Genode::Allocator &alloc, unsigned num_entries,
+		               unsigned ttl_s)
+		:
+			_alloc(alloc), _num_entries(num_entries), _ttl_ms(ttl_s*1000UL),
+			_entries(_alloc_entries(alloc, num_entries))
+		{ }
+
+		/**
+		 * Return copy of cached result, or nullptr on a miss
+		 */
+		addrinfo *lookup(char const *host, char const *service,
+		                 addrinfo const &hints)
+		{
+			Genode::Lock::Guard guard(_lock);
+
+			Entry &e = _slot(host, service);
+
+			if (!e.matches(host, service, hints))
+				return nullptr;
+
+			if (Libc::current_time() >= e.expires) {
+				freeaddrinfo(e.info);
+				e.info = nullptr;
+				return nullptr;
+			}
+
+			return _copy(e.info);
+		}
+
+		void insert(char const *host, char const *service,
+		            addrinfo const &hints, addrinfo const *info)
+		{
+			if (Genode::strlen(host) >= Host::capacity()
+			 || (service && Genode::strlen(service) >= Service::capacity()))
+				return;
+
+			addrinfo *copy = _copy(info);
+			if (!copy)
+				return;
+
+			Genode::Lock::Guard guard(_lock);
+
+			Entry &e = _slot(host, service);
+
+			if (e.info)
+				freeaddrinfo(e.info);
+
+			e.host     = Host(host);
+			e.service  = Service(service ? service : "");
+			e.flags    = hints.ai_flags;
+			e.family   = hints.ai_family;
+			e.socktype = hints.ai_socktype;
+			e.protocol = hints.ai_protocol;
+			e.expires  = Libc::current_time() + _ttl_ms;
+			e.info     = copy;
+		}
+};
+
+
+static Libc::Addrinfo_cache *_addrinfo_cache;
+
+
+void Libc::init_addrinfo_cache(Genode::Allocator &alloc, Genode::Xml_node libc_config)
+{
+	unsigned const num_entries = libc_config.attribute_value("dns_cache", 0U);
+	unsigned const ttl         = libc_config.attribute_value("dns_cache_ttl", 60U);
+
+	if (num_entries && ttl)
+		_addrinfo_cache = new (alloc) Addrinfo_cache(alloc, num_entries, ttl);
+}
+
+
+extern "C" int getaddrinfo(char const *host, char const *service,
+                           addrinfo const *hints, addrinfo **res)
+{
+	addrinfo const no_hints { };
+	addrinfo const &h = hints ? *hints : no_hints;
+
+	/* numeric addresses are converted without any lookup */
+	bool const cacheable = _addrinfo_cache && host && res
+	                    && !(h.ai_flags & AI_NUMERICHOST);
+
+	if (!cacheable)
+		return libc_getaddrinfo_uncached(host, service, hints, res);
+
+	if ((*res = _addrinfo_cache->lookup(host, service, h)))
+		return 0;
+
+	int const err = libc_getaddrinfo_uncached(host, service, hints, res);
+	if (err == 0)
+		_addrinfo_cache->insert(host, service, h, *res);
+
+	return err;
+}
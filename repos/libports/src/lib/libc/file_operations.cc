@@ -429,7 +429,13 @@ extern "C" void *mmap(void *addr, ::size_t length, int prot, int flags,
 	/* handle requests for anonymous memory */
 	if (!addr && libc_fd == -1) {
 		bool const executable = prot & PROT_EXEC;
-		void *start = Libc::mem_alloc(executable)->alloc(length, PAGE_SHIFT);
+
+		/* align large blocks to the huge-page size to enable superpages */
+		Genode::size_t const align_log2 =
+			length >= Libc::Mem_alloc_impl::HUGE_PAGE_SIZE
+			? (Genode::size_t)Libc::Mem_alloc_impl::HUGE_PAGE_SHIFT : PAGE_SHIFT;
+
+		void *start = Libc::mem_alloc(executable)->alloc(length, align_log2);
 		mmap_registry()->insert(start, length, 0);
 		return start;
 	}
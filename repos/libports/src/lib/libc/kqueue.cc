@@ -0,0 +1,318 @@
+/*
+ * \brief  kqueue() and kevent() implementation
+ * \author Genode Labs
+ * \date   2026-10-14
+ *
+ * In contrast to 'select()', a kqueue keeps the registered events across
+ * calls. Hence, a 'kevent()' call neither rebuilds fd sets nor asks each
+ * plugin about all file descriptors. It only queries the file descriptors
+ * registered at the queue, one by one via 'Plugin::poll()'. The queue is
+ * re-examined only after an I/O response was received since the previous
+ * examination.
+ *
+ * Only the 'EVFILT_READ' and 'EVFILT_WRITE' filters are supported. Knotes
+ * of closed file descriptors are removed lazily when the queue is examined.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/log.h>
+#include <util/list.h>
+
+/* Libc includes */
+#include <libc-plugin/fd_alloc.h>
+#include <libc-plugin/plugin.h>
+#include <libc/allocator.h>
+#include <sys/event.h>
+#include <sys/poll.h>
+#include <errno.h>
+
+/* libc-internal includes */
+#include "libc_errno.h"
+#include "task.h"
+
+
+namespace Libc {
+	struct Knote;
+	struct Kqueue;
+	struct Kqueue_plugin;
+}
+
+
+void (*libc_kqueue_notify)() __attribute__((weak));
+
+
+static Libc::Allocator kqueue_alloc;
+
+
+/**
+ * Number of I/O responses received, used to detect the need to re-examine
+ * a queue
+ */
+static unsigned long kqueue_generation;
+
+static void kqueue_notify() { kqueue_generation++; }
+
+
+/**
+ * Event registered at a kqueue
+ */
+struct Libc::Knote : Genode::List<Knote>::Element
+{
+	struct kevent kev;
+
+	bool enabled    = true;
+	bool last_ready = false;
+
+	Knote(struct kevent const &kev) : kev(kev) { }
+
+	bool matches(struct kevent const &other) const {
+		return kev.ident == other.ident && kev.filter == other.filter; }
+};
+
+
+struct Libc::Kqueue : Plugin_context
+{
+	Genode::List<Knote> knotes { };
+
+	~Kqueue()
+	{
+		while (Knote *kn = knotes.first()) {
+			knotes.remove(kn);
+			destroy(kqueue_alloc, kn);
+		}
+	}
+
+	Knote *lookup(struct kevent const &kev)
+	{
+		for (Knote *kn = knotes.first(); kn; kn = kn->next())
+			if (kn->matches(kev))
+				return kn;
+		return nullptr;
+	}
+
+	/**
+	 * Apply change, return error number or 0 on success
+	 */
+	int apply(struct kevent const &change)
+	{
+		if (change.filter != EVFILT_READ && change.filter != EVFILT_WRITE)
+			return EINVAL;
+
+		Knote *kn = lookup(change);
+
+		if (change.flags & EV_DELETE) {
+			if (!kn) return ENOENT;
+			knotes.remove(kn);
+			destroy(kqueue_alloc, kn);
+			return 0;
+		}
+
+		if (change.flags & EV_ADD) {
+			if (!file_descriptor_allocator()->find_by_libc_fd((int)change.ident))
+				return EBADF;
+
+			if (!kn) {
+				kn = new (kqueue_alloc) Knote(change);
+				knotes.insert(kn);
+			} else {
+				kn->kev.flags  = change.flags;
+				kn->kev.fflags = change.fflags;
+				kn->kev.udata  = change.udata;
+			}
+			kn->enabled = true;
+		}
+
+		if (!kn)
+			return ENOENT;
+
+		if (change.flags & EV_ENABLE)  kn->enabled = true;
+		if (change.flags & EV_DISABLE) kn->enabled = false;
+
+		return 0;
+	}
+
+	/**
+	 * Examine the registered knotes and store triggered events
+	 *
+	 * \return number of events stored in 'eventlist'
+	 */
+	int collect(struct kevent *eventlist, int nevents)
+	{
+		int nready = 0;
+
+		for (Knote *kn = knotes.first(), *next = nullptr; kn && nready < nevents; kn = next) {
+
+			next = kn->next();
+
+			File_descriptor *fd =
+				file_descriptor_allocator()->find_by_libc_fd((int)kn->kev.ident);
+
+			/* file descriptor was closed */
+			if (!fd || !fd->plugin) {
+				knotes.remove(kn);
+				destroy(kqueue_alloc, kn);
+				continue;
+			}
+
+			if (!kn->enabled)
+				continue;
+
+			struct pollfd pfd { fd->libc_fd,
+			                    (short)(kn->kev.filter == EVFILT_READ ? POLLIN : POLLOUT),
+			                    0 };
+
+			bool const ready = fd->plugin->poll(*fd, pfd)
+			                && (pfd.revents & (pfd.events | POLLERR));
+
+			/* report edge-triggered events only on the transition to ready */
+			bool const report = ready && !((kn->kev.flags & EV_CLEAR) && kn->last_ready);
+
+			kn->last_ready = ready;
+
+			if (!report)
+				continue;
+
+			struct kevent &ev = eventlist[nready++];
+			ev = kn->kev;
+			ev.flags = kn->kev.flags & (EV_ONESHOT | EV_CLEAR | EV_DISPATCH);
+			if (pfd.revents & POLLERR)
+				ev.flags |= EV_EOF;
+			ev.data = 0;
+
+			if (kn->kev.flags & EV_ONESHOT) {
+				knotes.remove(kn);
+				destroy(kqueue_alloc, kn);
+			} else if (kn->kev.flags & EV_DISPATCH) {
+				kn->enabled = false;
+			}
+		}
+
+		return nready;
+	}
+};
+
+
+struct Libc::Kqueue_plugin : Plugin
+{
+	int close(File_descriptor *fd) override
+	{
+		Kqueue *kq = dynamic_cast<Kqueue *>(fd->context);
+		if (kq)
+			destroy(kqueue_alloc, kq);
+
+		file_descriptor_allocator()->free(fd);
+		return 0;
+	}
+};
+
+
+static Libc::Kqueue_plugin &kqueue_plugin()
+{
+	static Libc::Kqueue_plugin inst;
+	return inst;
+}
+
+
+extern "C" int
+__attribute__((weak))
+kqueue(void)
+{
+	/* initialize the kqueue notification function pointer */
+	if (!libc_kqueue_notify)
+		libc_kqueue_notify = kqueue_notify;
+
+	Libc::Kqueue *kq = new (kqueue_alloc) Libc::Kqueue();
+
+	Libc::File_descriptor *fd =
+		Libc::file_descriptor_allocator()->alloc(&kqueue_plugin(), kq);
+
+	if (!fd) {
+		destroy(kqueue_alloc, kq);
+		return Libc::Errno(EMFILE);
+	}
+
+	return fd->libc_fd;
+}
+
+
+extern "C" int
+__attribute__((weak))
+kevent(int libc_fd, struct kevent const *changelist, int nchanges,
+       struct kevent *eventlist, int nevents, struct timespec const *ts)
+{
+	Libc::File_descriptor *fd =
+		Libc::file_descriptor_allocator()->find_by_libc_fd(libc_fd);
+
+	Libc::Kqueue *kq = fd ? dynamic_cast<Libc::Kqueue *>(fd->context) : nullptr;
+	if (!kq)
+		return Libc::Errno(EBADF);
+
+	if (nchanges < 0 || nevents < 0)
+		return Libc::Errno(EINVAL);
+
+	int nready = 0;
+
+	/* apply changes, report errors in the event list if space is left */
+	for (int i = 0; i < nchanges; i++) {
+
+		struct kevent const &change = changelist[i];
+
+		int const error = kq->apply(change);
+
+		if (!error && !(change.flags & EV_RECEIPT))
+			continue;
+
+		if (nready == nevents) {
+			if (error)
+				return Libc::Errno(error);
+			continue;
+		}
+
+		struct kevent &ev = eventlist[nready++];
+		ev = change;
+		ev.flags = EV_ERROR;
+		ev.data  = error;
+	}
+
+	if (nready || nevents == 0)
+		return nready;
+
+	struct Timeout
+	{
+		bool    const  valid;
+		unsigned long  duration;
+
+		bool expired() const { return valid && duration == 0; };
+
+		Timeout(timespec const *ts)
+		:
+			valid(ts != nullptr),
+			duration(ts ? (unsigned long)ts->tv_sec*1000 + ts->tv_nsec/1000000 : 0UL)
+		{ }
+	} timeout { ts };
+
+	struct Check : Libc::Suspend_functor
+	{
+		unsigned long const generation = kqueue_generation;
+
+		bool suspend() override { return generation == kqueue_generation; }
+	};
+
+	for (;;) {
+		Check check;
+
+		nready = kq->collect(eventlist, nevents);
+
+		if (nready || timeout.expired())
+			return nready;
+
+		timeout.duration = Libc::suspend(check, timeout.duration);
+	}
+}
@@ -30,6 +30,11 @@ namespace Libc {
 	 */
 	void init_mem_alloc(Genode::Env &env);
 
+	/**
+	 * Reserve virtual memory for the global memory allocator, if configured
+	 */
+	void init_mem_alloc_area(Genode::Env &env, Genode::Xml_node libc_config);
+
 	/**
 	 * Support for querying available RAM quota in sysctl functions
 	 */
@@ -44,6 +49,11 @@ namespace Libc {
 	 * Malloc allocator
          */
 	void init_malloc(Genode::Allocator &heap);
+
+	/**
+	 * Cache of 'getaddrinfo' results, if configured
+	 */
+	void init_addrinfo_cache(Genode::Allocator &alloc, Genode::Xml_node libc_config);
 }
 
 #endif /* _LIBC_INIT_H_ */
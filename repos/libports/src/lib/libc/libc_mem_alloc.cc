@@ -38,12 +38,22 @@ Libc::Mem_alloc_impl::Dataspace_pool::~Dataspace_pool()
 		Ram_dataspace_capability ds_cap = ds->cap;
 		void const * const local_addr = ds->local_addr;
 
+		bool const in_area = ds->in_area;
+
 		remove(ds);
 		delete ds;
 
-		_region_map->detach(local_addr);
+		if (in_area)
+			_area->map.detach((addr_t)local_addr - _area->base);
+		else
+			_region_map->detach(local_addr);
 		_ram_session->free(ds_cap);
 	}
+
+	if (_area.constructed()) {
+		_region_map->detach(_area->base);
+		_area.destruct();
+	}
 }
 
 
@@ -52,13 +62,33 @@ int Libc::Mem_alloc_impl::Dataspace_pool::expand(size_t size, Range_allocator *a
 	Ram_dataspace_capability new_ds_cap;
 	void *local_addr, *ds_addr = 0;
 
+	/*
+	 * Within the reserved area, a dataspace of at least the huge-page size
+	 * is placed at a huge-page aligned offset. Smaller dataspaces are
+	 * packed at page granularity.
+	 */
+	size_t offset  = 0;
+	bool   in_area = false;
+	if (_area.constructed()) {
+		offset  = align_addr(_area->used, size >= HUGE_PAGE_SIZE
+		                                  ? HUGE_PAGE_SHIFT : 12);
+		in_area = _area->fits(offset, size);
+	}
+
 	/* make new ram dataspace available at our local address space */
 	try {
 		new_ds_cap = _ram_session->alloc(size);
 
 		enum { MAX_SIZE = 0, NO_OFFSET = 0, ANY_LOCAL_ADDR = false };
-		local_addr = _region_map->attach(new_ds_cap, MAX_SIZE, NO_OFFSET,
-		                                 ANY_LOCAL_ADDR, nullptr, _executable);
+		if (in_area) {
+			_area->map.attach(new_ds_cap, MAX_SIZE, NO_OFFSET, true,
+			                  offset, _executable);
+			local_addr = (void *)(_area->base + offset);
+			_area->used = offset + size;
+		} else {
+			local_addr = _region_map->attach(new_ds_cap, MAX_SIZE, NO_OFFSET,
+			                                 ANY_LOCAL_ADDR, nullptr, _executable);
+		}
 	}
 	catch (Out_of_ram) { return -2; }
 	catch (Out_of_caps) { return -4; }
@@ -77,7 +107,7 @@ int Libc::Mem_alloc_impl::Dataspace_pool::expand(size_t size, Range_allocator *a
 	}
 
 	/* add dataspace information to list of dataspaces */
-	Dataspace *ds  = new (ds_addr) Dataspace(new_ds_cap, local_addr);
+	Dataspace *ds  = new (ds_addr) Dataspace(new_ds_cap, local_addr, in_area);
 	insert(ds);
 
 	return 0;
@@ -112,7 +142,15 @@ void *Libc::Mem_alloc_impl::alloc(size_t size, size_t align_log2)
 		_chunk_size = min(2*_chunk_size, (size_t)MAX_CHUNK_SIZE);
 	}
 
-	if (_ds_pool.expand(align_addr(request_size, 12), &_alloc) < 0) {
+	/*
+	 * Large blocks get backing store of their own. Rounding it to the
+	 * huge-page size lets core align the dataspace naturally, physically
+	 * as well as virtually, which enables superpage mappings.
+	 */
+	size_t const align_log2_ds = request_size >= HUGE_PAGE_SIZE
+	                           ? HUGE_PAGE_SHIFT : 12;
+
+	if (_ds_pool.expand(align_addr(request_size, align_log2_ds), &_alloc) < 0) {
 		Genode::warning("libc: could not expand dataspace pool");
 		return 0;
 	}
@@ -132,6 +170,14 @@ void Libc::Mem_alloc_impl::free(void *addr)
 }
 
 
+void Libc::Mem_alloc_impl::reserve(Genode::Env &env, size_t size)
+{
+	Lock::Guard lock_guard(_lock);
+
+	_ds_pool.reserve(env, size);
+}
+
+
 Genode::size_t Libc::Mem_alloc_impl::size_at(void const *addr) const
 {
 	/* serialize access of heap functions */
@@ -142,8 +188,8 @@ Genode::size_t Libc::Mem_alloc_impl::size_at(void const *addr) const
 }
 
 
-static Libc::Mem_alloc *_libc_mem_alloc_rw  = nullptr;
-static Libc::Mem_alloc *_libc_mem_alloc_rwx = nullptr;
+static Libc::Mem_alloc_impl *_libc_mem_alloc_rw  = nullptr;
+static Libc::Mem_alloc_impl *_libc_mem_alloc_rwx = nullptr;
 
 
 static void _init_mem_alloc(Genode::Region_map &rm, Genode::Ram_session &ram)
@@ -164,6 +210,19 @@ namespace Libc {
 	{
 		_init_mem_alloc(env.rm(), env.ram());
 	}
+
+	void init_mem_alloc_area(Genode::Env &env, Genode::Xml_node config)
+	{
+		Number_of_bytes const size =
+			config.attribute_value("mem_reserve", Number_of_bytes(0));
+
+		if (!size || !_libc_mem_alloc_rw)
+			return;
+
+		try { _libc_mem_alloc_rw->reserve(env, size); }
+		catch (...) {
+			warning("libc: could not reserve ", size, " bytes of virtual memory"); }
+	}
 }
 
 
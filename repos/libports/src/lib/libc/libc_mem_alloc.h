@@ -12,8 +12,10 @@
 #include <base/allocator_avl.h>
 #include <base/env.h>
 #include <util/list.h>
+#include <util/reconstructible.h>
 #include <ram_session/ram_session.h>
-#include <rm_session/rm_session.h>
+#include <region_map/client.h>
+#include <rm_session/connection.h>
 
 namespace Libc {
 
@@ -38,15 +40,29 @@ namespace Libc {
 				MAX_CHUNK_SIZE = 1024*1024
 			};
 
+		public:
+
+			/*
+			 * Backing store of at least this size is allocated in units of
+			 * 2 MiB so that the kernel can use superpage mappings
+			 */
+			enum {
+				HUGE_PAGE_SHIFT = 21,
+				HUGE_PAGE_SIZE  = 1UL << HUGE_PAGE_SHIFT
+			};
+
+		private:
+
 			class Dataspace : public Genode::List<Dataspace>::Element
 			{
 				public:
 
 					Genode::Ram_dataspace_capability cap;
 					void  *local_addr;
+					bool   in_area;   /* attached within the reserved area */
 
-					Dataspace(Genode::Ram_dataspace_capability c, void *a)
-					: cap(c), local_addr(a) {}
+					Dataspace(Genode::Ram_dataspace_capability c, void *a, bool in_area)
+					: cap(c), local_addr(a), in_area(in_area) {}
 
 					inline void * operator new(__SIZE_TYPE__, void* addr) {
 						return addr; }
@@ -58,10 +74,40 @@ namespace Libc {
 			{
 				private:
 
+					/**
+					 * Virtual area reserved up front
+					 *
+					 * The area is attached to the address space as managed
+					 * dataspace. Its size is a multiple of 'HUGE_PAGE_SIZE'.
+					 * It is populated with dataspaces one after another.
+					 * Dataspaces of at least 'HUGE_PAGE_SIZE' are placed at
+					 * 'HUGE_PAGE_SIZE'-aligned offsets.
+					 */
+					struct Area
+					{
+						Genode::Rm_connection     rm;
+						Genode::size_t const      size;
+						Genode::Region_map_client map;
+						Genode::addr_t const      base;
+						Genode::size_t            used = 0;
+
+						Area(Genode::Env &env, Genode::Region_map &local_rm,
+						     Genode::size_t size)
+						:
+							rm(env), size(size), map(rm.create(size)),
+							base(local_rm.attach(map.dataspace()))
+						{ }
+
+						bool fits(Genode::size_t offset, Genode::size_t s) const {
+							return offset <= size && s <= size - offset; }
+					};
+
 					Genode::Ram_session *_ram_session;  /* ram session for backing store */
 					Genode::Region_map  *_region_map;   /* region map of address space   */
 					bool const           _executable;   /* whether to allocate executable dataspaces */
 
+					Genode::Constructible<Area> _area { };
+
 				public:
 
 					/**
@@ -91,6 +137,22 @@ namespace Libc {
 					 */
 					int expand(Genode::size_t size, Genode::Range_allocator *alloc);
 
+					/**
+					 * Reserve virtual area for the backing store
+					 *
+					 * \throw Service_denied
+					 * \throw Out_of_ram
+					 * \throw Out_of_caps
+					 */
+					void reserve(Genode::Env &env, Genode::size_t size)
+					{
+						if (!_area.constructed())
+							_area.construct(env, *_region_map,
+							                Genode::align_addr(size, HUGE_PAGE_SHIFT));
+					}
+
+					bool reserved() const { return _area.constructed(); }
+
 					void reassign_resources(Genode::Ram_session *ram, Genode::Region_map *rm) {
 						_ram_session = ram, _region_map = rm; }
 			};
@@ -124,6 +186,15 @@ namespace Libc {
 			void *alloc(Genode::size_t size, Genode::size_t align_log2);
 			void free(void *ptr);
 			Genode::size_t size_at(void const *ptr) const;
+
+			/**
+			 * Back the allocator by a virtual area of 'size' bytes reserved up
+			 * front
+			 *
+			 * Once the area is exhausted, backing store is attached anywhere
+			 * in the address space.
+			 */
+			void reserve(Genode::Env &env, Genode::size_t size);
 	};
 }
 
@@ -16,6 +16,9 @@
 #include <base/env.h>
 #include <base/log.h>
 #include <base/slab.h>
+#include <base/thread.h>
+#include <cpu/atomic.h>
+#include <cpu/memory_barrier.h>
 #include <util/construct_at.h>
 #include <util/string.h>
 #include <util/misc_math.h>
@@ -24,10 +27,12 @@
 extern "C" {
 #include <string.h>
 #include <stdlib.h>
+#include <stdio.h>
 }
 
 /* libc-internal includes */
 #include "libc_init.h"
+#include "libc_mem_alloc.h"
 #include <base/internal/unmanaged_singleton.h>
 
 
@@ -66,6 +71,15 @@ namespace Genode {
 
 /**
  * Allocator that uses slabs for small objects sizes
+ *
+ * Small objects are cached per thread. A thread allocates from and frees to
+ * its own cache without taking the global lock. The slabs are refilled and
+ * drained in batches. A cache returns half of a size class to the slabs
+ * once the class exceeds its capacity. Large allocations bypass the slabs
+ * and are served by 'Libc::Mem_alloc' directly.
+ *
+ * At most 'NUM_CACHES' threads get a cache. Caches are not released when
+ * their thread exits (see '_thread_cache').
  */
 class Malloc
 {
@@ -80,6 +94,13 @@ class Malloc
 			NUM_SLABS  = (SLAB_STOP - SLAB_START) + 1
 		};
 
+		enum {
+			NUM_CACHES  = 32,       /* max. number of threads with a cache */
+			CACHE_BYTES = 8*1024,   /* capacity of a cache per size class */
+			MIN_CACHED  = 4,        /* min. capacity in objects */
+			BATCH       = 16,       /* max. objects taken from a slab at once */
+		};
+
 		struct Metadata
 		{
 			unsigned long long value; /* bits 63..5 size and 4..0 offset */
@@ -112,10 +133,64 @@ class Malloc
 		 */
 		static constexpr size_t _room() { return sizeof(Metadata) + 15; }
 
+		/**
+		 * Free slab blocks of one size class, linked via their first word
+		 */
+		struct Bin
+		{
+			void     *head  = nullptr;
+			unsigned  count = 0;
+
+			void push(void *block)
+			{
+				*(void **)block = head;
+				head = block;
+				count++;
+			}
+
+			void *pop()
+			{
+				void *block = head;
+				if (block) {
+					head = *(void **)block;
+					count--;
+				}
+				return block;
+			}
+		};
+
+		struct Thread_cache
+		{
+			enum { FREE = 0, CLAIMING = 1, CLAIMED = 2 };
+
+			int volatile              state = FREE;
+			Genode::Thread * volatile owner = nullptr;
+
+			Bin bins[NUM_SLABS];
+
+			/* statistics, updated by the owner only */
+			unsigned long hits = 0, misses = 0, drains = 0;
+		};
+
+		struct Statistics
+		{
+			unsigned long slab_allocs  = 0;
+			unsigned long slab_frees   = 0;
+			unsigned long large_allocs = 0;
+			unsigned long large_frees  = 0;
+			unsigned long large_bytes  = 0;
+			unsigned long uncached     = 0;
+		};
+
 		Genode::Allocator  &_backing_store;        /* back-end allocator */
 		Genode::Slab_alloc *_allocator[NUM_SLABS]; /* slab allocators */
 		Genode::Lock        _lock;
 
+		Thread_cache _caches[NUM_CACHES];
+
+		/* protected by '_lock' */
+		Statistics _stats { };
+
 		unsigned _slab_log2(size_t size) const
 		{
 			unsigned msb = Genode::log2(size);
@@ -131,6 +206,113 @@ class Malloc
 			return msb;
 		}
 
+		static unsigned _capacity(unsigned msb)
+		{
+			return Genode::max((unsigned)(CACHE_BYTES >> msb), (unsigned)MIN_CACHED);
+		}
+
+		/**
+		 * Return cache of the calling thread, or nullptr if all are taken
+		 *
+		 * A cache is claimed by the first 'NUM_CACHES' threads that allocate
+		 * or free a small block. All further threads are served by the slabs
+		 * under the global lock. Caches are never released. When a thread
+		 * exits, its cache stays claimed and the blocks held in its bins,
+		 * up to 'CACHE_BYTES' per size class, are leaked. A cache is only
+		 * reused by a later thread whose 'Thread' object occupies the same
+		 * address as the one of the exited owner.
+		 */
+		Thread_cache *_thread_cache()
+		{
+			Genode::Thread * const myself = Genode::Thread::myself();
+
+			unsigned const start = ((addr_t)myself >> 12) % NUM_CACHES;
+
+			for (unsigned i = 0; i < NUM_CACHES; i++) {
+				Thread_cache &cache = _caches[(start + i) % NUM_CACHES];
+
+				if (cache.state == Thread_cache::CLAIMED && cache.owner == myself)
+					return &cache;
+
+				if (cache.state == Thread_cache::FREE
+				 && Genode::cmpxchg(&cache.state, Thread_cache::FREE,
+				                                  Thread_cache::CLAIMING)) {
+					cache.owner = myself;
+					Genode::memory_barrier();
+					cache.state = Thread_cache::CLAIMED;
+					return &cache;
+				}
+			}
+			return nullptr;
+		}
+
+		/**
+		 * Move up to 'count' blocks of the bin back to the slab
+		 */
+		void _drain(Bin &bin, unsigned msb, unsigned count)
+		{
+			Genode::Lock::Guard lock_guard(_lock);
+
+			for (unsigned i = 0; i < count; i++) {
+				void *block = bin.pop();
+				if (!block)
+					break;
+				_allocator[msb - SLAB_START]->free(block);
+				_stats.slab_frees++;
+			}
+		}
+
+		/**
+		 * Allocate slab block, refill the bin if given
+		 */
+		void *_slab_alloc(unsigned msb, Bin *bin)
+		{
+			Genode::Lock::Guard lock_guard(_lock);
+
+			Genode::Slab_alloc &slab = *_allocator[msb - SLAB_START];
+
+			void *block = slab.alloc();
+			if (!block)
+				return nullptr;
+			_stats.slab_allocs++;
+
+			if (!bin) {
+				_stats.uncached++;
+				return block;
+			}
+
+			unsigned const batch = Genode::min(_capacity(msb)/2, (unsigned)BATCH);
+			for (unsigned i = 1; i < batch; i++) {
+				void *extra = slab.alloc();
+				if (!extra)
+					break;
+				_stats.slab_allocs++;
+				bin->push(extra);
+			}
+			return block;
+		}
+
+		void *_large_alloc(size_t size)
+		{
+			void *addr = Libc::mem_alloc()->alloc(size, 4);
+			if (!addr)
+				return nullptr;
+
+			Genode::Lock::Guard lock_guard(_lock);
+			_stats.large_allocs++;
+			_stats.large_bytes += size;
+			return addr;
+		}
+
+		void _large_free(void *addr, size_t size)
+		{
+			Libc::mem_alloc()->free(addr);
+
+			Genode::Lock::Guard lock_guard(_lock);
+			_stats.large_frees++;
+			_stats.large_bytes -= size;
+		}
+
 	public:
 
 		Malloc(Genode::Allocator &backing_store) : _backing_store(backing_store)
@@ -149,18 +331,27 @@ class Malloc
 
 		void * alloc(size_t size)
 		{
-			Genode::Lock::Guard lock_guard(_lock);
-
 			size_t   const real_size = size + _room();
 			unsigned const msb       = _slab_log2(real_size);
 
 			void *alloc_addr = nullptr;
 
-			/* use backing store if requested memory is larger than largest slab */
+			/* use 'Mem_alloc' if requested memory is larger than largest slab */
 			if (msb > SLAB_STOP)
-				_backing_store.alloc(real_size, &alloc_addr);
-			else
-				alloc_addr = _allocator[msb - SLAB_START]->alloc();
+				alloc_addr = _large_alloc(real_size);
+			else {
+				Thread_cache *cache = _thread_cache();
+				Bin          *bin   = cache ? &cache->bins[msb - SLAB_START] : nullptr;
+
+				alloc_addr = bin ? bin->pop() : nullptr;
+
+				if (alloc_addr)
+					cache->hits++;
+				else {
+					if (cache) cache->misses++;
+					alloc_addr = _slab_alloc(msb, bin);
+				}
+			}
 
 			if (!alloc_addr) return nullptr;
 
@@ -200,8 +391,6 @@ class Malloc
 
 		void free(void *ptr)
 		{
-			Genode::Lock::Guard lock_guard(_lock);
-
 			Metadata *md = (Metadata *)ptr - 1;
 
 			size_t   const  real_size  = md->size();
@@ -210,10 +399,63 @@ class Malloc
 			void *alloc_addr = (void *)((addr_t)ptr - md->offset());
 
 			if (msb > SLAB_STOP) {
-				_backing_store.free(alloc_addr, real_size);
-			} else {
+				_large_free(alloc_addr, real_size);
+				return;
+			}
+
+			Thread_cache *cache = _thread_cache();
+			if (!cache) {
+				Genode::Lock::Guard lock_guard(_lock);
 				_allocator[msb - SLAB_START]->free(alloc_addr);
+				_stats.slab_frees++;
+				return;
+			}
+
+			Bin &bin = cache->bins[msb - SLAB_START];
+			bin.push(alloc_addr);
+
+			/* return half of the bin to the slab if the cache overflows */
+			unsigned const capacity = _capacity(msb);
+			if (bin.count > capacity) {
+				cache->drains++;
+				_drain(bin, msb, capacity/2);
+			}
+		}
+
+		/**
+		 * Print allocator statistics
+		 */
+		void print_statistics(FILE *out)
+		{
+			unsigned long hits = 0, misses = 0, drains = 0, cached = 0;
+			unsigned      threads = 0;
+
+			for (unsigned i = 0; i < NUM_CACHES; i++) {
+				Thread_cache const &cache = _caches[i];
+				if (cache.state != Thread_cache::CLAIMED)
+					continue;
+
+				threads++;
+				hits   += cache.hits;
+				misses += cache.misses;
+				drains += cache.drains;
+				for (unsigned j = 0; j < NUM_SLABS; j++)
+					cached += cache.bins[j].count;
+			}
+
+			Statistics stats;
+			{
+				Genode::Lock::Guard lock_guard(_lock);
+				stats = _stats;
 			}
+
+			fprintf(out, "malloc: thread caches %u, hits %lu, misses %lu, "
+			             "drains %lu, cached blocks %lu\n",
+			        threads, hits, misses, drains, cached);
+			fprintf(out, "malloc: slab allocs %lu, frees %lu, uncached %lu\n",
+			        stats.slab_allocs, stats.slab_frees, stats.uncached);
+			fprintf(out, "malloc: large allocs %lu, frees %lu, in use %lu bytes\n",
+			        stats.large_allocs, stats.large_frees, stats.large_bytes);
 		}
 };
 
@@ -242,6 +484,17 @@ extern "C" void free(void *ptr)
 }
 
 
+/**
+ * Print allocator statistics to stderr
+ *
+ * The output ends up at the VFS file configured as 'stderr' of the libc.
+ */
+extern "C" void malloc_stats(void)
+{
+	mallocator->print_statistics(stderr);
+}
+
+
 extern "C" void *realloc(void *ptr, size_t size)
 {
 	if (!ptr) return malloc(size);
@@ -19,6 +19,12 @@
 #include <libc-plugin/plugin_registry.h>
 #include <libc-plugin/plugin.h>
 
+/* libc includes */
+#include <sys/poll.h>
+#include <sys/uio.h>
+#include <errno.h>
+#include <unistd.h>
+
 using namespace Genode;
 using namespace Libc;
 
@@ -128,6 +134,106 @@ bool Plugin::supports_mmap()
 }
 
 
+bool Plugin::poll(File_descriptor &fd, struct pollfd &pfd)
+{
+	fd_set readfds, writefds, exceptfds;
+	FD_ZERO(&readfds); FD_ZERO(&writefds); FD_ZERO(&exceptfds);
+
+	if (pfd.events & POLLIN)  FD_SET(fd.libc_fd, &readfds);
+	if (pfd.events & POLLOUT) FD_SET(fd.libc_fd, &writefds);
+	FD_SET(fd.libc_fd, &exceptfds);
+
+	/* zero timeout for polling */
+	struct timeval tv_0 = { 0, 0 };
+
+	int const nfds = fd.libc_fd + 1;
+
+	if (!supports_select(nfds, &readfds, &writefds, &exceptfds, &tv_0))
+		return false;
+
+	if (select(nfds, &readfds, &writefds, &exceptfds, &tv_0) < 0)
+		return false;
+
+	pfd.revents = 0;
+	if (FD_ISSET(fd.libc_fd, &readfds))   pfd.revents |= POLLIN;
+	if (FD_ISSET(fd.libc_fd, &writefds))  pfd.revents |= POLLOUT;
+	if (FD_ISSET(fd.libc_fd, &exceptfds)) pfd.revents |= POLLERR;
+
+	return true;
+}
+
+
+ssize_t Plugin::sendfile(File_descriptor *, File_descriptor *, ::off_t, ::size_t)
+{
+	errno = EOPNOTSUPP;
+	return -1;
+}
+
+
+/**
+ * Emulate vectored I/O at 'offset' by transferring segment by segment
+ */
+template <typename FN>
+static ssize_t rw_vectored(Plugin &plugin, File_descriptor *fd,
+                           struct iovec const *iov, int iovcnt,
+                           ::off_t offset, FN const &rw)
+{
+	::off_t const old_offset = (offset == -1) ? 0 : plugin.lseek(fd, 0, SEEK_CUR);
+
+	if (offset != -1 && (old_offset == -1 || plugin.lseek(fd, offset, SEEK_SET) == -1))
+		return -1;
+
+	ssize_t total = 0;
+	bool    stop  = false;
+
+	for (int i = 0; i < iovcnt && !stop; i++) {
+
+		char    *base = (char *)iov[i].iov_base;
+		::size_t len  = iov[i].iov_len;
+
+		while (len > 0) {
+			ssize_t const n = rw(base, len);
+
+			/* report an error only if nothing was transferred */
+			if (n < 0 && total == 0)
+				total = -1;
+
+			if (n <= 0) {
+				stop = true;
+				break;
+			}
+
+			base  += n;
+			len   -= n;
+			total += n;
+		}
+	}
+
+	if (offset != -1)
+		plugin.lseek(fd, old_offset, SEEK_SET);
+
+	return total;
+}
+
+
+ssize_t Plugin::preadv(File_descriptor *fd, struct iovec const *iov,
+                       int iovcnt, ::off_t offset)
+{
+	return rw_vectored(*this, fd, iov, iovcnt, offset,
+	                   [&] (char *buf, ::size_t count) {
+	                   	return read(fd, buf, count); });
+}
+
+
+ssize_t Plugin::pwritev(File_descriptor *fd, struct iovec const *iov,
+                        int iovcnt, ::off_t offset)
+{
+	return rw_vectored(*this, fd, iov, iovcnt, offset,
+	                   [&] (char *buf, ::size_t count) {
+	                   	return write(fd, buf, count); });
+}
+
+
 /**
  * Generate dummy member function of Plugin class
  */
@@ -14,64 +14,54 @@
 /* Genode includes */
 #include <base/lock.h>
 #include <libc-plugin/fd_alloc.h>
+#include <libc-plugin/plugin.h>
 
 /* libc includes */
 #include <sys/types.h>
 #include <sys/uio.h>
+#include <errno.h>
 #include <unistd.h>
 
-
-struct Read
-{
-	ssize_t operator()(int fd, void *buf, size_t count)
-	{
-		return read(fd, buf, count);
-	}
-};
-
-
-struct Write
-{
-	ssize_t operator()(int fd, const void *buf, size_t count)
-	{
-		return write(fd, buf, count);
-	}
-};
+/* libc-internal includes */
+#include "libc_errno.h"
 
 
-template <typename Rw_func, typename Buf_type>
-static ssize_t pread_pwrite_impl(Rw_func rw_func, int fd, Buf_type buf, ::size_t count, ::off_t offset)
+/**
+ * Pass positional request to the plugin of the file descriptor
+ *
+ * The offset is handed to the plugin along with the request, the file
+ * offset is neither consulted nor modified.
+ */
+template <typename FN>
+static ssize_t pread_pwrite_impl(int fd, void *buf, ::size_t count, ::off_t offset,
+                                 FN const &fn)
 {
 	Libc::File_descriptor *fdesc = Libc::file_descriptor_allocator()->find_by_libc_fd(fd);
-	if (fdesc == 0)
-		return -1;
-
-	Genode::Lock_guard<Genode::Lock> rw_lock_guard(fdesc->lock);
+	if (fdesc == 0 || !fdesc->plugin)
+		return Libc::Errno(EBADF);
 
-	off_t old_offset = lseek(fd, 0, SEEK_CUR);
+	if (offset < 0)
+		return Libc::Errno(EINVAL);
 
-	if (old_offset == -1)
-		return -1;
-
-	if (lseek(fd, offset, SEEK_SET) == -1)
-		return -1;
-
-	ssize_t result = rw_func(fd, buf, count);
+	Genode::Lock_guard<Genode::Lock> rw_lock_guard(fdesc->lock);
 
-	if (lseek(fd, old_offset, SEEK_SET) == -1)
-		return -1;
+	struct iovec const iov { buf, count };
 
-	return result;
+	return fn(*fdesc->plugin, fdesc, iov);
 }
 
 
 extern "C" ssize_t pread(int fd, void *buf, ::size_t count, ::off_t offset)
 {
-	return pread_pwrite_impl(Read(), fd, buf, count, offset);
+	return pread_pwrite_impl(fd, buf, count, offset,
+		[&] (Libc::Plugin &plugin, Libc::File_descriptor *fdesc, iovec const &iov) {
+			return plugin.preadv(fdesc, &iov, 1, offset); });
 }
 
 
 extern "C" ssize_t pwrite(int fd, const void *buf, ::size_t count, ::off_t offset)
 {
-	return pread_pwrite_impl(Write(), fd, buf, count, offset);
+	return pread_pwrite_impl(fd, const_cast<void *>(buf), count, offset,
+		[&] (Libc::Plugin &plugin, Libc::File_descriptor *fdesc, iovec const &iov) {
+			return plugin.pwritev(fdesc, &iov, 1, offset); });
 }
@@ -14,88 +14,59 @@
 
 /* Genode includes */
 #include <base/lock.h>
+#include <libc-plugin/fd_alloc.h>
+#include <libc-plugin/plugin.h>
 
 /* libc includes */
 #include <sys/uio.h>
 #include <limits.h>
 #include <unistd.h>
 #include <errno.h>
-#include <stdio.h>
 
+/* libc-internal includes */
+#include "libc_errno.h"
 
-static Genode::Lock rw_lock;
 
-
-struct Read
-{
-     ssize_t operator()(int fd, void *buf, size_t count)
-     {
-    	 return read(fd, buf, count);
-     }
-};
+enum { CURRENT_OFFSET = -1 };
 
 
-struct Write
+/**
+ * Pass vectored request to the plugin of the file descriptor
+ *
+ * The plugin receives all segments at once, which enables it to transfer
+ * them by a single operation.
+ */
+template <typename FN>
+static ssize_t readv_writev_impl(int libc_fd, const struct iovec *iov, int iovcnt,
+                                 FN const &fn)
 {
-     ssize_t operator()(int fd, const void *buf, size_t count)
-     {
-    	 return write(fd, buf, count);
-     }
-};
+	Libc::File_descriptor *fd =
+		Libc::file_descriptor_allocator()->find_by_libc_fd(libc_fd);
 
+	if (!fd || !fd->plugin)
+		return Libc::Errno(EBADF);
 
-template <typename Rw_func>
-static ssize_t readv_writev_impl(Rw_func rw_func, int fd, const struct iovec *iov, int iovcnt)
-{
-	Genode::Lock_guard<Genode::Lock> rw_lock_guard(rw_lock);
+	if (iovcnt < 1 || iovcnt > IOV_MAX)
+		return Libc::Errno(EINVAL);
 
-	char *v;
-	ssize_t bytes_transfered_total = 0;
 	size_t v_len = 0;
-	int i;
-
-	if (iovcnt < 1 || iovcnt > IOV_MAX) {
-		errno = EINVAL;
-		return -1;
-	}
-
-	for (i = 0; i < iovcnt; i++)
-		v_len += iov->iov_len;
-
-	if (v_len > SSIZE_MAX) {
-		errno = EINVAL;
-		return -1;
-	}
-
-	while (iovcnt > 0) {
-		v = static_cast<char *>(iov->iov_base);
-		v_len = iov->iov_len;
-
-		while (v_len > 0) {
-			ssize_t bytes_transfered = rw_func(fd, v, v_len);
-
-			if (bytes_transfered == -1)
-				return -1;
+	for (int i = 0; i < iovcnt; i++)
+		v_len += iov[i].iov_len;
 
-			if (bytes_transfered == 0)
-				return bytes_transfered_total;
+	if (v_len > SSIZE_MAX)
+		return Libc::Errno(EINVAL);
 
-			v_len -= bytes_transfered;
-			v += bytes_transfered;
-			bytes_transfered_total += bytes_transfered;
-		}
+	Genode::Lock_guard<Genode::Lock> rw_lock_guard(fd->lock);
 
-		iov++;
-		iovcnt--;
-	}
-
-	return bytes_transfered_total;
+	return fn(*fd->plugin, fd);
 }
 
 
 extern "C" ssize_t _readv(int fd, const struct iovec *iov, int iovcnt)
 {
-	return readv_writev_impl(Read(), fd, iov, iovcnt);
+	return readv_writev_impl(fd, iov, iovcnt,
+		[&] (Libc::Plugin &plugin, Libc::File_descriptor *fdesc) {
+			return plugin.preadv(fdesc, iov, iovcnt, CURRENT_OFFSET); });
 }
 
 
@@ -107,7 +78,9 @@ extern "C" ssize_t readv(int fd, const struct iovec *iov, int iovcnt)
 
 extern "C" ssize_t _writev(int fd, const struct iovec *iov, int iovcnt)
 {
-	return readv_writev_impl(Write(), fd, iov, iovcnt);
+	return readv_writev_impl(fd, iov, iovcnt,
+		[&] (Libc::Plugin &plugin, Libc::File_descriptor *fdesc) {
+			return plugin.pwritev(fdesc, iov, iovcnt, CURRENT_OFFSET); });
 }
 
 
@@ -115,3 +88,25 @@ extern "C" ssize_t writev(int fd, const struct iovec *iov, int iovcnt)
 {
 	return _writev(fd, iov, iovcnt);
 }
+
+
+extern "C" ssize_t preadv(int fd, const struct iovec *iov, int iovcnt, ::off_t offset)
+{
+	if (offset < 0)
+		return Libc::Errno(EINVAL);
+
+	return readv_writev_impl(fd, iov, iovcnt,
+		[&] (Libc::Plugin &plugin, Libc::File_descriptor *fdesc) {
+			return plugin.preadv(fdesc, iov, iovcnt, offset); });
+}
+
+
+extern "C" ssize_t pwritev(int fd, const struct iovec *iov, int iovcnt, ::off_t offset)
+{
+	if (offset < 0)
+		return Libc::Errno(EINVAL);
+
+	return readv_writev_impl(fd, iov, iovcnt,
+		[&] (Libc::Plugin &plugin, Libc::File_descriptor *fdesc) {
+			return plugin.pwritev(fdesc, iov, iovcnt, offset); });
+}
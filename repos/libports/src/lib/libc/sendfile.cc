@@ -0,0 +1,163 @@
+/*
+ * \brief  'sendfile()' implementation
+ * \author Genode Labs
+ * \date   2026-10-14
+ *
+ * The data is copied by the plugin of the destination, which passes it from
+ * the buffer of the source file system directly to the destination, e.g.,
+ * from the packet buffer of a file-system session to the "data" file of a
+ * socket. If the plugin cannot copy between the file descriptors, the data
+ * is copied via a buffer on the stack.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <util/misc_math.h>
+
+/* Libc includes */
+#include <libc-plugin/fd_alloc.h>
+#include <libc-plugin/plugin.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/select.h>
+#include <sys/uio.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+/* libc-internal includes */
+#include "libc_errno.h"
+
+
+enum { MAX_CHUNK_SIZE = 64*1024, BOUNCE_BUFFER_SIZE = 4096 };
+
+
+/**
+ * Copy data via a buffer if the plugin cannot copy by itself
+ */
+static ssize_t copy_via_buffer(int in_fd, int out_fd, ::off_t offset, ::size_t count)
+{
+	char buf[BOUNCE_BUFFER_SIZE];
+
+	ssize_t const n = pread(in_fd, buf, Genode::min(count, sizeof(buf)), offset);
+	if (n <= 0)
+		return n;
+
+	/* data not taken by 'out_fd' is read again by the next call */
+	return write(out_fd, buf, n);
+}
+
+
+/**
+ * Block until 'fd' becomes writeable
+ */
+static void wait_for_write_ready(int fd)
+{
+	fd_set writefds;
+	FD_ZERO(&writefds);
+	FD_SET(fd, &writefds);
+
+	select(fd + 1, nullptr, &writefds, nullptr, nullptr);
+}
+
+
+/**
+ * Write all iovecs, return false on error
+ */
+static bool write_iovecs(int fd, struct iovec const *iov, int iovcnt,
+                         bool nonblocking, off_t &sent)
+{
+	for (int i = 0; i < iovcnt; i++) {
+
+		char const *base = (char const *)iov[i].iov_base;
+
+		for (::size_t done = 0; done < iov[i].iov_len; ) {
+
+			ssize_t const n = write(fd, base + done, iov[i].iov_len - done);
+
+			if (n < 0 && errno == EAGAIN && !nonblocking) {
+				wait_for_write_ready(fd);
+				continue;
+			}
+
+			if (n <= 0)
+				return false;
+
+			done += n;
+			sent += n;
+		}
+	}
+	return true;
+}
+
+
+extern "C" int
+__attribute__((weak))
+sendfile(int in_libc_fd, int out_libc_fd, off_t offset, size_t nbytes,
+         struct sf_hdtr *hdtr, off_t *sbytes, int flags)
+{
+	off_t sent = 0;
+
+	auto result = [&] (int ret) {
+		if (sbytes) *sbytes = sent;
+		return ret;
+	};
+
+	Libc::File_descriptor *in_fd =
+		Libc::file_descriptor_allocator()->find_by_libc_fd(in_libc_fd);
+	Libc::File_descriptor *out_fd =
+		Libc::file_descriptor_allocator()->find_by_libc_fd(out_libc_fd);
+
+	if (!in_fd || !out_fd || !out_fd->plugin)
+		return result(Libc::Errno(EBADF));
+
+	if (offset < 0)
+		return result(Libc::Errno(EINVAL));
+
+	bool const nonblocking = fcntl(out_libc_fd, F_GETFL) & O_NONBLOCK;
+
+	if (hdtr && !write_iovecs(out_libc_fd, hdtr->headers, hdtr->hdr_cnt,
+	                          nonblocking, sent))
+		return result(-1);
+
+	/* a count of zero means sending until the end of the file */
+	::size_t remaining = nbytes ? nbytes : ~(::size_t)0;
+
+	while (remaining) {
+
+		::size_t const count = Genode::min(remaining, (::size_t)MAX_CHUNK_SIZE);
+
+		ssize_t n = out_fd->plugin->sendfile(out_fd, in_fd, offset, count);
+
+		if (n < 0 && errno == EOPNOTSUPP)
+			n = copy_via_buffer(in_libc_fd, out_libc_fd, offset, count);
+
+		if (n < 0 && errno == EAGAIN && !nonblocking) {
+			wait_for_write_ready(out_libc_fd);
+			continue;
+		}
+
+		if (n < 0)
+			return result(-1);
+
+		/* end of file */
+		if (n == 0)
+			break;
+
+		offset    += n;
+		sent      += n;
+		remaining -= n;
+	}
+
+	if (hdtr && !write_iovecs(out_libc_fd, hdtr->trailers, hdtr->trl_cnt,
+	                          nonblocking, sent))
+		return result(-1);
+
+	return result(0);
+}
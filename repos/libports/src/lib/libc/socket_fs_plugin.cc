@@ -30,6 +30,7 @@
 #include <unistd.h>
 #include <ctype.h>
 #include <stdio.h>
+#include <sys/poll.h>
 
 /* libc-internal includes */
 #include "socket_fs_plugin.h"
@@ -121,6 +122,10 @@ struct Socket_fs::Context : Libc::Plugin_context
 		int  _fd_flags    = 0;
 		bool _accept_only = false;
 
+		/* remote address reported on accept */
+		sockaddr_in _remote      { };
+		bool        _remote_known = false;
+
 		template <typename FUNC>
 		void _fd_apply(FUNC const &fn)
 		{
@@ -188,6 +193,23 @@ struct Socket_fs::Context : Libc::Plugin_context
 
 		void accept_only() { _accept_only = true; }
 
+		void remote(sockaddr_in const &addr) { _remote = addr; _remote_known = true; }
+
+		/**
+		 * Copy known remote address to 'addr'
+		 *
+		 * \return false if the address must be read from the "remote" file
+		 */
+		bool remote(sockaddr_in *addr, socklen_t *addrlen) const
+		{
+			if (!_remote_known || !addr || !addrlen || *addrlen <= 0)
+				return false;
+
+			memcpy(addr, &_remote, Genode::min(*addrlen, (socklen_t)sizeof(_remote)));
+			*addrlen = sizeof(_remote);
+			return true;
+		}
+
 		bool read_ready()
 		{
 			return _accept_only ? accept_read_ready() : data_read_ready();
@@ -233,9 +255,11 @@ struct Socket_fs::Plugin : Libc::Plugin
 
 	ssize_t read(Libc::File_descriptor *, void *, ::size_t) override;
 	ssize_t write(Libc::File_descriptor *, const void *, ::size_t) override;
+	ssize_t sendfile(Libc::File_descriptor *, Libc::File_descriptor *, ::off_t, ::size_t) override;
 	int fcntl(Libc::File_descriptor *, int, long) override;
 	int close(Libc::File_descriptor *) override;
 	int select(int, fd_set *, fd_set *, fd_set *, timeval *) override;
+	bool poll(Libc::File_descriptor &, struct pollfd &) override;
 };
 
 
@@ -410,6 +434,9 @@ extern "C" int socket_fs_getpeername(int libc_fd, sockaddr *addr, socklen_t *add
 	case Socket_fs::Context::Proto::UDP: return Errno(ENOTCONN);
 	case Socket_fs::Context::Proto::TCP:
 		{
+			if (context->remote((sockaddr_in *)addr, addrlen))
+				return 0;
+
 			Socket_fs::Remote_functor func(*context, false);
 			return read_sockaddr_in(func, (sockaddr_in *)addr, addrlen);
 		}
@@ -447,28 +474,49 @@ extern "C" int socket_fs_accept(int libc_fd, sockaddr *addr, socklen_t *addrlen)
 	/* TODO EOPNOTSUPP - no SOCK_STREAM */
 	/* TODO ECONNABORTED */
 
-	char accept_socket[10];
+	/*
+	 * The socket fs may report the remote address of the new socket
+	 * separated by a space, e.g., "tcp/3 10.0.2.1:80".
+	 */
+	Sockaddr_string accept_socket;
+	char *remote = nullptr;
 	{
 		int n = 0;
 		/* XXX currently reading accept may return without new connection */
 		do {
-			n = read(context->accept_fd(), accept_socket, sizeof(accept_socket));
+			n = read(context->accept_fd(), accept_socket.base(),
+			         accept_socket.capacity() - 1);
 		} while (n == 0);
 		if (n == -1 && errno == EAGAIN)
 			return Errno(EAGAIN);
-		if (n == -1 || n >= (int)sizeof(accept_socket) - 1)
+		if (n == -1 || n >= (int)accept_socket.capacity() - 1)
 			return Errno(EINVAL);
 
-		accept_socket[n] = 0;
+		accept_socket.terminate(n);
+		accept_socket.remove_trailing_newline();
+
+		remote = strchr(accept_socket.base(), ' ');
+		if (remote)
+			*remote++ = 0;
 	}
 
-	Absolute_path accept_path(accept_socket, Libc::config_socket());
+	Absolute_path accept_path(accept_socket.base(), Libc::config_socket());
 	Socket_fs::Context *accept_context = new (&global_allocator)
 	                                     Socket_fs::Context(context->proto(), accept_path);
 	Libc::File_descriptor *new_fd =
 		Libc::file_descriptor_allocator()->alloc(&plugin(), accept_context);
 
-	if (addr && addrlen) {
+	if (remote) {
+		Sockaddr_string remote_string;
+		strncpy(remote_string.base(), remote, remote_string.capacity());
+
+		try {
+			accept_context->remote(sockaddr_in_struct(remote_string.host(),
+			                                          remote_string.port()));
+		} catch (Address_conversion_failed) { }
+	}
+
+	if (addr && addrlen && !accept_context->remote((sockaddr_in *)addr, addrlen)) {
 		Socket_fs::Remote_functor func(*accept_context, false);
 		int ret = read_sockaddr_in(func, (sockaddr_in *)addr, addrlen);
 		if (ret == -1) return ret;
@@ -742,6 +790,12 @@ extern "C" int socket_fs_shutdown(int libc_fd, int how)
 }
 
 
+/**
+ * Create socket by reading the "new_socket" file of the protocol
+ *
+ * The file is opened for each socket. A file descriptor kept open across
+ * calls would be visible to the application, which may close or 'dup2' it.
+ */
 static Genode::String<16> new_socket(Absolute_path const &path)
 {
 	Absolute_path new_socket("new_socket", path.base());
@@ -751,6 +805,7 @@ static Genode::String<16> new_socket(Absolute_path const &path)
 		Genode::error(__func__, ": new_socket file not accessible - socket fs not mounted?");
 		throw New_socket_failed();
 	}
+
 	char buf[10];
 	int const n = read(fd, buf, sizeof(buf));
 	close(fd);
@@ -918,6 +973,50 @@ int Socket_fs::Plugin::select(int nfds,
 }
 
 
+ssize_t Socket_fs::Plugin::sendfile(Libc::File_descriptor *fd,
+                                    Libc::File_descriptor *in_fd,
+                                    ::off_t offset, ::size_t count)
+{
+	Socket_fs::Context *context = dynamic_cast<Socket_fs::Context *>(fd->context);
+	if (!context) return Errno(ENOTSOCK);
+
+	/* pass the data directly to the "data" file of the socket */
+	try {
+		int const data_fd = context->data_fd();
+
+		Libc::File_descriptor *data =
+			Libc::file_descriptor_allocator()->find_by_libc_fd(data_fd);
+		if (!data || !data->plugin) return Errno(EBADF);
+
+		lseek(data_fd, 0, 0);
+		return data->plugin->sendfile(data, in_fd, offset, count);
+	} catch (Socket_fs::Context::Inaccessible) {
+		return Errno(EINVAL);
+	}
+}
+
+
+bool Socket_fs::Plugin::poll(Libc::File_descriptor &fdo, struct pollfd &pfd)
+{
+	Socket_fs::Context *context = dynamic_cast<Socket_fs::Context *>(fdo.context);
+	if (!context) return false;
+
+	pfd.revents = 0;
+
+	if (pfd.events & POLLIN) {
+		try {
+			if (context->read_ready())
+				pfd.revents |= POLLIN;
+		} catch (Socket_fs::Context::Inaccessible) { }
+	}
+
+	if (pfd.events & POLLOUT)
+		pfd.revents |= POLLOUT; /* XXX ask if "data" is writeable */
+
+	return true;
+}
+
+
 int Socket_fs::Plugin::close(Libc::File_descriptor *fd)
 {
 	Socket_fs::Context *context = dynamic_cast<Socket_fs::Context *>(fd->context);
@@ -0,0 +1,218 @@
+/*
+ * \brief  Cache of VFS stat results
+ * \author Genode Labs
+ * \date   2026-10-14
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _LIBC__STAT_CACHE_H_
+#define _LIBC__STAT_CACHE_H_
+
+/* Genode includes */
+#include <base/allocator.h>
+#include <base/lock.h>
+#include <base/log.h>
+#include <util/construct_at.h>
+#include <util/string.h>
+#include <vfs/directory_service.h>
+
+namespace Libc { class Stat_cache; }
+
+
+/**
+ * Direct-mapped cache of the stat results of recently looked-up paths
+ *
+ * Besides the stat information of existing nodes, the cache holds negative
+ * entries for paths that do not exist. The VFS does not notify about
+ * modifications. Hence, the cache is invalidated by the modifying
+ * operations of the libc only and must not be used for file systems that
+ * are modified by other components.
+ */
+class Libc::Stat_cache : Genode::Noncopyable
+{
+	public:
+
+		typedef Vfs::Directory_service::Stat        Stat;
+		typedef Vfs::Directory_service::Stat_result Stat_result;
+
+	private:
+
+		/* longer paths are not cached */
+		enum { MAX_PATH_LEN = 160, REPORT_INTERVAL = 4096 };
+
+		typedef Genode::String<MAX_PATH_LEN> Path;
+
+		struct Entry
+		{
+			unsigned    generation = 0;   /* valid if equal to '_generation' */
+			Path        path { };
+			Stat_result result = Stat_result::STAT_ERR_NO_ENTRY;
+			Stat        stat { };
+		};
+
+		Genode::Allocator &_alloc;
+
+		unsigned const _num_entries;
+
+		Entry * const _entries;
+
+		bool const _verbose;
+
+		/* incremented to invalidate all entries at once */
+		unsigned _generation = 1;
+
+		unsigned long _hits = 0, _misses = 0;
+
+		Genode::Lock _lock { };
+
+		/**
+		 * FNV-1a hash of path
+		 */
+		static unsigned _hash(char const *path, Genode::size_t len)
+		{
+			unsigned h = 2166136261u;
+			for (Genode::size_t i = 0; i < len; i++)
+				h = (h ^ (unsigned char)path[i])*16777619u;
+			return h;
+		}
+
+		static Entry *_alloc_entries(Genode::Allocator &alloc, unsigned num)
+		{
+			Entry *entries = (Entry *)alloc.alloc(num*sizeof(Entry));
+			for (unsigned i = 0; i < num; i++)
+				Genode::construct_at<Entry>(&entries[i]);
+			return entries;
+		}
+
+		Entry &_slot(char const *path, Genode::size_t len) {
+			return _entries[_hash(path, len) % _num_entries]; }
+
+		bool _cacheable(char const *path) const {
+			return Genode::strlen(path) < MAX_PATH_LEN; }
+
+		void _invalidate(char const *path, Genode::size_t len)
+		{
+			Entry &e = _slot(path, len);
+
+			if (e.generation == _generation && e.path.length() == len + 1
+			 && Genode::strcmp(e.path.string(), path, len) == 0)
+				e.generation = 0;
+		}
+
+	public:
+
+		Stat_cache(Genode::Allocator &alloc, unsigned num_entries, bool verbose)
+		:
+			_alloc(alloc), _num_entries(num_entries),
+			_entries(_alloc_entries(alloc, num_entries)), _verbose(verbose)
+		{ }
+
+		~Stat_cache() { _alloc.free(_entries, _num_entries*sizeof(Entry)); }
+
+		/**
+		 * Look up cached stat result of 'path'
+		 *
+		 * \return  true if the result of 'path' is cached, in which
+		 *          case 'result' and 'stat' are filled in
+		 */
+		bool lookup(char const *path, Stat_result &result, Stat &stat)
+		{
+			Genode::Lock::Guard guard(_lock);
+
+			bool hit = false;
+
+			if (_cacheable(path)) {
+				Entry const &e = _slot(path, Genode::strlen(path));
+
+				if (e.generation == _generation && e.path == path) {
+					result = e.result;
+					stat   = e.stat;
+					hit    = true;
+				}
+			}
+
+			if (hit) _hits++; else _misses++;
+
+			if (_verbose && (_hits + _misses) % REPORT_INTERVAL == 0)
+				Genode::log("stat cache: ", _hits, " hits, ", _misses, " misses");
+
+			return hit;
+		}
+
+		/**
+		 * Remember stat result of 'path'
+		 *
+		 * Only positive results and the absence of a path are cached.
+		 */
+		void insert(char const *path, Stat_result result, Stat const &stat)
+		{
+			if (result != Stat_result::STAT_OK
+			 && result != Stat_result::STAT_ERR_NO_ENTRY)
+				return;
+
+			if (!_cacheable(path))
+				return;
+
+			Genode::Lock::Guard guard(_lock);
+
+			Entry &e = _slot(path, Genode::strlen(path));
+
+			e.generation = _generation;
+			e.path       = Path(path);
+			e.result     = result;
+			e.stat       = stat;
+		}
+
+		/**
+		 * Invalidate entry of 'path' and its parent directory
+		 */
+		void invalidate(char const *path)
+		{
+			if (!path) {
+				flush();
+				return;
+			}
+
+			Genode::Lock::Guard guard(_lock);
+
+			Genode::size_t len = Genode::strlen(path);
+
+			_invalidate(path, len);
+
+			/* strip last path element, keep the leading slash of the root */
+			while (len > 1 && path[len - 1] != '/')
+				len--;
+			if (len > 1)
+				len--;
+
+			_invalidate(path, len);
+		}
+
+		/**
+		 * Invalidate all entries
+		 *
+		 * This is used for operations that affect whole subtrees such as
+		 * renaming or removing directories.
+		 */
+		void flush()
+		{
+			Genode::Lock::Guard guard(_lock);
+
+			if (++_generation)
+				return;
+
+			/* generation counter wrapped, entries may appear valid again */
+			for (unsigned i = 0; i < _num_entries; i++)
+				_entries[i].generation = 0;
+
+			_generation = 1;
+		}
+};
+
+#endif /* _LIBC__STAT_CACHE_H_ */
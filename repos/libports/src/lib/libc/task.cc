@@ -344,6 +344,7 @@ struct Libc::Pthreads
 
 
 extern void (*libc_select_notify)();
+extern void (*libc_kqueue_notify)();
 
 struct Libc::Io_response_handler : Vfs::Io_response_handler
 {
@@ -353,6 +354,10 @@ struct Libc::Io_response_handler : Vfs::Io_response_handler
 		if (libc_select_notify)
 			libc_select_notify();
 
+		/* kqueues need to be re-examined */
+		if (libc_kqueue_notify)
+			libc_kqueue_notify();
+
 		/* resume all as any context may have been deblocked from blocking I/O */
 		Libc::resume_all();
 	}
@@ -914,14 +919,16 @@ void Component::construct(Genode::Env &env)
 		*unmanaged_singleton<Genode::Heap>(env.ram(), env.rm());
 
 	/* pass Genode::Env to libc subsystems that depend on it */
-	Libc::init_malloc(heap);
 	Libc::init_mem_alloc(env);
+	Libc::init_malloc(heap);
 	Libc::init_dl(env);
 	Libc::sysctl_init(env);
 
 	kernel = unmanaged_singleton<Libc::Kernel>(env, heap);
 
 	Libc::libc_config_init(kernel->libc_env().libc_config());
+	Libc::init_mem_alloc_area(env, kernel->libc_env().libc_config());
+	Libc::init_addrinfo_cache(heap, kernel->libc_env().libc_config());
 
 	/*
 	 * XXX The following two steps leave us with the dilemma that we don't know
@@ -17,6 +17,7 @@
 #include <base/env.h>
 #include <base/log.h>
 #include <vfs/dir_file_system.h>
+#include <dataspace/client.h>
 
 /* libc includes */
 #include <errno.h>
@@ -28,6 +29,8 @@
 #include <unistd.h>
 #include <termios.h>
 #include <sys/mman.h>
+#include <sys/poll.h>
+#include <sys/uio.h>
 #include <sys/ioctl.h>
 #include <sys/disk.h>
 #include <dlfcn.h>
@@ -158,9 +161,16 @@ namespace Libc {
 
 int Libc::Vfs_plugin::access(const char *path, int amode)
 {
+	Stat_result result;
+	Stat        stat;
+	if (_cached_stat(path, result, stat))
+		return result == Stat_result::STAT_OK ? 0 : Errno(ENOENT);
+
 	if (_root_dir.leaf_path(path))
 		return 0;
 
+	_remember_missing(path);
+
 	errno = ENOENT;
 	return -1;
 }
@@ -169,7 +179,13 @@ int Libc::Vfs_plugin::access(const char *path, int amode)
 Libc::File_descriptor *Libc::Vfs_plugin::open(char const *path, int flags,
                                               int libc_fd)
 {
-	if (_root_dir.directory(path)) {
+	/* a path known to be missing cannot be opened without creating it */
+	if (!(flags & (O_CREAT | O_NOFOLLOW)) && _known_missing(path)) {
+		errno = ENOENT;
+		return nullptr;
+	}
+
+	if (_directory(path)) {
 
 		if (((flags & O_ACCMODE) != O_RDONLY)) {
 			errno = EINVAL;
@@ -226,6 +242,7 @@ Libc::File_descriptor *Libc::Vfs_plugin::open(char const *path, int flags,
 					        errno = ELOOP;
 					        return 0;
 					}
+					_remember_missing(path);
 					errno = ENOENT;
 					return 0;
 				}
@@ -267,6 +284,9 @@ Libc::File_descriptor *Libc::Vfs_plugin::open(char const *path, int flags,
 
 	/* the file was successfully opened */
 
+	if (flags & (O_CREAT | O_TRUNC))
+		_invalidate_stat(path);
+
 	Libc::File_descriptor *fd =
 		Libc::file_descriptor_allocator()->alloc(this, vfs_context(handle), libc_fd);
 
@@ -333,6 +353,7 @@ int Libc::Vfs_plugin::mkdir(const char *path, mode_t mode)
 	switch (_root_dir.opendir(path, true, &dir_handle, _alloc)) {
 	case Opendir_result::OPENDIR_OK:
 		dir_handle->ds().close(dir_handle);
+		_invalidate_stat(path);
 		break;
 	case Opendir_result::OPENDIR_ERR_LOOKUP_FAILED:
 		return Errno(ENOENT);
@@ -363,7 +384,7 @@ int Libc::Vfs_plugin::stat(char const *path, struct stat *buf)
 
 	Vfs::Directory_service::Stat stat;
 
-	switch (_root_dir.stat(path, stat)) {
+	switch (_stat(path, stat)) {
 	case Result::STAT_ERR_NO_ENTRY: errno = ENOENT; return -1;
 	case Result::STAT_ERR_NO_PERM:  errno = EACCES; return -1;
 	case Result::STAT_OK:                           break;
@@ -381,6 +402,8 @@ ssize_t Libc::Vfs_plugin::write(Libc::File_descriptor *fd, const void *buf,
 
 	Vfs::Vfs_handle *handle = vfs_handle(fd);
 
+	_invalidate_stat(fd->fd_path);
+
 	Vfs::file_size out_count  = 0;
 	Result         out_result = Result::WRITE_OK;
 
@@ -532,6 +555,386 @@ ssize_t Libc::Vfs_plugin::read(Libc::File_descriptor *fd, void *buf,
 }
 
 
+/**
+ * Number of segments of a vectored request passed to the VFS at once
+ */
+enum { MAX_IO_SEGMENTS = 16 };
+
+
+/**
+ * Position within the segments of a vectored request
+ */
+struct Io_cursor
+{
+	struct iovec const * const iov;
+	int const                  iovcnt;
+
+	int      index = 0;   /* current segment */
+	::size_t skip  = 0;   /* bytes of current segment already transferred */
+
+	Io_cursor(struct iovec const *iov, int iovcnt) : iov(iov), iovcnt(iovcnt) { }
+
+	bool done() const { return index >= iovcnt; }
+
+	/**
+	 * Convert up to 'MAX_IO_SEGMENTS' remaining segments
+	 *
+	 * \return number of converted segments
+	 */
+	unsigned fill(Vfs::Io_vector *segments, Vfs::file_size &count) const
+	{
+		unsigned num = 0;
+		count = 0;
+
+		for (int i = index; i < iovcnt && num < MAX_IO_SEGMENTS; i++, num++) {
+			::size_t const s = (i == index) ? skip : 0;
+			segments[num] = Vfs::Io_vector { (char *)iov[i].iov_base + s,
+			                                 iov[i].iov_len - s };
+			count += iov[i].iov_len - s;
+		}
+		return num;
+	}
+
+	void advance(Vfs::file_size n)
+	{
+		while (index < iovcnt) {
+			::size_t const left = iov[index].iov_len - skip;
+			if (n < left) { skip += n; return; }
+			n -= left;
+			index++;
+			skip = 0;
+		}
+	}
+};
+
+
+ssize_t Libc::Vfs_plugin::preadv(Libc::File_descriptor *fd, struct iovec const *iov,
+                                 int iovcnt, ::off_t offset)
+{
+	Libc::dispatch_pending_io_signals();
+
+	typedef Vfs::File_io_service::Read_result Result;
+
+	Vfs::Vfs_handle *handle = vfs_handle(fd);
+
+	if (offset == -1 && fd->flags & O_NONBLOCK && !Libc::read_ready(fd))
+		return Errno(EAGAIN);
+
+	Vfs::file_size const saved_seek = handle->seek();
+	if (offset != -1)
+		handle->seek(offset);
+
+	ssize_t total      = 0;
+	Result  out_result = Result::READ_OK;
+
+	for (Io_cursor cursor(iov, iovcnt); !cursor.done(); ) {
+
+		Vfs::Io_vector segments[MAX_IO_SEGMENTS];
+		Vfs::file_size count = 0;
+		unsigned const num   = cursor.fill(segments, count);
+
+		cursor.advance(count);
+
+		if (!count)
+			continue;
+
+		/* one queued read covers all segments */
+		{
+			struct Check : Libc::Suspend_functor
+			{
+				bool             retry { false };
+
+				Vfs::Vfs_handle *handle;
+				Vfs::file_size   count;
+
+				Check(Vfs::Vfs_handle *handle, Vfs::file_size count)
+				: handle(handle), count(count) { }
+
+				bool suspend() override
+				{
+					retry = !handle->fs().queue_read(handle, count);
+					return retry;
+				}
+			} check ( handle, count);
+
+			do {
+				Libc::suspend(check);
+			} while (check.retry);
+		}
+
+		Vfs::file_size out_count = 0;
+
+		{
+			struct Check : Libc::Suspend_functor
+			{
+				bool                  retry { false };
+
+				Vfs::Vfs_handle      *handle;
+				Vfs::Io_vector const *segments;
+				unsigned              num;
+				Vfs::file_size       &out_count;
+				Result               &out_result;
+
+				Check(Vfs::Vfs_handle *handle, Vfs::Io_vector const *segments,
+				      unsigned num, Vfs::file_size &out_count, Result &out_result)
+				: handle(handle), segments(segments), num(num),
+				  out_count(out_count), out_result(out_result)
+				{ }
+
+				bool suspend() override
+				{
+					out_result = handle->fs().complete_readv(handle, segments,
+					                                         num, out_count);
+					/* suspend me if read is still queued */
+
+					retry = (out_result == Result::READ_QUEUED);
+
+					return retry;
+				}
+			} check ( handle, segments, num, out_count, out_result);
+
+			do {
+				Libc::suspend(check);
+			} while (check.retry);
+		}
+
+		if (out_result != Result::READ_OK)
+			break;
+
+		handle->advance_seek(out_count);
+		total += out_count;
+
+		/* short read */
+		if (out_count < count)
+			break;
+	}
+
+	if (offset != -1)
+		handle->seek(saved_seek);
+
+	/* report an error only if nothing was read */
+	if (total)
+		return total;
+
+	switch (out_result) {
+	case Result::READ_ERR_AGAIN:       return Errno(EAGAIN);
+	case Result::READ_ERR_WOULD_BLOCK: return Errno(EWOULDBLOCK);
+	case Result::READ_ERR_INVALID:     return Errno(EINVAL);
+	case Result::READ_ERR_IO:          return Errno(EIO);
+	case Result::READ_ERR_INTERRUPT:   return Errno(EINTR);
+	case Result::READ_OK:              break;
+
+	case Result::READ_QUEUED: /* handled above, so never reached */ break;
+	}
+
+	return 0;
+}
+
+
+ssize_t Libc::Vfs_plugin::pwritev(Libc::File_descriptor *fd, struct iovec const *iov,
+                                  int iovcnt, ::off_t offset)
+{
+	typedef Vfs::File_io_service::Write_result Result;
+
+	Vfs::Vfs_handle *handle = vfs_handle(fd);
+
+	_invalidate_stat(fd->fd_path);
+
+	Vfs::file_size const saved_seek = handle->seek();
+	if (offset != -1)
+		handle->seek(offset);
+
+	ssize_t total      = 0;
+	Result  out_result = Result::WRITE_OK;
+
+	for (Io_cursor cursor(iov, iovcnt); !cursor.done(); ) {
+
+		Vfs::Io_vector segments[MAX_IO_SEGMENTS];
+		Vfs::file_size count = 0;
+		unsigned const num   = cursor.fill(segments, count);
+
+		/* skip empty segments */
+		if (!count) {
+			cursor.advance(0);
+			continue;
+		}
+
+		Vfs::file_size out_count = 0;
+
+		if (fd->flags & O_NONBLOCK) {
+
+			try {
+				out_result = handle->fs().writev(handle, segments, num, out_count);
+			} catch (Vfs::File_io_service::Insufficient_buffer) { }
+
+		} else {
+
+			struct Check : Libc::Suspend_functor
+			{
+				bool                  retry { false };
+
+				Vfs::Vfs_handle      *handle;
+				Vfs::Io_vector const *segments;
+				unsigned              num;
+				Vfs::file_size       &out_count;
+				Result               &out_result;
+
+				Check(Vfs::Vfs_handle *handle, Vfs::Io_vector const *segments,
+				      unsigned num, Vfs::file_size &out_count, Result &out_result)
+				: handle(handle), segments(segments), num(num),
+				  out_count(out_count), out_result(out_result)
+				{ }
+
+				bool suspend() override
+				{
+					try {
+						out_result = handle->fs().writev(handle, segments,
+						                                 num, out_count);
+						retry = false;
+					} catch (Vfs::File_io_service::Insufficient_buffer) {
+						retry = true;
+					}
+
+					return retry;
+				}
+			} check(handle, segments, num, out_count, out_result);
+
+			do {
+				Libc::suspend(check);
+			} while (check.retry);
+		}
+
+		if (out_result != Result::WRITE_OK)
+			break;
+
+		handle->advance_seek(out_count);
+		total += out_count;
+
+		/* a blocking write continues after a short write */
+		cursor.advance(out_count);
+
+		if (out_count < count && (fd->flags & O_NONBLOCK || !out_count))
+			break;
+	}
+
+	if (offset != -1)
+		handle->seek(saved_seek);
+
+	/* report an error only if nothing was written */
+	if (total)
+		return total;
+
+	switch (out_result) {
+	case Result::WRITE_ERR_AGAIN:       return Errno(EAGAIN);
+	case Result::WRITE_ERR_WOULD_BLOCK: return Errno(EWOULDBLOCK);
+	case Result::WRITE_ERR_INVALID:     return Errno(EINVAL);
+	case Result::WRITE_ERR_IO:          return Errno(EIO);
+	case Result::WRITE_ERR_INTERRUPT:   return Errno(EINTR);
+	case Result::WRITE_OK:              break;
+	}
+
+	return 0;
+}
+
+
+ssize_t Libc::Vfs_plugin::sendfile(Libc::File_descriptor *out_fd,
+                                   Libc::File_descriptor *in_fd,
+                                   ::off_t offset, ::size_t count)
+{
+	/* the source must be a VFS file, otherwise copy via a buffer */
+	if (in_fd->plugin != this)
+		return Errno(EOPNOTSUPP);
+
+	Libc::dispatch_pending_io_signals();
+
+	typedef Vfs::File_io_service::Read_result Result;
+
+	Vfs::Vfs_handle *from = vfs_handle(in_fd);
+	Vfs::Vfs_handle *to   = vfs_handle(out_fd);
+
+	Vfs::file_size const saved_seek = from->seek();
+	from->seek(offset);
+
+	{
+		struct Check : Libc::Suspend_functor
+		{
+			bool             retry { false };
+
+			Vfs::Vfs_handle *handle;
+			::size_t         count;
+
+			Check(Vfs::Vfs_handle *handle, ::size_t count)
+			: handle(handle), count(count) { }
+
+			bool suspend() override
+			{
+				retry = !handle->fs().queue_read(handle, count);
+				return retry;
+			}
+		} check ( from, count);
+
+		do {
+			Libc::suspend(check);
+		} while (check.retry);
+	}
+
+	Vfs::file_size out_count = 0;
+	Result         out_result;
+
+	{
+		struct Check : Libc::Suspend_functor
+		{
+			bool             retry { false };
+
+			Vfs::Vfs_handle *from;
+			Vfs::Vfs_handle *to;
+			::size_t         count;
+			Vfs::file_size  &out_count;
+			Result          &out_result;
+
+			Check(Vfs::Vfs_handle *from, Vfs::Vfs_handle *to, ::size_t count,
+			      Vfs::file_size &out_count, Result &out_result)
+			: from(from), to(to), count(count), out_count(out_count),
+			  out_result(out_result)
+			{ }
+
+			bool suspend() override
+			{
+				try {
+					out_result = from->fs().complete_copy(from, to, count, out_count);
+				} catch (Vfs::File_io_service::Insufficient_buffer) {
+					out_result = Result::READ_QUEUED;
+				}
+
+				/* suspend me if read is still queued or 'to' lacks buffer space */
+				retry = (out_result == Result::READ_QUEUED);
+
+				return retry;
+			}
+		} check ( from, to, count, out_count, out_result);
+
+		do {
+			Libc::suspend(check);
+		} while (check.retry);
+	}
+
+	from->seek(saved_seek);
+
+	switch (out_result) {
+	case Result::READ_ERR_AGAIN:       return Errno(EAGAIN);
+	case Result::READ_ERR_WOULD_BLOCK: return Errno(EWOULDBLOCK);
+	case Result::READ_ERR_INVALID:     return Errno(EOPNOTSUPP);
+	case Result::READ_ERR_IO:          return Errno(EIO);
+	case Result::READ_ERR_INTERRUPT:   return Errno(EINTR);
+	case Result::READ_OK:              break;
+
+	case Result::READ_QUEUED: /* handled above, so never reached */ break;
+	}
+
+	return out_count;
+}
+
+
 ssize_t Libc::Vfs_plugin::getdirentries(Libc::File_descriptor *fd, char *buf,
                                         ::size_t nbytes, ::off_t *basep)
 {
@@ -821,6 +1224,8 @@ int Libc::Vfs_plugin::ftruncate(Libc::File_descriptor *fd, ::off_t length)
 
 	typedef Vfs::File_io_service::Ftruncate_result Result;
 
+	_invalidate_stat(fd->fd_path);
+
 	switch (handle->fs().ftruncate(handle, length)) {
 	case Result::FTRUNCATE_ERR_NO_PERM:   errno = EPERM;  return -1;
 	case Result::FTRUNCATE_ERR_INTERRUPT: errno = EINTR;  return -1;
@@ -945,6 +1350,8 @@ int Libc::Vfs_plugin::symlink(const char *oldpath, const char *newpath)
 	_vfs_sync(handle);
 	handle->ds().close(handle);
 
+	_invalidate_stat(newpath);
+
 	if (out_count != count)
 		return Errno(ENAMETOOLONG);
 
@@ -1060,6 +1467,9 @@ ssize_t Libc::Vfs_plugin::readlink(const char *path, char *buf, ::size_t buf_siz
 
 int Libc::Vfs_plugin::rmdir(char const *path)
 {
+	/* cached results of nodes below the directory become stale */
+	_flush_stat_cache();
+
 	return unlink(path);
 }
 
@@ -1074,6 +1484,8 @@ int Libc::Vfs_plugin::unlink(char const *path)
 	case Result::UNLINK_ERR_NOT_EMPTY: errno = ENOTEMPTY; return -1;
 	case Result::UNLINK_OK:            break;
 	}
+
+	_invalidate_stat(path);
 	return 0;
 }
 
@@ -1106,6 +1518,9 @@ int Libc::Vfs_plugin::rename(char const *from_path, char const *to_path)
 	case Result::RENAME_ERR_NO_PERM:  errno = EPERM;  return -1;
 	case Result::RENAME_OK:                           break;
 	}
+
+	/* the renamed node may be a directory with cached nodes below */
+	_flush_stat_cache();
 	return 0;
 }
 
@@ -1113,22 +1528,62 @@ int Libc::Vfs_plugin::rename(char const *from_path, char const *to_path)
 void *Libc::Vfs_plugin::mmap(void *addr_in, ::size_t length, int prot, int flags,
                              Libc::File_descriptor *fd, ::off_t offset)
 {
-	if (prot != PROT_READ) {
+	if (prot & ~(PROT_READ | PROT_WRITE)) {
 		Genode::error("mmap for prot=", Genode::Hex(prot), " not supported");
 		errno = EACCES;
 		return (void *)-1;
 	}
 
-	if (addr_in != 0) {
-		Genode::error("mmap for predefined address not supported");
+	bool const fixed      = (flags & MAP_FIXED);
+	bool const writeable  = (prot & PROT_WRITE);
+	bool const shared     = (flags & MAP_SHARED);
+	bool const page_align = !(offset & ((1 << PAGE_SHIFT) - 1));
+
+	if (fixed && (!addr_in || ((Genode::addr_t)addr_in & ((1 << PAGE_SHIFT) - 1)))) {
 		errno = EINVAL;
 		return (void *)-1;
 	}
 
+	if (writeable && shared && (fd->flags & O_ACCMODE) == O_RDONLY) {
+		errno = EACCES;
+		return (void *)-1;
+	}
+
 	/*
-	 * XXX attempt to obtain memory mapping via
-	 *     'Vfs::Directory_service::dataspace'.
+	 * Attach the dataspace of the file if the file system provides one,
+	 * e.g., the device content of a block session or a ROM module
+	 *
+	 * A private writeable mapping must not modify the file and is therefore
+	 * backed by a copy. A shared writeable mapping requires a writeable
+	 * dataspace.
 	 */
+	if (fd->fd_path && page_align && !(writeable && !shared)) {
+
+		Vfs::Dataspace_capability const ds = _root_dir.dataspace(fd->fd_path);
+		if (ds.valid() && (!writeable || Genode::Dataspace_client(ds).writable())) {
+			try {
+				void *addr = fixed
+				           ? _rm.attach_at(ds, (Genode::addr_t)addr_in, length, offset)
+				           : _rm.attach(ds, length, offset);
+
+				Genode::Lock::Guard guard(_mappings_lock);
+				_mappings.insert(new (_alloc)
+					Mapping(addr, length, offset, ds, fd->fd_path, false));
+				return addr;
+			} catch (...) {
+				/* fall back to copying the file content */
+			}
+		}
+		if (ds.valid())
+			_root_dir.release(fd->fd_path, ds);
+	}
+
+	/* copies are placed by the libc allocator, a fixed address is a mere hint */
+	if (fixed) {
+		Genode::error("mmap at fixed address requires a file-system dataspace");
+		errno = EINVAL;
+		return (void *)-1;
+	}
 
 	void *addr = Libc::mem_alloc()->alloc(length, PAGE_SHIFT);
 	if (addr == (void *)-1) {
@@ -1138,22 +1593,136 @@ void *Libc::Vfs_plugin::mmap(void *addr_in, ::size_t length, int prot, int flags
 
 	if (::pread(fd->libc_fd, addr, length, offset) < 0) {
 		Genode::error("mmap could not obtain file content");
-		::munmap(addr, length);
+		Libc::mem_alloc()->free(addr);
 		errno = EACCES;
 		return (void *)-1;
 	}
 
+	if (writeable && shared) {
+		if (!fd->fd_path) {
+			Genode::error("mmap of shared writeable mapping without path");
+			Libc::mem_alloc()->free(addr);
+			errno = EINVAL;
+			return (void *)-1;
+		}
+
+		Genode::Lock::Guard guard(_mappings_lock);
+		_mappings.insert(new (_alloc)
+			Mapping(addr, length, offset, Vfs::Dataspace_capability(),
+			        fd->fd_path, true));
+	}
+
 	return addr;
 }
 
 
+int Libc::Vfs_plugin::_write_back(Mapping const &m, void *start, ::size_t len)
+{
+	Genode::addr_t const m_start = (Genode::addr_t)m.addr;
+	Genode::addr_t const m_end   = m_start + m.length;
+
+	/* clip range to mapping */
+	Genode::addr_t const from = Genode::max(m_start, (Genode::addr_t)start);
+	Genode::addr_t const to   = Genode::min(m_end, (Genode::addr_t)start + len);
+
+	if (from >= to)
+		return 0;
+
+	int const libc_fd = ::open(m.path.string(), O_WRONLY);
+	if (libc_fd < 0) {
+		Genode::error("msync could not open ", m.path);
+		return Errno(EIO);
+	}
+
+	::size_t const count = to - from;
+	ssize_t  const n     = ::pwrite(libc_fd, (void const *)from, count,
+	                                m.offset + (from - m_start));
+	::close(libc_fd);
+
+	if (n < 0 || (::size_t)n != count) {
+		Genode::error("msync could not write back ", m.path);
+		return Errno(EIO);
+	}
+	return 0;
+}
+
+
 int Libc::Vfs_plugin::munmap(void *addr, ::size_t)
 {
-	Libc::mem_alloc()->free(addr);
+	Mapping *mapping = nullptr;
+	{
+		Genode::Lock::Guard guard(_mappings_lock);
+
+		for (Mapping *m = _mappings.first(); m; m = m->next()) {
+			if (m->addr != addr)
+				continue;
+
+			_mappings.remove(m);
+			mapping = m;
+			break;
+		}
+	}
+
+	if (!mapping) {
+		Libc::mem_alloc()->free(addr);
+		return 0;
+	}
+
+	int result = 0;
+
+	if (mapping->attached()) {
+		_rm.detach(addr);
+		_root_dir.release(mapping->path.string(), mapping->ds);
+	} else {
+		result = _write_back(*mapping, mapping->addr, mapping->length);
+		Libc::mem_alloc()->free(addr);
+	}
+
+	destroy(_alloc, mapping);
+	return result;
+}
+
+
+int Libc::Vfs_plugin::msync(void *addr, ::size_t len, int)
+{
+	/*
+	 * Directly attached dataspaces are shared with the file system and
+	 * don't need to be written back. Hence, all 'msync' flags are handled
+	 * as 'MS_SYNC'.
+	 */
+	Genode::Lock::Guard guard(_mappings_lock);
+
+	for (Mapping *m = _mappings.first(); m; m = m->next())
+		if (m->write_back
+		 && (Genode::addr_t)addr <  (Genode::addr_t)m->addr + m->length
+		 && (Genode::addr_t)addr + len > (Genode::addr_t)m->addr)
+			return _write_back(*m, addr, len);
+
 	return 0;
 }
 
 
+bool Libc::Vfs_plugin::poll(Libc::File_descriptor &fdo, struct pollfd &pfd)
+{
+	Vfs::Vfs_handle *handle = vfs_handle(&fdo);
+	if (!handle) return false;
+
+	pfd.revents = 0;
+
+	if (pfd.events & POLLIN) {
+		if (handle->fs().read_ready(handle))
+			pfd.revents |= POLLIN;
+		else
+			Libc::notify_read_ready(handle);
+	}
+
+	if (pfd.events & POLLOUT)
+		pfd.revents |= POLLOUT; /* XXX always writeable */
+
+	return true;
+}
+
+
 bool Libc::Vfs_plugin::supports_select(int nfds,
                                        fd_set *readfds, fd_set *writefds, fd_set *exceptfds,
                                        struct timeval *timeout)
@@ -18,11 +18,14 @@
 
 /* Genode includes */
 #include <libc/component.h>
+#include <util/reconstructible.h>
 #include "task.h"
+#include "stat_cache.h"
 
 /* libc includes */
 #include <fcntl.h>
 #include <unistd.h>
+#include <sys/stat.h>
 
 /* libc plugin interface */
 #include <libc-plugin/plugin.h>
@@ -39,6 +42,116 @@ class Libc::Vfs_plugin : public Libc::Plugin
 
 		Vfs::File_system &_root_dir;
 
+		Genode::Region_map &_rm;
+
+		/**
+		 * File region mapped by 'mmap'
+		 *
+		 * The mapping either refers to a dataspace provided by the VFS that
+		 * is attached directly, or to a copy of the file content. The copy of
+		 * a writeable shared mapping is written back to the file by 'msync'
+		 * and 'munmap'.
+		 */
+		struct Mapping : Genode::List<Mapping>::Element
+		{
+			typedef Genode::String<Vfs::MAX_PATH_LEN> Path;
+
+			void                      * const addr;
+			::size_t                    const length;
+			::off_t                     const offset;
+			Vfs::Dataspace_capability const ds;
+			Path                        const path;
+			bool                        const write_back;
+
+			Mapping(void *addr, ::size_t length, ::off_t offset,
+			        Vfs::Dataspace_capability ds, char const *path,
+			        bool write_back)
+			:
+				addr(addr), length(length), offset(offset), ds(ds),
+				path(path), write_back(write_back)
+			{ }
+
+			bool attached() const { return ds.valid(); }
+		};
+
+		/**
+		 * Write back copied content of a shared mapping to its file
+		 */
+		int _write_back(Mapping const &, void *start, ::size_t len);
+
+		Genode::List<Mapping> _mappings;
+		Genode::Lock          _mappings_lock;
+
+		/**
+		 * Cache of stat results, enabled via the 'stat_cache' attribute
+		 */
+		Genode::Constructible<Stat_cache> _stat_cache { };
+
+		typedef Vfs::Directory_service::Stat        Stat;
+		typedef Vfs::Directory_service::Stat_result Stat_result;
+
+		bool _cached_stat(char const *path, Stat_result &result, Stat &stat)
+		{
+			return _stat_cache.constructed()
+			    && _stat_cache->lookup(path, result, stat);
+		}
+
+		Stat_result _stat(char const *path, Stat &stat)
+		{
+			Stat_result result;
+			if (_cached_stat(path, result, stat))
+				return result;
+
+			result = _root_dir.stat(path, stat);
+
+			if (_stat_cache.constructed())
+				_stat_cache->insert(path, result, stat);
+
+			return result;
+		}
+
+		bool _directory(char const *path)
+		{
+			Stat_result result;
+			Stat        stat;
+			if (_cached_stat(path, result, stat))
+				return result == Stat_result::STAT_OK
+				    && (stat.mode & S_IFMT) == Vfs::Directory_service::STAT_MODE_DIRECTORY;
+
+			return _root_dir.directory(path);
+		}
+
+		bool _known_missing(char const *path)
+		{
+			Stat_result result;
+			Stat        stat;
+			return _cached_stat(path, result, stat)
+			    && result == Stat_result::STAT_ERR_NO_ENTRY;
+		}
+
+		void _remember_missing(char const *path)
+		{
+			if (_stat_cache.constructed())
+				_stat_cache->insert(path, Stat_result::STAT_ERR_NO_ENTRY, Stat());
+		}
+
+		/**
+		 * Invalidate cached stat result of 'path'
+		 *
+		 * If 'path' is a null pointer, all cached results are invalidated.
+		 */
+		void _invalidate_stat(char const *path)
+		{
+			if (_stat_cache.constructed())
+				_stat_cache->invalidate(path);
+		}
+
+		void _flush_stat_cache()
+		{
+			if (_stat_cache.constructed())
+				_stat_cache->flush();
+		}
+
 		void _open_stdio(Genode::Xml_node const &node, char const *attr,
 		                 int libc_fd, unsigned flags)
 		{
@@ -138,7 +251,7 @@ class Libc::Vfs_plugin : public Libc::Plugin
 
 		Vfs_plugin(Libc::Env &env, Genode::Allocator &alloc)
 		:
-			_alloc(alloc), _root_dir(env.vfs())
+			_alloc(alloc), _root_dir(env.vfs()), _rm(env.rm())
 		{
 			using Genode::Xml_node;
 
@@ -147,6 +260,12 @@ class Libc::Vfs_plugin : public Libc::Plugin
 					try {
 						Xml_node const node = top.sub_node("libc");
 
+						unsigned const stat_cache_entries =
+							node.attribute_value("stat_cache", 0U);
+						if (stat_cache_entries)
+							_stat_cache.construct(_alloc, stat_cache_entries,
+							                      node.attribute_value("stat_cache_verbose", false));
+
 						try {
 							Genode::String<Vfs::MAX_PATH_LEN> path;
 							node.attribute("cwd").value(&path);
@@ -197,6 +316,8 @@ class Libc::Vfs_plugin : public Libc::Plugin
 		::off_t lseek(Libc::File_descriptor *fd, ::off_t offset, int whence) override;
 		int     mkdir(const char *, mode_t) override;
 		ssize_t read(Libc::File_descriptor *, void *, ::size_t) override;
+		ssize_t preadv(Libc::File_descriptor *, struct iovec const *, int, ::off_t) override;
+		ssize_t pwritev(Libc::File_descriptor *, struct iovec const *, int, ::off_t) override;
 		ssize_t readlink(const char *, char *, ::size_t) override;
 		int     rename(const char *, const char *) override;
 		int     rmdir(const char *) override;
@@ -204,8 +325,11 @@ class Libc::Vfs_plugin : public Libc::Plugin
 		int     symlink(const char *, const char *) override;
 		int     unlink(const char *) override;
 		ssize_t write(Libc::File_descriptor *, const void *, ::size_t ) override;
+		ssize_t sendfile(Libc::File_descriptor *, Libc::File_descriptor *, ::off_t, ::size_t) override;
 		void   *mmap(void *, ::size_t, int, int, Libc::File_descriptor *, ::off_t) override;
 		int     munmap(void *, ::size_t) override;
+		int     msync(void *, ::size_t, int) override;
+		bool    poll(Libc::File_descriptor &, struct pollfd &) override;
 		int     select(int nfds, fd_set *readfds, fd_set *writefds, fd_set *exceptfds, struct timeval *timeout) override;
 };
 
@@ -29,7 +29,9 @@
 #include <libc-plugin/plugin.h>
 #include <libc-plugin/fd_alloc.h>
 
+#include <base/attached_rom_dataspace.h>
 #include <fatfs/block.h>
+#include <fatfs/fast_seek.h>
 
 namespace Fatfs { extern "C" {
 #include <fatfs/ff.h>
@@ -89,7 +91,8 @@ class File_plugin_context : public Plugin_context
 {
 	private:
 
-		Fatfs::FIL _fatfs_file;
+		Fatfs::FIL       _fatfs_file;
+		Fatfs::Fast_seek _fast_seek;
 
 	public:
 
@@ -104,6 +107,14 @@ class File_plugin_context : public Plugin_context
 			Plugin_context(filename), _fatfs_file(fatfs_file) { }
 
 		Fatfs::FIL *fatfs_file() { return &_fatfs_file; }
+
+		void fast_seek(bool enable)
+		{
+			if (enable)
+				_fast_seek.enable(_fatfs_file);
+			else
+				_fast_seek.disable(_fatfs_file);
+		}
 };
 
 
@@ -147,6 +158,17 @@ class Plugin : public Libc::Plugin
 			return file_plugin_context->fatfs_file();
 		}
 
+		/**
+		 * Enter or leave the fast-seek mode of an open file
+		 */
+		void _fast_seek(Libc::File_descriptor *fd, bool enable)
+		{
+			File_plugin_context *file_plugin_context =
+				dynamic_cast<File_plugin_context*>(context(fd));
+			if (file_plugin_context)
+				file_plugin_context->fast_seek(enable);
+		}
+
 		Fatfs::DIR *_get_fatfs_dir(Libc::File_descriptor *fd)
 		{
 			Directory_plugin_context *directory_plugin_context =
@@ -179,7 +201,17 @@ class Plugin : public Libc::Plugin
 		{
 			_heap.construct(env.ram(), env.rm());
 
-			Fatfs::block_init(env, *_heap);
+			enum { DEFAULT_CACHE_SIZE = 512*1024 };
+
+			Genode::size_t cache_size = DEFAULT_CACHE_SIZE;
+			try {
+				Genode::Attached_rom_dataspace config(env, "config");
+				cache_size = config.xml().sub_node("libc")
+					.attribute_value("fatfs_cache_size",
+					                 Genode::Number_of_bytes(cache_size));
+			} catch (...) { }
+
+			Fatfs::block_init(env, *_heap, cache_size);
 
 			/* mount the file system */
 			if (verbose)
@@ -326,6 +358,8 @@ class Plugin : public Libc::Plugin
 
 			/* 'f_truncate()' truncates to the current seek pointer */
 
+			_fast_seek(fd, false);
+
 			if (lseek(fd, length, SEEK_SET) == -1)
 				return -1;
 
@@ -421,6 +455,10 @@ class Plugin : public Libc::Plugin
 					break;
 			}
 
+			/* seeking beyond the end of the file expands the file */
+			if (offset > (off_t)f_size(_get_fatfs_file(fd)))
+				_fast_seek(fd, false);
+
 			FRESULT res = f_lseek(_get_fatfs_file(fd), offset);
 
 			switch(res) {
@@ -627,6 +665,8 @@ class Plugin : public Libc::Plugin
 		{
 			using namespace Fatfs;
 
+			_fast_seek(fd, true);
+
 			UINT result;
 			FRESULT res = f_read(_get_fatfs_file(fd), buf, count, &result);
 
@@ -766,6 +806,8 @@ class Plugin : public Libc::Plugin
 		{
 			using namespace Fatfs;
 
+			_fast_seek(fd, false);
+
 			UINT result;
 			FRESULT res = f_write(_get_fatfs_file(fd), buf, count, &result);
 
@@ -16,7 +16,8 @@
 #include <base/env.h>
 #include <base/heap.h>
 #include <base/log.h>
-#include <os/ring_buffer.h>
+#include <base/attached_rom_dataspace.h>
+#include <base/semaphore.h>
 #include <util/misc_math.h>
 
 /* libc includes */
@@ -39,9 +40,9 @@ namespace Libc_pipe {
 	using namespace Genode;
 
 	enum Type { READ_END, WRITE_END };
-	enum { PIPE_BUF_SIZE = 4096 };
+	enum { DEFAULT_PIPE_BUF_SIZE = 64*1024 };
 
-	typedef Ring_buffer<unsigned char, PIPE_BUF_SIZE+1> Pipe_buffer;
+	class Pipe_buffer;
 
 	class Plugin_context : public Libc::Plugin_context
 	{
@@ -55,8 +56,6 @@ namespace Libc_pipe {
 
 			Pipe_buffer *_buffer;
 
-			Genode::Semaphore *_write_avail_sem;
-
 			bool _nonblock = false;
 
 		public:
@@ -68,16 +67,18 @@ namespace Libc_pipe {
 			 *                 read end or to the write end of the pipe
 			 *
 			 * \param partner  the other pipe end
+			 *
+			 * \param buffer_size  size of the pipe buffer, used by the
+			 *                     first end created only
 			 */
 			Plugin_context(Type type, Libc::File_descriptor *partner,
-			               Genode::Allocator &alloc);
+			               Genode::Allocator &alloc, Genode::size_t buffer_size);
 
 			~Plugin_context();
 
 			Type type() const                          { return _type; }
 			Pipe_buffer *buffer() const                { return _buffer; }
 			Libc::File_descriptor *partner() const     { return _partner; }
-			Genode::Semaphore *write_avail_sem() const { return _write_avail_sem; }
 			bool nonblock() const                      { return _nonblock; }
 
 			void set_partner(Libc::File_descriptor *partner) { _partner = partner; }
@@ -91,6 +92,8 @@ namespace Libc_pipe {
 
 			Genode::Constructible<Genode::Heap> _heap;
 
+			Genode::size_t _buffer_size = DEFAULT_PIPE_BUF_SIZE;
+
 		public:
 
 			/**
@@ -119,6 +122,162 @@ namespace Libc_pipe {
 	};
 
 
+	/**
+	 * Byte ring shared by both ends of a pipe
+	 *
+	 * Data is copied in bulk. A blocked reader is woken up once the
+	 * buffer is filled up to the low watermark, the buffer is full, or
+	 * the writer completed its write. A blocked writer is woken up once
+	 * the reader freed up half of the buffer or drained it.
+	 */
+	class Pipe_buffer
+	{
+		private:
+
+			Genode::Lock _lock;
+
+			Genode::Allocator &_alloc;
+
+			Genode::size_t  const _size;
+			unsigned char * const _buf;
+
+			Genode::size_t const _low_watermark = _size/4;
+
+			Genode::size_t _head = 0;
+			Genode::size_t _tail = 0;
+			Genode::size_t _used = 0;
+
+			bool _writer_gone = false;
+
+			bool              _reader_waiting = false;
+			bool              _writer_waiting = false;
+			Genode::Semaphore _read_avail_sem;
+			Genode::Semaphore _write_avail_sem;
+
+			void _wake_up_reader()
+			{
+				_reader_waiting = false;
+				_read_avail_sem.up();
+			}
+
+			void _wake_up_writer()
+			{
+				_writer_waiting = false;
+				_write_avail_sem.up();
+			}
+
+		public:
+
+			Pipe_buffer(Genode::Allocator &alloc, Genode::size_t size)
+			:
+				_alloc(alloc), _size(size),
+				_buf((unsigned char *)_alloc.alloc(_size))
+			{ }
+
+			~Pipe_buffer() { _alloc.free(_buf, _size); }
+
+			bool empty()
+			{
+				Genode::Lock::Guard guard(_lock);
+				return _used == 0;
+			}
+
+			Genode::size_t avail_capacity()
+			{
+				Genode::Lock::Guard guard(_lock);
+				return _size - _used;
+			}
+
+			void writer_close()
+			{
+				Genode::Lock::Guard guard(_lock);
+
+				_writer_gone = true;
+				if (_reader_waiting)
+					_wake_up_reader();
+			}
+
+			/**
+			 * Read at least one byte, block while the buffer is empty
+			 *
+			 * \return  number of bytes read, 0 if the writer is gone
+			 */
+			Genode::size_t read(unsigned char *dst, Genode::size_t count)
+			{
+				for (;;) {
+					{
+						Genode::Lock::Guard guard(_lock);
+
+						if (_used) {
+							Genode::size_t const n     = min(count, _used);
+							Genode::size_t const upper = min(n, _size - _tail);
+
+							Genode::memcpy(dst, _buf + _tail, upper);
+							Genode::memcpy(dst + upper, _buf, n - upper);
+
+							_tail  = (_tail + n) % _size;
+							_used -= n;
+
+							if (_writer_waiting
+							 && (_size - _used >= _size/2 || !_used))
+								_wake_up_writer();
+
+							return n;
+						}
+
+						if (_writer_gone)
+							return 0;
+
+						_reader_waiting = true;
+					}
+					_read_avail_sem.down();
+				}
+			}
+
+			/**
+			 * Write 'count' bytes, block while the buffer is full
+			 *
+			 * \param nonblock  return number of bytes written instead of
+			 *                  blocking
+			 * \param notify    function called before blocking
+			 */
+			template <typename FN>
+			Genode::size_t write(unsigned char const *src, Genode::size_t count,
+			             bool nonblock, FN const &notify)
+			{
+				Genode::size_t written = 0;
+
+				for (;;) {
+					{
+						Genode::Lock::Guard guard(_lock);
+
+						Genode::size_t const n     = min(count - written, _size - _used);
+						Genode::size_t const upper = min(n, _size - _head);
+
+						Genode::memcpy(_buf + _head, src + written, upper);
+						Genode::memcpy(_buf, src + written + upper, n - upper);
+
+						_head    = (_head + n) % _size;
+						_used   += n;
+						written += n;
+
+						if (_reader_waiting
+						 && (written == count || _used == _size
+						                      || _used >= _low_watermark))
+							_wake_up_reader();
+
+						if (written == count || nonblock)
+							return written;
+
+						_writer_waiting = true;
+					}
+					notify();
+					_write_avail_sem.down();
+				}
+			}
+	};
+
+
 	/***************
 	 ** Utilities **
 	 ***************/
@@ -146,22 +305,20 @@ namespace Libc_pipe {
 	 ********************/
 
 	Plugin_context::Plugin_context(Type type, Libc::File_descriptor *partner,
-	                               Genode::Allocator &alloc)
+	                               Genode::Allocator &alloc, Genode::size_t buffer_size)
 	: _type(type), _partner(partner), _alloc(alloc)
 	{
 		if (!_partner) {
 
 			/* allocate shared resources */
 
-			_buffer = new (_alloc) Pipe_buffer;
-			_write_avail_sem = new (_alloc) Genode::Semaphore(PIPE_BUF_SIZE);
+			_buffer = new (_alloc) Pipe_buffer(_alloc, buffer_size);
 
 		} else {
 
 			/* get shared resource pointers from partner */
 
-			_buffer     = context(_partner)->buffer();
-			_write_avail_sem = context(_partner)->write_avail_sem();
+			_buffer = context(_partner)->buffer();
 		}
 	}
 
@@ -177,7 +334,6 @@ namespace Libc_pipe {
 
 			/* partner fd is already destroyed -> free shared resources */
 			destroy(_alloc, _buffer);
-			destroy(_alloc, _write_avail_sem);
 		}
 	}
 
@@ -195,6 +351,16 @@ namespace Libc_pipe {
 	void Plugin::init(Genode::Env &env)
 	{
 		_heap.construct(env.ram(), env.rm());
+
+		try {
+			Genode::Attached_rom_dataspace config(env, "config");
+			_buffer_size = config.xml().sub_node("libc")
+				.attribute_value("pipe_buffer_size",
+				                 Genode::Number_of_bytes(_buffer_size));
+		} catch (...) { }
+
+		/* keep room for at least one page of data */
+		_buffer_size = Genode::max(_buffer_size, (Genode::size_t)4096);
 	}
 
 
@@ -233,6 +399,10 @@ namespace Libc_pipe {
 
 	int Plugin::close(Libc::File_descriptor *pipefdo)
 	{
+		/* unblock the reader, which gets end-of-file */
+		if (write_end(pipefdo))
+			context(pipefdo)->buffer()->writer_close();
+
 		Genode::destroy(*_heap, context(pipefdo));
 		Libc::file_descriptor_allocator()->free(pipefdo);
 
@@ -299,9 +469,11 @@ namespace Libc_pipe {
 	int Plugin::pipe(Libc::File_descriptor *pipefdo[2])
 	{
 		pipefdo[0] = Libc::file_descriptor_allocator()->alloc(this,
-		               new (*_heap) Plugin_context(READ_END, 0, *_heap));
+		               new (*_heap) Plugin_context(READ_END, 0, *_heap,
+		                                           _buffer_size));
 		pipefdo[1] = Libc::file_descriptor_allocator()->alloc(this,
-		               new (*_heap) Plugin_context(WRITE_END, pipefdo[0], *_heap));
+		               new (*_heap) Plugin_context(WRITE_END, pipefdo[0], *_heap,
+		                                           _buffer_size));
 		static_cast<Plugin_context *>(pipefdo[0]->context)->set_partner(pipefdo[1]);
 
 		return 0;
@@ -326,21 +498,7 @@ namespace Libc_pipe {
 
 		/* blocking mode, read at least one byte */
 
-		ssize_t num_bytes_read = 0;
-
-		do {
-
-			((unsigned char*)buf)[num_bytes_read] =
-				context(fdo)->buffer()->get();
-
-			num_bytes_read++;
-
-			context(fdo)->write_avail_sem()->up();
-
-		} while ((num_bytes_read < (ssize_t)count) &&
-		         !context(fdo)->buffer()->empty());
-
-		return num_bytes_read;
+		return context(fdo)->buffer()->read((unsigned char *)buf, count);
 	}
 
 
@@ -403,26 +561,15 @@ namespace Libc_pipe {
 			return -1;
 		}
 
-		::size_t num_bytes_written = 0;
-		while (num_bytes_written < count) {
-
-			if (context(fdo)->buffer()->avail_capacity() == 0) {
+		auto notify = [] () {
+			if (libc_select_notify)
+				libc_select_notify(); };
 
-				if (context(fdo)->nonblock())
-					return num_bytes_written;
-
-				if (libc_select_notify)
-					libc_select_notify();
-			}
-
-			context(fdo)->write_avail_sem()->down();
-		
-			context(fdo)->buffer()->add(((unsigned char*)buf)[num_bytes_written]);
-			num_bytes_written++;
-		}
+		::size_t const num_bytes_written =
+			context(fdo)->buffer()->write((unsigned char const *)buf, count,
+			                              context(fdo)->nonblock(), notify);
 
-		if (libc_select_notify)
-			libc_select_notify();
+		notify();
 
 		return num_bytes_written;
 	}
@@ -28,13 +28,15 @@ extern "C" {
 
 /* Genode includes */
 #include <base/thread.h>
+#include <base/lock.h>
 #include <base/log.h>
 #include <nic/packet_allocator.h>
 #include <nic_session/connection.h>
 
 extern "C" {
 
-	static void  genode_netif_input(struct netif *netif);
+	static bool  genode_netif_input(struct netif *netif);
+	static void  rx_pbuf_free(struct pbuf *p);
 
 	void lwip_nic_link_state_changed(int state);
 }
@@ -45,14 +47,60 @@ extern "C" {
  */
 class Nic_receiver_thread : public Genode::Thread_deprecated<8192>
 {
-	private:
+	public:
 
 		typedef Nic::Packet_descriptor Packet_descriptor;
 
+		/**
+		 * Custom pbuf that references the content of a received packet
+		 *
+		 * The packet is acknowledged not before lwIP freed the pbuf, which
+		 * happens in the tcpip thread or in an application thread after the
+		 * data was copied to the application.
+		 */
+		struct Rx_pbuf
+		{
+			struct pbuf_custom   custom; /* must be the first member */
+			Nic_receiver_thread *thread;
+			Packet_descriptor    packet;
+			Rx_pbuf             *next;
+		};
+
+	private:
+
 		Nic::Connection  *_nic;       /* nic-session */
 		Packet_descriptor _rx_packet; /* actual packet received */
 		struct netif     *_netif;     /* LwIP network interface structure */
 
+		/*
+		 * At most half of the packets that fit into the RX buffer are
+		 * referenced by pbufs, further packets are copied to keep the NIC
+		 * server able to deliver packets.
+		 */
+		unsigned const _num_rx_pbufs;
+		Rx_pbuf       *_rx_pbufs;
+		Rx_pbuf       *_free_rx_pbufs     = nullptr;
+		Rx_pbuf       *_released_rx_pbufs = nullptr;
+
+		/* synchronizes the acknowledgements of all threads */
+		Genode::Lock _rx_lock { };
+
+		/**
+		 * Acknowledge released packets, called with '_rx_lock' held
+		 */
+		void _ack_released_rx_pbufs()
+		{
+			while (_released_rx_pbufs && _nic->rx()->ready_to_ack()) {
+				Rx_pbuf *rx = _released_rx_pbufs;
+				_released_rx_pbufs = rx->next;
+
+				_nic->rx()->acknowledge_packet(rx->packet);
+
+				rx->next = _free_rx_pbufs;
+				_free_rx_pbufs = rx;
+			}
+		}
+
 		Genode::Signal_receiver  _sig_rec;
 
 		Genode::Io_signal_dispatcher<Nic_receiver_thread> _link_state_dispatcher;
@@ -61,9 +109,19 @@ class Nic_receiver_thread : public Genode::Thread_deprecated<8192>
 
 		void _handle_rx_packet_avail(unsigned)
 		{
+			{
+				Genode::Lock::Guard guard(_rx_lock);
+				_ack_released_rx_pbufs();
+			}
+
 			while (_nic->rx()->packet_avail() && _nic->rx()->ready_to_ack()) {
 				_rx_packet = _nic->rx()->get_packet();
-				genode_netif_input(_netif);
+
+				/* referenced packets are acknowledged by 'release_rx_pbuf' */
+				if (genode_netif_input(_netif))
+					continue;
+
+				Genode::Lock::Guard guard(_rx_lock);
 				_nic->rx()->acknowledge_packet(_rx_packet);
 			}
 		}
@@ -87,9 +145,12 @@ class Nic_receiver_thread : public Genode::Thread_deprecated<8192>
 
 	public:
 
-		Nic_receiver_thread(Nic::Connection *nic, struct netif *netif)
+		Nic_receiver_thread(Nic::Connection *nic, struct netif *netif,
+		                    Genode::size_t rx_buf_size)
 		:
 			Genode::Thread_deprecated<8192>("nic-recv"), _nic(nic), _netif(netif),
+			_num_rx_pbufs(rx_buf_size / Nic::Packet_allocator::DEFAULT_PACKET_SIZE / 2),
+			_rx_pbufs(new (Genode::env()->heap()) Rx_pbuf[_num_rx_pbufs]),
 			_link_state_dispatcher(_sig_rec, *this, &Nic_receiver_thread::_handle_link_state),
 			_rx_packet_avail_dispatcher(_sig_rec, *this, &Nic_receiver_thread::_handle_rx_packet_avail),
 			_rx_ready_to_ack_dispatcher(_sig_rec, *this, &Nic_receiver_thread::_handle_rx_read_to_ack)
@@ -97,12 +158,47 @@ class Nic_receiver_thread : public Genode::Thread_deprecated<8192>
 			_nic->link_state_sigh(_link_state_dispatcher);
 			_nic->rx_channel()->sigh_packet_avail(_rx_packet_avail_dispatcher);
 			_nic->rx_channel()->sigh_ready_to_ack(_rx_ready_to_ack_dispatcher);
+
+			for (unsigned i = 0; i < _num_rx_pbufs; i++) {
+				_rx_pbufs[i].custom.custom_free_function = rx_pbuf_free;
+				_rx_pbufs[i].thread = this;
+				_rx_pbufs[i].next   = _free_rx_pbufs;
+				_free_rx_pbufs      = &_rx_pbufs[i];
+			}
 		}
 
 		void entry();
 		Nic::Connection  *nic() { return _nic; };
 		Packet_descriptor rx_packet() { return _rx_packet; };
 
+		/**
+		 * Return pbuf for referencing the current packet, or nullptr
+		 */
+		Rx_pbuf *alloc_rx_pbuf()
+		{
+			Genode::Lock::Guard guard(_rx_lock);
+
+			Rx_pbuf *rx = _free_rx_pbufs;
+			if (rx) {
+				_free_rx_pbufs = rx->next;
+				rx->packet = _rx_packet;
+			}
+			return rx;
+		}
+
+		/**
+		 * Acknowledge the packet of a pbuf freed by lwIP
+		 */
+		void release_rx_pbuf(Rx_pbuf &rx)
+		{
+			Genode::Lock::Guard guard(_rx_lock);
+
+			rx.next = _released_rx_pbufs;
+			_released_rx_pbufs = &rx;
+
+			_ack_released_rx_pbufs();
+		}
+
 		Packet_descriptor alloc_tx_packet(Genode::size_t size)
 		{
 			while (true) {
@@ -180,16 +276,32 @@ extern "C" {
 	}
 
 
+	/**
+	 * Called by lwIP when a pbuf referencing a received packet is freed
+	 */
+	static void rx_pbuf_free(struct pbuf *p)
+	{
+		Nic_receiver_thread::Rx_pbuf *rx =
+			reinterpret_cast<Nic_receiver_thread::Rx_pbuf *>(p);
+
+		rx->thread->release_rx_pbuf(*rx);
+	}
+
+
 	/**
 	 * Should allocate a pbuf and transfer the bytes of the incoming
 	 * packet from the interface into the pbuf.
 	 *
+	 * If possible, the pbuf references the content of the packet instead
+	 * of holding a copy.
+	 *
 	 * @param netif the lwip network interface structure for this genode_netif
+	 * @param referenced set to true if the pbuf references the packet
 	 * @return a pbuf filled with the received packet (including MAC header)
 	 *         NULL on memory error
 	 */
 	static struct pbuf *
-	low_level_input(struct netif *netif)
+	low_level_input(struct netif *netif, bool &referenced)
 	{
 		Nic_receiver_thread   *th         = reinterpret_cast<Nic_receiver_thread*>(netif->state);
 		Nic::Connection       *nic        = th->nic();
@@ -197,10 +309,20 @@ extern "C" {
 		char                  *rx_content = nic->rx()->packet_content(rx_packet);
 		u16_t                  len        = rx_packet.size();
 
-#if ETH_PAD_SIZE
+#if !ETH_PAD_SIZE
+		Nic_receiver_thread::Rx_pbuf *rx = th->alloc_rx_pbuf();
+		if (rx) {
+			referenced = true;
+			LINK_STATS_INC(link.recv);
+			return pbuf_alloced_custom(PBUF_RAW, len, PBUF_REF, &rx->custom,
+			                           rx_content, len);
+		}
+#else
 		len += ETH_PAD_SIZE; /* allow room for Ethernet padding */
 #endif
 
+		referenced = false;
+
 		/* We allocate a pbuf chain of pbufs from the pool. */
 		struct pbuf *p = pbuf_alloc(PBUF_RAW, len, PBUF_POOL);
 		if (p) {
@@ -239,18 +361,21 @@ extern "C" {
 	 * the appropriate input function is called.
 	 *
 	 * @param netif the lwip network interface structure for this genode_netif
+	 * @return true if the packet is referenced by a pbuf, which acknowledges
+	 *         the packet when freed
 	 */
-	static void
+	static bool
 	genode_netif_input(struct netif *netif)
 	{
 		/*
 		 * Move received packet into a new pbuf,
 		 * if something went wrong, return silently
 		 */
-		struct pbuf *p = low_level_input(netif);
+		bool referenced = false;
+		struct pbuf *p = low_level_input(netif, referenced);
 
 		/* No packet could be read, silently ignore this */
-		if (p == NULL) return;
+		if (p == NULL) return false;
 
 		if (netif->input(p, netif) != ERR_OK) {
 			if (verbose)
@@ -258,6 +383,7 @@ extern "C" {
 			pbuf_free(p);
 			p = 0;
 		}
+		return referenced;
 	}
 
 
@@ -296,7 +422,7 @@ extern "C" {
 
 		/* Setup receiver thread */
 		Nic_receiver_thread *th = new (env()->heap())
-			Nic_receiver_thread(nic, netif);
+			Nic_receiver_thread(nic, netif, nbs->rx_buf_size);
 
 		/* Store receiver thread address in user-defined netif struct part */
 		netif->state      = (void*) th;
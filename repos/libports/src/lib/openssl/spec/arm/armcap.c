@@ -0,0 +1,62 @@
+/*
+ * \brief  ARM CPU capabilities of libcrypto
+ * \author Genode Labs
+ * \date   2026-10-14
+ *
+ * Replacement of OpenSSL's 'crypto/armcap.c', which probes for NEON by
+ * executing a NEON instruction and catching SIGILL. Genode's libc does not
+ * deliver SIGILL. Hence, NEON support is assumed if the code is compiled
+ * for a NEON-enabled platform. The 'OPENSSL_armcap' environment variable
+ * overrides the capabilities.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#include <stdlib.h>
+#include <openssl/crypto.h>
+
+#include "arm_arch.h"
+
+unsigned int OPENSSL_armcap_P;
+
+/*
+ * The generic timer is not necessarily accessible from user level. So,
+ * 'ARMV7_TICK' is never set by default and the instrumentation based on
+ * the time-stamp counter is disabled.
+ */
+unsigned int _armv7_tick(void);
+
+unsigned int OPENSSL_rdtsc(void)
+{
+	if (OPENSSL_armcap_P & ARMV7_TICK)
+		return _armv7_tick();
+
+	return 0;
+}
+
+void OPENSSL_cpuid_setup(void) __attribute__((constructor));
+
+void OPENSSL_cpuid_setup(void)
+{
+	static int trigger = 0;
+	char const *e;
+
+	if (trigger) return;
+	trigger = 1;
+
+	if ((e = getenv("OPENSSL_armcap"))) {
+		OPENSSL_armcap_P = strtoul(e, NULL, 0);
+		return;
+	}
+
+#if defined(__ARM_NEON__)
+	OPENSSL_armcap_P = ARMV7_NEON;
+#else
+	OPENSSL_armcap_P = 0;
+#endif
+}
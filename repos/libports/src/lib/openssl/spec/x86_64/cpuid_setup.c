@@ -0,0 +1,25 @@
+/*
+ * \brief  Probe CPU capabilities at load time of libcrypto
+ * \author Genode Labs
+ * \date   2026-10-14
+ *
+ * OpenSSL's x86_64cpuid code calls 'OPENSSL_cpuid_setup' from the '.init'
+ * section, which is not executed by Genode's dynamic linker. Without the
+ * setup, 'OPENSSL_ia32cap_P' remains zero and the AES-NI, SSSE3, and
+ * PCLMULQDQ code paths stay unused.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+void OPENSSL_cpuid_setup(void);
+
+static void __attribute__((constructor)) genode_cpuid_setup(void)
+{
+	/* the capabilities can be overridden via 'OPENSSL_ia32cap' */
+	OPENSSL_cpuid_setup();
+}
@@ -13,8 +13,10 @@
  */
 
 #include <base/log.h>
-#include <base/semaphore.h>
+#include <os/timed_semaphore.h>
+#include <errno.h>
 #include <semaphore.h>
+#include "thread.h"
 
 using namespace Genode;
 
@@ -24,9 +26,9 @@ extern "C" {
 	 * This class is named 'struct sem' because the 'sem_t' type is
 	 * defined as 'struct sem*' in 'semaphore.h'
 	 */
-	struct sem : Semaphore
+	struct sem : Timed_semaphore
 	{
-		sem(int value) : Semaphore(value) { }
+		sem(int value) : Timed_semaphore(value) { }
 	};
 
 
@@ -72,17 +74,39 @@ extern "C" {
 	}
 
 
-	int sem_timedwait(sem_t * __restrict, const struct timespec * __restrict)
+	int sem_timedwait(sem_t * __restrict sem, const struct timespec * __restrict abstime)
 	{
-		warning(__func__, " not implemented");
-		return -1;
+		if (!abstime || abstime->tv_nsec < 0 || abstime->tv_nsec >= 1000*1000*1000) {
+			errno = EINVAL;
+			return -1;
+		}
+
+		struct timespec currtime;
+		clock_gettime(CLOCK_REALTIME, &currtime);
+
+		try {
+			(*sem)->down(timeout_ms(currtime, *abstime));
+		} catch (Timeout_exception) {
+			errno = ETIMEDOUT;
+			return -1;
+		} catch (Nonblocking_exception) {
+			errno = ETIMEDOUT;
+			return -1;
+		}
+		return 0;
 	}
 
 
-	int sem_trywait(sem_t *)
+	int sem_trywait(sem_t *sem)
 	{
-		warning(__func__, " not implemented");
-		return -1;
+		/* a zero timeout does not block */
+		try {
+			(*sem)->down(0);
+		} catch (Nonblocking_exception) {
+			errno = EAGAIN;
+			return -1;
+		}
+		return 0;
 	}
 
 
@@ -14,7 +14,10 @@
 
 #include <base/log.h>
 #include <base/thread.h>
+#include <cpu/atomic.h>
+#include <cpu/memory_barrier.h>
 #include <os/timed_semaphore.h>
+#include <util/fifo.h>
 #include <util/list.h>
 
 #include <errno.h>
@@ -275,15 +278,69 @@ extern "C" {
 	};
 
 
+	/*
+	 * Mutex with a lock-free fast path
+	 *
+	 * Acquiring an uncontended mutex is a single atomic operation. A
+	 * contended mutex is polled for a short while before the caller blocks,
+	 * which avoids the blocking for short critical sections. A thread is
+	 * woken up on unlock only if the mutex was marked as contended.
+	 */
+	struct Fast_mutex
+	{
+		enum State { UNLOCKED = 0, LOCKED = 1, CONTENDED = 2 };
+
+		enum { SPIN_ROUNDS = 100 };
+
+		int volatile _state = UNLOCKED;
+
+		/* wakeup token for blocked threads */
+		Semaphore _wakeup { 0 };
+
+		int _exchange(int value)
+		{
+			for (;;) {
+				int const old = _state;
+				if (cmpxchg(&_state, old, value))
+					return old;
+			}
+		}
+
+		bool try_lock() { return cmpxchg(&_state, UNLOCKED, LOCKED); }
+
+		void lock()
+		{
+			for (unsigned i = 0; i < SPIN_ROUNDS; i++) {
+				if (_state == UNLOCKED && try_lock())
+					return;
+				memory_barrier();
+			}
+
+			/*
+			 * Mark the mutex as contended and block. A woken-up thread
+			 * competes with others, hence it re-marks the mutex as contended.
+			 */
+			while (_exchange(CONTENDED) != UNLOCKED)
+				_wakeup.down();
+		}
+
+		void unlock()
+		{
+			if (_exchange(UNLOCKED) == CONTENDED)
+				_wakeup.up();
+		}
+	};
+
+
 	struct pthread_mutex
 	{
 		pthread_mutex_attr mutexattr;
 
-		Lock mutex_lock;
+		Fast_mutex mutex;
 
-		pthread_t owner;
-		int       lock_count;
-		Lock      owner_and_counter_lock;
+		/* used by recursive and error-checking mutexes only */
+		pthread_t volatile owner;
+		int                lock_count;
 
 		pthread_mutex(const pthread_mutexattr_t *__restrict attr)
 		: owner(0),
@@ -297,45 +354,30 @@ extern "C" {
 		{
 			if (mutexattr.type == PTHREAD_MUTEX_RECURSIVE) {
 
-				Lock::Guard lock_guard(owner_and_counter_lock);
-
-				if (lock_count == 0) {
-					owner = pthread_self();
+				/* only the owner itself can observe being the owner */
+				if (owner == pthread_self()) {
 					lock_count++;
-					mutex_lock.lock();
 					return 0;
 				}
 
-				/* the mutex is already locked */
-				if (pthread_self() == owner) {
-					lock_count++;
-					return 0;
-				} else {
-					mutex_lock.lock();
-					return 0;
-				}
+				mutex.lock();
+				owner      = pthread_self();
+				lock_count = 1;
+				return 0;
 			}
 
 			if (mutexattr.type == PTHREAD_MUTEX_ERRORCHECK) {
 
-				Lock::Guard lock_guard(owner_and_counter_lock);
-
-				if (lock_count == 0) {
-					owner = pthread_self();
-					mutex_lock.lock();
-					return 0;
-				}
-
-				/* the mutex is already locked */
-				if (pthread_self() != owner) {
-					mutex_lock.lock();
-					return 0;
-				} else
+				if (owner == pthread_self())
 					return EDEADLK;
+
+				mutex.lock();
+				owner = pthread_self();
+				return 0;
 			}
 
 			/* PTHREAD_MUTEX_NORMAL or PTHREAD_MUTEX_DEFAULT */
-			mutex_lock.lock();
+			mutex.lock();
 			return 0;
 		}
 
@@ -343,87 +385,61 @@ extern "C" {
 		{
 			if (mutexattr.type == PTHREAD_MUTEX_RECURSIVE) {
 
-				Lock::Guard lock_guard(owner_and_counter_lock);
-
-				if (lock_count == 0) {
-					owner = pthread_self();
+				if (owner == pthread_self()) {
 					lock_count++;
-					mutex_lock.lock();
 					return 0;
 				}
 
-				/* the mutex is already locked */
-				if (pthread_self() == owner) {
-					lock_count++;
-					return 0;
-				} else {
+				if (!mutex.try_lock())
 					return EBUSY;
-				}
+
+				owner      = pthread_self();
+				lock_count = 1;
+				return 0;
 			}
 
 			if (mutexattr.type == PTHREAD_MUTEX_ERRORCHECK) {
 
-				Lock::Guard lock_guard(owner_and_counter_lock);
-
-				if (lock_count == 0) {
-					owner = pthread_self();
-					mutex_lock.lock();
-					return 0;
-				}
-
-				/* the mutex is already locked */
-				if (pthread_self() != owner) {
-					return EBUSY;
-				} else
+				if (owner == pthread_self())
 					return EDEADLK;
-			}
 
-			/* PTHREAD_MUTEX_NORMAL or PTHREAD_MUTEX_DEFAULT */
-			Lock::Guard lock_guard(owner_and_counter_lock);
+				if (!mutex.try_lock())
+					return EBUSY;
 
-			if (lock_count == 0) {
 				owner = pthread_self();
-				mutex_lock.lock();
 				return 0;
 			}
 
-			return EBUSY;
+			/* PTHREAD_MUTEX_NORMAL or PTHREAD_MUTEX_DEFAULT */
+			return mutex.try_lock() ? 0 : EBUSY;
 		}
 
 		int unlock()
 		{
-
 			if (mutexattr.type == PTHREAD_MUTEX_RECURSIVE) {
 
-				Lock::Guard lock_guard(owner_and_counter_lock);
-
-				if (pthread_self() != owner)
+				if (owner != pthread_self())
 					return EPERM;
 
-				lock_count--;
-
-				if (lock_count == 0) {
+				if (--lock_count == 0) {
 					owner = 0;
-					mutex_lock.unlock();
+					mutex.unlock();
 				}
-
 				return 0;
 			}
 
 			if (mutexattr.type == PTHREAD_MUTEX_ERRORCHECK) {
 
-				Lock::Guard lock_guard(owner_and_counter_lock);
-
-				if (pthread_self() != owner)
+				if (owner != pthread_self())
 					return EPERM;
 
 				owner = 0;
-				mutex_lock.unlock();
+				mutex.unlock();
 				return 0;
 			}
 
 			/* PTHREAD_MUTEX_NORMAL or PTHREAD_MUTEX_DEFAULT */
-			mutex_lock.unlock();
+			mutex.unlock();
 			return 0;
 		}
 	};
@@ -531,19 +547,37 @@ extern "C" {
 
 
 	/*
-	 * Implementation based on
-	 * http://web.archive.org/web/20010914175514/http://www-classic.be.com/aboutbe/benewsletter/volume_III/Issue40.html#Workshop
+	 * Each waiting thread enqueues a waiter object with a semaphore of its
+	 * own. A signal dequeues and wakes exactly one waiter. In contrast to a
+	 * single shared semaphore, neither a signalling thread has to wait for a
+	 * handshake with the woken-up thread nor are waiters woken up in vain.
 	 */
-
 	struct pthread_cond
 	{
-		int num_waiters;
-		int num_signallers;
-		Lock counter_lock;
-		Timed_semaphore signal_sem;
-		Semaphore handshake_sem;
+		struct Waiter : Fifo<Waiter>::Element
+		{
+			Timed_semaphore sem { 0 };
+			bool            signalled = false;
+		};
+
+		Lock         lock;
+		Fifo<Waiter> waiters;
+
+		/**
+		 * Wake up the first waiter, called with 'lock' held
+		 *
+		 * \return false if no thread is waiting
+		 */
+		bool wake_one()
+		{
+			Waiter *w = waiters.dequeue();
+			if (!w)
+				return false;
 
-		pthread_cond() : num_waiters(0), num_signallers(0) { }
+			w->signalled = true;
+			w->sem.up();
+			return true;
+		}
 	};
 
 
@@ -605,47 +639,6 @@ extern "C" {
 	}
 
 
-	static uint64_t timeout_ms(struct timespec currtime,
-	                           struct timespec abstimeout)
-	{
-		enum { S_IN_MS = 1000, S_IN_NS = 1000 * 1000 * 1000 };
-
-		if (currtime.tv_nsec >= S_IN_NS) {
-			currtime.tv_sec  += currtime.tv_nsec / S_IN_NS;
-			currtime.tv_nsec  = currtime.tv_nsec % S_IN_NS;
-		}
-		if (abstimeout.tv_nsec >= S_IN_NS) {
-			abstimeout.tv_sec  += abstimeout.tv_nsec / S_IN_NS;
-			abstimeout.tv_nsec  = abstimeout.tv_nsec % S_IN_NS;
-		}
-
-		/* check whether absolute timeout is in the past */
-		if (currtime.tv_sec > abstimeout.tv_sec)
-			return 0;
-
-		uint64_t diff_ms = (abstimeout.tv_sec - currtime.tv_sec) * S_IN_MS;
-		uint64_t diff_ns = 0;
-
-		if (abstimeout.tv_nsec >= currtime.tv_nsec)
-			diff_ns = abstimeout.tv_nsec - currtime.tv_nsec;
-		else {
-			/* check whether absolute timeout is in the past */
-			if (diff_ms == 0)
-				return 0;
-			diff_ns  = S_IN_NS - currtime.tv_nsec + abstimeout.tv_nsec;
-			diff_ms -= S_IN_MS;
-		}
-
-		diff_ms += diff_ns / 1000 / 1000;
-
-		/* if there is any diff then let the timeout be at least 1 MS */
-		if (diff_ms == 0 && diff_ns != 0)
-			return 1;
-
-		return diff_ms;
-	}
-
-
 	int pthread_cond_timedwait(pthread_cond_t *__restrict cond,
 	                           pthread_mutex_t *__restrict mutex,
 	                           const struct timespec *__restrict abstime)
@@ -657,14 +650,17 @@ extern "C" {
 
 		pthread_cond *c = *cond;
 
-		c->counter_lock.lock();
-		c->num_waiters++;
-		c->counter_lock.unlock();
+		pthread_cond::Waiter waiter;
+
+		/* enqueue before releasing the mutex to not miss a signal */
+		c->lock.lock();
+		c->waiters.enqueue(&waiter);
+		c->lock.unlock();
 
 		pthread_mutex_unlock(mutex);
 
 		if (!abstime)
-			c->signal_sem.down();
+			waiter.sem.down();
 		else {
 			struct timespec currtime;
 			clock_gettime(CLOCK_REALTIME, &currtime);
@@ -672,24 +668,25 @@ extern "C" {
 			Alarm::Time timeout = timeout_ms(currtime, *abstime);
 
 			try {
-				c->signal_sem.down(timeout);
+				waiter.sem.down(timeout);
 			} catch (Timeout_exception) {
 				result = ETIMEDOUT;
 			} catch (Genode::Nonblocking_exception) {
-				errno  = ETIMEDOUT;
 				result = ETIMEDOUT;
 			}
-		}
 
-		c->counter_lock.lock();
-		if (c->num_signallers > 0) {
-			if (result == ETIMEDOUT) /* timeout occured */
-				c->signal_sem.down();
-			c->handshake_sem.up();
-			--c->num_signallers;
+			/*
+			 * A signal may have raced with the timeout, in which case the
+			 * waiter was already dequeued and the signal is consumed.
+			 */
+			if (result == ETIMEDOUT) {
+				Lock::Guard guard(c->lock);
+				if (waiter.signalled)
+					result = 0;
+				else
+					c->waiters.remove(&waiter);
+			}
 		}
-		c->num_waiters--;
-		c->counter_lock.unlock();
 
 		pthread_mutex_lock(mutex);
 
@@ -711,16 +708,10 @@ extern "C" {
 
 		pthread_cond *c = *cond;
 
-		c->counter_lock.lock();
-		if (c->num_waiters > c->num_signallers) {
-		  ++c->num_signallers;
-		  c->signal_sem.up();
-		  c->counter_lock.unlock();
-		  c->handshake_sem.down();
-		} else
-		  c->counter_lock.unlock();
+		Lock::Guard guard(c->lock);
+		c->wake_one();
 
-	   return 0;
+		return 0;
 	}
 
 
@@ -731,17 +722,8 @@ extern "C" {
 
 		pthread_cond *c = *cond;
 
-		c->counter_lock.lock();
-		if (c->num_waiters > c->num_signallers) {
-			int still_waiting = c->num_waiters - c->num_signallers;
-			c->num_signallers = c->num_waiters;
-			for (int i = 0; i < still_waiting; i++)
-				c->signal_sem.up();
-			c->counter_lock.unlock();
-			for (int i = 0; i < still_waiting; i++)
-				c->handshake_sem.down();
-		} else
-			c->counter_lock.unlock();
+		Lock::Guard guard(c->lock);
+		while (c->wake_one());
 
 		return 0;
 	}
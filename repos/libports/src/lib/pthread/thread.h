@@ -17,6 +17,8 @@
 #define _INCLUDE__SRC_LIB_PTHREAD_THREAD_H_
 
 #include <pthread.h>
+#include <stdint.h>
+#include <time.h>
 
 /*
  * Used by 'pthread_self()' to find out if the current thread is an alien
@@ -43,6 +45,50 @@ class Pthread_registry
 Pthread_registry &pthread_registry();
 
 
+/**
+ * Return milliseconds from 'currtime' until the absolute timeout
+ */
+static inline uint64_t timeout_ms(struct timespec currtime,
+                                  struct timespec abstimeout)
+{
+	enum { S_IN_MS = 1000, S_IN_NS = 1000 * 1000 * 1000 };
+
+	if (currtime.tv_nsec >= S_IN_NS) {
+		currtime.tv_sec  += currtime.tv_nsec / S_IN_NS;
+		currtime.tv_nsec  = currtime.tv_nsec % S_IN_NS;
+	}
+	if (abstimeout.tv_nsec >= S_IN_NS) {
+		abstimeout.tv_sec  += abstimeout.tv_nsec / S_IN_NS;
+		abstimeout.tv_nsec  = abstimeout.tv_nsec % S_IN_NS;
+	}
+
+	/* check whether absolute timeout is in the past */
+	if (currtime.tv_sec > abstimeout.tv_sec)
+		return 0;
+
+	uint64_t diff_ms = (abstimeout.tv_sec - currtime.tv_sec) * S_IN_MS;
+	uint64_t diff_ns = 0;
+
+	if (abstimeout.tv_nsec >= currtime.tv_nsec)
+		diff_ns = abstimeout.tv_nsec - currtime.tv_nsec;
+	else {
+		/* check whether absolute timeout is in the past */
+		if (diff_ms == 0)
+			return 0;
+		diff_ns  = S_IN_NS - currtime.tv_nsec + abstimeout.tv_nsec;
+		diff_ms -= S_IN_MS;
+	}
+
+	diff_ms += diff_ns / 1000 / 1000;
+
+	/* if there is any diff then let the timeout be at least 1 MS */
+	if (diff_ms == 0 && diff_ns != 0)
+		return 1;
+
+	return diff_ms;
+}
+
+
 extern "C" {
 
 	struct pthread_attr
@@ -101,6 +101,34 @@ struct Completion : Usb::Completion
 };
 
 
+/**
+ * Isochronous endpoint
+ *
+ * Qemu expects isochronous packets to be completed synchronously. One Usb
+ * session packet carries 'FRAMES' frames. IN frames are read ahead by up to
+ * 'PACKETS' session packets and OUT frames are collected until a session
+ * packet is full.
+ */
+struct Isoc_endpoint
+{
+	enum { FRAMES = 8, PACKETS = 4 };
+
+	uint8_t  address    = 0; /* endpoint address, 0 if unused */
+	unsigned frame_size = 0;
+	unsigned in_flight  = 0;
+
+	/* completed IN packets */
+	Usb::Packet_descriptor ready[PACKETS];
+	unsigned               ready_head  = 0;
+	unsigned               ready_count = 0;
+	unsigned               frame       = 0; /* next frame of head packet */
+
+	/* OUT packet being filled */
+	Usb::Packet_descriptor out;
+	bool                   out_valid = false;
+};
+
+
 /**
  * Helper for the formatted output and device info
  */
@@ -146,6 +174,7 @@ struct Usb_host_device : List<Usb_host_device>::Element
 
 	USBHostDevice  *qemu_dev;
 	Completion      completion[Usb::Session::TX_QUEUE_SIZE];
+	Isoc_endpoint   isoc_ep[32];
 
 	Signal_receiver  &sig_rec;
 	Signal_dispatcher<Usb_host_device> state_dispatcher { sig_rec, *this, &Usb_host_device::state_change };
@@ -228,12 +257,180 @@ struct Usb_host_device : List<Usb_host_device>::Element
 		while (usb_raw.source()->ack_avail()) {
 			Usb::Packet_descriptor packet = usb_raw.source()->get_acked_packet();
 
+			if (packet.type == Usb::Packet_descriptor::ISOC) {
+				_isoc_complete(packet);
+				continue;
+			}
+
 			char *packet_content = usb_raw.source()->packet_content(packet);
 			dynamic_cast<Completion *>(packet.completion)->complete(packet, packet_content);
 			free_packet(packet);
 		}
 	}
 
+	/************************
+	 ** Isochronous frames **
+	 ************************/
+
+	Isoc_endpoint &_isoc_endpoint(uint8_t address) {
+		return isoc_ep[(address & 0xf) | ((address & USB_DIR_IN) ? 0x10 : 0)]; }
+
+	Usb::Isoc_transfer &_isoc_content(Usb::Packet_descriptor &packet) {
+		return *(Usb::Isoc_transfer *)usb_raw.source()->packet_content(packet); }
+
+	void _isoc_complete(Usb::Packet_descriptor &packet)
+	{
+		Isoc_endpoint &ep = _isoc_endpoint(packet.transfer.ep);
+
+		if (ep.in_flight)
+			ep.in_flight--;
+
+		bool const in = packet.transfer.ep & USB_DIR_IN;
+
+		/* keep IN frames until the guest polls for them */
+		if (in && packet.succeded && ep.address == packet.transfer.ep
+		 && ep.ready_count < Isoc_endpoint::PACKETS) {
+			ep.ready[(ep.ready_head + ep.ready_count++) % Isoc_endpoint::PACKETS] = packet;
+			return;
+		}
+
+		free_packet(packet);
+	}
+
+	/**
+	 * Submit isochronous packets until the read ahead is complete
+	 */
+	void _isoc_read_ahead(Isoc_endpoint &ep)
+	{
+		size_t const data_size = Isoc_endpoint::FRAMES * ep.frame_size;
+
+		while (ep.in_flight + ep.ready_count < Isoc_endpoint::PACKETS) {
+
+			Usb::Packet_descriptor packet;
+			try { packet = alloc_packet(Usb::Isoc_transfer::size(data_size)); }
+			catch (...) { return; }
+
+			if (!packet.completion) {
+				usb_raw.source()->release_packet(packet);
+				return;
+			}
+
+			Usb::Isoc_transfer &isoc = _isoc_content(packet);
+			isoc.number_of_packets = Isoc_endpoint::FRAMES;
+			for (unsigned i = 0; i < Isoc_endpoint::FRAMES; i++)
+				isoc.packet_size[i] = ep.frame_size;
+
+			packet.type                      = Usb::Packet_descriptor::ISOC;
+			packet.transfer.ep               = ep.address;
+			packet.transfer.polling_interval = Usb::Packet_descriptor::DEFAULT_POLLING_INTERVAL;
+
+			submit(packet);
+			ep.in_flight++;
+		}
+	}
+
+	void _isoc_in(Isoc_endpoint &ep, USBPacket *p)
+	{
+		_isoc_read_ahead(ep);
+
+		/* report an empty frame if no data is available yet */
+		if (!ep.ready_count)
+			return;
+
+		Usb::Packet_descriptor &packet = ep.ready[ep.ready_head];
+		Usb::Isoc_transfer     &isoc   = _isoc_content(packet);
+
+		size_t const size = min((size_t)isoc.actual_packet_size[ep.frame],
+		                        p->iov.size);
+		usb_packet_copy(p, isoc.data() + isoc.frame_offset(ep.frame), size);
+
+		if (++ep.frame < isoc.number_of_packets)
+			return;
+
+		free_packet(packet);
+		ep.ready_head = (ep.ready_head + 1) % Isoc_endpoint::PACKETS;
+		ep.ready_count--;
+		ep.frame = 0;
+
+		_isoc_read_ahead(ep);
+	}
+
+	void _isoc_out(Isoc_endpoint &ep, USBPacket *p)
+	{
+		if (!ep.out_valid) {
+			size_t const data_size = Isoc_endpoint::FRAMES * ep.frame_size;
+
+			try { ep.out = alloc_packet(Usb::Isoc_transfer::size(data_size)); }
+			catch (...) { return; }
+
+			if (!ep.out.completion) {
+				usb_raw.source()->release_packet(ep.out);
+				return;
+			}
+
+			ep.out_valid = true;
+			_isoc_content(ep.out).number_of_packets = 0;
+		}
+
+		Usb::Isoc_transfer &isoc = _isoc_content(ep.out);
+
+		unsigned const frame = isoc.number_of_packets++;
+		size_t   const size  = min((size_t)ep.frame_size, p->iov.size);
+
+		usb_packet_copy(p, isoc.data() + isoc.frame_offset(frame), size);
+		isoc.packet_size[frame] = size;
+
+		if (isoc.number_of_packets < Isoc_endpoint::FRAMES)
+			return;
+
+		ep.out.type                      = Usb::Packet_descriptor::ISOC;
+		ep.out.transfer.ep               = ep.address;
+		ep.out.transfer.polling_interval = Usb::Packet_descriptor::DEFAULT_POLLING_INTERVAL;
+
+		submit(ep.out);
+		ep.in_flight++;
+		ep.out_valid = false;
+	}
+
+	/**
+	 * Handle isochronous packet of the guest
+	 */
+	void isoc_data(USBDevice *udev, USBPacket *p)
+	{
+		bool    const in      = p->pid == USB_TOKEN_IN;
+		uint8_t const address = p->ep->nr | (in ? USB_DIR_IN : 0);
+
+		Isoc_endpoint &ep = _isoc_endpoint(address);
+		ep.address    = address;
+		ep.frame_size = usb_ep_get_max_packet_size(udev, p->pid, p->ep->nr);
+
+		if (in) _isoc_in(ep, p);
+		else    _isoc_out(ep, p);
+
+		p->status = USB_RET_SUCCESS;
+	}
+
+	/**
+	 * Drop buffered isochronous frames, e.g., on a change of the alt setting
+	 */
+	void isoc_reset()
+	{
+		for (Isoc_endpoint &ep : isoc_ep) {
+			while (ep.ready_count) {
+				free_packet(ep.ready[ep.ready_head]);
+				ep.ready_head = (ep.ready_head + 1) % Isoc_endpoint::PACKETS;
+				ep.ready_count--;
+			}
+			if (ep.out_valid)
+				free_packet(ep.out);
+
+			/* packets still in flight are released on their completion */
+			ep.address   = 0;
+			ep.frame     = 0;
+			ep.out_valid = false;
+		}
+	}
+
 	void _destroy()
 	{
 		/* mark delete before removing */
@@ -335,6 +532,7 @@ struct Usb_host_device : List<Usb_host_device>::Element
 
 	void update_ep(USBDevice *udev)
 	{
+		isoc_reset();
 		usb_ep_reset(udev);
 
 		/* retrieve device speed */
@@ -447,6 +645,9 @@ static void usb_host_handle_data(USBDevice *udev, USBPacket *p)
 		type = Usb::Packet_descriptor::IRQ;
 		size = p->iov.size;
 		break;
+	case USB_ENDPOINT_XFER_ISOC:
+		dev->isoc_data(udev, p);
+		return;
 	default:
 		error("not supported data request");
 		break;
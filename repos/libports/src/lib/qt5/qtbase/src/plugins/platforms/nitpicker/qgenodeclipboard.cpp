@@ -17,6 +17,7 @@
 
 /* Genode includes */
 #include <util/xml_node.h>
+#include <clipboard/content.h>
 
 /* Qt includes */
 #include <QMimeData>
@@ -26,6 +27,8 @@ QT_BEGIN_NAMESPACE
 
 static constexpr bool verbose = false;
 
+static char const *text_mime_type = "text/plain;charset=utf-8";
+
 
 QGenodeClipboard::QGenodeClipboard(Genode::Env &env, Genode::Signal_receiver &sig_rcv)
 : _clipboard_signal_dispatcher(sig_rcv, *this, &QGenodeClipboard::_handle_clipboard)
@@ -47,6 +50,7 @@ QGenodeClipboard::QGenodeClipboard(Genode::Env &env, Genode::Signal_receiver &si
 
 			try {
 				_clipboard_reporter = new Genode::Reporter(env, "clipboard");
+				_clipboard_reporter->expanding(true);
 				_clipboard_reporter->enabled(true);
 			} catch (...) {	}
 
@@ -84,6 +88,21 @@ QMimeData *QGenodeClipboard::mimeData(QClipboard::Mode mode)
 
 	char *xml_data = _clipboard_ds->local_addr<char>();
 
+	/* large content is passed without XML escaping */
+	bool const raw = Clipboard::with_raw_content(xml_data, _clipboard_ds->size(),
+		[&] (Clipboard::Mime_type const &mime, char const *data, Genode::size_t len) {
+
+			QByteArray const bytes(data, len);
+
+			if (mime == text_mime_type || mime == "text/plain")
+				_mimedata->setText(QString::fromUtf8(bytes));
+			else
+				_mimedata->setData(QString(mime.string()), bytes);
+		});
+
+	if (raw)
+		return _mimedata;
+
 	try {
 		Genode::Xml_node node(xml_data);
 
@@ -125,6 +144,16 @@ void QGenodeClipboard::setMimeData(QMimeData *data, QClipboard::Mode mode)
 	if (!_clipboard_reporter)
 		return;
 
+	Genode::size_t const len = utf8text.size();
+
+	if (len >= Clipboard::RAW_CONTENT_THRESHOLD) {
+		_clipboard_reporter->report_in_place(Clipboard::raw_content_max_size(len),
+			[&] (char *dst, Genode::size_t dst_len) {
+				return Clipboard::write_raw_content(dst, dst_len, text_mime_type,
+				                                    utf8text.constData(), len); });
+		return;
+	}
+
 	try {
 		Genode::Reporter::Xml_generator xml(*_clipboard_reporter, [&] () {
 			xml.append_sanitized(utf8text.constData(), utf8text.size()); });
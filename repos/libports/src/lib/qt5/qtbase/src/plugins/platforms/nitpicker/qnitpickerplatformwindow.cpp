@@ -301,6 +301,42 @@ Nitpicker::Session::View_handle QNitpickerPlatformWindow::_create_view()
 	return _nitpicker_session.create_view();
 }
 
+bool QNitpickerPlatformWindow::_buffer_fits(Framebuffer::Mode const &mode) const
+{
+	if (mode.format() != _buffer_mode.format())
+		return false;
+
+	if (mode.width() > _buffer_mode.width() || mode.height() > _buffer_mode.height())
+		return false;
+
+	/* release the memory of a buffer that became much too large */
+	long const area        = (long)mode.width()*mode.height();
+	long const buffer_area = (long)_buffer_mode.width()*_buffer_mode.height();
+
+	return area*4 >= buffer_area;
+}
+
+Framebuffer::Mode QNitpickerPlatformWindow::_over_allocated(Framebuffer::Mode const &mode) const
+{
+	/*
+	 * Add a slack of one eighth, rounded up to 64 pixels, to absorb the
+	 * subsequent steps of an interactive resize. The buffer never exceeds
+	 * the screen.
+	 */
+	enum { GRANULARITY = 64 };
+
+	QRect const screen_geometry(screen()->geometry());
+
+	auto padded = [] (int value, int limit) {
+		int const result = (value + value/8 + GRANULARITY - 1) & ~(GRANULARITY - 1);
+		return qMax(value, qMin(result, limit));
+	};
+
+	return Framebuffer::Mode(padded(mode.width(),  screen_geometry.width()),
+	                         padded(mode.height(), screen_geometry.height()),
+	                         mode.format());
+}
+
 void QNitpickerPlatformWindow::_adjust_and_set_geometry(const QRect &rect)
 {
 	/* limit window size to screen size */
@@ -314,11 +350,19 @@ void QNitpickerPlatformWindow::_adjust_and_set_geometry(const QRect &rect)
 
 	Framebuffer::Mode mode(adjusted_rect.width(), adjusted_rect.height(),
 	                       Framebuffer::Mode::RGB565);
-	_nitpicker_session.buffer(mode, false);
+
+	/*
+	 * The nitpicker buffer is re-created only if the new window size does not
+	 * fit. The view shows the upper-left part of the buffer only.
+	 */
+	if (!_buffer_fits(mode)) {
+		_buffer_mode = _over_allocated(mode);
+		_nitpicker_session.buffer(_buffer_mode, false);
+		_framebuffer_changed = true;
+	}
 
 	_current_mode = mode;
 
-	_framebuffer_changed = true;
 	_geometry_changed = true;
 
 	emit framebuffer_changed();
@@ -700,6 +744,11 @@ unsigned char *QNitpickerPlatformWindow::framebuffer()
 	return _framebuffer;
 }
 
+QSize QNitpickerPlatformWindow::framebuffer_size() const
+{
+	return QSize(_buffer_mode.width(), _buffer_mode.height());
+}
+
 void QNitpickerPlatformWindow::refresh(int x, int y, int w, int h)
 {
 	if (qnpw_verbose)
@@ -51,6 +51,7 @@ class QNitpickerPlatformWindow : public QObject, public QPlatformWindow
 		bool                             _framebuffer_changed;
 		bool                             _geometry_changed;
 		Framebuffer::Mode                _current_mode;
+		Framebuffer::Mode                _buffer_mode;
 		Genode::Signal_receiver         &_signal_receiver;
 		Nitpicker::Session::View_handle  _view_handle;
 		Input::Session_client            _input_session;
@@ -77,6 +78,8 @@ class QNitpickerPlatformWindow : public QObject, public QPlatformWindow
 		void _process_touch_events(QList<Input::Event> const &events);
 
 		Nitpicker::Session::View_handle _create_view();
+		bool _buffer_fits(Framebuffer::Mode const &mode) const;
+		Framebuffer::Mode _over_allocated(Framebuffer::Mode const &mode) const;
 		void _adjust_and_set_geometry(const QRect &rect);
 
 	private Q_SLOTS:
@@ -171,6 +174,11 @@ class QNitpickerPlatformWindow : public QObject, public QPlatformWindow
 
 	    unsigned char *framebuffer();
 
+		/**
+		 * Size of the nitpicker buffer, which may exceed the window size
+		 */
+		QSize framebuffer_size() const;
+
 		void refresh(int x, int y, int w, int h);
 
 
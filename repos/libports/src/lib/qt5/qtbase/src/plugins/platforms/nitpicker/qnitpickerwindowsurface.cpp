@@ -27,10 +27,21 @@
 
 static const bool verbose = false;
 
+/*
+ * By setting the environment variable 'QT_NITPICKER_DIRECT', Qt paints
+ * directly into the nitpicker buffer instead of a back buffer. This saves
+ * one copy of each flushed region but may expose partially painted content.
+ */
+static bool direct_rendering()
+{
+	return !qgetenv("QT_NITPICKER_DIRECT").isEmpty();
+}
+
 QT_BEGIN_NAMESPACE
 
 QNitpickerWindowSurface::QNitpickerWindowSurface(QWindow *window)
-    : QPlatformBackingStore(window), _backbuffer(0), _framebuffer_changed(true)
+    : QPlatformBackingStore(window), _backbuffer(0), _backbuffer_size(0),
+      _framebuffer_changed(true), _direct(direct_rendering())
 {
     //qDebug() << "QNitpickerWindowSurface::QNitpickerWindowSurface:" << (long)this;
 
@@ -61,9 +72,32 @@ QPaintDevice *QNitpickerWindowSurface::paintDevice()
         QImage::Format format = QGuiApplication::primaryScreen()->handle()->format();
         QRect geo = _platform_window->geometry();
         unsigned int const bytes_per_pixel = QGuiApplication::primaryScreen()->depth() / 8;
-		qFree(_backbuffer);
-		_backbuffer = (unsigned char*)qMalloc(geo.width() * geo.height() * bytes_per_pixel);
-		_image = QImage(_backbuffer, geo.width(), geo.height(), geo.width() * bytes_per_pixel, format);
+
+		/*
+		 * The image uses the layout of the nitpicker buffer, which is
+		 * over-allocated by the platform window. Hence, the back buffer is
+		 * only re-allocated if the nitpicker buffer was re-created with a
+		 * larger size.
+		 */
+		QSize const buffer_size = _platform_window->framebuffer_size();
+		int   const stride      = buffer_size.width() * bytes_per_pixel;
+
+		unsigned char *bits = 0;
+
+		if (_direct) {
+			bits = _platform_window->framebuffer();
+		} else {
+			int const size = stride * buffer_size.height();
+
+			if (size > _backbuffer_size) {
+				qFree(_backbuffer);
+				_backbuffer      = (unsigned char*)qMalloc(size);
+				_backbuffer_size = size;
+			}
+			bits = _backbuffer;
+		}
+
+		_image = QImage(bits, geo.width(), geo.height(), stride, format);
 
         if (verbose)
         	qDebug() << "QNitpickerWindowSurface::paintDevice(): w =" << geo.width() << ", h =" << geo.height();
@@ -90,9 +124,14 @@ void QNitpickerWindowSurface::flush(QWindow *window, const QRegion &region, cons
 
 	unsigned int const bytes_per_pixel = _image.depth() / 8;
 
-	for (int i = 0; i < region.rects().size(); i++) {
+	/* acquire the framebuffer only once, it may have been re-created */
+	unsigned char *framebuffer = _platform_window->framebuffer();
+
+	QVector<QRect> const rects(region.rects());
 
-		QRect rect(region.rects()[i]);
+	for (int i = 0; i < rects.size(); i++) {
+
+		QRect rect(rects[i]);
 
 		/*
 		 * It happened that after resizing a window, the given flush region was
@@ -101,22 +140,33 @@ void QNitpickerWindowSurface::flush(QWindow *window, const QRegion &region, cons
 
 		rect &= _image.rect();
 
-		unsigned int buffer_offset = ((rect.y() + offset.y()) * _image.bytesPerLine()) +
-		                             ((rect.x() + offset.x()) * bytes_per_pixel);
+		if (!_direct) {
+			unsigned int buffer_offset = ((rect.y() + offset.y()) * _image.bytesPerLine()) +
+			                             ((rect.x() + offset.x()) * bytes_per_pixel);
 
-		blit(_image.bits() + buffer_offset,
-		     _image.bytesPerLine(),
-		     _platform_window->framebuffer() + buffer_offset,
-		     _image.bytesPerLine(),
-		     rect.width() * bytes_per_pixel,
-		     rect.height());
+			blit(_image.bits() + buffer_offset,
+			     _image.bytesPerLine(),
+			     framebuffer + buffer_offset,
+			     _image.bytesPerLine(),
+			     rect.width() * bytes_per_pixel,
+			     rect.height());
+		}
 
-		_platform_window->refresh(rect.x() + offset.x(),
-		                          rect.y() + offset.y(),
-		                          rect.width(),
-		                          rect.height());
+		if (rects.size() <= MAX_REFRESH_RECTS)
+			_refresh(rect.translated(offset));
 	}
 
+	/*
+	 * Refreshing many small rectangles costs more RPCs than nitpicker
+	 * spends on redrawing their bounding rectangle.
+	 */
+	if (rects.size() > MAX_REFRESH_RECTS)
+		_refresh((region.boundingRect() & _image.rect()).translated(offset));
+}
+
+void QNitpickerWindowSurface::_refresh(QRect const &rect)
+{
+	_platform_window->refresh(rect.x(), rect.y(), rect.width(), rect.height());
 }
 
 void QNitpickerWindowSurface::resize(const QSize &size, const QRegion &staticContents)
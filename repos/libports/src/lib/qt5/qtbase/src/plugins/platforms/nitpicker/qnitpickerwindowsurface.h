@@ -27,10 +27,17 @@ class QNitpickerWindowSurface : public QObject, public QPlatformBackingStore
 
 	private:
 
+		/* refresh the bounding rectangle of regions with more rectangles */
+		enum { MAX_REFRESH_RECTS = 8 };
+
 		QNitpickerPlatformWindow *_platform_window;
 		unsigned char            *_backbuffer;
+		int                       _backbuffer_size;
 		QImage                    _image;
 		bool                      _framebuffer_changed;
+		bool const                _direct;
+
+		void _refresh(QRect const &rect);
 
 	public:
 
@@ -32,6 +32,10 @@ extern Genode::Lock  event_lock;
 
 enum {
 	AUDIO_CHANNELS = 2,
+
+	/* bounds of the number of packets filled per call of the SDL callback */
+	MIN_FILL_PACKETS = 2,
+	MAX_FILL_PACKETS = 8,
 };
 
 using Genode::Allocator_avl;
@@ -104,6 +108,7 @@ struct Volume_config
 struct SDL_PrivateAudioData {
 	Uint8             *mixbuf;
 	Uint32             mixlen;
+	unsigned           fill_packets;
 	Constructible<Volume_config> volume_config;
 	Constructible<Audio_out::Connection> audio[AUDIO_CHANNELS];
 	Audio_out::Packet     *packet[AUDIO_CHANNELS];
@@ -204,8 +209,11 @@ static void GENODEAUD_WaitAudio(_THIS)
 	                            ? ((Audio_out::QUEUE_SIZE + packet_pos) - play_pos)
 	                            : packet_pos - play_pos;
 
-	/* wait until there is only one packet left to play */
-	while (queued > 1) {
+	/*
+	 * Wait until no more packets are queued than the SDL callback fills at
+	 * once, so that the stream never runs dry while mixing.
+	 */
+	while (queued > _this->hidden->fill_packets) {
 		con.wait_for_progress();
 		queued--;
 	}
@@ -232,27 +240,35 @@ static void GENODEAUD_PlayAudio(_THIS)
 
 	float const volume = _this->hidden->volume_config->volume;
 
-	/*
-	 * Get new packet for left channel and use it to synchronize
-	 * the right channel
-	 */
-	p[0] = c[0]->stream()->next(p[0]);
-	unsigned ppos = c[0]->stream()->packet_position(p[0]);
-	p[1] = c[1]->stream()->get(ppos);
+	int16_t const *mixbuf = (int16_t const *)_this->hidden->mixbuf;
 
-	for (int sample = 0; sample < Audio_out::PERIOD; sample++)
-		for (int channel = 0; channel < AUDIO_CHANNELS; channel++)
-			p[channel]->content()[sample] =
-				volume * (float)(((int16_t*)_this->hidden->mixbuf)[sample * AUDIO_CHANNELS + channel]) / 32768;
+	for (unsigned i = 0; i < _this->hidden->fill_packets; i++) {
 
-	for (int channel = 0; channel < AUDIO_CHANNELS; channel++) {
-		_this->hidden->audio[channel]->submit(p[channel]);
 		/*
-		 * Save current packet to query packet position next time and
-		 * when in GENODEAUD_WaitAudio
+		 * Get new packet for left channel and use it to synchronize
+		 * the right channel
 		 */
-		_this->hidden->packet[channel] = p[channel];
+		p[0] = c[0]->stream()->next(p[0]);
+		unsigned ppos = c[0]->stream()->packet_position(p[0]);
+		p[1] = c[1]->stream()->get(ppos);
+
+		int16_t const *src = mixbuf + i * Audio_out::PERIOD * AUDIO_CHANNELS;
+
+		for (int sample = 0; sample < Audio_out::PERIOD; sample++)
+			for (int channel = 0; channel < AUDIO_CHANNELS; channel++)
+				p[channel]->content()[sample] =
+					volume * (float)(src[sample * AUDIO_CHANNELS + channel]) / 32768;
+
+		for (int channel = 0; channel < AUDIO_CHANNELS; channel++)
+			_this->hidden->audio[channel]->submit(p[channel]);
 	}
+
+	/*
+	 * Save current packet to query packet position next time and
+	 * when in GENODEAUD_WaitAudio
+	 */
+	for (int channel = 0; channel < AUDIO_CHANNELS; channel++)
+		_this->hidden->packet[channel] = p[channel];
 }
 
 
@@ -278,12 +294,24 @@ static int GENODEAUD_OpenAudio(_THIS, SDL_AudioSpec *spec)
 	log("          samples=", spec->samples);
 	log("          size=",    spec->size);
 
+	/*
+	 * The SDL callback fills several packets at once, following the
+	 * buffer size requested by the application. This reduces the number
+	 * of wake-ups of the audio thread and keeps more samples queued.
+	 */
+	unsigned const requested = (spec->samples + Audio_out::PERIOD - 1)
+	                         / Audio_out::PERIOD;
+	_this->hidden->fill_packets = Genode::max((unsigned)MIN_FILL_PACKETS,
+	                              Genode::min(requested, (unsigned)MAX_FILL_PACKETS));
+
 	spec->channels = AUDIO_CHANNELS;
 	spec->format = AUDIO_S16LSB;
 	spec->freq = Audio_out::SAMPLE_RATE;
-	spec->samples = Audio_out::PERIOD;
+	spec->samples = Audio_out::PERIOD * _this->hidden->fill_packets;
 	SDL_CalculateAudioSpec(spec);
 
+	log("          packets per fill=", _this->hidden->fill_packets);
+
 	/* Allocate mixing buffer */
 	_this->hidden->mixlen = spec->size;
 	_this->hidden->mixbuf = (Uint8 *) SDL_AllocAudioMem(_this->hidden->mixlen);
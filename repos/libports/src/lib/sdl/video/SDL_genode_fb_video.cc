@@ -480,18 +480,30 @@ extern "C" {
 
 		Genode::log("Set video mode to: ", width, "x", height, "@", bpp);
 
-		SDL_memset(t->hidden->buffer, 0, width * height * (bpp / 8));
+		SDL_memset(t->hidden->buffer, 0, framebuffer->mode().width()
+		                               * framebuffer->mode().height()
+		                               * framebuffer->mode().bytes_per_pixel());
 
 		if (!SDL_ReallocFormat(current, bpp, 0, 0, 0, 0) ) {
 			Genode::error("couldn't allocate new pixel format for requested mode");
 			return nullptr;
 		}
 
+		/*
+		 * SDL renders directly into the framebuffer dataspace. Requests for
+		 * other pixel formats are served by a shadow surface of the SDL core.
+		 * The pitch must match the framebuffer even if the requested mode is
+		 * smaller.
+		 */
+		scr_mode = framebuffer->mode();
+		width  = Genode::min(width,  scr_mode.width());
+		height = Genode::min(height, scr_mode.height());
+
 		/* Set up the new mode framebuffer */
 		current->flags = flags | SDL_FULLSCREEN;
 		t->hidden->w = current->w = width;
 		t->hidden->h = current->h = height;
-		current->pitch = current->w * (bpp / 8);
+		current->pitch = scr_mode.width() * scr_mode.bytes_per_pixel();
 
 #if defined(SDL_VIDEO_OPENGL)
 		if ((flags & SDL_OPENGL) && !init_opengl(t)) {
@@ -547,10 +559,33 @@ extern "C" {
 	static void Genode_Fb_UpdateRects(SDL_VideoDevice *t, int numrects,
 	                                  SDL_Rect *rects)
 	{
-		int i;
-		for(i=0;i<numrects;i++) {
-			framebuffer->refresh(rects[i].x, rects[i].y, rects[i].w, rects[i].h);
+		/*
+		 * Each refresh is an RPC. For many small rectangles, refreshing
+		 * their bounding rectangle at once is cheaper.
+		 */
+		enum { MAX_REFRESH_RECTS = 8 };
+
+		if (numrects <= MAX_REFRESH_RECTS) {
+			for (int i = 0; i < numrects; i++)
+				if (rects[i].w && rects[i].h)
+					framebuffer->refresh(rects[i].x, rects[i].y,
+					                     rects[i].w, rects[i].h);
+			return;
 		}
+
+		int x1 = t->hidden->w, y1 = t->hidden->h, x2 = 0, y2 = 0;
+		for (int i = 0; i < numrects; i++) {
+			if (!rects[i].w || !rects[i].h)
+				continue;
+
+			x1 = Genode::min(x1, (int)rects[i].x);
+			y1 = Genode::min(y1, (int)rects[i].y);
+			x2 = Genode::max(x2, rects[i].x + rects[i].w);
+			y2 = Genode::max(y2, rects[i].y + rects[i].h);
+		}
+
+		if (x1 < x2 && y1 < y2)
+			framebuffer->refresh(x1, y1, x2 - x1, y2 - y1);
 	}
 
 
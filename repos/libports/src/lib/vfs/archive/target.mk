@@ -0,0 +1,2 @@
+TARGET = dummy-vfs_archive
+LIBS = vfs_archive
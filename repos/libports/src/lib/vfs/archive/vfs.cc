@@ -0,0 +1,904 @@
+/*
+ * \brief  VFS plugin for serving compressed archives via libarchive
+ * \author Genode Labs
+ * \date   2026-10-14
+ *
+ * The archive is provided as ROM module and served read-only without
+ * unpacking it. At construction time, the plugin walks the archive once to
+ * build an index of all entries. File content is decompressed on demand in
+ * blocks, which are kept in an LRU cache of bounded size. Because compressed
+ * streams can only be decoded sequentially, the plugin keeps a few archive
+ * readers open at different positions of the stream. Each reader acts as
+ * seek point from which the decompression of a requested block resumes.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <vfs/file_system_factory.h>
+#include <vfs/file_system.h>
+#include <vfs/vfs_handle.h>
+#include <base/attached_rom_dataspace.h>
+#include <base/lock.h>
+#include <base/log.h>
+#include <util/avl_string.h>
+#include <util/construct_at.h>
+
+/* libarchive includes */
+#include <archive.h>
+#include <archive_entry.h>
+
+namespace Vfs_archive {
+
+	using namespace Vfs;
+
+	struct Entry;
+	class  Index;
+	class  Block_cache;
+	struct Reader;
+	class  File_system;
+
+	typedef Genode::String<64> Rom_name;
+}
+
+
+struct Vfs_archive::Entry : Genode::Avl_string_base
+{
+	enum Type { FILE, DIRECTORY, SYMLINK };
+
+	/**
+	 * Ordinal number of implicit directories, which have no archive record
+	 */
+	enum { IMPLICIT = -1L };
+
+	Genode::size_t const alloc_size;
+	unsigned long  const inode;
+
+	Type         type    = DIRECTORY;
+	unsigned     mode    = 0755;
+	unsigned     uid     = 0;
+	unsigned     gid     = 0;
+	file_size    size    = 0;
+	long         ordinal = IMPLICIT;  /* position of record in the archive */
+	char        *link    = nullptr;   /* symlink target */
+	Entry const *data    = this;      /* hard links refer to another entry */
+
+	Entry   *first_child  = nullptr;
+	Entry   *last_child   = nullptr;
+	Entry   *next_sibling = nullptr;
+	unsigned num_children = 0;
+
+	Entry *next_allocated = nullptr;
+
+	Entry(char const *path, Genode::size_t alloc_size, unsigned long inode)
+	: Avl_string_base(path), alloc_size(alloc_size), inode(inode) { }
+
+	char const *basename() const
+	{
+		char const *name = Avl_string_base::name();
+		for (char const *s = name; *s; s++)
+			if (*s == '/')
+				name = s + 1;
+		return name;
+	}
+
+	Directory_service::Dirent_type dirent_type() const
+	{
+		switch (type) {
+		case FILE:      return Directory_service::DIRENT_TYPE_FILE;
+		case SYMLINK:   return Directory_service::DIRENT_TYPE_SYMLINK;
+		case DIRECTORY: break;
+		}
+		return Directory_service::DIRENT_TYPE_DIRECTORY;
+	}
+};
+
+
+/**
+ * Tree of all archive entries, including implicit parent directories
+ */
+class Vfs_archive::Index : Genode::Noncopyable
+{
+	private:
+
+		Genode::Allocator &_alloc;
+
+		Genode::Avl_tree<Genode::Avl_string_base> _tree { };
+
+		Entry *_entries     = nullptr;   /* list of all allocated entries */
+		unsigned long _num_entries = 0;
+
+		Entry &_root = _create("/");
+
+		Entry &_create(char const *path)
+		{
+			Genode::size_t const len  = Genode::strlen(path) + 1;
+			Genode::size_t const size = sizeof(Entry) + len;
+
+			char  *mem   = (char *)_alloc.alloc(size);
+			char  *name  = mem + sizeof(Entry);
+			Genode::strncpy(name, path, len);
+
+			Entry &entry = *Genode::construct_at<Entry>(mem, name, size,
+			                                            ++_num_entries);
+			entry.next_allocated = _entries;
+			_entries = &entry;
+
+			_tree.insert(&entry);
+			return entry;
+		}
+
+		Entry &_directory(Absolute_path const &path)
+		{
+			if (Entry *entry = lookup(path.base()))
+				return *entry;
+
+			return _insert(path);
+		}
+
+		Entry &_insert(Absolute_path const &path)
+		{
+			Absolute_path parent_path(path);
+			parent_path.strip_last_element();
+
+			Entry &parent = _directory(parent_path);
+			Entry &entry  = _create(path.base());
+
+			if (parent.last_child)
+				parent.last_child->next_sibling = &entry;
+			else
+				parent.first_child = &entry;
+
+			parent.last_child = &entry;
+			parent.num_children++;
+
+			return entry;
+		}
+
+	public:
+
+		Index(Genode::Allocator &alloc) : _alloc(alloc) { }
+
+		~Index()
+		{
+			while (Entry *entry = _entries) {
+				_entries = entry->next_allocated;
+
+				if (entry->link)
+					_alloc.free(entry->link, Genode::strlen(entry->link) + 1);
+
+				Genode::size_t const size = entry->alloc_size;
+				entry->~Entry();
+				_alloc.free(entry, size);
+			}
+		}
+
+		unsigned long num_entries() const { return _num_entries; }
+
+		Entry *lookup(char const *path)
+		{
+			if (Genode::strcmp(path, "/") == 0)
+				return &_root;
+
+			Genode::Avl_string_base *node = _tree.first();
+			return node ? static_cast<Entry *>(node->find_by_name(path)) : nullptr;
+		}
+
+		/**
+		 * Return entry for 'path', creating it if needed
+		 *
+		 * Archives may contain several records of the same path, in which
+		 * case the last record wins.
+		 */
+		Entry &entry(Absolute_path const &path)
+		{
+			if (Entry *entry = lookup(path.base()))
+				return *entry;
+
+			return _insert(path);
+		}
+
+		void link(Entry &entry, char const *target)
+		{
+			if (entry.link)
+				_alloc.free(entry.link, Genode::strlen(entry.link) + 1);
+
+			Genode::size_t const len = Genode::strlen(target) + 1;
+			entry.link = (char *)_alloc.alloc(len);
+			Genode::strncpy(entry.link, target, len);
+		}
+};
+
+
+/**
+ * LRU cache of decompressed blocks of file content
+ */
+class Vfs_archive::Block_cache : Genode::Noncopyable
+{
+	public:
+
+		enum { BLOCK_SIZE = 16*1024 };
+
+		struct Block
+		{
+			Entry const   *entry     = nullptr;
+			file_size      index     = 0;
+			Genode::size_t length    = 0;
+			unsigned long  last_used = 0;
+			char          *data      = nullptr;
+		};
+
+	private:
+
+		Genode::Allocator &_alloc;
+
+		unsigned const _num_blocks;
+
+		Block * const _blocks;
+		char  * const _data;
+
+		unsigned long _now = 0;
+
+		static unsigned _num_blocks_for(Genode::size_t bytes) {
+			return Genode::max(4UL, (unsigned long)(bytes / BLOCK_SIZE)); }
+
+		Block *_alloc_blocks()
+		{
+			Block *blocks = (Block *)_alloc.alloc(_num_blocks*sizeof(Block));
+			for (unsigned i = 0; i < _num_blocks; i++)
+				Genode::construct_at<Block>(&blocks[i]);
+			return blocks;
+		}
+
+	public:
+
+		Block_cache(Genode::Allocator &alloc, Genode::size_t bytes)
+		:
+			_alloc(alloc), _num_blocks(_num_blocks_for(bytes)),
+			_blocks(_alloc_blocks()),
+			_data((char *)_alloc.alloc(_num_blocks*BLOCK_SIZE))
+		{
+			for (unsigned i = 0; i < _num_blocks; i++)
+				_blocks[i].data = _data + i*BLOCK_SIZE;
+		}
+
+		~Block_cache()
+		{
+			_alloc.free(_data,   _num_blocks*BLOCK_SIZE);
+			_alloc.free(_blocks, _num_blocks*sizeof(Block));
+		}
+
+		Genode::size_t size() const { return _num_blocks*BLOCK_SIZE; }
+
+		Block const *lookup(Entry const &entry, file_size index)
+		{
+			for (unsigned i = 0; i < _num_blocks; i++) {
+				Block &block = _blocks[i];
+				if (block.entry == &entry && block.index == index) {
+					block.last_used = ++_now;
+					return &block;
+				}
+			}
+			return nullptr;
+		}
+
+		/**
+		 * Return least-recently used block for being refilled
+		 *
+		 * The block is invalid until 'assign' is called.
+		 */
+		Block &victim()
+		{
+			Block *lru = &_blocks[0];
+			for (unsigned i = 1; i < _num_blocks && lru->entry; i++)
+				if (!_blocks[i].entry || _blocks[i].last_used < lru->last_used)
+					lru = &_blocks[i];
+
+			lru->entry = nullptr;
+			return *lru;
+		}
+
+		void assign(Block &block, Entry const &entry, file_size index,
+		            Genode::size_t length)
+		{
+			block.entry     = &entry;
+			block.index     = index;
+			block.length    = length;
+			block.last_used = ++_now;
+		}
+};
+
+
+/**
+ * Archive reader positioned within the decompressed stream
+ */
+struct Vfs_archive::Reader : Genode::Noncopyable
+{
+	struct archive *archive   = nullptr;
+	long            ordinal   = Entry::IMPLICIT;  /* record read last */
+	file_size       offset    = 0;   /* consumed content bytes of record */
+	unsigned long   last_used = 0;
+
+	~Reader() { close(); }
+
+	void close()
+	{
+		if (archive)
+			archive_read_free(archive);
+
+		archive = nullptr;
+		ordinal = Entry::IMPLICIT;
+		offset  = 0;
+	}
+
+	bool open(void const *base, Genode::size_t size)
+	{
+		close();
+
+		archive = archive_read_new();
+		if (!archive)
+			return false;
+
+		archive_read_support_filter_all(archive);
+		archive_read_support_format_all(archive);
+
+		if (archive_read_open_memory(archive, const_cast<void *>(base), size)
+		    != ARCHIVE_OK) {
+			Genode::error("could not open archive: ", error());
+			close();
+			return false;
+		}
+		return true;
+	}
+
+	char const *error() const
+	{
+		char const *msg = archive ? archive_error_string(archive) : nullptr;
+		return msg ? msg : "unknown error";
+	}
+
+	/**
+	 * Return true if the reader can reach the given position by
+	 * decompressing forward
+	 */
+	bool precedes(long target_ordinal, file_size target_offset) const
+	{
+		return archive && (ordinal < target_ordinal
+		               || (ordinal == target_ordinal && offset <= target_offset));
+	}
+
+	/**
+	 * Read next record header
+	 *
+	 * The remaining content of the current record is skipped.
+	 */
+	archive_entry *next()
+	{
+		archive_entry *entry = nullptr;
+
+		int const ret = archive_read_next_header(archive, &entry);
+		if (ret != ARCHIVE_OK && ret != ARCHIVE_WARN)
+			return nullptr;
+
+		ordinal++;
+		offset = 0;
+		return entry;
+	}
+
+	bool advance_to(long target_ordinal)
+	{
+		while (ordinal < target_ordinal)
+			if (!next())
+				return false;
+		return true;
+	}
+
+	/**
+	 * Read up to 'len' content bytes of the current record
+	 *
+	 * \return  number of bytes read, or -1 on error
+	 */
+	long read(char *dst, Genode::size_t len)
+	{
+		Genode::size_t count = 0;
+		while (count < len) {
+			la_ssize_t const ret = archive_read_data(archive, dst + count,
+			                                         len - count);
+			if (ret < 0)
+				return -1;
+			if (ret == 0)
+				break;
+			count += ret;
+		}
+		offset += count;
+		return count;
+	}
+};
+
+
+class Vfs_archive::File_system : public Vfs::File_system
+{
+	private:
+
+		typedef Block_cache::Block Block;
+
+		enum { MAX_READERS = 8, DEFAULT_READERS = 4,
+		       DEFAULT_CACHE_SIZE = 1024*1024 };
+
+		Rom_name const _rom_name;
+
+		Genode::Attached_rom_dataspace _rom;
+
+		Index _index;
+
+		Block_cache _cache;
+
+		unsigned const _num_readers;
+
+		Reader        _readers[MAX_READERS];
+		unsigned long _now = 0;
+
+		Genode::Lock _lock { };
+
+		void _build_index(Reader &reader)
+		{
+			if (!reader.open(_rom.local_addr<void>(), _rom.size()))
+				return;
+
+			while (archive_entry *record = reader.next()) {
+
+				Absolute_path path(archive_entry_pathname(record), "/");
+				path.remove_trailing('/');
+
+				if (path == "/")
+					continue;
+
+				Entry &entry = _index.entry(path);
+
+				entry.ordinal = reader.ordinal;
+				entry.mode    = archive_entry_perm(record);
+				entry.uid     = archive_entry_uid(record);
+				entry.gid     = archive_entry_gid(record);
+				entry.size    = archive_entry_size_is_set(record)
+				              ? archive_entry_size(record) : 0;
+				entry.data    = &entry;
+
+				char const *hardlink = archive_entry_hardlink(record);
+				if (hardlink && entry.size == 0) {
+					Absolute_path target_path(hardlink, "/");
+					Entry const *target = _index.lookup(target_path.base());
+					if (target)
+						entry.data = target->data;
+					entry.type = Entry::FILE;
+					continue;
+				}
+
+				switch (archive_entry_filetype(record)) {
+				case AE_IFDIR:
+					entry.type = Entry::DIRECTORY;
+					break;
+				case AE_IFLNK:
+					entry.type = Entry::SYMLINK;
+					_index.link(entry, archive_entry_symlink(record)
+					                 ? archive_entry_symlink(record) : "");
+					entry.size = Genode::strlen(entry.link);
+					break;
+				default:
+					entry.type = Entry::FILE;
+				}
+			}
+
+			if (archive_errno(reader.archive))
+				Genode::warning(_rom_name, ": ", reader.error());
+
+			reader.close();
+		}
+
+		/**
+		 * Return reader closest before the given position
+		 *
+		 * If no reader precedes the position, the least-recently used reader
+		 * is restarted at the beginning of the archive.
+		 */
+		Reader *_reader_for(long ordinal, file_size offset)
+		{
+			Reader *best = nullptr, *lru = &_readers[0];
+
+			for (unsigned i = 0; i < _num_readers; i++) {
+				Reader &r = _readers[i];
+
+				if (r.precedes(ordinal, offset)
+				 && (!best || best->ordinal < r.ordinal
+				           || (best->ordinal == r.ordinal && best->offset < r.offset)))
+					best = &r;
+
+				if (!r.archive || (lru->archive && r.last_used < lru->last_used))
+					lru = &r;
+			}
+
+			if (!best) {
+				if (!lru->open(_rom.local_addr<void>(), _rom.size()))
+					return nullptr;
+				best = lru;
+			}
+
+			best->last_used = ++_now;
+			return best;
+		}
+
+		/**
+		 * Decompress content of 'entry' up to the block with 'index'
+		 *
+		 * All blocks decoded on the way are cached as they are likely to be
+		 * read next.
+		 */
+		Block const *_decompress(Entry const &entry, file_size index)
+		{
+			file_size const offset = index*Block_cache::BLOCK_SIZE;
+
+			Reader *reader = _reader_for(entry.ordinal, offset);
+			if (!reader)
+				return nullptr;
+
+			if (!reader->advance_to(entry.ordinal)) {
+				Genode::error(_rom_name, ": ", reader->error());
+				reader->close();
+				return nullptr;
+			}
+
+			while (reader->offset <= offset) {
+
+				file_size const block_index = reader->offset / Block_cache::BLOCK_SIZE;
+
+				Block &block = _cache.victim();
+
+				long const len = reader->read(block.data, Block_cache::BLOCK_SIZE);
+				if (len < 0) {
+					Genode::error(_rom_name, ": ", reader->error());
+					reader->close();
+					return nullptr;
+				}
+
+				if (len == 0)
+					return nullptr;
+
+				/* blocks cached earlier are decoded again to move forward */
+				Block const *cached = _cache.lookup(entry, block_index);
+				if (!cached) {
+					_cache.assign(block, entry, block_index, len);
+					cached = &block;
+				}
+
+				if (block_index == index)
+					return cached;
+
+				if (len < Block_cache::BLOCK_SIZE)
+					return nullptr;
+			}
+			return nullptr;
+		}
+
+		Read_result _read(Entry const &entry, file_size offset, char *dst,
+		                  file_size count, file_size &out_count)
+		{
+			Genode::Lock::Guard guard(_lock);
+
+			out_count = 0;
+
+			Entry const &data = *entry.data;
+
+			while (count && offset < data.size) {
+
+				file_size const index = offset / Block_cache::BLOCK_SIZE;
+
+				Block const *block = _cache.lookup(data, index);
+				if (!block)
+					block = _decompress(data, index);
+				if (!block)
+					return out_count ? READ_OK : READ_ERR_IO;
+
+				Genode::size_t const skip = offset - index*Block_cache::BLOCK_SIZE;
+				if (skip >= block->length)
+					break;
+
+				Genode::size_t const n = Genode::min(count, (file_size)(block->length - skip));
+				Genode::memcpy(dst, block->data + skip, n);
+
+				dst       += n;
+				count     -= n;
+				offset    += n;
+				out_count += n;
+			}
+			return READ_OK;
+		}
+
+		struct Archive_handle : Vfs_handle
+		{
+			Entry const &entry;
+
+			Archive_handle(File_system &fs, Allocator &alloc, Entry const &entry)
+			: Vfs_handle(fs, fs, alloc, 0), entry(entry) { }
+
+			virtual Read_result read(char *dst, file_size count,
+			                         file_size &out_count) = 0;
+		};
+
+		struct File_handle : Archive_handle
+		{
+			using Archive_handle::Archive_handle;
+
+			Read_result read(char *dst, file_size count,
+			                 file_size &out_count) override
+			{
+				return static_cast<File_system &>(fs())._read(entry, seek(), dst,
+				                                              count, out_count);
+			}
+		};
+
+		struct Symlink_handle : Archive_handle
+		{
+			using Archive_handle::Archive_handle;
+
+			Read_result read(char *dst, file_size count,
+			                 file_size &out_count) override
+			{
+				out_count = Genode::min(count, entry.size);
+				Genode::memcpy(dst, entry.link, out_count);
+				return READ_OK;
+			}
+		};
+
+		struct Dir_handle : Archive_handle
+		{
+			/* last visited child, speeds up the sequential listing */
+			file_size    _index = 0;
+			Entry const *_child = nullptr;
+
+			Dir_handle(File_system &fs, Allocator &alloc, Entry const &entry)
+			: Archive_handle(fs, alloc, entry), _child(entry.first_child) { }
+
+			Read_result read(char *dst, file_size count,
+			                 file_size &out_count) override
+			{
+				if (count < sizeof(Dirent))
+					return READ_ERR_INVALID;
+
+				Dirent &dirent = *(Dirent *)dst;
+				dirent = Dirent();
+
+				file_size const index = seek() / sizeof(Dirent);
+
+				if (index < _index) {
+					_index = 0;
+					_child = entry.first_child;
+				}
+
+				for (; _child && _index < index; _index++)
+					_child = _child->next_sibling;
+
+				out_count = sizeof(Dirent);
+
+				if (!_child) {
+					dirent.type = DIRENT_TYPE_END;
+					return READ_OK;
+				}
+
+				dirent.fileno = _child->inode;
+				dirent.type   = _child->dirent_type();
+				Genode::strncpy(dirent.name, _child->basename(), sizeof(dirent.name));
+
+				return READ_OK;
+			}
+		};
+
+		Entry *_lookup(char const *path) { return _index.lookup(path); }
+
+	public:
+
+		File_system(Genode::Env &env, Genode::Allocator &alloc,
+		            Genode::Xml_node config)
+		:
+			_rom_name(config.attribute_value("name", Rom_name())),
+			_rom(env, _rom_name.string()),
+			_index(alloc),
+			_cache(alloc, config.attribute_value("cache",
+			       Genode::Number_of_bytes(DEFAULT_CACHE_SIZE))),
+			_num_readers(Genode::max(1U, Genode::min((unsigned)MAX_READERS,
+			             config.attribute_value("readers", (unsigned)DEFAULT_READERS))))
+		{
+			_build_index(_readers[0]);
+
+			Genode::log("archive '", _rom_name, "': ", _index.num_entries(),
+			            " entries, ", _cache.size()/1024, " KiB cache, ",
+			            _num_readers, " readers");
+		}
+
+
+		/*********************************
+		 ** Directory-service interface **
+		 *********************************/
+
+		Dataspace_capability dataspace(char const *) override {
+			return Dataspace_capability(); }
+
+		void release(char const *, Dataspace_capability) override { }
+
+		Stat_result stat(char const *path, Stat &out) override
+		{
+			out = Stat();
+
+			Entry const *entry = _lookup(path);
+			if (!entry)
+				return STAT_ERR_NO_ENTRY;
+
+			unsigned mode = entry->mode;
+			switch (entry->type) {
+			case Entry::FILE:      mode |= STAT_MODE_FILE;      break;
+			case Entry::SYMLINK:   mode |= STAT_MODE_SYMLINK;   break;
+			case Entry::DIRECTORY: mode |= STAT_MODE_DIRECTORY; break;
+			}
+
+			out.mode   = mode;
+			out.size   = entry->type == Entry::FILE ? entry->data->size : entry->size;
+			out.uid    = entry->uid;
+			out.gid    = entry->gid;
+			out.inode  = entry->inode;
+			out.device = (Genode::addr_t)this;
+
+			return STAT_OK;
+		}
+
+		Unlink_result unlink(char const *path) override
+		{
+			return _lookup(path) ? UNLINK_ERR_NO_PERM : UNLINK_ERR_NO_ENTRY;
+		}
+
+		Rename_result rename(char const *from, char const *to) override
+		{
+			if (_lookup(from) || _lookup(to))
+				return RENAME_ERR_NO_PERM;
+			return RENAME_ERR_NO_ENTRY;
+		}
+
+		file_size num_dirent(char const *path) override
+		{
+			Entry const *entry = _lookup(path);
+			return entry && entry->type == Entry::DIRECTORY ? entry->num_children : 0;
+		}
+
+		bool directory(char const *path) override
+		{
+			Entry const *entry = _lookup(path);
+			return entry && entry->type == Entry::DIRECTORY;
+		}
+
+		char const *leaf_path(char const *path) override
+		{
+			return _lookup(path) ? path : nullptr;
+		}
+
+		Open_result open(char const *path, unsigned mode,
+		                 Vfs_handle **out_handle,
+		                 Genode::Allocator &alloc) override
+		{
+			Entry const *entry = _lookup(path);
+
+			if (!entry) {
+				if (mode & OPEN_MODE_CREATE)
+					return OPEN_ERR_NO_PERM;
+				return OPEN_ERR_UNACCESSIBLE;
+			}
+
+			if ((mode & OPEN_MODE_ACCMODE) != OPEN_MODE_RDONLY)
+				return OPEN_ERR_NO_PERM;
+
+			if (entry->type != Entry::FILE)
+				return OPEN_ERR_UNACCESSIBLE;
+
+			*out_handle = new (alloc) File_handle(*this, alloc, *entry);
+			return OPEN_OK;
+		}
+
+		Opendir_result opendir(char const *path, bool create,
+		                       Vfs_handle **out_handle,
+		                       Genode::Allocator &alloc) override
+		{
+			Entry const *entry = _lookup(path);
+
+			if (create)
+				return entry ? OPENDIR_ERR_NODE_ALREADY_EXISTS
+				             : OPENDIR_ERR_PERMISSION_DENIED;
+
+			if (!entry || entry->type != Entry::DIRECTORY)
+				return OPENDIR_ERR_LOOKUP_FAILED;
+
+			*out_handle = new (alloc) Dir_handle(*this, alloc, *entry);
+			return OPENDIR_OK;
+		}
+
+		Openlink_result openlink(char const *path, bool create,
+		                         Vfs_handle **out_handle,
+		                         Genode::Allocator &alloc) override
+		{
+			Entry const *entry = _lookup(path);
+
+			if (create)
+				return entry ? OPENLINK_ERR_NODE_ALREADY_EXISTS
+				             : OPENLINK_ERR_PERMISSION_DENIED;
+
+			if (!entry || entry->type != Entry::SYMLINK)
+				return OPENLINK_ERR_LOOKUP_FAILED;
+
+			*out_handle = new (alloc) Symlink_handle(*this, alloc, *entry);
+			return OPENLINK_OK;
+		}
+
+		void close(Vfs_handle *vfs_handle) override
+		{
+			Archive_handle *handle = static_cast<Archive_handle *>(vfs_handle);
+
+			if (handle)
+				destroy(vfs_handle->alloc(), handle);
+		}
+
+
+		/***************************
+		 ** File_system interface **
+		 ***************************/
+
+		static char const *name()   { return "archive"; }
+		char const *type() override { return "archive"; }
+
+
+		/********************************
+		 ** File I/O service interface **
+		 ********************************/
+
+		Write_result write(Vfs_handle *, char const *, file_size,
+		                   file_size &) override
+		{
+			return WRITE_ERR_INVALID;
+		}
+
+		Read_result complete_read(Vfs_handle *vfs_handle, char *dst,
+		                          file_size count, file_size &out_count) override
+		{
+			out_count = 0;
+
+			Archive_handle *handle = static_cast<Archive_handle *>(vfs_handle);
+			if (!handle)
+				return READ_ERR_INVALID;
+
+			return handle->read(dst, count, out_count);
+		}
+
+		Ftruncate_result ftruncate(Vfs_handle *, file_size) override
+		{
+			return FTRUNCATE_ERR_NO_PERM;
+		}
+
+		bool read_ready(Vfs_handle *) override { return true; }
+};
+
+
+struct Archive_factory : Vfs::File_system_factory
+{
+	Vfs::File_system *create(Genode::Env &env, Genode::Allocator &alloc,
+	                         Genode::Xml_node node,
+	                         Vfs::Io_response_handler &) override
+	{
+		return new (alloc) Vfs_archive::File_system(env, alloc, node);
+	}
+};
+
+
+extern "C" Vfs::File_system_factory *vfs_file_system_factory(void)
+{
+	static Archive_factory factory;
+	return &factory;
+}
@@ -24,6 +24,7 @@
 
 /* Genode block backend */
 #include <fatfs/block.h>
+#include <fatfs/fast_seek.h>
 
 namespace Fatfs {
 
@@ -56,6 +57,7 @@ class Fatfs::File_system : public Vfs::File_system
 		{
 			Path               path;
 			Fatfs::FIL         fil;
+			Fatfs::Fast_seek   fast_seek;
 			Fatfs_file_handles handles;
 
 			/************************
@@ -106,6 +108,8 @@ class Fatfs::File_system : public Vfs::File_system
 				FRESULT fres;
 				FIL *fil = &file->fil;
 
+				file->fast_seek.enable(*fil);
+
 				fres = f_lseek(fil, seek());
 				if (fres == FR_OK) {
 					UINT bw = 0;
@@ -560,6 +564,8 @@ class Fatfs::File_system : public Vfs::File_system
 			FIL *fil = &handle->file->fil;
 			FSIZE_t const wpos = handle->seek();
 
+			handle->file->fast_seek.disable(*fil);
+
 			/* seek file pointer */
 			if (f_tell(fil) != wpos) {
 				/*
@@ -610,6 +616,8 @@ class Fatfs::File_system : public Vfs::File_system
 			FIL *fil = &handle->file->fil;
 			FRESULT res = FR_OK;
 
+			handle->file->fast_seek.disable(*fil);
+
 			/* f_lseek will expand a file... */
 			res = f_lseek(fil, len);
 			if (f_tell(fil) != len)
@@ -635,8 +643,9 @@ struct Fatfs_factory : Vfs::File_system_factory
 {
 	struct Inner : Vfs::File_system_factory
 	{
-		Inner(Genode::Env &env, Genode::Allocator &alloc) {
-			Fatfs::block_init(env, alloc); }
+		Inner(Genode::Env &env, Genode::Allocator &alloc,
+		      Genode::size_t cache_size) {
+			Fatfs::block_init(env, alloc, cache_size); }
 
 		Vfs::File_system *create(Genode::Env       &env,
 		                         Genode::Allocator &alloc,
@@ -653,7 +662,12 @@ struct Fatfs_factory : Vfs::File_system_factory
 	                         Genode::Xml_node   node,
 	                         Vfs::Io_response_handler &io_handler) override
 	{
-		static Inner factory(env, alloc);
+		enum { DEFAULT_CACHE_SIZE = 512*1024 };
+
+		/* the sector cache is configured by the first fatfs node */
+		static Inner factory(env, alloc,
+			node.attribute_value("cache_size",
+				Genode::Number_of_bytes(DEFAULT_CACHE_SIZE)));
 		return factory.create(env, alloc, node, io_handler);
 	}
 };
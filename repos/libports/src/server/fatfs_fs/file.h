@@ -18,6 +18,7 @@
 namespace Fatfs { extern "C" {
 #include <fatfs/ff.h>
 } }
+#include <fatfs/fast_seek.h>
 
 /* local includes */
 #include <node.h>
@@ -31,7 +32,8 @@ class Fatfs_fs::File : public Node
 {
 	private:
 
-		Fatfs::FIL _fatfs_fil;
+		Fatfs::FIL       _fatfs_fil;
+		Fatfs::Fast_seek _fast_seek;
 
 	public:
 
@@ -81,6 +83,8 @@ class Fatfs_fs::File : public Node
 				seek_offset = file_info.fsize;
 			}
 
+			_fast_seek.enable(_fatfs_fil);
+
 			FRESULT res = f_lseek(&_fatfs_fil, seek_offset);
 
 			switch(res) {
@@ -144,6 +148,8 @@ class Fatfs_fs::File : public Node
 				seek_offset = file_info.fsize;
 			}
 
+			_fast_seek.disable(_fatfs_fil);
+
 			FRESULT res = f_lseek(&_fatfs_fil, seek_offset);
 
 			switch(res) {
@@ -206,6 +212,8 @@ class Fatfs_fs::File : public Node
 
 			/* 'f_truncate()' truncates to the current seek pointer */
 
+			_fast_seek.disable(_fatfs_fil);
+
 			FRESULT res = f_lseek(&_fatfs_fil, size);
 
 			switch(res) {
@@ -952,9 +952,19 @@ struct Fatfs_fs::Main
 
 	Fatfs::FATFS _fatfs;
 
+	enum { DEFAULT_CACHE_SIZE = 512*1024 };
+
 	Main(Genode::Env &env) : _env(env)
 	{
-		Fatfs::block_init(_env, _heap);
+		{
+			Genode::Attached_rom_dataspace config(_env, "config");
+
+			Genode::Number_of_bytes const cache_size =
+				config.xml().attribute_value("cache_size",
+					Genode::Number_of_bytes(DEFAULT_CACHE_SIZE));
+
+			Fatfs::block_init(_env, _heap, cache_size);
+		}
 
 		using namespace File_system;
 		using namespace Fatfs;
@@ -182,7 +182,7 @@ class Fuse_fs::Directory : public Node
 			if (S_ISDIR(s.st_mode))
 				node = new (&_alloc) Directory(_alloc, node_path.base(), false);
 			else if (S_ISREG(s.st_mode))
-				node = new (&_alloc) File(this, path, STAT_ONLY);
+				node = new (&_alloc) File(_alloc, this, path, STAT_ONLY);
 			else if (S_ISLNK(s.st_mode))
 				node = new (&_alloc) Symlink(this, path, false);
 			else
@@ -39,6 +39,37 @@ class Fuse_fs::File : public Node
 
 		struct fuse_file_info  _file_info;
 
+		Allocator &_alloc;
+
+		/*
+		 * Read-ahead buffer, filled by reads smaller than the read-ahead
+		 * size and accessed by 'read_buffered' without the FUSE lock
+		 */
+		Lock        _ra_lock;
+		char       *_ra_buf    = nullptr;
+		size_t      _ra_size   = 0;
+		seek_off_t  _ra_offset = 0;
+		size_t      _ra_length = 0;
+		bool        _ra_eof    = false;
+
+		bool _alloc_ra_buf(size_t size)
+		{
+			if (_ra_buf)
+				return _ra_size == size;
+
+			try {
+				_ra_buf  = (char *)_alloc.alloc(size);
+				_ra_size = size;
+				return true;
+			} catch (...) { return false; }
+		}
+
+		void _invalidate_ra()
+		{
+			Lock::Guard guard(_ra_lock);
+			_ra_length = 0;
+		}
+
 		void _open_path(char const *path, Mode mode, bool create, bool trunc)
 		{
 			int res;
@@ -94,12 +125,13 @@ class Fuse_fs::File : public Node
 
 	public:
 
-		File(Node *parent, char const *name, Mode mode,
+		File(Allocator &alloc, Node *parent, char const *name, Mode mode,
 		     bool create = false, bool trunc = false)
 		:
 			Node(name),
 			_parent(parent),
-			_path(name, _parent->name())
+			_path(name, _parent->name()),
+			_alloc(alloc)
 		{
 			_open_path(_path.base(), mode, create, trunc);
 		}
@@ -107,6 +139,9 @@ class Fuse_fs::File : public Node
 		~File()
 		{
 			Fuse::fuse()->op.release(_path.base(), &_file_info);
+
+			if (_ra_buf)
+				_alloc.free(_ra_buf, _ra_size);
 		}
 
 		struct fuse_file_info *file_info() { return &_file_info; }
@@ -125,15 +160,57 @@ class Fuse_fs::File : public Node
 			return status;
 		}
 
+		bool read_buffered(char *dst, size_t len, seek_off_t seek_offset,
+		                   size_t &out_len) override
+		{
+			if (seek_offset == ~0ULL)
+				return false;
+
+			Lock::Guard guard(_ra_lock);
+
+			seek_off_t const end = _ra_offset + _ra_length;
+
+			if (!_ra_length || seek_offset < _ra_offset || seek_offset >= end)
+				return false;
+
+			if (seek_offset + len > end && !_ra_eof)
+				return false;
+
+			out_len = min(len, (size_t)(end - seek_offset));
+			memcpy(dst, _ra_buf + (seek_offset - _ra_offset), out_len);
+			return true;
+		}
+
 		size_t read(char *dst, size_t len, seek_off_t seek_offset) override
 		{
 			/* append mode, use actual length as offset */
 			if (seek_offset == ~0ULL)
 				seek_offset = _length();
 
-			int ret = Fuse::fuse()->op.read(_path.base(), dst, len,
+			size_t const ra_size = Fuse::fuse()->conn.max_readahead;
+
+			if (len >= ra_size || !_alloc_ra_buf(ra_size)) {
+				int ret = Fuse::fuse()->op.read(_path.base(), dst, len,
+				                                seek_offset, &_file_info);
+				return ret < 0 ? 0 : ret;
+			}
+
+			Lock::Guard guard(_ra_lock);
+
+			int ret = Fuse::fuse()->op.read(_path.base(), _ra_buf, _ra_size,
 			                                seek_offset, &_file_info);
-			return ret < 0 ? 0 : ret;
+			if (ret < 0) {
+				_ra_length = 0;
+				return 0;
+			}
+
+			_ra_offset = seek_offset;
+			_ra_length = ret;
+			_ra_eof    = (size_t)ret < _ra_size;
+
+			size_t const n = min(len, (size_t)ret);
+			memcpy(dst, _ra_buf, n);
+			return n;
 		}
 
 		size_t write(char const *src, size_t len, seek_off_t seek_offset) override
@@ -142,13 +219,32 @@ class Fuse_fs::File : public Node
 			if (seek_offset == ~0ULL)
 				seek_offset = _length();
 
-			int ret = Fuse::fuse()->op.write(_path.base(), src, len,
-			                                 seek_offset, &_file_info);
-			return ret < 0 ? 0 : ret;
+			_invalidate_ra();
+
+			/* without big writes, the file system expects single pages */
+			struct fuse_conn_info const &conn = Fuse::fuse()->conn;
+			size_t const max_write = (conn.want & FUSE_CAP_BIG_WRITES)
+			                       ? conn.max_write : 4096;
+
+			size_t written = 0;
+			while (written < len) {
+				size_t const n = min(len - written, max_write);
+
+				int ret = Fuse::fuse()->op.write(_path.base(), src + written, n,
+				                                 seek_offset + written,
+				                                 &_file_info);
+				if (ret <= 0)
+					break;
+
+				written += ret;
+			}
+			return written;
 		}
 
 		void truncate(file_size_t size) override
 		{
+			_invalidate_ra();
+
 			int res = Fuse::fuse()->op.ftruncate(_path.base(), size,
 			                                     &_file_info);
 			if (res == 0)
@@ -25,6 +25,7 @@
 
 /* local includes */
 #include <directory.h>
+#include <job_queue.h>
 #include <open_node.h>
 #include <util.h>
 
@@ -55,6 +56,32 @@ class Fuse_fs::Session_component : public Session_rpc_object
 
 		Signal_handler<Session_component> _process_packet_handler;
 
+		Job_queue &_jobs;
+
+		/*
+		 * At most one packet of a session is processed by a worker at a
+		 * time, which keeps the order of the session's packets.
+		 */
+		Lock      _busy_lock;
+		bool      _busy    = false;
+		bool      _waiting = false;
+		bool      _closing = false;
+		Semaphore _idle;
+
+		/**
+		 * Wait until no worker processes a packet of the session
+		 */
+		void _wait_for_worker()
+		{
+			{
+				Lock::Guard guard(_busy_lock);
+				if (!_busy)
+					return;
+				_waiting = true;
+			}
+			_idle.down();
+		}
+
 
 		/******************************
 		 ** Packet-stream processing **
@@ -76,13 +103,22 @@ class Fuse_fs::Session_component : public Session_rpc_object
 			switch (packet.operation()) {
 
 			case Packet_descriptor::READ:
-				if (content && (packet.length() <= packet.size()))
-					res_length = open_node.node().read((char *)content, length, packet.position());
+				if (content && (packet.length() <= packet.size())) {
+					Node &node = open_node.node();
+					if (node.read_buffered((char *)content, length,
+					                       packet.position(), res_length))
+						break;
+
+					Lock::Guard guard(fuse_lock());
+					res_length = node.read((char *)content, length, packet.position());
+				}
 				break;
 
 			case Packet_descriptor::WRITE:
-				if (content && (packet.length() <= packet.size()))
+				if (content && (packet.length() <= packet.size())) {
+					Lock::Guard guard(fuse_lock());
 					res_length = open_node.node().write((char const *)content, length, packet.position());
+				}
 				break;
 
 			case Packet_descriptor::CONTENT_CHANGED:
@@ -97,7 +133,10 @@ class Fuse_fs::Session_component : public Session_rpc_object
 				break;
 
 			case Packet_descriptor::SYNC:
-				Fuse::sync_fs();
+				{
+					Lock::Guard guard(fuse_lock());
+					Fuse::sync_fs();
+				}
 				break;
 			}
 
@@ -106,10 +145,8 @@ class Fuse_fs::Session_component : public Session_rpc_object
 			tx_sink()->acknowledge_packet(packet);
 		}
 
-		void _process_packet()
+		void _process_packet(Packet_descriptor packet)
 		{
-			Packet_descriptor packet = tx_sink()->get_packet();
-
 			/* assume failure by default */
 			packet.succeeded(false);
 
@@ -133,6 +170,12 @@ class Fuse_fs::Session_component : public Session_rpc_object
 		{
 			while (tx_sink()->packet_avail()) {
 
+				{
+					Lock::Guard guard(_busy_lock);
+					if (_busy)
+						return;
+				}
+
 				/*
 				 * Make sure that the '_process_packet' function does not
 				 * block.
@@ -148,7 +191,26 @@ class Fuse_fs::Session_component : public Session_rpc_object
 				if (!tx_sink()->ready_to_ack())
 					return;
 
-				_process_packet();
+				Packet_descriptor const packet = tx_sink()->get_packet();
+
+				bool const reads_or_writes =
+					packet.operation() == Packet_descriptor::READ  ||
+					packet.operation() == Packet_descriptor::WRITE ||
+					packet.operation() == Packet_descriptor::SYNC;
+
+				if (reads_or_writes) {
+					Lock::Guard guard(_busy_lock);
+
+					_busy = _jobs.put(Job_queue::Job { this, packet });
+					if (_busy)
+						return;
+				}
+
+				/*
+				 * Process notification requests, which call no FUSE
+				 * operation, and packets not taken by a worker in place
+				 */
+				_process_packet(packet);
 			}
 		}
 
@@ -172,14 +234,16 @@ class Fuse_fs::Session_component : public Session_rpc_object
 		                  Genode::Env &env,
 		                  char const *root_dir,
 		                  bool        writeable,
-		                  Allocator  &md_alloc)
+		                  Allocator  &md_alloc,
+		                  Job_queue  &jobs)
 		:
 			Session_rpc_object(env.ram().alloc(tx_buf_size), env.rm(), env.ep().rpc_ep()),
 			_env(env),
 			_md_alloc(md_alloc),
 			_root(*new (&_md_alloc) Directory(_md_alloc, root_dir, false)),
 			_writeable(writeable),
-			_process_packet_handler(_env.ep(), *this, &Session_component::_process_packets)
+			_process_packet_handler(_env.ep(), *this, &Session_component::_process_packets),
+			_jobs(jobs)
 		{
 			_tx.sigh_packet_avail(_process_packet_handler);
 			_tx.sigh_ready_to_ack(_process_packet_handler);
@@ -190,6 +254,14 @@ class Fuse_fs::Session_component : public Session_rpc_object
 		 */
 		~Session_component()
 		{
+			{
+				Lock::Guard guard(_busy_lock);
+				_closing = true;
+			}
+			_wait_for_worker();
+
+			Lock::Guard guard(fuse_lock());
+
 			Fuse::sync_fs();
 
 			Dataspace_capability ds = tx_sink()->dataspace();
@@ -197,6 +269,28 @@ class Fuse_fs::Session_component : public Session_rpc_object
 			destroy(&_md_alloc, &_root);
 		}
 
+		/**
+		 * Process packet, called by a worker thread
+		 */
+		void process_job(Packet_descriptor const &packet)
+		{
+			_process_packet(packet);
+
+			bool wake_up = false;
+			{
+				Lock::Guard guard(_busy_lock);
+				_busy    = false;
+				wake_up  = _waiting;
+				_waiting = false;
+
+				/* continue with the packets queued in the meantime */
+				if (!_closing)
+					Signal_transmitter(_process_packet_handler).submit();
+			}
+			if (wake_up)
+				_idle.up();
+		}
+
 
 		/***************************
 		 ** File_system interface **
@@ -204,6 +298,8 @@ class Fuse_fs::Session_component : public Session_rpc_object
 
 		File_handle file(Dir_handle dir_handle, Name const &name, Mode mode, bool create)
 		{
+			Lock::Guard guard(fuse_lock());
+
 			if (!valid_filename(name.string()))
 				throw Invalid_name();
 
@@ -214,7 +310,7 @@ class Fuse_fs::Session_component : public Session_rpc_object
 				if (create && !_writeable)
 					throw Permission_denied();
 
-				File *file = new (&_md_alloc) File(&dir, name.string(), mode, create);
+				File *file = new (&_md_alloc) File(_md_alloc, &dir, name.string(), mode, create);
 
 				Open_node *open_file =
 					new (_md_alloc) Open_node(*file, _open_node_registry);
@@ -233,6 +329,8 @@ class Fuse_fs::Session_component : public Session_rpc_object
 
 		Symlink_handle symlink(Dir_handle dir_handle, Name const &name, bool create)
 		{
+			Lock::Guard guard(fuse_lock());
+
 			if (! Fuse::support_symlinks()) {
 				Genode::error("FUSE file system does not support symlinks");
 				throw Permission_denied();
@@ -265,6 +363,8 @@ class Fuse_fs::Session_component : public Session_rpc_object
 
 		Dir_handle dir(Path const &path, bool create)
 		{
+			Lock::Guard guard(fuse_lock());
+
 			char const *path_str = path.string();
 
 			_assert_valid_path(path_str);
@@ -285,6 +385,8 @@ class Fuse_fs::Session_component : public Session_rpc_object
 
 		Node_handle node(Path const &path)
 		{
+			Lock::Guard guard(fuse_lock());
+
 			char const *path_str = path.string();
 
 			_assert_valid_path(path_str);
@@ -303,6 +405,11 @@ class Fuse_fs::Session_component : public Session_rpc_object
 
 		void close(Node_handle handle)
 		{
+			/* the node may be in use by a worker */
+			_wait_for_worker();
+
+			Lock::Guard guard(fuse_lock());
+
 			auto close_fn = [&] (Open_node &open_node) {
 				Node &node = open_node.node();
 				destroy(_md_alloc, &open_node);
@@ -318,6 +425,8 @@ class Fuse_fs::Session_component : public Session_rpc_object
 
 		Status status(Node_handle node_handle)
 		{
+			Lock::Guard guard(fuse_lock());
+
 			auto status_fn = [&] (Open_node &open_node) {
 				return open_node.node().status();
 			};
@@ -336,6 +445,8 @@ class Fuse_fs::Session_component : public Session_rpc_object
 
 		void unlink(Dir_handle dir_handle, Name const &name)
 		{
+			Lock::Guard guard(fuse_lock());
+
 			if (!_writeable)
 				throw Permission_denied();
 
@@ -371,6 +482,8 @@ class Fuse_fs::Session_component : public Session_rpc_object
 
 		void truncate(File_handle file_handle, file_size_t size)
 		{
+			Lock::Guard guard(fuse_lock());
+
 			if (!_writeable)
 				throw Permission_denied();
 
@@ -388,6 +501,8 @@ class Fuse_fs::Session_component : public Session_rpc_object
 		void move(Dir_handle from_dir_handle, Name const &from_name,
 			  Dir_handle to_dir_handle,   Name const &to_name)
 		{
+			Lock::Guard guard(fuse_lock());
+
 			if (!_writeable)
 				throw Permission_denied();
 			
@@ -445,6 +560,8 @@ class Fuse_fs::Root : public Root_component<Session_component>
 		Genode::Env                   &_env;
 		Genode::Attached_rom_dataspace _config { _env, "config" };
 
+		Job_queue &_jobs;
+
 	protected:
 
 		Session_component *_create_session(const char *args)
@@ -525,7 +642,8 @@ class Fuse_fs::Root : public Root_component<Session_component>
 				throw Insufficient_ram_quota();
 			}
 			return new (md_alloc())
-				Session_component(tx_buf_size, _env, root_dir, writeable, *md_alloc());
+				Session_component(tx_buf_size, _env, root_dir, writeable,
+				                  *md_alloc(), _jobs);
 		}
 
 	public:
@@ -536,17 +654,41 @@ class Fuse_fs::Root : public Root_component<Session_component>
 		 * \param env         environment
 		 * \param md_alloc    meta-data allocator
 		 */
-		Root(Genode::Env & env, Allocator &md_alloc)
+		Root(Genode::Env & env, Allocator &md_alloc, Job_queue &jobs)
 		: Root_component<Session_component>(env.ep(), md_alloc),
-		  _env(env) { }
+		  _env(env), _jobs(jobs) { }
+
+		/**
+		 * Apply the FUSE connection parameters of the config
+		 */
+		void configure_fuse(struct fuse_conn_info &conn)
+		{
+			Xml_node const config = _config.xml();
+
+			conn.max_readahead = config.attribute_value("readahead",
+				Number_of_bytes(conn.max_readahead));
+			conn.max_write     = config.attribute_value("max_write",
+				Number_of_bytes(conn.max_write));
+
+			if (!config.attribute_value("big_writes", true))
+				conn.want &= ~FUSE_CAP_BIG_WRITES;
+		}
+
+		/**
+		 * Return number of worker threads configured
+		 */
+		unsigned workers() {
+			return _config.xml().attribute_value("workers", 2U); }
 };
 
 
 struct Fuse_fs::Main
 {
 	Genode::Env & env;
+	Heap          heap        { env.ram(), env.rm() };
 	Sliced_heap   sliced_heap { env.ram(), env.rm() };
-	Root          fs_root     { env, sliced_heap    };
+	Job_queue     jobs        { };
+	Root          fs_root     { env, sliced_heap, jobs };
 
 	Main(Genode::Env & env) : env(env)
 	{
@@ -555,6 +697,10 @@ struct Fuse_fs::Main
 			return;
 		}
 
+		fs_root.configure_fuse(Fuse::fuse()->conn);
+
+		jobs.start_workers(env, heap, fs_root.workers());
+
 		env.parent().announce(env.ep().manage(fs_root));
 	}
 
@@ -567,6 +713,15 @@ struct Fuse_fs::Main
 };
 
 
+void Fuse_fs::Job_queue::Worker::entry()
+{
+	for (;;) {
+		Job const job = jobs.get();
+		job.session->process_job(job.packet);
+	}
+}
+
+
 /***************
  ** Component **
  ***************/
@@ -0,0 +1,137 @@
+/*
+ * \brief  Packets processed by worker threads
+ * \author Genode Labs
+ * \date   2026-10-14
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _JOB_QUEUE_H_
+#define _JOB_QUEUE_H_
+
+/* Genode includes */
+#include <base/lock.h>
+#include <base/semaphore.h>
+#include <base/thread.h>
+#include <file_system_session/file_system_session.h>
+
+namespace Fuse_fs {
+
+	struct Session_component;
+	class  Job_queue;
+
+	/**
+	 * Lock serializing the calls of FUSE operations
+	 *
+	 * The FUSE file-system implementations are not reentrant. Packets
+	 * served from a read-ahead buffer do not need the lock.
+	 */
+	inline Genode::Lock &fuse_lock()
+	{
+		static Genode::Lock lock;
+		return lock;
+	}
+}
+
+
+/**
+ * Packets handed over from the entrypoint to the worker threads
+ *
+ * While a worker executes a FUSE operation or copies packet payload, the
+ * entrypoint keeps serving RPCs and signals and other workers serve
+ * packets from read-ahead buffers.
+ */
+class Fuse_fs::Job_queue
+{
+	public:
+
+		struct Job
+		{
+			Session_component                *session;
+			File_system::Packet_descriptor    packet;
+		};
+
+	private:
+
+		enum { SIZE = 64, STACK_SIZE = 64*1024*sizeof(long) };
+
+		struct Worker : Genode::Thread
+		{
+			Job_queue &jobs;
+
+			Worker(Genode::Env &env, Job_queue &jobs)
+			: Genode::Thread(env, "fuse_worker", STACK_SIZE), jobs(jobs)
+			{
+				start();
+			}
+
+			void entry() override;
+		};
+
+		Genode::Lock      _lock;
+		Genode::Semaphore _avail;
+
+		Job      _jobs[SIZE];
+		unsigned _head  = 0;
+		unsigned _tail  = 0;
+		unsigned _count = 0;
+
+		unsigned _workers = 0;
+
+	public:
+
+		/**
+		 * Start worker threads
+		 */
+		void start_workers(Genode::Env &env, Genode::Allocator &alloc,
+		                   unsigned count)
+		{
+			for (unsigned i = 0; i < count; i++)
+				new (alloc) Worker(env, *this);
+
+			_workers += count;
+		}
+
+		/**
+		 * Enqueue job
+		 *
+		 * \return false if the queue is full or there are no workers
+		 */
+		bool put(Job const &job)
+		{
+			{
+				Genode::Lock::Guard guard(_lock);
+
+				if (!_workers || _count == SIZE)
+					return false;
+
+				_jobs[_head] = job;
+				_head = (_head + 1) % SIZE;
+				_count++;
+			}
+			_avail.up();
+			return true;
+		}
+
+		/**
+		 * Dequeue job, block until a job is available
+		 */
+		Job get()
+		{
+			_avail.down();
+
+			Genode::Lock::Guard guard(_lock);
+
+			Job const job = _jobs[_tail];
+			_tail = (_tail + 1) % SIZE;
+			_count--;
+			return job;
+		}
+};
+
+#endif /* _JOB_QUEUE_H_ */
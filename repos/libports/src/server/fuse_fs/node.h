@@ -47,6 +47,15 @@ class Fuse_fs::Node : public Node_base
 		char   const *name()  const { return _name.base(); }
 
 		virtual size_t read(char *dst, size_t len, seek_off_t) = 0;
+
+		/**
+		 * Read from buffered data without calling a FUSE operation
+		 *
+		 * \return true if the request was served from the buffer
+		 */
+		virtual bool read_buffered(char *dst, size_t len, seek_off_t,
+		                           size_t &out_len) { return false; }
+
 		virtual size_t write(char const *src, size_t len, seek_off_t) = 0;
 		virtual Status status() = 0;
 
@@ -0,0 +1,82 @@
+/*
+ * \brief  Benchmark of the dynamic linker's relocation costs
+ * \author Genode Labs
+ * \date   2026-10-14
+ *
+ * Each '<library>' node of the config names a shared library that is
+ * loaded and unloaded repeatedly via the 'Shared_object' API, once with
+ * lazy and once with immediate binding. The reported duration comprises
+ * the loading, relocation, and construction of the library and its
+ * dependencies that are not already loaded.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/component.h>
+#include <base/attached_rom_dataspace.h>
+#include <base/heap.h>
+#include <base/log.h>
+#include <base/shared_object.h>
+#include <timer_session/connection.h>
+
+using namespace Genode;
+
+
+struct Main
+{
+	typedef String<64> Name;
+
+	Env &_env;
+
+	Heap _heap { _env.ram(), _env.rm() };
+
+	Timer::Connection _timer { _env };
+
+	Attached_rom_dataspace _config { _env, "config" };
+
+	unsigned const _rounds = _config.xml().attribute_value("rounds", 10U);
+
+	/**
+	 * Return average duration of loading the library in microseconds
+	 */
+	unsigned long _measure(Name const &name, Shared_object::Bind bind)
+	{
+		unsigned long const start_us = _timer.elapsed_us();
+
+		for (unsigned i = 0; i < _rounds; i++)
+			Shared_object(_env, _heap, name.string(), bind,
+			              Shared_object::DONT_KEEP);
+
+		return (_timer.elapsed_us() - start_us) / _rounds;
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		log("--- ldso start-up benchmark (", _rounds, " rounds) ---");
+
+		_config.xml().for_each_sub_node("library", [&] (Xml_node node) {
+
+			Name const name = node.attribute_value("name", Name());
+
+			try {
+				unsigned long const lazy_us = _measure(name, Shared_object::BIND_LAZY);
+				unsigned long const now_us  = _measure(name, Shared_object::BIND_NOW);
+
+				log(name, ": lazy ", lazy_us, " us, now ", now_us, " us");
+			}
+			catch (Shared_object::Invalid_rom_module) {
+				error(name, ": unable to load library"); }
+		});
+
+		log("--- ldso start-up benchmark finished ---");
+	}
+};
+
+
+void Component::construct(Env &env) { static Main main(env); }
@@ -24,6 +24,19 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
+
+
+/* provided by Genode's libc */
+extern "C" void malloc_stats(void);
+
+
+static unsigned long now_ms()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec*1000 + ts.tv_nsec/1000000;
+}
 
 
 int main(int argc, char **argv)
@@ -117,5 +130,25 @@ int main(int argc, char **argv)
 		}
 	}
 
+	printf("Malloc: benchmark small allocations\n");
+	{
+		enum { BENCH_ROUNDS = 10000, BENCH_BLOCKS = 32 };
+
+		unsigned long const start = now_ms();
+
+		void *addr[BENCH_BLOCKS];
+		for (unsigned round = 0; round < BENCH_ROUNDS; ++round) {
+			for (unsigned i = 0; i < BENCH_BLOCKS; ++i)
+				addr[i] = malloc(16 + 61*i);
+			for (unsigned i = 0; i < BENCH_BLOCKS; ++i)
+				free(addr[i]);
+		}
+
+		printf("%u malloc/free pairs took %lu ms\n",
+		       BENCH_ROUNDS*BENCH_BLOCKS, now_ms() - start);
+	}
+
+	malloc_stats();
+
 	exit(error_count);
 }
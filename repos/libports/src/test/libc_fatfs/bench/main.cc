@@ -0,0 +1,130 @@
+/*
+ * \brief  Throughput of the FatFs libc plugin
+ * \author Genode Labs
+ * \date   2026-10-14
+ *
+ * The benchmark writes a file and reads it sequentially, backwards, and at
+ * random offsets. The backward and random reads exercise the fast-seek
+ * mode, the small random reads and the metadata accesses the sector cache.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <libc/component.h>
+#include <timer_session/connection.h>
+
+/* libc includes */
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+enum {
+	FILE_SIZE   = 16*1024*1024,
+	BLOCK_SIZE  = 64*1024,
+	SMALL_SIZE  = 4*1024,
+	NUM_RANDOM  = 2048,
+};
+
+static char buf[BLOCK_SIZE];
+
+static char const *file_name = "bench.tst";
+
+
+struct Main
+{
+	Libc::Env &_env;
+
+	Timer::Connection _timer { _env };
+
+	void _report(char const *test, unsigned long start_ms, size_t bytes)
+	{
+		unsigned long const ms = Genode::max(_timer.elapsed_ms() - start_ms, 1UL);
+
+		printf("%-16s %8lu ms %8lu KiB/s\n", test, ms,
+		       (unsigned long)((bytes/1024)*1000/ms));
+	}
+
+	void _check(bool condition, char const *test)
+	{
+		if (condition)
+			return;
+
+		printf("Error: %s failed\n", test);
+		exit(-1);
+	}
+
+	void _write()
+	{
+		unlink(file_name);
+
+		int const fd = open(file_name, O_CREAT | O_RDWR);
+		_check(fd >= 0, "open");
+
+		unsigned long const start = _timer.elapsed_ms();
+		for (size_t i = 0; i < FILE_SIZE; i += BLOCK_SIZE) {
+			memset(buf, (int)(i / BLOCK_SIZE), BLOCK_SIZE);
+			_check(write(fd, buf, BLOCK_SIZE) == BLOCK_SIZE, "write");
+		}
+		fsync(fd);
+		_report("write", start, FILE_SIZE);
+
+		close(fd);
+	}
+
+	void _read(char const *test, size_t size, unsigned count,
+	           off_t (*offset)(unsigned))
+	{
+		int const fd = open(file_name, O_RDONLY);
+		_check(fd >= 0, "open");
+
+		unsigned long const start = _timer.elapsed_ms();
+		for (unsigned i = 0; i < count; i++) {
+			off_t const o = offset(i);
+			_check(lseek(fd, o, SEEK_SET) == o, test);
+			_check(read(fd, buf, size) == (ssize_t)size, test);
+			_check(buf[0] == (char)(o / BLOCK_SIZE), test);
+		}
+		_report(test, start, size*count);
+
+		close(fd);
+	}
+
+	static off_t _sequential(unsigned i) { return (off_t)i*BLOCK_SIZE; }
+
+	static off_t _backward(unsigned i) {
+		return FILE_SIZE - (off_t)(i + 1)*BLOCK_SIZE; }
+
+	static off_t _random(unsigned)
+	{
+		return (off_t)(random() % (FILE_SIZE / SMALL_SIZE))*SMALL_SIZE;
+	}
+
+	Main(Libc::Env &env) : _env(env)
+	{
+		Libc::with_libc([&] () {
+
+			printf("--- FatFs benchmark ---\n");
+
+			_write();
+			_read("sequential read", BLOCK_SIZE, FILE_SIZE/BLOCK_SIZE, _sequential);
+			_read("backward read",   BLOCK_SIZE, FILE_SIZE/BLOCK_SIZE, _backward);
+			_read("random read",     SMALL_SIZE, NUM_RANDOM,           _random);
+
+			unlink(file_name);
+
+			printf("--- FatFs benchmark finished ---\n");
+		});
+		_env.parent().exit(0);
+	}
+};
+
+
+void Libc::Component::construct(Libc::Env &env) { static Main main(env); }
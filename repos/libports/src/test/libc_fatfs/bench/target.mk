@@ -0,0 +1,3 @@
+TARGET = test-libc_fatfs_bench
+LIBS   = libc libc_fatfs
+SRC_CC = main.cc
@@ -0,0 +1,119 @@
+/*
+ * \brief  Test kqueue() and kevent() in libc
+ * \author Genode Labs
+ * \date   2026-10-14
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* libc includes */
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/event.h>
+#include <sys/types.h>
+
+
+static void die(char const *token) __attribute__((noreturn));
+static void die(char const *token)
+{
+	printf("Error: %s: %s\n", token, strerror(errno));
+	exit(1);
+}
+
+
+static void test_errors(int kq)
+{
+	struct kevent change;
+
+	/* deleting an unregistered event is reported in the event list */
+	EV_SET(&change, 0, EVFILT_READ, EV_DELETE, 0, 0, 0);
+
+	struct kevent ev;
+	struct timespec const timeout_0 { 0, 0 };
+	int const n = kevent(kq, &change, 1, &ev, 1, &timeout_0);
+	if (n != 1 || !(ev.flags & EV_ERROR) || ev.data != ENOENT)
+		die("EV_DELETE of unregistered event");
+
+	/* without an event list, the error is returned */
+	if (kevent(kq, &change, 1, nullptr, 0, &timeout_0) != -1 || errno != ENOENT)
+		die("EV_DELETE without event list");
+
+	/* unsupported filter */
+	EV_SET(&change, 0, EVFILT_TIMER, EV_ADD, 0, 0, 0);
+	if (kevent(kq, &change, 1, nullptr, 0, &timeout_0) != -1 || errno != EINVAL)
+		die("unsupported filter");
+
+	printf("error handling: ok\n");
+}
+
+
+int main(int argc, char **argv)
+{
+	if (argc < 2) {
+		printf("usage: %s <file to watch>\n", argv[0]);
+		return 1;
+	}
+
+	int const kq = kqueue();
+	if (kq == -1)
+		die("kqueue");
+
+	test_errors(kq);
+
+	int const fd = open(argv[1], O_RDONLY);
+	if (fd == -1)
+		die("open");
+
+	struct kevent change;
+	EV_SET(&change, fd, EVFILT_READ, EV_ADD, 0, 0, (void *)argv[1]);
+	if (kevent(kq, &change, 1, nullptr, 0, nullptr) == -1)
+		die("kevent EV_ADD");
+
+	enum { ROUNDS = 10 };
+	for (unsigned round = 0; round < ROUNDS; ) {
+
+		struct kevent ev;
+		struct timespec const timeout { 1, 0 };
+
+		int const n = kevent(kq, nullptr, 0, &ev, 1, &timeout);
+		if (n == -1)
+			die("kevent");
+
+		if (n == 0) {
+			printf("timeout\n");
+			continue;
+		}
+
+		if ((int)ev.ident != fd || ev.filter != EVFILT_READ || ev.udata != argv[1])
+			die("unexpected event");
+
+		char buf[128];
+		ssize_t const nbytes = read(fd, buf, sizeof(buf) - 1);
+		if (nbytes < 0)
+			die("read");
+
+		buf[nbytes] = 0;
+		printf("round %u: read %zd bytes from %s\n", ++round, nbytes,
+		       (char const *)ev.udata);
+	}
+
+	/* remove the registration */
+	EV_SET(&change, fd, EVFILT_READ, EV_DELETE, 0, 0, 0);
+	if (kevent(kq, &change, 1, nullptr, 0, nullptr) == -1)
+		die("kevent EV_DELETE");
+
+	close(kq);
+	close(fd);
+
+	printf("test succeeded\n");
+	return 0;
+}
@@ -20,6 +20,7 @@
 #include <fcntl.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/mman.h>
 
 namespace Test {
 	class Buffer;
@@ -194,6 +195,40 @@ class Test::Block_device
 
 			return result;
 		}
+
+		/**
+		 * Check content like 'expect' but access the device via 'mmap'
+		 */
+		bool expect_mapped(Block_number block_number, char const *content)
+		{
+			size_t const content_len = strlen(content);
+			size_t const length = BLOCK_SIZE*(block_number.value + content_len);
+
+			char const * const ptr = (char const *)
+				mmap(nullptr, length, PROT_READ, MAP_SHARED, _fd.value, 0);
+			if (ptr == MAP_FAILED) {
+				Genode::error("could not map block device");
+				return false;
+			}
+
+			bool result = true;
+			for (unsigned i = 0; i < content_len; i++) {
+
+				char const c = ptr[BLOCK_SIZE*(block_number.value + i)];
+				if (c == content[i])
+					continue;
+
+				Genode::error("unexpected mapped content "
+				              "at block ", block_number.value + i, ", "
+				              "got ",      Genode::Char(c), ", "
+				              "expected ", Genode::Char(content[i]));
+
+				result = false;
+			}
+
+			munmap((void *)ptr, length);
+			return result;
+		}
 };
 
 
@@ -253,6 +288,17 @@ void Test::Main::_exec_step(Genode::Xml_node step, Block_device &block_device)
 		Genode::error("step '", step, "' failed");
 		throw Step_failed();
 	}
+
+	if (step.has_type("expect_mapped")) {
+		Block_device::Block_number const at{ step.attribute_value("at", 0UL)};
+		Content const content = step.attribute_value("content", Content());
+		Genode::log("expect_mapped at=", at.value, " content=\"", content, "\"");
+		if (block_device.expect_mapped(at, content.string()))
+			return;
+
+		Genode::error("step '", step, "' failed");
+		throw Step_failed();
+	}
 }
 
 
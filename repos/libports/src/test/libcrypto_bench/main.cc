@@ -0,0 +1,180 @@
+/*
+ * \brief  Throughput benchmark of libcrypto
+ * \author Genode Labs
+ * \date   2026-10-14
+ *
+ * The benchmark measures the throughput of the ciphers and digests common
+ * in TLS and the rate of RSA signatures, which are dominated by the
+ * Montgomery multiplication. Each result is logged in MiB/s or operations
+ * per second together with the CPU capabilities detected by libcrypto.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <libc/component.h>
+#include <timer_session/connection.h>
+#include <base/attached_rom_dataspace.h>
+#include <base/log.h>
+
+/* libc includes */
+#include <openssl/crypto.h>
+#include <openssl/evp.h>
+#include <openssl/rsa.h>
+#include <openssl/bn.h>
+#include <openssl/objects.h>
+
+namespace Libcrypto_bench {
+	using namespace Genode;
+	struct Main;
+}
+
+
+struct Libcrypto_bench::Main
+{
+	enum { BUF_SIZE = 16*1024 };
+
+	Env &_env;
+
+	Timer::Connection _timer { _env };
+
+	Attached_rom_dataspace _config { _env, "config" };
+
+	unsigned const _duration_ms =
+		max(10U, _config.xml().attribute_value("duration_ms", 1000U));
+
+	unsigned char _in [BUF_SIZE];
+	unsigned char _out[BUF_SIZE + EVP_MAX_BLOCK_LENGTH];
+
+	struct Failed : Exception { };
+
+	/**
+	 * Call 'fn' repeatedly for the configured duration and log the rate
+	 *
+	 * \param per_call  amount of 'unit' processed per call
+	 */
+	template <typename FN>
+	void _measure(char const *name, char const *unit, double per_call, FN const &fn)
+	{
+		unsigned long       calls = 0;
+		unsigned long const start = _timer.elapsed_ms();
+		unsigned long       now   = start;
+
+		while (now - start < _duration_ms) {
+			for (unsigned i = 0; i < 8; i++, calls++)
+				if (!fn()) {
+					error(name, " failed");
+					throw Failed();
+				}
+			now = _timer.elapsed_ms();
+		}
+
+		/* report rates with two decimal places */
+		unsigned long const rate =
+			(unsigned long)(100.0*per_call*calls*1000/(now - start));
+
+		log(name, ": ", rate/100, ".", rate/10 % 10, rate % 10, " ", unit);
+	}
+
+	void _bench_cipher(char const *name, EVP_CIPHER const *cipher)
+	{
+		static unsigned char const key[EVP_MAX_KEY_LENGTH] = { 1, 2, 3 };
+		static unsigned char const iv [EVP_MAX_IV_LENGTH]  = { 4, 5, 6 };
+
+		EVP_CIPHER_CTX ctx;
+		EVP_CIPHER_CTX_init(&ctx);
+
+		EVP_EncryptInit_ex(&ctx, cipher, NULL, key, iv);
+
+		_measure(name, "MiB/s", (double)BUF_SIZE/(1024*1024), [&] () {
+			int out_len = 0;
+			return EVP_EncryptUpdate(&ctx, _out, &out_len, _in, BUF_SIZE) == 1;
+		});
+
+		EVP_CIPHER_CTX_cleanup(&ctx);
+	}
+
+	void _bench_digest(char const *name, EVP_MD const *md)
+	{
+		EVP_MD_CTX ctx;
+		EVP_MD_CTX_init(&ctx);
+
+		EVP_DigestInit_ex(&ctx, md, NULL);
+
+		_measure(name, "MiB/s", (double)BUF_SIZE/(1024*1024), [&] () {
+			return EVP_DigestUpdate(&ctx, _in, BUF_SIZE) == 1; });
+
+		unsigned char digest[EVP_MAX_MD_SIZE];
+		EVP_DigestFinal_ex(&ctx, digest, NULL);
+		EVP_MD_CTX_cleanup(&ctx);
+	}
+
+	void _bench_rsa(int bits)
+	{
+		RSA    *rsa = RSA_new();
+		BIGNUM *e   = BN_new();
+
+		BN_set_word(e, RSA_F4);
+
+		if (!RSA_generate_key_ex(rsa, bits, e, NULL)) {
+			error("RSA key generation failed");
+			throw Failed();
+		}
+
+		unsigned char hash[32] = { 7, 8, 9 };
+		unsigned char sig[1024];
+		unsigned int  sig_len = 0;
+
+		String<32> const sign_name("RSA-", bits, " sign");
+		_measure(sign_name.string(), "ops/s", 1.0, [&] () {
+			return RSA_sign(NID_sha256, hash, sizeof(hash), sig, &sig_len, rsa) == 1; });
+
+		String<32> const verify_name("RSA-", bits, " verify");
+		_measure(verify_name.string(), "ops/s", 1.0, [&] () {
+			return RSA_verify(NID_sha256, hash, sizeof(hash), sig, sig_len, rsa) == 1; });
+
+		BN_free(e);
+		RSA_free(rsa);
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		Libc::with_libc([&] () {
+
+			for (unsigned i = 0; i < BUF_SIZE; i++)
+				_in[i] = i;
+
+			/* capabilities as used for selecting the code paths */
+			unsigned long const *ia32cap = OPENSSL_ia32cap_loc();
+			if (ia32cap)
+				log("OPENSSL_ia32cap: ", Hex(*ia32cap));
+
+			_bench_cipher("AES-128-CBC", EVP_aes_128_cbc());
+			_bench_cipher("AES-256-CBC", EVP_aes_256_cbc());
+			_bench_cipher("AES-128-CTR", EVP_aes_128_ctr());
+			_bench_cipher("AES-128-GCM", EVP_aes_128_gcm());
+			_bench_cipher("RC4",         EVP_rc4());
+
+			_bench_digest("MD5",     EVP_md5());
+			_bench_digest("SHA-1",   EVP_sha1());
+			_bench_digest("SHA-256", EVP_sha256());
+			_bench_digest("SHA-512", EVP_sha512());
+
+			_bench_rsa(2048);
+		});
+
+		log("benchmark completed");
+		_env.parent().exit(0);
+	}
+};
+
+
+void Libc::Component::construct(Libc::Env &env)
+{
+	static Libcrypto_bench::Main main(env);
+}
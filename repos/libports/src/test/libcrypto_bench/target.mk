@@ -0,0 +1,3 @@
+TARGET = test-libcrypto_bench
+LIBS   = libc libcrypto
+SRC_CC = main.cc
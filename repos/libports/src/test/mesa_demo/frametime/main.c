@@ -0,0 +1,120 @@
+/*
+ * \brief  Frame-time benchmark of the software rasterizer
+ * \author Genode Labs
+ * \date   2026-10-14
+ *
+ * Each frame clears the window and draws a stack of smooth-shaded,
+ * depth-tested quads, each of which covers the whole window. Hence, the
+ * frame time is dominated by rasterization and fragment processing. The
+ * average, minimum, and maximum frame time is reported for each batch of
+ * frames.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#define GL_GLEXT_PROTOTYPES
+#include <GL/gl.h>
+#include <GL/glext.h>
+#include <EGL/egl.h>
+#include "eglut.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+enum {
+	WIDTH       = 600,
+	HEIGHT      = 600,
+	LAYERS      = 4,    /* full-window quads drawn per frame */
+	BATCH       = 100,  /* frames per report */
+	NUM_BATCHES = 5
+};
+
+static unsigned frames, batches;
+static int      last_ms = -1, sum_ms, min_ms, max_ms;
+
+
+static void account_frame(void)
+{
+	int const now_ms = eglutGet(EGLUT_ELAPSED_TIME);
+
+	if (last_ms >= 0) {
+		int const ms = now_ms - last_ms;
+
+		if (frames == 0 || ms < min_ms) min_ms = ms;
+		if (frames == 0 || ms > max_ms) max_ms = ms;
+
+		sum_ms += ms;
+		frames++;
+	}
+	last_ms = now_ms;
+
+	if (frames < BATCH)
+		return;
+
+	printf("frame time: avg %d.%02d ms, min %d ms, max %d ms (%dx%d, %d layers)\n",
+	       sum_ms/BATCH, (sum_ms % BATCH)*100/BATCH, min_ms, max_ms,
+	       WIDTH, HEIGHT, LAYERS);
+
+	frames = 0;
+	sum_ms = 0;
+
+	if (++batches == NUM_BATCHES) {
+		printf("benchmark finished\n");
+		exit(0);
+	}
+}
+
+
+static void idle(void)
+{
+	eglutPostRedisplay();
+}
+
+
+static void render(void)
+{
+	int i;
+
+	glClearColor(0.f, 0.f, 0.f, 0.f);
+	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+	/* draw back to front so that each layer passes the depth test */
+	glBegin(GL_QUADS);
+	for (i = 0; i < LAYERS; i++) {
+		GLfloat const z = 0.9f - 1.8f*i/LAYERS;
+
+		glColor3f(1.f, 0.f,   0.f); glVertex3f(-1.f, -1.f, z);
+		glColor3f(0.f, 1.f,   0.f); glVertex3f( 1.f, -1.f, z);
+		glColor3f(0.f, 0.f,   1.f); glVertex3f( 1.f,  1.f, z);
+		glColor3f(1.f, 1.f, 0.5f);  glVertex3f(-1.f,  1.f, z);
+	}
+	glEnd();
+
+	glFlush();
+
+	account_frame();
+}
+
+
+int eglut_main(int argc, char **argv)
+{
+	eglutInit(argc, argv);
+	eglutInitWindowSize(WIDTH, HEIGHT);
+	eglutInitAPIMask(EGLUT_OPENGL_BIT);
+	eglutCreateWindow("Frame time");
+
+	glEnable(GL_DEPTH_TEST);
+	glDepthFunc(GL_LESS);
+	glShadeModel(GL_SMOOTH);
+
+	eglutIdleFunc(&idle);
+	eglutDisplayFunc(&render);
+
+	eglutMainLoop();
+	return 0;
+}
@@ -11,10 +11,12 @@
  * under the terms of the GNU Affero General Public License version 3.
  */
 
+#include <errno.h>
 #include <pthread.h>
 #include <semaphore.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <time.h>
 
 
 enum { NUM_THREADS = 2 };
@@ -62,6 +64,218 @@ static inline void compare_semaphore_values(int reported_value, int expected_val
     }
 }
 
+static unsigned long now_ms()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec*1000 + ts.tv_nsec/1000000;
+}
+
+
+static void check(bool condition, char const *msg)
+{
+	if (condition)
+		return;
+
+	printf("error: %s\n", msg);
+	exit(-1);
+}
+
+
+/**
+ * Contention benchmark, threads increment a counter protected by a mutex
+ */
+struct Mutex_contention
+{
+	enum { NUM_CONTENDERS = 4, ROUNDS = 100000 };
+
+	pthread_mutex_t mutex;
+	unsigned long   counter = 0;
+
+	static void *contender(void *arg)
+	{
+		Mutex_contention &test = *(Mutex_contention *)arg;
+
+		for (unsigned i = 0; i < ROUNDS; i++) {
+			pthread_mutex_lock(&test.mutex);
+			test.counter++;
+			pthread_mutex_unlock(&test.mutex);
+		}
+		return 0;
+	}
+
+	Mutex_contention(int type)
+	{
+		pthread_mutexattr_t attr;
+		pthread_mutexattr_init(&attr);
+		pthread_mutexattr_settype(&attr, type);
+		pthread_mutex_init(&mutex, &attr);
+		pthread_mutexattr_destroy(&attr);
+
+		unsigned long const start = now_ms();
+
+		pthread_t threads[NUM_CONTENDERS];
+		for (unsigned i = 0; i < NUM_CONTENDERS; i++)
+			check(pthread_create(&threads[i], 0, contender, this) == 0,
+			      "pthread_create() failed");
+
+		for (unsigned i = 0; i < NUM_CONTENDERS; i++)
+			pthread_join(threads[i], 0);
+
+		check(counter == NUM_CONTENDERS*ROUNDS, "mutex did not exclude contenders");
+
+		printf("main thread: mutex type %d, %u threads x %u rounds: %lu ms\n",
+		       type, (unsigned)NUM_CONTENDERS, (unsigned)ROUNDS, now_ms() - start);
+
+		pthread_mutex_destroy(&mutex);
+	}
+};
+
+
+static void test_mutex_types()
+{
+	pthread_mutexattr_t attr;
+	pthread_mutex_t     mutex;
+
+	pthread_mutexattr_init(&attr);
+	pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+	pthread_mutex_init(&mutex, &attr);
+
+	check(pthread_mutex_lock(&mutex)    == 0, "recursive lock");
+	check(pthread_mutex_trylock(&mutex) == 0, "recursive trylock");
+	check(pthread_mutex_unlock(&mutex)  == 0, "recursive unlock");
+	check(pthread_mutex_unlock(&mutex)  == 0, "recursive unlock");
+	check(pthread_mutex_unlock(&mutex)  == EPERM, "unlock of unowned mutex");
+	pthread_mutex_destroy(&mutex);
+
+	pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_ERRORCHECK);
+	pthread_mutex_init(&mutex, &attr);
+
+	check(pthread_mutex_lock(&mutex)    == 0,       "error-check lock");
+	check(pthread_mutex_lock(&mutex)    == EDEADLK, "error-check relock");
+	check(pthread_mutex_trylock(&mutex) == EDEADLK, "error-check trylock");
+	check(pthread_mutex_unlock(&mutex)  == 0,       "error-check unlock");
+	check(pthread_mutex_unlock(&mutex)  == EPERM,   "error-check unlock of unowned mutex");
+	pthread_mutex_destroy(&mutex);
+
+	pthread_mutexattr_destroy(&attr);
+
+	printf("main thread: mutex types ok\n");
+}
+
+
+/**
+ * Condition-variable test, a producer hands out items to consumers
+ */
+struct Cond_handoff
+{
+	enum { NUM_CONSUMERS = 4, ITEMS = 10000 };
+
+	pthread_mutex_t mutex;
+	pthread_cond_t  cond;
+	unsigned        available = 0;
+	unsigned        consumed  = 0;
+	bool            done      = false;
+
+	static void *consumer(void *arg)
+	{
+		Cond_handoff &test = *(Cond_handoff *)arg;
+
+		pthread_mutex_lock(&test.mutex);
+		for (;;) {
+			while (!test.available && !test.done)
+				pthread_cond_wait(&test.cond, &test.mutex);
+
+			if (!test.available)
+				break;
+
+			test.available--;
+			test.consumed++;
+		}
+		pthread_mutex_unlock(&test.mutex);
+		return 0;
+	}
+
+	Cond_handoff()
+	{
+		pthread_mutex_init(&mutex, 0);
+		pthread_cond_init(&cond, 0);
+
+		unsigned long const start = now_ms();
+
+		pthread_t threads[NUM_CONSUMERS];
+		for (unsigned i = 0; i < NUM_CONSUMERS; i++)
+			check(pthread_create(&threads[i], 0, consumer, this) == 0,
+			      "pthread_create() failed");
+
+		for (unsigned i = 0; i < ITEMS; i++) {
+			pthread_mutex_lock(&mutex);
+			available++;
+			pthread_cond_signal(&cond);
+			pthread_mutex_unlock(&mutex);
+		}
+
+		pthread_mutex_lock(&mutex);
+		done = true;
+		pthread_cond_broadcast(&cond);
+		pthread_mutex_unlock(&mutex);
+
+		for (unsigned i = 0; i < NUM_CONSUMERS; i++)
+			pthread_join(threads[i], 0);
+
+		check(consumed == ITEMS, "items lost by condition variable");
+
+		printf("main thread: condvar %u consumers x %u items: %lu ms\n",
+		       (unsigned)NUM_CONSUMERS, (unsigned)ITEMS, now_ms() - start);
+
+		pthread_cond_destroy(&cond);
+		pthread_mutex_destroy(&mutex);
+	}
+};
+
+
+static void test_timed_waits()
+{
+	struct timespec abstime;
+
+	/* condition variable */
+	pthread_mutex_t mutex;
+	pthread_cond_t  cond;
+	pthread_mutex_init(&mutex, 0);
+	pthread_cond_init(&cond, 0);
+
+	pthread_mutex_lock(&mutex);
+	clock_gettime(CLOCK_REALTIME, &abstime);
+	abstime.tv_nsec += 100*1000*1000;
+	check(pthread_cond_timedwait(&cond, &mutex, &abstime) == ETIMEDOUT,
+	      "pthread_cond_timedwait() did not time out");
+	pthread_mutex_unlock(&mutex);
+
+	pthread_cond_destroy(&cond);
+	pthread_mutex_destroy(&mutex);
+
+	/* semaphore */
+	sem_t sem;
+	sem_init(&sem, 0, 1);
+
+	check(sem_trywait(&sem) == 0, "sem_trywait() failed");
+	check(sem_trywait(&sem) == -1 && errno == EAGAIN,
+	      "sem_trywait() on zero semaphore");
+
+	clock_gettime(CLOCK_REALTIME, &abstime);
+	abstime.tv_sec += 1;
+	check(sem_timedwait(&sem, &abstime) == -1 && errno == ETIMEDOUT,
+	      "sem_timedwait() did not time out");
+
+	sem_post(&sem);
+	check(sem_timedwait(&sem, &abstime) == 0, "sem_timedwait() failed");
+
+	sem_destroy(&sem);
+
+	printf("main thread: timed waits ok\n");
+}
+
+
 int main(int argc, char **argv)
 {
 	printf("--- pthread test ---\n");
@@ -142,6 +356,14 @@ int main(int argc, char **argv)
 		}
 	}
 
+	test_mutex_types();
+	test_timed_waits();
+
+	Mutex_contention contention_normal    { PTHREAD_MUTEX_NORMAL };
+	Mutex_contention contention_recursive { PTHREAD_MUTEX_RECURSIVE };
+
+	Cond_handoff cond_handoff;
+
 	printf("--- returning from main ---\n");
 	return 0;
 }
@@ -19,11 +19,21 @@
 
 /* libc includes */
 #include <fcntl.h>
+#include <stdlib.h>
+#include <time.h>
 
 
 extern "C"  int __sread(void *, char *, int);
 
 
+static unsigned long now_ms()
+{
+	timespec ts { 0, 0 };
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec*1000UL + ts.tv_nsec/(1000*1000);
+}
+
+
 int main(int argc, char const ** args)
 {
 	using namespace Genode;
@@ -33,6 +43,14 @@ int main(int argc, char const ** args)
 		return -1;
 	}
 
+	/*
+	 * The start-up report needs a timer session, so it is enabled only if
+	 * the environment variable 'PYTHON_STARTUP_REPORT' is set.
+	 */
+	bool const report = getenv("PYTHON_STARTUP_REPORT") != nullptr;
+
+	unsigned long const start_ms = report ? now_ms() : 0;
+
 	char * name = const_cast<char*>(args[0]);
 	FILE * fp = fopen(name, "r");
 	//fp._flags = __SRD;
@@ -46,5 +64,10 @@ int main(int argc, char const ** args)
 	Genode::log("Starting python ...");
 	PyRun_SimpleFile(fp, name);
 
+	if (report)
+		Genode::log("start-up and execution of ", Cstring(name), " took ",
+		            now_ms() - start_ms, " ms, ",
+		            PyDict_Size(PyImport_GetModuleDict()), " modules loaded");
+
 	return 0;
 }
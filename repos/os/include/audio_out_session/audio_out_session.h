@@ -154,6 +154,7 @@ class Audio_out::Stream
 
 		unsigned  _pos;             /* current playback position */
 		unsigned  _tail;            /* tail pointer used for allocations */
+		unsigned  _delay;           /* frames buffered by the server */
 		Packet    _buf[QUEUE_SIZE]; /* packet queue */
 
 	public:
@@ -177,6 +178,16 @@ class Audio_out::Stream
 		 */
 		unsigned tail() const { return _tail; }
 
+		/**
+		 * Number of frames buffered by the server beyond the playback position
+		 *
+		 * The frames were taken from the stream but were not played by the
+		 * device yet. Together with the number of queued packets, the value
+		 * yields the delay until a submitted packet becomes audible. Servers
+		 * that do not know the value report 0.
+		 */
+		unsigned delay() const { return _delay; }
+
 		/**
 		 * Number of packets between playback and allocation position
 		 *
@@ -291,6 +302,11 @@ class Audio_out::Stream
 		 * Increment current stream position by one
 		 */
 		void increment_position() { _pos = (_pos + 1) % QUEUE_SIZE; }
+
+		/**
+		 * Set number of frames buffered by the server
+		 */
+		void delay(unsigned frames) { _delay = frames; }
 };
 
 
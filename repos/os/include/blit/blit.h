@@ -31,4 +31,71 @@
 extern "C" void blit(void const *src, unsigned src_w,
                      void *dst, unsigned dst_w, int w, int h);
 
+
+/**
+ * Mix line of RGB565 pixels with source pixels at the ratio of alpha values
+ *
+ * \param dst    destination pixels
+ * \param src    source pixels
+ * \param alpha  alpha value per source pixel
+ * \param n      number of pixels
+ *
+ * The result equals 'Pixel_rgb565::mix' applied to each pixel with a
+ * non-zero alpha value. Pixels with an alpha value of zero stay untouched.
+ */
+extern "C" void blit_blend_rgb565(void *dst, void const *src,
+                                  unsigned char const *alpha, unsigned n);
+
+
+/**
+ * Mix line of RGB888 pixels with source pixels at the ratio of alpha values
+ *
+ * The result equals 'Pixel_rgb888::mix' applied to each pixel with a
+ * non-zero alpha value. Pixels with an alpha value of zero stay untouched.
+ */
+extern "C" void blit_blend_rgb888(void *dst, void const *src,
+                                  unsigned char const *alpha, unsigned n);
+
+
+/**
+ * Convert line of RGB888 pixels to RGB565 with ordered dithering
+ *
+ * \param dither  16 values subtracted from the color channels, the value
+ *                applied to the pixel at position 'x' is 'dither[x & 15]'
+ * \param x       horizontal position of the first pixel
+ */
+extern "C" void blit_convert_rgb888_to_rgb565(void *dst, void const *src,
+                                              unsigned n,
+                                              unsigned char const *dither,
+                                              unsigned x);
+
+
+/**
+ * Convert line of RGB565 pixels to RGB888
+ */
+extern "C" void blit_convert_rgb565_to_rgb888(void *dst, void const *src,
+                                              unsigned n);
+
+
+/**
+ * Select the implementation of the blit functions
+ *
+ * \param name  name of the implementation, e.g., "scalar", "sse2", "avx2",
+ *              or "neon", or nullptr to select the best implementation
+ *              supported by the CPU
+ *
+ * \return      false if the implementation is not available, in which case
+ *              the selection is not changed
+ *
+ * By default, the best implementation is selected at the first use of the
+ * library. Selecting a specific implementation is meant for benchmarks.
+ */
+extern "C" bool blit_select_kernels(char const *name);
+
+
+/**
+ * Return name of the selected implementation of the blit functions
+ */
+extern "C" char const *blit_kernels_name();
+
 #endif /* _INCLUDE__BLIT__BLIT_H_ */
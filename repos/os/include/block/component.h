@@ -69,15 +69,70 @@ class Block::Session_component : public Block::Session_component_base,
 {
 	private:
 
+		enum { MAX_REQUESTS = Driver::MAX_COMMAND_SLOTS };
+
 		addr_t                            _rq_phys;
 		Signal_handler<Session_component> _sink_ack;
 		Signal_handler<Session_component> _sink_submit;
 		bool                              _req_queue_full;
 		bool                              _ack_queue_full;
-		Packet_descriptor                 _p_to_handle;
+		Request                           _requests[MAX_REQUESTS];
+		uint32_t                          _used_tags;
+		unsigned                          _congested_tag;
+		bool                              _barrier;
+		bool                              _barrier_submitted;
+		unsigned                          _barrier_tag;
 		unsigned                          _p_in_fly;
 		bool                              _writeable;
 
+		/**
+		 * Return true if all tags available to the driver are in use
+		 */
+		bool _slots_full()
+		{
+			unsigned const slots = min(_driver.command_slots(),
+			                           (unsigned)MAX_REQUESTS);
+			for (unsigned tag = 0; tag < slots; tag++)
+				if (!(_used_tags & (1U << tag)))
+					return false;
+
+			return true;
+		}
+
+		unsigned _alloc_tag()
+		{
+			unsigned tag = 0;
+			while (_used_tags & (1U << tag)) tag++;
+
+			_used_tags |= 1U << tag;
+			return tag;
+		}
+
+		/**
+		 * Release the tag of the request in flight with the given packet
+		 *
+		 * \return released tag, or MAX_REQUESTS if there is no such request
+		 */
+		unsigned _release_tag(Packet_descriptor const &packet)
+		{
+			for (unsigned tag = 0; tag < MAX_REQUESTS; tag++) {
+				if (!(_used_tags & (1U << tag)))
+					continue;
+
+				/* requests without payload differ by their operation only */
+				Packet_descriptor const &p = _requests[tag].packet;
+				if (p.offset()       == packet.offset()       &&
+				    p.size()         == packet.size()         &&
+				    p.operation()    == packet.operation()    &&
+				    p.block_number() == packet.block_number() &&
+				    p.block_count()  == packet.block_count()) {
+					_used_tags &= ~(1U << tag);
+					return tag;
+				}
+			}
+			return MAX_REQUESTS;
+		}
+
 		/**
 		 * Acknowledge a packet already handled
 		 */
@@ -97,61 +152,123 @@ class Block::Session_component : public Block::Session_component_base,
 			return p.block_number() + p.block_count() - 1
 			       < _driver.block_count(); }
 
+		/**
+		 * Copy and check the scatter-gather table of the packet
+		 *
+		 * \return false if the table is malformed
+		 */
+		bool _read_sg_table(Packet_descriptor const &packet, Sg_table &sg)
+		{
+			Sg_table const *table = (Sg_table const *)
+				tx_sink()->packet_content(packet);
+			if (!table || packet.size() < sizeof(Sg_table))
+				return false;
+
+			sg = *table;
+			if (!sg.count || sg.count > Sg_table::MAX_SEGMENTS)
+				return false;
+
+			size_t const blk_size = _driver.block_size();
+			size_t total = 0;
+			for (unsigned i = 0; i < sg.count; i++) {
+				Sg_table::Segment const &s = sg.segment[i];
+				if (!s.size || s.size % blk_size
+				    || !tx_sink()->packet_valid(Packet_descriptor(s.offset, s.size)))
+					return false;
+				total += s.size;
+			}
+			return total == packet.block_count() * blk_size;
+		}
+
+		/**
+		 * Pass the request with the given tag to the driver
+		 */
+		void _submit(unsigned tag)
+		{
+			Request &request = _requests[tag];
+
+			try { _driver.submit(request); }
+			catch (Driver::Request_congestion) {
+				_req_queue_full = true;
+				_congested_tag  = tag;
+			}
+			catch (Driver::Io_error) {
+				ack_packet(request.packet, false); }
+		}
+
+		/**
+		 * Pass the pending barrier to the driver once no other request
+		 * is in flight anymore
+		 */
+		void _submit_barrier()
+		{
+			if (_barrier_submitted || _used_tags != (1U << _barrier_tag))
+				return;
+
+			_barrier_submitted = true;
+			_submit(_barrier_tag);
+		}
+
 		/**
 		 * Handle a single request
 		 */
 		void _handle_packet(Packet_descriptor packet)
 		{
-			_p_to_handle = packet;
-			_p_to_handle.succeeded(false);
+			typedef Block::Packet_descriptor::Opcode Opcode;
+
+			packet.succeeded(false);
+
+			Opcode const op = packet.operation();
+			bool const payload   = op == Opcode::READ || op == Opcode::WRITE;
+			bool const modifying = op == Opcode::WRITE || op == Opcode::DISCARD;
 
 			/* ignore invalid packets */
-			if (!packet.size() || !_range_check(_p_to_handle)) {
-				_ack_packet(_p_to_handle);
+			if ((payload && !packet.size())
+			    || (op != Opcode::FLUSH
+			        && (!packet.block_count() || !_range_check(packet)))) {
+				_ack_packet(packet);
 				return;
 			}
 
-			try {
-				switch (_p_to_handle.operation()) {
-
-				case Block::Packet_descriptor::READ:
-					if (_driver.dma_enabled())
-						_driver.read_dma(packet.block_number(),
-						                 packet.block_count(),
-						                 _rq_phys + packet.offset(),
-						                 _p_to_handle);
-					else
-						_driver.read(packet.block_number(),
-						             packet.block_count(),
-						             tx_sink()->packet_content(packet),
-						             _p_to_handle);
-					break;
-
-				case Block::Packet_descriptor::WRITE:
-					if (!_writeable) {
-						_ack_packet(_p_to_handle);
-						break;
-					}
-					if (_driver.dma_enabled())
-						_driver.write_dma(packet.block_number(),
-						                  packet.block_count(),
-						                  _rq_phys + packet.offset(),
-						                  _p_to_handle);
-					else
-						_driver.write(packet.block_number(),
-						              packet.block_count(),
-						              tx_sink()->packet_content(packet),
-						              _p_to_handle);
-					break;
-
-				default:
-					throw Driver::Io_error();
-				}
-			} catch (Driver::Request_congestion) {
-				_req_queue_full = true;
-			} catch (Driver::Io_error) {
-				_ack_packet(_p_to_handle);
+			/* ignore modifying requests to read-only sessions */
+			if (modifying && !_writeable) {
+				_ack_packet(packet);
+				return;
+			}
+
+			/* ignore malformed scatter-gather requests */
+			Sg_table sg;
+			if (packet.scatter_gather()
+			    && (!payload || !_driver.scatter_gather()
+			        || !_read_sg_table(packet, sg))) {
+				_ack_packet(packet);
+				return;
+			}
+
+			unsigned const tag = _alloc_tag();
+
+			Request &request = _requests[tag];
+			request.packet = packet;
+			request.tag    = tag;
+			request.phys   = _rq_phys + packet.offset();
+			request.buffer = tx_sink()->packet_content(packet);
+
+			if (packet.scatter_gather()) {
+				request.sg          = sg;
+				request.bulk_phys   = _rq_phys;
+				request.bulk_buffer = request.buffer - packet.offset();
 			}
+
+			if (op != Opcode::FLUSH) {
+				_submit(tag);
+				return;
+			}
+
+			/* hold back subsequent requests until the barrier completed */
+			_barrier           = true;
+			_barrier_submitted = false;
+			_barrier_tag       = tag;
+			_submit_barrier();
 		}
 
 		/**
@@ -165,10 +282,14 @@ class Block::Session_component : public Block::Session_component_base,
 			 * direct the packet request to the driver backend
 			 */
 			for (_ack_queue_full = (_p_in_fly >= tx_sink()->ack_slots_free());
-			     !_req_queue_full && !_ack_queue_full
+			     !_req_queue_full && !_ack_queue_full && !_barrier
+			     && !_slots_full()
 			     && tx_sink()->packet_avail();
-				 _ack_queue_full = (++_p_in_fly >= tx_sink()->ack_slots_free()))
+			     _ack_queue_full = (_p_in_fly >= tx_sink()->ack_slots_free()))
+			{
+				_p_in_fly++;
 				_handle_packet(tx_sink()->get_packet());
+			}
 		}
 
 	public:
@@ -191,6 +312,12 @@ class Block::Session_component : public Block::Session_component_base,
 		  _sink_ack(ep, *this, &Session_component::_signal),
 		  _sink_submit(ep, *this, &Session_component::_signal),
 		  _req_queue_full(false),
+		  _ack_queue_full(false),
+		  _used_tags(0),
+		  _congested_tag(0),
+		  _barrier(false),
+		  _barrier_submitted(false),
+		  _barrier_tag(0),
 		  _p_in_fly(0),
 		  _writeable(writeable)
 		{
@@ -212,19 +339,37 @@ class Block::Session_component : public Block::Session_component_base,
 		 */
 		void ack_packet(Packet_descriptor &packet, bool success)
 		{
+			bool const slots_full = _slots_full();
+
+			unsigned const tag = _release_tag(packet);
 			packet.succeeded(success);
 			_ack_packet(packet);
 
-			if (!_req_queue_full && !_ack_queue_full)
+			/*
+			 * A pending barrier gets submitted when the last request
+			 * before it completed, its completion resumes the processing
+			 */
+			bool barrier_done = false;
+			if (_barrier) {
+				if (tag != _barrier_tag) {
+					_submit_barrier();
+					return;
+				}
+				_barrier     = false;
+				barrier_done = true;
+			}
+
+			if (!_req_queue_full && !_ack_queue_full && !slots_full
+			    && !barrier_done)
 				return;
 
 			/*
 			 * when the driver's request queue was full,
-			 * handle last unprocessed packet taken out of submit queue
+			 * handle last unprocessed request again
 			 */
 			if (_req_queue_full) {
 				_req_queue_full = false;
-				_handle_packet(_p_to_handle);
+				_submit(_congested_tag);
 			}
 
 			/* resume packet processing */
@@ -251,10 +396,24 @@ class Block::Session_component : public Block::Session_component_base,
 				ops->set_operation(Opcode::READ);
 			if (_writeable && driver_ops.supported(Opcode::WRITE))
 				ops->set_operation(Opcode::WRITE);
+			if (_writeable && driver_ops.supported(Opcode::DISCARD))
+				ops->set_operation(Opcode::DISCARD);
+
+			/* barriers are implemented by the session component */
+			if (_writeable)
+				ops->set_operation(Opcode::FLUSH);
 
+			if (_driver.scatter_gather())
+				ops->set_scatter_gather();
+
+			if (_driver.dataspace(_writeable).valid())
+				ops->set_mappable();
 		}
 
 		void sync() { _driver.sync(); }
+
+		Dataspace_capability dataspace() override {
+			return _driver.dataspace(_writeable); }
 };
 
 
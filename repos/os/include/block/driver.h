@@ -24,6 +24,7 @@
 #include <block_session/rpc_object.h>
 
 namespace Block {
+	struct Request;
 	class Driver_session_base;
 	class Driver_session;
 	class Driver;
@@ -31,6 +32,44 @@ namespace Block {
 };
 
 
+/**
+ * Request handed out to the driver by the session component
+ */
+struct Block::Request
+{
+	Packet_descriptor  packet;  /* packet descriptor from the client */
+	unsigned           tag;     /* unique among all requests in flight */
+	Genode::addr_t     phys;    /* physical address of the payload */
+	char              *buffer;  /* local address of the payload */
+
+	/*
+	 * Segments of a scatter-gather request, copied from the bulk buffer
+	 * to prevent the client from changing them while in flight
+	 */
+	Sg_table           sg;
+	Genode::addr_t     bulk_phys;    /* physical address of bulk buffer */
+	char              *bulk_buffer;  /* local address of bulk buffer */
+
+	/**
+	 * Call 'fn(phys, buffer, size)' for each segment of the payload
+	 *
+	 * A request without scatter-gather table consists of one segment.
+	 */
+	template <typename FN>
+	void for_each_segment(FN const &fn) const
+	{
+		if (!packet.scatter_gather()) {
+			fn(phys, buffer, packet.size());
+			return;
+		}
+		for (unsigned i = 0; i < sg.count; i++) {
+			Sg_table::Segment const &s = sg.segment[i];
+			fn(bulk_phys + s.offset, bulk_buffer + s.offset, s.size);
+		}
+	}
+};
+
+
 struct Block::Driver_session_base
 {
 	/**
@@ -95,6 +134,11 @@ class Block::Driver
 		class Io_error           : public ::Genode::Exception { };
 		class Request_congestion : public ::Genode::Exception { };
 
+		/**
+		 * Upper bound of requests a driver can keep in flight
+		 */
+		enum { MAX_COMMAND_SLOTS = 32 };
+
 		/**
 		 * Constructor
 		 */
@@ -193,6 +237,107 @@ class Block::Driver
 		                       Packet_descriptor &packet) {
 			throw Io_error(); }
 
+		/**
+		 * Discard blocks of the medium
+		 *
+		 * \param block_number  number of first block to discard
+		 * \param block_count   number of blocks to discard
+		 * \param packet        packet descriptor from the client
+		 *
+		 * \throw Request_congestion
+		 *
+		 * Note: should be overridden by devices that support 'DISCARD'
+		 */
+		virtual void discard(sector_t           block_number,
+		                     Genode::size_t     block_count,
+		                     Packet_descriptor &packet) {
+			throw Io_error(); }
+
+		/**
+		 * Request number of requests the driver can process concurrently
+		 *
+		 * The session component never has more requests in flight at the
+		 * driver. The tag of each request is lower than this number, which
+		 * enables drivers to use the tag as index of a device command slot.
+		 * Synchronous drivers, which acknowledge each request before
+		 * returning, always have at most one request in flight.
+		 *
+		 * Note: should be overridden by asynchronously working drivers
+		 */
+		virtual unsigned command_slots() { return MAX_COMMAND_SLOTS; }
+
+		/**
+		 * Check if driver processes scatter-gather requests
+		 *
+		 * Scatter-gather requests are handed out via 'submit' only, which
+		 * must be overridden by drivers that return true.
+		 */
+		virtual bool scatter_gather() { return false; }
+
+		/**
+		 * Request dataspace with the content of the medium
+		 *
+		 * \param writeable  true if the client is allowed to modify the
+		 *                   content
+		 *
+		 * \return invalid capability if the medium is not accessible as
+		 *         memory, or if modifications of a read-only client cannot
+		 *         be prevented
+		 *
+		 * Note: may be overridden by drivers that keep the medium in memory
+		 */
+		virtual Genode::Dataspace_capability dataspace(bool writeable) {
+			return Genode::Dataspace_capability(); }
+
+		/**
+		 * Process request
+		 *
+		 * \param request  request with the packet descriptor from the client
+		 *
+		 * \throw Request_congestion
+		 * \throw Io_error
+		 *
+		 * The default implementation dispatches the request to the read,
+		 * write, and discard methods above, and implements 'FLUSH' via
+		 * 'sync'.
+		 *
+		 * Note: may be overridden by drivers that make use of the tag
+		 */
+		virtual void submit(Request &request)
+		{
+			Packet_descriptor &p = request.packet;
+
+			switch (p.operation()) {
+
+			case Packet_descriptor::READ:
+				if (dma_enabled())
+					read_dma(p.block_number(), p.block_count(), request.phys, p);
+				else
+					read(p.block_number(), p.block_count(), request.buffer, p);
+				return;
+
+			case Packet_descriptor::WRITE:
+				if (dma_enabled())
+					write_dma(p.block_number(), p.block_count(), request.phys, p);
+				else
+					write(p.block_number(), p.block_count(), request.buffer, p);
+				return;
+
+			case Packet_descriptor::DISCARD:
+				discard(p.block_number(), p.block_count(), p);
+				return;
+
+			/* the session component ensures that no request is in flight */
+			case Packet_descriptor::FLUSH:
+				sync();
+				ack_packet(p);
+				return;
+
+			default:
+				throw Io_error();
+			}
+		}
+
 		/**
 		 * Check if DMA is enabled for driver
 		 *
@@ -14,6 +14,7 @@
 #ifndef _INCLUDE__BLOCK_SESSION__BLOCK_SESSION_H_
 #define _INCLUDE__BLOCK_SESSION__BLOCK_SESSION_H_
 
+#include <dataspace/capability.h>
 #include <os/packet_stream.h>
 #include <packet_stream_tx/packet_stream_tx.h>
 #include <session/session.h>
@@ -26,6 +27,7 @@ namespace Block {
 	typedef Genode::uint64_t sector_t;
 
 	class Packet_descriptor;
+	struct Sg_table;
 	struct Session;
 }
 
@@ -36,12 +38,24 @@ namespace Block {
  * The data associated with the 'Packet_descriptor' is either
  * the data read from or written to the block indicated by
  * its number.
+ *
+ * A 'DISCARD' request tells the device that the content of the given
+ * blocks is no longer needed. The content of discarded blocks is undefined
+ * until they get written again. A 'FLUSH' request acts as write barrier.
+ * It is acknowledged not before all requests submitted prior to it are
+ * completed and stored persistently, and requests submitted after it are
+ * not processed before. Both requests carry no payload.
+ *
+ * The payload of a 'READ' or 'WRITE' request may be scattered over
+ * several regions of the bulk buffer. In this case, the packet is marked
+ * as scatter-gather packet and its content is an 'Sg_table' that lists the
+ * regions.
  */
 class Block::Packet_descriptor : public Genode::Packet_descriptor
 {
 	public:
 
-		enum Opcode    { READ, WRITE, END };
+		enum Opcode    { READ, WRITE, DISCARD, FLUSH, END };
 		enum Alignment { PACKET_ALIGNMENT = 11 };
 
 	private:
@@ -50,6 +64,7 @@ class Block::Packet_descriptor : public Genode::Packet_descriptor
 		sector_t        _block_number; /* requested block number */
 		Genode::size_t  _block_count;  /* number of blocks to transfer */
 		unsigned        _success :1;   /* indicates success of operation */
+		unsigned        _sg      :1;   /* content is a scatter-gather table */
 
 	public:
 
@@ -59,7 +74,8 @@ class Block::Packet_descriptor : public Genode::Packet_descriptor
 		Packet_descriptor(Genode::off_t offset=0, Genode::size_t size = 0)
 		:
 			Genode::Packet_descriptor(offset, size),
-			_op(READ), _block_number(0), _block_count(0), _success(false)
+			_op(READ), _block_number(0), _block_count(0), _success(false),
+			_sg(false)
 		{ }
 
 		/**
@@ -70,15 +86,40 @@ class Block::Packet_descriptor : public Genode::Packet_descriptor
 		:
 			Genode::Packet_descriptor(p.offset(), p.size()),
 			_op(op), _block_number(blk_nr),
-			_block_count(blk_count), _success(false)
+			_block_count(blk_count), _success(false), _sg(false)
 		{ }
 
 		Opcode         operation()    const { return _op;           }
 		sector_t       block_number() const { return _block_number; }
 		Genode::size_t block_count()  const { return _block_count;  }
 		bool           succeeded()    const { return _success;      }
+		bool           scatter_gather() const { return _sg;         }
 
 		void succeeded(bool b) { _success = b ? 1 : 0; }
+		void scatter_gather(bool b) { _sg = b ? 1 : 0; }
+};
+
+
+/**
+ * Content of a scatter-gather packet
+ *
+ * The segments are located in the bulk buffer and get transferred in the
+ * order of the table to or from the consecutive blocks of the request.
+ * The size of each segment must be a multiple of the block size and the
+ * sum of all segments must match the block count of the request.
+ */
+struct Block::Sg_table
+{
+	enum { MAX_SEGMENTS = 16 };
+
+	struct Segment
+	{
+		Genode::off_t  offset;  /* offset within the bulk buffer */
+		Genode::size_t size;    /* size in bytes */
+	};
+
+	unsigned count;
+	Segment  segment[MAX_SEGMENTS];
 };
 
 
@@ -107,11 +148,19 @@ struct Block::Session : public Genode::Session
 	{
 		private:
 
-			unsigned _ops :Packet_descriptor::END; /* bitfield of ops */
+			unsigned _ops      :Packet_descriptor::END; /* bitfield of ops */
+			unsigned _sg       :1;                      /* scatter gather */
+			unsigned _mappable :1;                      /* see 'dataspace' */
 
 		public:
 
-			Operations() : _ops(0) { }
+			Operations() : _ops(0), _sg(0), _mappable(0) { }
+
+			bool scatter_gather() const { return _sg; }
+			bool mappable()       const { return _mappable; }
+
+			void set_scatter_gather() { _sg = 1; }
+			void set_mappable()       { _mappable = 1; }
 
 			bool supported(Packet_descriptor::Opcode op) {
 				return (_ops & (1 << op)); }
@@ -152,6 +201,19 @@ struct Block::Session : public Genode::Session
 	 */
 	virtual void sync() = 0;
 
+	/**
+	 * Request dataspace that holds the content of the block device
+	 *
+	 * Servers that keep the device content in memory may hand out the
+	 * dataspace so that the client can access the blocks directly instead
+	 * of copying them via the packet stream. The availability is indicated
+	 * by 'Operations::mappable'. For read-only sessions, the dataspace is
+	 * only handed out if it cannot be modified, e.g., a ROM dataspace.
+	 *
+	 * \return dataspace capability, or invalid capability if unsupported
+	 */
+	virtual Genode::Dataspace_capability dataspace() = 0;
+
 	/**
 	 * Request packet-transmission channel
 	 */
@@ -171,7 +233,8 @@ struct Block::Session : public Genode::Session
 	           Genode::size_t *, Operations *);
 	GENODE_RPC(Rpc_tx_cap, Genode::Capability<Tx>, _tx_cap);
 	GENODE_RPC(Rpc_sync, void, sync);
-	GENODE_RPC_INTERFACE(Rpc_info, Rpc_tx_cap, Rpc_sync);
+	GENODE_RPC(Rpc_dataspace, Genode::Dataspace_capability, dataspace);
+	GENODE_RPC_INTERFACE(Rpc_info, Rpc_tx_cap, Rpc_sync, Rpc_dataspace);
 };
 
 #endif /* _INCLUDE__BLOCK_SESSION__BLOCK_SESSION_H_ */
@@ -59,6 +59,9 @@ class Block::Session_client : public Genode::Rpc_client<Session>
 		Tx::Source *tx() { return _tx.source(); }
 		void sync() override { call<Rpc_sync>(); }
 
+		Genode::Dataspace_capability dataspace() override {
+			return call<Rpc_dataspace>(); }
+
 		/*
 		 * Wrapper for alloc_packet, allocates 2KB aligned packets
 		 */
@@ -60,6 +60,13 @@ class Block::Session_rpc_object : public Genode::Rpc_object<Session, Session_rpc
 		Genode::Capability<Tx> _tx_cap() { return _tx.cap(); }
 
 		Tx::Sink *tx_sink() { return _tx.sink(); }
+
+		/**
+		 * Servers that keep the device content in memory may override
+		 * this method
+		 */
+		Genode::Dataspace_capability dataspace() override {
+			return Genode::Dataspace_capability(); }
 };
 
 #endif /* _INCLUDE__BLOCK_SESSION__SERVER_H_ */
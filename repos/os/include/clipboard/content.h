@@ -0,0 +1,115 @@
+/*
+ * \brief  Utilities for exchanging raw clipboard content
+ * \author Genode Labs
+ * \date   2026-10-14
+ *
+ * Textual clipboard content is normally reported as the sanitized content
+ * of a '<clipboard>' node. For large content, the escaping and decoding
+ * becomes prohibitively expensive. Alternatively, the content can be
+ * reported in its raw form, preceded by a header that denotes its MIME
+ * type and size:
+ *
+ * ! <clipboard mime="text/plain;charset=utf-8" size="1048576"/>
+ * ! ...raw content...
+ *
+ * The raw content starts right after the newline that terminates the
+ * header.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__CLIPBOARD__CONTENT_H_
+#define _INCLUDE__CLIPBOARD__CONTENT_H_
+
+#include <util/xml_node.h>
+#include <util/xml_generator.h>
+
+namespace Clipboard {
+
+	typedef Genode::String<64> Mime_type;
+
+	/**
+	 * Content size above which writers should prefer the raw format
+	 */
+	enum { RAW_CONTENT_THRESHOLD = 16*1024 };
+
+	/**
+	 * Upper bound of the header size
+	 */
+	enum { RAW_HEADER_MAX_SIZE = 160 };
+
+	static inline Genode::size_t raw_content_max_size(Genode::size_t len) {
+		return RAW_HEADER_MAX_SIZE + len; }
+
+	/**
+	 * Write raw content with header into report buffer
+	 *
+	 * \return  number of bytes to submit, or 0 if 'dst_len' is too small
+	 */
+	static inline Genode::size_t write_raw_content(char *dst, Genode::size_t dst_len,
+	                                               Mime_type const &mime,
+	                                               char const *src,
+	                                               Genode::size_t src_len)
+	{
+		using namespace Genode;
+
+		size_t header_len = 0;
+		try {
+			Xml_generator xml(dst, min(dst_len, (size_t)RAW_HEADER_MAX_SIZE),
+			                  "clipboard", [&] () {
+				xml.attribute("mime", mime);
+				xml.attribute("size", src_len);
+			});
+			header_len = xml.used();
+		} catch (Xml_generator::Buffer_exceeded) { return 0; }
+
+		if (dst_len - header_len < src_len)
+			return 0;
+
+		memcpy(dst + header_len, src, src_len);
+		return header_len + src_len;
+	}
+
+	/**
+	 * Call 'fn(mime, data, len)' if 'base' holds raw clipboard content
+	 *
+	 * \return  false if the content is not in raw format
+	 */
+	template <typename FN>
+	static inline bool with_raw_content(char const *base, Genode::size_t max_len,
+	                                    FN const &fn)
+	{
+		using namespace Genode;
+
+		try {
+			Xml_node const header(base, max_len);
+
+			if (!header.has_type("clipboard") || !header.has_attribute("size"))
+				return false;
+
+			char const *data = header.addr() + header.size();
+			char const *end  = base + max_len;
+
+			/* skip newline that terminates the header */
+			if (data < end && *data == '\n')
+				data++;
+
+			unsigned long const size = header.attribute_value("size", 0UL);
+			if ((unsigned long)(end - data) < size)
+				return false;
+
+			fn(header.attribute_value("mime", Mime_type()), data, (size_t)size);
+			return true;
+
+		} catch (Xml_node::Invalid_syntax) { }
+
+		return false;
+	}
+}
+
+#endif /* _INCLUDE__CLIPBOARD__CONTENT_H_ */
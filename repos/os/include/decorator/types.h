@@ -20,7 +20,7 @@
 #include <util/color.h>
 #include <util/geometry.h>
 #include <util/color.h>
-#include <util/dirty_rect.h>
+#include <util/dirty_region.h>
 #include <os/surface.h>
 
 namespace Decorator {
@@ -29,7 +29,7 @@ namespace Decorator {
 	typedef Genode::Surface_base::Area  Area;
 	typedef Genode::Surface_base::Rect  Rect;
 
-	typedef Genode::Dirty_rect<Rect, 3> Dirty_rect;
+	typedef Genode::Dirty_region<Rect, 16> Dirty_region;
 
 	using Genode::size_t;
 	using Genode::Color;
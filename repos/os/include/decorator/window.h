@@ -108,6 +108,15 @@ class Decorator::Window_base : public Window_list::Element
 
 		virtual Rect outer_geometry() const = 0;
 
+		/**
+		 * Return true if the content view hides the decorator's pixels
+		 * within 'geometry()'
+		 *
+		 * For an opaque window, a change of its decoration affects only the
+		 * area between 'geometry()' and 'outer_geometry()'.
+		 */
+		virtual bool opaque() const { return false; }
+
 		virtual void stack(Nitpicker::Session::View_handle neighbor) = 0;
 
 		virtual Nitpicker::Session::View_handle frontmost_view() const = 0;
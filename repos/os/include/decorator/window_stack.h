@@ -33,7 +33,7 @@ class Decorator::Window_stack : public Window_base::Draw_behind_fn
 
 		Window_list          _windows;
 		Window_factory_base &_window_factory;
-		Dirty_rect mutable   _dirty_rect;
+		Dirty_region mutable _dirty_region;
 
 		inline void _draw_rec(Canvas_base &canvas, Window_base const *win,
 		                      Rect rect) const;
@@ -61,6 +61,26 @@ class Decorator::Window_stack : public Window_base::Draw_behind_fn
 			throw Xml_node::Nonexistent_sub_node();
 		}
 
+		/**
+		 * Mark the pixels drawn for the window as dirty
+		 */
+		void _mark_decoration_as_dirty(Window_base const &window)
+		{
+			if (!window.opaque()) {
+				_dirty_region.mark_as_dirty(window.outer_geometry());
+				return;
+			}
+
+			Rect top, left, right, bottom;
+			window.outer_geometry().cut(window.geometry(),
+			                            &top, &left, &right, &bottom);
+
+			_dirty_region.mark_as_dirty(top);
+			_dirty_region.mark_as_dirty(left);
+			_dirty_region.mark_as_dirty(right);
+			_dirty_region.mark_as_dirty(bottom);
+		}
+
 		void _destroy(Window_base &window)
 		{
 			_windows.remove(&window);
@@ -89,11 +109,11 @@ class Decorator::Window_stack : public Window_base::Draw_behind_fn
 			_window_factory(window_factory)
 		{ }
 
-		Dirty_rect draw(Canvas_base &canvas) const
+		Dirty_region draw(Canvas_base &canvas) const
 		{
-			Dirty_rect result = _dirty_rect;
+			Dirty_region result = _dirty_region;
 
-			_dirty_rect.flush([&] (Rect const &rect) {
+			_dirty_region.flush([&] (Rect const &rect) {
 				_draw_rec(canvas, _windows.first(), rect); });
 
 			return result;
@@ -107,7 +127,7 @@ class Decorator::Window_stack : public Window_base::Draw_behind_fn
 
 			for (Window_base *win = _windows.first(); win; win = win->next()) {
 				if (win->animated()) {
-					_dirty_rect.mark_as_dirty(win->outer_geometry());
+					_mark_decoration_as_dirty(*win);
 					redraw_needed = true;
 				}
 			}
@@ -216,13 +236,17 @@ void Decorator::Window_stack::update_model(Genode::Xml_node root_node)
 			_xml_node_by_window_id(root_node, window->id());
 		}
 		catch (Xml_node::Nonexistent_sub_node) {
-			_dirty_rect.mark_as_dirty(window->outer_geometry());
+			_dirty_region.mark_as_dirty(window->outer_geometry());
 			_destroy(*window);
 		};
 	}
 
 	/*
 	 * Step 2: Update window properties of already present windows.
+	 *
+	 * Windows behind a moved window become visible within its original
+	 * geometry. Otherwise, only the decoration of a changed window must be
+	 * redrawn.
 	 */
 	for (Window_base *window = _windows.first(); window; window = window->next()) {
 
@@ -234,8 +258,14 @@ void Decorator::Window_stack::update_model(Genode::Xml_node root_node)
 		try {
 			Rect const orig_geometry = window->outer_geometry();
 			if (window->update(_xml_node_by_window_id(root_node, window->id()))) {
-				_dirty_rect.mark_as_dirty(orig_geometry);
-				_dirty_rect.mark_as_dirty(window->outer_geometry());
+
+				Rect const geometry = window->outer_geometry();
+
+				if (orig_geometry.p1() != geometry.p1()
+				 || orig_geometry.p2() != geometry.p2())
+					_dirty_region.mark_as_dirty(orig_geometry);
+
+				_mark_decoration_as_dirty(*window);
 			}
 		}
 		catch (Xml_node::Nonexistent_sub_node) {
@@ -267,7 +297,7 @@ void Decorator::Window_stack::update_model(Genode::Xml_node root_node)
 
 				_windows.insert(new_window);
 
-				_dirty_rect.mark_as_dirty(new_window->outer_geometry());
+				_mark_decoration_as_dirty(*new_window);
 			}
 		}
 	});
@@ -297,7 +327,7 @@ void Decorator::Window_stack::update_model(Genode::Xml_node root_node)
 			_windows.remove(window);
 			_windows.insert(window, previous_window);
 
-			_dirty_rect.mark_as_dirty(window->outer_geometry());
+			_mark_decoration_as_dirty(*window);
 		}
 
 		previous_window = window;
@@ -38,6 +38,14 @@ struct Framebuffer::Session_client : Genode::Rpc_client<Session>
 
 	void refresh(int x, int y, int w, int h) override {
 		call<Rpc_refresh>(x, y, w, h); }
+
+	unsigned buffers() const override { return call<Rpc_buffers>(); }
+
+	void flip(unsigned buffer, int x, int y, int w, int h) override {
+		call<Rpc_flip>(buffer, x, y, w, h); }
+
+	void flip_sigh(Genode::Signal_context_capability sigh) override {
+		call<Rpc_flip_sigh>(sigh); }
 };
 
 #endif /* _INCLUDE__FRAMEBUFFER_SESSION__CLIENT_H_ */
@@ -104,6 +104,10 @@ struct Framebuffer::Session : Genode::Session
 	 * Hence, prior calling this method, the client should make sure to
 	 * have detached the previously requested dataspace from its local
 	 * address space.
+	 *
+	 * The dataspace holds 'buffers()' frames of 'mode()' size one after
+	 * another. By calling this method, the first buffer becomes the
+	 * displayed one.
 	 */
 	virtual Genode::Dataspace_capability dataspace() = 0;
 
@@ -138,6 +142,43 @@ struct Framebuffer::Session : Genode::Session
 	 */
 	virtual void sync_sigh(Genode::Signal_context_capability) = 0;
 
+	/**
+	 * Return number of buffers within the framebuffer dataspace
+	 *
+	 * A server with more than one buffer supports page flipping.
+	 */
+	virtual unsigned buffers() const { return 1; }
+
+	/**
+	 * Display specified buffer from the next vertical blank on
+	 *
+	 * \param buffer   index of the buffer to display
+	 * \param x,y,w,h  area where the buffer differs from the one displayed
+	 *                 so far
+	 *
+	 * The switch is atomic, a displayed picture never shows parts of two
+	 * buffers. Servers that scan out the buffer directly ignore the area
+	 * whereas servers that copy the buffer transfer only the area. Once
+	 * the buffer is displayed, the signal handler registered via
+	 * 'flip_sigh' is notified. From then on, the buffer displayed before
+	 * may be drawn into. A flip requested while another flip is still
+	 * pending replaces the pending flip.
+	 *
+	 * A server with a single buffer merely refreshes the area.
+	 */
+	virtual void flip(unsigned buffer, int x, int y, int w, int h)
+	{
+		if (buffer == 0)
+			refresh(x, y, w, h);
+	}
+
+	/**
+	 * Register signal handler to be notified when a flip took effect
+	 *
+	 * Servers with a single buffer never deliver this signal.
+	 */
+	virtual void flip_sigh(Genode::Signal_context_capability) { }
+
 
 	/*********************
 	 ** RPC declaration **
@@ -148,9 +189,12 @@ struct Framebuffer::Session : Genode::Session
 	GENODE_RPC(Rpc_refresh, void, refresh, int, int, int, int);
 	GENODE_RPC(Rpc_mode_sigh, void, mode_sigh, Genode::Signal_context_capability);
 	GENODE_RPC(Rpc_sync_sigh, void, sync_sigh, Genode::Signal_context_capability);
+	GENODE_RPC(Rpc_buffers, unsigned, buffers);
+	GENODE_RPC(Rpc_flip, void, flip, unsigned, int, int, int, int);
+	GENODE_RPC(Rpc_flip_sigh, void, flip_sigh, Genode::Signal_context_capability);
 
 	GENODE_RPC_INTERFACE(Rpc_dataspace, Rpc_mode, Rpc_mode_sigh, Rpc_refresh,
-	                     Rpc_sync_sigh);
+	                     Rpc_sync_sigh, Rpc_buffers, Rpc_flip, Rpc_flip_sigh);
 };
 
 #endif /* _INCLUDE__FRAMEBUFFER_SESSION__FRAMEBUFFER_SESSION_H_ */
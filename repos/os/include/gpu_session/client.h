@@ -43,6 +43,12 @@ class Gpu::Session_client : public Genode::Rpc_client<Session>
 		void exec_buffer(Genode::Dataspace_capability cap, Genode::size_t size) override {
 			call<Rpc_exec_buffer>(cap, size); }
 
+		Seqno exec_buffers(Exec_list const &list) override {
+			return call<Rpc_exec_buffers>(list); }
+
+		Genode::Dataspace_capability completion_dataspace() override {
+			return call<Rpc_completion_dataspace>(); }
+
 		void completion_sigh(Genode::Signal_context_capability sigh) override {
 			call<Rpc_completion_sigh>(sigh); }
 
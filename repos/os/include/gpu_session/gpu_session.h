@@ -19,8 +19,11 @@
 namespace Gpu {
 
 	using addr_t = Genode::uint64_t;
+	using Seqno  = Genode::uint64_t;
 
 	struct Info;
+	struct Exec_list;
+	struct Completion;
 	struct Session;
 }
 
@@ -51,6 +54,58 @@ struct Gpu::Info
 };
 
 
+/*
+ * Batch buffers executed as one submission
+ *
+ * The buffers are referred to by their PPGTT address and are executed in
+ * the order of the list.
+ */
+struct Gpu::Exec_list
+{
+	enum { MAX_BUFFERS = 8 };
+
+	struct Buffer
+	{
+		addr_t         ppgtt_va;
+		Genode::size_t size;
+	};
+
+	Buffer   buffer[MAX_BUFFERS];
+	unsigned count = 0;
+
+	/**
+	 * Append buffer to list
+	 *
+	 * \return false if the list is full
+	 */
+	bool add(addr_t ppgtt_va, Genode::size_t size)
+	{
+		if (count == MAX_BUFFERS)
+			return false;
+
+		buffer[count++] = Buffer { ppgtt_va, size };
+		return true;
+	}
+};
+
+
+/*
+ * Execution progress of the session
+ *
+ * The structure is located in the dataspace returned by
+ * 'Session::completion_dataspace'. It is written by the GPU multiplexer
+ * and may be polled by the client. Each submission is identified by a
+ * sequence number. Submissions complete in the order of their numbers.
+ */
+struct Gpu::Completion
+{
+	Seqno volatile submitted;
+	Seqno volatile completed;
+
+	bool complete(Seqno seqno) const { return completed >= seqno; }
+};
+
+
 /*
  * Gpu session interface
  */
@@ -82,6 +137,25 @@ struct Gpu::Session : public Genode::Session
 	 */
 	virtual void exec_buffer(Genode::Dataspace_capability cap, Genode::size_t size) = 0;
 
+	/**
+	 * Execute commands from several buffers as one submission
+	 *
+	 * \param list  batch buffers mapped in the PPGTT of the session
+	 *
+	 * \return sequence number of the submission, or 0 if the submission
+	 *         was rejected
+	 *
+	 * Submissions issued while the GPU still executes previous ones are
+	 * queued and handed to the GPU at once when the previous ones are
+	 * complete.
+	 */
+	virtual Seqno exec_buffers(Exec_list const &list) = 0;
+
+	/**
+	 * Request dataspace containing the 'Completion' structure of the session
+	 */
+	virtual Genode::Dataspace_capability completion_dataspace() = 0;
+
 	/**
 	 * Register completion signal handler
 	 *
@@ -155,6 +229,9 @@ struct Gpu::Session : public Genode::Session
 	GENODE_RPC(Rpc_info, Info, info);
 	GENODE_RPC(Rpc_exec_buffer, void, exec_buffer, Genode::Dataspace_capability,
 	           Genode::size_t);
+	GENODE_RPC(Rpc_exec_buffers, Seqno, exec_buffers, Exec_list const &);
+	GENODE_RPC(Rpc_completion_dataspace, Genode::Dataspace_capability,
+	           completion_dataspace);
 	GENODE_RPC(Rpc_completion_sigh, void, completion_sigh,
 	           Genode::Signal_context_capability);
 	GENODE_RPC_THROW(Rpc_alloc_buffer, Genode::Dataspace_capability, alloc_buffer,
@@ -174,8 +251,8 @@ struct Gpu::Session : public Genode::Session
 	GENODE_RPC(Rpc_set_tiling, bool, set_tiling,
 	           Genode::Dataspace_capability, unsigned);
 
-	GENODE_RPC_INTERFACE(Rpc_info, Rpc_exec_buffer,
-	                     Rpc_completion_sigh, Rpc_alloc_buffer,
+	GENODE_RPC_INTERFACE(Rpc_info, Rpc_exec_buffer, Rpc_exec_buffers,
+	                     Rpc_completion_dataspace, Rpc_completion_sigh, Rpc_alloc_buffer,
 	                     Rpc_free_buffer, Rpc_map_buffer, Rpc_unmap_buffer,
 	                     Rpc_map_buffer_ppgtt, Rpc_unmap_buffer_ppgtt,
 	                     Rpc_set_tiling);
@@ -38,12 +38,17 @@ class Input::Session_component : public Genode::Rpc_object<Input::Session>
 		/**
 		 * Constructor
 		 *
-		 * \param env  Env containing local region map
-		 * \param ram  Ram session at which to allocate session buffer
+		 * \param env         Env containing local region map
+		 * \param ram         Ram session at which to allocate session buffer
+		 * \param queue_size  number of event-queue slots
 		 */
-		Session_component(Genode::Env &env, Genode::Ram_session &ram)
-		: _ds(ram, env.rm(),
-		      Event_queue::QUEUE_SIZE*sizeof(Input::Event)) { }
+		Session_component(Genode::Env &env, Genode::Ram_session &ram,
+		                  unsigned queue_size = Event_queue::QUEUE_SIZE)
+		:
+			_ds(ram, env.rm(), Genode::min(queue_size, (unsigned)Event_queue::MAX_QUEUE_SIZE)
+			                   *sizeof(Input::Event)),
+			_event_queue(queue_size)
+		{ }
 
 		/**
 		 * Constructor
@@ -64,13 +69,19 @@ class Input::Session_component : public Genode::Rpc_object<Input::Session>
 
 		/**
 		 * Submit input event to event queue
+		 *
+		 * \param submit_signal_immediately  false to defer the notification
+		 *                                   of the client to an explicit call
+		 *                                   of 'Event_queue::submit_signal'
 		 */
-		void submit(Input::Event event)
+		void submit(Input::Event event, bool submit_signal_immediately = true)
 		{
 			try {
-				_event_queue.add(event);
+				_event_queue.add(event, submit_signal_immediately);
 			} catch (Input::Event_queue::Overflow) {
-				Genode::warning("input overflow - resetting queue");
+				Genode::warning("input overflow - resetting queue (",
+				                _event_queue.overflows(), " overflows, ",
+				                _event_queue.coalesced(), " coalesced motion events)");
 				_event_queue.reset();
 			}
 		}
@@ -94,7 +105,9 @@ class Input::Session_component : public Genode::Rpc_object<Input::Session>
 			Input::Event *dst = _ds.local_addr<Input::Event>();
 			
 			unsigned cnt = 0;
-			for (; cnt < Event_queue::QUEUE_SIZE && !_event_queue.empty(); cnt++)
+			unsigned const max = _ds.size() / sizeof(Input::Event);
+
+			for (; cnt < max && !_event_queue.empty(); cnt++)
 				*dst++ = _event_queue.get();
 
 			return cnt;
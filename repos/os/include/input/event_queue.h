@@ -15,8 +15,10 @@
 #define _EVENT_QUEUE_H_
 
 #include <base/signal.h>
+#include <base/lock.h>
+#include <base/exception.h>
+#include <util/misc_math.h>
 #include <input/event.h>
-#include <os/ring_buffer.h>
 
 namespace Input { class Event_queue; };
 
@@ -32,27 +34,93 @@ class Input::Event_queue
 		 * queues up to 255 events, which should be enough. Normally, PS/2
 		 * generates not more than 16Kbit/s, which would correspond to ca. 66 mouse
 		 * events per 10ms.
+		 *
+		 * Fast mice and touchscreens generate far more events. For those,
+		 * a larger queue of up to 'MAX_QUEUE_SIZE' slots can be used. In
+		 * addition, consecutive motion events are coalesced as long as they
+		 * are not fetched by the client (see 'add').
 		 */
-		enum { QUEUE_SIZE = 512U };
+		enum { QUEUE_SIZE = 512U, MAX_QUEUE_SIZE = 4096U };
 
-		typedef Genode::Ring_buffer<Input::Event, QUEUE_SIZE> Ring_buffer;
+		class Overflow : public Genode::Exception { };
 
 	private:
 
-		Ring_buffer _queue;
+		/*
+		 * The maximum number of elements is '_size - 1'
+		 */
+		unsigned const _size;
+
+		Input::Event _queue[MAX_QUEUE_SIZE];
+
+		unsigned _head = 0;
+		unsigned _tail = 0;
+
+		/* synchronizes the source of events with the consumer */
+		Genode::Lock mutable _lock;
 
 		bool _enabled = false;
 
+		bool _coalesce_motion = true;
+
+		unsigned long _overflows = 0;
+		unsigned long _coalesced = 0;
+
 		Genode::Signal_context_capability _sigh;
 
+		unsigned _next(unsigned i) const { return (i + 1) % _size; }
+
+		/**
+		 * Merge motion event into the youngest queued event if possible
+		 *
+		 * Relative motion is accumulated, absolute motion replaces the
+		 * absolute position of the queued event. Accumulated relative
+		 * motion of zero would turn the event into an absolute motion to
+		 * (0, 0), so this case is not merged.
+		 */
+		bool _merge(Input::Event const &ev)
+		{
+			if (_head == _tail)
+				return false;
+
+			Input::Event &last = _queue[(_head + _size - 1) % _size];
+
+			if (ev.absolute_motion() && last.absolute_motion()) {
+				last = ev;
+				return true;
+			}
+
+			if (ev.relative_motion() && last.relative_motion()) {
+				int const rx = last.rx() + ev.rx(), ry = last.ry() + ev.ry();
+				if (!rx && !ry)
+					return false;
+
+				last = Input::Event(Input::Event::MOTION, 0, ev.ax(), ev.ay(), rx, ry);
+				return true;
+			}
+
+			return false;
+		}
+
 	public:
 
-		typedef Ring_buffer::Overflow Overflow;
+		/**
+		 * Constructor
+		 *
+		 * \param size  number of queue slots, at most 'MAX_QUEUE_SIZE'
+		 */
+		Event_queue(unsigned size = QUEUE_SIZE)
+		: _size(Genode::min(Genode::max(size, 2U), (unsigned)MAX_QUEUE_SIZE)) { }
 
 		void enabled(bool enabled) { _enabled = enabled; }
 
 		bool enabled() const { return _enabled; }
 
+		/**
+		 * Enable or disable the coalescing of motion events
+		 */
+		void coalesce_motion(bool enabled) { _coalesce_motion = enabled; }
+
 		void sigh(Genode::Signal_context_capability sigh) { _sigh = sigh; }
 
 		void submit_signal()
@@ -69,19 +137,73 @@ class Input::Event_queue
 			if (!_enabled)
 				return;
 
-			_queue.add(ev);
+			{
+				Genode::Lock::Guard guard(_lock);
+
+				if (_coalesce_motion && _merge(ev)) {
+					_coalesced++;
+				} else {
+
+					if (_next(_head) == _tail) {
+						_overflows++;
+						throw Overflow();
+					}
+
+					_queue[_head] = ev;
+					_head = _next(_head);
+				}
+			}
 
 			if (submit_signal_immediately)
 				submit_signal();
 		}
 
-		Input::Event get() { return _queue.get(); }
+		/**
+		 * Take event from queue
+		 *
+		 * Must not be called for an empty queue.
+		 */
+		Input::Event get()
+		{
+			Genode::Lock::Guard guard(_lock);
+
+			Input::Event const ev = _queue[_tail];
+			_tail = _next(_tail);
+			return ev;
+		}
+
+		bool empty() const
+		{
+			Genode::Lock::Guard guard(_lock);
+			return _tail == _head;
+		}
+
+		int avail_capacity() const
+		{
+			Genode::Lock::Guard guard(_lock);
+			return (_size - 1) - (_head + _size - _tail) % _size;
+		}
+
+		void reset()
+		{
+			Genode::Lock::Guard guard(_lock);
+			_head = _tail;
+		}
 
-		bool empty() const { return _queue.empty(); }
+		/**
+		 * Return number of queue slots
+		 */
+		unsigned size() const { return _size; }
 
-		int avail_capacity() const { return _queue.avail_capacity(); }
+		/**
+		 * Return number of events rejected because of a full queue
+		 */
+		unsigned long overflows() const { return _overflows; }
 
-		void reset() { _queue.reset(); }
+		/**
+		 * Return number of motion events merged into queued events
+		 */
+		unsigned long coalesced() const { return _coalesced; }
 };
 
 #endif /* _EVENT_QUEUE_H_ */
@@ -0,0 +1,118 @@
+/*
+ * \brief  Flow hash for distributing NIC packets over multiple queues
+ * \author Genode Labs
+ * \date   2026-10-14
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__NIC__FLOW_HASH_H_
+#define _INCLUDE__NIC__FLOW_HASH_H_
+
+/* Genode includes */
+#include <base/stdint.h>
+#include <net/ethernet.h>
+#include <net/ipv4.h>
+
+namespace Nic { struct Flow_hash; }
+
+
+/**
+ * Classification of Ethernet frames by flow
+ *
+ * Similar to the receive-side scaling of network cards, IPv4 packets are
+ * classified by their addresses and protocol and, if not fragmented, by their
+ * TCP or UDP ports. The hash is symmetric, so both directions of a flow map to
+ * the same value. All other frames are classified by their MAC addresses.
+ */
+struct Nic::Flow_hash
+{
+	enum {
+		IPV4_FLAGS_OFFSET    = 6,
+		IPV4_PROTOCOL_OFFSET = 9,
+		IPV4_SRC_OFFSET      = 12,
+		IPV4_DST_OFFSET      = 16,
+		IPV4_FRAGMENT_MASK   = 0x3f,
+		PROTOCOL_TCP         = 6,
+		PROTOCOL_UDP         = 17,
+	};
+
+	static Genode::uint32_t _read_32(Genode::uint8_t const *p) {
+		return (p[0] << 24) | (p[1] << 16) | (p[2] << 8) | p[3]; }
+
+	static Genode::uint32_t _read_16(Genode::uint8_t const *p) {
+		return (p[0] << 8) | p[1]; }
+
+	/**
+	 * Finalization step of the MurmurHash3 algorithm
+	 */
+	static Genode::uint32_t _mix(Genode::uint32_t h)
+	{
+		h ^= h >> 16;
+		h *= 0x85ebca6b;
+		h ^= h >> 13;
+		h *= 0xc2b2ae35;
+		h ^= h >> 16;
+		return h;
+	}
+
+	/**
+	 * Return flow hash of an Ethernet frame
+	 */
+	static Genode::uint32_t value(void const *eth_base, Genode::size_t size)
+	{
+		using namespace Genode;
+		using Net::Ethernet_frame;
+
+		if (size < sizeof(Ethernet_frame))
+			return 0;
+
+		uint8_t const *eth = (uint8_t const *)eth_base;
+		Ethernet_frame const &frame = *(Ethernet_frame const *)eth_base;
+
+		if (frame.type() != Ethernet_frame::Type::IPV4 ||
+		    size < sizeof(Ethernet_frame) + sizeof(Net::Ipv4_packet))
+		{
+			/* MAC addresses, symmetric by XOR */
+			uint32_t h = 0;
+			for (unsigned i = 0; i < Ethernet_frame::ADDR_LEN; i++)
+				h = (h << 5) ^ (h >> 27) ^ (eth[i] ^ eth[i + Ethernet_frame::ADDR_LEN]);
+			return _mix(h);
+		}
+
+		uint8_t const *ip = eth + sizeof(Ethernet_frame);
+		uint32_t h = _read_32(ip + IPV4_SRC_OFFSET) ^ _read_32(ip + IPV4_DST_OFFSET);
+		uint8_t const protocol = ip[IPV4_PROTOCOL_OFFSET];
+		h ^= protocol;
+
+		/* only the first fragment contains the header of the transport layer */
+		bool const fragment = (ip[IPV4_FLAGS_OFFSET] & IPV4_FRAGMENT_MASK) ||
+		                       ip[IPV4_FLAGS_OFFSET + 1];
+
+		size_t const ip_header_size = (ip[0] & 0xf) * 4;
+		if (!fragment &&
+		    (protocol == PROTOCOL_TCP || protocol == PROTOCOL_UDP) &&
+		    size >= sizeof(Ethernet_frame) + ip_header_size + 4)
+		{
+			uint8_t const *ports = ip + ip_header_size;
+			h ^= (_read_16(ports) ^ _read_16(ports + 2)) << 8;
+		}
+		return _mix(h);
+	}
+
+	/**
+	 * Return queue out of 'queues' that an Ethernet frame is assigned to
+	 */
+	static unsigned queue(void const *eth_base, Genode::size_t size,
+	                      unsigned queues)
+	{
+		return queues > 1 ? value(eth_base, size) % queues : 0;
+	}
+};
+
+#endif /* _INCLUDE__NIC__FLOW_HASH_H_ */
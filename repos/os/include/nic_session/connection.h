@@ -31,12 +31,15 @@ struct Nic::Connection : Genode::Connection<Session>, Session_client
 	Capability<Nic::Session> _session(Genode::Parent &parent,
 	                                  char const *label,
 	                                  Genode::size_t tx_buf_size,
-	                                  Genode::size_t rx_buf_size)
+	                                  Genode::size_t rx_buf_size,
+	                                  unsigned queue  = 0,
+	                                  unsigned queues = 1)
 	{
 		return session(parent,
-		               "ram_quota=%ld, cap_quota=%ld, tx_buf_size=%ld, rx_buf_size=%ld, label=\"%s\"",
+		               "ram_quota=%ld, cap_quota=%ld, tx_buf_size=%ld, rx_buf_size=%ld, "
+		               "queue=%u, queues=%u, label=\"%s\"",
 		               32*1024*sizeof(long) + tx_buf_size + rx_buf_size,
-		               CAP_QUOTA, tx_buf_size, rx_buf_size, label);
+		               CAP_QUOTA, tx_buf_size, rx_buf_size, queue, queues, label);
 	}
 
 	/**
@@ -46,15 +49,22 @@ struct Nic::Connection : Genode::Connection<Session>, Session_client
 	 *                         transmission buffer
 	 * \param tx_buf_size      size of transmission buffer in bytes
 	 * \param rx_buf_size      size of reception buffer in bytes
+	 * \param queue            index of the session within a multi-queue
+	 *                         session
+	 * \param queues           number of sessions of the multi-queue
+	 *                         session, see 'Nic::Session::MAX_QUEUES'
 	 */
 	Connection(Genode::Env             &env,
 	           Genode::Range_allocator *tx_block_alloc,
 	           Genode::size_t           tx_buf_size,
 	           Genode::size_t           rx_buf_size,
-	           char const              *label = "")
+	           char const              *label  = "",
+	           unsigned                 queue  = 0,
+	           unsigned                 queues = 1)
 	:
 		Genode::Connection<Session>(env, _session(env.parent(), label,
-		                                          tx_buf_size, rx_buf_size)),
+		                                          tx_buf_size, rx_buf_size,
+		                                          queue, queues)),
 		Session_client(cap(), *tx_block_alloc, env.rm())
 	{ }
 
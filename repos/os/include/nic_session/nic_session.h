@@ -54,6 +54,17 @@ struct Nic::Session : Genode::Session
 {
 	enum { QUEUE_SIZE = 1024 };
 
+	/*
+	 * A client may open up to 'MAX_QUEUES' sessions with the same label that
+	 * form one multi-queue session. The sessions are distinguished by the
+	 * session arguments 'queue' and 'queues' and share one MAC address.
+	 * A server that supports multiple queues distributes the packets
+	 * destined for the client over those sessions by flow, so that each
+	 * session can be served by a separate entrypoint of the client. Servers
+	 * that are unaware of multiple queues treat each session individually.
+	 */
+	enum { MAX_QUEUES = 16 };
+
 	/*
 	 * Types used by the client stub code and server implementation
 	 *
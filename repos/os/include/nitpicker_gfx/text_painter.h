@@ -29,11 +29,58 @@ struct Text_painter
 
 		public:
 
+			/**
+			 * Bounding box of the visible pixels of a glyph
+			 *
+			 * The coordinates are relative to the glyph's cell. An empty
+			 * glyph has a box with 'x1 > x2'.
+			 */
+			struct Box { unsigned short x1, y1, x2, y2; };
+
 			unsigned char const *img;            /* font image         */
 			int           const  img_w, img_h;   /* size of font image */
 			int32_t       const *otab;           /* offset table       */
 			int32_t       const *wtab;           /* width table        */
 
+		private:
+
+			Box _boxes[256];
+
+			/**
+			 * Determine the boxes of all glyphs
+			 *
+			 * Glyphs are mostly transparent. Knowing their boxes, the
+			 * painters skip the transparent parts.
+			 */
+			void _init_boxes()
+			{
+				for (unsigned c = 0; c < 256; c++) {
+
+					Box box { 1, 1, 0, 0 };
+					bool empty = true;
+
+					for (int y = 0; y < img_h; y++) {
+						unsigned char const *row = img + otab[c] + y*img_w;
+						for (int x = 0; x < wtab[c]; x++) {
+							if (!row[x])
+								continue;
+
+							if (empty) {
+								box = Box { (unsigned short)x, (unsigned short)y,
+								            (unsigned short)x, (unsigned short)y };
+								empty = false;
+							}
+							if (x < box.x1) box.x1 = x;
+							if (x > box.x2) box.x2 = x;
+							box.y2 = y;
+						}
+					}
+					_boxes[c] = box;
+				}
+			}
+
+		public:
+
 			/**
 			 * Construct font from a TFF data block
 			 */
@@ -46,7 +93,14 @@ struct Text_painter
 
 				otab((int32_t *)(tff)),
 				wtab((int32_t *)(tff + 1024))
-			{ }
+			{
+				_init_boxes();
+			}
+
+			/**
+			 * Return bounding box of the visible pixels of glyph 'c'
+			 */
+			Box box(unsigned char c) const { return _boxes[c]; }
 
 			/**
 			 * Calculate width of string when printed with the font
@@ -71,6 +125,51 @@ struct Text_painter
 	typedef Genode::Surface_base::Rect  Rect;
 
 
+	/**
+	 * Blend a row of glyph pixels with the given color
+	 *
+	 * \param alpha        glyph alpha values
+	 * \param color_alpha  alpha value of the color
+	 *
+	 * The alpha values are examined eight at a time. Transparent runs are
+	 * skipped and opaque runs are filled without blending.
+	 */
+	template <typename PT>
+	static inline void blend_span(PT *dst, unsigned char const *alpha, int n,
+	                              PT pix, int color_alpha)
+	{
+		typedef Genode::uint64_t uint64_t;
+
+		auto blend = [&] (int i) {
+			if (alpha[i])
+				dst[i] = (alpha[i] == 255 && color_alpha == 255)
+				       ? pix : PT::mix(dst[i], pix, (color_alpha*alpha[i]) >> 8);
+		};
+
+		int i = 0;
+		for (; i + 8 <= n; i += 8) {
+
+			uint64_t word;
+			__builtin_memcpy(&word, alpha + i, sizeof(word));
+
+			if (!word)
+				continue;
+
+			if (word == ~0ULL && color_alpha == 255) {
+				for (int k = 0; k < 8; k++)
+					dst[i + k] = pix;
+				continue;
+			}
+
+			for (int k = 0; k < 8; k++)
+				blend(i + k);
+		}
+
+		for (; i < n; i++)
+			blend(i);
+	}
+
+
 	template <typename PT>
 	static inline void paint(Genode::Surface<PT> &surface,
 	                         Point                p,
@@ -82,13 +181,14 @@ struct Text_painter
 		int x = p.x(), y = p.y();
 
 		unsigned char const *src = font.img;
-		int d, h = font.img_h;
+		int d, h = font.img_h, top = 0;
 
 		/* check top clipping */
 		if ((d = surface.clip().y1() - y) > 0) {
 			src += d*font.img_w;
 			y   += d;
 			h   -= d;
+			top  = d;
 		}
 
 		/* check bottom clipping */
@@ -111,18 +211,24 @@ struct Text_painter
 		/* draw glyphs */
 		for ( ; *str && (x <= surface.clip().x2()); str++) {
 
-			int const w     = font.wtab[*str];
-			int const start = Genode::max(0,     surface.clip().x1() - x);
-			int const end   = Genode::min(w - 1, surface.clip().x2() - x);
+			int      const w   = font.wtab[*str];
+			Font::Box const box = font.box(*str);
+
+			/* restrict drawing to the visible part of the glyph */
+			int const start = Genode::max((int)box.x1, surface.clip().x1() - x);
+			int const end   = Genode::min((int)box.x2, Genode::min(w - 1, surface.clip().x2() - x));
+			int const first = Genode::max(0, box.y1 - top);
+			int const last  = Genode::min(h - 1, box.y2 - top);
+
+			int const line = surface.size().w();
+
+			PT                  *d = dst + x + first*line;
+			unsigned char const *s = src + font.otab[*str] + first*font.img_w;
 
-			PT                  *d = dst + x;
-			unsigned char const *s = src + font.otab[*str];
+			if (start <= end)
+				for (int j = first; j <= last; j++, s += font.img_w, d += line)
+					blend_span(d + start, s + start, end - start + 1, pix, alpha);
 
-			for (int j = 0; j < h; j++, s += font.img_w, d += surface.size().w())
-				for (int i = start; i <= end; i++)
-					if (s[i])
-						d[i] = (s[i] == 255 && alpha == 255)
-						     ? pix : PT::mix(d[i], pix, (alpha*s[i]) >> 8);
 			x += w;
 		}
 
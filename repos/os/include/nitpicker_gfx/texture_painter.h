@@ -16,6 +16,8 @@
 
 #include <blit/blit.h>
 #include <os/texture.h>
+#include <os/pixel_rgb565.h>
+#include <os/pixel_rgb888.h>
 
 
 struct Texture_painter
@@ -43,13 +45,81 @@ struct Texture_painter
 	typedef Genode::Surface_base::Rect  Rect;
 
 
+	/**
+	 * Mix line of texture pixels into the surface according to their alpha
+	 */
+	template <typename PT>
+	static inline void _blend_line(PT *dst, PT const *src,
+	                               unsigned char const *alpha, int n)
+	{
+		for (; n-- > 0; src++, dst++, alpha++)
+			if (*alpha)
+				*dst = PT::mix(*dst, *src, *alpha);
+	}
+
+	/*
+	 * The blit library provides vectorized kernels for the common pixel
+	 * formats
+	 */
+
+	static inline void _blend_line(Genode::Pixel_rgb565 *dst,
+	                               Genode::Pixel_rgb565 const *src,
+	                               unsigned char const *alpha, int n)
+	{
+		blit_blend_rgb565(dst, src, alpha, n);
+	}
+
+	static inline void _blend_line(Genode::Pixel_rgb888 *dst,
+	                               Genode::Pixel_rgb888 const *src,
+	                               unsigned char const *alpha, int n)
+	{
+		blit_blend_rgb888(dst, src, alpha, n);
+	}
+
+
+	/**
+	 * Mix line of texture pixels with a uniform opacity applied
+	 *
+	 * The per-pixel alpha values are combined with the opacity in chunks,
+	 * which are then blended by the regular blend kernels.
+	 */
+	template <typename PT>
+	static inline void _blend_line(PT *dst, PT const *src,
+	                               unsigned char const *alpha, int n,
+	                               unsigned opacity)
+	{
+		enum { CHUNK = 256 };
+		unsigned char chunk_alpha[CHUNK];
+
+		while (n > 0) {
+
+			int const chunk = n < CHUNK ? n : CHUNK;
+
+			for (int i = 0; i < chunk; i++)
+				chunk_alpha[i] = alpha ? (alpha[i]*(opacity + 1)) >> 8 : opacity;
+
+			_blend_line(dst, src, chunk_alpha, chunk);
+
+			dst += chunk; src += chunk; n -= chunk;
+			if (alpha) alpha += chunk;
+		}
+	}
+
+
+	/**
+	 * Paint texture onto surface
+	 *
+	 * \param opacity  uniform opacity (0...255) applied to the texture
+	 *                 in 'SOLID' mode
+	 */
 	template <typename PT>
 	static inline void paint(Genode::Surface<PT>       &surface,
 	                         Genode::Texture<PT> const &texture,
 	                         Genode::Color              mix_color,
 	                         Point                      position,
 	                         Mode                       mode,
-	                         bool                       allow_alpha)
+	                         bool                       allow_alpha,
+	                         unsigned                   opacity = 255)
 	{
 		Rect clipped = Rect::intersect(Rect(position, texture.size()),
 		                               surface.clip());
@@ -77,12 +147,28 @@ struct Texture_painter
 		int i, j;
 		PT            const *s;
 		PT                  *d;
-		unsigned char const *a;
 
 		switch (mode) {
 
 		case SOLID:
 
+			if (opacity == 0)
+				return;
+
+			/*
+			 * Blend texture with reduced opacity, taking the alpha channel
+			 * into account if present
+			 */
+			if (opacity < 255) {
+
+				bool const use_alpha = texture.alpha() && allow_alpha;
+
+				for (j = clipped.h(); j--; src += src_w, alpha += src_w, dst += dst_w)
+					_blend_line(dst, src, use_alpha ? alpha : nullptr,
+					            clipped.w(), opacity);
+				break;
+			}
+
 			/*
 			 * If the texture has no alpha channel, we can use
 			 * a plain pixel blit.
@@ -98,9 +184,7 @@ struct Texture_painter
 			 * Copy texture with alpha blending
 			 */
 			for (j = clipped.h(); j--; src += src_w, alpha += src_w, dst += dst_w)
-				for (i = clipped.w(), s = src, a = alpha, d = dst; i--; s++, d++, a++)
-					if (*a)
-						*d = PT::mix(*d, *s, *a);
+				_blend_line(dst, src, alpha, clipped.w());
 			break;
 
 		case MIXED:
@@ -72,7 +72,7 @@ struct Nitpicker::Session : Genode::Session
 	{
 		enum Opcode { OP_GEOMETRY, OP_OFFSET,
 		              OP_TO_FRONT, OP_TO_BACK, OP_BACKGROUND,
-		              OP_TITLE, OP_NOP };
+		              OP_TITLE, OP_ALPHA, OP_NOP };
 
 		/*
 		 * Argument structures for nitpicker's command interface
@@ -121,6 +121,19 @@ struct Nitpicker::Session : Genode::Session
 			Genode::String<64> title;
 		};
 
+		/**
+		 * Opacity of the view content, 255 is opaque
+		 *
+		 * A view with zero opacity is invisible and does not respond to
+		 * input.
+		 */
+		struct Alpha
+		{
+			static Opcode opcode() { return OP_ALPHA; }
+			View_handle   view;
+			unsigned char alpha;
+		};
+
 		Opcode opcode;
 		union
 		{
@@ -131,6 +144,7 @@ struct Nitpicker::Session : Genode::Session
 			To_back    to_back;
 			Background background;
 			Title      title;
+			Alpha      alpha;
 		};
 
 		Command() : opcode(OP_NOP) { }
@@ -15,13 +15,77 @@
 #define _INCLUDE__OS__DITHER_PAINTER_H_
 
 /* Genode includes */
+#include <blit/blit.h>
 #include <util/dither_matrix.h>
 #include <os/surface.h>
 #include <os/texture.h>
+#include <os/pixel_rgb565.h>
+#include <os/pixel_rgb888.h>
 
 
 struct Dither_painter
 {
+	/**
+	 * Convert line of pixels starting at position 'x', 'y'
+	 *
+	 * \param src_alpha  alpha values of the source pixels, or nullptr
+	 */
+	template <typename DST_PT, typename SRC_PT>
+	static inline void _paint_line(DST_PT *dst, SRC_PT const *src_pixel,
+	                               unsigned char const *src_alpha,
+	                               unsigned n, unsigned x, unsigned y)
+	{
+		using Genode::max;
+
+		if (src_alpha) {
+			for (; n--; x++) {
+
+				int const v = Genode::Dither_matrix::value(x, y) >> 4;
+
+				SRC_PT        const pixel = *src_pixel++;
+				unsigned char const alpha = *src_alpha++;
+
+				int const r = pixel.r() - v;
+				int const g = pixel.g() - v;
+				int const b = pixel.b() - v;
+				int const a = alpha ? (int)alpha - v : 0;
+
+				*dst++ = DST_PT(max(0, r), max(0, g), max(0, b), max(0, a));
+			}
+		} else {
+			for (; n--; x++) {
+
+				int const v = Genode::Dither_matrix::value(x, y) >> 4;
+
+				SRC_PT const pixel = *src_pixel++;
+
+				int const r = pixel.r() - v;
+				int const g = pixel.g() - v;
+				int const b = pixel.b() - v;
+
+				*dst++ = DST_PT(max(0, r), max(0, g), max(0, b));
+			}
+		}
+	}
+
+	/*
+	 * The conversion from RGB888 to RGB565 is provided by the blit library.
+	 * Because RGB565 has no alpha channel, the source alpha is irrelevant.
+	 */
+	static inline void _paint_line(Genode::Pixel_rgb565 *dst,
+	                               Genode::Pixel_rgb888 const *src_pixel,
+	                               unsigned char const *,
+	                               unsigned n, unsigned x, unsigned y)
+	{
+		Genode::Dither_matrix::Row const row = Genode::Dither_matrix::row(y);
+
+		unsigned char dither[16];
+		for (unsigned i = 0; i < sizeof(dither); i++)
+			dither[i] = row.value(i) >> 4;
+
+		blit_convert_rgb888_to_rgb565(dst, src_pixel, n, dither, x);
+	}
+
 	/*
 	 * Surface and texture must have the same size
 	 */
@@ -46,9 +110,9 @@ struct Dither_painter
 		unsigned const src_line_len = texture.size().w();
 		unsigned const src_offset = src_line_len*clipped.y1() + clipped.x1();
 
-		DST_PT              *dst,       *dst_line       = surface.addr()  + dst_offset;
-		SRC_PT        const *src_pixel, *src_pixel_line = texture.pixel() + src_offset;
-		unsigned char const *src_alpha, *src_alpha_line = texture.alpha() + src_offset;
+		DST_PT              *dst_line       = surface.addr()  + dst_offset;
+		SRC_PT        const *src_pixel_line = texture.pixel() + src_offset;
+		unsigned char const *src_alpha_line = texture.alpha() + src_offset;
 		bool          const  src_has_alpha = texture.alpha() != nullptr;
 
 		unsigned const x_max = min((unsigned)clipped.x2(), dst_x + texture.size().w() - 1);
@@ -56,39 +120,10 @@ struct Dither_painter
 
 		for (unsigned y = dst_y; y <= y_max; y++) {
 
-			src_pixel = src_pixel_line;
-			src_alpha = src_alpha_line;
-			dst       = dst_line;
-
-			if (src_has_alpha) {
-				for (unsigned x = dst_x; x <= x_max; x++) {
-
-					int const v = Genode::Dither_matrix::value(x, y) >> 4;
-
-					SRC_PT        const pixel = *src_pixel++;
-					unsigned char const alpha = *src_alpha++;
-
-					int const r = pixel.r() - v;
-					int const g = pixel.g() - v;
-					int const b = pixel.b() - v;
-					int const a = alpha ? (int)alpha - v : 0;
-
-					*dst++ = DST_PT(max(0, r), max(0, g), max(0, b), max(0, a));
-				}
-			} else {
-				for (unsigned x = dst_x; x <= x_max; x++) {
-
-					int const v = Genode::Dither_matrix::value(x, y) >> 4;
-
-					SRC_PT const pixel = *src_pixel++;
-
-					int const r = pixel.r() - v;
-					int const g = pixel.g() - v;
-					int const b = pixel.b() - v;
-
-					*dst++ = DST_PT(max(0, r), max(0, g), max(0, b));
-				}
-			}
+			if (x_max >= dst_x)
+				_paint_line(dst_line, src_pixel_line,
+				            src_has_alpha ? src_alpha_line : nullptr,
+				            x_max - dst_x + 1, dst_x, y);
 
 			src_pixel_line += src_line_len;
 			src_alpha_line += src_line_len;
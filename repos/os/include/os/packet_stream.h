@@ -61,6 +61,16 @@
  * acknowledge buffers using the methods 'packet_avail',
  * 'ready_to_submit', 'ready_to_ack', and 'ack_avail'.
  *
+ * For high packet rates, both parties may use the non-blocking bulk variants
+ * 'submit_packets', 'get_packets', 'acknowledge_packets', and
+ * 'get_acked_packets'. Those transfer a batch of packet descriptors under a
+ * single acquisition of the queue lock and deliver at most one signal per
+ * batch.
+ *
+ * Furthermore, the signals that notify the opposite party about new packets
+ * or acknowledgements can be coalesced similar to the interrupt moderation of
+ * network cards. See 'coalesce_packet_avail' and 'coalesce_ack_avail'.
+ *
  * If bidirectional data exchange between two processes is desired, two pairs
  * of 'Packet_stream_source' and 'Packet_stream_sink' should be instantiated.
  */
@@ -269,6 +279,58 @@ class Genode::Packet_descriptor_transmitter
 		Genode::Lock _tx_queue_lock;
 		TX_QUEUE    *_tx_queue;
 
+	public:
+
+		/**
+		 * Counters of the signal coalescing
+		 */
+		struct Signal_stats
+		{
+			unsigned long submitted; /* ready-to-receive signals sent */
+			unsigned long deferred;  /* packets that deferred a signal */
+		};
+
+	private:
+
+		/*
+		 * Signal coalescing
+		 *
+		 * With a threshold greater than one, the ready-to-receive signal
+		 * is not submitted on the empty-to-non-empty transition of the queue
+		 * but only after 'threshold' packets were added since or once
+		 * 'flush' is called.
+		 */
+		unsigned     _coalesce_threshold { 0 };
+		unsigned     _coalesced          { 0 };
+		bool         _wakeup_due         { false };
+		Signal_stats _stats              { 0, 0 };
+
+		void _rx_wakeup()
+		{
+			_rx_ready.submit();
+			_wakeup_due = false;
+			_coalesced  = 0;
+			_stats.submitted++;
+		}
+
+		/**
+		 * Account newly added packet and determine if a wakeup is needed
+		 */
+		void _packet_added(bool &wakeup)
+		{
+			if (_tx_queue->single_element())
+				_wakeup_due = true;
+
+			if (!_wakeup_due)
+				return;
+
+			if (++_coalesced < _coalesce_threshold) {
+				_stats.deferred++;
+				return;
+			}
+			wakeup = true;
+		}
+
 	public:
 
 		/**
@@ -315,8 +377,14 @@ class Genode::Packet_descriptor_transmitter
 
 			do {
 				/* block for signal if tx queue is full */
-				if (_tx_queue->full())
+				if (_tx_queue->full()) {
+
+					/* never sleep while the receiver is not notified */
+					if (_wakeup_due)
+						_rx_wakeup();
+
 					_tx_ready.wait_for_signal();
+				}
 
 				/*
 				 * It could happen that pending signals do not refer to the
@@ -326,8 +394,77 @@ class Genode::Packet_descriptor_transmitter
 
 			} while (_tx_queue->add(packet) == false);
 
-			if (_tx_queue->single_element())
-				_rx_ready.submit();
+			bool wakeup = false;
+			_packet_added(wakeup);
+			if (wakeup)
+				_rx_wakeup();
+		}
+
+		/**
+		 * Transmit a batch of packet descriptors
+		 *
+		 * In contrast to 'tx', this method does not block but inserts as
+		 * many descriptors as fit into the queue. The receiver is woken up
+		 * by at most one signal for the whole batch.
+		 *
+		 * \return number of packet descriptors actually transmitted
+		 */
+		unsigned tx_bulk(typename TX_QUEUE::Packet_descriptor const *packets,
+		                 unsigned                                     count)
+		{
+			Genode::Lock::Guard lock_guard(_tx_queue_lock);
+
+			bool     wakeup = false;
+			unsigned i      = 0;
+			for (; i < count; i++) {
+
+				if (!_tx_queue->add(packets[i]))
+					break;
+
+				/*
+				 * Remember any empty-to-non-empty transition, the receiver
+				 * may have drained the queue concurrently.
+				 */
+				_packet_added(wakeup);
+			}
+
+			/* a full queue must never stay unnoticed by the receiver */
+			if (wakeup || (_wakeup_due && _tx_queue->full()))
+				_rx_wakeup();
+
+			return i;
+		}
+
+		/**
+		 * Enable coalescing of ready-to-receive signals
+		 *
+		 * \param threshold  number of packets that are accumulated before
+		 *                   signalling the receiver, a value of 0 or 1
+		 *                   disables the coalescing
+		 */
+		void coalesce(unsigned threshold)
+		{
+			Genode::Lock::Guard lock_guard(_tx_queue_lock);
+			_coalesce_threshold = threshold;
+		}
+
+		/**
+		 * Submit a deferred ready-to-receive signal
+		 *
+		 * When coalescing signals, this method must be called periodically,
+		 * e.g., on a timeout, to bound the latency of the last packets.
+		 */
+		void flush()
+		{
+			Genode::Lock::Guard lock_guard(_tx_queue_lock);
+			if (_wakeup_due)
+				_rx_wakeup();
+		}
+
+		Signal_stats signal_stats()
+		{
+			Genode::Lock::Guard lock_guard(_tx_queue_lock);
+			return _stats;
 		}
 
 		/**
@@ -411,6 +548,35 @@ class Genode::Packet_descriptor_receiver
 				_tx_ready.submit();
 		}
 
+		/**
+		 * Receive a batch of packet descriptors
+		 *
+		 * This method does not block. The transmitter is woken up by at
+		 * most one signal for the whole batch.
+		 *
+		 * \return number of packet descriptors stored at 'out_packets'
+		 */
+		unsigned rx_bulk(typename RX_QUEUE::Packet_descriptor *out_packets,
+		                 unsigned                              max_count)
+		{
+			Genode::Lock::Guard lock_guard(_rx_queue_lock);
+
+			bool     wakeup = false;
+			unsigned i      = 0;
+			for (; i < max_count && !_rx_queue->empty(); i++) {
+
+				out_packets[i] = _rx_queue->get();
+
+				if (_rx_queue->single_slot_free())
+					wakeup = true;
+			}
+
+			if (wakeup)
+				_tx_ready.submit();
+
+			return i;
+		}
+
 		typename RX_QUEUE::Packet_descriptor rx_peek() const
 		{
 			Genode::Lock::Guard lock_guard(_rx_queue_lock);
@@ -681,6 +847,12 @@ class Genode::Packet_stream_source : private Packet_stream_base
 			return _submit_transmitter.ready_for_tx();
 		}
 
+		/**
+		 * Return number of packets that can be submitted without blocking
+		 */
+		unsigned submit_slots_free() {
+			return _submit_transmitter.tx_slots_free(); }
+
 		/**
 		 * Tell sink about a packet to process
 		 */
@@ -689,6 +861,46 @@ class Genode::Packet_stream_source : private Packet_stream_base
 			_submit_transmitter.tx(packet);
 		}
 
+		/**
+		 * Tell sink about a batch of packets to process
+		 *
+		 * This method does not block. Packets that do not fit into the
+		 * submit queue remain in the responsibility of the caller.
+		 *
+		 * \return number of submitted packets
+		 */
+		unsigned submit_packets(Packet_descriptor const *packets,
+		                        unsigned                 count)
+		{
+			return _submit_transmitter.tx_bulk(packets, count);
+		}
+
+		typedef typename Packet_descriptor_transmitter<Submit_queue>::Signal_stats
+		        Signal_stats;
+
+		/**
+		 * Coalesce packet-avail signals sent to the sink
+		 *
+		 * \param threshold  number of submitted packets per signal, a value of
+		 *                   0 or 1 disables the coalescing
+		 *
+		 * A source that uses coalescing must call 'flush_packet_avail'
+		 * whenever it stops submitting packets for a while.
+		 */
+		void coalesce_packet_avail(unsigned threshold) {
+			_submit_transmitter.coalesce(threshold); }
+
+		/**
+		 * Deliver a deferred packet-avail signal
+		 */
+		void flush_packet_avail() { _submit_transmitter.flush(); }
+
+		/**
+		 * Return counters of the packet-avail signalling
+		 */
+		Signal_stats packet_avail_stats() {
+			return _submit_transmitter.signal_stats(); }
+
 		/**
 		 * Returns true if one or more packet acknowledgements are available
 		 */
@@ -704,6 +916,17 @@ class Genode::Packet_stream_source : private Packet_stream_base
 			return packet;
 		}
 
+		/**
+		 * Get up to 'max_count' acknowledged packets without blocking
+		 *
+		 * \return number of packets stored at 'packets'
+		 */
+		unsigned get_acked_packets(Packet_descriptor *packets,
+		                           unsigned           max_count)
+		{
+			return _ack_receiver.rx_bulk(packets, max_count);
+		}
+
 		/**
 		 * Release bulk-buffer space consumed by the packet
 		 */
@@ -822,6 +1045,16 @@ class Genode::Packet_stream_sink : private Packet_stream_base
 			return packet;
 		}
 
+		/**
+		 * Get up to 'max_count' packets from source without blocking
+		 *
+		 * \return number of packets stored at 'packets'
+		 */
+		unsigned get_packets(Packet_descriptor *packets, unsigned max_count)
+		{
+			return _submit_receiver.rx_bulk(packets, max_count);
+		}
+
 		/**
 		 * Return but do not dequeue next packet
 		 *
@@ -866,6 +1099,46 @@ class Genode::Packet_stream_sink : private Packet_stream_base
 			_ack_transmitter.tx(packet);
 		}
 
+		/**
+		 * Acknowledge a batch of packets
+		 *
+		 * This method does not block. Packets that do not fit into the
+		 * acknowledgement queue remain in the responsibility of the caller.
+		 *
+		 * \return number of acknowledged packets
+		 */
+		unsigned acknowledge_packets(Packet_descriptor const *packets,
+		                             unsigned                 count)
+		{
+			return _ack_transmitter.tx_bulk(packets, count);
+		}
+
+		typedef typename Packet_descriptor_transmitter<Ack_queue>::Signal_stats
+		        Signal_stats;
+
+		/**
+		 * Coalesce ack-avail signals sent to the source
+		 *
+		 * \param threshold  number of acknowledged packets per signal, a value
+		 *                   of 0 or 1 disables the coalescing
+		 *
+		 * A sink that uses coalescing must call 'flush_ack_avail' whenever
+		 * it stops acknowledging packets for a while.
+		 */
+		void coalesce_ack_avail(unsigned threshold) {
+			_ack_transmitter.coalesce(threshold); }
+
+		/**
+		 * Deliver a deferred ack-avail signal
+		 */
+		void flush_ack_avail() { _ack_transmitter.flush(); }
+
+		/**
+		 * Return counters of the ack-avail signalling
+		 */
+		Signal_stats ack_avail_stats() {
+			return _ack_transmitter.signal_stats(); }
+
 		void debug_print_buffers() {
 			Packet_stream_base::_debug_print_buffers(); }
 
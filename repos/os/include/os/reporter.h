@@ -34,30 +34,106 @@ class Genode::Reporter : Noncopyable
 		Name const _xml_name;
 		Name const _label;
 
-		size_t const _buffer_size;
+		size_t _buffer_size;
 
 		bool _enabled = false;
 
+		bool _expanding = false;
+
+		size_t _max_report_size = 0;
+
 		struct Connection
 		{
 			Report::Connection report;
 			Attached_dataspace ds = { *env_deprecated()->rm_session(), report.dataspace() };
 
-			Connection(char const *name, size_t buffer_size)
-			: report(false, name, buffer_size) { }
+			Connection(char const *name, size_t buffer_size, size_t max_report_size)
+			: report(false, name, buffer_size, max_report_size) { }
 		};
 
-		Constructible<Connection> _conn;
+		/*
+		 * Two connection slots allow for replacing the connection by one
+		 * with a larger report buffer while preserving the buffer content
+		 */
+		Constructible<Connection> _conn_slots[2];
+		unsigned                  _curr_slot = 0;
+
+		Connection       &_conn()       { return *_conn_slots[_curr_slot]; }
+		Connection const &_conn() const { return *_conn_slots[_curr_slot]; }
 
 		/**
 		 * Return size of report buffer
 		 */
-		size_t _size() const { return _enabled ? _conn->ds.size() : 0; }
+		size_t _size() const { return _enabled ? _conn().ds.size() : 0; }
 
 		/**
 		 * Return pointer to report buffer
 		 */
-		char *_base() { return _enabled ? _conn->ds.local_addr<char>() : 0; }
+		char *_base() { return _enabled ? _conn().ds.local_addr<char>() : 0; }
+
+		/**
+		 * Enlarge report buffer to at least 'min_size' bytes
+		 *
+		 * \return  false if the buffer cannot be enlarged
+		 */
+		bool _expand(size_t min_size)
+		{
+			if (!_enabled || !_expanding)
+				return false;
+
+			size_t new_size = max(_size(), (size_t)1);
+			while (new_size < min_size)
+				new_size *= 2;
+
+			unsigned const next_slot = !_curr_slot;
+			try { _conn_slots[next_slot].construct(_label.string(), new_size,
+			                                       _max_report_size); }
+			catch (...) { return false; }
+
+			memcpy(_conn_slots[next_slot]->ds.local_addr<char>(), _base(), _size());
+
+			_conn_slots[_curr_slot].destruct();
+			_curr_slot   = next_slot;
+			_buffer_size = new_size;
+			return true;
+		}
+
+		/**
+		 * Submit report in chunks of the report-buffer size
+		 */
+		void _report_chunked(char const *data, size_t length)
+		{
+			for (size_t offset = 0; offset < length; ) {
+				size_t const chunk = min(length - offset, _size());
+				memcpy(_base(), data + offset, chunk);
+				offset += chunk;
+				_conn().report.submit_chunk(chunk, offset == length);
+			}
+		}
+
+		/**
+		 * Report buffer as target of 'Reporter::Xml_generator'
+		 */
+		struct Report_buffer : Genode::Xml_generator::Expanding_buffer
+		{
+			Reporter &_reporter;
+
+			Report_buffer(Reporter &reporter) : _reporter(reporter)
+			{
+				base = _reporter._base();
+				size = _reporter._size();
+			}
+
+			bool expand(size_t min_size) override
+			{
+				if (!_reporter._expand(min_size))
+					return false;
+
+				base = _reporter._base();
+				size = _reporter._size();
+				return true;
+			}
+		};
 
 	public:
 
@@ -89,9 +165,10 @@ class Genode::Reporter : Noncopyable
 			if (enabled == _enabled) return;
 
 			if (enabled)
-				_conn.construct(_label.string(), _buffer_size);
+				_conn_slots[_curr_slot].construct(_label.string(), _buffer_size,
+				                                  _max_report_size);
 			else
-				_conn.destruct();
+				_conn_slots[_curr_slot].destruct();
 
 			_enabled = enabled;
 		}
@@ -109,6 +186,26 @@ class Genode::Reporter : Noncopyable
 		 */
 		bool is_enabled() const { return enabled(); }
 
+		/**
+		 * Enable or disable the on-demand enlargement of the report buffer
+		 *
+		 * If enabled, a report produced by 'Reporter::Xml_generator' that
+		 * exceeds the report buffer does not fail. Instead, the report
+		 * connection is replaced by one with a buffer large enough to hold
+		 * the report. The enlarged buffer is kept for subsequent reports.
+		 */
+		void expanding(bool expanding) { _expanding = expanding; }
+
+		/**
+		 * Define the maximum size of reports submitted in chunks
+		 *
+		 * If set, a report passed to 'report' that exceeds the report
+		 * buffer is submitted in chunks instead of being dropped. The
+		 * value is a session argument and must be defined before enabling
+		 * the reporter.
+		 */
+		void max_report_size(size_t size) { _max_report_size = size; }
+
 		Name name() const { return _label; }
 
 		/**
@@ -124,30 +221,57 @@ class Genode::Reporter : Noncopyable
 		 */
 		void report(void const *data, size_t length)
 		{
-			void *base = _base();
+			if (!_base())
+				return;
 
-			if (!base || length > _size())
+			if (length > _size() && !_expand(length)) {
+				if (length <= _max_report_size)
+					_report_chunked((char const *)data, length);
 				return;
+			}
+
+			void *base = _base();
 
 			memcpy(base, data, length);
-			_conn->report.submit(length);
+			_conn().report.submit(length);
+		}
+
+		/**
+		 * Produce report directly within the report buffer
+		 *
+		 * \param max_length  buffer size needed by 'fn'
+		 * \param fn          functor called with the buffer address and
+		 *                    size, returning the number of bytes to report
+		 *
+		 * This variant avoids copying large reports that are not generated
+		 * via 'Reporter::Xml_generator'.
+		 */
+		template <typename FN>
+		void report_in_place(size_t max_length, FN const &fn)
+		{
+			if (!_base() || (max_length > _size() && !_expand(max_length)))
+				return;
+
+			size_t const length = fn(_base(), _size());
+			if (length)
+				_conn().report.submit(length);
 		}
 
 		/**
 		 * XML generator targeting a reporter
 		 */
-		struct Xml_generator : public Genode::Xml_generator
+		struct Xml_generator : private Report_buffer, public Genode::Xml_generator
 		{
 			template <typename FUNC>
 			Xml_generator(Reporter &reporter, FUNC const &func)
 			:
-				Genode::Xml_generator(reporter._base(),
-				                      reporter._size(),
+				Report_buffer(reporter),
+				Genode::Xml_generator(static_cast<Report_buffer &>(*this),
 				                      reporter._xml_name.string(),
 				                      func)
 			{
 				if (reporter.enabled())
-					reporter._conn->report.submit(used());
+					reporter._conn().report.submit(used());
 			}
 		};
 };
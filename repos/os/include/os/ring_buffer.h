@@ -16,15 +16,29 @@
 
 #include <base/semaphore.h>
 #include <base/exception.h>
+#include <cpu/atomic.h>
+#include <cpu/memory_barrier.h>
+#include <util/misc_math.h>
 #include <util/string.h>
 
 namespace Genode {
 
 	struct Ring_buffer_unsynchronized;
 	struct Ring_buffer_synchronized;
+	struct Ring_buffer_spsc;
+	struct Ring_buffer_mpsc;
 
 	template <typename, int, typename SYNC_POLICY = Ring_buffer_synchronized>
 	class Ring_buffer;
+
+	template <typename, int, bool>
+	class Lock_free_ring_buffer;
+
+	template <typename ET, int QUEUE_SIZE>
+	class Ring_buffer<ET, QUEUE_SIZE, Ring_buffer_spsc>;
+
+	template <typename ET, int QUEUE_SIZE>
+	class Ring_buffer<ET, QUEUE_SIZE, Ring_buffer_mpsc>;
 }
 
 
@@ -57,6 +71,23 @@ struct Genode::Ring_buffer_synchronized
 };
 
 
+/**
+ * Lock-free policy for a single producer and a single consumer
+ *
+ * In contrast to the lock-based policies, 'get' does not block. The
+ * consumer must check for 'empty' first.
+ */
+struct Genode::Ring_buffer_spsc { };
+
+
+/**
+ * Lock-free policy for multiple producers and a single consumer
+ *
+ * As for 'Ring_buffer_spsc', 'get' does not block.
+ */
+struct Genode::Ring_buffer_mpsc { };
+
+
 /**
  * Ring buffer template
  *
@@ -146,4 +177,179 @@ class Genode::Ring_buffer
 		void reset() { _head = _tail; }
 };
 
+
+/**
+ * Ring buffer synchronized without locks
+ *
+ * \param MULTI_PRODUCER  if true, producers reserve slots via compare-and-
+ *                        exchange, otherwise, only one producer is allowed
+ *
+ * Producers reserve slots by advancing '_reserve' and mark each slot as
+ * filled once the element is written. The consumer advances '_tail' over
+ * filled slots only. The indices modified by producers and the consumer
+ * reside in distinct cache lines to avoid false sharing.
+ */
+template <typename ET, int QUEUE_SIZE, bool MULTI_PRODUCER>
+class Genode::Lock_free_ring_buffer
+{
+	private:
+
+		enum { CACHE_LINE_SIZE = 64 };
+
+		/* modified by producers */
+		int volatile _reserve __attribute__((aligned(CACHE_LINE_SIZE)));
+
+		/* modified by the consumer */
+		int volatile _tail __attribute__((aligned(CACHE_LINE_SIZE)));
+
+		int volatile _filled[QUEUE_SIZE] __attribute__((aligned(CACHE_LINE_SIZE)));
+
+		ET _queue[QUEUE_SIZE];
+
+		static int _next(int i, int n = 1) { return (i + n)%QUEUE_SIZE; }
+
+		int _free_slots(int head) const {
+			return QUEUE_SIZE - 1 - (head - _tail + QUEUE_SIZE)%QUEUE_SIZE; }
+
+		/**
+		 * Reserve up to 'max' consecutive slots
+		 *
+		 * \return  number of reserved slots, starting at 'head'
+		 */
+		int _reserve_slots(int max, int &head)
+		{
+			for (;;) {
+				head = _reserve;
+
+				int const n = min(max, _free_slots(head));
+				if (n <= 0)
+					return 0;
+
+				if (!MULTI_PRODUCER) {
+					_reserve = _next(head, n);
+					return n;
+				}
+
+				if (cmpxchg(&_reserve, head, _next(head, n)))
+					return n;
+			}
+		}
+
+		void _fill(int slot, ET const &e)
+		{
+			_queue[slot] = e;
+
+			/* make element visible before marking the slot as filled */
+			memory_barrier();
+			_filled[slot] = 1;
+		}
+
+	public:
+
+		class Overflow : public Exception { };
+
+		Lock_free_ring_buffer() : _reserve(0), _tail(0)
+		{
+			Genode::memset((void *)_filled, 0, sizeof(_filled));
+			Genode::memset(_queue, 0, sizeof(_queue));
+		}
+
+		/**
+		 * Place element into ring buffer
+		 *
+		 * \throw Overflow  the ring buffer is full
+		 */
+		void add(ET e)
+		{
+			int head = 0;
+			if (!_reserve_slots(1, head))
+				throw Overflow();
+
+			_fill(head, e);
+		}
+
+		/**
+		 * Place up to 'n' elements into ring buffer
+		 *
+		 * \return  number of added elements, which is less than 'n' if
+		 *          the ring buffer is full
+		 */
+		int add(ET const *src, int n)
+		{
+			int head = 0;
+			int const num = _reserve_slots(n, head);
+
+			for (int i = 0; i < num; i++)
+				_fill(_next(head, i), src[i]);
+
+			return num;
+		}
+
+		/**
+		 * Take element from ring buffer
+		 *
+		 * Must only be called by the consumer if the buffer is not empty.
+		 */
+		ET get()
+		{
+			int const tail = _tail;
+
+			memory_barrier();
+			ET const e = _queue[tail];
+
+			/* release slot only after the element got copied */
+			memory_barrier();
+			_filled[tail] = 0;
+
+			/* producers must observe the released slot before the new tail */
+			memory_barrier();
+			_tail = _next(tail);
+
+			return e;
+		}
+
+		/**
+		 * Take up to 'max' elements from ring buffer
+		 *
+		 * \return  number of elements copied to 'dst'
+		 */
+		int get(ET *dst, int max)
+		{
+			int num = 0;
+			for (; num < max && !empty(); num++)
+				dst[num] = get();
+
+			return num;
+		}
+
+		/**
+		 * Return true if no filled element is available to the consumer
+		 */
+		bool empty() const { return !_filled[_tail]; }
+
+		/**
+		 * Return the remaining capacity
+		 */
+		int avail_capacity() const { return _free_slots(_reserve); }
+
+		/**
+		 * Discard all filled elements, must only be called by the consumer
+		 */
+		void reset() { while (!empty()) get(); }
+};
+
+
+template <typename ET, int QUEUE_SIZE>
+class Genode::Ring_buffer<ET, QUEUE_SIZE, Genode::Ring_buffer_spsc>
+:
+	public Lock_free_ring_buffer<ET, QUEUE_SIZE, false>
+{ };
+
+
+template <typename ET, int QUEUE_SIZE>
+class Genode::Ring_buffer<ET, QUEUE_SIZE, Genode::Ring_buffer_mpsc>
+:
+	public Lock_free_ring_buffer<ET, QUEUE_SIZE, true>
+{ };
+
 #endif /* _INCLUDE__OS__RING_BUFFER_H_ */
@@ -0,0 +1,509 @@
+/*
+ * \brief  Range allocator with segregated free lists
+ * \author Genode Labs
+ * \date   2026-10-14
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__OS__TLSF_ALLOCATOR_H_
+#define _INCLUDE__OS__TLSF_ALLOCATOR_H_
+
+#include <base/allocator.h>
+#include <base/tslab.h>
+#include <util/avl_tree.h>
+#include <util/construct_at.h>
+#include <util/misc_math.h>
+
+namespace Genode { class Tlsf_allocator; }
+
+
+/**
+ * Range allocator with bounded allocation latency
+ *
+ * Free blocks are kept in lists indexed by a two-level classification of
+ * their size, in the style of the TLSF allocator. The first level is the
+ * power of two of the size, the second level divides each power-of-two
+ * interval into 'SL_COUNT' sub ranges. Two bitmaps record the non-empty
+ * lists, so that a fitting free block is found by two bit scans,
+ * independent of the number of blocks. Allocated blocks are kept in an AVL
+ * tree ordered by address for looking them up when freed, and each block
+ * is linked with its neighbours in address order, which lets 'free' merge
+ * adjacent free blocks immediately.
+ *
+ * Like 'Allocator_avl', the allocator never accesses the managed address
+ * range and allocates its meta data at the meta-data allocator. It can be
+ * used in place of 'Allocator_avl' wherever a 'Range_allocator' is
+ * expected, e.g., as packet allocator of a packet stream. The latency of
+ * 'alloc', 'alloc_aligned' without range constraints, 'alloc_addr', and
+ * 'free' is bounded by the logarithm of the number of allocated blocks.
+ * Only allocations constrained by 'from' and 'to' scan the blocks.
+ */
+class Genode::Tlsf_allocator : public Range_allocator
+{
+	public:
+
+		enum {
+			SL_LOG2  = 4,
+			SL_COUNT = 1 << SL_LOG2,
+			FL_COUNT = 8*sizeof(size_t) - SL_LOG2 + 1,
+		};
+
+	private:
+
+		struct Block : Avl_node<Block>
+		{
+			addr_t addr = 0;
+			size_t size = 0;
+			bool   used = false;
+
+			/* neighbours in address order */
+			Block *prev_phys = nullptr;
+			Block *next_phys = nullptr;
+
+			/* neighbours within free list */
+			Block *prev_free = nullptr;
+			Block *next_free = nullptr;
+
+			bool higher(Block *b) const { return b->addr > addr; }
+
+			bool contains(addr_t a) const { return a - addr < size; }
+
+			/**
+			 * Return true if block is directly followed by 'b'
+			 */
+			bool adjacent(Block const &b) const { return addr + size == b.addr; }
+		};
+
+		enum { SLAB_BLOCK_SIZE = 256*sizeof(Block) };
+
+		Tslab<Block, SLAB_BLOCK_SIZE> _md_slab;
+
+		Avl_tree<Block> _used { };
+
+		Block *_first = nullptr;  /* first block in address order */
+
+		Block   *_free_lists[FL_COUNT][SL_COUNT] { };
+		addr_t   _fl_bitmap = 0;
+		unsigned _sl_bitmap[FL_COUNT] { };
+
+		size_t _avail = 0;
+
+		static unsigned _msb(size_t value) {
+			return 8*sizeof(unsigned long) - 1 - __builtin_clzl(value); }
+
+		static unsigned _lsb(unsigned long value) {
+			return __builtin_ctzl(value); }
+
+		/**
+		 * Return indices of the free list covering 'size'
+		 */
+		static void _mapping(size_t size, unsigned &fl, unsigned &sl)
+		{
+			if (size < SL_COUNT) {
+				fl = 0;
+				sl = size;
+				return;
+			}
+
+			unsigned const msb = _msb(size);
+			fl = msb - SL_LOG2 + 1;
+			sl = (size >> (msb - SL_LOG2)) - SL_COUNT;
+		}
+
+		Block *_new_block()
+		{
+			void *ptr = nullptr;
+			return _md_slab.alloc(sizeof(Block), &ptr)
+			       ? construct_at<Block>(ptr) : nullptr;
+		}
+
+		void _destroy(Block *b)
+		{
+			if (!b) return;
+			b->~Block();
+			_md_slab.free(b, sizeof(Block));
+		}
+
+		void _insert_free(Block &b)
+		{
+			unsigned fl = 0, sl = 0;
+			_mapping(b.size, fl, sl);
+
+			Block *&head = _free_lists[fl][sl];
+			b.prev_free = nullptr;
+			b.next_free = head;
+			if (head) head->prev_free = &b;
+			head = &b;
+
+			_fl_bitmap     |= 1UL << fl;
+			_sl_bitmap[fl] |= 1U << sl;
+			_avail += b.size;
+		}
+
+		void _remove_free(Block &b)
+		{
+			unsigned fl = 0, sl = 0;
+			_mapping(b.size, fl, sl);
+
+			if (b.next_free) b.next_free->prev_free = b.prev_free;
+			if (b.prev_free) b.prev_free->next_free = b.next_free;
+			else             _free_lists[fl][sl]    = b.next_free;
+
+			b.prev_free = b.next_free = nullptr;
+
+			if (!_free_lists[fl][sl]) {
+				_sl_bitmap[fl] &= ~(1U << sl);
+				if (!_sl_bitmap[fl])
+					_fl_bitmap &= ~(1UL << fl);
+			}
+			_avail -= b.size;
+		}
+
+		/**
+		 * Return a free block of at least 'size' bytes
+		 */
+		Block *_find_free(size_t size)
+		{
+			unsigned fl = 0, sl = 0;
+
+			/*
+			 * Search starting at the list following the one covering
+			 * 'size', so that any block found is large enough.
+			 */
+			size_t search = size;
+			if (size >= SL_COUNT) {
+				size_t const round = ((size_t)1 << (_msb(size) - SL_LOG2)) - 1;
+				if (size + round < size)
+					return nullptr;
+				search = size + round;
+			}
+			_mapping(search, fl, sl);
+
+			unsigned sl_map = _sl_bitmap[fl] & (~0U << sl);
+			if (!sl_map) {
+				addr_t const fl_map = fl + 1 < FL_COUNT
+				                    ? _fl_bitmap & (~0UL << (fl + 1)) : 0;
+				if (fl_map) {
+					fl     = _lsb(fl_map);
+					sl_map = _sl_bitmap[fl];
+				}
+			}
+
+			if (sl_map)
+				return _free_lists[fl][_lsb(sl_map)];
+
+			/* the list covering 'size' may still hold a large-enough block */
+			_mapping(size, fl, sl);
+			for (Block *b = _free_lists[fl][sl]; b; b = b->next_free)
+				if (b->size >= size)
+					return b;
+
+			return nullptr;
+		}
+
+		/**
+		 * Return first free block that fits the constraints
+		 *
+		 * \param out_addr  aligned address of the allocation within block
+		 */
+		Block *_find_constrained(size_t size, unsigned align,
+		                         addr_t from, addr_t to, addr_t &out_addr)
+		{
+			for (Block *b = _first; b; b = b->next_phys) {
+
+				if (b->used)
+					continue;
+
+				addr_t const start = max(b->addr, from);
+				addr_t const a     = align_addr(start, align);
+
+				if (a < start || !b->contains(a)
+				 || b->size - (a - b->addr) < size
+				 || a + (size - 1) < a || a + (size - 1) > to)
+					continue;
+
+				out_addr = a;
+				return b;
+			}
+			return nullptr;
+		}
+
+		void _link_after(Block *pos, Block &b)
+		{
+			b.prev_phys = pos;
+			b.next_phys = pos ? pos->next_phys : _first;
+			if (b.next_phys) b.next_phys->prev_phys = &b;
+			if (pos) pos->next_phys = &b;
+			else     _first         = &b;
+		}
+
+		void _unlink(Block &b)
+		{
+			if (b.next_phys) b.next_phys->prev_phys = b.prev_phys;
+			if (b.prev_phys) b.prev_phys->next_phys = b.next_phys;
+			else             _first                 = b.next_phys;
+		}
+
+		/**
+		 * Merge block with free neighbours and insert result into free list
+		 */
+		void _merge_and_insert(Block *b)
+		{
+			b->used = false;
+
+			Block *prev = b->prev_phys;
+			if (prev && !prev->used && prev->adjacent(*b)) {
+				_remove_free(*prev);
+				prev->size += b->size;
+				_unlink(*b);
+				_destroy(b);
+				b = prev;
+			}
+
+			Block *next = b->next_phys;
+			if (next && !next->used && b->adjacent(*next)) {
+				_remove_free(*next);
+				b->size += next->size;
+				_unlink(*next);
+				_destroy(next);
+			}
+
+			_insert_free(*b);
+		}
+
+		/**
+		 * Allocate 'size' bytes at 'addr' from free block 'b'
+		 *
+		 * \param spare  meta-data blocks for the remainders in front and
+		 *               behind of the allocation, consumed when used
+		 */
+		void _carve(Block &b, addr_t addr, size_t size, Block *spare[2])
+		{
+			_remove_free(b);
+
+			if (addr > b.addr) {
+				Block &head = *spare[0];
+				spare[0]  = nullptr;
+				head.addr = b.addr;
+				head.size = addr - b.addr;
+				_link_after(b.prev_phys, head);
+				_insert_free(head);
+
+				b.addr  = addr;
+				b.size -= head.size;
+			}
+
+			if (b.size > size) {
+				Block &tail = *spare[1];
+				spare[1]  = nullptr;
+				tail.addr = addr + size;
+				tail.size = b.size - size;
+				_link_after(&b, tail);
+				_insert_free(tail);
+
+				b.size = size;
+			}
+
+			b.used = true;
+			_used.insert(&b);
+		}
+
+		/**
+		 * Return allocated block with the highest address not above 'addr'
+		 */
+		Block *_used_at_or_below(addr_t addr) const
+		{
+			Block *result = nullptr;
+			for (Block *b = _used.first(); b; ) {
+				if (b->addr <= addr) {
+					result = b;
+					b = b->child(Block::RIGHT);
+				} else
+					b = b->child(Block::LEFT);
+			}
+			return result;
+		}
+
+		/**
+		 * Return free block containing 'addr'
+		 */
+		Block *_free_at(addr_t addr) const
+		{
+			Block *used = _used_at_or_below(addr);
+			if (used && used->contains(addr))
+				return nullptr;
+
+			/* all blocks between 'used' and the next allocated one are free */
+			for (Block *b = used ? used->next_phys : _first;
+			     b && b->addr <= addr; b = b->next_phys)
+				if (b->contains(addr))
+					return b;
+
+			return nullptr;
+		}
+
+		template <typename FN>
+		Alloc_return _with_spare_blocks(FN const &fn)
+		{
+			Block *spare[2] = { _new_block(), _new_block() };
+
+			Alloc_return result = (spare[0] && spare[1])
+			                    ? fn(spare) : Alloc_return::OUT_OF_METADATA;
+
+			_destroy(spare[0]);
+			_destroy(spare[1]);
+			return result;
+		}
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param md_alloc  allocator used for meta data
+		 */
+		explicit Tlsf_allocator(Allocator *md_alloc) : _md_slab(md_alloc) { }
+
+		~Tlsf_allocator()
+		{
+			while (Block *b = _first) {
+				_unlink(*b);
+				_destroy(b);
+			}
+		}
+
+		/**
+		 * Return size of allocated block at 'addr', or 0
+		 */
+		size_t size_at(void const *addr) const
+		{
+			Block *b = _used_at_or_below((addr_t)addr);
+			return (b && b->addr == (addr_t)addr) ? b->size : 0;
+		}
+
+
+		/*******************************
+		 ** Range-allocator interface **
+		 *******************************/
+
+		int add_range(addr_t base, size_t size) override
+		{
+			if (!size || base + (size - 1) < base)
+				return -1;
+
+			Block *prev = nullptr;
+			for (Block *b = _first; b; b = b->next_phys) {
+				if (b->addr <= base + (size - 1) && base <= b->addr + (b->size - 1))
+					return -3;
+				if (b->addr < base)
+					prev = b;
+			}
+
+			Block *b = _new_block();
+			if (!b)
+				return -4;
+
+			b->addr = base;
+			b->size = size;
+			_link_after(prev, *b);
+			_merge_and_insert(b);
+			return 0;
+		}
+
+		int remove_range(addr_t base, size_t size) override
+		{
+			if (alloc_addr(size, base).error())
+				return -1;
+
+			Block *b = _used_at_or_below(base);
+			_used.remove(b);
+			_unlink(*b);
+			_destroy(b);
+			return 0;
+		}
+
+		Alloc_return alloc_aligned(size_t size, void **out_addr, int align,
+		                           addr_t from = 0, addr_t to = ~0UL) override
+		{
+			size = max(size, (size_t)1);
+
+			return _with_spare_blocks([&] (Block *spare[2]) -> Alloc_return {
+
+				Block  *b = nullptr;
+				addr_t  a = 0;
+
+				if (from == 0 && to == ~0UL) {
+					size_t const padding = ((size_t)1 << align) - 1;
+					if (size + padding >= size)
+						b = _find_free(size + padding);
+					if (b)
+						a = align_addr(b->addr, align);
+				} else
+					b = _find_constrained(size, align, from, to, a);
+
+				if (!b)
+					return Alloc_return::RANGE_CONFLICT;
+
+				_carve(*b, a, size, spare);
+				*out_addr = (void *)a;
+				return Alloc_return::OK;
+			});
+		}
+
+		Alloc_return alloc_addr(size_t size, addr_t addr) override
+		{
+			size = max(size, (size_t)1);
+
+			return _with_spare_blocks([&] (Block *spare[2]) -> Alloc_return {
+
+				Block *b = _free_at(addr);
+				if (!b || b->size - (addr - b->addr) < size)
+					return Alloc_return::RANGE_CONFLICT;
+
+				_carve(*b, addr, size, spare);
+				return Alloc_return::OK;
+			});
+		}
+
+		void free(void *addr) override
+		{
+			Block *b = _used_at_or_below((addr_t)addr);
+			if (!b || b->addr != (addr_t)addr)
+				return;
+
+			_used.remove(b);
+			_merge_and_insert(b);
+		}
+
+		void free(void *addr, size_t) override { free(addr); }
+
+		size_t avail() const override { return _avail; }
+
+		bool valid_addr(addr_t addr) const override
+		{
+			Block *b = _used_at_or_below(addr);
+			return b && b->contains(addr);
+		}
+
+
+		/*************************
+		 ** Allocator interface **
+		 *************************/
+
+		bool alloc(size_t size, void **out_addr) override
+		{
+			return alloc_aligned(size, out_addr, log2(sizeof(addr_t))).ok();
+		}
+
+		size_t overhead(size_t) const override { return sizeof(Block); }
+
+		bool need_size_for_free() const override { return false; }
+};
+
+#endif /* _INCLUDE__OS__TLSF_ALLOCATOR_H_ */
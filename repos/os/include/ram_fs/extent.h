@@ -0,0 +1,318 @@
+/*
+ * \brief  Extent-based data structure for storing sparse files in RAM
+ * \author Genode Labs
+ * \date   2026-10-14
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__RAM_FS__EXTENT_H_
+#define _INCLUDE__RAM_FS__EXTENT_H_
+
+/* Genode includes */
+#include <util/noncopyable.h>
+#include <util/avl_tree.h>
+#include <util/construct_at.h>
+#include <util/string.h>
+#include <base/allocator.h>
+#include <file_system_session/file_system_session.h>
+
+namespace File_system {
+
+	using namespace Genode;
+
+	template <size_t> class Extent_tree;
+}
+
+
+/**
+ * Sparse file content kept as a tree of extents
+ *
+ * \param EXTENT_SIZE  file range covered by one extent, power of two
+ *
+ * The file is divided into ranges of 'EXTENT_SIZE' bytes. Only ranges that
+ * were written to are represented by an extent, which backs the written
+ * part of its range with a buffer. The buffer grows in powers of two, so
+ * small or sparsely populated ranges occupy little memory. Unbacked parts
+ * of the file read as zeros. Because extents are looked up by their index
+ * in an AVL tree, the file size is only limited by 'file_size_t'.
+ *
+ * Buffers are reference counted. A tree created via 'clone' shares all
+ * buffers with its origin and copies a buffer only when writing to it.
+ */
+template <Genode::size_t EXTENT_SIZE>
+class File_system::Extent_tree : Noncopyable
+{
+	public:
+
+		enum { MIN_CAPACITY = 64 };
+
+	private:
+
+		static_assert(EXTENT_SIZE >= MIN_CAPACITY
+		           && (EXTENT_SIZE & (EXTENT_SIZE - 1)) == 0,
+		              "extent size must be a power of two");
+
+		typedef unsigned long long Index;
+
+		/**
+		 * Reference-counted backing store of an extent
+		 */
+		struct Buffer
+		{
+			unsigned     refs = 1;
+			size_t const capacity;
+
+			Buffer(size_t capacity) : capacity(capacity) { }
+
+			char *data() { return (char *)(this + 1); }
+		};
+
+		struct Extent : Avl_node<Extent>
+		{
+			Index const index;
+
+			Buffer *buffer = nullptr;
+			size_t  start  = 0;  /* first backed byte within extent */
+			size_t  used   = 0;  /* number of backed bytes */
+
+			Extent(Index index) : index(index) { }
+
+			size_t end() const { return start + used; }
+
+			bool higher(Extent *e) const { return e->index > index; }
+
+			Extent *find(Index i)
+			{
+				if (i == index) return this;
+
+				Extent *e = Avl_node<Extent>::child(i > index);
+				return e ? e->find(i) : nullptr;
+			}
+
+			/**
+			 * Return any extent with an index of at least 'i'
+			 */
+			Extent *find_at_or_above(Index i)
+			{
+				if (index >= i) return this;
+
+				Extent *e = Avl_node<Extent>::child(Avl_node<Extent>::RIGHT);
+				return e ? e->find_at_or_above(i) : nullptr;
+			}
+
+			Index last_index()
+			{
+				Extent *e = Avl_node<Extent>::child(Avl_node<Extent>::RIGHT);
+				return e ? e->last_index() : index;
+			}
+		};
+
+		Allocator        &_alloc;
+		Avl_tree<Extent>  _tree;
+
+		static size_t _capacity(size_t size)
+		{
+			size_t capacity = MIN_CAPACITY;
+			while (capacity < size)
+				capacity <<= 1;
+			return capacity;
+		}
+
+		Buffer &_alloc_buffer(size_t capacity) {
+			return *Genode::construct_at<Buffer>(_alloc.alloc(sizeof(Buffer) + capacity),
+			                                     capacity); }
+
+		void _release(Buffer *buffer)
+		{
+			if (!buffer || --buffer->refs)
+				return;
+
+			size_t const size = sizeof(Buffer) + buffer->capacity;
+			buffer->~Buffer();
+			_alloc.free(buffer, size);
+		}
+
+		Extent *_lookup(Index index) {
+			return _tree.first() ? _tree.first()->find(index) : nullptr; }
+
+		void _destroy(Extent &extent)
+		{
+			_tree.remove(&extent);
+			_release(extent.buffer);
+			Genode::destroy(_alloc, &extent);
+		}
+
+		/**
+		 * Make bytes [from, to) of the extent writeable
+		 *
+		 * The extent gets a private buffer that covers the union of the
+		 * already backed bytes and the specified range. Bytes in between
+		 * are zeroed.
+		 */
+		void _make_writeable(Extent &extent, size_t from, size_t to)
+		{
+			size_t const old_end   = extent.end();
+			size_t const new_start = extent.used ? min(extent.start, from) : from;
+			size_t const new_end   = extent.used ? max(old_end, to) : to;
+			size_t const span      = new_end - new_start;
+
+			Buffer *old = extent.buffer;
+
+			if (old && old->refs == 1 && new_start == extent.start
+			 && span <= old->capacity) {
+
+				/* capacity beyond the backed bytes may contain stale data */
+				if (from > old_end)
+					memset(old->data() + (old_end - extent.start), 0,
+					       from - old_end);
+
+				extent.used = span;
+				return;
+			}
+
+			Buffer &buffer = _alloc_buffer(_capacity(span));
+
+			memset(buffer.data(), 0, span);
+			if (extent.used)
+				memcpy(buffer.data() + (extent.start - new_start),
+				       old->data(), extent.used);
+
+			_release(old);
+			extent.buffer = &buffer;
+			extent.start  = new_start;
+			extent.used   = span;
+		}
+
+	public:
+
+		Extent_tree(Allocator &alloc) : _alloc(alloc) { }
+
+		~Extent_tree() { truncate(0); }
+
+		/**
+		 * Replace content by the content of 'other', sharing its buffers
+		 */
+		void clone(Extent_tree &other)
+		{
+			truncate(0);
+
+			other._tree.for_each([&] (Extent const &e) {
+				Extent &extent = *new (_alloc) Extent(e.index);
+				extent.buffer  = e.buffer;
+				extent.start   = e.start;
+				extent.used    = e.used;
+				e.buffer->refs++;
+				_tree.insert(&extent);
+			});
+		}
+
+		/**
+		 * Return offset of the byte following the last backed byte
+		 */
+		file_size_t used_size()
+		{
+			if (!_tree.first())
+				return 0;
+
+			Extent &last = *_lookup(_tree.first()->last_index());
+			return last.index * EXTENT_SIZE + last.end();
+		}
+
+		/**
+		 * Return number of bytes of buffer memory owned or shared
+		 */
+		size_t buffer_size() const
+		{
+			size_t sum = 0;
+			_tree.for_each([&] (Extent const &e) { sum += e.buffer->capacity; });
+			return sum;
+		}
+
+		void read(char *dst, size_t len, seek_off_t seek_offset)
+		{
+			while (len) {
+
+				Index  const index = seek_offset / EXTENT_SIZE;
+				size_t const off   = seek_offset % EXTENT_SIZE;
+				size_t const n     = min(len, EXTENT_SIZE - off);
+
+				Extent *extent = _lookup(index);
+
+				if (!extent) {
+					memset(dst, 0, n);
+				} else {
+
+					/* zeros before, backed bytes, zeros after */
+					size_t const end   = off + n;
+					size_t const head  = min(end, max(off, extent->start));
+					size_t const tail  = max(head, min(end, extent->end()));
+
+					memset(dst, 0, head - off);
+					if (tail > head)
+						memcpy(dst + head - off,
+						       extent->buffer->data() + head - extent->start,
+						       tail - head);
+					memset(dst + tail - off, 0, end - tail);
+				}
+
+				dst += n; len -= n; seek_offset += n;
+			}
+		}
+
+		void write(char const *src, size_t len, seek_off_t seek_offset)
+		{
+			while (len) {
+
+				Index  const index = seek_offset / EXTENT_SIZE;
+				size_t const off   = seek_offset % EXTENT_SIZE;
+				size_t const n     = min(len, EXTENT_SIZE - off);
+
+				Extent *extent = _lookup(index);
+				if (!extent) {
+					extent = new (_alloc) Extent(index);
+					_tree.insert(extent);
+				}
+
+				try { _make_writeable(*extent, off, off + n); }
+				catch (...) {
+					if (!extent->used) _destroy(*extent);
+					throw;
+				}
+
+				memcpy(extent->buffer->data() + off - extent->start, src, n);
+
+				src += n; len -= n; seek_offset += n;
+			}
+		}
+
+		void truncate(file_size_t size)
+		{
+			Index const limit = (size + EXTENT_SIZE - 1) / EXTENT_SIZE;
+
+			/* drop all extents located entirely beyond the new size */
+			while (_tree.first()) {
+				Extent *e = _tree.first()->find_at_or_above(limit);
+				if (!e) break;
+				_destroy(*e);
+			}
+
+			/* clip the extent containing the new end of file */
+			size_t const off = size % EXTENT_SIZE;
+			Extent *e = off ? _lookup(size / EXTENT_SIZE) : nullptr;
+			if (!e)
+				return;
+
+			if (off <= e->start)
+				_destroy(*e);
+			else
+				e->used = min(e->used, off - e->start);
+		}
+};
+
+#endif /* _INCLUDE__RAM_FS__EXTENT_H_ */
@@ -0,0 +1,196 @@
+/*
+ * \brief  Name-ordered index of directory entries
+ * \author Genode Labs
+ * \date   2026-10-14
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__RAM_FS__NAME_INDEX_H_
+#define _INCLUDE__RAM_FS__NAME_INDEX_H_
+
+/* Genode includes */
+#include <util/avl_tree.h>
+#include <util/noncopyable.h>
+#include <util/string.h>
+
+namespace File_system { template <typename> class Name_index; }
+
+
+/**
+ * Directory entries kept in an AVL tree ordered by name
+ *
+ * \param NODE  entry type, derived from 'Genode::Avl_node<NODE>', providing
+ *              a 'name()' method and implementing 'higher' via 'ordered'
+ *
+ * Lookup by name takes logarithmic time. Entries are enumerated in name
+ * order, so the position of an entry depends on the set of names only,
+ * not on the insertion history. A cursor remembers the position of the
+ * most recently accessed entry and is kept up to date when entries are
+ * added or removed. Reading a directory sequentially in either direction
+ * thereby costs a logarithmic number of steps per entry.
+ */
+template <typename NODE>
+class File_system::Name_index : Genode::Noncopyable
+{
+	private:
+
+		typedef Genode::Avl_node<NODE> Avl_node;
+
+		Genode::Avl_tree<NODE> _tree;
+		unsigned long          _count = 0;
+
+		NODE          *_cursor       = nullptr;
+		unsigned long  _cursor_index = 0;
+
+		/**
+		 * Compare 'name' with the first 'len' characters of 'key'
+		 */
+		static int _compare(char const *name, char const *key,
+		                    Genode::size_t len)
+		{
+			int const r = Genode::strcmp(name, key, len);
+			if (r) return r;
+			return name[len] ? 1 : 0;
+		}
+
+		NODE *_first() const
+		{
+			NODE *n = _tree.first();
+			while (n && n->child(Avl_node::LEFT))
+				n = n->child(Avl_node::LEFT);
+			return n;
+		}
+
+		/**
+		 * Return entry following 'node' in name order
+		 */
+		NODE *_next(NODE *node) const
+		{
+			NODE *result = nullptr;
+			for (NODE *n = _tree.first(); n; ) {
+				if (ordered(node, n)) {
+					result = n;
+					n = n->child(Avl_node::LEFT);
+				} else
+					n = n->child(Avl_node::RIGHT);
+			}
+			return result;
+		}
+
+		/**
+		 * Return entry preceding 'node' in name order
+		 */
+		NODE *_prev(NODE *node) const
+		{
+			NODE *result = nullptr;
+			for (NODE *n = _tree.first(); n; ) {
+				if (ordered(n, node)) {
+					result = n;
+					n = n->child(Avl_node::RIGHT);
+				} else
+					n = n->child(Avl_node::LEFT);
+			}
+			return result;
+		}
+
+	public:
+
+		/**
+		 * Order of entries within the index
+		 *
+		 * Entries are ordered by name. Entries of the same name, which
+		 * may transiently exist while a node is moved over another one,
+		 * are ordered by address to keep the order strict.
+		 */
+		static bool ordered(NODE *a, NODE *b)
+		{
+			int const r = Genode::strcmp(a->name(), b->name());
+			return r ? r < 0 : a < b;
+		}
+
+		unsigned long count() const { return _count; }
+
+		void insert(NODE *node)
+		{
+			if (_cursor && ordered(node, _cursor))
+				_cursor_index++;
+
+			_tree.insert(node);
+			_count++;
+		}
+
+		void remove(NODE *node)
+		{
+			if (node == _cursor) {
+				_cursor = _prev(node);
+				if (_cursor)
+					_cursor_index--;
+			} else if (_cursor && ordered(node, _cursor))
+				_cursor_index--;
+
+			_tree.remove(node);
+			_count--;
+		}
+
+		/**
+		 * Return entry named by the first 'len' characters of 'name'
+		 *
+		 * \return  entry, or nullptr if no such entry exists
+		 */
+		NODE *lookup(char const *name, Genode::size_t len) const
+		{
+			for (NODE *n = _tree.first(); n; ) {
+				int const r = _compare(n->name(), name, len);
+				if (r == 0)
+					return n;
+				n = n->child(r < 0);
+			}
+			return nullptr;
+		}
+
+		NODE *lookup(char const *name) const {
+			return lookup(name, Genode::strlen(name)); }
+
+		/**
+		 * Return entry at position 'index' in name order
+		 *
+		 * \return  entry, or nullptr if 'index' is out of range
+		 */
+		NODE *entry(unsigned long index)
+		{
+			if (index >= _count)
+				return nullptr;
+
+			unsigned long const distance = _cursor
+				? (index > _cursor_index ? index - _cursor_index
+				                         : _cursor_index - index)
+				: index + 1;
+
+			/* restart at the first entry if this is shorter */
+			if (index < distance) {
+				_cursor       = _first();
+				_cursor_index = 0;
+			}
+
+			for (; _cursor_index < index; _cursor_index++)
+				_cursor = _next(_cursor);
+
+			for (; _cursor_index > index; _cursor_index--)
+				_cursor = _prev(_cursor);
+
+			return _cursor;
+		}
+
+		/**
+		 * Return an arbitrary entry, used for draining the index
+		 */
+		NODE *any() const { return _tree.first(); }
+};
+
+#endif /* _INCLUDE__RAM_FS__NAME_INDEX_H_ */
@@ -33,6 +33,8 @@ struct Report::Session_component : Genode::Rpc_object<Session>, Rom::Writer
 {
 	private:
 
+		Genode::Env &_env;
+
 		Rom::Registry_for_writer &_registry;
 
 		Genode::Session_label const _label;
@@ -43,6 +45,67 @@ struct Report::Session_component : Genode::Rpc_object<Session>, Rom::Writer
 
 		bool &_verbose;
 
+		/*
+		 * Report assembled from chunks, present only while a chunked report
+		 * is being submitted
+		 */
+		size_t const _max_report_size;
+
+		Genode::Constructible<Genode::Attached_ram_dataspace> _chunks;
+
+		size_t _chunks_size    = 0;
+		bool   _chunks_dropped = false;
+
+		void _reset_chunks()
+		{
+			_chunks.destruct();
+			_chunks_size    = 0;
+			_chunks_dropped = false;
+		}
+
+		/**
+		 * Append chunk to the assembled report
+		 *
+		 * \return false if the report cannot be assembled
+		 */
+		bool _append_chunk(char const *src, size_t length)
+		{
+			using namespace Genode;
+
+			if (!length)
+				return true;
+
+			size_t const needed = _chunks_size + length;
+			if (needed > _max_report_size) {
+				error("report '", _module.name(), "' exceeds "
+				      "max_report_size of ", _max_report_size, " bytes");
+				return false;
+			}
+
+			try {
+				if (!_chunks.constructed())
+					_chunks.construct(_env.ram(), _env.rm(), needed);
+
+				/* grow by a factor of two to limit the number of reallocations */
+				if (_chunks->size() < needed) {
+					Attached_ram_dataspace grown(_env.ram(), _env.rm(),
+					                             min(max(needed, 2*_chunks->size()),
+					                                 _max_report_size));
+					memcpy(grown.local_addr<char>(),
+					       _chunks->local_addr<char const>(), _chunks_size);
+					_chunks->swap(grown);
+				}
+			}
+			catch (...) {
+				error("failed to allocate buffer for report '", _module.name(), "'");
+				return false;
+			}
+
+			memcpy(_chunks->local_addr<char>() + _chunks_size, src, length);
+			_chunks_size = needed;
+			return true;
+		}
+
 		Rom::Module &_create_module(Rom::Module::Name const &name)
 		{
 			try { return _registry.lookup(*this, name); }
@@ -60,12 +123,13 @@ struct Report::Session_component : Genode::Rpc_object<Session>, Rom::Writer
 
 		Session_component(Genode::Env &env,
 		                  Genode::Session_label const &label, size_t buffer_size,
+		                  size_t max_report_size,
 		                  Rom::Registry_for_writer &registry, bool &verbose)
 		:
-			_registry(registry), _label(label),
+			_env(env), _registry(registry), _label(label),
 			_ds(env.ram(), env.rm(), buffer_size),
 			_module(_create_module(label.string())),
-			_verbose(verbose)
+			_verbose(verbose), _max_report_size(max_report_size)
 		{ }
 
 		~Session_component()
@@ -80,16 +144,42 @@ struct Report::Session_component : Genode::Rpc_object<Session>, Rom::Writer
 
 		Dataspace_capability dataspace() override { return _ds.cap(); }
 
-		void submit(size_t length) override
+		void _write_content(char const *src, size_t length)
 		{
-			length = Genode::min(length, _ds.size());
-
 			if (_verbose) {
 				Genode::log("report '", _module.name(), "'");
-				_log_lines(_ds.local_addr<char>(), length);
+				_log_lines(src, length);
 			}
 
-			_module.write_content(*this, _ds.local_addr<char>(), length);
+			_module.write_content(*this, src, length);
+		}
+
+		void submit(size_t length) override
+		{
+			/* a pending chunked report is superseded */
+			_reset_chunks();
+
+			_write_content(_ds.local_addr<char>(), Genode::min(length, _ds.size()));
+		}
+
+		void submit_chunk(size_t length, bool last) override
+		{
+			length = Genode::min(length, _ds.size());
+
+			if (!_chunks_dropped && !_append_chunk(_ds.local_addr<char>(), length))
+				_chunks_dropped = true;
+
+			if (!last)
+				return;
+
+			/*
+			 * The module copies the content into a backing store of the
+			 * report's size, which allows us to release the assembled report.
+			 */
+			if (!_chunks_dropped && _chunks.constructed())
+				_write_content(_chunks->local_addr<char>(), _chunks_size);
+
+			_reset_chunks();
 		}
 
 		void response_sigh(Genode::Signal_context_capability) override { }
@@ -121,8 +211,12 @@ struct Report::Root : Genode::Root_component<Session_component>
 			size_t const buffer_size =
 				Arg_string::find_arg(args, "buffer_size").aligned_size();
 
+			/* limit of reports submitted in chunks */
+			size_t const max_report_size =
+				Arg_string::find_arg(args, "max_report_size").aligned_size();
+
 			size_t const session_size =
-				max(sizeof(Session_component), 4096U) + buffer_size;
+				max(sizeof(Session_component), 4096U) + buffer_size + max_report_size;
 
 			if (ram_quota < session_size) {
 				Genode::error("insufficient ram donation from ", label.string());
@@ -135,7 +229,7 @@ struct Report::Root : Genode::Root_component<Session_component>
 			}
 
 			return new (md_alloc())
-				Session_component(_env, label, buffer_size,
+				Session_component(_env, label, buffer_size, max_report_size,
 				                  _rom_registry, _verbose);
 		}
 
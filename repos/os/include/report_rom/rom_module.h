@@ -68,6 +68,16 @@ struct Rom::Readable_module
 	                            size_t dst_len) const = 0;
 
 	virtual size_t size() const = 0;
+
+	/**
+	 * Return generation of the content as visible to the reader
+	 *
+	 * The generation changes whenever the content obtained by
+	 * 'read_content' changes. Hence, a reader that already holds the
+	 * content of the returned generation need not read it again. The
+	 * value 0 denotes that no content is readable.
+	 */
+	virtual unsigned long generation(Reader const &reader) const = 0;
 };
 
 
@@ -145,6 +155,20 @@ struct Rom::Module : Module_list::Element, Readable_module
 		 */
 		size_t _size = 0;
 
+		/**
+		 * Number of content changes, used as generation of the content
+		 */
+		unsigned long _generation = 0;
+
+		/**
+		 * Return true if the content equals 'src'
+		 */
+		bool _equals(char const * const src, size_t const src_len) const
+		{
+			return _ds.constructed() && _size == src_len
+			    && Genode::memcmp(_ds->local_addr<char const>(), src, src_len) == 0;
+		}
+
 
 		/********************************
 		 ** Interface used by registry **
@@ -207,6 +231,7 @@ struct Rom::Module : Module_list::Element, Readable_module
 				Genode::memset(_ds->local_addr<char>(), 0, _size);
 				_size = 0;
 				_last_writer = nullptr;
+				_generation++;
 			}
 		}
 
@@ -231,14 +256,25 @@ struct Rom::Module : Module_list::Element, Readable_module
 		/**
 		 * Assign new content to the ROM module
 		 *
-		 * Called by report service when a new report comes in.
+		 * Called by report service when a new report comes in. If the
+		 * report equals the current content of the same writer, readers
+		 * are not notified.
 		 */
 		void write_content(Writer const &writer, char const * const src, size_t const src_len)
 		{
 			if (!_write_policy.write_permitted(*this, writer))
 				return;
 
+			/*
+			 * Suppress duplicate reports. A report by another writer may
+			 * be subject to a different read policy and is therefore
+			 * always propagated.
+			 */
+			if (_last_writer == &writer && _equals(src, src_len))
+				return;
+
 			_size = 0;
+			_generation++;
 
 			_last_writer = &writer;
 
@@ -248,9 +284,17 @@ struct Rom::Module : Module_list::Element, Readable_module
 			 * Take a terminating zero into account, which we append to each
 			 * report. This way, we do not need to trust report clients to
 			 * append a zero termination to textual reports.
+			 *
+			 * The backing store grows at least by a factor of two to
+			 * accommodate a sequence of growing reports with few
+			 * reallocations.
 			 */
-			if (!_ds.constructed() || _ds->size() < (src_len + 1))
-				_ds.construct(_ram, _rm, (src_len + 1));
+			if (!_ds.constructed() || _ds->size() < (src_len + 1)) {
+				size_t const size = _ds.constructed()
+				                  ? Genode::max(src_len + 1, 2*_ds->size())
+				                  : src_len + 1;
+				_ds.construct(_ram, _rm, size);
+			}
 
 			/* copy content into backing store */
 			_size = src_len;
@@ -289,6 +333,20 @@ struct Rom::Module : Module_list::Element, Readable_module
 
 		virtual size_t size() const override { return _size; }
 
+		/**
+		 * Readable_module interface
+		 */
+		unsigned long generation(Reader const &reader) const override
+		{
+			if (!_ds.constructed() || !_last_writer)
+				return 0;
+
+			if (!_read_policy.read_permitted(*this, *_last_writer, reader))
+				return 0;
+
+			return _generation;
+		}
+
 		Name name() const { return _name; }
 };
 
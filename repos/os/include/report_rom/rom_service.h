@@ -18,6 +18,7 @@
 #include <util/arg_string.h>
 #include <util/xml_node.h>
 #include <rom_session/rom_session.h>
+#include <cpu/memory_barrier.h>
 #include <root/component.h>
 #include <report_rom/rom_registry.h>
 
@@ -55,6 +56,11 @@ class Rom::Session_component : public Genode::Rpc_object<Genode::Rom_session>,
 
 		size_t _content_size = 0;
 
+		/**
+		 * Generation of the module content present in '_ds'
+		 */
+		unsigned long _generation = 0;
+
 		/**
 		 * Keep state of valid content to notify the client only once when
 		 * the ROM module becomes invalid.
@@ -63,8 +69,66 @@ class Rom::Session_component : public Genode::Rpc_object<Genode::Rom_session>,
 
 		Genode::Signal_context_capability _sigh;
 
+		/*
+		 * Dataspace updated in place, allocated once requested by the client
+		 */
+		Constructible<Genode::Attached_ram_dataspace> _shared;
+
+		typedef Genode::Rom_session::Shared_header Shared_header;
+
+		Shared_header &_shared_header() {
+			return *_shared->local_addr<Shared_header>(); }
+
+		size_t _shared_capacity() const {
+			return _shared->size() - Genode::Rom_session::SHARED_CONTENT_OFFSET; }
+
+		/**
+		 * Write current module content to the shared dataspace
+		 */
+		void _update_shared()
+		{
+			if (!_shared.constructed())
+				return;
+
+			Shared_header &header = _shared_header();
+			if (header.retired)
+				return;
+
+			header.generation++;
+			Genode::memory_barrier();
+
+			if (_module.size() > _shared_capacity()) {
+
+				/* the client has to request a larger dataspace */
+				header.retired = true;
+
+			} else {
+
+				char * const content = _shared->local_addr<char>()
+				                     + Genode::Rom_session::SHARED_CONTENT_OFFSET;
+
+				size_t const old_size = header.size;
+				size_t const new_size = _module.read_content(*this, content,
+				                                             _shared_capacity());
+
+				/* clear difference between old and new content */
+				if (new_size < old_size)
+					Genode::memset(content + new_size, 0, old_size - new_size);
+
+				header.size = new_size;
+
+				if (new_size)
+					_valid = true;
+			}
+
+			Genode::memory_barrier();
+			header.generation++;
+		}
+
 		void _notify_client()
 		{
+			_update_shared();
+
 			if (_sigh.valid())
 				Genode::Signal_transmitter(_sigh).submit();
 		}
@@ -104,14 +168,32 @@ class Rom::Session_component : public Genode::Rpc_object<Genode::Rom_session>,
 		{
 			using namespace Genode;
 
-				/* replace dataspace by new one */
-				/* XXX we could keep the old dataspace if the size fits */
-				_ds.construct(_ram, _rm, _module.size());
+				/*
+				 * Replace dataspace by a larger one if the content does not
+				 * fit. Growing the dataspace by at least a factor of two
+				 * limits the number of reallocations for growing content.
+				 */
+				if (!_ds.constructed() || _ds->size() < _module.size()) {
+					size_t const size = _ds.constructed()
+					                  ? max(_module.size(), 2*_ds->size())
+					                  : _module.size();
+					_ds.construct(_ram, _rm, size);
+					_content_size = 0;
+				}
 
 				/* fill dataspace content with report contained in module */
-				_content_size =
+				_generation = _module.generation(*this);
+
+				size_t const new_content_size =
 					_module.read_content(*this, _ds->local_addr<char>(), _ds->size());
 
+				/* clear difference between old and new content */
+				if (new_content_size < _content_size)
+					Genode::memset(_ds->local_addr<char>() + new_content_size, 0,
+					               _content_size - new_content_size);
+
+				_content_size = new_content_size;
+
 				_valid = _content_size > 0;
 
 				/* cast RAM into ROM dataspace capability */
@@ -121,9 +203,19 @@ class Rom::Session_component : public Genode::Rpc_object<Genode::Rom_session>,
 
 		bool update() override
 		{
-			if (!_ds.constructed() || _module.size() > _ds->size())
+			if (!_ds.constructed())
 				return false;
 
+			/* skip copying if the client already has the current content */
+			unsigned long const generation = _module.generation(*this);
+			if (generation == _generation)
+				return true;
+
+			if (_module.size() > _ds->size())
+				return false;
+
+			_generation = generation;
+
 			size_t const new_content_size =
 				_module.read_content(*this, _ds->local_addr<char>(), _ds->size());
 
@@ -139,6 +231,28 @@ class Rom::Session_component : public Genode::Rpc_object<Genode::Rom_session>,
 			return true;
 		}
 
+		Genode::Rom_dataspace_capability shared_dataspace() override
+		{
+			using namespace Genode;
+
+			/*
+			 * Replace retired dataspace, growing it at least by a factor
+			 * of two as done for the regular dataspace
+			 */
+			if (!_shared.constructed() || _shared_header().retired) {
+
+				size_t const needed = SHARED_CONTENT_OFFSET + _module.size();
+				size_t const size   = _shared.constructed()
+				                    ? max(needed, 2*_shared->size()) : needed;
+
+				_shared.construct(_ram, _rm, size);
+				_update_shared();
+			}
+
+			Dataspace_capability ds_cap = static_cap_cast<Dataspace>(_shared->cap());
+			return static_cap_cast<Rom_dataspace>(ds_cap);
+		}
+
 		void sigh(Genode::Signal_context_capability sigh) override
 		{
 			_sigh = sigh;
@@ -165,8 +279,12 @@ class Rom::Session_component : public Genode::Rpc_object<Genode::Rom_session>,
 		void notify_module_invalidated() override
 		{
 			/* deliver a signal for an invalidated module only once */
-			if (!_valid)
+			if (!_valid) {
+
+				/* the shared content must never outlive the read permission */
+				_update_shared();
 				return;
+			}
 
 			_valid = false;
 			_notify_client();
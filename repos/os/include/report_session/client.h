@@ -32,6 +32,9 @@ struct Report::Session_client : Genode::Rpc_client<Session>
 	void submit(size_t length) override {
 		call<Rpc_submit>(length); }
 
+	void submit_chunk(size_t length, bool last) override {
+		call<Rpc_submit_chunk>(length, last); }
+
 	void response_sigh(Signal_context_capability cap) override {
 		call<Rpc_response_sigh>(cap); }
 
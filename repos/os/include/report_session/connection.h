@@ -30,18 +30,27 @@ struct Report::Connection : Genode::Connection<Session>, Session_client
 	 * \noapi
 	 */
 	Capability<Report::Session> _session(Genode::Parent &parent,
-	                                     char const *label, size_t buffer_size)
+	                                     char const *label, size_t buffer_size,
+	                                     size_t max_report_size = 0)
 	{
-		return session(parent, "label=\"%s\", ram_quota=%ld, cap_quota=%ld, buffer_size=%zd",
-		               label, 10*1024 + buffer_size, CAP_QUOTA, buffer_size);
+		return session(parent, "label=\"%s\", ram_quota=%ld, cap_quota=%ld, "
+		               "buffer_size=%zd, max_report_size=%zd",
+		               label, 10*1024 + buffer_size + max_report_size, CAP_QUOTA,
+		               buffer_size, max_report_size);
 	}
 
 	/**
 	 * Constructor
+	 *
+	 * \param max_report_size  maximum size of reports submitted in chunks,
+	 *                         which is accounted as part of the session
+	 *                         quota
 	 */
-	Connection(Genode::Env &env, char const *label, size_t buffer_size = 4096)
+	Connection(Genode::Env &env, char const *label, size_t buffer_size = 4096,
+	           size_t max_report_size = 0)
 	:
-		Genode::Connection<Session>(env, _session(env.parent(), label, buffer_size)),
+		Genode::Connection<Session>(env, _session(env.parent(), label, buffer_size,
+		                                          max_report_size)),
 		Session_client(cap())
 	{ }
 
@@ -67,9 +76,11 @@ struct Report::Connection : Genode::Connection<Session>, Session_client
 	 * This variant solely exists to be called by deprecated functions. It
 	 * will be removed as soon as those functions are gone.
 	 */
-	Connection(bool, char const *label, size_t buffer_size = 4096)
+	Connection(bool, char const *label, size_t buffer_size = 4096,
+	           size_t max_report_size = 0)
 	:
-		Genode::Connection<Session>(_session(*Genode::env_deprecated()->parent(), label, buffer_size)),
+		Genode::Connection<Session>(_session(*Genode::env_deprecated()->parent(), label,
+		                                     buffer_size, max_report_size)),
 		Session_client(cap())
 	{ }
 };
@@ -79,6 +79,22 @@ struct Report::Session : Genode::Session
 	 */
 	virtual void submit(size_t length) = 0;
 
+	/**
+	 * Submit data that is currently contained in the dataspace as part of
+	 * a report
+	 *
+	 * \param length  length of the chunk in bytes
+	 * \param last    true if the chunk completes the report
+	 *
+	 * This method allows for the submission of reports that exceed the
+	 * dataspace. The chunks are concatenated in the order of their
+	 * submission and the report becomes effective with the last chunk.
+	 * The size of a chunked report is limited by the 'max_report_size'
+	 * session argument. While this method is called, the information in
+	 * the dataspace must not be modified by the client.
+	 */
+	virtual void submit_chunk(size_t length, bool last) = 0;
+
 	/**
 	 * Install signal handler for response notifications
 	 */
@@ -101,10 +117,11 @@ struct Report::Session : Genode::Session
 
 	GENODE_RPC(Rpc_dataspace, Dataspace_capability, dataspace);
 	GENODE_RPC(Rpc_submit, void, submit, size_t);
+	GENODE_RPC(Rpc_submit_chunk, void, submit_chunk, size_t, bool);
 	GENODE_RPC(Rpc_response_sigh, void, response_sigh, Signal_context_capability);
 	GENODE_RPC(Rpc_obtain_response, size_t, obtain_response);
-	GENODE_RPC_INTERFACE(Rpc_dataspace, Rpc_submit, Rpc_response_sigh,
-	                     Rpc_obtain_response);
+	GENODE_RPC_INTERFACE(Rpc_dataspace, Rpc_submit, Rpc_submit_chunk,
+	                     Rpc_response_sigh, Rpc_obtain_response);
 };
 
 #endif /* _INCLUDE__REPORT_SESSION__REPORT_SESSION_H_ */
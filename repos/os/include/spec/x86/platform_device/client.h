@@ -54,6 +54,12 @@ struct Platform::Device_client : public Genode::Rpc_client<Device>
 	Genode::Io_port_session_capability io_port(Genode::uint8_t id) override {
 		return call<Rpc_io_port>(id); }
 
+	unsigned msi_x_vectors() override {
+		return call<Rpc_msi_x_vectors>(); }
+
+	Genode::Irq_session_capability msi_x(Genode::uint16_t vector, unsigned cpu) override {
+		return call<Rpc_msi_x>(vector, cpu); }
+
 	Genode::Io_mem_session_capability io_mem(Genode::uint8_t id,
 	                                         Genode::Cache_attribute caching = Genode::Cache_attribute::UNCACHED,
 	                                         Genode::addr_t offset = 0,
@@ -179,6 +179,34 @@ struct Platform::Device : Platform::Abstract_device
 	 */
 	virtual Genode::Io_port_session_capability io_port(Genode::uint8_t id) = 0;
 
+	/**
+	 * Return number of MSI-X vectors usable via 'msi_x'
+	 *
+	 * \retval 0  the device lacks MSI-X or MSI usage is not permitted
+	 */
+	virtual unsigned msi_x_vectors() = 0;
+
+	/**
+	 * Obtain IRQ session for an MSI-X vector
+	 *
+	 * \param vector  index of the vector in the MSI-X table of the device
+	 * \param cpu     CPU that receives the interrupt, e.g., the CPU that
+	 *                serves the device queue belonging to the vector, given
+	 *                as x position in the affinity space of the platform
+	 *                driver
+	 *
+	 * The first request of a vector enables MSI-X for the device. All
+	 * vectors not requested stay masked. MSI-X cannot be used together
+	 * with an MSI obtained via 'irq'.
+	 *
+	 * \return invalid capability if the vector is unavailable
+	 *
+	 * \throw Out_of_ram
+	 * \throw Out_of_caps
+	 */
+	virtual Genode::Irq_session_capability msi_x(Genode::uint16_t vector,
+	                                             unsigned cpu) = 0;
+
 	/*
 	 * The base classes are defined as follows:
 	 *
@@ -252,8 +280,13 @@ struct Platform::Device : Platform::Abstract_device
 	                 GENODE_TYPE_LIST(Out_of_ram, Out_of_caps),
 	                 Genode::uint8_t, Genode::Cache_attribute,
 	                 Genode::addr_t, Genode::size_t);
+	GENODE_RPC(Rpc_msi_x_vectors, unsigned, msi_x_vectors);
+	GENODE_RPC_THROW(Rpc_msi_x, Genode::Irq_session_capability, msi_x,
+	                 GENODE_TYPE_LIST(Out_of_ram, Out_of_caps),
+	                 Genode::uint16_t, unsigned);
 
 	GENODE_RPC_INTERFACE(Rpc_bus_address, Rpc_vendor_id, Rpc_device_id,
 	                     Rpc_class_code, Rpc_resource, Rpc_config_read,
-	                     Rpc_config_write, Rpc_irq, Rpc_io_port, Rpc_io_mem);
+	                     Rpc_config_write, Rpc_irq, Rpc_io_port, Rpc_io_mem,
+	                     Rpc_msi_x_vectors, Rpc_msi_x);
 };
@@ -0,0 +1,496 @@
+/*
+ * \brief  Sorted path index of a TAR archive
+ * \author Genode Labs
+ * \date   2026-10-14
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__TAR__INDEX_H_
+#define _INCLUDE__TAR__INDEX_H_
+
+/* Genode includes */
+#include <base/allocator.h>
+#include <base/lock.h>
+#include <util/noncopyable.h>
+#include <util/string.h>
+
+namespace Tar { class Index; }
+
+
+/**
+ * Index of the records of a TAR archive, sorted by path
+ *
+ * The index is built on first use by a single scan over the record
+ * headers. Each record occupies a few bytes within the index, the path
+ * names are referenced within the archive itself. Paths are compared with
+ * '/' ordered before any other character, which places each directory
+ * record directly in front of the records of its subtree. Looking up a
+ * path thereby takes logarithmic time and the entries of a directory,
+ * including directories present only as path prefix of other records, are
+ * enumerated by skipping over the subtree of each entry.
+ *
+ * If an archive contains multiple records of the same path, the last one
+ * takes effect.
+ */
+class Tar::Index : Genode::Noncopyable
+{
+	public:
+
+		typedef Genode::size_t size_t;
+
+		/* length of one data block in tar */
+		enum { BLOCK_LEN = 512 };
+
+		/* location and length of header fields */
+		enum { NAME_LEN = 100, SIZE_OFFSET = 124, SIZE_LEN = 12 };
+
+		/**
+		 * Result of a lookup
+		 */
+		struct Node
+		{
+			/* record header, nullptr for a directory without record */
+			char const *header = nullptr;
+
+			/* identifier unique within the archive, 0 if not found */
+			unsigned long id = 0;
+
+			bool valid() const { return id != 0; }
+		};
+
+		/**
+		 * Position of a directory entry, used for sequential enumeration
+		 */
+		struct Cursor
+		{
+			unsigned long index = ~0UL;
+			unsigned long pos   = 0;
+		};
+
+		/**
+		 * Return size of the member described by 'header'
+		 */
+		static unsigned long long member_size(char const *header)
+		{
+			char buf[SIZE_LEN + 1];
+			Genode::strncpy(buf, header + SIZE_OFFSET, sizeof(buf));
+
+			unsigned long long value = 0;
+			Genode::ascii_to_unsigned(buf, value, 8);
+			return value;
+		}
+
+		static char const *member_data(char const *header) {
+			return header + BLOCK_LEN; }
+
+	private:
+
+		struct Entry
+		{
+			unsigned      block;   /* block number of record header */
+			unsigned char offset;  /* start of path within name field */
+			unsigned char length;  /* length of path */
+		};
+
+		Genode::Allocator &_alloc;
+		char const * const _base;
+		size_t       const _size;
+
+		Genode::Lock   _lock;
+		bool           _built = false;
+		Entry         *_entries = nullptr;
+		unsigned long  _capacity = 0;
+		unsigned long  _count = 0;
+
+		char const *_header(Entry const &e) const {
+			return _base + (size_t)e.block*BLOCK_LEN; }
+
+		char const *_path(Entry const &e) const {
+			return _header(e) + e.offset; }
+
+		/**
+		 * Strip leading "./" and '/' and trailing '/' characters
+		 */
+		static char const *_normalize(char const *path, size_t &len)
+		{
+			for (;;) {
+				if (len && path[0] == '/') { path++; len--; continue; }
+				if (len > 1 && path[0] == '.' && path[1] == '/') {
+					path += 2; len -= 2; continue; }
+				break;
+			}
+			while (len && path[len - 1] == '/')
+				len--;
+			return path;
+		}
+
+		static unsigned _order(char c) {
+			return c == '/' ? 1 : (unsigned char)c; }
+
+		static int _compare(char const *a, size_t a_len,
+		                    char const *b, size_t b_len)
+		{
+			for (size_t i = 0; ; i++) {
+				if (i == a_len || i == b_len)
+					return (a_len > i) - (b_len > i);
+
+				unsigned const ca = _order(a[i]), cb = _order(b[i]);
+				if (ca != cb)
+					return ca < cb ? -1 : 1;
+			}
+		}
+
+		int _compare(Entry const &e, char const *key, size_t len) const {
+			return _compare(_path(e), e.length, key, len); }
+
+		bool _less(Entry const &a, Entry const &b) const
+		{
+			int const r = _compare(_path(a), a.length, _path(b), b.length);
+			return r ? r < 0 : a.block < b.block;
+		}
+
+		/**
+		 * Return true if 'e' equals 'key' or lies in the subtree of 'key'
+		 */
+		bool _in_subtree(Entry const &e, char const *key, size_t len) const
+		{
+			if (len == 0)
+				return true;
+
+			return e.length >= len && Genode::strcmp(_path(e), key, len) == 0
+			    && (e.length == len || _path(e)[len] == '/');
+		}
+
+		/**
+		 * Return first position at or after 'from' of an entry not lower
+		 * than 'key'
+		 */
+		unsigned long _lower_bound(char const *key, size_t len,
+		                           unsigned long from = 0) const
+		{
+			unsigned long lo = from, hi = _count;
+			while (lo < hi) {
+				unsigned long const mid = lo + (hi - lo)/2;
+				if (_compare(_entries[mid], key, len) < 0)
+					lo = mid + 1;
+				else
+					hi = mid;
+			}
+			return lo;
+		}
+
+		/**
+		 * Return first position after 'from' outside the subtree of 'key'
+		 *
+		 * The entry at 'from' must lie within the subtree.
+		 */
+		unsigned long _subtree_end(char const *key, size_t len,
+		                           unsigned long from) const
+		{
+			unsigned long lo = from + 1, hi = _count;
+			while (lo < hi) {
+				unsigned long const mid = lo + (hi - lo)/2;
+				if (_in_subtree(_entries[mid], key, len))
+					lo = mid + 1;
+				else
+					hi = mid;
+			}
+			return lo;
+		}
+
+		void _sift_down(unsigned long root, unsigned long end)
+		{
+			for (;;) {
+				unsigned long child = 2*root + 1;
+				if (child >= end)
+					return;
+
+				if (child + 1 < end && _less(_entries[child], _entries[child + 1]))
+					child++;
+
+				if (!_less(_entries[root], _entries[child]))
+					return;
+
+				Entry const tmp = _entries[root];
+				_entries[root]  = _entries[child];
+				_entries[child] = tmp;
+				root = child;
+			}
+		}
+
+		void _sort()
+		{
+			for (unsigned long i = _count/2; i-- > 0; )
+				_sift_down(i, _count);
+
+			for (unsigned long end = _count; end > 1; ) {
+				end--;
+				Entry const tmp = _entries[0];
+				_entries[0]   = _entries[end];
+				_entries[end] = tmp;
+				_sift_down(0, end);
+			}
+		}
+
+		/**
+		 * Call 'fn' with the block number of each record header
+		 */
+		template <typename FN>
+		void _for_each_record(FN const &fn) const
+		{
+			size_t const block_cnt = _size/BLOCK_LEN;
+
+			for (size_t block = 0; block < block_cnt; ) {
+
+				char const *header = _base + block*BLOCK_LEN;
+
+				/* lookout for empty eof-blocks */
+				if (header[0] == 0 && header[1] == 0)
+					break;
+
+				fn((unsigned)block);
+
+				unsigned long long const size = member_size(header);
+
+				/* one metablock and the rounded-up datablocks */
+				block += 1 + (size + BLOCK_LEN - 1)/BLOCK_LEN;
+			}
+		}
+
+		void _build()
+		{
+			if (_built)
+				return;
+
+			_for_each_record([&] (unsigned) { _capacity++; });
+
+			if (_capacity)
+				_entries = (Entry *)_alloc.alloc(_capacity*sizeof(Entry));
+
+			_for_each_record([&] (unsigned block) {
+
+				char const *name = _base + (size_t)block*BLOCK_LEN;
+
+				size_t len = 0;
+				while (len < NAME_LEN && name[len])
+					len++;
+
+				char const *path = _normalize(name, len);
+
+				/* skip the record of the archive root */
+				if (len == 0)
+					return;
+
+				_entries[_count++] = Entry { block,
+				                             (unsigned char)(path - name),
+				                             (unsigned char)len };
+			});
+
+			_sort();
+
+			/* keep only the last record of each path */
+			unsigned long n = 0;
+			for (unsigned long i = 0; i < _count; i++) {
+				if (n && _compare(_entries[n - 1], _path(_entries[i]),
+				                  _entries[i].length) == 0)
+					n--;
+				_entries[n++] = _entries[i];
+			}
+			_count = n;
+
+			_built = true;
+		}
+
+		/**
+		 * Return position of the first entry within directory 'key'
+		 */
+		unsigned long _first_child(char const *key, size_t len) const
+		{
+			unsigned long pos = _lower_bound(key, len);
+			if (len && pos < _count && _compare(_entries[pos], key, len) == 0)
+				pos++;
+			return pos;
+		}
+
+		/**
+		 * Return length of the path of the directory entry starting at 'pos'
+		 *
+		 * \return  0 if 'pos' lies outside of directory 'key'
+		 */
+		size_t _child_len(char const *key, size_t len, unsigned long pos) const
+		{
+			if (pos >= _count)
+				return 0;
+
+			Entry const &e = _entries[pos];
+			if (!_in_subtree(e, key, len) || e.length == len)
+				return 0;
+
+			char const *path = _path(e);
+			size_t child_len = len ? len + 1 : 0;
+			while (child_len < e.length && path[child_len] != '/')
+				child_len++;
+
+			return child_len;
+		}
+
+		Node _node(unsigned long pos, size_t len) const
+		{
+			Entry const &e = _entries[pos];
+
+			/* directories without record are identified by their length */
+			Node node;
+			node.header = e.length == len ? _header(e) : nullptr;
+			node.id     = pos*(NAME_LEN + 1) + len + 2;
+			return node;
+		}
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param alloc  allocator used for the index
+		 * \param base   local address of the archive
+		 * \param size   size of the archive in bytes
+		 */
+		Index(Genode::Allocator &alloc, char const *base, size_t size)
+		: _alloc(alloc), _base(base), _size(size) { }
+
+		~Index()
+		{
+			if (_entries)
+				_alloc.free(_entries, _capacity*sizeof(Entry));
+		}
+
+		/**
+		 * Look up record or implicit directory of 'path'
+		 *
+		 * The root of the archive is always found as directory.
+		 */
+		Node lookup(char const *path)
+		{
+			Genode::Lock::Guard guard(_lock);
+			_build();
+
+			size_t len = Genode::strlen(path);
+			char const * const key = _normalize(path, len);
+
+			if (len == 0) {
+				Node root;
+				root.id = 1;
+				return root;
+			}
+
+			unsigned long const pos = _lower_bound(key, len);
+			if (pos < _count && _in_subtree(_entries[pos], key, len))
+				return _node(pos, len);
+
+			return Node();
+		}
+
+		/**
+		 * Return number of entries of directory 'path'
+		 */
+		unsigned long num_children(char const *path)
+		{
+			Genode::Lock::Guard guard(_lock);
+			_build();
+
+			size_t len = Genode::strlen(path);
+			char const * const key = _normalize(path, len);
+
+			unsigned long count = 0;
+			for (unsigned long pos = _first_child(key, len); ; count++) {
+				size_t const child_len = _child_len(key, len, pos);
+				if (!child_len)
+					break;
+				pos = _subtree_end(_path(_entries[pos]), child_len, pos);
+			}
+			return count;
+		}
+
+		/**
+		 * Return entry at position 'index' of directory 'path'
+		 *
+		 * \param cursor  position of the previously returned entry, which
+		 *                speeds up sequential enumeration
+		 * \param name    buffer for the null-terminated name of the entry
+		 *
+		 * \return  node of the entry, invalid if 'index' is out of range
+		 */
+		Node child(char const *path, unsigned long index, Cursor &cursor,
+		           char *name, size_t name_len)
+		{
+			Genode::Lock::Guard guard(_lock);
+			_build();
+
+			size_t len = Genode::strlen(path);
+			char const * const key = _normalize(path, len);
+
+			if (cursor.index > index) {
+				cursor.index = 0;
+				cursor.pos   = _first_child(key, len);
+			}
+
+			size_t child_len = _child_len(key, len, cursor.pos);
+
+			for (; child_len && cursor.index < index; cursor.index++) {
+				cursor.pos = _subtree_end(_path(_entries[cursor.pos]),
+				                          child_len, cursor.pos);
+				child_len  = _child_len(key, len, cursor.pos);
+			}
+
+			if (!child_len)
+				return Node();
+
+			size_t const start = len ? len + 1 : 0;
+			Genode::strncpy(name, _path(_entries[cursor.pos]) + start,
+			                Genode::min(name_len, child_len - start + 1));
+
+			return _node(cursor.pos, child_len);
+		}
+
+		/**
+		 * Return true if the content of the member can be mapped directly
+		 *
+		 * This is the case if the data starts at a page boundary of the
+		 * archive and the remainder of its last page contains zeros only,
+		 * so that a page-granular mapping of the member reveals no data
+		 * of other records.
+		 *
+		 * \param page_size  granularity of mappings
+		 */
+		bool mappable(char const *header, size_t page_size) const
+		{
+			size_t const data = member_data(header) - _base;
+			size_t const size = (size_t)member_size(header);
+
+			if (data % page_size || size == 0)
+				return false;
+
+			size_t const end = Genode::min(_size,
+			                               (data + size + page_size - 1)
+			                               & ~(page_size - 1));
+
+			for (size_t i = data + size; i < end; i++)
+				if (_base[i])
+					return false;
+
+			return true;
+		}
+
+		/**
+		 * Return offset of the member data within the archive
+		 */
+		size_t data_offset(char const *header) const {
+			return member_data(header) - _base; }
+};
+
+#endif /* _INCLUDE__TAR__INDEX_H_ */
@@ -0,0 +1,131 @@
+/*
+ * \brief  Dataspace holding the content of a TAR archive member
+ * \author Genode Labs
+ * \date   2026-10-14
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__TAR__MEMBER_DATASPACE_H_
+#define _INCLUDE__TAR__MEMBER_DATASPACE_H_
+
+/* Genode includes */
+#include <base/attached_dataspace.h>
+#include <util/misc_math.h>
+#include <region_map/client.h>
+#include <rm_session/connection.h>
+#include <tar/index.h>
+
+namespace Tar { class Member_dataspace; }
+
+
+/**
+ * Dataspace with the content of one archive member
+ *
+ * If the member is mappable according to 'Index::mappable', the dataspace
+ * is a managed dataspace that refers to the pages of the archive directly.
+ * Otherwise, or if no managed dataspace can be created, the content is
+ * copied into a RAM dataspace.
+ */
+class Tar::Member_dataspace : Genode::Noncopyable
+{
+	private:
+
+		enum { PAGE_SIZE = 4096 };
+
+		Genode::Ram_session &_ram;
+		Genode::Rm_session  *_rm_session;
+
+		Genode::Capability<Genode::Region_map> _region_map { };
+		Genode::Ram_dataspace_capability       _ram_ds     { };
+		Genode::Dataspace_capability           _ds         { };
+
+		bool _map(Genode::Dataspace_capability archive_ds,
+		          Index const &index, char const *header)
+		{
+			using namespace Genode;
+
+			if (!_rm_session || !index.mappable(header, PAGE_SIZE))
+				return false;
+
+			size_t const size = align_addr((size_t)Index::member_size(header), 12);
+
+			try {
+				_region_map = _rm_session->create(size);
+				Region_map_client rm(_region_map);
+				rm.attach(archive_ds, size, index.data_offset(header));
+				_ds = rm.dataspace();
+				return true;
+			}
+			catch (...) {
+				if (_region_map.valid())
+					_rm_session->destroy(_region_map);
+				_region_map = Capability<Region_map>();
+				return false;
+			}
+		}
+
+		void _copy(Genode::Region_map &local_rm, char const *header)
+		{
+			using namespace Genode;
+
+			size_t const size = (size_t)Index::member_size(header);
+
+			_ram_ds = _ram.alloc(size);
+			_ds     = _ram_ds;
+
+			Attached_dataspace ds(local_rm, _ram_ds);
+			memcpy(ds.local_addr<char>(), Index::member_data(header),
+			       min(size, ds.size()));
+		}
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param rm_session  RM session used for managed dataspaces, or
+		 *                    nullptr to always copy the content
+		 * \param archive_ds  dataspace of the archive
+		 * \param index       index of the archive
+		 * \param header      record header of the member
+		 *
+		 * \throw Out_of_ram
+		 * \throw Out_of_caps
+		 */
+		Member_dataspace(Genode::Ram_session          &ram,
+		                 Genode::Region_map           &local_rm,
+		                 Genode::Rm_session           *rm_session,
+		                 Genode::Dataspace_capability  archive_ds,
+		                 Index                  const &index,
+		                 char                   const *header)
+		:
+			_ram(ram), _rm_session(rm_session)
+		{
+			if (!_map(archive_ds, index, header))
+				_copy(local_rm, header);
+		}
+
+		virtual ~Member_dataspace()
+		{
+			if (_region_map.valid())
+				_rm_session->destroy(_region_map);
+
+			if (_ram_ds.valid())
+				_ram.free(_ram_ds);
+		}
+
+		Genode::Dataspace_capability cap() const { return _ds; }
+
+		/**
+		 * Return true if the dataspace refers to the archive directly
+		 */
+		bool zero_copy() const { return _region_map.valid(); }
+};
+
+#endif /* _INCLUDE__TAR__MEMBER_DATASPACE_H_ */
@@ -16,6 +16,7 @@
 
 /* Genode includes */
 #include <base/allocator.h>
+#include <util/string.h>
 
 
 /**
@@ -23,18 +24,46 @@
  *              about the glyph and its attributes
  *
  * The 'CELL' type must have a default constructor and has to provide the
- * methods 'set_cursor()' and 'clear_cursor'.
+ * methods 'set_cursor()' and 'clear_cursor'. Cells are compared bytewise
+ * to detect changes. Hence, the type must not contain padding.
+ *
+ * Changes are tracked per cell. A line is dirty if any of its cells is
+ * dirty.
+ *
+ * If scroll tracking is enabled, scrolling does not mark the lines of the
+ * scroll region as dirty. Instead, the dirty state moves along with the
+ * lines and the scroll operation is recorded. The consumer is expected to
+ * apply the recorded operations to its output, e.g., by moving pixels,
+ * before updating the dirty cells.
  */
 template <typename CELL>
 class Cell_array
 {
+	public:
+
+		/**
+		 * Scroll operation
+		 *
+		 * The lines of the region 'start'...'end' are moved up by 'lines',
+		 * or down if negative.
+		 */
+		struct Scroll { int start, end, lines; };
+
 	private:
 
+		enum { MAX_SCROLLS = 8 };
+
+		Scroll   _scrolls[MAX_SCROLLS];
+		unsigned _num_scrolls     = 0;
+		bool     _track_scrolls   = false;
+		bool     _scroll_overflow = false;
+
 		unsigned           _num_cols;
 		unsigned           _num_lines;
 		Genode::Allocator *_alloc;
 		CELL             **_array;
 		bool              *_line_dirty;
+		bool              *_cell_dirty;  /* indexed by screen position */
 
 		typedef CELL *Char_cell_line;
 
@@ -44,10 +73,53 @@ class Cell_array
 				*line++ = CELL();
 		}
 
+		bool *_cell_dirty_line(int line) { return _cell_dirty + line*_num_cols; }
+
+		void _mark_cell_as_dirty(int column, int line)
+		{
+			_cell_dirty_line(line)[column] = true;
+			_line_dirty[line] = true;
+		}
+
 		void _mark_lines_as_dirty(int start, int end)
 		{
 			for (int line = start; line <= end; line++)
-				_line_dirty[line] = true;
+				mark_line_as_dirty(line);
+		}
+
+		/**
+		 * Move dirty state of the scroll region along with the lines
+		 */
+		void _scroll_dirty_state(int start, int end, bool up)
+		{
+			int const from = up ? start + 1 : start;
+			int const to   = up ? start     : start + 1;
+			int const n    = end - start;
+
+			Genode::memmove(_line_dirty + to, _line_dirty + from, n*sizeof(bool));
+			Genode::memmove(_cell_dirty_line(to), _cell_dirty_line(from),
+			                n*_num_cols*sizeof(bool));
+
+			/* the exposed line must be updated */
+			mark_line_as_dirty(up ? end : start);
+		}
+
+		void _record_scroll(int start, int end, bool up)
+		{
+			int const lines = up ? 1 : -1;
+
+			Scroll *last = _num_scrolls ? &_scrolls[_num_scrolls - 1] : nullptr;
+			if (last && last->start == start && last->end == end) {
+				last->lines += lines;
+				return;
+			}
+
+			if (_num_scrolls == MAX_SCROLLS) {
+				_scroll_overflow = true;
+				return;
+			}
+
+			_scrolls[_num_scrolls++] = Scroll { start, end, lines };
 		}
 
 		void _scroll_vertically(int start, int end, bool up)
@@ -67,7 +139,13 @@ class Cell_array
 
 			_array[up ? end: start] = yanked_line;
 
-			_mark_lines_as_dirty(start, end);
+			if (!_track_scrolls || start >= end) {
+				_mark_lines_as_dirty(start, end);
+				return;
+			}
+
+			_scroll_dirty_state(start, end, up);
+			_record_scroll(start, end, up);
 		}
 
 	public:
@@ -85,6 +163,10 @@ class Cell_array
 			for (unsigned i = 0; i < num_lines; i++)
 				_line_dirty[i] = false;
 
+			_cell_dirty = new (alloc) bool[num_lines*num_cols];
+			for (unsigned i = 0; i < num_lines*num_cols; i++)
+				_cell_dirty[i] = false;
+
 			for (unsigned i = 0; i < num_lines; i++)
 				_array[i] = new (alloc) CELL[num_cols];
 		}
@@ -94,14 +176,21 @@ class Cell_array
 			for (unsigned i = 0; i < _num_lines; i++)
 				Genode::destroy(_alloc, _array[i]);
 
+			Genode::destroy(_alloc, _cell_dirty);
 			Genode::destroy(_alloc, _line_dirty);
 			Genode::destroy(_alloc, _array);
 		}
 
 		void set_cell(int column, int line, CELL cell)
 		{
-			_array[line][column] = cell;
-			_line_dirty[line] = true;
+			CELL &curr = _array[line][column];
+
+			/* rewriting the same content is common for full-screen updates */
+			if (Genode::memcmp(&curr, &cell, sizeof(CELL)) == 0)
+				return;
+
+			curr = cell;
+			_mark_cell_as_dirty(column, line);
 		}
 
 		CELL get_cell(int column, int line)
@@ -111,16 +200,52 @@ class Cell_array
 
 		bool line_dirty(int line) { return _line_dirty[line]; }
 
+		bool cell_dirty(int column, int line) { return _cell_dirty_line(line)[column]; }
+
 		void mark_line_as_clean(int line)
 		{
+			bool *cells = _cell_dirty_line(line);
+			for (unsigned col = 0; col < _num_cols; col++)
+				cells[col] = false;
+
 			_line_dirty[line] = false;
 		}
 
 		void mark_line_as_dirty(int line)
 		{
+			bool *cells = _cell_dirty_line(line);
+			for (unsigned col = 0; col < _num_cols; col++)
+				cells[col] = true;
+
 			_line_dirty[line] = true;
 		}
 
+		/**
+		 * Enable recording of scroll operations
+		 */
+		void track_scrolls(bool enabled) { _track_scrolls = enabled; }
+
+		/**
+		 * Call functor for each recorded scroll operation in order
+		 *
+		 * The functor 'fn' takes a 'Scroll const &' as argument. If too many
+		 * distinct scroll operations were recorded, all lines are marked as
+		 * dirty instead.
+		 */
+		template <typename FN>
+		void flush_scrolls(FN const &fn)
+		{
+			if (_scroll_overflow)
+				_mark_lines_as_dirty(0, _num_lines - 1);
+			else
+				for (unsigned i = 0; i < _num_scrolls; i++)
+					if (_scrolls[i].lines)
+						fn(_scrolls[i]);
+
+			_num_scrolls     = 0;
+			_scroll_overflow = false;
+		}
+
 		void scroll_up(int region_start, int region_end)
 		{
 			_scroll_vertically(region_start, region_end, true);
@@ -153,7 +278,7 @@ class Cell_array
 				cell.clear_cursor();
 
 			if (mark_dirty)
-				_line_dirty[pos.y] = true;
+				_mark_cell_as_dirty(pos.x, pos.y);
 		}
 
 		unsigned num_cols()  { return _num_cols; }
@@ -155,6 +155,16 @@ class Char_cell_array_character_screen : public Terminal::Character_screen
 
 		Terminal::Position cursor_pos() const { return _cursor_pos; }
 
+		/**
+		 * Return true if characters are output with the default attributes
+		 * and line feeds scroll the whole screen
+		 */
+		bool plain() const
+		{
+			return _color_index == DEFAULT_COLOR_INDEX && !_inverse && !_highlight
+			    && _region_start == 0 && _region_end == _boundary.height - 1;
+		}
+
 		void output(Terminal::Character c)
 		{
 			if (c.ascii() > 0x10) {
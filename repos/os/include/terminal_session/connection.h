@@ -46,12 +46,21 @@ struct Terminal::Connection : Genode::Connection<Session>, Session_client
 
 	/**
 	 * Constructor
+	 *
+	 * \param io_buffer_size  size of the shared I/O buffer requested from
+	 *                        the server, 0 for the server's default
+	 *
+	 * A larger I/O buffer lets 'read' and 'write' transfer more data per
+	 * RPC. The server may impose a limit or ignore the request.
 	 */
-	Connection(Genode::Env &env, char const *label = "")
+	Connection(Genode::Env &env, char const *label = "",
+	           Genode::size_t io_buffer_size = 0)
 	:
 		Genode::Connection<Session>(env, session(env.parent(),
-		                                         "ram_quota=%ld, cap_quota=%ld, label=\"%s\"",
-		                                         10*1024, CAP_QUOTA, label)),
+		                                         "ram_quota=%ld, cap_quota=%ld, "
+		                                         "io_buffer_size=%ld, label=\"%s\"",
+		                                         10*1024 + io_buffer_size, CAP_QUOTA,
+		                                         io_buffer_size, label)),
 		Session_client(env.rm(), cap())
 	{
 		wait_for_connection(cap());
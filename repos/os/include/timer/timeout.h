@@ -31,6 +31,7 @@ namespace Genode {
 	class Timeout_scheduler;
 	class Timeout;
 	class Alarm_timeout_scheduler;
+	class Wheel_timeout_scheduler;
 }
 
 namespace Timer
@@ -139,6 +140,7 @@ class Genode::Timeout_scheduler
 class Genode::Timeout : private Noncopyable
 {
 	friend class Alarm_timeout_scheduler;
+	friend class Wheel_timeout_scheduler;
 
 	public:
 
@@ -170,10 +172,30 @@ class Genode::Timeout : private Noncopyable
 
 		} _alarm;
 
+		/**
+		 * State of the timeout within a 'Wheel_timeout_scheduler'
+		 */
+		struct Wheel_entry
+		{
+			Timeout      &timeout;
+			Lock          dispatch_lock { };  /* taken during 'on_alarm' */
+			Wheel_entry  *next     = nullptr;
+			Wheel_entry **prev     = nullptr; /* link to entry, 0 if unqueued */
+			uint64_t      deadline = 0;       /* absolute, in ticks */
+			uint64_t      period   = 0;       /* in ticks, 0 if one-shot */
+			unsigned      level    = 0;
+			unsigned      slot     = 0;
+
+			Wheel_entry(Timeout &timeout) : timeout(timeout) { }
+
+			bool queued() const { return prev != nullptr; }
+
+		} _wheel_entry;
+
 	public:
 
 		Timeout(Timeout_scheduler &timeout_scheduler)
-		: _alarm(timeout_scheduler) { }
+		: _alarm(timeout_scheduler), _wheel_entry(*this) { }
 
 		~Timeout() { discard(); }
 
@@ -235,4 +257,112 @@ class Genode::Alarm_timeout_scheduler : private Noncopyable,
 		Duration curr_time() override { return _time_source.curr_time(); }
 };
 
+
+/**
+ * Timeout-scheduler implementation using a hierarchical timing wheel
+ *
+ * In contrast to the 'Alarm_timeout_scheduler', which keeps all timeouts
+ * in a sorted list, scheduling and discarding a timeout takes constant
+ * time. Time is divided into ticks of the configured precision. Each
+ * level of the wheel consists of 'SLOTS' lists of timeouts, each list
+ * covering 'SLOTS' times the ticks of a list of the next lower level. A
+ * timeout resides at the lowest level at which its deadline shares all
+ * higher-order digits with the current time. When time advances, the
+ * timeouts of lists that are passed are either due or move to a lower
+ * level. Hence, each timeout moves at most 'NUM_LEVELS' times.
+ *
+ * Timeouts never trigger before their deadline but up to one tick later.
+ * Timeouts that are due at the same time are executed in the order of
+ * their deadlines only at the granularity of the lists they resided in.
+ */
+class Genode::Wheel_timeout_scheduler : private Noncopyable,
+                                        public  Timeout_scheduler,
+                                        public  Time_source::Timeout_handler
+{
+	friend class Timer::Connection;
+	friend class Timer::Root_component;
+
+	public:
+
+		enum { LEVEL_BITS = 4, SLOTS = 1 << LEVEL_BITS,
+		       NUM_LEVELS = 64 / LEVEL_BITS };
+
+	private:
+
+		typedef Timeout::Wheel_entry Entry;
+
+		enum { EXPIRED = NUM_LEVELS };
+
+		Time_source    &_time_source;
+		unsigned const  _tick_shift;   /* log2 of tick in microseconds */
+
+		Lock          _lock { };
+		unsigned long _last_us = 0;    /* time-source value at last update */
+		uint64_t      _now_us  = 0;
+		uint64_t      _now     = 0;    /* current time in ticks */
+		uint64_t      _wakeup  = ~0ULL; /* tick of the programmed wakeup */
+
+		Entry    *_slots[NUM_LEVELS][SLOTS] { };
+		unsigned  _occupied[NUM_LEVELS]     { }; /* bitmap of non-empty slots */
+
+		/* due timeouts in the order of their expiration */
+		Entry  *_expired      = nullptr;
+		Entry **_expired_tail = &_expired;
+
+		static unsigned _tick_shift_of(Microseconds precision);
+
+		/**
+		 * Return duration in ticks, rounded up
+		 */
+		uint64_t _ticks(uint64_t duration_us) const;
+
+		/**
+		 * Return tick at which a timeout of 'duration_us' is due
+		 */
+		uint64_t _deadline(uint64_t duration_us) const;
+
+		void _enable();
+		void _update_time();
+		void _insert(Entry &entry);
+		void _remove(Entry &entry);
+		void _advance(uint64_t now);
+		void _schedule_wakeup();
+
+
+		/**********************************
+		 ** Time_source::Timeout_handler **
+		 **********************************/
+
+		void handle_timeout(Duration curr_time) override;
+
+
+		/***********************
+		 ** Timeout_scheduler **
+		 ***********************/
+
+		void _schedule_one_shot(Timeout &timeout, Microseconds duration) override;
+		void _schedule_periodic(Timeout &timeout, Microseconds duration) override;
+		void _discard(Timeout &timeout) override;
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param precision  duration of one tick, rounded up to a power
+		 *                   of two
+		 */
+		Wheel_timeout_scheduler(Time_source  &time_source,
+		                        Microseconds  precision = Microseconds(1));
+
+		~Wheel_timeout_scheduler();
+
+
+		/***********************
+		 ** Timeout_scheduler **
+		 ***********************/
+
+		Duration curr_time() override { return _time_source.curr_time(); }
+};
+
 #endif /* _TIMER__TIMEOUT_H_ */
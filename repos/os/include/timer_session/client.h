@@ -36,6 +36,8 @@ struct Timer::Session_client : Genode::Rpc_client<Session>
 	unsigned long elapsed_ms() const override { return call<Rpc_elapsed_ms>(); }
 
 	unsigned long elapsed_us() const override { return call<Rpc_elapsed_us>(); }
+
+	Genode::Dataspace_capability time_page() override { return call<Rpc_time_page>(); }
 };
 
 #endif /* _INCLUDE__TIMER_SESSION__CLIENT_H_ */
@@ -16,7 +16,9 @@
 
 /* Genode includes */
 #include <timer_session/client.h>
+#include <timer_session/time_page.h>
 #include <base/connection.h>
+#include <base/attached_dataspace.h>
 #include <util/reconstructible.h>
 #include <base/entrypoint.h>
 #include <timer/timeout.h>
@@ -197,6 +199,16 @@ class Timer::Connection : public  Genode::Connection<Session>,
 
 		Genode::Io_signal_handler<Connection> _signal_handler;
 
+		/*
+		 * Once the time page provided by the server is calibrated, the
+		 * time is interpolated from the page and the real-time updates
+		 * via RPC below are no longer needed.
+		 */
+		Genode::Attached_dataspace _time_page_ds;
+
+		Time_page const &_time_page() const {
+			return *_time_page_ds.local_addr<Time_page const>(); }
+
 		Timeout_handler *_handler               { nullptr };
 		Lock             _real_time_lock        { Lock::UNLOCKED };
 		unsigned long    _us                    { elapsed_us() };
@@ -235,7 +247,7 @@ class Timer::Connection : public  Genode::Connection<Session>,
 		 ** Timeout_scheduler helpers **
 		 *******************************/
 
-		Genode::Alarm_timeout_scheduler _scheduler { *this };
+		Genode::Wheel_timeout_scheduler _scheduler { *this };
 
 
 		/***********************
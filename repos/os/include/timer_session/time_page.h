@@ -0,0 +1,121 @@
+/*
+ * \brief  Time information shared between timer server and client
+ * \author Genode Labs
+ * \date   2026-10-14
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__TIMER_SESSION__TIME_PAGE_H_
+#define _INCLUDE__TIMER_SESSION__TIME_PAGE_H_
+
+/* Genode includes */
+#include <base/stdint.h>
+#include <cpu/memory_barrier.h>
+#include <trace/timestamp.h>
+
+namespace Timer { struct Time_page; }
+
+
+/**
+ * Page, provided by the timer server to each session, for reading the
+ * time without invoking the server
+ *
+ * The server periodically stores its current time together with a
+ * timestamp taken at the same moment and the ratio of time and timestamp
+ * progress, which it calibrates against its own time source. The client
+ * interpolates the current time from these values and its own timestamp.
+ * This requires the timestamps of server and client to be comparable,
+ * which holds for the global timestamp counters used by 'Trace::timestamp'
+ * and the kernel time on base-hw.
+ *
+ * Updates are protected by a sequence counter that is odd while an update
+ * is in progress. A reader that observes an odd or changing counter
+ * retries.
+ */
+struct Timer::Time_page
+{
+	typedef Genode::uint64_t         uint64_t;
+	typedef Genode::Trace::Timestamp Timestamp;
+
+	enum { UPDATE_PERIOD_US = 250000 };
+	enum { RATIO_SHIFT      = 32 };
+	enum { MAX_READ_TRIALS  = 100 };
+
+	unsigned volatile seq;
+
+	uint64_t volatile us;       /* time since session creation */
+	uint64_t volatile ts;       /* timestamp taken at 'us' */
+	uint64_t volatile us_per_ts; /* fixed point with 'RATIO_SHIFT' fractional
+	                                bits, 0 if not calibrated yet */
+
+	/**
+	 * Return timestamp comparable to the one of the timer server
+	 */
+	static Timestamp timestamp();
+
+	/**
+	 * Return true if the page can be used for interpolating the time
+	 */
+	bool valid() const { return us_per_ts != 0; }
+
+	/**
+	 * Update the page, must be called by the timer server only
+	 */
+	void write(uint64_t new_us, Timestamp new_ts, uint64_t new_us_per_ts)
+	{
+		seq = seq + 1;
+		Genode::memory_barrier();
+
+		us        = new_us;
+		ts        = new_ts;
+		us_per_ts = new_us_per_ts;
+
+		Genode::memory_barrier();
+		seq = seq + 1;
+	}
+
+	/**
+	 * Interpolate the current time from the page
+	 *
+	 * \param result  time since session creation in microseconds
+	 *
+	 * \return  false if the page is not calibrated yet or could not be
+	 *          read consistently
+	 */
+	bool read_us(uint64_t &result) const
+	{
+		for (unsigned i = 0; i < MAX_READ_TRIALS; i++) {
+
+			unsigned const start_seq = seq;
+			if (start_seq & 1)
+				continue;
+
+			Genode::memory_barrier();
+			uint64_t const page_us    = us;
+			uint64_t const page_ts    = ts;
+			uint64_t const page_ratio = us_per_ts;
+			Genode::memory_barrier();
+
+			if (seq != start_seq)
+				continue;
+
+			if (!page_ratio)
+				return false;
+
+			/* the difference is taken in the timestamp type to handle wraps */
+			uint64_t const ts_diff = (Timestamp)(timestamp() - (Timestamp)page_ts);
+
+			result = page_us + ((ts_diff * page_ratio) >> RATIO_SHIFT);
+			return true;
+		}
+		return false;
+	}
+};
+
+#endif /* _INCLUDE__TIMER_SESSION__TIME_PAGE_H_ */
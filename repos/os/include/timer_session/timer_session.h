@@ -17,6 +17,7 @@
 #define _INCLUDE__TIMER_SESSION__TIMER_SESSION_H_
 
 #include <base/signal.h>
+#include <dataspace/capability.h>
 #include <session/session.h>
 
 namespace Timer { struct Session; }
@@ -60,6 +61,14 @@ struct Timer::Session : Genode::Session
 
 	virtual unsigned long elapsed_us() const = 0;
 
+	/**
+	 * Return dataspace of the session's time page
+	 *
+	 * The dataspace contains a 'Timer::Time_page', which allows for
+	 * reading the time without invoking the server.
+	 */
+	virtual Genode::Dataspace_capability time_page() = 0;
+
 	/**
 	 * Client-side convenience method for sleeping the specified number
 	 * of milliseconds
@@ -82,9 +91,11 @@ struct Timer::Session : Genode::Session
 	GENODE_RPC(Rpc_sigh, void, sigh, Genode::Signal_context_capability);
 	GENODE_RPC(Rpc_elapsed_ms, unsigned long, elapsed_ms);
 	GENODE_RPC(Rpc_elapsed_us, unsigned long, elapsed_us);
+	GENODE_RPC(Rpc_time_page, Genode::Dataspace_capability, time_page);
 
 	GENODE_RPC_INTERFACE(Rpc_trigger_once, Rpc_trigger_periodic,
-	                     Rpc_sigh, Rpc_elapsed_ms, Rpc_elapsed_us);
+	                     Rpc_sigh, Rpc_elapsed_ms, Rpc_elapsed_us,
+	                     Rpc_time_page);
 };
 
 #endif /* _INCLUDE__TIMER_SESSION__TIMER_SESSION_H_ */
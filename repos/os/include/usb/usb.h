@@ -92,6 +92,7 @@ class Usb::Endpoint : public Endpoint_descriptor
 		Endpoint(Endpoint_descriptor &endpoint_descr)
 		: Endpoint_descriptor(endpoint_descr) { }
 
+		bool isoc()      const { return (attributes & 0x3) == ENDPOINT_ISOC;      }
 		bool bulk()      const { return (attributes & 0x3) == ENDPOINT_BULK;      }
 		bool interrupt() const { return (attributes & 0x3) == ENDPOINT_INTERRUPT; }
 
@@ -356,6 +357,32 @@ class Usb::Interface : public Meta_data
 			if(block) Sync_completion sync(_handler, p);
 			else _handler.submit(p);
 		}
+
+		/**
+		 * Submit isochronous transfer
+		 *
+		 * The packet content must start with an 'Isoc_transfer' header that
+		 * describes the frames of the transfer.
+		 */
+		void isoc_transfer(Packet_descriptor &p, Endpoint &ep,
+		                   int polling_interval =
+		                   	Usb::Packet_descriptor::DEFAULT_POLLING_INTERVAL,
+		                   bool block = true, Completion *c = nullptr)
+		{
+			_check();
+
+			if (!ep.isoc())
+				throw Session::Invalid_endpoint();
+
+			p.type                      = Usb::Packet_descriptor::ISOC;
+			p.succeded                  = false;
+			p.transfer.ep               = ep.address;
+			p.transfer.polling_interval = polling_interval;
+			p.completion                = c;
+
+			if(block) Sync_completion sync(_handler, p);
+			else _handler.submit(p);
+		}
 };
 
 
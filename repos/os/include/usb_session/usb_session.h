@@ -24,6 +24,7 @@ namespace Usb {
 	using namespace Genode;
 	class Session;
 	struct Packet_descriptor;
+	struct Isoc_transfer;
 	struct Completion;
 }
 
@@ -33,7 +34,7 @@ namespace Usb {
  */
 struct Usb::Packet_descriptor : Genode::Packet_descriptor
 {
-	enum Type { STRING, CTRL, BULK, IRQ, ALT_SETTING, CONFIG, RELEASE_IF };
+	enum Type { STRING, CTRL, BULK, IRQ, ALT_SETTING, CONFIG, RELEASE_IF, ISOC };
 
 	/* use the polling interval stated in the endpoint descriptor */
 	enum { DEFAULT_POLLING_INTERVAL = -1 };
@@ -64,7 +65,8 @@ struct Usb::Packet_descriptor : Genode::Packet_descriptor
 		{
 			uint8_t ep;
 			int     actual_size; /* returned */
-			int     polling_interval; /* for interrupt transfers */
+			int     polling_interval; /* for interrupt and isochronous transfers */
+			unsigned latency_us;      /* returned, time spent at the host controller */
 		} transfer;
 
 		struct
@@ -104,6 +106,44 @@ struct Usb::Packet_descriptor : Genode::Packet_descriptor
 };
 
 
+/**
+ * Payload of isochronous transfers
+ *
+ * One packet carries several frames, which spares a packet-stream round trip
+ * per frame. The content of an 'ISOC' packet starts with this header,
+ * followed by the frame data. Frame 'i' starts at the sum of the
+ * 'packet_size' values of the preceding frames. On completion,
+ * 'actual_packet_size' holds the number of bytes transferred per frame.
+ */
+struct Usb::Isoc_transfer
+{
+	enum { MAX_PACKETS = 32 };
+
+	unsigned number_of_packets;
+	unsigned packet_size[MAX_PACKETS];
+	unsigned actual_packet_size[MAX_PACKETS];
+
+	char *data() { return reinterpret_cast<char *>(this + 1); }
+
+	/**
+	 * Return offset of frame data within the payload
+	 */
+	Genode::size_t frame_offset(unsigned frame) const
+	{
+		Genode::size_t offset = 0;
+		for (unsigned i = 0; i < frame && i < MAX_PACKETS; i++)
+			offset += packet_size[i];
+		return offset;
+	}
+
+	/**
+	 * Return packet size needed for the given amount of frame data
+	 */
+	static Genode::size_t size(Genode::size_t data_size) {
+		return sizeof(Isoc_transfer) + data_size; }
+};
+
+
 /**
  * Completion for asynchronous communication
  */
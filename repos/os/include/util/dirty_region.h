@@ -0,0 +1,299 @@
+/*
+ * \brief  Utility for tracking dirty areas as a set of disjoint rectangles
+ * \author Genode Labs
+ * \date   2026-10-14
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__UTIL__DIRTY_REGION_H_
+#define _INCLUDE__UTIL__DIRTY_REGION_H_
+
+#include <base/stdint.h>
+
+namespace Genode { template <typename, unsigned> class Dirty_region; }
+
+
+/**
+ * Dirty-region tracker
+ *
+ * \param RECT       rectangle type (as defined in 'util/geometry.h')
+ * \param MAX_RECTS  maximum number of rectangles of the region
+ *
+ * In contrast to 'Dirty_rect', which merges the dirty area into a few
+ * compound rectangles, the region represents the dirty area by disjoint
+ * rectangles. Of an added rectangle, only the parts not covered yet are
+ * added, each cut into the horizontal bands above, beside, and below the
+ * covered rectangle. Adjacent rectangles of the same height or width are
+ * coalesced. Hence, two small areas in opposite corners stay two small
+ * rectangles instead of becoming the whole screen.
+ *
+ * Each rectangle of the region causes a traversal of the consumer, e.g., of
+ * a view stack. The number of rectangles is therefore limited by a redraw
+ * budget. Once the budget is exceeded, the two rectangles with the cheapest
+ * compound are merged, which trades overdraw for fewer traversals.
+ */
+template <typename RECT, unsigned MAX_RECTS>
+class Genode::Dirty_region
+{
+	private:
+
+		static_assert(MAX_RECTS > 1, "region needs room for merging rectangles");
+
+		typedef RECT Rect;
+		typedef Genode::size_t size_t;
+
+		Rect     _rects[MAX_RECTS];
+		unsigned _count  = 0;
+		unsigned _budget = MAX_RECTS;
+
+		static size_t _pixels(Rect const &r) { return r.area().count(); }
+
+		static bool _intersect(Rect const &r1, Rect const &r2) {
+			return Rect::intersect(r1, r2).valid(); }
+
+		static bool _contains(Rect const &outer, Rect const &inner)
+		{
+			return outer.x1() <= inner.x1() && outer.x2() >= inner.x2()
+			    && outer.y1() <= inner.y1() && outer.y2() >= inner.y2();
+		}
+
+		/**
+		 * Return true if the union of 'r1' and 'r2' is a rectangle
+		 */
+		static bool _adjacent(Rect const &r1, Rect const &r2)
+		{
+			if (r1.y1() == r2.y1() && r1.y2() == r2.y2())
+				return r1.x2() + 1 == r2.x1() || r2.x2() + 1 == r1.x1();
+
+			if (r1.x1() == r2.x1() && r1.x2() == r2.x2())
+				return r1.y2() + 1 == r2.y1() || r2.y2() + 1 == r1.y1();
+
+			return false;
+		}
+
+		void _remove(unsigned i) { _rects[i] = _rects[--_count]; }
+
+		/**
+		 * Insert rectangle that is disjoint to all rectangles of the region
+		 *
+		 * The caller must ensure that there is a free slot.
+		 */
+		void _insert_disjoint(Rect r)
+		{
+			for (bool merged = true; merged; ) {
+				merged = false;
+				for (unsigned i = 0; i < _count; i++) {
+					if (_adjacent(_rects[i], r)) {
+						r = Rect::compound(_rects[i], r);
+						_remove(i);
+						merged = true;
+						break;
+					}
+				}
+			}
+			_rects[_count++] = r;
+		}
+
+		/**
+		 * Insert rectangle, absorbing all rectangles it intersects
+		 *
+		 * The caller must ensure that there is a free slot.
+		 */
+		void _absorb(Rect r)
+		{
+			for (bool grown = true; grown; ) {
+				grown = false;
+				for (unsigned i = 0; i < _count; ) {
+					if (_intersect(_rects[i], r)) {
+						r = Rect::compound(_rects[i], r);
+						_remove(i);
+						grown = true;
+					} else {
+						i++;
+					}
+				}
+			}
+			_insert_disjoint(r);
+		}
+
+		/**
+		 * Merge the two rectangles whose compound costs the least overdraw
+		 */
+		void _merge_cheapest()
+		{
+			if (_count < 2)
+				return;
+
+			unsigned best_i = 0, best_j = 1;
+			size_t   lowest_costs = ~(size_t)0;
+
+			for (unsigned i = 0; i < _count - 1; i++) {
+				for (unsigned j = i + 1; j < _count; j++) {
+
+					size_t const costs =
+						_pixels(Rect::compound(_rects[i], _rects[j]))
+						- _pixels(_rects[i]) - _pixels(_rects[j]);
+
+					if (costs >= lowest_costs)
+						continue;
+
+					best_i = i; best_j = j;
+					lowest_costs = costs;
+				}
+			}
+
+			Rect const compound = Rect::compound(_rects[best_i], _rects[best_j]);
+
+			/* remove the higher index first as '_remove' moves the last element */
+			_remove(best_j);
+			_remove(best_i);
+			_absorb(compound);
+		}
+
+		void _enforce_budget()
+		{
+			while (_count > _budget)
+				_merge_cheapest();
+		}
+
+	public:
+
+		/**
+		 * Define the maximum number of rectangles, at least one
+		 */
+		void budget(unsigned budget)
+		{
+			_budget = budget < 1 ? 1 : (budget > MAX_RECTS ? MAX_RECTS : budget);
+			_enforce_budget();
+		}
+
+		unsigned budget() const { return _budget; }
+
+		bool empty() const { return _count == 0; }
+
+		unsigned count() const { return _count; }
+
+		/**
+		 * Forget all dirty rectangles
+		 */
+		void reset() { _count = 0; }
+
+		/**
+		 * Return number of dirty pixels
+		 */
+		size_t pixels() const
+		{
+			size_t sum = 0;
+			for (unsigned i = 0; i < _count; i++)
+				sum += _pixels(_rects[i]);
+			return sum;
+		}
+
+		void mark_as_dirty(Rect added)
+		{
+			if (!added.valid())
+				return;
+
+			/* make room for at least one rectangle */
+			if (_count == MAX_RECTS)
+				_merge_cheapest();
+
+			/*
+			 * Cut the parts already covered out of the added rectangle.
+			 * Rectangles covered by the added rectangle are dropped.
+			 */
+			Rect     pieces[MAX_RECTS];
+			unsigned num_pieces = 0;
+			bool     overflow   = false;
+
+			pieces[num_pieces++] = added;
+
+			for (unsigned i = 0; i < _count && !overflow; ) {
+
+				Rect const existing = _rects[i];
+
+				if (_contains(added, existing)) {
+					_remove(i);
+					continue;
+				}
+				i++;
+
+				for (unsigned j = 0; j < num_pieces && !overflow; ) {
+
+					if (!_intersect(pieces[j], existing)) {
+						j++;
+						continue;
+					}
+
+					Rect cut[4];
+					pieces[j].cut(existing, &cut[0], &cut[1], &cut[2], &cut[3]);
+
+					/* replace the piece by its valid remainders */
+					pieces[j] = pieces[--num_pieces];
+					for (unsigned k = 0; k < 4; k++) {
+						if (!cut[k].valid())
+							continue;
+						if (num_pieces == MAX_RECTS) {
+							overflow = true;
+							break;
+						}
+						pieces[num_pieces++] = cut[k];
+					}
+				}
+			}
+
+			if (overflow || _count + num_pieces > MAX_RECTS)
+				_absorb(added);
+			else
+				for (unsigned j = 0; j < num_pieces; j++)
+					_insert_disjoint(pieces[j]);
+
+			_enforce_budget();
+		}
+
+		/**
+		 * Call functor for each dirty rectangle
+		 *
+		 * The functor 'fn' takes a 'Rect const &' as argument.
+		 */
+		template <typename FN>
+		void for_each(FN const &fn) const
+		{
+			for (unsigned i = 0; i < _count; i++)
+				fn(_rects[i]);
+		}
+
+		/**
+		 * Call functor for each dirty rectangle from top to bottom
+		 *
+		 * The functor 'fn' takes a 'Rect const &' as argument.
+		 * This method resets the dirty region.
+		 */
+		template <typename FN>
+		void flush(FN const &fn)
+		{
+			/* sort by position, which keeps the consumer's accesses local */
+			for (unsigned i = 1; i < _count; i++) {
+				Rect const r = _rects[i];
+				unsigned j = i;
+				for (; j > 0 && (_rects[j - 1].y1() > r.y1()
+				             || (_rects[j - 1].y1() == r.y1()
+				              && _rects[j - 1].x1() > r.x1())); j--)
+					_rects[j] = _rects[j - 1];
+				_rects[j] = r;
+			}
+
+			for (unsigned i = 0; i < _count; i++)
+				fn(_rects[i]);
+
+			_count = 0;
+		}
+};
+
+#endif /* _INCLUDE__UTIL__DIRTY_REGION_H_ */
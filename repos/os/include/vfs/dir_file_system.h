@@ -81,9 +81,28 @@ class Vfs::Dir_file_system : public File_system
 		/* pointer to first child file system */
 		File_system *_first_file_system;
 
+		/**
+		 * Entry of the mount table
+		 *
+		 * The mount table holds the child file systems in the order of the
+		 * configuration. For '<dir>' children, it refers to the
+		 * 'Dir_file_system' so that lookups can skip the directories whose
+		 * name does not match the path without descending into them.
+		 */
+		struct Mount
+		{
+			File_system     *fs;
+			Dir_file_system *dir;
+		};
+
+		Mount    *_mounts     = nullptr;
+		unsigned  _num_mounts = 0;
+
 		/* add new file system to the list of children */
-		void _append_file_system(File_system *fs)
+		void _append_file_system(File_system *fs, Dir_file_system *dir = nullptr)
 		{
+			_mounts[_num_mounts++] = Mount { fs, dir };
+
 			if (!_first_file_system) {
 				_first_file_system = fs;
 				return;
@@ -101,11 +120,50 @@ class Vfs::Dir_file_system : public File_system
 		 */
 		char _name[MAX_NAME_LEN];
 
+		Genode::size_t _name_len = 0;
+
 		/**
 		 * Returns if path corresponds to top directory of file system
 		 */
 		bool _top_dir(char const *path) const {	return strcmp(path, "/") == 0; }
 
+		/**
+		 * Return true if the first element(s) of 'path' equal the directory
+		 * name
+		 *
+		 * \param path  path without leading slash
+		 */
+		bool _matches(char const *path) const
+		{
+			return strcmp(path, _name, _name_len) == 0
+			    && (path[_name_len] == 0 || path[_name_len] == '/');
+		}
+
+		/**
+		 * Call 'fn' for each child file system that may contain 'path'
+		 *
+		 * Children are visited in the order of the configuration until 'fn'
+		 * returns true. For the top directory, all children are visited.
+		 */
+		template <typename FN>
+		void _for_each_mount(char const *path, FN const &fn)
+		{
+			char const * const elem = (path[0] == '/') ? path + 1 : path;
+
+			bool const all = (*elem == 0);
+
+			for (unsigned i = 0; i < _num_mounts; i++) {
+
+				Mount const &m = _mounts[i];
+
+				if (!all && m.dir && !m.dir->_matches(elem))
+					continue;
+
+				if (fn(*m.fs))
+					return;
+			}
+		}
+
 		/**
 		 * Perform operation on a file system
 		 *
@@ -146,17 +204,19 @@ class Vfs::Dir_file_system : public File_system
 			 */
 			RES error = ok;
 
+			bool succeeded = false;
+
 			/*
 			 * The given path refers to at least one of our sub directories.
 			 * Propagate the request into all of our file systems. If at least
 			 * one operation succeeds, we return success.
 			 */
-			for (File_system *fs = _first_file_system; fs; fs = fs->next) {
+			_for_each_mount(path, [&] (File_system &fs) {
 
-				RES const err = fn(*fs, path);
+				RES const err = fn(fs, path);
 
 				if (err == ok)
-					return err;
+					return succeeded = true;
 
 				if (err != no_entry && err != no_perm) {
 					error = err;
@@ -164,7 +224,12 @@ class Vfs::Dir_file_system : public File_system
 
 				if (err == no_perm)
 					permission_denied = true;
-			}
+
+				return false;
+			});
+
+			if (succeeded)
+				return ok;
 
 			/* none of our file systems could successfully operate on the path */
 			return error != ok ? error : permission_denied ? no_perm : no_entry;
@@ -187,20 +252,10 @@ class Vfs::Dir_file_system : public File_system
 			if (path[0] == '/')
 				path++;
 
-			Genode::size_t const name_len = strlen(_name);
-			if (strcmp(path, _name, name_len) != 0)
-				return 0;
-			path += name_len;
-
-			/*
-			 * The first characters of the first path element are equal to
-			 * the current directory name. Let's check if the length of the
-			 * first path element matches the name length.
-			 */
-			if (*path != 0 && *path != '/')
+			if (!_matches(path))
 				return 0;
 
-			return path;
+			return path + _name_len;
 		}
 
 		/*
@@ -210,9 +265,10 @@ class Vfs::Dir_file_system : public File_system
 		file_size _sum_dirents_of_file_systems(char const *path)
 		{
 			file_size cnt = 0;
-			for (File_system *fs = _first_file_system; fs; fs = fs->next) {
-				cnt += fs->num_dirent(path);
-			}
+			_for_each_mount(path, [&] (File_system &fs) {
+				cnt += fs.num_dirent(path);
+				return false;
+			});
 			return cnt;
 		}
 
@@ -304,33 +360,38 @@ class Vfs::Dir_file_system : public File_system
 			return result;
 		}
 
-	public:
-
 		Dir_file_system(Genode::Env         &env,
 		                Genode::Allocator   &alloc,
 		                Genode::Xml_node     node,
 		                Io_response_handler &io_handler,
-		                File_system_factory &fs_factory)
+		                File_system_factory &fs_factory,
+		                bool                 vfs_root)
 		:
-			_vfs_root(false),
+			_vfs_root(vfs_root),
 			_first_file_system(0)
 		{
 			using namespace Genode;
 
 			/* remember directory name */
-			if (node.has_type("fstab") || node.has_type("vfs"))
+			if (vfs_root || node.has_type("fstab") || node.has_type("vfs"))
 				_name[0] = 0;
 			else
 				node.attribute("name").value(_name, sizeof(_name));
 
+			_name_len = strlen(_name);
+
+			if (node.num_sub_nodes())
+				_mounts = new (alloc) Mount[node.num_sub_nodes()];
+
 			for (unsigned i = 0; i < node.num_sub_nodes(); i++) {
 
 				Xml_node sub_node = node.sub_node(i);
 
 				/* traverse into <dir> nodes */
 				if (sub_node.has_type("dir")) {
-					_append_file_system(new (alloc)
-						Dir_file_system(env, alloc, sub_node, io_handler, fs_factory));
+					Dir_file_system *dir = new (alloc)
+						Dir_file_system(env, alloc, sub_node, io_handler, fs_factory);
+					_append_file_system(dir, dir);
 					continue;
 				}
 
@@ -353,6 +414,23 @@ class Vfs::Dir_file_system : public File_system
 			}
 		}
 
+	public:
+
+		Dir_file_system(Genode::Env         &env,
+		                Genode::Allocator   &alloc,
+		                Genode::Xml_node     node,
+		                Io_response_handler &io_handler,
+		                File_system_factory &fs_factory)
+		:
+			Dir_file_system(env, alloc, node, io_handler, fs_factory, false)
+		{ }
+
+		/**
+		 * Constructor for the root of a VFS
+		 *
+		 * The sub nodes of 'node' are merged at the root. In contrast to a
+		 * '<dir>' node, 'node' does not need to have a 'name' attribute.
+		 */
 		Dir_file_system(Genode::Env         &env,
 		                Genode::Allocator   &alloc,
 		                Genode::Xml_node     node,
@@ -360,8 +438,8 @@ class Vfs::Dir_file_system : public File_system
 		                File_system_factory &fs_factory,
 		                Dir_file_system::Root)
 		:
-			Dir_file_system(env, alloc, node, io_handler, fs_factory)
-			{ _vfs_root = true; }
+			Dir_file_system(env, alloc, node, io_handler, fs_factory, true)
+		{ }
 
 		/*********************************
 		 ** Directory-service interface **
@@ -377,14 +455,13 @@ class Vfs::Dir_file_system : public File_system
 			 * Query sub file systems for dataspace using the path local to
 			 * the respective file system
 			 */
-			File_system *fs = _first_file_system;
-			for (; fs; fs = fs->next) {
-				Dataspace_capability ds = fs->dataspace(path);
-				if (ds.valid())
-					return ds;
-			}
+			Dataspace_capability ds;
+			_for_each_mount(path, [&] (File_system &fs) {
+				ds = fs.dataspace(path);
+				return ds.valid();
+			});
 
-			return Dataspace_capability();
+			return ds;
 		}
 
 		void release(char const *path, Dataspace_capability ds_cap) override
@@ -393,8 +470,10 @@ class Vfs::Dir_file_system : public File_system
 			if (!path)
 				return;
 
-			for (File_system *fs = _first_file_system; fs; fs = fs->next)
-				fs->release(path, ds_cap);
+			_for_each_mount(path, [&] (File_system &fs) {
+				fs.release(path, ds_cap);
+				return false;
+			});
 		}
 
 		Stat_result stat(char const *path, Stat &out) override
@@ -421,21 +500,17 @@ class Vfs::Dir_file_system : public File_system
 
 			/*
 			 * The given path refers to one of our sub directories.
-			 * Propagate the request into our file systems.
+			 * Propagate the request into our file systems. If none of our
+			 * file systems feels responsible for the path, the result
+			 * remains 'STAT_ERR_NO_ENTRY'.
 			 */
-			for (File_system *fs = _first_file_system; fs; fs = fs->next) {
+			Stat_result result = STAT_ERR_NO_ENTRY;
+			_for_each_mount(path, [&] (File_system &fs) {
+				result = fs.stat(path, out);
+				return result != STAT_ERR_NO_ENTRY;
+			});
 
-				Stat_result const err = fs->stat(path, out);
-
-				if (err == STAT_OK)
-					return err;
-
-				if (err != STAT_ERR_NO_ENTRY)
-					return err;
-			}
-
-			/* none of our file systems felt responsible for the path */
-			return STAT_ERR_NO_ENTRY;
+			return result;
 		}
 
 		file_size num_dirent(char const *path) override
@@ -480,11 +555,11 @@ class Vfs::Dir_file_system : public File_system
 			if (strlen(path) == 0)
 				return true;
 
-			for (File_system *fs = _first_file_system; fs; fs = fs->next)
-				if (fs->directory(path))
-					return true;
+			bool result = false;
+			_for_each_mount(path, [&] (File_system &fs) {
+				return result = fs.directory(path); });
 
-			return false;
+			return result;
 		}
 
 		/**
@@ -504,13 +579,13 @@ class Vfs::Dir_file_system : public File_system
 			if (strlen(path) == 0)
 				return path;
 
-			for (File_system *fs = _first_file_system; fs; fs = fs->next) {
-				char const *leaf_path = fs->leaf_path(path);
-				if (leaf_path)
-					return leaf_path;
-			}
+			char const *leaf_path = 0;
+			_for_each_mount(path, [&] (File_system &fs) {
+				leaf_path = fs.leaf_path(path);
+				return leaf_path != 0;
+			});
 
-			return 0;
+			return leaf_path;
 		}
 
 		Open_result open(char const  *path,
@@ -546,20 +621,18 @@ class Vfs::Dir_file_system : public File_system
 				return OPEN_OK;
 			}
 
-			/* path refers to any of our sub file systems */
-			for (File_system *fs = _first_file_system; fs; fs = fs->next) {
-
-				Open_result const err = fs->open(path, mode, out_handle, alloc);
-				switch (err) {
-				case OPEN_ERR_UNACCESSIBLE:
-					continue;
-				default:
-					return err;
-				}
-			}
+			/*
+			 * Path refers to any of our sub file systems. If the path does
+			 * not match any existing file or directory, the result remains
+			 * 'OPEN_ERR_UNACCESSIBLE'.
+			 */
+			Open_result result = OPEN_ERR_UNACCESSIBLE;
+			_for_each_mount(path, [&] (File_system &fs) {
+				result = fs.open(path, mode, out_handle, alloc);
+				return result != OPEN_ERR_UNACCESSIBLE;
+			});
 
-			/* path does not match any existing file or directory */
-			return OPEN_ERR_UNACCESSIBLE;
+			return result;
 		}
 
 		/**
@@ -570,24 +643,21 @@ class Vfs::Dir_file_system : public File_system
 		                                   Dir_vfs_handle &dir_vfs_handle)
 		{
 			try {
-				for (File_system *fs = _first_file_system; fs; fs = fs->next) {
+				_for_each_mount(sub_path, [&] (File_system &fs) {
 					Vfs_handle *sub_dir_handle = nullptr;
 
-					Opendir_result r = fs->opendir(
+					Opendir_result r = fs.opendir(
 						sub_path, false, &sub_dir_handle, dir_vfs_handle.alloc());
 
-					switch (r) {
-					case OPENDIR_OK:
-						break;
-					case OPENDIR_ERR_LOOKUP_FAILED:
-					default:
-						continue;
-					}
+					if (r != OPENDIR_OK)
+						return false;
 
 					new (dir_vfs_handle.alloc())
 						Dir_vfs_handle::Subdir_handle_element(
 							dir_vfs_handle.subdir_handle_registry, *sub_dir_handle);
-				}
+
+					return false;
+				});
 			}
 			catch (Genode::Out_of_ram)  { return OPENDIR_ERR_OUT_OF_RAM; }
 			catch (Genode::Out_of_caps) { return OPENDIR_ERR_OUT_OF_CAPS; }
@@ -723,14 +793,15 @@ class Vfs::Dir_file_system : public File_system
 				return RENAME_ERR_CROSS_FS;
 
 			Rename_result final = RENAME_ERR_NO_ENTRY;
-			for (File_system *fs = _first_file_system; fs; fs = fs->next) {
-				switch (fs->rename(from_path, to_path)) {
-				case RENAME_OK:           return RENAME_OK;
-				case RENAME_ERR_NO_ENTRY: continue;
-				case RENAME_ERR_NO_PERM:  return RENAME_ERR_NO_PERM;
+			_for_each_mount(from_path, [&] (File_system &fs) {
+				switch (fs.rename(from_path, to_path)) {
+				case RENAME_OK:           final = RENAME_OK;          return true;
+				case RENAME_ERR_NO_ENTRY:                             return false;
+				case RENAME_ERR_NO_PERM:  final = RENAME_ERR_NO_PERM; return true;
 				case RENAME_ERR_CROSS_FS: final = RENAME_ERR_CROSS_FS;
 				}
-			}
+				return false;
+			});
 			return final;
 		}
 
@@ -21,10 +21,21 @@
 namespace Vfs {
 	class Vfs_handle;
 	struct Io_response_handler;
+	struct Io_vector;
 	struct File_io_service;
 }
 
 
+/**
+ * Segment of a vectored read or write operation
+ */
+struct Vfs::Io_vector
+{
+	char      *base;
+	file_size  size;
+};
+
+
 struct Vfs::Io_response_handler
 {
 	virtual void handle_io_response(Vfs::Vfs_handle::Context *context) = 0;
@@ -54,6 +65,51 @@ struct Vfs::File_io_service
 	                           char const *buf, file_size buf_size,
 	                           file_size &out_count) = 0;
 
+	/**
+	 * Write the segments of 'iov' one after another
+	 *
+	 * Like 'write', the operation starts at the seek offset of the handle
+	 * and leaves the seek offset unchanged. The default implementation
+	 * writes segment by segment.
+	 */
+	virtual Write_result writev(Vfs_handle *vfs_handle,
+	                            Io_vector const *iov, unsigned iovcnt,
+	                            file_size &out_count)
+	{
+		file_size const seek = vfs_handle->seek();
+
+		Write_result result = WRITE_OK;
+		out_count = 0;
+
+		for (unsigned i = 0; i < iovcnt; i++) {
+
+			file_size count = 0;
+			try {
+				result = write(vfs_handle, iov[i].base, iov[i].size, count);
+			} catch (Insufficient_buffer) {
+				vfs_handle->seek(seek);
+
+				/* report the segments written so far */
+				if (out_count) return WRITE_OK;
+				throw;
+			}
+
+			if (result != WRITE_OK) {
+				if (out_count) result = WRITE_OK;
+				break;
+			}
+
+			out_count += count;
+			vfs_handle->advance_seek(count);
+
+			if (count < iov[i].size)
+				break;
+		}
+
+		vfs_handle->seek(seek);
+		return result;
+	}
+
 
 	/**********
 	 ** Read **
@@ -78,6 +134,61 @@ struct Vfs::File_io_service
 	                                  char *dst, file_size count,
 	                                  file_size &out_count) = 0;
 
+	/**
+	 * Complete queued read operation into the segments of 'iov'
+	 *
+	 * The read must have been queued for the total size of all segments.
+	 * The default implementation completes the read segment by segment.
+	 */
+	virtual Read_result complete_readv(Vfs_handle *vfs_handle,
+	                                   Io_vector const *iov, unsigned iovcnt,
+	                                   file_size &out_count)
+	{
+		file_size const seek = vfs_handle->seek();
+
+		Read_result result = READ_OK;
+		out_count = 0;
+
+		for (unsigned i = 0; i < iovcnt; i++) {
+
+			file_size count = 0;
+			result = complete_read(vfs_handle, iov[i].base, iov[i].size, count);
+
+			/* report the segments read so far */
+			if (result != READ_OK) {
+				if (out_count) result = READ_OK;
+				break;
+			}
+
+			out_count += count;
+			vfs_handle->advance_seek(count);
+
+			if (count < iov[i].size)
+				break;
+		}
+
+		vfs_handle->seek(seek);
+		return result;
+	}
+
+	/**
+	 * Complete queued read operation by writing the data to another handle
+	 *
+	 * In contrast to 'complete_read', the data is passed from the buffer
+	 * of the file system directly to the 'write' operation of 'to', which
+	 * saves the copy into and out of an intermediate buffer of the caller.
+	 * Data not accepted by 'to' remains readable. The write error of 'to'
+	 * is reflected by the corresponding read error.
+	 *
+	 * The default implementation returns READ_ERR_INVALID. In this case,
+	 * the caller falls back to 'complete_read' and 'write'.
+	 */
+	virtual Read_result complete_copy(Vfs_handle *from, Vfs_handle *to,
+	                                  file_size count, file_size &out_count)
+	{
+		return READ_ERR_INVALID;
+	}
+
 	/**
 	 * Return true if the handle has readable data
 	 */
@@ -93,6 +204,16 @@ struct Vfs::File_io_service
 	 */
 	virtual bool notify_read_ready(Vfs_handle *) { return true; }
 
+	/**
+	 * Explicitly indicate interest in modifications of a file
+	 *
+	 * Once the file content was changed by another party, the
+	 * 'Io_response_handler' is called with the context of the handle.
+	 *
+	 * \return false if the file system cannot detect modifications
+	 */
+	virtual bool notify_content_changed(Vfs_handle *) { return false; }
+
 
 	/***************
 	 ** Ftruncate **
@@ -1,5 +1,16 @@
-SRC_CC  = blit.cc
+SRC_CC  = blit.cc kernels.cc
 REQUIRES = arm 32bit
-INC_DIR += $(REP_DIR)/src/lib/blit/spec/arm
+INC_DIR += $(REP_DIR)/src/lib/blit/spec/arm \
+           $(REP_DIR)/src/lib/blit
+
+#
+# NEON is featured by the Cortex-A CPUs of all supported ARMv7-A platforms
+#
+ifneq ($(filter arm_v7a,$(SPECS)),)
+SRC_CC             += kernels_neon.cc
+CC_OPT_kernels      = -DBLIT_NEON
+CC_OPT_kernels_neon = -mfpu=neon -mfloat-abi=softfp
+endif
 
 vpath blit.cc $(REP_DIR)/src/lib/blit
+vpath %.cc    $(REP_DIR)/src/lib/blit/spec/arm
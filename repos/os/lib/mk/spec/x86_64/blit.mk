@@ -1,6 +1,13 @@
-SRC_CC  = blit.cc
+SRC_CC  = blit.cc kernels.cc kernels_sse2.cc kernels_avx2.cc
 REQUIRES = x86 64bit
 INC_DIR += $(REP_DIR)/src/lib/blit/spec/x86_64 \
-           $(REP_DIR)/src/lib/blit/spec/x86
+           $(REP_DIR)/src/lib/blit/spec/x86 \
+           $(REP_DIR)/src/lib/blit
+
+#
+# The AVX2 kernels are used only if the CPU supports AVX2
+#
+CC_OPT_kernels_avx2 = -mavx2
 
 vpath blit.cc $(REP_DIR)/src/lib/blit
+vpath %.cc    $(REP_DIR)/src/lib/blit/spec/x86_64
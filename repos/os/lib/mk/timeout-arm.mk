@@ -1,4 +1,5 @@
 SRC_CC += timeout.cc
+SRC_CC += wheel_timeout_scheduler.cc
 SRC_CC += timer_connection.cc
 SRC_CC += arm/timer_connection_time.cc
 SRC_CC += duration.cc
@@ -13,6 +13,7 @@
 
 /* base includes */
 #include <base/component.h>
+#include <base/binary_log.h>
 #include <log_session/connection.h>
 
 /* os includes */
@@ -90,12 +91,81 @@ class Log
 		void log() { _rom_to_log(end_pos()); }
 };
 
+/**
+ * Formatter of the records of core's binary log
+ */
+class Binary_log_reader
+{
+	private:
+
+		typedef Genode::Binary_log Binary_log;
+
+		Genode::Attached_rom_dataspace _rom_ds;
+		Genode::Log_connection         _log;
+
+		unsigned _next = 0;
+
+		Binary_log const &_binary_log() const {
+			return *_rom_ds.local_addr<Binary_log const>(); }
+
+		void _write(char const *line) {
+			_log.write(Genode::Log_session::String(line)); }
+
+	public:
+
+		Binary_log_reader(Genode::Env &env, char const * const rom_name,
+		                  char const * const log_name)
+		: _rom_ds(env, rom_name), _log(env, log_name) { }
+
+		void log()
+		{
+			Binary_log const &binary_log = _binary_log();
+			if (!binary_log.valid())
+				return;
+
+			unsigned const num = binary_log.num_records();
+
+			/* skip records overwritten since the last check */
+			unsigned const next_record = binary_log.next_record();
+			if (next_record - _next > num) {
+				unsigned const lost = next_record - num - _next;
+				_write(Genode::String<64>(lost, " records lost\n").string());
+				_next = next_record - num;
+			}
+
+			for (; _next != binary_log.next_record(); _next++) {
+
+				Binary_log::Record r;
+				int const result = binary_log.fetch(_next, r);
+
+				/* record is still being written */
+				if (result < 0)
+					break;
+
+				if (result > 0) {
+					_write("record lost\n");
+					continue;
+				}
+
+				char text[Genode::Log_session::MAX_STRING_LEN];
+				binary_log.format(r, text, sizeof(text));
+
+				_write(Genode::String<Genode::Log_session::MAX_STRING_LEN>(
+					"[", r.timestamp, "] ", Genode::Cstring(text), "\n").string());
+			}
+		}
+};
+
+
 struct Monitor
 {
 	Genode::Env &env;
 
 	Log output { env, "log", "log" };
 
+	/* the binary log is not available on all kernels */
+	Genode::Constructible<Binary_log_reader> binary_output { };
+
 	Timer::Connection timer { env };
 
 	Genode::Signal_handler<Monitor> interval { env.ep(), *this, &Monitor::check };
@@ -111,6 +181,9 @@ struct Monitor
 			period_ms = config.xml().attribute_value("period_ms", 1000UL);
 		} catch (...) { }
 
+		try { binary_output.construct(env, "binary_log", "binary"); }
+		catch (...) { Genode::warning("core binary log not available"); }
+
 		Genode::log("update every ", period_ms," ms");
 
 		timer.trigger_periodic(1000UL * period_ms);
@@ -119,6 +192,9 @@ struct Monitor
 	void check()
 	{
 		output.log();
+
+		if (binary_output.constructed())
+			binary_output->log();
 	}
 };
 
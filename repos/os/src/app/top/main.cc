@@ -240,6 +240,11 @@ struct App::Main
 
 	Trace_subject_registry _trace_subject_registry;
 
+	/* frame statistics as reported by nitpicker */
+	Constructible<Attached_rom_dataspace> _frames { };
+
+	void _show_frames();
+
 	void _handle_config();
 
 	Signal_handler<Main> _config_handler = {
@@ -268,6 +273,14 @@ void App::Main::_handle_config()
 
 	log("period_ms=", _period_ms);
 
+	bool const show_frames = _config.xml().attribute_value("frames", false);
+
+	if (show_frames && !_frames.constructed())
+		_frames.construct(_env, "frames");
+
+	if (!show_frames && _frames.constructed())
+		_frames.destruct();
+
 	_timer.trigger_periodic(1000*_period_ms);
 }
 
@@ -279,6 +292,46 @@ void App::Main::_handle_period()
 
 	/* show most significant consumers */
 	_trace_subject_registry.top();
+
+	/* show compositing statistics */
+	_show_frames();
+}
+
+
+void App::Main::_show_frames()
+{
+	if (!_frames.constructed())
+		return;
+
+	_frames->update();
+
+	Xml_node const frames = _frames->xml();
+
+	if (!frames.has_type("frames"))
+		return;
+
+	typedef String<48> Text;
+
+	auto duration = [&] (char const *type)
+	{
+		if (!frames.has_sub_node(type))
+			return Text("-");
+
+		Xml_node const node = frames.sub_node(type);
+		return Text(node.attribute_value("avg_us", 0UL), "/",
+		            node.attribute_value("max_us", 0UL), "us");
+	};
+
+	log("frames: fps=",  frames.attribute_value("fps", 0UL), " "
+	    "pixels=",       frames.attribute_value("pixels_per_frame", 0UL), " "
+	    "draw=",         duration("draw"),    " "
+	    "latency=",      duration("latency"), " "
+	    "input=",        duration("input"),   " "
+	    "flip=",         duration("flip"));
+
+	frames.for_each_sub_node("session", [&] (Xml_node session) {
+		log("frames: refresh_rate=", session.attribute_value("refresh_rate", 0UL),
+		    " label='", session.attribute_value("label", String<160>()), "'"); });
 }
 
 
@@ -35,13 +35,20 @@ struct Trace_subject_registry
 			 */
 			unsigned long long recent_execution_time = 0;
 
+			/**
+			 * Wake-ups during the last period
+			 */
+			unsigned long recent_wakeups = 0;
+
 			Entry(Genode::Trace::Subject_id id) : id(id) { }
 
 			void update(Genode::Trace::Subject_info const &new_info)
 			{
 				unsigned long long const last_execution_time = info.execution_time().value;
+				unsigned long      const last_wakeups        = info.wakeups();
 				info = new_info;
 				recent_execution_time = info.execution_time().value - last_execution_time;
+				recent_wakeups        = info.wakeups() - last_wakeups;
 			}
 		};
 
@@ -110,7 +117,7 @@ struct Trace_subject_registry
 			_sort_by_recent_execution_time();
 		}
 
-		void report(Genode::Xml_generator &xml,
+		void report(Genode::Xml_generator &xml, unsigned long period_ms,
 		            bool report_affinity, bool report_activity)
 		{
 			for (Entry const *e = _entries.first(); e; e = e->next()) {
@@ -127,12 +134,17 @@ struct Trace_subject_registry
 						xml.node("activity", [&] () {
 							xml.attribute("total", e->info.execution_time().value);
 							xml.attribute("recent", e->recent_execution_time);
+							if (e->info.wakeups() && period_ms)
+								xml.attribute("wakeups_per_s",
+								              e->recent_wakeups*1000/period_ms);
 						});
 
 					if (report_affinity)
 						xml.node("affinity", [&] () {
 							xml.attribute("xpos", e->info.affinity().xpos());
 							xml.attribute("ypos", e->info.affinity().ypos());
+							if (e->info.migrations())
+								xml.attribute("migrations", e->info.migrations());
 						});
 				});
 			}
@@ -225,7 +237,8 @@ void App::Main::_handle_period()
 	_reporter.clear();
 	Genode::Reporter::Xml_generator xml(_reporter, [&] ()
 	{
-		_trace_subject_registry.report(xml, _report_affinity, _report_activity);
+		_trace_subject_registry.report(xml, _period_ms, _report_affinity,
+		                               _report_activity);
 	});
 }
 
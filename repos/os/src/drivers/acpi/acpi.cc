@@ -517,6 +517,7 @@ class Element : public List<Element>::Element
 		bool               _valid;    /* true if this is a valid element */
 		bool               _routed;   /* has the PCI information been read */
 		List<Pci_routing>  _pci;      /* list of PCI routing elements for this element */
+		Element           *_hash_next = nullptr; /* next element of name-hash bucket */
 
 		/* packages we are looking for */
 		enum { DEVICE = 0x5b, SUB_DEVICE = 0x82, DEVICE_NAME = 0x8, SCOPE = 0x10, METHOD = 0x14, PACKAGE_OP = 0x12 };
@@ -527,6 +528,34 @@ class Element : public List<Element>::Element
 		/* default signature length of ACPI elements */
 		enum { NAME_LEN = 4 };
 
+		/* buckets of the name index */
+		enum { HASH_SIZE = 1024 };
+
+		/**
+		 * Index of listed elements by absolute name
+		 *
+		 * Looking up names via a linear scan of the element list becomes
+		 * quadratic in the number of devices of large DSDTs.
+		 */
+		static Element **_hash_table()
+		{
+			static Element *_table[HASH_SIZE];
+			return _table;
+		}
+
+		static unsigned _hash(char const *name, size_t len)
+		{
+			/* FNV-1a */
+			uint32_t h = 2166136261u;
+			for (size_t i = 0; i < len; i++)
+				h = (h ^ (uint8_t)name[i]) * 16777619u;
+
+			return h & (HASH_SIZE - 1);
+		}
+
+		Element *&_bucket() {
+			return _hash_table()[_hash(_name, min(sizeof(_name), (size_t)_name_len))]; }
+
 		/* ComputationalData - ACPI 19.2.3 */
 		enum { BYTE_PREFIX = 0xa, WORD_PREFIX = 0xb, DWORD_PREFIX = 0xc, QWORD_PREFIX=0xe };
 
@@ -704,22 +733,23 @@ class Element : public List<Element>::Element
 		 */
 		Element *_compare(char const *sub_string, uint32_t skip = 0)
 		{
-			size_t sub_len = strlen(sub_string);
+			size_t const sub_len = strlen(sub_string);
 
-			Element *other = list()->first();
-			while (other) {
+			if (skip > _name_len || _name_len - skip + sub_len > sizeof(_name))
+				return 0;
 
-				if ((other->_name_len == _name_len + sub_len - skip) &&
+			char name[sizeof(_name)];
+			memcpy(name, _name, _name_len - skip);
+			memcpy(name + _name_len - skip, sub_string, sub_len);
 
-				    /* compare our part */
-				    !(memcmp(other->_name, _name, _name_len - skip)) &&
+			size_t const len = _name_len - skip + sub_len;
 
-				    /* compare other part */
-				    !memcmp(other->_name + _name_len - skip, sub_string, sub_len))
+			/* buckets are ordered like the element list, newest first */
+			for (Element *other = _hash_table()[_hash(name, len)]; other;
+			     other = other->_hash_next)
+				if (other->_name_len == len && !memcmp(other->_name, name, len))
 					return other;
 
-				other = other->next();
-			}
 			return 0;
 		}
 
@@ -937,6 +967,29 @@ class Element : public List<Element>::Element
 			_pci      = other._pci;
 		}
 
+		/**
+		 * Add element to list and name index
+		 */
+		void _insert()
+		{
+			list()->insert(this);
+
+			Element *&bucket = _bucket();
+			_hash_next = bucket;
+			bucket     = this;
+		}
+
+		void _remove()
+		{
+			list()->remove(this);
+
+			for (Element **e = &_bucket(); *e; e = &(*e)->_hash_next)
+				if (*e == this) {
+					*e = _hash_next;
+					break;
+				}
+		}
+
 		bool is_device_name() { return _type == DEVICE_NAME; }
 
 		/**
@@ -1004,7 +1057,7 @@ class Element : public List<Element>::Element
 				freed_up += sizeof(*element) + element->_name ? element->_name_len : 0;
 
 				Element * next = element->next();
-				Element::list()->remove(element);
+				element->_remove();
 				destroy(&alloc, element);
 				element = next;
 			}
@@ -1034,7 +1087,7 @@ class Element : public List<Element>::Element
 					break;
 
 				Element *i = new (&alloc) Element(e);
-				list()->insert(i);
+				i->_insert();
 
 				/* skip header */
 				data += e.size_len();
@@ -1324,6 +1377,9 @@ void Acpi::generate_report(Genode::Env &env, Genode::Allocator &alloc)
 	static Reporter acpi(env, "acpi", "acpi", REPORT_SIZE);
 	acpi.enabled(true);
 
+	/* machines with many PCI devices exceed the initial report size */
+	acpi.expanding(true);
+
 	Genode::Reporter::Xml_generator xml(acpi, [&] () {
 		if (!(!Fadt::features && !Fadt::reset_type &&
 		      !Fadt::reset_addr && !Fadt::reset_value))
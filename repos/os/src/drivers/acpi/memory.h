@@ -32,8 +32,8 @@ class Acpi::Memory
 				Genode::Io_mem_connection _io_mem;
 
 			public:
-				Io_mem(Genode::Env &env, Genode::addr_t phys)
-				: _io_mem(env, phys, 0x1000UL) { }
+				Io_mem(Genode::Env &env, Genode::addr_t phys, Genode::size_t size)
+				: _io_mem(env, phys, size) { }
 
 				Genode::Io_mem_dataspace_capability dataspace()
 				{
@@ -50,6 +50,36 @@ class Acpi::Memory
 		Genode::Allocator_avl     _range;
 		Genode::List<Io_mem>      _io_mem_list;
 
+		void _attach(Genode::addr_t phys, Genode::addr_t low, Genode::size_t size)
+		{
+			/* allocate acpi pages as io memory */
+			Io_mem *mem = new (_heap) Io_mem(_env, phys, size);
+			/* attach acpi pages to this process */
+			try { _rm_acpi.attach_at(mem->dataspace(), low, size); }
+			catch (...) { destroy(_heap, mem); throw; }
+			/* add to list to free when parsing acpi table is done */
+			_io_mem_list.insert(mem);
+		}
+
+		/**
+		 * Map 'size' bytes at 'phys' to the ACPI region at offset 'low'
+		 *
+		 * If core denies the whole range, e.g., because it covers pages
+		 * of different memory types, the pages are mapped one by one.
+		 */
+		void _map(Genode::addr_t phys, Genode::addr_t low, Genode::size_t size)
+		{
+			if (size > 0x1000UL) {
+				try {
+					_attach(phys, low, size);
+					return;
+				} catch (...) { }
+			}
+
+			for (Genode::addr_t off = 0; off < size; off += 0x1000UL)
+				_attach(phys + off, low + off, 0x1000UL);
+		}
+
 	public:
 
 		Memory(Genode::Env &env, Genode::Allocator &heap)
@@ -84,18 +114,23 @@ class Acpi::Memory
 			addr_t const phys_aligned = phys & _align_mask(12);
 			addr_t const size_aligned = align_addr(p_size + (phys & _align_offset(12)), 12);
 
-			for (addr_t size = 0; size < size_aligned; size += 0x1000UL) {
+			/*
+			 * Map each run of not yet mapped pages via a single I/O memory
+			 * session instead of one session per page
+			 */
+			for (addr_t size = 0; size < size_aligned; ) {
 				addr_t const low = (phys_aligned + size) &
 				                     _align_offset(ACPI_REGION_SIZE_LOG2);
-				if (!_range.alloc_addr(0x1000UL, low).ok())
-					continue;
-
-				/* allocate acpi page as io memory */
-				Io_mem *mem = new (_heap) Io_mem(_env, phys_aligned + size);
-				/* attach acpi page to this process */
-				_rm_acpi.attach_at(mem->dataspace(), low, 0x1000UL);
-				/* add to list to free when parsing acpi table is done */
-				_io_mem_list.insert(mem);
+
+				addr_t run = 0;
+				while (size + run < size_aligned &&
+				       _range.alloc_addr(0x1000UL, low + run).ok())
+					run += 0x1000UL;
+
+				if (run)
+					_map(phys_aligned + size, low, run);
+
+				size += run ? run : 0x1000UL;
 			}
 
 			return _acpi_base + (phys & _align_offset(ACPI_REGION_SIZE_LOG2));
@@ -243,6 +243,25 @@ struct Command_fis : Genode::Mmio
 		write<Sector0_7::Tag>(slot);
 	}
 
+	void flush_cache_ext()
+	{
+		write<Bits::C>(1);
+		write<Device::Lba>(1);
+		write<Command>(0xea);
+	}
+
+	/**
+	 * Data set management with TRIM, 'blocks' of 512-byte range entries
+	 */
+	void dsm_trim(Genode::size_t blocks)
+	{
+		write<Bits::C>(1);
+		write<Device::Lba>(1);
+		write<Command>(0x06);
+		write<Features>(1);
+		write<Sector>(blocks);
+	}
+
 	void atapi()
 	{
 		write<Bits::C>(1);
@@ -287,6 +306,11 @@ struct Command_header : Genode::Mmio
 		write<Prdbc>(0);
 	}
 
+	void prd_count(unsigned count)
+	{
+		write<Prdtl>(count);
+	}
+
 	void atapi_command()
 	{
 		write<Bits::A>(1);
@@ -361,6 +385,8 @@ struct Prdt : Genode::Mmio
 		struct Irq : Bitfield<31,1>  { }; /* interrupt completion */
 	};
 
+	enum { MAX_BYTES = 4 * 1024 * 1024 };
+
 	Prdt(Genode::addr_t base, Genode::addr_t phys, Genode::size_t bytes)
 	: Mmio(base)
 	{
@@ -376,10 +402,13 @@ struct Prdt : Genode::Mmio
 
 struct Command_table
 {
+	/* scatter-gather packets use up to one PRD per segment */
+	enum { MAX_PRDS = Block::Sg_table::MAX_SEGMENTS };
+
 	Command_fis   fis;
 	Atapi_command atapi_cmd;
 
-	/* in Genode we only need one PRD (for one packet) */
+	/* first PRD, sufficient for contiguous packets */
 	Prdt            prdt;
 
 	Command_table(Genode::addr_t base,
@@ -389,7 +418,16 @@ struct Command_table
 	  prdt(base + 0x80, phys, bytes)
 	{ }
 
-	static constexpr Genode::size_t size() { return 0x100; }
+	/**
+	 * Setup PRD with index 'i', the first one is set up by the constructor
+	 */
+	void prd(unsigned i, Genode::addr_t phys, Genode::size_t bytes)
+	{
+		Prdt(fis.base() + 0x80 + i * Prdt::size(), phys, bytes);
+	}
+
+	static constexpr Genode::size_t size() {
+		return 0x80 + MAX_PRDS * Prdt::size(); }
 };
 
 
@@ -843,7 +881,7 @@ struct Port_driver : Port, Block::Driver
 	void sanity_check(Block::sector_t block_number, Genode::size_t count)
 	{
 		/* max. PRDT size is 4MB */
-		if (count * block_size() > 4 * 1024 * 1024) {
+		if (count * block_size() > Prdt::MAX_BYTES) {
 			Genode::error("error: maximum supported packet size is 4MB");
 			throw Io_error();
 		}
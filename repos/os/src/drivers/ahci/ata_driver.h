@@ -42,6 +42,14 @@ struct Identity : Genode::Mmio
 
 	struct Sector_count : Register<0xc8, 64> { };
 
+	/* max. number of 512-byte blocks of DSM range entries */
+	struct Dsm_max_blocks : Register<0xd2, 16> { };
+
+	struct Dsm_caps : Register<0x152, 16>
+	{
+		struct Trim : Bitfield<0, 1> { };
+	};
+
 	struct Logical_block  : Register<0xd4, 16>
 	{
 		struct Per_physical : Bitfield<0,  3> { }; /* 2^X logical per physical */
@@ -188,6 +196,19 @@ struct Ata_driver : Port_driver
 
 	Io_command                               *io_cmd = nullptr;
 	Block::Packet_descriptor                  pending[32];
+	unsigned                                  busy = 0;  /* slots in use */
+
+	/*
+	 * Non-queued commands like flushes and discards must not overlap with
+	 * any other command
+	 */
+	bool                                      exclusive = false;
+
+	/* DMA buffer for the range entries of discard requests */
+	enum { DSM_BUF_SIZE = 0x1000, DSM_BLOCK_SIZE = 512, DSM_ENTRY_MAX = 0xffff };
+	Genode::Ram_dataspace_capability          dsm_ds;
+	Genode::uint64_t                         *dsm_buf  = nullptr;
+	addr_t                                    dsm_phys = 0;
 
 	Signal_context_capability device_identified;
 
@@ -211,23 +232,32 @@ struct Ata_driver : Port_driver
 	{
 		if (io_cmd)
 			destroy(&alloc, io_cmd);
-	}
-
-	unsigned find_free_cmd_slot()
-	{
-		for (unsigned slot = 0; slot < cmd_slots; slot++)
-			if (!pending[slot].size())
-				return slot;
 
-		throw Block::Driver::Request_congestion();
+		if (dsm_ds.valid()) {
+			rm.detach((void *)dsm_buf);
+			platform_hba.free_dma_buffer(dsm_ds);
+		}
 	}
 
 	void ack_packets()
 	{
 		unsigned slots =  Port::read<Ci>() | Port::read<Sact>();
 
+		/*
+		 * Collect the finished slots before acknowledging any packet because
+		 * the acknowledgement may already issue new commands.
+		 */
+		unsigned done = 0;
+		for (unsigned slot = 0; slot < cmd_slots; slot++)
+			if (!(slots & (1U << slot)) && (busy & (1U << slot)))
+				done |= 1U << slot;
+
+		busy &= ~done;
+		if (!busy)
+			exclusive = false;
+
 		for (unsigned slot = 0; slot < cmd_slots; slot++) {
-			if ((slots & (1U << slot)) || !pending[slot].size())
+			if (!(done & (1U << slot)))
 				continue;
 
 			Block::Packet_descriptor p = pending[slot];
@@ -242,7 +272,7 @@ struct Ata_driver : Port_driver
 		Block::sector_t end = block_number + count - 1;
 
 		for (unsigned slot = 0; slot < cmd_slots; slot++) {
-			if (!pending[slot].size())
+			if (!(busy & (1U << slot)) || !pending[slot].size())
 				continue;
 
 			Block::sector_t pending_start = pending[slot].block_number();
@@ -262,20 +292,59 @@ struct Ata_driver : Port_driver
 		}
 	}
 
-	void io(bool                      read,
-	        Block::sector_t           block_number,
-	        size_t                    count,
-	        addr_t                    phys,
-	        Block::Packet_descriptor &packet)
+	/**
+	 * Check scatter-gather request, each segment is described by one PRD
+	 */
+	void sg_sanity_check(Block::Request const &request)
 	{
-		sanity_check(block_number, count);
+		Block::Packet_descriptor const &p = request.packet;
+
+		bool segment_too_large = false;
+		request.for_each_segment([&] (addr_t, char *, size_t size) {
+			if (size > Prdt::MAX_BYTES) segment_too_large = true; });
+
+		if (segment_too_large || p.block_count() > 0xffff) {
+			Genode::error("error: scatter-gather segment or request too large");
+			throw Io_error();
+		}
+
+		if (p.block_number() + p.block_count() > block_count()) {
+			Genode::error("error: requested blocks are outside of device");
+			throw Io_error();
+		}
+	}
+
+	void io(bool read, Block::Request &request)
+	{
+		Block::Packet_descriptor &packet = request.packet;
+
+		Block::sector_t const block_number = packet.block_number();
+		size_t          const count        = packet.block_count();
+		unsigned        const slot         = request.tag;
+
+		if (packet.scatter_gather())
+			sg_sanity_check(request);
+		else
+			sanity_check(block_number, count);
+
 		overlap_check(block_number, count);
 
-		unsigned slot = find_free_cmd_slot();
+		if (exclusive || slot >= cmd_slots || (busy & (1U << slot)))
+			throw Block::Driver::Request_congestion();
+
 		pending[slot] = packet;
+		busy         |= 1U << slot;
 
-		/* setup fis */
-		Command_table table(command_table_addr(slot), phys, count * block_size());
+		/* setup fis and one PRD per segment */
+		Command_table table(command_table_addr(slot), request.phys,
+		                    count * block_size());
+
+		unsigned prds = 1;
+		if (packet.scatter_gather()) {
+			prds = 0;
+			request.for_each_segment([&] (addr_t phys, char *, size_t size) {
+				table.prd(prds++, phys, size); });
+		}
 
 		/* set ATA command */
 		io_cmd->command(*this, table, read, block_number, count, slot);
@@ -283,11 +352,87 @@ struct Ata_driver : Port_driver
 		/* set or clear write flag in command header */
 		Command_header header(command_header_addr(slot));
 		header.write<Command_header::Bits::W>(read ? 0 : 1);
+		header.prd_count(prds);
 		header.clear_byte_count();
 
 		execute(slot);
 	}
 
+	/**
+	 * Issue non-queued command once the device is idle
+	 */
+	template <typename FUNC>
+	void non_queued(Block::Packet_descriptor &packet, unsigned slot,
+	                FUNC const &setup)
+	{
+		if (busy || slot >= cmd_slots)
+			throw Block::Driver::Request_congestion();
+
+		setup(command_table_addr(slot), command_header_addr(slot));
+
+		pending[slot] = packet;
+		busy          = 1U << slot;
+		exclusive     = true;
+
+		execute(slot);
+	}
+
+	void flush(Block::Packet_descriptor &packet, unsigned slot)
+	{
+		non_queued(packet, slot, [&] (addr_t table_addr, addr_t header_addr) {
+			Command_table table(table_addr, 0, 0);
+			table.fis.flush_cache_ext();
+
+			Command_header header(header_addr);
+			header.write<Command_header::Bits::W>(0);
+			header.prd_count(1);
+			header.clear_byte_count();
+		});
+	}
+
+	void discard(Block::sector_t           block_number,
+	             size_t                    count,
+	             Block::Packet_descriptor &packet,
+	             unsigned                  slot)
+	{
+		if (!trim_support() || block_number + count > block_count())
+			throw Io_error();
+
+		/* each range entry covers up to 0xffff blocks */
+		size_t const entries = (count + DSM_ENTRY_MAX - 1) / DSM_ENTRY_MAX;
+		size_t const max_blocks =
+			min((size_t)DSM_BUF_SIZE / DSM_BLOCK_SIZE,
+			    max((size_t)1, (size_t)info->read<Identity::Dsm_max_blocks>()));
+		size_t const blocks =
+			(entries * sizeof(Genode::uint64_t) + DSM_BLOCK_SIZE - 1) / DSM_BLOCK_SIZE;
+
+		if (blocks > max_blocks) {
+			Genode::error("discard of ", count, " blocks exceeds device limit");
+			throw Io_error();
+		}
+
+		non_queued(packet, slot, [&] (addr_t table_addr, addr_t header_addr) {
+
+			/* range entry: LBA in bits 0-47, number of blocks in bits 48-63 */
+			Genode::memset(dsm_buf, 0, blocks * DSM_BLOCK_SIZE);
+			Block::sector_t lba = block_number;
+			for (size_t i = 0, left = count; left; i++) {
+				size_t const n = min(left, (size_t)DSM_ENTRY_MAX);
+				dsm_buf[i] = (Genode::uint64_t)lba | ((Genode::uint64_t)n << 48);
+				lba  += n;
+				left -= n;
+			}
+
+			Command_table table(table_addr, dsm_phys, blocks * DSM_BLOCK_SIZE);
+			table.fis.dsm_trim(blocks);
+
+			Command_header header(header_addr);
+			header.write<Command_header::Bits::W>(1);
+			header.prd_count(1);
+			header.clear_byte_count();
+		});
+	}
+
 
 	/*****************
 	 ** Port_driver **
@@ -329,6 +474,11 @@ struct Ata_driver : Port_driver
 		case READY:
 
 			io_cmd->handle_irq(*this, status);
+
+			/* non-queued commands complete with a register FIS */
+			if (exclusive && Port::Is::Dhrs::get(status))
+				ack_irq();
+
 			ack_packets();
 
 		default:
@@ -343,6 +493,11 @@ struct Ata_driver : Port_driver
 		return info->read<Identity::Sata_caps::Ncq_support>() && hba.ncq();
 	}
 
+	bool trim_support()
+	{
+		return info->read<Identity::Dsm_caps::Trim>();
+	}
+
 	void check_device()
 	{
 		cmd_slots = min((int)cmd_slots,
@@ -352,6 +507,12 @@ struct Ata_driver : Port_driver
 		if (!ncq_support())
 			cmd_slots = 1;
 
+		if (trim_support()) {
+			dsm_ds   = platform_hba.alloc_dma_buffer(DSM_BUF_SIZE);
+			dsm_buf  = rm.attach(dsm_ds);
+			dsm_phys = (addr_t)Dataspace_client(dsm_ds).phys_addr();
+		}
+
 		state = READY;
 		state_change();
 	}
@@ -378,23 +539,39 @@ struct Ata_driver : Port_driver
 		Block::Session::Operations o;
 		o.set_operation(Block::Packet_descriptor::READ);
 		o.set_operation(Block::Packet_descriptor::WRITE);
+		if (trim_support())
+			o.set_operation(Block::Packet_descriptor::DISCARD);
 		return o;
 	}
 
-	void read_dma(Block::sector_t           block_number,
-	              size_t                    block_count,
-	              addr_t                    phys,
-	              Block::Packet_descriptor &packet) override
-	{
-		io(true, block_number, block_count, phys, packet);
-	}
+	unsigned command_slots() override { return cmd_slots; }
 
-	void write_dma(Block::sector_t           block_number,
-	               size_t                    block_count,
-	               addr_t                    phys,
-	               Block::Packet_descriptor &packet) override
+	bool scatter_gather() override { return true; }
+
+	/*
+	 * The tag of the request serves as command slot. With NCQ, all slots
+	 * of the device can be in flight at the same time.
+	 */
+	void submit(Block::Request &request) override
 	{
-		io(false, block_number, block_count, phys, packet);
+		Block::Packet_descriptor &p = request.packet;
+
+		switch (p.operation()) {
+		case Block::Packet_descriptor::READ:
+			io(true, request);
+			return;
+		case Block::Packet_descriptor::WRITE:
+			io(false, request);
+			return;
+		case Block::Packet_descriptor::DISCARD:
+			discard(p.block_number(), p.block_count(), p, request.tag);
+			return;
+		case Block::Packet_descriptor::FLUSH:
+			flush(p, request.tag);
+			return;
+		default:
+			throw Io_error();
+		}
 	}
 
 	Genode::size_t block_size() override
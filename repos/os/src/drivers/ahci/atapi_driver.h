@@ -182,6 +182,8 @@ struct Atapi_driver : Port_driver
 		return host_to_big_endian(((unsigned *)device_info)[0]) + 1;
 	}
 
+	unsigned command_slots() override { return 1; }
+
 	void read_dma(Block::sector_t           block_number,
 	              size_t                    count,
 	              addr_t                    phys,
@@ -195,7 +195,8 @@ struct Framebuffer::Main
 	Io_mem_connection _sys_mem  { _env, SP810_PHYS, SP810_SIZE };
 	void *            _sys_base { _env.rm().attach(_sys_mem.dataspace()) };
 
-	Dataspace_capability _fb_ds_cap  { _env.ram().alloc(Framebuffer::FRAMEBUFFER_SIZE) };
+	Dataspace_capability _fb_ds_cap  { _env.ram().alloc(Framebuffer::FRAMEBUFFER_SIZE,
+	                                                    WRITE_COMBINED) };
 	Session_component    _fb_session { _env, _lcd_base, _sys_base, _fb_ds_cap };
 	Static_root<Session> _fb_root    { _ep.manage(_fb_session) };
 
@@ -67,7 +67,7 @@ class Framebuffer::Session_component : public Genode::Rpc_object<Framebuffer::Se
 		                  size_t size, size_t width, size_t height,
 		                  bool buffered)
 		:
-			_width(width), _height(height), _fb_mem(env, phys_addr, size),
+			_width(width), _height(height), _fb_mem(env, phys_addr, size, true),
 			_timer(env)
 		{
 			if (buffered) {
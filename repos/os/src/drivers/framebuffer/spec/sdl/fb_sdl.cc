@@ -41,28 +41,89 @@ class Framebuffer::Session_component : public Rpc_object<Session>
 {
 	private:
 
+		enum { NONE = ~0U };
+
 		SDL_Surface *_screen { nullptr };
 
 		Mode                  _mode;
 		Dataspace_capability  _fb_ds_cap;
 		void                 *_fb_ds_addr;
+		unsigned const        _buffers;
 
 		Timer::Connection _timer;
 
+		Signal_context_capability _sync_sigh { };
+		Signal_context_capability _flip_sigh { };
+
+		/*
+		 * The periodic timer emulates the vertical blank, at which a
+		 * pending flip takes effect.
+		 */
+		bool _vblank_started = false;
+
+		unsigned _front   = 0;
+		unsigned _pending = NONE;
+
+		struct Area { int x, y, w, h; } _flip_area { 0, 0, 0, 0 };
+
+		void _handle_vblank()
+		{
+			if (_pending != NONE) {
+				_front   = _pending;
+				_pending = NONE;
+
+				refresh(_flip_area.x, _flip_area.y, _flip_area.w, _flip_area.h);
+
+				if (_flip_sigh.valid())
+					Signal_transmitter(_flip_sigh).submit();
+			}
+
+			if (_sync_sigh.valid())
+				Signal_transmitter(_sync_sigh).submit();
+		}
+
+		Signal_handler<Session_component> _vblank_handler;
+
+		void _start_vblank()
+		{
+			if (_vblank_started)
+				return;
+
+			_timer.sigh(_vblank_handler);
+			_timer.trigger_periodic(100000000 / 5994); /* 59.94Hz */
+			_vblank_started = true;
+		}
+
+		char *_buffer(unsigned i)
+		{
+			return (char *)_fb_ds_addr
+			     + i*_mode.width()*_mode.height()*_mode.bytes_per_pixel();
+		}
+
 	public:
 
 		/**
 		 * Constructor
+		 *
+		 * \param buffers  number of frames within the dataspace
 		 */
 		Session_component(Env &env, Framebuffer::Mode mode,
-		                  Dataspace_capability fb_ds_cap, void *fb_ds_addr)
+		                  Dataspace_capability fb_ds_cap, void *fb_ds_addr,
+		                  unsigned buffers)
 		:
-			_mode(mode), _fb_ds_cap(fb_ds_cap), _fb_ds_addr(fb_ds_addr), _timer(env)
+			_mode(mode), _fb_ds_cap(fb_ds_cap), _fb_ds_addr(fb_ds_addr),
+			_buffers(buffers), _timer(env),
+			_vblank_handler(env.ep(), *this, &Session_component::_handle_vblank)
 		{ }
 
 		void screen(SDL_Surface *screen) { _screen = screen; }
 
-		Dataspace_capability dataspace() override { return _fb_ds_cap; }
+		Dataspace_capability dataspace() override
+		{
+			_front   = 0;
+			_pending = NONE;
+			return _fb_ds_cap;
+		}
 
 		Mode mode() const override { return _mode; }
 
@@ -70,9 +131,9 @@ class Framebuffer::Session_component : public Rpc_object<Session>
 
 		void sync_sigh(Signal_context_capability sigh) override
 		{
-			_timer.sigh(sigh);
+			_sync_sigh = sigh;
 			if (sigh.valid())
-				_timer.trigger_periodic(100000000 / 5994); /* 59.94Hz */
+				_start_vblank();
 		}
 
 		void refresh(int x, int y, int w, int h) override
@@ -85,12 +146,12 @@ class Framebuffer::Session_component : public Rpc_object<Session>
 
 			if (x1 <= x2 && y1 <= y2) {
 
-				/* copy pixels from shared dataspace to sdl surface */
+				/* copy pixels from the displayed buffer to sdl surface */
 				const int start_offset = _mode.bytes_per_pixel()*(y1*_mode.width() + x1);
 				const int line_len     = _mode.bytes_per_pixel()*(x2 - x1 + 1);
 				const int pitch        = _mode.bytes_per_pixel()*_mode.width();
 
-				char *src = (char *)_fb_ds_addr     + start_offset;
+				char *src = _buffer(_front)       + start_offset;
 				char *dst = (char *)_screen->pixels + start_offset;
 
 				for (int i = y1; i <= y2; i++, src += pitch, dst += pitch)
@@ -100,6 +161,24 @@ class Framebuffer::Session_component : public Rpc_object<Session>
 				SDL_UpdateRect(_screen, x1, y1, x2 - x1 + 1, y2 - y1 + 1);
 			}
 		}
+
+		unsigned buffers() const override { return _buffers; }
+
+		void flip(unsigned buffer, int x, int y, int w, int h) override
+		{
+			if (buffer >= _buffers)
+				return;
+
+			_pending   = buffer;
+			_flip_area = { x, y, w, h };
+
+			_start_vblank();
+		}
+
+		void flip_sigh(Signal_context_capability sigh) override
+		{
+			_flip_sigh = sigh;
+		}
 };
 
 
@@ -150,10 +229,18 @@ struct Fb_sdl::Main
 
 	Framebuffer::Mode _fb_mode { _fb_width, _fb_height, Framebuffer::Mode::RGB565 };
 
+	enum { MAX_BUFFERS = 3 };
+
+	/* number of frames for page flipping */
+	unsigned const _fb_buffers =
+		max(1U, min((unsigned)MAX_BUFFERS,
+		            _config.xml().attribute_value("buffers", 1U)));
+
 	Attached_ram_dataspace _fb_ds { _env.ram(), _env.rm(),
-	                                _fb_mode.width()*_fb_mode.height()*_fb_mode.bytes_per_pixel() };
+	                                _fb_buffers*_fb_mode.width()*_fb_mode.height()*_fb_mode.bytes_per_pixel() };
 
-	Framebuffer::Session_component _fb_session { _env, _fb_mode, _fb_ds.cap(), _fb_ds.local_addr<void>() };
+	Framebuffer::Session_component _fb_session { _env, _fb_mode, _fb_ds.cap(),
+	                                             _fb_ds.local_addr<void>(), _fb_buffers };
 
 	Static_root<Framebuffer::Session> _fb_root { _env.ep().manage(_fb_session) };
 
@@ -195,6 +282,8 @@ struct Fb_sdl::Main
 		SDL_ShowCursor(0);
 
 		log("creating virtual framebuffer for mode ", _fb_mode);
+		if (_fb_buffers > 1)
+			log("using ", _fb_buffers, " buffers for page flipping");
 
 		_env.parent().announce(env.ep().manage(_fb_root));
 		_env.parent().announce(env.ep().manage(_input_root));
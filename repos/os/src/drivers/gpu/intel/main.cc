@@ -41,6 +41,7 @@
 #include <context.h>
 #include <context_descriptor.h>
 #include <ring_buffer.h>
+#include <submit_stats.h>
 
 
 namespace Igd {
@@ -90,6 +91,8 @@ struct Igd::Device
 
 	enum { WATCHDOG_TIMEOUT = 1*1000*1000, };
 
+	uint64_t _now_us() { return _timer.elapsed_us(); }
+
 	struct Timer_delayer : Genode::Mmio::Delayer
 	{
 		Timer::Connection &_timer;
@@ -536,7 +539,7 @@ struct Igd::Device
 
 		uint64_t seqno() const {
 			Utils::clflush((uint32_t*)(ctx_vaddr + 0xc0));
-			return *(uint32_t*)(ctx_vaddr + 0xc0); }
+			return *(uint64_t volatile *)(ctx_vaddr + 0xc0); }
 	};
 
 	void _fill_page(Genode::Ram_dataspace_capability ds, addr_t v)
@@ -639,8 +642,33 @@ struct Igd::Device
 
 		Genode::Signal_context_capability _completion_sigh;
 
+		/*
+		 * Batch buffers of the submissions not yet written to the ring
+		 *
+		 * While the vGPU is scheduled, its ring buffer must not be
+		 * changed. Submissions issued meanwhile are collected and written
+		 * at once after the completion of the scheduled ones.
+		 */
+		enum { MAX_PENDING = 64 };
+
+		Gpu::Exec_list::Buffer _pending[MAX_PENDING];
+		unsigned               _num_pending { 0 };
+
+		/* last sequence number assigned to a submission */
 		uint64_t _current_seqno { 0 };
 
+		/* last sequence number written to the ring */
+		uint64_t _submitted_seqno { 0 };
+
+		Gpu::Completion *_completion { nullptr };
+
+		/* points in time of the pending and the written submissions */
+		uint64_t _queued_us    { 0 };
+		uint64_t _written_us   { 0 };
+		uint64_t _scheduled_us { 0 };
+
+		Submit_stats _stats { };
+
 		uint32_t const       _id;
 		Engine<Rcs_context> &rcs;
 
@@ -655,20 +683,90 @@ struct Igd::Device
 		Genode::Signal_context_capability completion_sigh() {
 			return _completion_sigh; }
 
+		/**
+		 * Set completion structure shared with the client
+		 */
+		void completion(Gpu::Completion *completion) { _completion = completion; }
+
 		uint64_t current_seqno() const { return _current_seqno; }
 
+		uint64_t submitted_seqno() const { return _submitted_seqno; }
+
 		uint64_t complete_seqno() const { return rcs.seqno(); }
 
-		void setup_ring_buffer(Genode::addr_t const buffer_addr,
-		                       Genode::addr_t const scratch_addr)
+		Submit_stats const &stats() const { return _stats; }
+
+		bool pending() const { return _num_pending > 0; }
+
+		/**
+		 * Queue submission of batch buffers
+		 *
+		 * \return sequence number of the submission, or 0 if the
+		 *         submission does not fit into the queue
+		 */
+		uint64_t queue(Gpu::Exec_list const &list, uint64_t now_us)
 		{
+			if (!list.count || list.count > Gpu::Exec_list::MAX_BUFFERS
+			 || _num_pending + list.count > MAX_PENDING)
+				return 0;
+
+			if (!_num_pending)
+				_queued_us = now_us;
+
+			for (unsigned i = 0; i < list.count; i++)
+				_pending[_num_pending++] = list.buffer[i];
+
+			_stats.submissions++;
+			_stats.batches += list.count;
+
 			_current_seqno++;
+			if (_completion)
+				_completion->submitted = _current_seqno;
+
+			return _current_seqno;
+		}
+
+		/**
+		 * Account execlist submission of the written ring content
+		 */
+		void scheduled(uint64_t now_us)
+		{
+			_stats.queue.add(now_us - _written_us);
+			_scheduled_us = now_us;
+		}
+
+		/**
+		 * Account completion of the written ring content
+		 */
+		void completed(uint64_t now_us)
+		{
+			_stats.exec.add(now_us - _scheduled_us);
+
+			if (_completion)
+				_completion->completed = _submitted_seqno;
+		}
+
+		/**
+		 * Write pending submissions to the ring buffer
+		 *
+		 * All pending batch buffers are enclosed by one prolog and one
+		 * epilog. Only the sequence number of the last submission is
+		 * written to the hardware status page, which completes all
+		 * submissions written at once.
+		 */
+		void setup_ring_buffer(Genode::addr_t const scratch_addr)
+		{
+			if (!_num_pending) { return; }
+
+			_submitted_seqno = _current_seqno;
+			_written_us      = _queued_us;
+			_stats.rings++;
 
 			Execlist &el = *rcs.execlist;
 
 			Ring_buffer::Index advance = 0;
 
-			size_t const need = 4 /* batchbuffer cmd */ + 6 /* prolog */ + 16 /* epilog + w/a */;
+			size_t const need = 4*_num_pending /* batchbuffer cmds */ + 6 /* prolog */ + 16 /* epilog + w/a */;
 			if (!el.ring_avail(need)) { el.ring_reset_and_fill_zero(); }
 
 			/* save old tail */
@@ -707,12 +805,14 @@ struct Igd::Device
 			}
 
 			/* batch-buffer commands */
-			if (1)
+			for (unsigned b = 0; b < _num_pending; b++)
 			{
 				enum { CMD_NUM = 4, };
 				Genode::uint32_t cmd[CMD_NUM] = {};
 				Igd::Mi_batch_buffer_start mi;
 
+				addr_t const buffer_addr = _pending[b].ppgtt_va;
+
 				cmd[0] = mi.value;
 				cmd[1] = buffer_addr & 0xffffffff;
 				cmd[2] = (buffer_addr >> 32) & 0xffff;
@@ -722,6 +822,7 @@ struct Igd::Device
 					advance += el.ring_append(cmd[i]);
 				}
 			}
+			_num_pending = 0;
 
 			/* epilog */
 			if (1)
@@ -766,8 +867,8 @@ struct Igd::Device
 				cmd[1] = tmp;
 				cmd[2] = (rcs.hw_status_page() + HWS_DATA) & 0xffffffff;
 				cmd[3] = 0; /* upper addr 0 */
-				cmd[4] = _current_seqno & 0xffffffff;
-				cmd[5] = _current_seqno >> 32;
+				cmd[4] = _submitted_seqno & 0xffffffff;
+				cmd[5] = _submitted_seqno >> 32;
 				Igd::Mi_user_interrupt ui;
 				cmd[6] = ui.value;
 				cmd[7] = 0; /* MI_NOOP */
@@ -899,6 +1000,7 @@ struct Igd::Device
 		_mmio->write_post<Igd::Mmio::HWS_PGA_RCSUNIT>(addr);
 
 		_submit_execlist(rcs);
+		gpu->scheduled(_now_us());
 
 		_active_vgpu = gpu;
 		_timer.trigger_once(WATCHDOG_TIMEOUT);
@@ -919,7 +1021,7 @@ struct Igd::Device
 	{
 		if (!gpu) { return; }
 
-		uint64_t const curr_seqno = gpu->current_seqno();
+		uint64_t const curr_seqno = gpu->submitted_seqno();
 		uint64_t const comp_seqno = gpu->complete_seqno();
 
 		if (curr_seqno != comp_seqno) {
@@ -931,7 +1033,18 @@ struct Igd::Device
 		Execlist &el = *gpu->rcs.execlist;
 		el.ring_update_head(gpu->rcs.context->head_offset());
 
+		gpu->completed(_now_us());
+
 		Genode::Signal_transmitter(gpu->completion_sigh()).submit();
+
+		/*
+		 * Write the submissions queued during the execution, the vGPU
+		 * is scheduled by the caller
+		 */
+		if (gpu->pending()) {
+			gpu->setup_ring_buffer(_ggtt->scratch_page());
+			_vgpu_list.enqueue(gpu);
+		}
 	}
 
 	void _handle_irq()
@@ -1021,6 +1134,7 @@ struct Igd::Device
 		gpu->rcs.context->dump_hw_status_page();
 		Execlist const &el = *gpu->rcs.execlist;
 		el.ring_dump(52);
+		gpu->stats().dump(gpu->id());
 
 		_device_reset_and_init();
 
@@ -1189,6 +1303,30 @@ struct Igd::Device
 		_schedule_current_vgpu();
 	}
 
+	/**
+	 * Submit batch buffers for execution by vGPU
+	 *
+	 * \param vgpu  reference to vGPU
+	 * \param list  batch buffers
+	 *
+	 * \return sequence number of the submission, or 0 if the submission
+	 *         was rejected
+	 *
+	 * If the vGPU is scheduled already, the submission stays pending until
+	 * the completion of the scheduled submissions.
+	 */
+	uint64_t vgpu_submit(Vgpu &vgpu, Gpu::Exec_list const &list)
+	{
+		uint64_t const seqno = vgpu.queue(list, _now_us());
+		if (!seqno) { return 0; }
+
+		if (_vgpu_already_scheduled(vgpu)) { return seqno; }
+
+		vgpu.setup_ring_buffer(_ggtt->scratch_page());
+		vgpu_enqueue(vgpu);
+		return seqno;
+	}
+
 	/**
 	 * Check if there is a vGPU slot left
 	 *
@@ -1353,7 +1491,25 @@ class Gpu::Session_component : public Genode::Session_object<Gpu::Session>
 
 		Genode::Registry<Genode::Registered<Buffer>> _buffer_registry;
 
-		Genode::uint64_t seqno { 0 };
+		/* completion structure shared with the client */
+		Genode::Dataspace_capability const _completion_ds;
+		Gpu::Completion                  &_completion;
+
+		Gpu::Completion &_attach_completion()
+		{
+			Gpu::Completion *completion = _rm.attach(_completion_ds);
+			Genode::memset(completion, 0, sizeof(*completion));
+			return *completion;
+		}
+
+		Seqno _submit(Exec_list const &list)
+		{
+			Seqno const seqno = _device.vgpu_submit(_vgpu, list);
+			if (!seqno) {
+				Genode::error("submission of ", list.count, " buffers rejected");
+			}
+			return seqno;
+		}
 
 		void _free_buffers()
 		{
@@ -1399,11 +1555,21 @@ class Gpu::Session_component : public Genode::Session_object<Gpu::Session>
 		:
 			Session_object(ep, resources, label, diag),
 			_rm(rm), _guard(&md_alloc, ram_quota),
-			_device(device), _vgpu(_device.alloc_vgpu(_guard))
-		{ }
+			_device(device), _vgpu(_device.alloc_vgpu(_guard)),
+			_completion_ds(_device.alloc_buffer(_guard, Igd::PAGE_SIZE)),
+			_completion(_attach_completion())
+		{
+			_vgpu.completion(&_completion);
+		}
 
 		~Session_component()
 		{
+			_vgpu.stats().dump(_vgpu.id());
+
+			_vgpu.completion(nullptr);
+			_rm.detach(&_completion);
+			_device.free_buffer(_guard, _completion_ds);
+
 			_free_buffers();
 			_device.free_vgpu(_guard, _vgpu);
 		}
@@ -1449,13 +1615,35 @@ class Gpu::Session_component : public Genode::Session_object<Gpu::Session>
 				return;
 			}
 
-			_vgpu.setup_ring_buffer(ppgtt_va, _device._ggtt->scratch_page());
+			Exec_list list;
+			list.add(ppgtt_va, size);
+			_submit(list);
+		}
 
-			try {
-				_device.vgpu_enqueue(_vgpu);
-			} catch (Igd::Device::Already_scheduled &e) {
-				Genode::error("vGPU already scheduled");
+		Seqno exec_buffers(Exec_list const &list) override
+		{
+			/* accept buffers mapped in the PPGTT of the session only */
+			for (unsigned i = 0; i < list.count && i < Exec_list::MAX_BUFFERS; i++) {
+
+				bool valid = false;
+				auto lookup = [&] (Buffer &buffer) {
+					if (buffer.ppgtt_va && buffer.ppgtt_va == list.buffer[i].ppgtt_va)
+						valid = true;
+				};
+				_buffer_registry.for_each(lookup);
+
+				if (!valid) {
+					Genode::error("Invalid execbuffer");
+					return 0;
+				}
 			}
+
+			return _submit(list);
+		}
+
+		Genode::Dataspace_capability completion_dataspace() override
+		{
+			return _completion_ds;
 		}
 
 		void completion_sigh(Genode::Signal_context_capability sigh) override
@@ -14,6 +14,7 @@
 /* local includes */
 #include <mmio.h>
 #include <context.h>
+#include <submit_stats.h>
 
 
 void Igd::Mmio::dump()
@@ -325,3 +326,14 @@ void Igd::Mmio::context_status_pointer_dump()
 		log(i, "  Context_status_ldw: ", Hex(csl));
 	}
 }
+
+
+void Igd::Submit_stats::dump(uint32_t vgpu_id) const
+{
+	using namespace Genode;
+
+	log("vGPU ", vgpu_id, " submissions: ", submissions,
+	    " batches: ", batches, " ring updates: ", rings);
+	log("  queued   avg: ", queue.avg_us(), " us max: ", queue.max_us, " us");
+	log("  executed avg: ", exec.avg_us(),  " us max: ", exec.max_us,  " us");
+}
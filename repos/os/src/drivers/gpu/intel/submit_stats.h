@@ -0,0 +1,51 @@
+/*
+ * \brief  Timing statistics of command submissions
+ * \author Genode Labs
+ * \date   2026-10-14
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _SUBMIT_STATS_H_
+#define _SUBMIT_STATS_H_
+
+/* local includes */
+#include <types.h>
+
+namespace Igd { struct Submit_stats; }
+
+
+struct Igd::Submit_stats
+{
+	struct Duration
+	{
+		uint64_t sum_us   { 0 };
+		uint64_t max_us   { 0 };
+		uint64_t count    { 0 };
+
+		void add(uint64_t us)
+		{
+			sum_us += us;
+			if (us > max_us) { max_us = us; }
+			count++;
+		}
+
+		uint64_t avg_us() const { return count ? sum_us / count : 0; }
+	};
+
+	uint64_t submissions { 0 };  /* number of submit requests */
+	uint64_t batches     { 0 };  /* number of batch buffers */
+	uint64_t rings       { 0 };  /* number of ring-buffer updates */
+
+	Duration queue { };  /* from submit request to execlist submission */
+	Duration exec  { };  /* from execlist submission to completion */
+
+	void dump(uint32_t vgpu_id) const;
+};
+
+#endif /* _SUBMIT_STATS_H_ */
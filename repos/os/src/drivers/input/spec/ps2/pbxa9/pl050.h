@@ -56,7 +56,8 @@ class Pl050
 
 
 	class _Channel : public Serial_interface,
-	                 public Genode::Ring_buffer<unsigned char, 256>
+	                 public Genode::Ring_buffer<unsigned char, 256,
+	                                            Genode::Ring_buffer_spsc>
 	{
 		private:
 
@@ -85,8 +85,13 @@ class I8042
 	 */
 	enum { MAX_ATTEMPTS = 4096 };
 
+	/*
+	 * The channel buffer is fed with the controller lock held and consumed
+	 * by the channel's reader only.
+	 */
 	class _Channel : public Serial_interface,
-	                 public Genode::Ring_buffer<unsigned char, 1024>
+	                 public Genode::Ring_buffer<unsigned char, 1024,
+	                                            Genode::Ring_buffer_spsc>
 	{
 		private:
 
@@ -0,0 +1,468 @@
+/*
+ * \brief  NVMe I/O queues and block driver
+ * \author Genode Labs
+ * \date   2026-10-14
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _NVME__DRIVER_H_
+#define _NVME__DRIVER_H_
+
+/* Genode includes */
+#include <base/entrypoint.h>
+#include <base/lock.h>
+#include <base/semaphore.h>
+#include <block/driver.h>
+
+/* local includes */
+#include <nvme.h>
+
+namespace Nvme {
+	class Io_queue;
+	class Driver;
+}
+
+
+/**
+ * I/O queue pair served by its own entrypoint
+ *
+ * Each queue pair is served by an entrypoint at the CPU that receives the
+ * completion interrupt of the queue. The block sessions assigned to the
+ * queue are served by the same entrypoint. Hence, the queue pair, the
+ * command table, and the PRP lists are accessed by one thread only, except
+ * for the command budgets, which are managed by the main entrypoint.
+ */
+class Nvme::Io_queue
+{
+	public:
+
+		enum {
+			STACK_SIZE    = 4*1024*sizeof(long),
+			PRP_ENTRIES   = 32,
+			PRP_LIST_SIZE = PRP_ENTRIES*sizeof(uint64_t),
+
+			/* transfer size covered by the PRP list of one command */
+			MAX_TRANSFER  = PRP_ENTRIES*PAGE_SIZE,
+		};
+
+	private:
+
+		typedef String<16> Name;
+
+		struct Command
+		{
+			Driver   *driver;
+			unsigned  tag;
+		};
+
+		Name const _name;
+
+		Entrypoint _ep;
+		Queue_pair _qp;
+		Dma_buffer _prp;
+
+		Irq_session_client _irq;
+
+		Signal_handler<Io_queue> _irq_handler {
+			_ep, *this, &Io_queue::_handle_irq };
+
+		Command  _commands[IO_QUEUE_SIZE];
+		uint16_t _free_cids[IO_QUEUE_SIZE];
+		unsigned _free_count = 0;
+
+		/* commands reserved by the drivers assigned to the queue */
+		unsigned _reserved = 0;
+
+		void _handle_irq();
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param id      queue ID at the controller
+		 * \param irq     IRQ session of the completion interrupt
+		 * \param vector  interrupt vector of the completion queue
+		 */
+		Io_queue(Env &env, Pci &pci, Controller &controller, unsigned id,
+		         unsigned size, Affinity::Location location,
+		         Irq_session_capability irq, unsigned vector)
+		:
+			_name("nvme_q", id),
+			_ep(env, STACK_SIZE, _name.string(), location),
+			_qp(env, pci, controller.registers(), id, size),
+			_prp(env, pci, size*PRP_LIST_SIZE),
+			_irq(irq)
+		{
+			for (unsigned cid = size; cid > 0; cid--) {
+				_commands[cid - 1] = Command { nullptr, 0 };
+				_free_cids[_free_count++] = cid - 1;
+			}
+
+			controller.create_io_queue(_qp, vector);
+
+			_irq.sigh(_irq_handler);
+			_irq.ack_irq();
+		}
+
+		Entrypoint &ep() { return _ep; }
+
+		/**
+		 * Return number of commands not reserved by any driver
+		 */
+		unsigned unreserved() const { return _qp.size() - 1 - _reserved; }
+
+		/**
+		 * Reserve (unreserve) commands for a driver
+		 *
+		 * Called by the main entrypoint when creating (destroying) a
+		 * session. The sum of all reservations never exceeds the queue
+		 * size, which lets each driver submit up to its reservation without
+		 * waiting for the completions of other drivers.
+		 */
+		bool reserve(unsigned count)
+		{
+			if (count > unreserved())
+				return false;
+
+			_reserved += count;
+			return true;
+		}
+
+		void unreserve(unsigned count) { _reserved -= count; }
+
+		uint64_t *prp_list(uint16_t cid) {
+			return _prp.local<uint64_t>(cid*PRP_LIST_SIZE); }
+
+		addr_t prp_list_phys(uint16_t cid) const {
+			return _prp.phys(cid*PRP_LIST_SIZE); }
+
+		/**
+		 * Describe the physically contiguous buffer by the PRP entries
+		 *
+		 * \param size  at most 'MAX_TRANSFER' bytes
+		 */
+		void prp(Sqe &e, uint16_t cid, addr_t phys, size_t size)
+		{
+			e.prp1 = phys;
+
+			size_t const first = PAGE_SIZE - (phys & (PAGE_SIZE - 1));
+			if (size <= first)
+				return;
+
+			addr_t page = phys + first;
+			size_t rest = size - first;
+
+			if (rest <= PAGE_SIZE) {
+				e.prp2 = page;
+				return;
+			}
+
+			uint64_t *list = prp_list(cid);
+			for (unsigned i = 0; rest; i++, page += PAGE_SIZE) {
+				list[i] = page;
+				rest   -= min(rest, (size_t)PAGE_SIZE);
+			}
+			e.prp2 = prp_list_phys(cid);
+		}
+
+		/**
+		 * Submit command on behalf of 'driver'
+		 *
+		 * \param fill  functor called with the cleared 'Sqe &' and the
+		 *              command ID
+		 */
+		template <typename FN>
+		void submit(Driver &driver, unsigned tag, FN const &fill)
+		{
+			uint16_t const cid = _free_cids[--_free_count];
+			_commands[cid] = Command { &driver, tag };
+
+			Sqe &e = _qp.next_entry();
+			fill(e, cid);
+			_qp.submit();
+		}
+};
+
+
+/**
+ * Block driver of one session
+ */
+class Nvme::Driver : public Block::Driver
+{
+	public:
+
+		/* commands reserved at the I/O queue per session */
+		enum { QUEUE_BUDGET = 64 };
+
+	private:
+
+		enum Io_opcode { FLUSH = 0x00, WRITE = 0x01, READ = 0x02, DSM = 0x09 };
+
+		enum { DSM_DEALLOCATE = 1 << 2, MAX_DSM_BLOCKS = ~0U };
+
+		struct Pending
+		{
+			Block::Packet_descriptor packet;
+			unsigned                 parts;    /* commands still in flight */
+			bool                     success;
+		};
+
+		Pci             &_pci;
+		Controller      &_controller;
+		Io_queue        &_queue;
+		Namespace const  _ns;
+
+		/* blocks transferred by one command */
+		size_t const _max_blocks =
+			min(_controller.max_transfer(), (size_t)Io_queue::MAX_TRANSFER)
+			/ _ns.block_size;
+
+		Pending _pending[MAX_COMMAND_SLOTS];
+
+		/*
+		 * The number of commands in flight is shared with the main
+		 * entrypoint, which waits for the completion of all commands
+		 * when the session gets closed.
+		 */
+		Lock      _lock;
+		unsigned  _in_flight = 0;
+		bool      _closing   = false;
+		Semaphore _idle;
+
+		/**
+		 * Submit 'parts' commands for the request
+		 *
+		 * \param fill  functor called with the 'Sqe &' and the command ID
+		 *              of each part
+		 *
+		 * \throw Request_congestion
+		 * \throw Io_error
+		 */
+		template <typename FN>
+		void _issue(Block::Request &request, size_t parts, FN const &fill)
+		{
+			if (parts > QUEUE_BUDGET)
+				throw Io_error();
+
+			{
+				Lock::Guard guard(_lock);
+
+				if (_closing)
+					throw Io_error();
+
+				/* completions of own commands resume the session */
+				if (_in_flight + parts > QUEUE_BUDGET)
+					throw Request_congestion();
+
+				_in_flight += parts;
+			}
+
+			_pending[request.tag] = Pending { request.packet, (unsigned)parts, true };
+
+			for (size_t i = 0; i < parts; i++)
+				_queue.submit(*this, request.tag, fill);
+		}
+
+		void _transfer(Block::Request &request, Io_opcode opcode)
+		{
+			Block::Packet_descriptor const &p = request.packet;
+
+			uint64_t lba    = p.block_number();
+			size_t   blocks = p.block_count();
+			addr_t   phys   = request.phys;
+
+			size_t const parts = (blocks + _max_blocks - 1) / _max_blocks;
+
+			_issue(request, parts, [&] (Sqe &e, uint16_t cid) {
+
+				size_t const n    = min(blocks, _max_blocks);
+				size_t const size = n*_ns.block_size;
+
+				e.command(opcode, cid);
+				e.nsid  = _ns.id;
+				e.cdw10 = (uint32_t)lba;
+				e.cdw11 = (uint32_t)(lba >> 32);
+				e.cdw12 = n - 1;
+				_queue.prp(e, cid, phys, size);
+
+				lba    += n;
+				blocks -= n;
+				phys   += size;
+			});
+		}
+
+		void _discard(Block::Request &request)
+		{
+			Block::Packet_descriptor const &p = request.packet;
+
+			uint64_t lba    = p.block_number();
+			size_t   blocks = p.block_count();
+
+			size_t const parts = blocks / MAX_DSM_BLOCKS
+			                   + (blocks % MAX_DSM_BLOCKS ? 1 : 0);
+
+			_issue(request, parts, [&] (Sqe &e, uint16_t cid) {
+
+				size_t const n = min(blocks, (size_t)MAX_DSM_BLOCKS);
+
+				/* the range is stored in the otherwise unused PRP list */
+				uint32_t *range = (uint32_t *)_queue.prp_list(cid);
+				range[0] = 0;
+				range[1] = n;
+				range[2] = (uint32_t)lba;
+				range[3] = (uint32_t)(lba >> 32);
+
+				e.command(DSM, cid);
+				e.nsid  = _ns.id;
+				e.prp1  = _queue.prp_list_phys(cid);
+				e.cdw10 = 0;  /* one range */
+				e.cdw11 = DSM_DEALLOCATE;
+
+				lba    += n;
+				blocks -= n;
+			});
+		}
+
+	public:
+
+		Driver(Env &env, Pci &pci, Controller &controller, Io_queue &queue,
+		       Namespace const &ns)
+		:
+			Block::Driver(env.ram()),
+			_pci(pci), _controller(controller), _queue(queue), _ns(ns)
+		{ }
+
+		/**
+		 * Called by the I/O queue for each completed command
+		 */
+		void completed(unsigned tag, bool success)
+		{
+			Pending &pending = _pending[tag];
+
+			pending.success &= success;
+			if (!--pending.parts)
+				ack_packet(pending.packet, pending.success);
+
+			bool wake = false;
+			{
+				Lock::Guard guard(_lock);
+				_in_flight--;
+				wake = _closing && !_in_flight;
+			}
+			if (wake)
+				_idle.up();
+		}
+
+
+		/*******************************
+		 **  Block::Driver interface  **
+		 *******************************/
+
+		size_t          block_size()  override { return _ns.block_size;  }
+		Block::sector_t block_count() override { return _ns.block_count; }
+
+		Block::Session::Operations ops() override
+		{
+			Block::Session::Operations o;
+			o.set_operation(Block::Packet_descriptor::READ);
+			o.set_operation(Block::Packet_descriptor::WRITE);
+			o.set_operation(Block::Packet_descriptor::FLUSH);
+			if (_controller.dsm())
+				o.set_operation(Block::Packet_descriptor::DISCARD);
+			return o;
+		}
+
+		bool dma_enabled() override { return true; }
+
+		Ram_dataspace_capability alloc_dma_buffer(size_t size) override {
+			return _pci.alloc_dma_buffer(size); }
+
+		void free_dma_buffer(Ram_dataspace_capability ds) override {
+			_pci.free_dma_buffer(ds); }
+
+		void submit(Block::Request &request) override
+		{
+			switch (request.packet.operation()) {
+
+			case Block::Packet_descriptor::READ:
+				_transfer(request, READ);
+				return;
+
+			case Block::Packet_descriptor::WRITE:
+				_transfer(request, WRITE);
+				return;
+
+			case Block::Packet_descriptor::DISCARD:
+				if (!_controller.dsm())
+					throw Io_error();
+				_discard(request);
+				return;
+
+			case Block::Packet_descriptor::FLUSH:
+
+				/* without a volatile write cache, completed writes are stored */
+				if (!_controller.volatile_write_cache()) {
+					ack_packet(request.packet);
+					return;
+				}
+				_issue(request, 1, [&] (Sqe &e, uint16_t cid) {
+					e.command(FLUSH, cid);
+					e.nsid = _ns.id;
+				});
+				return;
+
+			default:
+				throw Io_error();
+			}
+		}
+
+		/**
+		 * Wait until the controller completed all commands of the session
+		 *
+		 * Called by the main entrypoint when the session gets closed.
+		 */
+		void session_invalidated() override
+		{
+			bool wait = false;
+			{
+				Lock::Guard guard(_lock);
+				_closing = true;
+				wait     = _in_flight > 0;
+			}
+			if (wait)
+				_idle.down();
+		}
+};
+
+
+void Nvme::Io_queue::_handle_irq()
+{
+	_qp.for_each_completion([&] (Cqe const &cqe) {
+
+		if (cqe.cid >= _qp.size() || !_commands[cqe.cid].driver) {
+			error("unexpected completion of command ", cqe.cid);
+			return;
+		}
+
+		Command const command = _commands[cqe.cid];
+		_commands[cqe.cid].driver = nullptr;
+		_free_cids[_free_count++] = cqe.cid;
+
+		if (!cqe.succeeded())
+			warning("command ", cqe.cid, " failed with status ",
+			        Hex(cqe.status >> 1));
+
+		command.driver->completed(command.tag, cqe.succeeded());
+	});
+
+	_irq.ack_irq();
+}
+
+#endif /* _NVME__DRIVER_H_ */
@@ -0,0 +1,294 @@
+/*
+ * \brief  NVMe block driver
+ * \author Genode Labs
+ * \date   2026-10-14
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/attached_rom_dataspace.h>
+#include <base/component.h>
+#include <base/heap.h>
+#include <block/component.h>
+#include <os/session_policy.h>
+#include <root/component.h>
+#include <timer_session/connection.h>
+
+/* local includes */
+#include <driver.h>
+
+namespace Nvme {
+	struct Driver_factory;
+	class  Session_component;
+	class  Root;
+	struct Main;
+}
+
+
+struct Nvme::Driver_factory : Block::Driver_factory
+{
+	Env             &env;
+	Allocator       &alloc;
+	Pci             &pci;
+	Controller      &controller;
+	Io_queue        &queue;
+	Namespace const &ns;
+
+	Driver_factory(Env &env, Allocator &alloc, Pci &pci,
+	               Controller &controller, Io_queue &queue,
+	               Namespace const &ns)
+	:
+		env(env), alloc(alloc), pci(pci), controller(controller),
+		queue(queue), ns(ns)
+	{ }
+
+	Block::Driver *create() override {
+		return new (alloc) Driver(env, pci, controller, queue, ns); }
+
+	void destroy(Block::Driver *driver) override {
+		Genode::destroy(alloc, static_cast<Driver *>(driver)); }
+};
+
+
+class Nvme::Session_component : public Block::Session_component
+{
+	private:
+
+		Io_queue &_queue;
+
+	public:
+
+		Session_component(Driver_factory &factory, Region_map &rm,
+		                  size_t buf_size, bool writeable)
+		:
+			Block::Session_component(factory, factory.queue.ep(), rm,
+			                         buf_size, writeable),
+			_queue(factory.queue)
+		{ }
+
+		Driver_factory &factory() {
+			return static_cast<Driver_factory &>(_driver_factory); }
+
+		Io_queue &queue() { return _queue; }
+};
+
+
+class Nvme::Root : public Root_component<Session_component>
+{
+	private:
+
+		Env        &_env;
+		Allocator  &_alloc;
+		Pci        &_pci;
+		Controller &_controller;
+		Xml_node    _config;
+
+		Io_queue **_queues;
+		unsigned   _num_queues;
+
+		/**
+		 * Return queue with the most unreserved commands
+		 */
+		Io_queue *_least_loaded_queue()
+		{
+			Io_queue *queue = nullptr;
+			for (unsigned i = 0; i < _num_queues; i++)
+				if (!queue || _queues[i]->unreserved() > queue->unreserved())
+					queue = _queues[i];
+
+			return queue;
+		}
+
+	protected:
+
+		Session_component *_create_session(const char *args) override
+		{
+			Session_label  const label = label_from_args(args);
+			Session_policy const policy(label, _config);
+
+			size_t const ram_quota =
+				Arg_string::find_arg(args, "ram_quota").ulong_value(0);
+			size_t const tx_buf_size =
+				Arg_string::find_arg(args, "tx_buf_size").ulong_value(0);
+
+			if (!tx_buf_size)
+				throw Service_denied();
+
+			size_t const session_size = sizeof(Session_component)
+			                          + sizeof(Driver_factory) + sizeof(Driver)
+			                          + tx_buf_size;
+
+			if (max((size_t)4096, session_size) > ram_quota) {
+				error("insufficient 'ram_quota' from '", label, "',"
+				      " got ", ram_quota, ", need ", session_size);
+				throw Insufficient_ram_quota();
+			}
+
+			unsigned const ns_id = policy.attribute_value("namespace", 1U);
+
+			Namespace const *ns = _controller.name_space(ns_id);
+			if (!ns) {
+				error("namespace ", ns_id, " not available for '", label, "'");
+				throw Service_denied();
+			}
+
+			/* sessions are not writeable by default */
+			bool writeable = policy.attribute_value("writeable", false);
+			if (writeable)
+				writeable = Arg_string::find_arg(args, "writeable").bool_value(true);
+
+			Io_queue *queue = _least_loaded_queue();
+			if (!queue || !queue->reserve(Driver::QUEUE_BUDGET)) {
+				error("no I/O queue left for '", label, "'");
+				throw Service_denied();
+			}
+
+			Driver_factory *factory = nullptr;
+			try {
+				factory = new (_alloc)
+					Driver_factory(_env, _alloc, _pci, _controller, *queue, *ns);
+
+				Session_component *session = new (_alloc)
+					Session_component(*factory, _env.rm(), tx_buf_size, writeable);
+
+				log(writeable ? "writeable " : "read-only ",
+				    "session opened at namespace ", ns_id, " for '", label, "'");
+				return session;
+
+			} catch (...) {
+				if (factory)
+					Genode::destroy(_alloc, factory);
+				queue->unreserve(Driver::QUEUE_BUDGET);
+				throw;
+			}
+		}
+
+		void _destroy_session(Session_component *session) override
+		{
+			Driver_factory &factory = session->factory();
+			Io_queue       &queue   = session->queue();
+
+			Genode::destroy(_alloc, session);
+			Genode::destroy(_alloc, &factory);
+
+			queue.unreserve(Driver::QUEUE_BUDGET);
+		}
+
+	public:
+
+		Root(Env &env, Allocator &alloc, Pci &pci, Controller &controller,
+		     Xml_node config, Io_queue **queues, unsigned num_queues)
+		:
+			Root_component(&env.ep().rpc_ep(), &alloc),
+			_env(env), _alloc(alloc), _pci(pci), _controller(controller),
+			_config(config), _queues(queues), _num_queues(num_queues)
+		{ }
+};
+
+
+struct Nvme::Main
+{
+	Env  &env;
+	Heap  heap { env.ram(), env.rm() };
+
+	Attached_rom_dataspace config { env, "config" };
+
+	struct Timer_delayer : Mmio::Delayer, Timer::Connection
+	{
+		Timer_delayer(Env &env) : Timer::Connection(env) { }
+
+		void usleep(unsigned us) override { Timer::Connection::usleep(us); }
+	} delayer { env };
+
+	Pci        pci        { env };
+	Controller controller { env, pci, delayer };
+
+	Io_queue *queues[MAX_IO_QUEUES];
+	unsigned  num_queues = 0;
+
+	/**
+	 * Create one I/O queue pair per CPU if MSI-X is available
+	 *
+	 * Vector 0 belongs to the admin queue, which is polled and whose
+	 * vector stays masked. Without MSI-X, a single I/O queue pair gets
+	 * served via the legacy interrupt or MSI.
+	 */
+	void create_io_queues()
+	{
+		Affinity::Space cpus = env.cpu().affinity_space();
+
+		unsigned const vectors = pci.msi_x_vectors();
+		unsigned const size    = min((unsigned)IO_QUEUE_SIZE,
+		                             controller.max_queue_size());
+
+		unsigned count = 1;
+		if (vectors > 1)
+			count = min(min(cpus.total(), vectors - 1), (unsigned)MAX_IO_QUEUES);
+
+		/* the number of queue pairs can be limited by the configuration */
+		count = min(count, config.xml().attribute_value("max_queues", count));
+		count = controller.request_io_queues(max(1U, count));
+
+		for (unsigned i = 0; i < count; i++) {
+
+			unsigned const id     = i + 1;
+			unsigned const vector = vectors > 1 ? id : 0;
+
+			Affinity::Location const location = cpus.location_of_index(i);
+
+			Irq_session_capability const irq = vectors > 1
+			                                 ? pci.msi_x(vector, location)
+			                                 : pci.irq();
+			if (!irq.valid()) {
+				warning("no interrupt for I/O queue ", id);
+				break;
+			}
+
+			queues[num_queues++] = new (heap)
+				Io_queue(env, pci, controller, id, size, location, irq, vector);
+		}
+
+		log(num_queues, " I/O queue", num_queues > 1 ? "s" : "", " of ",
+		    size, " entries", vectors > 1 ? " with MSI-X" : "");
+	}
+
+	Constructible<Root> root;
+
+	Main(Env &env) : env(env)
+	{
+		create_io_queues();
+
+		if (!num_queues) {
+			error("no I/O queue available");
+			env.parent().exit(~0);
+			return;
+		}
+
+		root.construct(env, heap, pci, controller, config.xml(), queues,
+		               num_queues);
+		env.parent().announce(env.ep().manage(*root));
+	}
+};
+
+
+void Component::construct(Genode::Env &env)
+{
+	try {
+		static Nvme::Main main(env);
+	} catch (Nvme::Missing_controller) {
+		Genode::error("no NVMe controller found");
+		env.parent().exit(~0);
+	} catch (Nvme::Controller::Initialization_failed) {
+		Genode::error("NVMe controller initialization failed");
+		env.parent().exit(~0);
+	} catch (Genode::Service_denied) {
+		Genode::error("hardware access denied");
+		env.parent().exit(~0);
+	}
+}
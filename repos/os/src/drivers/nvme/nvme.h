@@ -0,0 +1,558 @@
+/*
+ * \brief  NVMe controller, queues, and admin commands
+ * \author Genode Labs
+ * \date   2026-10-14
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _NVME__NVME_H_
+#define _NVME__NVME_H_
+
+/* Genode includes */
+#include <base/log.h>
+#include <cpu/memory_barrier.h>
+#include <dataspace/client.h>
+#include <util/mmio.h>
+#include <util/string.h>
+
+/* local includes */
+#include <pci.h>
+
+namespace Nvme {
+
+	enum {
+		PAGE_SIZE        = 4096,
+		ADMIN_QUEUE_SIZE = 32,
+		IO_QUEUE_SIZE    = 256,
+		MAX_IO_QUEUES    = 8,
+		MAX_NAMESPACES   = 8,
+	};
+
+	struct Sqe;
+	struct Cqe;
+	class  Dma_buffer;
+	struct Registers;
+	class  Queue_pair;
+	struct Namespace;
+	class  Controller;
+}
+
+
+/**
+ * Submission-queue entry
+ */
+struct Nvme::Sqe
+{
+	uint32_t cdw0;  /* opcode (7:0), command identifier (31:16) */
+	uint32_t nsid;
+	uint64_t reserved;
+	uint64_t mptr;
+	uint64_t prp1;
+	uint64_t prp2;
+	uint32_t cdw10, cdw11, cdw12, cdw13, cdw14, cdw15;
+
+	void command(uint8_t opcode, uint16_t cid) { cdw0 = opcode | (cid << 16); }
+
+} __attribute__((packed));
+
+
+/**
+ * Completion-queue entry
+ */
+struct Nvme::Cqe
+{
+	uint32_t result;
+	uint32_t reserved;
+	uint16_t sq_head;
+	uint16_t sq_id;
+	uint16_t cid;
+	uint16_t status;  /* phase tag (0), status field (15:1) */
+
+	bool phase()     const { return status & 1; }
+	bool succeeded() const { return !(status >> 1); }
+
+} __attribute__((packed));
+
+
+/**
+ * DMA memory used by the controller, e.g., for queues and PRP lists
+ */
+class Nvme::Dma_buffer
+{
+	private:
+
+		Pci                           &_pci;
+		Ram_dataspace_capability const _ds;
+		Attached_dataspace             _local;
+		addr_t                   const _phys;
+
+	public:
+
+		Dma_buffer(Env &env, Pci &pci, size_t size)
+		:
+			_pci(pci), _ds(_pci.alloc_dma_buffer(size)),
+			_local(env.rm(), _ds), _phys(Dataspace_client(_ds).phys_addr())
+		{
+			memset(_local.local_addr<void>(), 0, size);
+		}
+
+		~Dma_buffer() { _pci.free_dma_buffer(_ds); }
+
+		template <typename T>
+		T *local(size_t offset = 0) {
+			return (T *)(_local.local_addr<char>() + offset); }
+
+		addr_t phys(size_t offset = 0) const { return _phys + offset; }
+};
+
+
+/**
+ * Controller registers
+ */
+struct Nvme::Registers : Genode::Mmio
+{
+	struct Cap : Register<0x0, 64>
+	{
+		struct Mqes  : Bitfield< 0, 16> { };  /* max queue entries - 1 */
+		struct To    : Bitfield<24,  8> { };  /* ready timeout in 500 ms */
+		struct Dstrd : Bitfield<32,  4> { };  /* doorbell stride */
+	};
+
+	struct Vs : Register<0x8, 32>
+	{
+		struct Mnr : Bitfield< 8,  8> { };
+		struct Mjr : Bitfield<16, 16> { };
+	};
+
+	struct Cc : Register<0x14, 32>
+	{
+		struct En     : Bitfield< 0, 1> { };
+		struct Css    : Bitfield< 4, 3> { };
+		struct Mps    : Bitfield< 7, 4> { };  /* page size 2^(12 + mps) */
+		struct Ams    : Bitfield<11, 3> { };
+		struct Iosqes : Bitfield<16, 4> { };  /* SQ entry size 2^n */
+		struct Iocqes : Bitfield<20, 4> { };  /* CQ entry size 2^n */
+	};
+
+	struct Csts : Register<0x1c, 32>
+	{
+		struct Rdy : Bitfield<0, 1> { };
+		struct Cfs : Bitfield<1, 1> { };  /* controller fatal status */
+	};
+
+	struct Aqa : Register<0x24, 32>
+	{
+		struct Asqs : Bitfield< 0, 12> { };
+		struct Acqs : Bitfield<16, 12> { };
+	};
+
+	struct Asq : Register<0x28, 64> { };
+	struct Acq : Register<0x30, 64> { };
+
+	enum { DOORBELL_BASE = 0x1000 };
+
+	unsigned const doorbell_stride = 4 << read<Cap::Dstrd>();
+
+	void _doorbell(unsigned index, uint32_t value)
+	{
+		/* make queue entries visible before the controller fetches them */
+		memory_barrier();
+		*(uint32_t volatile *)(base() + DOORBELL_BASE
+		                       + index*doorbell_stride) = value;
+	}
+
+	void sq_tail_doorbell(unsigned qid, uint32_t tail) { _doorbell(2*qid,     tail); }
+	void cq_head_doorbell(unsigned qid, uint32_t head) { _doorbell(2*qid + 1, head); }
+
+	Registers(addr_t base) : Mmio(base) { }
+};
+
+
+/**
+ * Pair of a submission queue and its completion queue
+ *
+ * A queue pair is accessed by one thread only.
+ */
+class Nvme::Queue_pair
+{
+	private:
+
+		Registers &_regs;
+
+		unsigned const _id;
+		unsigned const _size;
+
+		Dma_buffer _sq;
+		Dma_buffer _cq;
+
+		unsigned _sq_tail = 0;
+		unsigned _cq_head = 0;
+		bool     _phase   = true;
+
+	public:
+
+		Queue_pair(Env &env, Pci &pci, Registers &regs, unsigned id,
+		           unsigned size)
+		:
+			_regs(regs), _id(id), _size(size),
+			_sq(env, pci, size*sizeof(Sqe)), _cq(env, pci, size*sizeof(Cqe))
+		{ }
+
+		unsigned id()   const { return _id; }
+		unsigned size() const { return _size; }
+
+		addr_t sq_phys() const { return _sq.phys(); }
+		addr_t cq_phys() const { return _cq.phys(); }
+
+		/**
+		 * Return cleared entry at the tail of the submission queue
+		 *
+		 * The caller ensures that no more commands than 'size() - 1' are
+		 * outstanding.
+		 */
+		Sqe &next_entry()
+		{
+			Sqe &e = *_sq.local<Sqe>(_sq_tail*sizeof(Sqe));
+			memset(&e, 0, sizeof(e));
+			return e;
+		}
+
+		/**
+		 * Hand the entry obtained via 'next_entry' to the controller
+		 */
+		void submit()
+		{
+			_sq_tail = (_sq_tail + 1) % _size;
+			_regs.sq_tail_doorbell(_id, _sq_tail);
+		}
+
+		/**
+		 * Call 'fn(Cqe const &)' for each new completion
+		 *
+		 * \return number of completions
+		 */
+		template <typename FN>
+		unsigned for_each_completion(FN const &fn)
+		{
+			unsigned count = 0;
+			for (;;) {
+				Cqe const volatile &v = *_cq.local<Cqe>(_cq_head*sizeof(Cqe));
+				if ((bool)(v.status & 1) != _phase)
+					break;
+
+				Cqe const cqe = *const_cast<Cqe const *>(&v);
+				fn(cqe);
+				count++;
+
+				if (++_cq_head == _size) {
+					_cq_head = 0;
+					_phase   = !_phase;
+				}
+			}
+
+			if (count)
+				_regs.cq_head_doorbell(_id, _cq_head);
+
+			return count;
+		}
+};
+
+
+/**
+ * Active namespace of the controller
+ */
+struct Nvme::Namespace
+{
+	unsigned id;
+	size_t   block_size;
+	uint64_t block_count;
+};
+
+
+/**
+ * Controller initialization and admin commands
+ *
+ * Admin commands are issued during initialization only and are completed
+ * by polling.
+ */
+class Nvme::Controller
+{
+	public:
+
+		struct Initialization_failed : Exception { };
+
+		typedef String<41> Model;
+		typedef String<21> Serial;
+
+	private:
+
+		enum Admin_opcode {
+			CREATE_IO_SQ = 0x01,
+			CREATE_IO_CQ = 0x05,
+			IDENTIFY     = 0x06,
+			SET_FEATURES = 0x09,
+		};
+
+		enum {
+			CNS_NAMESPACE     = 0,
+			CNS_CONTROLLER    = 1,
+			FEATURE_QUEUES    = 0x07,
+			QUEUE_CONTIGUOUS  = 1,
+			CQ_IRQ_ENABLED    = 2,
+			ONCS_DSM          = 1 << 2,
+		};
+
+		Env              &_env;
+		Pci              &_pci;
+		Mmio::Delayer    &_delayer;
+		Registers         _regs { _pci.mmio_base() };
+		Queue_pair        _admin { _env, _pci, _regs, 0, ADMIN_QUEUE_SIZE };
+		Dma_buffer        _identify { _env, _pci, PAGE_SIZE };
+
+		uint16_t _admin_cid = 0;
+
+		/* identify-controller data */
+		Model    _model { };
+		Serial   _serial { };
+		size_t   _max_transfer = 0;
+		unsigned _num_namespaces = 0;
+		bool     _volatile_write_cache = false;
+		bool     _dsm = false;
+
+		Namespace _ns[MAX_NAMESPACES];
+		unsigned  _ns_count = 0;
+
+		unsigned _timeout_ms() const {
+			return max(1U, (unsigned)_regs.read<Registers::Cap::To>()) * 500; }
+
+		void _wait_ready(bool ready)
+		{
+			try {
+				_regs.wait_for(Mmio::Attempts(_timeout_ms()),
+				               Mmio::Microseconds(1000), _delayer,
+				               Registers::Csts::Rdy::Equal(ready));
+			} catch (Mmio::Polling_timeout) {
+				error("controller did not become ", ready ? "ready" : "idle");
+				throw Initialization_failed();
+			}
+		}
+
+		/**
+		 * Execute admin command and poll for its completion
+		 *
+		 * \return result dword of the completion
+		 */
+		template <typename FN>
+		uint32_t _admin_command(uint8_t opcode, FN const &fill)
+		{
+			uint16_t const cid = _admin_cid++;
+
+			Sqe &e = _admin.next_entry();
+			e.command(opcode, cid);
+			fill(e);
+			_admin.submit();
+
+			for (unsigned ms = 0; ms < _timeout_ms(); ms++) {
+				bool     done    = false;
+				bool     success = false;
+				uint32_t result  = 0;
+
+				_admin.for_each_completion([&] (Cqe const &cqe) {
+					if (cqe.cid != cid)
+						return;
+					done    = true;
+					success = cqe.succeeded();
+					result  = cqe.result;
+				});
+
+				if (done) {
+					if (!success) {
+						error("admin command ", Hex(opcode), " failed");
+						throw Initialization_failed();
+					}
+					return result;
+				}
+				_delayer.usleep(1000);
+			}
+			error("admin command ", Hex(opcode), " timed out");
+			throw Initialization_failed();
+		}
+
+		template <typename T>
+		T _identify_data(size_t offset) {
+			return *_identify.local<T const>(offset); }
+
+		template <size_t N>
+		String<N> _identify_string(size_t offset)
+		{
+			char buf[N];
+			memcpy(buf, _identify.local<char const>(offset), N - 1);
+
+			/* strip trailing blanks */
+			size_t len = N - 1;
+			for (; len && (buf[len - 1] == ' ' || !buf[len - 1]); len--);
+			buf[len] = 0;
+			return String<N>(Cstring(buf));
+		}
+
+		void _identify_controller()
+		{
+			_admin_command(IDENTIFY, [&] (Sqe &e) {
+				e.prp1  = _identify.phys();
+				e.cdw10 = CNS_CONTROLLER;
+			});
+
+			_serial = _identify_string<Serial::capacity()>(4);
+			_model  = _identify_string<Model::capacity()>(24);
+
+			/* the maximum data transfer size is given in minimum pages */
+			uint8_t const mdts = _identify_data<uint8_t>(77);
+			_max_transfer = mdts ? (size_t)PAGE_SIZE << mdts : ~(size_t)0;
+
+			_num_namespaces       = _identify_data<uint32_t>(516);
+			_dsm                  = _identify_data<uint16_t>(520) & ONCS_DSM;
+			_volatile_write_cache = _identify_data<uint8_t>(525) & 1;
+		}
+
+		void _identify_namespaces()
+		{
+			unsigned const count = min(_num_namespaces, (unsigned)MAX_NAMESPACES);
+			for (unsigned id = 1; id <= count; id++) {
+
+				_admin_command(IDENTIFY, [&] (Sqe &e) {
+					e.nsid  = id;
+					e.prp1  = _identify.phys();
+					e.cdw10 = CNS_NAMESPACE;
+				});
+
+				uint64_t const size = _identify_data<uint64_t>(0);
+				if (!size)
+					continue;
+
+				uint8_t  const flbas = _identify_data<uint8_t>(26) & 0xf;
+				uint32_t const lbaf  = _identify_data<uint32_t>(128 + 4*flbas);
+
+				_ns[_ns_count++] = Namespace { id, (size_t)1 << ((lbaf >> 16) & 0xff),
+				                               size };
+			}
+		}
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * Resets and enables the controller and identifies its namespaces.
+		 *
+		 * \throw Initialization_failed
+		 */
+		Controller(Env &env, Pci &pci, Mmio::Delayer &delayer)
+		: _env(env), _pci(pci), _delayer(delayer)
+		{
+			if (_regs.read<Registers::Cc::En>()) {
+				_regs.write<Registers::Cc::En>(0);
+				_wait_ready(false);
+			}
+
+			Registers::Aqa::access_t aqa = 0;
+			Registers::Aqa::Asqs::set(aqa, ADMIN_QUEUE_SIZE - 1);
+			Registers::Aqa::Acqs::set(aqa, ADMIN_QUEUE_SIZE - 1);
+			_regs.write<Registers::Aqa>(aqa);
+			_regs.write<Registers::Asq>(_admin.sq_phys());
+			_regs.write<Registers::Acq>(_admin.cq_phys());
+
+			Registers::Cc::access_t cc = 0;
+			Registers::Cc::Iosqes::set(cc, 6);
+			Registers::Cc::Iocqes::set(cc, 4);
+			Registers::Cc::En::set(cc, 1);
+			_regs.write<Registers::Cc>(cc);
+			_wait_ready(true);
+
+			if (_regs.read<Registers::Csts::Cfs>()) {
+				error("controller fatal status");
+				throw Initialization_failed();
+			}
+
+			_identify_controller();
+			_identify_namespaces();
+
+			log("NVMe ", _regs.read<Registers::Vs::Mjr>(), ".",
+			    _regs.read<Registers::Vs::Mnr>(), " model: ", _model,
+			    " serial: ", _serial);
+
+			for (unsigned i = 0; i < _ns_count; i++)
+				log("namespace ", _ns[i].id, ": ", _ns[i].block_count,
+				    " blocks of ", _ns[i].block_size, " bytes");
+		}
+
+		Registers &registers() { return _regs; }
+
+		Model  const &model()  const { return _model;  }
+		Serial const &serial() const { return _serial; }
+
+		/**
+		 * Return maximum number of entries of an I/O queue
+		 */
+		unsigned max_queue_size() const {
+			return _regs.read<Registers::Cap::Mqes>() + 1; }
+
+		size_t max_transfer()         const { return _max_transfer; }
+		bool   volatile_write_cache() const { return _volatile_write_cache; }
+		bool   dsm()                  const { return _dsm; }
+
+		/**
+		 * Return namespace with the given ID, or nullptr
+		 */
+		Namespace const *name_space(unsigned id) const
+		{
+			for (unsigned i = 0; i < _ns_count; i++)
+				if (_ns[i].id == id)
+					return &_ns[i];
+			return nullptr;
+		}
+
+		/**
+		 * Request 'count' I/O queue pairs
+		 *
+		 * \return number of queue pairs granted by the controller
+		 */
+		unsigned request_io_queues(unsigned count)
+		{
+			uint32_t const result = _admin_command(SET_FEATURES, [&] (Sqe &e) {
+				e.cdw10 = FEATURE_QUEUES;
+				e.cdw11 = (count - 1) | ((count - 1) << 16);
+			});
+
+			unsigned const sq = (result & 0xffff) + 1;
+			unsigned const cq = (result >> 16)    + 1;
+			return min(count, min(sq, cq));
+		}
+
+		/**
+		 * Create I/O queue pair at the controller
+		 *
+		 * \param vector  interrupt vector of the completion queue
+		 */
+		void create_io_queue(Queue_pair const &qp, unsigned vector)
+		{
+			_admin_command(CREATE_IO_CQ, [&] (Sqe &e) {
+				e.prp1  = qp.cq_phys();
+				e.cdw10 = qp.id() | ((qp.size() - 1) << 16);
+				e.cdw11 = QUEUE_CONTIGUOUS | CQ_IRQ_ENABLED | (vector << 16);
+			});
+
+			_admin_command(CREATE_IO_SQ, [&] (Sqe &e) {
+				e.prp1  = qp.sq_phys();
+				e.cdw10 = qp.id() | ((qp.size() - 1) << 16);
+				e.cdw11 = QUEUE_CONTIGUOUS | (qp.id() << 16);
+			});
+		}
+};
+
+#endif /* _NVME__NVME_H_ */
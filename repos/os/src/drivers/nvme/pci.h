@@ -0,0 +1,142 @@
+/*
+ * \brief  Access to the NVMe controller via the platform driver
+ * \author Genode Labs
+ * \date   2026-10-14
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _NVME__PCI_H_
+#define _NVME__PCI_H_
+
+/* Genode includes */
+#include <base/attached_dataspace.h>
+#include <io_mem_session/client.h>
+#include <irq_session/client.h>
+#include <platform_session/connection.h>
+#include <platform_device/client.h>
+#include <util/retry.h>
+
+namespace Nvme {
+
+	using namespace Genode;
+
+	struct Missing_controller : Exception { };
+
+	class Pci;
+}
+
+
+/**
+ * PCI device of the controller
+ *
+ * The platform session is used by the main entrypoint only, i.e., while
+ * probing the controller and when sessions get opened or closed.
+ */
+class Nvme::Pci
+{
+	private:
+
+		enum {
+			NVME_DEVICE = 0x010802u, /* mass storage, NVM, NVMe interface */
+			CLASS_MASK  = 0xffffffu,
+			PCI_CMD     = 0x4,
+			CMD_MEMORY  = 0x2,
+			CMD_MASTER  = 0x4,
+			BAR_MMIO    = 0,
+		};
+
+		Env &_env;
+
+		Platform::Connection                   _pci { _env };
+		Platform::Device_capability            _device_cap;
+		Constructible<Platform::Device_client> _device;
+		Constructible<Attached_dataspace>      _mmio;
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \throw Missing_controller
+		 */
+		Pci(Env &env) : _env(env)
+		{
+			_device_cap = _pci.with_upgrade([&] () {
+				return _pci.next_device(_device_cap, NVME_DEVICE, CLASS_MASK); });
+
+			if (!_device_cap.valid())
+				throw Missing_controller();
+
+			_device.construct(_device_cap);
+			log("NVMe controller found ("
+			    "vendor: ", Hex(_device->vendor_id()), " "
+			    "device: ", Hex(_device->device_id()), ")");
+
+			/* enable memory decoding and bus master */
+			unsigned const cmd =
+				_device->config_read(PCI_CMD, Platform::Device::ACCESS_16BIT);
+			_pci.with_upgrade([&] () {
+				_device->config_write(PCI_CMD, cmd | CMD_MEMORY | CMD_MASTER,
+				                      Platform::Device::ACCESS_16BIT); });
+
+			/*
+			 * The registers are mapped before requesting MSI-X vectors,
+			 * which enables the platform driver to program the MSI-X table
+			 * located in the same BAR via this mapping.
+			 */
+			Io_mem_session_capability const io_mem = _pci.with_upgrade([&] () {
+				return _device->io_mem(_device->phys_bar_to_virt(BAR_MMIO),
+				                       UNCACHED); });
+
+			Io_mem_session_client client(io_mem);
+			_mmio.construct(_env.rm(), client.dataspace());
+		}
+
+		addr_t mmio_base() const { return (addr_t)_mmio->local_addr<void>(); }
+
+		/**
+		 * Return number of MSI-X vectors available for the controller
+		 */
+		unsigned msi_x_vectors() { return _device->msi_x_vectors(); }
+
+		/**
+		 * Obtain IRQ session of MSI-X vector, delivered at 'cpu'
+		 */
+		Irq_session_capability msi_x(unsigned vector, Affinity::Location cpu)
+		{
+			return _pci.with_upgrade([&] () {
+				return _device->msi_x(vector, cpu.xpos()); });
+		}
+
+		/**
+		 * Obtain IRQ session of the legacy interrupt or MSI
+		 */
+		Irq_session_capability irq() { return _device->irq(0); }
+
+		Ram_dataspace_capability alloc_dma_buffer(size_t size)
+		{
+			size_t donate = size;
+
+			return retry<Out_of_ram>(
+				[&] () {
+					return retry<Out_of_caps>(
+						[&] () { return _pci.alloc_dma_buffer(size); },
+						[&] () { _pci.upgrade_caps(2); });
+				},
+				[&] () {
+					_pci.upgrade_ram(donate);
+					donate = donate * 2 > size ? 4096 : donate * 2;
+				});
+		}
+
+		void free_dma_buffer(Ram_dataspace_capability ds) {
+			_pci.free_dma_buffer(ds); }
+};
+
+#endif /* _NVME__PCI_H_ */
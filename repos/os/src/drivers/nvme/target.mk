@@ -0,0 +1,5 @@
+TARGET   = nvme_drv
+SRC_CC   = main.cc
+INC_DIR += $(PRG_DIR)
+LIBS    += base
+REQUIRES = x86
@@ -189,12 +189,13 @@ void Platform::Irq_session_component::ack_irq()
 Platform::Irq_session_component::Irq_session_component(unsigned irq,
                                                        addr_t pci_config_space,
                                                        Genode::Env       &env,
-                                                       Genode::Allocator &heap)
+                                                       Genode::Allocator &heap,
+                                                       int                cpu)
 :
 	_gsi(irq)
 {
-	/* invalid irq number for pci_devices */
-	if (_gsi >= INVALID_IRQ)
+	/* invalid irq number for pci_devices, MSI-X vectors go without GSI */
+	if (_gsi >= INVALID_IRQ && pci_config_space == ~0UL)
 		return;
 
 	if (pci_config_space != ~0UL) {
@@ -206,7 +207,7 @@ Platform::Irq_session_component::Irq_session_component(unsigned irq,
 
 				_irq_conn.construct(env, msi, Irq_session::TRIGGER_UNCHANGED,
 				                    Irq_session::POLARITY_UNCHANGED,
-				                    pci_config_space);
+				                    pci_config_space, cpu);
 
 				_msi_info = _irq_conn->info();
 				if (_msi_info.type == Irq_session::Info::Type::MSI) {
@@ -215,10 +216,14 @@ Platform::Irq_session_component::Irq_session_component(unsigned irq,
 				}
 			} catch (Genode::Service_denied) { }
 
+			_irq_conn.destruct();
 			irq_alloc.free_msi(msi);
 		}
 	}
 
+	if (_gsi >= INVALID_IRQ)
+		return;
+
 	Genode::Irq_session::Trigger  trigger;
 	Genode::Irq_session::Polarity polarity;
 
@@ -43,8 +43,20 @@ class Platform::Irq_session_component : public Genode::Rpc_object<Genode::Irq_se
 
 		enum { INVALID_IRQ = 0xffU };
 
-		Irq_session_component(unsigned, Genode::addr_t, Genode::Env &,
-		                      Genode::Allocator &heap);
+		/**
+		 * Constructor
+		 *
+		 * \param irq               GSI of the device or 'INVALID_IRQ' if
+		 *                          only an MSI is acceptable
+		 * \param pci_config_space  physical address of the extended PCI
+		 *                          config space of the device to use MSI,
+		 *                          or ~0UL to use the GSI
+		 * \param cpu               CPU that receives the MSI, -1 for the
+		 *                          default CPU
+		 */
+		Irq_session_component(unsigned irq, Genode::addr_t pci_config_space,
+		                      Genode::Env &, Genode::Allocator &heap,
+		                      int cpu = -1);
 		~Irq_session_component();
 
 		bool msi()
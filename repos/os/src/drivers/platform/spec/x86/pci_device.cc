@@ -134,8 +134,7 @@ void Platform::Device_component::config_write(unsigned char address,
 		}
 	}
 
-	_device_config.write(&_config_access, address, value, size,
-	                     _device_config.DONT_TRACK_ACCESS);
+	_config_write(address, value, size);
 }
 
 Genode::Irq_session_capability Platform::Device_component::irq(Genode::uint8_t id)
@@ -159,9 +158,11 @@ Genode::Irq_session_capability Platform::Device_component::irq(Genode::uint8_t i
 		return _irq_session->cap();
 	}
 
+	bool const msi = _session.msi_usage() && _msi_cap() && !_msi_x_in_use();
+
 	_irq_session = construct_at<Irq_session_component>(_mem_irq_component,
 	                                                   _configure_irq(_irq_line),
-	                                                   (!_session.msi_usage() || !_msi_cap()) ? ~0UL : _config_space,
+	                                                   msi ? _config_space : ~0UL,
 	                                                   _env, _global_heap);
 	_env.ep().rpc_ep().manage(_irq_session);
 
@@ -227,3 +228,158 @@ Genode::Irq_session_capability Platform::Device_component::irq(Genode::uint8_t i
 
 	return _irq_session->cap();
 }
+
+
+unsigned Platform::Device_component::msi_x_vectors()
+{
+	if (!_device_config.valid() || !_session.msi_usage())
+		return 0;
+
+	Genode::uint16_t const cap = _msi_x_cap();
+	if (!cap)
+		return 0;
+
+	Genode::uint16_t const ctrl = _device_config.read(&_config_access, cap + 2,
+	                                                  Platform::Device::ACCESS_16BIT);
+
+	return Genode::min((ctrl & 0x7ffU) + 1, (unsigned)MAX_MSI_X_VECTORS);
+}
+
+
+void Platform::Device_component::_write_msi_x_entry(Genode::uint16_t const cap,
+                                                    Genode::uint16_t const vector,
+                                                    Genode::addr_t   const address,
+                                                    Genode::uint32_t const data,
+                                                    bool             const masked)
+{
+	using Genode::addr_t;
+	using Genode::uint32_t;
+
+	uint32_t const table = _device_config.read(&_config_access, cap + 4,
+	                                           Platform::Device::ACCESS_32BIT);
+	unsigned const bir   = table & 0x7;
+
+	Resource const res = resource(bir);
+	if (bir >= Device::NUM_RESOURCES || res.type() != Resource::MEMORY) {
+		Genode::error(_device_config, " MSI-X table in invalid BAR ", bir);
+		throw Genode::Service_denied();
+	}
+
+	addr_t const entry = res.base() + (table & ~0x7U) + vector*MSI_X_ENTRY_SIZE;
+
+	auto write = [&] (addr_t local)
+	{
+		volatile uint32_t *reg = (volatile uint32_t *)local;
+
+		reg[3] = MSI_X_ENTRY_MASKED;
+		reg[0] = address & ~0U;
+		reg[1] = sizeof(address) > 4 ? (Genode::uint64_t)address >> 32 : 0;
+		reg[2] = data;
+		reg[3] = masked ? MSI_X_ENTRY_MASKED : 0;
+	};
+
+	for (Io_mem *io_mem = _io_mem[bir].first(); io_mem; io_mem = io_mem->next()) {
+		if (entry < io_mem->base ||
+		    entry + MSI_X_ENTRY_SIZE > io_mem->base + io_mem->size)
+			continue;
+
+		Genode::Attached_dataspace ds(_env.rm(), io_mem->dataspace());
+		write((addr_t)ds.local_addr<char>() + (io_mem->base & 0xfffUL)
+		      + (entry - io_mem->base));
+		return;
+	}
+
+	Genode::Attached_io_mem_dataspace ds(_env, entry, MSI_X_ENTRY_SIZE);
+	write((addr_t)ds.local_addr<char>());
+}
+
+
+void Platform::Device_component::_disable_msi_x()
+{
+	Genode::uint16_t const cap = _msi_x_cap();
+	if (!cap)
+		return;
+
+	Genode::uint16_t const ctrl = _device_config.read(&_config_access, cap + 2,
+	                                                  Platform::Device::ACCESS_16BIT);
+	if (ctrl & MSI_X_ENABLED)
+		_device_config.write(&_config_access, cap + 2,
+		                     ctrl & ~(MSI_X_ENABLED | MSI_X_FUNCTION_MASK),
+		                     Platform::Device::ACCESS_16BIT);
+}
+
+
+Genode::Irq_session_capability Platform::Device_component::msi_x(Genode::uint16_t const vector,
+                                                                 unsigned const cpu)
+{
+	if (vector >= msi_x_vectors())
+		return Genode::Irq_session_capability();
+
+	if (_msi_x_irq[vector])
+		return _msi_x_irq[vector]->cap();
+
+	if (_irq_session && _irq_session->msi()) {
+		Genode::error(_device_config, " MSI-X unavailable, device uses MSI");
+		return Genode::Irq_session_capability();
+	}
+
+	Irq_session_component * const irq = new (_md_alloc)
+		Irq_session_component(Irq_session_component::INVALID_IRQ,
+		                      _config_space, _env, _global_heap, (int)cpu);
+
+	if (!irq->msi()) {
+		Genode::error(_device_config, " no MSI available for MSI-X vector ", vector);
+		Genode::destroy(_md_alloc, irq);
+		return Genode::Irq_session_capability();
+	}
+
+	Genode::uint16_t const cap   = _msi_x_cap();
+	bool             const first = !_msi_x_in_use();
+
+	Genode::uint16_t const ctrl = _device_config.read(&_config_access, cap + 2,
+	                                                  Platform::Device::ACCESS_16BIT);
+
+	/* enable MSI-X with all vectors masked while programming the table */
+	if (first) {
+		Genode::uint16_t const msi_cap = _msi_cap();
+		if (msi_cap) {
+			Genode::uint16_t const msi = _device_config.read(&_config_access,
+			                                                 msi_cap + 2,
+			                                                 Platform::Device::ACCESS_16BIT);
+			if (msi & MSI_ENABLED)
+				_device_config.write(&_config_access, msi_cap + 2,
+				                     msi ^ MSI_ENABLED,
+				                     Platform::Device::ACCESS_8BIT);
+		}
+
+		_device_config.write(&_config_access, cap + 2,
+		                     ctrl | MSI_X_ENABLED | MSI_X_FUNCTION_MASK,
+		                     Platform::Device::ACCESS_16BIT);
+	}
+
+	try {
+		_write_msi_x_entry(cap, vector, irq->msi_address(), irq->msi_data(), false);
+	} catch (...) {
+		Genode::destroy(_md_alloc, irq);
+		if (first)
+			_disable_msi_x();
+
+		Genode::error(_device_config, " could not program MSI-X vector ", vector);
+		return Genode::Irq_session_capability();
+	}
+
+	if (first)
+		_device_config.write(&_config_access, cap + 2,
+		                     (ctrl | MSI_X_ENABLED) & ~MSI_X_FUNCTION_MASK,
+		                     Platform::Device::ACCESS_16BIT);
+
+	_msi_x_irq[vector] = irq;
+	_env.ep().rpc_ep().manage(irq);
+
+	Genode::log(_device_config, " uses MSI-X vector ", vector, ", "
+	            "CPU ", cpu, ", "
+	            "vector ", Genode::Hex(irq->msi_data()), ", "
+	            "address ", Genode::Hex(irq->msi_address()));
+
+	return irq->cap();
+}
@@ -15,6 +15,8 @@
 
 /* base */
 #include <base/rpc_server.h>
+#include <base/attached_io_mem_dataspace.h>
+#include <base/attached_dataspace.h>
 #include <io_mem_session/connection.h>
 #include <util/list.h>
 #include <util/mmio.h>
@@ -44,15 +46,24 @@ class Platform::Device_component : public Genode::Rpc_object<Platform::Device>,
 
 		Genode::Constructible<Genode::Io_mem_connection> _io_mem_config_extended;
 
+		/* local mapping of the extended config space */
+		Genode::Constructible<Genode::Attached_dataspace> _config_mmio;
+		bool                                              _config_mmio_failed = false;
+
 		Genode::Allocator           &_global_heap;
 
 		class Io_mem : public Genode::Io_mem_connection,
 		               public Genode::List<Io_mem>::Element
 		{
 			public:
+
+				Genode::addr_t const base;
+				Genode::size_t const size;
+
 				Io_mem (Genode::Env &env, Genode::addr_t base,
 			            Genode::size_t size, bool wc)
-				: Genode::Io_mem_connection(env, base, size, wc) { }
+				: Genode::Io_mem_connection(env, base, size, wc),
+				  base(base), size(size) { }
 		};
 
 		enum {
@@ -67,7 +78,18 @@ class Platform::Device_component : public Genode::Rpc_object<Platform::Device>,
 
 			CAP_MSI_64    = 0x80,
 			CAP_MASK      = 0x100,
-			MSI_ENABLED   = 0x1
+			MSI_ENABLED   = 0x1,
+
+			CAP_MSI       = 0x05,
+			CAP_MSI_X     = 0x11,
+
+			MSI_X_ENABLED       = 0x8000,
+			MSI_X_FUNCTION_MASK = 0x4000,
+			MSI_X_ENTRY_SIZE    = 16,
+			MSI_X_ENTRY_MASKED  = 0x1,
+
+			/* max. number of MSI-X vectors handed out per device */
+			MAX_MSI_X_VECTORS  = 64,
 		};
 
 		Genode::Tslab<Genode::Io_port_connection, IO_BLOCK_SIZE> _slab_ioport;
@@ -78,6 +100,10 @@ class Platform::Device_component : public Genode::Rpc_object<Platform::Device>,
 
 		char _mem_irq_component[sizeof(Irq_session_component)];
 
+		Irq_session_component *_msi_x_irq[MAX_MSI_X_VECTORS];
+
+		Genode::Allocator &_md_alloc;
+
 		Genode::Io_port_connection *_io_port_conn [Device::NUM_RESOURCES];
 		Genode::List<Io_mem> _io_mem [Device::NUM_RESOURCES];
 
@@ -89,11 +115,11 @@ class Platform::Device_component : public Genode::Rpc_object<Platform::Device>,
 
 
 		/**
-		 * Read out msi capabilities of the device.
+		 * Look up capability 'id' in the capability list of the device
 		 */
-		Genode::uint16_t _msi_cap()
+		Genode::uint16_t _find_cap(Genode::uint8_t const id)
 		{
-			enum { PCI_STATUS = 0x6, PCI_CAP_OFFSET = 0x34, CAP_MSI = 0x5 };
+			enum { PCI_STATUS = 0x6, PCI_CAP_OFFSET = 0x34 };
 
 			Status::access_t status = Status::read(_device_config.read(&_config_access,
 			                                       PCI_STATUS,
@@ -108,7 +134,7 @@ class Platform::Device_component : public Genode::Rpc_object<Platform::Device>,
 			for (Genode::uint16_t val = 0; cap; cap = val >> 8) {
 				val = _device_config.read(&_config_access, cap,
 				                          Platform::Device::ACCESS_16BIT);
-				if ((val & 0xff) != CAP_MSI)
+				if ((val & 0xff) != id)
 					continue;
 
 				return cap;
@@ -117,6 +143,39 @@ class Platform::Device_component : public Genode::Rpc_object<Platform::Device>,
 			return 0;
 		}
 
+		/**
+		 * Read out msi capabilities of the device.
+		 */
+		Genode::uint16_t _msi_cap() { return _find_cap(CAP_MSI); }
+
+		/**
+		 * Read out msi-x capabilities of the device.
+		 */
+		Genode::uint16_t _msi_x_cap() { return _find_cap(CAP_MSI_X); }
+
+		bool _msi_x_in_use() const
+		{
+			for (unsigned i = 0; i < MAX_MSI_X_VECTORS; i++)
+				if (_msi_x_irq[i])
+					return true;
+			return false;
+		}
+
+		/**
+		 * Write MSI-X table entry of 'vector'
+		 *
+		 * The table resides in a memory BAR of the device. If the client
+		 * obtained an I/O-memory session covering the table via 'io_mem',
+		 * the entry is written through this session. Otherwise, the page
+		 * of the entry is mapped only temporarily because core hands out
+		 * each I/O-memory range only once.
+		 */
+		void _write_msi_x_entry(Genode::uint16_t cap, Genode::uint16_t vector,
+		                        Genode::addr_t address, Genode::uint32_t data,
+		                        bool masked);
+
+		void _disable_msi_x();
+
 
 		/**
 		 * Disable MSI if already enabled.
@@ -156,6 +215,10 @@ class Platform::Device_component : public Genode::Rpc_object<Platform::Device>,
 				                     msi ^ MSI_ENABLED,
 				                     Platform::Device::ACCESS_8BIT);
 
+			/* MSI and MSI-X must not be enabled at the same time */
+			if (!_msi_x_in_use())
+				_disable_msi_x();
+
 			return irq;
 		}
 
@@ -180,6 +243,77 @@ class Platform::Device_component : public Genode::Rpc_object<Platform::Device>,
 				                     Platform::Device::ACCESS_16BIT);
 		}
 
+		/**
+		 * Return memory-mapped config space (ECAM) of the device
+		 *
+		 * Accessing the config space via memory is much cheaper than via
+		 * the I/O ports, which take two port accesses per register.
+		 *
+		 * \return  nullptr if the device has no extended config space
+		 */
+		Genode::uint8_t volatile *_config_mmio_base()
+		{
+			if (!_config_mmio.constructed() && !_config_mmio_failed) {
+				Genode::Io_mem_dataspace_capability const ds = get_config_space();
+				try {
+					if (ds.valid())
+						_config_mmio.construct(_env.rm(), ds);
+				} catch (...) { }
+
+				_config_mmio_failed = !_config_mmio.constructed();
+			}
+
+			return _config_mmio.constructed()
+			       ? _config_mmio->local_addr<Genode::uint8_t volatile>()
+			       : nullptr;
+		}
+
+		unsigned _config_read(unsigned char address, Access_size size)
+		{
+			using namespace Genode;
+
+			uint8_t volatile * const mmio = _config_mmio_base();
+			if (!mmio)
+				return _device_config.read(&_config_access, address, size,
+				                           _device_config.DONT_TRACK_ACCESS);
+
+			switch (size) {
+			case Access_size::ACCESS_8BIT:
+				return mmio[address];
+			case Access_size::ACCESS_16BIT:
+				return *(uint16_t volatile *)(mmio + (address & ~1U));
+			case Access_size::ACCESS_32BIT:
+				return *(uint32_t volatile *)(mmio + (address & ~3U));
+			default:
+				return ~0U;
+			}
+		}
+
+		void _config_write(unsigned char address, unsigned value,
+		                   Access_size size)
+		{
+			using namespace Genode;
+
+			uint8_t volatile * const mmio = _config_mmio_base();
+			if (!mmio) {
+				_device_config.write(&_config_access, address, value, size,
+				                     _device_config.DONT_TRACK_ACCESS);
+				return;
+			}
+
+			switch (size) {
+			case Access_size::ACCESS_8BIT:
+				mmio[address] = value;
+				break;
+			case Access_size::ACCESS_16BIT:
+				*(uint16_t volatile *)(mmio + (address & ~1U)) = value;
+				break;
+			case Access_size::ACCESS_32BIT:
+				*(uint32_t volatile *)(mmio + (address & ~3U)) = value;
+				break;
+			}
+		}
+
 	public:
 
 		/**
@@ -198,12 +332,16 @@ class Platform::Device_component : public Genode::Rpc_object<Platform::Device>,
 			                              Platform::Device::ACCESS_8BIT)),
 			_global_heap(global_heap),
 			_slab_ioport(&md_alloc, &_slab_ioport_block_data),
-			_slab_iomem(&md_alloc, &_slab_iomem_block_data)
+			_slab_iomem(&md_alloc, &_slab_iomem_block_data),
+			_md_alloc(md_alloc)
 		{
 			for (unsigned i = 0; i < Device::NUM_RESOURCES; i++) {
 				_io_port_conn[i] = nullptr;
 			}
 
+			for (unsigned i = 0; i < MAX_MSI_X_VECTORS; i++)
+				_msi_x_irq[i] = nullptr;
+
 			_disable_bus_master_dma();
 		}
 
@@ -220,10 +358,14 @@ class Platform::Device_component : public Genode::Rpc_object<Platform::Device>,
 			_irq_line(irq),
 			_global_heap(global_heap),
 			_slab_ioport(nullptr, &_slab_ioport_block_data),
-			_slab_iomem(nullptr, &_slab_iomem_block_data)
+			_slab_iomem(nullptr, &_slab_iomem_block_data),
+			_md_alloc(global_heap)
 		{
 			for (unsigned i = 0; i < Device::NUM_RESOURCES; i++)
 				_io_port_conn[i] = nullptr;
+
+			for (unsigned i = 0; i < MAX_MSI_X_VECTORS; i++)
+				_msi_x_irq[i] = nullptr;
 		}
 
 		/**
@@ -236,6 +378,17 @@ class Platform::Device_component : public Genode::Rpc_object<Platform::Device>,
 				_irq_session->~Irq_session();
 			}
 
+			if (_msi_x_in_use())
+				_disable_msi_x();
+
+			for (unsigned i = 0; i < MAX_MSI_X_VECTORS; i++) {
+				if (!_msi_x_irq[i])
+					continue;
+
+				_env.ep().rpc_ep().dissolve(_msi_x_irq[i]);
+				Genode::destroy(_md_alloc, _msi_x_irq[i]);
+			}
+
 			for (unsigned i = 0; i < Device::NUM_RESOURCES; i++) {
 				if (_io_port_conn[i])
 					Genode::destroy(_slab_ioport, _io_port_conn[i]);
@@ -302,11 +455,8 @@ class Platform::Device_component : public Genode::Rpc_object<Platform::Device>,
 			return _device_config.resource(resource_id);
 		}
 
-		unsigned config_read(unsigned char address, Access_size size) override
-		{
-			return _device_config.read(&_config_access, address, size,
-			                           _device_config.DONT_TRACK_ACCESS);
-		}
+		unsigned config_read(unsigned char address, Access_size size) override {
+			return _config_read(address, size); }
 
 		void config_write(unsigned char address, unsigned value,
 		                  Access_size size) override;
@@ -315,6 +465,10 @@ class Platform::Device_component : public Genode::Rpc_object<Platform::Device>,
 
 		Genode::Io_port_session_capability io_port(Genode::uint8_t) override;
 
+		unsigned msi_x_vectors() override;
+
+		Genode::Irq_session_capability msi_x(Genode::uint16_t, unsigned) override;
+
 		Genode::Io_mem_session_capability io_mem(Genode::uint8_t,
 		                                         Genode::Cache_attribute,
 		                                         Genode::addr_t,
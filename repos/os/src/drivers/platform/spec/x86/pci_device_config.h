@@ -154,7 +154,7 @@ namespace Platform {
 				      ".", Hex(_function, Hex::Prefix::OMIT_PREFIX));
 			}
 
-			Genode::uint16_t bdf () {
+			Genode::uint16_t bdf () const {
 				return (_bus << 8) | (_device << 3) | (_function & 0x7); }
 
 			/**
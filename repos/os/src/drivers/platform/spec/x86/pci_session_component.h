@@ -15,6 +15,7 @@
 
 /* base */
 #include <base/allocator_guard.h>
+#include <base/attached_dataspace.h>
 #include <base/attached_rom_dataspace.h>
 #include <base/heap.h>
 #include <base/rpc_server.h>
@@ -54,14 +55,18 @@ class Platform::Ram_dataspace : public Genode::List<Ram_dataspace>::Element {
 
 	private:
 		Ram_capability const _cap;
+		Genode::size_t const _size;
 
 	public:
-		Ram_dataspace(Ram_capability c) : _cap(c) { }
+		Ram_dataspace(Ram_capability c, Genode::size_t size = 0)
+		: _cap(c), _size(size) { }
 
 		bool match(const Ram_capability &cap) const {
 			return cap.local_name() == _cap.local_name(); }
 
 		Ram_capability cap() const { return _cap; }
+
+		Genode::size_t size() const { return _size; }
 };
 
 class Platform::Rmrr : public Genode::List<Platform::Rmrr>::Element
@@ -130,70 +135,117 @@ class Platform::Rmrr : public Genode::List<Platform::Rmrr>::Element
 };
 
 
+/**
+ * Table of all PCI devices found at start-up
+ *
+ * The buses are scanned only once. Reading the config space of each
+ * function, and sizing the base-address registers in particular, is far
+ * too costly to be repeated whenever a session enumerates devices.
+ */
 class Platform::Pci_buses
 {
 	private:
 
+		Genode::Allocator &_heap;
+
 		Genode::Bit_array<Device_config::MAX_BUSES> _valid;
 
+		/* devices sorted by bdf */
+		Device_config *_devices  = nullptr;
+		unsigned       _count    = 0;
+		unsigned       _capacity = 0;
+
 		void scan_bus(Config_access &config_access, Genode::Allocator &heap,
 		              unsigned char bus = 0);
 
-		bool _bus_valid(int bus)
+		void _add(Device_config const &config)
 		{
-			if (bus >= Device_config::MAX_BUSES)
-				return false;
+			using Genode::construct_at;
+
+			unsigned const i = _lower_bound(config.bdf());
 
-			return _valid.get(bus, 1);
+			/* bus reachable via more than one bridge */
+			if (i < _count && _devices[i].bdf() == config.bdf())
+				return;
+
+			if (_count == _capacity) {
+				unsigned const capacity = _capacity ? 2*_capacity : 64;
+
+				Device_config *devices = (Device_config *)
+					_heap.alloc(capacity * sizeof(Device_config));
+				for (unsigned j = 0; j < _count; j++)
+					construct_at<Device_config>(&devices[j], _devices[j]);
+
+				if (_devices)
+					_heap.free(_devices, _capacity * sizeof(Device_config));
+
+				_devices  = devices;
+				_capacity = capacity;
+			}
+
+			/* keep table sorted by bdf */
+			for (unsigned j = _count; j > i; j--)
+				_devices[j] = _devices[j - 1];
+
+			construct_at<Device_config>(&_devices[i], config);
+			_count++;
+		}
+
+		/**
+		 * Return index of first device at or behind 'bdf'
+		 */
+		unsigned _lower_bound(unsigned bdf) const
+		{
+			unsigned lo = 0, hi = _count;
+			while (lo < hi) {
+				unsigned const mid = (lo + hi) / 2;
+				if (_devices[mid].bdf() < bdf)
+					lo = mid + 1;
+				else
+					hi = mid;
+			}
+			return lo;
 		}
 
 	public:
 
-		Pci_buses(Genode::Env &env, Genode::Allocator &heap)
+		Pci_buses(Genode::Env &env, Genode::Allocator &heap) : _heap(heap)
 		{
 			Config_access c(env);
 			scan_bus(c, heap);
 		}
 
+		~Pci_buses()
+		{
+			if (_devices)
+				_heap.free(_devices, _capacity * sizeof(Device_config));
+		}
+
 		/**
-		 * Scan PCI buses for a device
+		 * Look up next device in the device table
 		 *
-		 * \param bus                start scanning at bus number
-		 * \param device             start scanning at device number
-		 * \param function           start scanning at function number
+		 * \param bus                start at bus number
+		 * \param device             start at device number
+		 * \param function           start at function number, which may
+		 *                           exceed the functions of 'device'
 		 * \param out_device_config  device config information of the
 		 *                           found device
-		 * \param config_access      interface for accessing the PCI
-		 *                           configuration
-		 *                           space
 		 *
 		 * \retval true   device was found
 		 * \retval false  no device was found
 		 */
 		bool find_next(int bus, int device, int function,
-		               Device_config *out_device_config,
-		               Config_access *config_access)
+		               Device_config *out_device_config) const
 		{
-			for (; bus < Device_config::MAX_BUSES; bus++) {
-				if (!_bus_valid(bus))
-					continue;
+			unsigned const bdf = (bus * Device_config::MAX_DEVICES + device)
+			                   * Device_config::MAX_FUNCTIONS + function;
 
-				for (; device < Device_config::MAX_DEVICES; device++) {
-					for (; function < Device_config::MAX_FUNCTIONS; function++) {
-
-						/* read config space */
-						Device_config config(bus, device, function, config_access);
+			unsigned const i = _lower_bound(bdf);
+			if (i >= _count)
+				return false;
 
-						if (config.valid()) {
-							*out_device_config = config;
-							return true;
-						}
-					}
-					function = 0; /* init value for next device */
-				}
-				device = 0; /* init value for next bus */
-			}
-			return false;
+			*out_device_config = _devices[i];
+			return true;
 		}
 };
 
@@ -241,6 +293,94 @@ class Platform::Session_component : public Genode::Rpc_object<Session>
 
 		Platform::Device_pd _device_pd { _env, _label, _ram_guard, _cap_guard };
 
+		/*
+		 * Pool of freed DMA buffers
+		 *
+		 * Drivers tend to free and re-allocate DMA buffers of the same sizes.
+		 * Freed buffers are kept with their mapping in the device PD and
+		 * handed out again, which saves the RAM allocation as well as the
+		 * IOMMU mapping and unmapping of the buffer. The pooled buffers
+		 * remain accounted to the session.
+		 */
+		enum { MAX_POOLED_DMA_BUFFERS = 16,
+		       MAX_POOLED_DMA_SIZE    = 4*1024*1024 };
+
+		Genode::List<Platform::Ram_dataspace> _dma_pool;
+
+		unsigned       _dma_pool_count = 0;
+		Genode::size_t _dma_pool_size  = 0;
+
+		struct Dma_stats
+		{
+			unsigned long allocs = 0, reused = 0, mapped = 0, released = 0;
+		} _dma_stats;
+
+		bool const _verbose_dma = _policy.attribute_value("verbose_dma", false);
+
+		Ram_capability _dma_pool_take(Genode::size_t size)
+		{
+			for (Platform::Ram_dataspace *ds = _dma_pool.first(); ds;
+			     ds = ds->next()) {
+
+				if (ds->size() != size)
+					continue;
+
+				_dma_pool.remove(ds);
+				_dma_pool_count--;
+				_dma_pool_size -= size;
+
+				Ram_capability const cap = ds->cap();
+				destroy(_md_alloc, ds);
+				return cap;
+			}
+			return Ram_capability();
+		}
+
+		/**
+		 * Return pooled buffers to the RAM allocator
+		 *
+		 * \return  true if any buffer was released
+		 */
+		bool _dma_pool_flush()
+		{
+			bool released = false;
+
+			while (Platform::Ram_dataspace *ds = _dma_pool.first()) {
+				_dma_pool.remove(ds);
+				_env_ram.free(ds->cap());
+				destroy(_md_alloc, ds);
+				_dma_stats.released++;
+				released = true;
+			}
+			_dma_pool_count = 0;
+			_dma_pool_size  = 0;
+
+			return released;
+		}
+
+		/**
+		 * Keep freed buffer for reuse, returns false if the pool is full
+		 */
+		bool _dma_pool_put(Ram_capability cap)
+		{
+			Genode::size_t const size = Genode::Dataspace_client(cap).size();
+
+			if (_dma_pool_count >= MAX_POOLED_DMA_BUFFERS
+			 || _dma_pool_size + size > MAX_POOLED_DMA_SIZE)
+				return false;
+
+			/* buffers are handed out cleared, as are new RAM dataspaces */
+			try {
+				Genode::Attached_dataspace ds(_env.rm(), cap);
+				Genode::memset(ds.local_addr<void>(), 0, size);
+			} catch (...) { return false; }
+
+			_dma_pool.insert(new (_md_alloc) Platform::Ram_dataspace(cap, size));
+			_dma_pool_count++;
+			_dma_pool_size += size;
+			return true;
+		}
+
 		enum { MAX_PCI_DEVICES = Device_config::MAX_BUSES *
 		                         Device_config::MAX_DEVICES *
 		                         Device_config::MAX_FUNCTIONS };
@@ -291,6 +431,7 @@ class Platform::Session_component : public Genode::Rpc_object<Session>
 				{ "AUDIO"    , 0x4, 0x01, 0x0},
 				{ "ETHERNET" , 0x2, 0x00, 0x0},
 				{ "HDAUDIO"  , 0x4, 0x03, 0x0},
+				{ "NVME"     , 0x1, 0x08, 0x0},
 				{ "USB"      , 0xc, 0x03, 0x0},
 				{ "VGA"      , 0x3, 0x00, 0x0},
 				{ "WIFI"     , 0x2, 0x80, 0x0},
@@ -582,6 +723,14 @@ class Platform::Session_component : public Genode::Rpc_object<Session>
 				_env_ram.free(ds->cap());
 				destroy(_md_alloc, ds);
 			}
+
+			_dma_pool_flush();
+
+			if (_verbose_dma)
+				Genode::log(_label, ": DMA buffers allocated=", _dma_stats.allocs,
+				            " reused=", _dma_stats.reused,
+				            " mapped=", _dma_stats.mapped,
+				            " released=", _dma_stats.released);
 		}
 
 
@@ -632,12 +781,6 @@ class Platform::Session_component : public Genode::Rpc_object<Session>
 		                              unsigned device_class,
 		                              unsigned class_mask) override
 		{
-			/*
-			 * Create the interface to the PCI config space.
-			 * This involves the creation of I/O port sessions.
-			 */
-			Config_access config_access(_env);
-
 			/* lookup device component for previous device */
 			auto lambda = [&] (Device_component *prev)
 			{
@@ -664,8 +807,7 @@ class Platform::Session_component : public Genode::Rpc_object<Session>
 
 				while (true) {
 					function += 1;
-					if (!_pci_bus.find_next(bus, device, function, &config,
-					                        &config_access))
+					if (!_pci_bus.find_next(bus, device, function, &config))
 						return Device_capability();
 
 					/* get new bdf values */
@@ -784,7 +926,22 @@ class Platform::Session_component : public Genode::Rpc_object<Session>
 
 		Ram_capability alloc_dma_buffer(Genode::size_t const size) override
 		{
-			Ram_capability ram_cap = _env_ram.alloc(size, Genode::UNCACHED);
+			_dma_stats.allocs++;
+
+			/* RAM dataspaces are allocated at page granularity */
+			Genode::size_t const ds_size = Genode::align_addr(size, 12);
+
+			Ram_capability ram_cap = _dma_pool_take(ds_size);
+			if (ram_cap.valid()) {
+				_dma_stats.reused++;
+				_insert(ram_cap);
+				return ram_cap;
+			}
+
+			/* pooled buffers may stand in the way of the new allocation */
+			ram_cap = Genode::retry<Genode::Out_of_ram>(
+				[&] () { return _env_ram.alloc(size, Genode::UNCACHED); },
+				[&] () { if (!_dma_pool_flush()) throw Genode::Out_of_ram(); });
 
 			if (!ram_cap.valid())
 				return ram_cap;
@@ -800,6 +957,7 @@ class Platform::Session_component : public Genode::Rpc_object<Session>
 				throw Genode::Out_of_caps();
 			}
 
+			_dma_stats.mapped++;
 			return ram_cap;
 		}
 
@@ -808,7 +966,11 @@ class Platform::Session_component : public Genode::Rpc_object<Session>
 			if (!ram_cap.valid() || !_remove(ram_cap))
 				return;
 
+			if (_dma_pool_put(ram_cap))
+				return;
+
 			_env_ram.free(ram_cap);
+			_dma_stats.released++;
 		}
 
 		Device_capability device(String const &name) override;
@@ -858,8 +1020,16 @@ class Platform::Root : public Genode::Root_component<Session_component>
 			if (!xml_acpi.has_type("acpi"))
 				throw 1;
 
-			for (unsigned i = 0; i < xml_acpi.num_sub_nodes(); i++) {
-				Xml_node node = xml_acpi.sub_node(i);
+			/*
+			 * Routing entries arrive grouped by bridge. Hence, remember the
+			 * outcome of the config-space probing of the last bridge.
+			 */
+			unsigned last_bridge_bdf   = ~0U;
+			unsigned mapped_bridge_bdf = 0;
+			bool     bridge_valid      = false;
+
+			/* iterate once instead of indexing each sub node from the start */
+			xml_acpi.for_each_sub_node([&] (Xml_node node) {
 
 				if (node.has_type("bdf")) {
 
@@ -937,7 +1107,7 @@ class Platform::Root : public Genode::Root_component<Session_component>
 				}
 
 				if (!node.has_type("routing"))
-					continue;
+					return;
 
 				unsigned gsi;
 				unsigned bridge_bdf;
@@ -949,31 +1119,38 @@ class Platform::Root : public Genode::Root_component<Session_component>
 				node.attribute("device").value(&device);
 				node.attribute("device_pin").value(&device_pin);
 
-				/* check that bridge bdf is actually a valid device */
-				Device_config config((bridge_bdf >> 8 & 0xff),
-				                     (bridge_bdf >> 3) & 0x1f,
-				                      bridge_bdf & 0x7, &config_access);
+				if (bridge_bdf != last_bridge_bdf) {
+					last_bridge_bdf = bridge_bdf;
+
+					/* check that bridge bdf is actually a valid device */
+					Device_config config((bridge_bdf >> 8 & 0xff),
+					                     (bridge_bdf >> 3) & 0x1f,
+					                      bridge_bdf & 0x7, &config_access);
+
+					bridge_valid      = config.valid();
+					mapped_bridge_bdf = bridge_bdf;
+
+					if (bridge_valid && !config.pci_bridge() && bridge_bdf != 0)
+						/**
+						 * If the bridge bdf has not a type header of a bridge in
+						 * the pci config space, then it should be the host bridge
+						 * device. The host bridge device need not to be
+						 * necessarily at 0:0.0, it may be on another location. The
+						 * irq routing information for the host bridge however
+						 * contain entries for the bridge bdf to be 0:0.0 -
+						 * therefore we override it here for the irq rerouting
+						 * information of host bridge devices.
+						 */
+						mapped_bridge_bdf = 0;
+				}
 
-				if (!config.valid())
-					continue;
+				if (!bridge_valid)
+					return;
 
-				if (!config.pci_bridge() && bridge_bdf != 0)
-					/**
-					 * If the bridge bdf has not a type header of a bridge in
-					 * the pci config space, then it should be the host bridge
-					 * device. The host bridge device need not to be
-					 * necessarily at 0:0.0, it may be on another location. The
-					 * irq routing information for the host bridge however
-					 * contain entries for the bridge bdf to be 0:0.0 -
-					 * therefore we override it here for the irq rerouting
-					 * information of host bridge devices.
-					 */
-					bridge_bdf = 0;
-
-				Irq_routing * r = new (_heap) Irq_routing(gsi, bridge_bdf,
+				Irq_routing * r = new (_heap) Irq_routing(gsi, mapped_bridge_bdf,
 				                                          device, device_pin);
 				Irq_routing::list()->insert(r);
-			}
+			});
 		}
 
 	protected:
@@ -1027,7 +1204,6 @@ class Platform::Root : public Genode::Root_component<Session_component>
 
 			if (_pci_reporter.enabled()) {
 
-				Config_access config_access(env);
 				Device_config config;
 				int bus = 0, device = 0, function = -1;
 
@@ -1035,8 +1211,7 @@ class Platform::Root : public Genode::Root_component<Session_component>
 					/* iterate over pci devices */
 					while (true) {
 						function += 1;
-						if (!_buses.find_next(bus, device, function, &config,
-						                      &config_access))
+						if (!_buses.find_next(bus, device, function, &config))
 							return;
 
 						bus      = config.bus_number();
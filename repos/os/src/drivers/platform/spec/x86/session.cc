@@ -52,6 +52,8 @@ void Platform::Pci_buses::scan_bus(Config_access &config_access,
 			if (!_valid.get(bus, 1))
 				_valid.set(bus, 1);
 
+			_add(config);
+
 			/* scan behind bridge */
 			if (config.pci_bridge()) {
 				/* PCI bridge spec 3.2.5.3, 3.2.5.4 */
@@ -28,14 +28,16 @@ Table::Table(Ram_session &ram, Region_map &rm)
 { }
 
 
-int Table::setup_request(size_t const size, addr_t const buffer_phys)
+int Table::setup_request(size_t const size, addr_t const buffer_phys,
+                         unsigned const slot)
 {
 	/* sanity check */
-	static size_t constexpr max_size = _max_desc * Desc::Length::max;
-	if (size > max_size) {
+	if (size > max_size || slot >= SLOTS) {
 		Genode::error("block request too large");
 		return -1;
 	}
+	Desc::access_t * const table = _base_virt + slot * _max_desc;
+
 	/* install new descriptors till they cover all requested bytes */
 	addr_t consumed = 0;
 	for (int index = 0; consumed < size; index++) {
@@ -56,7 +58,7 @@ int Table::setup_request(size_t const size, addr_t const buffer_phys)
 		if (consumed + curr == size) { Desc::End::set(desc, 1); }
 
 		/* install and account descriptor */
-		_base_virt[index] = desc;
+		table[index] = desc;
 		consumed += curr;
 	}
 	/* ensure that all descriptor writes were actually executed */
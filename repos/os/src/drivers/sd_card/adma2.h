@@ -53,19 +53,35 @@ struct Adma2::Desc : Register<64>
 };
 
 /**
- * Descriptor table
+ * Descriptor tables
+ *
+ * The tables are used in turns, which enables the driver to marshal the
+ * descriptors of the next transfer while the host processes the current
+ * one.
  */
 class Adma2::Table
 {
-	static size_t constexpr _max_desc = 1024;
-	static size_t constexpr _ds_size  = _max_desc * sizeof(Desc::access_t);
+	public:
+
+		static unsigned constexpr SLOTS = 2;
+
+	private:
 
-	Attached_ram_dataspace _ds;
-	Desc::access_t * const _base_virt;
-	addr_t const           _base_phys;
+		static size_t constexpr _max_desc   = 1024;
+		static size_t constexpr _table_size = _max_desc * sizeof(Desc::access_t);
+		static size_t constexpr _ds_size    = SLOTS * _table_size;
+
+		Attached_ram_dataspace _ds;
+		Desc::access_t * const _base_virt;
+		addr_t const           _base_phys;
 
 	public:
 
+		/**
+		 * Maximum number of bytes covered by one table
+		 */
+		static size_t constexpr max_size = _max_desc * Desc::Length::max;
+
 		Table(Ram_session &ram, Region_map &rm);
 
 		/**
@@ -73,17 +89,20 @@ class Adma2::Table
 		 *
 		 * \param size         request size in bytes
 		 * \param buffer_phys  physical base of transfer buffer
+		 * \param slot         table to use
 		 *
 		 * \retval  0  success
 		 * \retval -1  error
 		 */
-		int setup_request(size_t const size, addr_t const buffer_phys);
+		int setup_request(size_t const size, addr_t const buffer_phys,
+		                  unsigned const slot = 0);
 
 		/*
 		 * Accessors
 		 */
 
-		addr_t base_phys() const { return _base_phys; }
+		addr_t base_phys(unsigned const slot = 0) const {
+			return _base_phys + slot * _table_size; }
 };
 
 #endif /* _ADMA2_H_ */
@@ -95,7 +95,7 @@ void Driver::_handle_irq()
 	_irq.ack_irq();
 
 	/* the handler is only for block transfers, on other commands we poll */
-	if (!_block_transfer.pending) {
+	if (!_chunk_running) {
 		return; }
 
 	/*
@@ -116,11 +116,28 @@ void Driver::_handle_irq()
 	Irqstat::Tc::set(irqstat, 1);
 	Mmio::write<Irqstat>(irqstat);
 
-	if (_wait_for_cmd_complete_mb_finish(_block_transfer.read)) {
+	Chunk const chunk = _chunks[_chunk_head];
+	if (_wait_for_cmd_complete_mb_finish(chunk.read)) {
 		throw -1; }
 
-	_block_transfer.pending = false;
-	ack_packet(_block_transfer.packet, true);
+	_chunk_running = false;
+	_chunk_head    = (_chunk_head + 1) % Adma2::Table::SLOTS;
+	_chunk_cnt--;
+
+	Block_transfer    &transfer = _transfers[chunk.transfer];
+	bool         const  done    = !--transfer.chunks && !transfer.block_cnt;
+	Block::Packet_descriptor packet = transfer.packet;
+	if (done) {
+		_transfer_head = (_transfer_head + 1) % MAX_TRANSFERS;
+		_transfer_cnt--;
+	}
+	/* keep the card busy while the client processes the acknowledgement */
+	if (!_start_chunks()) {
+		error("issuing multi-block command failed");
+		throw -1;
+	}
+	if (done) {
+		ack_packet(packet, true); }
 }
 
 
@@ -213,11 +230,7 @@ void Driver::read_dma(Block::sector_t           blk_nr,
                       addr_t                    buf_phys,
                       Block::Packet_descriptor &packet)
 {
-	if (_prepare_dma_mb(packet, true, blk_cnt, buf_phys)) {
-		throw Io_error(); }
-
-	if (!issue_command(Read_multiple_block(blk_nr))) {
-		throw Io_error(); }
+	_enqueue_transfer(packet, true, blk_nr, blk_cnt, buf_phys);
 }
 
 
@@ -226,36 +239,99 @@ void Driver::write_dma(Block::sector_t           blk_nr,
                        addr_t                    buf_phys,
                        Block::Packet_descriptor &packet)
 {
-	if (_prepare_dma_mb(packet, false, blk_cnt, buf_phys)) {
-		throw Io_error(); }
-
-	if (!issue_command(Write_multiple_block(blk_nr))) {
-		throw Io_error(); }
+	_enqueue_transfer(packet, false, blk_nr, blk_cnt, buf_phys);
 }
 
 
-int Driver::_prepare_dma_mb(Block::Packet_descriptor packet,
-                          bool                     reading,
-                          size_t                   blk_cnt,
-                          addr_t                   buf_phys)
+void Driver::_enqueue_transfer(Block::Packet_descriptor packet,
+                               bool                     reading,
+                               Block::sector_t          blk_nr,
+                               size_t                   blk_cnt,
+                               addr_t                   buf_phys)
 {
-	if (_block_transfer.pending) {
+	if (_transfer_cnt == MAX_TRANSFERS) {
 		throw Request_congestion(); }
 
+	unsigned const index = (_transfer_head + _transfer_cnt++) % MAX_TRANSFERS;
+	_transfers[index] = Block_transfer { packet, reading, blk_nr, blk_cnt,
+	                                     buf_phys, 0 };
+
+	if (_chunk_running) {
+		_prepare_chunks();
+		return;
+	}
+	/*
+	 * If no chunk is running, no other transfer is pending, so we can
+	 * revert the state if the card refuses the command.
+	 */
+	if (!_start_chunks()) {
+		_transfer_cnt = 0;
+		_chunk_cnt    = 0;
+		throw Io_error();
+	}
+}
+
+
+void Driver::_prepare_chunks()
+{
+	static_assert(MAX_CHUNK_BLOCKS * 512 <= Adma2::Table::max_size,
+	              "ADMA2 table too small for maximum chunk");
+
+	for (unsigned i = 0; i < _transfer_cnt && _chunk_cnt < Adma2::Table::SLOTS; ) {
+
+		unsigned const  index    = (_transfer_head + i) % MAX_TRANSFERS;
+		Block_transfer &transfer = _transfers[index];
+		if (!transfer.block_cnt) {
+			i++;
+			continue;
+		}
+		/* write ADMA2 table of the chunk to DMA */
+		unsigned const slot    = (_chunk_head + _chunk_cnt) % Adma2::Table::SLOTS;
+		size_t   const blk_cnt = min(transfer.block_cnt,
+		                             (size_t)MAX_CHUNK_BLOCKS);
+		_adma2_table.setup_request(blk_cnt * block_size(), transfer.buf_phys,
+		                           slot);
+
+		_chunks[slot] = Chunk { index, transfer.block_nr, blk_cnt,
+		                        transfer.read };
+		_chunk_cnt++;
+
+		transfer.block_nr  += blk_cnt;
+		transfer.block_cnt -= blk_cnt;
+		transfer.buf_phys  += blk_cnt * block_size();
+		transfer.chunks++;
+	}
+}
+
 
-	/* write ADMA2 table to DMA */
-	size_t const req_size = blk_cnt * block_size();
-	if (_adma2_table.setup_request(req_size, buf_phys)) { return -1; }
+bool Driver::_issue_chunk()
+{
+	Chunk const &chunk = _chunks[_chunk_head];
 
 	/* configure DMA at host */
-	Mmio::write<Adsaddr>(_adma2_table.base_phys());
+	Mmio::write<Adsaddr>(_adma2_table.base_phys(_chunk_head));
 	Mmio::write<Blkattr::Blksize>(block_size());
-	Mmio::write<Blkattr::Blkcnt>(blk_cnt);
+	Mmio::write<Blkattr::Blkcnt>(chunk.block_cnt);
 
-	_block_transfer.read    = reading;
-	_block_transfer.packet  = packet;
-	_block_transfer.pending = true;
-	return 0;
+	_chunk_running = chunk.read
+		? issue_command(Read_multiple_block(chunk.block_nr))
+		: issue_command(Write_multiple_block(chunk.block_nr));
+
+	return _chunk_running;
+}
+
+
+bool Driver::_start_chunks()
+{
+	/* issue the chunk prepared in advance before preparing further ones */
+	if (!_chunk_cnt) {
+		_prepare_chunks(); }
+
+	if (_chunk_cnt && !_issue_chunk()) {
+		return false; }
+
+	_prepare_chunks();
+	return true;
 }
 
 
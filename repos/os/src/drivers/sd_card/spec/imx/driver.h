@@ -205,15 +205,41 @@ class Sd_card::Driver : public  Driver_base,
 			void usleep(unsigned us) { Timer::Connection::usleep(us); }
 		};
 
+		/*
+		 * A block transfer is split into chunks of at most
+		 * 'MAX_CHUNK_BLOCKS' blocks, each transferred by one multi-block
+		 * command. The ADMA2 descriptors of the next chunk are marshalled
+		 * while the host processes the current one, and the next chunk is
+		 * issued right after the current one completed.
+		 */
+		enum { MAX_TRANSFERS = 2, MAX_CHUNK_BLOCKS = (1 << 16) - 1 };
+
 		struct Block_transfer
 		{
 			Block::Packet_descriptor packet;
-			bool                     pending = false;
 			bool                     read;
+			Block::sector_t          block_nr;   /* first block not prepared */
+			size_t                   block_cnt;  /* blocks not prepared */
+			addr_t                   buf_phys;   /* buffer of 'block_nr' */
+			unsigned                 chunks;     /* chunks not completed */
+		};
+
+		struct Chunk
+		{
+			unsigned        transfer;  /* index in '_transfers' */
+			Block::sector_t block_nr;
+			size_t          block_cnt;
+			bool            read;
 		};
 
 		Env                    &_env;
-		Block_transfer          _block_transfer;
+		Block_transfer          _transfers[MAX_TRANSFERS];
+		unsigned                _transfer_head = 0;
+		unsigned                _transfer_cnt  = 0;
+		Chunk                   _chunks[Adma2::Table::SLOTS];
+		unsigned                _chunk_head    = 0;
+		unsigned                _chunk_cnt     = 0;
+		bool                    _chunk_running = false;
 		Timer_delayer           _delayer     { _env };
 		Signal_handler<Driver>  _irq_handler { _env.ep(), *this,
 		                                       &Driver::_handle_irq };
@@ -244,10 +270,15 @@ class Sd_card::Driver : public  Driver_base,
 		void _stop_transmission_finish_xfertyp(Xfertyp::access_t &xfertyp);
 		int  _wait_for_cmd_complete_mb_finish(bool const reading);
 
-		int _prepare_dma_mb(Block::Packet_descriptor packet,
-		                    bool                     reading,
-		                    size_t                   blk_cnt,
-		                    addr_t                   buf_phys);
+		void _enqueue_transfer(Block::Packet_descriptor packet,
+		                       bool                     reading,
+		                       Block::sector_t          blk_nr,
+		                       size_t                   blk_cnt,
+		                       addr_t                   buf_phys);
+
+		void _prepare_chunks();
+		bool _issue_chunk();
+		bool _start_chunks();
 
 		bool _issue_cmd_finish_xfertyp(Xfertyp::access_t &xfertyp,
 		                               bool const         transfer,
@@ -292,6 +323,8 @@ class Sd_card::Driver : public  Driver_base,
 
 		bool dma_enabled() override { return true; }
 
+		unsigned command_slots() override { return MAX_TRANSFERS; }
+
 		Ram_dataspace_capability alloc_dma_buffer(size_t size) override {
 			return _env.ram().alloc(size, UNCACHED); }
 };
@@ -25,14 +25,64 @@
 namespace Timer { class Root_component; }
 
 
-class Timer::Root_component : public Genode::Root_component<Session_component>
+class Timer::Root_component : public Genode::Root_component<Session_component>,
+                              private Genode::Timeout::Handler
 {
 	private:
 
 		enum { MIN_TIMEOUT_US = 1000 };
 
-		Time_source                     _time_source;
-		Genode::Alarm_timeout_scheduler _timeout_scheduler;
+		Genode::Env                     &_env;
+		Time_source                      _time_source;
+		Genode::Wheel_timeout_scheduler  _timeout_scheduler;
+		Genode::List<Session_component>  _sessions;
+
+
+		/*
+		 * Calibration of the time pages
+		 */
+
+		Genode::Timeout      _time_page_timeout { _timeout_scheduler };
+		unsigned long        _last_us   = 0;
+		Time_page::Timestamp _last_ts   = 0;
+		Genode::uint64_t     _us_per_ts = 0;
+
+		unsigned long _curr_us() {
+			return _timeout_scheduler.curr_time().trunc_to_plain_us().value; }
+
+		/**
+		 * Calibrate the timestamp ratio and update all time pages
+		 */
+		void handle_timeout(Duration) override
+		{
+			using Genode::uint64_t;
+
+			Time_page::Timestamp const ts = Time_page::timestamp();
+			unsigned long        const us = _curr_us();
+
+			/*
+			 * Skip samples taken after an excessive delay because
+			 * timestamps of the limited width of some platforms may
+			 * have wrapped meanwhile.
+			 */
+			unsigned long        const us_diff = us - _last_us;
+			Time_page::Timestamp const ts_diff = ts - _last_ts;
+
+			if (_last_us && us_diff && ts_diff &&
+			    us_diff < 2*Time_page::UPDATE_PERIOD_US)
+			{
+				uint64_t const ratio =
+					((uint64_t)us_diff << Time_page::RATIO_SHIFT) / ts_diff;
+
+				/* smooth out the inaccuracy of the time source */
+				_us_per_ts = _us_per_ts ? (3*_us_per_ts + ratio) / 4 : ratio;
+			}
+			_last_us = us;
+			_last_ts = ts;
+
+			for (Session_component *s = _sessions.first(); s; s = s->next())
+				s->update_time_page(us, ts, _us_per_ts);
+		}
 
 
 		/********************
@@ -45,11 +95,23 @@ class Timer::Root_component : public Genode::Root_component<Session_component>
 			size_t const ram_quota =
 				Arg_string::find_arg(args, "ram_quota").ulong_value(0);
 
-			if (ram_quota < sizeof(Session_component)) {
+			if (ram_quota < sizeof(Session_component) +
+			                Session_component::TIME_PAGE_SIZE) {
 				throw Insufficient_ram_quota(); }
 
-			return new (md_alloc())
-				Session_component(_timeout_scheduler);
+			Session_component *session = new (md_alloc())
+				Session_component(_timeout_scheduler, _env.ram(), _env.rm());
+
+			session->update_time_page(_curr_us(), Time_page::timestamp(),
+			                          _us_per_ts);
+			_sessions.insert(session);
+			return session;
+		}
+
+		void _destroy_session(Session_component *session)
+		{
+			_sessions.remove(session);
+			Genode::destroy(md_alloc(), session);
 		}
 
 	public:
@@ -57,10 +119,12 @@ class Timer::Root_component : public Genode::Root_component<Session_component>
 		Root_component(Genode::Env &env, Genode::Allocator &md_alloc)
 		:
 			Genode::Root_component<Session_component>(&env.ep().rpc_ep(), &md_alloc),
-			_time_source(env),
+			_env(env), _time_source(env),
 			_timeout_scheduler(_time_source, Microseconds(MIN_TIMEOUT_US))
 		{
 			_timeout_scheduler._enable();
+			_time_page_timeout.schedule_periodic(
+				Microseconds(Time_page::UPDATE_PERIOD_US), *this);
 		}
 };
 
@@ -20,7 +20,9 @@
 /* Genode includes */
 #include <util/list.h>
 #include <timer_session/timer_session.h>
+#include <timer_session/time_page.h>
 #include <base/rpc_server.h>
+#include <base/attached_ram_dataspace.h>
 #include <timer/timeout.h>
 
 namespace Timer {
@@ -40,6 +42,9 @@ class Timer::Session_component : public Genode::Rpc_object<Session>,
 		Genode::Timeout                    _timeout;
 		Genode::Timeout_scheduler         &_timeout_scheduler;
 		Genode::Signal_context_capability  _sigh;
+		Genode::Attached_ram_dataspace     _time_page_ds;
+
+		Time_page &_time_page = *_time_page_ds.local_addr<Time_page>();
 
 		unsigned long const _init_time_us =
 			_timeout_scheduler.curr_time().trunc_to_plain_us().value;
@@ -49,8 +54,28 @@ class Timer::Session_component : public Genode::Rpc_object<Session>,
 
 	public:
 
-		Session_component(Genode::Timeout_scheduler &timeout_scheduler)
-		: _timeout(timeout_scheduler), _timeout_scheduler(timeout_scheduler) { }
+		enum { TIME_PAGE_SIZE = 4096 };
+
+		Session_component(Genode::Timeout_scheduler &timeout_scheduler,
+		                  Genode::Ram_allocator     &ram,
+		                  Genode::Region_map        &rm)
+		:
+			_timeout(timeout_scheduler), _timeout_scheduler(timeout_scheduler),
+			_time_page_ds(ram, rm, TIME_PAGE_SIZE)
+		{ }
+
+		/**
+		 * Update time page with a sample of the server time
+		 *
+		 * \param curr_us    current time of the timeout scheduler
+		 * \param ts         timestamp taken at 'curr_us'
+		 * \param us_per_ts  calibrated ratio, see 'Time_page'
+		 */
+		void update_time_page(unsigned long curr_us, Time_page::Timestamp ts,
+		                      Genode::uint64_t us_per_ts)
+		{
+			_time_page.write(curr_us - _init_time_us, ts, us_per_ts);
+		}
 
 
 		/********************
@@ -89,6 +114,9 @@ class Timer::Session_component : public Genode::Rpc_object<Session>,
 			return _timeout_scheduler.curr_time().trunc_to_plain_us().value -
 			       _init_time_us; }
 
+		Genode::Dataspace_capability time_page() override {
+			return _time_page_ds.cap(); }
+
 		void msleep(unsigned) override { /* never called at the server side */ }
 		void usleep(unsigned) override { /* never called at the server side */ }
 };
@@ -29,6 +29,7 @@ namespace Uart {
 	class Driver;
 	struct Driver_factory;
 	struct Char_avail_functor;
+	struct Statistics;
 };
 
 
@@ -46,6 +47,16 @@ struct Uart::Char_avail_functor
 };
 
 
+/**
+ * Receive counters, not available via the kernel debugger
+ */
+struct Uart::Statistics
+{
+	unsigned long received = 0;
+	unsigned long dropped  = 0;
+	unsigned long overruns = 0;
+};
+
 
 class Uart::Driver
 {
@@ -53,6 +64,7 @@ class Uart::Driver
 
 		signed char            _buffered_char;
 		Char_avail_functor    &_char_avail;
+		Statistics             _stats { };
 		Timer::Connection      _timer;
 		Signal_handler<Driver> _timer_handler;
 
@@ -100,6 +112,23 @@ class Uart::Driver
 		}
 
 		void baud_rate(int bits_per_second) { }
+
+		bool rx_avail() { return char_avail(); }
+
+		size_t rx_read(char *dst, size_t dst_len)
+		{
+			size_t n = 0;
+			for (; n < dst_len && char_avail(); n++)
+				dst[n] = get_char();
+
+			return n;
+		}
+
+		void rx_flush() { while (char_avail()) get_char(); }
+
+		Statistics const &statistics() const { return _stats; }
+
+		void stats_sigh(Signal_context_capability) { }
 };
 
 
@@ -116,6 +145,8 @@ struct Uart::Driver_factory
 	Genode::Heap &heap;
 	Driver       *drivers[UARTS_NUM] { nullptr };
 
+	Genode::Signal_context_capability stats_sigh { };
+
 	Driver_factory(Genode::Env &env, Genode::Heap &heap)
 	: env(env), heap(heap) {}
 
@@ -125,6 +156,14 @@ struct Uart::Driver_factory
 
 	void destroy(Uart::Driver *driver) { /* TODO */ }
 
+	template <typename FN>
+	void for_each_driver(FN const &fn) const
+	{
+		for (unsigned i = 0; i < UARTS_NUM; i++)
+			if (drivers[i])
+				fn(i, *drivers[i]);
+	}
+
 };
 
 #endif /* _KDB_UART_H_ */
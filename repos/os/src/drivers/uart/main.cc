@@ -15,6 +15,7 @@
 #include <base/heap.h>
 #include <base/log.h>
 #include <base/attached_io_mem_dataspace.h>
+#include <os/reporter.h>
 
 /* local includes */
 #include <uart_component.h>
@@ -27,9 +28,37 @@ struct Main
 	Uart::Driver_factory factory   { env, heap           };
 	Uart::Root           uart_root { env, heap, factory  };
 
+	Genode::Constructible<Genode::Reporter> reporter;
+
+	Genode::Signal_handler<Main> stats_handler {
+		env.ep(), *this, &Main::handle_stats };
+
+	void handle_stats()
+	{
+		Genode::Reporter::Xml_generator xml(*reporter, [&] () {
+			factory.for_each_driver([&] (unsigned index,
+			                             Uart::Driver const &driver) {
+				Uart::Statistics const &stats = driver.statistics();
+				xml.node("uart", [&] () {
+					xml.attribute("index",    index);
+					xml.attribute("received", stats.received);
+					xml.attribute("dropped",  stats.dropped);
+					xml.attribute("overruns", stats.overruns);
+				});
+			});
+		});
+	}
+
 	Main(Genode::Env &env) : env(env)
 	{
 		Genode::log("--- UART driver started ---");
+
+		if (uart_root.config().attribute_value("report_statistics", false)) {
+			reporter.construct(env, "uart_stats");
+			reporter->enabled(true);
+			factory.stats_sigh = stats_handler;
+		}
+
 		env.parent().announce(env.ep().manage(uart_root));
 	}
 };
@@ -44,7 +73,9 @@ Uart::Driver & Uart::Driver_factory::create(unsigned index, unsigned baudrate,
 {
 	if (index >= UARTS_NUM) throw Not_available();
 
-	if (!drivers[index])
+	if (!drivers[index]) {
 		drivers[index] = new (&heap) Driver(env, index, baudrate, functor);
+		drivers[index]->stats_sigh(stats_sigh);
+	}
 	return *drivers[index];
 }
@@ -33,7 +33,7 @@ class Uart::Driver : public Genode::Attached_io_mem_dataspace,
 {
 	private:
 
-		enum { BAUD_115200 = 115200 };
+		enum { BAUD_115200 = 115200, RX_TRIGGER_8_CHAR = 4 };
 
 		struct Uart {
 			Genode::addr_t mmio_base;
@@ -72,8 +72,14 @@ class Uart::Driver : public Genode::Attached_io_mem_dataspace,
 		                                     _config(index).mmio_size),
 		  Exynos_uart((Genode::addr_t)local_addr<void>(),
 		              Arndale::UART_2_CLOCK, _baud_rate(baud_rate)),
-		  Driver_base(env, _config(index).irq_number, func) {
-			_rx_enable(); }
+		  Driver_base(env, _config(index).irq_number, func)
+		{
+			/*
+			 * Interrupt when 8 characters are in the 16-byte rx FIFO of
+			 * UART 2. Otherwise, the rx timeout enabled via 'Ucon' fires.
+			 */
+			_rx_enable(RX_TRIGGER_8_CHAR);
+		}
 
 
 		/***************************
@@ -81,7 +87,13 @@ class Uart::Driver : public Genode::Attached_io_mem_dataspace,
 		 ***************************/
 
 		void put_char(char c) override { Exynos_uart::put_char(c); }
-		bool char_avail()     override { return _rx_avail(); }
+		bool char_avail() override
+		{
+			if (_rx_overrun())
+				_overrun();
+
+			return _rx_avail();
+		}
 		char get_char()       override { return _rx_char();  }
 };
 
@@ -38,7 +38,14 @@ class Uart::Driver : public Genode::Attached_io_mem_dataspace,
 			/* enable access to 'Uart_fcr' and 'Uart_ier' */
 			write<Uart_lcr::Reg_mode>(Uart_lcr::Reg_mode::OPERATIONAL);
 
-			/* enable rx interrupt, disable other interrupts and sleep mode */
+			/* interrupt when 16 characters are in the rx FIFO */
+			write<Uart_fcr>(Uart_fcr::Fifo_enable::bits(1)
+			              | Uart_fcr::Rx_fifo_trig::bits(Uart_fcr::Rx_fifo_trig::_16_CHAR));
+
+			/*
+			 * Enable rx interrupt, which also fires on rx timeout, disable
+			 * other interrupts and sleep mode
+			 */
 			write<Uart_ier>(Uart_ier::Rhr_it::bits(1)
 			              | Uart_ier::Thr_it::bits(0)
 			              | Uart_ier::Line_sts_it::bits(0)
@@ -121,7 +128,15 @@ class Uart::Driver : public Genode::Attached_io_mem_dataspace,
 
 		void put_char(char c) override { Tl16c750_uart::put_char(c); }
 
-		bool char_avail() override { return read<Uart_lsr::Rx_fifo_empty>(); }
+		bool char_avail() override
+		{
+			Uart_lsr::access_t const lsr = read<Uart_lsr>();
+
+			if (Uart_lsr::Rx_oe::get(lsr))
+				_overrun();
+
+			return Uart_lsr::Rx_fifo_empty::get(lsr);
+		}
 
 		char get_char() override { return read<Uart_rhr::Rhr>(); }
 
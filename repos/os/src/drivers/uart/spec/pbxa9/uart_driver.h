@@ -101,6 +101,7 @@ class Uart::Driver : public Genode::Attached_io_mem_dataspace,
 			UARTFBRD  = 0x028,  /* fractional baud rate divisor */
 			UARTLCR_H = 0x02c,  /* line control */
 			UARTCR    = 0x030,  /* control */
+			UARTIFLS  = 0x034,  /* interrupt FIFO level select */
 			UARTIMSC  = 0x038,  /* interrupt mask register */
 			UARTICR   = 0x044,  /* interrupt clear register */
 		};
@@ -109,6 +110,9 @@ class Uart::Driver : public Genode::Attached_io_mem_dataspace,
 		 * Flags
 		 */
 		enum Flag {
+			/* data register */
+			UARTDR_OE        = 0x0800,  /* overrun error */
+
 			/* flag register */
 			UARTFR_BUSY      = 0x0008,  /* busy on tx */
 			UARTFR_TXFF      = 0x0020,  /* tx FIFO full */
@@ -123,11 +127,18 @@ class Uart::Driver : public Genode::Attached_io_mem_dataspace,
 			UARTCR_TXE       = 0x0100,  /* enable tx */
 			UARTCR_RXE       = 0x0200,  /* enable rx */
 
+			/* interrupt FIFO level select register */
+			UARTIFLS_RX_1_2  = 0x0010,  /* rx FIFO half full */
+			UARTIFLS_TX_1_2  = 0x0002,  /* tx FIFO half empty */
+
 			/* interrupt mask register */
 			UARTIMSC_RXIM    = 0x10,    /* rx interrupt mask */
+			UARTIMSC_RTIM    = 0x40,    /* rx timeout interrupt mask */
 
 			/* interrupt clear register */
 			UARTICR_RXIC     = 0x10,    /* rx interrupt clear */
+			UARTICR_RTIC     = 0x40,    /* rx timeout interrupt clear */
+			UARTICR_OEIC     = 0x400,   /* overrun interrupt clear */
 		};
 
 		Genode::uint32_t volatile *_base;
@@ -169,8 +180,12 @@ class Uart::Driver : public Genode::Attached_io_mem_dataspace,
 			/* enable uart */
 			_write_reg(UARTCR, _read_reg(UARTCR) | UARTCR_UARTEN);
 
-			/* enable rx interrupt */
-			_write_reg(UARTIMSC, UARTIMSC_RXIM);
+			/*
+			 * Interrupt when the rx FIFO is half full or when characters
+			 * remain in the FIFO for 32 bit periods
+			 */
+			_write_reg(UARTIFLS, UARTIFLS_RX_1_2 | UARTIFLS_TX_1_2);
+			_write_reg(UARTIMSC, UARTIMSC_RXIM | UARTIMSC_RTIM);
 		}
 
 
@@ -180,11 +195,11 @@ class Uart::Driver : public Genode::Attached_io_mem_dataspace,
 
 		void handle_irq() override
 		{
-			/* inform client about the availability of data */
-			Driver_base::handle_irq();
-
 			/* acknowledge irq */
-			_write_reg(UARTICR, UARTICR_RXIC);
+			_write_reg(UARTICR, UARTICR_RXIC | UARTICR_RTIC | UARTICR_OEIC);
+
+			/* drain FIFO and inform client about the availability of data */
+			Driver_base::handle_irq();
 		}
 
 		void put_char(char c) override
@@ -198,8 +213,15 @@ class Uart::Driver : public Genode::Attached_io_mem_dataspace,
 		bool char_avail() override {
 			return !(_read_reg(UARTFR) & UARTFR_RXFE); }
 
-		char get_char() override {
-			return _read_reg(UARTDR); }
+		char get_char() override
+		{
+			Genode::uint32_t const dr = _read_reg(UARTDR);
+
+			if (dr & UARTDR_OE)
+				_overrun();
+
+			return dr;
+		}
 };
 
 #endif /* _UART_DRIVER_H_ */
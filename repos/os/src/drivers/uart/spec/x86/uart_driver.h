@@ -92,9 +92,9 @@ class Uart::Driver : public Uart::Driver_base
 			_outb<DLHI>((115200/baud) >> 8);
 			_outb<LCR>(0x03);  /* set 8,N,1 */
 			_outb<IER>(0x00);  /* disable interrupts */
-			_outb<EIR>(0x07);  /* enable FIFOs */
+			_outb<EIR>(0x87);  /* enable FIFOs, rx trigger at 8 bytes */
 			_outb<MCR>(0x0b);  /* force data terminal ready */
-			_outb<IER>(0x01);  /* enable RX interrupts */
+			_outb<IER>(0x01);  /* enable RX and RX-timeout interrupts */
 			_inb<IER>();
 			_inb<EIR>();
 			_inb<LCR>();
@@ -136,7 +136,13 @@ class Uart::Driver : public Uart::Driver_base
 
 		bool char_avail() override
 		{
-			return _inb<LSR>() & 1;
+			char const lsr = _inb<LSR>();
+
+			/* overrun flag is cleared by reading the LSR */
+			if (lsr & 2)
+				_overrun();
+
+			return lsr & 1;
 		}
 
 		char get_char() override
@@ -104,7 +104,7 @@ class Uart::Session_component : public Rpc_object<Uart::Session,
 			_put_string("\033[1;199r\033[199;255H");
 
 			/* flush incoming characters */
-			for (; _driver.char_avail(); _driver.get_char());
+			_driver.rx_flush();
 
 			/* request cursor coordinates */
 			_put_string("\033[6n");
@@ -154,18 +154,15 @@ class Uart::Session_component : public Rpc_object<Uart::Session,
 
 		Size size() { return _size; }
 
-		bool avail() { return _driver.char_avail(); }
+		bool avail() { return _driver.rx_avail(); }
 
 		Genode::size_t _read(Genode::size_t dst_len)
 		{
 			char *io_buf      = _io_buffer.local_addr<char>();
 			Genode::size_t sz = Genode::min(dst_len, _io_buffer.size());
 
-			Genode::size_t n = 0;
-			while ((n < sz) && _driver.char_avail())
-				io_buf[n++] = _driver.get_char();
-
-			return n;
+			_driver.rx_avail();
+			return _driver.rx_read(io_buf, sz);
 		}
 
 		Genode::size_t _write(Genode::size_t num_bytes)
@@ -197,7 +194,7 @@ class Uart::Session_component : public Rpc_object<Uart::Session,
 		{
 			_char_avail.sigh = sigh;
 
-			if (_driver.char_avail()) _char_avail();
+			if (_driver.rx_avail()) _char_avail();
 		}
 
 		Genode::size_t read(void *, Genode::size_t) { return 0; }
@@ -250,6 +247,8 @@ class Uart::Root : public Uart::Root_component
 		Root(Env &env, Allocator &md_alloc, Driver_factory &driver_factory)
 		: Root_component(env.ep(), md_alloc), _env(env),
 		  _driver_factory(driver_factory) { }
+
+		Xml_node config() const { return _config.xml(); }
 };
 
 #endif /* _UART_COMPONENT_H_ */
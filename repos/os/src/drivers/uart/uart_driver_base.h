@@ -16,12 +16,14 @@
 #define _UART_DRIVER_BASE_H_
 
 #include <irq_session/connection.h>
+#include <os/ring_buffer.h>
 
 namespace Uart {
 	class  Driver_base;
 	class  Driver;
 	struct Driver_factory;
 	struct Char_avail_functor;
+	struct Statistics;
 };
 
 
@@ -38,14 +40,87 @@ struct Uart::Char_avail_functor
 };
 
 
+/**
+ * Receive counters of one UART
+ */
+struct Uart::Statistics
+{
+	unsigned long received = 0;  /* bytes taken from the hardware FIFO */
+	unsigned long dropped  = 0;  /* bytes lost because the buffer was full */
+	unsigned long overruns = 0;  /* overrun errors signalled by the UART */
+};
+
+
+/**
+ * UART driver with interrupt-driven receive buffer
+ *
+ * The platform drivers configure their receive FIFO to interrupt at a fill
+ * threshold or once the line stays idle for a few character times. On each
+ * interrupt, the whole FIFO is drained into a software ring buffer, from
+ * which the clients read. Hence, the client is woken up once per burst
+ * rather than once per character.
+ */
 class Uart::Driver_base
 {
 	private:
 
+		enum { RX_BUFFER_SIZE = 16*1024 };
+
+		typedef Genode::Ring_buffer<char, RX_BUFFER_SIZE + 1,
+		                            Genode::Ring_buffer_unsynchronized> Rx_buffer;
+
 		Char_avail_functor                 &_char_avail;
 		Genode::Irq_connection              _irq;
 		Genode::Signal_handler<Driver_base> _irq_handler;
 
+		Rx_buffer  _rx_buffer { };
+		Statistics _stats     { };
+
+		Genode::Signal_context_capability _stats_sigh { };
+
+		unsigned long _reported_errors = 0;
+
+		unsigned long _errors() const { return _stats.dropped + _stats.overruns; }
+
+	protected:
+
+		/**
+		 * Account overrun error detected by the platform driver
+		 */
+		void _overrun() { _stats.overruns++; }
+
+		/**
+		 * Move all characters from the hardware FIFO into the buffer
+		 *
+		 * \return true if new characters became available
+		 */
+		bool _drain_fifo()
+		{
+			bool received = false;
+
+			while (char_avail()) {
+				char const c = get_char();
+
+				if (!_rx_buffer.avail_capacity()) {
+					_stats.dropped++;
+					continue;
+				}
+
+				_rx_buffer.add(c);
+				_stats.received++;
+				received = true;
+			}
+
+			/* the lack of errors is not worth reporting */
+			if (_errors() != _reported_errors) {
+				_reported_errors = _errors();
+				if (_stats_sigh.valid())
+					Genode::Signal_transmitter(_stats_sigh).submit();
+			}
+
+			return received;
+		}
+
 	public:
 
 		Driver_base(Genode::Env &env, int irq_number, Char_avail_functor &func)
@@ -64,22 +139,67 @@ class Uart::Driver_base
 		 */
 		virtual void handle_irq()
 		{
-			_char_avail();
+			if (_drain_fifo())
+				_char_avail();
+
 			_irq.ack_irq();
 		}
 
+		/**
+		 * Return true if buffered characters are available for reading
+		 */
+		bool rx_avail()
+		{
+			/* pick up characters that did not raise an interrupt yet */
+			_drain_fifo();
+
+			return !_rx_buffer.empty();
+		}
+
+		/**
+		 * Read buffered characters into 'dst'
+		 *
+		 * \return number of characters read
+		 */
+		Genode::size_t rx_read(char *dst, Genode::size_t dst_len)
+		{
+			Genode::size_t n = 0;
+			for (; n < dst_len && !_rx_buffer.empty(); n++)
+				dst[n] = _rx_buffer.get();
+
+			return n;
+		}
+
+		/**
+		 * Discard all received characters
+		 */
+		void rx_flush()
+		{
+			_drain_fifo();
+			while (!_rx_buffer.empty())
+				_rx_buffer.get();
+		}
+
+		Statistics const &statistics() const { return _stats; }
+
+		/**
+		 * Register handler for changes of the error counters
+		 */
+		void stats_sigh(Genode::Signal_context_capability sigh) {
+			_stats_sigh = sigh; }
+
 		/**
 		 * Write character to UART
 		 */
 		virtual void put_char(char c) = 0;
 
 		/**
-		 * Return true if character is available for reading
+		 * Return true if character is available in the hardware FIFO
 		 */
 		virtual bool char_avail() = 0;
 
 		/**
-		 * Read character from UART
+		 * Read character from the hardware FIFO
 		 */
 		virtual char get_char() = 0;
 
@@ -105,6 +225,9 @@ struct Uart::Driver_factory
 	Genode::Heap &heap;
 	Driver       *drivers[UARTS_NUM];
 
+	/* signal handler informed about receive errors of any driver */
+	Genode::Signal_context_capability stats_sigh { };
+
 	Driver_factory(Genode::Env &env, Genode::Heap &heap)
 	: env(env), heap(heap) {
 		for (unsigned i = 0; i < UARTS_NUM; i++) drivers[i] = 0; }
@@ -130,6 +253,17 @@ struct Uart::Driver_factory
 	 * Destroy driver
 	 */
 	void destroy(Driver &driver) { /* TODO */ }
+
+	/**
+	 * Call 'fn' with the index and object of each driver in use
+	 */
+	template <typename FN>
+	void for_each_driver(FN const &fn) const
+	{
+		for (unsigned i = 0; i < UARTS_NUM; i++)
+			if (drivers[i])
+				fn(i, *drivers[i]);
+	}
 };
 
 #endif /* _UART_DRIVER_BASE_H_ */
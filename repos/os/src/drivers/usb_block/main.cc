@@ -52,8 +52,22 @@ struct Usb::Block_driver : Usb::Completion,
 	Signal_context_capability announce_sigh;
 
 	/*
-	 * Pending block request
+	 * Block requests
+	 *
+	 * The bulk-only transport executes one SCSI command at a time. To keep
+	 * the device busy nonetheless, the driver queues several requests and
+	 * merges consecutive requests of the same direction into one command.
+	 * The CBW, all data transfers, and the CSW of a command are submitted
+	 * at once instead of waiting for the completion of each phase.
 	 */
+	enum {
+		MAX_REQUESTS         = 16,
+		URB_SIZE             = 128 * 1024,
+		MAX_TRANSFER_DEFAULT = 1024 * 1024,
+		MAX_TRANSFER_LIMIT   = 4 * 1024 * 1024,
+		MAX_URBS             = MAX_TRANSFER_LIMIT / URB_SIZE + MAX_REQUESTS + 2,
+	};
+
 	struct Block_request
 	{
 		Block::Packet_descriptor  packet;
@@ -61,8 +75,44 @@ struct Usb::Block_driver : Usb::Completion,
 		char                     *buffer;
 		size_t                    size;
 		bool                      read;
-		bool                      pending = false;
-	} req;
+	};
+
+	Block_request _requests[MAX_REQUESTS];
+	unsigned      _req_head  = 0;
+	unsigned      _req_count = 0;
+
+	/* offset of the first byte of the head request not yet transferred */
+	size_t _head_offset = 0;
+
+	Block_request &_request(unsigned i) {
+		return _requests[(_req_head + i) % MAX_REQUESTS]; }
+
+	/*
+	 * Command currently executed by the device
+	 */
+	struct Command
+	{
+		bool     active   = false;
+		bool     success  = true;
+		unsigned requests = 0;  /* requests touched by the command */
+		bool     partial  = false; /* last request is not transferred entirely */
+		size_t   end      = 0;  /* offset within last request if partial */
+		unsigned urbs     = 0;  /* URBs not completed yet */
+	} _cmd;
+
+	enum Urb_type { URB_CBW, URB_DATA, URB_CSW };
+
+	struct Urb
+	{
+		Genode::off_t  offset;  /* packet offset within the USB buffer */
+		Urb_type       type;
+		char          *buffer;  /* destination of read data */
+	};
+
+	Urb      _urbs[MAX_URBS];
+	unsigned _urb_count = 0;
+
+	size_t _max_transfer = MAX_TRANSFER_DEFAULT;
 
 	bool initialized     = false;
 	bool device_plugged  = false;
@@ -115,11 +165,32 @@ struct Usb::Block_driver : Usb::Completion,
 		return "usb_storage";
 	}
 
+	/*
+	 * Maximum number of bytes transferred by one command
+	 */
+	static size_t max_transfer(Xml_node node)
+	{
+		size_t const kib = node.attribute_value("max_transfer_kib",
+		                                        (size_t)MAX_TRANSFER_DEFAULT / 1024);
+
+		return max((size_t)URB_SIZE,
+		           min((size_t)MAX_TRANSFER_LIMIT, kib * 1024));
+	}
+
+	/*
+	 * The USB buffer holds two commands, which leaves room for the CBW and
+	 * CSW packets of the next command while the payload of a command is in
+	 * flight.
+	 */
+	static size_t usb_buffer_size(Xml_node node) {
+		return 2 * max_transfer(node) + 64 * 1024; }
+
 	/*
 	 * USB session
 	 */
 	Allocator_avl   alloc;
-	Usb::Connection usb { env, &alloc, get_label(config.xml()), 2 * (1<<20), state_change_dispatcher };
+	Usb::Connection usb { env, &alloc, get_label(config.xml()),
+	                      usb_buffer_size(config.xml()), state_change_dispatcher };
 	Usb::Device     device;
 
 	/*
@@ -535,150 +606,227 @@ struct Usb::Block_driver : Usb::Completion,
 	}
 
 	/**
-	 * Execute pending request
-	 *
-	 * Called after the CBW has been successfully received by the device
-	 * to initiate read/write transaction.
+	 * Submit bulk transfer of a command
 	 */
-	bool execute_pending_request()
+	void submit_urb(Usb::Packet_descriptor &p, uint8_t endpoint, Urb_type type,
+	                char *buffer = nullptr)
 	{
-		Usb::Interface     &iface = device.interface(active_interface);
-		Usb::Endpoint          ep = iface.endpoint(req.read ? IN : OUT);
-		Usb::Packet_descriptor  p = iface.alloc(req.size);
-
-		if (!req.read) memcpy(iface.content(p), req.buffer, req.size);
+		Usb::Interface &iface = device.interface(active_interface);
 
-		iface.bulk_transfer(p, ep, false, this);
+		Urb &urb = _urbs[_urb_count++];
+		urb.offset = p.offset();
+		urb.type   = type;
+		urb.buffer = buffer;
 
-		return true;
+		_cmd.urbs++;
+		iface.bulk_transfer(p, iface.endpoint(endpoint), false, this);
 	}
 
 	/**
-	 * Acknowledge currently pending request
+	 * Start command for the requests at the head of the queue
 	 *
-	 * After receiving the CSW ack the request at the Block session.
+	 * Requests following the head request are merged into the command if
+	 * they are of the same direction and continue at the next block. A
+	 * request larger than the maximum transfer size is executed by
+	 * several commands.
 	 */
-	void ack_pending_request(bool success = true)
+	void start_command()
 	{
+		if (_cmd.active || !_req_count)
+			return;
+
+		Usb::Interface &iface = device.interface(active_interface);
+
+		Block_request   &head = _request(0);
+		bool      const  read = head.read;
+		Block::sector_t  lba  = head.lba + _head_offset / _block_size;
+
+		_cmd           = Command();
+		_cmd.active    = true;
+		_urb_count     = 0;
+
+		/* determine the requests covered by the command */
+		size_t total = 0;
+		size_t start = _head_offset;
+		for (unsigned i = 0; i < _req_count && total < _max_transfer; i++) {
+
+			Block_request &r = _request(i);
+			if (i && (r.read != read || r.lba != lba + total / _block_size))
+				break;
+
+			size_t const len = min(r.size - start, _max_transfer - total);
+
+			total += len;
+			_cmd.requests++;
+
+			if (start + len < r.size) {
+				_cmd.partial = true;
+				_cmd.end     = start + len;
+			}
+			start = 0;
+		}
+
 		/*
-		 * Needs to be reset bevor calling ack_packet to prevent getting a new
-		 * request imediately and throwing Request_congestion() in io() again.
+		 * Hold one reference while submitting, because allocating packets
+		 * may dispatch completions of the URBs submitted so far.
 		 */
-		req.pending = false;
+		_cmd.urbs = 1;
+
+		/* CBW */
+		char cb[Cbw::LENGTH];
+		uint32_t const t   = new_tag();
+		uint32_t const len = total / _block_size;
+		if (read) {
+			if (!force_cmd_10) Read_16 r((addr_t)cb, t, active_lun, lba, len, _block_size);
+			else               Read_10 r((addr_t)cb, t, active_lun, lba, len, _block_size);
+		} else {
+			if (!force_cmd_10) Write_16 w((addr_t)cb, t, active_lun, lba, len, _block_size);
+			else               Write_10 w((addr_t)cb, t, active_lun, lba, len, _block_size);
+		}
 
-		Block::Packet_descriptor p = req.packet;
-		ack_packet(p, success);
+		Usb::Packet_descriptor p = iface.alloc(Cbw::LENGTH);
+		memcpy(iface.content(p), cb, Cbw::LENGTH);
+		submit_urb(p, OUT, URB_CBW);
+
+		/* payload, split into URBs */
+		start = _head_offset;
+		for (unsigned i = 0; i < _cmd.requests; i++) {
+
+			Block_request &r = _request(i);
+
+			size_t const end = (_cmd.partial && i + 1 == _cmd.requests)
+			                 ? _cmd.end : r.size;
+
+			for (size_t off = start; off < end; off += URB_SIZE) {
+
+				size_t const size = min((size_t)URB_SIZE, end - off);
+
+				p = iface.alloc(size);
+				if (!read) memcpy(iface.content(p), r.buffer + off, size);
+				submit_urb(p, read ? IN : OUT, URB_DATA, r.buffer + off);
+			}
+			start = 0;
+		}
+
+		/* CSW */
+		p = iface.alloc(Csw::LENGTH);
+		submit_urb(p, IN, URB_CSW);
+
+		urb_completed();
 	}
 
 	/**
-	 * Handle packet completion
-	 *
-	 * This method is called several times while doing one transaction. First
-	 * the CWB is sent, than the payload read or written. At the end, the CSW
-	 * is requested.
+	 * Account completed URB of the command, finish command if it was the last
 	 */
-	void complete(Packet_descriptor &p)
+	void urb_completed()
 	{
-		Interface iface = device.interface(active_interface);
-
-		if (p.type != Packet_descriptor::BULK) {
-			Genode::error("No BULK packet");
-			iface.release(p);
+		if (--_cmd.urbs)
 			return;
-		}
 
-		if (!p.succeded) {
-			Genode::error("complete error: packet not succeded");
-			if (req.pending) {
-				Genode::error("request pending: tag: ", active_tag, " read: ",
-				              (int)req.read, " buffer: ", (void *)req.buffer, " lba: ",
-				              req.lba, " size: ", req.size);
-				ack_pending_request(false);
-			}
-			iface.release(p);
-			return;
-		}
+		_cmd.active = false;
 
-		static bool request_executed = false;
-		if (!p.read_transfer()) {
-			/* send read/write request */
-			if (req.pending) {
+		unsigned const acked = _cmd.success && _cmd.partial
+		                     ? _cmd.requests - 1 : _cmd.requests;
 
-				/*
-				 * The CBW was successfully sent to the device, now read/write the
-				 * actual content.
-				 */
-				if (!request_executed) {
-					request_executed = execute_pending_request();
-				} else {
-					/* the content was successfully written, get the CSW */
-					csw(*this);
-				}
-			}
+		/* pop requests before acking to free slots for new ones */
+		Block_request done[MAX_REQUESTS];
+		for (unsigned i = 0; i < acked; i++)
+			done[i] = _request(i);
 
-			iface.release(p);
-			return;
+		_req_head   = (_req_head + acked) % MAX_REQUESTS;
+		_req_count -= acked;
+		_head_offset = _cmd.success && _cmd.partial ? _cmd.end : 0;
+
+		for (unsigned i = 0; i < acked; i++)
+			ack_packet(done[i].packet, _cmd.success);
+
+		start_command();
+	}
+
+	/**
+	 * Check CSW of the command
+	 */
+	bool csw_valid(Csw &csw)
+	{
+		uint32_t const sig = csw.sig();
+		if (sig != Csw::SIG) {
+			Genode::error("CSW signature does not match: ",
+			              Hex(sig, Hex::PREFIX, Hex::PAD));
+			return false;
 		}
 
-		int actual_size = p.transfer.actual_size;
-		if (actual_size < 0) {
-			Genode::error("Transfer actual size: ", actual_size);
-			actual_size = 0;
+		uint32_t const tag = csw.tag();
+		if (tag != active_tag) {
+			Genode::error("CSW tag mismatch. Got ", tag, " expected: ",
+			              active_tag);
+			return false;
 		}
 
-		/* the size indicates an IN I/O packet */
-		if ((uint32_t)actual_size >= _block_size) {
-			if (req.pending) {
+		uint8_t const status = csw.sts();
+		if (status != Csw::PASSED) {
+			Block_request &r = _request(0);
+			Genode::error("CSW failed: ", Hex(status, Hex::PREFIX, Hex::PAD),
+			              " read: ", (int)r.read, " buffer: ", (void *)r.buffer,
+			              " lba: ", r.lba, " size: ", r.size);
+			return false;
+		}
 
-				/* the content was successfully read, get the CSW */
-				memcpy(req.buffer, iface.content(p), actual_size);
-				csw(*this);
-			}
+		uint32_t const dr = csw.dr();
+		if (dr) {
+			Genode::warning("CSW data residue: ", dr, " not considered");
+		}
+		return true;
+	}
+
+	/**
+	 * Handle packet completion
+	 *
+	 * This method is called for each URB of the command, i.e., the CBW,
+	 * the payload transfers, and the CSW. Once all URBs are completed, the
+	 * requests covered by the command are acknowledged.
+	 */
+	void complete(Packet_descriptor &p)
+	{
+		Interface iface = device.interface(active_interface);
 
+		Urb *urb = nullptr;
+		for (unsigned i = 0; i < _urb_count && !urb; i++)
+			if (_urbs[i].offset == p.offset())
+				urb = &_urbs[i];
+
+		if (p.type != Packet_descriptor::BULK || !urb || !_cmd.active) {
+			Genode::error("unexpected packet completion");
 			iface.release(p);
 			return;
 		}
 
-		/* when ending up here, we should have gotten an CSW packet */
-		if (actual_size != Csw::LENGTH)
-			Genode::warning("This is not the actual size you are looking for");
-
-		do {
-			Csw csw((addr_t)iface.content(p));
+		/* mark entry as completed, the packet offset may get reused */
+		urb->offset = -1;
 
-			uint32_t const sig = csw.sig();
-			if (sig != Csw::SIG) {
-				Genode::error("CSW signature does not match: ",
-				              Hex(sig, Hex::PREFIX, Hex::PAD));
-				break;
-			}
-
-			uint32_t const tag = csw.tag();
-			if (tag != active_tag) {
-				Genode::error("CSW tag mismatch. Got ", tag, " expected: ",
-				              active_tag);
-				break;
-			}
+		if (!p.succeded) {
+			Genode::error("complete error: packet not succeded, tag: ", active_tag);
+			_cmd.success = false;
+		} else if (urb->type == URB_DATA && p.read_transfer()) {
 
-			uint8_t const status = csw.sts();
-			if (status != Csw::PASSED) {
-				Genode::error("CSW failed: ", Hex(status, Hex::PREFIX, Hex::PAD),
-				              " read: ", (int)req.read, " buffer: ", (void *)req.buffer,
-				              " lba: ", req.lba, " size: ", req.size);
-				break;
+			int const actual_size = p.transfer.actual_size;
+			if (actual_size < 0 || (size_t)actual_size != p.size()) {
+				Genode::error("short read of ", actual_size, " bytes");
+				_cmd.success = false;
+			} else {
+				memcpy(urb->buffer, iface.content(p), actual_size);
 			}
+		} else if (urb->type == URB_CSW) {
 
-			uint32_t const dr = csw.dr();
-			if (dr) {
-				Genode::warning("CSW data residue: ", dr, " not considered");
-			}
+			if (p.transfer.actual_size != Csw::LENGTH)
+				Genode::warning("This is not the actual size you are looking for");
 
-			/* ack Block::Packet_descriptor */
-			request_executed = false;
-			ack_pending_request();
-		} while (0);
+			Csw csw((addr_t)iface.content(p));
+			if (!csw_valid(csw))
+				_cmd.success = false;
+		}
 
 		iface.release(p);
+		urb_completed();
 	}
 
 	/**
@@ -698,6 +846,8 @@ struct Usb::Block_driver : Usb::Completion,
 		active_lun       = node.attribute_value<unsigned long>("lun", 0);
 
 		verbose_scsi = node.attribute_value<bool>("verbose_scsi", false);
+
+		_max_transfer = max_transfer(node);
 	}
 
 	/**
@@ -726,25 +876,6 @@ struct Usb::Block_driver : Usb::Completion,
 		iface.release();
 	}
 
-	/**
-	 * Send CBW
-	 */
-	void send_cbw(Block::sector_t lba, size_t len, bool read)
-	{
-		uint32_t const t = new_tag();
-
-		char cb[Cbw::LENGTH];
-		if (read) {
-			if (!force_cmd_10) Read_16 r((addr_t)cb, t, active_lun, lba, len, _block_size);
-			else               Read_10 r((addr_t)cb, t, active_lun, lba, len, _block_size);
-		} else {
-			if (!force_cmd_10) Write_16 w((addr_t)cb, t, active_lun, lba, len, _block_size);
-			else               Write_10 w((addr_t)cb, t, active_lun, lba, len, _block_size);
-		}
-
-		cbw(cb, *this);
-	}
-
 	/**
 	 * Perform IO/ request
 	 *
@@ -758,16 +889,16 @@ struct Usb::Block_driver : Usb::Completion,
 	{
 		if (!device_plugged)          throw Io_error();
 		if (lba+count > _block_count) throw Io_error();
-		if (req.pending)              throw Request_congestion();
+		if (_req_count == MAX_REQUESTS) throw Request_congestion();
 
-		req.pending = true;
-		req.packet  = p;
-		req.lba     = lba;
-		req.size    = count * _block_size;
-		req.buffer  = buffer;
-		req.read    = read;
+		Block_request &r = _request(_req_count++);
+		r.packet = p;
+		r.lba    = lba;
+		r.size   = count * _block_size;
+		r.buffer = buffer;
+		r.read   = read;
 
-		send_cbw(lba, count, read);
+		start_command();
 	}
 
 	/*******************************
@@ -778,6 +909,12 @@ struct Usb::Block_driver : Usb::Completion,
 	Block::sector_t    block_count() override { return _block_count; }
 	Block::Session::Operations ops() override { return _block_ops;   }
 
+	/*
+	 * Announcing the queue size prevents the session component from
+	 * running into 'Request_congestion' while the queue is full.
+	 */
+	unsigned command_slots() override { return MAX_REQUESTS; }
+
 	void read(Block::sector_t lba, size_t count,
 	          char *buffer, Block::Packet_descriptor &p) override {
 		io(true, lba, count, buffer, p); }
@@ -16,7 +16,7 @@
 
 
 Init::Child::Apply_config_result
-Init::Child::apply_config(Xml_node start_node)
+Init::Child::apply_config(Xml_node start_node, unsigned routing_generation)
 {
 	if (_state == STATE_ABANDONED)
 		return NO_SIDE_EFFECTS;
@@ -37,10 +37,13 @@ Init::Child::apply_config(Xml_node start_node)
 
 	Config_update config_update = CONFIG_UNCHANGED;
 
+	bool const start_node_changed =
+		start_node.size() != _start_node->xml().size() ||
+		Genode::memcmp(start_node.addr(), _start_node->xml().addr(),
+		               start_node.size()) != 0;
+
 	/* import new start node if new version differs */
-	if (start_node.size() != _start_node->xml().size() ||
-	    Genode::memcmp(start_node.addr(), _start_node->xml().addr(),
-	                   start_node.size()) != 0)
+	if (start_node_changed)
 	{
 		/*
 		 * Check for a change of the version attribute, force restart
@@ -120,6 +123,7 @@ Init::Child::apply_config(Xml_node start_node)
 
 		/* import new start node */
 		_start_node.construct(_alloc, start_node);
+		_route_cache.flush();
 	}
 
 	/*
@@ -135,8 +139,17 @@ Init::Child::apply_config(Xml_node start_node)
 	case CONFIG_VANISHED: _config_rom_service->abandon();        break;
 	}
 
-	/* validate that the routes of all existing sessions remain intact */
-	{
+	/*
+	 * Validate that the routes of all existing sessions remain intact
+	 *
+	 * The resolved routes depend only on the start node and the routing
+	 * generation. If neither changed since the last validation, the
+	 * routes are known to be intact.
+	 */
+	if (start_node_changed || routing_generation != _validated_routing_generation) {
+
+		_validated_routing_generation = routing_generation;
+
 		bool routing_changed = false;
 		_child.for_each_session([&] (Session_state const &session) {
 			if (!_route_valid(session))
@@ -169,9 +182,38 @@ static Init::Ram_quota assigned_ram_from_start_node(Genode::Xml_node start_node)
 }
 
 
+/**
+ * Return upper bound of RAM balancing, or the quantum if not balanced
+ */
+static Init::Ram_quota maximum_ram_from_start_node(Genode::Xml_node start_node)
+{
+	using namespace Init;
+
+	size_t const assigned = assigned_ram_from_start_node(start_node).value;
+	size_t       maximum  = assigned;
+
+	start_node.for_each_sub_node("resource", [&] (Xml_node resource) {
+		if (resource.attribute_value("name", String<8>()) == "RAM")
+			maximum = resource.attribute_value("maximum", Number_of_bytes(maximum)); });
+
+	return Ram_quota { max(assigned, maximum) };
+}
+
+
+Init::Ram_quota Init::Child::_ram_target() const
+{
+	Xml_node const start_node = _start_node->xml();
+
+	size_t const assigned = assigned_ram_from_start_node(start_node).value;
+	size_t const maximum  = maximum_ram_from_start_node(start_node).value;
+
+	return Ram_quota { assigned + min(_balanced_ram.value, maximum - assigned) };
+}
+
+
 void Init::Child::apply_ram_upgrade()
 {
-	Ram_quota const assigned_ram_quota = assigned_ram_from_start_node(_start_node->xml());
+	Ram_quota const assigned_ram_quota = _ram_target();
 
 	if (assigned_ram_quota.value <= _resources.assigned_ram_quota.value)
 		return;
@@ -213,7 +255,7 @@ void Init::Child::apply_ram_upgrade()
 
 void Init::Child::apply_ram_downgrade()
 {
-	Ram_quota const assigned_ram_quota = assigned_ram_from_start_node(_start_node->xml());
+	Ram_quota const assigned_ram_quota = _ram_target();
 
 	if (assigned_ram_quota.value >= _resources.assigned_ram_quota.value)
 		return;
@@ -265,72 +307,192 @@ void Init::Child::apply_ram_downgrade()
 }
 
 
-void Init::Child::report_state(Xml_generator &xml, Report_detail const &detail) const
+Init::Ram_quota Init::Child::reclaim_balanced_ram(Ram_quota amount)
 {
-	xml.node("child", [&] () {
+	size_t const withdrawn = min(amount.value, _balanced_ram.value);
 
-		xml.attribute("name",   _unique_name);
-		xml.attribute("binary", _binary_name);
+	if (!withdrawn)
+		return Ram_quota { 0 };
 
-		if (_version.valid())
-			xml.attribute("version", _version);
+	_balanced_ram = Ram_quota { _balanced_ram.value - withdrawn };
 
-		if (detail.ids())
-			xml.attribute("id", _id.value);
+	if (_verbose.enabled())
+		log("reclaim ", Number_of_bytes(withdrawn), " of balanced RAM "
+		    "from child \"", name(), "\"");
 
-		if (!_child.active())
-			xml.attribute("state", "incomplete");
+	apply_ram_downgrade();
+	_report_update_trigger.trigger_report_update();
 
-		if (_exited)
-			xml.attribute("exited", _exit_value);
+	return Ram_quota { withdrawn };
+}
 
-		if (detail.child_ram() && _child.ram_session_cap().valid()) {
-			xml.node("ram", [&] () {
 
-				xml.attribute("assigned", String<32> {
-					Number_of_bytes(_resources.assigned_ram_quota.value) });
+void Init::Child::_generate_state(Xml_generator &xml, Report_detail const &detail) const
+{
+	xml.attribute("name",   _unique_name);
+	xml.attribute("binary", _binary_name);
 
-				generate_ram_info(xml, _child.ram());
+	if (_version.valid())
+		xml.attribute("version", _version);
 
-				if (_requested_resources.constructed() && _requested_resources->ram.value)
-					xml.attribute("requested", String<32>(_requested_resources->ram));
-			});
-		}
+	if (detail.ids())
+		xml.attribute("id", _id.value);
 
-		if (detail.child_caps() && _child.pd_session_cap().valid()) {
-			xml.node("caps", [&] () {
+	if (!_child.active())
+		xml.attribute("state", "incomplete");
 
-				xml.attribute("assigned", String<32>(_resources.assigned_cap_quota));
+	if (_exited)
+		xml.attribute("exited", _exit_value);
 
-				generate_caps_info(xml, _child.pd());
+	if (_restarts)
+		xml.attribute("restarts", _restarts);
 
-				if (_requested_resources.constructed() && _requested_resources->caps.value)
-					xml.attribute("requested", String<32>(_requested_resources->caps));
-			});
-		}
+	if (detail.child_ram() && _child.ram_session_cap().valid()) {
+		xml.node("ram", [&] () {
 
-		Session_state::Detail const
-			session_detail { detail.session_args() ? Session_state::Detail::ARGS
-			                                       : Session_state::Detail::NO_ARGS};
+			xml.attribute("assigned", String<32> {
+				Number_of_bytes(_resources.assigned_ram_quota.value) });
 
-		if (detail.requested()) {
-			xml.node("requested", [&] () {
-				_child.for_each_session([&] (Session_state const &session) {
-					xml.node("session", [&] () {
-						session.generate_client_side_info(xml, session_detail); }); }); });
-		}
+			if (_balanced_ram.value)
+				xml.attribute("balanced", String<32> {
+					Number_of_bytes(_balanced_ram.value) });
+
+			generate_ram_info(xml, _child.ram());
+
+			if (_requested_resources.constructed() && _requested_resources->ram.value)
+				xml.attribute("requested", String<32>(_requested_resources->ram));
+		});
+	}
+
+	if (detail.child_caps() && _child.pd_session_cap().valid()) {
+		xml.node("caps", [&] () {
+
+			xml.attribute("assigned", String<32>(_resources.assigned_cap_quota));
+
+			generate_caps_info(xml, _child.pd());
+
+			if (_requested_resources.constructed() && _requested_resources->caps.value)
+				xml.attribute("requested", String<32>(_requested_resources->caps));
+		});
+	}
+
+	Session_state::Detail const
+		session_detail { detail.session_args() ? Session_state::Detail::ARGS
+		                                       : Session_state::Detail::NO_ARGS};
+
+	if (detail.requested()) {
+		xml.node("requested", [&] () {
+			_child.for_each_session([&] (Session_state const &session) {
+				xml.node("session", [&] () {
+					session.generate_client_side_info(xml, session_detail); }); }); });
+	}
+
+	if (detail.provided()) {
+		xml.node("provided", [&] () {
+
+			auto fn = [&] (Session_state const &session) {
+				xml.node("session", [&] () {
+					session.generate_server_side_info(xml, session_detail); }); };
+
+			_session_requester.id_space().for_each<Session_state const>(fn);
+		});
+	}
+}
+
+
+namespace Init { struct Report_buffer; }
 
-		if (detail.provided()) {
-			xml.node("provided", [&] () {
 
-				auto fn = [&] (Session_state const &session) {
-					xml.node("session", [&] () {
-						session.generate_server_side_info(xml, session_detail); }); };
+/**
+ * Heap-backed buffer for generating a '<child>' node aside
+ */
+struct Init::Report_buffer : Xml_generator::Expanding_buffer
+{
+	enum { INITIAL_SIZE = 1024 };
+
+	Allocator &_alloc;
+
+	Report_buffer(Allocator &alloc) : _alloc(alloc)
+	{
+		base = (char *)_alloc.alloc(INITIAL_SIZE);
+		size = INITIAL_SIZE;
+	}
+
+	~Report_buffer() { _alloc.free(base, size); }
+
+	bool expand(size_t min_size) override
+	{
+		size_t new_size = size;
+		while (new_size < min_size)
+			new_size *= 2;
+
+		char *new_base = nullptr;
+		try { if (!_alloc.alloc(new_size, (void **)&new_base)) return false; }
+		catch (Out_of_ram)  { return false; }
+		catch (Out_of_caps) { return false; }
+
+		memcpy(new_base, base, size);
+		_alloc.free(base, size);
+
+		base = new_base;
+		size = new_size;
+		return true;
+	}
+};
+
+
+/**
+ * Append pre-generated XML as content of the current node of 'xml'
+ *
+ * Each line is indented by one level to match the nesting of the child
+ * nodes within the state report.
+ */
+static void append_indented(Genode::Xml_generator &xml, char const *src, Genode::size_t len)
+{
+	while (len) {
+		Genode::size_t line_len = 0;
+		for (; line_len < len && src[line_len] != '\n'; line_len++);
+
+		xml.append("\n\t");
+		xml.append(src, line_len);
+
+		if (line_len < len)
+			line_len++;
+
+		src += line_len;
+		len -= line_len;
+	}
+}
+
+
+void Init::Child::report_state(Xml_generator &xml, Report_detail const &detail) const
+{
+	if (detail.child_ram() || detail.child_caps())
+		_reported_counters = counters();
 
-				_session_requester.id_space().for_each<Session_state const>(fn);
-			});
+	if (detail.changes_only()) {
+		try {
+			Report_buffer buffer(_alloc);
+
+			Xml_generator child_xml(buffer, "child", [&] () {
+				_generate_state(child_xml, detail); });
+
+			unsigned long const child_digest = digest(buffer.base, child_xml.used());
+			if (child_digest != _reported_digest) {
+				_reported_digest = child_digest;
+				append_indented(xml, buffer.base, child_xml.used());
+			}
+			return;
 		}
-	});
+		catch (Xml_generator::Buffer_exceeded) { }
+		catch (Out_of_ram)  { }
+		catch (Out_of_caps) { }
+
+		/* report the node unconditionally if it cannot be generated aside */
+		_reported_digest = 0;
+	}
+
+	xml.node("child", [&] () { _generate_state(xml, detail); });
 }
 
 
@@ -433,6 +595,20 @@ Init::Child::Route Init::Child::resolve_session_request(Service::Name const &ser
 	 && label.last_element() == Session_requester::rom_name())
 		return Route { _session_requester.service() };
 
+	unsigned const generation = _routing_generation_accessor.routing_generation();
+
+	if (Route const *route = _route_cache.lookup(service_name, label, generation))
+		return *route;
+
+	Route const route = _route_from_policy(service_name, label);
+	_route_cache.insert(service_name, label, route);
+	return route;
+}
+
+
+Init::Child::Route Init::Child::_route_from_policy(Service::Name const &service_name,
+                                                   Session_label const &label)
+{
 	try {
 		Xml_node route_node = _default_route_accessor.default_route();
 		try {
@@ -627,32 +803,66 @@ void Init::Child::resource_request(Parent::Resource_args const &args)
 
 	_requested_resources.construct(args);
 	_report_update_trigger.trigger_report_update();
+
+	/*
+	 * Serve RAM requests automatically if the start node permits the
+	 * child to grow beyond its quantum
+	 */
+	Ram_quota const maximum = maximum_ram_from_start_node(_start_node->xml());
+	Ram_quota const target  = _ram_target();
+
+	if (!_requested_resources->ram.value || maximum.value <= target.value)
+		return;
+
+	size_t grant = min(_requested_resources->ram.value,
+	                   maximum.value - target.value);
+
+	/* take RAM from other balanced children if init lacks spare RAM */
+	size_t const limit = _ram_limit_accessor.ram_limit().value;
+	if (grant > limit)
+		grant = limit + _ram_balancer.reclaim_ram(Ram_quota { grant - limit },
+		                                          *this).value;
+
+	if (!grant)
+		return;
+
+	_balanced_ram = Ram_quota { _balanced_ram.value + grant };
+
+	/*
+	 * If RAM must first be yielded by other children, the upgrade is
+	 * completed once they respond, see 'Ram_balancer::ram_released'.
+	 */
+	apply_ram_upgrade();
 }
 
 
-Init::Child::Child(Env                      &env,
-                   Allocator                &alloc,
-                   Verbose            const &verbose,
-                   Id                        id,
-                   Report_update_trigger    &report_update_trigger,
-                   Xml_node                  start_node,
-                   Default_route_accessor   &default_route_accessor,
-                   Default_caps_accessor    &default_caps_accessor,
-                   Name_registry            &name_registry,
-                   Ram_quota                 ram_limit,
-                   Cap_quota                 cap_limit,
-                   Ram_limit_accessor       &ram_limit_accessor,
-                   Prio_levels               prio_levels,
-                   Affinity::Space const    &affinity_space,
-                   Registry<Parent_service> &parent_services,
-                   Registry<Routed_service> &child_services)
+Init::Child::Child(Env                         &env,
+                   Allocator                   &alloc,
+                   Verbose               const &verbose,
+                   Id                           id,
+                   Report_update_trigger       &report_update_trigger,
+                   Xml_node                     start_node,
+                   Default_route_accessor      &default_route_accessor,
+                   Routing_generation_accessor &routing_generation_accessor,
+                   Default_caps_accessor       &default_caps_accessor,
+                   Name_registry               &name_registry,
+                   Ram_quota                    ram_limit,
+                   Cap_quota                    cap_limit,
+                   Ram_limit_accessor          &ram_limit_accessor,
+                   Ram_balancer                &ram_balancer,
+                   Prio_levels                  prio_levels,
+                   Affinity::Space const       &affinity_space,
+                   Registry<Parent_service>    &parent_services,
+                   Registry<Routed_service>    &child_services)
 :
 	_env(env), _alloc(alloc), _verbose(verbose), _id(id),
 	_report_update_trigger(report_update_trigger),
 	_list_element(this),
 	_start_node(_alloc, start_node),
 	_default_route_accessor(default_route_accessor),
+	_routing_generation_accessor(routing_generation_accessor),
 	_ram_limit_accessor(ram_limit_accessor),
+	_ram_balancer(ram_balancer),
 	_name_registry(name_registry),
 	_resources(_resources_from_start_node(start_node, prio_levels, affinity_space,
 	                                      default_caps_accessor.default_caps(), cap_limit)),
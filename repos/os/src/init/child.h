@@ -48,10 +48,33 @@ class Init::Child : Child_policy, Routed_service::Wakeup
 
 		struct Default_route_accessor { virtual Xml_node default_route() = 0; };
 
+		struct Routing_generation_accessor { virtual unsigned routing_generation() = 0; };
+
 		struct Default_caps_accessor { virtual Cap_quota default_caps() = 0; };
 
 		struct Ram_limit_accessor { virtual Ram_quota ram_limit() = 0; };
 
+		/**
+		 * Interface for redistributing RAM between balanced children
+		 */
+		struct Ram_balancer
+		{
+			/**
+			 * Reclaim RAM granted to other children beyond their quantum
+			 *
+			 * Reclaimed RAM is either returned immediately or after the
+			 * affected children responded to a yield request.
+			 *
+			 * \return  reclaimed amount, which may be lower than 'amount'
+			 */
+			virtual Ram_quota reclaim_ram(Ram_quota amount, Child const &requester) = 0;
+
+			/**
+			 * Called whenever a child released RAM in response to a yield
+			 */
+			virtual void ram_released() = 0;
+		};
+
 	private:
 
 		friend class Child_registry;
@@ -83,8 +106,12 @@ class Init::Child : Child_policy, Routed_service::Wakeup
 
 		Default_route_accessor &_default_route_accessor;
 
+		Routing_generation_accessor &_routing_generation_accessor;
+
 		Ram_limit_accessor &_ram_limit_accessor;
 
+		Ram_balancer &_ram_balancer;
+
 		Name_registry &_name_registry;
 
 		/**
@@ -315,6 +342,17 @@ class Init::Child : Child_policy, Routed_service::Wakeup
 
 		Constructible<Requested_resources> _requested_resources;
 
+		/*
+		 * RAM granted in response to resource requests beyond the quantum
+		 * of the start node, bounded by the 'maximum' attribute
+		 */
+		Ram_quota _balanced_ram { 0 };
+
+		/**
+		 * Return RAM quota the child is supposed to own
+		 */
+		Ram_quota _ram_target() const;
+
 		Genode::Child _child { _env.rm(), _env.ep().rpc_ep(), *this };
 
 		struct Ram_pd_accessor : Routed_service::Ram_accessor,
@@ -412,6 +450,121 @@ class Init::Child : Child_policy, Routed_service::Wakeup
 		bool _exited     { false };
 		int  _exit_value { -1 };
 
+		/* number of times the child was restarted by init */
+		unsigned _restarts = 0;
+
+	public:
+
+		/**
+		 * Counters that can be obtained without generating a state report
+		 */
+		struct Counters
+		{
+			size_t   ram_used;
+			size_t   caps_used;
+			unsigned restarts;
+
+			bool operator != (Counters const &other) const
+			{
+				return ram_used  != other.ram_used
+				    || caps_used != other.caps_used
+				    || restarts  != other.restarts;
+			}
+		};
+
+	private:
+
+		/*
+		 * State as of the last report, used to detect changes
+		 */
+		Counters      mutable _reported_counters { 0, 0, 0 };
+		unsigned long mutable _reported_digest = 0;
+
+		/* routing generation of the last validation of the session routes */
+		unsigned _validated_routing_generation = 0;
+
+		/**
+		 * Cache of the routes obtained from the routing policy
+		 *
+		 * The routes depend only on the start node and the routing
+		 * generation. The cache is flushed whenever one of them changes.
+		 */
+		class Route_cache : Noncopyable
+		{
+			private:
+
+				enum { MAX_ENTRIES = 16 };
+
+				struct Entry
+				{
+					Service::Name        service_name { };
+					Session_label        label        { };
+					Constructible<Route> route        { };
+				};
+
+				Entry    _entries[MAX_ENTRIES];
+				unsigned _next       = 0;
+				unsigned _generation = 0;
+
+			public:
+
+				void flush()
+				{
+					for (unsigned i = 0; i < MAX_ENTRIES; i++)
+						_entries[i].route.destruct();
+				}
+
+				Route const *lookup(Service::Name const &service_name,
+				                    Session_label const &label,
+				                    unsigned             generation)
+				{
+					if (generation != _generation) {
+						flush();
+						_generation = generation;
+						return nullptr;
+					}
+
+					for (unsigned i = 0; i < MAX_ENTRIES; i++) {
+						Entry const &e = _entries[i];
+						if (e.route.constructed() && e.service_name == service_name
+						 && e.label == label)
+							return &*e.route;
+					}
+					return nullptr;
+				}
+
+				/**
+				 * Insert route, replacing the oldest entry if the cache is full
+				 */
+				void insert(Service::Name const &service_name,
+				            Session_label const &label, Route const &route)
+				{
+					Entry &e = _entries[_next];
+					_next = (_next + 1) % MAX_ENTRIES;
+
+					e.service_name = service_name;
+					e.label        = label;
+					e.route.construct(route);
+				}
+
+		} _route_cache { };
+
+		/**
+		 * Resolve session request according to the '<route>' node or the
+		 * default route
+		 *
+		 * \throw Service_denied
+		 */
+		Route _route_from_policy(Service::Name const &, Session_label const &);
+
+		/* set while initiating the environment sessions for parallel startup */
+		bool _defer_process_construction = false;
+
+		/* set if the child skipped more heartbeats than tolerated */
+		bool _unresponsive = false;
+
+		void _generate_state(Xml_generator &, Report_detail const &) const;
+
 	public:
 
 		/**
@@ -429,24 +582,29 @@ class Init::Child : Child_policy, Routed_service::Wakeup
 		 *                            RAM, used for dynamic RAM balancing at
 		 *                            runtime.
 		 *
+		 * \param ram_balancer        interface for reclaiming RAM from other
+		 *                            children when serving resource requests
+		 *
 		 * \throw Allocator::Out_of_memory  could not buffer the XML start node
 		 */
-		Child(Env                      &env,
-		      Allocator                &alloc,
-		      Verbose            const &verbose,
-		      Id                        id,
-		      Report_update_trigger    &report_update_trigger,
-		      Xml_node                  start_node,
-		      Default_route_accessor   &default_route_accessor,
-		      Default_caps_accessor    &default_caps_accessor,
-		      Name_registry            &name_registry,
-		      Ram_quota                 ram_limit,
-		      Cap_quota                 cap_limit,
-		      Ram_limit_accessor       &ram_limit_accessor,
-		      Prio_levels               prio_levels,
-		      Affinity::Space const    &affinity_space,
-		      Registry<Parent_service> &parent_services,
-		      Registry<Routed_service> &child_services);
+		Child(Env                         &env,
+		      Allocator                   &alloc,
+		      Verbose               const &verbose,
+		      Id                           id,
+		      Report_update_trigger       &report_update_trigger,
+		      Xml_node                     start_node,
+		      Default_route_accessor      &default_route_accessor,
+		      Routing_generation_accessor &routing_generation_accessor,
+		      Default_caps_accessor       &default_caps_accessor,
+		      Name_registry               &name_registry,
+		      Ram_quota                    ram_limit,
+		      Cap_quota                    cap_limit,
+		      Ram_limit_accessor          &ram_limit_accessor,
+		      Ram_balancer                &ram_balancer,
+		      Prio_levels                  prio_levels,
+		      Affinity::Space const       &affinity_space,
+		      Registry<Parent_service>    &parent_services,
+		      Registry<Routed_service>    &child_services);
 
 		virtual ~Child();
 
@@ -466,11 +624,20 @@ class Init::Child : Child_policy, Routed_service::Wakeup
 			}
 		}
 
-		void initiate_env_sessions()
+		/**
+		 * Initiate the environment sessions of the child
+		 *
+		 * \param defer_process  if true, the loading of the executable is
+		 *                       left to a subsequent call of
+		 *                       'construct_process'
+		 */
+		void initiate_env_sessions(bool defer_process = false)
 		{
 			if (_state == STATE_RAM_INITIALIZED) {
 
+				_defer_process_construction = defer_process;
 				_child.initiate_env_sessions();
+				_defer_process_construction = false;
 
 				/* check for completeness of the child's environment */
 				if (_verbose.enabled())
@@ -495,21 +662,102 @@ class Init::Child : Child_policy, Routed_service::Wakeup
 
 		bool abandoned() const { return _state == STATE_ABANDONED; }
 
+		bool process_pending() const { return _child.process_pending(); }
+
+		/**
+		 * Set up the ELF segments of a pending process and start it
+		 *
+		 * May be called by a helper thread, see 'Parallel_startup'.
+		 */
+		void construct_process() { _child.construct_process(); }
+
 		enum Apply_config_result { MAY_HAVE_SIDE_EFFECTS, NO_SIDE_EFFECTS };
 
 		/**
 		 * Apply new configuration to child
 		 *
+		 * \param routing_generation  counter that is incremented by the caller
+		 *                            whenever the routing of an unchanged start
+		 *                            node may yield a different result. The
+		 *                            routes of the child's sessions are
+		 *                            validated only if the start node changed
+		 *                            or if the value differs from the one of
+		 *                            the previous validation.
+		 *
 		 * \throw Allocator::Out_of_memory  unable to allocate buffer for new
 		 *                                  config
 		 */
-		Apply_config_result apply_config(Xml_node start_node);
+		Apply_config_result apply_config(Xml_node start_node,
+		                                 unsigned routing_generation);
 
 		void apply_ram_upgrade();
 		void apply_ram_downgrade();
 
+		/**
+		 * Return RAM granted beyond the quantum of the start node
+		 */
+		Ram_quota balanced_ram() const { return _balanced_ram; }
+
+		/**
+		 * Withdraw up to 'amount' of the balanced RAM from the child
+		 *
+		 * \return  withdrawn amount, which is returned to init either
+		 *          immediately or once the child responded to the
+		 *          resulting yield request
+		 */
+		Ram_quota reclaim_balanced_ram(Ram_quota amount);
+
+		/**
+		 * Generate '<child>' node of the state report
+		 *
+		 * If the report detail asks for changes only, the node is left
+		 * out if it equals the node generated by the previous call.
+		 */
 		void report_state(Xml_generator &xml, Report_detail const &detail) const;
 
+		Counters counters() const
+		{
+			return Counters {
+				_child.ram_session_cap().valid() ? _child.ram().used_ram().value : 0,
+				_child.pd_session_cap().valid()  ? _child.pd().used_caps().value : 0,
+				_restarts };
+		}
+
+		/**
+		 * Return true if the counters changed since the last report
+		 */
+		bool counters_changed() const { return counters() != _reported_counters; }
+
+		unsigned restarts() const { return _restarts; }
+
+		/**
+		 * Send heartbeat signal to the child
+		 *
+		 * \param skip  number of skipped heartbeats tolerated
+		 *
+		 * \return  true if the child became unresponsive or recovered
+		 */
+		bool heartbeat(unsigned skip)
+		{
+			_child.heartbeat();
+
+			bool const unresponsive = _child.skipped_heartbeats() > skip;
+			bool const changed      = unresponsive != _unresponsive;
+
+			_unresponsive = unresponsive;
+			return changed;
+		}
+
+		bool unresponsive() const { return _unresponsive; }
+
+		unsigned skipped_heartbeats() const { return _child.skipped_heartbeats(); }
+
+		/**
+		 * Take over the restart count of the predecessor of a restarted child
+		 */
+		void restarted(unsigned predecessor_restarts) {
+			_restarts = predecessor_restarts + 1; }
+
 
 		/****************************
 		 ** Child-policy interface **
@@ -566,9 +814,13 @@ class Init::Child : Child_policy, Routed_service::Wakeup
 
 		bool initiate_env_sessions() const override { return false; }
 
+		bool defer_process_construction() const override {
+			return _defer_process_construction; }
+
 		void yield_response() override
 		{
 			apply_ram_downgrade();
+			_ram_balancer.ram_released();
 			_report_update_trigger.trigger_report_update();
 		}
 };
@@ -136,6 +136,19 @@ class Init::Child_registry : public Name_registry, Child_list
 			}
 		}
 
+		/**
+		 * Return true if the counters of any child changed since the last
+		 * state report
+		 */
+		bool counters_changed() const
+		{
+			bool changed = false;
+			for_each_child([&] (Child const &child) {
+				changed = changed || child.counters_changed(); });
+
+			return changed;
+		}
+
 		Child::Name deref_alias(Child::Name const &name) override
 		{
 			for (Alias const *a = _aliases.first(); a; a = a->next())
@@ -0,0 +1,151 @@
+/*
+ * \brief  Heartbeat monitoring of children
+ * \author Genode Labs
+ * \date   2026-10-14
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _SRC__INIT__HEARTBEAT_H_
+#define _SRC__INIT__HEARTBEAT_H_
+
+/* Genode includes */
+#include <os/reporter.h>
+#include <timer_session/connection.h>
+
+/* local includes */
+#include <child_registry.h>
+
+namespace Init { class Heartbeat; }
+
+
+/**
+ * Periodic heartbeat signals sent to all children
+ *
+ * Children that miss to respond to more than 'skip' heartbeats are listed
+ * in the "heartbeat" report. The report is generated only if a child
+ * becomes unresponsive or recovers. So the monitoring neither involves the
+ * generation of the state report nor the parsing of reports by a watchdog.
+ */
+class Init::Heartbeat : Noncopyable
+{
+	private:
+
+		Env &_env;
+
+		Child_registry &_children;
+
+		Constructible<Timer::Connection> _timer;
+
+		Constructible<Reporter> _reporter;
+
+		unsigned _rate_ms = 0;
+		unsigned _skip    = 0;
+
+		/* number of unresponsive children as of the last report */
+		unsigned _reported_unresponsive = 0;
+
+		void _generate_report()
+		{
+			try {
+				Reporter::Xml_generator xml(*_reporter, [&] () {
+					xml.attribute("rate_ms", _rate_ms);
+
+					_children.for_each_child([&] (Child const &child) {
+						if (!child.unresponsive())
+							return;
+
+						xml.node("child", [&] () {
+							xml.attribute("name", child.name());
+							xml.attribute("skipped_heartbeats",
+							              child.skipped_heartbeats());
+						});
+					});
+				});
+			}
+			catch (Xml_generator::Buffer_exceeded) {
+				error("heartbeat report exceeds maximum size"); }
+		}
+
+		void _handle_timer()
+		{
+			bool     changed      = false;
+			unsigned unresponsive = 0;
+
+			_children.for_each_child([&] (Child &child) {
+				if (child.heartbeat(_skip))
+					changed = true;
+				if (child.unresponsive())
+					unresponsive++;
+			});
+
+			/* a destroyed unresponsive child leaves no state change behind */
+			if (unresponsive != _reported_unresponsive)
+				changed = true;
+
+			if (!changed)
+				return;
+
+			_reported_unresponsive = unresponsive;
+
+			if (_reporter.constructed())
+				_generate_report();
+		}
+
+		Signal_handler<Heartbeat> _timer_handler {
+			_env.ep(), *this, &Heartbeat::_handle_timer };
+
+	public:
+
+		Heartbeat(Env &env, Child_registry &children)
+		: _env(env), _children(children) { }
+
+		void apply_config(Xml_node config)
+		{
+			unsigned rate_ms = 0;
+			bool     report  = false;
+			unsigned skip    = 1;
+
+			if (config.has_sub_node("heartbeat")) {
+				Xml_node const heartbeat = config.sub_node("heartbeat");
+
+				rate_ms = heartbeat.attribute_value("rate_ms", 1000U);
+				skip    = heartbeat.attribute_value("skip", skip);
+				report  = heartbeat.attribute_value("report", true);
+			}
+
+			_skip = skip;
+
+			if (report && !_reporter.constructed()) {
+				_reporter.construct(_env, "heartbeat", "heartbeat");
+				_reporter->enabled(true);
+				_reported_unresponsive = ~0U;
+			}
+
+			if (!report && _reporter.constructed())
+				_reporter.destruct();
+
+			if (rate_ms == _rate_ms)
+				return;
+
+			_rate_ms = rate_ms;
+
+			if (!_rate_ms) {
+				_timer.destruct();
+				return;
+			}
+
+			if (!_timer.constructed()) {
+				_timer.construct(_env);
+				_timer->sigh(_timer_handler);
+			}
+			_timer->trigger_periodic(1000*_rate_ms);
+		}
+};
+
+#endif /* _SRC__INIT__HEARTBEAT_H_ */
@@ -14,19 +14,25 @@
 /* Genode includes */
 #include <base/component.h>
 #include <base/attached_rom_dataspace.h>
+#include <util/xml_index.h>
 
 /* local includes */
 #include <child_registry.h>
 #include <child.h>
 #include <alias.h>
 #include <state_reporter.h>
+#include <heartbeat.h>
 #include <server.h>
+#include <start_node_index.h>
+#include <parallel_startup.h>
 
 namespace Init { struct Main; }
 
 
 struct Init::Main : State_reporter::Producer, Child::Default_route_accessor,
-                    Child::Default_caps_accessor, Child::Ram_limit_accessor
+                    Child::Routing_generation_accessor,
+                    Child::Default_caps_accessor, Child::Ram_limit_accessor,
+                    Child::Ram_balancer
 {
 	Env &_env;
 
@@ -40,14 +46,89 @@ struct Init::Main : State_reporter::Producer, Child::Default_route_accessor,
 
 	Xml_node _config_xml = _config.xml();
 
+	/* index used for the repeated traversal of the config's nodes */
+	Constructible<Xml_index> _config_index;
+
+	/* index used for looking up the start node of a child */
+	Constructible<Start_node_index> _start_node_index;
+
+	/*
+	 * Counter incremented whenever the routing of an unchanged start node
+	 * may yield a different result, prompting children to validate the
+	 * routes of their sessions
+	 */
+	unsigned _routing_generation = 1;
+
+	/* digest of the config nodes that the routing of all children depends on */
+	unsigned long _routing_config_digest = 0;
+
+	/**
+	 * Statistics of the last reconfiguration
+	 */
+	struct Reconfig_info
+	{
+		unsigned      count;
+		unsigned long duration_ms;
+	};
+
+	Reconfig_info _reconfig_info { 0, 0 };
+
 	Reconstructible<Verbose> _verbose { _config_xml };
 
 	Constructible<Buffered_xml> _default_route;
 
 	Cap_quota _default_caps { 0 };
 
+	/* maximum number of threads used for the startup, 0 if sequential */
+	unsigned _startup_threads = 0;
+
+	static unsigned _startup_threads_from_config(Xml_node config)
+	{
+		try {
+			Xml_node const startup = config.sub_node("startup");
+			if (startup.attribute_value("parallel", false))
+				return startup.attribute_value("threads", ~0U);
+		}
+		catch (Xml_node::Nonexistent_sub_node) { }
+
+		return 0;
+	}
+
+	void _construct_pending_processes();
+
 	unsigned _child_cnt = 0;
 
+	/**
+	 * Restart count of a child that is destroyed to be started anew
+	 */
+	struct Restarted_child : List<Restarted_child>::Element
+	{
+		Child_policy::Name const name;
+		unsigned           const restarts;
+
+		Restarted_child(Child_policy::Name const &name, unsigned restarts)
+		: name(name), restarts(restarts) { }
+	};
+
+	List<Restarted_child> _restarted_children;
+
+	bool _start_node_exists(Child_policy::Name const &name) const
+	{
+		return _start_node_index->exists(name);
+	}
+
+	static unsigned long _routing_config_digest_from_config(Xml_node config)
+	{
+		unsigned long result = 0;
+
+		config.for_each_sub_node([&] (Xml_node node) {
+			if (node.has_type("default-route") || node.has_type("alias")
+			 || node.has_type("parent-provides"))
+				result = result*31 + digest(node.addr(), node.size()); });
+
+		return result;
+	}
+
 	static Ram_quota _preserved_ram_from_config(Xml_node config)
 	{
 		Number_of_bytes preserve { 40*sizeof(long)*1024 };
@@ -105,6 +186,42 @@ struct Init::Main : State_reporter::Producer, Child::Default_route_accessor,
 	 */
 	Ram_quota ram_limit() override { return _avail_ram(); }
 
+	/**
+	 * Child::Ram_balancer interface
+	 *
+	 * RAM is withdrawn from the children with the largest balanced
+	 * grants first.
+	 */
+	Ram_quota reclaim_ram(Ram_quota amount, Child const &requester) override
+	{
+		size_t reclaimed = 0;
+
+		while (reclaimed < amount.value) {
+
+			Child *victim = nullptr;
+			_children.for_each_child([&] (Child &child) {
+				if (&child == &requester || !child.balanced_ram().value)
+					return;
+				if (!victim || child.balanced_ram().value > victim->balanced_ram().value)
+					victim = &child; });
+
+			if (!victim)
+				break;
+
+			reclaimed += victim->reclaim_balanced_ram(
+				Ram_quota { amount.value - reclaimed }).value;
+		}
+		return Ram_quota { reclaimed };
+	}
+
+	/**
+	 * Child::Ram_balancer interface
+	 */
+	void ram_released() override
+	{
+		_children.for_each_child([&] (Child &child) { child.apply_ram_upgrade(); });
+	}
+
 	void _handle_resource_avail() { }
 
 	void produce_state_report(Xml_generator &xml, Report_detail const &detail) const
@@ -115,10 +232,21 @@ struct Init::Main : State_reporter::Producer, Child::Default_route_accessor,
 		if (detail.init_caps())
 			xml.node("caps", [&] () { generate_caps_info(xml, _env.pd()); });
 
+		if (detail.reconfig())
+			xml.node("reconfig", [&] () {
+				xml.attribute("count",       _reconfig_info.count);
+				xml.attribute("duration_ms", _reconfig_info.duration_ms);
+			});
+
 		if (detail.children())
 			_children.report_state(xml, detail);
 	}
 
+	bool child_counters_changed() const override
+	{
+		return _children.counters_changed();
+	}
+
 	/**
 	 * Default_route_accessor interface
 	 */
@@ -128,6 +256,11 @@ struct Init::Main : State_reporter::Producer, Child::Default_route_accessor,
 		                                    : Xml_node("<empty/>");
 	}
 
+	/**
+	 * Routing_generation_accessor interface
+	 */
+	unsigned routing_generation() override { return _routing_generation; }
+
 	/**
 	 * Default_caps_accessor interface
 	 */
@@ -135,6 +268,8 @@ struct Init::Main : State_reporter::Producer, Child::Default_route_accessor,
 
 	State_reporter _state_reporter { _env, *this };
 
+	Heartbeat _heartbeat { _env, _children };
+
 	Signal_handler<Main> _resource_avail_handler {
 		_env.ep(), *this, &Main::_handle_resource_avail };
 
@@ -242,14 +377,7 @@ void Init::Main::_abandon_obsolete_children()
 {
 	_children.for_each_child([&] (Child &child) {
 
-		Child_policy::Name const name = child.name();
-
-		bool obsolete = true;
-		_config_xml.for_each_sub_node("start", [&] (Xml_node node) {
-			if (node.attribute_value("name", Child_policy::Name()) == name)
-				obsolete = false; });
-
-		if (obsolete)
+		if (!_start_node_exists(child.name()))
 			child.abandon();
 	});
 }
@@ -267,35 +395,96 @@ void Init::Main::_update_children_config()
 		 */
 		bool side_effects = false;
 
-		_config_xml.for_each_sub_node("start", [&] (Xml_node node) {
+		_children.for_each_child([&] (Child &child) {
 
-			Child_policy::Name const start_node_name =
-				node.attribute_value("name", Child_policy::Name());
+			Start_node_index::Entry const *entry =
+				_start_node_index->lookup(child.name());
 
-			_children.for_each_child([&] (Child &child) {
-				if (child.name() == start_node_name) {
-					switch (child.apply_config(node)) {
-					case Child::NO_SIDE_EFFECTS: break;
-					case Child::MAY_HAVE_SIDE_EFFECTS: side_effects = true; break;
-					};
-				}
-			});
+			if (!entry)
+				return;
+
+			switch (child.apply_config(entry->node, _routing_generation)) {
+			case Child::NO_SIDE_EFFECTS: break;
+			case Child::MAY_HAVE_SIDE_EFFECTS: side_effects = true; break;
+			};
 		});
 
 		if (!side_effects)
 			break;
+
+		/* the set of services changed, revalidate the routes of all children */
+		_routing_generation++;
 	}
 }
 
 
+void Init::Main::_construct_pending_processes()
+{
+	size_t num_pending = 0;
+	_children.for_each_child([&] (Child const &child) {
+		if (child.process_pending())
+			num_pending++; });
+
+	if (!num_pending)
+		return;
+
+	try {
+		Parallel_startup startup(_heap, num_pending);
+
+		_children.for_each_child([&] (Child &child) {
+			if (child.process_pending())
+				startup.add(child); });
+
+		startup.execute(_env, _startup_threads);
+	}
+	catch (Out_of_ram)  { warning("out of RAM during parallel startup"); }
+	catch (Out_of_caps) { warning("out of caps during parallel startup"); }
+
+	/* construct remaining processes sequentially */
+	_children.for_each_child([&] (Child &child) {
+		child.construct_process(); });
+}
+
+
 void Init::Main::_handle_config()
 {
+	unsigned long start_ms = _state_reporter.elapsed_ms();
+
 	_config.update();
 
 	_config_xml = _config.xml();
 
+	_config_index.destruct();
+	try {
+		_config_index.construct(_heap, _config_xml);
+		_config_xml = _config_index->xml();
+	}
+	catch (Xml_node::Invalid_syntax) { }
+	catch (Out_of_ram)  { }
+	catch (Out_of_caps) { }
+
+	_start_node_index.destruct();
+	try {
+		_start_node_index.construct(_heap, _config_xml); }
+	catch (Out_of_ram)  { error("unable to allocate start-node index"); return; }
+	catch (Out_of_caps) { error("unable to allocate start-node index"); return; }
+
 	_verbose.construct(_config_xml);
 	_state_reporter.apply_config(_config_xml);
+	_heartbeat.apply_config(_config_xml);
+
+	/* the timer may have been created by applying the report config */
+	if (!start_ms)
+		start_ms = _state_reporter.elapsed_ms();
+
+	/* revalidate all routes if a node affecting all children changed */
+	unsigned long const routing_config_digest =
+		_routing_config_digest_from_config(_config_xml);
+
+	if (routing_config_digest != _routing_config_digest) {
+		_routing_config_digest = routing_config_digest;
+		_routing_generation++;
+	}
 
 	/* determine default route for resolving service requests */
 	try {
@@ -308,6 +497,8 @@ void Init::Main::_handle_config()
 		                                   .attribute_value("caps", 0UL) }; }
 	catch (...) { }
 
+	_startup_threads = _startup_threads_from_config(_config_xml);
+
 	Prio_levels     const prio_levels    = prio_levels_from_xml(_config_xml);
 	Affinity::Space const affinity_space = affinity_space_from_xml(_config_xml);
 
@@ -316,9 +507,18 @@ void Init::Main::_handle_config()
 	_abandon_obsolete_children();
 	_update_children_config();
 
-	/* kill abandoned children */
+	/* the services provided by abandoned and new children affect routing */
+	bool children_changed = false;
+
+	/* kill abandoned children, remember the restart count of restarted ones */
 	_children.for_each_child([&] (Child &child) {
 		if (child.abandoned()) {
+			children_changed = true;
+
+			if (_start_node_exists(child.name()))
+				_restarted_children.insert(new (_heap)
+					Restarted_child(child.name(), child.restarts()));
+
 			_children.remove(&child);
 			destroy(_heap, &child);
 		}
@@ -334,18 +534,20 @@ void Init::Main::_handle_config()
 	Ram_quota used_ram  { 0 };
 	Cap_quota used_caps { 0 };
 
+	_children.for_each_child([&] (Child const &child) {
+		if (Start_node_index::Entry *entry = _start_node_index->lookup(child.name()))
+			entry->child_exists = true; });
+
 	/* create new children */
 	try {
 		_config_xml.for_each_sub_node("start", [&] (Xml_node start_node) {
 
+			Start_node_index::Entry * const entry = _start_node_index->lookup(
+				start_node.attribute_value("name", Child_policy::Name()));
+
 			/* skip start node if corresponding child already exists */
-			bool exists = false;
-			_children.for_each_child([&] (Child const &child) {
-				if (child.name() == start_node.attribute_value("name", Child_policy::Name()))
-					exists = true; });
-			if (exists) {
+			if (entry && entry->child_exists)
 				return;
-			}
 
 			if (used_ram.value > avail_ram.value) {
 				error("RAM exhausted while starting childen");
@@ -361,13 +563,22 @@ void Init::Main::_handle_config()
 				Init::Child &child = *new (_heap)
 					Init::Child(_env, _heap, *_verbose,
 					            Init::Child::Id { ++_child_cnt }, _state_reporter,
-					            start_node, *this, *this, _children,
+					            start_node, *this, *this, *this, _children,
 					            Ram_quota { avail_ram.value  - used_ram.value },
 					            Cap_quota { avail_caps.value - used_caps.value },
-					             *this, prio_levels, affinity_space,
+					            *this, *this, prio_levels, affinity_space,
 					            _parent_services, _child_services);
 				_children.insert(&child);
 
+				if (entry)
+					entry->child_exists = true;
+
+				children_changed = true;
+
+				for (Restarted_child *r = _restarted_children.first(); r; r = r->next())
+					if (r->name == child.name())
+						child.restarted(r->restarts);
+
 				/* account for the start XML node buffered in the child */
 				size_t const metadata_overhead = start_node.size()
 				                               + sizeof(Init::Child);
@@ -405,6 +616,11 @@ void Init::Main::_handle_config()
 	catch (Xml_node::Invalid_syntax) { error("config has invalid syntax"); }
 	catch (Init::Child_registry::Alias_name_is_not_unique) { }
 
+	while (Restarted_child *r = _restarted_children.first()) {
+		_restarted_children.remove(r);
+		destroy(_heap, r);
+	}
+
 	/*
 	 * Initiate RAM sessions of all new children
 	 */
@@ -415,7 +631,9 @@ void Init::Main::_handle_config()
 	 * Initiate remaining environment sessions of all new children
 	 */
 	_children.for_each_child([&] (Child &child) {
-		child.initiate_env_sessions(); });
+		child.initiate_env_sessions(_startup_threads > 0); });
+
+	_construct_pending_processes();
 
 	/*
 	 * (Re-)distribute RAM among the childen, given their resource assignments
@@ -427,6 +645,16 @@ void Init::Main::_handle_config()
 	_children.for_each_child([&] (Child &child) { child.apply_ram_upgrade(); });
 
 	_server.apply_config(_config_xml);
+
+	if (children_changed)
+		_routing_generation++;
+
+	_reconfig_info = Reconfig_info {
+		_reconfig_info.count + 1,
+		start_ms ? _state_reporter.elapsed_ms() - start_ms : 0 };
+
+	if (_verbose->enabled() && start_ms)
+		log("reconfiguration took ", _reconfig_info.duration_ms, " ms");
 }
 
 
@@ -0,0 +1,143 @@
+/*
+ * \brief  Concurrent loading of the executables of new children
+ * \author Genode Labs
+ * \date   2026-10-14
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _SRC__INIT__PARALLEL_STARTUP_H_
+#define _SRC__INIT__PARALLEL_STARTUP_H_
+
+/* Genode includes */
+#include <base/thread.h>
+#include <base/lock.h>
+
+/* local includes */
+#include <child.h>
+
+namespace Init { class Parallel_startup; }
+
+
+/**
+ * Set up the ELF segments of children on helper threads
+ *
+ * The environment sessions of the children are created by init's
+ * entrypoint. Only children whose environment is complete at that time
+ * have a pending process, i.e., children that do not depend on the
+ * sessions of other children. Their processes are constructed by a number
+ * of helper threads spread across the CPUs. The calling thread blocks until
+ * all processes are constructed.
+ */
+class Init::Parallel_startup : Noncopyable
+{
+	private:
+
+		enum { STACK_SIZE = 4*1024*sizeof(long) };
+
+		Allocator &_alloc;
+
+		size_t const _num_children;
+
+		Child **_children;
+
+		size_t _num_added = 0;
+
+		Lock   _lock { };
+		size_t _next = 0;
+
+		Child *_next_child()
+		{
+			Lock::Guard guard(_lock);
+			return (_next < _num_added) ? _children[_next++] : nullptr;
+		}
+
+		struct Helper : Thread
+		{
+			Parallel_startup &_startup;
+
+			Helper(Env &env, Parallel_startup &startup, Affinity::Location location)
+			:
+				Thread(env, "startup", STACK_SIZE, location, Weight(), env.cpu()),
+				_startup(startup)
+			{ }
+
+			void entry() override
+			{
+				while (Child *child = _startup._next_child())
+					child->construct_process();
+			}
+		};
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param num_children  maximum number of children to be added
+		 *
+		 * \throw Out_of_ram
+		 * \throw Out_of_caps
+		 */
+		Parallel_startup(Allocator &alloc, size_t num_children)
+		:
+			_alloc(alloc), _num_children(num_children),
+			_children((Child **)_alloc.alloc(num_children*sizeof(Child *)))
+		{ }
+
+		~Parallel_startup() { _alloc.free(_children, _num_children*sizeof(Child *)); }
+
+		void add(Child &child)
+		{
+			if (_num_added < _num_children)
+				_children[_num_added++] = &child;
+		}
+
+		/**
+		 * Construct the processes of all added children
+		 *
+		 * \param max_threads  maximum number of helper threads
+		 */
+		void execute(Env &env, unsigned max_threads)
+		{
+			Affinity::Space cpus = env.cpu().affinity_space();
+
+			unsigned const num_threads =
+				(unsigned)min((size_t)min(max_threads, cpus.total()), _num_added);
+
+			Helper **helpers = (Helper **)_alloc.alloc(num_threads*sizeof(Helper *));
+
+			unsigned started = 0;
+			for (; started < num_threads; started++) {
+				try {
+					helpers[started] = new (_alloc)
+						Helper(env, *this, cpus.location_of_index(started));
+				}
+				catch (...) {
+					warning("unable to create startup helper thread");
+					break;
+				}
+			}
+
+			for (unsigned i = 0; i < started; i++)
+				helpers[i]->start();
+
+			/* help the helpers, and cover the case of no helper at all */
+			while (Child *child = _next_child())
+				child->construct_process();
+
+			for (unsigned i = 0; i < started; i++) {
+				helpers[i]->join();
+				destroy(_alloc, helpers[i]);
+			}
+
+			_alloc.free(helpers, num_threads*sizeof(Helper *));
+		}
+};
+
+#endif /* _SRC__INIT__PARALLEL_STARTUP_H_ */
@@ -36,6 +36,8 @@ class Init::Report_detail : Genode::Noncopyable
 		bool _child_caps   = false;
 		bool _init_ram     = false;
 		bool _init_caps    = false;
+		bool _changes_only = false;
+		bool _reconfig     = false;
 
 	public:
 
@@ -52,6 +54,8 @@ class Init::Report_detail : Genode::Noncopyable
 			_child_caps   = report.attribute_value("child_caps",   false);
 			_init_ram     = report.attribute_value("init_ram",     false);
 			_init_caps    = report.attribute_value("init_caps",    false);
+			_changes_only = report.attribute_value("changes_only", false);
+			_reconfig     = report.attribute_value("reconfig",     false);
 		}
 
 		bool children()     const { return _children;     }
@@ -63,6 +67,16 @@ class Init::Report_detail : Genode::Noncopyable
 		bool child_caps()   const { return _child_caps;   }
 		bool init_ram()     const { return _init_ram;     }
 		bool init_caps()    const { return _init_caps;    }
+
+		/**
+		 * Return true if unchanged '<child>' nodes are left out
+		 */
+		bool changes_only() const { return _changes_only; }
+
+		/**
+		 * Return true if the duration of the last reconfiguration is reported
+		 */
+		bool reconfig() const { return _reconfig; }
 };
 
 
@@ -0,0 +1,129 @@
+/*
+ * \brief  Lookup of start nodes by name
+ * \author Genode Labs
+ * \date   2026-10-14
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _SRC__INIT__START_NODE_INDEX_H_
+#define _SRC__INIT__START_NODE_INDEX_H_
+
+/* Genode includes */
+#include <base/child.h>
+#include <util/construct_at.h>
+
+/* local includes */
+#include <types.h>
+#include <utils.h>
+
+namespace Init { class Start_node_index; }
+
+
+/**
+ * Hash table of the '<start>' nodes of a config
+ *
+ * The index replaces the repeated scans of all start nodes for each child
+ * when applying a new config. If a name appears multiple times, the first
+ * start node is taken, which corresponds to init's handling of duplicates.
+ */
+class Init::Start_node_index : Noncopyable
+{
+	public:
+
+		typedef Child_policy::Name Name;
+
+		struct Entry
+		{
+			Name     name;
+			Xml_node node;
+
+			/* set while a child of this name exists */
+			bool child_exists;
+		};
+
+	private:
+
+		Allocator &_alloc;
+
+		size_t const _num_slots;
+
+		Entry *_entries;
+
+		static size_t _num_slots_for(Xml_node config)
+		{
+			size_t count = 0;
+			config.for_each_sub_node("start", [&] (Xml_node) { count++; });
+
+			/* keep the load factor below 1/2 */
+			size_t slots = 16;
+			while (slots < 2*count)
+				slots *= 2;
+
+			return slots;
+		}
+
+		size_t _slot(Name const &name) const {
+			return digest(name.string(), name.length()) & (_num_slots - 1); }
+
+		/**
+		 * Return entry for the name, or an unused entry
+		 */
+		Entry &_lookup(Name const &name) const
+		{
+			size_t i = _slot(name);
+			for (; _entries[i].name.valid() && _entries[i].name != name;
+			     i = (i + 1) & (_num_slots - 1));
+
+			return _entries[i];
+		}
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \throw Out_of_ram
+		 * \throw Out_of_caps
+		 */
+		Start_node_index(Allocator &alloc, Xml_node config)
+		:
+			_alloc(alloc), _num_slots(_num_slots_for(config)),
+			_entries((Entry *)_alloc.alloc(_num_slots*sizeof(Entry)))
+		{
+			for (size_t i = 0; i < _num_slots; i++)
+				construct_at<Entry>(&_entries[i],
+				                    Entry { Name(), Xml_node("<empty/>"), false });
+
+			config.for_each_sub_node("start", [&] (Xml_node node) {
+
+				Name const name = node.attribute_value("name", Name());
+				if (!name.valid())
+					return;
+
+				Entry &entry = _lookup(name);
+				if (!entry.name.valid())
+					entry = Entry { name, node, false };
+			});
+		}
+
+		~Start_node_index() { _alloc.free(_entries, _num_slots*sizeof(Entry)); }
+
+		/**
+		 * Return entry of start node with the given name, or nullptr
+		 */
+		Entry *lookup(Name const &name)
+		{
+			Entry &entry = _lookup(name);
+			return entry.name.valid() ? &entry : nullptr;
+		}
+
+		bool exists(Name const &name) const { return _lookup(name).name.valid(); }
+};
+
+#endif /* _SRC__INIT__START_NODE_INDEX_H_ */
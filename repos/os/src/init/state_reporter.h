@@ -31,6 +31,11 @@ class Init::State_reporter : public Report_update_trigger
 		{
 			virtual void produce_state_report(Xml_generator &xml,
 			                                  Report_detail const &) const = 0;
+
+			/**
+			 * Return true if the child counters changed since the last report
+			 */
+			virtual bool child_counters_changed() const = 0;
 		};
 
 	private:
@@ -47,6 +52,13 @@ class Init::State_reporter : public Report_update_trigger
 
 		unsigned _report_delay_ms = 0;
 
+		/* minimum time between two reports, 0 if unlimited */
+		unsigned _min_interval_ms = 0;
+
+		/* time of the last report as returned by 'elapsed_ms' */
+		unsigned long _last_report_ms = 0;
+		bool          _reported       = false;
+
 		/* interval used when child-ram reporting is enabled */
 		unsigned _report_period_ms = 0;
 
@@ -61,14 +73,28 @@ class Init::State_reporter : public Report_update_trigger
 			_env.ep(), *this, &State_reporter::_handle_timer };
 
 		Signal_handler<State_reporter> _timer_periodic_handler {
-			_env.ep(), *this, &State_reporter::_handle_timer };
+			_env.ep(), *this, &State_reporter::_handle_timer_periodic };
 
 		bool _scheduled = false;
 
 		void _handle_timer()
 		{
+			/* defer the report if the previous one is too recent */
+			if (_min_interval_ms && _reported && _timer.constructed()) {
+				unsigned long const since_ms = _timer->elapsed_ms() - _last_report_ms;
+				if (since_ms < _min_interval_ms) {
+					_timer->trigger_once((_min_interval_ms - since_ms)*1000);
+					return;
+				}
+			}
+
 			_scheduled = false;
 
+			if (_timer.constructed()) {
+				_last_report_ms = _timer->elapsed_ms();
+				_reported       = true;
+			}
+
 			try {
 				Reporter::Xml_generator xml(*_reporter, [&] () {
 
@@ -91,6 +117,24 @@ class Init::State_reporter : public Report_update_trigger
 			}
 		}
 
+		/**
+		 * Update the report only if the counters of a child changed
+		 *
+		 * In contrast to producing the report, checking the counters
+		 * does not require a pass over the complete state of all
+		 * children.
+		 */
+		void _handle_timer_periodic()
+		{
+			if (!_producer.child_counters_changed())
+				return;
+
+			if (_timer.constructed() && _report_delay_ms)
+				trigger_report_update();
+			else
+				_handle_timer();
+		}
+
 	public:
 
 		State_reporter(Env &env, Producer &producer)
@@ -114,11 +158,14 @@ class Init::State_reporter : public Report_update_trigger
 
 				_report_detail.construct(report);
 				_report_delay_ms = report.attribute_value("delay_ms", 100UL);
+				_min_interval_ms = report.attribute_value("min_interval_ms", 0UL);
+				_reporter->expanding(true);
 				_reporter->enabled(true);
 			}
 			catch (Xml_node::Nonexistent_sub_node) {
 				_report_detail.construct();
 				_report_delay_ms = 0;
+				_min_interval_ms = 0;
 				if (_reporter.constructed())
 					_reporter->enabled(false);
 			}
@@ -176,6 +223,17 @@ class Init::State_reporter : public Report_update_trigger
 			}
 		}
 
+		/**
+		 * Return time in milliseconds, or 0 if no timer is used
+		 *
+		 * The timer is present whenever state reports are enabled. It is
+		 * used to measure the duration of reconfigurations.
+		 */
+		unsigned long elapsed_ms()
+		{
+			return _timer.constructed() ? _timer->elapsed_ms() : 0;
+		}
+
 		void trigger_report_update() override
 		{
 			if (!_scheduled && _timer.constructed() && _report_delay_ms) {
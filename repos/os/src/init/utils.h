@@ -260,6 +260,18 @@ namespace Init {
 		} catch (...) {
 			return Affinity::Space(1, 1); }
 	}
+
+	/**
+	 * Return FNV-1a hash of the given characters
+	 */
+	inline unsigned long digest(char const *src, size_t len)
+	{
+		unsigned long hash = 2166136261UL;
+		for (size_t i = 0; i < len; i++)
+			hash = (hash ^ (unsigned char)src[i])*16777619UL;
+
+		return hash;
+	}
 }
 
 #endif /* _SRC__INIT__UTIL_H_ */
@@ -11,8 +11,17 @@
  * under the terms of the GNU Affero General Public License version 3.
  */
 
+/* Genode includes */
 #include <blit/blit.h>
+#include <os/pixel_rgb565.h>
+#include <os/pixel_rgb888.h>
+#include <util/string.h>
+
+/* local includes */
 #include <blit_helper.h>
+#include <kernels.h>
+
+using namespace Blit;
 
 
 extern "C" void blit(void const *s, unsigned src_w,
@@ -37,7 +46,13 @@ extern "C" void blit(void const *s, unsigned src_w,
 
 	/* copy 32byte chunks */
 	if (w >> 5) {
-		copy_block_32byte(src, src_w, dst, dst_w, w >> 5, h);
+		void (*copy)(void const *, void *, int) = kernels().copy_32byte_chunks;
+
+		char const *src_line = src;
+		char       *dst_line = dst;
+		for (int i = h; i--; src_line += src_w, dst_line += dst_w)
+			copy(src_line, dst_line, w >> 5);
+
 		src += w & ~31;
 		dst += w & ~31;
 		w    = w &  31;
@@ -54,3 +69,137 @@ extern "C" void blit(void const *s, unsigned src_w,
 	/* handle trailing row */
 	if (w >> 1) copy_16bit_column(src, src_w, dst, dst_w, h);
 }
+
+
+/********************
+ ** Scalar kernels **
+ ********************/
+
+namespace { namespace Scalar {
+
+	using Genode::Pixel_rgb565;
+	using Genode::Pixel_rgb888;
+
+	void copy_32byte_chunks(void const *src, void *dst, int n) {
+		copy_block_32byte((char const *)src, 0, (char *)dst, 0, n, 1); }
+
+	void blend_rgb565(uint16_t *dst, uint16_t const *src,
+	                  uint8_t const *alpha, unsigned n)
+	{
+		Pixel_rgb565       *d = (Pixel_rgb565 *)dst;
+		Pixel_rgb565 const *s = (Pixel_rgb565 const *)src;
+
+		for (; n--; d++, s++, alpha++)
+			if (*alpha)
+				*d = Pixel_rgb565::mix(*d, *s, *alpha);
+	}
+
+	void blend_rgb888(uint32_t *dst, uint32_t const *src,
+	                  uint8_t const *alpha, unsigned n)
+	{
+		Pixel_rgb888       *d = (Pixel_rgb888 *)dst;
+		Pixel_rgb888 const *s = (Pixel_rgb888 const *)src;
+
+		for (; n--; d++, s++, alpha++)
+			if (*alpha)
+				*d = Pixel_rgb888::mix(*d, *s, *alpha);
+	}
+
+	void rgb888_to_rgb565(uint16_t *dst, uint32_t const *src, unsigned n,
+	                      uint8_t const *dither, unsigned x)
+	{
+		Pixel_rgb565       *d = (Pixel_rgb565 *)dst;
+		Pixel_rgb888 const *s = (Pixel_rgb888 const *)src;
+
+		using Genode::max;
+
+		for (; n--; d++, s++, x++) {
+			int const v = dither[x & 15];
+			*d = Pixel_rgb565(max(0, s->r() - v), max(0, s->g() - v),
+			                  max(0, s->b() - v));
+		}
+	}
+
+	void rgb565_to_rgb888(uint32_t *dst, uint16_t const *src, unsigned n)
+	{
+		Pixel_rgb888       *d = (Pixel_rgb888 *)dst;
+		Pixel_rgb565 const *s = (Pixel_rgb565 const *)src;
+
+		for (; n--; d++, s++)
+			*d = Pixel_rgb888(s->r(), s->g(), s->b());
+	}
+} }
+
+
+Kernels const Blit::scalar {
+	"scalar", Scalar::copy_32byte_chunks, Scalar::blend_rgb565,
+	Scalar::blend_rgb888, Scalar::rgb888_to_rgb565, Scalar::rgb565_to_rgb888 };
+
+
+/***************
+ ** Selection **
+ ***************/
+
+static Kernels const *_selected_kernels;
+
+
+Kernels const &Blit::kernels()
+{
+	if (!_selected_kernels)
+		blit_select_kernels(nullptr);
+
+	return *_selected_kernels;
+}
+
+
+extern "C" bool blit_select_kernels(char const *name)
+{
+	Kernels const *kernels = arch_kernels(name);
+
+	if (!kernels && (!name || Genode::strcmp(name, scalar.name) == 0))
+		kernels = &scalar;
+
+	if (!kernels)
+		return false;
+
+	_selected_kernels = kernels;
+	return true;
+}
+
+
+extern "C" char const *blit_kernels_name() { return kernels().name; }
+
+
+/*******************
+ ** Pixel kernels **
+ *******************/
+
+extern "C" void blit_blend_rgb565(void *dst, void const *src,
+                                  unsigned char const *alpha, unsigned n)
+{
+	kernels().blend_rgb565((uint16_t *)dst, (uint16_t const *)src, alpha, n);
+}
+
+
+extern "C" void blit_blend_rgb888(void *dst, void const *src,
+                                  unsigned char const *alpha, unsigned n)
+{
+	kernels().blend_rgb888((uint32_t *)dst, (uint32_t const *)src, alpha, n);
+}
+
+
+extern "C" void blit_convert_rgb888_to_rgb565(void *dst, void const *src,
+                                              unsigned n,
+                                              unsigned char const *dither,
+                                              unsigned x)
+{
+	kernels().rgb888_to_rgb565((uint16_t *)dst, (uint32_t const *)src, n,
+	                           dither, x);
+}
+
+
+extern "C" void blit_convert_rgb565_to_rgb888(void *dst, void const *src,
+                                              unsigned n)
+{
+	kernels().rgb565_to_rgb888((uint32_t *)dst, (uint16_t const *)src, n);
+}
@@ -0,0 +1,18 @@
+/*
+ * \brief  Architectures without CPU-specific blit kernels
+ * \author Genode Labs
+ * \date   2026-10-14
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* local includes */
+#include <kernels.h>
+
+
+Blit::Kernels const *Blit::arch_kernels(char const *) { return nullptr; }
@@ -0,0 +1,73 @@
+/*
+ * \brief  Implementations of the blit functions selectable at runtime
+ * \author Genode Labs
+ * \date   2026-10-14
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _LIB__BLIT__KERNELS_H_
+#define _LIB__BLIT__KERNELS_H_
+
+#include <base/stdint.h>
+
+namespace Blit {
+
+	using Genode::uint8_t;
+	using Genode::uint16_t;
+	using Genode::uint32_t;
+
+	struct Kernels;
+
+	/**
+	 * Portable implementation, also used for the tails of lines
+	 */
+	extern Kernels const scalar;
+
+	/**
+	 * Return CPU-specific implementation
+	 *
+	 * \param name  name of the implementation, or nullptr for the best
+	 *              implementation supported by the CPU
+	 *
+	 * \return      nullptr if no such implementation is supported
+	 *
+	 * This function is provided by the architecture-specific part of the
+	 * library.
+	 */
+	Kernels const *arch_kernels(char const *name);
+
+	/**
+	 * Return selected implementation
+	 */
+	Kernels const &kernels();
+}
+
+
+struct Blit::Kernels
+{
+	char const *name;
+
+	/**
+	 * Copy 'n' chunks of 32 bytes to a 32bit-aligned destination
+	 */
+	void (*copy_32byte_chunks)(void const *src, void *dst, int n);
+
+	void (*blend_rgb565)(uint16_t *dst, uint16_t const *src,
+	                     uint8_t const *alpha, unsigned n);
+
+	void (*blend_rgb888)(uint32_t *dst, uint32_t const *src,
+	                     uint8_t const *alpha, unsigned n);
+
+	void (*rgb888_to_rgb565)(uint16_t *dst, uint32_t const *src, unsigned n,
+	                         uint8_t const *dither, unsigned x);
+
+	void (*rgb565_to_rgb888)(uint32_t *dst, uint16_t const *src, unsigned n);
+};
+
+#endif /* _LIB__BLIT__KERNELS_H_ */
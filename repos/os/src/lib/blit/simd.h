@@ -0,0 +1,293 @@
+/*
+ * \brief  Blit kernels based on the vector extensions of the compiler
+ * \author Genode Labs
+ * \date   2026-10-14
+ *
+ * The kernels are written once for vectors of a given width and compiled
+ * for each instruction-set extension, e.g., SSE2, AVX2, or NEON. Each
+ * compilation unit including this header is built with the compiler flags
+ * of the respective extension. Therefore, all code of this header has
+ * internal linkage. Otherwise, the linker might pick an instance compiled
+ * for an extension the CPU lacks for a caller outside the kernel.
+ *
+ * The vector code processes whole vectors of pixels only. The remaining
+ * pixels of a line are handled by the scalar kernels. The results of the
+ * vector kernels are identical to those of the scalar kernels.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _LIB__BLIT__SIMD_H_
+#define _LIB__BLIT__SIMD_H_
+
+/* local includes */
+#include <kernels.h>
+
+namespace {
+
+	using namespace Blit;
+
+	template <typename T>
+	inline T load(void const *src)
+	{
+		T value;
+		__builtin_memcpy(&value, src, sizeof(value));
+		return value;
+	}
+
+	template <typename T>
+	inline void store(void *dst, T value) {
+		__builtin_memcpy(dst, &value, sizeof(value)); }
+
+
+	/**
+	 * Vectors of 128 bits
+	 *
+	 * Besides the vector types, the interleaving of the lower and upper
+	 * halves of two vectors and the selection of the even elements are
+	 * provided. The compiler translates those permutations into the
+	 * respective unpack and pack instructions.
+	 */
+	struct Vectors_128
+	{
+		typedef uint8_t  U8  __attribute__((vector_size(16)));
+		typedef uint16_t U16 __attribute__((vector_size(16)));
+		typedef uint32_t U32 __attribute__((vector_size(16)));
+
+		static U8 zip_lo8(U8 a, U8 b)
+		{
+			U8 const sel = { 0, 16, 1, 17, 2, 18, 3, 19,
+			                 4, 20, 5, 21, 6, 22, 7, 23 };
+			return __builtin_shuffle(a, b, sel);
+		}
+
+		static U8 zip_hi8(U8 a, U8 b)
+		{
+			U8 const sel = {  8, 24,  9, 25, 10, 26, 11, 27,
+			                 12, 28, 13, 29, 14, 30, 15, 31 };
+			return __builtin_shuffle(a, b, sel);
+		}
+
+		static U16 zip_lo16(U16 a, U16 b)
+		{
+			U16 const sel = { 0, 8, 1, 9, 2, 10, 3, 11 };
+			return __builtin_shuffle(a, b, sel);
+		}
+
+		static U16 zip_hi16(U16 a, U16 b)
+		{
+			U16 const sel = { 4, 12, 5, 13, 6, 14, 7, 15 };
+			return __builtin_shuffle(a, b, sel);
+		}
+
+		static U16 even16(U16 a, U16 b)
+		{
+			U16 const sel = { 0, 2, 4, 6, 8, 10, 12, 14 };
+			return __builtin_shuffle(a, b, sel);
+		}
+	};
+
+
+	template <typename V>
+	struct Simd_kernels
+	{
+		typedef typename V::U8  U8;
+		typedef typename V::U16 U16;
+		typedef typename V::U32 U32;
+
+		enum { BYTES = sizeof(U8) };
+
+		static bool _transparent(uint8_t const *alpha)
+		{
+			Genode::uint64_t words[BYTES/8];
+			__builtin_memcpy(words, alpha, sizeof(words));
+
+			Genode::uint64_t any = 0;
+			for (unsigned i = 0; i < BYTES/8; i++)
+				any |= words[i];
+
+			return !any;
+		}
+
+		/**
+		 * Mix RGB565 pixels like 'Pixel_rgb565::mix'
+		 *
+		 * The channels are blended separately, which is equivalent to the
+		 * blending of the packed pixel because no channel can overflow.
+		 */
+		static U16 _mix_rgb565(U16 d, U16 s, U16 a)
+		{
+			U16 const k1 = (264 - a) >> 3, k2 = a >> 3, g1 = 264 - a;
+
+			U16 const r = ((((d >> 11) * k1) >> 5)
+			            +  (((s >> 11) * k2) >> 5)) << 11;
+			U16 const g = (((((d >> 6) & 0x1f) * g1) >> 8)
+			            +  ((((s >> 6) & 0x1f) * a)  >> 8)) << 6;
+			U16 const b = ((((d & 0x1f) * k1) >> 5)
+			            +  (((s & 0x1f) * k2) >> 5));
+
+			U16 const keep = (U16)(a == 0);
+			return ((r | g | b) & ~keep) | (d & keep);
+		}
+
+		/**
+		 * Mix RGB888 pixels like 'Pixel_rgb888::mix'
+		 *
+		 * \param a  alpha values, replicated to both 16-bit halves of each
+		 *           pixel
+		 */
+		static U32 _mix_rgb888(U32 d, U32 s, U16 a)
+		{
+			U16 const ia = 255 - a;
+
+			U16 const rb = ((((U16)(d & 0xff00ff)) * ia) >> 8)
+			             + ((((U16)(s & 0xff00ff)) * a)  >> 8);
+			U16 const ag = ((((U16)((d >> 8) & 0xff00ff)) * ia) >> 8)
+			             + ((((U16)((s >> 8) & 0xff00ff)) * a)  >> 8);
+
+			U32 const mix  = (U32)rb | (((U32)ag & 0xff) << 8);
+			U32 const keep = (U32)(a == 0);
+			return (mix & ~keep) | (d & keep);
+		}
+
+		/**
+		 * Convert RGB888 pixels to RGB565 after subtracting dither values
+		 *
+		 * \param v  dither value, replicated to all bytes of each pixel
+		 */
+		static U32 _dither_rgb565(U32 p, U32 v)
+		{
+			U8 const c = (U8)p, w = (U8)v;
+
+			/* saturating subtraction */
+			U32 const q = (U32)(c - (c < w ? c : w));
+
+			return ((q >> 8) & 0xf800) | ((q >> 5) & 0x07e0) | ((q >> 3) & 0x1f);
+		}
+
+		static U32 _rgb888(U32 p)
+		{
+			return ((p & 0xf800) << 8) | ((p & 0x07e0) << 5) | ((p & 0x1f) << 3);
+		}
+
+		static void copy_32byte_chunks(void const *src, void *dst, int n)
+		{
+			uint8_t const *s = (uint8_t const *)src;
+			uint8_t       *d = (uint8_t       *)dst;
+
+			for (; n-- > 0; s += 32, d += 32)
+				for (unsigned i = 0; i < 32; i += BYTES)
+					store(d + i, load<U8>(s + i));
+		}
+
+		static void blend_rgb565(uint16_t *dst, uint16_t const *src,
+		                         uint8_t const *alpha, unsigned n)
+		{
+			enum { PIXELS = BYTES, HALF = PIXELS/2 };
+
+			U8 const zero = { };
+
+			for (; n >= PIXELS; n -= PIXELS, dst += PIXELS, src += PIXELS,
+			                    alpha += PIXELS) {
+
+				if (_transparent(alpha))
+					continue;
+
+				U8 const a = load<U8>(alpha);
+
+				store(dst, _mix_rgb565(load<U16>(dst), load<U16>(src),
+				                       (U16)V::zip_lo8(a, zero)));
+				store(dst + HALF, _mix_rgb565(load<U16>(dst + HALF),
+				                              load<U16>(src + HALF),
+				                              (U16)V::zip_hi8(a, zero)));
+			}
+
+			scalar.blend_rgb565(dst, src, alpha, n);
+		}
+
+		static void blend_rgb888(uint32_t *dst, uint32_t const *src,
+		                         uint8_t const *alpha, unsigned n)
+		{
+			enum { PIXELS = BYTES, QUARTER = PIXELS/4 };
+
+			U8 const zero = { };
+
+			for (; n >= PIXELS; n -= PIXELS, dst += PIXELS, src += PIXELS,
+			                    alpha += PIXELS) {
+
+				if (_transparent(alpha))
+					continue;
+
+				U8  const a    = load<U8>(alpha);
+				U16 const a_lo = (U16)V::zip_lo8(a, zero);
+				U16 const a_hi = (U16)V::zip_hi8(a, zero);
+
+				U16 const a32[4] = { V::zip_lo16(a_lo, a_lo), V::zip_hi16(a_lo, a_lo),
+				                     V::zip_lo16(a_hi, a_hi), V::zip_hi16(a_hi, a_hi) };
+
+				for (unsigned i = 0; i < 4; i++) {
+					uint32_t       *d = dst + i*QUARTER;
+					uint32_t const *s = src + i*QUARTER;
+					store(d, _mix_rgb888(load<U32>(d), load<U32>(s), a32[i]));
+				}
+			}
+
+			scalar.blend_rgb888(dst, src, alpha, n);
+		}
+
+		static void rgb888_to_rgb565(uint16_t *dst, uint32_t const *src,
+		                             unsigned n, uint8_t const *dither,
+		                             unsigned x)
+		{
+			enum { PIXELS = BYTES/2, HALF = PIXELS/2 };
+
+			/* repeat dither values to load them at any position */
+			uint8_t row[32];
+			for (unsigned i = 0; i < sizeof(row); i++)
+				row[i] = dither[i & 15];
+
+			for (; n >= PIXELS; n -= PIXELS, dst += PIXELS, src += PIXELS,
+			                    x += PIXELS) {
+
+				U8 v = { };
+				__builtin_memcpy(&v, row + (x & 15), PIXELS);
+
+				U16 const v2 = (U16)V::zip_lo8(v, v);
+
+				U32 const lo = _dither_rgb565(load<U32>(src),
+				                              (U32)V::zip_lo16(v2, v2));
+				U32 const hi = _dither_rgb565(load<U32>(src + HALF),
+				                              (U32)V::zip_hi16(v2, v2));
+
+				store(dst, V::even16((U16)lo, (U16)hi));
+			}
+
+			scalar.rgb888_to_rgb565(dst, src, n, dither, x);
+		}
+
+		static void rgb565_to_rgb888(uint32_t *dst, uint16_t const *src,
+		                             unsigned n)
+		{
+			enum { PIXELS = BYTES/2, HALF = PIXELS/2 };
+
+			U16 const zero = { };
+
+			for (; n >= PIXELS; n -= PIXELS, dst += PIXELS, src += PIXELS) {
+
+				U16 const p = load<U16>(src);
+
+				store(dst,        _rgb888((U32)V::zip_lo16(p, zero)));
+				store(dst + HALF, _rgb888((U32)V::zip_hi16(p, zero)));
+			}
+
+			scalar.rgb565_to_rgb888(dst, src, n);
+		}
+	};
+}
+
+#endif /* _LIB__BLIT__SIMD_H_ */
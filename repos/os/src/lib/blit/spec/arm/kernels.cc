@@ -0,0 +1,38 @@
+/*
+ * \brief  Selection of the blit kernels for ARM
+ * \author Genode Labs
+ * \date   2026-10-14
+ *
+ * NEON cannot be detected from user level. The NEON kernels are built in
+ * if the CPUs of the platform feature NEON, which is indicated by the
+ * 'BLIT_NEON' define.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <util/string.h>
+
+/* local includes */
+#include <kernels.h>
+
+#ifdef BLIT_NEON
+namespace Blit { extern Kernels const neon; }
+#endif
+
+
+Blit::Kernels const *Blit::arch_kernels(char const *name)
+{
+#ifdef BLIT_NEON
+	if (!name || Genode::strcmp(name, neon.name) == 0)
+		return &neon;
+#endif
+
+	(void)name;
+	return nullptr;
+}
@@ -0,0 +1,27 @@
+/*
+ * \brief  Blit kernels using NEON
+ * \author Genode Labs
+ * \date   2026-10-14
+ *
+ * This compilation unit is built with NEON enabled.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* local includes */
+#include <simd.h>
+
+namespace { typedef Simd_kernels<Vectors_128> Neon; }
+
+
+namespace Blit { extern Kernels const neon; }
+
+
+Blit::Kernels const Blit::neon {
+	"neon", Neon::copy_32byte_chunks, Neon::blend_rgb565, Neon::blend_rgb888,
+	Neon::rgb888_to_rgb565, Neon::rgb565_to_rgb888 };
@@ -0,0 +1,79 @@
+/*
+ * \brief  Selection of the blit kernels for x86_64
+ * \author Genode Labs
+ * \date   2026-10-14
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <util/string.h>
+
+/* local includes */
+#include <kernels.h>
+
+namespace Blit { extern Kernels const sse2, avx2; }
+
+
+static void cpuid(unsigned leaf, unsigned &eax, unsigned &ebx,
+                  unsigned &ecx, unsigned &edx)
+{
+	asm volatile ("cpuid"
+	              : "=a" (eax), "=b" (ebx), "=c" (ecx), "=d" (edx)
+	              : "a" (leaf), "c" (0));
+}
+
+
+static bool avx2_supported()
+{
+	enum {
+		CPUID_1_ECX_OSXSAVE = 1 << 27,
+		CPUID_1_ECX_AVX     = 1 << 28,
+		CPUID_7_EBX_AVX2    = 1 << 5,
+		XCR0_SSE_AVX        = 6,
+	};
+
+	unsigned eax = 0, ebx = 0, ecx = 0, edx = 0;
+
+	cpuid(0, eax, ebx, ecx, edx);
+	if (eax < 7)
+		return false;
+
+	cpuid(1, eax, ebx, ecx, edx);
+	unsigned const avx = CPUID_1_ECX_OSXSAVE | CPUID_1_ECX_AVX;
+	if ((ecx & avx) != avx)
+		return false;
+
+	/* the kernel must save the AVX registers on context switches */
+	unsigned xcr0 = 0, xcr0_hi = 0;
+	asm volatile ("xgetbv" : "=a" (xcr0), "=d" (xcr0_hi) : "c" (0));
+	if ((xcr0 & XCR0_SSE_AVX) != XCR0_SSE_AVX)
+		return false;
+
+	cpuid(7, eax, ebx, ecx, edx);
+	return ebx & CPUID_7_EBX_AVX2;
+}
+
+
+Blit::Kernels const *Blit::arch_kernels(char const *name)
+{
+	using Genode::strcmp;
+
+	bool const avx2_usable = avx2_supported();
+
+	if (!name)
+		return avx2_usable ? &avx2 : &sse2;
+
+	if (strcmp(name, sse2.name) == 0)
+		return &sse2;
+
+	if (strcmp(name, avx2.name) == 0 && avx2_usable)
+		return &avx2;
+
+	return nullptr;
+}
@@ -0,0 +1,108 @@
+/*
+ * \brief  Blit kernels using AVX2
+ * \author Genode Labs
+ * \date   2026-10-14
+ *
+ * This compilation unit is built with AVX2 enabled. Its functions must be
+ * called only if the CPU supports AVX2.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* local includes */
+#include <simd.h>
+
+namespace {
+
+	/**
+	 * Vectors of 256 bits
+	 *
+	 * The permutations correspond to those of 'Vectors_128'.
+	 */
+	struct Vectors_256
+	{
+		typedef uint8_t  U8  __attribute__((vector_size(32)));
+		typedef uint16_t U16 __attribute__((vector_size(32)));
+		typedef uint32_t U32 __attribute__((vector_size(32)));
+
+		static U8 zip_lo8(U8 a, U8 b)
+		{
+			U8 const sel = {  0, 32,  1, 33,  2, 34,  3, 35,
+			                  4, 36,  5, 37,  6, 38,  7, 39,
+			                  8, 40,  9, 41, 10, 42, 11, 43,
+			                 12, 44, 13, 45, 14, 46, 15, 47 };
+			return __builtin_shuffle(a, b, sel);
+		}
+
+		static U8 zip_hi8(U8 a, U8 b)
+		{
+			U8 const sel = { 16, 48, 17, 49, 18, 50, 19, 51,
+			                 20, 52, 21, 53, 22, 54, 23, 55,
+			                 24, 56, 25, 57, 26, 58, 27, 59,
+			                 28, 60, 29, 61, 30, 62, 31, 63 };
+			return __builtin_shuffle(a, b, sel);
+		}
+
+		static U16 zip_lo16(U16 a, U16 b)
+		{
+			U16 const sel = { 0, 16, 1, 17, 2, 18, 3, 19,
+			                  4, 20, 5, 21, 6, 22, 7, 23 };
+			return __builtin_shuffle(a, b, sel);
+		}
+
+		static U16 zip_hi16(U16 a, U16 b)
+		{
+			U16 const sel = {  8, 24,  9, 25, 10, 26, 11, 27,
+			                  12, 28, 13, 29, 14, 30, 15, 31 };
+			return __builtin_shuffle(a, b, sel);
+		}
+
+		static U16 even16(U16 a, U16 b)
+		{
+			U16 const sel = {  0,  2,  4,  6,  8, 10, 12, 14,
+			                  16, 18, 20, 22, 24, 26, 28, 30 };
+			return __builtin_shuffle(a, b, sel);
+		}
+	};
+
+
+	typedef long long V4di __attribute__((vector_size(32)));
+
+	/**
+	 * Copy 32-byte chunks with non-temporal stores
+	 */
+	void copy_32byte_chunks(void const *src, void *dst, int n)
+	{
+		char const *s = (char const *)src;
+		char       *d = (char       *)dst;
+
+		unsigned long bytes = 32UL*n;
+
+		/* the destination is 32bit-aligned, align it further to 32 bytes */
+		for (; ((unsigned long)d & 31) && bytes; bytes -= 4, s += 4, d += 4)
+			__builtin_memcpy(d, s, 4);
+
+		for (; bytes >= 32; bytes -= 32, s += 32, d += 32)
+			__builtin_ia32_movntdq256((V4di *)d, load<V4di>(s));
+
+		for (; bytes; bytes -= 4, s += 4, d += 4)
+			__builtin_memcpy(d, s, 4);
+
+		__builtin_ia32_sfence();
+	}
+
+	typedef Simd_kernels<Vectors_256> Avx2;
+}
+
+
+namespace Blit { extern Kernels const avx2; }
+
+
+Blit::Kernels const Blit::avx2 {
+	"avx2", copy_32byte_chunks, Avx2::blend_rgb565, Avx2::blend_rgb888,
+	Avx2::rgb888_to_rgb565, Avx2::rgb565_to_rgb888 };
@@ -0,0 +1,60 @@
+/*
+ * \brief  Blit kernels using SSE2
+ * \author Genode Labs
+ * \date   2026-10-14
+ *
+ * SSE2 is part of the x86_64 base architecture.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* local includes */
+#include <simd.h>
+
+namespace {
+
+	typedef long long V2di __attribute__((vector_size(16)));
+
+	/**
+	 * Copy 32-byte chunks with non-temporal stores
+	 *
+	 * Non-temporal stores bypass the cache, which is preferable for writes
+	 * to the framebuffer.
+	 */
+	void copy_32byte_chunks(void const *src, void *dst, int n)
+	{
+		char const *s = (char const *)src;
+		char       *d = (char       *)dst;
+
+		unsigned long bytes = 32UL*n;
+
+		/* the destination is 32bit-aligned, align it further to 16 bytes */
+		for (; ((unsigned long)d & 15) && bytes; bytes -= 4, s += 4, d += 4)
+			__builtin_memcpy(d, s, 4);
+
+		for (; bytes >= 32; bytes -= 32, s += 32, d += 32) {
+			__builtin_ia32_movntdq((V2di *)d,        load<V2di>(s));
+			__builtin_ia32_movntdq((V2di *)(d + 16), load<V2di>(s + 16));
+		}
+
+		for (; bytes; bytes -= 4, s += 4, d += 4)
+			__builtin_memcpy(d, s, 4);
+
+		__builtin_ia32_sfence();
+	}
+
+	typedef Simd_kernels<Vectors_128> Sse2;
+}
+
+
+namespace Blit { extern Kernels const sse2; }
+
+
+Blit::Kernels const Blit::sse2 {
+	"sse2", copy_32byte_chunks, Sse2::blend_rgb565, Sse2::blend_rgb888,
+	Sse2::rgb888_to_rgb565, Sse2::rgb565_to_rgb888 };
@@ -23,7 +23,13 @@
 using namespace Genode;
 
 
-Trace::Timestamp Timer::Connection::_timestamp()
+Trace::Timestamp Timer::Time_page::timestamp()
 {
 	return Kernel::time();
 }
+
+
+Trace::Timestamp Timer::Connection::_timestamp()
+{
+	return Time_page::timestamp();
+}
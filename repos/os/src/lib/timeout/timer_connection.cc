@@ -87,9 +87,11 @@ Duration Timer::Connection::_update_interpolated_time(Duration &interpolated_tim
 
 void Timer::Connection::_handle_timeout()
 {
-	unsigned long const us = elapsed_us();
-	if (us - _us > REAL_TIME_UPDATE_PERIOD_US) {
-		_update_real_time();
+	if (!_time_page().valid()) {
+		unsigned long const us = elapsed_us();
+		if (us - _us > REAL_TIME_UPDATE_PERIOD_US) {
+			_update_real_time();
+		}
 	}
 	if (_handler) {
 		_handler->handle_timeout(curr_time());
@@ -103,7 +105,8 @@ void Timer::Connection::schedule_timeout(Microseconds     duration,
 	if (duration.value < MIN_TIMEOUT_US)
 		duration.value = MIN_TIMEOUT_US;
 
-	if (duration.value > REAL_TIME_UPDATE_PERIOD_US)
+	/* wake up in time for the next real-time update if needed */
+	if (duration.value > REAL_TIME_UPDATE_PERIOD_US && !_time_page().valid())
 		duration.value = REAL_TIME_UPDATE_PERIOD_US;
 
 	_handler = &handler;
@@ -120,6 +123,9 @@ void Timer::Connection::_enable_modern_mode()
 	_sigh(_signal_handler);
 	_scheduler._enable();
 
+	if (_time_page().valid()) {
+		return;
+	}
 	/* do initial calibration burst to make interpolation available earlier */
 	for (unsigned i = 0; i < NR_OF_INITIAL_CALIBRATIONS; i++) {
 		_update_real_time();
@@ -133,7 +139,8 @@ Timer::Connection::Connection(Genode::Env &env, char const *label)
 	                            "ram_quota=10K, cap_quota=%u, label=\"%s\"",
 	                            CAP_QUOTA, label)),
 	Session_client(cap()),
-	_signal_handler(env.ep(), *this, &Connection::_handle_timeout)
+	_signal_handler(env.ep(), *this, &Connection::_handle_timeout),
+	_time_page_ds(env.rm(), time_page())
 {
 	/* register default signal handler */
 	Session_client::sigh(_default_sigh_cap);
@@ -144,7 +151,8 @@ Timer::Connection::Connection()
 :
 	Genode::Connection<Session>(session("ram_quota=10K")),
 	Session_client(cap()),
-	_signal_handler(internal_env().ep(), *this, &Connection::_handle_timeout)
+	_signal_handler(internal_env().ep(), *this, &Connection::_handle_timeout),
+	_time_page_ds(internal_env().rm(), time_page())
 {
 	/* register default signal handler */
 	Session_client::sigh(_default_sigh_cap);
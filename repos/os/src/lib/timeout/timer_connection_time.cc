@@ -173,6 +173,13 @@ Duration Timer::Connection::curr_time()
 {
 	_enable_modern_mode();
 
+	/* prefer the time page over the local interpolation */
+	uint64_t page_us = 0;
+	if (_time_page().read_us(page_us)) {
+		Duration page_time(Microseconds((unsigned long)page_us));
+		return _update_interpolated_time(page_time);
+	}
+
 	Reconstructible<Lock_guard<Lock> > lock_guard(_real_time_lock);
 	Duration                           interpolated_time(_real_time);
 
@@ -18,7 +18,13 @@
 using namespace Genode;
 
 
-Trace::Timestamp Timer::Connection::_timestamp()
+Trace::Timestamp Timer::Time_page::timestamp()
 {
 	return Trace::timestamp();
 }
+
+
+Trace::Timestamp Timer::Connection::_timestamp()
+{
+	return Time_page::timestamp();
+}
@@ -0,0 +1,368 @@
+/*
+ * \brief  Timeout scheduler based on a hierarchical timing wheel
+ * \author Genode Labs
+ * \date   2026-10-14
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <timer/timeout.h>
+#include <util/misc_math.h>
+
+using namespace Genode;
+
+
+/**
+ * Return value of the slot digit of 'time' at 'level'
+ */
+static inline unsigned digit(uint64_t time, unsigned level)
+{
+	enum { MASK = Wheel_timeout_scheduler::SLOTS - 1 };
+	return (time >> (level*Wheel_timeout_scheduler::LEVEL_BITS)) & MASK;
+}
+
+
+/**
+ * Return digits of 'time' above 'level'
+ */
+static inline uint64_t prefix(uint64_t time, unsigned level)
+{
+	unsigned const shift = (level + 1)*Wheel_timeout_scheduler::LEVEL_BITS;
+	return shift < 64 ? time >> shift : 0;
+}
+
+
+unsigned Wheel_timeout_scheduler::_tick_shift_of(Microseconds precision)
+{
+	if (precision.value <= 1)
+		return 0;
+
+	unsigned const shift = log2(precision.value);
+	return (1UL << shift) < precision.value ? shift + 1 : shift;
+}
+
+
+uint64_t Wheel_timeout_scheduler::_ticks(uint64_t duration_us) const
+{
+	uint64_t const tick_us = 1ULL << _tick_shift;
+
+	return (duration_us + tick_us - 1) / tick_us;
+}
+
+
+uint64_t Wheel_timeout_scheduler::_deadline(uint64_t duration_us) const
+{
+	/*
+	 * The current tick '_now' is the current time rounded down. Count from
+	 * the precise current time instead, so that a deadline never lies less
+	 * than 'duration_us' ahead.
+	 */
+	return _ticks(_now_us + duration_us);
+}
+
+
+void Wheel_timeout_scheduler::_update_time()
+{
+	unsigned long const curr_us =
+		_time_source.curr_time().trunc_to_plain_us().value;
+
+	/* ignore time that went backwards, which may happen on interpolation */
+	unsigned long const elapsed_us = curr_us - _last_us;
+	if ((long)elapsed_us < 0)
+		return;
+
+	_last_us  = curr_us;
+	_now_us  += elapsed_us;
+
+	_advance(_now_us >> _tick_shift);
+}
+
+
+void Wheel_timeout_scheduler::_insert(Entry &entry)
+{
+	/* due timeouts are appended to the expired list */
+	if (entry.deadline <= _now) {
+		entry.level    = EXPIRED;
+		entry.next     = nullptr;
+		entry.prev     = _expired_tail;
+		*_expired_tail = &entry;
+		_expired_tail  = &entry.next;
+		return;
+	}
+
+	/* lowest level at which the deadline shares all higher digits with now */
+	uint64_t const differing = entry.deadline ^ _now;
+	unsigned const level     = (63 - __builtin_clzll(differing)) / LEVEL_BITS;
+	unsigned const slot      = digit(entry.deadline, level);
+
+	Entry *&head = _slots[level][slot];
+
+	entry.level = level;
+	entry.slot  = slot;
+	entry.next  = head;
+	entry.prev  = &head;
+	if (head)
+		head->prev = &entry.next;
+	head = &entry;
+
+	_occupied[level] |= 1U << slot;
+}
+
+
+void Wheel_timeout_scheduler::_remove(Entry &entry)
+{
+	if (!entry.queued())
+		return;
+
+	*entry.prev = entry.next;
+	if (entry.next)
+		entry.next->prev = entry.prev;
+	else if (entry.level == EXPIRED)
+		_expired_tail = entry.prev;
+
+	if (entry.level != EXPIRED && !_slots[entry.level][entry.slot])
+		_occupied[entry.level] &= ~(1U << entry.slot);
+
+	entry.next = nullptr;
+	entry.prev = nullptr;
+}
+
+
+void Wheel_timeout_scheduler::_advance(uint64_t const now)
+{
+	if (now <= _now)
+		return;
+
+	uint64_t const old = _now;
+	_now = now;
+
+	/*
+	 * Lower levels are processed first so that due timeouts are appended
+	 * to the expired list roughly in the order of their deadlines.
+	 */
+	for (unsigned level = 0; level < NUM_LEVELS; level++) {
+
+		unsigned const old_digit = digit(old, level);
+		unsigned const new_digit = digit(now, level);
+		bool     const same_prefix = prefix(old, level) == prefix(now, level);
+
+		/* if the digits of this and all higher levels match, we are done */
+		if (same_prefix && old_digit == new_digit)
+			break;
+
+		/*
+		 * All timeouts of a level lie behind the old digit. If the prefix
+		 * changed, all of them are passed. Otherwise, only those up to
+		 * the new digit.
+		 */
+		unsigned passed = _occupied[level];
+		if (same_prefix)
+			passed &= (2U << new_digit) - 1;
+
+		while (passed) {
+			unsigned const slot = __builtin_ctz(passed);
+			passed &= passed - 1;
+
+			/* detach list of slot and re-insert its timeouts */
+			Entry *entry = _slots[level][slot];
+			_slots[level][slot] = nullptr;
+			_occupied[level] &= ~(1U << slot);
+
+			while (entry) {
+				Entry *next = entry->next;
+				_insert(*entry);
+				entry = next;
+			}
+		}
+	}
+}
+
+
+void Wheel_timeout_scheduler::_schedule_wakeup()
+{
+	unsigned long sleep_time_us = _time_source.max_timeout().value;
+	{
+		Lock::Guard lock_guard(_lock);
+
+		_wakeup = ~0ULL;
+
+		if (_expired)
+			_wakeup = _now;
+
+		/* the earliest timeout resides at the lowest non-empty level */
+		else for (unsigned level = 0; level < NUM_LEVELS; level++) {
+
+			if (!_occupied[level])
+				continue;
+
+			/* search earliest deadline within the first non-empty slot */
+			unsigned const slot = __builtin_ctz(_occupied[level]);
+			for (Entry *e = _slots[level][slot]; e; e = e->next)
+				_wakeup = min(_wakeup, e->deadline);
+			break;
+		}
+
+		if (_wakeup != ~0ULL) {
+			uint64_t const wakeup_us = _wakeup << _tick_shift;
+			sleep_time_us = wakeup_us > _now_us
+			              ? (unsigned long)min(wakeup_us - _now_us,
+			                                   (uint64_t)~0UL)
+			              : 0;
+		}
+	}
+
+	/* limit max timeout to a more reasonable value, e.g. 60s */
+	if (sleep_time_us > 60000000) {
+		sleep_time_us = 60000000;
+	} else if (sleep_time_us == 0) {
+		sleep_time_us = 1; }
+
+	_time_source.schedule_timeout(Microseconds(sleep_time_us), *this);
+}
+
+
+void Wheel_timeout_scheduler::handle_timeout(Duration)
+{
+	for (;;) {
+
+		Entry *entry = nullptr;
+		{
+			Lock::Guard lock_guard(_lock);
+
+			_update_time();
+
+			entry = _expired;
+			if (!entry)
+				break;
+
+			_remove(*entry);
+
+			/* defer destruction until the call of 'on_alarm' is finished */
+			entry->dispatch_lock.lock();
+		}
+
+		bool const reschedule = entry->timeout._alarm.on_alarm(1);
+
+		if (reschedule && entry->period) {
+
+			Lock::Guard lock_guard(_lock);
+
+			/* the handler may have re-scheduled the timeout already */
+			if (!entry->queued()) {
+
+				/* skip periods that passed already */
+				entry->deadline += entry->period;
+				if (entry->deadline <= _now)
+					entry->deadline = _deadline(entry->period << _tick_shift);
+
+				_insert(*entry);
+			}
+		}
+
+		/* release timeout, resume concurrent destructor operation */
+		entry->dispatch_lock.unlock();
+	}
+
+	_schedule_wakeup();
+}
+
+
+Wheel_timeout_scheduler::Wheel_timeout_scheduler(Time_source  &time_source,
+                                                 Microseconds  precision)
+:
+	_time_source(time_source), _tick_shift(_tick_shift_of(precision))
+{ }
+
+
+Wheel_timeout_scheduler::~Wheel_timeout_scheduler()
+{
+	Lock::Guard lock_guard(_lock);
+
+	while (_expired)
+		_remove(*_expired);
+
+	for (unsigned level = 0; level < NUM_LEVELS; level++)
+		for (unsigned slot = 0; slot < SLOTS; slot++)
+			while (Entry *entry = _slots[level][slot])
+				_remove(*entry);
+}
+
+
+void Wheel_timeout_scheduler::_enable()
+{
+	_time_source.schedule_timeout(Microseconds(0), *this);
+}
+
+
+void Wheel_timeout_scheduler::_schedule_one_shot(Timeout      &timeout,
+                                                 Microseconds  duration)
+{
+	Entry &entry = timeout._wheel_entry;
+	bool   earlier_than_wakeup = false;
+	{
+		Lock::Guard lock_guard(_lock);
+
+		/* ensure that the schedulers time is up-to-date before adding a timeout */
+		_update_time();
+		_remove(entry);
+
+		/* round up to whole ticks so that the timeout never triggers early */
+		entry.deadline = _deadline(duration.value);
+		entry.period   = 0;
+		_insert(entry);
+
+		earlier_than_wakeup = entry.deadline < _wakeup;
+	}
+
+	if (earlier_than_wakeup) {
+		_time_source.schedule_timeout(Microseconds(0), *this); }
+}
+
+
+void Wheel_timeout_scheduler::_schedule_periodic(Timeout      &timeout,
+                                                 Microseconds  duration)
+{
+	Entry &entry = timeout._wheel_entry;
+	{
+		Lock::Guard lock_guard(_lock);
+
+		/* ensure that the schedulers time is up-to-date before adding a timeout */
+		_update_time();
+		_remove(entry);
+
+		/*
+		 * Refuse to schedule a periodic timeout of 0 because it would
+		 * trigger infinitely.
+		 */
+		if (duration.value == 0)
+			return;
+
+		/* first deadline is overdue */
+		entry.deadline = _now;
+		entry.period   = _ticks(duration.value);
+		_insert(entry);
+	}
+
+	_time_source.schedule_timeout(Microseconds(0), *this);
+}
+
+
+void Wheel_timeout_scheduler::_discard(Timeout &timeout)
+{
+	Entry &entry = timeout._wheel_entry;
+
+	/*
+	 * Taking the dispatch lock makes sure that the timeout is not in the
+	 * middle of being executed by 'handle_timeout'.
+	 */
+	Lock::Guard lock_guard(_lock);
+	Lock::Guard dispatch_guard(entry.dispatch_lock);
+
+	_remove(entry);
+}
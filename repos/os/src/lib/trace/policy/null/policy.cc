@@ -37,3 +37,7 @@ size_t signal_receive(char *dst, Signal_context const &, unsigned)
 	return 0;
 }
 
+size_t checkpoint(char *dst, char const *name, unsigned long data)
+{
+	return 0;
+}
@@ -51,3 +51,24 @@ size_t signal_receive(char *dst, Signal_context const &, unsigned)
 {
 	return 0;
 }
+
+size_t checkpoint(char *dst, char const *name, unsigned long data)
+{
+	/* leave room for the separator and the decimal value */
+	size_t len = min(strlen(name), (size_t)MAX_EVENT_SIZE - 22);
+
+	memcpy(dst, (void*)name, len);
+	dst[len++] = '=';
+
+	char digits[20];
+	unsigned num_digits = 0;
+	do {
+		digits[num_digits++] = '0' + data % 10;
+		data /= 10;
+	} while (data);
+
+	while (num_digits)
+		dst[len++] = digits[--num_digits];
+
+	return len;
+}
@@ -26,6 +26,7 @@ class Vfs::Block_file_system : public Single_file_system
 {
 	private:
 
+		Genode::Env       &_env;
 		Genode::Allocator &_alloc;
 
 		typedef Genode::String<64> Label;
@@ -49,6 +50,13 @@ class Vfs::Block_file_system : public Single_file_system
 		bool                        _readable;
 		bool                        _writeable;
 
+		/*
+		 * Device content provided as dataspace by the server, which is
+		 * accessed directly instead of via the packet stream
+		 */
+		Genode::Dataspace_capability _mapped_ds;
+		char                        *_mapped;
+
 		Genode::Signal_receiver           _signal_receiver;
 		Genode::Signal_context            _signal_context;
 		Genode::Signal_context_capability _source_submit_cap;
@@ -70,10 +78,23 @@ class Vfs::Block_file_system : public Single_file_system
 				Block::Session::Tx::Source        *_tx_source;
 				bool                              &_readable;
 				bool                              &_writeable;
+				char                              *_mapped;
 				Genode::Signal_receiver           &_signal_receiver;
 				Genode::Signal_context            &_signal_context;
 				Genode::Signal_context_capability &_source_submit_cap;
 
+				/**
+				 * Return number of bytes accessible at the current seek
+				 * offset of the mapped device content
+				 */
+				file_size _mapped_count(file_size count)
+				{
+					file_size const size   = _block_count * _block_size;
+					file_size const offset = seek();
+
+					return offset < size ? Genode::min(count, size - offset) : 0;
+				}
+
 				file_size _block_io(file_size nr, void *buf, file_size sz,
 				                    bool write, bool bulk = false)
 				{
@@ -148,6 +169,7 @@ class Vfs::Block_file_system : public Single_file_system
 				                 Block::Session::Tx::Source        *tx_source,
 				                 bool                              &readable,
 				                 bool                              &writeable,
+				                 char                              *mapped,
 				                 Genode::Signal_receiver           &signal_receiver,
 				                 Genode::Signal_context            &signal_context,
 				                 Genode::Signal_context_capability &source_submit_cap)
@@ -165,6 +187,7 @@ class Vfs::Block_file_system : public Single_file_system
 				  _tx_source(tx_source),
 				  _readable(readable),
 				  _writeable(writeable),
+				  _mapped(mapped),
 				  _signal_receiver(signal_receiver),
 				  _signal_context(signal_context),
 				  _source_submit_cap(source_submit_cap)
@@ -178,6 +201,12 @@ class Vfs::Block_file_system : public Single_file_system
 						return READ_ERR_INVALID;
 					}
 
+					if (_mapped) {
+						out_count = _mapped_count(count);
+						Genode::memcpy(dst, _mapped + seek(), out_count);
+						return READ_OK;
+					}
+
 					file_size seek_offset = seek();
 
 					file_size read = 0;
@@ -246,6 +275,12 @@ class Vfs::Block_file_system : public Single_file_system
 						return WRITE_ERR_INVALID;
 					}
 
+					if (_mapped) {
+						out_count = _mapped_count(count);
+						Genode::memcpy(_mapped + seek(), buf, out_count);
+						return WRITE_OK;
+					}
+
 					file_size seek_offset = seek();
 
 					file_size written = 0;
@@ -328,6 +363,7 @@ class Vfs::Block_file_system : public Single_file_system
 		                  Io_response_handler &)
 		:
 			Single_file_system(NODE_TYPE_BLOCK_DEVICE, name(), config),
+			_env(env),
 			_alloc(alloc),
 			_label(config.attribute_value("label", Label())),
 			_block_buffer(0),
@@ -336,6 +372,7 @@ class Vfs::Block_file_system : public Single_file_system
 			_tx_source(_block.tx()),
 			_readable(false),
 			_writeable(false),
+			_mapped(nullptr),
 			_source_submit_cap(_signal_receiver.manage(&_signal_context))
 		{
 			try { config.attribute("block_buffer_count").value(&_block_buffer_count); }
@@ -349,10 +386,25 @@ class Vfs::Block_file_system : public Single_file_system
 			_block_buffer = new (_alloc) char[_block_buffer_count * _block_size];
 
 			_block.tx_channel()->sigh_ready_to_submit(_source_submit_cap);
+
+			/* access the device content directly if offered by the server */
+			if (_block_ops.mappable() && config.attribute_value("map", true)) {
+				try {
+					_mapped_ds = _block.dataspace();
+					if (_mapped_ds.valid())
+						_mapped = _env.rm().attach(_mapped_ds);
+				} catch (...) {
+					Genode::warning("could not map block device, use packet stream");
+					_mapped_ds = Genode::Dataspace_capability();
+				}
+			}
 		}
 
 		~Block_file_system()
 		{
+			if (_mapped)
+				_env.rm().detach(_mapped);
+
 			_signal_receiver.dissolve(&_signal_context);
 
 			destroy(_alloc, _block_buffer);
@@ -384,12 +436,25 @@ class Vfs::Block_file_system : public Single_file_system
 			                                           _tx_source,
 			                                           _readable,
 			                                           _writeable,
+			                                           _mapped,
 			                                           _signal_receiver,
 			                                           _signal_context,
 			                                           _source_submit_cap);
 			return OPEN_OK;
 		}
 
+		/*
+		 * The dataspace is handed out only if it is mapped locally,
+		 * which implies that the server permits the access mode
+		 */
+		Dataspace_capability dataspace(char const *path) override
+		{
+			if (!_single_file(path) || !_mapped)
+				return Dataspace_capability();
+
+			return _mapped_ds;
+		}
+
 		Stat_result stat(char const *path, Stat &out) override
 		{
 			Stat_result const result = Single_file_system::stat(path, out);
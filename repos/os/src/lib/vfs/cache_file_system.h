@@ -0,0 +1,758 @@
+/*
+ * \brief  Page cache in front of other file systems
+ * \author Genode Labs
+ * \date   2026-10-14
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__VFS__CACHE_FILE_SYSTEM_H_
+#define _INCLUDE__VFS__CACHE_FILE_SYSTEM_H_
+
+/* Genode includes */
+#include <os/reporter.h>
+#include <ram_fs/name_index.h>
+#include <vfs/dir_file_system.h>
+
+namespace Vfs { class Cache_file_system; }
+
+
+/**
+ * Bounded page cache for the file systems hosted by a '<cache>' node
+ *
+ * File content read via the cache is kept in pages of 'page_size' bytes.
+ * The amount of cached content is limited by the 'size' attribute. Once all
+ * pages are in use, the least recently used page is reused.
+ *
+ * Writing to a file via the cache drops its cached pages. To notice
+ * modifications by other parties, the cache keeps a handle open for each
+ * cached file and asks the underlying file system to notify it about
+ * content changes. For file systems that cannot detect modifications, all
+ * writes must be issued via the cache.
+ *
+ * If the 'report' attribute is set to "yes", the cache reports its hit and
+ * miss counters as "vfs_cache" report.
+ */
+class Vfs::Cache_file_system : public File_system, private Io_response_handler
+{
+	private:
+
+		enum { REPORT_INTERVAL = 64 };
+
+		struct File;
+
+		struct Page : Genode::Avl_node<Page>
+		{
+			File          *file      = nullptr; /* owner, nullptr if unused */
+			file_size      index     = 0;
+			file_size      length    = 0;       /* number of valid bytes */
+			unsigned long  last_used = 0;
+			char          *data      = nullptr;
+
+			/* page is referenced by a pending read and must not be reused */
+			bool busy = false;
+
+			bool higher(Page *p) { return p->index > index; }
+
+			Page *find(file_size i)
+			{
+				if (i == index) return this;
+
+				Page *p = Avl_node<Page>::child(i > index);
+				return p ? p->find(i) : nullptr;
+			}
+		};
+
+		/**
+		 * Context of the handle used for watching a file
+		 */
+		struct Watch : Vfs_handle::Context, Genode::Avl_node<Watch>
+		{
+			File &file;
+
+			Watch(File &file) : file(file) { }
+
+			Vfs_handle::Context const *context() const { return this; }
+
+			bool higher(Watch *w) { return w->context() > context(); }
+
+			Watch *find(Vfs_handle::Context const *c)
+			{
+				if (c == context()) return this;
+
+				Watch *w = Avl_node<Watch>::child(c > context());
+				return w ? w->find(c) : nullptr;
+			}
+		};
+
+		struct File : Genode::Avl_node<File>
+		{
+			Absolute_path const path;
+
+			Genode::Avl_tree<Page> pages;
+
+			unsigned num_pages = 0;
+			unsigned handles   = 0;
+
+			/* file is not reachable via its path anymore */
+			bool detached = false;
+
+			/* incremented on modification to discard outdated page fills */
+			unsigned long generation = 0;
+
+			Watch       watch { *this };
+			Vfs_handle *watch_handle = nullptr;
+
+			File(char const *path) : path(path) { }
+
+			char const *name() const { return path.base(); }
+
+			bool higher(File *f) {
+				return ::File_system::Name_index<File>::ordered(this, f); }
+
+			Page *page(file_size index) {
+				return pages.first() ? pages.first()->find(index) : nullptr; }
+		};
+
+		struct Cache_handle : Vfs_handle
+		{
+			Vfs_handle &sub;
+			File       &file;
+
+			/*
+			 * FILL: page is read from the sub file system
+			 * HIT:  page is cached
+			 * PASS: no page available, read without caching
+			 */
+			enum class State { IDLE, FILL, HIT, PASS };
+
+			State         state      = State::IDLE;
+			Page         *page       = nullptr;
+			file_size     page_index = 0;
+			unsigned long generation = 0;
+
+			Cache_handle(Directory_service &ds, File_io_service &fs,
+			             Genode::Allocator &alloc, int status_flags,
+			             Vfs_handle &sub, File &file)
+			:
+				Vfs_handle(ds, fs, alloc, status_flags), sub(sub), file(file)
+			{ }
+
+			/**
+			 * Prepare sub handle for an operation at the current offset
+			 */
+			Vfs_handle &prepare(file_size offset)
+			{
+				sub.seek(offset);
+				sub.context = context;
+				return sub;
+			}
+		};
+
+		Genode::Allocator   &_alloc;
+		Io_response_handler &_io_handler;
+
+		Dir_file_system _vfs;
+
+		file_size const _page_size;
+		unsigned  const _num_pages;
+
+		Page * const _pages;
+		char * const _data;
+
+		unsigned long _tick = 0;
+
+		::File_system::Name_index<File> _files;
+		Genode::Avl_tree<Watch>         _watches;
+
+		unsigned long _hits          = 0;
+		unsigned long _misses        = 0;
+		unsigned long _evictions     = 0;
+		unsigned long _invalidations = 0;
+
+		Genode::Reporter _reporter;
+
+		void _report()
+		{
+			if (!_reporter.enabled())
+				return;
+
+			try {
+				Genode::Reporter::Xml_generator xml(_reporter, [&] () {
+					xml.attribute("hits",          _hits);
+					xml.attribute("misses",        _misses);
+					xml.attribute("evictions",     _evictions);
+					xml.attribute("invalidations", _invalidations);
+					xml.attribute("pages",         _num_pages);
+					xml.attribute("page_size",     _page_size);
+				});
+			} catch (...) { Genode::warning("could not generate cache report"); }
+		}
+
+		void _count_access(unsigned long &counter)
+		{
+			counter++;
+			if ((_hits + _misses) % REPORT_INTERVAL == 0)
+				_report();
+		}
+
+		void _detach_page(Page &page)
+		{
+			page.file->pages.remove(&page);
+			page.file->num_pages--;
+			page.file = nullptr;
+		}
+
+		void _release_if_unused(File &file)
+		{
+			if (file.handles || file.num_pages)
+				return;
+
+			if (file.watch_handle) {
+				_watches.remove(&file.watch);
+				file.watch_handle->ds().close(file.watch_handle);
+			}
+
+			if (!file.detached)
+				_files.remove(&file);
+
+			Genode::destroy(_alloc, &file);
+		}
+
+		/**
+		 * Drop all cached pages of 'file'
+		 */
+		void _invalidate(File &file)
+		{
+			file.generation++;
+
+			while (Page *page = file.pages.first()) {
+				_detach_page(*page);
+				page->last_used = 0;
+			}
+		}
+
+		/**
+		 * Make 'file' unreachable via its path
+		 *
+		 * The file stays allocated as long as it is referenced by handles.
+		 */
+		void _forget(char const *path)
+		{
+			Absolute_path const canonical(path);
+
+			File *file = _files.lookup(canonical.base());
+			if (!file)
+				return;
+
+			_invalidate(*file);
+
+			if (file->watch_handle) {
+				_watches.remove(&file->watch);
+				file->watch_handle->ds().close(file->watch_handle);
+				file->watch_handle = nullptr;
+			}
+
+			_files.remove(file);
+			file->detached = true;
+
+			_release_if_unused(*file);
+		}
+
+		/**
+		 * Return cache state of the file at 'path', create it if needed
+		 */
+		File &_file(char const *path)
+		{
+			Absolute_path const canonical(path);
+
+			if (File *file = _files.lookup(canonical.base()))
+				return *file;
+
+			File &file = *new (_alloc) File(canonical.base());
+			_files.insert(&file);
+
+			/* ask the file system to tell us about foreign modifications */
+			Vfs_handle *watch_handle = nullptr;
+			if (_vfs.open(path, OPEN_MODE_RDONLY, &watch_handle, _alloc) != OPEN_OK)
+				return file;
+
+			watch_handle->context = &file.watch;
+			if (!watch_handle->fs().notify_content_changed(watch_handle)) {
+				watch_handle->ds().close(watch_handle);
+				return file;
+			}
+
+			file.watch_handle = watch_handle;
+			_watches.insert(&file.watch);
+			return file;
+		}
+
+		/**
+		 * Obtain page for caching, reusing the least recently used one
+		 *
+		 * \return  page, or nullptr if all pages are busy
+		 */
+		Page *_claim()
+		{
+			Page *victim = nullptr;
+			for (unsigned i = 0; i < _num_pages; i++) {
+				Page &page = _pages[i];
+				if (!page.busy && (!victim || page.last_used < victim->last_used))
+					victim = &page;
+			}
+
+			if (!victim)
+				return nullptr;
+
+			if (File *file = victim->file) {
+				_detach_page(*victim);
+				_evictions++;
+				_release_if_unused(*file);
+			}
+
+			victim->busy = true;
+			return victim;
+		}
+
+		void _unpin(Page &page)
+		{
+			page.busy = false;
+
+			/* page was not inserted or invalidated meanwhile */
+			if (!page.file)
+				page.last_used = 0;
+		}
+
+		void _insert(File &file, Page &page, file_size index)
+		{
+			/* replace page that was filled concurrently via another handle */
+			if (Page *old = file.page(index)) {
+				_detach_page(*old);
+				old->last_used = 0;
+			}
+
+			page.file      = &file;
+			page.index     = index;
+			page.last_used = ++_tick;
+			file.pages.insert(&page);
+			file.num_pages++;
+		}
+
+		/**
+		 * Copy data from 'first' and the cached pages following it
+		 */
+		file_size _copy(Cache_handle &handle, Page &first,
+		                char *dst, file_size count)
+		{
+			file_size copied = 0;
+			file_size pos    = handle.seek();
+
+			for (Page *page = &first; page && copied < count; ) {
+
+				file_size const offset = pos % _page_size;
+				if (offset >= page->length)
+					break;
+
+				file_size const n = min(count - copied, page->length - offset);
+				memcpy(dst + copied, page->data + offset, n);
+
+				page->last_used = ++_tick;
+				copied += n;
+				pos    += n;
+
+				if (page->length < _page_size)
+					break;
+
+				page = handle.file.page(pos / _page_size);
+			}
+			return copied;
+		}
+
+		static file_size _page_size_from_config(Genode::Xml_node config)
+		{
+			file_size const size = config.attribute_value("page_size",
+			                       Genode::Number_of_bytes(4096));
+			return Genode::max(size, (file_size)512);
+		}
+
+		static unsigned _num_pages_from_config(Genode::Xml_node config,
+		                                       file_size page_size)
+		{
+			file_size const size = config.attribute_value("size",
+			                       Genode::Number_of_bytes(1024*1024));
+			return Genode::max((unsigned)(size / page_size), 1U);
+		}
+
+
+		/**********************************
+		 ** Io_response_handler interface **
+		 **********************************/
+
+		void handle_io_response(Vfs_handle::Context *context) override
+		{
+			Watch *watch = (context && _watches.first())
+			             ? _watches.first()->find(context) : nullptr;
+
+			if (!watch) {
+				_io_handler.handle_io_response(context);
+				return;
+			}
+
+			_invalidations++;
+			_invalidate(watch->file);
+			_release_if_unused(watch->file);
+			_report();
+		}
+
+	public:
+
+		Cache_file_system(Genode::Env         &env,
+		                  Genode::Allocator   &alloc,
+		                  Genode::Xml_node     config,
+		                  Io_response_handler &io_handler,
+		                  File_system_factory &fs_factory)
+		:
+			_alloc(alloc), _io_handler(io_handler),
+			_vfs(env, alloc, config, *this, fs_factory, Dir_file_system::Root()),
+			_page_size(_page_size_from_config(config)),
+			_num_pages(_num_pages_from_config(config, _page_size)),
+			_pages(new (alloc) Page[_num_pages]),
+			_data((char *)alloc.alloc(_page_size * _num_pages)),
+			_reporter(env, "vfs_cache")
+		{
+			for (unsigned i = 0; i < _num_pages; i++)
+				_pages[i].data = _data + i * _page_size;
+
+			_reporter.enabled(config.attribute_value("report", false));
+			_report();
+		}
+
+		~Cache_file_system()
+		{
+			while (File *file = _files.any())
+				_forget(file->name());
+
+			_alloc.free(_data, _page_size * _num_pages);
+			Genode::destroy(_alloc, _pages);
+		}
+
+		static char const *name()   { return "cache"; }
+		char const *type() override { return "cache"; }
+
+		void apply_config(Genode::Xml_node const &node) override {
+			_vfs.apply_config(node); }
+
+
+		/*********************************
+		 ** Directory-service interface **
+		 *********************************/
+
+		Dataspace_capability dataspace(char const *path) override {
+			return _vfs.dataspace(path); }
+
+		void release(char const *path, Dataspace_capability ds_cap) override {
+			_vfs.release(path, ds_cap); }
+
+		Stat_result stat(char const *path, Stat &out) override {
+			return _vfs.stat(path, out); }
+
+		Unlink_result unlink(char const *path) override
+		{
+			Unlink_result const result = _vfs.unlink(path);
+			if (result == UNLINK_OK)
+				_forget(path);
+			return result;
+		}
+
+		Rename_result rename(char const *from, char const *to) override
+		{
+			Rename_result const result = _vfs.rename(from, to);
+			if (result == RENAME_OK) {
+				_forget(from);
+				_forget(to);
+			}
+			return result;
+		}
+
+		file_size num_dirent(char const *path) override {
+			return _vfs.num_dirent(path); }
+
+		bool directory(char const *path) override {
+			return _vfs.directory(path); }
+
+		char const *leaf_path(char const *path) override {
+			return _vfs.leaf_path(path); }
+
+		Open_result open(char const *path, unsigned mode,
+		                 Vfs_handle **out_handle, Allocator &alloc) override
+		{
+			Vfs_handle *sub = nullptr;
+
+			Open_result const result = _vfs.open(path, mode, &sub, alloc);
+			if (result != OPEN_OK)
+				return result;
+
+			File *file = nullptr;
+
+			try {
+				file = &_file(path);
+				file->handles++;
+
+				*out_handle = new (alloc)
+					Cache_handle(*this, *this, alloc, sub->status_flags(),
+					             *sub, *file);
+				return OPEN_OK;
+			}
+			catch (Genode::Out_of_ram)  { }
+			catch (Genode::Out_of_caps) { }
+
+			sub->ds().close(sub);
+
+			if (file) {
+				file->handles--;
+				_release_if_unused(*file);
+			}
+			return OPEN_ERR_OUT_OF_RAM;
+		}
+
+		/*
+		 * Directories and symlinks are not cached, the handles of the
+		 * sub file systems are handed out directly
+		 */
+
+		Opendir_result opendir(char const *path, bool create,
+		                       Vfs_handle **out_handle, Allocator &alloc) override {
+			return _vfs.opendir(path, create, out_handle, alloc); }
+
+		Openlink_result openlink(char const *path, bool create,
+		                         Vfs_handle **out_handle, Allocator &alloc) override {
+			return _vfs.openlink(path, create, out_handle, alloc); }
+
+		void close(Vfs_handle *vfs_handle) override
+		{
+			if (!vfs_handle) return;
+
+			Cache_handle &handle = static_cast<Cache_handle &>(*vfs_handle);
+
+			if (handle.page)
+				_unpin(*handle.page);
+
+			handle.sub.ds().close(&handle.sub);
+
+			File &file = handle.file;
+			Genode::destroy(handle.alloc(), &handle);
+
+			file.handles--;
+			_release_if_unused(file);
+		}
+
+
+		/********************************
+		 ** File I/O service interface **
+		 ********************************/
+
+		Write_result write(Vfs_handle *vfs_handle, char const *buf,
+		                   file_size count, file_size &out_count) override
+		{
+			Cache_handle &handle = static_cast<Cache_handle &>(*vfs_handle);
+			Vfs_handle   &sub    = handle.prepare(handle.seek());
+
+			Write_result const result =
+				sub.fs().write(&sub, buf, count, out_count);
+
+			if (result == WRITE_OK)
+				_invalidate(handle.file);
+
+			return result;
+		}
+
+		bool queue_read(Vfs_handle *vfs_handle, file_size count) override
+		{
+			Cache_handle &handle = static_cast<Cache_handle &>(*vfs_handle);
+
+			if (handle.state != Cache_handle::State::IDLE)
+				return true;
+
+			file_size const index = handle.seek() / _page_size;
+
+			if (Page *page = handle.file.page(index)) {
+				page->busy   = true;
+				handle.page  = page;
+				handle.state = Cache_handle::State::HIT;
+				return true;
+			}
+
+			Page *page = _claim();
+
+			if (!page) {
+				Vfs_handle &sub = handle.prepare(handle.seek());
+				if (!sub.fs().queue_read(&sub, count))
+					return false;
+
+				handle.state = Cache_handle::State::PASS;
+				return true;
+			}
+
+			Vfs_handle &sub = handle.prepare(index * _page_size);
+			if (!sub.fs().queue_read(&sub, _page_size)) {
+				_unpin(*page);
+				return false;
+			}
+
+			handle.state      = Cache_handle::State::FILL;
+			handle.page       = page;
+			handle.page_index = index;
+			handle.generation = handle.file.generation;
+			return true;
+		}
+
+		Read_result complete_read(Vfs_handle *vfs_handle, char *dst,
+		                          file_size count, file_size &out_count) override
+		{
+			Cache_handle &handle = static_cast<Cache_handle &>(*vfs_handle);
+			Vfs_handle   &sub    = handle.sub;
+
+			out_count = 0;
+
+			switch (handle.state) {
+
+			case Cache_handle::State::IDLE:
+				return READ_ERR_INVALID;
+
+			case Cache_handle::State::PASS:
+			{
+				Read_result const result =
+					sub.fs().complete_read(&sub, dst, count, out_count);
+
+				if (result != READ_QUEUED) {
+					handle.state = Cache_handle::State::IDLE;
+					_count_access(_misses);
+				}
+				return result;
+			}
+
+			case Cache_handle::State::HIT:
+			{
+				Page &page = *handle.page;
+
+				out_count = _copy(handle, page, dst, count);
+
+				handle.page  = nullptr;
+				handle.state = Cache_handle::State::IDLE;
+				_unpin(page);
+				_count_access(_hits);
+				return READ_OK;
+			}
+
+			case Cache_handle::State::FILL:
+			{
+				Page &page = *handle.page;
+
+				file_size length = 0;
+				Read_result const result =
+					sub.fs().complete_read(&sub, page.data, _page_size, length);
+
+				if (result == READ_QUEUED)
+					return result;
+
+				handle.page  = nullptr;
+				handle.state = Cache_handle::State::IDLE;
+
+				if (result == READ_OK) {
+					page.length = length;
+
+					/* do not cache data that predates a modification */
+					if (handle.generation == handle.file.generation)
+						_insert(handle.file, page, handle.page_index);
+
+					out_count = _copy(handle, page, dst, count);
+				}
+
+				_unpin(page);
+				_count_access(_misses);
+				return result;
+			}
+			}
+
+			return READ_ERR_INVALID;
+		}
+
+		bool read_ready(Vfs_handle *vfs_handle) override
+		{
+			Cache_handle &handle = static_cast<Cache_handle &>(*vfs_handle);
+			Vfs_handle   &sub    = handle.prepare(handle.seek());
+
+			return sub.fs().read_ready(&sub);
+		}
+
+		bool notify_read_ready(Vfs_handle *vfs_handle) override
+		{
+			Cache_handle &handle = static_cast<Cache_handle &>(*vfs_handle);
+			Vfs_handle   &sub    = handle.prepare(handle.seek());
+
+			return sub.fs().notify_read_ready(&sub);
+		}
+
+		Ftruncate_result ftruncate(Vfs_handle *vfs_handle, file_size len) override
+		{
+			Cache_handle &handle = static_cast<Cache_handle &>(*vfs_handle);
+			Vfs_handle   &sub    = handle.prepare(handle.seek());
+
+			Ftruncate_result const result = sub.fs().ftruncate(&sub, len);
+
+			if (result == FTRUNCATE_OK)
+				_invalidate(handle.file);
+
+			return result;
+		}
+
+		Ioctl_result ioctl(Vfs_handle *vfs_handle, Ioctl_opcode opcode,
+		                   Ioctl_arg arg, Ioctl_out &out) override
+		{
+			Cache_handle &handle = static_cast<Cache_handle &>(*vfs_handle);
+			Vfs_handle   &sub    = handle.prepare(handle.seek());
+
+			return sub.fs().ioctl(&sub, opcode, arg, out);
+		}
+
+		bool check_unblock(Vfs_handle *vfs_handle,
+		                   bool rd, bool wr, bool ex) override
+		{
+			Cache_handle &handle = static_cast<Cache_handle &>(*vfs_handle);
+			Vfs_handle   &sub    = handle.prepare(handle.seek());
+
+			return sub.fs().check_unblock(&sub, rd, wr, ex);
+		}
+
+		void register_read_ready_sigh(Vfs_handle *vfs_handle,
+		                              Signal_context_capability sigh) override
+		{
+			Cache_handle &handle = static_cast<Cache_handle &>(*vfs_handle);
+
+			handle.sub.fs().register_read_ready_sigh(&handle.sub, sigh);
+		}
+
+		bool queue_sync(Vfs_handle *vfs_handle) override
+		{
+			Cache_handle &handle = static_cast<Cache_handle &>(*vfs_handle);
+			Vfs_handle   &sub    = handle.prepare(handle.seek());
+
+			return sub.fs().queue_sync(&sub);
+		}
+
+		Sync_result complete_sync(Vfs_handle *vfs_handle) override
+		{
+			Cache_handle &handle = static_cast<Cache_handle &>(*vfs_handle);
+			Vfs_handle   &sub    = handle.prepare(handle.seek());
+
+			return sub.fs().complete_sync(&sub);
+		}
+};
+
+#endif /* _INCLUDE__VFS__CACHE_FILE_SYSTEM_H_ */
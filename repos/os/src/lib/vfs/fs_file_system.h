@@ -17,9 +17,9 @@
 #define _INCLUDE__VFS__FS_FILE_SYSTEM_H_
 
 /* Genode includes */
-#include <base/allocator_avl.h>
 #include <base/id_space.h>
 #include <file_system_session/connection.h>
+#include <os/tlsf_allocator.h>
 
 
 namespace Vfs { class Fs_file_system; }
@@ -40,7 +40,7 @@ class Vfs::Fs_file_system : public File_system
 		Lock _lock;
 
 		Genode::Env           &_env;
-		Genode::Allocator_avl  _fs_packet_alloc;
+		Genode::Tlsf_allocator _fs_packet_alloc;
 		Io_response_handler   &_io_handler;
 
 		typedef Genode::String<64> Label_string;
@@ -57,15 +57,41 @@ class Vfs::Fs_file_system : public File_system
 
 		struct Handle_state
 		{
+			enum { MAX_READ_WINDOW = 16 };
+
 			enum class Read_ready_state { IDLE, PENDING, READY };
 			Read_ready_state read_ready_state = Read_ready_state::IDLE;
 
 			enum class Queued_state { IDLE, QUEUED, ACK };
-			Queued_state queued_read_state = Queued_state::IDLE;
 			Queued_state queued_sync_state = Queued_state::IDLE;
 
-			::File_system::Packet_descriptor queued_read_packet;
 			::File_system::Packet_descriptor queued_sync_packet;
+
+			/**
+			 * READ packet submitted on behalf of the handle
+			 */
+			struct Read_slot
+			{
+				Queued_state state = Queued_state::IDLE;
+
+				/* packet is of no interest anymore, release it on ack */
+				bool stale = false;
+
+				file_size requested = 0;
+				file_size consumed  = 0;
+
+				::File_system::Packet_descriptor packet;
+
+				file_size position() const {
+					return packet.position() + consumed; }
+			};
+
+			Read_slot read_slots[MAX_READ_WINDOW];
+
+			/* file offset following the last byte requested via READ */
+			file_size read_ahead_end = 0;
+
+			unsigned writes_in_flight = 0;
 		};
 
 		struct Fs_vfs_handle : Vfs_handle, ::File_system::Node,
@@ -74,22 +100,74 @@ class Vfs::Fs_file_system : public File_system
 			::File_system::Connection &_fs;
 			Io_response_handler       &_io_handler;
 
-			bool _queue_read(file_size count, file_size const seek_offset)
+			unsigned const _read_window;
+			unsigned const _write_window;
+
+			/**
+			 * Return slot that provides the data at file offset 'position'
+			 */
+			Read_slot *_read_slot(file_size position)
 			{
-				if (queued_read_state != Handle_state::Queued_state::IDLE)
-					return false;
+				for (Read_slot &slot : read_slots)
+					if (slot.state != Queued_state::IDLE && !slot.stale
+					 && slot.position() == position)
+						return &slot;
+				return nullptr;
+			}
+
+			void _release_read(Read_slot &slot)
+			{
+				_fs.tx()->release_packet(slot.packet);
+				slot = Read_slot();
+			}
+
+			/**
+			 * Drop read-ahead data located before 'position', or all data
+			 * if 'position' is omitted
+			 */
+			void _discard_reads(file_size position = ~(file_size)0)
+			{
+				bool released = false;
+
+				for (Read_slot &slot : read_slots) {
+
+					if (slot.state == Queued_state::IDLE || slot.stale
+					 || slot.position() >= position)
+						continue;
+
+					if (slot.state == Queued_state::ACK) {
+						_release_read(slot);
+						released = true;
+					} else {
+						slot.stale = true;
+					}
+				}
+
+				if (position == ~(file_size)0)
+					read_ahead_end = 0;
 
+				/*
+				 * Notify anyone who might have failed on
+				 * 'alloc_packet()' or 'submit_packet()'
+				 */
+				if (released)
+					_io_handler.handle_io_response(nullptr);
+			}
+
+			bool _submit_read(file_size count, file_size seek_offset)
+			{
 				::File_system::Session::Tx::Source &source = *_fs.tx();
 
-				/* if not ready to submit suggest retry */
-				if (!source.ready_to_submit()) return false;
+				Read_slot *slot = nullptr;
+				for (Read_slot &s : read_slots)
+					if (s.state == Queued_state::IDLE) { slot = &s; break; }
 
-				file_size const max_packet_size = source.bulk_buffer_size() / 2;
-				file_size const clipped_count = min(max_packet_size, count);
+				/* if not ready to submit suggest retry */
+				if (!slot || !source.ready_to_submit()) return false;
 
 				::File_system::Packet_descriptor p;
 				try {
-					p = source.alloc_packet(clipped_count);
+					p = source.alloc_packet(count);
 				} catch (::File_system::Session::Tx::Source::Packet_alloc_failed) {
 					return false;
 				}
@@ -97,10 +175,13 @@ class Vfs::Fs_file_system : public File_system
 				::File_system::Packet_descriptor const
 					packet(p, file_handle(),
 					       ::File_system::Packet_descriptor::READ,
-					       clipped_count, seek_offset);
+					       count, seek_offset);
 
-				read_ready_state  = Handle_state::Read_ready_state::IDLE;
-				queued_read_state = Handle_state::Queued_state::QUEUED;
+				slot->state     = Queued_state::QUEUED;
+				slot->requested = count;
+				slot->packet    = packet;
+
+				read_ahead_end = seek_offset + count;
 
 				/* pass packet to server side */
 				source.submit_packet(packet);
@@ -108,28 +189,116 @@ class Vfs::Fs_file_system : public File_system
 				return true;
 			}
 
-			Read_result _complete_read(void *dst, file_size count,
-			                           file_size &out_count)
+			/**
+			 * Keep up to '_read_window' READ packets in flight
+			 *
+			 * The handle never occupies more than half of the packet buffer
+			 * for read-ahead to leave room for other handles.
+			 */
+			void _read_ahead(file_size count)
+			{
+				file_size const max_bytes = _fs.tx()->bulk_buffer_size() / 2;
+
+				for (;;) {
+
+					unsigned  in_flight = 0;
+					file_size bytes     = 0;
+					for (Read_slot const &slot : read_slots) {
+						if (slot.state == Queued_state::IDLE || slot.stale)
+							continue;
+						in_flight++;
+						bytes += slot.requested;
+					}
+
+					if (in_flight >= _read_window || bytes + count > max_bytes)
+						return;
+
+					if (!_submit_read(count, read_ahead_end))
+						return;
+				}
+			}
+
+			bool _queue_read(file_size count, file_size const seek_offset)
+			{
+				file_size const max_packet_size = _fs.tx()->bulk_buffer_size() / 2;
+				file_size const clipped_count = min(max_packet_size, count);
+
+				Read_slot * const slot = _read_slot(seek_offset);
+
+				/*
+				 * Reading continues at the end of the previous request, or the
+				 * requested data is already in flight.
+				 */
+				bool const sequential = slot || (seek_offset == read_ahead_end);
+
+				if (slot)
+					_discard_reads(seek_offset);
+				else {
+					_discard_reads();
+					if (!_submit_read(clipped_count, seek_offset))
+						return false;
+				}
+
+				read_ready_state = Handle_state::Read_ready_state::IDLE;
+
+				if (sequential && _read_window > 1)
+					_read_ahead(clipped_count);
+
+				return true;
+			}
+
+			/**
+			 * Hand out the data of an acknowledged READ packet
+			 *
+			 * \param consume  functor called with the packet content
+			 *                 and the number of bytes at hand, returns
+			 *                 the number of bytes taken or a negative
+			 *                 value on error
+			 */
+			template <typename FN>
+			Read_result _complete_read(file_size count,
+			                           file_size const seek_offset,
+			                           file_size &out_count,
+			                           FN const &consume)
 			{
-				if (queued_read_state != Handle_state::Queued_state::ACK)
+				Read_slot * const slot = _read_slot(seek_offset);
+
+				if (!slot || slot->state != Queued_state::ACK)
 					return READ_QUEUED;
 
 				/* obtain result packet descriptor with updated status info */
-				::File_system::Packet_descriptor const
-					packet = queued_read_packet;
+				::File_system::Packet_descriptor const packet = slot->packet;
 
-				file_size const read_num_bytes = min(packet.length(), count);
+				file_size const length = packet.length();
+				file_size const avail  = length > slot->consumed
+				                       ? length - slot->consumed : 0;
 
 				::File_system::Session::Tx::Source &source = *_fs.tx();
 
-				memcpy(dst, source.packet_content(packet), read_num_bytes);
+				long long const consumed =
+					consume(source.packet_content(packet) + slot->consumed,
+					        min(avail, count));
 
-				queued_read_state  = Handle_state::Queued_state::IDLE;
-				queued_read_packet = ::File_system::Packet_descriptor();
+				if (consumed < 0)
+					return READ_ERR_IO;
 
-				out_count  = read_num_bytes;
+				file_size const read_num_bytes = (file_size)consumed;
 
-				source.release_packet(packet);
+				slot->consumed += read_num_bytes;
+				out_count       = read_num_bytes;
+
+				if (slot->consumed < length)
+					return READ_OK;
+
+				bool const end_of_file = length < slot->requested;
+
+				_release_read(*slot);
+
+				/* read-ahead beyond the end of the file is pointless */
+				if (end_of_file) {
+					_discard_reads();
+					read_ahead_end = ~(file_size)0;
+				}
 
 				/*
 				 * Notify anyone who might have failed on
@@ -140,17 +309,66 @@ class Vfs::Fs_file_system : public File_system
 				return READ_OK;
 			}
 
+			Read_result _complete_read(void *dst, file_size count,
+			                           file_size const seek_offset,
+			                           file_size &out_count)
+			{
+				return _complete_read(count, seek_offset, out_count,
+					[&] (char const *src, file_size num_bytes) {
+						memcpy(dst, src, num_bytes);
+						return (long long)num_bytes; });
+			}
+
 			Fs_vfs_handle(File_system &fs, Allocator &alloc,
 			              int status_flags, Handle_space &space,
 			              ::File_system::Node_handle node_handle,
 			              ::File_system::Connection &fs_connection,
-			              Io_response_handler &io_handler)
+			              Io_response_handler &io_handler,
+			              unsigned read_window = 1,
+			              unsigned write_window = 1)
 			:
 				Vfs_handle(fs, fs, alloc, status_flags),
 				Handle_space::Element(*this, space, node_handle),
-				_fs(fs_connection), _io_handler(io_handler)
+				_fs(fs_connection), _io_handler(io_handler),
+				_read_window(read_window), _write_window(write_window)
 			{ }
 
+			/**
+			 * Record acknowledgement of a READ packet
+			 *
+			 * \return  false if the packet is not of interest anymore
+			 */
+			bool read_acked(::File_system::Packet_descriptor const &packet)
+			{
+				for (Read_slot &slot : read_slots) {
+
+					if (slot.state != Queued_state::QUEUED
+					 || slot.packet.offset() != packet.offset())
+						continue;
+
+					if (slot.stale) {
+						slot = Read_slot();
+						return false;
+					}
+
+					slot.packet = packet;
+					slot.state  = Queued_state::ACK;
+					return true;
+				}
+				return false;
+			}
+
+			/**
+			 * Return true if another WRITE packet may be submitted
+			 */
+			bool write_window_open() const {
+				return writes_in_flight < _write_window; }
+
+			/**
+			 * Drop read-ahead data, e.g., because the file is modified
+			 */
+			void discard_reads() { _discard_reads(); }
+
 			::File_system::File_handle file_handle() const
 			{ return ::File_system::File_handle { id().value }; }
 
@@ -167,6 +385,18 @@ class Vfs::Fs_file_system : public File_system
 				return READ_ERR_INVALID;
 			}
 
+			virtual Read_result complete_copy(Vfs_handle *, file_size, file_size &)
+			{
+				return READ_ERR_INVALID;
+			}
+
+			virtual Read_result complete_readv(Io_vector const *iov, unsigned iovcnt,
+			                                   file_size &out_count)
+			{
+				return iovcnt ? complete_read(iov[0].base, iov[0].size, out_count)
+				              : READ_OK;
+			}
+
 			bool queue_sync()
 			{
 				if (queued_sync_state != Handle_state::Queued_state::IDLE)
@@ -198,7 +428,9 @@ class Vfs::Fs_file_system : public File_system
 
 			Sync_result complete_sync()
 			{
-				if (queued_sync_state != Handle_state::Queued_state::ACK)
+				/* the sync completes not before all write-behind packets */
+				if (queued_sync_state != Handle_state::Queued_state::ACK
+				 || writes_in_flight)
 					return SYNC_QUEUED;
 
 				/* obtain result packet descriptor */
@@ -234,7 +466,67 @@ class Vfs::Fs_file_system : public File_system
 			Read_result complete_read(char *dst, file_size count,
 			                          file_size &out_count) override
 			{
-				return _complete_read(dst, count, out_count);
+				return _complete_read(dst, count, seek(), out_count);
+			}
+
+			/**
+			 * Scatter the data of one READ packet into the segments
+			 */
+			Read_result complete_readv(Io_vector const *iov, unsigned iovcnt,
+			                           file_size &out_count) override
+			{
+				file_size count = 0;
+				for (unsigned i = 0; i < iovcnt; i++)
+					count += iov[i].size;
+
+				return _complete_read(count, seek(), out_count,
+					[&] (char const *src, file_size num_bytes) {
+
+						file_size done = 0;
+						for (unsigned i = 0; i < iovcnt && done < num_bytes; i++) {
+							file_size const n = min(iov[i].size, num_bytes - done);
+							memcpy(iov[i].base, src + done, n);
+							done += n;
+						}
+						return (long long)done; });
+			}
+
+			/**
+			 * Write the read data from the packet buffer to 'to'
+			 *
+			 * Data not accepted by 'to' stays in the packet and is
+			 * handed out by the next read at the same offset.
+			 */
+			Read_result complete_copy(Vfs_handle *to, file_size count,
+			                          file_size &out_count) override
+			{
+				Write_result write_result = WRITE_OK;
+
+				Read_result const result =
+					_complete_read(count, seek(), out_count,
+						[&] (char const *src, file_size num_bytes) {
+
+							if (!num_bytes)
+								return 0LL;
+
+							file_size written = 0;
+							write_result = to->fs().write(to, src, num_bytes, written);
+
+							if (write_result == WRITE_OK && !written)
+								write_result = WRITE_ERR_WOULD_BLOCK;
+
+							return write_result == WRITE_OK
+							       ? (long long)written : -1LL; });
+
+				switch (write_result) {
+				case WRITE_ERR_AGAIN:       return READ_ERR_AGAIN;
+				case WRITE_ERR_WOULD_BLOCK: return READ_ERR_WOULD_BLOCK;
+				case WRITE_ERR_INVALID:     return READ_ERR_INVALID;
+				case WRITE_ERR_INTERRUPT:   return READ_ERR_INTERRUPT;
+				case WRITE_ERR_IO:          return READ_ERR_IO;
+				case WRITE_OK:              break;
+				}
+				return result;
 			}
 		};
 
@@ -265,7 +557,9 @@ class Vfs::Fs_file_system : public File_system
 				file_size       entry_out_count;
 
 				Read_result read_result =
-					_complete_read(&entry, DIRENT_SIZE, entry_out_count);
+					_complete_read(&entry, DIRENT_SIZE,
+					               seek() / sizeof(Dirent) * DIRENT_SIZE,
+					               entry_out_count);
 
 				if (read_result != READ_OK)
 					return read_result;
@@ -315,7 +609,7 @@ class Vfs::Fs_file_system : public File_system
 			Read_result complete_read(char *dst, file_size count,
 			                          file_size &out_count) override
 			{
-				return _complete_read(dst, count, out_count);
+				return _complete_read(dst, count, seek(), out_count);
 			}
 		};
 
@@ -414,57 +708,15 @@ class Vfs::Fs_file_system : public File_system
 
 		Post_signal_hook _post_signal_hook { _env.ep(), _io_handler };
 
-		file_size _read(Fs_vfs_handle &handle, void *buf,
-		                file_size const count, file_size const seek_offset)
-		{
-			::File_system::Session::Tx::Source &source = *_fs.tx();
-			using ::File_system::Packet_descriptor;
-
-			file_size const max_packet_size = source.bulk_buffer_size() / 2;
-			file_size const clipped_count = min(max_packet_size, count);
-
-			/* XXX check if alloc_packet() and submit_packet() will succeed! */
-
-			Packet_descriptor const packet_in(source.alloc_packet(clipped_count),
-			                                  handle.file_handle(),
-			                                  Packet_descriptor::READ,
-			                                  clipped_count,
-			                                  seek_offset);
-
-			/* wait until packet was acknowledged */
-			handle.queued_read_state = Handle_state::Queued_state::QUEUED;
-
-			/* pass packet to server side */
-			source.submit_packet(packet_in);
-
-			while (handle.queued_read_state != Handle_state::Queued_state::ACK) {
-				_env.ep().wait_and_dispatch_one_io_signal();
-			}
-
-			/* obtain result packet descriptor with updated status info */
-			Packet_descriptor const packet_out = handle.queued_read_packet;
-
-			handle.queued_read_state  = Handle_state::Queued_state::IDLE;
-			handle.queued_read_packet = Packet_descriptor();
-
-			if (!packet_out.succeeded()) {
-				/* could be EOF or a real error */
-				::File_system::Status status = _fs.status(handle.file_handle());
-				if (seek_offset < status.size)
-					Genode::warning("unexpected failure on file-system read");
-			}
-
-			file_size const read_num_bytes = min(packet_out.length(), count);
-
-			memcpy(buf, source.packet_content(packet_out), read_num_bytes);
-
-			source.release_packet(packet_out);
-
-			return read_num_bytes;
-		}
-
-		file_size _write(Fs_vfs_handle &handle,
-		                 const char *buf, file_size count, file_size seek_offset)
+		/**
+		 * Submit WRITE packet
+		 *
+		 * \param fill  functor called with the packet content and the
+		 *              number of bytes to write
+		 */
+		template <typename FN>
+		file_size _write(Fs_vfs_handle &handle, file_size count,
+		                 file_size seek_offset, FN const &fill)
 		{
 			::File_system::Session::Tx::Source &source = *_fs.tx();
 			using ::File_system::Packet_descriptor;
@@ -472,9 +724,12 @@ class Vfs::Fs_file_system : public File_system
 			file_size const max_packet_size = source.bulk_buffer_size() / 2;
 			count = min(max_packet_size, count);
 
-			if (!source.ready_to_submit())
+			if (!handle.write_window_open() || !source.ready_to_submit())
 				throw Insufficient_buffer();
 
+			/* read-ahead data may predate the write */
+			handle.discard_reads();
+
 			try {
 				Packet_descriptor packet_in(source.alloc_packet(count),
 				                            handle.file_handle(),
@@ -482,10 +737,11 @@ class Vfs::Fs_file_system : public File_system
 				                            count,
 				                            seek_offset);
 
-				memcpy(source.packet_content(packet_in), buf, count);
+				fill(source.packet_content(packet_in), count);
 
-				/* pass packet to server side */
+				/* pass packet to server side, the ack is not waited for */
 				source.submit_packet(packet_in);
+				handle.writes_in_flight++;
 			} catch (::File_system::Session::Tx::Source::Packet_alloc_failed) {
 				throw Insufficient_buffer();
 			} catch (...) {
@@ -495,6 +751,14 @@ class Vfs::Fs_file_system : public File_system
 			return count;
 		}
 
+		file_size _write(Fs_vfs_handle &handle,
+		                 const char *buf, file_size count, file_size seek_offset)
+		{
+			return _write(handle, count, seek_offset,
+				[&] (char *dst, file_size num_bytes) {
+					memcpy(dst, buf, num_bytes); });
+		}
+
 		void _handle_ack()
 		{
 			::File_system::Session::Tx::Source &source = *_fs.tx();
@@ -506,6 +770,8 @@ class Vfs::Fs_file_system : public File_system
 
 				Handle_space::Id const id(packet.handle());
 
+				bool release = packet.operation() == Packet_descriptor::WRITE;
+
 				try {
 					_handle_space.apply<Fs_vfs_handle>(id, [&] (Fs_vfs_handle &handle)
 					{
@@ -516,12 +782,20 @@ class Vfs::Fs_file_system : public File_system
 							break;
 
 						case Packet_descriptor::READ:
-							handle.queued_read_packet = packet;
-							handle.queued_read_state  = Handle_state::Queued_state::ACK;
-							_post_signal_hook.arm(handle.context);
+							if (handle.read_acked(packet)) {
+								_post_signal_hook.arm(handle.context);
+								break;
+							}
+
+							/* discarded read-ahead packet */
+							release = true;
+							_post_signal_hook.arm(nullptr);
 							break;
 
 						case Packet_descriptor::WRITE:
+							if (handle.writes_in_flight)
+								handle.writes_in_flight--;
+
 							/*
 							 * Notify anyone who might have failed on
 							 * 'alloc_packet()' or 'submit_packet()'
@@ -542,15 +816,32 @@ class Vfs::Fs_file_system : public File_system
 						}
 					});
 				} catch (Handle_space::Unknown_id) {
-					Genode::warning("ack for unknown VFS handle"); }
 
-				if (packet.operation() == Packet_descriptor::WRITE) {
+					/* read-ahead packets may outlive their handle */
+					if (packet.operation() == Packet_descriptor::READ)
+						release = true;
+					else
+						Genode::warning("ack for unknown VFS handle");
+				}
+
+				if (release) {
 					Lock::Guard guard(_lock);
 					source.release_packet(packet);
 				}
 			}
 		}
 
+		/*
+		 * Number of READ and WRITE packets kept in flight per file handle
+		 *
+		 * Sequential reads are served from read-ahead packets submitted
+		 * in advance. Writes are acknowledged to the VFS user as soon as
+		 * the packet is submitted. A sync completes once all preceding
+		 * writes of the handle were acknowledged by the server.
+		 */
+		unsigned const _read_window;
+		unsigned const _write_window;
+
 		Genode::Io_signal_handler<Fs_file_system> _ack_handler {
 			_env.ep(), *this, &Fs_file_system::_handle_ack };
 
@@ -569,7 +860,11 @@ class Vfs::Fs_file_system : public File_system
 			_fs(env, _fs_packet_alloc,
 			    _label.string(), _root.string(),
 			    config.attribute_value("writeable", true),
-			    ::File_system::DEFAULT_TX_BUF_SIZE)
+			    config.attribute_value("buffer_size",
+			                           Genode::Number_of_bytes(::File_system::DEFAULT_TX_BUF_SIZE))),
+			_read_window(Genode::min(Genode::max(config.attribute_value("read_window", 4U), 1U),
+			                         (unsigned)Handle_state::MAX_READ_WINDOW)),
+			_write_window(Genode::max(config.attribute_value("write_window", 8U), 1U))
 		{
 			_fs.sigh_ack_avail(_ack_handler);
 		}
@@ -755,7 +1050,8 @@ class Vfs::Fs_file_system : public File_system
 
 				*out_handle = new (alloc)
 					Fs_vfs_file_handle(*this, alloc, vfs_mode, _handle_space,
-					                   file, _fs, _io_handler);
+					                   file, _fs, _io_handler,
+					                   _read_window, _write_window);
 			}
 			catch (::File_system::Lookup_failed)       { return OPEN_ERR_UNACCESSIBLE;  }
 			catch (::File_system::Permission_denied)   { return OPEN_ERR_NO_PERM;       }
@@ -847,6 +1143,9 @@ class Vfs::Fs_file_system : public File_system
 
 			Fs_vfs_handle *fs_handle = static_cast<Fs_vfs_handle *>(vfs_handle);
 
+			/* packets still in flight are released when acknowledged */
+			fs_handle->discard_reads();
+
 			_fs.close(fs_handle->file_handle());
 			destroy(fs_handle->alloc(), fs_handle);
 		}
@@ -876,6 +1175,34 @@ class Vfs::Fs_file_system : public File_system
 			return WRITE_OK;
 		}
 
+		/**
+		 * Gather the segments into one WRITE packet
+		 */
+		Write_result writev(Vfs_handle *vfs_handle, Io_vector const *iov,
+		                    unsigned iovcnt, file_size &out_count) override
+		{
+			Lock::Guard guard(_lock);
+
+			Fs_vfs_handle &handle = static_cast<Fs_vfs_handle &>(*vfs_handle);
+
+			file_size count = 0;
+			for (unsigned i = 0; i < iovcnt; i++)
+				count += iov[i].size;
+
+			out_count = _write(handle, count, handle.seek(),
+				[&] (char *dst, file_size num_bytes) {
+
+					file_size done = 0;
+					for (unsigned i = 0; i < iovcnt && done < num_bytes; i++) {
+						file_size const n = min(iov[i].size, num_bytes - done);
+						memcpy(dst + done, iov[i].base, n);
+						done += n;
+					}
+				});
+
+			return WRITE_OK;
+		}
+
 		bool queue_read(Vfs_handle *vfs_handle, file_size count) override
 		{
 			Lock::Guard guard(_lock);
@@ -897,6 +1224,34 @@ class Vfs::Fs_file_system : public File_system
 			return handle->complete_read(dst, count, out_count);
 		}
 
+		Read_result complete_readv(Vfs_handle *vfs_handle, Io_vector const *iov,
+		                           unsigned iovcnt, file_size &out_count) override
+		{
+			Lock::Guard guard(_lock);
+
+			out_count = 0;
+
+			Fs_vfs_handle *handle = static_cast<Fs_vfs_handle *>(vfs_handle);
+
+			return handle->complete_readv(iov, iovcnt, out_count);
+		}
+
+		Read_result complete_copy(Vfs_handle *from, Vfs_handle *to,
+		                          file_size count, file_size &out_count) override
+		{
+			/* writing to ourself would take the lock twice */
+			if (&to->fs() == this)
+				return READ_ERR_INVALID;
+
+			Lock::Guard guard(_lock);
+
+			out_count = 0;
+
+			Fs_vfs_handle *handle = static_cast<Fs_vfs_handle *>(from);
+
+			return handle->complete_copy(to, count, out_count);
+		}
+
 		bool read_ready(Vfs_handle *vfs_handle) override
 		{
 			Fs_vfs_handle *handle = static_cast<Fs_vfs_handle *>(vfs_handle);
@@ -933,9 +1288,41 @@ class Vfs::Fs_file_system : public File_system
 			return true;
 		}
 
+		bool notify_content_changed(Vfs_handle *vfs_handle) override
+		{
+			Lock::Guard guard(_lock);
+
+			Fs_vfs_handle *handle = static_cast<Fs_vfs_handle *>(vfs_handle);
+
+			::File_system::Session::Tx::Source &source = *_fs.tx();
+
+			if (!source.ready_to_submit()) return false;
+
+			using ::File_system::Packet_descriptor;
+
+			/*
+			 * The server registers the handle as listener. It does not
+			 * acknowledge the packet but sends a CONTENT_CHANGED packet
+			 * whenever the file was modified.
+			 */
+			Packet_descriptor packet(Packet_descriptor(),
+			                         handle->file_handle(),
+			                         Packet_descriptor::CONTENT_CHANGED,
+			                         0, 0);
+
+			source.submit_packet(packet);
+			return true;
+		}
+
 		Ftruncate_result ftruncate(Vfs_handle *vfs_handle, file_size len) override
 		{
-			Fs_vfs_handle const *handle = static_cast<Fs_vfs_handle *>(vfs_handle);
+			Fs_vfs_handle *handle = static_cast<Fs_vfs_handle *>(vfs_handle);
+
+			/* read-ahead data may cover the truncated range */
+			{
+				Lock::Guard guard(_lock);
+				handle->discard_reads();
+			}
 
 			try {
 				_fs.truncate(handle->file_handle(), len);
@@ -14,16 +14,24 @@
 #ifndef _INCLUDE__VFS__RAM_FILE_SYSTEM_H_
 #define _INCLUDE__VFS__RAM_FILE_SYSTEM_H_
 
-#include <ram_fs/chunk.h>
+#include <ram_fs/name_index.h>
 #include <vfs/file_system.h>
 #include <dataspace/client.h>
 #include <util/avl_tree.h>
+#include <util/list.h>
+#include <cpu/atomic.h>
 
 namespace Vfs_ram {
 
 	using namespace Genode;
 	using namespace Vfs;
 
+	class Reference_counter;
+	class Cow_chunk_base;
+
+	template <unsigned>           class Cow_chunk;
+	template <unsigned, typename> class Cow_chunk_index;
+
 	class Node;
 	class File;
 	class Symlink;
@@ -47,11 +55,257 @@ namespace Vfs_ram {
 		return start;
 	}
 
+	/**
+	 * Return exclusively owned version of 'chunk'
+	 *
+	 * A missing chunk is allocated, a shared chunk is copied.
+	 */
+	template <typename CHUNK>
+	static inline CHUNK *writeable_chunk(Allocator &alloc, CHUNK *chunk);
+
+	/**
+	 * Drop reference to 'chunk' and free it when unused
+	 */
+	template <typename CHUNK>
+	static inline void release_chunk(Allocator &alloc, CHUNK *chunk);
 }
 
 namespace Vfs { class Ram_file_system; }
 
 
+/**
+ * Counter of references to a shared object, starting at one
+ *
+ * Objects shared between snapshots and clones are referenced from
+ * different nodes, which may be locked independently.
+ */
+class Vfs_ram::Reference_counter : Genode::Noncopyable
+{
+	private:
+
+		int volatile _value = 1;
+
+		int _add(int inc)
+		{
+			for (;;) {
+				int const old = _value;
+				if (cmpxchg(&_value, old, old + inc))
+					return old + inc;
+			}
+		}
+
+	public:
+
+		void ref() { _add(1); }
+
+		/**
+		 * Drop reference
+		 *
+		 * \return true if the last reference was dropped
+		 */
+		bool unref() { return _add(-1) == 0; }
+
+		bool shared() const { return _value > 1; }
+};
+
+
+/**
+ * Common base of copy-on-write chunks and chunk indices
+ *
+ * A chunk is shared between all files that originate from the same
+ * snapshot. It is never modified while being shared. Writing to a file
+ * copies the shared chunks along the path to the written data, so only
+ * chunks that differ occupy memory of their own.
+ */
+class Vfs_ram::Cow_chunk_base : public Reference_counter
+{
+	protected:
+
+		Cow_chunk_base() { }
+
+		/*
+		 * A copy starts with a fresh reference counter
+		 */
+		Cow_chunk_base(Cow_chunk_base const &) : Reference_counter() { }
+};
+
+
+/**
+ * Chunk of bytes used as leaf in the hierarchy of chunk indices
+ */
+template <unsigned CHUNK_SIZE>
+class Vfs_ram::Cow_chunk : public Cow_chunk_base
+{
+	private:
+
+		char _data[CHUNK_SIZE];
+
+	public:
+
+		enum { SIZE = CHUNK_SIZE };
+
+		Cow_chunk() { memset(_data, 0, SIZE); }
+
+		Cow_chunk(Cow_chunk const &other) : Cow_chunk_base(other) {
+			memcpy(_data, other._data, SIZE); }
+
+		/*
+		 * The offsets of the following functions are relative to the
+		 * chunk.
+		 */
+
+		void read(char *dst, size_t len, file_size offset) const {
+			memcpy(dst, &_data[offset], len); }
+
+		void write(Allocator &, char const *src, size_t len, file_size offset) {
+			memcpy(&_data[offset], src, len); }
+
+		void truncate(Allocator &, file_size size) {
+			memset(&_data[size], 0, SIZE - size); }
+
+		void release_entries(Allocator &) { }
+};
+
+
+template <unsigned NUM_ENTRIES, typename ENTRY_TYPE>
+class Vfs_ram::Cow_chunk_index : public Cow_chunk_base
+{
+	public:
+
+		typedef ENTRY_TYPE Entry;
+
+		enum { ENTRY_SIZE = ENTRY_TYPE::SIZE,
+		       SIZE       = ENTRY_SIZE*NUM_ENTRIES };
+
+	private:
+
+		Entry *_entries[NUM_ENTRIES];
+
+		/**
+		 * Apply 'fn' to the entries covering the given range
+		 *
+		 * The functor is called with the index of the entry and the
+		 * offset relative to the entry.
+		 */
+		template <typename DATA, typename FN>
+		static void _for_each_entry(DATA *data, size_t len, file_size offset,
+		                            FN const &fn)
+		{
+			while (len > 0) {
+				unsigned  const index    = offset / ENTRY_SIZE;
+				file_size const local    = offset - (file_size)index*ENTRY_SIZE;
+				size_t    const curr_len = min(len, (size_t)(ENTRY_SIZE - local));
+
+				fn(index, data, curr_len, local);
+
+				len    -= curr_len;
+				data   += curr_len;
+				offset += curr_len;
+			}
+		}
+
+	public:
+
+		Cow_chunk_index()
+		{
+			for (unsigned i = 0; i < NUM_ENTRIES; i++)
+				_entries[i] = nullptr;
+		}
+
+		/**
+		 * Construct copy that shares all sub chunks with 'other'
+		 */
+		Cow_chunk_index(Cow_chunk_index const &other) : Cow_chunk_base(other)
+		{
+			for (unsigned i = 0; i < NUM_ENTRIES; i++) {
+				_entries[i] = other._entries[i];
+				if (_entries[i])
+					_entries[i]->ref();
+			}
+		}
+
+		void read(char *dst, size_t len, file_size offset) const
+		{
+			_for_each_entry(dst, len, offset,
+				[&] (unsigned i, char *dst, size_t len, file_size offset) {
+					if (_entries[i])
+						_entries[i]->read(dst, len, offset);
+					else
+						memset(dst, 0, len);
+				});
+		}
+
+		void write(Allocator &alloc, char const *src, size_t len, file_size offset)
+		{
+			_for_each_entry(src, len, offset,
+				[&] (unsigned i, char const *src, size_t len, file_size offset) {
+					_entries[i] = writeable_chunk(alloc, _entries[i]);
+					_entries[i]->write(alloc, src, len, offset);
+				});
+		}
+
+		/**
+		 * Discard content beyond 'size' bytes
+		 */
+		void truncate(Allocator &alloc, file_size size)
+		{
+			unsigned const index = size / ENTRY_SIZE;
+
+			for (unsigned i = index + 1; i < NUM_ENTRIES; i++) {
+				release_chunk(alloc, _entries[i]);
+				_entries[i] = nullptr;
+			}
+
+			if (index >= NUM_ENTRIES || !_entries[index])
+				return;
+
+			file_size const local = size - (file_size)index*ENTRY_SIZE;
+			if (!local) {
+				release_chunk(alloc, _entries[index]);
+				_entries[index] = nullptr;
+				return;
+			}
+
+			_entries[index] = writeable_chunk(alloc, _entries[index]);
+			_entries[index]->truncate(alloc, local);
+		}
+
+		void release_entries(Allocator &alloc)
+		{
+			for (unsigned i = 0; i < NUM_ENTRIES; i++) {
+				release_chunk(alloc, _entries[i]);
+				_entries[i] = nullptr;
+			}
+		}
+};
+
+
+template <typename CHUNK>
+static inline CHUNK *Vfs_ram::writeable_chunk(Allocator &alloc, CHUNK *chunk)
+{
+	if (!chunk)
+		return new (alloc) CHUNK();
+
+	if (!chunk->shared())
+		return chunk;
+
+	CHUNK *copy = new (alloc) CHUNK(*chunk);
+	release_chunk(alloc, chunk);
+	return copy;
+}
+
+
+template <typename CHUNK>
+static inline void Vfs_ram::release_chunk(Allocator &alloc, CHUNK *chunk)
+{
+	if (!chunk || !chunk->unref())
+		return;
+
+	chunk->release_entries(alloc);
+	destroy(alloc, chunk);
+}
+
+
 class Vfs_ram::Node : public Genode::Avl_node<Node>, public Genode::Lock
 {
 	private:
@@ -126,40 +380,7 @@ class Vfs_ram::Node : public Genode::Avl_node<Node>, public Genode::Lock
 		 ** Avl node interface **
 		 ************************/
 
-		bool higher(Node *c) { return (strcmp(c->_name, _name) > 0); }
-
-		/**
-		 * Find index N by walking down the tree N times,
-		 * not the most efficient way to do this.
-		 */
-		Node *index(file_offset &i)
-		{
-			if (i-- == 0)
-				return this;
-
-			Node *n;
-
-			n = child(LEFT);
-			if (n)
-				n = n->index(i);
-
-			if (n) return n;
-
-			n = child(RIGHT);
-			if (n)
-				n = n->index(i);
-
-			return n;
-		}
-
-		Node *sibling(const char *name)
-		{
-			if (strcmp(name, _name) == 0) return this;
-
-			Node *c =
-				Avl_node<Node>::child(strcmp(name, _name) > 0);
-			return c ? c->sibling(name) : nullptr;
-		}
+		bool higher(Node *c) { return ::File_system::Name_index<Node>::ordered(this, c); }
 
 		struct Guard
 		{
@@ -176,49 +397,48 @@ class Vfs_ram::File : public Vfs_ram::Node
 {
 	private:
 
-		typedef ::File_system::Chunk<4096>      Chunk_level_3;
-		typedef ::File_system::Chunk_index<128, Chunk_level_3> Chunk_level_2;
-		typedef ::File_system::Chunk_index<64,  Chunk_level_2> Chunk_level_1;
-		typedef ::File_system::Chunk_index<64,  Chunk_level_1> Chunk_level_0;
+		typedef Cow_chunk<4096>                      Chunk_level_3;
+		typedef Cow_chunk_index<128, Chunk_level_3> Chunk_level_2;
+		typedef Cow_chunk_index<64,  Chunk_level_2> Chunk_level_1;
+		typedef Cow_chunk_index<64,  Chunk_level_1> Chunk_level_0;
 
-		Chunk_level_0 _chunk;
-		file_size     _length = 0;
+		Allocator     &_alloc;
+		Chunk_level_0 *_chunk  = nullptr; /* nullptr if file has no content */
+		file_size      _length = 0;
 
 	public:
 
 		File(char const *name, Allocator &alloc)
-		: Node(name), _chunk(alloc, 0) { }
+		: Node(name), _alloc(alloc) { }
 
-		size_t read(char *dst, size_t len, file_size seek_offset) override
+		/**
+		 * Construct file that shares the content of 'origin'
+		 */
+		File(char const *name, Allocator &alloc, File &origin)
+		:
+			Node(name), _alloc(alloc), _chunk(origin._chunk),
+			_length(origin._length)
 		{
-			file_size const chunk_used_size = _chunk.used_size();
+			if (_chunk)
+				_chunk->ref();
+		}
 
+		~File() { release_chunk(_alloc, _chunk); }
+
+		size_t read(char *dst, size_t len, file_size seek_offset) override
+		{
 			if (seek_offset >= _length)
 				return 0;
 
-			/*
-			 * Constrain read transaction to available chunk data
-			 *
-			 * Note that 'chunk_used_size' may be lower than '_length'
-			 * because 'Chunk' may have truncated tailing zeros.
-			 */
+			/* constrain read transaction to the file length */
 			if (seek_offset + len >= _length)
 				len = _length - seek_offset;
 
-			file_size read_len = len;
-
-			if (seek_offset + read_len > chunk_used_size) {
-				if (chunk_used_size >= seek_offset)
-					read_len = chunk_used_size - seek_offset;
-				else
-					read_len = 0;
-			}
-
-			_chunk.read(dst, read_len, seek_offset);
-
-			/* add zero padding if needed */
-			if (read_len < len)
-				memset(dst + read_len, 0, len - read_len);
+			/* 'Cow_chunk_index' fills unpopulated ranges with zeros */
+			if (_chunk)
+				_chunk->read(dst, len, seek_offset);
+			else
+				memset(dst, 0, len);
 
 			return len;
 		}
@@ -235,18 +455,23 @@ class Vfs_ram::File : public Vfs_ram::Node
 		size_t write(char const *src, size_t len, file_size seek_offset) override
 		{
 			if (seek_offset == (file_size)(~0))
-				seek_offset = _chunk.used_size();
+				seek_offset = _length;
+
+			if (seek_offset >= Chunk_level_0::SIZE)
+				return 0;
 
 			if (seek_offset + len >= Chunk_level_0::SIZE)
-				len = Chunk_level_0::SIZE - (seek_offset + len);
+				len = Chunk_level_0::SIZE - seek_offset;
 
-			try { _chunk.write(src, len, (size_t)seek_offset); }
+			try {
+				_chunk = writeable_chunk(_alloc, _chunk);
+				_chunk->write(_alloc, src, len, seek_offset);
+			}
 			catch (Out_of_memory) { return 0; }
 
 			/*
-			 * Keep track of file length. We cannot use 'chunk.used_size()'
-			 * as file length because trailing zeros may by represented
-			 * by zero chunks, which do not contribute to 'used_size()'.
+			 * Keep track of file length. Trailing zeros may be
+			 * represented by unpopulated chunks.
 			 */
 			_length = max(_length, seek_offset + len);
 
@@ -257,8 +482,15 @@ class Vfs_ram::File : public Vfs_ram::Node
 
 		void truncate(file_size size) override
 		{
-			if (size < _chunk.used_size())
-				_chunk.truncate(size);
+			if (_chunk && size == 0) {
+				release_chunk(_alloc, _chunk);
+				_chunk = nullptr;
+			}
+
+			if (_chunk && size < _length) {
+				_chunk = writeable_chunk(_alloc, _chunk);
+				_chunk->truncate(_alloc, size);
+			}
 
 			_length = size;
 		}
@@ -276,6 +508,9 @@ class Vfs_ram::Symlink : public Vfs_ram::Node
 
 		Symlink(char const *name) : Node(name) { }
 
+		Symlink(char const *name, Symlink const &origin) : Node(name) {
+			set(origin._target, origin._len); }
+
 		file_size length() { return _len; }
 
 		void set(char const *target, size_t len)
@@ -319,27 +554,176 @@ class Vfs_ram::Symlink : public Vfs_ram::Node
 };
 
 
+/**
+ * Directory node
+ *
+ * A directory may be a lazy clone of another directory, its origin. The
+ * origin is part of a snapshot and thereby never modified. The entries of
+ * the clone are created from the origin not before they are accessed for
+ * the first time. Cloning a directory tree is thereby independent of the
+ * size of the tree.
+ */
 class Vfs_ram::Directory : public Vfs_ram::Node
 {
 	private:
 
-		Avl_tree<Node>  _entries;
-		file_size       _count = 0;
+		Allocator                      &_alloc;
+		::File_system::Name_index<Node> _entries;
+
+		Directory        *_origin = nullptr;
+		Reference_counter _refs;
+
+		/**
+		 * Create clone of an entry of a snapshot
+		 */
+		static Node *_clone(Allocator &alloc, Node &node)
+		{
+			if (File *file = dynamic_cast<File *>(&node))
+				return new (alloc) File(file->name(), alloc, *file);
+
+			if (Symlink *link = dynamic_cast<Symlink *>(&node))
+				return new (alloc) Symlink(link->name(), *link);
+
+			Directory &dir = dynamic_cast<Directory &>(node);
+			return new (alloc) Directory(dir.name(), alloc, &dir);
+		}
+
+		/**
+		 * Populate entries from the origin
+		 *
+		 * Entries created while the origin could not be cloned take
+		 * precedence over the entries of the origin.
+		 *
+		 * \return false if memory was exhausted, in which case the
+		 *         directory stays unpopulated
+		 */
+		bool _populate()
+		{
+			if (!_origin)
+				return true;
+
+			::File_system::Name_index<Node> fresh;
+
+			bool complete = true;
+			{
+				Directory &origin = *_origin;
+				Node::Guard guard(&origin);
+
+				if (!origin._populate())
+					return false;
+
+				try {
+					for (unsigned long i = 0; i < origin._entries.count(); i++) {
+						Node &node = *origin._entries.entry(i);
+						if (!_entries.lookup(node.name()))
+							fresh.insert(_clone(_alloc, node));
+					}
+				} catch (Out_of_memory) { complete = false; }
+			}
+
+			while (Node *node = fresh.any()) {
+				fresh.remove(node);
+				if (complete)
+					_entries.insert(node);
+				else if (Directory *dir = dynamic_cast<Directory *>(node))
+					unref(_alloc, dir);
+				else
+					destroy(_alloc, node);
+			}
+
+			if (!complete)
+				return false;
+
+			unref(_alloc, _origin);
+			_origin = nullptr;
+			return true;
+		}
 
 	public:
 
-		Directory(char const *name)
-		: Node(name) { }
+		/**
+		 * Constructor
+		 *
+		 * \param origin  directory to clone lazily, or nullptr
+		 */
+		Directory(char const *name, Allocator &alloc,
+		          Directory *origin = nullptr)
+		:
+			Node(name), _alloc(alloc), _origin(origin)
+		{
+			if (_origin)
+				_origin->_refs.ref();
+		}
+
+		/**
+		 * Drop reference to directory and free it when unused
+		 *
+		 * A directory is referenced by its parent and by each clone that
+		 * is not yet populated.
+		 */
+		static void unref(Allocator &alloc, Directory *dir)
+		{
+			if (!dir->_refs.unref())
+				return;
+
+			dir->empty(alloc);
+			destroy(alloc, dir);
+		}
+
+		/**
+		 * Create snapshot of directory tree
+		 *
+		 * Files of the snapshot share their content with the originals.
+		 * Subtrees not yet populated from an origin share the origin.
+		 *
+		 * \throw Out_of_memory
+		 */
+		static Directory *snapshot(Allocator &alloc, Directory &dir,
+		                           char const *name)
+		{
+			Node::Guard guard(&dir);
+
+			if (dir._origin && !dir._entries.count())
+				return new (alloc) Directory(name, alloc, dir._origin);
+
+			if (!dir._populate())
+				throw Out_of_memory();
+
+			Directory *copy = new (alloc) Directory(name, alloc);
+			try {
+				for (unsigned long i = 0; i < dir._entries.count(); i++) {
+					Node &node = *dir._entries.entry(i);
+
+					if (Directory *sub = dynamic_cast<Directory *>(&node)) {
+						copy->_entries.insert(snapshot(alloc, *sub, sub->name()));
+						continue;
+					}
+
+					Node::Guard node_guard(&node);
+					copy->_entries.insert(_clone(alloc, node));
+				}
+			} catch (...) {
+				unref(alloc, copy);
+				throw;
+			}
+			return copy;
+		}
 
 		void empty(Allocator &alloc)
 		{
-			while (Node *node = _entries.first()) {
+			if (_origin) {
+				unref(alloc, _origin);
+				_origin = nullptr;
+			}
+
+			while (Node *node = _entries.any()) {
 				_entries.remove(node);
 				if (File *file = dynamic_cast<File*>(node)) {
 					if (file->close_but_keep())
 						continue;
 				} else if (Directory *dir = dynamic_cast<Directory*>(node)) {
-					dir->empty(alloc);
+					unref(alloc, dir);
+					continue;
 				}
 				destroy(alloc, node);
 			}
@@ -347,24 +731,24 @@ class Vfs_ram::Directory : public Vfs_ram::Node
 
 		void adopt(Node *node)
 		{
+			_populate();
 			_entries.insert(node);
-			++_count;
 		}
 
 		Node *child(char const *name)
 		{
-			Node *node = _entries.first();
-			return node ? node->sibling(name) : nullptr;
+			_populate();
+			return _entries.lookup(name);
 		}
 
-		void release(Node *node)
+		void release(Node *node) { _entries.remove(node); }
+
+		file_size length() override
 		{
-			_entries.remove(node);
-			--_count;
+			_populate();
+			return _entries.count();
 		}
 
-		file_size length() override { return _count; }
-
 		Vfs::File_io_service::Read_result complete_read(char *dst,
 		                                                file_size count,
 		                                                file_size seek_offset,
@@ -375,14 +759,15 @@ class Vfs_ram::Directory : public Vfs_ram::Node
 			if (count < sizeof(Dirent))
 				return Vfs::File_io_service::READ_ERR_INVALID;
 
+			_populate();
+
 			file_offset index = seek_offset / sizeof(Dirent);
 
 			Dirent *dirent = (Dirent*)dst;
 			*dirent = Dirent();
 			out_count = sizeof(Dirent);
 
-			Node *node = _entries.first();
-			if (node) node = node->index(index);
+			Node *node = _entries.entry(index);
 			if (!node) {
 				dirent->type = Directory_service::DIRENT_TYPE_END;
 				return Vfs::File_io_service::READ_OK;
@@ -432,9 +817,45 @@ class Vfs::Ram_file_system : public Vfs::File_system
 			}
 		};
 
+		typedef Genode::String<Vfs_ram::MAX_NAME_LEN> Name;
+		typedef Genode::String<Vfs::MAX_PATH_LEN>     Path;
+		typedef Genode::String<32>                    Version;
+
+		/**
+		 * Snapshot as declared by a '<snapshot>' node of the configuration
+		 */
+		struct Snapshot : Genode::List<Snapshot>::Element
+		{
+			Name const          name;
+			Version const       version;
+			Vfs_ram::Directory &root;
+			bool                declared = true;
+
+			Snapshot(Name const &name, Version const &version,
+			         Vfs_ram::Directory &root)
+			: name(name), version(version), root(root) { }
+		};
+
+		/**
+		 * Clone as declared by a '<clone>' node of the configuration
+		 */
+		struct Clone : Genode::List<Clone>::Element
+		{
+			Path const    path;
+			Name const    snapshot;
+			Version const version;
+			bool          declared = true;
+
+			Clone(Path const &path, Name const &snapshot, Version const &version)
+			: path(path), snapshot(snapshot), version(version) { }
+		};
+
 		Genode::Env        &_env;
 		Genode::Allocator  &_alloc;
-		Vfs_ram::Directory  _root = { "" };
+		Vfs_ram::Directory  _root = { "", _alloc };
+
+		Genode::List<Snapshot> _snapshots;
+		Genode::List<Clone>    _clones;
 
 		Vfs_ram::Node *lookup(char const *path, bool return_parent = false)
 		{
@@ -488,21 +909,165 @@ class Vfs::Ram_file_system : public Vfs::File_system
 				if (file->close_but_keep())
 					return;
 			} else if (Directory *dir = dynamic_cast<Directory*>(node)) {
-				dir->empty(_alloc);
+				Directory::unref(_alloc, dir);
+				return;
 			}
 
 			destroy(_alloc, node);
 		}
 
+		Snapshot *_lookup_snapshot(Name const &name)
+		{
+			for (Snapshot *s = _snapshots.first(); s; s = s->next())
+				if (s->name == name)
+					return s;
+			return nullptr;
+		}
+
+		Clone *_lookup_clone(Path const &path)
+		{
+			for (Clone *c = _clones.first(); c; c = c->next())
+				if (c->path == path)
+					return c;
+			return nullptr;
+		}
+
+		void _destroy_snapshot(Snapshot *snapshot)
+		{
+			_snapshots.remove(snapshot);
+			Vfs_ram::Directory::unref(_alloc, &snapshot->root);
+			destroy(_alloc, snapshot);
+		}
+
+		/**
+		 * Replace node at 'path' by a lazy clone of 'origin'
+		 */
+		bool _clone(char const *path, Vfs_ram::Directory &origin)
+		{
+			using namespace Vfs_ram;
+
+			Directory *parent = lookup_parent(path);
+			if (!parent) return false;
+
+			char const *name = basename(path);
+			if (!*name || strlen(name) >= MAX_NAME_LEN)
+				return false;
+
+			Directory *dir;
+			try { dir = new (_alloc) Directory(name, _alloc, &origin); }
+			catch (Out_of_memory) { return false; }
+
+			Node::Guard guard(parent);
+
+			if (Node *node = parent->child(name)) {
+				node->lock();
+				parent->release(node);
+				remove(node);
+			}
+			parent->adopt(dir);
+			return true;
+		}
+
+		void _apply_snapshot(Genode::Xml_node node)
+		{
+			using namespace Vfs_ram;
+
+			Name    const name    = node.attribute_value("name",    Name());
+			Path    const from    = node.attribute_value("from",    Path());
+			Version const version = node.attribute_value("version", Version());
+
+			Snapshot *snapshot = _lookup_snapshot(name);
+			if (snapshot && snapshot->version == version) {
+				snapshot->declared = true;
+				return;
+			}
+
+			Directory *dir = dynamic_cast<Directory *>(lookup(from.string()));
+			if (!dir) {
+				Genode::warning("cannot snapshot ", from, ", no such directory");
+				return;
+			}
+
+			Directory *root;
+			try { root = Directory::snapshot(_alloc, *dir, name.string()); }
+			catch (Out_of_memory) {
+				Genode::warning("out of memory while taking snapshot ", name);
+				return;
+			}
+
+			if (snapshot)
+				_destroy_snapshot(snapshot);
+
+			_snapshots.insert(new (_alloc) Snapshot(name, version, *root));
+		}
+
+		void _apply_clone(Genode::Xml_node node)
+		{
+			Path    const path     = node.attribute_value("path",     Path());
+			Name    const name     = node.attribute_value("snapshot", Name());
+			Version const version  = node.attribute_value("version",  Version());
+
+			Clone *clone = _lookup_clone(path);
+			if (clone && clone->snapshot == name && clone->version == version) {
+				clone->declared = true;
+				return;
+			}
+
+			Snapshot *snapshot = _lookup_snapshot(name);
+			if (!snapshot) {
+				Genode::warning("cannot clone ", path, ", no snapshot ", name);
+				return;
+			}
+
+			if (!_clone(path.string(), snapshot->root)) {
+				Genode::warning("cannot clone ", path);
+				return;
+			}
+
+			if (clone) {
+				_clones.remove(clone);
+				destroy(_alloc, clone);
+			}
+
+			_clones.insert(new (_alloc) Clone(path, name, version));
+		}
+
 	public:
 
+		/**
+		 * Constructor
+		 *
+		 * The configuration may declare snapshots of directories and
+		 * clones of those snapshots:
+		 *
+		 * ! <ram>
+		 * !   <snapshot name="base" from="/template"/>
+		 * !   <clone snapshot="base" path="/sandbox" version="1"/>
+		 * ! </ram>
+		 *
+		 * A snapshot is taken when it appears in the configuration or its
+		 * 'version' attribute changes. A clone replaces the node at
+		 * 'path' under the same conditions. Hence, changing the version of
+		 * a clone resets the directory to the content of the snapshot.
+		 */
 		Ram_file_system(Genode::Env       &env,
 		                Genode::Allocator &alloc,
-		                Genode::Xml_node,
+		                Genode::Xml_node   config,
 		                Io_response_handler &)
-		: _env(env), _alloc(alloc) { }
+		: _env(env), _alloc(alloc) { apply_config(config); }
 
-		~Ram_file_system() { _root.empty(_alloc); }
+		~Ram_file_system()
+		{
+			while (Clone *clone = _clones.first()) {
+				_clones.remove(clone);
+				destroy(_alloc, clone);
+			}
+
+			while (Snapshot *snapshot = _snapshots.first())
+				_destroy_snapshot(snapshot);
+
+			_root.empty(_alloc);
+		}
 
 
 		/*********************************
@@ -592,7 +1157,7 @@ class Vfs::Ram_file_system : public Vfs::File_system
 					return OPENDIR_ERR_NODE_ALREADY_EXISTS;
 
 				try {
-					dir = new (_alloc) Directory(name);
+					dir = new (_alloc) Directory(name, _alloc);
 				} catch (Out_of_memory) { return OPENDIR_ERR_NO_SPACE; }
 
 				parent->adopt(dir);
@@ -860,6 +1425,39 @@ class Vfs::Ram_file_system : public Vfs::File_system
 		 ** File_system interface **
 		 ***************************/
 
+		void apply_config(Genode::Xml_node const &config) override
+		{
+			for (Snapshot *s = _snapshots.first(); s; s = s->next())
+				s->declared = false;
+
+			for (Clone *c = _clones.first(); c; c = c->next())
+				c->declared = false;
+
+			config.for_each_sub_node("snapshot", [&] (Genode::Xml_node node) {
+				_apply_snapshot(node); });
+
+			config.for_each_sub_node("clone", [&] (Genode::Xml_node node) {
+				_apply_clone(node); });
+
+			/*
+			 * Clones of dropped snapshots keep their content. So do
+			 * directories of dropped clones.
+			 */
+			for (Snapshot *s = _snapshots.first(), *next; s; s = next) {
+				next = s->next();
+				if (!s->declared)
+					_destroy_snapshot(s);
+			}
+
+			for (Clone *c = _clones.first(), *next; c; c = next) {
+				next = c->next();
+				if (!c->declared) {
+					_clones.remove(c);
+					destroy(_alloc, c);
+				}
+			}
+		}
+
 		static char const *name()   { return "ram"; }
 		char const *type() override { return "ram"; }
 };
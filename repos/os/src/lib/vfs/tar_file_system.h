@@ -18,6 +18,8 @@
 #include <vfs/file_system.h>
 #include <vfs/vfs_handle.h>
 #include <base/attached_rom_dataspace.h>
+#include <base/registry.h>
+#include <tar/member_dataspace.h>
 
 namespace Vfs { class Tar_file_system; }
 
@@ -34,6 +36,30 @@ class Vfs::Tar_file_system : public File_system
 	char                          *_tar_base = _tar_ds.local_addr<char>();
 	file_size               const  _tar_size = _tar_ds.size();
 
+	Tar::Index _index { _alloc, _tar_base, (Genode::size_t)_tar_size };
+
+	/*
+	 * RM session for mapping page-aligned members directly, constructed
+	 * on the first attempt
+	 */
+	Genode::Constructible<Genode::Rm_connection> _rm { };
+	bool                                         _rm_denied = false;
+
+	typedef Genode::Registered<Tar::Member_dataspace> Member_dataspace;
+
+	Genode::Registry<Member_dataspace> _dataspaces { };
+
+	Genode::Rm_session *_rm_session()
+	{
+		if (!_rm.constructed() && !_rm_denied) {
+			try { _rm.construct(_env); }
+			catch (...) { _rm_denied = true; }
+		}
+		return _rm.constructed() ? &*_rm : nullptr;
+	}
+
+	typedef Tar::Index::Node Node;
+
 	class Record
 	{
 		private:
@@ -86,19 +112,17 @@ class Vfs::Tar_file_system : public File_system
 			void *data() const { return (char *)this + BLOCK_LEN; }
 	};
 
-	class Node;
-
 	class Tar_vfs_handle : public Vfs_handle
 	{
 		protected:
 
-			Node const *_node;
+			Record const * const _record;
 
 		public:
 
 			Tar_vfs_handle(File_system &fs, Allocator &alloc, int status_flags,
-			               Node const *node)
-			: Vfs_handle(fs, fs, alloc, status_flags), _node(node)
+			               Record const *record)
+			: Vfs_handle(fs, fs, alloc, status_flags), _record(record)
 			{ }
 
 			virtual Read_result read(char *dst, file_size count,
@@ -113,14 +137,14 @@ class Vfs::Tar_file_system : public File_system
 		Read_result read(char *dst, file_size count,
 		                 file_size &out_count) override
 		{
-			file_size const record_size = _node->record->size();
+			file_size const record_size = _record->size();
 
 			file_size const record_bytes_left = record_size >= seek()
 			                                  ? record_size  - seek() : 0;
 
 			count = min(record_bytes_left, count);
 
-			char const *data = (char *)_node->record->data() + seek();
+			char const *data = (char *)_record->data() + seek();
 
 			memcpy(dst, data, count);
 
@@ -131,7 +155,14 @@ class Vfs::Tar_file_system : public File_system
 
 	struct Tar_vfs_dir_handle : Tar_vfs_handle
 	{
-		using Tar_vfs_handle::Tar_vfs_handle;
+		Absolute_path const _path;
+
+		Tar::Index::Cursor _cursor { };
+
+		Tar_vfs_dir_handle(File_system &fs, Allocator &alloc, int status_flags,
+		                   char const *path)
+		: Tar_vfs_handle(fs, alloc, status_flags, nullptr), _path(path)
+		{ }
 
 		Read_result read(char *dst, file_size count,
 		                 file_size &out_count) override
@@ -146,20 +177,20 @@ class Vfs::Tar_file_system : public File_system
 
 			file_offset index = seek() / sizeof(Dirent);
 
-			Node const *node = _node->lookup_child(index);
+			Tar_file_system &tar_fs = static_cast<Tar_file_system&>(fs());
+
+			Node node = tar_fs._index.child(_path.base(), index, _cursor,
+			                                dirent->name, sizeof(dirent->name));
 
-			if (!node)
+			if (!node.valid())
 				return READ_OK;
 
-			dirent->fileno = (Genode::addr_t)node;
+			dirent->fileno = node.id;
 
-			Record const *record = node->record;
+			Record const *record = (Record const *)node.header;
 
-			while (record && (record->type() == Record::TYPE_HARDLINK)) {
-				Tar_file_system &tar_fs = static_cast<Tar_file_system&>(fs());
-				Node const *target = tar_fs.dereference(record->linked_name());
-				record = target ? target->record : 0;
-			}
+			if (record && (record->type() == Record::TYPE_HARDLINK))
+				record = (Record const *)tar_fs.dereference(record).header;
 
 			if (record) {
 				switch (record->type()) {
@@ -172,15 +203,13 @@ class Vfs::Tar_file_system : public File_system
 
 				default:
 					Genode::error("unhandled record type ", record->type(), " "
-					              "for ", node->name);
+					              "for ", Genode::Cstring(dirent->name));
 				}
 			} else {
 				/* If no record exists, assume it is a directory */
 				dirent->type = DIRENT_TYPE_DIRECTORY;
 			}
 
-			strncpy(dirent->name, node->name, sizeof(dirent->name));
-
 			out_count = sizeof(Dirent);
 
 			return READ_OK;
@@ -194,11 +223,9 @@ class Vfs::Tar_file_system : public File_system
 		Read_result read(char *buf, file_size buf_size,
 		                 file_size &out_count) override
 		{
-			Record const *record = _node->record;
-
 			file_size const count = min(buf_size, 100ULL);
 
-			memcpy(buf, record->linked_name(), count);
+			memcpy(buf, _record->linked_name(), count);
 
 			out_count = count;
 
@@ -206,208 +233,16 @@ class Vfs::Tar_file_system : public File_system
 		}
 	};
 
-	struct Scanner_policy_path_element
-	{
-		static bool identifier_char(char c, unsigned /* i */)
-		{
-			return (c != '/') && (c != 0);
-		}
-	};
-
-
-	typedef Genode::Token<Scanner_policy_path_element> Path_element_token;
-
-
-	struct Node : List<Node>, List<Node>::Element
-	{
-		char const *name;
-		Record const *record;
-
-		Node(char const *name, Record const *record) : name(name), record(record) { }
-
-		Node *lookup(char const *name)
-		{
-			Absolute_path lookup_path(name);
-
-			Node *parent_node = this;
-			Node *child_node;
-
-			Path_element_token t(lookup_path.base());
-
-			while (t) {
-
-				if (t.type() != Path_element_token::IDENT) {
-						t = t.next();
-						continue;
-				}
-
-				char path_element[MAX_PATH_LEN];
-
-				t.string(path_element, sizeof(path_element));
-
-				for (child_node = parent_node->first(); child_node; child_node = child_node->next()) {
-					if (strcmp(child_node->name, path_element) == 0) {
-						parent_node = child_node;
-						break;
-					}
-				}
-
-				if (!child_node)
-					return 0;
-
-				t = t.next();
-			}
-
-			return parent_node;
-		}
-
-
-		Node const *lookup_child(int index) const
-		{
-			for (Node const *child_node = first(); child_node; child_node = child_node->next(), index--) {
-				if (index == 0)
-					return child_node;
-			}
-
-			return 0;
-		}
-
-
-		file_size num_dirent()
-		{
-			file_size count = 0;
-			for (Node *child_node = first(); child_node; child_node = child_node->next(), count++) ;
-			return count;
-		}
-
-	} _root_node;
-
-
-	/*
-	 *  Create a Node for a tar record and insert it into the node list
-	 */
-	class Add_node_action
-	{
-		private:
-
-			Genode::Allocator &_alloc;
-
-			Node &_root_node;
-
-		public:
-
-			Add_node_action(Genode::Allocator &alloc,
-			                Node              &root_node)
-			: _alloc(alloc), _root_node(root_node) { }
-
-			void operator()(Record const *record)
-			{
-				Absolute_path current_path(record->name());
-
-				char path_element[MAX_PATH_LEN];
-
-				Path_element_token t(current_path.base());
-
-				Node *parent_node = &_root_node;
-				Node *child_node;
-
-				while(t) {
-
-					if (t.type() != Path_element_token::IDENT) {
-							t = t.next();
-							continue;
-					}
-
-					Absolute_path remaining_path(t.start());
-
-					t.string(path_element, sizeof(path_element));
-
-					for (child_node = parent_node->first(); child_node; child_node = child_node->next()) {
-						if (strcmp(child_node->name, path_element) == 0)
-							break;
-					}
-
-					if (child_node) {
-
-						if (remaining_path.has_single_element()) {
-							/* Found a node for the record to be inserted.
-							 * This is usually a directory node without
-							 * record. */
-							child_node->record = record;
-						}
-					} else {
-						if (remaining_path.has_single_element()) {
-
-							/*
-							 * TODO: find 'path_element' in 'record->name'
-							 * and use the location in the record as name
-							 * pointer to save some memory
-							 */
-							Genode::size_t name_size = strlen(path_element) + 1;
-							char *name = (char*)_alloc.alloc(name_size);
-							strncpy(name, path_element, name_size);
-							child_node = new (_alloc) Node(name, record);
-						} else {
-
-							/* create a directory node without record */
-							Genode::size_t name_size = strlen(path_element) + 1;
-							char *name = (char*)_alloc.alloc(name_size);
-							strncpy(name, path_element, name_size);
-							child_node = new (_alloc) Node(name, 0);
-						}
-						parent_node->insert(child_node);
-					}
-
-					parent_node = child_node;
-					t = t.next();
-				}
-			}
-	};
-
-
-	template <typename Tar_record_action>
-	void _for_each_tar_record_do(Tar_record_action tar_record_action)
-	{
-		/* measure size of archive in blocks */
-		unsigned block_id = 0, block_cnt = _tar_size/Record::BLOCK_LEN;
-
-		/* scan metablocks of archive */
-		while (block_id < block_cnt) {
-
-			Record *record = (Record *)(_tar_base + block_id*Record::BLOCK_LEN);
-
-			tar_record_action(record);
-
-			file_size size = record->size();
-
-			/* some datablocks */       /* one metablock */
-			block_id = block_id + (size / Record::BLOCK_LEN) + 1;
-
-			/* round up */
-			if (size % Record::BLOCK_LEN != 0) block_id++;
-
-			/* check for end of tar archive */
-			if (block_id*Record::BLOCK_LEN >= _tar_size)
-				break;
-
-			/* lookout for empty eof-blocks */
-			if (*(_tar_base + (block_id*Record::BLOCK_LEN)) == 0x00)
-				if (*(_tar_base + (block_id*Record::BLOCK_LEN + 1)) == 0x00)
-					break;
-		}
-	}
-
-
 	struct Num_dirent_cache
 	{
 		Lock             lock;
-		Node            &root_node;
+		Tar::Index      &index;
 		bool             valid;              /* true after first lookup */
 		char             key[256];           /* key used for lookup */
 		file_size        cached_num_dirent;  /* cached value */
 
-		Num_dirent_cache(Node &root_node)
-		: root_node(root_node), valid(false), cached_num_dirent(0) { }
+		Num_dirent_cache(Tar::Index &index)
+		: index(index), valid(false), cached_num_dirent(0) { }
 
 		file_size num_dirent(char const *path)
 		{
@@ -415,48 +250,58 @@ class Vfs::Tar_file_system : public File_system
 
 			/* check for cache miss */
 			if (!valid || strcmp(path, key) != 0) {
-				Node *node = root_node.lookup(path);
-				if (!node)
+				if (!index.lookup(path).valid())
 					return 0;
 				strncpy(key, path, sizeof(key));
-				cached_num_dirent = node->num_dirent();
+				cached_num_dirent = index.num_children(path);
 				valid = true;
 			}
 			return cached_num_dirent;
 		}
-	} _cached_num_dirent;
+	} _cached_num_dirent { _index };
 
 	/**
 	 * Walk hardlinks until we reach a file
 	 */
-	Node const *dereference(char const *path)
+	Node dereference(Record const *record)
 	{
-		Node const *node = _root_node.lookup(path);
-		Node const *slow_node = node;
+		Record const *slow_record = record;
+		Node node;
 		int i = 0;
-		while (node) {
-			Record const *record = node->record;
-			if (!record || record->type() != Record::TYPE_HARDLINK)
-				break; /* got it */
+		while (record && record->type() == Record::TYPE_HARDLINK) {
 
 			/*
-			 * The `node` pointer is followed every iteration and
-			 * `slow_node` every-other iteration. If there is a
+			 * The `record` pointer is followed every iteration and
+			 * `slow_record` every-other iteration. If there is a
 			 * loop then eventually we catch it as the faster
 			 * laps the slower.
 			 */
-			node = _root_node.lookup(record->linked_name());
+			node   = _index.lookup(record->linked_name());
+			record = (Record const *)node.header;
 			if (i++ & 1) {
-				slow_node = _root_node.lookup(slow_node->record->linked_name());
-				if (node == slow_node) {
-					Genode::error(_rom_name, " contains a hard-link loop at '", path, "'");
-					node = nullptr;
+				slow_record = (Record const *)
+					_index.lookup(slow_record->linked_name()).header;
+				if (record && record == slow_record) {
+					Genode::error(_rom_name, " contains a hard-link loop at '",
+					              Genode::Cstring(record->name(), 100), "'");
+					return Node();
 				}
 			}
 		}
 		return node;
 	}
 
+	Node dereference(char const *path)
+	{
+		Node const node = _index.lookup(path);
+		Record const *record = (Record const *)node.header;
+
+		if (record && record->type() == Record::TYPE_HARDLINK)
+			return dereference(record);
+
+		return node;
+	}
+
 	public:
 
 		Tar_file_system(Genode::Env       &env,
@@ -465,14 +310,16 @@ class Vfs::Tar_file_system : public File_system
 		                Io_response_handler &)
 		:
 			_env(env), _alloc(alloc),
-			_rom_name(config.attribute_value("name", Rom_name())),
-			_root_node("", 0),
-			_cached_num_dirent(_root_node)
+			_rom_name(config.attribute_value("name", Rom_name()))
 		{
 			Genode::log("tar archive '", _rom_name, "' "
 			            "local at ", (void *)_tar_base, ", size is ", _tar_size);
+		}
 
-			_for_each_tar_record_do(Add_node_action(_alloc, _root_node));
+		~Tar_file_system()
+		{
+			_dataspaces.for_each([&] (Member_dataspace &ds) {
+				destroy(_alloc, &ds); });
 		}
 
 		/*********************************
@@ -481,11 +328,10 @@ class Vfs::Tar_file_system : public File_system
 
 		Dataspace_capability dataspace(char const *path) override
 		{
-			Node const *node = dereference(path);
-			if (!node || !node->record)
+			Record const *record = (Record const *)dereference(path).header;
+			if (!record)
 				return Dataspace_capability();
 
-			Record const *record = node->record;
 			if (record->type() != Record::TYPE_FILE) {
 				Genode::error("TAR record \"", path, "\" has "
 				              "unsupported type ", record->type());
@@ -493,14 +339,11 @@ class Vfs::Tar_file_system : public File_system
 			}
 
 			try {
-				Ram_dataspace_capability ds_cap =
-					_env.ram().alloc(record->size());
-
-				void *local_addr = _env.rm().attach(ds_cap);
-				memcpy(local_addr, record->data(), record->size());
-				_env.rm().detach(local_addr);
-
-				return ds_cap;
+				Member_dataspace &ds = *new (_alloc)
+					Member_dataspace(_dataspaces, _env.ram(), _env.rm(),
+					                 _rm_session(), _tar_ds.cap(), _index,
+					                 (char const *)record);
+				return ds.cap();
 			}
 			catch (...) { Genode::warning(__func__, " could not create new dataspace"); }
 
@@ -509,23 +352,27 @@ class Vfs::Tar_file_system : public File_system
 
 		void release(char const *, Dataspace_capability ds_cap) override
 		{
-			_env.ram().free(static_cap_cast<Genode::Ram_dataspace>(ds_cap));
+			_dataspaces.for_each([&] (Member_dataspace &ds) {
+				if (ds.cap() == ds_cap)
+					destroy(_alloc, &ds); });
 		}
 
 		Stat_result stat(char const *path, Stat &out) override
 		{
 			out = Stat();
 
-			Node const *node = dereference(path);
-			if (!node)
+			Node const node = dereference(path);
+			if (!node.valid())
 				return STAT_ERR_NO_ENTRY;
 
-			if (!node->record) {
-				out.mode = STAT_MODE_DIRECTORY;
+			if (!node.header) {
+				out.mode  = STAT_MODE_DIRECTORY;
+				out.inode = node.id;
+				out.device = (Genode::addr_t)this;
 				return STAT_OK;
 			}
 
-			Record const *record = node->record;
+			Record const *record = (Record const *)node.header;
 
 			/* convert TAR record modes to stat modes */
 			unsigned mode = record->mode();
@@ -541,7 +388,7 @@ class Vfs::Tar_file_system : public File_system
 			out.size  = record->size();
 			out.uid   = record->uid();
 			out.gid   = record->gid();
-			out.inode = (Genode::addr_t)node;
+			out.inode = node.id;
 			out.device = (Genode::addr_t)this;
 
 			return STAT_OK;
@@ -549,8 +396,7 @@ class Vfs::Tar_file_system : public File_system
 
 		Unlink_result unlink(char const *path) override
 		{
-			Node const *node = dereference(path);
-			if (!node)
+			if (!dereference(path).valid())
 				return UNLINK_ERR_NO_ENTRY;
 			else
 				return UNLINK_ERR_NO_PERM;
@@ -558,7 +404,7 @@ class Vfs::Tar_file_system : public File_system
 
 		Rename_result rename(char const *from, char const *to) override
 		{
-			if (_root_node.lookup(from) || _root_node.lookup(to))
+			if (_index.lookup(from).valid() || _index.lookup(to).valid())
 				return RENAME_ERR_NO_PERM;
 			return RENAME_ERR_NO_ENTRY;
 		}
@@ -570,12 +416,12 @@ class Vfs::Tar_file_system : public File_system
 
 		bool directory(char const *path) override
 		{
-			Node const *node = dereference(path);
+			Node const node = dereference(path);
 
-			if (!node)
+			if (!node.valid())
 				return false;
 
-			Record const *record = node->record;
+			Record const *record = (Record const *)node.header;
 
 			return record ? (record->type() == Record::TYPE_DIR) : true;
 		}
@@ -587,18 +433,17 @@ class Vfs::Tar_file_system : public File_system
 			 * case, return the whole path, which is relative to the root
 			 * of this file system.
 			 */
-			Node *node = _root_node.lookup(path);
-			return node ? path : 0;
+			return _index.lookup(path).valid() ? path : 0;
 		}
 
 		Open_result open(char const *path, unsigned, Vfs_handle **out_handle,
 		                 Genode::Allocator& alloc) override
 		{
-			Node const *node = dereference(path);
-			if (!node || !node->record || node->record->type() != Record::TYPE_FILE)
+			Record const *record = (Record const *)dereference(path).header;
+			if (!record || record->type() != Record::TYPE_FILE)
 				return OPEN_ERR_UNACCESSIBLE;
 
-			*out_handle = new (alloc) Tar_vfs_file_handle(*this, alloc, 0, node);
+			*out_handle = new (alloc) Tar_vfs_file_handle(*this, alloc, 0, record);
 
 			return OPEN_OK;
 		}
@@ -607,13 +452,14 @@ class Vfs::Tar_file_system : public File_system
 		                       Vfs_handle **out_handle,
 		                       Genode::Allocator& alloc) override
 		{
-			Node const *node = dereference(path);
+			Node const node = dereference(path);
+			Record const *record = (Record const *)node.header;
 
-			if (!node ||
-			    (node->record && (node->record->type() != Record::TYPE_DIR)))
+			if (!node.valid() ||
+			    (record && (record->type() != Record::TYPE_DIR)))
 				return OPENDIR_ERR_LOOKUP_FAILED;
 
-			*out_handle = new (alloc) Tar_vfs_dir_handle(*this, alloc, 0, node);
+			*out_handle = new (alloc) Tar_vfs_dir_handle(*this, alloc, 0, path);
 
 			return OPENDIR_OK;
 		}
@@ -621,12 +467,11 @@ class Vfs::Tar_file_system : public File_system
 		Openlink_result openlink(char const *path, bool create,
 	                             Vfs_handle **out_handle, Allocator &alloc)
 	    {
-			Node const *node = dereference(path);
-			if (!node || !node->record ||
-			    node->record->type() != Record::TYPE_SYMLINK)
+			Record const *record = (Record const *)dereference(path).header;
+			if (!record || record->type() != Record::TYPE_SYMLINK)
 				return OPENLINK_ERR_LOOKUP_FAILED;
 
-			*out_handle = new (alloc) Tar_vfs_symlink_handle(*this, alloc, 0, node);
+			*out_handle = new (alloc) Tar_vfs_symlink_handle(*this, alloc, 0, record);
 
 			return OPENLINK_OK;
 	    }
@@ -0,0 +1,72 @@
+/*
+ * \brief  Adaptive replacement cache (ARC) strategy
+ * \author Genode Labs
+ * \date   2026-10-14
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#include "arc.h"
+
+using Cache::Policy_element;
+using Cache::offset_t;
+
+
+void Arc_policy::access(Policy_element &e, offset_t off)
+{
+	/* hit, the chunk is (again) frequently used */
+	if (e.queue()) {
+		e.queue()->remove(e);
+		_t2.insert_head(e);
+		return;
+	}
+
+	unsigned long const size = count() + 1;
+
+	/* miss of a chunk that was recently evicted from t1, favour t1 */
+	if (_b1.remove(off)) {
+		unsigned long const b1 = _b1.count() + 1, b2 = _b2.count();
+		unsigned long const delta = b1 >= b2 ? 1 : b2 / b1;
+		_p = Genode::min(size, _p + delta);
+		_t2.insert_head(e);
+		return;
+	}
+
+	/* miss of a chunk that was recently evicted from t2, favour t2 */
+	if (_b2.remove(off)) {
+		unsigned long const b1 = _b1.count(), b2 = _b2.count() + 1;
+		unsigned long const delta = b2 >= b1 ? 1 : b1 / b2;
+		_p = _p > delta ? _p - delta : 0;
+		_t2.insert_head(e);
+		return;
+	}
+
+	/* chunk that was not used recently */
+	_t1.insert_head(e);
+}
+
+
+Policy_element *Arc_policy::victim()
+{
+	if (_t1.count() && (_t1.count() > _p || !_t2.count()))
+		return _t1.tail();
+
+	return _t2.tail();
+}
+
+
+void Arc_policy::evict(Policy_element &e, offset_t off)
+{
+	if (_t1.contains(e)) {
+		_t1.remove(e);
+		_b1.insert(off);
+	} else {
+		_t2.remove(e);
+		_b2.insert(off);
+	}
+}
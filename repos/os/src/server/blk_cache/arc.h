@@ -0,0 +1,56 @@
+/*
+ * \brief  Adaptive replacement cache (ARC) strategy
+ * \author Genode Labs
+ * \date   2026-10-14
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _ARC_H_
+#define _ARC_H_
+
+#include "policy.h"
+#include "ghost.h"
+
+/**
+ * Adaptive replacement cache according to Megiddo and Modha
+ *
+ * Chunks that were accessed once reside in 't1', chunks that were accessed
+ * more than once in 't2'. The lists 'b1' and 'b2' remember the chunks
+ * recently evicted from 't1' respectively 't2'. A miss that hits one of
+ * these ghost lists shifts the target size 'p' of 't1' in favour of the
+ * corresponding resident list. As the cache has no fixed size but grows
+ * until the RAM quota is exhausted, the current number of resident chunks
+ * serves as cache size.
+ */
+class Arc_policy : public Cache::Replacement_policy
+{
+	private:
+
+		enum { GHOST_CAPACITY = 4096 };
+
+		Cache::Policy_queue                _t1;
+		Cache::Policy_queue                _t2;
+		Cache::Ghost_list<GHOST_CAPACITY>  _b1;
+		Cache::Ghost_list<GHOST_CAPACITY>  _b2;
+		unsigned long                      _p { 0 };
+
+	public:
+
+		Arc_policy() { _resident(_t1); _resident(_t2); }
+
+		void access(Cache::Policy_element &e, Cache::offset_t off) override;
+
+		Cache::Policy_element *victim() override;
+
+		void evict(Cache::Policy_element &e, Cache::offset_t off) override;
+
+		char const *name() const override { return "arc"; }
+};
+
+#endif /* _ARC_H_ */
@@ -108,7 +108,8 @@ namespace Cache {
 		private:
 
 			char        _data[CHUNK_SIZE];
-			unsigned    _writes;
+			bool        _valid;       /* holds the data of the device */
+			bool        _dirty;       /* data differs from the device */
 
 		public:
 
@@ -126,12 +127,19 @@ namespace Cache {
 			 * of 'Chunk_index'.
 			 */
 			Chunk(Genode::Allocator &, offset_t base_offset, Chunk_base *p)
-			: Chunk_base(base_offset, p), _writes(0) { }
+			: Chunk_base(base_offset, p), _valid(false), _dirty(false) { }
 
 			/**
 			 * Construct zero chunk
 			 */
-			Chunk() : _writes(0) { }
+			Chunk() : _valid(false), _dirty(false) { }
+
+			~Chunk() { POLICY::remove(this); }
+
+			/**
+			 * Return true if the chunk must be written back to the device
+			 */
+			bool dirty() const { return _dirty; }
 
 			/**
 			 * Return number of used entries
@@ -155,7 +163,32 @@ namespace Cache {
 
 				_num_entries = Genode::max(_num_entries, local_offset + len);
 
-				_writes++;
+				_valid = true;
+				_dirty = true;
+			}
+
+			/**
+			 * Fill chunk with data read from the device
+			 *
+			 * The data is ignored if the chunk got written meanwhile, as the
+			 * written data is more recent.
+			 */
+			void fill(char const *src, size_t len, offset_t seek_offset)
+			{
+				assert_valid_range(seek_offset, len, SIZE);
+
+				POLICY::write(this);
+
+				if (_dirty)
+					return;
+
+				offset_t const local_offset = seek_offset - base_offset();
+
+				Genode::memcpy(&_data[local_offset], src, len);
+
+				_num_entries = Genode::max(_num_entries, local_offset + len);
+
+				_valid = true;
 			}
 
 			void read(char *dst, size_t len, offset_t seek_offset) const
@@ -171,18 +204,30 @@ namespace Cache {
 			{
 				assert_valid_range(seek_offset, len, SIZE);
 
-				if (_writes == 0)
+				if (!_valid)
 					throw Range_incomplete(base_offset(), SIZE);
 			}
 
 			void sync(size_t len, offset_t seek_offset)
 			{
-				if (_writes > 1) {
+				if (_dirty) {
 					POLICY::sync(this, (char*)_data);
-					_writes = 1;
+					_dirty = false;
 				}
 			}
 
+			/**
+			 * Drop the content if the whole chunk is discarded
+			 */
+			void discard(size_t len, offset_t seek_offset)
+			{
+				if (len < SIZE)
+					return;
+
+				_valid = false;
+				_dirty = false;
+			}
+
 			void alloc(size_t len, offset_t seek_offset) { }
 
 			void truncate(size_t size)
@@ -205,7 +250,7 @@ namespace Cache {
 
 			void free(size_t, offset_t)
 			{
-				if (_writes > 1) throw Dirty_chunk(_base_offset, SIZE);
+				if (_dirty) throw Dirty_chunk(_base_offset, SIZE);
 
 				_num_entries = 0;
 				if (_parent) _parent->free(SIZE, _base_offset);
@@ -393,6 +438,20 @@ namespace Cache {
 				}
 			};
 
+			struct Fill_func
+			{
+				typedef ENTRY_TYPE Entry;
+
+				static Entry &lookup(Chunk_index &chunk, unsigned i) {
+					return chunk._entry(i); }
+
+				void operator () (Entry &entry, char const *src, size_t len,
+				                  offset_t seek_offset) const
+				{
+					entry.fill(src, len, seek_offset);
+				}
+			};
+
 			struct Read_func
 			{
 				typedef ENTRY_TYPE const Entry;
@@ -417,6 +476,20 @@ namespace Cache {
 					entry.stat(len, seek_offset); }
 			};
 
+			struct Discard_func
+			{
+				typedef ENTRY_TYPE Entry;
+
+				static Entry &lookup(Chunk_index const &chunk, unsigned i) {
+					return chunk._entry_for_syncing(i); }
+
+				void operator () (Entry &entry, char*, size_t len,
+				                  offset_t seek_offset) const
+				{
+					entry.discard(len, seek_offset);
+				}
+			};
+
 			struct Sync_func
 			{
 				typedef ENTRY_TYPE Entry;
@@ -499,6 +572,12 @@ namespace Cache {
 			void write(char const *src, size_t len, offset_t seek_offset) {
 				_range_op(*this, src, len, seek_offset, Write_func()); }
 
+			/**
+			 * Fill chunk with data read from the device
+			 */
+			void fill(char const *src, size_t len, offset_t seek_offset) {
+				_range_op(*this, src, len, seek_offset, Fill_func()); }
+
 			/**
 			 * Allocate needed chunks
 			 */
@@ -524,6 +603,13 @@ namespace Cache {
 				if (zero()) return;
 				_range_op(*this, (char*)0, len, seek_offset, Sync_func()); }
 
+			/**
+			 * Drop the content of completely discarded chunks
+			 */
+			void discard(size_t len, offset_t seek_offset) {
+				if (zero()) return;
+				_range_op(*this, (char*)0, len, seek_offset, Discard_func()); }
+
 			/**
 			 * Free chunks
 			 */
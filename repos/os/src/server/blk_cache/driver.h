@@ -15,13 +15,18 @@
 #include <block_session/connection.h>
 #include <block/component.h>
 #include <os/packet_allocator.h>
+#include <os/reporter.h>
+#include <timer_session/connection.h>
+#include <util/reconstructible.h>
+#include <util/xml_node.h>
 
 #include "chunk.h"
 
 /**
  * Cache driver used by the generic block driver framework
  *
- * \param POLICY  the cache replacement policy (e.g. LRU)
+ * \param POLICY  the policy front end that forwards the accesses of chunks
+ *                to the replacement policy (see 'Cache_policy')
  */
 template <typename POLICY>
 class Driver : public Block::Driver
@@ -31,17 +36,22 @@ class Driver : public Block::Driver
 		/**
 		 * This class encapsulates requests to the backend device in progress,
 		 * and the packets from the client side that triggered the request.
+		 * Read-ahead requests have no client packet.
 		 */
 		struct Request : public Genode::List<Request>::Element
 		{
 			Block::Packet_descriptor srv;
 			Block::Packet_descriptor cli;
 			char * const             buffer;
+			bool const               read_ahead;
 
 			Request(Block::Packet_descriptor &s,
 			        Block::Packet_descriptor &c,
 			        char * const              b)
-				: srv(s), cli(c), buffer(b) {}
+				: srv(s), cli(c), buffer(b), read_ahead(false) {}
+
+			Request(Block::Packet_descriptor &s)
+				: srv(s), buffer(nullptr), read_ahead(true) {}
 
 			/*
 			 * \return true when the given response packet matches
@@ -75,19 +85,6 @@ class Driver : public Block::Driver
 		};
 
 
-		/**
-		 * Write failed exception at a specific device offset,
-		 * can be triggered whenever the backend device is not ready
-		 * to proceed
-		 */
-		struct Write_failed : Genode::Exception
-		{
-			Cache::offset_t off;
-
-			Write_failed(Cache::offset_t o) : off(o) {}
-		};
-
-
 		/*
 		 * The given policy class is extended by a synchronization routine,
 		 * used by the cache chunk structure
@@ -102,6 +99,21 @@ class Driver : public Block::Driver
 			CACHE_BLK_SIZE = 4096
 		};
 
+		enum { DEFAULT_WRITEBACK_INTERVAL_MS = 1000 };
+		enum { DEFAULT_READ_AHEAD_MAX_KIB    = 128  };
+
+		/**
+		 * Write failed exception at a specific device offset,
+		 * can be triggered whenever the backend device is not ready
+		 * to proceed
+		 */
+		struct Write_failed : Genode::Exception
+		{
+			Cache::offset_t off;
+
+			Write_failed(Cache::offset_t o) : off(o) {}
+		};
+
 		/**
 		 * We use five levels of page-table like chunk structure,
 		 * thereby we've a maximum device size of 256^4*4096 (LBA48)
@@ -126,6 +138,21 @@ class Driver : public Block::Driver
 		Genode::Io_signal_handler<Driver> _source_ack;
 		Genode::Io_signal_handler<Driver> _source_submit;
 		Genode::Io_signal_handler<Driver> _yield;
+		bool                              _replaying { false };
+
+		/*
+		 * Sequential-access detection and read-ahead state, the window
+		 * is given in cache blocks and doubles with each sequential read
+		 */
+		Genode::size_t                    _ra_max;            /* max window */
+		Genode::size_t                    _ra_window { 0 };   /* current    */
+		Block::sector_t                   _seq_next  { 0 };   /* expected   */
+		Block::sector_t                   _ra_end    { 0 };   /* issued     */
+
+		Genode::Constructible<Timer::Connection>               _timer;
+		Genode::Constructible<Timer::Periodic_timeout<Driver>> _writeback;
+		Genode::Constructible<Timer::Periodic_timeout<Driver>> _report_timeout;
+		Genode::Constructible<Genode::Reporter>                _reporter;
 
 		Driver(Driver const&);            /* singleton pattern */
 		Driver& operator=(Driver const&); /* singleton pattern */
@@ -157,6 +184,15 @@ class Driver : public Block::Driver
 		 */
 		inline void _handle_reply(Block::Packet_descriptor &srv, Request *r)
 		{
+			/* discards and flushes are passed through to the backend */
+			Block::Packet_descriptor::Opcode const op = r->cli.operation();
+			if (op == Block::Packet_descriptor::DISCARD ||
+			    op == Block::Packet_descriptor::FLUSH) {
+				ack_packet(r->cli, srv.succeeded());
+				return;
+			}
+
+			_replaying = true;
 			try {
 			if (r->cli.operation() == Block::Packet_descriptor::READ)
 				read(r->cli.block_number(), r->cli.block_count(),
@@ -170,6 +206,7 @@ class Driver : public Block::Driver
 				                "srv (", r->srv.block_number(), " ",
 				                         r->srv.block_count(), ")");
 			}
+			_replaying = false;
 		}
 
 		/*
@@ -180,18 +217,26 @@ class Driver : public Block::Driver
 			while (_blk.tx()->ack_avail()) {
 				Block::Packet_descriptor p = _blk.tx()->get_acked_packet();
 
-				/* when reading, write result into cache */
-				if (p.operation() == Block::Packet_descriptor::READ)
-					_cache.write(_blk.tx()->packet_content(p),
-					             p.block_count() * _blk_sz,
-					             p.block_number() * _blk_sz);
+				/*
+				 * When reading, fill the result into the cache. If the
+				 * chunks got evicted meanwhile, the replayed requests
+				 * simply miss again.
+				 */
+				if (p.operation() == Block::Packet_descriptor::READ) {
+					try {
+						_cache.fill(_blk.tx()->packet_content(p),
+						            p.block_count() * _blk_sz,
+						            p.block_number() * _blk_sz);
+					} catch (Cache::Chunk_base::Range_incomplete) { }
+				}
 
 				/* loop through the list of requests, and ack all related */
 				for (Request *r = _r_list.first(), *r_to_handle = r; r;
 				     r_to_handle = r) {
 					r = r->next();
 					if (r_to_handle->match(p)) {
-						_handle_reply(p, r_to_handle);
+						if (!r_to_handle->read_ahead)
+							_handle_reply(p, r_to_handle);
 						_r_list.remove(r_to_handle);
 						Genode::destroy(&_r_slab, r_to_handle);
 					}
@@ -260,6 +305,98 @@ class Driver : public Block::Driver
 			}
 		}
 
+		/*
+		 * Pass a request without payload to the backend device
+		 *
+		 * \param packet  original packet request received from the client
+		 * \param nr      block number offset at the backend device
+		 * \param cnt     number of blocks
+		 */
+		void _forward(Block::Packet_descriptor &packet,
+		              Block::sector_t nr, Genode::size_t cnt)
+		{
+			if (!_blk.tx()->ready_to_submit())
+				throw Request_congestion();
+
+			Block::Packet_descriptor p_to_dev(_blk.dma_alloc_packet(0),
+			                                  packet.operation(), nr, cnt);
+			_r_list.insert(new (&_r_slab) Request(p_to_dev, packet, nullptr));
+			_blk.tx()->submit_packet(p_to_dev);
+		}
+
+		/*
+		 * Track sequential reads and adapt the read-ahead window
+		 *
+		 * \param nr   block number offset of the read
+		 * \param cnt  number of blocks read
+		 */
+		void _detect_sequential(Block::sector_t nr, Genode::size_t cnt)
+		{
+			if (nr == _seq_next && nr) {
+				_ra_window = Genode::min(_ra_max,
+				                         Genode::max((Genode::size_t)1, _ra_window * 2));
+			} else {
+				_ra_window = 0;
+				_ra_end    = 0;
+			}
+			_seq_next = nr + cnt;
+		}
+
+		/*
+		 * Read the blocks following a sequential read into the cache
+		 *
+		 * Read ahead is best effort. It's skipped whenever the backend
+		 * device or the cache memory is congested.
+		 */
+		void _read_ahead()
+		{
+			if (!_ra_window)
+				return;
+
+			Block::sector_t const first = _cache_blk_round_up(_seq_next);
+			Block::sector_t const nr    = Genode::max(first, _ra_end);
+			Block::sector_t const end   =
+				Genode::min((Block::sector_t)(first + _ra_window * _cache_blk_mod()),
+				            _cache_blk_round_off(_blk_cnt));
+
+			if (nr >= end)
+				return;
+
+			Genode::size_t const cnt = end - nr;
+
+			/* skip blocks that are cached or requested already */
+			try {
+				_cache.stat(cnt * _blk_sz, nr * _blk_sz);
+				_ra_end = end;
+				return;
+			} catch (Cache::Chunk_base::Range_incomplete) { }
+
+			for (Request *r = _r_list.first(); r; r = r->next())
+				if (r->match(false, nr, 1))
+					return;
+
+			if (!_blk.tx()->ready_to_submit())
+				return;
+
+			Block::Packet_descriptor p_to_dev;
+			try {
+				_cache.alloc(cnt * _blk_sz, nr * _blk_sz);
+
+				p_to_dev =
+					Block::Packet_descriptor(_blk.dma_alloc_packet(_blk_sz*cnt),
+					                         Block::Packet_descriptor::READ,
+					                         nr, cnt);
+				_r_list.insert(new (&_r_slab) Request(p_to_dev));
+				_blk.tx()->submit_packet(p_to_dev);
+				_ra_end = end;
+				POLICY::stats().read_aheads++;
+			}
+			catch (Block::Session::Tx::Source::Packet_alloc_failed) { }
+			catch (Block::Driver::Request_congestion) { }
+			catch (Genode::Allocator::Out_of_memory) {
+				_blk.tx()->release_packet(p_to_dev); }
+		}
+
 		/*
 		 * Synchronize dirty chunks with backend device
 		 */
@@ -325,14 +462,62 @@ class Driver : public Block::Driver
 			_env.parent().yield_response();
 		}
 
+		/*
+		 * Write back dirty chunks as long as the backend device accepts
+		 * requests, leaves the remainder to the next period or 'sync'
+		 */
+		void _handle_writeback(Genode::Duration)
+		{
+			try {
+				POLICY::for_each([&] (typename POLICY::Element &e) {
+					Chunk_level_4 &chunk = static_cast<Chunk_level_4 &>(e);
+					chunk.sync(Chunk_level_4::SIZE, chunk.base_offset());
+				});
+			} catch (Write_failed) { }
+		}
+
+		void _handle_report(Genode::Duration)
+		{
+			Cache::Stats const &stats = POLICY::stats();
+
+			Cache::size_t resident = 0, dirty = 0;
+			POLICY::for_each([&] (typename POLICY::Element &e) {
+				resident += Chunk_level_4::SIZE;
+				if (static_cast<Chunk_level_4 &>(e).dirty())
+					dirty += Chunk_level_4::SIZE;
+			});
+
+			Genode::uint64_t const accesses = stats.hits + stats.misses;
+
+			try {
+				Genode::Reporter::Xml_generator xml(*_reporter, [&] () {
+					xml.attribute("policy",         POLICY::policy().name());
+					xml.attribute("hits",           stats.hits);
+					xml.attribute("misses",         stats.misses);
+					xml.attribute("hit_rate",       accesses
+					                                ? stats.hits * 100 / accesses
+					                                : 0);
+					xml.attribute("evictions",      stats.evictions);
+					xml.attribute("write_backs",    stats.write_backs);
+					xml.attribute("read_aheads",    stats.read_aheads);
+					xml.attribute("resident_bytes", resident);
+					xml.attribute("dirty_bytes",    dirty);
+				});
+			} catch (Genode::Xml_generator::Buffer_exceeded) {
+				Genode::warning("failed to generate report"); }
+		}
+
 	public:
 
 		/*
 		 * Constructor
 		 *
-		 * \param ep  server entrypoint
+		 * \param env     component environment
+		 * \param heap    allocator for cache chunks and meta data
+		 * \param config  component configuration
 		 */
-		Driver(Genode::Env &env, Genode::Heap &heap)
+		Driver(Genode::Env &env, Genode::Heap &heap,
+		       Genode::Xml_node const config)
 		: Block::Driver(env.ram()),
 		  _env(env),
 		  _r_slab(&heap),
@@ -343,7 +528,8 @@ class Driver : public Block::Driver
 		  _cache(heap, 0),
 		  _source_ack(env.ep(), *this, &Driver::_ack_avail),
 		  _source_submit(env.ep(), *this, &Driver::_ready_to_submit),
-		  _yield(env.ep(), *this, &Driver::_parent_yield)
+		  _yield(env.ep(), *this, &Driver::_parent_yield),
+		  _ra_max(0)
 		{
 			using namespace Genode;
 
@@ -360,6 +546,39 @@ class Driver : public Block::Driver
 
 			/* truncate chunk structure to real size of the device */
 			_cache.truncate(_blk_sz*_blk_cnt);
+
+			/* cap the read-ahead window, at most half of the packet buffer */
+			Genode::size_t const ra_max_kib =
+				config.attribute_value("read_ahead_max_kib",
+				                       (Genode::size_t)DEFAULT_READ_AHEAD_MAX_KIB);
+			_ra_max = Genode::min(ra_max_kib * 1024,
+			                      (Genode::size_t)Block::Session::TX_QUEUE_SIZE *
+			                      CACHE_BLK_SIZE / 2) / CACHE_BLK_SIZE;
+
+			unsigned long const writeback_ms =
+				config.attribute_value("writeback_interval_ms",
+				                       (unsigned long)DEFAULT_WRITEBACK_INTERVAL_MS);
+
+			unsigned long report_ms = 0;
+			try {
+				report_ms = 1000 * config.sub_node("report")
+				                   .attribute_value("interval_sec", 5UL);
+			} catch (Genode::Xml_node::Nonexistent_sub_node) { }
+
+			if (writeback_ms || report_ms)
+				_timer.construct(env);
+
+			if (writeback_ms)
+				_writeback.construct(*_timer, *this,
+				                     &Driver::_handle_writeback,
+				                     Genode::Microseconds(writeback_ms * 1000));
+			if (report_ms) {
+				_reporter.construct(env, "blk_cache");
+				_reporter->enabled(true);
+				_report_timeout.construct(*_timer, *this,
+				                          &Driver::_handle_report,
+				                          Genode::Microseconds(report_ms * 1000));
+			}
 		}
 
 		~Driver()
@@ -389,7 +608,16 @@ class Driver : public Block::Driver
 			if (!_ops.supported(Block::Packet_descriptor::READ))
 				throw Io_error();
 
-			if (!_stat(block_number, block_count, buffer, packet))
+			/* replayed requests were already accounted as misses */
+			bool const hit = _stat(block_number, block_count, buffer, packet);
+			if (!_replaying) {
+				if (hit) POLICY::stats().hits++;
+				else     POLICY::stats().misses++;
+
+				_detect_sequential(block_number, block_count);
+				_read_ahead();
+			}
+			if (!hit)
 				return;
 
 			_cache.read(buffer, block_count*_blk_sz, block_number*_blk_sz);
@@ -420,5 +648,53 @@ class Driver : public Block::Driver
 			ack_packet(packet);
 		}
 
+		void discard(Block::sector_t           block_number,
+		             Genode::size_t            block_count,
+		             Block::Packet_descriptor &packet)
+		{
+			if (!_ops.supported(Block::Packet_descriptor::DISCARD))
+				throw Io_error();
+
+			/*
+			 * Drop the cached content of all cache blocks that are covered
+			 * completely, so that it is neither read nor written back
+			 * anymore. Partially covered cache blocks stay untouched as
+			 * the content of discarded blocks is undefined anyway.
+			 */
+			Block::sector_t const first = _cache_blk_round_up(block_number);
+			Block::sector_t const end   =
+				_cache_blk_round_off(block_number + block_count);
+
+			_forward(packet, block_number, block_count);
+
+			if (first < end)
+				_cache.discard((end - first) * _blk_sz, first * _blk_sz);
+		}
+
+		/*
+		 * Flushes write back all dirty chunks and get passed through to the
+		 * backend device. The session component ensures that no other
+		 * request is in flight meanwhile.
+		 */
+		void submit(Block::Request &request) override
+		{
+			Block::Packet_descriptor &p = request.packet;
+
+			if (p.operation() != Block::Packet_descriptor::FLUSH) {
+				Block::Driver::submit(request);
+				return;
+			}
+
+			_sync();
+
+			if (_ops.supported(Block::Packet_descriptor::FLUSH)) {
+				_forward(p, 0, 0);
+				return;
+			}
+
+			_blk.sync();
+			ack_packet(p);
+		}
+
 		void sync() { _sync(); }
 };
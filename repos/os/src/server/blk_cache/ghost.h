@@ -0,0 +1,80 @@
+/*
+ * \brief  Bounded history of evicted chunks
+ * \author Genode Labs
+ * \date   2026-10-14
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _GHOST_H_
+#define _GHOST_H_
+
+#include "chunk.h"
+
+namespace Cache { template <unsigned> class Ghost_list; }
+
+
+/**
+ * FIFO of the offsets of evicted chunks
+ *
+ * If the list is full, the oldest offset gets dropped. The lookup is a
+ * linear search, which is negligible compared to the backend access that
+ * is needed for the chunk anyway.
+ *
+ * \param CAPACITY  maximum number of remembered offsets
+ */
+template <unsigned CAPACITY>
+class Cache::Ghost_list
+{
+	private:
+
+		enum : offset_t { INVALID = ~(offset_t)0 };
+
+		offset_t _off[CAPACITY];
+		unsigned _head  { 0 };
+		unsigned _count { 0 };
+
+	public:
+
+		Ghost_list()
+		{
+			for (unsigned i = 0; i < CAPACITY; i++)
+				_off[i] = INVALID;
+		}
+
+		void insert(offset_t off)
+		{
+			if (_off[_head] == INVALID)
+				_count++;
+
+			_off[_head] = off;
+			_head = (_head + 1) % CAPACITY;
+		}
+
+		/**
+		 * Remove offset
+		 *
+		 * \return true if the offset was in the list
+		 */
+		bool remove(offset_t off)
+		{
+			for (unsigned i = 0; i < CAPACITY; i++) {
+				if (_off[i] != off)
+					continue;
+
+				_off[i] = INVALID;
+				_count--;
+				return true;
+			}
+			return false;
+		}
+
+		unsigned count() const { return _count; }
+};
+
+#endif /* _GHOST_H_ */
@@ -12,51 +12,11 @@
  */
 
 #include "lru.h"
-#include "driver.h"
 
-typedef Driver<Lru_policy>::Chunk_level_4 Chunk;
 
-static const Lru_policy::Element        *lru = 0;
-static Genode::List<Lru_policy::Element> lru_list;
-
-
-static void lru_access(const Lru_policy::Element *e)
+void Lru_policy::access(Cache::Policy_element &e, Cache::offset_t)
 {
-	if (e == lru) return;
-
-	if (e->next()) lru_list.remove(e);
-
-	lru_list.insert(e, lru);
-	lru = e;
-}
-
-
-void Lru_policy::read(const Lru_policy::Element  *e) {
-	lru_access(e); }
-
-
-void Lru_policy::write(const Lru_policy::Element *e) {
-	lru_access(e); }
-
-
-void Lru_policy::flush(Cache::size_t size)
-{
-	Cache::size_t s = 0;
-	for (Lru_policy::Element *e = lru_list.first();
-		 e && ((size == 0) || (s < size));
-		 e = lru_list.first(), s += sizeof(Chunk)) {
-		Chunk *cb = static_cast<Chunk*>(e);
-		e = e->next();
-		try {
-			cb->free(Driver<Lru_policy>::CACHE_BLK_SIZE,
-			         cb->base_offset());
-			lru_list.remove(cb);
-		} catch(Chunk::Dirty_chunk &e) {
-			cb->sync(e.size, e.off);
-		}
-	}
-
-	if (!lru_list.first()) lru = 0;
+	if (queue.contains(e)) queue.remove(e);
 
-	if (s < size) throw Block::Driver::Request_congestion();
+	queue.insert_head(e);
 }
@@ -11,15 +11,25 @@
  * under the terms of the GNU Affero General Public License version 3.
  */
 
-#include <util/list.h>
+#ifndef _LRU_H_
+#define _LRU_H_
 
-#include "chunk.h"
+#include "policy.h"
 
-struct Lru_policy
+struct Lru_policy : Cache::Replacement_policy
 {
-	class Element : public Genode::List<Element>::Element {};
+	Cache::Policy_queue queue;
 
-	static void read(const Element  *e);
-	static void write(const Element *e);
-	static void flush(Cache::size_t size = 0);
+	Lru_policy() { _resident(queue); }
+
+	void access(Cache::Policy_element &e, Cache::offset_t) override;
+
+	Cache::Policy_element *victim() override { return queue.tail(); }
+
+	void evict(Cache::Policy_element &e, Cache::offset_t) override {
+		queue.remove(e); }
+
+	char const *name() const override { return "lru"; }
 };
+
+#endif /* _LRU_H_ */
@@ -11,12 +11,15 @@
  * under the terms of the GNU Affero General Public License version 3.
  */
 
+#include <base/attached_rom_dataspace.h>
 #include <base/component.h>
 
 #include "lru.h"
+#include "arc.h"
+#include "two_q.h"
 #include "driver.h"
 
-using Policy = Lru_policy;
+using Policy = Cache_policy;
 static Driver<Policy> * driver = nullptr;
 
 
@@ -24,7 +27,7 @@ static Driver<Policy> * driver = nullptr;
  * Synchronize a chunk with the backend device
  */
 template <typename POLICY>
-void Driver<POLICY>::Policy::sync(const typename POLICY::Element *e, char *dst)
+void Driver<POLICY>::Policy::sync(const typename POLICY::Element *e, char *src)
 {
 	Cache::offset_t off =
 		static_cast<const Driver<POLICY>::Chunk_level_4*>(e)->base_offset();
@@ -38,7 +41,10 @@ void Driver<POLICY>::Policy::sync(const typename POLICY::Element *e, char *dst)
 			p(driver->blk()->dma_alloc_packet(Driver::CACHE_BLK_SIZE),
 		      Block::Packet_descriptor::WRITE, off / driver->blk_sz(),
 		      Driver::CACHE_BLK_SIZE / driver->blk_sz());
+		Genode::memcpy(driver->blk()->tx()->packet_content(p), src,
+		               Driver::CACHE_BLK_SIZE);
 		driver->blk()->tx()->submit_packet(p);
+		POLICY::stats().write_backs++;
 	} catch(Block::Session::Tx::Source::Packet_alloc_failed) {
 		throw Write_failed(off);
 	}
@@ -50,14 +56,18 @@ struct Main
 	template <typename T>
 	struct Factory : Block::Driver_factory
 	{
-		Genode::Env  &env;
-		Genode::Heap &heap;
+		Genode::Env                    &env;
+		Genode::Heap                   &heap;
+		Genode::Attached_rom_dataspace &config;
 
-		Factory(Genode::Env &env, Genode::Heap &heap) : env(env), heap(heap) {}
+		Factory(Genode::Env &env, Genode::Heap &heap,
+		        Genode::Attached_rom_dataspace &config)
+		: env(env), heap(heap), config(config) {}
 
 		Block::Driver *create()
 		{
-			driver = new (&heap) ::Driver<T>(env, heap);
+			config.update();
+			driver = new (&heap) ::Driver<T>(env, heap, config.xml());
 			return driver;
 		}
 
@@ -67,15 +77,35 @@ struct Main
 
 	void resource_handler() { }
 
-	Genode::Env                 &env;
-	Genode::Heap                 heap    { env.ram(), env.rm()     };
-	Factory<Lru_policy>          factory { env, heap               };
-	Block::Root                  root    { env.ep(), heap, env.rm(), factory, true };
-	Genode::Signal_handler<Main> resource_dispatcher {
+	/**
+	 * Create replacement policy as selected by the configuration
+	 */
+	Cache::Replacement_policy &_create_policy()
+	{
+		typedef Genode::String<8> Name;
+		Name const name = config.xml().attribute_value("policy", Name("lru"));
+
+		if (name == "arc") return *new (&heap) Arc_policy;
+		if (name == "2q")  return *new (&heap) Two_q_policy;
+
+		if (name != "lru")
+			Genode::warning("unknown policy \"", name, "\", use LRU");
+
+		return *new (&heap) Lru_policy;
+	}
+
+	Genode::Env                    &env;
+	Genode::Heap                    heap    { env.ram(), env.rm()     };
+	Genode::Attached_rom_dataspace  config  { env, "config"           };
+	Cache::Replacement_policy      &policy  { _create_policy()        };
+	Factory<Cache_policy>           factory { env, heap, config       };
+	Block::Root                     root    { env.ep(), heap, env.rm(), factory, true };
+	Genode::Signal_handler<Main>    resource_dispatcher {
 		env.ep(), *this, &Main::resource_handler };
 
 	Main(Genode::Env &env) : env(env)
 	{
+		Cache_policy::policy(policy);
 		env.parent().announce(env.ep().manage(root));
 		env.parent().resource_avail_sigh(resource_dispatcher);
 	}
@@ -0,0 +1,77 @@
+/*
+ * \brief  Policy front end used by the chunk structure
+ * \author Genode Labs
+ * \date   2026-10-14
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#include "policy.h"
+#include "driver.h"
+
+typedef Driver<Cache_policy>::Chunk_level_4 Chunk;
+
+static Cache::Replacement_policy *replacement_policy = nullptr;
+static Cache::Stats               cache_stats;
+
+
+static Chunk &chunk(const Cache_policy::Element *e) {
+	return *static_cast<Chunk *>(const_cast<Cache_policy::Element *>(e)); }
+
+
+void Cache_policy::policy(Cache::Replacement_policy &policy) {
+	replacement_policy = &policy; }
+
+
+Cache::Replacement_policy &Cache_policy::policy() {
+	return *replacement_policy; }
+
+
+Cache::Stats &Cache_policy::stats() { return cache_stats; }
+
+
+void Cache_policy::read(const Cache_policy::Element *e) {
+	replacement_policy->access(chunk(e), chunk(e).base_offset()); }
+
+
+void Cache_policy::write(const Cache_policy::Element *e) {
+	replacement_policy->access(chunk(e), chunk(e).base_offset()); }
+
+
+void Cache_policy::remove(const Cache_policy::Element *e)
+{
+	Cache_policy::Element &elem = chunk(e);
+	if (elem.queue()) elem.queue()->remove(elem);
+}
+
+
+void Cache_policy::flush(Cache::size_t size)
+{
+	Cache::size_t s = 0;
+	while ((size == 0) || (s < size)) {
+
+		Cache_policy::Element *e = replacement_policy->victim();
+		if (!e) break;
+
+		Chunk &cb = chunk(e);
+
+		/* write back dirty chunk before evicting it */
+		try {
+			cb.sync(Chunk::SIZE, cb.base_offset());
+		} catch (Driver<Cache_policy>::Write_failed) {
+			throw Block::Driver::Request_congestion();
+		}
+
+		replacement_policy->evict(cb, cb.base_offset());
+		cb.free(Chunk::SIZE, cb.base_offset());
+		cache_stats.evictions++;
+		s += sizeof(Chunk);
+	}
+
+	if (s < size) throw Block::Driver::Request_congestion();
+}
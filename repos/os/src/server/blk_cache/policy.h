@@ -0,0 +1,206 @@
+/*
+ * \brief  Interface of cache replacement policies
+ * \author Genode Labs
+ * \date   2026-10-14
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _POLICY_H_
+#define _POLICY_H_
+
+#include "chunk.h"
+
+namespace Cache {
+
+	class Policy_element;
+	class Policy_queue;
+	class Replacement_policy;
+	struct Stats;
+}
+
+struct Cache_policy;
+
+
+/**
+ * Element of a policy queue, base class of each cached chunk
+ */
+class Cache::Policy_element
+{
+	private:
+
+		friend class Policy_queue;
+
+		Policy_element *_prev  { nullptr };
+		Policy_element *_next  { nullptr };
+		Policy_queue   *_queue { nullptr };
+
+	public:
+
+		Policy_queue *queue() const { return _queue; }
+};
+
+
+/**
+ * Doubly-linked queue of policy elements with constant-time operations
+ *
+ * The head of the queue is the most, the tail the least recently inserted
+ * element.
+ */
+class Cache::Policy_queue
+{
+	private:
+
+		Policy_element *_head  { nullptr };
+		Policy_element *_tail  { nullptr };
+		unsigned long   _count { 0 };
+
+	public:
+
+		void insert_head(Policy_element &e)
+		{
+			e._queue = this;
+			e._prev  = nullptr;
+			e._next  = _head;
+			if (_head) _head->_prev = &e;
+			else       _tail        = &e;
+			_head = &e;
+			_count++;
+		}
+
+		void remove(Policy_element &e)
+		{
+			if (e._prev) e._prev->_next = e._next;
+			else         _head          = e._next;
+			if (e._next) e._next->_prev = e._prev;
+			else         _tail          = e._prev;
+			e._prev = e._next = nullptr;
+			e._queue = nullptr;
+			_count--;
+		}
+
+		bool contains(Policy_element const &e) const { return e._queue == this; }
+
+		Policy_element *tail()  const { return _tail; }
+		unsigned long   count() const { return _count; }
+
+		template <typename FUNC>
+		void for_each(FUNC const &fn) const
+		{
+			for (Policy_element *e = _head; e; e = e->_next)
+				fn(*e);
+		}
+};
+
+
+/**
+ * Cache replacement policy
+ *
+ * A policy arranges the cached chunks in its resident queues and decides
+ * which chunk is to be evicted next. The chunks are identified by their
+ * offsets, which allows policies to remember chunks beyond their eviction.
+ */
+class Cache::Replacement_policy
+{
+	private:
+
+		enum { MAX_QUEUES = 2 };
+
+		Policy_queue *_queues[MAX_QUEUES];
+		unsigned      _queue_cnt { 0 };
+
+	protected:
+
+		/**
+		 * Register queue of resident chunks, called by the constructor
+		 */
+		void _resident(Policy_queue &q) { _queues[_queue_cnt++] = &q; }
+
+	public:
+
+		virtual ~Replacement_policy() { }
+
+		/**
+		 * Note access of chunk, the chunk might not be known yet
+		 */
+		virtual void access(Policy_element &e, offset_t off) = 0;
+
+		/**
+		 * Return chunk that should be evicted next or 0 if empty
+		 */
+		virtual Policy_element *victim() = 0;
+
+		/**
+		 * Remove chunk that gets evicted
+		 */
+		virtual void evict(Policy_element &e, offset_t off) = 0;
+
+		virtual char const *name() const = 0;
+
+		template <typename FUNC>
+		void for_each(FUNC const &fn) const
+		{
+			for (unsigned i = 0; i < _queue_cnt; i++)
+				_queues[i]->for_each(fn);
+		}
+
+		unsigned long count() const
+		{
+			unsigned long cnt = 0;
+			for (unsigned i = 0; i < _queue_cnt; i++)
+				cnt += _queues[i]->count();
+			return cnt;
+		}
+};
+
+
+/**
+ * Cache statistics
+ */
+struct Cache::Stats
+{
+	Genode::uint64_t hits        { 0 };
+	Genode::uint64_t misses      { 0 };
+	Genode::uint64_t evictions   { 0 };
+	Genode::uint64_t write_backs { 0 };
+	Genode::uint64_t read_aheads { 0 };
+};
+
+
+/**
+ * Policy front end used by the chunk structure
+ *
+ * It forwards the accesses of chunks to the replacement policy that
+ * was selected via 'policy' and implements the eviction of chunks.
+ */
+struct Cache_policy
+{
+	typedef Cache::Policy_element Element;
+
+	static void policy(Cache::Replacement_policy &policy);
+
+	static Cache::Replacement_policy &policy();
+
+	static Cache::Stats &stats();
+
+	static void read(Element const *e);
+	static void write(Element const *e);
+	static void remove(Element const *e);
+
+	/**
+	 * Evict chunks until 'size' bytes are freed, all if 'size' is 0
+	 *
+	 * \throw Block::Driver::Request_congestion
+	 */
+	static void flush(Cache::size_t size = 0);
+
+	template <typename FUNC>
+	static void for_each(FUNC const &fn) { policy().for_each(fn); }
+};
+
+#endif /* _POLICY_H_ */
@@ -1,3 +1,3 @@
 TARGET = blk_cache
 LIBS   = base
-SRC_CC = main.cc lru.cc
+SRC_CC = main.cc policy.cc lru.cc arc.cc two_q.cc
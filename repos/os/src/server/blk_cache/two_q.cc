@@ -0,0 +1,58 @@
+/*
+ * \brief  2Q cache replacement strategy
+ * \author Genode Labs
+ * \date   2026-10-14
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#include "two_q.h"
+
+using Cache::Policy_element;
+using Cache::offset_t;
+
+
+void Two_q_policy::access(Policy_element &e, offset_t off)
+{
+	/* chunks in 'a1_in' keep their position, correlated accesses */
+	if (_a1_in.contains(e))
+		return;
+
+	if (_am.contains(e)) {
+		_am.remove(e);
+		_am.insert_head(e);
+		return;
+	}
+
+	if (_a1_out.remove(off))
+		_am.insert_head(e);
+	else
+		_a1_in.insert_head(e);
+}
+
+
+Policy_element *Two_q_policy::victim()
+{
+	unsigned long const a1_in_max = Genode::max(1UL, count() / 4);
+
+	if (_a1_in.count() && (_a1_in.count() > a1_in_max || !_am.count()))
+		return _a1_in.tail();
+
+	return _am.tail();
+}
+
+
+void Two_q_policy::evict(Policy_element &e, offset_t off)
+{
+	if (_a1_in.contains(e)) {
+		_a1_in.remove(e);
+		_a1_out.insert(off);
+	} else {
+		_am.remove(e);
+	}
+}
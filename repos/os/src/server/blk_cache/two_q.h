@@ -0,0 +1,52 @@
+/*
+ * \brief  2Q cache replacement strategy
+ * \author Genode Labs
+ * \date   2026-10-14
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _TWO_Q_H_
+#define _TWO_Q_H_
+
+#include "policy.h"
+#include "ghost.h"
+
+/**
+ * Full version of the 2Q algorithm according to Johnson and Shasha
+ *
+ * Chunks enter the FIFO 'a1_in'. When evicted from there, they are
+ * remembered in 'a1_out'. Only chunks that are accessed again while being
+ * in 'a1_out' get promoted to the LRU queue 'am'. Thereby, a sequential
+ * scan doesn't flush the frequently used chunks. The size of 'a1_in' is
+ * kept at a quarter of the resident chunks.
+ */
+class Two_q_policy : public Cache::Replacement_policy
+{
+	private:
+
+		enum { GHOST_CAPACITY = 4096 };
+
+		Cache::Policy_queue                _a1_in;
+		Cache::Policy_queue                _am;
+		Cache::Ghost_list<GHOST_CAPACITY>  _a1_out;
+
+	public:
+
+		Two_q_policy() { _resident(_a1_in); _resident(_am); }
+
+		void access(Cache::Policy_element &e, Cache::offset_t off) override;
+
+		Cache::Policy_element *victim() override;
+
+		void evict(Cache::Policy_element &e, Cache::offset_t off) override;
+
+		char const *name() const override { return "2q"; }
+};
+
+#endif /* _TWO_Q_H_ */
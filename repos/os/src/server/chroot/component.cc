@@ -22,6 +22,7 @@
 #include <base/service.h>
 #include <base/allocator_avl.h>
 #include <base/heap.h>
+#include <util/reconstructible.h>
 
 namespace Chroot {
 	using namespace Genode;
@@ -52,10 +53,82 @@ struct Chroot::Main
 			server_id(*this, server_space, server_id) { }
 	};
 
+	/**
+	 * Cache of the roots of recently created sessions
+	 *
+	 * Determining the root of a session involves evaluating the policy and
+	 * creating the root directory at the backend, which costs several
+	 * round trips to the file-system server. Clients that open many
+	 * short-lived sessions request the same root over and over. Hence, the
+	 * outcome is remembered per label and requested root. The cache is
+	 * flushed on config updates and entries are evicted if the backend
+	 * denies a session.
+	 */
+	struct Root_cache
+	{
+		enum { MAX_ENTRIES = 32 };
+
+		struct Entry
+		{
+			Session_label        const label;
+			String<PATH_MAX_LEN> const root;     /* as requested */
+			Path                 const new_root;
+
+			Entry(Session_label const &label, char const *root,
+			      char const *new_root)
+			: label(label), root(root), new_root(new_root) { }
+
+			bool matches(Session_label const &l, char const *r) const {
+				return label == l && root == r; }
+		};
+
+		Constructible<Entry> _entries[MAX_ENTRIES];
+
+		unsigned _next = 0;
+
+		template <typename FN>
+		bool with_entry(Session_label const &label, char const *root,
+		                FN const &fn)
+		{
+			for (unsigned i = 0; i < MAX_ENTRIES; i++) {
+				if (_entries[i].constructed() && _entries[i]->matches(label, root)) {
+					fn(*_entries[i]);
+					return true;
+				}
+			}
+			return false;
+		}
+
+		/**
+		 * Insert entry, replacing the oldest one if the cache is full
+		 */
+		void insert(Session_label const &label, char const *root,
+		            char const *new_root)
+		{
+			_entries[_next].construct(label, root, new_root);
+			_next = (_next + 1) % MAX_ENTRIES;
+		}
+
+		void evict(Session_label const &label, char const *root)
+		{
+			for (unsigned i = 0; i < MAX_ENTRIES; i++)
+				if (_entries[i].constructed() && _entries[i]->matches(label, root))
+					_entries[i].destruct();
+		}
+
+		void flush()
+		{
+			for (unsigned i = 0; i < MAX_ENTRIES; i++)
+				_entries[i].destruct();
+		}
+	};
+
 	Genode::Env &env;
 
 	Id_space<Parent::Server> server_id_space;
 
+	Root_cache root_cache { };
+
 	Heap heap { env.ram(), env.rm() };
 
 	Allocator_avl fs_tx_block_alloc { &heap };
@@ -70,7 +143,11 @@ struct Chroot::Main
 
 	Attached_rom_dataspace config_rom { env, "config" };
 
-	void handle_config_update() { config_rom.update(); }
+	void handle_config_update()
+	{
+		config_rom.update();
+		root_cache.flush();
+	}
 
 	void handle_session_request(Xml_node request);
 
@@ -105,11 +182,51 @@ struct Chroot::Main
 
 	Session_capability request_session(Parent::Client::Id  const &id,
 	                                   Session_state::Args const &args)
+	{
+		Session_label const label = label_from_args(args.string());
+
+		/* extract the orginal root */
+		char orig_root[PATH_MAX_LEN];
+		Arg_string::find_arg(args.string(), "root").string(
+			orig_root, sizeof(orig_root), "/");
+
+		Path new_root;
+		bool const cached = root_cache.with_entry(label, orig_root,
+			[&] (Root_cache::Entry const &e) { new_root = e.new_root; });
+
+		if (!cached) {
+			new_root = _new_root(label, orig_root);
+			root_cache.insert(label, orig_root, new_root.base());
+		}
+
+		/* rewrite the root session argument */
+		enum { ARGS_MAX_LEN = 256 };
+		char new_args[ARGS_MAX_LEN];
+
+		strncpy(new_args, args.string(), ARGS_MAX_LEN);
+
+		/* sacrifice the label to make space for the root argument */
+		Arg_string::remove_arg(new_args, "label");
+
+		Arg_string::set_arg_string(new_args, ARGS_MAX_LEN, "root", new_root.base());
+
+		Affinity affinity;
+		try { return env.session("File_system", id, new_args, affinity); }
+		catch (...) {
+			/* the root directory may have vanished at the backend */
+			root_cache.evict(label, orig_root);
+			throw;
+		}
+	}
+
+	/**
+	 * Determine root directory of a session and create it if missing
+	 */
+	Path _new_root(Session_label const &label, char const *orig_root)
 	{
 		char tmp[PATH_MAX_LEN];
 		Path root_path;
 
-		Session_label const label = label_from_args(args.string());
 		Session_policy const policy(label, config_rom.xml());
 
 		/* Use a chroot path from policy */
@@ -139,10 +256,8 @@ struct Chroot::Main
 			root_path = path_from_label<Path>(label.string());
 		}
 
-		/* extract and append the orginal root */
-		Arg_string::find_arg(args.string(), "root").string(
-			tmp, sizeof(tmp), "/");
-		root_path.append_element(tmp);
+		/* append the orginal root */
+		root_path.append_element(orig_root);
 		root_path.remove_trailing('/');
 
 		char const *new_root = root_path.base();
@@ -161,19 +276,7 @@ struct Chroot::Main
 		catch (...)                 {
 			Genode::error(new_root,": unknown error");     throw; }
 
-		/* rewrite the root session argument */
-		enum { ARGS_MAX_LEN = 256 };
-		char new_args[ARGS_MAX_LEN];
-
-		strncpy(new_args, args.string(), ARGS_MAX_LEN);
-
-		/* sacrifice the label to make space for the root argument */
-		Arg_string::remove_arg(new_args, "label");
-
-		Arg_string::set_arg_string(new_args, ARGS_MAX_LEN, "root", new_root);
-
-		Affinity affinity;
-		return env.session("File_system", id, new_args, affinity);
+		return root_path;
 	}
 };
 
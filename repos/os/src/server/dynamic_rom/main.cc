@@ -14,6 +14,7 @@
 /* Genode includes */
 #include <util/reconstructible.h>
 #include <util/arg_string.h>
+#include <util/list.h>
 #include <base/heap.h>
 #include <base/component.h>
 #include <base/session_label.h>
@@ -29,34 +30,186 @@ namespace Dynamic_rom {
 	using Genode::Entrypoint;
 	using Genode::Rpc_object;
 	using Genode::Sliced_heap;
+	using Genode::Heap;
+	using Genode::Allocator;
 	using Genode::Env;
 	using Genode::Constructible;
 	using Genode::Signal_context_capability;
 	using Genode::Signal_handler;
 	using Genode::Xml_node;
 	using Genode::Arg_string;
+	using Genode::List;
+	using Genode::size_t;
 
+	class  Timeline;
 	class  Session_component;
 	class  Root;
 	struct Main;
 }
 
 
+/**
+ * Sequence of steps of a '<rom>' node, compiled at configuration time
+ *
+ * The content of each '<inline>' step is rendered into a dataspace once.
+ * Steps with identical content share the same dataspace. Executing a step
+ * thereby requires no XML parsing. The timeline is shared by all sessions
+ * of the ROM module, each session keeps its own position. The dataspaces
+ * of the timeline are never handed out to clients.
+ */
+class Dynamic_rom::Timeline : public List<Timeline>::Element
+{
+	public:
+
+		typedef Genode::String<160> Name;
+		typedef Genode::String<200> Desc;
+
+		struct Content : List<Content>::Element
+		{
+			Genode::Attached_ram_dataspace ds;
+
+			size_t        const size;
+			unsigned long const hash;
+
+			Content(Env &env, char const *src, size_t size, unsigned long hash)
+			:
+				ds(env.ram(), env.rm(), size ? size : 1), size(size), hash(hash)
+			{
+				Genode::memcpy(ds.local_addr<char>(), src, size);
+			}
+
+			bool equals(char const *src, size_t len) const
+			{
+				return len == size
+				    && Genode::memcmp(ds.local_addr<char const>(), src, len) == 0;
+			}
+		};
+
+		struct Step
+		{
+			enum Type { CONTENT, EMPTY, SLEEP, NOP } type;
+
+			/* valid for 'CONTENT' */
+			Content const *content;
+			Desc           desc;
+
+			/* valid for 'SLEEP' */
+			unsigned long  milliseconds;
+		};
+
+	private:
+
+		Allocator &_alloc;
+
+		Name const _name;
+
+		unsigned const _num_steps;
+
+		Step *_steps;
+
+		List<Content> _contents;
+
+		static unsigned long _hash(char const *src, size_t len)
+		{
+			/* FNV-1a hash */
+			unsigned long hash = 2166136261UL;
+			for (size_t i = 0; i < len; i++)
+				hash = (hash ^ (unsigned char)src[i])*16777619UL;
+
+			return hash;
+		}
+
+		Content const &_content(Env &env, char const *src, size_t len)
+		{
+			unsigned long const hash = _hash(src, len);
+
+			for (Content const *c = _contents.first(); c; c = c->next())
+				if (c->hash == hash && c->equals(src, len))
+					return *c;
+
+			Content &content = *new (_alloc) Content(env, src, len, hash);
+			_contents.insert(&content);
+			return content;
+		}
+
+		Step _step(Env &env, Xml_node node)
+		{
+			if (node.has_type("inline"))
+				return Step { Step::CONTENT,
+				              &_content(env, node.content_addr(), node.content_size()),
+				              node.attribute_value("description", Desc()), 0 };
+
+			if (node.has_type("empty"))
+				return Step { Step::EMPTY, nullptr, Desc(), 0 };
+
+			if (node.has_type("sleep") && node.has_attribute("milliseconds"))
+				return Step { Step::SLEEP, nullptr, Desc(),
+				              node.attribute_value("milliseconds", 0UL) };
+
+			return Step { Step::NOP, nullptr, Desc(), 0 };
+		}
+
+	public:
+
+		Timeline(Env &env, Allocator &alloc, Xml_node rom_node)
+		:
+			_alloc(alloc),
+			_name(rom_node.attribute_value("name", Name())),
+			_num_steps(rom_node.num_sub_nodes()),
+			_steps((Step *)alloc.alloc(sizeof(Step)*(_num_steps ? _num_steps : 1)))
+		{
+			unsigned i = 0;
+			rom_node.for_each_sub_node([&] (Xml_node node) {
+				Genode::construct_at<Step>(&_steps[i++], _step(env, node)); });
+		}
+
+		~Timeline()
+		{
+			while (Content *c = _contents.first()) {
+				_contents.remove(c);
+				Genode::destroy(_alloc, c);
+			}
+
+			for (unsigned i = 0; i < _num_steps; i++)
+				_steps[i].~Step();
+
+			_alloc.free(_steps, sizeof(Step)*(_num_steps ? _num_steps : 1));
+		}
+
+		Name const &name() const { return _name; }
+
+		unsigned num_steps() const { return _num_steps; }
+
+		Step const &step(unsigned i) const { return _steps[i]; }
+};
+
+
 class Dynamic_rom::Session_component : public Rpc_object<Genode::Rom_session>
 {
 	private:
 
 		Env                      &_env;
 		bool                     &_verbose;
-		Xml_node                  _rom_node;
+		Timeline           const &_timeline;
 		Timer::Connection         _timer;
 		unsigned                  _curr_idx = 0;
-		bool                      _has_content = false;
-		unsigned                  _last_content_idx = ~0;
-		Signal_context_capability _sigh;
 
+		/* content of the most recent step, or nullptr if empty */
+		Timeline::Content const  *_content = nullptr;
+
+		/* content copied to '_ram_ds' */
+		Timeline::Content const  *_handed_out_content = nullptr;
+
+		/*
+		 * Dataspace handed out to the client
+		 *
+		 * Each session obtains a dataspace of its own because the client
+		 * can write to it.
+		 */
 		Constructible<Genode::Attached_ram_dataspace> _ram_ds;
 
+		Signal_context_capability _sigh;
+
 		void _notify_client()
 		{
 			if (!_sigh.valid())
@@ -74,58 +227,55 @@ class Dynamic_rom::Session_component : public Rpc_object<Genode::Rom_session>
 			if (!_verbose)
 				return;
 
-			typedef Genode::String<160> Name;
-			Genode::log(_rom_node.attribute_value("name", Name()), ": ", args...);
+			Genode::log(_timeline.name(), ": ", args...);
 		}
 
 		enum Execution_state { EXEC_CONTINUE, EXEC_BLOCK };
 
-		Execution_state _execute_step(Xml_node curr_step)
+		Execution_state _execute_step(Timeline::Step const &curr_step)
 		{
+			typedef Timeline::Step Step;
+
+			switch (curr_step.type) {
+
 			/*
 			 * Replace content of ROM module by new one. Note that the content
 			 * of the currently handed out dataspace remains untouched until
 			 * the ROM client requests the new version by calling 'dataspace'
 			 * the next time.
 			 */
-			if (curr_step.has_type("inline")) {
-				_last_content_idx = _curr_idx;
-				_has_content      = true;
+			case Step::CONTENT:
+				_content = curr_step.content;
 				_notify_client();
 
-				if (curr_step.has_attribute("description")) {
-					typedef Genode::String<200> Desc;
-					Desc desc = curr_step.attribute_value("description", Desc());
-					_log("change (", desc.string(), ")");
-				} else {
+				if (curr_step.desc.valid())
+					_log("change (", curr_step.desc, ")");
+				else
 					_log("change");
-				}
-			}
+
+				return EXEC_CONTINUE;
 
 			/*
 			 * Remove ROM module
 			 */
-			if (curr_step.has_type("empty")) {
-				_last_content_idx = ~0;;
-				_has_content      = false;
+			case Step::EMPTY:
+				_content = nullptr;
 				_notify_client();
 				_log("remove");
-			}
+				return EXEC_CONTINUE;
 
 			/*
 			 * Sleep some time
 			 *
 			 * The timer will trigger the execution of the next step.
 			 */
-			if (curr_step.has_type("sleep")
-			 && curr_step.has_attribute("milliseconds")) {
-
-				unsigned long milliseconds = 0;
-				curr_step.attribute("milliseconds").value(&milliseconds);
-				_timer.trigger_once(milliseconds*1000);
-				_log("sleep ", milliseconds, " milliseconds");
-
+			case Step::SLEEP:
+				_timer.trigger_once(curr_step.milliseconds*1000);
+				_log("sleep ", curr_step.milliseconds, " milliseconds");
 				return EXEC_BLOCK;
+
+			case Step::NOP:
+				break;
 			}
 
 			return EXEC_CONTINUE;
@@ -133,13 +283,19 @@ class Dynamic_rom::Session_component : public Rpc_object<Genode::Rom_session>
 
 		void _execute_steps_until_sleep()
 		{
-			Execution_state exec_state = EXEC_CONTINUE;
-			while (exec_state == EXEC_CONTINUE) {
+			unsigned const num_steps = _timeline.num_steps();
+
+			/* stop after one pass over a timeline without any sleep step */
+			for (unsigned i = 0; i < num_steps; i++) {
 
-				exec_state = _execute_step(_rom_node.sub_node(_curr_idx));
+				Execution_state const exec_state =
+					_execute_step(_timeline.step(_curr_idx));
 
 				/* advance step index, wrap at the end */
-				_curr_idx = (_curr_idx + 1) % _rom_node.num_sub_nodes();
+				_curr_idx = (_curr_idx + 1) % num_steps;
+
+				if (exec_state == EXEC_BLOCK)
+					break;
 			}
 		}
 
@@ -152,9 +308,10 @@ class Dynamic_rom::Session_component : public Rpc_object<Genode::Rom_session>
 
 	public:
 
-		Session_component(Env &env, Xml_node rom_node, bool &verbose)
+		Session_component(Env &env, Timeline const &timeline, bool &verbose)
 		:
-			_env(env), _verbose(verbose), _rom_node(rom_node), _timer(env), _ep(env.ep())
+			_env(env), _verbose(verbose), _timeline(timeline), _timer(env),
+			_ep(env.ep())
 		{
 			/* init timer signal handler */
 			_timer.sigh(_timer_handler);
@@ -167,19 +324,18 @@ class Dynamic_rom::Session_component : public Rpc_object<Genode::Rom_session>
 		{
 			using namespace Genode;
 
-			if (!_has_content)
+			if (!_content)
 				return Rom_dataspace_capability();
 
-			/* replace dataspace by new one */
-			_ram_ds.construct(_env.ram(), _env.rm(), _rom_node.size());
-
-			/* fill with content of current step */
-			Xml_node step_node = _rom_node.sub_node(_last_content_idx);
-			memcpy(_ram_ds->local_addr<char>(),
-			       step_node.content_addr(),
-			       step_node.content_size());
+			/* copy the pre-rendered content into a fresh dataspace */
+			if (_content != _handed_out_content || !_ram_ds.constructed()) {
+				_ram_ds.destruct();
+				_ram_ds.construct(_env.ram(), _env.rm(), _content->ds.size());
+				memcpy(_ram_ds->local_addr<char>(),
+				       _content->ds.local_addr<char const>(), _content->size);
+				_handed_out_content = _content;
+			}
 
-			/* cast RAM into ROM dataspace capability */
 			Dataspace_capability ds_cap = static_cap_cast<Dataspace>(_ram_ds->cap());
 			return static_cap_cast<Rom_dataspace>(ds_cap);
 		}
@@ -196,20 +352,19 @@ class Dynamic_rom::Root : public Genode::Root_component<Session_component>
 	private:
 
 		Env        &_env;
-		Xml_node    _config_node;
+		Allocator  &_timeline_alloc;
 		bool       &_verbose;
 
+		List<Timeline> _timelines;
+
 		class Nonexistent_rom_module { };
 
-		Xml_node _lookup_rom_node_in_config(Genode::Session_label const &name)
+		Timeline const &_lookup_timeline(Genode::Session_label const &name)
 		{
-			/* lookup ROM module in config */
-			for (unsigned i = 0; i < _config_node.num_sub_nodes(); i++) {
-				Xml_node node = _config_node.sub_node(i);
-				if (node.has_attribute("name")
-				 && node.attribute("name").has_value(name.string()))
-					return node;
-			}
+			for (Timeline const *t = _timelines.first(); t; t = t->next())
+				if (t->name() == name)
+					return *t;
+
 			throw Nonexistent_rom_module();
 		}
 
@@ -225,8 +380,7 @@ class Dynamic_rom::Root : public Genode::Root_component<Session_component>
 
 			try {
 				return new (md_alloc())
-					Session_component(_env,
-					                  _lookup_rom_node_in_config(module_name),
+					Session_component(_env, _lookup_timeline(module_name),
 					                  _verbose);
 			}
 			catch (Nonexistent_rom_module) {
@@ -237,12 +391,31 @@ class Dynamic_rom::Root : public Genode::Root_component<Session_component>
 
 	public:
 
-		Root(Env &env, Genode::Allocator &md_alloc,
+		/**
+		 * Constructor
+		 *
+		 * \param timeline_alloc  allocator for the timelines compiled from
+		 *                        the '<rom>' nodes of the config
+		 */
+		Root(Env &env, Allocator &md_alloc, Allocator &timeline_alloc,
 		     Xml_node config_node, bool &verbose)
 		:
 			Genode::Root_component<Session_component>(&env.ep().rpc_ep(), &md_alloc),
-			_env(env), _config_node(config_node), _verbose(verbose)
-		{ }
+			_env(env), _timeline_alloc(timeline_alloc), _verbose(verbose)
+		{
+			config_node.for_each_sub_node("rom", [&] (Xml_node node) {
+				if (node.has_attribute("name"))
+					_timelines.insert(new (timeline_alloc)
+						Timeline(env, timeline_alloc, node)); });
+		}
+
+		~Root()
+		{
+			while (Timeline *t = _timelines.first()) {
+				_timelines.remove(t);
+				Genode::destroy(_timeline_alloc, t);
+			}
+		}
 };
 
 
@@ -256,7 +429,9 @@ struct Dynamic_rom::Main
 
 	Sliced_heap sliced_heap { env.ram(), env.rm() };
 
-	Root root { env, sliced_heap, config.xml(), verbose };
+	Heap heap { env.ram(), env.rm() };
+
+	Root root { env, sliced_heap, heap, config.xml(), verbose };
 
 	Main(Env &env) : env(env)
 	{
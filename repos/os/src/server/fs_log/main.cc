@@ -22,6 +22,7 @@
 #include <root/component.h>
 #include <base/component.h>
 #include <base/log.h>
+#include <timer_session/connection.h>
 
 /* Local includes */
 #include "session.h"
@@ -34,7 +35,7 @@ namespace Fs_log {
 	class  Root_component;
 
 	enum {
-		PACKET_SIZE = Log_session::String::MAX_SIZE,
+		PACKET_SIZE = BUFFER_SIZE,
 		 QUEUE_SIZE = File_system::Session::TX_QUEUE_SIZE,
 		TX_BUF_SIZE = PACKET_SIZE * (QUEUE_SIZE+2)
 	};
@@ -45,7 +46,8 @@ namespace Fs_log {
 
 
 class Fs_log::Root_component :
-	public Genode::Root_component<Fs_log::Session_component>
+	public Genode::Root_component<Fs_log::Session_component>,
+	private Fs_log::Flush_scheduler
 {
 	private:
 
@@ -56,11 +58,63 @@ class Fs_log::Root_component :
 		File_system::Connection         _fs
 			{ _env, _tx_alloc, "", "/", true, TX_BUF_SIZE };
 
-		void _update_config() { _config_rom.update(); }
+		enum { DEFAULT_FLUSH_MS = 100 };
+
+		unsigned _flush_ms = DEFAULT_FLUSH_MS;
+
+		void _update_config()
+		{
+			_config_rom.update();
+			_flush_ms = _config_rom.xml().attribute_value("flush_ms",
+			                                              (unsigned)DEFAULT_FLUSH_MS);
+		}
 
 		Genode::Signal_handler<Root_component> _config_handler
 			{ _env.ep(), *this, &Root_component::_update_config };
 
+		Genode::List<Session_component> _sessions;
+
+		/* sessions with buffered messages that await a packet */
+		bool _pending = false;
+
+		void _flush_sessions()
+		{
+			_pending = false;
+			for (Session_component *s = _sessions.first(); s; s = s->next())
+				if (!s->flush())
+					_pending = true;
+		}
+
+		Timer::Connection _timer { _env };
+
+		void _handle_flush_timeout(Duration) { _flush_sessions(); }
+
+		Timer::One_shot_timeout<Root_component> _flush_timeout
+			{ _timer, *this, &Root_component::_handle_flush_timeout };
+
+		/**
+		 * Retry flushing once the file system acknowledged packets
+		 */
+		void _handle_ack_avail()
+		{
+			if (_pending)
+				_flush_sessions();
+		}
+
+		Genode::Signal_handler<Root_component> _ack_avail_handler
+			{ _env.ep(), *this, &Root_component::_handle_ack_avail };
+
+
+		/*********************
+		 ** Flush_scheduler **
+		 *********************/
+
+		void schedule_flush() override
+		{
+			if (!_flush_timeout.scheduled())
+				_flush_timeout.schedule(Microseconds(_flush_ms*1000UL));
+		}
+
 	protected:
 
 		Session_component *_create_session(const char *args)
@@ -79,10 +133,13 @@ class Fs_log::Root_component :
 			char const *label_str = session_label.string();
 			char const *label_prefix = "";
 			bool truncate = false;
+			Line_options options;
 
 			try {
 				Session_policy policy(session_label, _config_rom.xml());
 				truncate = policy.attribute_value("truncate", truncate);
+				options.sequence  = policy.attribute_value("sequence",  false);
+				options.timestamp = policy.attribute_value("timestamp", false);
 				bool merge = policy.attribute_value("merge", false);
 
 				/* only a match on 'label_prefix' can be merged */
@@ -148,7 +205,11 @@ class Fs_log::Root_component :
 					                 File_system::WRITE_ONLY, true));
 				}
 
-				return new (md_alloc()) Session_component(_fs, *handle, label_prefix);
+				Session_component *session = new (md_alloc())
+					Session_component(_fs, *handle, label_prefix, _timer,
+					                  *this, options);
+				_sessions.insert(session);
+				return session;
 			}
 			catch (Permission_denied) {
 				errstr = "permission denied"; }
@@ -171,6 +232,12 @@ class Fs_log::Root_component :
 			throw Service_denied();
 		}
 
+		void _destroy_session(Session_component *session) override
+		{
+			_sessions.remove(session);
+			Genode::destroy(md_alloc(), session);
+		}
+
 	public:
 
 		/**
@@ -182,6 +249,9 @@ class Fs_log::Root_component :
 			_env(env)
 		{
 			_config_rom.sigh(_config_handler);
+			_update_config();
+
+			_fs.sigh_ack_avail(_ack_avail_handler);
 
 			/* fill the ack queue with packets so sessions never need to alloc */
 			File_system::Session::Tx::Source &source = *_fs.tx();
@@ -3,8 +3,10 @@
  * \author Emery Hemingway
  * \date   2015-05-16
  *
- * Message writing is fire-and-forget to prevent
- * logging from becoming I/O bound.
+ * Messages are buffered per session and written in batches to prevent
+ * logging from becoming I/O bound. A client never waits for the file
+ * system. If no packet is available while the buffer is full, messages
+ * are dropped and the number of dropped messages is noted in the log.
  */
 
 /*
@@ -23,32 +25,170 @@
 #include <base/rpc_server.h>
 #include <base/snprintf.h>
 #include <base/log.h>
+#include <timer_session/connection.h>
+#include <util/list.h>
 
 namespace Fs_log {
 
-	enum { MAX_LABEL_LEN = 128 };
+	enum {
+		MAX_LABEL_LEN  = 128,
+		MAX_PREFIX_LEN = 48,
+		BUFFER_SIZE    = 2048,
+		MAX_LINE_LEN   = MAX_LABEL_LEN + MAX_PREFIX_LEN
+		               + Genode::Log_session::MAX_STRING_LEN,
+	};
+
+	struct Flush_scheduler;
+	struct Line_options;
 
 	class Session_component;
 }
 
-class Fs_log::Session_component : public Genode::Rpc_object<Genode::Log_session>
+
+/**
+ * Interface for requesting the time-based flushing of session buffers
+ */
+struct Fs_log::Flush_scheduler
+{
+	virtual ~Flush_scheduler() { }
+
+	virtual void schedule_flush() = 0;
+};
+
+
+/**
+ * Per-line information prepended to each message
+ */
+struct Fs_log::Line_options
+{
+	bool sequence  = false;
+	bool timestamp = false;
+};
+
+
+class Fs_log::Session_component : public Genode::Rpc_object<Genode::Log_session>,
+                                  public Genode::List<Session_component>::Element
 {
 	private:
 
+		typedef File_system::Packet_descriptor Packet_descriptor;
+
 		char _label_buf[MAX_LABEL_LEN];
 		Genode::size_t const _label_len;
 
 		File_system::Session          &_fs;
 		File_system::File_handle const _handle;
 
+		Timer::Connection  &_timer;
+		Flush_scheduler    &_flush_scheduler;
+		Line_options const  _options;
+
+		char           _buf[BUFFER_SIZE];
+		Genode::size_t _used = 0;
+
+		unsigned long _sequence = 0;
+		unsigned long _dropped  = 0;
+
+		/**
+		 * Obtain acknowledged packet from the file system
+		 *
+		 * \param block  wait for a packet if none is available
+		 *
+		 * \return false if no packet is available
+		 */
+		bool _acked_packet(Packet_descriptor &packet, bool block)
+		{
+			File_system::Session::Tx::Source &source = *_fs.tx();
+
+			if (!block && !source.ack_avail())
+				return false;
+
+			packet = source.get_acked_packet();
+
+			/* the handle of a closed session is released with its sync */
+			if (packet.operation() == Packet_descriptor::SYNC)
+				_fs.close(packet.handle());
+
+			return true;
+		}
+
+		void _append(char const *str, Genode::size_t len)
+		{
+			Genode::memcpy(_buf + _used, str, len);
+			_used += len;
+		}
+
+		void _append_dropped()
+		{
+			if (!_dropped)
+				return;
+
+			char note[64];
+			Genode::snprintf(note, sizeof(note),
+			                 "[fs_log: %lu messages dropped]\n", _dropped);
+			_append(note, Genode::strlen(note));
+			_dropped = 0;
+		}
+
+		Genode::size_t _prefix(char *dst, Genode::size_t dst_len)
+		{
+			Genode::size_t len = 0;
+
+			if (_options.sequence)
+				len += Genode::snprintf(dst + len, dst_len - len,
+				                        "%lu ", _sequence);
+
+			if (_options.timestamp) {
+				unsigned long const ms =
+					_timer.curr_time().trunc_to_plain_ms().value;
+				len += Genode::snprintf(dst + len, dst_len - len,
+				                        "%lu.%03lu ", ms / 1000, ms % 1000);
+			}
+			return len;
+		}
+
+		/**
+		 * Write buffer content to the file system
+		 *
+		 * \return false if the buffer could not be written without blocking
+		 */
+		bool _flush(bool block)
+		{
+			if (!_used)
+				return true;
+
+			Packet_descriptor packet;
+			if (!_acked_packet(packet, block))
+				return false;
+
+			packet = Packet_descriptor(packet, _handle, Packet_descriptor::WRITE,
+			                           _used, File_system::SEEK_TAIL);
+
+			File_system::Session::Tx::Source &source = *_fs.tx();
+			Genode::memcpy(source.packet_content(packet), _buf, _used);
+			source.submit_packet(packet);
+
+			_used = 0;
+
+			_append_dropped();
+			if (_used)
+				_flush_scheduler.schedule_flush();
+
+			return true;
+		}
+
 	public:
 
 		Session_component(File_system::Session     &fs,
 		                  File_system::File_handle  handle,
-		                  char               const *label)
+		                  char               const *label,
+		                  Timer::Connection        &timer,
+		                  Flush_scheduler          &flush_scheduler,
+		                  Line_options              options)
 		:
 			_label_len(Genode::strlen(label) ? Genode::strlen(label)+3 : 0),
-			_fs(fs), _handle(handle)
+			_fs(fs), _handle(handle), _timer(timer),
+			_flush_scheduler(flush_scheduler), _options(options)
 		{
 			if (_label_len)
 				Genode::snprintf(_label_buf, MAX_LABEL_LEN, "[%s] ", label);
@@ -56,21 +196,27 @@ class Fs_log::Session_component : public Genode::Rpc_object<Genode::Log_session>
 
 		~Session_component()
 		{
-			/* sync */
-
-			File_system::Session::Tx::Source &source = *_fs.tx();
+			/* write pending messages, including a note about dropped ones */
 
-			File_system::Packet_descriptor packet = source.get_acked_packet();
+			_flush(true);
+			_flush(true);
 
-			if (packet.operation() == File_system::Packet_descriptor::SYNC)
-				_fs.close(packet.handle());
+			Packet_descriptor packet;
+			_acked_packet(packet, true);
 
-			packet = File_system::Packet_descriptor(
-				packet, _handle, File_system::Packet_descriptor::SYNC, 0, 0);
+			packet = Packet_descriptor(
+				packet, _handle, Packet_descriptor::SYNC, 0, 0);
 
-			source.submit_packet(packet);
+			_fs.tx()->submit_packet(packet);
 		}
 
+		/**
+		 * Flush buffered messages if possible without blocking
+		 *
+		 * \return false if no packet was available
+		 */
+		bool flush() { return _flush(false); }
+
 
 		/*****************
 		 ** Log session **
@@ -85,44 +231,33 @@ class Fs_log::Session_component : public Genode::Rpc_object<Genode::Log_session>
 				return 0;
 			}
 
-			size_t msg_len = strlen(msg.string());
-
-			File_system::Session::Tx::Source &source = *_fs.tx();
-
-			File_system::Packet_descriptor packet = source.get_acked_packet();
-
-			if (packet.operation() == File_system::Packet_descriptor::SYNC)
-				_fs.close(packet.handle());
+			size_t const msg_len = strlen(msg.string());
 
-			packet = File_system::Packet_descriptor(
-				packet, _handle, File_system::Packet_descriptor::WRITE,
-				msg_len, File_system::SEEK_TAIL);
+			++_sequence;
 
-			char *buf = source.packet_content(packet);
+			if (_used + MAX_LINE_LEN > BUFFER_SIZE && !_flush(false)) {
+				++_dropped;
+				return 0;
+			}
 
-			if (_label_len) {
-				memcpy(buf, _label_buf, _label_len);
+			bool const was_empty = !_used;
 
-				if (_label_len+msg_len > Log_session::String::MAX_SIZE) {
-					packet.length(msg_len);
-					source.submit_packet(packet);
+			char   prefix[MAX_PREFIX_LEN];
+			size_t prefix_len = _prefix(prefix, sizeof(prefix));
 
-					packet =  File_system::Packet_descriptor(
-						source.get_acked_packet(),
-				       _handle, File_system::Packet_descriptor::WRITE,
-				       msg_len, File_system::SEEK_TAIL);
+			if (_label_len)
+				_append(_label_buf, _label_len);
 
-					buf = source.packet_content(packet);
+			_append(prefix, prefix_len);
+			_append(msg.string(), msg_len);
 
-				} else {
-					buf += _label_len;
-					packet.length(_label_len+msg_len);
-				}
-			}
+			/* flush early to keep room for the next message */
+			if (_used + MAX_LINE_LEN > BUFFER_SIZE)
+				_flush(false);
 
-			memcpy(buf, msg.string(), msg_len);
+			if (was_empty && _used)
+				_flush_scheduler.schedule_flush();
 
-			source.submit_packet(packet);
 			return msg_len;
 		}
 };
@@ -78,6 +78,57 @@ class Fs_report::Session_component : public Genode::Rpc_object<Report::Session>
 		file_size   _file_size = 0;
 		bool        _success = true;
 
+		/**
+		 * Write content of the report buffer to the file at 'offset'
+		 */
+		bool _write(file_size const offset, size_t const length)
+		{
+			typedef Vfs::File_io_service::Write_result Write_result;
+
+			size_t written = 0;
+			while (written < length) {
+				file_size n = 0;
+
+				_handle->seek(offset + written);
+				Write_result res = _handle->fs().write(
+					_handle, _ds.local_addr<char const>()+written,
+					length - written, n);
+
+				if (res != Write_result::WRITE_OK) {
+					/* do not spam the log */
+					if (_success)
+						error("failed to write report to '", _leaf_path, "'");
+					_file_size = 0;
+					_success = false;
+					return false;
+				}
+
+				written += n;
+			}
+			return true;
+		}
+
+		void _sync(file_size const length)
+		{
+			if (_file_size != length)
+				_handle->fs().ftruncate(_handle, length);
+
+			_file_size = length;
+			_success = true;
+
+			/* flush to notify watchers */
+			while (!_handle->fs().queue_sync(_handle))
+				_ep.wait_and_dispatch_one_io_signal();
+
+			while (_handle->fs().complete_sync(_handle) ==
+			       Vfs::File_io_service::SYNC_QUEUED)
+				_ep.wait_and_dispatch_one_io_signal();
+		}
+
+		/* offset of the next chunk of a chunked report */
+		file_size _chunk_offset = 0;
+		bool      _chunks_ok    = true;
+
 	public:
 
 		Session_component(Genode::Env                 &env,
@@ -130,42 +181,34 @@ class Fs_report::Session_component : public Genode::Rpc_object<Report::Session>
 		{
 			/* TODO: close and reopen on error */
 
-			typedef Vfs::File_io_service::Write_result Write_result;
+			_chunk_offset = 0;
+			_chunks_ok    = true;
 
-			if (_file_size != length)
-				_handle->fs().ftruncate(_handle, length);
-
-			size_t offset = 0;
-			while (offset < length) {
-				file_size n = 0;
-
-				_handle->seek(offset);
-				Write_result res = _handle->fs().write(
-					_handle, _ds.local_addr<char const>()+offset,
-					length - offset, n);
+			if (_write(0, length))
+				_sync(length);
+		}
 
-				if (res != Write_result::WRITE_OK) {
-					/* do not spam the log */
-					if (_success)
-						error("failed to write report to '", _leaf_path, "'");
-					_file_size = 0;
-					_success = false;
-					return;
-				}
+		/*
+		 * Each chunk is written to the file directly, which spares the
+		 * assembly of the report in memory.
+		 */
+		void submit_chunk(size_t length, bool last) override
+		{
+			length = min(length, _ds.size());
 
-				offset += n;
-			}
+			if (_chunks_ok && _write(_chunk_offset, length))
+				_chunk_offset += length;
+			else
+				_chunks_ok = false;
 
-			_file_size = length;
-			_success = true;
+			if (!last)
+				return;
 
-			/* flush to notify watchers */
-			while (!_handle->fs().queue_sync(_handle))
-				_ep.wait_and_dispatch_one_io_signal();
+			if (_chunks_ok)
+				_sync(_chunk_offset);
 
-			while (_handle->fs().complete_sync(_handle) ==
-			       Vfs::File_io_service::SYNC_QUEUED)
-				_ep.wait_and_dispatch_one_io_signal();
+			_chunk_offset = 0;
+			_chunks_ok    = true;
 		}
 
 		void response_sigh(Genode::Signal_context_capability) override { }
@@ -33,9 +33,11 @@ namespace Fs_rom {
 
 	struct Packet_handler;
 
+	class Cached_file;
 	class Rom_session_component;
 	class Rom_root;
 
+	typedef List<Cached_file>           Cached_files;
 	typedef List<Rom_session_component> Sessions;
 
 	typedef File_system::Session_client::Tx::Source Tx_source;
@@ -43,19 +45,48 @@ namespace Fs_rom {
 
 
 /**
- * A 'Rom_session_component' exports a single file of the file system
+ * A 'Cached_file' holds the content of a file of the file system
+ *
+ * The content is shared by all ROM sessions that refer to the same file.
+ * It is read from the file system only if the file was changed since the
+ * last read, as indicated by the file-system watch. Each version of the
+ * content is read into a dedicated dataspace, which stays allocated as long
+ * as a ROM session refers to it.
  */
-class Fs_rom::Rom_session_component : public Rpc_object<Rom_session>,
-                                      public Sessions::Element
+class Fs_rom::Cached_file : public Cached_files::Element
 {
+	public:
+
+		enum { PATH_MAX_LEN = 512 };
+		typedef Genode::Path<PATH_MAX_LEN> Path;
+
+		/*
+		 * Version number used to track the need for ROM update notifications
+		 */
+		struct Version { unsigned value; };
+
+		/**
+		 * Dataspace holding one version of the file content
+		 */
+		struct Content
+		{
+			Attached_ram_dataspace ds;
+
+			/**
+			 * Number of ROM sessions that obtained the dataspace
+			 */
+			unsigned users = 0;
+
+			Content(Env &env, size_t size) : ds(env.ram(), env.rm(), size) { }
+		};
+
 	private:
 
 		Env &_env;
 
-		File_system::Session &_fs;
+		Allocator &_alloc;
 
-		enum { PATH_MAX_LEN = 512 };
-		typedef Genode::Path<PATH_MAX_LEN> Path;
+		File_system::Session &_fs;
 
 		/**
 		 * Name of requested file, interpreted at path into the file system
@@ -86,26 +117,33 @@ class Fs_rom::Rom_session_component : public Rpc_object<Rom_session>,
 		Constructible<File_system::Dir_handle> _compound_dir_handle;
 
 		/**
-		 * Dataspace exposed as ROM module to the client
+		 * Most recent content, handed out to the clients
 		 */
-		Attached_ram_dataspace _file_ds;
+		Content *_curr_content = nullptr;
 
 		/**
-		 * Signal destination for ROM file changes
+		 * Content currently being read from the file system
 		 */
-		Signal_context_capability _sigh;
+		Content *_read_content = nullptr;
+
+		bool _read_failed = false;
+
+		/**
+		 * True if '_curr_content' does not reflect the current file content
+		 */
+		bool _stale = true;
+
+		/**
+		 * Number of ROM sessions referring to the file
+		 */
+		unsigned _users = 0;
 
 		/*
 		 * Exception
 		 */
 		struct Open_compound_dir_failed { };
 
-		/*
-		 * Version number used to track the need for ROM update notifications
-		 */
-		struct Version { unsigned value; };
-		Version _curr_version       { 0 };
-		Version _handed_out_version { ~0U };
+		Version _curr_version { 0 };
 
 		/**
 		 * Open compound directory of specified file
@@ -207,33 +245,24 @@ class Fs_rom::Rom_session_component : public Rpc_object<Rom_session>,
 				warning("could not track compound dir, giving up"); }
 		}
 
+		void _release_if_unused(Content *content)
+		{
+			if (content && content != _curr_content && content->users == 0)
+				destroy(_alloc, content);
+		}
+
 		/**
-		 * Initialize '_file_ds' dataspace with file content
+		 * Read the current file content into a new dataspace
+		 *
+		 * On each repeated call of this function, a fresh dataspace is
+		 * allocated for the most current file content. The dataspace of
+		 * the previous version is kept until the last session that
+		 * obtained it moves on.
 		 */
-		void _update_dataspace()
+		void _update_content()
 		{
 			using namespace File_system;
 
-			/*
-			 * On each repeated call of this function, the dataspace is
-			 * replaced with a new one that contains the most current file
-			 * content. The dataspace is re-allocated if the new version
-			 * of the file has become bigger.
-			 */
-			try {
-				File_handle const file_handle = _open_file(_fs, _file_path);
-				File_system::file_size_t const new_file_size =
-					_fs.status(file_handle).size;
-
-				if (_file_ds.size() && (new_file_size > _file_size)) {
-					/* mark as invalid */
-					_file_ds.realloc(&_env.ram(), 0);
-					_file_size = 0;
-					_file_seek = 0;
-				}
-				_fs.close(file_handle);
-			} catch (Open_file_failed) { }
-
 			/* close and then re-open the file */
 			if (_file_handle.constructed()) {
 				_fs.close(*_file_handle);
@@ -261,24 +290,21 @@ class Fs_rom::Rom_session_component : public Rpc_object<Rom_session>,
 			size_t const file_size = _file_handle.constructed()
 			                       ? _fs.status(*_file_handle).size : 0;
 
-			/* allocate new RAM dataspace according to file size */
-			if (file_size > 0) {
-				try {
-					_file_seek = 0;
-					_file_ds.realloc(&_env.ram(), file_size);
-					_file_size = file_size;
-				} catch (...) {
-					error("couldn't allocate memory for file, empty result");
-					return;
-				}
-			} else {
+			if (file_size == 0) {
 				_register_for_compound_dir_changes();
 				return;
 			}
 
-			/* omit read if file is empty */
-			if (_file_size == 0)
+			/* allocate new RAM dataspace according to file size */
+			try {
+				_read_content = new (_alloc) Content(_env, file_size);
+			} catch (...) {
+				error("couldn't allocate memory for file, keep previous content");
 				return;
+			}
+			_file_size   = file_size;
+			_file_seek   = 0;
+			_read_failed = false;
 
 			/* read content from file */
 			Tx_source &source = *_fs.tx();
@@ -305,12 +331,19 @@ class Fs_rom::Rom_session_component : public Rpc_object<Rom_session>,
 				while (_file_seek == orig_file_seek)
 					_env.ep().wait_and_dispatch_one_io_signal();
 			}
-		}
 
-		void _notify_client_about_new_version()
-		{
-			if (_sigh.valid() && _curr_version.value != _handed_out_version.value)
-				Signal_transmitter(_sigh).submit();
+			Content * const content = _read_content;
+			_read_content = nullptr;
+
+			if (_read_failed) {
+				destroy(_alloc, content);
+				return;
+			}
+
+			/* replace current content, free it if no session refers to it */
+			Content * const prev_content = _curr_content;
+			_curr_content = content;
+			_release_if_unused(prev_content);
 		}
 
 	public:
@@ -318,19 +351,15 @@ class Fs_rom::Rom_session_component : public Rpc_object<Rom_session>,
 		/**
 		 * Constructor
 		 *
-		 * \param fs        file-system session to read the file from
-		 * \param filename  requested file name
-		 * \param sig_rec   signal receiver used to get notified about changes
-		 *                  within the compound directory (in the case when
-		 *                  the requested file could not be found at session-
-		 *                  creation time)
+		 * \param alloc      allocator for the content dataspaces
+		 * \param fs         file-system session to read the file from
+		 * \param file_path  requested file name
 		 */
-		Rom_session_component(Env &env,
-		                      File_system::Session &fs, const char *file_path)
+		Cached_file(Env &env, Allocator &alloc, File_system::Session &fs,
+		            const char *file_path)
 		:
-			_env(env), _fs(fs),
-			_file_path(file_path),
-			_file_ds(env.ram(), env.rm(), 0) /* realloc later */
+			_env(env), _alloc(alloc), _fs(fs),
+			_file_path(file_path)
 		{
 			try {
 				_file_handle.construct(_open_file(_fs, _file_path));
@@ -342,7 +371,7 @@ class Fs_rom::Rom_session_component : public Rpc_object<Rom_session>,
 		/**
 		 * Destructor
 		 */
-		~Rom_session_component()
+		~Cached_file()
 		{
 			/* close re-open the file */
 			if (_file_handle.constructed())
@@ -350,27 +379,64 @@ class Fs_rom::Rom_session_component : public Rpc_object<Rom_session>,
 
 			if (_compound_dir_handle.constructed())
 				_fs.close(*_compound_dir_handle);
+
+			if (_curr_content)
+				destroy(_alloc, _curr_content);
 		}
 
+		Path const &path() const { return _file_path; }
+
+		Version curr_version() const { return _curr_version; }
+
+		void add_user()    { _users++; }
+		void remove_user() { _users--; }
+
+		bool in_use() const { return _users > 0; }
+
 		/**
-		 * Return dataspace with up-to-date content of file
+		 * Obtain up-to-date content of file
+		 *
+		 * The file is read only if it changed since the previous call. The
+		 * returned content must be released via 'release_content'.
+		 *
+		 * \return  content, or nullptr if no content is available
 		 */
-		Rom_dataspace_capability dataspace()
+		Content *acquire_content()
 		{
-			_update_dataspace();
-			Dataspace_capability ds = _file_ds.cap();
-			_handed_out_version = _curr_version;
-			return static_cap_cast<Rom_dataspace>(ds);
+			if (_stale) {
+				_stale = false;
+				_update_content();
+			}
+			if (_curr_content)
+				_curr_content->users++;
+
+			return _curr_content;
 		}
 
-		void sigh(Signal_context_capability sigh)
+		/**
+		 * Release content obtained via 'acquire_content'
+		 */
+		void release_content(Content *content)
 		{
-			_sigh = sigh;
-			_notify_client_about_new_version();
+			if (!content)
+				return;
+
+			content->users--;
+			_release_if_unused(content);
 		}
 
 		/**
-		 * If packet corresponds to this session then process and return true.
+		 * Return true if the packet reports a change of the file
+		 */
+		bool changed_by(File_system::Packet_descriptor const packet) const
+		{
+			return packet.operation() == File_system::Packet_descriptor::CONTENT_CHANGED
+			    && ((_file_handle.constructed() && (*_file_handle == packet.handle())) ||
+			        (_compound_dir_handle.constructed() && (*_compound_dir_handle == packet.handle())));
+		}
+
+		/**
+		 * If packet corresponds to this file then process and return true.
 		 *
 		 * Called from the signal handler.
 		 */
@@ -380,29 +446,30 @@ class Fs_rom::Rom_session_component : public Rpc_object<Rom_session>,
 
 			case File_system::Packet_descriptor::CONTENT_CHANGED:
 
-				_curr_version = Version { _curr_version.value + 1 };
+				if (!changed_by(packet))
+					return false;
 
-				if ((_file_handle.constructed() && (*_file_handle == packet.handle())) ||
-				    (_compound_dir_handle.constructed() && (*_compound_dir_handle == packet.handle())))
-				{
-					_notify_client_about_new_version();
-					return true;
-				}
-				return false;
+				_curr_version = Version { _curr_version.value + 1 };
+				_stale = true;
+				return true;
 
 			case File_system::Packet_descriptor::READ: {
 
 				if (!(_file_handle.constructed() && (*_file_handle == packet.handle())))
 					return false;
 
+				if (!_read_content)
+					return true;
+
 				if (packet.position() > _file_seek || _file_seek >= _file_size) {
 					error("bad packet seek position");
-					_file_ds.realloc(&_env.ram(), 0);
+					_read_failed = true;
+					_file_seek   = _file_size;
 					return true;
 				}
 
 				size_t const n = min(packet.length(), _file_size - _file_seek);
-				memcpy(_file_ds.local_addr<char>()+_file_seek,
+				memcpy(_read_content->ds.local_addr<char>()+_file_seek,
 				       _fs.tx()->packet_content(packet), n);
 				_file_seek += n;
 				return true;
@@ -417,22 +484,111 @@ class Fs_rom::Rom_session_component : public Rpc_object<Rom_session>,
 		}
 };
 
+
+/**
+ * A 'Rom_session_component' exports a single file of the file system
+ */
+class Fs_rom::Rom_session_component : public Rpc_object<Rom_session>,
+                                      public Sessions::Element
+{
+	private:
+
+		Cached_file &_file;
+
+		/**
+		 * Signal destination for ROM file changes
+		 */
+		Signal_context_capability _sigh;
+
+		Cached_file::Version _handed_out_version { ~0U };
+
+		/**
+		 * Content handed out to the client
+		 */
+		Cached_file::Content *_content = nullptr;
+
+	public:
+
+		Rom_session_component(Cached_file &file) : _file(file)
+		{
+			_file.add_user();
+		}
+
+		~Rom_session_component()
+		{
+			_file.release_content(_content);
+			_file.remove_user();
+		}
+
+		Cached_file &file() { return _file; }
+
+		void notify_client_about_new_version()
+		{
+			if (_sigh.valid() && _file.curr_version().value != _handed_out_version.value)
+				Signal_transmitter(_sigh).submit();
+		}
+
+		/**
+		 * Return dataspace with up-to-date content of file
+		 */
+		Rom_dataspace_capability dataspace()
+		{
+			/* acquire new content before releasing the one handed out before */
+			Cached_file::Content * const content = _file.acquire_content();
+			_file.release_content(_content);
+			_content = content;
+
+			_handed_out_version = _file.curr_version();
+
+			if (!_content)
+				return Rom_dataspace_capability();
+
+			Dataspace_capability ds = _content->ds.cap();
+			return static_cap_cast<Rom_dataspace>(ds);
+		}
+
+		void sigh(Signal_context_capability sigh)
+		{
+			_sigh = sigh;
+			notify_client_about_new_version();
+		}
+};
+
+
 struct Fs_rom::Packet_handler : Io_signal_handler<Packet_handler>
 {
 	Tx_source &source;
 
+	/* list of files with open sessions */
+	Cached_files files;
+
 	/* list of open sessions */
 	Sessions sessions;
 
+	void _notify_sessions(Cached_file &file)
+	{
+		for (Rom_session_component *session = sessions.first();
+		     session; session = session->next())
+		{
+			if (&session->file() == &file)
+				session->notify_client_about_new_version();
+		}
+	}
+
 	void handle_packets()
 	{
 		while (source.ack_avail()) {
 			File_system::Packet_descriptor pack = source.get_acked_packet();
-			for (Rom_session_component *session = sessions.first();
-			     session; session = session->next())
+			for (Cached_file *file = files.first(); file; file = file->next())
 			{
-				if (session->process_packet(pack))
-					break;
+				bool const changed = file->changed_by(pack);
+
+				if (!file->process_packet(pack))
+					continue;
+
+				if (changed)
+					_notify_sessions(*file);
+				break;
 			}
 			source.release_packet(pack);
 		}
@@ -460,14 +616,42 @@ class Fs_rom::Rom_root : public Root_component<Fs_rom::Rom_session_component>
 
 		Packet_handler _packet_handler { _env.ep(), *_fs.tx() };
 
+		/**
+		 * Return cached file for the specified path, create it on demand
+		 */
+		Cached_file &_cached_file(char const *file_path)
+		{
+			Cached_file::Path const path(file_path);
+
+			for (Cached_file *file = _packet_handler.files.first();
+			     file; file = file->next())
+				if (file->path().equals(path))
+					return *file;
+
+			Cached_file *file = new (_heap) Cached_file(_env, _heap, _fs, file_path);
+			_packet_handler.files.insert(file);
+			return *file;
+		}
+
 		Rom_session_component *_create_session(const char *args) override
 		{
 			Session_label const label = label_from_args(args);
 			Session_label const module_name = label.last_element();
 
+			Cached_file &file = _cached_file(module_name.string());
+
 			/* create new session for the requested file */
-			Rom_session_component *session = new (md_alloc())
-				Rom_session_component(_env, _fs, module_name.string());
+			Rom_session_component *session = nullptr;
+			try {
+				session = new (md_alloc()) Rom_session_component(file);
+			}
+			catch (...) {
+				if (!file.in_use()) {
+					_packet_handler.files.remove(&file);
+					Genode::destroy(_heap, &file);
+				}
+				throw;
+			}
 
 			_packet_handler.sessions.insert(session);
 			return session;
@@ -475,8 +659,16 @@ class Fs_rom::Rom_root : public Root_component<Fs_rom::Rom_session_component>
 
 		void _destroy_session(Rom_session_component *session) override
 		{
+			Cached_file &file = session->file();
+
 			_packet_handler.sessions.remove(session);
 			Genode::destroy(md_alloc(), session);
+
+			/* release the file content with the last session */
+			if (!file.in_use()) {
+				_packet_handler.files.remove(&file);
+				Genode::destroy(_heap, &file);
+			}
 		}
 
 	public:
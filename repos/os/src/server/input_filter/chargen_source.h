@@ -108,7 +108,7 @@ class Input_filter::Chargen_source : public Source, Source::Sink
 		 * Key rules for generating characters
 		 */
 
-		enum { NUM_MODIFIERS = 4 };
+		enum { NUM_MODIFIERS = 4, NUM_MODIFIER_STATES = 1 << NUM_MODIFIERS };
 
 		/**
 		 * Cached state of modifiers, updated when a modifier key event occurs
@@ -117,8 +117,37 @@ class Input_filter::Chargen_source : public Source, Source::Sink
 		{
 			struct State { bool enabled = false; } states[NUM_MODIFIERS];
 
+			Modifier_map() { }
+
+			/**
+			 * Constructor
+			 *
+			 * \param index  modifier state with bit N set if modifier N
+			 *               is enabled
+			 */
+			explicit Modifier_map(unsigned index)
+			{
+				for (unsigned i = 0; i < NUM_MODIFIERS; i++)
+					states[i].enabled = index & (1 << i);
+			}
+
+			/**
+			 * Return index of modifier state within 'Key::characters'
+			 */
+			unsigned index() const
+			{
+				unsigned result = 0;
+				for (unsigned i = 0; i < NUM_MODIFIERS; i++)
+					if (states[i].enabled)
+						result |= 1 << i;
+
+				return result;
+			}
+
 		} _mod_map;
 
+		unsigned _mod_index = 0;
+
 		/**
 		 * State tracked per physical key
 		 */
@@ -234,6 +263,30 @@ class Input_filter::Chargen_source : public Source, Source::Sink
 				if (max_score > 0)
 					fn(best_match);
 			}
+
+			/*
+			 * Character for each modifier state, precomputed from the rules
+			 * to spare the rule matching when handling key events
+			 */
+			struct Character
+			{
+				bool               defined = false;
+				Input::Event::Utf8 utf8 { 0 };
+			};
+
+			Character characters[NUM_MODIFIER_STATES];
+
+			void compile_rules()
+			{
+				for (unsigned i = 0; i < NUM_MODIFIER_STATES; i++) {
+
+					characters[i] = Character();
+
+					apply_best_matching_rule(Modifier_map(i), [&] (Input::Event::Utf8 utf8) {
+						characters[i].defined = true;
+						characters[i].utf8    = utf8; });
+				}
+			}
 		};
 
 		/**
@@ -269,6 +322,15 @@ class Input_filter::Chargen_source : public Source, Source::Sink
 					return _keys[code];
 				};
 
+				/**
+				 * Precompute characters of all keys for all modifier states
+				 */
+				void compile_rules()
+				{
+					for (unsigned i = 0; i < Input::KEY_MAX; i++)
+						_keys[i].compile_rules();
+				}
+
 				/**
 				 * Obtain modifier condition from map XML node
 				 */
@@ -360,6 +422,8 @@ class Input_filter::Chargen_source : public Source, Source::Sink
 			_modifier_roms.for_each([&] (Modifier_rom const &mod_rom) {
 				_mod_map.states[mod_rom.id()].enabled |=
 					mod_rom.enabled(); });
+
+			_mod_index = _mod_map.index();
 		}
 
 		Owner _owner;
@@ -445,13 +509,14 @@ class Input_filter::Chargen_source : public Source, Source::Sink
 			}
 
 			if (event.type() == Event::PRESS) {
-				key.apply_best_matching_rule(_mod_map, [&] (Event::Utf8 utf8) {
+				Key::Character const &character = key.characters[_mod_index];
 
-					_destination.submit_event(Event(utf8));
+				if (character.defined) {
+					_destination.submit_event(Event(character.utf8));
 
 					if (_char_repeater.constructed())
-						_char_repeater->schedule_repeat(utf8);
-				});
+						_char_repeater->schedule_repeat(character.utf8);
+				}
 			}
 
 			if (event.type() == Event::RELEASE)
@@ -556,6 +621,8 @@ class Input_filter::Chargen_source : public Source, Source::Sink
 		{
 			_apply_config(config);
 
+			_key_map.compile_rules();
+
 			/* assign key types in key map */
 			_modifiers.for_each([&] (Modifier const &mod) {
 				_key_map.key(mod.code()).type = Key::MODIFIER; });
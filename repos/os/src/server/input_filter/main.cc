@@ -313,7 +313,10 @@ struct Input_filter::Main : Input_connection::Avail_handler,
 	/*
 	 * Input session provided to our client
 	 */
-	Input::Session_component _input_session { _env, _env.ram() };
+	Input::Session_component _input_session {
+		_env, _env.ram(),
+		_config.xml().attribute_value("queue_size",
+		                              (unsigned)Input::Event_queue::QUEUE_SIZE) };
 
 	/* process events */
 	struct Final_sink : Source::Sink
@@ -323,8 +326,9 @@ struct Input_filter::Main : Input_connection::Avail_handler,
 		Final_sink(Input::Session_component &input_session)
 		: _input_session(input_session) { }
 
+		/* the client is notified once per batch of events */
 		void submit_event(Input::Event const &event) override {
-			_input_session.submit(event); }
+			_input_session.submit(event, false); }
 
 	} _final_sink { _input_session };
 
@@ -344,8 +348,10 @@ struct Input_filter::Main : Input_connection::Avail_handler,
 			_input_connections.for_each([&] (Input_connection &connection) {
 				pending |= connection.pending(); });
 
-			if (pending && _output.constructed())
+			if (pending && _output.constructed()) {
 				_output->generate();
+				_input_session.event_queue().submit_signal();
+			}
 
 			if (_config_update_pending && _input_connections_idle())
 				Signal_transmitter(_config_handler).submit();
@@ -381,6 +387,9 @@ struct Input_filter::Main : Input_connection::Avail_handler,
 	{
 		Xml_node const config = _config.xml();
 
+		_input_session.event_queue().coalesce_motion(
+			config.attribute_value("coalesce_motion", true));
+
 		/* close input sessions that are no longer needed */
 		_input_connections.for_each([&] (Registered<Input_connection> &conn) {
 
@@ -16,6 +16,7 @@
 #include <base/exception.h>
 #include <base/log.h>
 #include <base/stdint.h>
+#include <util/construct_at.h>
 #include <util/misc_math.h>
 #include <util/token.h>
 
@@ -27,6 +28,7 @@ namespace Iso {
 	class Sector;
 	class Rock_ridge;
 	class Iso_base;
+	class Directory_cache;
 }
 
 
@@ -38,9 +40,10 @@ class Iso::Sector {
 	public:
 
 		enum {
-			MAX_SECTORS = 32, /* max. number sectors that can be read in one
-			                     transaction */
 			BLOCK_SIZE = 2048,
+
+			/* max. number sectors that can be read in one transaction */
+			MAX_SECTORS = TX_BUF_SIZE / BLOCK_SIZE / 2,
 		};
 
 	private:
@@ -93,6 +96,27 @@ class Iso::Sector {
 };
 
 
+/**
+ * Read 'count' sectors starting at 'blk_nr' to 'dst'
+ */
+static void read_sectors(Block::Connection &block, unsigned long blk_nr,
+                         unsigned long count, uint8_t *dst)
+{
+	using Iso::Sector;
+
+	while (count) {
+		unsigned long const n = min<unsigned long>(Sector::MAX_SECTORS, count);
+
+		Sector sec(block, blk_nr, n);
+		memcpy(dst, sec.addr<void *>(), n * Sector::blk_size());
+
+		blk_nr += n;
+		count  -= n;
+		dst    += n * Sector::blk_size();
+	}
+}
+
+
 /**
  * Rock ridge extension (see IEEE P1282)
  */
@@ -357,12 +381,100 @@ static Directory_record *root_dir(Genode::Allocator &alloc,
 }
 
 
+/**
+ * Cache of directory extents
+ *
+ * Path lookups walk the same directories over and over again, e.g., the
+ * directory of the shared libraries at boot time. The cache keeps the
+ * extents of the recently used directories, which spares the block
+ * requests for the lookups.
+ */
+class Iso::Directory_cache
+{
+	private:
+
+		struct Extent : List<Extent>::Element
+		{
+			uint32_t const blk_nr;
+			size_t   const size;
+
+			Extent(uint32_t blk_nr, size_t size) : blk_nr(blk_nr), size(size) { }
+
+			uint8_t *data() { return (uint8_t *)(this + 1); }
+		};
+
+		Genode::Allocator &_alloc;
+
+		List<Extent> _extents { };   /* most recently used first */
+		size_t       _size = 0;
+
+		void _evict_last()
+		{
+			Extent *last = _extents.first();
+			while (last && last->next())
+				last = last->next();
+
+			if (!last)
+				return;
+
+			_extents.remove(last);
+			_size -= last->size;
+			_alloc.free(last, sizeof(Extent) + last->size);
+		}
+
+	public:
+
+		Directory_cache(Genode::Allocator &alloc) : _alloc(alloc) { }
+
+		/**
+		 * Return content of directory extent
+		 *
+		 * The content stays valid until the next call.
+		 */
+		uint8_t *extent(Block::Connection &block, uint32_t blk_nr,
+		                uint32_t length)
+		{
+			for (Extent *e = _extents.first(); e; e = e->next()) {
+				if (e->blk_nr != blk_nr)
+					continue;
+
+				_extents.remove(e);
+				_extents.insert(e);
+				return e->data();
+			}
+
+			size_t const size = Sector::to_blk(length) * Sector::blk_size();
+
+			while (_extents.first() && _size + size > DIRECTORY_CACHE_SIZE)
+				_evict_last();
+
+			void *buf = nullptr;
+			if (!_alloc.alloc(sizeof(Extent) + size, &buf))
+				throw Insufficient_ram_quota();
+
+			Extent *e = construct_at<Extent>(buf, blk_nr, size);
+
+			try { read_sectors(block, blk_nr, Sector::to_blk(length), e->data()); }
+			catch (...) {
+				_alloc.free(buf, sizeof(Extent) + size);
+				throw;
+			}
+
+			_extents.insert(e);
+			_size += size;
+			return e->data();
+		}
+};
+
+
 /*******************
  ** Iso interface **
  *******************/
 
 static Directory_record *_root_dir;
 
+static Constructible<Iso::Directory_cache> _directory_cache;
+
 
 Iso::File_info *Iso::file_info(Genode::Allocator &alloc, Block::Connection &block,
                                char const *path)
@@ -382,9 +494,10 @@ Iso::File_info *Iso::file_info(Genode::Allocator &alloc, Block::Connection &bloc
 
 	if (!_root_dir) {
 		_root_dir = root_dir(alloc, block);
+		_directory_cache.construct(alloc);
 	}
 
-	Directory_record *dir = _root_dir;
+	uint32_t dir_blk_nr = _root_dir->blk_nr(), dir_length = _root_dir->data_length();
 	uint32_t blk_nr = 0, data_length = 0;
 
 	/* determine block nr and file length on disk, parse directory records */
@@ -398,30 +511,31 @@ Iso::File_info *Iso::file_info(Genode::Allocator &alloc, Block::Connection &bloc
 		t.string(level, PATH_LENGTH);
 
 		/*
-		 * Save current block number in a variable because successive
-		 * iterations might override the memory location where dir points
-		 * to when a directory entry spans several sectors.
+		 * Load extent of directory record and search for level. Records
+		 * do not cross sector boundaries, the rest of a sector is zeroed.
 		 */
-		uint32_t current_blk_nr = dir->blk_nr();
+		uint8_t * const extent =
+			_directory_cache->extent(block, dir_blk_nr, dir_length);
+
+		unsigned long const num_sectors = Sector::to_blk(dir_length);
 
-		/* load extent of directory record and search for level */
-		for (unsigned long i = 0; i < Sector::to_blk(dir->data_length()); i++) {
-			Sector sec(block, current_blk_nr + i, 1);
-			Directory_record *tmp = sec.addr<Directory_record *>()->locate(level);
+		for (unsigned long i = 0; i < num_sectors; i++) {
+			Directory_record *dir = ((Directory_record *)
+				(extent + i*Sector::blk_size()))->locate(level);
 
-			if (!tmp && i == Sector::to_blk(dir->data_length()) - 1) {
+			if (!dir && i == num_sectors - 1) {
 				Genode::error("file not found: ", Genode::Cstring(path));
 				throw File_not_found();
 			}
 
-			if (!tmp) continue;
+			if (!dir) continue;
 
-			dir = tmp;
-			current_blk_nr = dir->blk_nr();
+			dir_blk_nr = dir->blk_nr();
+			dir_length = dir->data_length();
 
 			if (!dir->directory()) {
-				blk_nr      = current_blk_nr;
-				data_length = dir->data_length();
+				blk_nr      = dir_blk_nr;
+				data_length = dir_length;
 			}
 
 			break;
@@ -430,8 +544,6 @@ Iso::File_info *Iso::file_info(Genode::Allocator &alloc, Block::Connection &bloc
 		t = t.next();
 	}
 
-	/* Warning: Don't access 'dir' after this point, since the sector is gone */
-
 	if (!blk_nr && !data_length) {
 		Genode::error("file not found: ", Genode::Cstring(path));
 		throw File_not_found();
@@ -450,26 +562,13 @@ unsigned long Iso::read_file(Block::Connection &block, File_info *info,
 
 	unsigned long total_blk_count = ((length + (Sector::blk_size() - 1)) &
 	                                 ~((Sector::blk_size()) - 1)) / Sector::blk_size();
-	unsigned long ret = total_blk_count;
-	unsigned long blk_count;
 	unsigned long blk_nr = info->blk_nr() + (file_offset / Sector::blk_size());
 
-	while ((blk_count = min<unsigned long>(Sector::MAX_SECTORS, total_blk_count))) {
-		Sector sec(block, blk_nr, blk_count);
-
-		total_blk_count -= blk_count;
-		blk_nr          += blk_count;
+	read_sectors(block, blk_nr, total_blk_count, buf);
 
-		unsigned long copy_length = blk_count * Sector::blk_size();
-		memcpy(buf, sec.addr<void *>(), copy_length);
-
-		length -= copy_length;
-		buf    += copy_length;
-
-		/* zero out rest of page */
-		if (!total_blk_count && (blk_count % 2))
-			memset(buf, 0, Sector::blk_size());
-	}
+	/* zero out rest of page */
+	if (total_blk_count % 2)
+		memset(buf + total_blk_count * Sector::blk_size(), 0, Sector::blk_size());
 
-	return ret * Sector::blk_size();
+	return total_blk_count * Sector::blk_size();
 }
@@ -31,6 +31,12 @@ namespace Iso {
 		PATH_LENGTH  = 128, /* max. length of a path */
 		LEVEL_LENGTH = 32,  /* max. length of a level of a path */
 		PAGE_SIZE    = 4096,
+
+		/* size of the Block-session packet buffer */
+		TX_BUF_SIZE  = 1024*1024,
+
+		/* max. amount of directory extents kept in memory */
+		DIRECTORY_CACHE_SIZE = 1024*1024,
 	};
 
 
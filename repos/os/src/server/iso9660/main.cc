@@ -103,8 +103,10 @@ class Iso::Rom_component : public Genode::Rpc_object<Rom_session>
 		              File_cache &cache, Block::Connection &block,
 		              char const *path)
 		{
+			/* hand out the dataspace of a file requested before */
 			if ((_file = _lookup(cache, path))) {
-				Genode::log("cache hit for file ", Genode::Cstring(path));
+				if (verbose)
+					Genode::log("cache hit for file ", Genode::Cstring(path));
 				return;
 			}
 
@@ -124,7 +126,7 @@ class Iso::Root : public Iso::Root_component
 		Genode::Allocator &_alloc;
 
 		Allocator_avl     _block_alloc { &_alloc };
-		Block::Connection _block       { _env, &_block_alloc };
+		Block::Connection _block       { _env, &_block_alloc, TX_BUF_SIZE };
 
 		/*
 		 * Entries in the cache are never freed, even if the ROM session
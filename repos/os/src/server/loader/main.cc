@@ -204,6 +204,7 @@ class Loader::Session_component : public Rpc_object<Session>
 		Env                        &_env;
 		Session_label         const _label;
 		Xml_node              const _config;
+		Parent_rom_cache           &_parent_roms;
 		Cap_quota             const _cap_quota;
 		Ram_quota             const _ram_quota;
 		Ram_session_client_guard    _local_ram { _env.ram_session_cap(), _ram_quota };
@@ -211,7 +212,7 @@ class Loader::Session_component : public Rpc_object<Session>
 		size_t                      _subsystem_cap_quota_limit = 0;
 		size_t                      _subsystem_ram_quota_limit = 0;
 		Parent_services             _parent_services;
-		Rom_module_registry         _rom_modules { _env, _config, _local_ram, _md_alloc };
+		Rom_module_registry         _rom_modules { _env, _config, _local_ram, _md_alloc, _parent_roms };
 		Local_rom_factory           _rom_factory { _env.ep(), _md_alloc, _rom_modules };
 		Local_rom_service           _rom_service { _rom_factory };
 		Local_cpu_service           _cpu_service { _env };
@@ -246,9 +247,10 @@ class Loader::Session_component : public Rpc_object<Session>
 		 * Constructor
 		 */
 		Session_component(Env &env, Session_label const &label, Xml_node config,
+		                  Parent_rom_cache &parent_roms,
 		                  Cap_quota cap_quota, Ram_quota ram_quota)
 		:
-			_env(env), _label(label), _config(config),
+			_env(env), _label(label), _config(config), _parent_roms(parent_roms),
 			_cap_quota(cap_quota), _ram_quota(ram_quota)
 		{
 			/* fetch all parent-provided ROMs according to the config */
@@ -378,8 +380,9 @@ class Loader::Root : public Root_component<Session_component>
 {
 	private:
 
-		Env           &_env;
-		Xml_node const _config;
+		Env              &_env;
+		Xml_node   const  _config;
+		Parent_rom_cache &_parent_roms;
 
 	protected:
 
@@ -393,16 +396,18 @@ class Loader::Root : public Root_component<Session_component>
 			catch (...) { }
 
 			return new (md_alloc()) Session_component(_env, label, session_config,
+			                                          _parent_roms,
 			                                          cap_quota_from_args(args),
 			                                          ram_quota_from_args(args));
 		}
 
 	public:
 
-		Root(Env &env, Xml_node config, Allocator &md_alloc)
+		Root(Env &env, Xml_node config, Allocator &md_alloc,
+		     Parent_rom_cache &parent_roms)
 		:
 			Root_component<Session_component>(&env.ep().rpc_ep(), &md_alloc),
-			_env(env), _config(config)
+			_env(env), _config(config), _parent_roms(parent_roms)
 		{ }
 };
 
@@ -418,7 +423,9 @@ struct Loader::Main
 
 	Attached_rom_dataspace _config { _env, "config" };
 
-	Root _root { _env, _config.xml(), _heap };
+	Parent_rom_cache _parent_roms { _env, _heap };
+
+	Root _root { _env, _config.xml(), _heap, _parent_roms };
 
 	Main(Env &env) : _env(env)
 	{
@@ -133,6 +133,7 @@ class Nitpicker::Session_component : public Rpc_object<Session>
 				}
 
 			case Command::OP_TITLE:
+			case Command::OP_ALPHA:
 				{
 					_nitpicker.enqueue(command);
 					_nitpicker.execute();
@@ -0,0 +1,134 @@
+/*
+ * \brief  ROM modules obtained from the parent, shared by all loader sessions
+ * \author Genode Labs
+ * \date   2026-10-14
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _PARENT_ROM_CACHE_H_
+#define _PARENT_ROM_CACHE_H_
+
+#include <base/registry.h>
+#include <rom_session/connection.h>
+
+namespace Genode { class Parent_rom_cache; }
+
+
+/**
+ * Cache of ROM sessions to the parent
+ *
+ * Subsystems started by the loader tend to request the same parent-provided
+ * ROM modules, e.g., the dynamic linker and shared libraries. Instead of
+ * opening a ROM session to the parent per loader session and module, the
+ * sessions are opened once and retained after the loader session is closed.
+ * The number of cached modules is bounded by the '<parent-rom>' nodes of the
+ * loader's configuration.
+ */
+class Genode::Parent_rom_cache : Noncopyable
+{
+	public:
+
+		typedef String<128> Name;
+
+		/**
+		 * Receiver of ROM-update signals
+		 */
+		struct Subscriber : Registry<Subscriber>::Element
+		{
+			Signal_context_capability const sigh;
+
+			Subscriber(Registry<Subscriber> &registry, Signal_context_capability sigh)
+			: Registry<Subscriber>::Element(registry, *this), sigh(sigh) { }
+		};
+
+		class Module : public List<Module>::Element
+		{
+			private:
+
+				friend class Parent_rom_cache;
+
+				Name const _name;
+
+				Rom_connection _rom;
+
+				Rom_dataspace_capability _ds = _rom.dataspace();
+
+				Registry<Subscriber> _subscribers;
+
+				/*
+				 * A single signal handler is installed at the parent and
+				 * the signal is distributed to all users
+				 */
+				void _handle_update()
+				{
+					if (!_rom.update())
+						_ds = _rom.dataspace();
+
+					_subscribers.for_each([&] (Subscriber &subscriber) {
+						if (subscriber.sigh.valid())
+							Signal_transmitter(subscriber.sigh).submit(); });
+				}
+
+				Signal_handler<Module> _update_handler;
+
+				Module(Env &env, Name const &name)
+				:
+					_name(name), _rom(env, name.string()),
+					_update_handler(env.ep(), *this, &Module::_handle_update)
+				{
+					_rom.sigh(_update_handler);
+				}
+
+			public:
+
+				Rom_dataspace_capability dataspace() const { return _ds; }
+
+				Registry<Subscriber> &subscribers() { return _subscribers; }
+		};
+
+	private:
+
+		Env       &_env;
+		Allocator &_alloc;
+		Lock       _lock;
+
+		List<Module> _modules;
+
+	public:
+
+		Parent_rom_cache(Env &env, Allocator &alloc) : _env(env), _alloc(alloc) { }
+
+		~Parent_rom_cache()
+		{
+			while (Module *module = _modules.first()) {
+				_modules.remove(module);
+				destroy(_alloc, module);
+			}
+		}
+
+		/**
+		 * Return module, open ROM session to the parent if not cached
+		 *
+		 * \throw Rom_connection::Rom_connection_failed
+		 */
+		Module &lookup(Name const &name)
+		{
+			Lock::Guard guard(_lock);
+
+			for (Module *m = _modules.first(); m; m = m->next())
+				if (m->_name == name)
+					return *m;
+
+			Module &module = *new (_alloc) Module(_env, name);
+			_modules.insert(&module);
+			return module;
+		}
+};
+
+#endif /* _PARENT_ROM_CACHE_H_ */
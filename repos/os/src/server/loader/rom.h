@@ -19,6 +19,9 @@
 #include <base/attached_ram_dataspace.h>
 #include <base/attached_rom_dataspace.h>
 
+/* local includes */
+#include <parent_rom_cache.h>
+
 namespace Genode {
 
 	class Rom_module : public List<Rom_module>::Element
@@ -35,7 +38,10 @@ namespace Genode {
 			Attached_ram_dataspace _fg;
 			Attached_ram_dataspace _bg;
 
-			Constructible<Attached_rom_dataspace> _parent_rom;
+			/* ROM module shared with other loader sessions */
+			Parent_rom_cache::Module *_parent_rom = nullptr;
+
+			Constructible<Parent_rom_cache::Subscriber> _parent_rom_subscriber;
 
 			bool _bg_has_pending_data;
 
@@ -48,7 +54,8 @@ namespace Genode {
 			enum Origin { PARENT_PROVIDED, SESSION_LOCAL };
 
 			Rom_module(Env &env, Xml_node config, Name const &name,
-			           Ram_allocator &ram_allocator, Origin origin)
+			           Ram_allocator &ram_allocator, Parent_rom_cache &parent_roms,
+			           Origin origin)
 			:
 				_name(name), _ram(ram_allocator),
 				_fg(_ram, env.rm(), 0), _bg(_ram, env.rm(), 0),
@@ -59,7 +66,7 @@ namespace Genode {
 					return;
 
 				try {
-					_parent_rom.construct(env, name.string()); }
+					_parent_rom = &parent_roms.lookup(name); }
 				catch (...) {
 					warning("ROM ", name, " unavailable from parent, "
 					        "try to use session-local ROM");
@@ -92,8 +99,8 @@ namespace Genode {
 			 */
 			Rom_dataspace_capability fg_dataspace()
 			{
-				if (_parent_rom.constructed())
-					return static_cap_cast<Rom_dataspace>(_parent_rom->cap());
+				if (_parent_rom)
+					return _parent_rom->dataspace();
 
 				if (!_fg.size() && !_bg_has_pending_data) {
 					Genode::error("no data loaded");
@@ -120,8 +127,8 @@ namespace Genode {
 			 */
 			void sigh(Signal_context_capability sigh)
 			{
-				if (_parent_rom.constructed())
-					_parent_rom->sigh(sigh);
+				if (_parent_rom)
+					_parent_rom_subscriber.construct(_parent_rom->subscribers(), sigh);
 
 				_sigh = sigh;
 			}
@@ -160,6 +167,7 @@ namespace Genode {
 			Lock             _lock;
 			Ram_allocator   &_ram_allocator;
 			Allocator       &_md_alloc;
+			Parent_rom_cache &_parent_roms;
 			List<Rom_module> _list;
 
 		public:
@@ -175,13 +183,15 @@ namespace Genode {
 			 * \param ram_allocator  RAM allocator used as backing store for
 			 *                       module data
 			 * \param md_alloc       backing store for ROM module meta data
+			 * \param parent_roms    ROM modules obtained from the parent
 			 */
 			Rom_module_registry(Env &env, Xml_node config,
 			                    Ram_allocator &ram_allocator,
-			                    Allocator &md_alloc)
+			                    Allocator &md_alloc,
+			                    Parent_rom_cache &parent_roms)
 			:
 				_env(env), _config(config), _ram_allocator(ram_allocator),
-				_md_alloc(md_alloc)
+				_md_alloc(md_alloc), _parent_roms(parent_roms)
 			{ }
 
 			~Rom_module_registry()
@@ -228,7 +238,7 @@ namespace Genode {
 
 					Rom_module *module = new (&_md_alloc)
 						Rom_module(_env, _config, name, _ram_allocator,
-						           Rom_module::SESSION_LOCAL);
+						           _parent_roms, Rom_module::SESSION_LOCAL);
 
 					Rom_module_lock_guard module_guard(*module);
 
@@ -249,7 +259,7 @@ namespace Genode {
 
 					Rom_module *module = new (&_md_alloc)
 						Rom_module(_env, _config, name, _ram_allocator,
-						           Rom_module::PARENT_PROVIDED);
+						           _parent_roms, Rom_module::PARENT_PROVIDED);
 
 					Rom_module_lock_guard module_guard(*module);
 
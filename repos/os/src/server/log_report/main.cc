@@ -39,6 +39,24 @@ class Report::Session_component : public Genode::Rpc_object<Session>
 
 		Genode::Attached_ram_dataspace _ds;
 
+		/* true while the chunks of a report are logged */
+		bool _chunked = false;
+
+		void _log_content(size_t const length)
+		{
+			using namespace Genode;
+
+			/* a chunk is not null-terminated, so limit the copy to 'length' */
+			char buf[1024];
+			for (size_t consumed = 0; consumed < length; consumed += strlen(buf)) {
+				strncpy(buf, _ds.local_addr<char>() + consumed,
+				        min(sizeof(buf), length - consumed + 1));
+				if (!buf[0])
+					break;
+				log(Cstring(buf));
+			}
+		}
+
 	public:
 
 		Session_component(Ram_session                 &ram,
@@ -56,13 +74,24 @@ class Report::Session_component : public Genode::Rpc_object<Session>
 			using namespace Genode;
 
 			log("\nreport: ", _label.string());
-
-			char buf[1024];
-			for (size_t consumed = 0; consumed < length; consumed += strlen(buf)) {
-				strncpy(buf, _ds.local_addr<char>() + consumed, sizeof(buf));
-				log(Cstring(buf));
-			}
+			_log_content(length);
 			log("\nend of report");
+
+			_chunked = false;
+		}
+
+		void submit_chunk(size_t const length, bool last) override
+		{
+			using namespace Genode;
+
+			if (!_chunked)
+				log("\nreport: ", _label.string());
+
+			_log_content(min(length, _ds.size()));
+			_chunked = !last;
+
+			if (last)
+				log("\nend of report");
 		}
 
 		void response_sigh(Genode::Signal_context_capability) override { }
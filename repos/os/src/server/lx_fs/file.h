@@ -113,6 +113,9 @@ class Lx_fs::File : public Node
 			Node::name(basename(path));
 		}
 
+		/* 'pread' and 'pwrite' leave the file offset untouched */
+		bool concurrent_io() const override { return true; }
+
 		size_t read(char *dst, size_t len, seek_off_t seek_offset) override
 		{
 			int ret = pread(_fd, dst, len, seek_offset);
@@ -22,6 +22,7 @@
 
 /* local includes */
 #include <directory.h>
+#include <job_queue.h>
 #include <open_node.h>
 
 namespace Lx_fs {
@@ -50,6 +51,57 @@ class Lx_fs::Session_component : public Session_rpc_object
 
 		Signal_handler<Session_component> _process_packet_dispatcher;
 
+		enum { MAX_IN_FLIGHT = 16 };
+
+		Job_queue &_jobs;
+
+		/*
+		 * Reads of files are processed concurrently by the workers. Any
+		 * other packet waits until the outstanding packets of the session
+		 * are completed and is processed with no other packet in flight.
+		 *
+		 * The entrypoint acknowledges the packets completed by the
+		 * workers because the listeners of modified nodes, which are
+		 * notified at the entrypoint, use the acknowledgement queue too.
+		 */
+		Lock              _lock;
+		unsigned          _in_flight     = 0;
+		bool              _exclusive     = false;
+		bool              _waiting       = false;
+		Semaphore         _idle;
+		Packet_descriptor _completed[MAX_IN_FLIGHT];
+		unsigned          _num_completed = 0;
+
+		/**
+		 * Wait until the workers completed all packets of the session
+		 */
+		void _wait_for_workers()
+		{
+			for (;;) {
+				{
+					Lock::Guard guard(_lock);
+					if (_num_completed == _in_flight)
+						return;
+					_waiting = true;
+				}
+				_idle.down();
+			}
+		}
+
+		void _acknowledge_completed()
+		{
+			Lock::Guard guard(_lock);
+
+			for (unsigned i = 0; i < _num_completed; i++)
+				tx_sink()->acknowledge_packet(_completed[i]);
+
+			_in_flight    -= _num_completed;
+			_num_completed = 0;
+
+			if (!_in_flight)
+				_exclusive = false;
+		}
+
 
 		/******************************
 		 ** Packet-stream processing **
@@ -58,9 +110,9 @@ class Lx_fs::Session_component : public Session_rpc_object
 		/**
 		 * Perform packet operation
 		 *
-		 * \return true on success, false on failure
+		 * \return false if the acknowledgement of the packet is deferred
 		 */
-		void _process_packet_op(Packet_descriptor &packet, Open_node &open_node)
+		bool _process_packet_op(Packet_descriptor &packet, Open_node &open_node)
 		{
 			void     * const content = tx_sink()->packet_content(packet);
 			size_t     const length  = packet.length();
@@ -85,7 +137,7 @@ class Lx_fs::Session_component : public Session_rpc_object
 				/* notify_listeners may bounce the packet back*/
 				open_node.node().notify_listeners();
 				/* otherwise defer acknowledgement of this packet */
-				return;
+				return false;
 
 			case Packet_descriptor::READ_READY:
 				/* not supported */
@@ -104,34 +156,51 @@ class Lx_fs::Session_component : public Session_rpc_object
 
 			packet.length(res_length);
 			packet.succeeded(res_length > 0);
-			tx_sink()->acknowledge_packet(packet);
+			return true;
 		}
 
-		void _process_packet()
+		Open_node *_lookup(Packet_descriptor const &packet)
 		{
-			Packet_descriptor packet = tx_sink()->get_packet();
-
-			/* assume failure by default */
-			packet.succeeded(false);
-
-			auto process_packet_fn = [&] (Open_node &open_node) {
-				_process_packet_op(packet, open_node);
-			};
-
 			try {
-				_open_node_registry.apply<Open_node>(packet.handle(), process_packet_fn);
+				return _open_node_registry.apply<Open_node>(packet.handle(),
+					[&] (Open_node &open_node) { return &open_node; });
 			} catch (Id_space<File_system::Node>::Unknown_id const &) {
-				Genode::error("Invalid_handle");
-				tx_sink()->acknowledge_packet(packet);
+				return nullptr;
 			}
 		}
 
+		/**
+		 * Hand packet over to a worker
+		 *
+		 * \return false if the packet must be processed in place
+		 */
+		bool _dispatch(Packet_descriptor const &packet, Open_node &open_node,
+		               bool concurrent)
+		{
+			bool const io = packet.operation() == Packet_descriptor::READ
+			             || packet.operation() == Packet_descriptor::WRITE;
+
+			if (!io || !open_node.node().concurrent_io())
+				return false;
+
+			Lock::Guard guard(_lock);
+
+			if (!_jobs.put(Job_queue::Job { this, packet, &open_node }))
+				return false;
+
+			_in_flight++;
+			_exclusive = !concurrent;
+			return true;
+		}
+
 		/**
 		 * Called by signal dispatcher, executed in the context of the main
 		 * thread (not serialized with the RPC functions)
 		 */
 		void _process_packets()
 		{
+			_acknowledge_completed();
+
 			while (tx_sink()->packet_avail()) {
 
 				/*
@@ -149,7 +218,38 @@ class Lx_fs::Session_component : public Session_rpc_object
 				if (!tx_sink()->ready_to_ack())
 					return;
 
-				_process_packet();
+				Open_node * const open_node = _lookup(tx_sink()->peek_packet());
+
+				bool const concurrent = open_node
+				                     && open_node->node().concurrent_io()
+				                     && tx_sink()->peek_packet().operation()
+				                        == Packet_descriptor::READ;
+				{
+					Lock::Guard guard(_lock);
+
+					/* keep an acknowledgement slot for each packet in flight */
+					if (_exclusive || (_in_flight && !concurrent)
+					 || _in_flight == MAX_IN_FLIGHT
+					 || _in_flight >= tx_sink()->ack_slots_free())
+						return;
+				}
+
+				Packet_descriptor packet = tx_sink()->get_packet();
+
+				/* assume failure by default */
+				packet.succeeded(false);
+
+				if (!open_node) {
+					Genode::error("Invalid_handle");
+					tx_sink()->acknowledge_packet(packet);
+					continue;
+				}
+
+				if (_dispatch(packet, *open_node, concurrent))
+					continue;
+
+				if (_process_packet_op(packet, *open_node))
+					tx_sink()->acknowledge_packet(packet);
 			}
 		}
 
@@ -173,14 +273,16 @@ class Lx_fs::Session_component : public Session_rpc_object
 		                  Genode::Env &env,
 		                  char const  *root_dir,
 		                  bool         writable,
-		                  Allocator   &md_alloc)
+		                  Allocator   &md_alloc,
+		                  Job_queue   &jobs)
 		:
 			Session_rpc_object(env.ram().alloc(tx_buf_size), env.rm(), env.ep().rpc_ep()),
 			_env(env),
 			_md_alloc(md_alloc),
 			_root(*new (&_md_alloc) Directory(_md_alloc, root_dir, false)),
 			_writable(writable),
-			_process_packet_dispatcher(env.ep(), *this, &Session_component::_process_packets)
+			_process_packet_dispatcher(env.ep(), *this, &Session_component::_process_packets),
+			_jobs(jobs)
 		{
 			/*
 			 * Register '_process_packets' dispatch function as signal
@@ -195,11 +297,39 @@ class Lx_fs::Session_component : public Session_rpc_object
 		 */
 		~Session_component()
 		{
+			_wait_for_workers();
+
 			Dataspace_capability ds = tx_sink()->dataspace();
 			_env.ram().free(static_cap_cast<Ram_dataspace>(ds));
 			destroy(&_md_alloc, &_root);
 		}
 
+		/**
+		 * Process packet, called by a worker thread
+		 */
+		void process_job(Job_queue::Job const &job)
+		{
+			Packet_descriptor packet = job.packet;
+			_process_packet_op(packet, *job.open_node);
+
+			bool wake_up = false;
+			{
+				Lock::Guard guard(_lock);
+
+				_completed[_num_completed++] = packet;
+
+				if (_waiting && _num_completed == _in_flight) {
+					_waiting = false;
+					wake_up  = true;
+				}
+
+				/* let the entrypoint acknowledge the packet */
+				Signal_transmitter(_process_packet_dispatcher).submit();
+			}
+			if (wake_up)
+				_idle.up();
+		}
+
 
 		/***************************
 		 ** File_system interface **
@@ -280,6 +410,9 @@ class Lx_fs::Session_component : public Session_rpc_object
 
 		void close(Node_handle handle)
 		{
+			/* the node may be in use by a worker */
+			_wait_for_workers();
+
 			auto close_fn = [&] (Open_node &open_node) {
 				Node &node = open_node.node();
 				destroy(_md_alloc, &open_node);
@@ -347,6 +480,8 @@ class Lx_fs::Root : public Root_component<Session_component>
 
 		Genode::Attached_rom_dataspace _config { _env, "config" };
 
+		Job_queue &_jobs;
+
 	protected:
 
 		Session_component *_create_session(const char *args)
@@ -428,7 +563,8 @@ class Lx_fs::Root : public Root_component<Session_component>
 
 			try {
 				return new (md_alloc())
-				       Session_component(tx_buf_size, _env, root_dir, writeable, *md_alloc());
+				       Session_component(tx_buf_size, _env, root_dir, writeable,
+				                         *md_alloc(), _jobs);
 			}
 			catch (Lookup_failed) {
 				Genode::error("session root directory \"", Genode::Cstring(root), "\" "
@@ -439,11 +575,17 @@ class Lx_fs::Root : public Root_component<Session_component>
 
 	public:
 
-		Root(Genode::Env &env, Allocator &md_alloc)
+		Root(Genode::Env &env, Allocator &md_alloc, Job_queue &jobs)
 		:
 			Root_component<Session_component>(&env.ep().rpc_ep(), &md_alloc),
-			_env(env)
+			_env(env), _jobs(jobs)
 		{ }
+
+		/**
+		 * Return number of worker threads configured
+		 */
+		unsigned workers() {
+			return _config.xml().attribute_value("workers", 4U); }
 };
 
 
@@ -451,15 +593,29 @@ struct Lx_fs::Main
 {
 	Genode::Env &env;
 
+	Genode::Heap        heap        { env.ram(), env.rm() };
 	Genode::Sliced_heap sliced_heap { env.ram(), env.rm() };
 
-	Root fs_root = { env, sliced_heap };
+	Job_queue jobs { };
+
+	Root fs_root = { env, sliced_heap, jobs };
 
 	Main(Genode::Env &env) : env(env)
 	{
+		jobs.start_workers(env, heap, fs_root.workers());
+
 		env.parent().announce(env.ep().manage(fs_root));
 	}
 };
 
 
+void Lx_fs::Job_queue::Worker::entry()
+{
+	for (;;) {
+		Job const job = jobs.get();
+		job.session->process_job(job);
+	}
+}
+
+
 void Component::construct(Genode::Env &env) { static Lx_fs::Main inst(env); }
@@ -53,6 +53,13 @@ class Lx_fs::Node : public File_system::Node_base
 
 		virtual Status status() = 0;
 
+		/**
+		 * Return true if the node's I/O may be performed by the workers
+		 *
+		 * Reads of such nodes are processed concurrently.
+		 */
+		virtual bool concurrent_io() const { return false; }
+
 		/*
 		 * File functionality
 		 */
@@ -0,0 +1,76 @@
+/*
+ * \brief  Mixing kernels of the audio mixer
+ * \author Genode Labs
+ * \date   2026-10-14
+ *
+ * The kernels operate on vectors of four samples by using the vector
+ * extensions of the compiler, which are translated to SSE on x86 and to
+ * NEON on ARM if available. The number of samples must be a multiple of
+ * four, which is the case for 'Audio_out::PERIOD'.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _MIX_H_
+#define _MIX_H_
+
+namespace Mix {
+
+	typedef float Vector __attribute__((vector_size(16)));
+
+	enum { VECTOR_SAMPLES = sizeof(Vector)/sizeof(float) };
+
+	inline Vector load(float const *src)
+	{
+		Vector v;
+		__builtin_memcpy(&v, src, sizeof(v));
+		return v;
+	}
+
+	inline void store(float *dst, Vector v) {
+		__builtin_memcpy(dst, &v, sizeof(v)); }
+
+	inline Vector splat(float f) { return Vector { f, f, f, f }; }
+
+	/**
+	 * Add 'n' samples of 'in' scaled by 'vol' to 'out'
+	 *
+	 * \param clear  overwrite 'out' instead of adding to it
+	 */
+	inline void add_scaled(float *out, float const *in, float vol,
+	                       unsigned n, bool clear)
+	{
+		static_assert(VECTOR_SAMPLES == 4, "unexpected vector size");
+
+		Vector const v = splat(vol);
+
+		if (clear)
+			for (unsigned i = 0; i < n; i += VECTOR_SAMPLES)
+				store(out + i, load(in + i) * v);
+		else
+			for (unsigned i = 0; i < n; i += VECTOR_SAMPLES)
+				store(out + i, load(out + i) + load(in + i) * v);
+	}
+
+	/**
+	 * Clip 'n' samples at [-1.0, 1.0] and scale them by 'vol'
+	 */
+	inline void clip_scaled(float *out, float vol, unsigned n)
+	{
+		Vector const v = splat(vol), hi = splat(1.f), lo = splat(-1.f);
+
+		for (unsigned i = 0; i < n; i += VECTOR_SAMPLES) {
+			Vector s = load(out + i);
+			s = s > hi ? hi : s;
+			s = s < lo ? lo : s;
+			store(out + i, s * v);
+		}
+	}
+}
+
+#endif /* _MIX_H_ */
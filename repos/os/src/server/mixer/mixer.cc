@@ -13,7 +13,8 @@
  * contains multiple input sessions (Audio_out::Session_elem). For every packet
  * in the output queue the mixer sums the corresponding packets from all input
  * sessions up. The volume level of an input packet is applied in a linear way
- * (sample_value * volume_level) and the output packet is clipped at [1.0,-1.0].
+ * (sample_value * volume_level) and the output packet is clipped at [1.0,-1.0]
+ * before the volume level of the output channel is applied.
  */
 
 /*
@@ -38,6 +39,9 @@
 #include <base/component.h>
 #include <base/log.h>
 
+/* local includes */
+#include <mix.h>
+
 
 typedef Mixer::Channel Channel;
 
@@ -138,16 +142,73 @@ class Audio_out::Mixer
 		{
 			bool const sessions;
 			bool const changes;
+			bool const latency;
 
 			Verbose(Genode::Xml_node config)
 			:
 				sessions(config.attribute_value("verbose_sessions", false)),
-				changes(config.attribute_value("verbose_changes", false))
+				changes(config.attribute_value("verbose_changes", false)),
+				latency(config.attribute_value("verbose_latency", false))
 			{ }
 		};
 
 		Genode::Reconstructible<Verbose> _verbose { _config_rom.xml() };
 
+		/*
+		 * Latency from mixing a packet, which is triggered by the client's
+		 * submission, until the driver reports its playback progress
+		 */
+		struct Latency
+		{
+			enum { LOG_PACKETS = 512 };
+
+			Timer::Connection timer;
+
+			unsigned long mixed_us[Audio_out::QUEUE_SIZE];
+
+			unsigned      last_pos = 0;
+			unsigned      packets  = 0;
+			unsigned long sum_us   = 0;
+			unsigned long min_us   = ~0UL;
+			unsigned long max_us   = 0;
+
+			Latency(Genode::Env &env) : timer(env)
+			{
+				for (unsigned i = 0; i < Audio_out::QUEUE_SIZE; i++)
+					mixed_us[i] = 0;
+			}
+
+			void mixed(unsigned pos) { mixed_us[pos] = timer.elapsed_us(); }
+
+			void played(unsigned pos)
+			{
+				unsigned long const now = timer.elapsed_us();
+
+				for (; last_pos != pos; last_pos = (last_pos + 1) % Audio_out::QUEUE_SIZE) {
+					if (!mixed_us[last_pos])
+						continue;
+
+					unsigned long const us = now - mixed_us[last_pos];
+					mixed_us[last_pos] = 0;
+
+					sum_us += us;
+					min_us  = Genode::min(min_us, us);
+					max_us  = Genode::max(max_us, us);
+
+					if (++packets < LOG_PACKETS)
+						continue;
+
+					Genode::log("latency of ", packets, " packets: "
+					            "min=", min_us, "us avg=", sum_us/packets, "us "
+					            "max=", max_us, "us");
+
+					packets = 0; sum_us = 0; min_us = ~0UL; max_us = 0;
+				}
+			}
+		};
+
+		Genode::Constructible<Latency> _latency;
+
 		/*
 		 * Mixer output Audio_out connection
 		 */
@@ -264,13 +325,16 @@ class Audio_out::Mixer
 		/*
 		 * Advance the stream of the session to a new position
 		 */
-		void _advance_session(Session_elem *session, unsigned pos)
+		void _advance_session(Session_elem *session, unsigned pos, unsigned delay)
 		{
 			if (session->stopped()) return;
 
 			Stream *stream  = session->stream();
 			bool const full = stream->full();
 
+			/* the session positions follow the output, so does the delay */
+			stream->delay(delay);
+
 			/* mark packets as played and icrement position pointer */
 			while (stream->pos() != pos) {
 				stream->get(stream->pos())->mark_as_played();
@@ -288,9 +352,10 @@ class Audio_out::Mixer
 		void _advance_position()
 		{
 			for_each_index(MAX_CHANNELS, [&] (int i) {
-				unsigned const pos = _out[i]->stream()->pos();
+				unsigned const pos   = _out[i]->stream()->pos();
+				unsigned const delay = _out[i]->stream()->delay();
 				_channels[i].for_each_session([&] (Session_elem &session) {
-					_advance_session(&session, pos);
+					_advance_session(&session, pos, delay);
 				});
 			});
 		}
@@ -298,30 +363,13 @@ class Audio_out::Mixer
 		/*
 		 * Mix input packet into output packet
 		 *
-		 * Packets are mixed in a linear way with min/max clipping.
+		 * Packets are summed up in a linear way. Clipping is applied once
+		 * all input packets are mixed.
 		 */
-		void _mix_packet(Packet *out, Packet *in, bool clear,
-		                 float const out_vol, float const vol)
+		void _mix_packet(Packet *out, Packet *in, bool clear, float const vol)
 		{
-			if (clear) {
-				for_each_index(Audio_out::PERIOD, [&] (int const i) {
-					out->content()[i]  = (in->content()[i] * vol);
-
-					if (out->content()[i] > 1) out->content()[i] = 1;
-					if (out->content()[i] < -1) out->content()[i] = -1;
-
-					out->content()[i] *= out_vol;
-				});
-			} else {
-				for_each_index(Audio_out::PERIOD, [&] (int const i) {
-					out->content()[i] += (in->content()[i] * vol);
-
-					if (out->content()[i] > 1) out->content()[i] = 1;
-					if (out->content()[i] < -1) out->content()[i] = -1;
-
-					out->content()[i] *= out_vol;
-				});
-			}
+			Mix::add_scaled(out->content(), in->content(), vol,
+			                Audio_out::PERIOD, clear);
 
 			/* mark the packet as processed by invalidating it */
 			in->invalidate();
@@ -360,7 +408,7 @@ class Audio_out::Mixer
 						/* skip if packet has been processed or was already played */
 						if ((!in->valid() && !mix_all) || in->played()) return;
 
-						_mix_packet(out, in, clear, out_vol, session.volume);
+						_mix_packet(out, in, clear, session.volume);
 
 						clear = false;
 					});
@@ -374,6 +422,9 @@ class Audio_out::Mixer
 					mix_all = true;
 				});
 
+			if (!clear)
+				Mix::clip_scaled(out->content(), out_vol, Audio_out::PERIOD);
+
 			return !clear;
 		}
 
@@ -399,11 +450,15 @@ class Audio_out::Mixer
 				});
 
 				/* all channels mixed, submit to output queue */
-				if (mix_one)
+				if (mix_one) {
 					for_each_index(MAX_CHANNELS, [&] (int const j) {
 						Packet *p = _out[j]->stream()->get(pos[j] + i);
 						_out[j]->submit(p);
 					});
+
+					if (_latency.constructed())
+						_latency->mixed((pos[LEFT] + i) % Audio_out::QUEUE_SIZE);
+				}
 			});
 		}
 
@@ -413,6 +468,9 @@ class Audio_out::Mixer
 		 */
 		void _handle()
 		{
+			if (_latency.constructed())
+				_latency->played(_out[LEFT]->stream()->pos());
+
 			_advance_position();
 			_mix();
 		}
@@ -459,6 +517,13 @@ class Audio_out::Mixer
 			Xml_node config_node = _config_rom.xml();
 			_verbose.construct(config_node);
 
+			if (_verbose->latency && !_latency.constructed()) {
+				_latency.construct(env);
+				_latency->last_pos = _out[LEFT]->stream()->pos();
+			}
+			if (!_verbose->latency && _latency.constructed())
+				_latency.destruct();
+
 			_set_default_config(config_node);
 
 			/* reset out volume in case there is no 'channel_list' node */
@@ -15,7 +15,6 @@
 #define _ADDRESS_NODE_H_
 
 /* Genode */
-#include <util/avl_tree.h>
 #include <util/list.h>
 #include <nic_session/nic_session.h>
 #include <net/netaddress.h>
@@ -30,8 +29,8 @@ namespace Net {
 
 	/**
 	 * An Address_node encapsulates a session-component and can be hold in
-	 * a list and/or avl-tree, whereby the network-address (MAC or IP)
-	 * acts as a key.
+	 * a list and/or an address table, whereby the network-address (MAC or
+	 * IP) acts as a key.
 	 */
 	template <typename ADDRESS> class Address_node;
 
@@ -41,13 +40,13 @@ namespace Net {
 
 
 template <typename ADDRESS>
-class Net::Address_node : public Genode::Avl_node<Address_node<ADDRESS> >,
-                          public Genode::List<Address_node<ADDRESS> >::Element
+class Net::Address_node : public Genode::List<Address_node<ADDRESS> >::Element
 {
 	private:
 
 		ADDRESS            _addr;       /* MAC or IP address  */
 		Session_component &_component;  /* client's component */
+		Address_node      *_hash_next = nullptr; /* next node of bucket */
 
 	public:
 
@@ -72,33 +71,13 @@ class Net::Address_node : public Genode::Avl_node<Address_node<ADDRESS> >,
 		Session_component &component()        { return _component; }
 
 
-		/************************
-		 ** Avl node interface **
-		 ************************/
+		/*****************************
+		 ** Address_table interface **
+		 *****************************/
 
-		bool higher(Address_node *c)
-		{
-			using namespace Genode;
-
-			return (memcmp(&c->_addr.addr, &_addr.addr,
-			               sizeof(_addr.addr)) > 0);
-		}
-
-		/**
-		 * Find by address
-		 */
-		Address_node *find_by_address(Address addr)
-		{
-			using namespace Genode;
-
-			if (addr == _addr)
-				return this;
-
-			bool side = memcmp(&addr.addr, _addr.addr,
-			                   sizeof(_addr.addr)) > 0;
-			Address_node *c = Avl_node<Address_node>::child(side);
-			return c ? c->find_by_address(addr) : 0;
-		}
+		Address_node  *hash_next()                  { return _hash_next; }
+		Address_node *&hash_next_ref()              { return _hash_next; }
+		void           hash_next(Address_node *n)   { _hash_next = n;    }
 };
 
 #endif /* _ADDRESS_NODE_H_ */
@@ -0,0 +1,99 @@
+/*
+ * \brief  Hash table of address nodes
+ * \author Genode Labs
+ * \date   2026-10-14
+ *
+ * The table is consulted for each frame that passes the bridge. In contrast
+ * to an AVL tree, a lookup touches only the bucket array and the nodes of a
+ * single bucket rather than a path of nodes scattered across the heap.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _ADDRESS_TABLE_H_
+#define _ADDRESS_TABLE_H_
+
+/* local includes */
+#include <address_node.h>
+
+namespace Net { template <typename NODE> class Address_table; }
+
+
+template <typename NODE>
+class Net::Address_table
+{
+	private:
+
+		enum { BUCKETS = 256, CACHE_LINE_SIZE = 64 };
+
+		NODE *_buckets[BUCKETS] __attribute__((aligned(CACHE_LINE_SIZE)));
+
+		using Address = typename NODE::Address;
+
+		/**
+		 * Hash over the address bytes
+		 *
+		 * The virtual MAC addresses of the clients, and usually their IP
+		 * addresses too, differ in the last byte only, which therefore
+		 * dominates the hash.
+		 */
+		static unsigned _bucket(Address const &addr)
+		{
+			unsigned hash = 0;
+			for (unsigned i = 0; i < sizeof(addr.addr); i++)
+				hash = (hash << 3) ^ (hash >> 5) ^ addr.addr[i];
+			return (hash ^ addr.addr[sizeof(addr.addr) - 1]) % BUCKETS;
+		}
+
+	public:
+
+		Address_table()
+		{
+			for (unsigned i = 0; i < BUCKETS; i++)
+				_buckets[i] = nullptr;
+		}
+
+		void insert(NODE &node)
+		{
+			NODE *&head = _buckets[_bucket(node.addr())];
+			node.hash_next(head);
+			head = &node;
+		}
+
+		void remove(NODE &node)
+		{
+			for (NODE **n = &_buckets[_bucket(node.addr())]; *n;
+			     n = &(*n)->hash_next_ref())
+				if (*n == &node) {
+					*n = node.hash_next();
+					node.hash_next(nullptr);
+					return;
+				}
+		}
+
+		/**
+		 * Return node of given address, or nullptr if not present
+		 */
+		NODE *lookup(Address const &addr)
+		{
+			for (NODE *n = _buckets[_bucket(addr)]; n; n = n->hash_next())
+				if (n->addr() == addr)
+					return n;
+			return nullptr;
+		}
+
+		bool contains(NODE &node)
+		{
+			for (NODE *n = _buckets[_bucket(node.addr())]; n; n = n->hash_next())
+				if (n == &node)
+					return true;
+			return false;
+		}
+};
+
+#endif /* _ADDRESS_TABLE_H_ */
@@ -16,6 +16,8 @@
 #include <net/dhcp.h>
 #include <net/udp.h>
 
+#include <nic/flow_hash.h>
+
 #include <component.h>
 
 using namespace Net;
@@ -38,9 +40,7 @@ bool Session_component::handle_arp(Ethernet_frame *eth, Genode::size_t size)
 		 if (arp->src_ip() == arp->dst_ip())
 			return false;
 
-		Ipv4_address_node *node = vlan().ip_tree.first();
-		if (node)
-			node = node->find_by_address(arp->dst_ip());
+		Ipv4_address_node *node = vlan().ip_table.lookup(arp->dst_ip());
 		if (!node) {
 			arp->src_mac(_nic.mac());
 		}
@@ -74,11 +74,9 @@ bool Session_component::handle_ip(Ethernet_frame *eth, Genode::size_t size)
 void Session_component::finalize_packet(Ethernet_frame *eth,
                                                     Genode::size_t size)
 {
-	Mac_address_node *node = vlan().mac_tree.first();
-	if (node)
-		node = node->find_by_address(eth->dst());
+	Mac_address_node *node = vlan().mac_table.lookup(eth->dst());
 	if (node)
-		node->component().send(eth, size);
+		node->component().deliver(eth, size);
 	else {
 		/* set our MAC as sender */
 		eth->src(_nic.mac());
@@ -89,33 +87,50 @@ void Session_component::finalize_packet(Ethernet_frame *eth,
 
 void Session_component::_unset_ipv4_node()
 {
-	Ipv4_address_node * first = vlan().ip_tree.first();
-	if (!first) return;
-	if (first->find_by_address(_ipv4_node.addr()))
-		vlan().ip_tree.remove(&_ipv4_node);
+	if (vlan().ip_table.contains(_ipv4_node))
+		vlan().ip_table.remove(_ipv4_node);
 }
 
 
 bool Session_component::link_state() { return _nic.link_state(); }
 
 
+void Session_component::deliver(Ethernet_frame *eth, Genode::size_t size)
+{
+	/* broadcasts are delivered to queue 0 only */
+	unsigned const queue = eth->dst() == Ethernet_frame::BROADCAST
+	                     ? 0 : ::Nic::Flow_hash::queue(eth, size, _queues);
+
+	if (queue && _queue_sessions[queue])
+		_queue_sessions[queue]->send(eth, size);
+	else
+		send(eth, size);
+}
+
+
 void Session_component::set_ipv4_address(Ipv4_address ip_addr)
 {
 	_unset_ipv4_node();
 	_ipv4_node.addr(ip_addr);
-	vlan().ip_tree.insert(&_ipv4_node);
+	vlan().ip_table.insert(_ipv4_node);
 }
 
 
-Session_component::Session_component(Genode::Ram_session        &ram,
-                                     Genode::Region_map         &rm,
-                                     Genode::Entrypoint         &ep,
-                                     Genode::size_t              amount,
-                                     Genode::size_t              tx_buf_size,
-                                     Genode::size_t              rx_buf_size,
-                                     Mac_address                 vmac,
-                                     Net::Nic                   &nic,
-                                     char                       *ip_addr)
+Session_component::Session_component(Genode::Ram_session         &ram,
+                                     Genode::Region_map          &rm,
+                                     Genode::Entrypoint          &ep,
+                                     Genode::size_t               amount,
+                                     Genode::size_t               tx_buf_size,
+                                     Genode::size_t               rx_buf_size,
+                                     Mac_address                  vmac,
+                                     Net::Nic                    &nic,
+                                     Genode::Session_label const &label,
+                                     unsigned                     queue,
+                                     unsigned                     queues,
+                                     Session_component           *primary,
+                                     Timer::Connection           *timer,
+                                     unsigned long                packet_rate,
+                                     char                        *ip_addr)
 : Stream_allocator(ram, rm, amount),
   Stream_dataspaces(ram, tx_buf_size, rx_buf_size),
   Session_rpc_object(rm,
@@ -125,9 +140,28 @@ Session_component::Session_component(Genode::Ram_session        &ram,
   Packet_handler(ep, nic.vlan()),
   _mac_node(*this, vmac),
   _ipv4_node(*this),
-  _nic(nic)
+  _nic(nic),
+  _label(label), _queue(queue), _queues(queues), _primary(primary)
 {
-	vlan().mac_tree.insert(&_mac_node);
+	for (unsigned i = 0; i < MAX_QUEUES; i++)
+		_queue_sessions[i] = nullptr;
+
+	if (timer && packet_rate)
+		_rate_limit.construct(*timer, packet_rate);
+
+	_tx.sigh_ready_to_ack(_sink_ack);
+	_tx.sigh_packet_avail(_sink_submit);
+	_rx.sigh_ack_avail(_source_ack);
+	_rx.sigh_ready_to_submit(_source_submit);
+
+	/* an additional queue shares the addresses of the primary session */
+	if (_queue) {
+		_primary->_queue_sessions[_queue] = this;
+		return;
+	}
+	_queue_sessions[0] = this;
+
+	vlan().mac_table.insert(_mac_node);
 	vlan().mac_list.insert(&_mac_node);
 
 	/* static ip parsing */
@@ -141,16 +175,21 @@ Session_component::Session_component(Genode::Ram_session        &ram,
 			Genode::log("vmac = ", vmac, " ip = ", ip);
 		}
 	}
-
-	_tx.sigh_ready_to_ack(_sink_ack);
-	_tx.sigh_packet_avail(_sink_submit);
-	_rx.sigh_ack_avail(_source_ack);
-	_rx.sigh_ready_to_submit(_source_submit);
 }
 
 
 Session_component::~Session_component() {
-	vlan().mac_tree.remove(&_mac_node);
+
+	if (_queue) {
+		if (_primary)
+			_primary->_queue_sessions[_queue] = nullptr;
+		return;
+	}
+	for (unsigned i = 1; i < _queues; i++)
+		if (_queue_sessions[i])
+			_queue_sessions[i]->_primary = nullptr;
+
+	vlan().mac_table.remove(_mac_node);
 	vlan().mac_list.remove(&_mac_node);
 	_unset_ipv4_node();
 }
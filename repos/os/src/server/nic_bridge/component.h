@@ -24,7 +24,9 @@
 #include <os/ram_session_guard.h>
 #include <os/session_policy.h>
 #include <root/component.h>
+#include <timer_session/connection.h>
 #include <util/arg_string.h>
+#include <util/reconstructible.h>
 
 #include <address_node.h>
 #include <nic.h>
@@ -34,6 +36,7 @@ namespace Net {
 	class Stream_allocator;
 	class Stream_dataspace;
 	class Stream_dataspaces;
+	class Rate_limit;
 	class Session_component;
 	class Root;
 }
@@ -86,6 +89,55 @@ struct Net::Stream_dataspaces
 };
 
 
+/**
+ * Token bucket that limits the rate of packets sent by a client
+ *
+ * The bucket holds the packets of up to 100 ms, which permits short bursts.
+ */
+class Net::Rate_limit
+{
+	private:
+
+		Timer::Connection   &_timer;
+		unsigned long const  _rate;    /* packets per second */
+		unsigned long const  _burst;
+		unsigned long        _tokens;
+		unsigned long        _last_ms;
+
+	public:
+
+		Rate_limit(Timer::Connection &timer, unsigned long rate)
+		:
+			_timer(timer), _rate(rate), _burst(Genode::max(rate / 10, 1UL)),
+			_tokens(_burst), _last_ms(timer.elapsed_ms())
+		{ }
+
+		/**
+		 * Take tokens for up to 'count' packets
+		 *
+		 * \return number of packets that may pass
+		 */
+		unsigned admit(unsigned count)
+		{
+			using namespace Genode;
+
+			unsigned long const now     = _timer.elapsed_ms();
+			unsigned long const elapsed = min(now - _last_ms, 1000UL);
+			unsigned long const refill  = elapsed * _rate / 1000;
+
+			/* keep the fraction of a token for the next time */
+			if (refill) {
+				_tokens  = min(_burst, _tokens + refill);
+				_last_ms = now;
+			}
+
+			unsigned const admitted = (unsigned)min((unsigned long)count, _tokens);
+			_tokens -= admitted;
+			return admitted;
+		}
+};
+
+
 /**
  * Nic-session component class
  *
@@ -100,10 +152,27 @@ class Net::Session_component : public  Net::Stream_allocator,
 {
 	private:
 
+		enum { MAX_QUEUES = ::Nic::Session::MAX_QUEUES };
+
 		Mac_address_node                  _mac_node;
 		Ipv4_address_node                 _ipv4_node;
 		Net::Nic                         &_nic;
 		Genode::Signal_context_capability _link_state_sigh;
+		Genode::Session_label       const _label;
+
+		/*
+		 * Multi-queue support
+		 *
+		 * The first session of a multi-queue session (queue 0) is the
+		 * primary one. It owns the MAC address and knows the sessions of the
+		 * other queues, which in turn refer to the primary session.
+		 */
+		unsigned           const _queue;
+		unsigned           const _queues;
+		Session_component       *_primary;
+		Session_component       *_queue_sessions[MAX_QUEUES];
+
+		Genode::Constructible<Rate_limit> _rate_limit;
 
 		void _unset_ipv4_node();
 
@@ -119,16 +188,29 @@ class Net::Session_component : public  Net::Stream_allocator,
 		 * \param tx_buf_size  buffer size for tx channel
 		 * \param rx_buf_size  buffer size for rx channel
 		 * \param vmac         virtual mac address
+		 * \param label        session label
+		 * \param queue        index within the multi-queue session
+		 * \param queues       number of queues of the multi-queue session
+		 * \param primary      session of queue 0 if 'queue' is not 0
+		 * \param timer        timer used for the rate limit
+		 * \param packet_rate  maximum packets per second sent by the client,
+		 *                     0 for no limit
 		 */
-		Session_component(Genode::Ram_session &ram,
-		                  Genode::Region_map  &rm,
-		                  Genode::Entrypoint  &ep,
-		                  Genode::size_t       amount,
-		                  Genode::size_t       tx_buf_size,
-		                  Genode::size_t       rx_buf_size,
-		                  Mac_address          vmac,
-		                  Net::Nic            &nic,
-		                  char                *ip_addr = 0);
+		Session_component(Genode::Ram_session         &ram,
+		                  Genode::Region_map          &rm,
+		                  Genode::Entrypoint          &ep,
+		                  Genode::size_t               amount,
+		                  Genode::size_t               tx_buf_size,
+		                  Genode::size_t               rx_buf_size,
+		                  Mac_address                  vmac,
+		                  Net::Nic                    &nic,
+		                  Genode::Session_label const &label,
+		                  unsigned                     queue,
+		                  unsigned                     queues,
+		                  Session_component           *primary,
+		                  Timer::Connection           *timer,
+		                  unsigned long                packet_rate,
+		                  char                        *ip_addr = 0);
 
 		~Session_component();
 
@@ -144,6 +226,30 @@ class Net::Session_component : public  Net::Stream_allocator,
 		{
 			if (_link_state_sigh.valid())
 				Genode::Signal_transmitter(_link_state_sigh).submit();
+
+			for (unsigned i = 1; i < _queues; i++)
+				if (_queue_sessions[i])
+					_queue_sessions[i]->link_state_changed();
+		}
+
+		/**
+		 * Deliver ethernet frame to the client
+		 *
+		 * For a multi-queue session, the frame is passed to the queue
+		 * selected by the flow hash of the frame. Broadcasts are passed
+		 * to queue 0.
+		 */
+		void deliver(Ethernet_frame *eth, Genode::size_t size);
+
+		/**
+		 * Return true if session is the primary one of a multi-queue session
+		 * with the given label that has no session for 'queue' yet
+		 */
+		bool queue_free(Genode::Session_label const &label,
+		                unsigned queue, unsigned queues) const
+		{
+			return !_queue && _label == label && _queues == queues &&
+			       queue < _queues && !_queue_sessions[queue];
 		}
 
 		void set_ipv4_address(Ipv4_address ip_addr);
@@ -172,6 +278,9 @@ class Net::Session_component : public  Net::Stream_allocator,
 		bool handle_arp(Ethernet_frame *eth,      Genode::size_t size);
 		bool handle_ip(Ethernet_frame *eth,       Genode::size_t size);
 		void finalize_packet(Ethernet_frame *eth, Genode::size_t size);
+
+		unsigned admit(unsigned count) override {
+			return _rate_limit.constructed() ? _rate_limit->admit(count) : count; }
 };
 
 
@@ -187,6 +296,9 @@ class Net::Root : public Genode::Root_component<Net::Session_component>
 		Net::Nic         &_nic;
 		Genode::Xml_node  _config;
 
+		/* used for rate limits only */
+		Genode::Constructible<Timer::Connection> _timer;
+
 	protected:
 
 		Session_component *_create_session(const char *args)
@@ -197,9 +309,12 @@ class Net::Root : public Genode::Root_component<Net::Session_component>
 			char ip_addr[MAX_IP_ADDR_LENGTH];
 			memset(ip_addr, 0, MAX_IP_ADDR_LENGTH);
 
+			unsigned long packet_rate = 0;
+
 			 try {
 				Session_label const label = label_from_args(args);
 				Session_policy policy(label, _config);
+				packet_rate = policy.attribute_value("tx_packet_rate", 0UL);
 				policy.attribute("ip_addr").value(ip_addr, sizeof(ip_addr));
 			} catch (Xml_node::Nonexistent_attribute) {
 				Genode::log("Missing \"ip_addr\" attribute in policy definition");
@@ -211,12 +326,51 @@ class Net::Root : public Genode::Root_component<Net::Session_component>
 				Arg_string::find_arg(args, "tx_buf_size").ulong_value(0);
 			size_t rx_buf_size =
 				Arg_string::find_arg(args, "rx_buf_size").ulong_value(0);
+			unsigned queue =
+				Arg_string::find_arg(args, "queue" ).ulong_value(0);
+			unsigned queues =
+				Arg_string::find_arg(args, "queues").ulong_value(1);
+
+			if (!queues || queues > ::Nic::Session::MAX_QUEUES ||
+			    queue >= queues) {
+				Genode::warning("invalid queue arguments");
+				throw Service_denied();
+			}
+
+			Session_label const label = label_from_args(args);
+
+			if (packet_rate && !_timer.constructed())
+				_timer.construct(_env);
+
+			Timer::Connection *timer = _timer.constructed() ? &*_timer : nullptr;
 
 			try {
+				if (!queue)
+					return new (md_alloc())
+						Session_component(_env.ram(), _env.rm(), _env.ep(),
+						                  ram_quota, tx_buf_size, rx_buf_size,
+						                  _mac_alloc.alloc(), _nic, label,
+						                  0, queues, nullptr, timer, packet_rate,
+						                  ip_addr);
+
+				/* find primary session of the multi-queue session */
+				Mac_address_node *node = _nic.vlan().mac_list.first();
+				for (; node; node = node->next())
+					if (node->component().queue_free(label, queue, queues))
+						break;
+
+				if (!node) {
+					Genode::warning("no primary session for queue ", queue,
+					                " of \"", label, "\"");
+					throw Service_denied();
+				}
+				Session_component &primary = node->component();
 				return new (md_alloc())
 					Session_component(_env.ram(), _env.rm(), _env.ep(),
 					                  ram_quota, tx_buf_size, rx_buf_size,
-					                  _mac_alloc.alloc(), _nic, ip_addr);
+					                  primary.mac_address(), _nic, label,
+					                  queue, queues, &primary, timer,
+					                  packet_rate);
 			}
 			catch (Mac_allocator::Alloc_failed) {
 				Genode::warning("Mac address allocation failed!");
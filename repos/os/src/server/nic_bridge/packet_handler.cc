@@ -25,27 +25,71 @@ using namespace Net;
 
 void Packet_handler::_ready_to_submit()
 {
+	Packet_descriptor packets[PACKET_BATCH_SIZE];
+
 	/* as long as packets are available, and we can ack them */
 	while (sink()->packet_avail()) {
-		_packet = sink()->get_packet();
-		if (!_packet.size()) continue;
-		handle_ethernet(sink()->packet_content(_packet), _packet.size());
 
 		if (!sink()->ready_to_ack()) {
 			Genode::warning("ack state FULL");
 			return;
 		}
 
-		sink()->acknowledge_packet(_packet);
+		/* do not fetch more packets than we can acknowledge at once */
+		unsigned const max      = Genode::min((unsigned)PACKET_BATCH_SIZE,
+		                                      sink()->ack_slots_free());
+		unsigned const count    = sink()->get_packets(packets, max);
+		unsigned const admitted = admit(count);
+
+		unsigned valid = 0;
+		for (unsigned i = 0; i < count; i++) {
+			if (!packets[i].size()) continue;
+			if (i < admitted)
+				handle_ethernet(sink()->packet_content(packets[i]),
+				                packets[i].size());
+			packets[valid++] = packets[i];
+		}
+
+		_flush_all_pending();
+
+		sink()->acknowledge_packets(packets, valid);
+	}
+}
+
+
+void Packet_handler::_submit_pending()
+{
+	unsigned const submitted = source()->submit_packets(_pending, _num_pending);
+
+	/* drop packets that do not fit into the submit queue */
+	for (unsigned i = submitted; i < _num_pending; i++)
+		source()->release_packet(_pending[i]);
+
+	if (submitted < _num_pending)
+		Genode::warning("Packet dropped");
+
+	_num_pending = 0;
+}
+
+
+void Packet_handler::_flush_all_pending()
+{
+	while (Packet_handler *handler = _vlan.pending_handlers.first()) {
+		_vlan.pending_handlers.remove(handler);
+		handler->_submit_pending();
 	}
 }
 
 
 void Packet_handler::_ready_to_ack()
 {
+	Packet_descriptor packets[PACKET_BATCH_SIZE];
+
 	/* check for acknowledgements */
-	while (source()->ack_avail())
-		source()->release_packet(source()->get_acked_packet());
+	for (unsigned count;
+	     (count = source()->get_acked_packets(packets, PACKET_BATCH_SIZE)); )
+		for (unsigned i = 0; i < count; i++)
+			source()->release_packet(packets[i]);
 }
 
 
@@ -68,7 +112,7 @@ void Packet_handler::broadcast_to_clients(Ethernet_frame *eth, Genode::size_t si
 			_vlan.mac_list.first();
 		while (node) {
 			/* deliver packet */
-			node->component().send(eth, size);
+			node->component().deliver(eth, size);
 			node = node->next();
 		}
 	}
@@ -110,11 +154,20 @@ void Packet_handler::handle_ethernet(void* src, Genode::size_t size)
 void Packet_handler::send(Ethernet_frame *eth, Genode::size_t size)
 {
 	try {
-		/* copy and submit packet */
+		/* copy packet and defer submission */
 		Packet_descriptor packet  = source()->alloc_packet(size);
 		char             *content = source()->packet_content(packet);
 		Genode::memcpy((void*)content, (void*)eth, size);
-		source()->submit_packet(packet);
+
+		if (!_num_pending)
+			_vlan.pending_handlers.insert(this);
+
+		_pending[_num_pending++] = packet;
+
+		if (_num_pending == PACKET_BATCH_SIZE) {
+			_vlan.pending_handlers.remove(this);
+			_submit_pending();
+		}
 	} catch(Packet_stream_source< ::Nic::Session::Policy>::Packet_alloc_failed) {
 		Genode::warning("Packet dropped");
 	}
@@ -129,3 +182,11 @@ Packet_handler::Packet_handler(Genode::Entrypoint &ep, Vlan &vlan)
   _source_submit(ep, *this, &Packet_handler::_packet_avail),
   _client_link_state(ep, *this, &Packet_handler::_link_state)
 { }
+
+
+Packet_handler::~Packet_handler()
+{
+	/* pending packets are freed along with the packet stream */
+	if (_num_pending)
+		_vlan.pending_handlers.remove(this);
+}
@@ -35,12 +35,33 @@ namespace Net {
 /**
  * Generic packet handler used as base for NIC and client packet handlers.
  */
-class Net::Packet_handler
+class Net::Packet_handler : public Genode::List<Packet_handler>::Element
 {
 	private:
 
-		Packet_descriptor _packet;
-		Net::Vlan        &_vlan;
+		/* number of packets fetched from a stream at once */
+		enum { PACKET_BATCH_SIZE = 32 };
+
+		Net::Vlan &_vlan;
+
+		/*
+		 * Packets sent to this handler are submitted as a batch, either when
+		 * the batch is full or when the sending handler finished its batch
+		 * of received packets. Handlers with pending packets are listed at
+		 * the VLAN.
+		 */
+		Packet_descriptor _pending[PACKET_BATCH_SIZE];
+		unsigned          _num_pending = 0;
+
+		/**
+		 * Submit pending packets to the sink
+		 */
+		void _submit_pending();
+
+		/**
+		 * Submit the pending packets of all handlers
+		 */
+		void _flush_all_pending();
 
 		/**
 		 * submit queue not empty anymore
@@ -85,6 +106,8 @@ class Net::Packet_handler
 
 		Packet_handler(Genode::Entrypoint&, Vlan&);
 
+		virtual ~Packet_handler();
+
 		virtual Packet_stream_sink< ::Nic::Session::Policy>   * sink()   = 0;
 		virtual Packet_stream_source< ::Nic::Session::Policy> * source() = 0;
 
@@ -103,6 +126,9 @@ class Net::Packet_handler
 		/**
 		 * Send ethernet frame
 		 *
+		 * The frame is copied to a packet whose submission is deferred until
+		 * the end of the current batch.
+		 *
 		 * \param eth   ethernet frame to send.
 		 * \param size  ethernet frame's size.
 		 */
@@ -134,6 +160,14 @@ class Net::Packet_handler
 		virtual bool handle_ip(Ethernet_frame *eth,
 		                       Genode::size_t size)    = 0;
 
+		/**
+		 * Return how many of 'count' received packets may be handled
+		 *
+		 * The remaining packets of the batch are dropped. By default, all
+		 * packets are handled.
+		 */
+		virtual unsigned admit(unsigned count) { return count; }
+
 		/*
 		 * Finalize handling of ethernet frame.
 		 *
@@ -0,0 +1,233 @@
+/*
+ * \brief  Capturing of NIC traffic to a pcap file
+ * \author Genode Labs
+ * \date   2026-10-14
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/log.h>
+#include <file_system/util.h>
+#include <os/path.h>
+
+/* local includes */
+#include <capture.h>
+
+using namespace Net;
+using namespace Genode;
+
+
+namespace {
+
+	struct Pcap_file_header
+	{
+		uint32_t magic;
+		uint16_t version_major;
+		uint16_t version_minor;
+		int32_t  thiszone;
+		uint32_t sigfigs;
+		uint32_t snaplen;
+		uint32_t linktype;
+
+	} __attribute__((packed));
+
+	struct Pcap_record_header
+	{
+		uint32_t ts_sec;
+		uint32_t ts_usec;
+		uint32_t incl_len;
+		uint32_t orig_len;
+
+	} __attribute__((packed));
+
+	enum { PCAP_MAGIC = 0xa1b2c3d4, LINKTYPE_ETHERNET = 1 };
+
+	unsigned be16(uint8_t const *p) { return (p[0] << 8) | p[1]; }
+
+	size_t power_of_two_above(size_t value)
+	{
+		size_t result = 1;
+		while (result < value)
+			result <<= 1;
+		return result;
+	}
+}
+
+
+/********************
+ ** Capture_filter **
+ ********************/
+
+bool Capture_filter::matches(uint8_t const *eth, size_t size) const
+{
+	enum {
+		ETH_HEADER_SIZE = 14, ETH_TYPE_OFFSET = 12, ETH_TYPE_IPV4 = 0x800,
+		IP_PROTOCOL_OFFSET = 9, IP_PROTOCOL_TCP = 6, IP_PROTOCOL_UDP = 17,
+	};
+
+	if (!_ether_type && !_ip_protocol && !_port)
+		return true;
+
+	if (size < ETH_HEADER_SIZE)
+		return false;
+
+	unsigned const ether_type = be16(eth + ETH_TYPE_OFFSET);
+	if (_ether_type && ether_type != _ether_type)
+		return false;
+
+	if (!_ip_protocol && !_port)
+		return true;
+
+	/* the remaining criteria refer to IPv4 packets */
+	uint8_t const *ip = eth + ETH_HEADER_SIZE;
+	if (ether_type != ETH_TYPE_IPV4 || size < ETH_HEADER_SIZE + 20)
+		return false;
+
+	unsigned const protocol = ip[IP_PROTOCOL_OFFSET];
+	if (_ip_protocol && protocol != _ip_protocol)
+		return false;
+
+	if (!_port)
+		return true;
+
+	if (protocol != IP_PROTOCOL_TCP && protocol != IP_PROTOCOL_UDP)
+		return false;
+
+	size_t const ip_header_size = (ip[0] & 0xf)*4;
+	uint8_t const *l4 = ip + ip_header_size;
+	if (size < ETH_HEADER_SIZE + ip_header_size + 4)
+		return false;
+
+	return be16(l4) == _port || be16(l4 + 2) == _port;
+}
+
+
+/*************
+ ** Capture **
+ *************/
+
+File_system::File_handle Capture::_open(File_system::Session &fs, char const *path)
+{
+	using namespace File_system;
+
+	Genode::Path<MAX_PATH_LEN> dir_path(path);
+	dir_path.strip_last_element();
+
+	Dir_handle dir = ensure_dir(fs, dir_path.base());
+	Handle_guard dir_guard(fs, dir);
+
+	File_system::Name const name(basename(path));
+
+	try { return fs.file(dir, name, WRITE_ONLY, true); }
+	catch (Node_already_exists) { }
+
+	File_handle file = fs.file(dir, name, WRITE_ONLY, false);
+	fs.truncate(file, 0);
+	return file;
+}
+
+
+void Capture::_write(void const *src, size_t len)
+{
+	size_t const written = File_system::write(_fs, _file, src, len, _seek);
+	if (written < len)
+		error("capture: writing to file failed");
+
+	_seek += written;
+}
+
+
+void Capture::entry()
+{
+	unsigned long last_flush_ms = _timer.elapsed_ms();
+	unsigned long logged_drops  = 0;
+
+	for (;;) {
+
+		unsigned long const now_ms = _timer.elapsed_ms();
+		size_t        const avail  = _ring.avail();
+
+		bool const flush = avail && now_ms - last_flush_ms >= FLUSH_INTERVAL_MS;
+
+		if (avail < _chunk_size && !flush) {
+			_timer.msleep(POLL_INTERVAL_MS);
+			continue;
+		}
+
+		/* drain all available data, one contiguous part at a time */
+		for (size_t remaining = avail; remaining; ) {
+			size_t len = 0;
+			uint8_t const *data = _ring.peek(len);
+			len = min(len, remaining);
+
+			_write(data, len);
+			_ring.consume(len);
+			remaining -= len;
+		}
+		last_flush_ms = now_ms;
+
+		unsigned long const dropped = __atomic_load_n(&_dropped, __ATOMIC_RELAXED);
+		if (dropped != logged_drops) {
+			warning("capture: ", dropped - logged_drops, " frames dropped, "
+			        "consider a larger 'buffer'");
+			logged_drops = dropped;
+		}
+	}
+}
+
+
+void Capture::frame(void const *eth, size_t size, Duration time)
+{
+	if (!_filter.matches((uint8_t const *)eth, size))
+		return;
+
+	size_t const incl_len = min(size, _snaplen);
+
+	if (_ring.free_space() < sizeof(Pcap_record_header) + incl_len) {
+		__atomic_store_n(&_dropped, _dropped + 1, __ATOMIC_RELAXED);
+		return;
+	}
+
+	uint64_t const us = time.trunc_to_plain_us().value;
+
+	Pcap_record_header const header {
+		(uint32_t)(us / 1000000), (uint32_t)(us % 1000000),
+		(uint32_t)incl_len, (uint32_t)size };
+
+	_ring.write(&header, sizeof(header));
+	_ring.write(eth, incl_len);
+	_ring.commit();
+}
+
+
+Capture::Capture(Env &env, Allocator &alloc, Xml_node config)
+:
+	Thread(env, "capture", STACK_SIZE),
+	_env(env), _path(config.attribute_value("file", Path("/nic_dump.pcap"))),
+	_filter(config),
+	_snaplen(config.attribute_value("snaplen", (size_t)DEFAULT_SNAPLEN)),
+	_ring_ds(env.ram(), env.rm(),
+	         power_of_two_above(config.attribute_value("buffer",
+	                                                   Number_of_bytes(1024*1024)))),
+	_ring(_ring_ds.local_addr<uint8_t>(), _ring_ds.size()),
+	_chunk_size(max((size_t)MIN_CHUNK_SIZE, _ring.size() / 4)),
+	_fs_block_alloc(&alloc),
+	_fs(env, _fs_block_alloc, "capture"),
+	_file(_open(_fs, _path.string()))
+{
+	Pcap_file_header const header {
+		PCAP_MAGIC, 2, 4, 0, 0, (uint32_t)_snaplen, LINKTYPE_ETHERNET };
+
+	_ring.write(&header, sizeof(header));
+	_ring.commit();
+
+	log("capture frames to file \"", _path, "\"");
+
+	start();
+}
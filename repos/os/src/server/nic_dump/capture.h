@@ -0,0 +1,201 @@
+/*
+ * \brief  Capturing of NIC traffic to a pcap file
+ * \author Genode Labs
+ * \date   2026-10-14
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _CAPTURE_H_
+#define _CAPTURE_H_
+
+/* Genode includes */
+#include <base/allocator_avl.h>
+#include <base/attached_ram_dataspace.h>
+#include <base/thread.h>
+#include <file_system_session/connection.h>
+#include <timer_session/connection.h>
+#include <util/xml_node.h>
+
+namespace Net {
+
+	class Capture_filter;
+	class Capture_ring;
+	class Capture;
+}
+
+
+/**
+ * Filter evaluated on the raw frame before anything is copied
+ *
+ * A criterion that is not configured matches all frames.
+ */
+class Net::Capture_filter
+{
+	private:
+
+		unsigned const _ether_type;   /* 0 matches all */
+		unsigned const _ip_protocol;  /* 0 matches all */
+		unsigned const _port;         /* TCP/UDP source or destination */
+
+	public:
+
+		Capture_filter(Genode::Xml_node config)
+		:
+			_ether_type (config.attribute_value("ether_type",  0U)),
+			_ip_protocol(config.attribute_value("ip_protocol", 0U)),
+			_port       (config.attribute_value("port",        0U))
+		{ }
+
+		bool matches(Genode::uint8_t const *eth, Genode::size_t size) const;
+};
+
+
+/**
+ * Byte ring written by the entrypoint and drained by the capture thread
+ *
+ * The ring has a single producer and a single consumer, which only
+ * exchange the positions of the ring via atomic loads and stores.
+ */
+class Net::Capture_ring
+{
+	private:
+
+		Genode::uint8_t     *_buf;
+		Genode::size_t const _size;     /* power of two */
+
+		unsigned long _head = 0;        /* written by producer */
+		unsigned long _tail = 0;        /* written by consumer */
+
+		unsigned long _load(unsigned long const &pos) const {
+			return __atomic_load_n(&pos, __ATOMIC_ACQUIRE); }
+
+		void _store(unsigned long &pos, unsigned long value) {
+			__atomic_store_n(&pos, value, __ATOMIC_RELEASE); }
+
+	public:
+
+		Capture_ring(Genode::uint8_t *buf, Genode::size_t size)
+		: _buf(buf), _size(size) { }
+
+		Genode::size_t size() const { return _size; }
+
+		/************************
+		 ** Producer interface **
+		 ************************/
+
+		Genode::size_t free_space() const {
+			return _size - (_head - _load(_tail)); }
+
+		/**
+		 * Append data, the caller must have checked the free space
+		 */
+		void write(void const *src, Genode::size_t len)
+		{
+			Genode::size_t const offset = _head & (_size - 1);
+			Genode::size_t const first  = Genode::min(len, _size - offset);
+
+			Genode::memcpy(_buf + offset, src, first);
+			Genode::memcpy(_buf, (Genode::uint8_t const *)src + first, len - first);
+
+			_head += len;
+		}
+
+		/**
+		 * Make the written data visible to the consumer
+		 */
+		void commit() { _store(_head, _head); }
+
+		/************************
+		 ** Consumer interface **
+		 ************************/
+
+		Genode::size_t avail() const { return _load(_head) - _tail; }
+
+		/**
+		 * Return contiguous part of the available data
+		 */
+		Genode::uint8_t const *peek(Genode::size_t &len) const
+		{
+			Genode::size_t const offset = _tail & (_size - 1);
+			len = Genode::min(avail(), _size - offset);
+			return _buf + offset;
+		}
+
+		void consume(Genode::size_t len) { _store(_tail, _tail + len); }
+};
+
+
+/**
+ * Capture of the frames passing the component in pcap format
+ *
+ * The frames are written to the ring by the entrypoint. A separate thread
+ * drains the ring in large chunks to a file of a file-system session. If the
+ * ring is full, frames are not captured but dropped from the capture.
+ */
+class Net::Capture : private Genode::Thread
+{
+	private:
+
+		enum {
+			STACK_SIZE        = 4*1024*sizeof(long),
+			MIN_CHUNK_SIZE    = 64*1024,
+			FLUSH_INTERVAL_MS = 100,
+			POLL_INTERVAL_MS  = 10,
+			DEFAULT_SNAPLEN   = 1518,
+		};
+
+		using Path = Genode::String<File_system::MAX_PATH_LEN>;
+
+		Genode::Env                    &_env;
+		Path const                      _path;
+		Capture_filter const            _filter;
+		Genode::size_t const            _snaplen;
+		Genode::Attached_ram_dataspace  _ring_ds;
+		Capture_ring                    _ring;
+		Genode::size_t const            _chunk_size;
+
+		unsigned long _dropped = 0;   /* written by producer */
+
+		/* used by the capture thread only */
+		Timer::Connection               _timer { _env };
+		Genode::Allocator_avl           _fs_block_alloc;
+		File_system::Connection         _fs;
+		File_system::File_handle        _file;
+		File_system::seek_off_t         _seek = 0;
+
+		File_system::File_handle _open(File_system::Session &, char const *path);
+
+		void _write(void const *src, Genode::size_t len);
+
+
+		/************
+		 ** Thread **
+		 ************/
+
+		void entry() override;
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param config  '<capture>' node of the configuration
+		 *
+		 * \throw File_system::Lookup_failed
+		 * \throw File_system::Permission_denied
+		 */
+		Capture(Genode::Env &env, Genode::Allocator &alloc, Genode::Xml_node config);
+
+		/**
+		 * Capture frame, called by the entrypoint
+		 */
+		void frame(void const *eth, Genode::size_t size, Genode::Duration time);
+};
+
+#endif /* _CAPTURE_H_ */
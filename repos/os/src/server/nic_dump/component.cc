@@ -61,6 +61,7 @@ Net::Session_component::Session_component(Allocator         &alloc,
                                           Xml_node           config,
                                           Timer::Connection &timer,
                                           Duration          &curr_time,
+                                          Capture           *capture,
                                           Env               &env)
 :
 	Session_component_base(alloc, amount, env.ram(), tx_buf_size, rx_buf_size),
@@ -68,8 +69,8 @@ Net::Session_component::Session_component(Allocator         &alloc,
 	                   env.ep().rpc_ep()),
 	Interface(env.ep(), config.attribute_value("downlink", Interface_label()),
 	          timer, curr_time, config.attribute_value("time", false),
-	          _guarded_alloc),
-	_uplink(env, config, timer, curr_time, alloc),
+	          config.attribute_value("log", !capture), capture, _guarded_alloc),
+	_uplink(env, config, timer, curr_time, capture, alloc),
 	_link_state_handler(env.ep(), *this, &Session_component::_handle_link_state)
 {
 	_tx.sigh_ready_to_ack(_sink_ack);
@@ -109,11 +110,13 @@ Net::Root::Root(Env               &env,
                 Allocator         &alloc,
                 Xml_node           config,
                 Timer::Connection &timer,
-                Duration          &curr_time)
+                Duration          &curr_time,
+                Capture           *capture)
 :
 	Root_component<Session_component, Genode::Single_client>(&env.ep().rpc_ep(),
 	                                                         &alloc),
-	_env(env), _config(config), _timer(timer), _curr_time(curr_time)
+	_env(env), _config(config), _timer(timer), _curr_time(curr_time),
+	_capture(capture)
 { }
 
 
@@ -145,7 +148,7 @@ Session_component *Net::Root::_create_session(char const *args)
 		return new (md_alloc())
 			Session_component(*md_alloc(), ram_quota - session_size,
 			                  tx_buf_size, rx_buf_size, _config, _timer,
-			                  _curr_time, _env);
+			                  _curr_time, _capture, _env);
 	}
 	catch (...) { throw Service_denied(); }
 }
@@ -13,6 +13,7 @@
 
 /* local includes */
 #include <interface.h>
+#include <capture.h>
 
 /* Genode includes */
 #include <net/ethernet.h>
@@ -26,11 +27,20 @@ void Interface::_handle_eth(void              *const  eth_base,
                             size_t             const  eth_size,
                             Packet_descriptor  const &pkt)
 {
+	/* the capture is done for the raw frame before it gets parsed */
+	if (_capture)
+		_capture->frame(eth_base, eth_size, _timer.curr_time());
+
 	try {
 		Ethernet_frame &eth = *new (eth_base) Ethernet_frame(eth_size);
 		Interface &remote = _remote.deref();
 		Packet_log_config log_cfg;
 
+		if (!_log_packets) {
+			remote._send(eth, eth_size);
+			return;
+		}
+
 		if (_log_time) {
 			Genode::Duration const new_time    = _timer.curr_time();
 			unsigned long    const new_time_ms = new_time.trunc_to_plain_us().value / 1000;
@@ -98,6 +108,8 @@ Interface::Interface(Entrypoint        &ep,
                      Timer::Connection &timer,
                      Duration          &curr_time,
                      bool               log_time,
+                     bool               log_packets,
+                     Capture           *capture,
                      Allocator         &alloc)
 :
 	_sink_ack     (ep, *this, &Interface::_ack_avail),
@@ -105,5 +117,5 @@ Interface::Interface(Entrypoint        &ep,
 	_source_ack   (ep, *this, &Interface::_ready_to_ack),
 	_source_submit(ep, *this, &Interface::_packet_avail),
 	_alloc(alloc), _label(label), _timer(timer), _curr_time(curr_time),
-	_log_time(log_time)
+	_log_time(log_time), _log_packets(log_packets), _capture(capture)
 { }
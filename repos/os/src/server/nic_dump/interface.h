@@ -28,6 +28,7 @@ namespace Net {
 	using Packet_stream_sink   = ::Nic::Packet_stream_sink< ::Nic::Session::Policy>;
 	using Packet_stream_source = ::Nic::Packet_stream_source< ::Nic::Session::Policy>;
 	class Ethernet_frame;
+	class Capture;
 	class Interface;
 	using Interface_label = Genode::String<64>;
 }
@@ -52,6 +53,8 @@ class Net::Interface
 		Timer::Connection  &_timer;
 		Genode::Duration   &_curr_time;
 		bool                _log_time;
+		bool                _log_packets;
+		Capture            *_capture;
 
 		void _send(Ethernet_frame &eth, Genode::size_t const eth_size);
 
@@ -80,6 +83,8 @@ class Net::Interface
 		          Timer::Connection  &timer,
 		          Genode::Duration   &curr_time,
 		          bool                log_time,
+		          bool                log_packets,
+		          Capture            *capture,
 		          Genode::Allocator  &alloc);
 
 		void remote(Interface &remote) { _remote.set(remote); }
@@ -16,8 +16,10 @@
 #include <base/heap.h>
 #include <base/attached_rom_dataspace.h>
 #include <timer_session/connection.h>
+#include <util/reconstructible.h>
 
 /* local includes */
+#include <capture.h>
 #include <component.h>
 
 using namespace Net;
@@ -32,18 +34,32 @@ class Main
 		Timer::Connection      _timer;
 		Duration               _curr_time { Microseconds(0UL) };
 		Heap                   _heap;
+		Constructible<Capture> _capture { };
 		Net::Root              _root;
 
+		Capture *_construct_capture(Env &env);
+
 	public:
 
 		Main(Env &env);
 };
 
 
+Capture *Main::_construct_capture(Env &env)
+{
+	try {
+		_capture.construct(env, _heap, _config.xml().sub_node("capture")); }
+	catch (Xml_node::Nonexistent_sub_node) { return nullptr; }
+
+	return &*_capture;
+}
+
+
 Main::Main(Env &env)
 :
 	_config(env, "config"), _timer(env), _heap(&env.ram(), &env.rm()),
-	_root(env, _heap, _config.xml(), _timer, _curr_time)
+	_root(env, _heap, _config.xml(), _timer, _curr_time,
+	      _construct_capture(env))
 {
 	env.parent().announce(env.ep().manage(_root));
 }
@@ -2,6 +2,6 @@ TARGET = nic_dump
 
 LIBS += base net
 
-SRC_CC += component.cc main.cc packet_log.cc uplink.cc interface.cc
+SRC_CC += component.cc main.cc packet_log.cc uplink.cc interface.cc capture.cc
 
 INC_DIR += $(PRG_DIR)
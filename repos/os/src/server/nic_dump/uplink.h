@@ -48,6 +48,7 @@ class Net::Uplink : public Nic::Packet_allocator,
 		       Genode::Xml_node   config,
 		       Timer::Connection &timer,
 		       Genode::Duration  &curr_time,
+		       Capture           *capture,
 		       Genode::Allocator &alloc);
 };
 
@@ -16,195 +16,49 @@
 
 /* Genode includes */
 #include <base/allocator.h>
+#include <util/bit_allocator.h>
 
-namespace Genode {
-
-	class Bit_array_dynamic;
-	class Bit_allocator_dynamic;
-}
-
-
-class Genode::Bit_array_dynamic
-{
-	public:
-
-		struct Invalid_bit_count              : Exception { };
-		struct Invalid_index_access           : Exception { };
-		struct Invalid_clear                  : Exception { };
-		struct Invalid_set                    : Exception { };
-		struct Count_of_bits_not_word_aligned : Exception { };
-
-	protected:
-
-		enum {
-			BITS_PER_BYTE = 8UL,
-			BITS_PER_WORD = sizeof(addr_t) * BITS_PER_BYTE
-		};
-
-	private:
-
-		unsigned _bit_cnt;
-		unsigned _word_cnt;
-		addr_t  *_words;
-
-		addr_t _word(addr_t index) const {
-			return index / BITS_PER_WORD; }
-
-		void _check_range(addr_t const index,
-		                  addr_t const width) const
-		{
-			if ((index >= _word_cnt * BITS_PER_WORD) ||
-			    width > _word_cnt * BITS_PER_WORD ||
-			    _word_cnt * BITS_PER_WORD - width < index)
-				throw Invalid_index_access();
-		}
-
-		addr_t _mask(addr_t const index, addr_t const width,
-		             addr_t &rest) const
-		{
-			addr_t const shift = index - _word(index) * BITS_PER_WORD;
-
-			rest = width + shift > BITS_PER_WORD ?
-			       width + shift - BITS_PER_WORD : 0;
-
-			return (width >= BITS_PER_WORD) ? ~0UL << shift
-			                                : ((1UL << width) - 1) << shift;
-		}
-
-		void _set(addr_t index, addr_t width, bool free)
-		{
-			_check_range(index, width);
-
-			addr_t rest, word, mask;
-			do {
-				word = _word(index);
-				mask = _mask(index, width, rest);
-
-				if (free) {
-					if ((_words[word] & mask) != mask)
-						throw Invalid_clear();
-					_words[word] &= ~mask;
-				} else {
-					if (_words[word] & mask)
-						throw Invalid_set();
-					_words[word] |= mask;
-				}
-
-				index = (_word(index) + 1) * BITS_PER_WORD;
-				width = rest;
-			} while (rest);
-		}
-
-	public:
-
-		/**
-		 * Return true if at least one bit is set between
-		 * index until index + width - 1
-		 */
-		bool get(addr_t index, addr_t width) const
-		{
-			_check_range(index, width);
-
-			bool used = false;
-			addr_t rest, mask;
-			do {
-				mask  = _mask(index, width, rest);
-				used  = _words[_word(index)] & mask;
-				index = (_word(index) + 1) * BITS_PER_WORD;
-				width = rest;
-			} while (!used && rest);
-
-			return used;
-		}
-
-		void set(addr_t const index, addr_t const width) {
-			_set(index, width, false); }
-
-		void clear(addr_t const index, addr_t const width) {
-			_set(index, width, true); }
-
-		Bit_array_dynamic(addr_t *addr, unsigned bits)
-		: _bit_cnt(bits), _word_cnt(_bit_cnt / BITS_PER_WORD),
-		  _words(addr)
-		{
-			if (!bits || bits % BITS_PER_WORD)
-				throw Invalid_bit_count();
-
-			memset(_words, 0, sizeof(addr_t)*_word_cnt);
-
-			if (bits % BITS_PER_WORD)
-				throw Count_of_bits_not_word_aligned();
-		}
-};
+namespace Genode { class Bit_allocator_dynamic; }
 
 
 class Genode::Bit_allocator_dynamic
 {
 	private:
 
-		addr_t             _next { 0 };
-		Allocator         &_alloc;
-		unsigned    const  _bits_aligned;
-		addr_t     *const  _ram;
-		Bit_array_dynamic  _array;
-
 		enum {
 			BITS_PER_BYTE = 8UL,
 			BITS_PER_WORD = sizeof(addr_t) * BITS_PER_BYTE,
 		};
 
-		/**
-		 * Reserve consecutive number of bits
-		 *
-		 * \noapi
-		 */
-		void _reserve(addr_t bit_start, size_t const num)
+		struct Bits : Bit_allocator_base
 		{
-			if (!num) return;
+			Bits(unsigned bits, unsigned bits_aligned, addr_t *ram)
+			:
+				Bit_allocator_base(bits_aligned, ram)
+			{
+				_reserve(bits, bits_aligned - bits);
+			}
+		};
 
-			_array.set(bit_start, num);
-		}
+		Allocator      &_alloc;
+		unsigned const  _bits_aligned;
+		addr_t  *const  _ram;
+		Bits            _bits;
 
 		size_t _ram_size() const
 		{
-			return (_bits_aligned / BITS_PER_WORD) * sizeof(addr_t);
+			return Bit_allocator_base::storage_words(_bits_aligned) * sizeof(addr_t);
 		}
 
 	public:
 
-		struct Out_of_indices : Exception { };
-
-		addr_t alloc(size_t const num_log2 = 0)
-		{
-			addr_t const step = 1UL << num_log2;
-			addr_t max = ~0UL;
+		using Out_of_indices = Bit_allocator_base::Out_of_indices;
 
-			do {
-				try {
-					/* throws exception if array is accessed outside bounds */
-					for (addr_t i = _next & ~(step - 1); i < max; i += step) {
-						if (_array.get(i, step))
-							continue;
+		addr_t alloc(size_t const num_log2 = 0) {
+			return _bits.alloc(num_log2); }
 
-						_array.set(i, step);
-						_next = i + step;
-						return i;
-					}
-				} catch (Bit_array_dynamic::Invalid_index_access) { }
-
-				max = _next;
-				_next = 0;
-
-			} while (max != 0);
-
-			throw Out_of_indices();
-		}
-
-		void free(addr_t const bit_start, size_t const num_log2 = 0)
-		{
-			_array.clear(bit_start, 1UL << num_log2);
-			_next = bit_start;
-		}
+		void free(addr_t const bit_start, size_t const num_log2 = 0) {
+			_bits.free(bit_start, num_log2); }
 
 		Bit_allocator_dynamic(Allocator &alloc, unsigned bits)
 		:
@@ -213,10 +67,8 @@ class Genode::Bit_allocator_dynamic
 			              bits + BITS_PER_WORD - (bits % BITS_PER_WORD) :
 			              bits),
 			_ram((addr_t *)_alloc.alloc(_ram_size())),
-			_array(_ram, _bits_aligned)
-		{
-			_reserve(bits, _bits_aligned - bits);
-		}
+			_bits(bits, _bits_aligned, _ram)
+		{ }
 
 		~Bit_allocator_dynamic()
 		{
@@ -36,7 +36,6 @@ class Net::Dhcp_client
 			INIT = 0, SELECT = 1, REQUEST = 2, BOUND = 3, RENEW = 4, REBIND = 5
 		};
 
-		Genode::Allocator                  &_alloc;
 		Interface                          &_interface;
 		State                                _state { State::INIT };
 		Timer::One_shot_timeout<Dhcp_client> _timeout;
@@ -62,8 +61,7 @@ class Net::Dhcp_client
 
 	public:
 
-		Dhcp_client(Genode::Allocator &alloc,
-		            Timer::Connection &timer,
+		Dhcp_client(Timer::Connection &timer,
 		            Interface         &interface);
 
 		void handle_ip(Ethernet_frame &eth, Genode::size_t eth_size);
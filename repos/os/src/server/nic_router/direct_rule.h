@@ -17,10 +17,12 @@
 /* local includes */
 #include <ipv4_address_prefix.h>
 #include <rule.h>
+#include <prefix_trie.h>
 
 /* Genode includes */
 #include <util/list.h>
 #include <util/xml_node.h>
+#include <util/reconstructible.h>
 
 namespace Genode { class Xml_node; }
 
@@ -67,34 +69,60 @@ struct Net::Direct_rule : Direct_rule_base,
 
 
 template <typename T>
-struct Net::Direct_rule_list : Genode::List<T>
+class Net::Direct_rule_list : public Genode::List<T>
 {
-	using List = Genode::List<T>;
+	private:
 
-	struct No_match : Genode::Exception { };
+		using List = Genode::List<T>;
 
-	T const &longest_prefix_match(Ipv4_address const &ip) const
-	{
-		/* first match is sufficient as the list is prefix-size-sorted */
-		for (T const *curr = List::first(); curr; curr = curr->next()) {
-			if (curr->dst().prefix_matches(ip)) {
-				return *curr; }
+		Genode::Constructible<Prefix_trie<T const> > _trie;
+
+	public:
+
+		struct No_match : Genode::Exception { };
+
+		/**
+		 * Compile the rules into a prefix trie for faster lookups
+		 *
+		 * Inserting a rule afterwards discards the trie until the next call.
+		 */
+		void compile(Genode::Allocator &alloc)
+		{
+			/* the first listed rule of two with the same prefix has precedence */
+			_trie.construct(alloc);
+			for (T const *curr = List::first(); curr; curr = curr->next()) {
+				_trie->insert(curr->dst(), *curr); }
+		}
+
+		T const &longest_prefix_match(Ipv4_address const &ip) const
+		{
+			if (_trie.constructed()) {
+				try { return _trie->longest_prefix_match(ip); }
+				catch (typename Prefix_trie<T const>::No_match) {
+					throw No_match(); }
+			}
+			/* first match is sufficient as the list is prefix-size-sorted */
+			for (T const *curr = List::first(); curr; curr = curr->next()) {
+				if (curr->dst().prefix_matches(ip)) {
+					return *curr; }
+			}
+			throw No_match();
 		}
-		throw No_match();
-	}
-
-	void insert(T &rule)
-	{
-		/* ensure that the list stays prefix-size-sorted (descending) */
-		T *behind = nullptr;
-		for (T *curr = List::first(); curr; curr = curr->next()) {
-			if (rule.dst().prefix >= curr->dst().prefix) {
-				break; }
-
-			behind = curr;
+
+		void insert(T &rule)
+		{
+			_trie.destruct();
+
+			/* ensure that the list stays prefix-size-sorted (descending) */
+			T *behind = nullptr;
+			for (T *curr = List::first(); curr; curr = curr->next()) {
+				if (rule.dst().prefix >= curr->dst().prefix) {
+					break; }
+
+				behind = curr;
+			}
+			List::insert(&rule, behind);
 		}
-		List::insert(&rule, behind);
-	}
 };
 
 #endif /* _RULE_H_ */
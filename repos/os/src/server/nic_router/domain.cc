@@ -110,7 +110,12 @@ Domain::Domain(Configuration &config, Xml_node const node, Allocator &alloc)
 	Domain_base(node), _avl_member(_name, *this), _config(config),
 	_node(node), _alloc(alloc),
 	_ip_config(_node.attribute_value("interface", Ipv4_address_prefix()),
-	           _node.attribute_value("gateway",   Ipv4_address()))
+	           _node.attribute_value("gateway",   Ipv4_address())),
+	_tcp_link_hash(alloc), _udp_link_hash(alloc),
+	_signal_coalescing(_node.attribute_value("signal_coalescing", 0U)),
+	_signal_coalescing_timeout(
+		_node.attribute_value("signal_coalescing_timeout_us",
+		                      (unsigned long)DEFAULT_SIGNAL_COALESCING_TIMEOUT_US))
 {
 	if (_name == Domain_name()) {
 		error("Missing name attribute in domain node");
@@ -136,6 +141,44 @@ Link_side_tree &Domain::links(L3_protocol const protocol)
 }
 
 
+Link_side_hash &Domain::link_hash(L3_protocol const protocol)
+{
+	switch (protocol) {
+	case L3_protocol::TCP: return _tcp_link_hash;
+	case L3_protocol::UDP: return _udp_link_hash;
+	default: throw Interface::Bad_transport_protocol(); }
+}
+
+
+void Domain::insert_link_side(L3_protocol const protocol, Link_side &side)
+{
+	if (_config.link_hash()) {
+		link_hash(protocol).insert(side); }
+	else {
+		links(protocol).insert(&side); }
+}
+
+
+void Domain::remove_link_side(L3_protocol const protocol, Link_side &side)
+{
+	if (_config.link_hash()) {
+		link_hash(protocol).remove(side); }
+	else {
+		links(protocol).remove(&side); }
+}
+
+
+Link_side const &Domain::find_link_side(L3_protocol  const  protocol,
+                                        Link_side_id const &id)
+{
+	if (!_config.link_hash()) {
+		return links(protocol).find_by_id(id); }
+
+	try { return link_hash(protocol).find(id); }
+	catch (Link_side_hash::No_match) { throw Link_side_tree::No_match(); }
+}
+
+
 void Domain::_ip_config_changed()
 {
 	if (!ip_config().valid) {
@@ -204,6 +247,10 @@ void Domain::create_rules(Domain_tree &domains)
 		try { _ip_rules.insert(*new (_alloc) Ip_rule(domains, node)); }
 		catch (Rule::Invalid) { warning("invalid IP rule"); }
 	});
+	/* compile rules that need a longest-prefix match on each new flow */
+	_tcp_rules.compile(_alloc);
+	_udp_rules.compile(_alloc);
+	_ip_rules.compile(_alloc);
 }
 
 
@@ -229,6 +276,12 @@ void Domain::dissolve_interface(Interface &interface)
 {
 	_interfaces.remove(&interface);
 	_interface_cnt--;
+
+	/* keep the counters of the interface but not its links */
+	Traffic_stats stats = interface.stats();
+	stats.tcp_links = 0;
+	stats.udp_links = 0;
+	_closed_interface_stats.add(stats);
 	if (_config.verbose_domain_state()) {
 		log("[", *this, "] NIC sessions: ", _interface_cnt);
 	}
@@ -236,9 +289,12 @@ void Domain::dissolve_interface(Interface &interface)
 
 void Domain::report(Xml_generator &xml)
 {
-	bool const bytes  = _config.report().bytes();
-	bool const config = _config.report().config();
-	if (!bytes && !config) {
+	bool const bytes   = _config.report().bytes();
+	bool const config  = _config.report().config();
+	bool const signals = _config.report().signals();
+	bool const copies  = _config.report().copies();
+	bool const stats   = _config.report().stats();
+	if (!bytes && !config && !signals && !copies && !stats) {
 		return;
 	}
 	xml.node("domain", [&] () {
@@ -251,6 +307,22 @@ void Domain::report(Xml_generator &xml)
 			xml.attribute("ipv4", String<19>(ip_config().interface));
 			xml.attribute("gw",   String<16>(ip_config().gateway));
 		}
+		if (stats) {
+			Traffic_stats domain_stats = _closed_interface_stats;
+			for (Interface *interface = _interfaces.first(); interface;
+			     interface = interface->next())
+			{
+				domain_stats.add(interface->stats());
+			}
+			domain_stats.report(xml);
+		}
+		if (signals || copies || stats) {
+			try {
+				_interfaces.for_each([&] (Interface &interface) {
+					interface.report(xml); });
+			}
+			catch (List<Interface>::Empty) { }
+		}
 	});
 }
 
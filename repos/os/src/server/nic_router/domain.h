@@ -23,12 +23,14 @@
 #include <port_allocator.h>
 #include <pointer.h>
 #include <ipv4_config.h>
+#include <traffic_stats.h>
 #include <dhcp_server.h>
 #include <interface.h>
 
 /* Genode includes */
 #include <util/avl_string.h>
 #include <util/reconstructible.h>
+#include <os/duration.h>
 
 namespace Genode {
 
@@ -102,8 +104,13 @@ class Net::Domain : public Domain_base
 		Arp_waiter_list                       _foreign_arp_waiters;
 		Link_side_tree                        _tcp_links;
 		Link_side_tree                        _udp_links;
+		Link_side_hash                        _tcp_link_hash;
+		Link_side_hash                        _udp_link_hash;
 		Genode::size_t                        _tx_bytes { 0 };
 		Genode::size_t                        _rx_bytes { 0 };
+		Traffic_stats                         _closed_interface_stats;
+		unsigned                       const  _signal_coalescing;
+		Genode::Microseconds           const  _signal_coalescing_timeout;
 
 		void _read_forward_rules(Genode::Cstring  const &protocol,
 		                         Domain_tree            &domains,
@@ -124,6 +131,8 @@ class Net::Domain : public Domain_base
 		struct Invalid     : Genode::Exception { };
 		struct No_next_hop : Genode::Exception { };
 
+		enum { DEFAULT_SIGNAL_COALESCING_TIMEOUT_US = 500 };
+
 		Domain(Configuration          &config,
 		       Genode::Xml_node const  node,
 		       Genode::Allocator      &alloc);
@@ -142,6 +151,20 @@ class Net::Domain : public Domain_base
 
 		Link_side_tree &links(L3_protocol const protocol);
 
+		Link_side_hash &link_hash(L3_protocol const protocol);
+
+		void insert_link_side(L3_protocol const protocol, Link_side &side);
+
+		void remove_link_side(L3_protocol const protocol, Link_side &side);
+
+		/**
+		 * Return link side with the given ID
+		 *
+		 * \throw Link_side_tree::No_match
+		 */
+		Link_side const &find_link_side(L3_protocol  const  protocol,
+		                                Link_side_id const &id);
+
 		void manage_interface(Interface &interface);
 
 		void dissolve_interface(Interface &interface);
@@ -180,6 +203,8 @@ class Net::Domain : public Domain_base
 		Arp_waiter_list     &foreign_arp_waiters() { return _foreign_arp_waiters; }
 		Link_side_tree      &tcp_links()           { return _tcp_links; }
 		Link_side_tree      &udp_links()           { return _udp_links; }
+		unsigned             signal_coalescing()   const { return _signal_coalescing; }
+		Genode::Microseconds signal_coalescing_timeout() const { return _signal_coalescing_timeout; }
 };
 
 
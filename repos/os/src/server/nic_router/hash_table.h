@@ -0,0 +1,218 @@
+/*
+ * \brief  Hash table with open addressing and cache-line sized buckets
+ * \author Genode Labs
+ * \date   2026-10-14
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _HASH_TABLE_H_
+#define _HASH_TABLE_H_
+
+/* Genode includes */
+#include <base/allocator.h>
+#include <util/string.h>
+
+namespace Net { template <typename, typename> class Hash_table; }
+
+
+/**
+ * Hash table of references to elements
+ *
+ * \param ELEM  element type, must provide a method 'KEY const &hash_key()'
+ * \param KEY   key type, must provide a method 'Genode::uint32_t hash()'
+ *              and the operator '=='
+ *
+ * The table doesn't own the elements. Each bucket fills exactly one cache
+ * line and holds the hash values and references of multiple elements. Thus,
+ * a lookup usually touches one cache line of the table plus the matching
+ * element. Colliding elements overflow into the subsequent buckets (linear
+ * probing). Removed elements leave a tombstone that is reused on insertion
+ * and vanishes when the table gets resized.
+ */
+template <typename ELEM, typename KEY>
+class Net::Hash_table
+{
+	private:
+
+		enum {
+			CACHE_LINE_SIZE = 64,
+			SLOTS           = CACHE_LINE_SIZE /
+			                  (sizeof(Genode::uint32_t) + sizeof(ELEM *)),
+			MIN_BUCKETS     = 16,
+		};
+
+		struct Bucket
+		{
+			Genode::uint32_t hash[SLOTS];
+			ELEM            *elem[SLOTS];
+		}
+		__attribute__((aligned(CACHE_LINE_SIZE)));
+
+		static ELEM *_tombstone() { return (ELEM *)1; }
+
+		Genode::Allocator &_alloc;
+		void              *_buffer       { nullptr };
+		Genode::size_t     _buffer_size  { 0 };
+		Bucket            *_buckets      { nullptr };
+		unsigned long      _bucket_cnt   { 0 };
+		unsigned long      _elem_cnt     { 0 };
+		unsigned long      _tombstone_cnt { 0 };
+
+		unsigned long _capacity() const { return _bucket_cnt * SLOTS; }
+
+		/**
+		 * Allocate zeroed, cache-line aligned bucket array
+		 */
+		void _alloc_buckets(unsigned long const bucket_cnt)
+		{
+			_buffer_size = bucket_cnt * sizeof(Bucket) + CACHE_LINE_SIZE;
+			_buffer      = _alloc.alloc(_buffer_size);
+			Genode::memset(_buffer, 0, _buffer_size);
+
+			Genode::addr_t const base = (Genode::addr_t)_buffer;
+			_buckets    = (Bucket *)((base + CACHE_LINE_SIZE - 1) &
+			                         ~((Genode::addr_t)CACHE_LINE_SIZE - 1));
+			_bucket_cnt = bucket_cnt;
+		}
+
+		/**
+		 * Insert element without checking the load factor
+		 */
+		void _insert(ELEM &elem, Genode::uint32_t const hash)
+		{
+			for (unsigned long b = hash & (_bucket_cnt - 1);;
+			     b = (b + 1) & (_bucket_cnt - 1))
+			{
+				Bucket &bucket = _buckets[b];
+				for (unsigned i = 0; i < SLOTS; i++) {
+
+					if (bucket.elem[i] == _tombstone())
+						_tombstone_cnt--;
+					else if (bucket.elem[i])
+						continue;
+
+					bucket.hash[i] = hash;
+					bucket.elem[i] = &elem;
+					_elem_cnt++;
+					return;
+				}
+			}
+		}
+
+		void _resize(unsigned long const bucket_cnt)
+		{
+			Bucket        *const old_buckets     = _buckets;
+			unsigned long  const old_bucket_cnt  = _bucket_cnt;
+			void          *const old_buffer      = _buffer;
+			Genode::size_t const old_buffer_size = _buffer_size;
+
+			_alloc_buckets(bucket_cnt);
+			_elem_cnt      = 0;
+			_tombstone_cnt = 0;
+
+			for (unsigned long b = 0; b < old_bucket_cnt; b++) {
+				Bucket &bucket = old_buckets[b];
+				for (unsigned i = 0; i < SLOTS; i++) {
+					if (bucket.elem[i] && bucket.elem[i] != _tombstone()) {
+						_insert(*bucket.elem[i], bucket.hash[i]); }
+				}
+			}
+			if (old_buffer) {
+				_alloc.free(old_buffer, old_buffer_size); }
+		}
+
+		/**
+		 * Call 'fn' with the bucket and slot index of the matching element
+		 */
+		template <typename FUNC>
+		bool _with_slot(KEY const &key, FUNC && fn) const
+		{
+			if (!_elem_cnt) {
+				return false; }
+
+			Genode::uint32_t const hash = key.hash();
+			for (unsigned long b = hash & (_bucket_cnt - 1), probed = 0;
+			     probed < _bucket_cnt; b = (b + 1) & (_bucket_cnt - 1), probed++)
+			{
+				Bucket &bucket = _buckets[b];
+				for (unsigned i = 0; i < SLOTS; i++) {
+
+					ELEM *const elem = bucket.elem[i];
+					if (!elem) {
+						return false; }
+
+					if (elem == _tombstone() || bucket.hash[i] != hash) {
+						continue; }
+
+					if (elem->hash_key() == key) {
+						fn(bucket, i);
+						return true;
+					}
+				}
+			}
+			return false;
+		}
+
+	public:
+
+		struct No_match : Genode::Exception { };
+
+		Hash_table(Genode::Allocator &alloc) : _alloc(alloc) { }
+
+		~Hash_table()
+		{
+			if (_buffer) {
+				_alloc.free(_buffer, _buffer_size); }
+		}
+
+		void insert(ELEM &elem)
+		{
+			/* keep the load factor including tombstones below 3/4 */
+			if ((_elem_cnt + _tombstone_cnt + 1) * 4 > _capacity() * 3) {
+
+				unsigned long bucket_cnt = _bucket_cnt ? _bucket_cnt
+				                                       : (unsigned long)MIN_BUCKETS;
+
+				while ((_elem_cnt + 1) * 2 > bucket_cnt * SLOTS) {
+					bucket_cnt *= 2; }
+
+				_resize(bucket_cnt);
+			}
+			_insert(elem, elem.hash_key().hash());
+		}
+
+		void remove(ELEM &elem)
+		{
+			_with_slot(elem.hash_key(), [&] (Bucket &bucket, unsigned i) {
+				bucket.elem[i] = _tombstone();
+				_elem_cnt--;
+				_tombstone_cnt++;
+			});
+		}
+
+		/**
+		 * Return element with the given key
+		 *
+		 * \throw No_match
+		 */
+		ELEM &find(KEY const &key) const
+		{
+			ELEM *result = nullptr;
+			if (!_with_slot(key, [&] (Bucket &bucket, unsigned i) {
+				result = bucket.elem[i]; }))
+			{
+				throw No_match();
+			}
+			return *result;
+		}
+
+		unsigned long count() const { return _elem_cnt; }
+};
+
+#endif /* _HASH_TABLE_H_ */
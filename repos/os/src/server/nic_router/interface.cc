@@ -15,6 +15,7 @@
 #include <net/tcp.h>
 #include <net/udp.h>
 #include <net/arp.h>
+#include <util/xml_generator.h>
 
 /* local includes */
 #include <interface.h>
@@ -291,84 +292,79 @@ void Interface::_send_dhcp_reply(Dhcp_server               const &dhcp_srv,
                                  Dhcp_packet::Message_type        msg_type,
                                  uint32_t                         xid)
 {
-	/* allocate buffer for the reply */
+	/* write the reply directly to the packet that is sent to the client */
 	enum { BUF_SIZE = 512 };
 	using Size_guard = Size_guard_tpl<BUF_SIZE, Dhcp_msg_buffer_too_small>;
-	void *buf;
-	try { _alloc.alloc(BUF_SIZE, &buf); }
-	catch (...) { throw Alloc_dhcp_msg_buffer_failed(); }
-
-	/* create ETH header of the reply */
-	Size_guard size;
-	size.add(sizeof(Ethernet_frame));
-	Ethernet_frame &eth = *reinterpret_cast<Ethernet_frame *>(buf);
-	eth.dst(client_mac);
-	eth.src(_router_mac);
-	eth.type(Ethernet_frame::Type::IPV4);
-
-	/* create IP header of the reply */
-	enum { IPV4_TIME_TO_LIVE = 64 };
-	size_t const ip_off = size.curr();
-	size.add(sizeof(Ipv4_packet));
-	Ipv4_packet &ip = *eth.data<Ipv4_packet>();
-	ip.header_length(sizeof(Ipv4_packet) / 4);
-	ip.version(4);
-	ip.diff_service(0);
-	ip.identification(0);
-	ip.flags(0);
-	ip.fragment_offset(0);
-	ip.time_to_live(IPV4_TIME_TO_LIVE);
-	ip.protocol(Ipv4_packet::Protocol::UDP);
-	ip.src(_router_ip());
-	ip.dst(client_ip);
-
-	/* create UDP header of the reply */
-	size_t const udp_off = size.curr();
-	size.add(sizeof(Udp_packet));
-	Udp_packet &udp = *ip.data<Udp_packet>();
-	udp.src_port(Port(Dhcp_packet::BOOTPS));
-	udp.dst_port(Port(Dhcp_packet::BOOTPC));
-
-	/* create mandatory DHCP fields of the reply  */
-	size.add(sizeof(Dhcp_packet));
-	Dhcp_packet &dhcp = *udp.data<Dhcp_packet>();
-	dhcp.op(Dhcp_packet::REPLY);
-	dhcp.htype(Dhcp_packet::Htype::ETH);
-	dhcp.hlen(sizeof(Mac_address));
-	dhcp.hops(0);
-	dhcp.xid(xid);
-	dhcp.secs(0);
-	dhcp.flags(0);
-	dhcp.ciaddr(msg_type == Dhcp_packet::Message_type::INFORM ? client_ip : Ipv4_address());
-	dhcp.yiaddr(msg_type == Dhcp_packet::Message_type::INFORM ? Ipv4_address() : client_ip);
-	dhcp.siaddr(_router_ip());
-	dhcp.giaddr(Ipv4_address());
-	dhcp.client_mac(client_mac);
-	dhcp.zero_fill_sname();
-	dhcp.zero_fill_file();
-	dhcp.default_magic_cookie();
-
-	/* append DHCP option fields to the reply */
-	Dhcp_packet::Options_aggregator<Size_guard> dhcp_opts(dhcp, size);
-	dhcp_opts.append_option<Dhcp_packet::Message_type_option>(msg_type);
-	dhcp_opts.append_option<Dhcp_packet::Server_ipv4>(_router_ip());
-	dhcp_opts.append_option<Dhcp_packet::Ip_lease_time>(dhcp_srv.ip_lease_time().value / 1000 / 1000);
-	dhcp_opts.append_option<Dhcp_packet::Subnet_mask>(_ip_config().interface.subnet_mask());
-	dhcp_opts.append_option<Dhcp_packet::Router_ipv4>(_router_ip());
-	if (dhcp_srv.dns_server().valid()) {
-		dhcp_opts.append_option<Dhcp_packet::Dns_server_ipv4>(dhcp_srv.dns_server()); }
-	dhcp_opts.append_option<Dhcp_packet::Broadcast_addr>(_ip_config().interface.broadcast_address());
-	dhcp_opts.append_option<Dhcp_packet::Options_end>();
-
-	/* fill in header values that need the packet to be complete already */
-	udp.length(size.curr() - udp_off);
-	udp.update_checksum(ip.src(), ip.dst());
-	ip.total_length(size.curr() - ip_off);
-	ip.checksum(Ipv4_packet::calculate_checksum(ip));
-
-	/* send reply to sender of request and free reply buffer */
-	send(eth, size.curr());
-	_alloc.free(buf, BUF_SIZE);
+	send(BUF_SIZE, [&] (Ethernet_frame &eth) {
+
+		/* create ETH header of the reply */
+		Size_guard size;
+		size.add(sizeof(Ethernet_frame));
+		eth.dst(client_mac);
+		eth.src(_router_mac);
+		eth.type(Ethernet_frame::Type::IPV4);
+
+		/* create IP header of the reply */
+		enum { IPV4_TIME_TO_LIVE = 64 };
+		size_t const ip_off = size.curr();
+		size.add(sizeof(Ipv4_packet));
+		Ipv4_packet &ip = *eth.data<Ipv4_packet>();
+		ip.header_length(sizeof(Ipv4_packet) / 4);
+		ip.version(4);
+		ip.diff_service(0);
+		ip.identification(0);
+		ip.flags(0);
+		ip.fragment_offset(0);
+		ip.time_to_live(IPV4_TIME_TO_LIVE);
+		ip.protocol(Ipv4_packet::Protocol::UDP);
+		ip.src(_router_ip());
+		ip.dst(client_ip);
+
+		/* create UDP header of the reply */
+		size_t const udp_off = size.curr();
+		size.add(sizeof(Udp_packet));
+		Udp_packet &udp = *ip.data<Udp_packet>();
+		udp.src_port(Port(Dhcp_packet::BOOTPS));
+		udp.dst_port(Port(Dhcp_packet::BOOTPC));
+
+		/* create mandatory DHCP fields of the reply  */
+		size.add(sizeof(Dhcp_packet));
+		Dhcp_packet &dhcp = *udp.data<Dhcp_packet>();
+		dhcp.op(Dhcp_packet::REPLY);
+		dhcp.htype(Dhcp_packet::Htype::ETH);
+		dhcp.hlen(sizeof(Mac_address));
+		dhcp.hops(0);
+		dhcp.xid(xid);
+		dhcp.secs(0);
+		dhcp.flags(0);
+		dhcp.ciaddr(msg_type == Dhcp_packet::Message_type::INFORM ? client_ip : Ipv4_address());
+		dhcp.yiaddr(msg_type == Dhcp_packet::Message_type::INFORM ? Ipv4_address() : client_ip);
+		dhcp.siaddr(_router_ip());
+		dhcp.giaddr(Ipv4_address());
+		dhcp.client_mac(client_mac);
+		dhcp.zero_fill_sname();
+		dhcp.zero_fill_file();
+		dhcp.default_magic_cookie();
+
+		/* append DHCP option fields to the reply */
+		Dhcp_packet::Options_aggregator<Size_guard> dhcp_opts(dhcp, size);
+		dhcp_opts.append_option<Dhcp_packet::Message_type_option>(msg_type);
+		dhcp_opts.append_option<Dhcp_packet::Server_ipv4>(_router_ip());
+		dhcp_opts.append_option<Dhcp_packet::Ip_lease_time>(dhcp_srv.ip_lease_time().value / 1000 / 1000);
+		dhcp_opts.append_option<Dhcp_packet::Subnet_mask>(_ip_config().interface.subnet_mask());
+		dhcp_opts.append_option<Dhcp_packet::Router_ipv4>(_router_ip());
+		if (dhcp_srv.dns_server().valid()) {
+			dhcp_opts.append_option<Dhcp_packet::Dns_server_ipv4>(dhcp_srv.dns_server()); }
+		dhcp_opts.append_option<Dhcp_packet::Broadcast_addr>(_ip_config().interface.broadcast_address());
+		dhcp_opts.append_option<Dhcp_packet::Options_end>();
+
+		/* fill in header values that need the packet to be complete already */
+		udp.length(size.curr() - udp_off);
+		udp.update_checksum(ip.src(), ip.dst());
+		ip.total_length(size.curr() - ip_off);
+		ip.checksum(Ipv4_packet::calculate_checksum(ip));
+		return size.curr();
+	});
 }
 
 
@@ -586,7 +582,7 @@ void Interface::_handle_ip(Ethernet_frame          &eth,
 
 		/* try to route via existing UDP/TCP links */
 		try {
-			Link_side const &local_side = _domain.links(prot).find_by_id(local);
+			Link_side const &local_side = _domain.find_link_side(prot, local);
 			Link &link = local_side.link();
 			bool const client = local_side.is_client();
 			Link_side &remote_side = client ? link.server() : link.client();
@@ -668,6 +664,7 @@ void Interface::_handle_ip(Ethernet_frame          &eth,
 	catch (Ip_rule_list::No_match) { }
 
 	/* give up and drop packet */
+	_stats.no_rule++;
 	if (_config().verbose()) {
 		log("Unroutable packet"); }
 }
@@ -812,15 +809,29 @@ void Interface::_handle_arp(Ethernet_frame &eth, size_t const eth_size)
 
 void Interface::_ready_to_submit()
 {
-	while (_sink().packet_avail()) {
+	Packet_descriptor pkts[PACKET_BATCH_SIZE];
+	Packet_descriptor acks[PACKET_BATCH_SIZE];
 
-		Packet_descriptor const pkt = _sink().get_packet();
-		if (!pkt.size()) {
-			continue; }
+	/* fetch and acknowledge packets batch-wise to save signals */
+	for (unsigned nr_of_pkts;
+	     (nr_of_pkts = _sink().get_packets(pkts, PACKET_BATCH_SIZE)); )
+	{
+		unsigned nr_of_acks = 0;
+		for (unsigned i = 0; i < nr_of_pkts; i++) {
+
+			Packet_descriptor const &pkt = pkts[i];
+			if (!pkt.size()) {
+				continue; }
 
-		try { _handle_eth(_sink().packet_content(pkt), pkt.size(), pkt); }
-		catch (Packet_postponed) { continue; }
-		_ack_packet(pkt);
+			/* fetch the head of the next frame while handling this one */
+			if (i + 1 < nr_of_pkts && pkts[i + 1].size()) {
+				__builtin_prefetch(_sink().packet_content(pkts[i + 1])); }
+
+			try { _handle_eth(_sink().packet_content(pkt), pkt.size(), pkt); }
+			catch (Packet_postponed) { continue; }
+			acks[nr_of_acks++] = pkt;
+		}
+		_ack_packets(acks, nr_of_acks);
 	}
 }
 
@@ -835,8 +846,13 @@ void Interface::_continue_handle_eth(Packet_descriptor const &pkt)
 
 void Interface::_ready_to_ack()
 {
-	while (_source().ack_avail()) {
-		_source().release_packet(_source().get_acked_packet()); }
+	Packet_descriptor pkts[PACKET_BATCH_SIZE];
+	for (unsigned nr_of_pkts;
+	     (nr_of_pkts = _source().get_acked_packets(pkts, PACKET_BATCH_SIZE)); )
+	{
+		for (unsigned i = 0; i < nr_of_pkts; i++) {
+			_source().release_packet(pkts[i]); }
+	}
 }
 
 
@@ -861,6 +877,7 @@ void Interface::_handle_eth(void              *const  eth_base,
                             Packet_descriptor  const &pkt)
 {
 	_domain.raise_rx_bytes(eth_size);
+	_stats.received(eth_size);
 
 	/* do garbage collection over transport-layer links and DHCP allocations */
 	_destroy_dissolved_links<Udp_link>(_dissolved_udp_links, _alloc);
@@ -887,62 +904,85 @@ void Interface::_handle_eth(void              *const  eth_base,
 			default: throw Bad_network_protocol(); }
 		}
 	}
-	catch (Ethernet_frame::No_ethernet_frame) { warning("malformed Ethernet frame"); }
-	catch (Ipv4_packet::No_ip_packet)         { warning("malformed IPv4 packet"     ); }
-	catch (Tcp_packet::No_tcp_packet)         { warning("malformed TCP packet"    ); }
-	catch (Udp_packet::No_udp_packet)         { warning("malformed UDP packet"    ); }
-	catch (Dhcp_packet::No_dhcp_packet)       { warning("malformed DHCP packet"   ); }
-	catch (Arp_packet::No_arp_packet)         { warning("malformed ARP packet"    ); }
+	catch (Ethernet_frame::No_ethernet_frame) { _stats.other_drops++; warning("malformed Ethernet frame"); }
+	catch (Ipv4_packet::No_ip_packet)         { _stats.other_drops++; warning("malformed IPv4 packet"     ); }
+	catch (Tcp_packet::No_tcp_packet)         { _stats.other_drops++; warning("malformed TCP packet"    ); }
+	catch (Udp_packet::No_udp_packet)         { _stats.other_drops++; warning("malformed UDP packet"    ); }
+	catch (Dhcp_packet::No_dhcp_packet)       { _stats.other_drops++; warning("malformed DHCP packet"   ); }
+	catch (Arp_packet::No_arp_packet)         { _stats.other_drops++; warning("malformed ARP packet"    ); }
 
 	catch (Bad_network_protocol) {
+		_stats.other_drops++;
 		if (_config().verbose()) {
 			log("unknown network layer protocol");
 		}
 	}
 	catch (Drop_packet_inform exception) {
+		_stats.other_drops++;
 		if (_config().verbose()) {
 			log("(", _domain, ") Drop packet: ", exception.msg);
 		}
 	}
 	catch (Drop_packet_warn exception) {
+		_stats.other_drops++;
 		warning("(", _domain, ") Drop packet: ", exception.msg);
 	}
 	catch (Port_allocator_guard::Out_of_indices) {
+		_stats.no_nat_port++;
 		error("no available NAT ports"); }
 
 	catch (Domain::No_next_hop) {
+		_stats.other_drops++;
 		error("can not find next hop"); }
 
 	catch (List<Interface>::Empty) {
+		_stats.other_drops++;
 		error("no interface connected to domain"); }
 
-	catch (Alloc_dhcp_msg_buffer_failed) {
-		error("failed to allocate buffer for DHCP reply"); }
-
 	catch (Dhcp_msg_buffer_too_small) {
+		_stats.other_drops++;
 		error("DHCP reply buffer too small"); }
 
 	catch (Dhcp_server::Alloc_ip_failed) {
+		_stats.other_drops++;
 		error("failed to allocate IP for DHCP client"); }
 }
 
 
-void Interface::send(Ethernet_frame &eth, Genode::size_t const size)
+void Interface::_submit(Packet_descriptor const &pkt, Ethernet_frame &eth)
 {
 	if (_config().verbose()) {
 		log("(", _domain, " <- router) ", eth); }
-	try {
-		/* copy and submit packet */
-		Packet_descriptor const pkt = _source().alloc_packet(size);
-		char *content = _source().packet_content(pkt);
-		Genode::memcpy((void *)content, (void *)&eth, size);
-		_source().submit_packet(pkt);
-		_domain.raise_tx_bytes(size);
-	}
-	catch (Packet_stream_source::Packet_alloc_failed) {
-		if (_config().verbose()) {
-			log("Failed to allocate packet"); }
-	}
+
+	_source().submit_packet(pkt);
+	_stats.sent(pkt.size());
+	_copy_stats.bytes += pkt.size();
+	_domain.raise_tx_bytes(pkt.size());
+	_schedule_signal_flush();
+}
+
+
+void Interface::_packet_alloc_failed()
+{
+	_stats.alloc_failed++;
+	if (_config().verbose()) {
+		log("Failed to allocate packet"); }
+}
+
+
+void Interface::send(Ethernet_frame &eth, Genode::size_t const size)
+{
+	/*
+	 * The bulk buffers of the sessions are shared with different clients,
+	 * so a frame from another session can't be handed over as is. Copy it
+	 * right into the egress packet instead, which is the only copy of a
+	 * frame on its way through the router.
+	 */
+	send(size, [&] (Ethernet_frame &egress) {
+		Genode::memcpy((void *)&egress, (void *)&eth, size);
+		_copy_stats.copies++;
+		return size;
+	});
 }
 
 
@@ -958,7 +998,8 @@ Interface::Interface(Entrypoint        &ep,
 	_source_ack(ep, *this, &Interface::_ready_to_ack),
 	_source_submit(ep, *this, &Interface::_packet_avail),
 	_router_mac(router_mac), _mac(mac), _timer(timer), _alloc(alloc),
-	_domain(domain)
+	_domain(domain),
+	_signal_flush_timeout(timer, *this, &Interface::_handle_signal_flush_timeout)
 {
 	_domain.manage_interface(*this);
 }
@@ -966,6 +1007,10 @@ Interface::Interface(Entrypoint        &ep,
 
 void Interface::_init()
 {
+	/* apply signal coalescing of the domain to both packet streams */
+	_source().coalesce_packet_avail(_domain.signal_coalescing());
+	_sink().coalesce_ack_avail(_domain.signal_coalescing());
+
 	if (!_domain.ip_config().valid) {
 		_dhcp_client.discover();
 	}
@@ -979,12 +1024,86 @@ void Interface::_ack_packet(Packet_descriptor const &pkt)
 		return;
 	}
 	_sink().acknowledge_packet(pkt);
+	_schedule_signal_flush();
+}
+
+
+void Interface::_ack_packets(Packet_descriptor const *pkts,
+                             unsigned          const  nr_of_pkts)
+{
+	if (_sink().acknowledge_packets(pkts, nr_of_pkts) < nr_of_pkts) {
+		error("ack state FULL"); }
+
+	_schedule_signal_flush();
+}
+
+
+void Interface::_schedule_signal_flush()
+{
+	if (_domain.signal_coalescing() < 2 || _signal_flush_timeout.scheduled()) {
+		return; }
+
+	_signal_flush_timeout.schedule(_domain.signal_coalescing_timeout());
+}
+
+
+void Interface::_handle_signal_flush_timeout(Duration)
+{
+	_source().flush_packet_avail();
+	_sink().flush_ack_avail();
+}
+
+
+void Interface::report(Genode::Xml_generator &xml)
+{
+	xml.node("interface", [&] () {
+		xml.attribute("mac", String<18>(_mac));
+
+		if (_config().report().signals()) {
+
+			Packet_stream_source::Signal_stats const submit {
+				_source().packet_avail_stats() };
+
+			Packet_stream_sink::Signal_stats const ack {
+				_sink().ack_avail_stats() };
+
+			xml.attribute("packet_avail_signals",  submit.submitted);
+			xml.attribute("packet_avail_deferred", submit.deferred);
+			xml.attribute("ack_avail_signals",     ack.submitted);
+			xml.attribute("ack_avail_deferred",    ack.deferred);
+		}
+		if (_config().report().copies()) {
+			xml.attribute("sent_bytes",  _copy_stats.bytes);
+			xml.attribute("sent_copies", _copy_stats.copies);
+			if (_copy_stats.copies) {
+				xml.attribute("bytes_per_copy",
+				              _copy_stats.bytes / _copy_stats.copies); }
+		}
+		if (_config().report().stats()) {
+			stats().report(xml); }
+	});
+}
+
+
+Traffic_stats Interface::stats() const
+{
+	auto count = [] (Link_list const &links) {
+		unsigned long cnt = 0;
+		for (Link const *link = links.first(); link; link = link->next()) {
+			cnt++; }
+		return cnt;
+	};
+	Traffic_stats stats = _stats;
+	stats.tcp_links = count(_tcp_links);
+	stats.udp_links = count(_udp_links);
+	return stats;
 }
 
 
 void Interface::cancel_arp_waiting(Arp_waiter &waiter)
 {
 	warning("waiting for ARP cancelled");
+	_stats.no_arp++;
 	_ack_packet(waiter.packet());
 	destroy(_alloc, &waiter);
 }
@@ -21,11 +21,14 @@
 #include <dhcp_client.h>
 #include <dhcp_server.h>
 #include <list.h>
+#include <traffic_stats.h>
 
 /* Genode includes */
 #include <nic_session/nic_session.h>
 #include <net/dhcp.h>
 
+namespace Genode { class Xml_generator; }
+
 namespace Net {
 
 	using Packet_descriptor    = ::Nic::Packet_descriptor;
@@ -60,6 +63,9 @@ class Net::Interface : public Genode::List<Interface>::Element
 
 	private:
 
+		/* number of packets handled per packet-stream operation */
+		enum { PACKET_BATCH_SIZE = 32 };
+
 		Timer::Connection    &_timer;
 		Genode::Allocator    &_alloc;
 		Domain               &_domain;
@@ -70,7 +76,29 @@ class Net::Interface : public Genode::List<Interface>::Element
 		Link_list             _dissolved_udp_links;
 		Dhcp_allocation_tree  _dhcp_allocations;
 		Dhcp_allocation_list  _released_dhcp_allocations;
-		Dhcp_client           _dhcp_client { _alloc, _timer, *this };
+		Dhcp_client           _dhcp_client { _timer, *this };
+
+		Timer::One_shot_timeout<Interface> _signal_flush_timeout;
+
+		/**
+		 * Bytes sent and number of copies needed to send them
+		 */
+		struct Copy_stats
+		{
+			Genode::uint64_t bytes  { 0 };
+			Genode::uint64_t copies { 0 };
+		};
+
+		Copy_stats    _copy_stats;
+		Traffic_stats _stats;
+
+		void _submit(Packet_descriptor const &pkt, Ethernet_frame &eth);
+
+		void _packet_alloc_failed();
+
+		void _handle_signal_flush_timeout(Genode::Duration);
+
+		void _schedule_signal_flush();
 
 		void _new_link(L3_protocol                   const  protocol,
 		               Link_side_id                  const &local_id,
@@ -164,6 +192,9 @@ class Net::Interface : public Genode::List<Interface>::Element
 
 		void _ack_packet(Packet_descriptor const &pkt);
 
+		void _ack_packets(Packet_descriptor const *pkts,
+		                  unsigned          const  nr_of_pkts);
+
 		virtual Packet_stream_sink &_sink() = 0;
 
 		virtual Packet_stream_source &_source() = 0;
@@ -180,12 +211,11 @@ class Net::Interface : public Genode::List<Interface>::Element
 
 	public:
 
-		struct Bad_send_dhcp_args           : Genode::Exception { };
-		struct Bad_transport_protocol       : Genode::Exception { };
-		struct Bad_network_protocol         : Genode::Exception { };
-		struct Packet_postponed             : Genode::Exception { };
-		struct Alloc_dhcp_msg_buffer_failed : Genode::Exception { };
-		struct Dhcp_msg_buffer_too_small    : Genode::Exception { };
+		struct Bad_send_dhcp_args        : Genode::Exception { };
+		struct Bad_transport_protocol    : Genode::Exception { };
+		struct Bad_network_protocol      : Genode::Exception { };
+		struct Packet_postponed          : Genode::Exception { };
+		struct Dhcp_msg_buffer_too_small : Genode::Exception { };
 
 		struct Drop_packet_inform : Genode::Exception
 		{
@@ -217,12 +247,50 @@ class Net::Interface : public Genode::List<Interface>::Element
 
 		void send(Ethernet_frame &eth, Genode::size_t const eth_size);
 
+		/**
+		 * Send a frame that gets written directly to the egress packet
+		 *
+		 * \param max_size  maximum size of the frame, must not exceed the
+		 *                  block size of the packet allocator
+		 * \param write     functor 'size_t (Ethernet_frame &)' that writes
+		 *                  the frame and returns its actual size
+		 *
+		 * This saves the intermediate buffer and the copy operation for
+		 * frames that are generated by the router itself.
+		 */
+		template <typename FUNC>
+		void send(Genode::size_t const max_size, FUNC && write)
+		{
+			try {
+				Packet_descriptor const pkt = _source().alloc_packet(max_size);
+				Ethernet_frame &eth = *reinterpret_cast<Ethernet_frame *>(
+					_source().packet_content(pkt));
+
+				Genode::size_t size;
+				try { size = write(eth); }
+				catch (...) {
+					_source().release_packet(pkt);
+					throw;
+				}
+				_submit(Packet_descriptor(pkt.offset(), size), eth);
+			}
+			catch (Packet_stream_source::Packet_alloc_failed) {
+				_packet_alloc_failed(); }
+		}
+
 		Link_list &dissolved_links(L3_protocol const protocol);
 
 		Link_list &links(L3_protocol const protocol);
 
 		void cancel_arp_waiting(Arp_waiter &waiter);
 
+		void report(Genode::Xml_generator &xml);
+
+		/**
+		 * Return traffic counters including the current number of links
+		 */
+		Traffic_stats stats() const;
+
 
 		/***************
 		 ** Accessors **
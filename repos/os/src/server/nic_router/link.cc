@@ -33,6 +33,18 @@ constexpr size_t Link_side_id::data_size()
 }
 
 
+Genode::uint32_t Link_side_id::hash() const
+{
+	/* FNV-1a */
+	Genode::uint32_t hash = 2166136261U;
+	Genode::uint8_t const *byte = (Genode::uint8_t const *)data_base();
+	for (size_t i = 0; i < data_size(); i++) {
+		hash = (hash ^ byte[i]) * 16777619U; }
+
+	return hash;
+}
+
+
 bool Link_side_id::operator == (Link_side_id const &id) const
 {
 	return memcmp(id.data_base(), data_base(), data_size()) == 0;
@@ -133,8 +145,8 @@ Link::Link(Interface                           &cln_interface,
 	_server(srv_domain, srv_id, *this)
 {
 	_client_interface.links(_protocol).insert(this);
-	_client.domain().links(_protocol).insert(&_client);
-	_server.domain().links(_protocol).insert(&_server);
+	_client.domain().insert_link_side(_protocol, _client);
+	_server.domain().insert_link_side(_protocol, _server);
 	_dissolve_timeout.schedule(_dissolve_timeout_us);
 }
 
@@ -149,8 +161,8 @@ void Link::_handle_dissolve_timeout(Duration)
 
 void Link::dissolve()
 {
-	_client.domain().links(_protocol).remove(&_client);
-	_server.domain().links(_protocol).remove(&_server);
+	_client.domain().remove_link_side(_protocol, _client);
+	_server.domain().remove_link_side(_protocol, _server);
 	if (_config.verbose()) {
 		log("Dissolve ", l3_protocol_name(_protocol), " link: ", *this); }
 
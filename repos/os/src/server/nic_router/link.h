@@ -17,13 +17,14 @@
 /* Genode includes */
 #include <timer_session/connection.h>
 #include <util/avl_tree.h>
-#include <util/list.h>
+#include <util/double_list.h>
 #include <net/ipv4.h>
 #include <net/port.h>
 
 /* local includes */
 #include <pointer.h>
 #include <l3_protocol.h>
+#include <hash_table.h>
 
 namespace Net {
 
@@ -35,8 +36,9 @@ namespace Net {
 	class  Link_side_id;
 	class  Link_side;
 	class  Link_side_tree;
+	class  Link_side_hash;
 	class  Link;
-	struct Link_list : Genode::List<Link> { };
+	struct Link_list : Genode::Double_list<Link> { };
 	class  Tcp_link;
 	class  Udp_link;
 }
@@ -53,6 +55,8 @@ struct Net::Link_side_id
 
 	void *data_base() const { return (void *)&src_ip; }
 
+	Genode::uint32_t hash() const;
+
 
 	/************************
 	 ** Standard operators **
@@ -110,6 +114,13 @@ class Net::Link_side : public Genode::Avl_node<Link_side>
 		Ipv4_address const &dst_ip()    const { return _id.dst_ip; }
 		Port                src_port()  const { return _id.src_port; }
 		Port                dst_port()  const { return _id.dst_port; }
+
+
+		/****************
+		 ** Hash_table **
+		 ****************/
+
+		Link_side_id const &hash_key() const { return _id; }
 };
 
 
@@ -121,6 +132,12 @@ struct Net::Link_side_tree : Genode::Avl_tree<Link_side>
 };
 
 
+struct Net::Link_side_hash : Hash_table<Link_side, Link_side_id>
+{
+	Link_side_hash(Genode::Allocator &alloc) : Hash_table(alloc) { }
+};
+
+
 class Net::Link : public Link_list::Element
 {
 	protected:
@@ -0,0 +1,118 @@
+/*
+ * \brief  Binary trie for the longest-prefix match of IPv4 addresses
+ * \author Genode Labs
+ * \date   2026-10-14
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _PREFIX_TRIE_H_
+#define _PREFIX_TRIE_H_
+
+/* local includes */
+#include <ipv4_address_prefix.h>
+
+/* Genode includes */
+#include <base/allocator.h>
+
+namespace Net { template <typename> class Prefix_trie; }
+
+
+/**
+ * Trie that maps IPv4 address prefixes to objects of type 'T'
+ *
+ * Each level of the trie corresponds to one bit of the address. Thus, a
+ * lookup costs at most one step per bit of the longest stored prefix,
+ * independent from the number of stored prefixes.
+ */
+template <typename T>
+class Net::Prefix_trie
+{
+	private:
+
+		struct Node
+		{
+			Node *child[2] { nullptr, nullptr };
+			T    *object   { nullptr };
+		};
+
+		Genode::Allocator &_alloc;
+		Node              *_root { nullptr };
+
+		static unsigned _bit(Ipv4_address const &ip, unsigned const idx)
+		{
+			return (ip.addr[idx / 8] >> (7 - idx % 8)) & 1;
+		}
+
+		void _destroy(Node *node)
+		{
+			if (!node) {
+				return; }
+
+			_destroy(node->child[0]);
+			_destroy(node->child[1]);
+			Genode::destroy(_alloc, node);
+		}
+
+	public:
+
+		struct No_match : Genode::Exception { };
+
+		Prefix_trie(Genode::Allocator &alloc) : _alloc(alloc) { }
+
+		~Prefix_trie() { _destroy(_root); }
+
+		/**
+		 * Map 'prefix' to 'object' if 'prefix' is not mapped yet
+		 */
+		void insert(Ipv4_address_prefix const &prefix, T &object)
+		{
+			unsigned const length = prefix.prefix < 32 ? prefix.prefix : 32;
+
+			Node **node = &_root;
+			for (unsigned idx = 0; ; idx++) {
+
+				if (!*node) {
+					*node = new (_alloc) Node; }
+
+				if (idx == length) {
+					break; }
+
+				node = &(*node)->child[_bit(prefix.address, idx)];
+			}
+			if (!(*node)->object) {
+				(*node)->object = &object; }
+		}
+
+		/**
+		 * Return object of the longest prefix that matches 'ip'
+		 *
+		 * \throw No_match
+		 */
+		T &longest_prefix_match(Ipv4_address const &ip) const
+		{
+			T *result = nullptr;
+			Node const *node = _root;
+			for (unsigned idx = 0; node; idx++) {
+
+				if (node->object) {
+					result = node->object; }
+
+				if (idx == 32) {
+					break; }
+
+				node = node->child[_bit(ip, idx)];
+			}
+			if (!result) {
+				throw No_match(); }
+
+			return *result;
+		}
+};
+
+#endif /* _PREFIX_TRIE_H_ */
@@ -27,11 +27,15 @@ Net::Report::Report(Env               &env,
 :
 	_config(node.attribute_value("config", true)),
 	_bytes (node.attribute_value("bytes",  true)),
+	_signals(node.attribute_value("signals", false)),
+	_copies (node.attribute_value("copies",  false)),
+	_stats  (node.attribute_value("stats",   false)),
 	_reporter(env, "state"),
 	_domains(domains),
 	_timeout(timer, *this, &Report::_handle_report_timeout,
 	         read_sec_attr(node, "interval_sec", 5))
 {
+	_reporter.expanding(true);
 	_reporter.enabled(true);
 }
 
@@ -37,6 +37,9 @@ class Net::Report
 
 		bool const                       _config;
 		bool const                       _bytes;
+		bool const                       _signals;
+		bool const                       _copies;
+		bool const                       _stats;
 		Genode::Reporter                 _reporter;
 		Domain_tree                     &_domains;
 		Timer::Periodic_timeout<Report>  _timeout;
@@ -56,7 +59,10 @@ class Net::Report
 		 ***************/
 
 		bool config() const { return _config; }
-		bool bytes()  const { return _bytes; }
+		bool bytes()   const { return _bytes; }
+		bool signals() const { return _signals; }
+		bool copies()  const { return _copies; }
+		bool stats()   const { return _stats; }
 };
 
 #endif /* _REPORT_H_ */
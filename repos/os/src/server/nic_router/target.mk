@@ -9,6 +9,7 @@ SRC_CC += uplink.cc interface.cc arp_cache.cc configuration.cc
 SRC_CC += domain.cc l3_protocol.cc direct_rule.cc link.cc
 SRC_CC += transport_rule.cc leaf_rule.cc permit_rule.cc
 SRC_CC += dhcp_client.cc dhcp_server.cc report.cc xml_node.cc
+SRC_CC += traffic_stats.cc
 
 INC_DIR += $(PRG_DIR)
 
@@ -0,0 +1,57 @@
+/*
+ * \brief  Counters for the traffic that passes an interface or a domain
+ * \author Genode Labs
+ * \date   2026-10-14
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <util/xml_generator.h>
+
+/* local includes */
+#include <traffic_stats.h>
+
+using namespace Net;
+using namespace Genode;
+
+
+void Traffic_stats::add(Traffic_stats const &other)
+{
+	rx_packets   += other.rx_packets;
+	rx_bytes     += other.rx_bytes;
+	tx_packets   += other.tx_packets;
+	tx_bytes     += other.tx_bytes;
+	no_arp       += other.no_arp;
+	no_rule      += other.no_rule;
+	alloc_failed += other.alloc_failed;
+	no_nat_port  += other.no_nat_port;
+	other_drops  += other.other_drops;
+	tcp_links    += other.tcp_links;
+	udp_links    += other.udp_links;
+}
+
+
+void Traffic_stats::report(Xml_generator &xml) const
+{
+	xml.node("stats", [&] () {
+		xml.attribute("rx_packets", rx_packets);
+		xml.attribute("rx_bytes",   rx_bytes);
+		xml.attribute("tx_packets", tx_packets);
+		xml.attribute("tx_bytes",   tx_bytes);
+		xml.attribute("tcp_links",  tcp_links);
+		xml.attribute("udp_links",  udp_links);
+		xml.node("drops", [&] () {
+			xml.attribute("no_arp",       no_arp);
+			xml.attribute("no_rule",      no_rule);
+			xml.attribute("alloc_failed", alloc_failed);
+			xml.attribute("no_nat_port",  no_nat_port);
+			xml.attribute("other",        other_drops);
+		});
+	});
+}
@@ -0,0 +1,57 @@
+/*
+ * \brief  Counters for the traffic that passes an interface or a domain
+ * \author Genode Labs
+ * \date   2026-10-14
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _TRAFFIC_STATS_H_
+#define _TRAFFIC_STATS_H_
+
+/* Genode includes */
+#include <base/stdint.h>
+
+namespace Genode { class Xml_generator; }
+
+namespace Net { struct Traffic_stats; }
+
+
+/**
+ * Traffic counters that are cheap enough to be raised for each packet
+ */
+struct Net::Traffic_stats
+{
+	Genode::uint64_t rx_packets   { 0 };
+	Genode::uint64_t rx_bytes     { 0 };
+	Genode::uint64_t tx_packets   { 0 };
+	Genode::uint64_t tx_bytes     { 0 };
+	Genode::uint64_t no_arp       { 0 };
+	Genode::uint64_t no_rule      { 0 };
+	Genode::uint64_t alloc_failed { 0 };
+	Genode::uint64_t no_nat_port  { 0 };
+	Genode::uint64_t other_drops  { 0 };
+	unsigned long    tcp_links    { 0 };
+	unsigned long    udp_links    { 0 };
+
+	void received(Genode::size_t bytes) { rx_packets++; rx_bytes += bytes; }
+
+	void sent(Genode::size_t bytes) { tx_packets++; tx_bytes += bytes; }
+
+	/**
+	 * Accumulate the counters of 'other'
+	 */
+	void add(Traffic_stats const &other);
+
+	/**
+	 * Generate a 'stats' node with the counters
+	 */
+	void report(Genode::Xml_generator &xml) const;
+};
+
+#endif /* _TRAFFIC_STATS_H_ */
@@ -43,7 +43,8 @@ struct Nitpicker::Canvas_base
 	virtual void draw_box(Rect, Color) = 0;
 
 	virtual void draw_texture(Point, Texture_base const &, Texture_painter::Mode,
-	                          Color mix_color, bool allow_alpha) = 0;
+	                          Color mix_color, bool allow_alpha,
+	                          unsigned opacity) = 0;
 
 	virtual void draw_text(Point, Text_painter::Font const &, Color,
 	                       char const *string) = 0;
@@ -85,11 +86,11 @@ class Nitpicker::Canvas : public Canvas_base, public Surface_base::Flusher
 
 		void draw_texture(Point pos, Texture_base const &texture_base,
 		                  Texture_painter::Mode mode, Color mix_color,
-		                  bool allow_alpha)
+		                  bool allow_alpha, unsigned opacity)
 		{
 			Texture<PT> const &texture = static_cast<Texture<PT> const &>(texture_base);
 			Texture_painter::paint(_surface, texture, mix_color, pos, mode,
-			                       allow_alpha);
+			                       allow_alpha, opacity);
 		}
 
 		void draw_text(Point pos, Text_painter::Font const &font,
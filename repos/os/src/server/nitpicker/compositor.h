@@ -0,0 +1,198 @@
+/*
+ * \brief  Parallel drawing of the view stack in screen tiles
+ * \author Genode Labs
+ * \date   2026-10-14
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _COMPOSITOR_H_
+#define _COMPOSITOR_H_
+
+/* Genode includes */
+#include <base/thread.h>
+#include <base/semaphore.h>
+
+/* local includes */
+#include "view_stack.h"
+
+namespace Nitpicker { template <typename> class Compositor; }
+
+
+/**
+ * Draw dirty areas using a pool of worker threads
+ *
+ * The screen is split into tiles. For each frame, the workers and the
+ * calling thread fetch tiles one after another and draw the intersections
+ * of the tile with the dirty areas, each thread using its own canvas.
+ * The calling thread blocks until all tiles are drawn, so that the
+ * framebuffer is refreshed with complete contents only.
+ *
+ * While a frame is drawn, the entrypoint does not modify the view stack
+ * or the textures of the sessions.
+ */
+template <typename PT>
+class Nitpicker::Compositor : Noncopyable
+{
+	public:
+
+		enum { MAX_THREADS = 16, TILE_SIZE = 128 };
+
+	private:
+
+		enum { STACK_SIZE = 16*1024*sizeof(long) };
+
+		View_stack const &_view_stack;
+
+		/*
+		 * Current frame, written by the calling thread before waking up
+		 * the workers
+		 */
+		struct Frame
+		{
+			PT                 *base;
+			Area                size;
+			Dirty_region const *region;
+			View_stack::Redraw  redraw;
+			unsigned            columns;
+			unsigned            num_tiles;
+			unsigned            next_tile;
+		} _frame { };
+
+		Semaphore _finished { };
+
+		Rect _tile(unsigned i) const
+		{
+			return Rect(Point((i % _frame.columns)*TILE_SIZE,
+			                  (i / _frame.columns)*TILE_SIZE),
+			            Area(TILE_SIZE, TILE_SIZE));
+		}
+
+		/**
+		 * Draw tiles until all tiles of the frame are taken
+		 */
+		void _draw_tiles()
+		{
+			Canvas<PT> canvas(_frame.base, _frame.size);
+
+			for (;;) {
+				unsigned const i = __atomic_fetch_add(&_frame.next_tile, 1,
+				                                      __ATOMIC_RELAXED);
+				if (i >= _frame.num_tiles)
+					return;
+
+				Rect const tile = _tile(i);
+
+				_frame.region->for_each([&] (Rect const &rect) {
+					Rect const clipped = Rect::intersect(tile, rect);
+					if (clipped.valid())
+						_view_stack.draw(canvas, clipped, _frame.redraw); });
+			}
+		}
+
+		struct Worker : Thread
+		{
+			Compositor &_compositor;
+
+			Semaphore _start { };
+
+			Worker(Env &env, Compositor &compositor, Affinity::Location location)
+			:
+				Thread(env, "compositor", STACK_SIZE, location, Weight(), env.cpu()),
+				_compositor(compositor)
+			{ }
+
+			void entry() override
+			{
+				for (;;) {
+					_start.down();
+					_compositor._draw_tiles();
+					_compositor._finished.up();
+				}
+			}
+		};
+
+		Allocator &_alloc;
+
+		Worker   *_workers[MAX_THREADS - 1] { };
+		unsigned  _num_workers = 0;
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param threads  number of drawing threads including the caller
+		 *
+		 * The workers are spread across the CPUs, starting at the CPU
+		 * following the one of the caller.
+		 */
+		Compositor(Env &env, Allocator &alloc, View_stack const &view_stack,
+		           unsigned threads)
+		:
+			_view_stack(view_stack), _alloc(alloc)
+		{
+			Affinity::Space cpus = env.cpu().affinity_space();
+
+			unsigned const num_workers =
+				min(min(threads, (unsigned)MAX_THREADS), cpus.total()) - 1;
+
+			for (; _num_workers < num_workers; _num_workers++) {
+				try {
+					_workers[_num_workers] = new (_alloc)
+						Worker(env, *this, cpus.location_of_index(_num_workers + 1));
+				}
+				catch (...) {
+					warning("unable to create compositor thread");
+					break;
+				}
+				_workers[_num_workers]->start();
+			}
+		}
+
+		~Compositor()
+		{
+			for (unsigned i = 0; i < _num_workers; i++)
+				destroy(_alloc, _workers[i]);
+		}
+
+		unsigned threads() const { return _num_workers + 1; }
+
+		/**
+		 * Draw the areas of 'region' into the pixel buffer at 'base'
+		 */
+		void draw(PT *base, Area size, Dirty_region const &region,
+		          View_stack::Redraw redraw)
+		{
+			if (region.empty())
+				return;
+
+			/* avoid the costs of tiling if there is nobody to share with */
+			if (!_num_workers) {
+				Canvas<PT> canvas(base, size);
+				region.for_each([&] (Rect const &rect) {
+					_view_stack.draw(canvas, rect, redraw); });
+				return;
+			}
+
+			unsigned const columns = (size.w() + TILE_SIZE - 1) / TILE_SIZE;
+			unsigned const rows    = (size.h() + TILE_SIZE - 1) / TILE_SIZE;
+
+			_frame = Frame { base, size, &region, redraw, columns, columns*rows, 0 };
+
+			for (unsigned i = 0; i < _num_workers; i++)
+				_workers[i]->_start.up();
+
+			_draw_tiles();
+
+			for (unsigned i = 0; i < _num_workers; i++)
+				_finished.down();
+		}
+};
+
+#endif /* _COMPOSITOR_H_ */
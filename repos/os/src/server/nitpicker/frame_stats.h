@@ -0,0 +1,194 @@
+/*
+ * \brief  Timing statistics of the frames drawn by nitpicker
+ * \author Genode Labs
+ * \date   2026-10-14
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _FRAME_STATS_H_
+#define _FRAME_STATS_H_
+
+/* Genode includes */
+#include <base/trace/events.h>
+#include <util/xml_generator.h>
+
+/* local includes */
+#include "types.h"
+
+namespace Nitpicker { class Frame_stats; }
+
+
+/**
+ * Per-frame timing, accumulated over a reporting period
+ *
+ * For each frame, the following durations are measured:
+ *
+ * - The draw time covers the drawing of the dirty areas including the
+ *   refresh of the framebuffer or the request of a flip.
+ * - The latency reaches from the first damage of the screen after the
+ *   previous frame, caused by a client or by user input, to the end of
+ *   drawing.
+ * - The input latency reaches from the handling of a batch of input
+ *   events that caused activity to the end of the next frame.
+ * - The flip time reaches from the request of a page flip to its
+ *   completion signalled by the framebuffer.
+ *
+ * Each frame is also recorded as trace checkpoints of the entrypoint thread.
+ */
+class Nitpicker::Frame_stats : Noncopyable
+{
+	public:
+
+		typedef Genode::uint64_t Us;
+
+		enum { PERIOD_US = 1000*1000 };
+
+	private:
+
+		enum { NONE = ~0ULL };
+
+		struct Duration
+		{
+			Us            sum   = 0;
+			Us            max   = 0;
+			unsigned long count = 0;
+
+			void add(Us us)
+			{
+				sum += us;
+				max  = Genode::max(max, us);
+				count++;
+			}
+
+			void generate(Xml_generator &xml, char const *type) const
+			{
+				if (!count)
+					return;
+
+				xml.node(type, [&] () {
+					xml.attribute("avg_us", sum / count);
+					xml.attribute("max_us", max);
+				});
+			}
+		};
+
+		Duration _draw { }, _latency { }, _input { }, _flip { };
+
+		unsigned long      _frames = 0;
+		unsigned long long _pixels = 0;
+		unsigned long      _max_pixels = 0;
+
+		Us _period_start = NONE;
+		Us _damage       = NONE;
+		Us _input_start  = NONE;
+		Us _flip_start   = NONE;
+
+	public:
+
+		/**
+		 * Record the first damage of the screen since the previous frame
+		 */
+		void damaged(Us now)
+		{
+			if (_damage == NONE)
+				_damage = now;
+		}
+
+		/**
+		 * Record the handling of input events that caused activity
+		 */
+		void input(Us start)
+		{
+			if (_input_start == NONE)
+				_input_start = start;
+		}
+
+		void flip_requested(Us now) { _flip_start = now; }
+
+		void flipped(Us now)
+		{
+			if (_flip_start == NONE)
+				return;
+
+			_flip.add(now - _flip_start);
+			Trace::Checkpoint("nitpicker_flip_us", now - _flip_start);
+			_flip_start = NONE;
+		}
+
+		/**
+		 * Account drawn frame
+		 *
+		 * \param start   time when drawing started
+		 * \param end     time when drawing ended
+		 * \param pixels  number of drawn pixels
+		 */
+		void frame(Us start, Us end, unsigned long pixels)
+		{
+			if (_period_start == NONE)
+				_period_start = start;
+
+			_frames++;
+			_pixels    += pixels;
+			_max_pixels = Genode::max(_max_pixels, pixels);
+
+			_draw.add(end - start);
+			Trace::Checkpoint("nitpicker_draw_us", end - start);
+			Trace::Checkpoint("nitpicker_pixels",  pixels);
+
+			if (_damage != NONE && _damage <= end) {
+				_latency.add(end - _damage);
+				Trace::Checkpoint("nitpicker_latency_us", end - _damage);
+			}
+
+			if (_input_start != NONE && _input_start <= end) {
+				_input.add(end - _input_start);
+				Trace::Checkpoint("nitpicker_input_us", end - _input_start);
+			}
+
+			_damage = _input_start = NONE;
+		}
+
+		bool period_elapsed(Us now) const
+		{
+			return _period_start != NONE && now - _period_start >= PERIOD_US;
+		}
+
+		Us period(Us now) const { return _period_start == NONE ? 0 : now - _period_start; }
+
+		/**
+		 * Generate report of the current period and start a new period
+		 */
+		void generate(Xml_generator &xml, Us now)
+		{
+			Us const period_us = Genode::max(period(now), (Us)1);
+
+			xml.attribute("period_ms", period_us / 1000);
+			xml.attribute("frames",    _frames);
+			xml.attribute("fps",       (_frames*1000000ULL) / period_us);
+
+			if (_frames) {
+				xml.attribute("pixels_per_frame", _pixels / _frames);
+				xml.attribute("max_pixels",       _max_pixels);
+			}
+
+			_draw   .generate(xml, "draw");
+			_latency.generate(xml, "latency");
+			_input  .generate(xml, "input");
+			_flip   .generate(xml, "flip");
+
+			_draw = _latency = _input = _flip = Duration();
+
+			_frames       = 0;
+			_pixels       = 0;
+			_max_pixels   = 0;
+			_period_start = now;
+		}
+};
+
+#endif /* _FRAME_STATS_H_ */
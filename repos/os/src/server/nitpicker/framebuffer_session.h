@@ -41,6 +41,7 @@ class Framebuffer::Session_component : public Rpc_object<Session>
 		Signal_context_capability     _sync_sigh;
 		Framebuffer::Mode             _mode;
 		bool                          _alpha = false;
+		unsigned long                 _refresh_count = 0;
 
 	public:
 
@@ -79,6 +80,16 @@ class Framebuffer::Session_component : public Rpc_object<Session>
 				Signal_transmitter(_mode_sigh).submit();
 		}
 
+		/**
+		 * Return number of refresh calls since the last call of this method
+		 */
+		unsigned long take_refresh_count()
+		{
+			unsigned long const count = _refresh_count;
+			_refresh_count = 0;
+			return count;
+		}
+
 		void submit_sync()
 		{
 			if (_sync_sigh.valid())
@@ -22,6 +22,7 @@
 #include <input_session/connection.h>
 #include <framebuffer_session/connection.h>
 #include <os/session_policy.h>
+#include <timer_session/connection.h>
 
 /* local includes */
 #include "types.h"
@@ -30,6 +31,8 @@
 #include "clip_guard.h"
 #include "pointer_origin.h"
 #include "domain_registry.h"
+#include "compositor.h"
+#include "frame_stats.h"
 
 namespace Nitpicker {
 
@@ -60,6 +63,8 @@ void Framebuffer::Session_component::refresh(int x, int y, int w, int h)
 {
 	Rect const rect(Point(x, y), Area(w, h));
 
+	_refresh_count++;
+
 	_view_stack.mark_session_views_as_dirty(_session, rect);
 }
 
@@ -191,7 +196,7 @@ class Nitpicker::Root : public Root_component<Session_component>,
 };
 
 
-struct Nitpicker::Main : Focus_updater
+struct Nitpicker::Main : Focus_updater, Damage_observer
 {
 	Env &_env;
 
@@ -211,6 +216,8 @@ struct Nitpicker::Main : Focus_updater
 	 */
 	struct Framebuffer_screen
 	{
+		enum { MAX_BUFFERS = 3, NONE = ~0U };
+
 		Framebuffer::Session &framebuffer;
 
 		Framebuffer::Mode const mode = framebuffer.mode();
@@ -221,11 +228,57 @@ struct Nitpicker::Main : Focus_updater
 
 		Area size = screen.size();
 
+		/*
+		 * If the framebuffer provides more than one buffer, we draw into a
+		 * back buffer and flip buffers instead of refreshing the screen.
+		 */
+		unsigned const buffers = _buffers();
+
+		unsigned front   = 0;     /* displayed buffer */
+		unsigned pending = NONE;  /* buffer of the requested flip */
+		unsigned ready   = NONE;  /* buffer drawn while a flip is pending */
+
+		/* areas where the content of each buffer lags behind */
+		Dirty_region stale[MAX_BUFFERS];
+
+		unsigned _buffers() const
+		{
+			size_t   const frame_size = size.count()*sizeof(PT);
+			unsigned const fitting    = fb_ds.size() / frame_size;
+
+			return max(1U, min(min(framebuffer.buffers(), fitting),
+			                   (unsigned)MAX_BUFFERS));
+		}
+
+		bool flipping() const { return buffers > 1; }
+
+		PT *buffer(unsigned i) { return fb_ds.local_addr<PT>() + i*size.count(); }
+
+		/**
+		 * Return buffer to draw into, or NONE if all buffers are in use
+		 */
+		unsigned back_buffer() const
+		{
+			if (ready != NONE)
+				return ready;
+
+			for (unsigned i = 0; i < buffers; i++)
+				if (i != front && i != pending)
+					return i;
+
+			return NONE;
+		}
+
 		/**
 		 * Constructor
 		 */
 		Framebuffer_screen(Region_map &rm, Framebuffer::Session &fb)
-		: framebuffer(fb), fb_ds(rm, framebuffer.dataspace()) { }
+		: framebuffer(fb), fb_ds(rm, framebuffer.dataspace())
+		{
+			/* the initial content of the buffers is undefined */
+			for (unsigned i = 0; i < buffers; i++)
+				stale[i].mark_as_dirty(Rect(Point(), size));
+		}
 	};
 
 	Reconstructible<Framebuffer_screen> _fb_screen = { _env.rm(), _framebuffer };
@@ -234,6 +287,10 @@ struct Nitpicker::Main : Focus_updater
 
 	Signal_handler<Main> _fb_mode_handler = { _env.ep(), *this, &Main::_handle_fb_mode };
 
+	void _handle_flip();
+
+	Signal_handler<Main> _flip_handler = { _env.ep(), *this, &Main::_handle_flip };
+
 	/*
 	 * User-input policy
 	 */
@@ -273,11 +330,15 @@ struct Nitpicker::Main : Focus_updater
 	Reporter _focus_reporter    = { _env, "focus" };
 	Reporter _keystate_reporter = { _env, "keystate" };
 	Reporter _clicked_reporter  = { _env, "clicked" };
+	Reporter _redraw_reporter   = { _env, "redraw" };
+	Reporter _frames_reporter   = { _env, "frames" };
 
 	Attached_rom_dataspace _config_rom { _env, "config" };
 
 	Constructible<Attached_rom_dataspace> _focus_rom;
 
+	Constructible<Compositor<PT> > _compositor;
+
 	Root<PT> _root = { _env, _config_rom, _session_list, *_domain_registry,
 	                   _global_keys, _view_stack, _user_state, _pointer_origin,
 	                   _builtin_background, _sliced_heap, _framebuffer,
@@ -345,14 +406,184 @@ struct Nitpicker::Main : Focus_updater
 	 */
 	bool _motion_activity = false;
 
+	/**
+	 * Number of rectangles redrawn per frame unless configured otherwise
+	 */
+	enum { DEFAULT_REDRAW_BUDGET = 16 };
+
+	/**
+	 * Accumulated numbers of redrawn frames, rectangles, and pixels
+	 */
+	struct Redraw_stats
+	{
+		unsigned long      frames = 0, rects = 0, last_pixels = 0;
+		unsigned long long pixels = 0;
+
+		void report(Reporter &reporter) const
+		{
+			Reporter::Xml_generator xml(reporter, [&] () {
+				xml.attribute("frames",      frames);
+				xml.attribute("rects",       rects);
+				xml.attribute("pixels",      pixels);
+				xml.attribute("last_pixels", last_pixels);
+			});
+		}
+	} _redraw_stats { };
+
+	/*
+	 * Frame timing, enabled by the "frames" report or the 'trace_frames'
+	 * config attribute
+	 */
+	Constructible<Timer::Connection> _timer { };
+
+	bool _frame_timing = false;
+
+	Frame_stats _frame_stats { };
+
+	/**
+	 * Return current time in microseconds, or 0 if timing is disabled
+	 */
+	Frame_stats::Us _now_us()
+	{
+		return _frame_timing ? _timer->curr_time().trunc_to_plain_us().value : 0;
+	}
+
+	/**
+	 * Damage_observer interface
+	 */
+	void damaged() override
+	{
+		if (_frame_timing)
+			_frame_stats.damaged(_now_us());
+	}
+
+	void _report_frames(Frame_stats::Us now)
+	{
+		Frame_stats::Us const period_us = max(_frame_stats.period(now), (Frame_stats::Us)1);
+
+		Reporter::Xml_generator xml(_frames_reporter, [&] () {
+
+			_frame_stats.generate(xml, now);
+
+			for (Session_component *s = _session_list.first(); s; s = s->next()) {
+
+				unsigned long const refreshes = s->take_refresh_count();
+				if (!refreshes)
+					continue;
+
+				xml.node("session", [&] () {
+					xml.attribute("label", s->label());
+					xml.attribute("refresh_rate", (refreshes*1000000ULL) / period_us);
+				});
+			}
+		});
+	}
+
+	/**
+	 * Account frame
+	 *
+	 * \param start_us  time when drawing the frame started
+	 */
+	void _account_redraw(Dirty_region const &redrawn, Frame_stats::Us start_us)
+	{
+		_redraw_stats.frames++;
+		_redraw_stats.rects      += redrawn.count();
+		_redraw_stats.last_pixels = redrawn.pixels();
+		_redraw_stats.pixels     += _redraw_stats.last_pixels;
+
+		if (_redraw_reporter.enabled())
+			_redraw_stats.report(_redraw_reporter);
+
+		if (!_frame_timing)
+			return;
+
+		Frame_stats::Us const now = _now_us();
+
+		_frame_stats.frame(start_us, now, redrawn.pixels());
+
+		if (_frames_reporter.enabled() && _frame_stats.period_elapsed(now))
+			_report_frames(now);
+	}
+
+	/**
+	 * Request flip to the specified buffer
+	 */
+	void _flip(Framebuffer_screen &fb, unsigned buffer)
+	{
+		/* the buffer differs from the displayed one where the latter is stale */
+		Rect area;
+		fb.stale[fb.front].for_each([&] (Rect const &rect) {
+			area = area.valid() ? Rect::compound(area, rect) : rect; });
+
+		_framebuffer.flip(buffer, area.x1(), area.y1(), area.w(), area.h());
+
+		if (_frame_timing)
+			_frame_stats.flip_requested(_now_us());
+
+		fb.pending = buffer;
+		fb.ready   = Framebuffer_screen::NONE;
+	}
+
+	/**
+	 * Perform redraw into a back buffer and display it by flipping buffers
+	 */
+	void _draw_and_flip(Framebuffer_screen &fb)
+	{
+		unsigned const back = fb.back_buffer();
+
+		/* keep the dirty areas until a buffer becomes available */
+		if (back == Framebuffer_screen::NONE)
+			return;
+
+		Dirty_region const damage = _view_stack.take_dirty_region();
+
+		if (damage.empty())
+			return;
+
+		Frame_stats::Us const start_us = _now_us();
+
+		for (unsigned i = 0; i < fb.buffers; i++)
+			damage.for_each([&] (Rect const &rect) {
+				fb.stale[i].mark_as_dirty(rect); });
+
+		_compositor->draw(fb.buffer(back), fb.size, fb.stale[back],
+		                  View_stack::WHOLE_AREA);
+
+		_account_redraw(fb.stale[back], start_us);
+		fb.stale[back].reset();
+
+		if (fb.pending == Framebuffer_screen::NONE)
+			_flip(fb, back);
+		else
+			fb.ready = back;
+	}
+
 	/**
 	 * Perform redraw and flush pixels to the framebuffer
 	 */
 	void _draw_and_flush()
 	{
-		_view_stack.draw(_fb_screen->screen).flush([&] (Rect const &rect) {
+		Framebuffer_screen &fb = *_fb_screen;
+
+		if (fb.flipping()) {
+			_draw_and_flip(fb);
+			return;
+		}
+
+		Dirty_region const redrawn = _view_stack.take_dirty_region();
+
+		if (redrawn.empty())
+			return;
+
+		Frame_stats::Us const start_us = _now_us();
+
+		_compositor->draw(fb.buffer(0), fb.size, redrawn, View_stack::DIRTY_PARTS);
+
+		redrawn.for_each([&] (Rect const &rect) {
 			_framebuffer.refresh(rect.x1(), rect.y1(),
 			                     rect.w(),  rect.h()); });
+
+		_account_redraw(redrawn, start_us);
 	}
 
 	Main(Env &env) : _env(env)
@@ -360,12 +591,14 @@ struct Nitpicker::Main : Focus_updater
 		_view_stack.default_background(_builtin_background);
 		_view_stack.stack(_pointer_origin);
 		_view_stack.stack(_builtin_background);
+		_view_stack.damage_observer(*this);
 
 		_config_rom.sigh(_config_handler);
 		_handle_config();
 
 		_framebuffer.sync_sigh(_input_handler);
 		_framebuffer.mode_sigh(_fb_mode_handler);
+		_framebuffer.flip_sigh(_flip_handler);
 
 		_env.parent().announce(_env.ep().manage(_root));
 	}
@@ -376,6 +609,8 @@ void Nitpicker::Main::_handle_input()
 {
 	_period_cnt++;
 
+	Frame_stats::Us const input_us = _now_us();
+
 	bool const old_button_activity = _button_activity;
 	bool const old_motion_activity = _motion_activity;
 
@@ -394,6 +629,9 @@ void Nitpicker::Main::_handle_input()
 		_motion_activity             = true;
 	}
 
+	if (_frame_timing && (result.button_activity || result.motion_activity))
+		_frame_stats.input(input_us);
+
 	/*
 	 * Report information about currently pressed keys whenever the key state
 	 * is affected by the incoming events.
@@ -445,10 +683,7 @@ void Nitpicker::Main::_handle_input()
 	if (result.motion_activity)
 		_view_stack.geometry(_pointer_origin, Rect(_user_state.pointer_pos(), Area()));
 
-	/* perform redraw and flush pixels to the framebuffer */
-	_view_stack.draw(_fb_screen->screen).flush([&] (Rect const &rect) {
-		_framebuffer.refresh(rect.x1(), rect.y1(),
-		                     rect.w(),  rect.h()); });
+	_draw_and_flush();
 
 	_view_stack.mark_all_views_as_clean();
 
@@ -515,6 +750,26 @@ void Nitpicker::Main::_handle_config()
 	configure_reporter(config, _focus_reporter);
 	configure_reporter(config, _keystate_reporter);
 	configure_reporter(config, _clicked_reporter);
+	configure_reporter(config, _redraw_reporter);
+	configure_reporter(config, _frames_reporter);
+
+	_frame_timing = _frames_reporter.enabled()
+	             || config.attribute_value("trace_frames", false);
+
+	if (_frame_timing && !_timer.constructed())
+		_timer.construct(_env);
+
+	_view_stack.redraw_budget(config.attribute_value("redraw_budget",
+	                                                 (unsigned)DEFAULT_REDRAW_BUDGET));
+
+	/* the number of compositor threads is evaluated at startup only */
+	if (!_compositor.constructed()) {
+		_compositor.construct(_env, _sliced_heap, _view_stack,
+		                      config.attribute_value("compositor_threads", 1U));
+
+		if (_compositor->threads() > 1)
+			log("drawing with ", _compositor->threads(), " compositor threads");
+	}
 
 	/* update domain registry and session policies */
 	for (Session_component *s = _session_list.first(); s; s = s->next())
@@ -559,6 +814,28 @@ void Nitpicker::Main::_handle_config()
 }
 
 
+void Nitpicker::Main::_handle_flip()
+{
+	Framebuffer_screen &fb = *_fb_screen;
+
+	/* ignore flips requested for the framebuffer before a mode change */
+	if (fb.pending == Framebuffer_screen::NONE)
+		return;
+
+	fb.front   = fb.pending;
+	fb.pending = Framebuffer_screen::NONE;
+
+	if (_frame_timing)
+		_frame_stats.flipped(_now_us());
+
+	/* display the frame drawn in the meantime, or draw the deferred one */
+	if (fb.ready != Framebuffer_screen::NONE)
+		_flip(fb, fb.ready);
+	else
+		_draw_and_flush();
+}
+
+
 void Nitpicker::Main::_handle_fb_mode()
 {
 	/* reconstruct framebuffer screen and menu bar */
@@ -172,6 +172,17 @@ void Session_component::_execute_command(Command const &command)
 			return;
 		}
 
+	case Command::OP_ALPHA:
+		{
+			Command::Alpha const &cmd = command.alpha;
+			Locked_ptr<View_component> view(_view_handle_registry.lookup(cmd.view));
+
+			if (view.valid())
+				_view_stack.alpha(*view, cmd.alpha);
+
+			return;
+		}
+
 	case Command::OP_NOP:
 		return;
 	}
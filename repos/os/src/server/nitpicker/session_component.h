@@ -333,6 +333,14 @@ class Nitpicker::Session_component : public Rpc_object<Session>,
 			_framebuffer_session_component.submit_sync();
 		}
 
+		/**
+		 * Return number of framebuffer refreshes since the last call
+		 */
+		unsigned long take_refresh_count()
+		{
+			return _framebuffer_session_component.take_refresh_count();
+		}
+
 
 		/*********************************
 		 ** Nitpicker session interface **
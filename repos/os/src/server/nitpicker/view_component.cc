@@ -129,7 +129,7 @@ void View_component::draw(Canvas_base &canvas, Focus const &focus) const
 	Texture_base const *texture = _owner.texture();
 	if (texture) {
 		canvas.draw_texture(_buffer_off + view_rect.p1(), *texture, op,
-		                    mix_color, allow_alpha);
+		                    mix_color, allow_alpha, _alpha);
 	} else {
 		canvas.draw_box(view_rect, black());
 	}
@@ -157,6 +157,10 @@ bool View_component::input_response_at(Point p) const
 {
 	Rect const view_rect = abs_geometry();
 
+	/* invisible views do not respond to input */
+	if (_alpha == 0)
+		return false;
+
 	/* check if point lies outside view geometry */
 	if ((p.x() < view_rect.x1()) || (p.x() > view_rect.x2())
 	 || (p.y() < view_rect.y1()) || (p.y() > view_rect.y2()))
@@ -180,7 +184,7 @@ int View_component::frame_size(Focus const &focus) const
 
 bool View_component::transparent() const
 {
-	return _transparent || _owner.uses_alpha();
+	return _transparent || _owner.uses_alpha() || _alpha < 255;
 }
 
 
@@ -17,7 +17,7 @@
 /* Genode includes */
 #include <util/string.h>
 #include <util/list.h>
-#include <util/dirty_rect.h>
+#include <util/dirty_region.h>
 #include <base/weak_ptr.h>
 #include <base/rpc_server.h>
 
@@ -30,7 +30,7 @@ namespace Nitpicker {
 	class Buffer;
 	class Focus;
 
-	typedef Dirty_rect<Rect, 3> Dirty_rect;
+	typedef Genode::Dirty_region<Rect, 32> Dirty_region;
 
 	/*
 	 * For each buffer, there is a list of views that belong to this buffer.
@@ -87,7 +87,8 @@ class Nitpicker::View_component : public Same_buffer_list_elem,
 		Point           _buffer_off;     /* offset to the visible buffer area    */
 		View_owner     &_owner;
 		Title           _title;
-		Dirty_rect      _dirty_rect;
+		Dirty_region    _dirty_region;
+		unsigned char   _alpha = 255;    /* opacity of the view content       */
 
 		List<View_parent_elem> _children;
 
@@ -211,6 +212,13 @@ class Nitpicker::View_component : public Same_buffer_list_elem,
 		 */
 		void title(Title const &title);
 
+		/**
+		 * Set opacity of the view content
+		 */
+		void alpha(unsigned char alpha) { _alpha = alpha; }
+
+		unsigned char alpha() const { return _alpha; }
+
 		/**
 		 * Return successor in view stack
 		 */
@@ -267,17 +275,17 @@ class Nitpicker::View_component : public Same_buffer_list_elem,
 		 *
 		 * \param rect  dirty rectangle in absolute coordinates
 		 */
-		void mark_as_dirty(Rect rect) { _dirty_rect.mark_as_dirty(rect); }
+		void mark_as_dirty(Rect rect) { _dirty_region.mark_as_dirty(rect); }
 
 		/**
-		 * Return dirty-rectangle information
+		 * Return dirty region of the view
 		 */
-		Dirty_rect dirty_rect() const { return _dirty_rect; }
+		Dirty_region const &dirty_region() const { return _dirty_region; }
 
 		/**
-		 * Reset dirty rectangle
+		 * Reset dirty region
 		 */
-		void mark_as_clean() { _dirty_rect = Dirty_rect(); }
+		void mark_as_clean() { _dirty_region = Dirty_region(); }
 };
 
 #endif /* _VIEW_H_ */
@@ -168,7 +168,8 @@ void View_stack::_place_labels(Rect rect)
 }
 
 
-void View_stack::draw_rec(Canvas_base &canvas, View_component const *view, Rect rect) const
+void View_stack::draw_rec(Canvas_base &canvas, View_component const *view,
+                          Rect rect, Redraw redraw) const
 {
 	Rect clipped;
 
@@ -185,25 +186,35 @@ void View_stack::draw_rec(Canvas_base &canvas, View_component const *view, Rect
 	View_component const *next = _next_view(*view);
 
 	/* draw areas at the top/left of the current view */
-	if (next &&  top.valid()) draw_rec(canvas, next, top);
-	if (next && left.valid()) draw_rec(canvas, next, left);
+	if (next &&  top.valid()) draw_rec(canvas, next, top,  redraw);
+	if (next && left.valid()) draw_rec(canvas, next, left, redraw);
 
-	/* draw current view */
-	view->dirty_rect().flush([&] (Rect const &dirty_rect) {
+	auto draw_view = [&] (Rect const &dirty_clipped) {
 
-		Clip_guard clip_guard(canvas, Rect::intersect(clipped, dirty_rect));
+		Clip_guard clip_guard(canvas, dirty_clipped);
 
 		/* draw background if view is transparent */
 		if (view->uses_alpha())
-			draw_rec(canvas, _next_view(*view), clipped);
+			draw_rec(canvas, _next_view(*view), dirty_clipped, redraw);
 
 		view->frame(canvas, _focus);
 		view->draw(canvas, _focus);
-	});
+	};
+
+	/* draw the dirty parts of the current view within the clipping rectangle */
+	if (redraw == WHOLE_AREA)
+		draw_view(clipped);
+	else
+		view->dirty_region().for_each([&] (Rect const &dirty_rect) {
+
+			Rect const dirty_clipped = Rect::intersect(clipped, dirty_rect);
+			if (dirty_clipped.valid())
+				draw_view(dirty_clipped);
+		});
 
 	/* draw areas at the bottom/right of the current view */
-	if (next &&  right.valid()) draw_rec(canvas, next, right);
-	if (next && bottom.valid()) draw_rec(canvas, next, bottom);
+	if (next &&  right.valid()) draw_rec(canvas, next, right,  redraw);
+	if (next && bottom.valid()) draw_rec(canvas, next, bottom, redraw);
 }
 
 
@@ -294,6 +305,17 @@ void View_stack::title(View_component &view, const char *title)
 }
 
 
+void View_stack::alpha(View_component &view, unsigned char alpha)
+{
+	if (view.alpha() == alpha)
+		return;
+
+	view.alpha(alpha);
+
+	refresh_view(view, view.abs_geometry());
+}
+
+
 View_component *View_stack::find_view(Point p)
 {
 	View_component *view = _first_view();
@@ -18,7 +18,19 @@
 #include "session_component.h"
 #include "canvas.h"
 
-namespace Nitpicker { class View_stack; }
+namespace Nitpicker {
+	class View_stack;
+	struct Damage_observer;
+}
+
+
+struct Nitpicker::Damage_observer
+{
+	/**
+	 * Called when the screen becomes dirty while being clean before
+	 */
+	virtual void damaged() = 0;
+};
 
 
 class Nitpicker::View_stack
@@ -29,7 +41,8 @@ class Nitpicker::View_stack
 		Focus                 &_focus;
 		List<View_stack_elem>  _views;
 		View_component        *_default_background = nullptr;
-		Dirty_rect mutable     _dirty_rect;
+		Dirty_region mutable   _dirty_region;
+		Damage_observer       *_damage_observer = nullptr;
 
 		/**
 		 * Return outline geometry of a view
@@ -78,12 +91,20 @@ class Nitpicker::View_stack
 		template <typename VIEW>
 		VIEW *_next_view(VIEW &view) const;
 
+		void _mark_as_dirty(Rect rect)
+		{
+			if (_dirty_region.empty() && _damage_observer)
+				_damage_observer->damaged();
+
+			_dirty_region.mark_as_dirty(rect);
+		}
+
 		/**
 		 * Schedule 'rect' to be redrawn
 		 */
 		void _mark_view_as_dirty(View_component &view, Rect rect)
 		{
-			_dirty_rect.mark_as_dirty(rect);
+			_mark_as_dirty(rect);
 
 			view.mark_as_dirty(rect);
 		}
@@ -95,7 +116,7 @@ class Nitpicker::View_stack
 		 */
 		View_stack(Area size, Focus &focus) : _size(size), _focus(focus)
 		{
-			_dirty_rect.mark_as_dirty(Rect(Point(0, 0), _size));
+			_dirty_region.mark_as_dirty(Rect(Point(0, 0), _size));
 		}
 
 		/**
@@ -110,26 +131,57 @@ class Nitpicker::View_stack
 			update_all_views();
 		}
 
+		/**
+		 * Parts of the views drawn by 'draw_rec'
+		 */
+		enum Redraw {
+			DIRTY_PARTS,  /* only the view-local dirty parts */
+			WHOLE_AREA,   /* all views within the area */
+		};
+
 		/**
 		 * Draw views in specified area (recursivly)
 		 *
 		 * \param view  current view in view stack
 		 */
-		void draw_rec(Canvas_base &, View_component const *view, Rect) const;
+		void draw_rec(Canvas_base &, View_component const *view, Rect,
+		              Redraw = DIRTY_PARTS) const;
 
 		/**
-		 * Draw dirty areas
+		 * Define maximum number of rectangles redrawn per frame
+		 *
+		 * Beyond the budget, dirty rectangles are merged at the cost of
+		 * redrawing areas that are not dirty.
 		 */
-		Dirty_rect draw(Canvas_base &canvas) const
-		{
-			Dirty_rect result = _dirty_rect;
+		void redraw_budget(unsigned budget) { _dirty_region.budget(budget); }
 
-			_dirty_rect.flush([&] (Rect const &rect) {
-				draw_rec(canvas, _first_view(), rect); });
+		/**
+		 * Register observer of the first damage after drawing
+		 */
+		void damage_observer(Damage_observer &observer) { _damage_observer = &observer; }
 
+		/**
+		 * Return dirty areas and mark them as clean without drawing
+		 *
+		 * The caller draws the areas via 'draw', possibly with a larger
+		 * region for a buffer that lags behind, e.g., a back buffer.
+		 */
+		Dirty_region take_dirty_region()
+		{
+			Dirty_region result = _dirty_region;
+			_dirty_region.reset();
 			return result;
 		}
 
+		/**
+		 * Draw views within 'rect' without changing the dirty state
+		 *
+		 * Because the view stack is not modified, several threads may draw
+		 * disjoint areas at the same time, each using its own canvas.
+		 */
+		void draw(Canvas_base &canvas, Rect rect, Redraw redraw) const {
+			draw_rec(canvas, _first_view(), rect, redraw); }
+
 		/**
 		 * Trigger redraw of the whole view stack
 		 */
@@ -138,7 +190,7 @@ class Nitpicker::View_stack
 			Rect const whole_screen(Point(), _size);
 
 			_place_labels(whole_screen);
-			_dirty_rect.mark_as_dirty(whole_screen);
+			_mark_as_dirty(whole_screen);
 
 			for (View_component *view = _first_view(); view; view = view->view_stack_next())
 				view->mark_as_dirty(_outline(*view));
@@ -229,6 +281,11 @@ class Nitpicker::View_stack
 		 */
 		void title(View_component &view, char const *title);
 
+		/**
+		 * Set opacity of view content
+		 */
+		void alpha(View_component &view, unsigned char alpha);
+
 		/**
 		 * Find view at specified position
 		 */
@@ -21,6 +21,7 @@
 #include <block_session/rpc_object.h>
 
 #include "gpt.h"
+#include "scheduler.h"
 
 namespace Block {
 
@@ -32,7 +33,7 @@ namespace Block {
 
 
 class Block::Session_component : public Block::Session_rpc_object,
-                                 public List<Block::Session_component>::Element,
+                                 public Block::Scheduler::Client,
                                  public Block_dispatcher
 {
 	private:
@@ -42,11 +43,10 @@ class Block::Session_component : public Block::Session_rpc_object,
 		Partition                        *_partition;
 		Signal_handler<Session_component> _sink_ack;
 		Signal_handler<Session_component> _sink_submit;
-		bool                              _req_queue_full;
 		bool                              _ack_queue_full;
-		Packet_descriptor                 _p_to_handle;
 		unsigned                          _p_in_fly;
 		Block::Driver                    &_driver;
+		Block::Scheduler                 &_scheduler;
 		bool                              _writeable;
 
 		/**
@@ -67,38 +67,106 @@ class Block::Session_component : public Block::Session_rpc_object,
 		inline bool _range_check(Packet_descriptor &p) {
 			return p.block_number() + p.block_count() <= _partition->sectors; }
 
+		/**
+		 * Check scatter-gather table of packet
+		 */
+		bool _sg_valid(Packet_descriptor const &p)
+		{
+			Sg_table const *sg = (Sg_table const *)tx_sink()->packet_content(p);
+			if (!sg || p.size() < sizeof(Sg_table)
+			    || !sg->count || sg->count > Sg_table::MAX_SEGMENTS)
+				return false;
+
+			size_t total = 0;
+			for (unsigned i = 0; i < sg->count; i++) {
+				Packet_descriptor const s(sg->segment[i].offset,
+				                          sg->segment[i].size);
+				if (!s.size() || s.size() % _driver.blk_size()
+				    || !tx_sink()->packet_valid(s))
+					return false;
+				total += s.size();
+			}
+			return total == p.block_count() * _driver.blk_size();
+		}
+
+		/**
+		 * Call 'fn(content, size)' for each payload segment of the packet
+		 *
+		 * The scatter-gather table resides in memory shared with the
+		 * client, hence each segment is checked again on use.
+		 */
+		template <typename FN>
+		void _for_each_segment(Packet_descriptor const &p, FN const &fn)
+		{
+			size_t left = p.block_count() * _driver.blk_size();
+
+			if (!p.scatter_gather()) {
+				char *content = tx_sink()->packet_content(p);
+				if (content)
+					fn(content, min(left, p.size()));
+				return;
+			}
+
+			Sg_table const *sg = (Sg_table const *)tx_sink()->packet_content(p);
+			if (!sg || p.size() < sizeof(Sg_table))
+				return;
+
+			unsigned const count = min(sg->count, (unsigned)Sg_table::MAX_SEGMENTS);
+			for (unsigned i = 0; i < count && left; i++) {
+				Packet_descriptor const s(sg->segment[i].offset,
+				                          min(left, sg->segment[i].size));
+				char *content = tx_sink()->packet_content(s);
+				if (!content)
+					return;
+
+				fn(content, s.size());
+				left -= s.size();
+			}
+		}
+
 		/**
 		 * Handle a single request
 		 */
 		void _handle_packet(Packet_descriptor packet)
 		{
-			_p_to_handle = packet;
-			_p_to_handle.succeeded(false);
+			typedef Packet_descriptor::Opcode Opcode;
+
+			packet.succeeded(false);
+
+			Opcode const op = packet.operation();
+			bool const payload   = op == Opcode::READ  || op == Opcode::WRITE;
+			bool const modifying = op == Opcode::WRITE || op == Opcode::DISCARD;
+			bool const flush     = op == Opcode::FLUSH;
 
 			/* ignore invalid packets */
-			if (!packet.size() || !_range_check(_p_to_handle)) {
-				_ack_packet(_p_to_handle);
+			if (op >= Opcode::END || (payload && !packet.size())
+			    || (!flush && !_range_check(packet))
+			    || (packet.scatter_gather() && (!payload || !_sg_valid(packet)))) {
+				_ack_packet(packet);
 				return;
 			}
 
-			bool write   = _p_to_handle.operation() == Packet_descriptor::WRITE;
-			sector_t off = _p_to_handle.block_number() + _partition->lba;
-			size_t cnt   = _p_to_handle.block_count();
-			void* addr   = tx_sink()->packet_content(_p_to_handle);
-
-			if (write && !_writeable) {
-				_ack_packet(_p_to_handle);
+			if ((modifying && !_writeable) || !_driver.ops().supported(op)) {
+				_ack_packet(packet);
 				return;
 			}
 
-			try {
-				_driver.io(write, off, cnt, addr, *this, _p_to_handle);
-			} catch (Block::Session::Tx::Source::Packet_alloc_failed) {
-				if (!_req_queue_full) {
-					_req_queue_full = true;
-					Session_component::wait_queue().insert(this);
-				}
-			}
+			/* requests without payload are accounted like one block */
+			enqueue(packet, max((size_t)1, packet.block_count()) * _driver.blk_size());
+		}
+
+		/**
+		 * Pass request chosen by the scheduler to the back end
+		 */
+		void _submit(Packet_descriptor &packet, Genode::uint64_t arrival_us) override
+		{
+			bool const flush = packet.operation() == Packet_descriptor::FLUSH;
+
+			/* a flush covers the whole device, thus no offset applies */
+			sector_t off = flush ? 0 : packet.block_number() + _partition->lba;
+			size_t cnt   = packet.block_count();
+
+			_driver.io(packet.operation(), off, cnt, *this, packet, arrival_us);
 		}
 
 		/**
@@ -110,13 +178,15 @@ class Block::Session_component : public Block::Session_rpc_object,
 
 			/*
 			 * as long as more packets are available, and we're able to ack
-			 * them, and the driver's request queue isn't full,
-			 * direct the packet request to the driver backend
+			 * them, and the scheduler queue isn't full, queue the packet
+			 * request for the driver backend
 			 */
-			for (; !_req_queue_full && tx_sink()->packet_avail() &&
+			for (; !queue_full() && tx_sink()->packet_avail() &&
 					 !_ack_queue_full; _p_in_fly++,
 					 _ack_queue_full = _p_in_fly >= tx_sink()->ack_slots_free())
 					_handle_packet(tx_sink()->get_packet());
+
+			_scheduler.schedule();
 		}
 
 		/**
@@ -134,65 +204,62 @@ class Block::Session_component : public Block::Session_rpc_object,
 		                  Genode::Entrypoint       &ep,
 		                  Genode::Region_map       &rm,
 		                  Block::Driver            &driver,
+		                  Block::Scheduler         &scheduler,
+		                  Session_label const      &label,
+		                  Scheduler::Client_config  client_config,
 		                  bool                      writeable)
 		: Session_rpc_object(rm, rq_ds, ep.rpc_ep()),
+		  Scheduler::Client(scheduler, label, client_config),
 		  _rq_ds(rq_ds),
 		  _rq_phys(Dataspace_client(_rq_ds).phys_addr()),
 		  _partition(partition),
 		  _sink_ack(ep, *this, &Session_component::_ready_to_ack),
 		  _sink_submit(ep, *this, &Session_component::_packet_avail),
-		  _req_queue_full(false),
 		  _ack_queue_full(false),
 		  _p_in_fly(0),
 		  _driver(driver),
+		  _scheduler(scheduler),
 		  _writeable(writeable)
 		{
 			_tx.sigh_ready_to_ack(_sink_ack);
 			_tx.sigh_packet_avail(_sink_submit);
 		}
 
-		~Session_component()
-		{
-			_driver.remove_dispatcher(*this);
-
-			if (_req_queue_full)
-				wait_queue().remove(this);
-		}
+		~Session_component() { _driver.remove_dispatcher(*this); }
 
 		Ram_dataspace_capability const rq_ds() const { return _rq_ds; }
 		Partition *partition() { return _partition; }
 
-		void dispatch(Packet_descriptor &request, Packet_descriptor &reply)
+		void dispatch(Packet_descriptor &request, Packet_descriptor &reply,
+		              Genode::uint64_t arrival_us) override
 		{
+			completed(request.block_count() * _driver.blk_size(), arrival_us);
+
 			if (request.operation() == Block::Packet_descriptor::READ) {
-				void *src =
+				char const *src =
 					_driver.session().tx()->packet_content(reply);
-				Genode::size_t sz =
-					request.block_count() * _driver.blk_size();
-				Genode::memcpy(tx_sink()->packet_content(request), src, sz);
+				_for_each_segment(request, [&] (char *dst, size_t size) {
+					Genode::memcpy(dst, src, size);
+					src += size;
+				});
 			}
 			request.succeeded(reply.succeeded());
 			_ack_packet(request);
 
-			if (_ack_queue_full)
+			if (_ack_queue_full || tx_sink()->packet_avail())
 				_packet_avail();
 		}
 
-		static List<Session_component>& wait_queue()
-		{
-			static List<Session_component> l;
-			return l;
-		}
-
-		static void wake_up()
+		/*
+		 * The segments of a scatter-gather request get merged into one
+		 * request to the backend
+		 */
+		void gather(Packet_descriptor &request, char *dst) override
 		{
-			for (; Session_component *c = wait_queue().first();)
-			{
-				wait_queue().remove(c);
-				c->_req_queue_full = false;
-				c->_handle_packet(c->_p_to_handle);
-				c->_packet_avail();
-			}
+			_for_each_segment(request, [&] (char const *src, size_t size) {
+				Genode::memcpy(dst, src, size);
+				dst += size;
+			});
 		}
 
 		/*******************************
@@ -214,6 +281,12 @@ class Block::Session_component : public Block::Session_rpc_object,
 				ops->set_operation(Opcode::READ);
 			if (_writeable && driver_ops.supported(Opcode::WRITE))
 				ops->set_operation(Opcode::WRITE);
+			if (_writeable && driver_ops.supported(Opcode::DISCARD))
+				ops->set_operation(Opcode::DISCARD);
+			if (_writeable && driver_ops.supported(Opcode::FLUSH))
+				ops->set_operation(Opcode::FLUSH);
+
+			ops->set_scatter_gather();
 		}
 
 		void sync() { _driver.session().sync(); }
@@ -231,6 +304,7 @@ class Block::Root :
 		Genode::Env            &_env;
 		Genode::Xml_node        _config;
 		Block::Driver          &_driver;
+		Block::Scheduler       &_scheduler;
 		Block::Partition_table &_table;
 
 	protected:
@@ -252,6 +326,7 @@ class Block::Root :
 
 			Session_label const label = label_from_args(args);
 			char const *label_str = label.string();
+			Scheduler::Client_config client_config { Xml_node("<policy/>") };
 			try {
 				Session_policy policy(label, _config);
 
@@ -261,6 +336,9 @@ class Block::Root :
 				/* sessions are not writeable by default */
 				writeable = policy.attribute_value("writeable", false);
 
+				/* scheduling parameters */
+				client_config = Scheduler::Client_config(policy);
+
 			} catch (Xml_node::Nonexistent_attribute) {
 				error("policy does not define partition number for for '",
 				      label_str, "'");
@@ -310,6 +388,7 @@ class Block::Root :
 			Session_component *session = new (md_alloc())
 				Session_component(ds_cap, _table.partition(num),
 				                  _env.ep(), _env.rm(), _driver,
+				                  _scheduler, label, client_config,
 				                  writeable);
 
 			log("session opened at partition ", num, " for '", label_str, "'");
@@ -319,9 +398,10 @@ class Block::Root :
 	public:
 
 		Root(Genode::Env &env, Genode::Xml_node config, Genode::Heap &heap,
-		     Block::Driver &driver, Block::Partition_table &table)
+		     Block::Driver &driver, Block::Scheduler &scheduler,
+		     Block::Partition_table &table)
 		: Root_component(env.ep(), heap), _env(env), _config(config),
-		  _driver(driver), _table(table) { }
+		  _driver(driver), _scheduler(scheduler), _table(table) { }
 };
 
 #endif /* _PART_BLK__COMPONENT_H_ */
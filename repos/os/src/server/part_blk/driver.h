@@ -32,7 +32,18 @@ class Block::Block_dispatcher
 {
 	public:
 
-		virtual void dispatch(Packet_descriptor&, Packet_descriptor&) = 0;
+		/**
+		 * Complete request
+		 *
+		 * \param time  time value handed over when submitting the request
+		 */
+		virtual void dispatch(Packet_descriptor&, Packet_descriptor&,
+		                      Genode::uint64_t time) = 0;
+
+		/**
+		 * Copy the payload of a write request to the contiguous buffer 'dst'
+		 */
+		virtual void gather(Packet_descriptor&, char *dst) = 0;
 };
 
 
@@ -56,25 +67,34 @@ class Block::Driver
 			Block_dispatcher &_dispatcher;
 			Packet_descriptor _cli;
 			Packet_descriptor _srv;
+			Genode::uint64_t  _time;
 
 		public:
 
 			Request(Block_dispatcher &d,
 			        Packet_descriptor &cli,
-			        Packet_descriptor &srv)
-			: _dispatcher(d), _cli(cli), _srv(srv) {}
-
-			bool handle(Packet_descriptor& reply)
-			{
-				bool ret =  reply == _srv;
-				if (ret) _dispatcher.dispatch(_cli, reply);
-				return ret;
-			}
+			        Packet_descriptor &srv,
+			        Genode::uint64_t   time)
+			: _dispatcher(d), _cli(cli), _srv(srv), _time(time) {}
+
+			bool match(Packet_descriptor const &reply) const {
+				return reply == _srv; }
+
+			void handle(Packet_descriptor& reply) {
+				_dispatcher.dispatch(_cli, reply, _time); }
 
 			bool same_dispatcher(Block_dispatcher &same) {
 				return &same == &_dispatcher; }
 	};
 
+	/**
+	 * Interface for getting notified when the back end can take requests
+	 */
+	struct Submit_handler
+	{
+		virtual void ready_to_submit() = 0;
+	};
+
 	private:
 
 		enum { BLK_SZ = Session::TX_QUEUE_SIZE*sizeof(Request) };
@@ -88,22 +108,44 @@ class Block::Driver
 		Genode::Signal_handler<Driver> _source_ack;
 		Genode::Signal_handler<Driver> _source_submit;
 		Block::Session::Operations     _ops;
+		Submit_handler                *_submit_handler = nullptr;
 
-		void _ready_to_submit();
+		void _ready_to_submit()
+		{
+			if (_submit_handler)
+				_submit_handler->ready_to_submit();
+		}
 
 		void _ack_avail()
 		{
-			/* check for acknowledgements */
-			while (_session.tx()->ack_avail()) {
-				Packet_descriptor p = _session.tx()->get_acked_packet();
-				for (Request *r = _r_list.first(); r; r = r->next()) {
-					if (r->handle(p)) {
-						_r_list.remove(r);
-						Genode::destroy(&_r_slab, r);
-						break;
+			enum { BATCH_SIZE = 16 };
+			Packet_descriptor acks[BATCH_SIZE];
+
+			/* check for acknowledgements, fetch them batch-wise */
+			for (unsigned cnt;
+			     (cnt = _session.tx()->get_acked_packets(acks, BATCH_SIZE)); ) {
+
+				for (unsigned i = 0; i < cnt; i++) {
+					Packet_descriptor &p = acks[i];
+
+					/*
+					 * Requests without payload, like flushes of different
+					 * clients, may be indistinguishable. As the list is
+					 * ordered from the newest to the oldest request, the
+					 * last match is the one submitted first.
+					 */
+					Request *match = nullptr;
+					for (Request *r = _r_list.first(); r; r = r->next())
+						if (r->match(p))
+							match = r;
+
+					if (match) {
+						match->handle(p);
+						_r_list.remove(match);
+						Genode::destroy(&_r_slab, match);
 					}
+					_session.tx()->release_packet(p);
 				}
-				_session.tx()->release_packet(p);
 			}
 
 			_ready_to_submit();
@@ -134,24 +176,35 @@ class Block::Driver
 
 		static Driver& driver();
 
-		void io(bool write, sector_t nr, Genode::size_t cnt, void* addr,
-		        Block_dispatcher &dispatcher, Packet_descriptor& cli)
+		void submit_handler(Submit_handler &handler) {
+			_submit_handler = &handler; }
+
+		/**
+		 * Submit request to the back end
+		 *
+		 * \param time  value handed back to the dispatcher on completion
+		 *
+		 * \throw Block::Session::Tx::Source::Packet_alloc_failed
+		 */
+		void io(Packet_descriptor::Opcode op, sector_t nr, Genode::size_t cnt,
+		        Block_dispatcher &dispatcher, Packet_descriptor& cli,
+		        Genode::uint64_t time)
 		{
 			if (!_session.tx()->ready_to_submit())
 				throw Block::Session::Tx::Source::Packet_alloc_failed();
 
-			Block::Packet_descriptor::Opcode op = write
-			    ? Block::Packet_descriptor::WRITE
-			    : Block::Packet_descriptor::READ;
-			Genode::size_t size = _blk_size * cnt;
+			/* discard and flush requests carry no payload */
+			bool const payload = op == Packet_descriptor::READ
+			                  || op == Packet_descriptor::WRITE;
+
+			Genode::size_t size = payload ? _blk_size * cnt : 0;
 			Packet_descriptor p(_session.dma_alloc_packet(size),
 			                    op,  nr, cnt);
-			Request *r = new (&_r_slab) Request(dispatcher, cli, p);
+			Request *r = new (&_r_slab) Request(dispatcher, cli, p, time);
 			_r_list.insert(r);
 
-			if (write)
-				Genode::memcpy(_session.tx()->packet_content(p),
-				               addr, size);
+			if (op == Packet_descriptor::WRITE)
+				dispatcher.gather(cli, _session.tx()->packet_content(p));
 
 			_session.tx()->submit_packet(p);
 		}
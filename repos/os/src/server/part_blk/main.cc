@@ -20,10 +20,7 @@
 #include "driver.h"
 #include "gpt.h"
 #include "mbr.h"
-
-
-void Block::Driver::_ready_to_submit() {
-	Block::Session_component::wake_up(); }
+#include "scheduler.h"
 
 
 class Main
@@ -41,7 +38,9 @@ class Main
 		Genode::Reporter    _reporter { _env, "partitions" };
 		Mbr_partition_table _mbr      { _heap, _driver, _reporter };
 		Gpt                 _gpt      { _heap, _driver, _reporter };
-		Block::Root         _root     { _env, _config.xml(), _heap, _driver, _table() };
+		Block::Scheduler    _scheduler { _env, _config.xml(), _driver };
+		Block::Root         _root     { _env, _config.xml(), _heap, _driver,
+		                                _scheduler, _table() };
 
 	public:
 
@@ -0,0 +1,478 @@
+/*
+ * \brief  Scheduler for the requests of the partition clients
+ * \author Genode Labs
+ * \date   2026-10-14
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _PART_BLK__SCHEDULER_H_
+#define _PART_BLK__SCHEDULER_H_
+
+#include <base/log.h>
+#include <base/session_label.h>
+#include <os/reporter.h>
+#include <timer_session/connection.h>
+#include <util/list.h>
+#include <util/reconstructible.h>
+#include <util/xml_node.h>
+
+#include "driver.h"
+
+namespace Block {
+	class Io_stats;
+	class Scheduler;
+}
+
+
+/**
+ * Request statistics including a latency histogram of one client
+ */
+class Block::Io_stats
+{
+	public:
+
+		/*
+		 * Bucket i counts the requests with a latency below 16 << i us,
+		 * the last bucket counts all remaining requests
+		 */
+		enum { BUCKETS = 21, FIRST_BUCKET_US = 16 };
+
+	private:
+
+		unsigned long    _requests = 0;
+		Genode::uint64_t _bytes    = 0;
+		Genode::uint64_t _total_us = 0;
+		Genode::uint64_t _max_us   = 0;
+		unsigned long    _bucket[BUCKETS] { };
+
+	public:
+
+		void record(Genode::uint64_t latency_us, Genode::size_t bytes)
+		{
+			_requests++;
+			_bytes    += bytes;
+			_total_us += latency_us;
+			_max_us    = Genode::max(_max_us, latency_us);
+
+			unsigned i = 0;
+			while (i < BUCKETS - 1
+			       && latency_us >= ((Genode::uint64_t)FIRST_BUCKET_US << i))
+				i++;
+			_bucket[i]++;
+		}
+
+		void report(Genode::Xml_generator &xml) const
+		{
+			xml.attribute("requests", _requests);
+			xml.attribute("bytes", _bytes);
+
+			if (!_requests)
+				return;
+
+			xml.attribute("avg_latency_us", _total_us / _requests);
+			xml.attribute("max_latency_us", _max_us);
+
+			for (unsigned i = 0; i < BUCKETS; i++) {
+				if (!_bucket[i])
+					continue;
+
+				xml.node("latency", [&] () {
+					if (i < BUCKETS - 1)
+						xml.attribute("below_us",
+						              (Genode::uint64_t)FIRST_BUCKET_US << i);
+					xml.attribute("count", _bucket[i]);
+				});
+			}
+		}
+};
+
+
+/**
+ * Scheduler that decides which client request is passed to the back end next
+ *
+ * The requests of each client are queued in order of their arrival and
+ * stay in this order. The scheduler merely interleaves the requests of
+ * different clients, thus, the ordering requirements of flushes are kept.
+ * It keeps at most 'depth' requests in flight at the back end. Otherwise,
+ * the request queue of the back end would turn into a first-come,
+ * first-served queue again.
+ *
+ * Policies:
+ *
+ * 'fifo'      passes requests in order of their arrival
+ * 'deadline'  passes the request with the earliest deadline, which is the
+ *             arrival time plus the read or write deadline of the client
+ * 'wfq'       weighted fair queueing, each client receives a share of the
+ *             bandwidth proportional to its weight
+ *
+ * Independent of the policy, clients may be limited in the number of
+ * requests and bytes per second.
+ */
+class Block::Scheduler : public Driver::Submit_handler
+{
+	public:
+
+		enum Policy { FIFO, DEADLINE, WFQ };
+
+		struct Client_config
+		{
+			unsigned      weight;
+			unsigned long read_deadline_ms;
+			unsigned long write_deadline_ms;
+			unsigned long iops_limit;       /* requests per second */
+			unsigned long bandwidth_limit;  /* bytes per second */
+
+			Client_config(Genode::Xml_node policy)
+			:
+				weight(Genode::max(policy.attribute_value("weight", 1U), 1U)),
+				read_deadline_ms(policy.attribute_value("read_deadline_ms", 500UL)),
+				write_deadline_ms(policy.attribute_value("write_deadline_ms", 5000UL)),
+				iops_limit(policy.attribute_value("iops_limit", 0UL)),
+				bandwidth_limit(policy.attribute_value("bandwidth_limit",
+				                                       Genode::Number_of_bytes(0)))
+			{ }
+
+			bool limited() const { return iops_limit || bandwidth_limit; }
+		};
+
+		class Client;
+
+	private:
+
+		/* a rate-limited client may catch up for this duration */
+		enum { BURST_US = 100 * 1000 };
+
+		/* scale of the WFQ tags to keep the precision with large weights */
+		enum { WFQ_SCALE = 256 };
+
+		Genode::Env                     &_env;
+		Policy                    const  _policy;
+		unsigned                  const  _depth;
+		Genode::List<Client>             _clients        { };
+		unsigned                         _in_flight      = 0;
+		unsigned long                    _sequence       = 0;
+		Genode::uint64_t                 _virtual_time   = 0;
+		bool                             _report_enabled = false;
+		unsigned long                    _report_interval_ms;
+		Genode::Reporter                 _reporter       { _env, "io_stats" };
+
+		Genode::Constructible<Timer::Connection>                   _timer;
+		Genode::Constructible<Timer::One_shot_timeout<Scheduler>>  _throttle_timeout;
+		Genode::Constructible<Timer::Periodic_timeout<Scheduler>>  _report_timeout;
+
+		static Policy _policy_from_config(Genode::Xml_node config)
+		{
+			typedef Genode::String<16> Name;
+			Name name("fifo");
+			try {
+				name = config.sub_node("scheduler").attribute_value("policy", name);
+			} catch (Genode::Xml_node::Nonexistent_sub_node) { }
+
+			if (name == "deadline") return DEADLINE;
+			if (name == "wfq")      return WFQ;
+			if (name != "fifo")
+				Genode::warning("unknown scheduler policy '", name, "', use fifo");
+
+			return FIFO;
+		}
+
+		static unsigned _depth_from_config(Genode::Xml_node config, Policy policy)
+		{
+			/* keep the first-come, first-served behaviour by default */
+			unsigned depth = policy == FIFO ? (unsigned)Session::TX_QUEUE_SIZE : 8U;
+			try {
+				depth = config.sub_node("scheduler").attribute_value("depth", depth);
+			} catch (Genode::Xml_node::Nonexistent_sub_node) { }
+
+			return Genode::max(depth, 1U);
+		}
+
+		void _construct_timer()
+		{
+			if (_timer.constructed())
+				return;
+
+			_timer.construct(_env);
+			_throttle_timeout.construct(*_timer, *this, &Scheduler::_handle_throttle_timeout);
+		}
+
+		Genode::uint64_t _now_us()
+		{
+			if (!_timer.constructed())
+				return 0;
+
+			return _timer->curr_time().trunc_to_plain_us().value;
+		}
+
+		void _handle_throttle_timeout(Genode::Duration) { schedule(); }
+
+		void _handle_report_timeout(Genode::Duration);
+
+	public:
+
+		Scheduler(Genode::Env &env, Genode::Xml_node config, Driver &driver)
+		:
+			_env(env), _policy(_policy_from_config(config)),
+			_depth(_depth_from_config(config, _policy)),
+			_report_interval_ms(1000)
+		{
+			try {
+				Genode::Xml_node report = config.sub_node("report");
+				_report_enabled     = report.attribute_value("io_stats", false);
+				_report_interval_ms = Genode::max(report.attribute_value(
+					"io_stats_interval_ms", _report_interval_ms), 10UL);
+			} catch (Genode::Xml_node::Nonexistent_sub_node) { }
+
+			if (_policy == DEADLINE || _report_enabled)
+				_construct_timer();
+
+			if (_report_enabled) {
+				_reporter.enabled(true);
+				_report_timeout.construct(*_timer, *this,
+				                          &Scheduler::_handle_report_timeout,
+				                          Genode::Microseconds(_report_interval_ms * 1000));
+			}
+
+			driver.submit_handler(*this);
+		}
+
+		/**
+		 * Pass queued requests to the back end as long as possible
+		 */
+		void schedule();
+
+
+		/****************************
+		 ** Driver::Submit_handler **
+		 ****************************/
+
+		void ready_to_submit() override { schedule(); }
+};
+
+
+/**
+ * Client of the scheduler, which is a partition session
+ */
+class Block::Scheduler::Client : public Genode::List<Client>::Element
+{
+	friend class Scheduler;
+
+	public:
+
+		enum { QUEUE_SIZE = Session::TX_QUEUE_SIZE };
+
+	private:
+
+		struct Entry
+		{
+			Packet_descriptor packet;
+			Genode::uint64_t  arrival_us;
+			Genode::uint64_t  key;    /* requests with lower key go first */
+			Genode::size_t    bytes;
+		};
+
+		Scheduler                  &_scheduler;
+		Genode::Session_label const _label;
+		Client_config         const _config;
+		Entry                       _queue[QUEUE_SIZE];
+		unsigned                    _head         = 0;
+		unsigned                    _count        = 0;
+		unsigned                    _in_flight    = 0;
+		Genode::uint64_t            _finish       = 0;  /* last WFQ tag */
+		Genode::uint64_t            _iops_time    = 0;  /* rate limits */
+		Genode::uint64_t            _bw_time      = 0;
+		unsigned long               _throttled    = 0;
+		Io_stats                    _stats;
+
+		Entry &_first() { return _queue[_head]; }
+
+		Genode::uint64_t _allowed_us() const {
+			return Genode::max(_iops_time, _bw_time); }
+
+		/**
+		 * Account the request against the rate limits of the client
+		 *
+		 * The limits are implemented as virtual schedule: each request
+		 * shifts the earliest time of the next request by its cost.
+		 */
+		void _charge(Entry const &e, Genode::uint64_t now)
+		{
+			Genode::uint64_t const floor = now > BURST_US ? now - BURST_US : 0;
+
+			if (_config.iops_limit)
+				_iops_time = Genode::max(_iops_time, floor)
+				           + 1000*1000 / _config.iops_limit;
+
+			if (_config.bandwidth_limit)
+				_bw_time = Genode::max(_bw_time, floor)
+				         + (Genode::uint64_t)e.bytes * 1000*1000
+				           / _config.bandwidth_limit;
+		}
+
+		/**
+		 * Pass first request to the back end
+		 *
+		 * \return false if the back end cannot take the request
+		 */
+		bool _dispatch(Genode::uint64_t now)
+		{
+			Entry &e = _first();
+			try { _submit(e.packet, e.arrival_us); }
+			catch (Block::Session::Tx::Source::Packet_alloc_failed) {
+				return false; }
+
+			_charge(e, now);
+			if (_scheduler._policy == WFQ)
+				_scheduler._virtual_time = e.key;
+
+			_head = (_head + 1) % QUEUE_SIZE;
+			_count--;
+			_in_flight++;
+			_scheduler._in_flight++;
+			return true;
+		}
+
+	protected:
+
+		/**
+		 * Submit request to the back end
+		 *
+		 * \throw Block::Session::Tx::Source::Packet_alloc_failed
+		 */
+		virtual void _submit(Packet_descriptor &packet,
+		                     Genode::uint64_t   arrival_us) = 0;
+
+	public:
+
+		Client(Scheduler &scheduler, Genode::Session_label const &label,
+		       Client_config const &config)
+		: _scheduler(scheduler), _label(label), _config(config)
+		{
+			if (_config.limited())
+				_scheduler._construct_timer();
+
+			_scheduler._clients.insert(this);
+		}
+
+		virtual ~Client()
+		{
+			/* requests in flight got dropped by the driver */
+			_scheduler._in_flight -= _in_flight;
+			_scheduler._clients.remove(this);
+			_scheduler.schedule();
+		}
+
+		bool queue_full() const { return _count == QUEUE_SIZE; }
+
+		/**
+		 * Queue request, 'bytes' denotes the cost of the request
+		 */
+		void enqueue(Packet_descriptor const &packet, Genode::size_t bytes)
+		{
+			Genode::uint64_t const now = _scheduler._now_us();
+
+			Genode::uint64_t key = _scheduler._sequence++;
+			switch (_scheduler._policy) {
+			case FIFO:
+				break;
+			case DEADLINE:
+				key = now + 1000 * (packet.operation() == Packet_descriptor::READ
+				                    ? _config.read_deadline_ms
+				                    : _config.write_deadline_ms);
+				break;
+			case WFQ:
+				_finish = Genode::max(_finish, _scheduler._virtual_time)
+				        + (Genode::uint64_t)bytes * WFQ_SCALE / _config.weight;
+				key = _finish;
+				break;
+			}
+
+			_queue[(_head + _count) % QUEUE_SIZE] = { packet, now, key, bytes };
+			_count++;
+		}
+
+		/**
+		 * Account completion of request that arrived at 'arrival_us'
+		 */
+		void completed(Genode::size_t bytes, Genode::uint64_t arrival_us)
+		{
+			_in_flight--;
+			_scheduler._in_flight--;
+
+			Genode::uint64_t const now = _scheduler._now_us();
+			_stats.record(now > arrival_us ? now - arrival_us : 0, bytes);
+		}
+
+		void report(Genode::Xml_generator &xml) const
+		{
+			xml.node("client", [&] () {
+				xml.attribute("label", _label);
+				xml.attribute("queued", _count);
+				xml.attribute("in_flight", _in_flight);
+				xml.attribute("throttled", _throttled);
+				_stats.report(xml);
+			});
+		}
+};
+
+
+void Block::Scheduler::schedule()
+{
+	Genode::uint64_t const now = _now_us();
+
+	bool throttled = false;
+	Genode::uint64_t wake_up = ~0ULL;
+
+	while (_in_flight < _depth) {
+
+		Client *next = nullptr;
+		throttled    = false;
+		wake_up      = ~0ULL;
+
+		for (Client *c = _clients.first(); c; c = c->next()) {
+			if (!c->_count)
+				continue;
+
+			if (c->_allowed_us() > now) {
+				throttled = true;
+				wake_up   = Genode::min(wake_up, c->_allowed_us());
+				continue;
+			}
+			if (!next || c->_first().key < next->_first().key)
+				next = c;
+		}
+
+		if (!next)
+			break;
+
+		/* back end is congested, its ready-to-submit signal resumes */
+		if (!next->_dispatch(now))
+			return;
+
+		if (next->_count && next->_allowed_us() > now)
+			next->_throttled++;
+	}
+
+	if (throttled && _in_flight < _depth)
+		_throttle_timeout->schedule(Genode::Microseconds(wake_up - now));
+}
+
+
+void Block::Scheduler::_handle_report_timeout(Genode::Duration)
+{
+	try {
+		Genode::Reporter::Xml_generator xml(_reporter, [&] () {
+			xml.attribute("in_flight", _in_flight);
+			for (Client *c = _clients.first(); c; c = c->next())
+				c->report(xml);
+		});
+	} catch (...) { Genode::warning("I/O statistics report failed"); }
+}
+
+#endif /* _PART_BLK__SCHEDULER_H_ */
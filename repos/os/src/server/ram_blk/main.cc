@@ -131,6 +131,12 @@ class Ram_blk : public Block::Driver
 		{
 			_io(block_number, block_count, const_cast<char *>(buffer), packet, false);
 		}
+
+		Dataspace_capability dataspace(bool writeable) override
+		{
+			return writeable ? Dataspace_capability(_ram_ds.cap())
+			                 : Dataspace_capability();
+		}
 };
 
 
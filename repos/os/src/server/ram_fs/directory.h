@@ -29,28 +29,15 @@ class Ram_fs::Directory : public Node
 {
 	private:
 
-		List<Node> _entries;
-		size_t     _num_entries;
-
-		Node *_entry_unsynchronized(size_t index)
-		{
-			Node *node = _entries.first();
-			for (unsigned i = 0; i < index && node; node = node->next(), i++);
-			return node;
-		}
+		File_system::Name_index<Node> _entries;
 
 	public:
 
-		Directory(char const *name) : _num_entries(0) { Node::name(name); }
+		Directory(char const *name) { Node::name(name); }
 
 		bool has_sub_node_unsynchronized(char const *name) const override
 		{
-			Node const *sub_node = _entries.first();
-			for (; sub_node; sub_node = sub_node->next())
-				if (strcmp(sub_node->name(), name) == 0)
-					return true;
-
-			return false;
+			return _entries.lookup(name) != nullptr;
 		}
 
 		void adopt_unsynchronized(Node *node) override
@@ -59,7 +46,6 @@ class Ram_fs::Directory : public Node
 			 * XXX inc ref counter
 			 */
 			_entries.insert(node);
-			_num_entries++;
 
 			mark_as_updated();
 		}
@@ -67,7 +53,6 @@ class Ram_fs::Directory : public Node
 		void discard(Node *node) override
 		{
 			_entries.remove(node);
-			_num_entries--;
 
 			mark_as_updated();
 		}
@@ -100,12 +85,7 @@ class Ram_fs::Directory : public Node
 			 */
 
 			/* try to find entry that matches the first path element */
-			Node *sub_node = _entries.first();
-			for (; sub_node; sub_node = sub_node->next())
-				if ((strlen(sub_node->name()) == i) &&
-					(strcmp(sub_node->name(), path, i) == 0))
-					break;
-
+			Node *sub_node = _entries.lookup(path, i);
 			if (!sub_node)
 				throw File_system::Lookup_failed();
 
@@ -195,7 +175,7 @@ class Ram_fs::Directory : public Node
 				return 0;
 			}
 
-			Node *node = _entry_unsynchronized(index);
+			Node *node = _entries.entry(index);
 
 			/* index out of range */
 			if (!node)
@@ -224,7 +204,7 @@ class Ram_fs::Directory : public Node
 		{
 			Status s;
 			s.inode = inode();
-			s.size = _num_entries * sizeof(File_system::Directory_entry);
+			s.size = _entries.count() * sizeof(File_system::Directory_entry);
 			s.mode = File_system::Status::MODE_DIRECTORY;
 			return s;
 		}
@@ -468,7 +468,6 @@ class Ram_fs::Session_component : public File_system::Session_rpc_object
 						throw Unavailable();
 
 					Node *node = from_dir->lookup(from_name.string());
-					node->name(to_name.string());
 
 					if (!(open_to_dir_node.node() == open_from_dir_node.node())) {
 
@@ -478,6 +477,7 @@ class Ram_fs::Session_component : public File_system::Session_rpc_object
 							throw Unavailable();
 
 						from_dir->discard(node);
+						node->name(to_name.string());
 						to_dir->adopt_unsynchronized(node);
 
 						/*
@@ -496,6 +496,12 @@ class Ram_fs::Session_component : public File_system::Session_rpc_object
 
 						node->mark_as_updated();
 						node->notify_listeners();
+					} else {
+
+						/* re-insert the node to keep the name index ordered */
+						from_dir->discard(node);
+						node->name(to_name.string());
+						from_dir->adopt_unsynchronized(node);
 					}
 				};
 
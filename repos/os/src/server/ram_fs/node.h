@@ -17,7 +17,7 @@
 /* Genode includes */
 #include <file_system/listener.h>
 #include <file_system/node.h>
-#include <util/list.h>
+#include <ram_fs/name_index.h>
 
 namespace Ram_fs {
 	using namespace Genode;
@@ -30,7 +30,7 @@ namespace Ram_fs {
 
 
 class Ram_fs::Node : public File_system::Node_base, public Weak_object<Node>,
-                     public List<Node>::Element
+                     public Avl_node<Node>
 {
 	public:
 
@@ -64,9 +64,17 @@ class Ram_fs::Node : public File_system::Node_base, public Weak_object<Node>,
 
 		/**
 		 * Assign name
+		 *
+		 * The node must not be part of a directory while being renamed
+		 * because directories index their entries by name.
 		 */
 		void name(char const *name) { strncpy(_name, name, sizeof(_name)); }
 
+		/**
+		 * Avl_node interface
+		 */
+		bool higher(Node *n) { return File_system::Name_index<Node>::ordered(this, n); }
+
 		virtual size_t read(char *dst, size_t len, seek_off_t) = 0;
 		virtual size_t write(char const *src, size_t len, seek_off_t) = 0;
 
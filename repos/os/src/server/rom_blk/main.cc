@@ -75,6 +75,9 @@ class Rom_blk : public Block::Driver
 
 			ack_packet(packet);
 		}
+
+		/* ROM dataspaces are read-only */
+		Dataspace_capability dataspace(bool) override { return _file_cap; }
 };
 
 
@@ -72,6 +72,9 @@ class Rom_filter::Input_rom_registry
 
 				Xml_node _top_level { "<empty/>" };
 
+				/* incremented on each change of the ROM content */
+				unsigned long _generation = 0;
+
 				void _handle_rom_changed()
 				{
 					_rom_ds.update();
@@ -79,6 +82,7 @@ class Rom_filter::Input_rom_registry
 						return;
 
 					_top_level = _rom_ds.xml();
+					_generation++;
 
 					/* trigger re-evaluation of the inputs */
 					_input_rom_changed_fn.input_rom_changed();
@@ -160,6 +164,8 @@ class Rom_filter::Input_rom_registry
 
 				Input_rom_name name() const { return _name; }
 
+				unsigned long generation() const { return _generation; }
+
 				/**
 				 * Query input value from ROM modules
 				 *
@@ -380,6 +386,19 @@ class Rom_filter::Input_rom_registry
 			return input_value;
 		}
 
+		/**
+		 * Return number of changes of the input with specified name
+		 *
+		 * The value allows for detecting changes of the content returned
+		 * by 'xml'.
+		 */
+		unsigned long generation(Input_name const &input_name) const
+		{
+			Entry const *e = _lookup_entry_by_name(input_name);
+
+			return e ? e->generation() : 0;
+		}
+
 		/**
 		 * Lookup content of input with specified name
 		 *
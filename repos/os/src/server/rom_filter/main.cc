@@ -169,6 +169,122 @@ struct Rom_filter::Main : Input_rom_registry::Input_rom_changed_fn,
 
 	size_t _xml_output_len = 0;
 
+	/* copy of the output as reported to the clients */
+	Genode::Constructible<Genode::Attached_ram_dataspace> _reported_ds;
+
+	size_t _reported_len = 0;
+
+	/**
+	 * Input accessed by the most recent evaluation
+	 *
+	 * As long as the inputs accessed by the evaluation remain unchanged,
+	 * the evaluation yields the same result, which spares the re-evaluation
+	 * on changes of input ROMs.
+	 */
+	struct Dependency
+	{
+		enum Type { VALUE, CONTENT };
+
+		Type          type       = VALUE;
+		Input_name    name       { };
+		bool          defined    = false;   /* VALUE */
+		Input_value   value      { };       /* VALUE */
+		unsigned long generation = 0;       /* CONTENT */
+	};
+
+	enum { MAX_DEPENDENCIES = 64 };
+
+	Dependency _dependencies[MAX_DEPENDENCIES];
+
+	unsigned _num_dependencies = 0;
+
+	/* false if the dependencies exceeded 'MAX_DEPENDENCIES' */
+	bool _dependencies_complete = false;
+
+	void _record_dependency(Dependency const &dependency)
+	{
+		for (unsigned i = 0; i < _num_dependencies; i++)
+			if (_dependencies[i].type == dependency.type
+			 && _dependencies[i].name == dependency.name)
+				return;
+
+		if (_num_dependencies == MAX_DEPENDENCIES) {
+			_dependencies_complete = false;
+			return;
+		}
+
+		_dependencies[_num_dependencies++] = dependency;
+	}
+
+	bool _dependency_changed(Dependency const &dependency) const
+	{
+		if (dependency.type == Dependency::CONTENT)
+			return _input_rom_registry.generation(dependency.name) != dependency.generation;
+
+		try {
+			Input_value const value =
+				_input_rom_registry.query_value(_config.xml(), dependency.name);
+
+			return !dependency.defined || value != dependency.value;
+		}
+		catch (Input_rom_registry::Nonexistent_input_value) {
+			return dependency.defined; }
+	}
+
+	bool _dependencies_changed() const
+	{
+		if (!_dependencies_complete)
+			return true;
+
+		for (unsigned i = 0; i < _num_dependencies; i++)
+			if (_dependency_changed(_dependencies[i]))
+				return true;
+
+		return false;
+	}
+
+	/**
+	 * Query input value and record the dependency on it
+	 *
+	 * \throw Input_rom_registry::Nonexistent_input_value
+	 */
+	Input_value _query_value(Input_name const &name)
+	{
+		Dependency dependency;
+		dependency.name = name;
+
+		try {
+			dependency.value   = _input_rom_registry.query_value(_config.xml(), name);
+			dependency.defined = true;
+			_record_dependency(dependency);
+			return dependency.value;
+		}
+		catch (Input_rom_registry::Nonexistent_input_value) {
+			_record_dependency(dependency);
+			throw;
+		}
+	}
+
+	/**
+	 * Return true if the output differs from the output reported last
+	 */
+	bool _output_changed()
+	{
+		char const * const output = _xml_ds->local_addr<char const>();
+
+		if (_reported_ds.constructed() && _reported_len == _xml_output_len
+		 && Genode::memcmp(_reported_ds->local_addr<char const>(), output,
+		                   _xml_output_len) == 0)
+			return false;
+
+		if (!_reported_ds.constructed() || _reported_ds->size() < _xml_output_len)
+			_reported_ds.construct(_env.ram(), _env.rm(), _xml_ds->size());
+
+		Genode::memcpy(_reported_ds->local_addr<char>(), output, _xml_output_len);
+		_reported_len = _xml_output_len;
+		return true;
+	}
+
 	void _evaluate_node(Xml_node node, Xml_generator &xml);
 	void _evaluate();
 
@@ -217,7 +333,8 @@ struct Rom_filter::Main : Input_rom_registry::Input_rom_changed_fn,
 	 */
 	void input_rom_changed() override
 	{
-		_evaluate();
+		if (_dependencies_changed())
+			_evaluate();
 	}
 
 	/**
@@ -266,8 +383,7 @@ void Rom_filter::Main::_evaluate_node(Xml_node node, Xml_generator &xml)
 					has_value_node.attribute_value("value", Input_value());
 
 				try {
-					Input_value const input_value =
-						_input_rom_registry.query_value(_config.xml(), input_name);
+					Input_value const input_value = _query_value(input_name);
 
 					if (input_value == expected_input_value)
 						condition_satisfied = true;
@@ -297,8 +413,7 @@ void Rom_filter::Main::_evaluate_node(Xml_node node, Xml_generator &xml)
 				Input_name const input_name =
 					node.attribute_value("input", Input_name());
 				try {
-					Input_value const input_value =
-						_input_rom_registry.query_value(_config.xml(), input_name);
+					Input_value const input_value = _query_value(input_name);
 
 					xml.attribute(node.attribute_value("name", String()).string(),
 					              input_value);
@@ -351,6 +466,12 @@ void Rom_filter::Main::_evaluate_node(Xml_node node, Xml_generator &xml)
 			if (!sub_node.valid())
 				return;
 
+			Dependency dependency;
+			dependency.type       = Dependency::CONTENT;
+			dependency.name       = input_name;
+			dependency.generation = _input_rom_registry.generation(input_name);
+			_record_dependency(dependency);
+
 			try {
 				Xml_node input_node = _input_rom_registry.xml(input_name);
 
@@ -366,6 +487,10 @@ void Rom_filter::Main::_evaluate_node(Xml_node node, Xml_generator &xml)
 
 void Rom_filter::Main::_evaluate()
 {
+	/* the dependencies are recorded by the evaluation */
+	_num_dependencies      = 0;
+	_dependencies_complete = true;
+
 	try {
 		Xml_node output = _config.xml().sub_node("output");
 
@@ -383,6 +508,8 @@ void Rom_filter::Main::_evaluate()
 		enum { UPGRADE = 4096, NUM_ATTEMPTS = ~0L };
 		Genode::retry<Xml_generator::Buffer_exceeded>(
 			[&] () {
+				_num_dependencies      = 0;
+				_dependencies_complete = true;
 				Xml_generator xml(_xml_ds->local_addr<char>(),
 				                  _xml_ds->size(), node_type.string(),
 				                  [&] () { _evaluate_node(output, xml); });
@@ -395,7 +522,9 @@ void Rom_filter::Main::_evaluate()
 
 	} catch (Xml_node::Nonexistent_sub_node) { }
 
-	_root.notify_clients();
+	/* spare the clients from re-obtaining an unchanged output */
+	if (_output_changed())
+		_root.notify_clients();
 }
 
 
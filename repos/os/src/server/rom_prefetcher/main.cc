@@ -17,10 +17,17 @@
 #include <base/log.h>
 #include <base/heap.h>
 #include <base/attached_rom_dataspace.h>
+#include <base/thread.h>
+#include <dataspace/client.h>
 #include <timer_session/connection.h>
 #include <base/session_label.h>
+#include <os/reporter.h>
+#include <util/list.h>
 
 namespace Rom_prefetcher {
+	class Module;
+	class Prefetch_queue;
+	class Worker;
 	class Rom_session_component;
 	class Rom_root;
 	struct Main;
@@ -45,6 +52,198 @@ static void prefetch_dataspace(Genode::Region_map &rm, Genode::Dataspace_capabil
 }
 
 
+/**
+ * ROM module configured for prefetching
+ */
+struct Rom_prefetcher::Module : Genode::List<Module>::Element
+{
+	typedef Genode::String<64> Name;
+
+	enum State { PENDING, FETCHING, DONE, FAILED };
+
+	Name const name;
+	long const priority;
+
+	State          state       = PENDING;
+	bool           requested   = false;  /* fetched on behalf of a client */
+	Genode::size_t size        = 0;
+	unsigned long  start_ms    = 0;
+	unsigned long  duration_ms = 0;
+
+	Module(Name const &name, long priority) : name(name), priority(priority) { }
+};
+
+
+/**
+ * Modules to prefetch, ordered by priority
+ */
+class Rom_prefetcher::Prefetch_queue
+{
+	private:
+
+		Genode::Lock         _lock;
+		Genode::List<Module> _modules;
+
+		unsigned _workers_active = 0;
+
+		Genode::Signal_context_capability const _finished_sigh;
+
+		Module *_lookup(Module::Name const &name)
+		{
+			for (Module *m = _modules.first(); m; m = m->next())
+				if (m->name == name)
+					return m;
+			return nullptr;
+		}
+
+	public:
+
+		Prefetch_queue(Genode::Signal_context_capability finished_sigh)
+		: _finished_sigh(finished_sigh) { }
+
+		/**
+		 * Insert module after all modules of equal or higher priority
+		 */
+		void insert(Module &module)
+		{
+			Genode::Lock::Guard guard(_lock);
+
+			Module *at = nullptr;
+			for (Module *m = _modules.first(); m && m->priority >= module.priority; m = m->next())
+				at = m;
+
+			_modules.insert(&module, at);
+		}
+
+		void worker_started()
+		{
+			Genode::Lock::Guard guard(_lock);
+			_workers_active++;
+		}
+
+		/**
+		 * Return next module to prefetch or nullptr if there is none
+		 *
+		 * Once no module is left, the calling worker is considered as
+		 * finished.
+		 */
+		Module *next(unsigned long now_ms)
+		{
+			Genode::Lock::Guard guard(_lock);
+
+			for (Module *m = _modules.first(); m; m = m->next()) {
+				if (m->state != Module::PENDING)
+					continue;
+
+				m->state    = Module::FETCHING;
+				m->start_ms = now_ms;
+				return m;
+			}
+
+			if (--_workers_active == 0)
+				Genode::Signal_transmitter(_finished_sigh).submit();
+
+			return nullptr;
+		}
+
+		void fetched(Module &module, bool success, Genode::size_t size,
+		             unsigned long now_ms)
+		{
+			Genode::Lock::Guard guard(_lock);
+
+			module.state       = success ? Module::DONE : Module::FAILED;
+			module.size        = size;
+			module.duration_ms = now_ms - module.start_ms;
+		}
+
+		/**
+		 * Return true if module was already prefetched completely
+		 */
+		bool prefetched(Module::Name const &name)
+		{
+			Genode::Lock::Guard guard(_lock);
+
+			Module const *m = _lookup(name);
+			return m && m->state == Module::DONE;
+		}
+
+		/**
+		 * Mark module as fetched on behalf of a client
+		 *
+		 * This way, the workers skip modules requested by a client before
+		 * the workers came to them.
+		 */
+		void claim(Module::Name const &name)
+		{
+			Genode::Lock::Guard guard(_lock);
+
+			Module *m = _lookup(name);
+			if (m && m->state == Module::PENDING) {
+				m->state     = Module::DONE;
+				m->requested = true;
+			}
+		}
+
+		template <typename FN>
+		void for_each_module(FN const &fn)
+		{
+			Genode::Lock::Guard guard(_lock);
+
+			for (Module const *m = _modules.first(); m; m = m->next())
+				fn(*m);
+		}
+};
+
+
+/**
+ * Thread that prefetches modules from the queue until the queue is empty
+ */
+class Rom_prefetcher::Worker : public Genode::Thread
+{
+	private:
+
+		enum { STACK_SIZE = 8*1024*sizeof(long) };
+
+		Genode::Env       &_env;
+		Prefetch_queue    &_queue;
+		Timer::Connection &_timer;
+
+	public:
+
+		Worker(Genode::Env &env, Prefetch_queue &queue, Timer::Connection &timer)
+		:
+			Genode::Thread(env, "prefetch", STACK_SIZE),
+			_env(env), _queue(queue), _timer(timer)
+		{
+			_queue.worker_started();
+			start();
+		}
+
+		void entry() override
+		{
+			while (Module *module = _queue.next(_timer.elapsed_ms())) {
+
+				bool           success = false;
+				Genode::size_t size    = 0;
+
+				try {
+					Genode::Rom_connection rom(_env, module->name.string());
+					Genode::log("prefetching ROM module ", module->name);
+					Genode::Dataspace_capability const ds = rom.dataspace();
+
+					prefetch_dataspace(_env.rm(), ds);
+					size    = Genode::Dataspace_client(ds).size();
+					success = true;
+				} catch (...) {
+					Genode::error("could not open ROM module ", module->name);
+				}
+
+				_queue.fetched(*module, success, size, _timer.elapsed_ms());
+			}
+		}
+};
+
+
 class Rom_prefetcher::Rom_session_component : public Genode::Rpc_object<Genode::Rom_session>
 {
 	private:
@@ -58,10 +257,16 @@ class Rom_prefetcher::Rom_session_component : public Genode::Rpc_object<Genode::
 		 *
 		 * \param  filename  name of the requested file
 		 */
-		Rom_session_component(Genode::Env &env, Genode::Session_label const &label)
+		Rom_session_component(Genode::Env &env, Genode::Session_label const &label,
+		                      Prefetch_queue &queue)
 		:
 			_rom(env, label.string())
 		{
+			/* skip modules whose pages were touched by a worker already */
+			if (queue.prefetched(label.string()))
+				return;
+
+			queue.claim(label.string());
 			prefetch_dataspace(env.rm(), _rom.dataspace());
 		}
 
@@ -80,7 +285,8 @@ class Rom_prefetcher::Rom_root : public Genode::Root_component<Rom_session_compo
 {
 	private:
 
-		Genode::Env &_env;
+		Genode::Env    &_env;
+		Prefetch_queue &_queue;
 
 		Rom_session_component *_create_session(const char *args)
 		{
@@ -88,15 +294,16 @@ class Rom_prefetcher::Rom_root : public Genode::Root_component<Rom_session_compo
 
 			/* create new session for the requested file */
 			return new (md_alloc())
-				Rom_session_component(_env, label.last_element());
+				Rom_session_component(_env, label.last_element(), _queue);
 		}
 
 	public:
 
-		Rom_root(Genode::Env &env, Genode::Allocator &md_alloc)
+		Rom_root(Genode::Env &env, Genode::Allocator &md_alloc,
+		         Prefetch_queue &queue)
 		:
 			Genode::Root_component<Rom_session_component>(env.ep(), md_alloc),
-			_env(env)
+			_env(env), _queue(queue)
 		{ }
 };
 
@@ -109,34 +316,90 @@ struct Rom_prefetcher::Main
 
 	Genode::Sliced_heap _sliced_heap { _env.ram(), _env.rm() };
 
-	Rom_root _root { _env, _sliced_heap };
+	Genode::Heap _heap { _env.ram(), _env.rm() };
+
+	Timer::Connection _timer { _env };
+
+	Genode::Signal_handler<Main> _finished_handler {
+		_env.ep(), *this, &Main::_handle_finished };
+
+	Prefetch_queue _queue { _finished_handler };
+
+	Rom_root _root { _env, _sliced_heap, _queue };
+
+	Genode::Constructible<Genode::Reporter> _reporter;
+
+	unsigned long const _start_ms = _timer.elapsed_ms();
+
+	void _handle_finished()
+	{
+		unsigned long const total_ms = _timer.elapsed_ms() - _start_ms;
+
+		Genode::log("prefetching finished after ", total_ms, " ms");
+
+		if (!_reporter.constructed())
+			return;
+
+		Genode::Reporter::Xml_generator xml(*_reporter, [&] () {
+			xml.attribute("total_ms", total_ms);
+
+			_queue.for_each_module([&] (Module const &module) {
+				xml.node("rom", [&] () {
+					xml.attribute("name",     module.name);
+					xml.attribute("priority", module.priority);
+
+					if (module.state == Module::FAILED) {
+						xml.attribute("failed", "yes");
+						return;
+					}
+
+					if (module.requested) {
+						xml.attribute("requested", "yes");
+						return;
+					}
+
+					xml.attribute("size",     module.size);
+					xml.attribute("start_ms", module.start_ms - _start_ms);
+					xml.attribute("ms",       module.duration_ms);
+				});
+			});
+		});
+	}
 
 	Main(Genode::Env &env) : _env(env)
 	{
-		Timer::Connection timer(_env);
+		Genode::Xml_node const config = _config.xml();
 
-		_config.xml().for_each_sub_node("rom", [&] (Genode::Xml_node entry) {
+		if (config.attribute_value("report", false)) {
+			_reporter.construct(_env, "prefetch");
+			_reporter->enabled(true);
+		}
 
-			typedef Genode::String<64> Name;
-			Name const name = entry.attribute_value("name", Name());
+		config.for_each_sub_node("rom", [&] (Genode::Xml_node entry) {
 
-			try {
-				Genode::Rom_connection rom(_env, name.string());
-				log("prefetching ROM module ", name);
-				prefetch_dataspace(_env.rm(), rom.dataspace());
-			} catch (...) {
-				error("could not open ROM module ", name);
-			}
+			Module::Name const name = entry.attribute_value("name", Module::Name());
+			long const priority = entry.attribute_value("priority", 0L);
 
-			/* yield */
-			timer.msleep(1);
+			_queue.insert(*new (_heap) Module(name, priority));
 		});
 
-		/* announce server */
+		/*
+		 * Announce the service before prefetching so that clients can start
+		 * using the modules that are already available.
+		 */
 		_env.parent().announce(_env.ep().manage(_root));
+
+		unsigned const workers = config.attribute_value("workers", 2U);
+
+		if (!workers) {
+			_handle_finished();
+			return;
+		}
+
+		for (unsigned i = 0; i < workers; i++)
+			new (_heap) Worker(_env, _queue, _timer);
 	}
 };
 
 
 void Component::construct(Genode::Env &env) { static Rom_prefetcher::Main main(env); }
-
@@ -19,6 +19,7 @@
 #include <base/log.h>
 #include <base/session_label.h>
 #include <root/component.h>
+#include <tar/member_dataspace.h>
 
 namespace Tar_rom {
 
@@ -36,138 +37,33 @@ class Tar_rom::Rom_session_component : public Rpc_object<Rom_session>
 {
 	private:
 
-		Ram_session &_ram;
-
-		char const * const _tar_addr;
-		size_t       const _tar_size;
-
-		Ram_dataspace_capability _file_ds;
-
-		enum {
-			/* length of on data block in tar */
-			_BLOCK_LEN = 512,
-
-			/* length of the header field "file-size" in tar */
-			_FIELD_SIZE_LEN = 124
-		};
-
-		/**
-		 * Copy file content into dataspace
-		 *
-		 * \param dst  destination dataspace
-		 */
-		void _copy_content_to_dataspace(Region_map &rm, Dataspace_capability dst,
-		                                char const *src, size_t len)
-		{
-			/* temporarily map dataspace */
-			Attached_dataspace ds(rm, dst);
-
-			/* copy content */
-			size_t bytes_to_copy = min(len, ds.size());
-			memcpy(ds.local_addr<char>(), src, bytes_to_copy);
-		}
-
-		/**
-		 * Initialize dataspace containing the content of the archived file
-		 */
-		Ram_dataspace_capability _init_file_ds(Ram_session &ram, Region_map &rm,
-		                                       Session_label const &name)
-		{
-			/* measure size of archive in blocks */
-			unsigned block_id = 0, block_cnt = _tar_size/_BLOCK_LEN;
-
-			char   const *file_content = nullptr;
-			unsigned long file_size    = 0;
-
-			/* scan metablocks of archive */
-			while (block_id < block_cnt) {
-
-				ascii_to_unsigned(_tar_addr + block_id*_BLOCK_LEN +
-				                  _FIELD_SIZE_LEN, file_size, 8);
-
-				/* get name of tar record */
-				char const *record_filename = _tar_addr + block_id*_BLOCK_LEN;
-
-				/* skip leading dot of path if present */
-				if (record_filename[0] == '.' && record_filename[1] == '/')
-					record_filename++;
-
-				/* get infos about current file */
-				if (name == record_filename) {
-					file_content = _tar_addr + (block_id+1) * _BLOCK_LEN;
-					break;
-				}
-
-				/* some datablocks */       /* one metablock */
-				block_id = block_id + (file_size / _BLOCK_LEN) + 1;
-
-				/* round up */
-				if (file_size % _BLOCK_LEN != 0) block_id++;
-
-				/* check for end of tar archive */
-				if (block_id*_BLOCK_LEN >= _tar_size)
-					break;
-
-				/* lookout for empty eof-blocks */
-				if (*(_tar_addr + (block_id*_BLOCK_LEN)) == 0x00)
-					if (*(_tar_addr + (block_id*_BLOCK_LEN + 1)) == 0x00)
-						break;
-			}
-
-			if (!file_content) {
-				error("couldn't find file '", name, "', empty result");
-				return Ram_dataspace_capability();
-			}
-
-			/* try to allocate memory for file */
-			Ram_dataspace_capability file_ds;
-			try {
-				file_ds = ram.alloc(file_size);
-
-				/* get content of file copied into dataspace and return */
-				_copy_content_to_dataspace(rm, file_ds, file_content, file_size);
-			} catch (...) {
-				error("couldn't allocate memory for file, empty result");
-				return file_ds;
-			}
-
-			return file_ds;
-		}
+		Tar::Member_dataspace _file_ds;
 
 	public:
 
 		/**
-		 * Constructor scans and seeks to file
-		 *
-		 * \param  tar_addr  local address to tar archive
-		 * \param  tar_size  size of tar archive in bytes
-		 * \param  label     name of the requested ROM module
+		 * Constructor
 		 *
-		 * \throw Service_denied
+		 * \param rm_session  RM session for mapping the file directly, or
+		 *                    nullptr
+		 * \param tar_ds      dataspace of the tar archive
+		 * \param index       index of the tar archive
+		 * \param header      record header of the requested file
 		 */
 		Rom_session_component(Ram_session &ram, Region_map &rm,
-		                      char const *tar_addr, unsigned tar_size,
-		                      Session_label const &label)
+		                      Rm_session *rm_session,
+		                      Dataspace_capability tar_ds,
+		                      Tar::Index const &index, char const *header)
 		:
-			_ram(ram), _tar_addr(tar_addr), _tar_size(tar_size),
-			_file_ds(_init_file_ds(ram, rm, label))
-		{
-			if (!_file_ds.valid())
-				throw Service_denied();
-		}
-
-		/**
-		 * Destructor
-		 */
-		~Rom_session_component() { _ram.free(_file_ds); }
+			_file_ds(ram, rm, rm_session, tar_ds, index, header)
+		{ }
 
 		/**
 		 * Return dataspace with content of file
 		 */
 		Rom_dataspace_capability dataspace()
 		{
-			Dataspace_capability ds = _file_ds;
-			return static_cap_cast<Rom_dataspace>(ds);
+			return static_cap_cast<Rom_dataspace>(_file_ds.cap());
 		}
 
 		void sigh(Signal_context_capability) { }
@@ -180,8 +76,25 @@ class Tar_rom::Rom_root : public Root_component<Rom_session_component>
 
 		Env &_env;
 
-		char const * const _tar_addr;
-		unsigned     const _tar_size;
+		Dataspace_capability const _tar_ds;
+
+		Tar::Index _index;
+
+		/*
+		 * RM session for mapping page-aligned files directly, constructed
+		 * on the first attempt
+		 */
+		Constructible<Rm_connection> _rm { };
+		bool                         _rm_denied = false;
+
+		Rm_session *_rm_session()
+		{
+			if (!_rm.constructed() && !_rm_denied) {
+				try { _rm.construct(_env); }
+				catch (...) { _rm_denied = true; }
+			}
+			return _rm.constructed() ? &*_rm : nullptr;
+		}
 
 		Rom_session_component *_create_session(const char *args)
 		{
@@ -189,10 +102,24 @@ class Tar_rom::Rom_root : public Root_component<Rom_session_component>
 			Session_label const module_name = label.last_element();
 			log("connection for module '", module_name, "' requested");
 
+			Tar::Index::Node const node = _index.lookup(module_name.string());
+			if (!node.header) {
+				error("couldn't find file '", module_name, "', empty result");
+				throw Service_denied();
+			}
+
 			/* create new session for the requested file */
-			return new (md_alloc()) Rom_session_component(_env.ram(), _env.rm(),
-			                                              _tar_addr, _tar_size,
-			                                              module_name.string());
+			try {
+				return new (md_alloc())
+					Rom_session_component(_env.ram(), _env.rm(), _rm_session(),
+					                      _tar_ds, _index, node.header);
+			}
+			catch (Out_of_ram)  { throw; }
+			catch (Out_of_caps) { throw; }
+			catch (...) {
+				error("couldn't allocate memory for file, empty result");
+				throw Service_denied();
+			}
 		}
 
 	public:
@@ -200,14 +127,16 @@ class Tar_rom::Rom_root : public Root_component<Rom_session_component>
 		/**
 		 * Constructor
 		 *
-		 * \param tar_base  local address of tar archive
+		 * \param tar_ds    dataspace of the tar archive
+		 * \param tar_addr  local address of tar archive
 		 * \param tar_size  size of tar archive in bytes
 		 */
-		Rom_root(Env &env, Allocator &md_alloc,
+		Rom_root(Env &env, Allocator &md_alloc, Allocator &index_alloc,
+		         Dataspace_capability tar_ds,
 		         char const *tar_addr, size_t tar_size)
 		:
 			Root_component<Rom_session_component>(env.ep(), md_alloc),
-			_env(env), _tar_addr(tar_addr), _tar_size(tar_size)
+			_env(env), _tar_ds(tar_ds), _index(index_alloc, tar_addr, tar_size)
 		{ }
 };
 
@@ -237,7 +166,8 @@ struct Tar_rom::Main
 
 	Sliced_heap _sliced_heap { _env.ram(), _env.rm() };
 
-	Rom_root _root { _env, _sliced_heap, _tar_ds.local_addr<char>(), _tar_ds.size() };
+	Rom_root _root { _env, _sliced_heap, _sliced_heap, _tar_ds.cap(),
+	                 _tar_ds.local_addr<char>(), _tar_ds.size() };
 
 	Main(Env &env) : _env(env)
 	{
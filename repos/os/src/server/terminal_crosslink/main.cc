@@ -14,6 +14,7 @@
 /* Genode includes */
 #include <base/component.h>
 #include <base/heap.h>
+#include <base/attached_rom_dataspace.h>
 
 /* local includes */
 #include "terminal_root.h"
@@ -30,7 +31,18 @@ struct Terminal_crosslink::Main
 	Env  &_env;
 	Heap  _heap { _env.ram(), _env.rm() };
 
-	Root  _terminal_root { _env, _heap };
+	Attached_rom_dataspace _config { _env, "config" };
+
+	size_t _config_value(char const *attr, size_t default_value) {
+		return _config.xml().attribute_value(attr, default_value); }
+
+	size_t const _buffer_size =
+		max(_config_value("buffer_size", BUFFER_SIZE), (size_t)1);
+
+	Root _terminal_root { _env, _heap, _buffer_size,
+	                      _config_value("write_watermark", _buffer_size/2),
+	                      max(_config_value("max_io_buffer_size", 64*1024),
+	                          (size_t)BUFFER_SIZE) };
 
 	Main(Env &env) : _env(env)
 	{
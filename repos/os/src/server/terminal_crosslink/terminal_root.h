@@ -16,6 +16,7 @@
 
 /* Genode includes */
 #include <root/component.h>
+#include <util/arg_string.h>
 
 /* local includes */
 #include "terminal_session_component.h"
@@ -31,6 +32,8 @@ namespace Terminal_crosslink {
 
 			Session_component _session_component1, _session_component2;
 
+			size_t const _max_io_buffer_size;
+
 			enum Session_state {
 				FIRST_SESSION_OPEN  = 1 << 0,
 				SECOND_SESSION_OPEN = 1 << 1
@@ -38,17 +41,48 @@ namespace Terminal_crosslink {
 
 			int _session_state;
 
+			/**
+			 * Set up I/O buffer as requested by the session arguments
+			 */
+			Session_capability _open(Session_component &session,
+			                         Root::Session_args const &args)
+			{
+				char const *argbuf = args.string();
+
+				size_t const ram_quota =
+					Arg_string::find_arg(argbuf, "ram_quota").ulong_value(0);
+
+				size_t size =
+					Arg_string::find_arg(argbuf, "io_buffer_size").ulong_value(0);
+
+				if (!size)
+					size = BUFFER_SIZE;
+
+				/* the client pays for the I/O buffer of its choice */
+				if (size > BUFFER_SIZE && size > ram_quota)
+					throw Insufficient_ram_quota();
+
+				size = min(size, _max_io_buffer_size);
+
+				try { session.io_buffer_size(size); }
+				catch (Out_of_ram) { throw Insufficient_ram_quota(); }
+
+				return session.cap();
+			}
+
 		public:
 
 			Session_capability session(Root::Session_args const &args,
 			                           Genode::Affinity   const &)
 			{
 				if (!(_session_state & FIRST_SESSION_OPEN)) {
+					Session_capability cap = _open(_session_component1, args);
 					_session_state |= FIRST_SESSION_OPEN;
-					return _session_component1.cap();
+					return cap;
 				} else if (!(_session_state & SECOND_SESSION_OPEN)) {
+					Session_capability cap = _open(_session_component2, args);
 					_session_state |= SECOND_SESSION_OPEN;
-					return _session_component2.cap();
+					return cap;
 				}
 
 				return Session_capability();
@@ -66,11 +100,23 @@ namespace Terminal_crosslink {
 
 			/**
 			 * Constructor
+			 *
+			 * \param buffer_size         capacity of the buffer per
+			 *                            direction
+			 * \param write_watermark     fill level at which a writer,
+			 *                            paused by a full buffer, may
+			 *                            continue
+			 * \param max_io_buffer_size  limit of the I/O buffer size
+			 *                            requested by clients
 			 */
-			Root(Env &env, Allocator &alloc)
+			Root(Env &env, Allocator &alloc, size_t buffer_size,
+			     size_t write_watermark, size_t max_io_buffer_size)
 			: Root_component(&env.ep().rpc_ep(), &alloc),
-			  _session_component1(env, _session_component2),
-			  _session_component2(env, _session_component1),
+			  _session_component1(env, alloc, _session_component2,
+			                      buffer_size, write_watermark),
+			  _session_component2(env, alloc, _session_component1,
+			                      buffer_size, write_watermark),
+			  _max_io_buffer_size(max_io_buffer_size),
 			  _session_state(0)
 			{ }
 	};
@@ -25,13 +25,26 @@
 using namespace Genode;
 
 Terminal_crosslink::Session_component::Session_component(Env &env,
-                                                         Session_component &partner)
+                                                         Allocator &alloc,
+                                                         Session_component &partner,
+                                                         size_t buffer_size,
+                                                         size_t write_watermark)
 : _env(env),
   _partner(partner),
   _session_cap(_env.ep().rpc_ep().manage(this)),
-  _io_buffer(env.ram(), env.rm(), BUFFER_SIZE),
-  _cross_num_bytes_avail(0)
+  _buffer(alloc, buffer_size),
+  _write_watermark(min(write_watermark, buffer_size - 1))
 {
+	io_buffer_size(BUFFER_SIZE);
+}
+
+
+void Terminal_crosslink::Session_component::io_buffer_size(size_t size)
+{
+	if (_io_buffer.constructed() && _io_buffer->size() == size)
+		return;
+
+	_io_buffer.construct(_env.ram(), _env.rm(), size);
 }
 
 
@@ -50,27 +63,27 @@ bool Terminal_crosslink::Session_component::belongs_to(Session_capability cap)
 
 bool Terminal_crosslink::Session_component::cross_avail()
 {
-	return (_cross_num_bytes_avail > 0);
+	return _buffer.used() > 0;
 }
 
 
 size_t Terminal_crosslink::Session_component::cross_read(unsigned char *buf,
                                                          size_t dst_len)
 {
-	size_t num_bytes_read;
-
-	for (num_bytes_read = 0;
-	     (num_bytes_read < dst_len) && !_buffer.empty();
-	     num_bytes_read++)
-		buf[num_bytes_read] = _buffer.get();
+	size_t const num_bytes_read = _buffer.read(buf, dst_len);
 
-	_cross_num_bytes_avail -= num_bytes_read;
+	if (_write_paused && _buffer.used() <= _write_watermark)
+		_write_paused = false;
 
 	return num_bytes_read;
 }
 
 void Terminal_crosslink::Session_component::cross_write()
 {
+	if (_read_signal_pending)
+		return;
+
+	_read_signal_pending = true;
 	Signal_transmitter(_read_avail_sigh).submit();
 }
 
@@ -87,32 +100,41 @@ bool Terminal_crosslink::Session_component::avail()
 
 size_t Terminal_crosslink::Session_component::_read(size_t dst_len)
 {
-	return _partner.cross_read(_io_buffer.local_addr<unsigned char>(), dst_len);
+	_read_signal_pending = false;
+
+	size_t const num_bytes_read =
+		_partner.cross_read(_io_buffer->local_addr<unsigned char>(),
+		                    min(dst_len, _io_buffer->size()));
+
+	/* keep the client informed about data it has not picked up yet */
+	if (_partner.cross_avail())
+		cross_write();
+
+	return num_bytes_read;
 }
 
 
 size_t Terminal_crosslink::Session_component::_write(size_t num_bytes)
 {
-	unsigned char *src = _io_buffer.local_addr<unsigned char>();
+	if (_write_paused)
+		return 0;
+
+	size_t const num_bytes_written =
+		_buffer.write(_io_buffer->local_addr<unsigned char>(),
+		              min(num_bytes, _io_buffer->size()));
 
-	size_t num_bytes_written = 0;
-	while (num_bytes_written < num_bytes)
-		try {
-			_buffer.add(src[num_bytes_written]);
-			++num_bytes_written;
-		} catch(Local_buffer::Overflow) {
-			break;
-		}
+	if (_buffer.full())
+		_write_paused = true;
 
-	_cross_num_bytes_avail += num_bytes_written;
-	_partner.cross_write();
+	if (num_bytes_written)
+		_partner.cross_write();
 
 	return num_bytes_written;
 }
 
 
 Dataspace_capability Terminal_crosslink::Session_component::_dataspace()
-{ return _io_buffer.cap(); }
+{ return _io_buffer->cap(); }
 
 
 void Terminal_crosslink::Session_component::connected_sigh(Signal_context_capability sigh)
@@ -17,7 +17,7 @@
 /* Genode includes */
 #include <base/rpc_server.h>
 #include <base/attached_ram_dataspace.h>
-#include <os/ring_buffer.h>
+#include <util/reconstructible.h>
 #include <terminal_session/terminal_session.h>
 
 namespace Terminal_crosslink {
@@ -27,65 +27,153 @@ namespace Terminal_crosslink {
 	enum { STACK_SIZE = sizeof(addr_t)*1024 };
 	enum { BUFFER_SIZE = 4096 };
 
-	class Session_component : public Rpc_object<Terminal::Session,
-	                                            Session_component>
-	{
-		private:
+	class Ring;
+	class Session_component;
+}
+
 
-			Env                        &_env;
+/**
+ * Byte ring buffer copying data in at most two contiguous pieces
+ */
+class Terminal_crosslink::Ring
+{
+	private:
+
+		Allocator     &_alloc;
+		size_t   const _capacity;
+		unsigned char *_data;
+
+		size_t _head = 0; /* position of next write */
+		size_t _tail = 0; /* position of next read */
+		size_t _used = 0;
+
+	public:
+
+		Ring(Allocator &alloc, size_t capacity)
+		:
+			_alloc(alloc), _capacity(capacity),
+			_data((unsigned char *)alloc.alloc(capacity))
+		{ }
+
+		~Ring() { _alloc.free(_data, _capacity); }
+
+		size_t capacity() const { return _capacity; }
+		size_t used()     const { return _used; }
+		bool   full()     const { return _used == _capacity; }
+
+		size_t write(unsigned char const *src, size_t len)
+		{
+			len = min(len, _capacity - _used);
 
-			Session_component          &_partner;
-			Genode::Session_capability  _session_cap;
+			size_t const first = min(len, _capacity - _head);
+			memcpy(_data + _head, src, first);
+			memcpy(_data, src + first, len - first);
 
-			Attached_ram_dataspace      _io_buffer;
+			_head  = (_head + len) % _capacity;
+			_used += len;
+			return len;
+		}
 
-			typedef Genode::Ring_buffer<unsigned char, BUFFER_SIZE+1> Local_buffer;
+		size_t read(unsigned char *dst, size_t len)
+		{
+			len = min(len, _used);
 
-			Local_buffer                _buffer;
-			size_t                      _cross_num_bytes_avail;
-			Signal_context_capability   _read_avail_sigh;
+			size_t const first = min(len, _capacity - _tail);
+			memcpy(dst, _data + _tail, first);
+			memcpy(dst + first, _data, len - first);
 
-		public:
+			_tail  = (_tail + len) % _capacity;
+			_used -= len;
+			return len;
+		}
+};
 
-			/**
-			 * Constructor
-			 */
-			Session_component(Env &env, Session_component &partner);
 
-			Session_capability cap();
+class Terminal_crosslink::Session_component : public Rpc_object<Terminal::Session,
+                                                                 Session_component>
+{
+	private:
 
-			/**
-			 * Return true if capability belongs to session object
-			 */
-            bool belongs_to(Genode::Session_capability cap);
+		Env                        &_env;
 
-			/* to be called by the partner component */
-			bool cross_avail();
-			size_t cross_read(unsigned char *buf, size_t dst_len);
-			void cross_write();
+		Session_component          &_partner;
+		Genode::Session_capability  _session_cap;
 
-			/********************************
-			 ** Terminal session interface **
-			 ********************************/
+		Constructible<Attached_ram_dataspace> _io_buffer;
 
-			Size size();
+		/*
+		 * Data written by the client, to be read by the partner
+		 */
+		Ring         _buffer;
+		size_t const _write_watermark;
 
-			bool avail();
+		/*
+		 * Once the buffer became full, writing is paused until the
+		 * partner drained the buffer down to the write watermark. So the
+		 * client transfers data in large batches instead of trickling
+		 * in single bytes as soon as some space becomes available.
+		 */
+		bool _write_paused = false;
 
-			Genode::size_t _read(Genode::size_t dst_len);
+		/*
+		 * A read-avail signal is submitted only if the client has read
+		 * since the last signal. So, the client gets woken up once per
+		 * batch of data, regardless of the number of partner writes.
+		 */
+		bool _read_signal_pending = false;
 
-			Genode::size_t _write(Genode::size_t num_bytes);
+		Signal_context_capability _read_avail_sigh;
 
-			Genode::Dataspace_capability _dataspace();
+	public:
 
-			void connected_sigh(Genode::Signal_context_capability sigh);
+		/**
+		 * Constructor
+		 *
+		 * \param buffer_size      capacity of the buffer for data
+		 *                         written by the client
+		 * \param write_watermark  fill level at which a paused writer
+		 *                         may continue
+		 */
+		Session_component(Env &env, Allocator &alloc, Session_component &partner,
+		                  size_t buffer_size, size_t write_watermark);
 
-			void read_avail_sigh(Genode::Signal_context_capability sigh);
+		Session_capability cap();
 
-			Genode::size_t read(void *, Genode::size_t);
-			Genode::size_t write(void const *, Genode::size_t);
-	};
+		/**
+		 * Return true if capability belongs to session object
+		 */
+		bool belongs_to(Genode::Session_capability cap);
 
-}
+		/**
+		 * Replace I/O buffer shared with the client
+		 */
+		void io_buffer_size(size_t size);
+
+		/* to be called by the partner component */
+		bool cross_avail();
+		size_t cross_read(unsigned char *buf, size_t dst_len);
+		void cross_write();
+
+		/********************************
+		 ** Terminal session interface **
+		 ********************************/
+
+		Size size();
+
+		bool avail();
+
+		Genode::size_t _read(Genode::size_t dst_len);
+
+		Genode::size_t _write(Genode::size_t num_bytes);
+
+		Genode::Dataspace_capability _dataspace();
+
+		void connected_sigh(Genode::Signal_context_capability sigh);
+
+		void read_avail_sigh(Genode::Signal_context_capability sigh);
+
+		Genode::size_t read(void *, Genode::size_t);
+		Genode::size_t write(void const *, Genode::size_t);
+};
 
 #endif /* _TERMINAL_SESSION_COMPONENT_H_ */
@@ -178,38 +178,54 @@ class Trace_fs::Trace_file_system
 		};
 
 
+		/**
+		 * Header of an events file in the binary format
+		 */
+		struct Stream_header
+		{
+			enum { MAGIC = 0xc1fc1fc1, VERSION = 1 };
+
+			Genode::uint32_t magic;
+			Genode::uint32_t version;
+			Genode::uint32_t subject_id;
+
+		} __attribute__((packed));
+
 		/**
 		 * This class implements the Process_entry functor class
 		 *
 		 * It is needed by the Trace_buffer_manager to process a entry
-		 * from the Trace::Buffer.
+		 * from the Trace::Buffer. The processed entries are collected
+		 * to be appended to the events file in one go.
+		 *
+		 * In the text format, each entry is terminated by a newline. In
+		 * the binary format, each entry is preceded by its 32-bit length.
 		 */
 		template <size_t CAPACITY>
-		class Process_entry : public Followed_subject::Trace_buffer_manager::Process_entry
+		class Export_chunk : public Followed_subject::Trace_buffer_manager::Process_entry
 		{
+			public:
+
+				enum { MAX_ENTRY_LEN = 512 };
+
 			private:
 
-				char   _buf[CAPACITY];
-				size_t _length;
+				char       _buf[CAPACITY];
+				size_t     _length = 0;
+				bool const _binary;
 
+				static_assert(CAPACITY >= sizeof(Genode::uint32_t) + MAX_ENTRY_LEN,
+				              "chunk too small for an entry");
 
 			public:
 
-				Process_entry() : _length(0) { _buf[0] = 0; }
-
-				/**
-				 * Return capacity of the internal buffer
-				 *
-				 * \return capacity of the buffer in bytes
-				 */
-				size_t capacity() const { return CAPACITY; }
+				Export_chunk(bool binary) : _binary(binary) { }
 
 				/**
-				 * Return data of the processed Trace::Buffer::Entry
-				 *
-				 * \return pointer to data
+				 * Return true if the chunk may not hold another entry
 				 */
-				char const *data() const { return _buf; }
+				bool full() const {
+					return _length + sizeof(Genode::uint32_t) + MAX_ENTRY_LEN > CAPACITY; }
 
 				/**
 				 * Functor for processing a Trace:Buffer::Entry
@@ -220,16 +236,49 @@ class Trace_fs::Trace_file_system
 				 */
 				Genode::size_t operator()(Genode::Trace::Buffer::Entry &entry)
 				{
-					Genode::size_t len = Genode::min(entry.length() + 1, CAPACITY);
-					Genode::memcpy(_buf, entry.data(), len);
-					_buf[len - 1] = '\n';
+					using Genode::min;
+					using Genode::memcpy;
+
+					char *dst = _buf + _length;
+
+					if (_binary) {
+						if (entry.length() == 0)
+							return 0;
 
-					_length = len;
+						Genode::uint32_t const len =
+							min(entry.length(), (size_t)MAX_ENTRY_LEN);
+						memcpy(dst, &len, sizeof(len));
+						memcpy(dst + sizeof(len), entry.data(), len);
 
+						_length += sizeof(len) + len;
+						return sizeof(len) + len;
+					}
+
+					Genode::size_t const len =
+						min(entry.length() + 1, (size_t)MAX_ENTRY_LEN);
+					memcpy(dst, entry.data(), len);
+					dst[len - 1] = '\n';
+
+					_length += len;
 					return len;
 				}
+
+				/**
+				 * Append collected entries to events file
+				 */
+				void flush(Events_file &file)
+				{
+					if (!_length)
+						return;
+
+					try { file.append(_buf, _length); }
+					catch (...) { Genode::error("could not write entries"); }
+
+					_length = 0;
+				}
 		};
 
+		enum { EXPORT_CHUNK_SIZE = 16*1024 };
 
 		Genode::Region_map        &_rm;
 		Genode::Allocator         &_alloc;
@@ -239,6 +288,10 @@ class Trace_fs::Trace_file_system
 		size_t                     _buffer_size;
 		size_t                     _buffer_size_max;
 
+		bool const                 _binary;
+
+		Export_chunk<EXPORT_CHUNK_SIZE> _chunk { _binary };
+
 		Followed_subject_registry  _followed_subject_registry;
 
 
@@ -263,17 +316,23 @@ class Trace_fs::Trace_file_system
 			if (!manager)
 				return;
 
-			Process_entry<512> process_entry;
+			Events_file &file = subject->events_file;
 
-			while (!manager->last_entry()) {
-				size_t len = manager->dump_entry(process_entry);
+			if (_binary && file.length() == 0) {
+				Stream_header const header { Stream_header::MAGIC,
+				                             Stream_header::VERSION,
+				                             subject->id().id };
+				try { file.append((char const *)&header, sizeof(header)); }
+				catch (...) { Genode::error("could not write stream header"); }
+			}
 
-				if (len == 0)
-					continue;
+			while (!manager->last_entry()) {
+				if (_chunk.full())
+					_chunk.flush(file);
 
-				try { subject->events_file.append(process_entry.data(), len); }
-				catch (...) { Genode::error("could not write entry"); }
+				manager->dump_entry(_chunk);
 			}
+			_chunk.flush(file);
 
 			if (manager->last_entry()) {
 				manager->rewind();
@@ -395,10 +454,12 @@ class Trace_fs::Trace_file_system
 		                  Trace              &trace,
 		                  Directory          &root_dir,
 		                  size_t              buffer_size,
-		                  size_t              buffer_size_max)
+		                  size_t              buffer_size_max,
+		                  bool                binary)
 		:
 			_rm(rm), _alloc(alloc), _trace(trace), _root_dir(root_dir),
 			_buffer_size(buffer_size), _buffer_size_max(buffer_size_max),
+			_binary(binary),
 			_followed_subject_registry(_alloc)
 		{ }
 
@@ -783,7 +844,8 @@ class Trace_fs::Session_component : public Session_rpc_object
 		                  size_t               trace_meta_quota,
 		                  size_t               trace_parent_levels,
 		                  size_t               buffer_size,
-		                  size_t               buffer_size_max)
+		                  size_t               buffer_size_max,
+		                  bool                 binary)
 		:
 			Session_rpc_object(ram.alloc(tx_buf_size), rm, ep.rpc_ep()),
 			_ep(ep),
@@ -794,7 +856,7 @@ class Trace_fs::Session_component : public Session_rpc_object
 			_poll_interval(poll_interval),
 			_fs_update_timer(env),
 			_trace(new (&_md_alloc) Genode::Trace::Connection(env, trace_quota, trace_meta_quota, trace_parent_levels)),
-			_trace_fs(new (&_md_alloc) Trace_file_system(rm, _md_alloc, *_trace, _root_dir, buffer_size, buffer_size_max)),
+			_trace_fs(new (&_md_alloc) Trace_file_system(rm, _md_alloc, *_trace, _root_dir, buffer_size, buffer_size_max, binary)),
 			_process_packet_dispatcher(_ep, *this, &Session_component::_process_packets),
 			_fs_update_dispatcher(_ep, *this, &Session_component::_fs_update)
 		{
@@ -1022,6 +1084,7 @@ class Trace_fs::Root : public Root_component<Session_component>
 			Genode::Number_of_bytes buffer_size      =  32 * (1 << 10); /*  32 KiB */
 			Genode::Number_of_bytes buffer_size_max  =   1 * (1 << 20); /*   1 MiB */
 			unsigned trace_parent_levels             = 0;
+			bool binary                              = false;
 
 			Session_label const label = label_from_args(args);
 			try {
@@ -1046,6 +1109,9 @@ class Trace_fs::Root : public Root_component<Session_component>
 				try { policy.attribute("buffer_size_max").value(&buffer_size_max); }
 				catch (...) { }
 
+				binary = policy.attribute_value("format", Genode::String<8>("text"))
+				         == "binary";
+
 				/*
 				 * Determine directory that is used as root directory of
 				 * the session.
@@ -1101,7 +1167,7 @@ class Trace_fs::Root : public Root_component<Session_component>
 				                  *md_alloc(), subject_limit, interval,
 				                  trace_quota, trace_meta_quota,
 				                  trace_parent_levels, buffer_size,
-				                  buffer_size_max);
+				                  buffer_size_max, binary);
 		}
 
 	public:
@@ -0,0 +1,524 @@
+/*
+ * \brief  Aggregation of system-wide trace data into folded stacks
+ * \author Genode Labs
+ * \date   2026-10-14
+ *
+ * The component periodically obtains the execution times of all trace
+ * subjects and accepts the instruction-pointer samples of the 'cpu_sampler'
+ * via LOG sessions. Both are written as folded stacks to a file system, one
+ * line per stack consisting of the semicolon-separated frames followed by a
+ * count. The files can be fed directly into flame-graph tools.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/component.h>
+#include <base/allocator_avl.h>
+#include <base/attached_rom_dataspace.h>
+#include <base/heap.h>
+#include <base/rpc_server.h>
+#include <file_system/util.h>
+#include <file_system_session/connection.h>
+#include <log_session/log_session.h>
+#include <os/session_policy.h>
+#include <root/component.h>
+#include <timer_session/connection.h>
+#include <trace_session/connection.h>
+#include <util/avl_tree.h>
+#include <util/list.h>
+
+namespace Trace_profiler {
+
+	using namespace Genode;
+
+	typedef String<160> Frames;
+
+	Frames frames_from_label(char const *label);
+
+	class Thread_times;
+	class Histogram;
+	class Histograms;
+	class Folded_file;
+	class Log_session_component;
+	class Log_root;
+	struct Main;
+}
+
+
+/**
+ * Convert session label into folded-stack frames
+ *
+ * Each element of the label becomes a frame, e.g., "init -> app -> ep"
+ * becomes "init;app;ep".
+ */
+Trace_profiler::Frames Trace_profiler::frames_from_label(char const *label)
+{
+	char buf[Frames::capacity()];
+	size_t len = 0;
+
+	for (char const *s = label; *s && len + 1 < sizeof(buf); ) {
+
+		if (!strcmp(s, " -> ", 4)) {
+			buf[len++] = ';';
+			s += 4;
+			continue;
+		}
+
+		/* semicolons separate frames */
+		buf[len++] = (*s == ';') ? '_' : *s;
+		s++;
+	}
+	buf[len] = 0;
+
+	return Frames(Cstring(buf));
+}
+
+
+/**
+ * Folded file written from scratch at each period
+ */
+class Trace_profiler::Folded_file
+{
+	private:
+
+		enum { BUF_SIZE = 4096 };
+
+		File_system::Session           &_fs;
+		File_system::File_handle const  _handle;
+
+		char                   _buf[BUF_SIZE];
+		size_t                 _len  = 0;
+		File_system::seek_off_t _seek = 0;
+
+		static File_system::File_handle _open(File_system::Session &fs,
+		                                      File_system::Dir_handle dir,
+		                                      char const *name)
+		{
+			using namespace File_system;
+
+			try { return fs.file(dir, name, WRITE_ONLY, true); }
+			catch (Node_already_exists) { }
+
+			File_handle file = fs.file(dir, name, WRITE_ONLY, false);
+			fs.truncate(file, 0);
+			return file;
+		}
+
+		void _flush()
+		{
+			if (!_len)
+				return;
+
+			size_t const written = File_system::write(_fs, _handle, _buf, _len, _seek);
+			if (written < _len)
+				error("writing folded stacks failed");
+
+			_seek += written;
+			_len   = 0;
+		}
+
+	public:
+
+		Folded_file(File_system::Session &fs, File_system::Dir_handle dir,
+		            char const *name)
+		: _fs(fs), _handle(_open(fs, dir, name)) { }
+
+		~Folded_file()
+		{
+			_flush();
+			_fs.close(_handle);
+		}
+
+		template <typename... ARGS>
+		void line(ARGS &&... args)
+		{
+			String<256> const line(args..., "\n");
+
+			if (_len + line.length() > BUF_SIZE)
+				_flush();
+
+			/* omit the string terminator */
+			memcpy(_buf + _len, line.string(), line.length() - 1);
+			_len += line.length() - 1;
+		}
+};
+
+
+/**
+ * Execution times of all trace subjects
+ *
+ * Each entry keeps its last known execution time after its subject died.
+ */
+class Trace_profiler::Thread_times
+{
+	private:
+
+		struct Entry : List<Entry>::Element
+		{
+			Trace::Subject_id const id;
+			Frames            const frames;
+
+			unsigned long long execution_time = 0;
+
+			bool alive = true;
+
+			Entry(Trace::Subject_id id, Frames const &frames)
+			: id(id), frames(frames) { }
+		};
+
+		Allocator   &_alloc;
+		List<Entry>  _entries;
+
+		enum { MAX_SUBJECTS = 512 };
+		Trace::Subject_id _subjects[MAX_SUBJECTS];
+
+		Entry *_lookup(Trace::Subject_id const id)
+		{
+			for (Entry *e = _entries.first(); e; e = e->next())
+				if (e->alive && e->id == id)
+					return e;
+
+			return nullptr;
+		}
+
+	public:
+
+		Thread_times(Allocator &alloc) : _alloc(alloc) { }
+
+		~Thread_times()
+		{
+			while (Entry *e = _entries.first()) {
+				_entries.remove(e);
+				destroy(_alloc, e);
+			}
+		}
+
+		void update(Trace::Connection &trace)
+		{
+			unsigned const num_subjects = trace.subjects(_subjects, MAX_SUBJECTS);
+
+			for (unsigned i = 0; i < num_subjects; i++) {
+
+				Trace::Subject_id   const id   = _subjects[i];
+				Trace::Subject_info const info = trace.subject_info(id);
+
+				Entry *e = _lookup(id);
+				if (!e) {
+					String<Session_label::capacity() + 64> const label(
+						info.session_label(), " -> ", info.thread_name());
+
+					e = new (_alloc) Entry(id, frames_from_label(label.string()));
+					_entries.insert(e);
+				}
+
+				e->execution_time = info.execution_time().value;
+
+				if (info.state() == Trace::Subject_info::DEAD) {
+					trace.free(id);
+					e->alive = false;
+				}
+			}
+		}
+
+		void write(Folded_file &file) const
+		{
+			for (Entry const *e = _entries.first(); e; e = e->next())
+				if (e->execution_time)
+					file.line(e->frames, " ", e->execution_time);
+		}
+};
+
+
+/**
+ * Instruction-pointer samples of one thread
+ */
+class Trace_profiler::Histogram : public List<Histogram>::Element
+{
+	private:
+
+		struct Bucket : Avl_node<Bucket>
+		{
+			addr_t const  ip;
+			unsigned long count = 0;
+
+			Bucket(addr_t ip) : ip(ip) { }
+
+			bool higher(Bucket *other) const { return other->ip > ip; }
+
+			Bucket *find(addr_t addr)
+			{
+				if (addr == ip) return this;
+
+				Bucket *b = child(addr > ip);
+				return b ? b->find(addr) : nullptr;
+			}
+		};
+
+		Allocator    &_alloc;
+		Avl_tree<Bucket> _buckets;
+
+	public:
+
+		Frames const frames;
+
+		Histogram(Allocator &alloc, Frames const &frames)
+		: _alloc(alloc), frames(frames) { }
+
+		~Histogram()
+		{
+			while (Bucket *b = _buckets.first()) {
+				_buckets.remove(b);
+				destroy(_alloc, b);
+			}
+		}
+
+		/**
+		 * Count sample
+		 *
+		 * \param may_grow  true if a new address may be stored
+		 * \param grown     set to true if a new address got stored
+		 *
+		 * \return false if the sample could not be stored
+		 */
+		bool count(addr_t ip, bool may_grow, bool &grown)
+		{
+			Bucket *b = _buckets.first() ? _buckets.first()->find(ip) : nullptr;
+			if (!b) {
+				if (!may_grow)
+					return false;
+
+				b = new (_alloc) Bucket(ip);
+				_buckets.insert(b);
+				grown = true;
+			}
+
+			b->count++;
+			return true;
+		}
+
+		void write(Folded_file &file) const
+		{
+			if (!_buckets.first())
+				return;
+
+			_buckets.first()->for_each([&] (Bucket const &b) {
+				file.line(frames, ";", Hex(b.ip), " ", b.count); });
+		}
+};
+
+
+/**
+ * Histograms of all sampled threads, surviving their LOG sessions
+ */
+class Trace_profiler::Histograms
+{
+	private:
+
+		Allocator       &_alloc;
+		List<Histogram>  _histograms;
+
+		size_t const _max_addresses;
+		size_t       _addresses = 0;
+		unsigned long _dropped  = 0;
+
+	public:
+
+		Histograms(Allocator &alloc, size_t max_addresses)
+		: _alloc(alloc), _max_addresses(max_addresses) { }
+
+		~Histograms()
+		{
+			while (Histogram *h = _histograms.first()) {
+				_histograms.remove(h);
+				destroy(_alloc, h);
+			}
+		}
+
+		Histogram &histogram(Frames const &frames)
+		{
+			for (Histogram *h = _histograms.first(); h; h = h->next())
+				if (h->frames == frames)
+					return *h;
+
+			Histogram *h = new (_alloc) Histogram(_alloc, frames);
+			_histograms.insert(h);
+			return *h;
+		}
+
+		void count(Histogram &histogram, addr_t ip)
+		{
+			bool grown = false;
+
+			if (!histogram.count(ip, _addresses < _max_addresses, grown)) {
+				_dropped++;
+				return;
+			}
+
+			if (grown)
+				_addresses++;
+		}
+
+		unsigned long dropped() const { return _dropped; }
+
+		void write(Folded_file &file) const
+		{
+			for (Histogram const *h = _histograms.first(); h; h = h->next())
+				h->write(file);
+		}
+};
+
+
+/**
+ * LOG session used by the 'cpu_sampler' to deliver the samples of a thread
+ */
+class Trace_profiler::Log_session_component : public Rpc_object<Log_session>
+{
+	private:
+
+		Histograms &_histograms;
+		Histogram  &_histogram;
+
+	public:
+
+		Log_session_component(Histograms &histograms, Frames const &frames)
+		:
+			_histograms(histograms), _histogram(histograms.histogram(frames))
+		{ }
+
+		size_t write(String const &msg) override
+		{
+			char const *s = msg.string();
+
+			/* each line holds one sampled address as hexadecimal number */
+			while (*s) {
+				while (*s == ' ' || *s == '\n') s++;
+
+				addr_t ip = 0;
+				size_t const len = ascii_to_unsigned(s, ip, 16);
+				if (!len)
+					break;
+
+				_histograms.count(_histogram, ip);
+				s += len;
+			}
+
+			return strlen(msg.string());
+		}
+};
+
+
+class Trace_profiler::Log_root : public Root_component<Log_session_component>
+{
+	private:
+
+		Histograms &_histograms;
+
+	protected:
+
+		Log_session_component *_create_session(const char *args) override
+		{
+			Session_label const label = label_from_args(args);
+
+			/* strip the part of the label referring to the cpu_sampler */
+			char const *thread = label.string();
+			char const *prefix = "samples -> ";
+			for (char const *s = thread; *s; s++)
+				if (!strcmp(s, prefix, strlen(prefix)))
+					thread = s + strlen(prefix);
+
+			return new (md_alloc())
+				Log_session_component(_histograms, frames_from_label(thread));
+		}
+
+	public:
+
+		Log_root(Entrypoint &ep, Allocator &md_alloc, Histograms &histograms)
+		:
+			Root_component<Log_session_component>(ep, md_alloc),
+			_histograms(histograms)
+		{ }
+};
+
+
+struct Trace_profiler::Main
+{
+	Env &_env;
+
+	Attached_rom_dataspace _config { _env, "config" };
+
+	Heap _heap { _env.ram(), _env.rm() };
+
+	Sliced_heap _sliced_heap { _env.ram(), _env.rm() };
+
+	Trace::Connection _trace {
+		_env,
+		_config.xml().attribute_value("trace_quota", Number_of_bytes(512*1024)),
+		32*1024,
+		_config.xml().attribute_value("parent_levels", 0U) };
+
+	Allocator_avl           _fs_block_alloc { &_heap };
+	File_system::Connection _fs { _env, _fs_block_alloc, "profile" };
+
+	typedef String<File_system::MAX_PATH_LEN> Path;
+
+	Path const _directory = _config.xml().attribute_value("directory", Path("/"));
+
+	Thread_times _thread_times { _heap };
+
+	Histograms _histograms {
+		_heap, _config.xml().attribute_value("max_addresses", 64*1024UL) };
+
+	Log_root _log_root { _env.ep(), _sliced_heap, _histograms };
+
+	Timer::Connection _timer { _env };
+
+	unsigned long _reported_drops = 0;
+
+	void _handle_period()
+	{
+		_thread_times.update(_trace);
+
+		using namespace File_system;
+
+		Dir_handle dir = ensure_dir(_fs, _directory.string());
+		Handle_guard dir_guard(_fs, dir);
+
+		{
+			Folded_file file(_fs, dir, "execution_time.folded");
+			_thread_times.write(file);
+		}
+		{
+			Folded_file file(_fs, dir, "samples.folded");
+			_histograms.write(file);
+		}
+
+		if (_histograms.dropped() != _reported_drops) {
+			warning(_histograms.dropped() - _reported_drops, " samples dropped, "
+			        "consider a larger 'max_addresses'");
+			_reported_drops = _histograms.dropped();
+		}
+	}
+
+	Signal_handler<Main> _period_handler {
+		_env.ep(), *this, &Main::_handle_period };
+
+	Main(Env &env) : _env(env)
+	{
+		unsigned long const period_ms =
+			_config.xml().attribute_value("period_ms", 5000UL);
+
+		_timer.sigh(_period_handler);
+		_timer.trigger_periodic(1000*period_ms);
+
+		_env.parent().announce(_env.ep().manage(_log_root));
+	}
+};
+
+
+void Component::construct(Genode::Env &env) { static Trace_profiler::Main main(env); }
@@ -0,0 +1,3 @@
+TARGET = trace_profiler
+SRC_CC = main.cc
+LIBS   = base
@@ -16,6 +16,7 @@
 
 /* Genode includes */
 #include <util/construct_at.h>
+#include <util/misc_math.h>
 #include <util/xml_node.h>
 
 using namespace Genode;
@@ -227,38 +228,37 @@ void Block_driver::_submit_request(Vm_base &vm)
 }
 
 
+void *Block_driver::_next_reply(Device &dev, Packet_descriptor &pkt)
+{
+	void *req = dev.take_deferred_reply(pkt);
+	if (req) {
+		return req; }
+
+	/* get next packet/request pair and release invalid packets */
+	for (; !req; dev.session().tx()->release_packet(pkt)) {
+
+		if (!dev.session().tx()->ack_avail()) {
+			return nullptr; }
+
+		/* lookup request of next packet and free cache slot */
+		pkt = dev.session().tx()->get_acked_packet();
+		dev.cache().remove(dev.session().tx()->packet_content(pkt), &req);
+	}
+	_transferred += pkt.size();
+	return req;
+}
+
+
 void Block_driver::_collect_reply(Vm_base &vm)
 {
 	auto dev_func = [&] (Device &dev) {
 
-		struct Reply
-		{
-			unsigned long _req;
-			unsigned long _write;
-			unsigned long _dat_size;
-			unsigned long _dat[0];
-
-			Reply(void *req, bool write, size_t dat_size, void *dat_src)
-			:
-				_req((unsigned long)req), _write(write), _dat_size(dat_size)
-			{
-				memcpy(_dat, dat_src, dat_size);
-			}
-		} __attribute__ ((__packed__));
-
-		/* get next packet/request pair and release invalid packets */
-		void * req = 0;
+		/* tell VM to stop if no packet is available */
 		Packet_descriptor pkt;
-		for (; !req; dev.session().tx()->release_packet(pkt)) {
-
-			/* check for packets and tell VM to stop if none available */
-			if (!dev.session().tx()->ack_avail()) {
-				vm.smc_ret(0);
-				return;
-			}
-			/* lookup request of next packet and free cache slot */
-			pkt = dev.session().tx()->get_acked_packet();
-			dev.cache().remove(dev.session().tx()->packet_content(pkt), &req);
+		void *const req = _next_reply(dev, pkt);
+		if (!req) {
+			vm.smc_ret(0);
+			return;
 		}
 		/* get packet values */
 		void   *const dat      = dev.session().tx()->packet_content(pkt);
@@ -278,6 +278,128 @@ void Block_driver::_collect_reply(Vm_base &vm)
 }
 
 
+void Block_driver::_submit(Device            &dev,
+                           void              *req,
+                           bool               write,
+                           size_t             size,
+                           void const        *data,
+                           unsigned long long disc_offset)
+{
+	Packet_descriptor const alloc = dev.session().tx()->alloc_packet(size);
+	void *const addr = dev.session().tx()->packet_content(alloc);
+	try { dev.cache().insert(addr, req); }
+	catch (Request_cache::Full) {
+		dev.session().tx()->release_packet(alloc);
+		throw;
+	}
+	if (write) {
+		memcpy(addr, data, size); }
+
+	Packet_descriptor pkt(alloc, write ? Packet_descriptor::WRITE :
+	                                     Packet_descriptor::READ,
+	                      disc_offset / dev.block_size(),
+	                      size / dev.block_size());
+
+	dev.session().tx()->submit_packet(pkt);
+}
+
+
+/*
+ * Submit all requests that the VM placed in the block buffer
+ *
+ * In contrast to the combination of NEW_REQUEST and SUBMIT_REQUEST, which
+ * costs two world switches per request, a batch costs a single world switch.
+ * The VM receives the number of accepted requests. The submission stops at
+ * the first request that cannot be accepted, e.g., because the request
+ * queue is full, and the VM is expected to resubmit the remaining requests
+ * on the next block interrupt.
+ */
+void Block_driver::_submit_batch(Vm_base &vm)
+{
+	auto dev_func = [&] (Device &dev) {
+
+		size_t const count = vm.smc_arg_3();
+		if (count > _buf_size / sizeof(Batch_request)) {
+			error("oversized block-request batch");
+			throw Device_function_failed();
+		}
+		Batch_request const *batch = (Batch_request const *)_buf;
+
+		size_t i = 0;
+		for (; i < count; i++) {
+
+			Batch_request const &r = batch[i];
+
+			bool   const write = r.write;
+			size_t const size  = r.size;
+
+			if (write && (r.data_offset + size < r.data_offset ||
+			              r.data_offset + size > _buf_size)) {
+				error("block request exceeds block buffer");
+				break;
+			}
+			try {
+				_submit(dev, (void *)r.req, write, size,
+				        (char const *)_buf + r.data_offset,
+				        (unsigned long long)r.disc_offset_hi << 32 |
+				        r.disc_offset_lo);
+			}
+			catch (Request_cache::Full) { break; }
+			catch (Block::Session::Tx::Source::Packet_alloc_failed) { break; }
+		}
+		vm.smc_ret(i);
+	};
+	_dev_apply(Device::Id { vm.smc_arg_2() }, dev_func, [&] () { vm.smc_ret(0); });
+}
+
+
+/*
+ * Write as many replies as fit into the block buffer
+ *
+ * The replies are placed back to back, each aligned to the size of a machine
+ * word. Replies to write requests carry no data. The VM receives the number
+ * of replies.
+ */
+void Block_driver::_collect_replies(Vm_base &vm)
+{
+	auto dev_func = [&] (Device &dev) {
+
+		size_t offset = 0;
+		unsigned long count = 0;
+
+		for (;;) {
+			Packet_descriptor pkt;
+			void *const req = _next_reply(dev, pkt);
+			if (!req) {
+				break; }
+
+			void   *const dat      = dev.session().tx()->packet_content(pkt);
+			bool    const write    = pkt.operation() == Packet_descriptor::WRITE;
+			size_t  const dat_size = write ? 0 : pkt.size();
+			size_t  const size     = align_addr(sizeof(Reply) + dat_size,
+			                                    log2(sizeof(long)));
+
+			if (offset + size > _buf_size) {
+				if (!count) {
+					error("oversized block reply");
+					dev.session().tx()->release_packet(pkt);
+					throw Device_function_failed();
+				}
+				/* deliver the reply with the next batch */
+				dev.defer_reply(pkt, req);
+				break;
+			}
+			construct_at<Reply>((char *)_buf + offset, req, write, dat_size, dat);
+			dev.session().tx()->release_packet(pkt);
+			offset += size;
+			count++;
+		}
+		vm.smc_ret(count);
+	};
+	_dev_apply(Device::Id { vm.smc_arg_2() }, dev_func, [&] () { vm.smc_ret(-1); });
+}
+
+
 void Block_driver::handle_smc(Vm_base &vm)
 {
 	enum {
@@ -293,6 +415,8 @@ void Block_driver::handle_smc(Vm_base &vm)
 		COLLECT_REPLY  = 9,
 		BUFFER         = 10,
 		NAME           = 11,
+		SUBMIT_BATCH   = 12,
+		COLLECT_BATCH  = 13,
 	};
 	switch (vm.smc_arg_1()) {
 	case DEVICE_COUNT:   vm.smc_ret(_dev_count);                  break;
@@ -308,6 +432,8 @@ void Block_driver::handle_smc(Vm_base &vm)
 	case COLLECT_REPLY:  _collect_reply(vm);                      break;
 	case BUFFER:         _buffer(vm);                             break;
 	case NAME:           _name(vm);                               break;
+	case SUBMIT_BATCH:   _submit_batch(vm);                       break;
+	case COLLECT_BATCH:  _collect_replies(vm);                    break;
 	default:
 		error("unknown block-driver function ", vm.smc_arg_1());
 		throw Vm_base::Exception_handling_failed();
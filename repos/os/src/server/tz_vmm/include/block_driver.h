@@ -60,6 +60,37 @@ class Genode::Block_driver
 				void remove(void *pkt, void **req);
 		};
 
+		/**
+		 * Request of a batch, as laid out by the VM in the block buffer
+		 */
+		struct Batch_request
+		{
+			unsigned long req;
+			unsigned long write;
+			unsigned long size;
+			unsigned long data_offset;
+			unsigned long disc_offset_hi;
+			unsigned long disc_offset_lo;
+		} __attribute__ ((__packed__));
+
+		/**
+		 * Reply to a request, as expected by the VM in the block buffer
+		 */
+		struct Reply
+		{
+			unsigned long _req;
+			unsigned long _write;
+			unsigned long _dat_size;
+			unsigned long _dat[0];
+
+			Reply(void *req, bool write, size_t dat_size, void const *dat_src)
+			:
+				_req((unsigned long)req), _write(write), _dat_size(dat_size)
+			{
+				memcpy(_dat, dat_src, dat_size);
+			}
+		} __attribute__ ((__packed__));
+
 		class Device
 		{
 			public:
@@ -83,6 +114,10 @@ class Genode::Block_driver
 				Block::Session::Operations  _blk_ops;
 				bool                        _writeable;
 
+				/* acknowledged packet that did not fit into the last batch */
+				Packet_descriptor           _deferred_pkt { };
+				void                       *_deferred_req = nullptr;
+
 			public:
 
 				void _handle_irq() { _vm.inject_irq(_irq); }
@@ -107,6 +142,20 @@ class Genode::Block_driver
 				bool               writeable()   const { return _writeable; }
 				Name const        &name()        const { return _name;      }
 				unsigned           irq()         const { return _irq;       }
+
+				void defer_reply(Packet_descriptor pkt, void *req)
+				{
+					_deferred_pkt = pkt;
+					_deferred_req = req;
+				}
+
+				void *take_deferred_reply(Packet_descriptor &pkt)
+				{
+					void *const req = _deferred_req;
+					pkt = _deferred_pkt;
+					_deferred_req = nullptr;
+					return req;
+				}
 		};
 
 		void             *_buf       = nullptr;
@@ -115,6 +164,8 @@ class Genode::Block_driver
 		unsigned          _dev_count = 0;
 		Allocator_avl     _dev_alloc;
 
+		unsigned long long _transferred = 0;
+
 		void _buf_to_pkt(void *dst, size_t sz);
 		void _name(Vm_base &vm);
 		void _block_count(Vm_base &vm);
@@ -127,6 +178,11 @@ class Genode::Block_driver
 		void _new_request(Vm_base &vm);
 		void _submit_request(Vm_base &vm);
 		void _collect_reply(Vm_base &vm);
+		void _submit_batch(Vm_base &vm);
+		void _collect_replies(Vm_base &vm);
+		void _submit(Device &dev, void *req, bool write, size_t size,
+		             void const *data, unsigned long long disc_offset);
+		void *_next_reply(Device &dev, Packet_descriptor &pkt);
 
 		template <typename DEV_FUNC, typename ERR_FUNC>
 		void _dev_apply(Device::Id      id,
@@ -145,6 +201,11 @@ class Genode::Block_driver
 
 		void handle_smc(Vm_base &vm);
 
+		/**
+		 * Return number of bytes of all completed requests
+		 */
+		unsigned long long transferred() const { return _transferred; }
+
 		Block_driver(Entrypoint &ep,
 		             Xml_node    config,
 		             Allocator  &alloc,
@@ -34,7 +34,9 @@ class Genode::Serial_driver
 
 		void _push(char c) { _buf.local_addr<char>()[_off++] = c; }
 		void _flush();
+		void _put(char c);
 		void _send(Vm_base &vm);
+		void _send_buffer(Vm_base &vm);
 
 	public:
 
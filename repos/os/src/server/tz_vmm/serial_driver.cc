@@ -25,9 +25,8 @@ void Serial_driver::_flush()
 }
 
 
-void Serial_driver::_send(Vm_base &vm)
+void Serial_driver::_put(char c)
 {
-	char const c = vm.smc_arg_2();
 	if (c == '\n') {
 		_flush();
 	} else {
@@ -38,10 +37,38 @@ void Serial_driver::_send(Vm_base &vm)
 }
 
 
+void Serial_driver::_send(Vm_base &vm) { _put(vm.smc_arg_2()); }
+
+
+/*
+ * Output a whole string located in guest RAM with only one world switch
+ */
+void Serial_driver::_send_buffer(Vm_base &vm)
+{
+	addr_t const base = vm.smc_arg_2();
+	size_t const size = vm.smc_arg_3();
+	Ram   const &ram  = vm.ram();
+
+	if (!size) {
+		return; }
+
+	if (base < ram.base() || base + size <= base ||
+	    base + size > ram.base() + ram.size())
+	{
+		error("illegal serial buffer constraints");
+		return;
+	}
+	char const *src = (char const *)ram.va(base);
+	for (size_t i = 0; i < size; i++) {
+		_put(src[i]); }
+}
+
+
 void Serial_driver::handle_smc(Vm_base &vm)
 {
-	enum { SEND = 0 };
+	enum { SEND = 0, SEND_BUFFER = 1 };
 	switch (vm.smc_arg_1()) {
-	case SEND: _send(vm); break;
+	case SEND:        _send(vm);        break;
+	case SEND_BUFFER: _send_buffer(vm); break;
 	default: error("unknown serial-driver function ", vm.smc_arg_1()); }
 }
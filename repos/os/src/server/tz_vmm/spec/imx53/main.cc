@@ -57,6 +57,29 @@ class Main
 		Serial_driver _serial  { _env.ram() };
 		Block_driver  _block   { _env.ep(), _config.xml(), _heap, _vm };
 
+		/*
+		 * Statistics about the world switches per MiB of block I/O, enabled
+		 * if the config specifies the reporting interval in MiB
+		 */
+		unsigned long long const _stats_interval =
+			(unsigned long long)_config.xml().attribute_value("world_switch_stats_mib", 0UL) << 20;
+
+		unsigned long long _world_switches = 0;
+		unsigned long long _next_stats     = _stats_interval;
+
+		void _report_stats()
+		{
+			unsigned long long const transferred = _block.transferred();
+			if (!_stats_interval || transferred < _next_stats) {
+				return; }
+
+			unsigned long long const mib = transferred >> 20;
+			log("world switches: ", _world_switches, " for ", mib, " MiB of "
+			    "block I/O (", _world_switches / mib, " per MiB)");
+
+			_next_stats = transferred + _stats_interval;
+		}
+
 		void _handle_smc()
 		{
 			enum {
@@ -85,6 +108,7 @@ class Main
 		void _handle_exception()
 		{
 			_vm.on_vmm_entry();
+			_world_switches++;
 			try {
 				switch (_vm.state().cpu_exception) {
 				case Cpu_state::DATA_ABORT:      _handle_data_abort(); break;
@@ -93,6 +117,7 @@ class Main
 					error("unknown exception ", _vm.state().cpu_exception);
 					throw Vm::Exception_handling_failed();
 				}
+				_report_stats();
 				_vm.run();
 			}
 			catch (Vm::Exception_handling_failed) { _vm.dump(); }
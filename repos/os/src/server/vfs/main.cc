@@ -57,13 +57,13 @@ class Vfs_server::Session_component : public File_system::Session_rpc_object,
 {
 	private:
 
-		Node_space _node_space;
-
 		Genode::Ram_quota_guard           _ram_guard;
 		Genode::Cap_quota_guard           _cap_guard;
 		Genode::Constrained_ram_allocator _ram_alloc;
 		Genode::Heap                      _alloc;
 
+		Node_space _node_space { _alloc };
+
 		Genode::Signal_handler<Session_component> _process_packet_handler;
 
 		Vfs::Dir_file_system &_vfs;
@@ -76,11 +76,28 @@ class Vfs_server::Session_component : public File_system::Session_rpc_object,
 
 		bool const _writable;
 
+		Genode::Session_label const _label;
+
 		/*
-		 * XXX Currently, we have only one packet in backlog, which must finish
-		 *     processing before new packets can be processed.
+		 * Packets that could not be completed yet in the order of their
+		 * arrival. Packets of the same handle are completed in order
+		 * whereas packets of different handles may complete out of order.
+		 * Hence, a blocking operation on one handle does not hold up the
+		 * other handles of the session.
 		 */
-		Packet_descriptor _backlog_packet;
+		enum { MAX_PENDING = File_system::Session::TX_QUEUE_SIZE };
+
+		Packet_descriptor _pending[MAX_PENDING];
+		unsigned          _num_pending = 0;
+
+		struct Stats
+		{
+			unsigned long packets     = 0;
+			unsigned long stalls      = 0;
+			unsigned      max_pending = 0;
+		} _stats;
+
+		bool const _log_stats;
 
 		/****************************
 		 ** Handle to node mapping **
@@ -219,59 +236,67 @@ class Vfs_server::Session_component : public File_system::Session_rpc_object,
 			packet.succeeded(!!res_length);
 		}
 
-		bool _try_process_packet_op(Packet_descriptor &packet)
+		/**
+		 * Try to complete and acknowledge packet
+		 *
+		 * \return false if the operation cannot be completed yet
+		 */
+		bool _try_complete(Packet_descriptor packet)
 		{
 			try {
 				_process_packet_op(packet);
-				return true;
-			} catch (Not_ready) {
-				_backlog_packet = packet;
 			}
+			catch (Not_ready) { return false; }
+			catch (Dont_ack)  { return true; }
 
-			return false;
+			/*
+			 * The 'acknowledge_packet' function cannot block because we
+			 * checked for 'ready_to_ack' before.
+			 */
+			tx_sink()->acknowledge_packet(packet);
+			return true;
 		}
 
-		bool _process_backlog()
+		/**
+		 * Return true if one of the first 'n' pending packets refers to 'handle'
+		 */
+		bool _handle_pending(Node_handle handle, unsigned n) const
 		{
-			/* indicate success if there's no backlog */
-			if (!_backlog_packet.size() &&
-			    (_backlog_packet.operation() != Packet_descriptor::SYNC)) {
-				return true;
-			}
-
-			/* only start processing if acknowledgement is possible */
-			if (!tx_sink()->ready_to_ack())
-				return false;
-
-			if (!_try_process_packet_op(_backlog_packet))
-				return false;
+			for (unsigned i = 0; i < n; i++)
+				if (_pending[i].handle().value == handle.value)
+					return true;
 
-			/*
-			 * The 'acknowledge_packet' function cannot block because we
-			 * checked for 'ready_to_ack' in '_process_packets'.
-			 */
-			tx_sink()->acknowledge_packet(_backlog_packet);
+			return false;
+		}
 
-			/* invalidate backlog packet */
-			_backlog_packet = Packet_descriptor();
+		void _enqueue_pending(Packet_descriptor const &packet)
+		{
+			_pending[_num_pending++] = packet;
 
-			return true;
+			_stats.stalls++;
+			_stats.max_pending = Genode::max(_stats.max_pending, _num_pending);
 		}
 
-		bool _process_packet()
+		/**
+		 * Retry pending packets, keeping the order per handle
+		 */
+		void _process_pending()
 		{
-			Packet_descriptor packet = tx_sink()->get_packet();
+			unsigned kept = 0;
 
-			if (!_try_process_packet_op(packet))
-				return false;
+			for (unsigned i = 0; i < _num_pending; i++) {
 
-			/*
-			 * The 'acknowledge_packet' function cannot block because we
-			 * checked for 'ready_to_ack' in '_process_packets'.
-			 */
-			tx_sink()->acknowledge_packet(packet);
+				Packet_descriptor const packet = _pending[i];
 
-			return true;
+				/* only start processing if acknowledgement is possible */
+				bool const completed = !_handle_pending(packet.handle(), kept)
+				                    && tx_sink()->ready_to_ack()
+				                    && _try_complete(packet);
+				if (!completed)
+					_pending[kept++] = packet;
+			}
+
+			_num_pending = kept;
 		}
 
 		/**
@@ -280,37 +305,36 @@ class Vfs_server::Session_component : public File_system::Session_rpc_object,
 		 */
 		void _process_packets()
 		{
-			/*
-			 * XXX Process client backlog before looking at new requests. This
-			 *     limits the number of simultaneously addressed handles (which
-			 *     was also the case before adding the backlog in case of
-			 *     blocking operations).
-			 */
-			if (!_process_backlog())
-				/* backlog not cleared - block for next condition change */
-				return;
+			_process_pending();
 
 			while (tx_sink()->packet_avail()) {
 
 				/*
-				 * Make sure that the '_process_packet' function does not
+				 * Make sure that the '_try_complete' function does not
 				 * block.
 				 *
 				 * If the acknowledgement queue is full, we defer packet
 				 * processing until the client processed pending
 				 * acknowledgements and thereby emitted a ready-to-ack
 				 * signal. Otherwise, the call of 'acknowledge_packet()'
-				 * in '_process_packet' would infinitely block the context
+				 * in '_try_complete' would infinitely block the context
 				 * of the main thread. The main thread is however needed
 				 * for receiving any subsequent 'ready-to-ack' signals.
 				 */
 				if (!tx_sink()->ready_to_ack())
 					return;
 
-				try {
-					if (!_process_packet())
-						return;
-				} catch (Dont_ack) { }
+				/* block for next condition change if no slot is left */
+				if (_num_pending == MAX_PENDING)
+					return;
+
+				Packet_descriptor const packet = tx_sink()->get_packet();
+				_stats.packets++;
+
+				/* packets of a handle with pending packets must wait */
+				if (_handle_pending(packet.handle(), _num_pending)
+				 || !_try_complete(packet))
+					_enqueue_pending(packet);
 			}
 		}
 
@@ -352,6 +376,7 @@ class Vfs_server::Session_component : public File_system::Session_rpc_object,
 		 * \param tx_buf_size  shared transmission buffer size
 		 * \param root_path    path root of the session
 		 * \param writable     whether the session can modify files
+		 * \param log_stats    whether to log packet statistics on close
 		 */
 
 		Session_component(Genode::Env         &env,
@@ -361,7 +386,8 @@ class Vfs_server::Session_component : public File_system::Session_rpc_object,
 		                  size_t               tx_buf_size,
 		                  Vfs::Dir_file_system &vfs,
 		                  char           const *root_path,
-		                  bool                  writable)
+		                  bool                  writable,
+		                  bool                  log_stats)
 		:
 			Session_rpc_object(env.ram().alloc(tx_buf_size), env.rm(), env.ep().rpc_ep()),
 			_ram_guard(ram_quota),
@@ -371,7 +397,9 @@ class Vfs_server::Session_component : public File_system::Session_rpc_object,
 			_process_packet_handler(env.ep(), *this, &Session_component::_process_packets),
 			_vfs(vfs),
 			_root_path(root_path),
-			_writable(writable)
+			_writable(writable),
+			_label(label),
+			_log_stats(log_stats)
 		{
 			/*
 			 * Register '_process_packets' dispatch function as signal
@@ -386,6 +414,11 @@ class Vfs_server::Session_component : public File_system::Session_rpc_object,
 		 */
 		~Session_component()
 		{
+			if (_log_stats)
+				Genode::log("'", _label, "': ", _stats.packets, " packets, ",
+				            _stats.stalls, " stalled, max queue depth ",
+				            _stats.max_pending);
+
 			while (_node_space.apply_any<Node>([&] (Node &node) {
 				_close(node); })) { }
 		}
@@ -686,6 +719,7 @@ class Vfs_server::Root :
 			Session_label const label = label_from_args(args);
 			Path session_root;
 			bool writeable = false;
+			bool stats     = false;
 
 			/*****************
 			 ** Quota check **
@@ -738,6 +772,8 @@ class Vfs_server::Root :
 				if (policy.attribute_value("writeable", false))
 					writeable = Arg_string::find_arg(args, "writeable").bool_value(false);
 
+				stats = policy.attribute_value("stats", false);
+
 			} catch (Session_policy::No_policy_defined) {
 				/* missing policy - deny request */
 				throw Service_denied();
@@ -762,7 +798,7 @@ class Vfs_server::Root :
 				                   Genode::Ram_quota{ram_quota},
 				                   Genode::Cap_quota{cap_quota},
 				                   tx_buf_size, _vfs,
-				                   session_root.base(), writeable);
+				                   session_root.base(), writeable, stats);
 
 			auto ram_used = _env.pd().used_ram().value - initial_ram_usage;
 			auto cap_used = _env.pd().used_caps().value - initial_cap_usage;
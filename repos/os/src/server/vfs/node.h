@@ -19,7 +19,7 @@
 #include <file_system/node.h>
 #include <vfs/file_system.h>
 #include <os/path.h>
-#include <base/id_space.h>
+#include <base/hashed_id_space.h>
 
 /* Local includes */
 #include "assert.h"
@@ -34,7 +34,7 @@ namespace Vfs_server {
 	struct File;
 	struct Symlink;
 
-	typedef Genode::Id_space<Node> Node_space;
+	typedef Genode::Hashed_id_space<Node> Node_space;
 
 	struct Node_io_handler
 	{
@@ -14,16 +14,22 @@
 /* Genode includes */
 #include <base/attached_ram_dataspace.h>
 #include <base/attached_rom_dataspace.h>
+#include <base/allocator_avl.h>
 #include <base/component.h>
 #include <base/exception.h>
+#include <base/heap.h>
 #include <base/log.h>
+#include <block_session/connection.h>
 #include <cpu/cpu_state.h>
 #include <drivers/defs/exynos5.h>
+#include <nic/packet_allocator.h>
+#include <nic_session/connection.h>
 #include <os/ring_buffer.h>
 #include <terminal_session/connection.h>
 #include <timer_session/connection.h>
 #include <util/avl_tree.h>
 #include <util/mmio.h>
+#include <util/reconstructible.h>
 #include <vm_session/connection.h>
 
 #include <vm_state.h>
@@ -258,6 +264,7 @@ class Vm {
 		}
 
 		State & state() const { return _state; }
+		Ram   & ram()         { return _ram;   }
 };
 
 
@@ -1237,6 +1244,796 @@ class Vmm
 		};
 
 
+		/**
+		 * Device attached via the virtio-mmio transport
+		 *
+		 * The transport implements version 2 of the virtio-mmio interface
+		 * with split virtqueues. The virtqueues reside in guest RAM, which
+		 * is mapped into the VMM. Only the register accesses of the guest
+		 * trap, the descriptors are read directly. A queue notification
+		 * makes the device process all available buffers at once, and the
+		 * guest receives a single interrupt for a batch of used buffers.
+		 */
+		class Virtio_device : public Device
+		{
+			protected:
+
+				enum Device_id  { NET = 1, BLOCK = 2 };
+				enum Irq_status { USED_BUFFER = 1, CONFIG_CHANGE = 2 };
+
+				enum { QUEUE_SIZE = 128, MAX_QUEUES = 2 };
+
+				/**
+				 * Return local address of guest-physical range
+				 */
+				static char * _guest(Ram &ram, Genode::uint64_t addr,
+				                     Genode::size_t size)
+				{
+					Genode::uint64_t const off = addr - ram.base();
+
+					if (addr < ram.base() || off > ram.size() ||
+					    size > ram.size() - off)
+						throw Vm::Exception("Virtio: range %llx+%lx outside of RAM",
+						                    addr, (unsigned long)size);
+
+					return (char *)(ram.local() + off);
+				}
+
+				class Queue
+				{
+					private:
+
+						struct Descriptor
+						{
+							enum { NEXT = 1, WRITE = 2 };
+
+							Genode::uint64_t addr;
+							Genode::uint32_t len;
+							Genode::uint16_t flags;
+							Genode::uint16_t next;
+						} __attribute__((packed));
+
+						struct Used_elem
+						{
+							Genode::uint32_t id;
+							Genode::uint32_t len;
+						};
+
+						Ram                        *_ram   = nullptr;
+						Descriptor volatile        *_desc  = nullptr;
+						Genode::uint16_t volatile  *_avail = nullptr;
+						Genode::uint16_t volatile  *_used  = nullptr;
+						Genode::uint16_t            _last_avail = 0;
+						Genode::uint16_t            _used_idx   = 0;
+
+						Used_elem volatile *_used_ring() {
+							return (Used_elem volatile *)(_used + 2); }
+
+						template <typename FN>
+						void _for_each(Genode::uint16_t head, FN const &fn)
+						{
+							Genode::uint16_t i = head;
+							for (unsigned n = 0; n < num; n++) {
+								if (i >= num)
+									throw Vm::Exception("Virtio: descriptor %u out of bounds", i);
+
+								Genode::uint64_t const addr  = _desc[i].addr;
+								Genode::uint32_t const len   = _desc[i].len;
+								Genode::uint16_t const flags = _desc[i].flags;
+
+								fn(_guest(*_ram, addr, len), len,
+								   (bool)(flags & Descriptor::WRITE));
+
+								if (!(flags & Descriptor::NEXT)) return;
+								i = _desc[i].next;
+							}
+							throw Vm::Exception("Virtio: descriptor chain loops");
+						}
+
+						/**
+						 * Apply 'fn' to the ranges of the descriptor chain
+						 * that cover 'len' bytes after the first 'skip' bytes
+						 *
+						 * \param writeable  visit device-writeable descriptors
+						 *                   if true or device-readable ones
+						 *                   otherwise
+						 */
+						template <typename FN>
+						Genode::size_t _for_each_range(Genode::uint16_t head,
+						                               bool writeable,
+						                               Genode::size_t skip,
+						                               Genode::size_t len,
+						                               FN const &fn)
+						{
+							Genode::size_t done = 0;
+							_for_each(head, [&] (char *p, Genode::size_t n, bool w) {
+								if (w != writeable) return;
+								if (skip >= n) { skip -= n; return; }
+
+								n = Genode::min(n - skip, len - done);
+								fn(p + skip, done, n);
+								skip  = 0;
+								done += n;
+							});
+							return done;
+						}
+
+					public:
+
+						/* registers written by the driver */
+						Genode::uint32_t num   = 0;
+						Genode::uint64_t desc_addr  = 0;
+						Genode::uint64_t avail_addr = 0;
+						Genode::uint64_t used_addr  = 0;
+
+						void enable(Ram &ram)
+						{
+							if (!num || num > QUEUE_SIZE || (num & (num - 1)))
+								throw Vm::Exception("Virtio: invalid queue size %u", num);
+
+							_ram        = &ram;
+							_desc       = (Descriptor *)_guest(ram, desc_addr, num*sizeof(Descriptor));
+							_avail      = (Genode::uint16_t *)_guest(ram, avail_addr, 2*(3 + num));
+							_used       = (Genode::uint16_t *)_guest(ram, used_addr, 6 + 8*num);
+							_last_avail = 0;
+							_used_idx   = 0;
+						}
+
+						void disable() { *this = Queue(); }
+
+						bool ready() const { return _desc != nullptr; }
+
+						/**
+						 * Return true if the driver made buffers available
+						 */
+						bool avail() const {
+							return ready() && _last_avail != _avail[1]; }
+
+						/**
+						 * Return descriptor chain of the next available buffer
+						 */
+						Genode::uint16_t head() const {
+							return _avail[2 + _last_avail % num]; }
+
+						/**
+						 * Remove next available buffer from the queue
+						 */
+						void pop() { _last_avail++; }
+
+						/**
+						 * Hand buffer back to the driver
+						 *
+						 * \param len  number of bytes written to the buffer
+						 */
+						void put(Genode::uint16_t head, Genode::uint32_t len)
+						{
+							Used_elem volatile &e = _used_ring()[_used_idx % num];
+							e.id  = head;
+							e.len = len;
+							_used[1] = ++_used_idx;
+						}
+
+						/**
+						 * Return size of the readable or writeable part of a buffer
+						 */
+						Genode::size_t length(Genode::uint16_t head, bool writeable)
+						{
+							Genode::size_t len = 0;
+							_for_each(head, [&] (char *, Genode::size_t n, bool w) {
+								if (w == writeable) len += n; });
+							return len;
+						}
+
+						/**
+						 * Copy from device-readable part of buffer
+						 *
+						 * \return number of bytes copied
+						 */
+						Genode::size_t read(Genode::uint16_t head, Genode::size_t skip,
+						                    void *dst, Genode::size_t len)
+						{
+							return _for_each_range(head, false, skip, len,
+								[&] (char *p, Genode::size_t off, Genode::size_t n) {
+									Genode::memcpy((char *)dst + off, p, n); });
+						}
+
+						/**
+						 * Copy to device-writeable part of buffer
+						 *
+						 * \return number of bytes copied
+						 */
+						Genode::size_t write(Genode::uint16_t head, Genode::size_t skip,
+						                     void const *src, Genode::size_t len)
+						{
+							return _for_each_range(head, true, skip, len,
+								[&] (char *p, Genode::size_t off, Genode::size_t n) {
+									Genode::memcpy(p, (char const *)src + off, n); });
+						}
+				};
+
+			private:
+
+				enum {
+					MAGIC_VALUE         = 0x0,
+					VERSION             = 0x4,
+					DEVICE_ID           = 0x8,
+					VENDOR_ID           = 0xc,
+					DEVICE_FEATURES     = 0x10,
+					DEVICE_FEATURES_SEL = 0x14,
+					DRIVER_FEATURES     = 0x20,
+					DRIVER_FEATURES_SEL = 0x24,
+					QUEUE_SEL           = 0x30,
+					QUEUE_NUM_MAX       = 0x34,
+					QUEUE_NUM           = 0x38,
+					QUEUE_READY         = 0x44,
+					QUEUE_NOTIFY        = 0x50,
+					INTERRUPT_STATUS    = 0x60,
+					INTERRUPT_ACK       = 0x64,
+					STATUS              = 0x70,
+					QUEUE_DESC_LOW      = 0x80,
+					QUEUE_DESC_HIGH     = 0x84,
+					QUEUE_AVAIL_LOW     = 0x90,
+					QUEUE_AVAIL_HIGH    = 0x94,
+					QUEUE_USED_LOW      = 0xa0,
+					QUEUE_USED_HIGH     = 0xa4,
+					CONFIG_GENERATION   = 0xfc,
+					CONFIG              = 0x100,
+				};
+
+				enum { MAGIC = 0x74726976 /* "virt" */ };
+				enum { FEATURE_VERSION_1 = 1 /* bit 32 */ };
+				enum { STATUS_DRIVER_OK = 4, STATUS_FEATURES_OK = 8 };
+
+				Gic                    &_gic;
+				unsigned const          _irq;
+				Device_id const         _id;
+				unsigned const          _queue_count;
+				Queue                   _queues[MAX_QUEUES];
+				Genode::uint32_t        _device_features_sel = 0;
+				Genode::uint32_t        _driver_features_sel = 0;
+				Genode::uint32_t        _driver_features[2]  { 0, 0 };
+				Genode::uint32_t        _queue_sel           = 0;
+				Genode::uint32_t        _status              = 0;
+				Genode::uint32_t        _irq_status          = 0;
+				bool                    _used_pending        = false;
+
+				Queue &_selected()
+				{
+					if (_queue_sel >= _queue_count)
+						throw Error("Device %s: queue %u not implemented",
+						            name(), _queue_sel);
+					return _queues[_queue_sel];
+				}
+
+				static void _low(Genode::uint64_t &r, Genode::uint32_t v) {
+					r = (r & ~0xffffffffULL) | v; }
+
+				static void _high(Genode::uint64_t &r, Genode::uint32_t v) {
+					r = (r & 0xffffffffULL) | ((Genode::uint64_t)v << 32); }
+
+				void _reset_transport()
+				{
+					for (unsigned i = 0; i < MAX_QUEUES; i++)
+						_queues[i].disable();
+
+					_device_features_sel = _driver_features_sel = 0;
+					_driver_features[0]  = _driver_features[1]  = 0;
+					_queue_sel = _status = _irq_status = 0;
+					_used_pending = false;
+
+					_reset();
+				}
+
+				template <typename T>
+				void _read_config(T *reg, Genode::uint64_t off)
+				{
+					Genode::uint64_t const o = off - CONFIG;
+					if (off < CONFIG || o + sizeof(T) > _config_size())
+						throw Error("Device %s: read of offset %llx",
+						            name(), off);
+					Genode::memcpy(reg, (char const *)_config() + o, sizeof(T));
+				}
+
+			protected:
+
+				Queue &_queue(unsigned i) { return _queues[i]; }
+
+				bool _driver_ok() const { return _status & STATUS_DRIVER_OK; }
+
+				void _interrupt(Irq_status s)
+				{
+					_irq_status |= s;
+					_gic.inject_irq(_irq);
+				}
+
+				/**
+				 * Hand buffer back to the driver, deferring the interrupt
+				 */
+				void _put(Queue &q, Genode::uint16_t head, Genode::uint32_t len)
+				{
+					q.put(head, len);
+					_used_pending = true;
+				}
+
+				/**
+				 * Interrupt the driver once for all buffers put so far
+				 */
+				void _flush()
+				{
+					if (!_used_pending) return;
+
+					_used_pending = false;
+					_interrupt(USED_BUFFER);
+				}
+
+				/**
+				 * Return device-specific feature bits 0..31
+				 */
+				virtual Genode::uint32_t _features() = 0;
+
+				virtual void             _notify(unsigned queue) = 0;
+				virtual void             _reset() { }
+				virtual void const     * _config() = 0;
+				virtual Genode::size_t   _config_size() = 0;
+
+			public:
+
+				Virtio_device(const char * const       name,
+				              const Genode::uint64_t   addr,
+				              const Genode::uint64_t   size,
+				              Device_id                id,
+				              unsigned                 queue_count,
+				              unsigned                 irq,
+				              Vmm                     &vmm,
+				              Gic                     &gic)
+				: Device(name, addr, size, vmm.vm()),
+				  _gic(gic), _irq(irq), _id(id), _queue_count(queue_count)
+				{
+					_gic.register_irq(_irq, this, false);
+				}
+
+				void read(Genode::uint8_t * reg, Genode::uint64_t off) {
+					_read_config(reg, off); }
+
+				void read(Genode::uint16_t * reg, Genode::uint64_t off) {
+					_read_config(reg, off); }
+
+				void read(Genode::uint32_t * reg, Genode::uint64_t off)
+				{
+					if (off >= CONFIG) {
+						_read_config(reg, off);
+						return;
+					}
+
+					switch (off) {
+					case MAGIC_VALUE:       *reg = MAGIC;                   return;
+					case VERSION:           *reg = 2;                       return;
+					case DEVICE_ID:         *reg = _id;                     return;
+					case VENDOR_ID:         *reg = 0;                       return;
+					case INTERRUPT_STATUS:  *reg = _irq_status;             return;
+					case STATUS:            *reg = _status;                 return;
+					case CONFIG_GENERATION: *reg = 0;                       return;
+					case DEVICE_FEATURES:
+						*reg = _device_features_sel == 0 ? _features()
+						     : _device_features_sel == 1 ? FEATURE_VERSION_1 : 0;
+						return;
+					case QUEUE_NUM_MAX:
+						*reg = _queue_sel < _queue_count ? QUEUE_SIZE : 0;
+						return;
+					case QUEUE_READY:
+						*reg = _queue_sel < _queue_count &&
+						       _queues[_queue_sel].ready();
+						return;
+					default:
+						throw Error("Device %s: word-wise read of %llx",
+						            name(), off);
+					};
+				}
+
+				void write(Genode::uint32_t * reg, Genode::uint64_t off)
+				{
+					Genode::uint32_t const v = *reg;
+
+					switch (off) {
+					case DEVICE_FEATURES_SEL: _device_features_sel = v;     return;
+					case DRIVER_FEATURES_SEL: _driver_features_sel = v;     return;
+					case QUEUE_SEL:           _queue_sel           = v;     return;
+					case QUEUE_NUM:           _selected().num      = v;     return;
+					case INTERRUPT_ACK:       _irq_status         &= ~v;    return;
+					case QUEUE_DESC_LOW:      _low (_selected().desc_addr,  v);  return;
+					case QUEUE_DESC_HIGH:     _high(_selected().desc_addr,  v);  return;
+					case QUEUE_AVAIL_LOW:     _low (_selected().avail_addr, v);  return;
+					case QUEUE_AVAIL_HIGH:    _high(_selected().avail_addr, v);  return;
+					case QUEUE_USED_LOW:      _low (_selected().used_addr,  v);  return;
+					case QUEUE_USED_HIGH:     _high(_selected().used_addr,  v);  return;
+					case DRIVER_FEATURES:
+						if (_driver_features_sel < 2)
+							_driver_features[_driver_features_sel] = v;
+						return;
+					case QUEUE_READY:
+						if (v) _selected().enable(_vm.ram());
+						else   _selected().disable();
+						return;
+					case QUEUE_NOTIFY:
+						if (v < _queue_count && _queues[v].ready())
+							_notify(v);
+						return;
+					case STATUS:
+						if (!v) {
+							_reset_transport();
+							return;
+						}
+						/* the legacy interface is not supported */
+						_status = (_driver_features[1] & FEATURE_VERSION_1)
+						        ? v : (v & ~STATUS_FEATURES_OK);
+						return;
+					default:
+						throw Error("Device %s: word-wise write %x to %llx",
+						            name(), v, off);
+					};
+				}
+		};
+
+
+		/**
+		 * Virtio block device backed by a block session
+		 *
+		 * The payload of a request is copied once between guest RAM and the
+		 * bulk buffer of the block session. Packet-stream payloads must
+		 * reside within the bulk buffer, which rules out handing the guest
+		 * buffer to the block server directly.
+		 */
+		class Virtio_block : public Virtio_device
+		{
+			private:
+
+				enum {
+					SECTOR_SIZE = 512,
+					TX_BUF_SIZE = 512*1024,
+					SEG_SIZE    = 4096,
+					SEG_MAX     = 32,
+				};
+
+				enum Feature {
+					SIZE_MAX = 1 << 1,
+					SEG_MAX_ = 1 << 2,
+					RO       = 1 << 5,
+					BLK_SIZE = 1 << 6,
+				};
+
+				enum Type   { IN = 0, OUT = 1 };
+				enum Status { OK = 0, IOERR = 1, UNSUPP = 2 };
+
+				struct Header
+				{
+					Genode::uint32_t type;
+					Genode::uint32_t reserved;
+					Genode::uint64_t sector;
+				} __attribute__((packed));
+
+				struct Config
+				{
+					Genode::uint64_t capacity;
+					Genode::uint32_t size_max;
+					Genode::uint32_t seg_max;
+					Genode::uint16_t cylinders;
+					Genode::uint8_t  heads;
+					Genode::uint8_t  sectors;
+					Genode::uint32_t blk_size;
+				} __attribute__((packed));
+
+				struct Request
+				{
+					bool                     pending = false;
+					Block::Packet_descriptor packet;
+				};
+
+				using Packet = Block::Packet_descriptor;
+
+				Genode::Allocator_avl        _tx_alloc;
+				Block::Connection            _block;
+				Signal_handler<Virtio_block> _handler;
+				Block::sector_t              _block_count = 0;
+				Genode::size_t               _block_size  = 0;
+				Block::Session::Operations   _ops;
+				Config                       _cfg;
+				Request                      _requests[QUEUE_SIZE];
+
+				void _complete(Queue &q, Genode::uint16_t head, Status s,
+				               Genode::size_t written = 0)
+				{
+					Genode::size_t const len = q.length(head, true);
+					if (!len)
+						throw Error("Device %s: request without status", name());
+
+					Genode::uint8_t const status = s;
+					q.write(head, len - 1, &status, 1);
+					_put(q, head, written + 1);
+				}
+
+				/**
+				 * Submit request to the block session
+				 *
+				 * \return false if the request must wait for the block
+				 *         session to free up its transmission buffer
+				 */
+				bool _submit(Queue &q, Genode::uint16_t head)
+				{
+					Header hdr;
+					if (q.read(head, 0, &hdr, sizeof(hdr)) < sizeof(hdr))
+						throw Error("Device %s: request without header", name());
+
+					bool const write = hdr.type == OUT;
+					if (hdr.type != IN && !write) {
+						_complete(q, head, UNSUPP);
+						return true;
+					}
+
+					Genode::size_t const readable  = q.length(head, false);
+					Genode::size_t const writeable = q.length(head, true);
+					Genode::size_t const len = write ? readable - sizeof(hdr)
+					                                 : writeable - 1;
+					Genode::uint64_t const offset = hdr.sector * SECTOR_SIZE;
+
+					if (!writeable || !len || len > TX_BUF_SIZE ||
+					    len % _block_size || offset % _block_size ||
+					    (offset + len) / _block_size > _block_count ||
+					    (write && !_ops.supported(Packet::WRITE))) {
+						_complete(q, head, IOERR);
+						return true;
+					}
+
+					if (!_block.tx()->ready_to_submit())
+						return false;
+
+					Packet p;
+					try { p = _block.tx()->alloc_packet(len); }
+					catch (Block::Session::Tx::Source::Packet_alloc_failed) {
+						return false; }
+
+					if (write)
+						q.read(head, sizeof(hdr), _block.tx()->packet_content(p), len);
+
+					Request &r = _requests[head];
+					r.pending = true;
+					r.packet  = Packet(p, write ? Packet::WRITE : Packet::READ,
+					                   offset / _block_size, len / _block_size);
+					_block.tx()->submit_packet(r.packet);
+					return true;
+				}
+
+				void _process()
+				{
+					Queue &q = _queue(0);
+					while (q.avail() && _submit(q, q.head()))
+						q.pop();
+				}
+
+				void _handle_acks()
+				{
+					Queue &q = _queue(0);
+
+					while (_block.tx()->ack_avail()) {
+						Packet const p = _block.tx()->get_acked_packet();
+
+						for (unsigned i = 0; i < QUEUE_SIZE; i++) {
+							Request &r = _requests[i];
+							if (!r.pending || r.packet.offset() != p.offset())
+								continue;
+
+							bool const read = p.operation() == Packet::READ;
+							Genode::size_t written = 0;
+							if (read && p.succeeded())
+								written = q.write(i, 0, _block.tx()->packet_content(p),
+								                  p.size());
+
+							r.pending = false;
+							_complete(q, i, p.succeeded() ? OK : IOERR, written);
+							break;
+						}
+						_block.tx()->release_packet(p);
+					}
+
+					/* resume requests deferred for lack of buffer space */
+					_process();
+					_flush();
+				}
+
+				Genode::uint32_t _features() override
+				{
+					return SIZE_MAX | SEG_MAX_ | BLK_SIZE |
+					       (_ops.supported(Packet::WRITE) ? 0 : RO);
+				}
+
+				void _notify(unsigned) override
+				{
+					_process();
+					_flush();
+				}
+
+				void _reset() override
+				{
+					/* acknowledgements of pending requests get dropped */
+					for (unsigned i = 0; i < QUEUE_SIZE; i++)
+						_requests[i].pending = false;
+				}
+
+				void const   * _config()      override { return &_cfg;        }
+				Genode::size_t _config_size() override { return sizeof(_cfg); }
+
+			public:
+
+				Virtio_block(const char * const       name,
+				             const Genode::uint64_t   addr,
+				             const Genode::uint64_t   size,
+				             unsigned                 irq,
+				             Vmm                     &vmm,
+				             Genode::Env             &env,
+				             Genode::Allocator       &alloc,
+				             Gic                     &gic)
+				: Virtio_device(name, addr, size, BLOCK, 1, irq, vmm, gic),
+				  _tx_alloc(&alloc),
+				  _block(env, &_tx_alloc, TX_BUF_SIZE),
+				  _handler(vmm, env.ep(), *this, &Virtio_block::_handle_acks)
+				{
+					_block.info(&_block_count, &_block_size, &_ops);
+					_block.tx_channel()->sigh_ack_avail(_handler);
+					_block.tx_channel()->sigh_ready_to_submit(_handler);
+
+					Genode::memset(&_cfg, 0, sizeof(_cfg));
+					_cfg.capacity = _block_count * _block_size / SECTOR_SIZE;
+					_cfg.size_max = SEG_SIZE;
+					_cfg.seg_max  = SEG_MAX;
+					_cfg.blk_size = _block_size;
+				}
+		};
+
+
+		/**
+		 * Virtio network device backed by a NIC session
+		 *
+		 * Like for the block device, frames are copied once between guest
+		 * RAM and the bulk buffers of the NIC session.
+		 */
+		class Virtio_net : public Virtio_device
+		{
+			private:
+
+				enum { RX = 0, TX = 1 };
+				enum { BUF_SIZE = Nic::Packet_allocator::DEFAULT_PACKET_SIZE * 128 };
+				enum Feature { MAC = 1 << 5, STATUS = 1 << 16 };
+				enum { LINK_UP = 1 };
+
+				struct Header
+				{
+					Genode::uint8_t  flags;
+					Genode::uint8_t  gso_type;
+					Genode::uint16_t hdr_len;
+					Genode::uint16_t gso_size;
+					Genode::uint16_t csum_start;
+					Genode::uint16_t csum_offset;
+					Genode::uint16_t num_buffers;
+				} __attribute__((packed));
+
+				struct Config
+				{
+					Genode::uint8_t  mac[6];
+					Genode::uint16_t status;
+				} __attribute__((packed));
+
+				using Packet = Nic::Packet_descriptor;
+
+				Nic::Packet_allocator      _tx_alloc;
+				Nic::Connection            _nic;
+				Signal_handler<Virtio_net> _rx_handler;
+				Signal_handler<Virtio_net> _tx_handler;
+				Signal_handler<Virtio_net> _link_handler;
+				Config                     _cfg;
+
+				void _receive()
+				{
+					Queue &q = _queue(RX);
+
+					while (q.avail() && _nic.rx()->packet_avail() &&
+					       _nic.rx()->ready_to_ack()) {
+
+						Packet const p = _nic.rx()->get_packet();
+						Genode::uint16_t const head = q.head();
+						q.pop();
+
+						Header hdr { };
+						hdr.num_buffers = 1;
+
+						Genode::size_t n = q.write(head, 0, &hdr, sizeof(hdr));
+						n += q.write(head, sizeof(hdr),
+						             _nic.rx()->packet_content(p), p.size());
+
+						_put(q, head, n);
+						_nic.rx()->acknowledge_packet(p);
+					}
+					_flush();
+				}
+
+				void _transmit()
+				{
+					while (_nic.tx()->ack_avail())
+						_nic.tx()->release_packet(_nic.tx()->get_acked_packet());
+
+					Queue &q = _queue(TX);
+
+					while (q.avail() && _nic.tx()->ready_to_submit()) {
+
+						Genode::uint16_t const head = q.head();
+						Genode::size_t   const len  = q.length(head, false);
+						if (len < sizeof(Header))
+							throw Error("Device %s: frame without header", name());
+
+						Genode::size_t const size = len - sizeof(Header);
+						if (size) {
+							Packet p;
+							try { p = _nic.tx()->alloc_packet(size); }
+							catch (Nic::Session::Tx::Source::Packet_alloc_failed) {
+								break; }
+
+							q.read(head, sizeof(Header), _nic.tx()->packet_content(p), size);
+							_nic.tx()->submit_packet(p);
+						}
+
+						q.pop();
+						_put(q, head, 0);
+					}
+					_flush();
+				}
+
+				void _link_state()
+				{
+					_cfg.status = _nic.link_state() ? LINK_UP : 0;
+					if (_driver_ok()) _interrupt(CONFIG_CHANGE);
+				}
+
+				Genode::uint32_t _features() override { return MAC | STATUS; }
+
+				void _notify(unsigned queue) override
+				{
+					if (queue == RX) _receive();
+					else             _transmit();
+				}
+
+				void const   * _config()      override { return &_cfg;        }
+				Genode::size_t _config_size() override { return sizeof(_cfg); }
+
+			public:
+
+				Virtio_net(const char * const       name,
+				           const Genode::uint64_t   addr,
+				           const Genode::uint64_t   size,
+				           unsigned                 irq,
+				           Vmm                     &vmm,
+				           Genode::Env             &env,
+				           Genode::Allocator       &alloc,
+				           Gic                     &gic)
+				: Virtio_device(name, addr, size, NET, 2, irq, vmm, gic),
+				  _tx_alloc(&alloc),
+				  _nic(env, &_tx_alloc, BUF_SIZE, BUF_SIZE),
+				  _rx_handler  (vmm, env.ep(), *this, &Virtio_net::_receive),
+				  _tx_handler  (vmm, env.ep(), *this, &Virtio_net::_transmit),
+				  _link_handler(vmm, env.ep(), *this, &Virtio_net::_link_state)
+				{
+					_nic.rx_channel()->sigh_packet_avail(_rx_handler);
+					_nic.rx_channel()->sigh_ready_to_ack(_rx_handler);
+					_nic.tx_channel()->sigh_ack_avail(_tx_handler);
+					_nic.tx_channel()->sigh_ready_to_submit(_tx_handler);
+					_nic.link_state_sigh(_link_handler);
+
+					Nic::Mac_address const mac = _nic.mac_address();
+					Genode::memcpy(_cfg.mac, mac.addr, sizeof(_cfg.mac));
+					_cfg.status = _nic.link_state() ? LINK_UP : 0;
+				}
+		};
+
+
+		enum { VIRTIO_BLOCK_IRQ = 74, VIRTIO_NET_IRQ = 75 };
+
 		Signal_handler<Vmm>            _vm_handler;
 		Vm                             _vm;
 		Cp15                           _cp15;
@@ -1245,6 +2042,10 @@ class Vmm
 		Generic_timer                  _timer;
 		System_register                _sys_regs;
 		Pl011                          _uart;
+		Genode::Attached_rom_dataspace _config;
+		Genode::Heap                   _heap;
+		Genode::Constructible<Virtio_block> _block;
+		Genode::Constructible<Virtio_net>   _net;
 
 		void _handle_hyper_call() {
 			throw Vm::Exception("Unknown hyper call!"); }
@@ -1303,12 +2104,26 @@ class Vmm
 		  _gic      ("Gic",             0x2c001000, 0x2000, _vm),
 		  _timer    ("Timer",           0x2a430000, 0x1000, *this, env, _gic),
 		  _sys_regs ("System Register", 0x1c010000, 0x1000, _vm, env),
-		  _uart     ("Pl011",           0x1c090000, 0x1000, *this, env, _gic)
+		  _uart     ("Pl011",           0x1c090000, 0x1000, *this, env, _gic),
+		  _config(env, "config"),
+		  _heap(env.ram(), env.rm())
 		{
 			_device_tree.insert(&_gic);
 			_device_tree.insert(&_sys_regs);
 			_device_tree.insert(&_uart);
 
+			if (_config.xml().has_sub_node("virtio_block")) {
+				_block.construct("Virtio block", 0x1c130000, 0x200,
+				                 VIRTIO_BLOCK_IRQ, *this, env, _heap, _gic);
+				_device_tree.insert(&*_block);
+			}
+
+			if (_config.xml().has_sub_node("virtio_net")) {
+				_net.construct("Virtio net", 0x1c140000, 0x200,
+				               VIRTIO_NET_IRQ, *this, env, _heap, _gic);
+				_device_tree.insert(&*_net);
+			}
+
 			Genode::log("Start virtual machine ...");
 
 			_vm.start();
@@ -13,6 +13,7 @@
  */
 
 #include <base/allocator_avl.h>
+#include <base/attached_rom_dataspace.h>
 #include <base/component.h>
 #include <base/heap.h>
 #include <base/log.h>
@@ -29,6 +30,12 @@ enum {
 };
 
 
+/**
+ * Measure the sequential throughput
+ *
+ * If 'segments' is not zero, each request is a scatter-gather packet that
+ * consists of 'segments' separately allocated buffers of 'REQUEST_SIZE'.
+ */
 class Throughput
 {
 	private:
@@ -36,9 +43,11 @@ class Throughput
 		typedef Genode::size_t size_t;
 
 		Env &             _env;
+		unsigned          _segments;
 		Heap              _heap    { _env.ram(), _env.rm() };
 		Allocator_avl     _alloc   { &_heap };
-		Block::Connection _session { _env, &_alloc, TX_BUFFER };
+		Block::Connection _session { _env, &_alloc,
+		                             TX_BUFFER * max(_segments, 1U) };
 		Timer::Connection _timer   { _env };
 
 		Signal_handler<Throughput> _disp_ack    { _env.ep(), *this,
@@ -56,19 +65,68 @@ class Throughput
 		size_t          _blk_size;
 		Block::sector_t _blk_count;
 
+		/**
+		 * Allocate scatter-gather table and its segments
+		 *
+		 * \throw Packet_alloc_failed
+		 */
+		Block::Packet_descriptor _alloc_sg_packet()
+		{
+			Block::Packet_descriptor table =
+				_session.tx()->alloc_packet(sizeof(Block::Sg_table));
+			Block::Sg_table &sg = *(Block::Sg_table *)
+				_session.tx()->packet_content(table);
+
+			table.scatter_gather(true);
+
+			sg.count = 0;
+			try {
+				for (; sg.count < _segments; sg.count++) {
+					Block::Packet_descriptor const s =
+						_session.tx()->alloc_packet(REQUEST_SIZE);
+					sg.segment[sg.count] = { s.offset(), s.size() };
+				}
+			} catch (...) {
+				_release(table);
+				throw;
+			}
+			return table;
+		}
+
+		/**
+		 * Release packet including the segments of a scatter-gather packet
+		 */
+		void _release(Block::Packet_descriptor p)
+		{
+			Block::Sg_table &sg = *(Block::Sg_table *)
+				_session.tx()->packet_content(p);
+
+			if (p.scatter_gather())
+				for (unsigned i = 0; i < sg.count; i++)
+					_session.tx()->release_packet(
+						Block::Packet_descriptor(sg.segment[i].offset,
+						                         sg.segment[i].size));
+
+			_session.tx()->release_packet(p);
+		}
+
 		void _submit()
 		{
-			static size_t count = REQUEST_SIZE / _blk_size;
+			size_t const count = REQUEST_SIZE / _blk_size * max(_segments, 1U);
 
 			if (_read_done && (_write_done || !TEST_WRITE))
 				return;
 
 			try {
 				while (_session.tx()->ready_to_submit()) {
-					Block::Packet_descriptor p(
-						_session.tx()->alloc_packet(REQUEST_SIZE),
+					Block::Packet_descriptor const content = _segments
+						? _alloc_sg_packet()
+						: _session.tx()->alloc_packet(REQUEST_SIZE);
+
+					Block::Packet_descriptor p(content,
 						!_read_done ? Block::Packet_descriptor::READ : Block::Packet_descriptor::WRITE,
 						_current, count);
+					p.scatter_gather(content.scatter_gather());
 
 					_session.tx()->submit_packet(p);
 
@@ -90,9 +148,9 @@ class Throughput
 					      "count: ", p.block_count());
 
 				if (!_read_done || (_read_done &&  p.operation() == Block::Packet_descriptor::WRITE))
-					_bytes += p.size();
+					_bytes += p.block_count() * _blk_size;
 
-				_session.tx()->release_packet(p);
+				_release(p);
 			}
 
 			if (_bytes >= TEST_SIZE) {
@@ -109,9 +167,12 @@ class Throughput
 				return;
 
 			_stop = _timer.elapsed_ms();
+
+			/* avoid division by zero if the run took less than a millisecond */
+			unsigned long const ms = max(_stop - _start, 1UL);
 			log(!_read_done ? "Read" : "Wrote", " ", _bytes / 1024, " KiB in ",
 			    _stop - _start, " ms (",
-				((double)_bytes / (1024 * 1024)) / ((double)(_stop - _start) / 1000),
+				((double)_bytes / (1024 * 1024)) / ((double)ms / 1000),
 				" MiB/s)");
 
 			/* start write */
@@ -132,8 +193,8 @@ class Throughput
 
 	public:
 
-		Throughput(Env & env)
-		: _env(env)
+		Throughput(Env & env, unsigned segments)
+		: _env(env), _segments(min(segments, (unsigned)Block::Sg_table::MAX_SEGMENTS))
 		{
 			_session.tx_channel()->sigh_ack_avail(_disp_ack);
 			_session.tx_channel()->sigh_ready_to_submit(_disp_submit);
@@ -141,12 +202,172 @@ class Throughput
 			Block::Session::Operations blk_ops;
 			_session.info(&_blk_count, &_blk_size, &blk_ops);
 
+			if (_segments && !blk_ops.scatter_gather()) {
+				warning("scatter-gather requests not supported by server");
+				_segments = 0;
+			}
+
 			warning("block count ", _blk_count, " size ", _blk_size);
 			log("read/write ", TEST_SIZE / 1024, " KiB ...");
+			if (_segments)
+				log("scatter-gather requests of ", _segments, " segments");
 			_start = _timer.elapsed_ms();
 			_submit();
 		}
 };
 
 
-void Component::construct(Env &env) { static Throughput test(env); }
+/**
+ * Measure the I/O operations per second at increasing queue depths
+ *
+ * Each request reads 'REQUEST_SIZE' bytes at a pseudo-random position.
+ * The number of requests in flight is kept constant at the current queue
+ * depth, which starts at 1 and doubles up to 'MAX_DEPTH'.
+ */
+class Iops
+{
+	private:
+
+		enum { MAX_DEPTH = 32 };
+
+		Env &             _env;
+		Heap              _heap    { _env.ram(), _env.rm() };
+		Allocator_avl     _alloc   { &_heap };
+		Block::Connection _session { _env, &_alloc, TX_BUFFER };
+		Timer::Connection _timer   { _env };
+
+		Signal_handler<Iops> _disp_ack    { _env.ep(), *this, &Iops::_ack };
+		Signal_handler<Iops> _disp_submit { _env.ep(), *this, &Iops::_submit };
+
+		unsigned long const _requests;
+
+		unsigned        _depth     = 0;
+		unsigned        _in_flight = 0;
+		unsigned long   _submitted = 0;
+		unsigned long   _completed = 0;
+		unsigned long   _start     = 0;
+		uint32_t        _random    = 1;
+
+		size_t          _blk_size;
+		Block::sector_t _blk_count;
+
+		Block::sector_t _random_block()
+		{
+			/* xorshift */
+			_random ^= _random << 13;
+			_random ^= _random >> 17;
+			_random ^= _random << 5;
+
+			Block::sector_t const count = REQUEST_SIZE / _blk_size;
+			return (_random % (_blk_count / count)) * count;
+		}
+
+		void _submit()
+		{
+			if (!_depth)
+				return;
+
+			try {
+				while (_in_flight < _depth && _submitted < _requests
+				       && _session.tx()->ready_to_submit()) {
+
+					Block::Packet_descriptor p(
+						_session.tx()->alloc_packet(REQUEST_SIZE),
+						Block::Packet_descriptor::READ, _random_block(),
+						REQUEST_SIZE / _blk_size);
+
+					_session.tx()->submit_packet(p);
+					_in_flight++;
+					_submitted++;
+				}
+			} catch (...) { }
+		}
+
+		void _ack()
+		{
+			while (_session.tx()->ack_avail()) {
+
+				Block::Packet_descriptor p = _session.tx()->get_acked_packet();
+				if (!p.succeeded())
+					error("packet error: block: ", p.block_number(), " "
+					      "count: ", p.block_count());
+
+				_session.tx()->release_packet(p);
+				_in_flight--;
+				_completed++;
+			}
+
+			if (_completed >= _requests) {
+				_finish();
+				return;
+			}
+
+			_submit();
+		}
+
+		void _start_depth(unsigned depth)
+		{
+			_depth     = depth;
+			_submitted = 0;
+			_completed = 0;
+			_start     = _timer.elapsed_ms();
+			_submit();
+		}
+
+		void _finish()
+		{
+			/* avoid division by zero if the run took less than a millisecond */
+			unsigned long const ms = max(_timer.elapsed_ms() - _start, 1UL);
+
+			log("queue depth ", _depth, ": ", _completed, " requests in ",
+			    ms, " ms (", _completed * 1000 / ms, " IOPS)");
+
+			if (_depth < MAX_DEPTH) {
+				_start_depth(_depth * 2);
+				return;
+			}
+
+			_depth = 0;
+			log("Done");
+		}
+
+	public:
+
+		Iops(Env &env, unsigned long requests)
+		: _env(env), _requests(requests)
+		{
+			_session.tx_channel()->sigh_ack_avail(_disp_ack);
+			_session.tx_channel()->sigh_ready_to_submit(_disp_submit);
+
+			Block::Session::Operations blk_ops;
+			_session.info(&_blk_count, &_blk_size, &blk_ops);
+
+			warning("block count ", _blk_count, " size ", _blk_size);
+			log("random reads of ", REQUEST_SIZE / 1024, " KiB, ",
+			    _requests, " requests per queue depth ...");
+			_start_depth(1);
+		}
+};
+
+
+void Component::construct(Env &env)
+{
+	bool          iops     = false;
+	unsigned long requests = 10000;
+	unsigned      segments = 0;
+
+	try {
+		Attached_rom_dataspace config { env, "config" };
+		iops     = config.xml().attribute_value("iops", iops);
+		requests = max(config.xml().attribute_value("iops_requests", requests),
+		               1UL);
+		segments = config.xml().attribute_value("scatter_gather", segments);
+	} catch (...) { }
+
+	if (iops) {
+		static Iops test(env, requests);
+		return;
+	}
+
+	static Throughput test(env, segments);
+}
@@ -374,6 +374,88 @@ struct Violation_test : Test
 };
 
 
+/**
+ * Check that a flush request acts as barrier
+ *
+ * The flush must not be acknowledged before the writes submitted prior to
+ * it, and the subsequent read must not be acknowledged before the flush.
+ */
+struct Barrier_test : Test
+{
+	enum { WRITES = 4 };
+
+	struct Order_violated : Exception
+	{
+		Block::Packet_descriptor::Opcode op;
+		unsigned                         pos;
+
+		Order_violated(Block::Packet_descriptor::Opcode op, unsigned pos)
+		: op(op), pos(pos) { }
+
+		void print_error() {
+			Genode::error("barrier violated: operation ", (int)op,
+			              " acknowledged at position ", pos); }
+	};
+
+	unsigned acked = 0;
+
+	Barrier_test(Genode::Env &env, Genode::Heap &heap, unsigned timeo)
+	: Test(env, heap, (WRITES + 1)*blk_sz, timeo) {}
+
+	void req(Block::Packet_descriptor::Opcode op, Block::sector_t nr,
+	         Genode::size_t cnt)
+	{
+		Genode::size_t const size = op == Block::Packet_descriptor::FLUSH
+		                          ? 0 : cnt*blk_sz;
+		Block::Packet_descriptor p(_session.dma_alloc_packet(size), op,
+		                           nr, cnt);
+		_session.tx()->submit_packet(p);
+	}
+
+	void perform()
+	{
+		if (!blk_ops.supported(Block::Packet_descriptor::FLUSH))
+			return;
+
+		Genode::log("flush barrier after ", (unsigned)WRITES, " writes");
+
+		for (unsigned i = 0; i < WRITES; i++)
+			req(Block::Packet_descriptor::WRITE, i, 1);
+
+		req(Block::Packet_descriptor::FLUSH, 0, 0);
+		req(Block::Packet_descriptor::READ, 0, 1);
+
+		while (acked < WRITES + 2)
+			_handle_signal();
+	}
+
+	void ack_avail()
+	{
+		_handle = false;
+
+		while (_session.tx()->ack_avail()) {
+			Block::Packet_descriptor p = _session.tx()->get_acked_packet();
+			Block::Packet_descriptor::Opcode const op = p.operation();
+
+			if (!p.succeeded())
+				throw Block_exception(p.block_number(), p.block_count(),
+				                      op != Block::Packet_descriptor::READ);
+
+			bool const in_order =
+				(acked <  WRITES && op == Block::Packet_descriptor::WRITE) ||
+				(acked == WRITES && op == Block::Packet_descriptor::FLUSH) ||
+				(acked >  WRITES && op == Block::Packet_descriptor::READ);
+
+			if (!in_order)
+				throw Order_violated(op, acked);
+
+			_session.tx()->release_packet(p);
+			acked++;
+		}
+	}
+};
+
+
 template <typename TEST>
 void perform(Genode::Env &env, Genode::Heap &heap, unsigned timeo_ms = 0)
 {
@@ -424,6 +506,7 @@ void Component::construct(Genode::Env &env)
 		perform<Read_test<Block::Session::TX_QUEUE_SIZE, 1> >(env, heap);
 		perform<Write_test<Block::Session::TX_QUEUE_SIZE, 8, 16> >(env, heap);
 		perform<Violation_test>(env, heap, 1000);
+		perform<Barrier_test>(env, heap, 1000);
 
 		log("Tests finished successfully!");
 	}
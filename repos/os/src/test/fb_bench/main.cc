@@ -120,12 +120,83 @@ struct Unaligned_blit_test : Test
 	}
 };
 
+struct Kernel_test : Test
+{
+	static constexpr char const *brief = "pixel kernels of blit library from RAM to RAM";
+
+	/* each buffer holds 'h' lines of 32-bit pixels */
+	unsigned const  w     = fb_mode.width();
+	unsigned const  h     = fb_ds.size() / (4*w);
+	unsigned char  *alpha = nullptr;
+
+	template <typename FN>
+	void measure(char const *kernel, unsigned dst_bytes_per_pixel, FN const &fn)
+	{
+		log(kernel, ":");
+
+		unsigned       kib      = 0;
+		unsigned const start_ms = timer.elapsed_ms();
+		for (; timer.elapsed_ms() - start_ms < DURATION_MS/4;) {
+			for (unsigned y = 0; y < h; y++)
+				fn(y);
+			kib += (w * h * dst_bytes_per_pixel) / 1024;
+		}
+		conclusion(kib, start_ms, timer.elapsed_ms());
+	}
+
+	Kernel_test(Env &env, int id, char const *kernels) : Test(env, id, brief)
+	{
+		blit_select_kernels(kernels);
+		log("kernels: ", blit_kernels_name(), "\n");
+
+		if (!heap.alloc(w * h, (void **)&alpha)) {
+			env.parent().exit(-1); }
+
+		/* alpha gradient with a transparent span at the start of each line */
+		for (unsigned i = 0; i < w * h; i++)
+			alpha[i] = (i % w) < w/4 ? 0 : i;
+
+		char       *dst = buf[0];
+		char const *src = buf[1];
+
+		unsigned short       *dst16 = (unsigned short *)dst;
+		unsigned short const *src16 = (unsigned short const *)src;
+		unsigned             *dst32 = (unsigned *)dst;
+		unsigned const       *src32 = (unsigned const *)src;
+
+		unsigned char const dither[16] = { 0, 12, 3, 15, 0, 12, 3, 15,
+		                                   8,  4, 11, 7, 8,  4, 11, 7 };
+
+		measure("copy", 4, [&] (unsigned y) {
+			blit(src + y*w*4, w*4, dst + y*w*4, w*4, w*4, 1); });
+
+		measure("blend RGB565", 2, [&] (unsigned y) {
+			blit_blend_rgb565(dst16 + y*w, src16 + y*w, alpha + y*w, w); });
+
+		measure("blend RGB888", 4, [&] (unsigned y) {
+			blit_blend_rgb888(dst32 + y*w, src32 + y*w, alpha + y*w, w); });
+
+		measure("convert RGB888 to RGB565", 2, [&] (unsigned y) {
+			blit_convert_rgb888_to_rgb565(dst16 + y*w, src32 + y*w, w, dither, 0); });
+
+		measure("convert RGB565 to RGB888", 4, [&] (unsigned y) {
+			blit_convert_rgb565_to_rgb888(dst32 + y*w, src16 + y*w, w); });
+	}
+
+	~Kernel_test()
+	{
+		heap.free(alpha, w * h);
+		blit_select_kernels(nullptr);
+	}
+};
+
 struct Main
 {
 	Constructible<Bytewise_ram_test>   test_1;
 	Constructible<Bytewise_fb_test>    test_2;
 	Constructible<Blit_test>           test_3;
 	Constructible<Unaligned_blit_test> test_4;
+	Constructible<Kernel_test>         test_kernels;
 
 	Main(Env &env)
 	{
@@ -134,6 +205,15 @@ struct Main
 		test_2.construct(env, 2); test_2.destruct();
 		test_3.construct(env, 3); test_3.destruct();
 		test_4.construct(env, 4); test_4.destruct();
+
+		/* benchmark each implementation of the kernels supported by the CPU */
+		char const *kernels[] = { "scalar", "sse2", "avx2", "neon" };
+		int id = 5;
+		for (char const *name : kernels) {
+			if (!blit_select_kernels(name))
+				continue;
+			test_kernels.construct(env, id++, name); test_kernels.destruct();
+		}
 		log("--- Framebuffer benchmark finished ---");
 	}
 };
@@ -231,6 +231,19 @@ class Test::Input_to_filter
 				}
 			});
 		}
+
+		/**
+		 * Submit press and release of the key specified by the 'code'
+		 * attribute of 'step' to the USB input
+		 */
+		void submit_key_stroke(Xml_node step)
+		{
+			Input::Keycode const code =
+				_code(step.attribute_value("code", Key_name()));
+
+			_usb.submit(Input::Event(Input::Event::PRESS,   code, 0, 0, 0, 0));
+			_usb.submit(Input::Event(Input::Event::RELEASE, code, 0, 0, 0, 0));
+		}
 };
 
 
@@ -281,6 +294,38 @@ struct Test::Main : Input_from_filter::Event_handler
 
 	unsigned long _went_to_sleep_time = 0;
 
+	/**
+	 * Latency of character generation, measured by the 'measure_chars' step
+	 *
+	 * For each key stroke, the time from submitting the key press until the
+	 * reception of the generated character is measured.
+	 */
+	struct Char_latency
+	{
+		unsigned long remaining = 0;
+		unsigned long count     = 0;
+		unsigned long start_us  = 0;
+		unsigned long min_us    = ~0UL;
+		unsigned long max_us    = 0;
+		unsigned long sum_us    = 0;
+
+		void add(unsigned long us)
+		{
+			count++;
+			sum_us += us;
+			min_us  = min(min_us, us);
+			max_us  = max(max_us, us);
+		}
+	};
+
+	Constructible<Char_latency> _char_latency;
+
+	void _submit_measured_key_stroke()
+	{
+		_char_latency->start_us = _timer.elapsed_us();
+		_input_to_filter.submit_key_stroke(_curr_step_xml());
+	}
+
 	Xml_node _curr_step_xml() const { return _config.xml().sub_node(_curr_step); }
 
 	void _advance_step()
@@ -305,7 +350,8 @@ struct Test::Main : Input_from_filter::Event_handler
 			                                  step.type() == "expect_release" ||
 			                                  step.type() == "expect_char"    ||
 			                                  step.type() == "expect_motion"  ||
-			                                  step.type() == "expect_wheel");
+			                                  step.type() == "expect_wheel"   ||
+			                                  step.type() == "measure_chars");
 
 			if (step.type() == "filter_config") {
 				_publish_report(_input_filter_config_reporter, step);
@@ -362,6 +408,13 @@ struct Test::Main : Input_from_filter::Event_handler
 			 || step.type() == "expect_wheel")
 				return;
 
+			if (step.type() == "measure_chars") {
+				_char_latency.construct();
+				_char_latency->remaining = step.attribute_value("count", 100UL);
+				_submit_measured_key_stroke();
+				return;
+			}
+
 			if (step.type() == "sleep") {
 				if (_went_to_sleep_time == 0) {
 					unsigned long const timeout_ms = step.attribute_value("ms", 250UL);
@@ -385,6 +438,11 @@ struct Test::Main : Input_from_filter::Event_handler
 
 		Xml_node const step = _curr_step_xml();
 
+		if (step.type() == "measure_chars") {
+			_handle_measured_event(step, ev);
+			return;
+		}
+
 		switch (ev.type()) {
 		case Input::Event::PRESS:
 			if (step.type() == "expect_press"
@@ -427,6 +485,37 @@ struct Test::Main : Input_from_filter::Event_handler
 		_execute_curr_step();
 	}
 
+	void _handle_measured_event(Xml_node step, Input::Event const &ev)
+	{
+		typedef Genode::String<20> Value;
+
+		/* the press and release events are forwarded by the filter as is */
+		if (ev.type() == Input::Event::PRESS || ev.type() == Input::Event::RELEASE)
+			return;
+
+		if (ev.type() != Input::Event::CHARACTER
+		 || step.attribute_value("char", Value()) != Value(Char(ev.utf8().b0))) {
+			error("unexpected event: ", ev);
+			throw Exception();
+		}
+
+		_char_latency->add(_timer.elapsed_us() - _char_latency->start_us);
+
+		if (--_char_latency->remaining) {
+			_submit_measured_key_stroke();
+			return;
+		}
+
+		Char_latency const &latency = *_char_latency;
+		log("character latency of ", latency.count, " key strokes: "
+		    "min=", latency.min_us, " avg=", latency.sum_us/latency.count,
+		    " max=", latency.max_us, " us");
+
+		_char_latency.destruct();
+		_advance_step();
+		_execute_curr_step();
+	}
+
 	void _handle_timer()
 	{
 		if (_curr_step_xml().type() != "sleep") {
@@ -0,0 +1,591 @@
+/*
+ * \brief  Throughput and latency benchmark for the NIC session
+ * \author Genode Labs
+ * \date   2026-10-14
+ *
+ * The component works either as generator or as sink of raw UDP frames. The
+ * generator keeps a configured number of frames in flight and expects each
+ * frame to come back, either reflected by the sink, which swaps the
+ * addresses of the frame, or by a loop-back NIC server. For each configured
+ * pair of frame size and queue depth, the generator reports the packet rate
+ * and percentiles of the round-trip latency.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/*
+ * The network headers come first because they provide the 'ascii_to'
+ * functions needed for reading addresses from the configuration.
+ */
+#include <net/ethernet.h>
+#include <net/arp.h>
+#include <net/ipv4.h>
+#include <net/udp.h>
+#include <nic/xml_node.h>
+
+#include <base/component.h>
+#include <base/log.h>
+#include <base/heap.h>
+#include <base/allocator_avl.h>
+#include <base/attached_rom_dataspace.h>
+#include <nic_session/connection.h>
+#include <nic/packet_allocator.h>
+#include <timer_session/connection.h>
+
+namespace Test {
+
+	struct Payload;
+	struct Latency_histogram;
+	struct Run;
+	struct Main;
+
+	using namespace Genode;
+	using namespace Net;
+}
+
+
+/**
+ * Content of the UDP payload of each benchmark frame
+ */
+struct Test::Payload
+{
+	enum { MAGIC = 0x6e706566 };
+
+	uint32_t magic;
+	uint32_t seq;
+	uint64_t tx_time_us;
+
+} __attribute__((packed));
+
+
+/**
+ * Histogram of latencies with a resolution of one microsecond
+ */
+struct Test::Latency_histogram
+{
+	enum { MAX_US = 4096 };
+
+	unsigned long _counts[MAX_US] { };
+	unsigned long _total  = 0;
+	unsigned long _max_us = 0;
+
+	void add(unsigned long us)
+	{
+		_counts[min(us, (unsigned long)MAX_US - 1)]++;
+		_total++;
+		_max_us = max(_max_us, us);
+	}
+
+	/**
+	 * Return latency not exceeded by the given share of the samples
+	 *
+	 * Latencies beyond the histogram range are reported as 'MAX_US'.
+	 */
+	unsigned long percentile(unsigned per_mille) const
+	{
+		unsigned long const limit = (_total*per_mille + 999) / 1000;
+
+		unsigned long sum = 0;
+		for (unsigned us = 0; us < MAX_US; us++) {
+			sum += _counts[us];
+			if (sum >= limit && sum)
+				return us;
+		}
+		return MAX_US;
+	}
+
+	unsigned long max_us() const { return _max_us; }
+
+	void reset()
+	{
+		for (unsigned us = 0; us < MAX_US; us++)
+			_counts[us] = 0;
+
+		_total = _max_us = 0;
+	}
+};
+
+
+/**
+ * Parameters of one benchmark run as configured via a '<run>' node
+ */
+struct Test::Run
+{
+	size_t   const frame_size;
+	unsigned const queue_depth;
+
+	static size_t _frame_size(Xml_node run)
+	{
+		enum { MIN_FRAME_SIZE = 60, MAX_FRAME_SIZE = 1514 };
+
+		size_t const size = run.attribute_value("frame_size", (size_t)MIN_FRAME_SIZE);
+		return max((size_t)MIN_FRAME_SIZE, min((size_t)MAX_FRAME_SIZE, size));
+	}
+
+	static unsigned _queue_depth(Xml_node run)
+	{
+		unsigned const depth = run.attribute_value("queue_depth", 1U);
+		return max(1U, min(depth, (unsigned)Nic::Session::QUEUE_SIZE - 1));
+	}
+
+	Run(Xml_node run)
+	: frame_size(_frame_size(run)), queue_depth(_queue_depth(run)) { }
+};
+
+
+struct Test::Main
+{
+	enum {
+		BUF_SIZE      = Nic::Packet_allocator::DEFAULT_PACKET_SIZE
+		              * Nic::Session::QUEUE_SIZE,
+		BATCH_SIZE    = 32,
+		TICK_US       = 10*1000,
+		DRAIN_TIME_US = 100*1000,
+	};
+
+	enum State { RESOLVE, RUNNING, DRAINING, FINISHED };
+
+	Env &_env;
+
+	Attached_rom_dataspace _config { _env, "config" };
+
+	Heap              _heap           { _env.ram(), _env.rm() };
+	Allocator_avl     _tx_block_alloc { &_heap };
+	Nic::Connection   _nic            { _env, &_tx_block_alloc, BUF_SIZE, BUF_SIZE };
+	Timer::Connection _timer          { _env };
+
+	Xml_node _config_xml() const { return _config.xml(); }
+
+	bool         const _generator { _config_xml().attribute_value("mode", String<16>("generator")) == "generator" };
+	Mac_address  const _mac       { _nic.mac_address() };
+	Ipv4_address const _ip        { _config_xml().attribute_value("ip",      Ipv4_address()) };
+	Ipv4_address const _dst_ip    { _config_xml().attribute_value("dst_ip",  Ipv4_address()) };
+	Ipv4_address const _gateway   { _config_xml().attribute_value("gateway", Ipv4_address()) };
+	Port         const _port      { _config_xml().attribute_value("port",    Port(7777)) };
+	uint64_t     const _duration_us { _config_xml().attribute_value("duration_ms", 1000UL) * 1000 };
+
+	/*
+	 * If no destination MAC address is configured, the generator resolves
+	 * the address of the gateway, or of the destination if there is no
+	 * gateway, via ARP.
+	 */
+	bool        const _dst_mac_configured { _config_xml().has_attribute("dst_mac") };
+	Mac_address       _dst_mac { _config_xml().attribute_value("dst_mac", Mac_address()) };
+
+	State _state = RESOLVE;
+
+	Latency_histogram _latency { };
+
+	/* state of the current run */
+	unsigned _run_idx     = 0;
+	size_t   _frame_size  = 0;
+	unsigned _queue_depth = 0;
+	unsigned _seq         = 0;
+	unsigned _in_flight   = 0;
+
+	unsigned long _tx_cnt = 0, _rx_cnt = 0, _lost_cnt = 0;
+	unsigned long _rx_cnt_last_tick = 0;
+
+	uint64_t _start_us = 0, _end_us = 0, _last_rx_us = 0;
+
+	/* frames allocated but not submitted yet */
+	Packet_descriptor _tx_batch[BATCH_SIZE];
+	unsigned          _tx_batch_cnt = 0;
+
+	uint64_t _now_us() { return _timer.curr_time().trunc_to_plain_us().value; }
+
+	void _flush_tx()
+	{
+		unsigned submitted = 0;
+		while (submitted < _tx_batch_cnt)
+			submitted += _nic.tx()->submit_packets(_tx_batch + submitted,
+			                                       _tx_batch_cnt - submitted);
+		_tx_batch_cnt = 0;
+	}
+
+	/**
+	 * Allocate and fill frame, deferring its submission to '_flush_tx'
+	 *
+	 * \return false if the transmit buffer is exhausted
+	 */
+	template <typename FN>
+	bool _send(size_t size, FN const &write)
+	{
+		if (_tx_batch_cnt == BATCH_SIZE)
+			_flush_tx();
+
+		Packet_descriptor packet;
+		try { packet = _nic.tx()->alloc_packet(size); }
+		catch (Nic::Session::Tx::Source::Packet_alloc_failed) { return false; }
+
+		write(_nic.tx()->packet_content(packet));
+		_tx_batch[_tx_batch_cnt++] = packet;
+		return true;
+	}
+
+	void _release_acked_packets()
+	{
+		Packet_descriptor acked[BATCH_SIZE];
+		while (unsigned const n = _nic.tx()->get_acked_packets(acked, BATCH_SIZE))
+			for (unsigned i = 0; i < n; i++)
+				_nic.tx()->release_packet(acked[i]);
+	}
+
+
+	/*********
+	 ** ARP **
+	 *********/
+
+	Ipv4_address _arp_target() const {
+		return _gateway.valid() ? _gateway : _dst_ip; }
+
+	void _send_arp(Arp_packet::Opcode opcode, Mac_address dst_mac,
+	               Ipv4_address dst_ip)
+	{
+		enum { ARP_FRAME_SIZE = sizeof(Ethernet_frame) + sizeof(Arp_packet) };
+
+		_send(ARP_FRAME_SIZE, [&] (char *content) {
+
+			Ethernet_frame &eth = *new (content) Ethernet_frame();
+			eth.dst(opcode == Arp_packet::REQUEST ? Ethernet_frame::BROADCAST : dst_mac);
+			eth.src(_mac);
+			eth.type(Ethernet_frame::Type::ARP);
+
+			Arp_packet &arp = *new (eth.data<void>()) Arp_packet(sizeof(Arp_packet));
+			arp.hardware_address_type(Arp_packet::ETHERNET);
+			arp.protocol_address_type((uint16_t)Ethernet_frame::Type::IPV4);
+			arp.hardware_address_size(Ethernet_frame::ADDR_LEN);
+			arp.protocol_address_size(Ipv4_packet::ADDR_LEN);
+			arp.opcode(opcode);
+			arp.src_mac(_mac);
+			arp.src_ip(_ip);
+			arp.dst_mac(dst_mac);
+			arp.dst_ip(dst_ip);
+		});
+	}
+
+	void _handle_arp(Ethernet_frame &eth, size_t size)
+	{
+		Arp_packet &arp = *new (eth.data<void>())
+			Arp_packet(size - sizeof(Ethernet_frame));
+
+		if (!arp.ethernet_ipv4())
+			return;
+
+		if (arp.opcode() == Arp_packet::REQUEST && arp.dst_ip() == _ip) {
+			_send_arp(Arp_packet::REPLY, arp.src_mac(), arp.src_ip());
+			return;
+		}
+
+		if (arp.opcode() == Arp_packet::REPLY && _state == RESOLVE
+		 && arp.src_ip() == _arp_target()) {
+
+			_dst_mac = arp.src_mac();
+			log("resolved ", _arp_target(), " to ", _dst_mac);
+			_start_run();
+		}
+	}
+
+
+	/*********
+	 ** UDP **
+	 *********/
+
+	/**
+	 * Return payload of a benchmark frame or nullptr
+	 */
+	Payload *_payload(Ethernet_frame &eth, size_t size)
+	{
+		size_t const ip_size = size - sizeof(Ethernet_frame);
+		Ipv4_packet &ip = *new (eth.data<void>()) Ipv4_packet(ip_size);
+
+		if (ip.protocol() != Ipv4_packet::Protocol::UDP)
+			return nullptr;
+
+		Udp_packet &udp = *new (ip.data<void>())
+			Udp_packet(ip_size - sizeof(Ipv4_packet));
+
+		if (!(udp.dst_port() == _port)
+		 || ip_size < sizeof(Ipv4_packet) + sizeof(Udp_packet) + sizeof(Payload))
+			return nullptr;
+
+		Payload &payload = *udp.data<Payload>();
+		return payload.magic == Payload::MAGIC ? &payload : nullptr;
+	}
+
+	void _write_frame(char *content)
+	{
+		Ethernet_frame &eth = *new (content) Ethernet_frame();
+		eth.dst(_dst_mac);
+		eth.src(_mac);
+		eth.type(Ethernet_frame::Type::IPV4);
+
+		/*
+		 * Clear the IP and UDP headers at once. A UDP checksum of zero means
+		 * that there is none, which spares the generator from touching the
+		 * whole payload of each frame.
+		 */
+		size_t const ip_size = _frame_size - sizeof(Ethernet_frame);
+		memset(eth.data<void>(), 0, sizeof(Ipv4_packet) + sizeof(Udp_packet));
+
+		Ipv4_packet &ip = *new (eth.data<void>()) Ipv4_packet(ip_size);
+		ip.header_length(sizeof(Ipv4_packet) / 4);
+		ip.version(4);
+		ip.total_length(ip_size);
+		ip.time_to_live(64);
+		ip.protocol(Ipv4_packet::Protocol::UDP);
+		ip.src(_ip);
+		ip.dst(_dst_ip);
+		ip.checksum(Ipv4_packet::calculate_checksum(ip));
+
+		Udp_packet &udp = *new (ip.data<void>())
+			Udp_packet(ip_size - sizeof(Ipv4_packet));
+		udp.src_port(_port);
+		udp.dst_port(_port);
+		udp.length(ip_size - sizeof(Ipv4_packet));
+
+		Payload &payload = *udp.data<Payload>();
+		payload.magic      = Payload::MAGIC;
+		payload.seq        = _seq++;
+		payload.tx_time_us = _now_us();
+	}
+
+	/**
+	 * Send frame back to its origin
+	 *
+	 * Swapping the addresses does not change the IP and UDP checksums. If
+	 * the transmit buffer is exhausted, the frame is dropped.
+	 */
+	void _reflect(Ethernet_frame const &rx_eth, size_t size)
+	{
+		_send(size, [&] (char *content) {
+
+			memcpy(content, &rx_eth, size);
+
+			Ethernet_frame &eth = *(Ethernet_frame *)content;
+			eth.dst(rx_eth.src());
+			eth.src(_mac);
+
+			Ipv4_packet &ip = *eth.data<Ipv4_packet>();
+			Ipv4_address const src_ip = ip.src();
+			ip.src(ip.dst());
+			ip.dst(src_ip);
+		});
+	}
+
+	void _handle_frame(void *content, size_t size)
+	{
+		try {
+			Ethernet_frame &eth = *new (content) Ethernet_frame(size);
+
+			switch (eth.type()) {
+
+			case Ethernet_frame::Type::ARP:
+				_handle_arp(eth, size);
+				return;
+
+			case Ethernet_frame::Type::IPV4:
+				{
+					Payload const *payload = _payload(eth, size);
+					if (!payload)
+						return;
+
+					if (!_generator) {
+						_reflect(eth, size);
+						return;
+					}
+
+					/* ignore frames of previous runs */
+					if (_state != RUNNING && _state != DRAINING)
+						return;
+
+					if (size != _frame_size || _in_flight == 0)
+						return;
+
+					_last_rx_us = _now_us();
+					_latency.add(_last_rx_us - payload->tx_time_us);
+					_rx_cnt++;
+					_in_flight--;
+				}
+				return;
+			}
+		}
+		catch (Ethernet_frame::No_ethernet_frame) { }
+		catch (Arp_packet::No_arp_packet)         { }
+		catch (Ipv4_packet::No_ip_packet)         { }
+		catch (Udp_packet::No_udp_packet)         { }
+	}
+
+
+	/****************
+	 ** Generation **
+	 ****************/
+
+	void _fill_queue()
+	{
+		if (_state != RUNNING)
+			return;
+
+		while (_in_flight < _queue_depth) {
+			if (!_send(_frame_size, [&] (char *content) { _write_frame(content); }))
+				break;
+
+			_in_flight++;
+			_tx_cnt++;
+		}
+	}
+
+	void _start_run()
+	{
+		unsigned idx = 0;
+		_config_xml().for_each_sub_node("run", [&] (Xml_node node) {
+			if (idx++ != _run_idx)
+				return;
+
+			Run const run(node);
+			_frame_size  = run.frame_size;
+			_queue_depth = run.queue_depth;
+		});
+
+		if (_run_idx >= idx) {
+			_state = FINISHED;
+			log("--- benchmark finished ---");
+			_env.parent().exit(0);
+			return;
+		}
+
+		_latency.reset();
+		_in_flight = 0;
+		_tx_cnt = _rx_cnt = _lost_cnt = _rx_cnt_last_tick = 0;
+		_state    = RUNNING;
+		_start_us = _last_rx_us = _now_us();
+
+		_fill_queue();
+	}
+
+	void _report()
+	{
+		uint64_t const elapsed_us = max(_last_rx_us - _start_us, (uint64_t)1);
+		unsigned long const pps   = (unsigned long)(_rx_cnt*1000000ULL / elapsed_us);
+		unsigned long const mbps  = (unsigned long)(_rx_cnt*_frame_size*8 / elapsed_us);
+
+		log("frame_size=", _frame_size, " queue_depth=", _queue_depth, ": ",
+		    "tx=", _tx_cnt, " rx=", _rx_cnt, " lost=", _lost_cnt, " ",
+		    "pps=", pps, " mbit/s=", mbps, " ",
+		    "latency_us p50=", _latency.percentile(500),
+		    " p90=",  _latency.percentile(900),
+		    " p99=",  _latency.percentile(990),
+		    " p999=", _latency.percentile(999),
+		    " max=",  _latency.max_us());
+	}
+
+	void _handle_tick(Duration)
+	{
+		uint64_t const now_us = _now_us();
+
+		switch (_state) {
+
+		case RESOLVE:
+
+			/* repeat ARP request until it got answered */
+			_send_arp(Arp_packet::REQUEST, Mac_address(), _arp_target());
+			break;
+
+		case RUNNING:
+
+			/*
+			 * Frames dropped on the way would stall the generator otherwise,
+			 * hence, frames are considered lost if nothing arrived in a tick.
+			 */
+			if (_rx_cnt == _rx_cnt_last_tick && _in_flight) {
+				_lost_cnt += _in_flight;
+				_in_flight = 0;
+			}
+			_rx_cnt_last_tick = _rx_cnt;
+
+			if (now_us - _start_us >= _duration_us) {
+				_state  = DRAINING;
+				_end_us = now_us;
+			}
+			_fill_queue();
+			break;
+
+		case DRAINING:
+
+			if (_in_flight && now_us - _end_us < DRAIN_TIME_US)
+				break;
+
+			_lost_cnt += _in_flight;
+			_report();
+			_run_idx++;
+			_start_run();
+			break;
+
+		case FINISHED: break;
+		}
+
+		_flush_tx();
+	}
+
+	Timer::Periodic_timeout<Main> _tick {
+		_timer, *this, &Main::_handle_tick, Microseconds(TICK_US) };
+
+
+	/*********
+	 ** NIC **
+	 *********/
+
+	void _handle_nic()
+	{
+		_release_acked_packets();
+
+		Packet_descriptor rx[BATCH_SIZE];
+		for (;;) {
+			unsigned const max_cnt = min((unsigned)BATCH_SIZE,
+			                             _nic.rx()->ack_slots_free());
+			unsigned const n = max_cnt ? _nic.rx()->get_packets(rx, max_cnt) : 0;
+			if (!n)
+				break;
+
+			for (unsigned i = 0; i < n; i++)
+				_handle_frame(_nic.rx()->packet_content(rx[i]), rx[i].size());
+
+			_nic.rx()->acknowledge_packets(rx, n);
+
+			_fill_queue();
+			_flush_tx();
+		}
+
+		_fill_queue();
+		_flush_tx();
+	}
+
+	Signal_handler<Main> _nic_handler { _env.ep(), *this, &Main::_handle_nic };
+
+	Main(Env &env) : _env(env)
+	{
+		_nic.tx_channel()->sigh_ready_to_submit(_nic_handler);
+		_nic.tx_channel()->sigh_ack_avail      (_nic_handler);
+		_nic.rx_channel()->sigh_ready_to_ack   (_nic_handler);
+		_nic.rx_channel()->sigh_packet_avail   (_nic_handler);
+
+		log("--- NIC ", _generator ? "generator" : "sink", " (mac=", _mac,
+		    " ip=", _ip, ") ---");
+
+		if (!_generator)
+			return;
+
+		if (_dst_mac_configured)
+			_start_run();
+		else
+			_handle_tick(Duration(Microseconds(0)));
+	}
+};
+
+
+void Component::construct(Genode::Env &env) { static Test::Main main(env); }
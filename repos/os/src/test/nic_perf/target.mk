@@ -0,0 +1,3 @@
+TARGET = test-nic_perf
+SRC_CC = main.cc
+LIBS   = base net
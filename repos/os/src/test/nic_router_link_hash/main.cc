@@ -0,0 +1,161 @@
+/*
+ * \brief  Compare link lookup via AVL tree and hash table of the NIC router
+ * \author Genode Labs
+ * \date   2026-10-14
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/component.h>
+#include <base/heap.h>
+#include <base/log.h>
+#include <timer_session/connection.h>
+#include <util/avl_tree.h>
+
+/* NIC router includes */
+#include <hash_table.h>
+
+using namespace Genode;
+
+
+/**
+ * Key that resembles the 'Link_side_id' of the NIC router
+ */
+struct Flow_id
+{
+	uint32_t src_ip;
+	uint16_t src_port;
+	uint32_t dst_ip;
+	uint16_t dst_port;
+
+	uint32_t hash() const
+	{
+		uint32_t hash = 2166136261U;
+		uint8_t const *byte = (uint8_t const *)this;
+		for (size_t i = 0; i < sizeof(*this); i++) {
+			hash = (hash ^ byte[i]) * 16777619U; }
+
+		return hash;
+	}
+
+	bool operator == (Flow_id const &id) const {
+		return memcmp(&id, this, sizeof(*this)) == 0; }
+
+	bool operator > (Flow_id const &id) const {
+		return memcmp(&id, this, sizeof(*this)) > 0; }
+
+} __attribute__((packed));
+
+
+struct Flow : Avl_node<Flow>
+{
+	Flow_id const id;
+
+	Flow(Flow_id const &id) : id(id) { }
+
+	Flow_id const &hash_key() const { return id; }
+
+	bool higher(Flow *flow) { return flow->id > id; }
+
+	Flow const *find_by_id(Flow_id const &other) const
+	{
+		if (other == id) {
+			return this; }
+
+		Flow const *const flow = Avl_node<Flow>::child(other > id);
+		return flow ? flow->find_by_id(other) : nullptr;
+	}
+};
+
+
+struct Main
+{
+	Env               &env;
+	Heap               heap   { env.ram(), env.rm() };
+	Timer::Connection  timer  { env };
+
+	unsigned long _now_us() {
+		return timer.curr_time().trunc_to_plain_us().value; }
+
+	static Flow_id _flow_id(unsigned i)
+	{
+		/* mimic NAT flows from a subnet to a few servers */
+		return Flow_id { 0x0a000000U + (i & 0xffff), (uint16_t)(49152 + (i >> 16)),
+		                 0xc0a80100U + (i % 7), 443 };
+	}
+
+	void _bench(unsigned const nr_of_flows)
+	{
+		Flow **flows = (Flow **)static_cast<Allocator &>(heap)
+		                    .alloc(nr_of_flows * sizeof(Flow *));
+		for (unsigned i = 0; i < nr_of_flows; i++) {
+			flows[i] = new (heap) Flow(_flow_id(i)); }
+
+		Avl_tree<Flow>                tree;
+		Net::Hash_table<Flow, Flow_id> table(heap);
+
+		unsigned long found = 0;
+
+		/* AVL tree */
+		unsigned long t0 = _now_us();
+		for (unsigned i = 0; i < nr_of_flows; i++) {
+			tree.insert(flows[i]); }
+
+		unsigned long t1 = _now_us();
+		for (unsigned i = 0; i < nr_of_flows; i++) {
+			if (tree.first()->find_by_id(_flow_id((i * 7919) % nr_of_flows))) {
+				found++; } }
+
+		unsigned long t2 = _now_us();
+
+		/* hash table */
+		for (unsigned i = 0; i < nr_of_flows; i++) {
+			table.insert(*flows[i]); }
+
+		unsigned long t3 = _now_us();
+		for (unsigned i = 0; i < nr_of_flows; i++) {
+			try {
+				table.find(_flow_id((i * 7919) % nr_of_flows));
+				found++;
+			}
+			catch (Net::Hash_table<Flow, Flow_id>::No_match) { }
+		}
+		unsigned long t4 = _now_us();
+
+		if (found != 2UL * nr_of_flows) {
+			error("lookup failed for ", 2UL * nr_of_flows - found, " flows"); }
+
+		log("flows=", nr_of_flows,
+		    " avl: insert=", t1 - t0, "us lookup=", t2 - t1, "us",
+		    " hash: insert=", t3 - t2, "us lookup=", t4 - t3, "us");
+
+		for (unsigned i = 0; i < nr_of_flows; i++) {
+			table.remove(*flows[i]);
+			tree.remove(flows[i]);
+			destroy(heap, flows[i]);
+		}
+		if (table.count()) {
+			error("hash table not empty after removal"); }
+
+		heap.free(flows, nr_of_flows * sizeof(Flow *));
+	}
+
+	Main(Env &env) : env(env)
+	{
+		log("--- NIC router link-lookup benchmark ---");
+		_bench(1000);
+		_bench(10000);
+		_bench(100000);
+		log("--- benchmark finished ---");
+		env.parent().exit(0);
+	}
+};
+
+
+void Component::construct(Env &env) { static Main main(env); }
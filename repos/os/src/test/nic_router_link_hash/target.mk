@@ -0,0 +1,4 @@
+TARGET   = test-nic_router_link_hash
+SRC_CC   = main.cc
+LIBS    += base
+INC_DIR += $(REP_DIR)/src/server/nic_router
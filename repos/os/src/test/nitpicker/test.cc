@@ -15,6 +15,7 @@
 #include <util/list.h>
 #include <base/component.h>
 #include <base/log.h>
+#include <base/attached_rom_dataspace.h>
 #include <nitpicker_session/connection.h>
 #include <timer_session/connection.h>
 #include <input/event.h>
@@ -141,6 +142,70 @@ class Test_view_stack : public List<Test_view>
 };
 
 
+/**
+ * Measure the pixels redrawn by nitpicker per frame
+ *
+ * Two small views in opposite corners of the screen are moved at each frame.
+ * The redrawn pixels are obtained from the "redraw" report of nitpicker,
+ * which is expected to be provided as ROM module.
+ */
+static void measure_redraw(Env &env, Nitpicker::Connection &nitpicker,
+                           Timer::Connection &timer, Xml_node config)
+{
+	unsigned const frames = config.attribute_value("frames", 100U);
+	int      const size   = config.attribute_value("view_size", 32U);
+
+	Framebuffer::Mode const screen = nitpicker.mode();
+	int const scr_w = screen.width(), scr_h = screen.height();
+
+	Attached_rom_dataspace redraw(env, "redraw");
+
+	struct Stats
+	{
+		unsigned long frames = 0, rects = 0, pixels = 0;
+
+		Stats(Xml_node node)
+		:
+			frames(node.attribute_value("frames", 0UL)),
+			rects (node.attribute_value("rects",  0UL)),
+			pixels(node.attribute_value("pixels", 0UL))
+		{ }
+	};
+
+	static Test_view tl(&nitpicker, 0, 0, size, size, "top-left");
+	static Test_view br(&nitpicker, scr_w - 2*size, scr_h - 2*size, size, size,
+	                    "bottom-right");
+
+	/* let the initial redraw of the views settle */
+	timer.msleep(500);
+	redraw.update();
+	Stats const start(redraw.xml());
+
+	for (unsigned i = 0; i < frames; i++) {
+		int const d = (i % (unsigned)size);
+		tl.move(d, d);
+		br.move(scr_w - 2*size + d, scr_h - 2*size + d);
+		timer.msleep(20);
+	}
+
+	timer.msleep(100);
+	redraw.update();
+	Stats const end(redraw.xml());
+
+	unsigned long const drawn_frames = end.frames - start.frames;
+	unsigned long const pixels       = end.pixels - start.pixels;
+	unsigned long const rects        = end.rects  - start.rects;
+
+	log("redrawn frames: ", drawn_frames, " rects: ", rects, " pixels: ", pixels);
+
+	if (drawn_frames)
+		log("redrawn pixels per frame: ", pixels / drawn_frames, " "
+		    "(screen has ", scr_w*scr_h, " pixels)");
+
+	log("--- nitpicker redraw measurement finished ---");
+}
+
+
 void Component::construct(Genode::Env &env)
 {
 	/*
@@ -153,6 +218,22 @@ void Component::construct(Genode::Env &env)
 	Framebuffer::Mode const mode(256, 256, Framebuffer::Mode::RGB565);
 	nitpicker.buffer(mode, false);
 
+	/* the test is started without configuration in interactive scenarios */
+	bool measure = false;
+	try {
+		Attached_rom_dataspace config(env, "config");
+		if (config.xml().has_sub_node("measure-redraw")) {
+			measure_redraw(env, nitpicker, timer,
+			               config.xml().sub_node("measure-redraw"));
+			measure = true;
+		}
+	} catch (Genode::Rom_connection::Rom_connection_failed) { }
+
+	if (measure) {
+		env.parent().exit(0);
+		return;
+	}
+
 	int const scr_w = mode.width(), scr_h = mode.height();
 
 	log("screen is ", mode);
@@ -0,0 +1,178 @@
+/*
+ * \brief  Unit test for RAM fs extent data structure
+ * \author Genode Labs
+ * \date   2026-10-14
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/heap.h>
+#include <base/component.h>
+#include <ram_fs/extent.h>
+
+using namespace File_system;
+using namespace Genode;
+
+/* the smallest possible extents exercise all boundary cases */
+struct Extents : Extent_tree<64>
+{
+	enum { MAX_PRINT = 256 };
+
+	Extents(Allocator &alloc) : Extent_tree(alloc) { }
+
+	void print(Output &out) const
+	{
+		static char read_buf[MAX_PRINT];
+
+		Extents &e = const_cast<Extents &>(*this);
+		file_size_t const size = e.used_size();
+		if (size > MAX_PRINT) {
+			Genode::print(out, "content (size=", size, ")");
+			return;
+		}
+
+		e.read(read_buf, size, 0);
+		Genode::print(out, "content (size=", size, "): ");
+		Genode::print(out, "\"");
+		for (unsigned i = 0; i < size; i++) {
+			char const c = read_buf[i];
+			if (c) {
+				Genode::print(out, Char(c)); }
+			else {
+				Genode::print(out, "."); }
+		}
+		Genode::print(out, "\"");
+	}
+};
+
+struct Allocator_tracer : Allocator
+{
+	struct Alloc
+	{
+		using Id = Id_space<Alloc>::Id;
+
+		Id_space<Alloc>::Element id_space_elem;
+		size_t                   size;
+
+		Alloc(Id_space<Alloc> &space, Id id, size_t size)
+		: id_space_elem(*this, space, id), size(size) { }
+	};
+
+	Id_space<Alloc>  allocs;
+	size_t           sum { 0 };
+	unsigned         count { 0 };
+	Allocator       &wrapped;
+
+	Allocator_tracer(Allocator &wrapped) : wrapped(wrapped) { }
+
+	bool alloc(size_t size, void **out_addr) override
+	{
+		sum += size;
+		count++;
+		bool result = wrapped.alloc(size, out_addr);
+		new (wrapped) Alloc(allocs, Alloc::Id { (addr_t)*out_addr }, size);
+		return result;
+	}
+
+	void free(void *addr, size_t size) override
+	{
+		allocs.apply<Alloc>(Alloc::Id { (addr_t)addr }, [&] (Alloc &alloc) {
+			sum -= alloc.size;
+			destroy(wrapped, &alloc);
+			wrapped.free(addr, size);
+		});
+	}
+
+	size_t overhead(size_t size) const override { return wrapped.overhead(size); }
+	bool   need_size_for_free()  const override { return wrapped.need_size_for_free(); }
+};
+
+struct Main
+{
+	Env              &env;
+	Heap              heap  { env.ram(), env.rm() };
+	Allocator_tracer  alloc { heap };
+
+	Main(Env &env) : env(env)
+	{
+		log("--- RAM filesystem extent test ---");
+		{
+			Extents extents(alloc);
+			write(extents, "five-o-one", 0);
+
+			/* overwrite part of the file */
+			write(extents, "five", 7);
+
+			/* write to position beyond current file length */
+			write(extents, "Nuance", 17);
+			write(extents, "YM-2149", 35);
+
+			/* write across an extent boundary into a hole */
+			write(extents, "boundary", 60);
+
+			/* fill the hole in front of the backed part of an extent */
+			write(extents, "front", 64);
+
+			/* sparse write far beyond any fixed-geometry limit */
+			write(extents, "far", 1ULL << 40);
+			read(extents, (1ULL << 40) - 2, 7);
+			truncate(extents, 68);
+
+			/* copy-on-write clone */
+			{
+				Extents copy(alloc);
+				/* cloning allocates extents but no buffers */
+				unsigned const count = alloc.count;
+				copy.clone(extents);
+				log("clone: buffers=", copy.buffer_size(),
+				    " allocations=", alloc.count - count);
+
+				/* the first write copies the affected buffer only */
+				write(copy, "COPY", 0);
+				log("copy: buffers=", copy.buffer_size(),
+				    " allocations=", alloc.count - count);
+				log("origin -> ", extents);
+				truncate(copy, 10);
+				log("origin -> ", extents);
+			}
+
+			truncate(extents, 30);
+			for (unsigned i = 29; i > 0; i--)
+				truncate(extents, i);
+		}
+		log("allocator: sum=", alloc.sum);
+		log("--- RAM filesystem extent test finished ---");
+	}
+
+	void write(Extents &extents, char const *str, seek_off_t seek_offset)
+	{
+		extents.write(str, strlen(str), seek_offset);
+		log("write \"", str, "\" at offset ", seek_offset, " -> ", extents);
+	}
+
+	void read(Extents &extents, seek_off_t seek_offset, size_t len)
+	{
+		char buf[16];
+		extents.read(buf, len, seek_offset);
+
+		for (unsigned i = 0; i < len; i++)
+			if (!buf[i]) buf[i] = '.';
+
+		log("read ", len, " bytes at offset ", seek_offset, " -> \"",
+		    Cstring(buf, len), "\"");
+	}
+
+	void truncate(Extents &extents, file_size_t size)
+	{
+		extents.truncate(size);
+		log("trunc(", size, ") -> ", extents);
+	}
+};
+
+void Component::construct(Env &env) { struct Main main(env); }
@@ -0,0 +1,3 @@
+TARGET   = test-ram_fs_extent
+SRC_CC   = main.cc
+LIBS     = base
@@ -48,7 +48,47 @@ struct Test::Main
 
 	enum State { WAIT_FOR_FIRST_UPDATE,
 	             WAIT_FOR_TIMEOUT,
-	             WAIT_FOR_SECOND_UPDATE } _state = WAIT_FOR_FIRST_UPDATE;
+	             WAIT_FOR_SECOND_UPDATE,
+	             WAIT_FOR_NO_UPDATE } _state = WAIT_FOR_FIRST_UPDATE;
+
+	void _test_chunked_report()
+	{
+		enum { SIZE = 3*4096 + 100 };
+
+		static char content[SIZE];
+		for (unsigned i = 0; i < SIZE; i++)
+			content[i] = 'a' + (i % 26);
+
+		log("Reporter: submit report that exceeds the report buffer");
+		Reporter large { _env, "large" };
+		large.max_report_size(4*4096);
+		large.enabled(true);
+		large.report(content, SIZE);
+
+		Attached_rom_dataspace rom { _env, "large" };
+		ASSERT(rom.valid());
+		ASSERT(rom.size() >= SIZE);
+		ASSERT(memcmp(rom.local_addr<char const>(), content, SIZE) == 0);
+		log("ROM client: got chunked report of ", (unsigned)SIZE, " bytes - OK");
+	}
+
+	void _finish()
+	{
+		try {
+			log("ROM client: try to open the same report again");
+			Reporter again { _env, "brightness" };
+			again.enabled(true);
+			error("expected Service_denied");
+			throw -3;
+		}
+		catch (Service_denied) {
+			log("ROM client: caught Service_denied - OK"); }
+
+		_test_chunked_report();
+
+		log("--- test-report_rom finished ---");
+		_env.parent().exit(0);
+	}
 
 	void _handle_rom_update()
 	{
@@ -69,20 +109,19 @@ struct Test::Main
 		}
 
 		if (_state == WAIT_FOR_SECOND_UPDATE) {
-			try {
-				log("ROM client: try to open the same report again");
-				Reporter again { _env, "brightness" };
-				again.enabled(true);
-				error("expected Service_denied");
-				throw -3;
-			}
-			catch (Service_denied) {
-				log("ROM client: caught Service_denied - OK"); }
 
-			log("--- test-report_rom finished ---");
-			_env.parent().exit(0);
+			log("Reporter: report unchanged brightness, wait a bit");
+			_report_brightness(99);
+
+			_timer.trigger_once(250*1000);
+			_state = WAIT_FOR_NO_UPDATE;
 			return;
 		}
+
+		if (_state == WAIT_FOR_NO_UPDATE) {
+			error("unexpected notification about unchanged report");
+			_env.parent().exit(-1);
+		}
 	}
 
 	Signal_handler<Main> _rom_update_handler {
@@ -111,6 +150,13 @@ struct Test::Main
 			_state = WAIT_FOR_SECOND_UPDATE;
 			return;
 		}
+
+		if (_state == WAIT_FOR_NO_UPDATE) {
+			log("got timeout");
+			log("ROM client: no notification about unchanged report - OK");
+			_finish();
+			return;
+		}
 	}
 
 	Signal_handler<Main> _timer_handler {
@@ -0,0 +1,181 @@
+/*
+ * \brief  Measure the wake-up latency of a periodically woken component
+ * \author Genode Labs
+ * \date   2026-10-14
+ *
+ * In the spirit of cyclictest, the component repeatedly schedules a timeout
+ * and records how late the timeout handler is executed compared to the
+ * deadline. Combined with background load of a differing priority or CPU
+ * quota, the latency reflects the time needed to preempt the load. The
+ * result is printed as histogram.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/component.h>
+#include <base/attached_rom_dataspace.h>
+#include <base/log.h>
+#include <timer_session/connection.h>
+
+namespace Test {
+
+	using namespace Genode;
+
+	class Histogram;
+	struct Main;
+}
+
+
+class Test::Histogram
+{
+	public:
+
+		enum { MAX_BUCKETS = 256 };
+
+	private:
+
+		unsigned long const _bucket_us;
+
+		unsigned long _buckets[MAX_BUCKETS + 1] { };
+
+		unsigned long _samples = 0;
+		unsigned long _min_us  = ~0UL;
+		unsigned long _max_us  = 0;
+		unsigned long _sum_us  = 0;
+
+		/*
+		 * Smallest latency that is not exceeded by the given percentage of
+		 * samples, expressed as upper bound of the corresponding bucket
+		 */
+		unsigned long _percentile_us(unsigned percent) const
+		{
+			unsigned long const threshold = (_samples*percent + 99)/100;
+
+			unsigned long count = 0;
+			for (unsigned i = 0; i < MAX_BUCKETS; i++) {
+				count += _buckets[i];
+				if (count >= threshold)
+					return (i + 1)*_bucket_us;
+			}
+			return _max_us;
+		}
+
+	public:
+
+		Histogram(unsigned long bucket_us) : _bucket_us(max(1UL, bucket_us)) { }
+
+		void add(unsigned long latency_us)
+		{
+			_buckets[min((unsigned long)MAX_BUCKETS, latency_us/_bucket_us)]++;
+
+			_samples++;
+			_sum_us += latency_us;
+			_min_us  = min(_min_us, latency_us);
+			_max_us  = max(_max_us, latency_us);
+		}
+
+		unsigned long samples() const { return _samples; }
+
+		void print(char const *name) const
+		{
+			if (!_samples)
+				return;
+
+			log("<histogram name=\"", name, "\" unit=\"us\""
+			    " bucket=\"", _bucket_us, "\""
+			    " samples=\"", _samples, "\""
+			    " min=\"", _min_us, "\""
+			    " avg=\"", _sum_us/_samples, "\""
+			    " p99=\"", _percentile_us(99), "\""
+			    " max=\"", _max_us, "\">");
+
+			for (unsigned i = 0; i < MAX_BUCKETS; i++)
+				if (_buckets[i])
+					log("\t<bucket from=\"", i*_bucket_us, "\""
+					    " count=\"", _buckets[i], "\"/>");
+
+			if (_buckets[MAX_BUCKETS])
+				log("\t<overflow from=\"", MAX_BUCKETS*_bucket_us, "\""
+				    " count=\"", _buckets[MAX_BUCKETS], "\"/>");
+
+			log("</histogram>");
+		}
+};
+
+
+struct Test::Main
+{
+	Env &_env;
+
+	Attached_rom_dataspace _config { _env, "config" };
+
+	Timer::Connection _timer { _env };
+
+	typedef String<64> Name;
+
+	Name const _name = _config.xml().attribute_value("name", Name("wakeup"));
+
+	unsigned long const _interval_us =
+		_config.xml().attribute_value("interval_us", 1000UL);
+
+	unsigned long const _samples =
+		_config.xml().attribute_value("samples", 10000UL);
+
+	/* number of initial samples that are not recorded */
+	unsigned long const _warmup =
+		_config.xml().attribute_value("warmup", 100UL);
+
+	unsigned long _woken = 0;
+
+	unsigned long _deadline_us = 0;
+
+	Histogram _histogram {
+		_config.xml().attribute_value("bucket_us", 10UL) };
+
+	Timer::One_shot_timeout<Main> _timeout {
+		_timer, *this, &Main::_handle_timeout };
+
+	unsigned long _curr_us() { return _timer.curr_time().trunc_to_plain_us().value; }
+
+	void _schedule()
+	{
+		_deadline_us = _curr_us() + _interval_us;
+		_timeout.schedule(Microseconds(_interval_us));
+	}
+
+	void _handle_timeout(Duration)
+	{
+		unsigned long const now_us = _curr_us();
+
+		/* a timeout that fired early counts as zero latency */
+		unsigned long const latency_us =
+			now_us > _deadline_us ? now_us - _deadline_us : 0;
+
+		if (_woken++ >= _warmup)
+			_histogram.add(latency_us);
+
+		if (_histogram.samples() < _samples) {
+			_schedule();
+			return;
+		}
+
+		_histogram.print(_name.string());
+		_env.parent().exit(0);
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		log("measure wake-up latency: ", _samples, " samples, interval ",
+		    _interval_us, " us");
+		_schedule();
+	}
+};
+
+
+void Component::construct(Genode::Env &env) { static Test::Main main(env); }
@@ -31,6 +31,7 @@ struct Main
 	struct Block_operation_failed : Exception { };
 
 	enum Operation { READ, WRITE };
+	enum Pattern   { SEQUENTIAL, RANDOM };
 
 	struct Driver_session : Block::Driver_session_base
 	{
@@ -48,17 +49,20 @@ struct Main
 		}
 	};
 
+	enum { NR_OF_REQ_SIZES = 12, NR_OF_RUNS = 4 };
+
 	Env                    &env;
 	Packet_descriptor       pkt;
 	unsigned long           time_before_ms;
 	Timer::Connection       timer        { env };
 	Operation               operation    { READ };
+	Pattern                 pattern      { SEQUENTIAL };
 	Signal_handler<Main>    ack_handler  { env.ep(), *this, &Main::update_state };
 	Driver_session          drv_session  { ack_handler };
 	Sd_card::Driver         drv          { env };
-	size_t const            buf_size_kib { Attached_rom_dataspace(env, "config")
-	                                       .xml().attribute_value("buffer_size_kib",
-	                                                              (size_t)0) };
+	Attached_rom_dataspace  config       { env, "config" };
+	size_t const            buf_size_kib { config.xml().attribute_value("buffer_size_kib",
+	                                                                    (size_t)0) };
 	size_t const            buf_size     { buf_size_kib * 1024 };
 	Attached_ram_dataspace  buf          { env.ram(), env.rm(), buf_size, UNCACHED };
 	char                   *buf_virt     { buf.local_addr<char>() };
@@ -67,12 +71,104 @@ struct Main
 	size_t                  buf_off_done { 0 };
 	size_t                  buf_off_pend { 0 };
 	unsigned                req_size_id  { 0 };
-	size_t                  req_sizes[9] { 512, 1024, 1024 * 2,  1024 * 4,
+	size_t                  req_sizes[NR_OF_REQ_SIZES]
+	                                     { 512, 1024, 1024 * 2,  1024 * 4,
 	                                       1024 * 8,  1024 * 16, 1024 * 32,
-	                                       1024 * 64, 1024 * 128 };
+	                                       1024 * 64, 1024 * 128, 1024 * 256,
+	                                       1024 * 512, 1024 * 1024 };
+
+	/*
+	 * Random requests target the first 'random_area_kib' KiB of the card,
+	 * which get overwritten by the random writes
+	 */
+	Block::sector_t const   random_area  {
+		min(config.xml().attribute_value("random_area_kib", 16 * buf_size_kib)
+		    * 1024 / drv.block_size(), (size_t)drv.block_count()) };
+	uint32_t                random       { 1 };
+
+	/* throughput in KiB/sec per run and request size */
+	size_t                  results[NR_OF_RUNS][NR_OF_REQ_SIZES] { };
 
 	size_t req_size() const { return req_sizes[req_size_id]; }
 
+	unsigned run() const { return pattern * 2 + operation; }
+
+	/**
+	 * Return true if the request size fits into the buffer and the area
+	 */
+	bool req_size_valid()
+	{
+		return req_size_id < NR_OF_REQ_SIZES &&
+		       req_size() <= buf_size &&
+		       req_size() / drv.block_size() <= random_area;
+	}
+
+	Block::sector_t block_nr()
+	{
+		if (pattern == SEQUENTIAL) {
+			return buf_off_pend / drv.block_size(); }
+
+		/* xorshift */
+		random ^= random << 13;
+		random ^= random >> 17;
+		random ^= random << 5;
+
+		Block::sector_t const cnt = req_size() / drv.block_size();
+		return (random % (random_area / cnt)) * cnt;
+	}
+
+	void log_run()
+	{
+		static char const *names[NR_OF_RUNS] = {
+			"-- sequential reading from SD card --",
+			"-- sequential writing to SD card --",
+			"-- random reading from SD card --",
+			"-- random writing to SD card --" };
+
+		log("");
+		log(names[run()]);
+	}
+
+	void log_summary()
+	{
+		log("");
+		log("--- SD card benchmark summary (KiB/sec) ---");
+		for (unsigned i = 0; i < NR_OF_REQ_SIZES; i++) {
+			if (!results[0][i]) {
+				continue; }
+			log("   ", req_sizes[i], " bytes:"
+			    " seq read ",   results[0][i], ","
+			    " seq write ",  results[1][i], ","
+			    " rand read ",  results[2][i], ","
+			    " rand write ", results[3][i]);
+		}
+	}
+
+	/**
+	 * Go to the next request size, operation, or pattern
+	 *
+	 * \return false if all runs are done
+	 */
+	bool next_run()
+	{
+		req_size_id++;
+		if (req_size_valid()) {
+			return true; }
+
+		req_size_id = 0;
+		switch (operation) {
+		case READ:  operation = WRITE; break;
+		case WRITE:
+			operation = READ;
+			if (pattern == RANDOM) {
+				return false; }
+			pattern = RANDOM;
+			break;
+		}
+		log_run();
+		return true;
+	}
+
 	void update_state()
 	{
 		/* raise done counter and check if the buffer is full */
@@ -82,33 +178,27 @@ struct Main
 
 			/* print stats for the current request size */
 			unsigned long const time_after_ms = timer.elapsed_ms();
-			unsigned long const duration_ms   = time_after_ms - time_before_ms;
+			unsigned long const duration_ms   = max(time_after_ms - time_before_ms,
+			                                        1UL);
 			size_t        const kib_per_sec   = (1000 * buf_size_kib) /
 			                                    duration_ms;
 			log("      duration:   ", duration_ms,  " ms");
 			log("      amount:     ", buf_size_kib, " KiB");
 			log("      throughput: ", kib_per_sec,  " KiB/sec");
+			if (pattern == RANDOM) {
+				log("      requests:   ", (1000 * (buf_size / req_size())) /
+				                          duration_ms, " per sec"); }
+
+			results[run()][req_size_id] = kib_per_sec;
 
 			/* go to next request size */
 			buf_off_pend = 0;
 			buf_off_done = 0;
-			req_size_id++;
-
-			/* check if we have done all request sizes for an operation */
-			if (req_size_id == sizeof(req_sizes)/sizeof(req_sizes[0])) {
-
-				/* go to next operation or end the test */
+			if (!next_run()) {
+				log_summary();
 				log("");
-				req_size_id = 0;
-				switch (operation) {
-				case READ:
-					operation = WRITE;
-					log("-- writing to SD card --");
-					break;
-				case WRITE:
-					log("--- SD card benchmark finished ---");
-					return;
-				}
+				log("--- SD card benchmark finished ---");
+				return;
 			}
 			log("   request size ", req_size(), " bytes");
 			time_before_ms = timer.elapsed_ms();
@@ -119,7 +209,7 @@ struct Main
 			for (; buf_off_pend < buf_size; buf_off_pend += req_size()) {
 
 				/* calculate block offset */
-				addr_t const nr  = buf_off_pend / drv.block_size();
+				Block::sector_t const nr = block_nr();
 
 				if (drv.dma_enabled()) {
 
@@ -144,13 +234,13 @@ struct Main
 	Main(Env &env) : env(env)
 	{
 		log("");
-		log("--- SD card benchmark (", drv.dma_enabled() ? "with" : "no", " DMA) ---");
+		log("--- SD card benchmark (", drv.dma_enabled() ? "with" : "no", " DMA, ",
+		    drv.command_slots(), " requests in flight) ---");
 
 		drv.session(&drv_session);
 
 		/* start issuing requests */
-		log("");
-		log("-- reading from SD card --");
+		log_run();
 		log("   request size ", req_size(), " bytes");
 		time_before_ms = timer.elapsed_ms();
 		update_state();
@@ -0,0 +1,216 @@
+/*
+ * \brief  Throughput test for crosslinked terminal sessions
+ * \author Genode Labs
+ * \date   2026-10-14
+ *
+ * A writer thread streams a test pattern through a pair of crosslinked
+ * terminal sessions to a reader thread, which validates the data. The
+ * transfer is repeated for each I/O buffer size given in the
+ * configuration, e.g.,
+ *
+ * ! <config size_kib="16384">
+ * !   <round io_buffer_size="4096"/>
+ * !   <round io_buffer_size="65536"/>
+ * ! </config>
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#include <base/attached_rom_dataspace.h>
+#include <base/component.h>
+#include <base/heap.h>
+#include <base/thread.h>
+#include <terminal_session/connection.h>
+#include <timer_session/connection.h>
+
+namespace Test_terminal_crosslink_bench {
+
+	using namespace Genode;
+
+	class Writer;
+	class Reader;
+	struct Main;
+
+	enum { STACK_SIZE = sizeof(addr_t)*2048 };
+
+	static unsigned char pattern(size_t offset) {
+		return (unsigned char)(offset*7 + (offset >> 12)); }
+}
+
+
+class Test_terminal_crosslink_bench::Writer : public Thread
+{
+	private:
+
+		Terminal::Connection _terminal;
+
+		size_t const   _total;
+		unsigned char *_buf;
+		size_t const   _buf_size;
+
+	public:
+
+		Writer(Env &env, unsigned char *buf, size_t buf_size, size_t total)
+		:
+			Thread(env, "writer", STACK_SIZE),
+			_terminal(env, "writer", buf_size),
+			_total(total), _buf(buf), _buf_size(buf_size)
+		{ }
+
+		void entry() override
+		{
+			size_t offset = 0;
+
+			while (offset < _total) {
+
+				size_t const len = min(_buf_size, _total - offset);
+				for (size_t i = 0; i < len; i++)
+					_buf[i] = pattern(offset + i);
+
+				for (size_t written = 0; written < len; )
+					written += _terminal.write(_buf + written, len - written);
+
+				offset += len;
+			}
+		}
+};
+
+
+class Test_terminal_crosslink_bench::Reader : public Thread
+{
+	private:
+
+		Terminal::Connection _terminal;
+
+		Signal_receiver _sig_rec;
+		Signal_context  _sig_ctx;
+
+		size_t const   _total;
+		unsigned char *_buf;
+		size_t const   _buf_size;
+
+	public:
+
+		size_t   signals = 0;
+		size_t   reads   = 0;
+		bool     valid   = true;
+
+		Reader(Env &env, unsigned char *buf, size_t buf_size, size_t total)
+		:
+			Thread(env, "reader", STACK_SIZE),
+			_terminal(env, "reader", buf_size),
+			_total(total), _buf(buf), _buf_size(buf_size)
+		{
+			_terminal.read_avail_sigh(_sig_rec.manage(&_sig_ctx));
+		}
+
+		~Reader() { _sig_rec.dissolve(&_sig_ctx); }
+
+		void entry() override
+		{
+			size_t offset = 0;
+
+			while (offset < _total) {
+
+				_sig_rec.wait_for_signal();
+				signals++;
+
+				/* drain all data available */
+				while (size_t const n = _terminal.read(_buf, _buf_size)) {
+					reads++;
+
+					for (size_t i = 0; i < n && valid; i++)
+						if (_buf[i] != pattern(offset + i)) {
+							error("unexpected data at offset ", offset + i);
+							valid = false;
+						}
+
+					offset += n;
+				}
+			}
+		}
+};
+
+
+struct Test_terminal_crosslink_bench::Main
+{
+	Env &_env;
+
+	Heap       _heap  { _env.ram(), _env.rm() };
+	Allocator &_alloc { _heap };
+
+	Attached_rom_dataspace _config { _env, "config" };
+
+	Timer::Connection _timer { _env };
+
+	/**
+	 * Transfer 'total' bytes
+	 *
+	 * \return false on data corruption
+	 */
+	bool _round(size_t io_buffer_size, size_t total)
+	{
+		unsigned char *write_buf = (unsigned char *)_alloc.alloc(io_buffer_size);
+		unsigned char *read_buf  = (unsigned char *)_alloc.alloc(io_buffer_size);
+
+		bool valid = true;
+		{
+			Reader reader(_env, read_buf,  io_buffer_size, total);
+			Writer writer(_env, write_buf, io_buffer_size, total);
+
+			unsigned long const start_ms = _timer.elapsed_ms();
+
+			reader.start();
+			writer.start();
+			writer.join();
+			reader.join();
+
+			unsigned long const ms = max(_timer.elapsed_ms() - start_ms, 1UL);
+
+			log("io_buffer_size=", io_buffer_size, ": ",
+			    total/1024, " KiB in ", ms, " ms, ",
+			    (total/1024)*1000/ms, " KiB/s, ",
+			    reader.reads, " reads, ", reader.signals, " signals");
+
+			valid = reader.valid;
+		}
+
+		_alloc.free(write_buf, io_buffer_size);
+		_alloc.free(read_buf,  io_buffer_size);
+		return valid;
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		Xml_node const config = _config.xml();
+
+		size_t const total = config.attribute_value("size_kib", 16*1024UL)*1024;
+
+		bool valid = true;
+		config.for_each_sub_node("round", [&] (Xml_node round) {
+			if (valid)
+				valid = _round(round.attribute_value("io_buffer_size", 4096UL),
+				               total);
+		});
+
+		if (!valid) {
+			error("test failed");
+			env.parent().exit(1);
+			return;
+		}
+
+		log("Test succeeded");
+		env.parent().exit(0);
+	}
+};
+
+
+void Component::construct(Genode::Env &env)
+{
+	static Test_terminal_crosslink_bench::Main main(env);
+}
@@ -18,6 +18,7 @@
 #include <util/fifo.h>
 #include <util/misc_math.h>
 #include <base/attached_rom_dataspace.h>
+#include <base/heap.h>
 
 using namespace Genode;
 
@@ -764,16 +765,184 @@ struct Fast_polling : Test
 };
 
 
+struct Scheduler_benchmark : Test
+{
+	static constexpr char const *brief = "compare the costs of timeout schedulers";
+
+	enum { NR_OF_TIMEOUTS = 4000, MAX_DURATION_US = 1000000 };
+
+	/**
+	 * Time source that advances only when told to
+	 */
+	struct Manual_time_source : Time_source
+	{
+		unsigned long    now_us  = 0;
+		Timeout_handler *handler = nullptr;
+
+		Duration curr_time() override { return Duration(Microseconds(now_us)); }
+
+		Microseconds max_timeout() const override {
+			return Microseconds(~0UL >> 1); }
+
+		void schedule_timeout(Microseconds, Timeout_handler &handler) override {
+			this->handler = &handler; }
+	};
+
+	struct Counter : Timeout::Handler
+	{
+		unsigned long count = 0;
+
+		void handle_timeout(Duration) override { count++; }
+	};
+
+	Heap heap { env.ram(), env.rm() };
+
+	unsigned long _random = 12345;
+
+	unsigned long _duration_us()
+	{
+		_random = _random*1103515245UL + 12345UL;
+		return 1 + (_random >> 8) % MAX_DURATION_US;
+	}
+
+	unsigned long _elapsed_us(unsigned long start_us) {
+		return timer.curr_time().trunc_to_plain_us().value - start_us; }
+
+	template <typename SCHEDULER>
+	void _measure(char const *name)
+	{
+		Manual_time_source time_source;
+		SCHEDULER          scheduler(time_source);
+		Counter            counter;
+
+		Allocator &alloc    = heap;
+		Timeout  **timeouts = (Timeout **)
+			alloc.alloc(NR_OF_TIMEOUTS*sizeof(Timeout *));
+
+		for (unsigned i = 0; i < NR_OF_TIMEOUTS; i++)
+			timeouts[i] = new (heap) Timeout(scheduler);
+
+		_random = 12345;
+		unsigned long start_us = _elapsed_us(0);
+		for (unsigned i = 0; i < NR_OF_TIMEOUTS; i++)
+			timeouts[i]->schedule_one_shot(Microseconds(_duration_us()), counter);
+		unsigned long const schedule_us = _elapsed_us(start_us);
+
+		start_us = _elapsed_us(0);
+		for (unsigned i = 0; i < NR_OF_TIMEOUTS; i += 2)
+			timeouts[i]->discard();
+		unsigned long const discard_us = _elapsed_us(start_us);
+
+		/* let the remaining timeouts trigger */
+		time_source.now_us = MAX_DURATION_US + 1;
+		if (time_source.handler)
+			time_source.handler->handle_timeout(time_source.curr_time());
+
+		log(name, ": scheduled ", (unsigned)NR_OF_TIMEOUTS, " timeouts in ",
+		    schedule_us, " us, discarded half of them in ", discard_us, " us");
+
+		if (counter.count != NR_OF_TIMEOUTS / 2) {
+			error(name, ": ", counter.count, " timeouts triggered, expected ",
+			      (unsigned)NR_OF_TIMEOUTS / 2);
+			error_cnt++;
+		}
+
+		for (unsigned i = 0; i < NR_OF_TIMEOUTS; i++)
+			destroy(heap, timeouts[i]);
+
+		heap.free(timeouts, NR_OF_TIMEOUTS*sizeof(Timeout *));
+	}
+
+	struct Trigger_time : Timeout::Handler
+	{
+		Manual_time_source &time_source;
+		unsigned long       triggered_us = 0;
+		bool                triggered    = false;
+
+		Trigger_time(Manual_time_source &time_source)
+		: time_source(time_source) { }
+
+		void handle_timeout(Duration) override
+		{
+			triggered_us = time_source.now_us;
+			triggered    = true;
+		}
+	};
+
+	/**
+	 * Check that one-shot timeouts of the wheel scheduler never trigger early
+	 *
+	 * The timeouts are scheduled at times that do not coincide with a tick
+	 * of the wheel.
+	 */
+	void _check_not_early()
+	{
+		enum { PRECISION_US = 1000, STEP_US = 10 };
+
+		unsigned long const start_offsets_us[] = { 0, 1, 500, 999 };
+		unsigned long const durations_us[]     = { 1, 999, 1000, 1001, 25000 };
+
+		for (unsigned long const offset_us : start_offsets_us) {
+			for (unsigned long const duration_us : durations_us) {
+
+				Manual_time_source      time_source;
+				Wheel_timeout_scheduler scheduler(time_source,
+				                                  Microseconds(PRECISION_US));
+				Trigger_time            trigger(time_source);
+				Timeout                 timeout(scheduler);
+
+				time_source.now_us = PRECISION_US + offset_us;
+				unsigned long const start_us = time_source.now_us;
+
+				timeout.schedule_one_shot(Microseconds(duration_us), trigger);
+
+				while (!trigger.triggered
+				    && time_source.now_us < start_us + duration_us + 2*PRECISION_US) {
+
+					time_source.now_us += STEP_US;
+					if (time_source.handler)
+						time_source.handler->handle_timeout(time_source.curr_time());
+				}
+
+				unsigned long const elapsed_us = trigger.triggered_us - start_us;
+
+				if (!trigger.triggered || elapsed_us < duration_us) {
+					error("wheel scheduler: timeout of ", duration_us, " us "
+					      "scheduled at ", start_us, " us triggered after ",
+					      trigger.triggered ? elapsed_us : 0UL, " us");
+					error_cnt++;
+				}
+			}
+		}
+	}
+
+	Scheduler_benchmark(Env                       &env,
+	                    unsigned                  &error_cnt,
+	                    Signal_context_capability  done,
+	                    unsigned                   id)
+	:
+		Test(env, error_cnt, done, id, brief)
+	{
+		_measure<Alarm_timeout_scheduler>("alarm scheduler");
+		_measure<Wheel_timeout_scheduler>("wheel scheduler");
+		_check_not_early();
+		Test::done.submit();
+	}
+};
+
+
 struct Main
 {
-	Env                           &env;
-	unsigned                       error_cnt   { 0 };
-	Constructible<Duration_test>   test_1;
-	Constructible<Fast_polling>    test_2;
-	Constructible<Mixed_timeouts>  test_3;
-	Signal_handler<Main>           test_1_done { env.ep(), *this, &Main::handle_test_1_done };
-	Signal_handler<Main>           test_2_done { env.ep(), *this, &Main::handle_test_2_done };
-	Signal_handler<Main>           test_3_done { env.ep(), *this, &Main::handle_test_3_done };
+	Env                                &env;
+	unsigned                            error_cnt   { 0 };
+	Constructible<Duration_test>        test_1;
+	Constructible<Fast_polling>         test_2;
+	Constructible<Mixed_timeouts>       test_3;
+	Constructible<Scheduler_benchmark>  test_4;
+	Signal_handler<Main>                test_1_done { env.ep(), *this, &Main::handle_test_1_done };
+	Signal_handler<Main>                test_2_done { env.ep(), *this, &Main::handle_test_2_done };
+	Signal_handler<Main>                test_3_done { env.ep(), *this, &Main::handle_test_3_done };
+	Signal_handler<Main>                test_4_done { env.ep(), *this, &Main::handle_test_4_done };
 
 	Main(Env &env) : env(env)
 	{
@@ -795,6 +964,12 @@ struct Main
 	void handle_test_3_done()
 	{
 		test_3.destruct();
+		test_4.construct(env, error_cnt, test_4_done, 4);
+	}
+
+	void handle_test_4_done()
+	{
+		test_4.destruct();
 		if (error_cnt) {
 			error("test failed because of ", error_cnt, " error(s)");
 			env.parent().exit(-1);
@@ -0,0 +1,181 @@
+/*
+ * \brief  Test for the range allocator with segregated free lists
+ * \author Genode Labs
+ * \date   2026-10-14
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/component.h>
+#include <base/heap.h>
+#include <base/log.h>
+#include <base/allocator_avl.h>
+#include <os/tlsf_allocator.h>
+
+using namespace Genode;
+
+
+struct Failed { };
+
+
+static void check(bool condition, char const *what)
+{
+	if (condition)
+		return;
+
+	error("check failed: ", what);
+	throw Failed();
+}
+
+
+/**
+ * Linear-congruential generator for reproducible allocation patterns
+ */
+struct Random
+{
+	unsigned long _value = 12345;
+
+	unsigned long next(unsigned long limit)
+	{
+		_value = _value*1103515245UL + 12345UL;
+		return (_value >> 8) % limit;
+	}
+};
+
+
+/**
+ * Allocation pattern of a long-running packet allocator
+ *
+ * Packets of varying sizes are kept in flight and released in an order
+ * that differs from the allocation order. Each allocation is checked
+ * against the ranges of all packets in flight.
+ *
+ * \return  number of failed allocations
+ */
+static unsigned long packet_pattern(Range_allocator &alloc, size_t range_size,
+                                    unsigned long rounds)
+{
+	enum { MAX_IN_FLIGHT = 128 };
+
+	struct Packet { addr_t addr; size_t size; } packets[MAX_IN_FLIGHT] { };
+
+	Random random;
+	unsigned long failed = 0;
+
+	for (unsigned long i = 0; i < rounds; i++) {
+
+		Packet &p = packets[random.next(MAX_IN_FLIGHT)];
+
+		if (p.size) {
+			alloc.free((void *)p.addr, p.size);
+			p.size = 0;
+			continue;
+		}
+
+		size_t const size = random.next(8) ? 512 + random.next(4096)
+		                                   : 64*1024 + random.next(64*1024);
+		void *addr = nullptr;
+		if (alloc.alloc_aligned(size, &addr, log2(16)).error()) {
+			failed++;
+			continue;
+		}
+
+		check(((addr_t)addr & 15) == 0, "alignment");
+		check((addr_t)addr + size <= range_size, "allocation within range");
+
+		for (Packet const &q : packets)
+			check(!q.size || (addr_t)addr + size <= q.addr
+			              || q.addr + q.size <= (addr_t)addr, "no overlap");
+
+		p.addr = (addr_t)addr;
+		p.size = size;
+	}
+
+	for (Packet &p : packets)
+		if (p.size)
+			alloc.free((void *)p.addr, p.size);
+
+	return failed;
+}
+
+
+static void test_range_operations(Allocator &md_alloc)
+{
+	Tlsf_allocator alloc(&md_alloc);
+
+	check(alloc.add_range(0x1000, 0x1000) == 0, "add range");
+	check(alloc.add_range(0x2000, 0x1000) == 0, "add adjacent range");
+	check(alloc.add_range(0x2800, 0x100)  != 0, "reject overlapping range");
+	check(alloc.avail() == 0x2000, "avail after adding ranges");
+
+	/* adjacent ranges are merged */
+	void *addr = nullptr;
+	check(alloc.alloc_aligned(0x2000, &addr, 0).ok() && addr == (void *)0x1000,
+	      "allocate merged ranges at once");
+	check(alloc.valid_addr(0x2fff) && !alloc.valid_addr(0x3000), "valid_addr");
+	alloc.free(addr);
+
+	check(alloc.alloc_addr(0x100, 0x1800).ok(), "alloc_addr");
+	check(alloc.alloc_addr(0x10, 0x18f0).error(), "alloc_addr of used range");
+	check(alloc.size_at((void *)0x1800) == 0x100, "size_at");
+
+	check(alloc.alloc_aligned(0x100, &addr, 12).ok() && addr == (void *)0x2000,
+	      "page-aligned allocation");
+	alloc.free(addr);
+
+	check(alloc.alloc_aligned(0x100, &addr, 4, 0x2400, 0x24ff).ok()
+	      && addr == (void *)0x2400, "allocation within bounds");
+	check(alloc.alloc_aligned(0x100, &addr, 4, 0x2400, 0x24ff).error(),
+	      "allocation beyond bounds");
+	alloc.free((void *)0x2400);
+	alloc.free((void *)0x1800);
+
+	check(alloc.avail() == 0x2000, "avail after freeing all blocks");
+	check(alloc.remove_range(0x1000, 0x1000) == 0, "remove range");
+	check(alloc.avail() == 0x1000, "avail after removing range");
+
+	log("range operations succeeded");
+}
+
+
+void Component::construct(Env &env)
+{
+	static Heap heap(env.ram(), env.rm());
+
+	log("--- TLSF allocator test ---");
+
+	try {
+		test_range_operations(heap);
+
+		enum { RANGE_SIZE = 4*1024*1024, ROUNDS = 200000 };
+
+		size_t const md_before = heap.consumed();
+		{
+			Tlsf_allocator tlsf(&heap);
+			tlsf.add_range(0, RANGE_SIZE);
+
+			unsigned long const failed = packet_pattern(tlsf, RANGE_SIZE, ROUNDS);
+			log("packet pattern: ", failed, " failed allocations");
+
+			check(tlsf.avail() == RANGE_SIZE, "all packets freed");
+		}
+		check(heap.consumed() == md_before, "meta data released");
+
+		{
+			Allocator_avl avl(&heap);
+			avl.add_range(0x10, RANGE_SIZE - 0x10);
+
+			unsigned long const failed = packet_pattern(avl, RANGE_SIZE, ROUNDS);
+			log("packet pattern with AVL allocator: ", failed, " failed allocations");
+		}
+	}
+	catch (Failed) { return; }
+
+	log("--- TLSF allocator test finished ---");
+}
@@ -0,0 +1,3 @@
+TARGET = test-tlsf_allocator
+SRC_CC = main.cc
+LIBS   = base
@@ -0,0 +1,606 @@
+/*
+ * \brief  VFS throughput and latency benchmark
+ * \author Genode Labs
+ * \date   2026-10-14
+ *
+ * The benchmark drives the VFS configured at its '<vfs>' config node, i.e.,
+ * any local file system or a file-system server via the 'fs' plugin. It
+ * measures the rates of metadata operations and the throughput and latency
+ * of sequential and random block I/O for an increasing number of
+ * concurrently served files. The results are logged and reported as
+ * "results" report.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <vfs/file_system_factory.h>
+#include <vfs/dir_file_system.h>
+#include <timer_session/connection.h>
+#include <base/heap.h>
+#include <base/attached_rom_dataspace.h>
+#include <base/snprintf.h>
+#include <base/component.h>
+#include <base/log.h>
+#include <os/reporter.h>
+
+namespace Vfs_bench {
+
+	using namespace Genode;
+
+	typedef Genode::Path<Vfs::MAX_PATH_LEN> Path;
+
+	struct Failed : Exception { };
+
+	class Latency;
+	struct Result;
+	struct Main;
+}
+
+
+/**
+ * Collection of latency samples, reduced to percentiles
+ *
+ * If more operations are measured than samples fit, a uniform random
+ * subset of the samples is kept (reservoir sampling).
+ */
+class Vfs_bench::Latency
+{
+	private:
+
+		enum { MAX_SAMPLES = 4096 };
+
+		unsigned long _samples[MAX_SAMPLES];
+		unsigned      _num  = 0;
+		unsigned long _seen = 0;
+		unsigned long _max  = 0;
+		unsigned long _rand = 0x2545f491;
+
+		unsigned long _random()
+		{
+			_rand ^= _rand << 13;
+			_rand ^= _rand >> 17;
+			_rand ^= _rand << 5;
+			return _rand;
+		}
+
+		bool _sorted = false;
+
+		void _sort()
+		{
+			/* shell sort with Knuth's gap sequence */
+			unsigned gap = 1;
+			while (gap < _num / 3)
+				gap = 3*gap + 1;
+
+			for (; gap; gap /= 3)
+				for (unsigned i = gap; i < _num; i++) {
+					unsigned long const v = _samples[i];
+					unsigned j = i;
+					for (; j >= gap && _samples[j - gap] > v; j -= gap)
+						_samples[j] = _samples[j - gap];
+					_samples[j] = v;
+				}
+
+			_sorted = true;
+		}
+
+	public:
+
+		void reset() { _num = 0; _seen = 0; _max = 0; _sorted = false; }
+
+		void add(unsigned long us)
+		{
+			_max = max(_max, us);
+			_seen++;
+			_sorted = false;
+
+			if (_num < MAX_SAMPLES) {
+				_samples[_num++] = us;
+				return;
+			}
+
+			unsigned long const i = _random() % _seen;
+			if (i < MAX_SAMPLES)
+				_samples[i] = us;
+		}
+
+		/**
+		 * Return latency in microseconds below which 'permille' of the
+		 * samples lie
+		 */
+		unsigned long percentile(unsigned permille)
+		{
+			if (!_num)
+				return 0;
+
+			if (!_sorted)
+				_sort();
+
+			return _samples[min(_num - 1, (_num * permille) / 1000)];
+		}
+
+		unsigned long max_us() const { return _max; }
+};
+
+
+struct Vfs_bench::Result
+{
+	char const    *op;
+	unsigned       concurrency;
+	unsigned long  ops;
+	unsigned long  bytes;
+	unsigned long  elapsed_us;
+	unsigned long  p50, p90, p99, max;
+
+	unsigned long ops_per_s() const {
+		return elapsed_us ? (unsigned long)((1000000ULL*ops) / elapsed_us) : 0; }
+
+	unsigned long kib_per_s() const {
+		return elapsed_us ? (unsigned long)((1000000ULL*bytes/1024) / elapsed_us) : 0; }
+
+	void print(Output &out) const
+	{
+		Genode::print(out, op, " concurrency=", concurrency, ": ",
+		              ops, " ops in ", elapsed_us, " us, ",
+		              ops_per_s(), " ops/s");
+
+		if (bytes)
+			Genode::print(out, ", ", kib_per_s(), " KiB/s");
+
+		Genode::print(out, ", latency p50=", p50, " p90=", p90,
+		              " p99=", p99, " max=", max, " us");
+	}
+};
+
+
+struct Vfs_bench::Main
+{
+	Env &_env;
+
+	Heap _heap { _env.ram(), _env.rm() };
+
+	Attached_rom_dataspace _config_rom { _env, "config" };
+
+	Xml_node const _config = _config_rom.xml();
+
+	Timer::Connection _timer { _env };
+
+	struct Io_response_handler : Vfs::Io_response_handler
+	{
+		void handle_io_response(Vfs::Vfs_handle::Context *) override { }
+	} _io_response_handler;
+
+	Vfs::Global_file_system_factory _fs_factory { _heap };
+
+	Vfs::Dir_file_system _vfs { _env, _heap, _config.sub_node("vfs"),
+	                            _io_response_handler, _fs_factory,
+	                            Vfs::Dir_file_system::Root() };
+
+	enum { MAX_FILES = 256 };
+
+	typedef String<64> Label;
+
+	Label    const _label      = _config.attribute_value("label", Label("vfs"));
+	Path     const _dir        = _config.attribute_value("dir", String<Vfs::MAX_PATH_LEN>("/bench")).string();
+	unsigned const _files      = max(1U, min((unsigned)MAX_FILES, _config.attribute_value("files", 32U)));
+	size_t   const _block_size = max((size_t)1, (size_t)_config.attribute_value("block_size", Number_of_bytes(4096)));
+	size_t   const _file_size  = max(_block_size, (size_t)_config.attribute_value("file_size", Number_of_bytes(64*1024)));
+	unsigned const _rounds     = max(1U, _config.attribute_value("rounds", 4U));
+	unsigned const _max_conc   = max(1U, min(_files, _config.attribute_value("max_concurrency", 8U)));
+	bool     const _read_only  = _config.attribute_value("read_only", false);
+
+	unsigned long const _blocks_per_file = _file_size / _block_size;
+
+	enum { MAX_RESULTS = 64 };
+
+	Result   _results[MAX_RESULTS];
+	unsigned _num_results = 0;
+
+	Latency _latency;
+
+	Reporter _reporter { _env, "results", "results", 16*1024 };
+
+	unsigned long _now_us() { return _timer.curr_time().trunc_to_plain_us().value; }
+
+	unsigned long _rand = 0x9e3779b9;
+
+	unsigned long _random()
+	{
+		_rand ^= _rand << 13;
+		_rand ^= _rand >> 17;
+		_rand ^= _rand << 5;
+		return _rand;
+	}
+
+	Path _file_path(unsigned i) const
+	{
+		char name[16];
+		snprintf(name, sizeof(name), "f%u", i);
+
+		Path path(_dir);
+		path.append("/");
+		path.append(name);
+		return path;
+	}
+
+	void _add_result(char const *op, unsigned concurrency, unsigned long ops,
+	                 unsigned long bytes, unsigned long elapsed_us)
+	{
+		Result const result { op, concurrency, ops, bytes, elapsed_us,
+		                      _latency.percentile(500), _latency.percentile(900),
+		                      _latency.percentile(990), _latency.max_us() };
+		log(result);
+
+		if (_num_results < MAX_RESULTS)
+			_results[_num_results++] = result;
+	}
+
+	/**
+	 * Measure 'ops' invocations of 'fn', which is called with the index of
+	 * the operation
+	 */
+	template <typename FN>
+	void _measure(char const *op, unsigned long ops, FN const &fn)
+	{
+		_latency.reset();
+
+		unsigned long const start = _now_us();
+		for (unsigned long i = 0; i < ops; i++) {
+			unsigned long const t = _now_us();
+			fn(i);
+			_latency.add(_now_us() - t);
+		}
+		unsigned long const elapsed = _now_us() - start;
+
+		_add_result(op, 1, ops, 0, elapsed);
+	}
+
+	Vfs::Vfs_handle &_open(Path const &path, unsigned mode)
+	{
+		Vfs::Vfs_handle *handle = nullptr;
+		if (_vfs.open(path.base(), mode, &handle, _heap)
+		    != Vfs::Directory_service::OPEN_OK) {
+			error("failed to open ", path);
+			throw Failed();
+		}
+		return *handle;
+	}
+
+	void _sync(Vfs::Vfs_handle &handle)
+	{
+		while (!handle.fs().queue_sync(&handle))
+			_env.ep().wait_and_dispatch_one_io_signal();
+
+		while (handle.fs().complete_sync(&handle) == Vfs::File_io_service::SYNC_QUEUED)
+			_env.ep().wait_and_dispatch_one_io_signal();
+	}
+
+
+	/*************************
+	 ** Metadata benchmarks **
+	 *************************/
+
+	void _create_files()
+	{
+		Vfs::Vfs_handle *dir = nullptr;
+		if (_vfs.opendir(_dir.base(), true, &dir, _heap)
+		    != Vfs::Directory_service::OPENDIR_OK) {
+			error("failed to create ", _dir);
+			throw Failed();
+		}
+		_vfs.close(dir);
+
+		_measure("create", _files, [&] (unsigned long i) {
+			_vfs.close(&_open(_file_path(i), Vfs::Directory_service::OPEN_MODE_CREATE
+			                               | Vfs::Directory_service::OPEN_MODE_WRONLY));
+		});
+	}
+
+	void _open_files()
+	{
+		_measure("open", _rounds*_files, [&] (unsigned long i) {
+			_vfs.close(&_open(_file_path(i % _files),
+			                  Vfs::Directory_service::OPEN_MODE_RDONLY));
+		});
+	}
+
+	void _stat_files()
+	{
+		_measure("stat", _rounds*_files, [&] (unsigned long i) {
+
+			/* visit the files in an order unrelated to their names */
+			Vfs::Directory_service::Stat stat;
+			Path const path = _file_path((i*7919) % _files);
+
+			if (_vfs.stat(path.base(), stat) != Vfs::Directory_service::STAT_OK) {
+				error("stat of ", path, " failed");
+				throw Failed();
+			}
+		});
+	}
+
+	void _readdir()
+	{
+		Vfs::Vfs_handle *dir = nullptr;
+		if (_vfs.opendir(_dir.base(), false, &dir, _heap)
+		    != Vfs::Directory_service::OPENDIR_OK) {
+			error("failed to open ", _dir);
+			throw Failed();
+		}
+
+		unsigned long const entries = _vfs.num_dirent(_dir.base());
+
+		_measure("readdir", _rounds*entries, [&] (unsigned long i) {
+
+			Vfs::Directory_service::Dirent dirent;
+			Vfs::file_size out = 0;
+
+			dir->seek((i % entries) * sizeof(dirent));
+
+			while (!dir->fs().queue_read(dir, sizeof(dirent)))
+				_env.ep().wait_and_dispatch_one_io_signal();
+
+			while (dir->fs().complete_read(dir, (char *)&dirent, sizeof(dirent), out)
+			       == Vfs::File_io_service::READ_QUEUED)
+				_env.ep().wait_and_dispatch_one_io_signal();
+		});
+
+		_vfs.close(dir);
+	}
+
+	void _unlink_files()
+	{
+		_measure("unlink", _files, [&] (unsigned long i) {
+			Path const path = _file_path(i);
+			if (_vfs.unlink(path.base()) != Vfs::Directory_service::UNLINK_OK) {
+				error("unlink of ", path, " failed");
+				throw Failed();
+			}
+		});
+		_vfs.unlink(_dir.base());
+	}
+
+
+	/********************
+	 ** I/O benchmarks **
+	 ********************/
+
+	/**
+	 * Stream of block operations on the files with 'index % concurrency'
+	 */
+	struct Stream
+	{
+		Vfs::Vfs_handle *handle   = nullptr;
+		Vfs::file_size   offset   = 0;
+		char            *buf      = nullptr;
+		unsigned long    issued   = 0;
+		unsigned long    quota    = 0;
+		unsigned long    start_us = 0;
+		bool             busy     = false;
+		bool             queued   = false;
+	};
+
+	enum { MAX_STREAMS = 64 };
+
+	/**
+	 * Try to complete current operation of stream
+	 *
+	 * \return false if the operation must be retried later
+	 */
+	bool _try(Stream &s, bool write)
+	{
+		Vfs::Vfs_handle &handle = *s.handle;
+
+		if (write) {
+			handle.seek(s.offset);
+
+			Vfs::file_size out = 0;
+			Vfs::File_io_service::Write_result const r =
+				handle.fs().write(&handle, s.buf, _block_size, out);
+
+			if (r == Vfs::File_io_service::WRITE_ERR_WOULD_BLOCK
+			 || r == Vfs::File_io_service::WRITE_ERR_AGAIN)
+				return false;
+
+			if (r != Vfs::File_io_service::WRITE_OK) {
+				error("write failed");
+				throw Failed();
+			}
+			return true;
+		}
+
+		if (!s.queued) {
+			handle.seek(s.offset);
+			if (!handle.fs().queue_read(&handle, _block_size))
+				return false;
+			s.queued = true;
+		}
+
+		Vfs::file_size out = 0;
+		Vfs::File_io_service::Read_result const r =
+			handle.fs().complete_read(&handle, s.buf, _block_size, out);
+
+		if (r == Vfs::File_io_service::READ_QUEUED)
+			return false;
+
+		s.queued = false;
+
+		if (r != Vfs::File_io_service::READ_OK) {
+			error("read failed");
+			throw Failed();
+		}
+		return true;
+	}
+
+	void _io(char const *op, unsigned concurrency, bool write, bool random)
+	{
+		unsigned const mode = write ? Vfs::Directory_service::OPEN_MODE_WRONLY
+		                            : Vfs::Directory_service::OPEN_MODE_RDONLY;
+
+		Vfs::Vfs_handle *handles[MAX_FILES];
+		for (unsigned i = 0; i < _files; i++)
+			handles[i] = &_open(_file_path(i), mode);
+
+		unsigned long const ops = _files*_blocks_per_file;
+
+		Stream streams[MAX_STREAMS];
+		concurrency = min(concurrency, (unsigned)MAX_STREAMS);
+
+		void *buffers_ptr = nullptr;
+		_heap.alloc(concurrency*_block_size, &buffers_ptr);
+		char *buffers = (char *)buffers_ptr;
+		memset(buffers, 0x55, concurrency*_block_size);
+
+		for (unsigned i = 0; i < concurrency; i++) {
+			streams[i].buf   = buffers + i*_block_size;
+			streams[i].quota = ops / concurrency + (i < ops % concurrency);
+		}
+
+		/* files served by stream 'i' */
+		auto files_of = [&] (unsigned i) {
+			return _files / concurrency + (i < _files % concurrency); };
+
+		_latency.reset();
+
+		unsigned long const start = _now_us();
+
+		for (unsigned long done = 0; done < ops; ) {
+
+			bool progress = false;
+
+			for (unsigned i = 0; i < concurrency; i++) {
+
+				Stream &s = streams[i];
+
+				if (!s.busy) {
+					if (s.issued == s.quota)
+						continue;
+
+					unsigned long const n = random
+					                      ? _random() % s.quota : s.issued;
+
+					unsigned      const file  = i + concurrency*((n / _blocks_per_file) % files_of(i));
+					unsigned long const block = n % _blocks_per_file;
+
+					s.handle   = handles[file];
+					s.offset   = block*_block_size;
+					s.start_us = _now_us();
+					s.busy     = true;
+				}
+
+				if (!_try(s, write))
+					continue;
+
+				_latency.add(_now_us() - s.start_us);
+				s.busy = false;
+				s.issued++;
+				done++;
+				progress = true;
+			}
+
+			if (!progress)
+				_env.ep().wait_and_dispatch_one_io_signal();
+		}
+
+		if (write)
+			for (unsigned i = 0; i < _files; i++)
+				_sync(*handles[i]);
+
+		unsigned long const elapsed = _now_us() - start;
+
+		for (unsigned i = 0; i < _files; i++)
+			_vfs.close(handles[i]);
+
+		_heap.free(buffers, concurrency*_block_size);
+
+		_add_result(op, concurrency, ops, ops*_block_size, elapsed);
+	}
+
+
+	/***************
+	 ** Reporting **
+	 ***************/
+
+	void _report()
+	{
+		_reporter.enabled(true);
+
+		Reporter::Xml_generator xml(_reporter, [&] () {
+			xml.attribute("label",      _label);
+			xml.attribute("files",      _files);
+			xml.attribute("file_size",  _file_size);
+			xml.attribute("block_size", _block_size);
+
+			for (unsigned i = 0; i < _num_results; i++) {
+				Result const &r = _results[i];
+				xml.node("result", [&] () {
+					xml.attribute("op",          r.op);
+					xml.attribute("concurrency", r.concurrency);
+					xml.attribute("ops",         r.ops);
+					xml.attribute("bytes",       r.bytes);
+					xml.attribute("elapsed_us",  r.elapsed_us);
+					xml.attribute("ops_per_s",   r.ops_per_s());
+					xml.attribute("kib_per_s",   r.kib_per_s());
+					xml.attribute("p50_us",      r.p50);
+					xml.attribute("p90_us",      r.p90);
+					xml.attribute("p99_us",      r.p99);
+					xml.attribute("max_us",      r.max);
+				});
+			}
+		});
+	}
+
+	void _run()
+	{
+		if (!_read_only) {
+			_create_files();
+			_io("initial_write", 1, true, false);
+		}
+
+		_open_files();
+		_stat_files();
+		_readdir();
+
+		for (unsigned c = 1; c <= _max_conc; c *= 2) {
+			_io("seq_read",  c, false, false);
+			_io("rand_read", c, false, true);
+
+			if (_read_only)
+				continue;
+
+			_io("seq_write",  c, true, false);
+			_io("rand_write", c, true, true);
+		}
+
+		if (!_read_only)
+			_unlink_files();
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		log("benchmark '", _label, "': ", _files, " files of ", _file_size,
+		    " bytes, blocks of ", _block_size, " bytes");
+
+		try { _run(); }
+		catch (...) {
+			error("benchmark '", _label, "' failed");
+			_env.parent().exit(-1);
+			return;
+		}
+
+		try { _report(); }
+		catch (...) { warning("results not reported"); }
+
+		log("benchmark '", _label, "' finished");
+		_env.parent().exit(0);
+	}
+};
+
+
+void Component::construct(Genode::Env &env) { static Vfs_bench::Main main(env); }
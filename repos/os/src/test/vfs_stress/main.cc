@@ -510,6 +510,105 @@ struct Unlink_test : public Stress_test
 	}
 };
 
+/**
+ * Populate a single directory with many files
+ *
+ * This test stresses the per-directory name lookup and the enumeration of
+ * large directories rather than the creation of deep trees.
+ */
+struct Flat_test : public Stress_test
+{
+	Genode::Entrypoint &_ep;
+	unsigned const      _files;
+
+	void _file_path(::Path &file_path, unsigned i)
+	{
+		char name[16];
+		snprintf(name, sizeof(name), "f%u", i);
+		file_path.import(path.base());
+		file_path.append("/");
+		file_path.append(name);
+	}
+
+	Flat_test(Vfs::File_system &vfs, Genode::Allocator &alloc,
+	          char const *parent, Genode::Entrypoint &ep, unsigned files)
+	: Stress_test(vfs, alloc, parent), _ep(ep), _files(files)
+	{
+		Vfs::Vfs_handle *dir_handle;
+		assert_opendir(vfs.opendir(path.base(), true, &dir_handle, alloc));
+		vfs.close(dir_handle);
+	}
+
+	unsigned create()
+	{
+		using namespace Vfs;
+
+		::Path file_path;
+		for (unsigned i = 0; i < _files; i++) {
+			_file_path(file_path, i);
+			Vfs_handle *handle = nullptr;
+			assert_open(vfs.open(
+				file_path.base(), Directory_service::OPEN_MODE_CREATE, &handle, alloc));
+			Vfs_handle::Guard guard(handle);
+		}
+		return _files;
+	}
+
+	unsigned lookup()
+	{
+		::Path file_path;
+		Vfs::Directory_service::Stat stat;
+
+		/* visit the files in an order unrelated to their creation */
+		for (unsigned i = 0, j = 0; i < _files; i++, j = (j + 7919) % _files) {
+			_file_path(file_path, j);
+			if (vfs.stat(file_path.base(), stat) != Vfs::Directory_service::STAT_OK) {
+				error("stat of ", file_path, " failed");
+				throw Exception();
+			}
+		}
+		return _files;
+	}
+
+	unsigned readdir()
+	{
+		Vfs::Vfs_handle *dir_handle;
+		assert_opendir(vfs.opendir(path.base(), false, &dir_handle, alloc));
+
+		Vfs::Directory_service::Dirent dirent;
+		unsigned count = 0;
+		for (;; count++) {
+			dir_handle->seek(count * sizeof(dirent));
+			dir_handle->fs().queue_read(dir_handle, sizeof(dirent));
+			Vfs::file_size out_count;
+
+			while (dir_handle->fs().complete_read(dir_handle, (char*)&dirent,
+			                                      sizeof(dirent), out_count) ==
+			       Vfs::File_io_service::READ_QUEUED)
+				_ep.wait_and_dispatch_one_io_signal();
+
+			if (dirent.type == Vfs::Directory_service::DIRENT_TYPE_END)
+				break;
+		}
+		vfs.close(dir_handle);
+
+		if (count != _files)
+			error("read ", count, " directory entries, expected ", _files);
+		return count;
+	}
+
+	unsigned unlink()
+	{
+		::Path file_path;
+		for (unsigned i = 0; i < _files; i++) {
+			_file_path(file_path, i);
+			assert_unlink(vfs.unlink(file_path.base()));
+		}
+		assert_unlink(vfs.unlink(path.base()));
+		return _files;
+	}
+};
+
 void die(Genode::Env &env, int code) { env.parent().exit(code); }
 
 void Component::construct(Genode::Env &env)
@@ -561,6 +660,47 @@ void Component::construct(Genode::Env &env)
 
 	size_t initial_consumption = env.ram().used_ram().value;
 
+	/***************************
+	 ** Flat directory layout **
+	 ***************************/
+
+	if (unsigned const files = config_xml.attribute_value("flat", 0U)) {
+		try {
+			Flat_test test(vfs_root, heap, "/flat", env.ep(), files);
+
+			enum { CREATE, LOOKUP, READDIR, UNLINK, PHASES };
+			char const *what[PHASES] = { "created", "looked up",
+			                             "enumerated", "unlinked" };
+
+			for (unsigned phase = CREATE; phase < PHASES; phase++) {
+				elapsed_ms = timer.elapsed_ms();
+
+				unsigned count = 0;
+				switch (phase) {
+				case CREATE:  count = test.create();  break;
+				case LOOKUP:  count = test.lookup();  break;
+				case READDIR: count = test.readdir(); break;
+				case UNLINK:  count = test.unlink();  break;
+				}
+
+				elapsed_ms = timer.elapsed_ms() - elapsed_ms;
+
+				vfs_root_sync();
+
+				log(what[phase], " ", count, " files in one directory, ",
+				    (elapsed_ms*1000)/max(count, 1U), "μs/op, ",
+				    env.ram().used_ram().value/1024, "KiB consumed");
+			}
+		} catch (...) {
+			error("flat directory test failed");
+			return die(env, -1);
+		}
+
+		log("total: ",timer.elapsed_ms(),"ms, ",
+		    env.ram().used_ram().value/1024,"KiB consumed");
+		return die(env, 0);
+	}
+
 	/**************************
 	 ** Generate directories **
 	 **************************/
@@ -12,6 +12,7 @@
  */
 
 #include <base/component.h>
+#include <base/heap.h>
 #include <base/log.h>
 #include <util/xml_generator.h>
 #include <util/xml_node.h>
@@ -19,50 +20,92 @@
 using Genode::size_t;
 
 
-static size_t fill_buffer_with_xml(char *dst, size_t dst_len)
+static void generate_xml(Genode::Xml_generator &xml)
 {
-	Genode::Xml_generator xml(dst, dst_len, "config", [&]
-	{
-		xml.attribute("xpos", "27");
-		xml.attribute("ypos", "34");
+	xml.attribute("xpos", "27");
+	xml.attribute("ypos", "34");
 
-		xml.node("box", [&]()
-		{
-			xml.attribute("width",  "320");
-			xml.attribute("height", "240");
-		});
-		xml.node("label", [&] ()
-		{
-			xml.attribute("name", "a test");
-			xml.node("sub_label");
-			xml.node("another_sub_label", [&] ()
-			{
-				xml.node("sub_sub_label");
-			});
-		});
-		xml.node("bool", [&] ()
-		{
-			xml.attribute("true",  true);
-			xml.attribute("false", false);
-		});
-		xml.node("signed", [&] ()
-		{
-			xml.attribute("int",      -1);
-			xml.attribute("long",     -2L);
-			xml.attribute("longlong", -3LL);
-		});
-		xml.node("unsigned", [&] ()
+	xml.node("box", [&]()
+	{
+		xml.attribute("width",  "320");
+		xml.attribute("height", "240");
+	});
+	xml.node("label", [&] ()
+	{
+		xml.attribute("name", "a test");
+		xml.node("sub_label");
+		xml.node("another_sub_label", [&] ()
 		{
-			xml.attribute("int",      1U);
-			xml.attribute("long",     2UL);
-			xml.attribute("longlong", 3ULL);
+			xml.node("sub_sub_label");
 		});
 	});
+	xml.node("bool", [&] ()
+	{
+		xml.attribute("true",  true);
+		xml.attribute("false", false);
+	});
+	xml.node("signed", [&] ()
+	{
+		xml.attribute("int",      -1);
+		xml.attribute("long",     -2L);
+		xml.attribute("longlong", -3LL);
+	});
+	xml.node("unsigned", [&] ()
+	{
+		xml.attribute("int",      1U);
+		xml.attribute("long",     2UL);
+		xml.attribute("longlong", 3ULL);
+	});
+}
+
+
+static size_t fill_buffer_with_xml(char *dst, size_t dst_len)
+{
+	Genode::Xml_generator xml(dst, dst_len, "config", [&] {
+		generate_xml(xml); });
 
 	return xml.used();
 }
 
 
+/**
+ * Heap-backed buffer that doubles its size on demand
+ */
+struct Heap_buffer : Genode::Xml_generator::Expanding_buffer
+{
+	Genode::Allocator &_alloc;
+
+	unsigned num_expansions = 0;
+
+	Heap_buffer(Genode::Allocator &alloc, size_t initial_size) : _alloc(alloc)
+	{
+		base = (char *)_alloc.alloc(initial_size);
+		size = initial_size;
+	}
+
+	~Heap_buffer() { _alloc.free(base, size); }
+
+	bool expand(size_t min_size) override
+	{
+		size_t new_size = size;
+		while (new_size < min_size)
+			new_size *= 2;
+
+		char *new_base = nullptr;
+		if (!_alloc.alloc(new_size, (void **)&new_base))
+			return false;
+
+		Genode::memcpy(new_base, base, size);
+		_alloc.free(base, size);
+
+		base = new_base;
+		size = new_size;
+		num_expansions++;
+		return true;
+	}
+};
+
+
 void Component::construct(Genode::Env &env)
 {
 	using namespace Genode;
@@ -86,6 +129,24 @@ void Component::construct(Genode::Env &env)
 	catch (Genode::Xml_generator::Buffer_exceeded) {
 		log("buffer exceeded (expected error)"); }
 
+	/*
+	 * Test the generation into an expanding buffer, which must yield the
+	 * same result as the generation into a sufficiently large buffer
+	 */
+	{
+		static Heap heap(env.ram(), env.rm());
+
+		Heap_buffer buffer(heap, 16);
+		Xml_generator xml(buffer, "config", [&] { generate_xml(xml); });
+
+		if (xml.used() != used || memcmp(buffer.base, dst, used)) {
+			log("result of expanding buffer differs");
+			return;
+		}
+		log("expanding buffer: used ", xml.used(), " bytes after ",
+		    buffer.num_expansions, " expansions");
+	}
+
 	/*
 	 * Test the sanitizing of XML node content
 	 */
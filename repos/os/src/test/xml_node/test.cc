@@ -12,8 +12,12 @@
  */
 
 #include <util/xml_node.h>
+#include <util/xml_index.h>
+#include <util/xml_generator.h>
 #include <base/component.h>
+#include <base/heap.h>
 #include <base/log.h>
+#include <trace/timestamp.h>
 
 using namespace Genode;
 
@@ -145,6 +149,12 @@ static const char *xml_test_comments =
 	"<visible-tag/>"
 	"</config>";
 
+/* end tag of sub node does not match its start tag */
+static const char *xml_test_mismatching_tags =
+	"<config>"
+	"<program></quota>"
+	"</config>";
+
 
 /******************
  ** Test program **
@@ -314,8 +324,109 @@ static void log_xml_info(const char *xml_string)
 }
 
 
+static void log_indexed_xml_info(Allocator &alloc, const char *xml_string)
+{
+	try {
+		Xml_index index(alloc, Xml_node(xml_string));
+		log(Formatted_xml_node(index.xml()));
+	} catch (Xml_node::Invalid_syntax) {
+		log("string has invalid XML syntax\n");
+	}
+}
+
+
+/**
+ * Generate init configuration with the specified number of start nodes
+ */
+static size_t generate_config(char *dst, size_t dst_len, unsigned num_children)
+{
+	Xml_generator xml(dst, dst_len, "config", [&] () {
+		xml.node("parent-provides", [&] () {
+			xml.node("service", [&] () { xml.attribute("name", "LOG"); }); });
+
+		for (unsigned i = 0; i < num_children; i++) {
+			xml.node("start", [&] () {
+				xml.attribute("name", String<32>("child_", i));
+				xml.attribute("caps", 100);
+				xml.node("resource", [&] () {
+					xml.attribute("name", "RAM");
+					xml.attribute("quantum", "1M");
+				});
+				xml.node("route", [&] () {
+					xml.node("any-service", [&] () {
+						xml.node("parent", [&] () { }); }); });
+			});
+		}
+	});
+	return xml.used();
+}
+
+
+/**
+ * Access pattern of init when evaluating its configuration
+ *
+ * \return  number of start nodes found via their name
+ */
+static unsigned traverse_config(Xml_node config)
+{
+	unsigned found = 0;
+
+	config.for_each_sub_node("start", [&] (Xml_node start) {
+
+		typedef String<32> Name;
+		Name const name = start.attribute_value("name", Name());
+
+		start.attribute_value("caps", 0UL);
+		if (start.has_sub_node("resource"))
+			start.sub_node("resource").attribute_value("quantum", Number_of_bytes());
+
+		/* look up start node by name, e.g., for resolving routes */
+		config.for_each_sub_node("start", [&] (Xml_node other) {
+			if (other.attribute_value("name", Name()) == name)
+				found++; });
+	});
+	return found;
+}
+
+
+static void benchmark(Allocator &alloc)
+{
+	enum { NUM_CHILDREN = 200, ROUNDS = 4, BUFFER_SIZE = 64*1024 };
+
+	char * const buffer = (char *)alloc.alloc(BUFFER_SIZE);
+	size_t const size   = generate_config(buffer, BUFFER_SIZE, NUM_CHILDREN);
+
+	Xml_node const config(buffer, size);
+
+	Trace::Timestamp start = Trace::timestamp();
+	unsigned found = 0;
+	for (unsigned i = 0; i < ROUNDS; i++)
+		found += traverse_config(config);
+	Trace::Timestamp const plain = Trace::timestamp() - start;
+
+	log("traversal of ", (unsigned)NUM_CHILDREN, " start nodes: ",
+	    found, " lookups, took ", plain, " cycles");
+
+	start = Trace::timestamp();
+	found = 0;
+	{
+		Xml_index index(alloc, config);
+		for (unsigned i = 0; i < ROUNDS; i++)
+			found += traverse_config(index.xml());
+	}
+	Trace::Timestamp const indexed = Trace::timestamp() - start;
+
+	log("indexed traversal of ", (unsigned)NUM_CHILDREN, " start nodes: ",
+	    found, " lookups, took ", indexed, " cycles");
+
+	alloc.free(buffer, BUFFER_SIZE);
+}
+
+
 void Component::construct(Genode::Env &env)
 {
+	static Heap heap(env.ram(), env.rm());
+
 	log("--- XML-token test ---");
 	log_xml_tokens<Scanner_policy_identifier_with_underline>(xml_test_text_between_nodes);
 
@@ -351,6 +462,18 @@ void Component::construct(Genode::Env &env)
 	log("-- Test parsing XML with comments --");
 	log_xml_info(xml_test_comments);
 
+	log("-- Test indexed XML structure --");
+	log_indexed_xml_info(heap, xml_test_valid);
+
+	log("-- Test indexed XML with comments --");
+	log_indexed_xml_info(heap, xml_test_comments);
+
+	log("-- Test indexed XML with mismatching tags --");
+	log_indexed_xml_info(heap, xml_test_mismatching_tags);
+
+	log("-- Benchmark of XML traversal --");
+	benchmark(heap);
+
 	log("--- End of XML-parser test ---");
 	env.parent().exit(0);
 }
@@ -66,6 +66,12 @@ void Cpu_thread_component::_remove_breakpoint_at_first_instruction()
 
 void Cpu_thread_component::_dispatch_exception(unsigned)
 {
+	{
+		Lock::Guard guard(_state_lock);
+		_stopped            = true;
+		_cached_state_valid = false;
+	}
+
 	deliver_signal(SIGTRAP);
 }
 
@@ -235,18 +241,33 @@ void Cpu_thread_component::start(addr_t ip, addr_t sp)
 void Cpu_thread_component::pause()
 {
 	_parent_cpu_thread.pause();
+
+	Lock::Guard guard(_state_lock);
+	_stopped            = true;
+	_cached_state_valid = false;
 }
 
 
 void Cpu_thread_component::resume()
 {
+	{
+		Lock::Guard guard(_state_lock);
+		_stopped            = false;
+		_cached_state_valid = false;
+	}
+
 	_parent_cpu_thread.resume();
 }
 
 
 void Cpu_thread_component::single_step(bool enable)
 {
+	/* spare the RPC to core when continuing with an unchanged mode */
+	if (enable == _single_step)
+		return;
+
 	_parent_cpu_thread.single_step(enable);
+	_single_step = enable;
 }
 
 
@@ -258,13 +279,34 @@ void Cpu_thread_component::cancel_blocking()
 
 void Cpu_thread_component::state(Thread_state const &state)
 {
+	Lock::Guard guard(_state_lock);
+
+	_cached_state_valid = false;
+
 	_parent_cpu_thread.state(state);
+
+	if (_stopped) {
+		_cached_state       = state;
+		_cached_state_valid = true;
+	}
 }
 
 
 Thread_state Cpu_thread_component::state()
 {
-	return _parent_cpu_thread.state();
+	Lock::Guard guard(_state_lock);
+
+	if (_cached_state_valid)
+		return _cached_state;
+
+	Thread_state const state = _parent_cpu_thread.state();
+
+	if (_stopped) {
+		_cached_state       = state;
+		_cached_state_valid = true;
+	}
+
+	return state;
 }
 
 
@@ -58,6 +58,19 @@ class Gdb_monitor::Cpu_thread_component : public Rpc_object<Cpu_thread>,
 		unsigned char _original_instructions[MAX_BREAKPOINT_LEN];
 		addr_t _breakpoint_ip;
 
+		/*
+		 * The register state of a stopped thread is cached because gdbserver
+		 * accesses each register individually. The cache is invalidated
+		 * whenever the thread may have executed.
+		 */
+		Lock         _state_lock;
+		bool         _stopped            = false;
+		bool         _cached_state_valid = false;
+		Thread_state _cached_state;
+
+		/* single-stepping mode as last configured at the parent */
+		bool _single_step = false;
+
 		bool _set_breakpoint_at_first_instruction(addr_t ip);
 		void _remove_breakpoint_at_first_instruction();
 
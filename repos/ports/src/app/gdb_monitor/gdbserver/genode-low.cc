@@ -66,19 +66,27 @@ class Memory_model
 
 		/**
 		 * Representation of a currently mapped region
+		 *
+		 * A mapping is identified by its dataspace and offset rather than
+		 * by the region object, which may get destroyed and re-allocated
+		 * for a different dataspace whenever the child detaches a region.
 		 */
 		struct Mapped_region
 		{
-			Region_map_component::Region *_region;
-			unsigned char                *_local_base;
+			Dataspace_capability  _ds_cap;
+			off_t                 _offset;
+			unsigned char        *_local_base;
+			unsigned long         _last_used;
 
-			Mapped_region() : _region(0), _local_base(0) { }
+			Mapped_region() : _offset(0), _local_base(0), _last_used(0) { }
 
-			bool valid() { return _region != 0; }
+			bool valid() { return _local_base != 0; }
 
-			bool loaded(Region_map_component::Region const * region)
+			bool loaded(Region_map_component::Region *region)
 			{
-				return _region == region;
+				return valid()
+				    && _ds_cap.local_name() == region->ds_cap().local_name()
+				    && _offset == region->offset();
 			}
 
 			void flush(Region_map &rm)
@@ -86,24 +94,18 @@ class Memory_model
 				if (!valid()) return;
 				rm.detach(_local_base);
 				_local_base = 0;
-				_region = 0;
+				_ds_cap     = Dataspace_capability();
 			}
 
 			void load(Region_map_component::Region *region, Region_map &rm)
 			{
-				if (region == _region)
-					return;
-
-				if (!region || valid())
-					flush(rm);
-
-				if (!region)
-					return;
+				flush(rm);
 
 				try {
-					_region     = region;
-					_local_base = rm.attach(_region->ds_cap(),
-					                        0, _region->offset());
+					_local_base = rm.attach(region->ds_cap(),
+					                        0, region->offset());
+					_ds_cap     = region->ds_cap();
+					_offset     = region->offset();
 				}
 				catch (Region_map::Region_conflict) {
 					flush(rm);
@@ -118,11 +120,15 @@ class Memory_model
 			unsigned char *local_base() { return _local_base; }
 		};
 
-		enum { NUM_MAPPED_REGIONS = 1 };
+		/*
+		 * Several regions are kept attached because a single GDB command
+		 * typically touches the text, the stack, and the heap of the child.
+		 */
+		enum { NUM_MAPPED_REGIONS = 8 };
 
 		Mapped_region _mapped_region[NUM_MAPPED_REGIONS];
 
-		unsigned _evict_idx = 0;
+		unsigned long _access_count = 0;
 
 		/**
 		 * Return local address of mapped region
@@ -131,19 +137,61 @@ class Memory_model
 		 */
 		unsigned char *_update_curr_region(Region_map_component::Region *region)
 		{
+			if (!region)
+				return 0;
+
+			_access_count++;
+
 			for (unsigned i = 0; i < NUM_MAPPED_REGIONS; i++) {
-				if (_mapped_region[i].loaded(region))
+				if (_mapped_region[i].loaded(region)) {
+					_mapped_region[i]._last_used = _access_count;
 					return _mapped_region[i].local_base();
+				}
 			}
 
-			/* flush one currently mapped region */
-			_evict_idx++;
-			if (_evict_idx == NUM_MAPPED_REGIONS)
-				_evict_idx = 0;
+			/* replace the least recently used region */
+			Mapped_region *victim = &_mapped_region[0];
+			for (unsigned i = 1; i < NUM_MAPPED_REGIONS; i++)
+				if (_mapped_region[i]._last_used < victim->_last_used)
+					victim = &_mapped_region[i];
 
-			_mapped_region[_evict_idx].load(region, _rm);
+			victim->load(region, _rm);
+			victim->_last_used = _access_count;
 
-			return _mapped_region[_evict_idx].local_base();
+			return victim->local_base();
+		}
+
+		/**
+		 * Call 'fn(local_addr, len)' for each mapped chunk of the given range
+		 *
+		 * \throw No_memory_at_address
+		 */
+		template <typename FN>
+		void _for_each_chunk(addr_t addr, size_t len, FN const &fn)
+		{
+			while (len > 0) {
+
+				addr_t offset_in_region = 0;
+
+				Region_map_component::Region *region =
+					_address_space.find_region((void *)addr, &offset_in_region);
+
+				unsigned char *local_base = _update_curr_region(region);
+
+				if (!local_base) {
+					warning(__func__, ": no memory at address ", Hex(addr));
+					throw No_memory_at_address();
+				}
+
+				size_t const region_size = (addr_t)region->end()
+				                         - (addr_t)region->start() + 1;
+				size_t const chunk_len   = min(len, region_size - offset_in_region);
+
+				fn(local_base + offset_in_region, chunk_len);
+
+				addr += chunk_len;
+				len  -= chunk_len;
+			}
 		}
 
 	public:
@@ -155,51 +203,40 @@ class Memory_model
 			_rm(rm)
 		{ }
 
-		unsigned char read(void *addr)
+		/**
+		 * Copy 'len' bytes at 'addr' of the child to 'dst'
+		 *
+		 * \throw No_memory_at_address
+		 */
+		void read(addr_t addr, unsigned char *dst, size_t len)
 		{
 			Lock::Guard guard(_lock);
 
-			addr_t offset_in_region = 0;
-
-			Region_map_component::Region *region =
-				_address_space.find_region(addr, &offset_in_region);
-
-			unsigned char *local_base = _update_curr_region(region);
-
-			if (!local_base) {
-				warning(__func__, ": no memory at address ", addr);
-				throw No_memory_at_address();
-			}
-
-			unsigned char value =
-				local_base[offset_in_region];
+			_for_each_chunk(addr, len, [&] (unsigned char *src, size_t n) {
+				Genode::memcpy(dst, src, n);
+				dst += n;
+			});
 
 			if (verbose)
-				log(__func__, ": read addr=", addr, ", value=", Hex(value));
-
-			return value;
+				log(__func__, ": read addr=", Hex(addr), ", len=", len);
 		}
 
-		void write(void *addr, unsigned char value)
+		/**
+		 * Copy 'len' bytes from 'src' to 'addr' of the child
+		 *
+		 * \throw No_memory_at_address
+		 */
+		void write(addr_t addr, unsigned char const *src, size_t len)
 		{
 			if (verbose)
-				log(__func__, ": write addr=", addr, ", value=", Hex(value));
+				log(__func__, ": write addr=", Hex(addr), ", len=", len);
 
 			Lock::Guard guard(_lock);
 
-			addr_t offset_in_region = 0;
-			Region_map_component::Region *region =
-				_address_space.find_region(addr, &offset_in_region);
-
-			unsigned char *local_base = _update_curr_region(region);
-
-			if (!local_base) {
-				warning(__func__, ": no memory at address=", addr);
-				warning("(attempted to write ", Hex(value), ")");
-				throw No_memory_at_address();
-			}
-
-			local_base[offset_in_region] = value;
+			_for_each_chunk(addr, len, [&] (unsigned char *dst, size_t n) {
+				Genode::memcpy(dst, src, n);
+				src += n;
+			});
 		}
 };
 
@@ -648,7 +685,9 @@ void genode_store_registers(struct regcache *regcache, int regno)
 
 unsigned char genode_read_memory_byte(void *addr)
 {
-	return memory_model().read(addr);
+	unsigned char value = 0;
+	memory_model().read((addr_t)addr, &value, 1);
+	return value;
 }
 
 
@@ -657,10 +696,9 @@ int genode_read_memory(CORE_ADDR memaddr, unsigned char *myaddr, int len)
 	if (verbose)
 		log(__func__, "(", Hex(memaddr), ", ", myaddr, ", ", len, ")");
 
-	if (myaddr)
+	if (myaddr && (len > 0))
 		try {
-			for (int i = 0; i < len; i++)
-				myaddr[i] = genode_read_memory_byte((void*)((unsigned long)memaddr + i));
+			memory_model().read((addr_t)memaddr, myaddr, len);
 		} catch (No_memory_at_address) {
 			return EFAULT;
 		}
@@ -669,12 +707,6 @@ int genode_read_memory(CORE_ADDR memaddr, unsigned char *myaddr, int len)
 }
 
 
-void genode_write_memory_byte(void *addr, unsigned char value)
-{
-	memory_model().write(addr, value);
-}
-
-
 int genode_write_memory (CORE_ADDR memaddr, const unsigned char *myaddr, int len)
 {
 	if (verbose)
@@ -694,9 +726,8 @@ int genode_write_memory (CORE_ADDR memaddr, const unsigned char *myaddr, int len
 			        val, (long)memaddr);
 		}
 
-	for (int i = 0; i < len; i++)
 		try {
-			genode_write_memory_byte((void*)((unsigned long)memaddr + i), myaddr[i]);
+			memory_model().write((addr_t)memaddr, myaddr, len);
 		} catch (No_memory_at_address) {
 			return EFAULT;
 		}
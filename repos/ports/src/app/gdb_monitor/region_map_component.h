@@ -65,6 +65,7 @@ namespace Gdb_monitor {
 					}
 
 					void *start() { return _start; }
+					void *end() { return _end; }
 					off_t offset() { return _offset; }
 					Dataspace_capability ds_cap() { return _ds_cap; }
 			};
@@ -14,10 +14,13 @@
 /* Genode includes */
 #include <base/log.h>
 #include <base/heap.h>
+#include <base/lock.h>
 #include <os/static_root.h>
 #include <nic/component.h>
 #include <root/component.h>
 #include <libc/component.h>
+#include <timer_session/connection.h>
+#include <util/reconstructible.h>
 
 /* libc includes */
 #include <unistd.h>
@@ -48,9 +51,11 @@ class Openvpn_thread : public Genode::Thread
 
 	public:
 
-		Openvpn_thread(Genode::Env &env, int argc, char *argv[])
+		Openvpn_thread(Genode::Env &env, int argc, char *argv[],
+		               Genode::Affinity::Location location)
 		:
-			Thread(env, "openvpn_main", 16UL * 1024 * sizeof (long)),
+			Thread(env, "openvpn_main", 16UL * 1024 * sizeof (long),
+			       location, Weight(), env.cpu()),
 			_argc(argc), _argv(argv),
 			_exitcode(-1)
 		{ }
@@ -78,54 +83,95 @@ Tuntap_device *tuntap_dev()
 class Openvpn_component : public Tuntap_device,
                           public Nic::Session_component
 {
+	public:
+
+		/**
+		 * Packet counters, each one is modified by the OpenVPN thread only
+		 */
+		struct Stats
+		{
+			unsigned long tx_packets = 0, tx_bytes = 0, tx_batches = 0;
+			unsigned long rx_packets = 0, rx_bytes = 0;
+		};
+
 	private:
 
 		Nic::Mac_address _mac_addr;
 
-		char const *_packet;
-
 		enum { READ = 0, WRITE = 1 };
 
 		int _pipefd[2];
 		Genode::Semaphore _startup_lock;
-		Genode::Semaphore _tx_lock;
 
-	protected:
+		/*
+		 * Packets sent by the Nic client are taken from the packet stream
+		 * by the entrypoint in batches and queued for OpenVPN. The pipe
+		 * merely signals the transition of the queue from empty to
+		 * non-empty. OpenVPN acknowledges each packet right after copying
+		 * it. So, the entrypoint and the OpenVPN thread do not wait for
+		 * each other per packet and may run on different CPUs.
+		 */
+		enum { QUEUE_SIZE = 64 };
+
+		Genode::Packet_descriptor _queue[QUEUE_SIZE];
+
+		unsigned _queue_head = 0, _queue_tail = 0, _queue_count = 0;
+
+		bool _notified = false;
+
+		Genode::Lock _queue_lock { };
 
-		bool _send()
+		/* serializes the rx packet-stream source between both threads */
+		Genode::Lock _rx_lock { };
+
+		Stats _stats { };
+
+		void _release_acked_rx()
 		{
-			using namespace Genode;
+			Genode::Lock::Guard guard(_rx_lock);
 
-			if (!_tx.sink()->ready_to_ack())
-				return false;
+			while (_rx.source()->ack_avail())
+				_rx.source()->release_packet(_rx.source()->get_acked_packet());
+		}
 
-			if (!_tx.sink()->packet_avail())
-				return false;
+		/**
+		 * Move packets from the tx packet stream to the queue
+		 */
+		void _fetch_tx_packets()
+		{
+			using namespace Genode;
 
-			Packet_descriptor packet = _tx.sink()->get_packet();
-			if (!packet.size()) {
-				Genode::warning("invalid tx packet");
-				return true;
-			}
+			Lock::Guard guard(_queue_lock);
 
-			_packet = _tx.sink()->packet_content(packet);
+			while (_queue_count < QUEUE_SIZE
+			    && _tx.sink()->ready_to_ack()
+			    && _tx.sink()->packet_avail()) {
 
-			/* notify openvpn */
-			::write(_pipefd[WRITE], "1", 1);
+				Packet_descriptor const packet = _tx.sink()->get_packet();
+				if (!packet.size()) {
+					Genode::warning("invalid tx packet");
+					_tx.sink()->acknowledge_packet(packet);
+					continue;
+				}
 
-			/* block while openvpn handles the packet */
-			_tx_lock.down();
-			_tx.sink()->acknowledge_packet(packet);
+				_queue[_queue_tail] = packet;
+				_queue_tail = (_queue_tail + 1) % QUEUE_SIZE;
+				_queue_count++;
+			}
 
-			return true;
+			/* notify openvpn */
+			if (_queue_count && !_notified) {
+				::write(_pipefd[WRITE], "1", 1);
+				_notified = true;
+			}
 		}
 
+	protected:
+
 		void _handle_packet_stream() override
 		{
-			while (_rx.source()->ack_avail())
-				_rx.source()->release_packet(_rx.source()->get_acked_packet());
-
-			while (_send()) ;
+			_release_acked_rx();
+			_fetch_tx_packets();
 		}
 
 	public:
@@ -144,6 +190,8 @@ class Openvpn_component : public Tuntap_device,
 			}
 		}
 
+		Stats const &stats() const { return _stats; }
+
 		/**************************************
 		 ** Nic::Session_component interface **
 		 **************************************/
@@ -165,11 +213,40 @@ class Openvpn_component : public Tuntap_device,
 		/* tx */
 		int read(char *buf, Genode::size_t len)
 		{
-			Genode::memcpy(buf, _packet, len);
-			_packet = 0;
+			using namespace Genode;
 
-			/* unblock nic client */
-			_tx_lock.up();
+			Packet_descriptor packet;
+			bool              resume = false;
+			{
+				Lock::Guard guard(_queue_lock);
+
+				if (!_queue_count)
+					return 0;
+
+				packet = _queue[_queue_head];
+				_queue_head = (_queue_head + 1) % QUEUE_SIZE;
+
+				/* the entrypoint stopped fetching packets */
+				resume = (_queue_count-- == QUEUE_SIZE);
+
+				/* the notification is consumed with the last packet */
+				if (!_queue_count) {
+					char tmp[1];
+					::read(_pipefd[READ], tmp, sizeof(tmp));
+					_notified = false;
+					_stats.tx_batches++;
+				}
+			}
+
+			len = min(len, packet.size());
+			memcpy(buf, _tx.sink()->packet_content(packet), len);
+			_tx.sink()->acknowledge_packet(packet);
+
+			_stats.tx_packets++;
+			_stats.tx_bytes += len;
+
+			if (resume)
+				Signal_transmitter(_packet_stream_dispatcher).submit();
 
 			return len;
 		}
@@ -177,7 +254,9 @@ class Openvpn_component : public Tuntap_device,
 		/* rx */
 		int write(char const *buf, Genode::size_t len)
 		{
-			_handle_packet_stream();
+			_release_acked_rx();
+
+			Genode::Lock::Guard guard(_rx_lock);
 
 			if (!_rx.source()->ready_to_submit())
 				return 0;
@@ -188,6 +267,9 @@ class Openvpn_component : public Tuntap_device,
 				_rx.source()->submit_packet(packet);
 			} catch (...) { return 0; }
 
+			_stats.rx_packets++;
+			_stats.rx_bytes += len;
+
 			return len;
 		}
 
@@ -197,6 +279,77 @@ class Openvpn_component : public Tuntap_device,
 };
 
 
+/**
+ * Periodic report of the data-channel throughput
+ */
+class Throughput_reporter
+{
+	private:
+
+		Timer::Connection _timer;
+
+		Openvpn_component *_session = nullptr;
+
+		Openvpn_component::Stats _last { };
+
+		unsigned long _last_ms = 0;
+
+		unsigned const _num_cpus;
+
+		Genode::Signal_handler<Throughput_reporter> _handler;
+
+		static unsigned long _mbit_per_s(unsigned long bytes, unsigned long ms) {
+			return ms ? (bytes*8/1000)/ms : 0; }
+
+		void _handle_timeout()
+		{
+			if (!_session)
+				return;
+
+			Openvpn_component::Stats const curr = _session->stats();
+
+			unsigned long const now = _timer.elapsed_ms();
+			unsigned long const ms  = now - _last_ms;
+
+			unsigned long const tx_packets = curr.tx_packets - _last.tx_packets;
+			unsigned long const tx_batches = curr.tx_batches - _last.tx_batches;
+			unsigned long const tx_mbit    = _mbit_per_s(curr.tx_bytes - _last.tx_bytes, ms);
+			unsigned long const rx_mbit    = _mbit_per_s(curr.rx_bytes - _last.rx_bytes, ms);
+
+			Genode::log("data channel: "
+			            "tun->vpn ", tx_mbit, " Mbit/s "
+			            "(", tx_packets, " packets, ",
+			            tx_batches ? tx_packets/tx_batches : 0, " per batch), "
+			            "vpn->tun ", rx_mbit, " Mbit/s "
+			            "(", curr.rx_packets - _last.rx_packets, " packets), ",
+			            (tx_mbit + rx_mbit)/_num_cpus, " Mbit/s per core "
+			            "on ", _num_cpus, " CPU", _num_cpus > 1 ? "s" : "");
+
+			_last    = curr;
+			_last_ms = now;
+		}
+
+	public:
+
+		Throughput_reporter(Genode::Env &env, unsigned long interval_ms,
+		                    unsigned num_cpus)
+		:
+			_timer(env), _num_cpus(num_cpus),
+			_handler(env.ep(), *this, &Throughput_reporter::_handle_timeout)
+		{
+			_timer.sigh(_handler);
+			_timer.trigger_periodic(interval_ms*1000);
+		}
+
+		void session(Openvpn_component *session)
+		{
+			_session = session;
+			_last    = session ? session->stats() : Openvpn_component::Stats();
+			_last_ms = _timer.elapsed_ms();
+		}
+};
+
+
 class Root : public Genode::Root_component<Openvpn_component, Genode::Single_client>
 {
 	private:
@@ -205,6 +358,43 @@ class Root : public Genode::Root_component<Openvpn_component, Genode::Single_cli
 		Genode::Heap        _heap { _env.ram(), _env.rm() };
 		Openvpn_thread     *_thread = nullptr;
 
+		Genode::Affinity::Location _openvpn_location { };
+
+		unsigned _data_channel_cpus = 1;
+
+		Genode::Constructible<Throughput_reporter> _reporter { };
+
+		/**
+		 * Evaluate the 'openvpn_cpu' and 'stats_interval_ms' config attributes
+		 *
+		 * By default, the OpenVPN thread, which performs the data-channel
+		 * crypto, is placed on the second CPU if available, while the
+		 * entrypoint serving the Nic session remains on the first CPU.
+		 */
+		void _apply_config()
+		{
+			Genode::Affinity::Space space = _env.cpu().affinity_space();
+
+			unsigned cpu = space.total() > 1 ? 1 : 0;
+			unsigned long stats_interval_ms = 0;
+
+			_env.config([&] (Genode::Xml_node const &config) {
+				cpu = config.attribute_value("openvpn_cpu", cpu);
+				stats_interval_ms = config.attribute_value("stats_interval_ms", 0UL);
+			});
+
+			if (cpu >= space.total()) {
+				Genode::warning("openvpn_cpu ", cpu, " exceeds affinity space");
+				cpu = 0;
+			}
+
+			_openvpn_location  = space.location_of_index(cpu);
+			_data_channel_cpus = cpu ? 2 : 1;
+
+			if (stats_interval_ms)
+				_reporter.construct(_env, stats_interval_ms, _data_channel_cpus);
+		}
+
 	protected:
 
 		Openvpn_component *_create_session(const char *args)
@@ -243,17 +433,24 @@ class Root : public Genode::Root_component<Openvpn_component, Genode::Single_cli
 			 */
 			_tuntap_dev = component;
 
-			_thread = new (_heap) Openvpn_thread(_env, genode_argc, genode_argv);
+			_thread = new (_heap) Openvpn_thread(_env, genode_argc, genode_argv,
+			                                     _openvpn_location);
 			_thread->start();
 
 			/* wait until OpenVPN configured the TUN/TAP device for the first time */
 			_tuntap_dev->down();
 
+			if (_reporter.constructed())
+				_reporter->session(component);
+
 			return component;
 		}
 
 		void _destroy_session(Openvpn_component *session)
 		{
+			if (_reporter.constructed())
+				_reporter->session(nullptr);
+
 			Genode::destroy(Root::md_alloc(), session);
 			Genode::destroy(Root::md_alloc(), _thread);
 			_thread = nullptr;
@@ -264,7 +461,9 @@ class Root : public Genode::Root_component<Openvpn_component, Genode::Single_cli
 		Root(Libc::Env &env)
 		: Genode::Root_component<Openvpn_component, Genode::Single_client>(env.ep(), _heap),
 			_env(env)
-		{ }
+		{
+			_apply_config();
+		}
 };
 
 
@@ -90,12 +90,11 @@ extern "C" int read_tun(struct tuntap *tt, uint8_t *buf, int len)
 	if (len <= 0)
 		return -1;
 
-	{
-		/* read from fd to prevent select() from triggering more than once */
-		char tmp[1];
-		::read(tt->fd, tmp, sizeof (tmp));
-	}
-
+	/*
+	 * The device consumes the notification from the fd along with the
+	 * last queued packet. So, select() keeps triggering while packets
+	 * are pending.
+	 */
 	switch (tt->type) {
 	case DEV_TYPE_TAP:
 		return tuntap_dev()->read(reinterpret_cast<char*>(buf), len);
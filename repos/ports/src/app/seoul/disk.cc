@@ -67,6 +67,7 @@ Seoul::Disk::Disk(Genode::Env &env, Synced_motherboard &mb,
 	/* initialize struct with 0 size */
 	for (int i=0; i < MAX_DISKS; i++) {
 		_diskcon[i].blk_size = 0;
+		_diskcon[i].batched  = 0;
 	}
 }
 
@@ -78,6 +79,32 @@ void Seoul::Disk::register_host_operations(Motherboard &motherboard)
 
 void Seoul::Disk_signal::_signal() { _obj.handle_disk(_id); }
 
+
+void Seoul::Disk::_flush(unsigned disknr)
+{
+	Block::Session::Tx::Source *source = _diskcon[disknr].blk_con->tx();
+
+	unsigned const count = _diskcon[disknr].batched;
+	unsigned       done  = source->submit_packets(_diskcon[disknr].batch, count);
+
+	/* wait for the block server to make room for the remaining requests */
+	for (; done < count; done++)
+		source->submit_packet(_diskcon[disknr].batch[done]);
+
+	_diskcon[disknr].batched = 0;
+}
+
+
+void Seoul::Disk::flush()
+{
+	Genode::Lock::Guard guard(_batch_lock);
+
+	for (unsigned i = 0; i < MAX_DISKS; i++)
+		if (_diskcon[i].batched)
+			_flush(i);
+}
+
+
 void Seoul::Disk::handle_disk(unsigned disknr)
 {
 	Block::Session::Tx::Source *source = _diskcon[disknr].blk_con->tx();
@@ -292,7 +319,11 @@ bool Seoul::Disk::receive(MessageDisk &msg)
 				}
 			}
 
-			source->submit_packet(packet);
+			Genode::Lock::Guard guard(_batch_lock);
+
+			_diskcon[msg.disknr].batch[_diskcon[msg.disknr].batched++] = packet;
+			if (_diskcon[msg.disknr].batched == MAX_BATCH)
+				_flush(msg.disknr);
 		}
 		break;
 	default:
@@ -89,13 +89,17 @@ class Seoul::Disk : public StaticReceiver<Seoul::Disk>
 		};
 
 		/* block session used by disk models of VMM */
-		enum { MAX_DISKS = 4 };
+		enum { MAX_DISKS = 4, MAX_BATCH = 32 };
 		struct {
 			Block::Connection          *blk_con;
 			Block::Session::Operations  ops;
 			Genode::size_t              blk_size;
 			Block::sector_t             blk_cnt;
 			Disk_signal                *signal;
+
+			/* requests not yet submitted to the block session */
+			Block::Packet_descriptor    batch[MAX_BATCH];
+			unsigned                    batched;
 		} _diskcon[MAX_DISKS];
 
 		Synced_motherboard &_motherboard;
@@ -117,6 +121,10 @@ class Seoul::Disk : public StaticReceiver<Seoul::Disk>
 		Genode::Avl_tree<Avl_entry> _lookup_msg;
 		Genode::Lock           _lookup_msg_lock;
 
+		Genode::Lock           _batch_lock;
+
+		void _flush(unsigned disknr);
+
 	public:
 
 		/**
@@ -131,6 +139,15 @@ class Seoul::Disk : public StaticReceiver<Seoul::Disk>
 
 		bool receive(MessageDisk &msg);
 
+		/**
+		 * Submit the batched requests of all disks
+		 *
+		 * Requests issued by the device models get collected until the
+		 * handling of the VM exit that caused them is finished. Hence, the
+		 * block server is woken up once per batch.
+		 */
+		void flush();
+
 		void register_host_operations(Motherboard &);
 };
 
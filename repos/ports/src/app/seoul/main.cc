@@ -105,6 +105,8 @@ class Timeouts
 
 		Genode::Signal_handler<Timeouts> _timeout_sigh;
 
+		Seoul::Disk *_disk = nullptr;
+
 		void check_timeouts()
 		{
 			timevalue const now = _motherboard()->clock()->time();
@@ -121,6 +123,10 @@ class Timeouts
 				_motherboard()->bus_timeout.send(msg);
 			}
 
+			/* device models may issue disk requests on timeouts */
+			if (_disk)
+				_disk->flush();
+
 
 			unsigned long long next = _timeouts()->timeout();
 
@@ -141,6 +147,8 @@ class Timeouts
 			Genode::Signal_transmitter(_timeout_sigh).submit();
 		}
 
+		void disk(Seoul::Disk &disk) { _disk = &disk; }
+
 		/**
 		 * Constructor
 		 */
@@ -289,6 +297,13 @@ class Vcpu_dispatcher : public Vcpu_handler,
 		 */
 		Genode::Synced_interface<VCpu> _vcpu;
 
+		/*
+		 * Lock and model of the vCPU for sending several messages while
+		 * holding the lock only once
+		 */
+		Genode::Lock &_vcpu_lock;
+		VCpu         &_unsynchronized_vcpu;
+
 		Vmm::Vcpu_thread *_vcpu_thread;
 
 		/**
@@ -301,6 +316,11 @@ class Vcpu_dispatcher : public Vcpu_handler,
 		 */
 		Synced_motherboard &_motherboard;
 
+		/**
+		 * Disk requests get submitted in one batch at the end of a VM exit
+		 */
+		Seoul::Disk *_disk;
+
 
 		/***************
 		 ** Shortcuts **
@@ -340,34 +360,47 @@ class Vcpu_dispatcher : public Vcpu_handler,
 			if (skip == SKIP)
 				_skip_instruction(msg);
 
-			/**
-			 * Send the message to the VCpu.
-			 */
-			if (!_vcpu()->executor.send(msg, true))
-				Logging::panic("nobody to execute %s at %x:%x\n",
-				               __func__, msg.cpu->cs.sel, msg.cpu->eip);
+			{
+				/* acquire the lock once for all messages of this exit */
+				Genode::Lock::Guard guard(_vcpu_lock);
 
-			/**
-			 * Check whether we should inject something...
-			 */
-			if (msg.mtr_in & MTD_INJ && msg.type != CpuMessage::TYPE_CHECK_IRQ) {
-				msg.type = CpuMessage::TYPE_CHECK_IRQ;
-				if (!_vcpu()->executor.send(msg, true))
+				/**
+				 * Send the message to the VCpu.
+				 */
+				if (!_unsynchronized_vcpu.executor.send(msg, true))
 					Logging::panic("nobody to execute %s at %x:%x\n",
 					               __func__, msg.cpu->cs.sel, msg.cpu->eip);
-			}
 
-			/**
-			 * If the IRQ injection is performed, recalc the IRQ window.
-			 */
-			if (msg.mtr_out & MTD_INJ) {
-				msg.type = CpuMessage::TYPE_CALC_IRQWINDOW;
-				if (!_vcpu()->executor.send(msg, true))
-					Logging::panic("nobody to execute %s at %x:%x\n",
-					               __func__, msg.cpu->cs.sel, msg.cpu->eip);
+				/**
+				 * Check whether we should inject something...
+				 */
+				if (msg.mtr_in & MTD_INJ && msg.type != CpuMessage::TYPE_CHECK_IRQ) {
+					msg.type = CpuMessage::TYPE_CHECK_IRQ;
+					if (!_unsynchronized_vcpu.executor.send(msg, true))
+						Logging::panic("nobody to execute %s at %x:%x\n",
+						               __func__, msg.cpu->cs.sel, msg.cpu->eip);
+				}
+
+				/**
+				 * If the IRQ injection is performed, recalc the IRQ window.
+				 */
+				if (msg.mtr_out & MTD_INJ) {
+					msg.type = CpuMessage::TYPE_CALC_IRQWINDOW;
+					if (!_unsynchronized_vcpu.executor.send(msg, true))
+						Logging::panic("nobody to execute %s at %x:%x\n",
+						               __func__, msg.cpu->cs.sel, msg.cpu->eip);
+				}
 			}
 
 			msg.cpu->mtd = msg.mtr_out;
+
+			_flush_disk();
+		}
+
+		void _flush_disk()
+		{
+			if (_disk)
+				_disk->flush();
 		}
 
 		/**
@@ -519,6 +552,8 @@ class Vcpu_dispatcher : public Vcpu_handler,
 			}
 
 			utcb->mtd = msg.mtr_out;
+
+			_flush_disk();
 		}
 
 		/* SVM portal functions */
@@ -728,6 +763,7 @@ class Vcpu_dispatcher : public Vcpu_handler,
 		                VCpu                   *unsynchronized_vcpu,
 		                Guest_memory           &guest_memory,
 		                Synced_motherboard     &motherboard,
+		                Seoul::Disk            *disk,
 		                bool                    has_svm,
 		                bool                    has_vmx,
 		                Vmm::Vcpu_thread       *vcpu_thread,
@@ -736,9 +772,12 @@ class Vcpu_dispatcher : public Vcpu_handler,
 		:
 			Vcpu_handler(env, STACK_SIZE, cpu_session, location),
 			_vcpu(vcpu_lock, unsynchronized_vcpu),
+			_vcpu_lock(vcpu_lock),
+			_unsynchronized_vcpu(*unsynchronized_vcpu),
 			_vcpu_thread(vcpu_thread),
 			_guest_memory(guest_memory),
-			_motherboard(motherboard)
+			_motherboard(motherboard),
+			_disk(disk)
 		{
 			using namespace Genode;
 			using namespace Nova;
@@ -890,10 +929,16 @@ class Machine : public StaticReceiver<Machine>
 		bool                   _colocate_vm_vmm;
 		unsigned short         _vcpus_up = 0;
 
+		/* host CPUs of the vCPUs as configured */
+		enum { MAX_VCPUS = 32 };
+		unsigned               _vcpu_cpus[MAX_VCPUS];
+		unsigned               _vcpu_cpus_count = 0;
+
 		bool                   _alloc_fb_mem = false; /* For detecting FB alloc message */
 		Genode::Pd_connection *_pd_vcpus     = nullptr;
 		Seoul::Network        *_nic          = nullptr;
 		Rtc::Session          *_rtc          = nullptr;
+		Seoul::Disk           *_disk         = nullptr;
 
 	public:
 
@@ -967,8 +1012,12 @@ class Machine : public StaticReceiver<Machine>
 
 					_vcpus_up ++;
 
+					/* by default, vCPUs are placed on consecutive host CPUs */
+					unsigned const cpu = _vcpus_up <= _vcpu_cpus_count
+					                   ? _vcpu_cpus[_vcpus_up - 1] : _vcpus_up;
+
 					Genode::Affinity::Space cpu_space = _cpu_session.affinity_space();
-					Genode::Affinity::Location location = cpu_space.location_of_index(_vcpus_up);
+					Genode::Affinity::Location location = cpu_space.location_of_index(cpu);
 
 					Vmm::Vcpu_thread * vcpu_thread;
 					if (_colocate_vm_vmm)
@@ -986,6 +1035,7 @@ class Machine : public StaticReceiver<Machine>
 						                    msg.vcpu,
 						                    _guest_memory,
 						                    _motherboard,
+						                    _disk,
 						                    _hip->has_feature_svm(),
 						                    _hip->has_feature_vmx(),
 						                    vcpu_thread,
@@ -1270,6 +1320,37 @@ class Machine : public StaticReceiver<Machine>
 		class Config_error { };
 
 
+		/**
+		 * Pin vCPUs to host CPUs
+		 *
+		 * \param vcpus_node  XML node containing a 'vcpu' sub node with a
+		 *                    'cpu' attribute for each vCPU in the order of
+		 *                    the vCPUs
+		 *
+		 * The 'cpu' attribute denotes the index within the affinity space of
+		 * the VMM. vCPUs without a sub node are placed on consecutive CPUs.
+		 */
+		void pin_vcpus(Genode::Xml_node vcpus_node)
+		{
+			vcpus_node.for_each_sub_node("vcpu", [&] (Genode::Xml_node vcpu) {
+				if (_vcpu_cpus_count == MAX_VCPUS)
+					return;
+
+				unsigned const cpu = vcpu.attribute_value("cpu", _vcpu_cpus_count + 1);
+				_vcpu_cpus[_vcpu_cpus_count++] = cpu;
+			});
+		}
+
+		/**
+		 * Register disk back end for flushing batched requests
+		 */
+		void disk(Seoul::Disk &disk)
+		{
+			_disk = &disk;
+			_alarm_thread.disk(disk);
+		}
+
+
 		/**
 		 * Configure virtual machine according to the provided XML description
 		 *
@@ -1501,6 +1582,12 @@ void Component::construct(Genode::Env &env)
 
 	vdisk.register_host_operations(machine.unsynchronized_motherboard());
 
+	machine.disk(vdisk);
+
+	try {
+		machine.pin_vcpus(config.xml().sub_node("vcpus"));
+	} catch (Genode::Xml_node::Nonexistent_sub_node) { }
+
 	machine.setup_devices(config.xml().sub_node("machine"));
 
 	Genode::log("\n--- Booting VM ---");
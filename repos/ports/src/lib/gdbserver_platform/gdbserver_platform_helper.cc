@@ -14,6 +14,7 @@
 #include <cpu_thread/client.h>
 
 #include "cpu_session_component.h"
+#include "cpu_thread_component.h"
 #include "genode_child_resources.h"
 
 extern "C" {
@@ -33,27 +34,34 @@ extern Genode_child_resources *genode_child_resources();
 static constexpr bool verbose = false;
 
 
-Thread_state get_current_thread_state()
+/*
+ * The thread state is accessed via the local 'Cpu_thread_component' instead
+ * of an RPC to it, which would bypass the cached state of stopped threads.
+ */
+static Cpu_thread_component &current_cpu_thread()
 {
 	Cpu_session_component &csc = genode_child_resources()->cpu_session_component();
 
 	ptid_t ptid = ((struct inferior_list_entry*)current_inferior)->id;
 
-	Cpu_thread_client cpu_thread(csc.thread_cap(ptid.lwp));
+	Cpu_thread_component *cpu_thread = csc.lookup_cpu_thread(ptid.lwp);
 
-	return cpu_thread.state();
+	if (!cpu_thread)
+		throw Cpu_thread::State_access_failed();
+
+	return *cpu_thread;
 }
 
 
-void set_current_thread_state(Thread_state thread_state)
+Thread_state get_current_thread_state()
 {
-	Cpu_session_component &csc = genode_child_resources()->cpu_session_component();
-
-	ptid_t ptid = ((struct inferior_list_entry*)current_inferior)->id;
+	return current_cpu_thread().state();
+}
 
-	Cpu_thread_client cpu_thread(csc.thread_cap(ptid.lwp));
 
-	cpu_thread.state(thread_state);
+void set_current_thread_state(Thread_state thread_state)
+{
+	current_cpu_thread().state(thread_state);
 }
 
 
@@ -124,6 +124,10 @@ class Noux::Child : public Rpc_object<Session>,
 
 		Env &_env;
 
+		Cow_backend &_cow_backend;
+
+		size_t const _pipe_buffer_size;
+
 		Vfs::Dir_file_system &_root_dir;
 
 		Vfs_io_waiter_registry &_vfs_io_waiter_registry;
@@ -157,7 +161,8 @@ class Noux::Child : public Rpc_object<Session>,
 		 * Locally-provided PD service
 		 */
 		typedef Local_service<Pd_session_component> Pd_service;
-		Pd_session_component _pd { _heap, _env, _ep, _name, _ds_registry };
+		Pd_session_component _pd { _heap, _env, _ep, _name, _ds_registry,
+		                           _cow_backend };
 		Pd_service::Single_session_factory _pd_factory { _pd };
 		Pd_service                         _pd_service { _pd_factory };
 
@@ -302,6 +307,7 @@ class Noux::Child : public Rpc_object<Session>,
 		/**
 		 * Constructor
 		 *
+		 * \param pipe_buffer_size  buffer size of pipes created by the child
 		 * \param forked  false if the child is spawned directly from
 		 *                an executable binary (i.e., the init process,
 		 *                or children created via execve, or
@@ -324,6 +330,8 @@ class Noux::Child : public Rpc_object<Session>,
 		      Pid_allocator            &pid_allocator,
 		      int                       pid,
 		      Env                      &env,
+		      Cow_backend              &cow_backend,
+		      size_t                    pipe_buffer_size,
 		      Vfs::Dir_file_system     &root_dir,
 		      Vfs_io_waiter_registry   &vfs_io_waiter_registry,
 		      Args               const &args,
@@ -346,6 +354,8 @@ class Noux::Child : public Rpc_object<Session>,
 			_parent_execve(parent_execve),
 			_pid_allocator(pid_allocator),
 			_env(env),
+			_cow_backend(cow_backend),
+			_pipe_buffer_size(pipe_buffer_size),
 			_root_dir(root_dir),
 			_vfs_io_waiter_registry(vfs_io_waiter_registry),
 			_destruct_queue(destruct_queue),
@@ -526,6 +536,8 @@ class Noux::Child : public Rpc_object<Session>,
 			                                 _pid_allocator,
 			                                 pid(),
 			                                 _env,
+			                                 _cow_backend,
+			                                 _pipe_buffer_size,
 			                                 _root_dir,
 			                                 _vfs_io_waiter_registry,
 			                                 args,
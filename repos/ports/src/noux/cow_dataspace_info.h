@@ -0,0 +1,341 @@
+/*
+ * \brief  Copy-on-write RAM dataspaces of Noux processes
+ * \author Genode Labs
+ * \date   2026-10-14
+ *
+ * Large RAM dataspaces are handed out to Noux processes as managed
+ * dataspaces composed of chunks. When forking a process, the chunks are
+ * shared by the original and the clone and detached from both. The first
+ * access of either party to a shared chunk triggers a region-map fault,
+ * which is resolved by copying the chunk for the faulting party. The last
+ * user of a chunk gets the chunk attached as is. Hence, each chunk is copied
+ * at most once and chunks not touched after the fork are not copied at all.
+ * Because a region map cannot attach a RAM dataspace read-only, reading a
+ * shared chunk copies it in the same way as writing.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _NOUX__COW_DATASPACE_INFO_H_
+#define _NOUX__COW_DATASPACE_INFO_H_
+
+/* Genode includes */
+#include <base/attached_dataspace.h>
+#include <base/signal.h>
+#include <rm_session/connection.h>
+#include <region_map/client.h>
+
+/* Noux includes */
+#include <dataspace_registry.h>
+
+namespace Noux {
+	class Cow_backend;
+	class Cow_dataspace_info;
+}
+
+
+/**
+ * Resources shared by all copy-on-write dataspaces of a Noux instance
+ */
+class Noux::Cow_backend : Noncopyable
+{
+	private:
+
+		Env &_env;
+
+		bool const _enabled;
+
+		Constructible<Rm_connection> _rm;
+
+		Lock _lock;
+
+	public:
+
+		enum { CHUNK_SIZE = 256*1024, MIN_DS_SIZE = 4*CHUNK_SIZE };
+
+		/**
+		 * Constructor
+		 *
+		 * \param enabled  false to copy all RAM dataspaces eagerly on fork,
+		 *                 e.g., on kernels without managed dataspaces
+		 */
+		Cow_backend(Env &env, bool enabled) : _env(env), _enabled(enabled)
+		{
+			if (_enabled)
+				_rm.construct(_env);
+		}
+
+		/**
+		 * Return true if a RAM dataspace of 'size' bytes is copied on write
+		 */
+		bool suitable(size_t size) const {
+			return _enabled && size >= MIN_DS_SIZE; }
+
+		Env  &env()  { return _env;  }
+		Lock &lock() { return _lock; }
+
+		Capability<Region_map> create(size_t size)
+		{
+			for (;;) {
+				try { return _rm->create(size); }
+				catch (Out_of_ram)  { _rm->upgrade_ram(8*1024); }
+				catch (Out_of_caps) { _rm->upgrade_caps(2); }
+			}
+		}
+
+		void destroy(Capability<Region_map> rm) { _rm->destroy(rm); }
+
+		void attach(Region_map &rm, Dataspace_capability ds, size_t size,
+		            addr_t at)
+		{
+			for (;;) {
+				try {
+					rm.attach_at(ds, at, size);
+					return;
+				}
+				catch (Out_of_ram)  { _rm->upgrade_ram(8*1024); }
+				catch (Out_of_caps) { _rm->upgrade_caps(2); }
+			}
+		}
+
+		/**
+		 * Return copy of the first 'size' bytes of RAM dataspace 'src'
+		 */
+		Ram_dataspace_capability copy(Dataspace_capability src, size_t size)
+		{
+			Ram_dataspace_capability const dst = _env.ram().alloc(size);
+
+			Attached_dataspace src_ds(_env.rm(), src);
+			Attached_dataspace dst_ds(_env.rm(), dst);
+			memcpy(dst_ds.local_addr<char>(), src_ds.local_addr<char>(), size);
+
+			return dst;
+		}
+};
+
+
+class Noux::Cow_dataspace_info : public Dataspace_info,
+                                 public List<Cow_dataspace_info>::Element
+{
+	private:
+
+		enum { CHUNK_SIZE = Cow_backend::CHUNK_SIZE };
+
+		/**
+		 * Backing store shared by all clones of a dataspace
+		 */
+		struct Chunk
+		{
+			Ram_dataspace_capability ds;
+			unsigned                 users;
+		};
+
+		struct Slot
+		{
+			Chunk *chunk;
+			bool   attached;
+		};
+
+		Cow_backend &_backend;
+
+		Allocator &_alloc;
+
+		Capability<Region_map> const _rm_cap;
+		Region_map_client            _rm { _rm_cap };
+
+		unsigned const _num_slots = (size() + CHUNK_SIZE - 1) / CHUNK_SIZE;
+
+		Slot * const _slots = (Slot *)_alloc.alloc(_num_slots*sizeof(Slot));
+
+		Signal_handler<Cow_dataspace_info> _fault_handler {
+			_backend.env().ep(), *this, &Cow_dataspace_info::_handle_fault };
+
+		size_t _chunk_size(unsigned i) const {
+			return min((size_t)CHUNK_SIZE, size() - i*CHUNK_SIZE); }
+
+		void _attach(unsigned i)
+		{
+			_backend.attach(_rm, _slots[i].chunk->ds, _chunk_size(i),
+			                i*CHUNK_SIZE);
+			_slots[i].attached = true;
+		}
+
+		void _detach(unsigned i)
+		{
+			_rm.detach(i*CHUNK_SIZE);
+			_slots[i].attached = false;
+		}
+
+		/**
+		 * Make chunk private and attach it, called with the backend locked
+		 */
+		void _resolve(unsigned i)
+		{
+			Slot &slot = _slots[i];
+			if (slot.attached)
+				return;
+
+			if (slot.chunk->users > 1) {
+				Ram_dataspace_capability const ds =
+					_backend.copy(slot.chunk->ds, _chunk_size(i));
+
+				slot.chunk->users--;
+				slot.chunk = new (_alloc) Chunk { ds, 1 };
+			}
+			_attach(i);
+		}
+
+		void _handle_fault()
+		{
+			Lock::Guard guard(_backend.lock());
+
+			for (;;) {
+				Region_map::State const state = _rm.state();
+				if (state.type == Region_map::State::READY)
+					return;
+
+				unsigned const i = state.addr / CHUNK_SIZE;
+				if (i >= _num_slots || _slots[i].attached) {
+					error("unresolvable fault in copy-on-write dataspace at ",
+					      Hex(state.addr));
+					return;
+				}
+				_resolve(i);
+			}
+		}
+
+		void _release()
+		{
+			Lock::Guard guard(_backend.lock());
+
+			for (unsigned i = 0; i < _num_slots; i++) {
+				Chunk * const chunk = _slots[i].chunk;
+				if (!chunk || --chunk->users)
+					continue;
+
+				_backend.env().ram().free(chunk->ds);
+				destroy(_alloc, chunk);
+			}
+			_alloc.free(_slots, _num_slots*sizeof(Slot));
+		}
+
+	public:
+
+		/**
+		 * Constructor for a dataspace with fresh backing store
+		 *
+		 * \param rm  managed region map created via 'Cow_backend::create'
+		 */
+		Cow_dataspace_info(Cow_backend &backend, Allocator &alloc,
+		                   Capability<Region_map> rm)
+		:
+			Dataspace_info(Region_map_client(rm).dataspace()),
+			_backend(backend), _alloc(alloc), _rm_cap(rm)
+		{
+			for (unsigned i = 0; i < _num_slots; i++)
+				_slots[i] = Slot { nullptr, false };
+
+			try {
+				for (unsigned i = 0; i < _num_slots; i++) {
+					Ram_dataspace_capability const ds =
+						_backend.env().ram().alloc(_chunk_size(i));
+
+					_slots[i].chunk = new (_alloc) Chunk { ds, 1 };
+					_attach(i);
+				}
+			} catch (...) {
+				_release();
+				_backend.destroy(_rm_cap);
+				throw;
+			}
+			_rm.fault_handler(_fault_handler);
+		}
+
+		/**
+		 * Constructor for a clone that shares the chunks of 'origin'
+		 */
+		Cow_dataspace_info(Cow_dataspace_info &origin, Allocator &alloc,
+		                   Capability<Region_map> rm)
+		:
+			Dataspace_info(Region_map_client(rm).dataspace()),
+			_backend(origin._backend), _alloc(alloc), _rm_cap(rm)
+		{
+			Lock::Guard guard(_backend.lock());
+
+			for (unsigned i = 0; i < _num_slots; i++) {
+				Slot &src = origin._slots[i];
+
+				_slots[i] = Slot { src.chunk, false };
+				src.chunk->users++;
+
+				/* force the origin to fault on its next access */
+				if (src.attached)
+					origin._detach(i);
+			}
+			_rm.fault_handler(_fault_handler);
+		}
+
+		~Cow_dataspace_info()
+		{
+			_release();
+			_backend.destroy(_rm_cap);
+		}
+
+		Dataspace_capability fork(Ram_allocator      &,
+		                          Region_map         &,
+		                          Allocator          &alloc,
+		                          Dataspace_registry &ds_registry,
+		                          Rpc_entrypoint     &) override
+		{
+			try {
+				Cow_dataspace_info *clone = new (alloc)
+					Cow_dataspace_info(*this, alloc, _backend.create(size()));
+
+				ds_registry.insert(clone);
+				return clone->ds_cap();
+
+			} catch (...) {
+				error("fork of copy-on-write dataspace failed");
+				return Dataspace_capability();
+			}
+		}
+
+		void poke(Region_map &rm, addr_t dst_offset, char const *src, size_t len) override
+		{
+			if (!src) return;
+
+			if ((dst_offset >= size()) || (dst_offset + len > size())) {
+				error("illegal attemt to write beyond dataspace boundary");
+				return;
+			}
+
+			Lock::Guard guard(_backend.lock());
+
+			while (len) {
+				unsigned const i      = dst_offset / CHUNK_SIZE;
+				addr_t   const offset = dst_offset % CHUNK_SIZE;
+				size_t   const n      = min(len, _chunk_size(i) - offset);
+
+				try {
+					_resolve(i);
+
+					Attached_dataspace ds(rm, _slots[i].chunk->ds);
+					memcpy(ds.local_addr<char>() + offset, src, n);
+				} catch (...) {
+					warning("poke: failed to attach RAM dataspace");
+					return;
+				}
+
+				dst_offset += n;
+				src        += n;
+				len        -= n;
+			}
+		}
+};
+
+#endif /* _NOUX__COW_DATASPACE_INFO_H_ */
@@ -21,6 +21,7 @@
 #include <construct.h>
 #include <noux_session/sysio.h>
 #include <vfs_io_channel.h>
+#include <pipe_io_channel.h>
 #include <terminal_io_channel.h>
 #include <user_info.h>
 #include <io_receptor_registry.h>
@@ -243,6 +244,8 @@ struct Noux::Main
 
 	Pid_allocator _pid_allocator;
 
+	Cow_backend _cow_backend { _env, _config.xml().attribute_value("copy_on_write", true) };
+
 	Timeout_scheduler _timeout_scheduler { _env };
 
 	User_info _user_info { _config.xml() };
@@ -284,6 +287,9 @@ struct Noux::Main
 	                          _pid_allocator,
 	                          _pid_allocator.alloc(),
 	                          _env,
+	                          _cow_backend,
+	                          _config.xml().attribute_value("pipe_buffer_size",
+	                                                        Number_of_bytes(Pipe::DEFAULT_BUFFER_SIZE)),
 	                          _root_dir,
 	                          _io_response_handler.io_waiter_registry,
 	                          _args_of_init_process(),
@@ -10,7 +10,8 @@
  * Furthermore, the custom implementation is needed to get hold of the RAM
  * dataspaces allocated by each Noux process. When forking a process, the
  * acquired information (in the form of 'Ram_dataspace_info' objects) is used
- * to create a shadow copy of the forking address space.
+ * to create a shadow copy of the forking address space. Large dataspaces
+ * are not copied eagerly but copy-on-write (see 'cow_dataspace_info.h').
  */
 
 /*
@@ -31,6 +32,7 @@
 /* Noux includes */
 #include <region_map_component.h>
 #include <dataspace_registry.h>
+#include <cow_dataspace_info.h>
 
 namespace Noux {
 	struct Ram_dataspace_info;
@@ -113,6 +115,10 @@ class Noux::Pd_session_component : public Rpc_object<Pd_session>
 
 		List<Ram_dataspace_info> _ds_list;
 
+		Cow_backend &_cow;
+
+		List<Cow_dataspace_info> _cow_ds_list;
+
 		Dataspace_registry &_ds_registry;
 
 		template <typename FUNC>
@@ -133,13 +139,15 @@ class Noux::Pd_session_component : public Rpc_object<Pd_session>
 		 */
 		Pd_session_component(Allocator &alloc, Env &env, Rpc_entrypoint &ep,
 		                     Child_policy::Name const &name,
-		                     Dataspace_registry &ds_registry)
+		                     Dataspace_registry &ds_registry,
+		                     Cow_backend &cow)
 		:
 			_ep(ep), _pd(env, name.string()), _ref_pd(env.pd()),
 			_address_space(alloc, _ep, ds_registry, _pd, _pd.address_space()),
 			_stack_area   (alloc, _ep, ds_registry, _pd, _pd.stack_area()),
 			_linker_area  (alloc, _ep, ds_registry, _pd, _pd.linker_area()),
-			_alloc(alloc), _ram(env.ram()), _ds_registry(ds_registry)
+			_alloc(alloc), _ram(env.ram()), _ds_registry(ds_registry),
+			_cow(cow)
 		{
 			_ep.manage(this);
 
@@ -159,6 +167,10 @@ class Noux::Pd_session_component : public Rpc_object<Pd_session>
 			Ram_dataspace_info *info = 0;
 			while ((info = _ds_list.first()))
 				free(static_cap_cast<Ram_dataspace>(info->ds_cap()));
+
+			Cow_dataspace_info *cow_info = 0;
+			while ((cow_info = _cow_ds_list.first()))
+				free(static_cap_cast<Ram_dataspace>(cow_info->ds_cap()));
 		}
 
 		Pd_session_capability core_pd_cap() { return _pd.cap(); }
@@ -268,6 +280,18 @@ class Noux::Pd_session_component : public Rpc_object<Pd_session>
 
 		Ram_dataspace_capability alloc(size_t size, Cache_attribute cached) override
 		{
+			if (cached == CACHED && _cow.suitable(size)) {
+				Cow_dataspace_info *ds_info = new (_alloc)
+					Cow_dataspace_info(_cow, _alloc, _cow.create(size));
+
+				_ds_registry.insert(ds_info);
+				_cow_ds_list.insert(ds_info);
+
+				_used_ram_quota = Ram_quota { _used_ram_quota.value + ds_info->size() };
+
+				return static_cap_cast<Ram_dataspace>(ds_info->ds_cap());
+			}
+
 			Ram_dataspace_capability ds_cap = _ram.alloc(size, cached);
 
 			Ram_dataspace_info *ds_info = new (_alloc) Ram_dataspace_info(ds_cap);
@@ -282,6 +306,26 @@ class Noux::Pd_session_component : public Rpc_object<Pd_session>
 
 		void free(Ram_dataspace_capability ds_cap) override
 		{
+			Cow_dataspace_info *cow_info = nullptr;
+
+			_ds_registry.apply(ds_cap, [&] (Cow_dataspace_info *cdi) {
+				if (!cdi)
+					return;
+
+				cow_info = cdi;
+
+				_ds_registry.remove(cow_info);
+				cow_info->dissolve_users();
+				_cow_ds_list.remove(cow_info);
+
+				_used_ram_quota = Ram_quota { _used_ram_quota.value - cdi->size() };
+			});
+
+			if (cow_info) {
+				destroy(_alloc, cow_info);
+				return;
+			}
+
 			Ram_dataspace_info *ds_info;
 
 			auto lambda = [&] (Ram_dataspace_info *rdi) {
@@ -308,9 +352,9 @@ class Noux::Pd_session_component : public Rpc_object<Pd_session>
 		size_t dataspace_size(Ram_dataspace_capability ds_cap) const override
 		{
 			size_t result = 0;
-			_ds_registry.apply(ds_cap, [&] (Ram_dataspace_info *rdi) {
-				if (rdi)
-					result = rdi->size(); });
+			_ds_registry.apply(ds_cap, [&] (Dataspace_info *info) {
+				if (info)
+					result = info->size(); });
 			return result;
 		}
 
@@ -24,36 +24,56 @@ namespace Noux {
 }
 
 
+/**
+ * Pipe buffer shared by the sink and the source I/O channel
+ *
+ * The signals for waking up the reader and the writer are batched. The
+ * reader is woken up once the buffer is filled up to the low watermark, the
+ * buffer is full, or the writer finished a write request. The writer is
+ * woken up once the reader freed up half of the buffer or drained it.
+ */
 class Noux::Pipe : public Reference_counter
 {
 	private:
 
 		Lock mutable _lock;
 
-		enum { BUFFER_SIZE = 4096 };
-		char _buffer[BUFFER_SIZE];
+		Allocator &_alloc;
+
+		size_t const _buffer_size;
+		char * const _buffer;
 
-		unsigned _read_offset;
-		unsigned _write_offset;
+		size_t const _low_watermark  = min(_buffer_size/4, (size_t)Sysio::CHUNK_SIZE);
+		size_t const _high_watermark = _buffer_size/2;
+
+		size_t _read_offset;
+		size_t _write_offset;
 
 		Signal_context_capability _read_ready_sigh;
 		Signal_context_capability _write_ready_sigh;
 
 		bool _writer_is_gone;
 
+		/*
+		 * Reader or writer may be blocked since the last wake-up
+		 */
+		bool _reader_wake_up_pending = false;
+		bool _writer_wake_up_pending = false;
+
+		size_t _avail_data() const
+		{
+			if (_read_offset <= _write_offset)
+				return _write_offset - _read_offset;
+
+			return _buffer_size - _read_offset + _write_offset;
+		}
+
 		/**
 		 * Return space available in the buffer for writing, in bytes
 		 */
 		size_t _avail_buffer_space() const
 		{
-			if (_read_offset < _write_offset)
-				return (BUFFER_SIZE - _write_offset) + _read_offset - 1;
-
-			if (_read_offset > _write_offset)
-				return _read_offset - _write_offset - 1;
-
-			/* _read_offset == _write_offset */
-			return BUFFER_SIZE - 1;
+			return _buffer_size - 1 - _avail_data();
 		}
 
 		bool _any_space_avail_for_writing() const
@@ -63,24 +83,42 @@ class Noux::Pipe : public Reference_counter
 
 		void _wake_up_reader()
 		{
+			_reader_wake_up_pending = false;
+
 			if (_read_ready_sigh.valid())
 				Signal_transmitter(_read_ready_sigh).submit();
 		}
 
 		void _wake_up_writer()
 		{
+			_writer_wake_up_pending = false;
+
 			if (_write_ready_sigh.valid())
 				Signal_transmitter(_write_ready_sigh).submit();
 		}
 
 	public:
 
-		Pipe()
-		: _read_offset(0), _write_offset(0), _writer_is_gone(false) { }
+		enum { DEFAULT_BUFFER_SIZE = 64*1024 };
+
+		/**
+		 * Constructor
+		 *
+		 * \param buffer_size  size of the pipe buffer in bytes
+		 */
+		Pipe(Allocator &alloc, size_t buffer_size)
+		:
+			_alloc(alloc),
+			_buffer_size(max(buffer_size, (size_t)4096)),
+			_buffer((char *)_alloc.alloc(_buffer_size)),
+			_read_offset(0), _write_offset(0), _writer_is_gone(false)
+		{ }
 
 		~Pipe()
 		{
 			Lock::Guard guard(_lock);
+
+			_alloc.free(_buffer, _buffer_size);
 		}
 
 		void writer_close()
@@ -121,36 +159,23 @@ class Noux::Pipe : public Reference_counter
 		{
 			Lock::Guard guard(_lock);
 
-			if (_read_offset < _write_offset) {
+			size_t const len = min(dst_len, _avail_data());
 
-				size_t len = min(dst_len, _write_offset - _read_offset);
-				memcpy(dst, &_buffer[_read_offset], len);
+			size_t const upper_len = min(len, _buffer_size - _read_offset);
+			memcpy(dst, &_buffer[_read_offset], upper_len);
+			memcpy(dst + upper_len, &_buffer[0], len - upper_len);
 
-				_read_offset += len;
-				_wake_up_writer();
-
-				return len;
-			}
+			_read_offset = (_read_offset + len) % _buffer_size;
 
-			if (_read_offset > _write_offset) {
+			/* the reader consumed the data it would have been woken up for */
+			if (_read_offset == _write_offset)
+				_reader_wake_up_pending = false;
 
-				size_t const upper_len = min(dst_len, BUFFER_SIZE - _read_offset);
-				memcpy(dst, &_buffer[_read_offset], upper_len);
-
-				size_t const lower_len = min(dst_len - upper_len, _write_offset);
-				if (lower_len) {
-					memcpy(dst + upper_len, &_buffer[0], lower_len);
-					_read_offset = lower_len;
-				} else {
-					_read_offset += upper_len;
-				}
+			if (_writer_wake_up_pending
+			 && (_avail_buffer_space() >= _high_watermark || !_avail_data()))
 				_wake_up_writer();
 
-				return upper_len + lower_len;
-			}
-
-			/* _read_offset == _write_offset */
-			return 0;
+			return len;
 		}
 
 		/**
@@ -165,42 +190,43 @@ class Noux::Pipe : public Reference_counter
 			/* trim write request to the available buffer space */
 			size_t const trimmed_len = min(len, _avail_buffer_space());
 
-			/*
-			 * Remember pipe state prior writing to see whether a reader
-			 * must be unblocked after writing.
-			 */
-			bool const pipe_was_empty = (_read_offset == _write_offset);
-
-			/* write data up to the upper boundary of the pipe buffer */
-			size_t const upper_len = min(BUFFER_SIZE - _write_offset, trimmed_len);
-			memcpy(&_buffer[_write_offset], src, upper_len);
-
-			_write_offset += upper_len;
+			/* a reader may block for incoming data */
+			if (_read_offset == _write_offset && trimmed_len)
+				_reader_wake_up_pending = true;
 
 			/*
-			 * Determine number of remaining bytes beyond the buffer boundary.
-			 * The buffer wraps. So this data will end up in the lower part
-			 * of the pipe buffer.
+			 * Write data up to the upper boundary of the pipe buffer, the
+			 * remaining data wraps around to the lower part of the buffer.
 			 */
-			size_t const lower_len = trimmed_len - upper_len;
+			size_t const upper_len = min(_buffer_size - _write_offset, trimmed_len);
+			memcpy(&_buffer[_write_offset], src, upper_len);
+			memcpy(&_buffer[0], src + upper_len, trimmed_len - upper_len);
 
-			if (lower_len > 0) {
+			_write_offset = (_write_offset + trimmed_len) % _buffer_size;
 
-				/* pipe buffer wrap-around, write remaining data to the lower part */
-				memcpy(&_buffer[0], src + upper_len, lower_len);
-				_write_offset = lower_len;
-			}
+			/* the writer is going to block until the reader frees space */
+			if (!_any_space_avail_for_writing())
+				_writer_wake_up_pending = true;
 
-			/*
-			 * Wake up reader who may block for incoming data.
-			 */
-			if (pipe_was_empty || !_any_space_avail_for_writing())
+			if (_reader_wake_up_pending
+			 && (_avail_data() >= _low_watermark || !_any_space_avail_for_writing()))
 				_wake_up_reader();
 
 			/* return number of written bytes */
 			return trimmed_len;
 		}
 
+		/**
+		 * Wake up reader for data written by a completed write request
+		 */
+		void flush()
+		{
+			Lock::Guard guard(_lock);
+
+			if (_reader_wake_up_pending)
+				_wake_up_reader();
+		}
+
 		void register_write_ready_sigh(Signal_context_capability sigh)
 		{
 			Lock::Guard guard(_lock);
@@ -257,6 +283,11 @@ class Noux::Pipe_sink_io_channel : public Io_channel
 			size_t curr_count = _pipe->write(sysio.write_in.chunk + offset,
 			                                 sysio.write_in.count - offset);
 			offset += curr_count;
+
+			/* let the reader pick up the data of the completed request */
+			if (offset == sysio.write_in.count)
+				_pipe->flush();
+
 			return true;
 		}
 
@@ -540,6 +540,8 @@ bool Noux::Child::syscall(Noux::Session::Syscall sc)
 					                          _pid_allocator,
 					                          new_pid,
 					                          _env,
+					                          _cow_backend,
+					                          _pipe_buffer_size,
 					                          _root_dir,
 					                          _vfs_io_waiter_registry,
 					                          _args,
@@ -611,7 +613,7 @@ bool Noux::Child::syscall(Noux::Session::Syscall sc)
 
 		case SYSCALL_PIPE:
 			{
-				Shared_pointer<Pipe>       pipe       (new (_heap) Pipe,                                    _heap);
+				Shared_pointer<Pipe>       pipe       (new (_heap) Pipe(_heap, _pipe_buffer_size),          _heap);
 				Shared_pointer<Io_channel> pipe_sink  (new (_heap) Pipe_sink_io_channel  (pipe, _env.ep()), _heap);
 				Shared_pointer<Io_channel> pipe_source(new (_heap) Pipe_source_io_channel(pipe, _env.ep()), _heap);
 
@@ -0,0 +1,102 @@
+/*
+ * \brief  Fork latency depending on the size of the heap
+ * \author Genode Labs
+ * \date   2026-10-14
+ *
+ * The heap of the parent is grown step by step before measuring the time
+ * until a forked child that exits immediately is reaped. With copy-on-write
+ * fork, the latency does not grow with the amount of memory the child leaves
+ * untouched. Furthermore, the test checks that parent and child do not see
+ * each other's modifications of the heap.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/time.h>
+#include <sys/wait.h>
+
+enum { STEP_SIZE = 4*1024*1024, NUM_STEPS = 16, NUM_FORKS = 4 };
+
+
+static unsigned long long now_us()
+{
+	struct timeval tv;
+	gettimeofday(&tv, nullptr);
+	return tv.tv_sec*1000000ULL + tv.tv_usec;
+}
+
+
+/**
+ * Return microseconds until a forked child is reaped
+ */
+static unsigned long long fork_latency(char *probe)
+{
+	unsigned long long const start = now_us();
+
+	pid_t const pid = fork();
+	if (pid < 0) {
+		printf("Error: fork failed\n");
+		exit(-1);
+	}
+
+	/* child */
+	if (pid == 0) {
+		int const ok = (*probe == 'p');
+		*probe = 'c';
+		_exit(ok ? 0 : 1);
+	}
+
+	int status = 0;
+	waitpid(pid, &status, 0);
+
+	unsigned long long const duration = now_us() - start;
+
+	if (WEXITSTATUS(status) != 0 || *probe != 'p') {
+		printf("Error: heap content not preserved across fork\n");
+		exit(-1);
+	}
+	return duration;
+}
+
+
+int main(int, char **)
+{
+	printf("--- test-noux_fork_latency started ---\n");
+
+	char *probe = nullptr;
+
+	for (unsigned step = 1; step <= NUM_STEPS; step++) {
+
+		/* grow heap and touch every page */
+		char * const mem = (char *)malloc(STEP_SIZE);
+		if (!mem) {
+			printf("Error: could not grow heap\n");
+			return -1;
+		}
+		memset(mem, 'p', STEP_SIZE);
+
+		if (!probe)
+			probe = mem;
+
+		unsigned long long min = ~0ULL;
+		for (unsigned i = 0; i < NUM_FORKS; i++) {
+			unsigned long long const us = fork_latency(probe);
+			if (us < min) min = us;
+		}
+
+		printf("heap %u MiB: fork latency %llu us\n",
+		       step*(STEP_SIZE/(1024*1024)), min);
+	}
+
+	printf("--- test-noux_fork_latency finished ---\n");
+	return 0;
+}
@@ -0,0 +1,106 @@
+/*
+ * \brief  Pipe throughput between two Noux processes
+ * \author Genode Labs
+ * \date   2026-10-14
+ *
+ * The parent streams a fixed amount of data through a pipe to a forked
+ * reader with different write sizes and reports the resulting throughput.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/time.h>
+#include <sys/wait.h>
+
+enum { TOTAL = 32*1024*1024, MAX_BLOCK = 64*1024 };
+
+static char buf[MAX_BLOCK];
+
+
+static unsigned long long now_us()
+{
+	struct timeval tv;
+	gettimeofday(&tv, nullptr);
+	return tv.tv_sec*1000000ULL + tv.tv_usec;
+}
+
+
+static void reader(int fd)
+{
+	unsigned long long total = 0;
+
+	for (ssize_t n; (n = read(fd, buf, sizeof(buf))) > 0; )
+		total += n;
+
+	_exit(total == TOTAL ? 0 : 1);
+}
+
+
+static void measure(size_t block)
+{
+	int fd[2];
+	if (pipe(fd) != 0) {
+		printf("Error: pipe failed\n");
+		exit(-1);
+	}
+
+	pid_t const pid = fork();
+	if (pid < 0) {
+		printf("Error: fork failed\n");
+		exit(-1);
+	}
+
+	if (pid == 0) {
+		close(fd[1]);
+		reader(fd[0]);
+	}
+	close(fd[0]);
+
+	unsigned long long const start = now_us();
+
+	for (size_t sent = 0; sent < TOTAL; ) {
+		ssize_t const n = write(fd[1], buf, block);
+		if (n <= 0) {
+			printf("Error: write failed\n");
+			exit(-1);
+		}
+		sent += n;
+	}
+	close(fd[1]);
+
+	int status = 0;
+	waitpid(pid, &status, 0);
+
+	unsigned long long const us = now_us() - start;
+
+	if (WEXITSTATUS(status) != 0) {
+		printf("Error: reader received unexpected amount of data\n");
+		exit(-1);
+	}
+
+	printf("block %6zu bytes: %llu KiB/s\n", block,
+	       us ? (TOTAL/1024ULL)*1000000ULL/us : 0);
+}
+
+
+int main(int, char **)
+{
+	printf("--- test-noux_pipe_throughput started ---\n");
+
+	memset(buf, 'x', sizeof(buf));
+
+	for (size_t block = 512; block <= MAX_BLOCK; block *= 8)
+		measure(block);
+
+	printf("--- test-noux_pipe_throughput finished ---\n");
+	return 0;
+}
@@ -13,6 +13,7 @@
 
 #include <base/log.h>
 #include <util/xml_node.h>
+#include <clipboard/content.h>
 
 #include <VBox/settings.h>
 #include <SharedClipboard/VBoxClipboard.h>
@@ -319,6 +320,7 @@ void GenodeConsole::init_clipboard()
 	    mode == ClipboardMode_GuestToHost) {
 
 		_clipboard_reporter = new Genode::Reporter(genode_env(), "clipboard");
+		_clipboard_reporter->expanding(true);
 		_clipboard_reporter->enabled(true);
 
 		clipboard_reporter = _clipboard_reporter;
@@ -421,6 +423,26 @@ void vboxClipboardFormatAnnounce (VBOXCLIPBOARDCLIENTDATA *pClient,
 	                           formats);
 }
 
+static void clipboard_utf8_to_utf16(char const *utf8, size_t len, void *pv,
+                                    uint32_t const cb, uint32_t *pcbActual)
+{
+	size_t written = 0;
+
+	PRTUTF16 utf16_string = reinterpret_cast<PRTUTF16>(pv);
+	int rc = RTStrToUtf16Ex(utf8, len, &utf16_string, cb, &written);
+
+	if (RT_SUCCESS(rc)) {
+		if ((written * 2) + 2 > cb)
+			written = (cb - 2) / 2;
+
+		/* +1 stuff required for Windows guests ... linux guest doesn't care */
+		*pcbActual = (written + 1) * 2;
+		utf16_string[written] = 0;
+	} else
+		*pcbActual = 0;
+}
+
+
 int vboxClipboardReadData (VBOXCLIPBOARDCLIENTDATA *pClient, uint32_t format,
                            void *pv, uint32_t const cb, uint32_t *pcbActual)
 {
@@ -439,6 +461,12 @@ int vboxClipboardReadData (VBOXCLIPBOARDCLIENTDATA *pClient, uint32_t format,
 
 	char * data = clipboard_rom->local_addr<char>();
 
+	/* large content is passed without XML escaping */
+	if (Clipboard::with_raw_content(data, clipboard_rom->size(),
+	    [&] (Clipboard::Mime_type const &, char const *content, size_t len) {
+	        clipboard_utf8_to_utf16(content, len, pv, cb, pcbActual); }))
+		return VINF_SUCCESS;
+
 	try {
 
 		Genode::Xml_node node(data);
@@ -458,20 +486,8 @@ int vboxClipboardReadData (VBOXCLIPBOARDCLIENTDATA *pClient, uint32_t format,
 
 		size_t const len = node.decoded_content(decoded_clipboard_content,
 		                                        node.content_size());
-		size_t written = 0;
-
-		PRTUTF16 utf16_string = reinterpret_cast<PRTUTF16>(pv);
-		int rc = RTStrToUtf16Ex(decoded_clipboard_content, len, &utf16_string, cb, &written);
 
-		if (RT_SUCCESS(rc)) {
-			if ((written * 2) + 2 > cb)
-				written = (cb - 2) / 2;
-
-			/* +1 stuff required for Windows guests ... linux guest doesn't care */
-			*pcbActual = (written + 1) * 2;
-			utf16_string[written] = 0;
-		} else
-			*pcbActual = 0;
+		clipboard_utf8_to_utf16(decoded_clipboard_content, len, pv, cb, pcbActual);
 
 	} catch (Genode::Xml_node::Invalid_syntax) {
 		Genode::error("invalid clipboard xml syntax");
@@ -496,9 +512,21 @@ void vboxClipboardWriteData (VBOXCLIPBOARDCLIENTDATA *pClient, void *pv,
 	if (!RT_SUCCESS(rc) || !message)
 		return;
 
+	size_t const len = strlen(message);
+
+	if (len >= Clipboard::RAW_CONTENT_THRESHOLD) {
+		clipboard_reporter->report_in_place(Clipboard::raw_content_max_size(len),
+			[&] (char *dst, size_t dst_len) {
+				return Clipboard::write_raw_content(dst, dst_len,
+				                                    "text/plain;charset=utf-8",
+				                                    message, len); });
+		RTStrFree(message);
+		return;
+	}
+
 	try {
 		Genode::Reporter::Xml_generator xml(*clipboard_reporter, [&] () {
-			xml.append_sanitized(message, strlen(message)); });
+			xml.append_sanitized(message, len); });
 	} catch (...) {
 		Genode::error("could not write clipboard data");
 	}
@@ -82,6 +82,21 @@ static Chunk_ids chunk_ids;
 
 
 
+/*
+ * Guest RAM is backed on demand in blocks of BACKING_SIZE as soon as
+ * VirtualBox hands out the first chunk of a block. Each block is one
+ * physically contiguous dataspace, which permits the mapping of the 2 MiB
+ * chunks as large pages into the VM.
+ */
+enum {
+	BACKING_SIZE       = 32 * 1024 * 1024,
+	CHUNKS_PER_BACKING = BACKING_SIZE / GMM_CHUNK_SIZE,
+};
+
+static Genode::Bit_array<MAX_VM_MEMORY / BACKING_SIZE> vm_memory_backed;
+static Genode::uint64_t                                vm_memory_size;
+
+
 static Sub_rm_connection &vm_memory(Genode::uint64_t vm_size = 0)
 {
 	/* memory used by the VM in any order as the VMM asks for allocations */
@@ -92,36 +107,7 @@ static Sub_rm_connection &vm_memory(Genode::uint64_t vm_size = 0)
 
 	using namespace Genode;
 
-	/* create iterator for aligned allocation and attachment of memory */
-	addr_t const vmm_local = vm_memory.local_addr(0);
-	Flexpage_iterator fli(vmm_local, vm_size, 0, ~0UL, 0);
-
-	/* start iteration */
-	Flexpage memory = fli.page();
-	while (memory.valid()) {
-		addr_t const memory_size = 1UL << memory.log2_order;
-		addr_t allocated  = 0;
-
-		addr_t alloc_size = 128 * 1024 * 1024;
-		if (alloc_size > memory_size)
-			alloc_size = memory_size;
-
-		while (allocated < memory_size) {
-			Ram_dataspace_capability ds = genode_env().ram().alloc(alloc_size);
-
-			addr_t to = vm_memory.attach_executable(ds, memory.addr +
-			                                            allocated - vmm_local,
-			                                        alloc_size);
-			Assert(to == vm_memory.local_addr(memory.addr + allocated - vmm_local));
-			allocated += alloc_size;
-
-			if (memory_size - allocated < alloc_size)
-				alloc_size = memory_size - allocated;
-		}
-
-		/* request next aligned memory range to be allocated and attached */
-		memory = fli.page();
-	}
+	vm_memory_size = vm_size;
 
 	/* reserve chunkids which are special or unused */
 	chunk_ids.reserve(0, CHUNKID_START);
@@ -133,6 +119,35 @@ static Sub_rm_connection &vm_memory(Genode::uint64_t vm_size = 0)
 }
 
 
+/**
+ * Allocate and attach backing store of chunk if not done yet
+ */
+static void vm_memory_populate(Genode::addr_t chunkid)
+{
+	using namespace Genode;
+
+	static Lock lock;
+	Lock::Guard guard(lock);
+
+	addr_t const block = chunkid / CHUNKS_PER_BACKING;
+	if (vm_memory_backed.get(block, 1))
+		return;
+
+	addr_t const offset = block * BACKING_SIZE;
+	Assert(offset < vm_memory_size);
+
+	size_t const size = min((Genode::uint64_t)BACKING_SIZE,
+	                        vm_memory_size - offset);
+
+	Ram_dataspace_capability ds = genode_env().ram().alloc(size);
+
+	addr_t to = vm_memory().attach_executable(ds, offset, size);
+	Assert(to == vm_memory().local_addr(offset));
+
+	vm_memory_backed.set(block, 1);
+}
+
+
 /*
  * VCPU handling
  */
@@ -413,6 +428,7 @@ int SUPR3CallVMMR0Ex(PVMR0 pVMR0, VMCPUID idCpu, unsigned uOperation,
 			try {
 				page_idx = page_ids.alloc();
 				chunk_id = CHUNKID_PAGE_START + page_idx / PAGES_SUPERPAGE;
+				vm_memory_populate(chunk_id);
 			} catch (...) {
 				Genode::error(__func__," ", __LINE__, " allocation failed");
 				throw;
@@ -448,6 +464,8 @@ int SUPR3CallVMMR0Ex(PVMR0 pVMR0, VMCPUID idCpu, unsigned uOperation,
 		Assert(req->idChunkUnmap == NIL_GMM_CHUNKID);
 		Assert(req->idChunkMap   != NIL_GMM_CHUNKID);
 
+		vm_memory_populate(req->idChunkMap);
+
 		Genode::addr_t local_addr_offset = (uintptr_t)req->idChunkMap << GMM_CHUNK_SHIFT;
 		Genode::addr_t to = vm_memory().local_addr(local_addr_offset);
 
@@ -510,6 +528,7 @@ int SUPR3CallVMMR0Ex(PVMR0 pVMR0, VMCPUID idCpu, unsigned uOperation,
 
 		try {
 			chunkid = chunk_ids.alloc();
+			vm_memory_populate(chunkid);
 		} catch (...) {
 			Genode::error(__func__," ", __LINE__, " allocation failed");
 			throw;
@@ -582,6 +601,7 @@ int SUPR3CallVMMR0Ex(PVMR0 pVMR0, VMCPUID idCpu, unsigned uOperation,
 
 		try {
 			Genode::uint64_t chunkid = chunk_ids.alloc();
+			vm_memory_populate(chunkid);
 
 			pVM->pgm.s.aLargeHandyPage[0].idPage = (chunkid << GMM_CHUNKID_SHIFT);
 			pVM->pgm.s.aLargeHandyPage[0].HCPhysGCPhys = vm_memory().local_addr(chunkid << GMM_CHUNK_SHIFT);
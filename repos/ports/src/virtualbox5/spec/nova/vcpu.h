@@ -17,6 +17,8 @@
 
 /* Genode includes */
 #include <base/log.h>
+#include <cpu/atomic.h>
+#include <trace/timestamp.h>
 #include <util/flex_iterator.h>
 #include <util/touch.h>
 #include <rom_session/connection.h>
@@ -141,6 +143,83 @@ class Vcpu_handler : public Vmm::Vcpu_dispatcher<pthread>,
 		Genode::addr_t     _irq_inject  = 0;
 		Genode::addr_t     _irq_drop    = 0;
 
+		/*
+		 * Adaptive halt polling
+		 *
+		 * A halting vCPU spins for a short window before blocking on its
+		 * semaphore, which spares guests that are woken up soon the
+		 * latency of blocking and unblocking. The window grows when a
+		 * wake-up arrives shortly after blocking, and shrinks when the vCPU
+		 * blocks for longer than the maximum window.
+		 */
+		int volatile       _halt_blocked = 0;
+		int volatile       _halt_woken   = 0;
+		Genode::uint64_t   _halt_poll    = 0;
+		Genode::uint64_t   _wake_up_tsc  = 0;
+
+		/* statistics reported per vCPU */
+		Genode::addr_t     _halts        = 0;
+		Genode::addr_t     _halts_polled = 0;
+		Genode::addr_t     _halts_timed  = 0;
+		Genode::uint64_t   _wake_latency = 0;
+
+		enum { HALT_STATS_INTERVAL = 100000 };
+
+		static Genode::uint64_t _halt_poll_max() {
+			return genode_cpu_hz() / (1000*1000) * 50; /* 50 us */ }
+
+		static Genode::uint64_t _halt_poll_min() {
+			return genode_cpu_hz() / (1000*1000) * 2;  /* 2 us */ }
+
+		/**
+		 * Spin until woken up, until 'tsc_end', or until 'tsc_abs'
+		 *
+		 * \return true if the halt is over
+		 */
+		bool _halt_poll_until(Genode::uint64_t tsc_end, Genode::uint64_t tsc_abs)
+		{
+			for (;;) {
+				if (_halt_woken)
+					return true;
+
+				Genode::uint64_t const now = Genode::Trace::timestamp();
+				if (now >= tsc_abs) {
+					_halts_timed ++;
+					return true;
+				}
+				if (now >= tsc_end)
+					return false;
+
+				asm volatile ("pause":::"memory");
+			}
+		}
+
+		void _halt_done()
+		{
+			if (_halt_woken)
+				_wake_latency += Genode::Trace::timestamp() - _wake_up_tsc;
+
+			/*
+			 * A wake-up arriving from now on is noticed by the next halt.
+			 * One that raced with a timeout gets dropped, which is fine as
+			 * the EMT re-checks the pending events after the halt anyway.
+			 */
+			_halt_woken = 0;
+
+			if (_halts % HALT_STATS_INTERVAL)
+				return;
+
+			Genode::uint64_t const wakes   = _halts - _halts_timed;
+			Genode::uint64_t const ns_ktsc = 1000*1000*1000ULL / (genode_cpu_hz() / 1000);
+
+			Genode::log("vCPU ", _cpu_id, ": exits=", _vm_exits,
+			            " halts=", _halts, " polled=", _halts_polled,
+			            " timed out=", _halts_timed,
+			            " avg wake latency=",
+			            wakes ? _wake_latency / wakes * ns_ktsc / 1000 : 0,
+			            " ns poll window=", _halt_poll * ns_ktsc / 1000, " ns");
+		}
+
 		struct {
 			Nova::mword_t mtd;
 			unsigned intr_state;
@@ -843,12 +922,56 @@ class Vcpu_handler : public Vmm::Vcpu_dispatcher<pthread>,
 		{
 			Assert(utcb() == Thread::myself()->utcb());
 
-			Genode::addr_t sem = native_thread().exc_pt_sel + Nova::SM_SEL_EC;
-			Nova::sm_ctrl(sem, Nova::SEMAPHORE_DOWNZERO, tsc_abs);
+			using Genode::cmpxchg;
+
+			Genode::uint64_t const start = Genode::Trace::timestamp();
+
+			_halts ++;
+
+			/*
+			 * Spin first, which also delivers timer deadlines within the
+			 * window without programming a kernel timeout
+			 */
+			if (_halt_poll_until(start + _halt_poll, tsc_abs)) {
+				_halts_polled ++;
+				_halt_done();
+				return;
+			}
+
+			/* announce blocking, 'cmpxchg' serves as memory barrier */
+			cmpxchg(&_halt_blocked, 0, 1);
+
+			/* re-check for a wake-up that missed the announcement */
+			if (!(_halt_woken && cmpxchg(&_halt_blocked, 1, 0))) {
+				Genode::addr_t sem = native_thread().exc_pt_sel + Nova::SM_SEL_EC;
+				Nova::sm_ctrl(sem, Nova::SEMAPHORE_DOWNZERO, tsc_abs);
+				cmpxchg(&_halt_blocked, 1, 0);
+			}
+
+			Genode::uint64_t const blocked = Genode::Trace::timestamp() - start;
+
+			/* adapt the poll window */
+			if (!_halt_woken || blocked > _halt_poll_max())
+				_halt_poll /= 2;
+			else
+				_halt_poll = Genode::min(Genode::max(2*_halt_poll, _halt_poll_min()),
+				                         _halt_poll_max());
+
+			if (!_halt_woken)
+				_halts_timed ++;
+
+			_halt_done();
 		}
 
 		void wake_up()
 		{
+			_wake_up_tsc = Genode::Trace::timestamp();
+			_halt_woken  = 1;
+
+			/* the vCPU notices the wake-up by itself unless blocked */
+			if (!Genode::cmpxchg(&_halt_blocked, 1, 0))
+				return;
+
 			Genode::addr_t sem = native_thread().exc_pt_sel + Nova::SM_SEL_EC;
 			Nova::sm_ctrl(sem, Nova::SEMAPHORE_UP);
 		}